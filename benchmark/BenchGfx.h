@@ -0,0 +1,247 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark framebuffer and kernels
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup benchmark
+ *
+ * @{
+ */
+
+#ifndef __BENCH_GFX_H__
+#define __BENCH_GFX_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Framebuffer in the size of the LED matrix, which is used as display for
+ * the benchmarks. It provides the span access, like the LED matrix.
+ */
+class BenchGfx : public IGfx
+{
+public:
+
+    /** Width in pixel */
+    static const uint16_t WIDTH     = 32U;
+
+    /** Height in pixel */
+    static const uint16_t HEIGHT    = 8U;
+
+    /**
+     * Constructs the framebuffer.
+     */
+    BenchGfx() :
+        IGfx(WIDTH, HEIGHT),
+        m_buffer()
+    {
+    }
+
+    /**
+     * Destroys the framebuffer.
+     */
+    ~BenchGfx()
+    {
+    }
+
+    /**
+     * Get the frame in RGB888 format (0x00RRGGBB), like the LED matrix
+     * provides it for the recording.
+     *
+     * @param[out] frame    Frame with WIDTH * HEIGHT pixels
+     */
+    void getFrame(uint32_t* frame) const
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < (WIDTH * HEIGHT); ++index)
+        {
+            frame[index] = m_buffer[index];
+        }
+
+        return;
+    }
+
+private:
+
+    Color   m_buffer[WIDTH * HEIGHT];   /**< Framebuffer */
+
+    BenchGfx(const BenchGfx& gfx);
+    BenchGfx& operator=(const BenchGfx& gfx);
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color in RGB888 format.
+     */
+    Color getColorUnchecked(int16_t x, int16_t y) const final
+    {
+        return m_buffer[x + y * WIDTH];
+    }
+
+    /**
+     * Draw a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
+     */
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
+    {
+        m_buffer[x + y * WIDTH] = color;
+
+        return;
+    }
+
+    /**
+     * Dim color to black.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] ratio Dim ration [0; 255]
+     */
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
+    {
+        m_buffer[x + y * WIDTH].setIntensity(ratio);
+
+        return;
+    }
+
+    /**
+     * Write a horizontal span of pixels.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate
+     * @param[in] colors    Pixel colors
+     * @param[in] length    Number of pixels
+     */
+    void writeSpanUnchecked(int16_t x, int16_t y, const Color* colors, uint16_t length) final
+    {
+        Color*      dst     = &m_buffer[x + y * WIDTH];
+        uint16_t    index   = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            dst[index] = colors[index];
+        }
+
+        return;
+    }
+
+    /**
+     * Fill a vertical span of pixels.
+     *
+     * @param[in] x         x-coordinate
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Pixel color
+     */
+    void fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        Color*      dst     = &m_buffer[x + y * WIDTH];
+        uint16_t    index   = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            dst[index * WIDTH] = color;
+        }
+
+        return;
+    }
+
+    /**
+     * Read a horizontal span of pixels.
+     *
+     * @param[in]   x       x-coordinate of the first pixel
+     * @param[in]   y       y-coordinate
+     * @param[out]  colors  Pixel colors
+     * @param[in]   length  Number of pixels
+     */
+    void readSpanUnchecked(int16_t x, int16_t y, Color* colors, uint16_t length) const final
+    {
+        const Color*    src     = &m_buffer[x + y * WIDTH];
+        uint16_t        index   = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            colors[index] = src[index];
+        }
+
+        return;
+    }
+};
+
+/**
+ * Pixel kernel with the load of the rainbow plugin.
+ */
+struct RainbowKernel
+{
+    /**
+     * Calculate the color of a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] time  Start angle of the color wheel
+     *
+     * @return Pixel color
+     */
+    inline Color operator()(int16_t x, int16_t y, uint32_t time) const
+    {
+        Color color;
+
+        color.turnColorWheel(time + (x + y) * 8U);
+
+        return color;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BENCH_GFX_H__ */
+
+/** @} */
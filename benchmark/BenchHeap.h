@@ -0,0 +1,87 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap statistics of the benchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup benchmark
+ *
+ * @{
+ */
+
+#ifndef __BENCH_HEAP_H__
+#define __BENCH_HEAP_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The benchmark replaces the global new operator and counts every heap
+ * allocation since start.
+ */
+namespace BenchHeap
+{
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get the number of heap allocations since start.
+ *
+ * @return Number of allocations
+ */
+extern uint32_t getAllocations();
+
+/**
+ * Get the number of allocated bytes since start. Released memory is not
+ * subtracted.
+ *
+ * @return Number of allocated bytes
+ */
+extern size_t getAllocBytes();
+
+}
+
+#endif  /* __BENCH_HEAP_H__ */
+
+/** @} */
@@ -0,0 +1,520 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Main benchmark entry point
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The benchmark measures the rendering of the graphics library on the native
+ * system. Per benchmark the time per frame and the heap allocations per frame
+ * are reported. The numbers are only comparable on the same host, but they
+ * show rendering regressions in seconds, without the target.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+
+#include <IGfx.hpp>
+#include <Canvas.h>
+#include <TextWidget.h>
+#include <LampWidget.h>
+#include <IndexedImage.h>
+#include <FadeLinear.h>
+#include <FadeMoveX.h>
+#include <FadeMoveY.h>
+#include <FadeCross.h>
+#include <FadeWipeX.h>
+#include <PixelKernel.h>
+#include <EffectRunner.hpp>
+#include <Util.h>
+
+#include "BenchGfx.h"
+#include "BenchHeap.h"
+#include "Replay.h"
+#include "Simulation.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void benchBaseGfx(void);
+static void benchCanvas(void);
+static void benchTextWidget(void);
+static void benchFadeEffects(void);
+static void benchPixelKernel(void);
+static void benchEffectRunner(void);
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** Number of frames per benchmark. */
+static const uint32_t   FRAMES          = 20000U;
+
+/** Number of frames, which are run before the measurement starts. */
+static const uint32_t   WARMUP_FRAMES   = 100U;
+
+/** Number of heap allocations since start. */
+static uint32_t         gAllocations    = 0U;
+
+/** Number of allocated bytes since start. */
+static size_t           gAllocBytes     = 0U;
+
+/******************************************************************************
+ * External functions
+ *****************************************************************************/
+
+/**
+ * Allocate memory and count the allocation.
+ *
+ * @param[in] size  Size in byte
+ *
+ * @return Pointer to the allocated memory
+ */
+void* operator new(size_t size)
+{
+    void* ptr = malloc((0U == size) ? 1U : size);
+
+    if (nullptr == ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    ++gAllocations;
+    gAllocBytes += size;
+
+    return ptr;
+}
+
+/**
+ * Release memory.
+ *
+ * @param[in] ptr   Pointer to the memory
+ */
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+uint32_t BenchHeap::getAllocations()
+{
+    return gAllocations;
+}
+
+size_t BenchHeap::getAllocBytes()
+{
+    return gAllocBytes;
+}
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+int main(int argc, char **argv)
+{
+    /* Simulate the slot rotation of the display? */
+    if ((2 <= argc) &&
+        (0 == strcmp(argv[1], "--simulate")))
+    {
+        return Simulation::run(argc - 2, &argv[2]);
+    }
+
+    /* Record the reference frames or verify the frames against them? */
+    if (3 == argc)
+    {
+        if (0 == strcmp(argv[1], "--record"))
+        {
+            return Replay::record(argv[2]);
+        }
+        else if (0 == strcmp(argv[1], "--verify"))
+        {
+            return Replay::verify(argv[2]);
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    if (1 != argc)
+    {
+        printf("Usage: %s [--record <file> | --verify <file> | --simulate [options]]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-40s %12s %14s\n", "Benchmark", "ns/frame", "allocs/frame");
+
+    benchBaseGfx();
+    benchCanvas();
+    benchTextWidget();
+    benchFadeEffects();
+    benchPixelKernel();
+    benchEffectRunner();
+
+    return 0;
+}
+
+/******************************************************************************
+ * Local functions
+ *****************************************************************************/
+
+/**
+ * Run a benchmark and print the time and the allocations per frame.
+ *
+ * @tparam TFrame   Frame function type, which is called with the frame number.
+ *
+ * @param[in] name  Benchmark name
+ * @param[in] frame Frame function
+ */
+template < typename TFrame >
+static void bench(const char* name, TFrame frame)
+{
+    uint32_t    index       = 0U;
+    uint32_t    allocations = 0U;
+    int64_t     duration    = 0;
+
+    for(index = 0U; index < WARMUP_FRAMES; ++index)
+    {
+        frame(index);
+    }
+
+    allocations = gAllocations;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    for(index = 0U; index < FRAMES; ++index)
+    {
+        frame(WARMUP_FRAMES + index);
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    duration    = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    allocations = gAllocations - allocations;
+
+    printf("%-40s %12.1f %14.3f\n",
+        name,
+        static_cast<double>(duration) / FRAMES,
+        static_cast<double>(allocations) / FRAMES);
+
+    return;
+}
+
+/**
+ * Benchmark the graphics primitives.
+ */
+static void benchBaseGfx()
+{
+    BenchGfx    gfx;
+    const Color COLOR1(200U, 100U, 0U);
+    const Color COLOR2(0U, 100U, 200U);
+
+    bench("BaseGfx::fillScreen", [&](uint32_t frame) {
+        gfx.fillScreen((0U == (frame & 1U)) ? COLOR1 : COLOR2);
+    });
+
+    bench("BaseGfx::drawLine", [&](uint32_t frame) {
+        int16_t x = static_cast<int16_t>(frame % BenchGfx::WIDTH);
+
+        gfx.drawLine(x, 0, BenchGfx::WIDTH - 1 - x, BenchGfx::HEIGHT - 1, COLOR1);
+    });
+
+    bench("BaseGfx::drawRectangle", [&](uint32_t frame) {
+        int16_t x = static_cast<int16_t>(frame % 8U);
+
+        gfx.drawRectangle(x, 0, BenchGfx::WIDTH - 2 * x, BenchGfx::HEIGHT, COLOR2);
+    });
+
+    bench("BaseGfx::fillCircle", [&](uint32_t frame) {
+        int16_t x = static_cast<int16_t>(frame % BenchGfx::WIDTH);
+
+        gfx.fillCircle(x, BenchGfx::HEIGHT / 2, BenchGfx::HEIGHT / 2U, COLOR2);
+    });
+
+    bench("IGfx::drawLineAntialiased", [&](uint32_t frame) {
+        int16_t x = static_cast<int16_t>(frame % BenchGfx::WIDTH);
+
+        gfx.drawLineAntialiased(x, 0, BenchGfx::WIDTH - 1 - x, BenchGfx::HEIGHT - 1, COLOR1);
+    });
+
+    bench("IGfx::drawCircleAntialiased", [&](uint32_t frame) {
+        int16_t x = static_cast<int16_t>(frame % BenchGfx::WIDTH);
+
+        gfx.drawCircleAntialiased(x, BenchGfx::HEIGHT / 2, BenchGfx::HEIGHT / 2U - 1U, COLOR2);
+    });
+
+    bench("BaseGfx::fillRect", [&](uint32_t frame) {
+        int16_t x = static_cast<int16_t>(frame % 8U);
+
+        gfx.fillRect(x, 1, BenchGfx::WIDTH / 2U, BenchGfx::HEIGHT - 2U, COLOR1);
+    });
+
+    /* A 8x8 icon with few colors, drawn directly and palette indexed. */
+    {
+        const uint16_t  ICON_SIZE   = 8U;
+        Color           icon[ICON_SIZE * ICON_SIZE];
+        IndexedImage    indexedIcon;
+        uint16_t        index       = 0U;
+
+        for(index = 0U; index < (ICON_SIZE * ICON_SIZE); ++index)
+        {
+            icon[index] = (0U == (index % 3U)) ? COLOR1 : COLOR2;
+        }
+
+        (void)indexedIcon.set(icon, ICON_SIZE, ICON_SIZE);
+
+        bench("BaseGfx::drawRGBBitmap", [&](uint32_t frame) {
+            gfx.drawRGBBitmap(static_cast<int16_t>(frame % BenchGfx::WIDTH), 0, icon, ICON_SIZE, ICON_SIZE);
+        });
+
+        bench("IndexedImage::draw", [&](uint32_t frame) {
+            indexedIcon.draw(gfx, static_cast<int16_t>(frame % BenchGfx::WIDTH), 0, 0U, ICON_SIZE);
+        });
+    }
+
+    bench("BaseGfx::dimScreen", [&](uint32_t frame) {
+        gfx.dimScreen(static_cast<uint8_t>(frame));
+    });
+
+    gfx.setFont(TextWidget::DEFAULT_FONT);
+
+    bench("BaseGfx::drawText", [&](uint32_t frame) {
+        UTIL_NOT_USED(frame);
+
+        gfx.setTextCursorPos(0, gfx.getFont()->yAdvance - 1);
+        gfx.drawText("Hello World!");
+    });
+
+    return;
+}
+
+/**
+ * Benchmark the canvas update with and without changed widgets.
+ */
+static void benchCanvas()
+{
+    BenchGfx    gfx;
+    Canvas      canvas(BenchGfx::WIDTH, BenchGfx::HEIGHT, 0, 0);
+    Canvas      bufferedCanvas(BenchGfx::WIDTH, BenchGfx::HEIGHT, 0, 0, true);
+    TextWidget  textWidget("12:34");
+    TextWidget  bufferedTextWidget("12:34");
+    LampWidget  lampWidget(false, ColorDef::GRAY, ColorDef::YELLOW, 4U);
+
+    lampWidget.move(0, BenchGfx::HEIGHT - 1);
+    (void)canvas.addWidget(textWidget);
+    (void)canvas.addWidget(lampWidget);
+    (void)bufferedCanvas.addWidget(bufferedTextWidget);
+
+    bench("Canvas::update (unchanged)", [&](uint32_t frame) {
+        UTIL_NOT_USED(frame);
+
+        canvas.update(gfx);
+    });
+
+    bench("Canvas::update (changed)", [&](uint32_t frame) {
+        /* Changing the lamp only is cheap, therefore change the text. */
+        textWidget.setFormatStr((0U == (frame & 1U)) ? "12:34" : "12:35");
+        lampWidget.setOnState(0U == (frame & 1U));
+        canvas.update(gfx);
+    });
+
+    bench("Canvas::update (buffered, unchanged)", [&](uint32_t frame) {
+        UTIL_NOT_USED(frame);
+
+        bufferedCanvas.update(gfx);
+    });
+
+    bench("Canvas::update (buffered, changed)", [&](uint32_t frame) {
+        bufferedTextWidget.setFormatStr((0U == (frame & 1U)) ? "12:34" : "12:35");
+        bufferedCanvas.update(gfx);
+    });
+
+    return;
+}
+
+/**
+ * Benchmark the text widget with scrolling text.
+ */
+static void benchTextWidget()
+{
+    BenchGfx    gfx;
+    TextWidget  textWidget("The quick brown fox jumps over the lazy dog.");
+
+    bench("TextWidget::update (scroll pixel)", [&](uint32_t frame) {
+        UTIL_NOT_USED(frame);
+
+        gfx.fillScreen(ColorDef::BLACK);
+        textWidget.update(gfx);
+    });
+
+    textWidget.setScrollMode(TextWidget::SCROLL_MODE_SMOOTH);
+
+    bench("TextWidget::update (scroll smooth)", [&](uint32_t frame) {
+        UTIL_NOT_USED(frame);
+
+        gfx.fillScreen(ColorDef::BLACK);
+        textWidget.update(gfx);
+    });
+
+    textWidget.setScrollMode(TextWidget::SCROLL_MODE_SMOOTH_ANTIALIASED);
+
+    bench("TextWidget::update (scroll antialiased)", [&](uint32_t frame) {
+        UTIL_NOT_USED(frame);
+
+        gfx.fillScreen(ColorDef::BLACK);
+        textWidget.update(gfx);
+    });
+
+    return;
+}
+
+/**
+ * Benchmark a fade effect. Every frame is one fade step and the effect
+ * fades out and in again and again.
+ *
+ * @param[in] name      Benchmark name
+ * @param[in] effect    Fade effect
+ */
+static void benchFadeEffect(const char* name, IFadeEffect& effect)
+{
+    BenchGfx    gfx;
+    BenchGfx    prev;
+    BenchGfx    next;
+    bool        isFadeOut   = true;
+
+    prev.fillScreen(ColorDef::RED);
+    next.fillScreen(ColorDef::BLUE);
+    effect.init();
+
+    bench(name, [&](uint32_t frame) {
+        bool isFinished = false;
+
+        UTIL_NOT_USED(frame);
+
+        if (true == isFadeOut)
+        {
+            isFinished = effect.fadeOut(gfx, prev, next);
+        }
+        else
+        {
+            isFinished = effect.fadeIn(gfx, prev, next);
+        }
+
+        if (true == isFinished)
+        {
+            isFadeOut = !isFadeOut;
+        }
+    });
+
+    return;
+}
+
+/**
+ * Benchmark all fade effects.
+ */
+static void benchFadeEffects()
+{
+    FadeLinear  fadeLinear;
+    FadeMoveX   fadeMoveX;
+    FadeMoveY   fadeMoveY;
+    FadeCross   fadeCross;
+    FadeWipeX   fadeWipeX;
+
+    benchFadeEffect("FadeLinear", fadeLinear);
+    benchFadeEffect("FadeMoveX", fadeMoveX);
+    benchFadeEffect("FadeMoveY", fadeMoveY);
+    benchFadeEffect("FadeCross", fadeCross);
+    benchFadeEffect("FadeWipeX", fadeWipeX);
+
+    return;
+}
+
+/**
+ * Benchmark the packed pixel kernels over a whole frame.
+ */
+static void benchPixelKernel()
+{
+    const uint16_t  LENGTH  = BenchGfx::WIDTH * BenchGfx::HEIGHT;
+    uint32_t        dst[LENGTH];
+    uint32_t        src1[LENGTH];
+    uint32_t        src2[LENGTH];
+
+    PixelKernel::fill(src1, LENGTH, 0x00c86400U);
+    PixelKernel::fill(src2, LENGTH, 0x000064c8U);
+
+    bench("PixelKernel::scale", [&](uint32_t frame) {
+        PixelKernel::scale(dst, src1, LENGTH, static_cast<uint8_t>(frame));
+    });
+
+    bench("PixelKernel::blend", [&](uint32_t frame) {
+        PixelKernel::blend(dst, src1, src2, LENGTH, static_cast<uint8_t>(frame));
+    });
+
+    bench("PixelKernel::addSaturated", [&](uint32_t frame) {
+        UTIL_NOT_USED(frame);
+
+        PixelKernel::addSaturated(dst, src1, LENGTH);
+    });
+
+    return;
+}
+
+/**
+ * Benchmark the effect runner with the rainbow kernel. The fire and
+ * rainbow plugins render this way, but the plugins itself depend on the
+ * web server and can't be built for the native system.
+ */
+static void benchEffectRunner()
+{
+    BenchGfx        gfx;
+    RainbowKernel   kernel;
+
+    bench("EffectRunner::forEachPixel (rainbow)", [&](uint32_t frame) {
+        EffectRunner::forEachPixel(gfx, kernel, frame);
+    });
+
+    return;
+}
@@ -0,0 +1,610 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Deterministic frame replay
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Replay.h"
+#include "BenchGfx.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include <Arduino.h>
+#include <Canvas.h>
+#include <TextWidget.h>
+#include <LampWidget.h>
+#include <FadeLinear.h>
+#include <FadeMoveX.h>
+#include <FadeMoveY.h>
+#include <FadeCross.h>
+#include <FadeWipeX.h>
+#include <EffectRunner.hpp>
+#include <FrameCodec.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * The player records the rendered frames of the scenes or compares them with
+ * the reference recording. It drives the fixed clock.
+ */
+class Player
+{
+public:
+
+    /** Number of pixels per frame. */
+    static const uint16_t   PIXEL_COUNT     = BenchGfx::WIDTH * BenchGfx::HEIGHT;
+
+    /** Number of frames per scene. */
+    static const uint32_t   FRAMES          = 500U;
+
+    /** Frame period in ms, like the display manager with 25 fps. */
+    static const uint32_t   FRAME_PERIOD    = 40U;
+
+    /**
+     * Constructs the player.
+     *
+     * @param[in] isRecording   Record (true) or verify (false)
+     */
+    Player(bool isRecording) :
+        m_isRecording(isRecording),
+        m_fd(nullptr),
+        m_recording(),
+        m_offset(0U),
+        m_encoder(PIXEL_COUNT),
+        m_decoder(PIXEL_COUNT),
+        m_frame(),
+        m_record(),
+        m_sceneName(nullptr),
+        m_frameIdx(0U),
+        m_hash(0U),
+        m_mismatchIdx(FRAMES),
+        m_isError(false)
+    {
+    }
+
+    /**
+     * Destroys the player.
+     */
+    ~Player()
+    {
+        end();
+    }
+
+    /**
+     * Begin with the recording or load the reference recording.
+     *
+     * @param[in] filename  Name of the recording file
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin(const char* filename);
+
+    /**
+     * Finish the recording and release the fixed clock.
+     */
+    void end();
+
+    /**
+     * Begin a scene. The clock starts at 0 again.
+     *
+     * @param[in] name  Scene name
+     */
+    void beginScene(const char* name);
+
+    /**
+     * Record or verify the rendered frame and advance the clock.
+     *
+     * @param[in] gfx   Rendered frame
+     */
+    void nextFrame(const BenchGfx& gfx);
+
+    /**
+     * Finish the scene and print the result.
+     *
+     * @return If the scene frames are identical, it will return true otherwise false.
+     */
+    bool endScene();
+
+private:
+
+    bool                    m_isRecording;                                  /**< Record or verify? */
+    FILE*                   m_fd;                                           /**< Recording file */
+    std::vector<uint8_t>    m_recording;                                    /**< Reference recording */
+    size_t                  m_offset;                                       /**< Offset of the next record in the reference recording */
+    FrameEncoder            m_encoder;                                      /**< Frame encoder */
+    FrameDecoder            m_decoder;                                      /**< Frame decoder */
+    uint32_t                m_frame[PIXEL_COUNT];                           /**< Rendered frame */
+    uint8_t                 m_record[FrameCodec::RECORD_HEADER_SIZE + FrameCodec::RUN_HEADER_SIZE + FrameCodec::BYTES_PER_PIXEL * PIXEL_COUNT]; /**< Record buffer */
+    const char*             m_sceneName;                                    /**< Current scene name */
+    uint32_t                m_frameIdx;                                     /**< Index of the current frame in the scene */
+    uint32_t                m_hash;                                         /**< Hash over all scene frames */
+    uint32_t                m_mismatchIdx;                                  /**< Index of the first frame, which differs from the reference. */
+    bool                    m_isError;                                      /**< Any error happened? */
+
+    Player();
+    Player(const Player& player);
+    Player& operator=(const Player& player);
+
+    /**
+     * Verify the rendered frame with the reference.
+     *
+     * @param[in] timestamp Timestamp in ms of the rendered frame
+     *
+     * @return If identical, it will return true otherwise false.
+     */
+    bool verifyFrame(uint32_t timestamp);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool run(Player& player, const char* filename);
+static void sceneTextWidget(Player& player, const char* name, TextWidget::ScrollMode mode);
+static void sceneCanvas(Player& player);
+static void sceneFadeEffect(Player& player, const char* name, IFadeEffect& effect);
+static void sceneEffectRunner(Player& player);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool Player::begin(const char* filename)
+{
+    bool status = false;
+
+    if (true == m_isRecording)
+    {
+        uint8_t                 header[FrameCodec::FILE_HEADER_SIZE];
+        FrameCodec::FileHeader  fileHeader;
+
+        fileHeader.width    = BenchGfx::WIDTH;
+        fileHeader.height   = BenchGfx::HEIGHT;
+        fileHeader.seed     = 0U;
+
+        (void)FrameCodec::writeFileHeader(header, fileHeader);
+
+        m_fd = fopen(filename, "wb");
+
+        if ((nullptr != m_fd) &&
+            (sizeof(header) == fwrite(header, 1U, sizeof(header), m_fd)))
+        {
+            status = true;
+        }
+    }
+    else
+    {
+        FILE* fd = fopen(filename, "rb");
+
+        if (nullptr != fd)
+        {
+            uint8_t                 buffer[1024U];
+            size_t                  size        = 0U;
+            FrameCodec::FileHeader  fileHeader;
+
+            while(0U < (size = fread(buffer, 1U, sizeof(buffer), fd)))
+            {
+                m_recording.insert(m_recording.end(), buffer, buffer + size);
+            }
+
+            fclose(fd);
+
+            if ((true == FrameCodec::readFileHeader(m_recording.data(), m_recording.size(), fileHeader)) &&
+                (BenchGfx::WIDTH == fileHeader.width) &&
+                (BenchGfx::HEIGHT == fileHeader.height))
+            {
+                m_offset    = FrameCodec::FILE_HEADER_SIZE;
+                status      = true;
+            }
+        }
+    }
+
+    if (false == status)
+    {
+        printf("Couldn't %s %s.\n", (true == m_isRecording) ? "create" : "load", filename);
+    }
+
+    return status;
+}
+
+void Player::end()
+{
+    if (nullptr != m_fd)
+    {
+        fclose(m_fd);
+        m_fd = nullptr;
+    }
+
+    getNativeClock().isFixed = false;
+
+    return;
+}
+
+void Player::beginScene(const char* name)
+{
+    NativeClock& nativeClock = getNativeClock();
+
+    nativeClock.isFixed = true;
+    nativeClock.now     = 0UL;
+
+    /* Every scene can be verified on its own, starting with a key frame. */
+    m_encoder.requestKeyFrame();
+
+    m_sceneName     = name;
+    m_frameIdx      = 0U;
+    m_hash          = FrameCodec::hash(nullptr, 0U);
+    m_mismatchIdx   = FRAMES;
+
+    return;
+}
+
+void Player::nextFrame(const BenchGfx& gfx)
+{
+    NativeClock&    nativeClock = getNativeClock();
+    const uint32_t  TIMESTAMP   = static_cast<uint32_t>(nativeClock.now);
+
+    gfx.getFrame(m_frame);
+    m_hash = FrameCodec::hash(m_frame, PIXEL_COUNT, m_hash);
+
+    if (true == m_isRecording)
+    {
+        size_t recordSize = m_encoder.encode(m_frame, TIMESTAMP, m_record);
+
+        if ((0U < recordSize) &&
+            (recordSize != fwrite(m_record, 1U, recordSize, m_fd)))
+        {
+            m_isError = true;
+        }
+    }
+    /* The records must be consumed after a mismatch too, to verify the following scenes. */
+    else if ((false == verifyFrame(TIMESTAMP)) &&
+             (FRAMES == m_mismatchIdx))
+    {
+        m_mismatchIdx = m_frameIdx;
+    }
+    else
+    {
+        ;
+    }
+
+    ++m_frameIdx;
+    nativeClock.now += FRAME_PERIOD;
+
+    return;
+}
+
+bool Player::endScene()
+{
+    bool isIdentical = (FRAMES == m_mismatchIdx) && (false == m_isError);
+
+    if (true == m_isRecording)
+    {
+        printf("%-40s %8u %10.8x %s\n", m_sceneName, m_frameIdx, m_hash, (false == m_isError) ? "RECORDED" : "ERROR");
+    }
+    else if (true == isIdentical)
+    {
+        printf("%-40s %8u %10.8x %s\n", m_sceneName, m_frameIdx, m_hash, "OK");
+    }
+    else
+    {
+        printf("%-40s %8u %10.8x %s %u\n", m_sceneName, m_frameIdx, m_hash, "MISMATCH AT FRAME", m_mismatchIdx);
+    }
+
+    return isIdentical;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool Player::verifyFrame(uint32_t timestamp)
+{
+    bool isIdentical = false;
+
+    /* Unchanged frames are not recorded. Every scene begins with a key
+     * frame at timestamp 0, therefore a record with the timestamp of the
+     * rendered frame belongs to it.
+     */
+    if ((m_recording.size() >= (m_offset + FrameCodec::RECORD_HEADER_SIZE)) &&
+        (timestamp == ((static_cast<uint32_t>(m_recording[m_offset + 1U]) << 0U) |
+                       (static_cast<uint32_t>(m_recording[m_offset + 2U]) << 8U) |
+                       (static_cast<uint32_t>(m_recording[m_offset + 3U]) << 16U) |
+                       (static_cast<uint32_t>(m_recording[m_offset + 4U]) << 24U))))
+    {
+        uint32_t    recordTimestamp = 0U;
+        size_t      recordSize      = m_decoder.decode(&m_recording[m_offset], m_recording.size() - m_offset, recordTimestamp);
+
+        if (0U == recordSize)
+        {
+            m_isError = true;
+        }
+
+        m_offset += recordSize;
+    }
+
+    if (false == m_isError)
+    {
+        isIdentical = (0 == memcmp(m_frame, m_decoder.getFrame(), sizeof(m_frame)));
+    }
+
+    return isIdentical;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+int Replay::record(const char* filename)
+{
+    Player player(true);
+
+    return (true == run(player, filename)) ? 0 : 1;
+}
+
+int Replay::verify(const char* filename)
+{
+    Player player(false);
+
+    return (true == run(player, filename)) ? 0 : 1;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Run all scenes with the player.
+ *
+ * @param[in] player    Player
+ * @param[in] filename  Name of the recording file
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool run(Player& player, const char* filename)
+{
+    bool        isSuccessful    = false;
+    FadeLinear  fadeLinear;
+    FadeMoveX   fadeMoveX;
+    FadeMoveY   fadeMoveY;
+    FadeCross   fadeCross;
+    FadeWipeX   fadeWipeX;
+
+    if (true == player.begin(filename))
+    {
+        isSuccessful = true;
+
+        printf("%-40s %8s %10s %s\n", "Scene", "frames", "hash", "result");
+
+        sceneTextWidget(player, "TextWidget (scroll pixel)", TextWidget::SCROLL_MODE_PIXEL);
+        isSuccessful &= player.endScene();
+
+        sceneTextWidget(player, "TextWidget (scroll smooth)", TextWidget::SCROLL_MODE_SMOOTH);
+        isSuccessful &= player.endScene();
+
+        sceneTextWidget(player, "TextWidget (scroll antialiased)", TextWidget::SCROLL_MODE_SMOOTH_ANTIALIASED);
+        isSuccessful &= player.endScene();
+
+        sceneCanvas(player);
+        isSuccessful &= player.endScene();
+
+        sceneFadeEffect(player, "FadeLinear", fadeLinear);
+        isSuccessful &= player.endScene();
+
+        sceneFadeEffect(player, "FadeMoveX", fadeMoveX);
+        isSuccessful &= player.endScene();
+
+        sceneFadeEffect(player, "FadeMoveY", fadeMoveY);
+        isSuccessful &= player.endScene();
+
+        sceneFadeEffect(player, "FadeCross", fadeCross);
+        isSuccessful &= player.endScene();
+
+        sceneFadeEffect(player, "FadeWipeX", fadeWipeX);
+        isSuccessful &= player.endScene();
+
+        sceneEffectRunner(player);
+        isSuccessful &= player.endScene();
+
+        player.end();
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Scene with a scrolling text.
+ *
+ * @param[in] player    Player
+ * @param[in] name      Scene name
+ * @param[in] mode      Scroll mode
+ */
+static void sceneTextWidget(Player& player, const char* name, TextWidget::ScrollMode mode)
+{
+    uint32_t    frame   = 0U;
+
+    /* The widget takes the scroll timestamp from the fixed clock. */
+    player.beginScene(name);
+
+    {
+        BenchGfx    gfx;
+        TextWidget  textWidget;
+
+        textWidget.setScrollMode(mode);
+        textWidget.setFormatStr("The quick \\#ff0000brown\\#ffffff fox jumps over the lazy dog.");
+
+        for(frame = 0U; frame < Player::FRAMES; ++frame)
+        {
+            gfx.fillScreen(ColorDef::BLACK);
+            textWidget.update(gfx);
+            player.nextFrame(gfx);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Scene with a buffered canvas, which contains a clock and a lamp.
+ *
+ * @param[in] player    Player
+ */
+static void sceneCanvas(Player& player)
+{
+    uint32_t    frame   = 0U;
+
+    player.beginScene("Canvas");
+
+    {
+        BenchGfx    gfx;
+        Canvas      canvas(BenchGfx::WIDTH, BenchGfx::HEIGHT, 0, 0, true);
+        TextWidget  textWidget("12:34");
+        LampWidget  lampWidget(false, ColorDef::GRAY, ColorDef::YELLOW, 4U);
+
+        lampWidget.move(0, BenchGfx::HEIGHT - 1);
+        (void)canvas.addWidget(textWidget);
+        (void)canvas.addWidget(lampWidget);
+
+        for(frame = 0U; frame < Player::FRAMES; ++frame)
+        {
+            if (0U == (frame % 25U))
+            {
+                char clock[6];
+
+                (void)snprintf(clock, sizeof(clock), "12:%02u", (frame / 25U) % 60U);
+                textWidget.setFormatStr(clock);
+            }
+
+            lampWidget.setOnState(0U == ((frame / 10U) & 1U));
+            canvas.update(gfx);
+            player.nextFrame(gfx);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Scene with a fade effect, which fades between a rainbow and a text again
+ * and again.
+ *
+ * @param[in] player    Player
+ * @param[in] name      Scene name
+ * @param[in] effect    Fade effect
+ */
+static void sceneFadeEffect(Player& player, const char* name, IFadeEffect& effect)
+{
+    uint32_t    frame   = 0U;
+
+    player.beginScene(name);
+
+    {
+        BenchGfx        gfx;
+        BenchGfx        prev;
+        BenchGfx        next;
+        TextWidget      textWidget("12:34");
+        RainbowKernel   kernel;
+        bool            isFadeOut   = true;
+
+        EffectRunner::forEachPixel(prev, kernel, 0U);
+        next.fillScreen(ColorDef::BLACK);
+        textWidget.update(next);
+        effect.init();
+
+        for(frame = 0U; frame < Player::FRAMES; ++frame)
+        {
+            bool isFinished = false;
+
+            if (true == isFadeOut)
+            {
+                isFinished = effect.fadeOut(gfx, prev, next);
+            }
+            else
+            {
+                isFinished = effect.fadeIn(gfx, prev, next);
+            }
+
+            if (true == isFinished)
+            {
+                isFadeOut = !isFadeOut;
+            }
+
+            player.nextFrame(gfx);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Scene with the rainbow kernel and the effect runner.
+ *
+ * @param[in] player    Player
+ */
+static void sceneEffectRunner(Player& player)
+{
+    uint32_t    frame   = 0U;
+
+    player.beginScene("EffectRunner (rainbow)");
+
+    {
+        BenchGfx        gfx;
+        RainbowKernel   kernel;
+
+        for(frame = 0U; frame < Player::FRAMES; ++frame)
+        {
+            EffectRunner::forEachPixel(gfx, kernel, millis() / 10U);
+            player.nextFrame(gfx);
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,91 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Deterministic frame replay
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup benchmark
+ *
+ * @{
+ */
+
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The replay renders a fixed set of scenes (text scrolling, canvas, fade
+ * effects and effect runner) with a fixed clock. Therefore every run
+ * produces the same frames, which can be recorded as reference and verified
+ * later, e.g. after optimizing the rendering. The recording layout is the
+ * same as on the target, see FrameCodec.
+ */
+namespace Replay
+{
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Render all scenes and record the frames as reference.
+ *
+ * @param[in] filename  Name of the recording file
+ *
+ * @return If successful, it will return 0 otherwise 1.
+ */
+extern int record(const char* filename);
+
+/**
+ * Render all scenes and compare the frames with the reference recording.
+ *
+ * @param[in] filename  Name of the recording file
+ *
+ * @return If all frames are identical, it will return 0 otherwise 1.
+ */
+extern int verify(const char* filename);
+
+}
+
+#endif  /* __REPLAY_H__ */
+
+/** @} */
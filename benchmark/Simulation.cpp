@@ -0,0 +1,633 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display slot rotation simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Simulation.h"
+#include "BenchGfx.h"
+#include "BenchHeap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <Arduino.h>
+#include <Canvas.h>
+#include <TextWidget.h>
+#include <LampWidget.h>
+#include <FadeLinear.h>
+#include <FadeMoveX.h>
+#include <FadeMoveY.h>
+#include <FadeCross.h>
+#include <FadeWipeX.h>
+#include <EffectRunner.hpp>
+#include <ImageEncoder.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Simulation configuration, given by the command line options.
+ */
+struct Config
+{
+    uint32_t    slotCount;      /**< Number of slots */
+    uint32_t    minutes;        /**< Simulated time in minutes */
+    uint32_t    duration;       /**< Slot duration in ms */
+    const char* pngDir;         /**< Directory for the PNG sequence or nullptr */
+    bool        isTerminal;     /**< Show the frames in the terminal? */
+    uint64_t    maxFrameNs;     /**< Max. 99th percentile of the frame time in ns, 0 = no limit */
+};
+
+/**
+ * A simulated slot, which renders the content of a plugin.
+ */
+class SimSlot
+{
+public:
+
+    /**
+     * Destroys the slot.
+     */
+    virtual ~SimSlot()
+    {
+    }
+
+    /**
+     * Render the slot content.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    virtual void update(IGfx& gfx) = 0;
+
+protected:
+
+    /**
+     * Constructs the slot.
+     */
+    SimSlot()
+    {
+    }
+
+private:
+
+    SimSlot(const SimSlot& slot);
+    SimSlot& operator=(const SimSlot& slot);
+};
+
+/**
+ * Slot with a scrolling text, like the icon text plugins.
+ */
+class TextSlot : public SimSlot
+{
+public:
+
+    /**
+     * Constructs the slot.
+     *
+     * @param[in] index Slot index, which is shown in the text.
+     */
+    TextSlot(uint32_t index) :
+        SimSlot(),
+        m_textWidget()
+    {
+        char text[96U];
+
+        (void)snprintf(text, sizeof(text), "Slot %u: The quick \\#ff0000brown\\#ffffff fox jumps over the lazy dog.", index);
+        m_textWidget.setScrollMode(TextWidget::SCROLL_MODE_SMOOTH);
+        m_textWidget.setFormatStr(text);
+    }
+
+    /**
+     * Render the slot content.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void update(IGfx& gfx) final
+    {
+        gfx.fillScreen(ColorDef::BLACK);
+        m_textWidget.update(gfx);
+    }
+
+private:
+
+    TextWidget  m_textWidget;   /**< Scrolling text */
+};
+
+/**
+ * Slot with a buffered canvas, which contains a clock and a lamp, like the
+ * clock plugins.
+ */
+class ClockSlot : public SimSlot
+{
+public:
+
+    /**
+     * Constructs the slot.
+     */
+    ClockSlot() :
+        SimSlot(),
+        m_canvas(BenchGfx::WIDTH, BenchGfx::HEIGHT, 0, 0, true),
+        m_textWidget(),
+        m_lampWidget(false, ColorDef::GRAY, ColorDef::YELLOW, 4U)
+    {
+        m_lampWidget.move(0, BenchGfx::HEIGHT - 1);
+        (void)m_canvas.addWidget(m_textWidget);
+        (void)m_canvas.addWidget(m_lampWidget);
+    }
+
+    /**
+     * Render the slot content.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void update(IGfx& gfx) final
+    {
+        const uint32_t  SECONDS = millis() / 1000U;
+        char            clock[9];
+
+        (void)snprintf(clock, sizeof(clock), "%02u:%02u:%02u", (SECONDS / 3600U) % 24U, (SECONDS / 60U) % 60U, SECONDS % 60U);
+        m_textWidget.setFormatStr(clock);
+        m_lampWidget.setOnState(0U == (SECONDS & 1U));
+        m_canvas.update(gfx);
+    }
+
+private:
+
+    Canvas      m_canvas;       /**< Buffered canvas */
+    TextWidget  m_textWidget;   /**< Clock */
+    LampWidget  m_lampWidget;   /**< Lamp, which toggles every second */
+};
+
+/**
+ * Slot with a rainbow, like the rainbow plugin.
+ */
+class RainbowSlot : public SimSlot
+{
+public:
+
+    /**
+     * Constructs the slot.
+     */
+    RainbowSlot() :
+        SimSlot(),
+        m_kernel()
+    {
+    }
+
+    /**
+     * Render the slot content.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void update(IGfx& gfx) final
+    {
+        EffectRunner::forEachPixel(gfx, m_kernel, millis() / 10U);
+    }
+
+private:
+
+    RainbowKernel   m_kernel;   /**< Rainbow pixel kernel */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool parseOptions(int argc, char** argv, Config& cfg);
+static bool writePng(const char* dir, uint32_t frameIdx, const uint32_t* frame);
+static void showInTerminal(const uint32_t* frame);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Frame period in ms, like the display manager with the default 50 fps. */
+static const uint32_t   FRAME_PERIOD    = 20U;
+
+/** Number of pixels per frame. */
+static const uint16_t   PIXEL_COUNT     = BenchGfx::WIDTH * BenchGfx::HEIGHT;
+
+/** Scale factor of the PNG frames. */
+static const uint8_t    PNG_SCALE       = 4U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+int Simulation::run(int argc, char** argv)
+{
+    /** Display state, like the fade states of the display manager. */
+    enum State
+    {
+        STATE_SHOW = 0,     /**< Show the current slot */
+        STATE_FADE_OUT,     /**< Fade the current slot out */
+        STATE_FADE_IN       /**< Fade the next slot in */
+    };
+
+    Config                  cfg         = { 30U, 10U, 30000U, nullptr, false, 0U };
+    NativeClock&            nativeClock = getNativeClock();
+    std::vector<SimSlot*>   slots;
+    std::vector<uint64_t>   frameTimes;
+    BenchGfx                gfx;
+    BenchGfx                prev;
+    BenchGfx                next;
+    FadeLinear              fadeLinear;
+    FadeMoveX               fadeMoveX;
+    FadeMoveY               fadeMoveY;
+    FadeCross               fadeCross;
+    FadeWipeX               fadeWipeX;
+    IFadeEffect*            effects[]   = { &fadeLinear, &fadeMoveX, &fadeMoveY, &fadeCross, &fadeWipeX };
+    IFadeEffect*            effect      = nullptr;
+    uint32_t                frame[PIXEL_COUNT];
+    State                   state       = STATE_SHOW;
+    uint32_t                frameCount  = 0U;
+    uint32_t                frameIdx    = 0U;
+    uint32_t                current     = 0U;
+    uint32_t                rotations   = 0U;
+    uint32_t                slotStart   = 0U;
+    uint32_t                maxDeviation= 0U;
+    uint32_t                fadeStart   = 0U;
+    uint32_t                fadeTime    = 0U;
+    uint32_t                maxFadeTime = 0U;
+    uint32_t                allocations = 0U;
+    size_t                  allocBytes  = 0U;
+    uint32_t                index       = 0U;
+    bool                    isSuccessful= true;
+    uint64_t                p99         = 0U;
+    uint64_t                sum         = 0U;
+    int64_t                 realTime    = 0;
+
+    if (false == parseOptions(argc, argv, cfg))
+    {
+        printf("Options: [--slots <n>] [--minutes <n>] [--duration <ms>] [--png <dir>] [--term] [--max-frame-ns <n>]\n");
+        return 1;
+    }
+
+    nativeClock.isFixed = true;
+    nativeClock.now     = 0UL;
+
+    frameCount = (cfg.minutes * 60000U) / FRAME_PERIOD;
+    frameTimes.reserve(frameCount);
+
+    /* The heap usage of the slots is measured, like the plugins use it on the target. */
+    allocations = BenchHeap::getAllocations();
+    allocBytes  = BenchHeap::getAllocBytes();
+
+    for(index = 0U; index < cfg.slotCount; ++index)
+    {
+        switch(index % 3U)
+        {
+        case 0U:
+            slots.push_back(new TextSlot(index));
+            break;
+
+        case 1U:
+            slots.push_back(new ClockSlot());
+            break;
+
+        default:
+            slots.push_back(new RainbowSlot());
+            break;
+        }
+    }
+
+    allocations = BenchHeap::getAllocations() - allocations;
+    allocBytes  = BenchHeap::getAllocBytes() - allocBytes;
+
+    printf("Slots: %u, slot duration: %u ms, simulated: %u min, frames: %u\n", cfg.slotCount, cfg.duration, cfg.minutes, frameCount);
+    printf("Slot heap usage: %u allocations, %zu bytes\n", allocations, allocBytes);
+
+    /* Clear the terminal once, every frame overwrites the previous one. */
+    if (true == cfg.isTerminal)
+    {
+        printf("\x1b[2J");
+    }
+
+    allocations = BenchHeap::getAllocations();
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    for(frameIdx = 0U; frameIdx < frameCount; ++frameIdx)
+    {
+        const uint32_t NOW = static_cast<uint32_t>(nativeClock.now);
+
+        std::chrono::steady_clock::time_point frameBegin = std::chrono::steady_clock::now();
+
+        if (STATE_SHOW == state)
+        {
+            slots[current]->update(gfx);
+
+            /* Slot duration elapsed and another slot to show? */
+            if ((cfg.duration <= (NOW - slotStart)) &&
+                (1U < cfg.slotCount))
+            {
+                maxDeviation    = std::max(maxDeviation, (NOW - slotStart) - cfg.duration);
+                effect          = effects[rotations % (sizeof(effects) / sizeof(effects[0]))];
+                fadeStart       = NOW;
+                state           = STATE_FADE_OUT;
+                effect->init();
+            }
+        }
+        else
+        {
+            const uint32_t NEXT_SLOT = (current + 1U) % cfg.slotCount;
+
+            slots[current]->update(prev);
+            slots[NEXT_SLOT]->update(next);
+
+            if (STATE_FADE_OUT == state)
+            {
+                if (true == effect->fadeOut(gfx, prev, next))
+                {
+                    state = STATE_FADE_IN;
+                }
+            }
+            else if (true == effect->fadeIn(gfx, prev, next))
+            {
+                fadeTime    += NOW - fadeStart;
+                maxFadeTime = std::max(maxFadeTime, NOW - fadeStart);
+                current     = NEXT_SLOT;
+                slotStart   = NOW;
+                state       = STATE_SHOW;
+                ++rotations;
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        std::chrono::steady_clock::time_point frameEnd = std::chrono::steady_clock::now();
+
+        frameTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(frameEnd - frameBegin).count());
+
+        if ((nullptr != cfg.pngDir) ||
+            (true == cfg.isTerminal))
+        {
+            gfx.getFrame(frame);
+
+            if ((nullptr != cfg.pngDir) &&
+                (false == writePng(cfg.pngDir, frameIdx, frame)))
+            {
+                printf("Couldn't write frame %u to %s.\n", frameIdx, cfg.pngDir);
+                cfg.pngDir      = nullptr;
+                isSuccessful    = false;
+            }
+
+            /* The terminal output runs in real time, otherwise nobody can follow it. */
+            if (true == cfg.isTerminal)
+            {
+                showInTerminal(frame);
+                std::this_thread::sleep_until(begin + std::chrono::milliseconds(NOW + FRAME_PERIOD));
+            }
+        }
+
+        nativeClock.now += FRAME_PERIOD;
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    realTime    = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+    allocations = BenchHeap::getAllocations() - allocations;
+
+    for(index = 0U; index < cfg.slotCount; ++index)
+    {
+        delete slots[index];
+    }
+
+    nativeClock.isFixed = false;
+
+    if (0U < frameCount)
+    {
+        uint64_t maxFrameTime = *std::max_element(frameTimes.begin(), frameTimes.end());
+
+        for(index = 0U; index < frameCount; ++index)
+        {
+            sum += frameTimes[index];
+        }
+
+        std::sort(frameTimes.begin(), frameTimes.end());
+        p99 = frameTimes[(static_cast<uint64_t>(frameCount) * 99U) / 100U];
+
+        printf("Real time: %lld ms (%.1fx faster than real time)\n",
+            static_cast<long long>(realTime),
+            (0 < realTime) ? (static_cast<double>(cfg.minutes) * 60000.0 / static_cast<double>(realTime)) : 0.0);
+        printf("Frame time [ns]: avg %.1f, p99 %llu, max %llu\n",
+            static_cast<double>(sum) / frameCount,
+            static_cast<unsigned long long>(p99),
+            static_cast<unsigned long long>(maxFrameTime));
+        printf("Allocations per frame: %.3f\n", static_cast<double>(allocations) / frameCount);
+        printf("Slot rotations: %u, max. slot duration deviation: %u ms, fade duration avg %.1f ms, max %u ms\n",
+            rotations,
+            maxDeviation,
+            (0U < rotations) ? (static_cast<double>(fadeTime) / rotations) : 0.0,
+            maxFadeTime);
+    }
+
+    /* Performance gate, e.g. for the CI. */
+    if ((0U < cfg.maxFrameNs) &&
+        (cfg.maxFrameNs < p99))
+    {
+        printf("FAILED: Frame time p99 %llu ns exceeds %llu ns.\n",
+            static_cast<unsigned long long>(p99),
+            static_cast<unsigned long long>(cfg.maxFrameNs));
+        isSuccessful = false;
+    }
+
+    return (true == isSuccessful) ? 0 : 1;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Parse the command line options.
+ *
+ * @param[in]   argc    Number of options
+ * @param[in]   argv    Options
+ * @param[out]  cfg     Configuration
+ *
+ * @return If all options are valid, it will return true otherwise false.
+ */
+static bool parseOptions(int argc, char** argv, Config& cfg)
+{
+    bool    isValid = true;
+    int     index   = 0;
+
+    while((true == isValid) && (argc > index))
+    {
+        const char* option  = argv[index];
+        const char* value   = ((index + 1) < argc) ? argv[index + 1] : nullptr;
+
+        if (0 == strcmp(option, "--term"))
+        {
+            cfg.isTerminal = true;
+            ++index;
+        }
+        else if (nullptr == value)
+        {
+            isValid = false;
+        }
+        else
+        {
+            if (0 == strcmp(option, "--slots"))
+            {
+                cfg.slotCount = strtoul(value, nullptr, 10);
+                isValid = (0U < cfg.slotCount);
+            }
+            else if (0 == strcmp(option, "--minutes"))
+            {
+                cfg.minutes = strtoul(value, nullptr, 10);
+            }
+            else if (0 == strcmp(option, "--duration"))
+            {
+                cfg.duration = strtoul(value, nullptr, 10);
+            }
+            else if (0 == strcmp(option, "--png"))
+            {
+                cfg.pngDir = value;
+            }
+            else if (0 == strcmp(option, "--max-frame-ns"))
+            {
+                cfg.maxFrameNs = strtoull(value, nullptr, 10);
+            }
+            else
+            {
+                isValid = false;
+            }
+
+            index += 2;
+        }
+    }
+
+    return isValid;
+}
+
+/**
+ * Write a frame as PNG file to the directory.
+ *
+ * @param[in] dir       Directory
+ * @param[in] frameIdx  Frame index, which is part of the file name.
+ * @param[in] frame     Frame in RGB888 format
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool writePng(const char* dir, uint32_t frameIdx, const uint32_t* frame)
+{
+    bool            status  = false;
+    char            filename[256U];
+    ImageEncoder    encoder(ImageEncoder::FORMAT_PNG, frame, BenchGfx::WIDTH, BenchGfx::HEIGHT, PNG_SCALE);
+    FILE*           fd      = nullptr;
+
+    (void)snprintf(filename, sizeof(filename), "%s/frame_%06u.png", dir, frameIdx);
+
+    fd = fopen(filename, "wb");
+
+    if (nullptr != fd)
+    {
+        uint8_t buffer[1024U];
+
+        status = true;
+
+        while((true == status) && (false == encoder.isFinished()))
+        {
+            size_t size = encoder.read(buffer, sizeof(buffer));
+
+            status = (size == fwrite(buffer, 1U, size, fd));
+        }
+
+        fclose(fd);
+    }
+
+    return status;
+}
+
+/**
+ * Show a frame in the terminal. Two pixel rows are shown as one line of
+ * upper half blocks with 24-bit foreground and background color.
+ *
+ * @param[in] frame Frame in RGB888 format
+ */
+static void showInTerminal(const uint32_t* frame)
+{
+    uint16_t x = 0U;
+    uint16_t y = 0U;
+
+    /* Cursor home */
+    printf("\x1b[H");
+
+    for(y = 0U; y < BenchGfx::HEIGHT; y += 2U)
+    {
+        for(x = 0U; x < BenchGfx::WIDTH; ++x)
+        {
+            uint32_t upper = frame[x + y * BenchGfx::WIDTH];
+            uint32_t lower = ((y + 1U) < BenchGfx::HEIGHT) ? frame[x + (y + 1U) * BenchGfx::WIDTH] : 0U;
+
+            printf("\x1b[38;2;%u;%u;%um\x1b[48;2;%u;%u;%um\xe2\x96\x80",
+                (upper >> 16U) & 0xffU, (upper >> 8U) & 0xffU, upper & 0xffU,
+                (lower >> 16U) & 0xffU, (lower >> 8U) & 0xffU, lower & 0xffU);
+        }
+
+        printf("\x1b[0m\n");
+    }
+
+    (void)fflush(stdout);
+
+    return;
+}
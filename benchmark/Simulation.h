@@ -0,0 +1,94 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display slot rotation simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup benchmark
+ *
+ * @{
+ */
+
+#ifndef __SIMULATION_H__
+#define __SIMULATION_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The simulation rotates through a configurable number of slots, like the
+ * display manager does. The slots show a scrolling text, a clock with a lamp
+ * or a rainbow and are changed with the fade effects. The clock is fixed and
+ * advanced by one frame period per frame, therefore the simulation runs much
+ * faster than real time.
+ *
+ * It reports the frame times, the slot rotation and the heap usage. The
+ * frames can be written as PNG sequence or shown in the terminal.
+ */
+namespace Simulation
+{
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Run the simulation.
+ *
+ * Options:
+ * --slots <n>          Number of slots (default 30)
+ * --minutes <n>        Simulated time in minutes (default 10)
+ * --duration <ms>      Slot duration in ms (default 30000, like a slot)
+ * --png <dir>          Write every frame as PNG to the directory.
+ * --term               Show the frames in the terminal in real time.
+ * --max-frame-ns <n>   Fail, if the 99th percentile of the frame time is greater.
+ *
+ * @param[in] argc  Number of options
+ * @param[in] argv  Options
+ *
+ * @return If successful, it will return 0 otherwise 1.
+ */
+extern int run(int argc, char** argv);
+
+}
+
+#endif  /* __SIMULATION_H__ */
+
+/** @} */
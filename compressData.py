@@ -0,0 +1,98 @@
+# MIT License
+# 
+# Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import os
+import shutil
+import gzip
+import hashlib
+import json
+
+Import("env")
+
+# Files with this extensions are stored gzip compressed in the filesystem.
+# The webserver serves them with the corresponding content encoding.
+COMPRESS_EXTENSIONS = [ ".js", ".css", ".svg", ".txt" ]
+
+# SPIFFS limits the max. filename length, which includes the path as well.
+SPIFFS_FILENAME_LENGTH_LIMIT = 31
+
+def getVersion():
+    version = "vX.X.X"
+
+    try:
+        with open("version.json") as jsonFile:
+            data = json.load(jsonFile)
+            version = data["version"]
+    except:
+        pass
+
+    return version
+
+def stageData(srcDir, dstDir):
+    hash = hashlib.sha1()
+
+    if (True == os.path.isdir(dstDir)):
+        shutil.rmtree(dstDir)
+
+    for root, dirs, files in os.walk(srcDir):
+        dirs.sort()
+        files.sort()
+
+        for fileName in files:
+            srcFile = os.path.join(root, fileName)
+            relPath = os.path.relpath(srcFile, srcDir).replace("\\", "/")
+            dstFile = os.path.join(dstDir, relPath)
+            extension = os.path.splitext(fileName)[1].lower()
+
+            with open(srcFile, "rb") as file:
+                content = file.read()
+
+            hash.update(relPath.encode("utf-8"))
+            hash.update(content)
+
+            os.makedirs(os.path.dirname(dstFile), exist_ok=True)
+
+            if (extension in COMPRESS_EXTENSIONS) and (SPIFFS_FILENAME_LENGTH_LIMIT >= len("/" + relPath + ".gz")):
+                # The modification time is excluded, so the image is reproducible.
+                with gzip.GzipFile(dstFile + ".gz", "wb", 9, None, 0) as file:
+                    file.write(content)
+            else:
+                if (extension in COMPRESS_EXTENSIONS):
+                    print("Filename too long for compression: /" + relPath)
+
+                shutil.copyfile(srcFile, dstFile)
+
+    # The filesystem version is used by the webserver for the entity tags.
+    with open(os.path.join(dstDir, "version.json"), "w") as file:
+        json.dump({ "version": getVersion(), "hash": hash.hexdigest()[:8] }, file)
+
+    return hash.hexdigest()[:8]
+
+# Only the filesystem targets use the staged data directory.
+if (("buildfs" in COMMAND_LINE_TARGETS) or ("uploadfs" in COMMAND_LINE_TARGETS) or ("uploadfsota" in COMMAND_LINE_TARGETS)):
+    srcDataDir = env.subst("$PROJECT_DATA_DIR")
+    dstDataDir = os.path.join(env.subst("$BUILD_DIR"), "data")
+    fsHash = stageData(srcDataDir, dstDataDir)
+
+    env.Replace(PROJECT_DATA_DIR=dstDataDir)
+
+    print("Filesystem version     : " + getVersion() + " (" + fsHash + ")")
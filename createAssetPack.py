@@ -0,0 +1,117 @@
+# MIT License
+# 
+# Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Creates the asset pack with already decoded bitmaps from the data directory.
+# The asset pack is written to the flash partition with the label "assets",
+# e.g. esptool.py write_flash <partition offset> assets.bin
+#
+# Usage: python createAssetPack.py [-d <data directory>] [-o <asset pack file>]
+
+import os
+import struct
+import argparse
+
+# Pack format, see lib/Gfx/AssetPack.h
+MAGIC = b"PXAP"
+VERSION = 1
+HEADER_SIZE = 8
+NAME_SIZE = 32
+ENTRY_SIZE = NAME_SIZE + 8
+DATA_ALIGNMENT = 4
+
+def decodeBmp(content):
+    if (b"BM" != content[0:2]):
+        raise ValueError("No bitmap file.")
+
+    dataOffset, dibSize, width, height, planes, bpp, compression = struct.unpack_from("<IIiiHHI", content, 10)
+
+    if (1 != planes) or ((24 != bpp) and (32 != bpp)) or ((0 != compression) and (3 != compression)) or (0 >= width) or (0 == height):
+        raise ValueError("Unsupported bitmap format.")
+
+    isTopDown = (0 > height)
+    height = abs(height)
+    bytesPerPixel = bpp // 8
+    rowSize = ((bpp * width + 31) // 32) * 4
+    pixels = bytearray()
+
+    for y in range(height):
+        fileRow = y if (True == isTopDown) else (height - 1 - y)
+        rowOffset = dataOffset + fileRow * rowSize
+
+        for x in range(width):
+            offset = rowOffset + x * bytesPerPixel
+            blue, green, red = content[offset], content[offset + 1], content[offset + 2]
+
+            # Red, green, blue and intensity
+            pixels += bytes([red, green, blue, 0xFF])
+
+    return width, height, bytes(pixels)
+
+def createAssetPack(dataDir):
+    images = []
+
+    for root, dirs, files in os.walk(dataDir):
+        dirs.sort()
+        files.sort()
+
+        for fileName in files:
+            if (".bmp" == os.path.splitext(fileName)[1].lower()):
+                srcFile = os.path.join(root, fileName)
+                name = "/" + os.path.relpath(srcFile, dataDir).replace("\\", "/")
+
+                if (NAME_SIZE <= len(name.encode("utf-8"))):
+                    print("Filename too long for the asset pack: " + name)
+                else:
+                    with open(srcFile, "rb") as file:
+                        width, height, pixels = decodeBmp(file.read())
+
+                    images.append((name.encode("utf-8"), width, height, pixels))
+
+    # The entries are sorted by name, because the lookup uses binary search.
+    images.sort(key=lambda image: image[0])
+
+    header = MAGIC + struct.pack("<HH", VERSION, len(images))
+    table = bytearray()
+    data = bytearray()
+    offset = HEADER_SIZE + len(images) * ENTRY_SIZE
+
+    for name, width, height, pixels in images:
+        table += name.ljust(NAME_SIZE, b"\0") + struct.pack("<HHI", width, height, offset + len(data))
+        data += pixels
+
+        # The image data size is always a multiple of the alignment, because a pixel needs 4 byte.
+        data += bytes((DATA_ALIGNMENT - (len(data) % DATA_ALIGNMENT)) % DATA_ALIGNMENT)
+
+    return header + table + data, len(images)
+
+if ("__main__" == __name__):
+    parser = argparse.ArgumentParser(description="Create the asset pack with decoded bitmaps.")
+    parser.add_argument("-d", "--data", default="data", help="Data directory")
+    parser.add_argument("-o", "--output", default="assets.bin", help="Asset pack file")
+    args = parser.parse_args()
+
+    pack, count = createAssetPack(args.data)
+
+    with open(args.output, "wb") as file:
+        file.write(pack)
+
+    print("Asset pack " + args.output + " with " + str(count) + " images (" + str(len(pack)) + " bytes).")
@@ -0,0 +1,150 @@
+# MIT License
+# 
+# Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+# Creates a binary delta patch, which creates the new image from the old image.
+# The device applies it against the running partition, see lib/Utilities/DeltaPatch.h.
+#
+# Usage: python createDeltaPatch.py -s <old image> -t <new image> [-o <patch file>]
+
+import struct
+import argparse
+
+# Patch format, see lib/Utilities/DeltaPatch.h
+MAGIC = b"PXDP"
+OPCODE_END = 0
+OPCODE_COPY = 1
+OPCODE_ADD = 2
+OPCODE_DATA = 3
+
+# Size of the source blocks, which are used to find matches.
+BLOCK_SIZE = 16
+
+# A shorter exact match is cheaper inside an ADD command than a separate COPY command.
+MIN_COPY_LENGTH = 18
+
+# Max. number of different bytes, which a single ADD command bridges.
+MAX_ADD_LENGTH = 64
+
+def createIndex(source):
+    index = {}
+
+    for offset in range(0, len(source) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        block = source[offset:offset + BLOCK_SIZE]
+
+        if (block not in index):
+            index[block] = offset
+
+    return index
+
+def getExactLength(source, srcOffset, target, tgtOffset, maxLength):
+    length = 0
+
+    while (maxLength > length) and ((srcOffset + length) < len(source)) and ((tgtOffset + length) < len(target)) and (source[srcOffset + length] == target[tgtOffset + length]):
+        length += 1
+
+    return length
+
+# Determines the number of bytes until the exact match resumes, which is typical
+# for moved code with changed addresses. If it doesn't resume, it will return 0.
+def getAddLength(source, srcOffset, target, tgtOffset):
+    addLength = 0
+    length = 1
+
+    while (0 == addLength) and (MAX_ADD_LENGTH >= length) and ((srcOffset + length) < len(source)) and ((tgtOffset + length) < len(target)):
+        if (MIN_COPY_LENGTH <= getExactLength(source, srcOffset + length, target, tgtOffset + length, MIN_COPY_LENGTH)):
+            addLength = length
+
+        length += 1
+
+    # The end of the target image is bridged too.
+    if (0 == addLength) and ((tgtOffset + length) >= len(target)) and ((srcOffset + length) <= len(source)):
+        addLength = len(target) - tgtOffset
+
+    return addLength
+
+def createDeltaPatch(source, target):
+    index = createIndex(source)
+    patch = bytearray(MAGIC + struct.pack("<I", len(target)))
+    literal = bytearray()
+    tgtOffset = 0
+    srcOffset = None
+
+    while (len(target) > tgtOffset):
+        exactLength = 0
+        addLength = 0
+
+        # Continue in the source image, where the last match ended.
+        if (None != srcOffset):
+            exactLength = getExactLength(source, srcOffset, target, tgtOffset, len(target))
+
+            if (MIN_COPY_LENGTH > exactLength):
+                exactLength = 0
+                addLength = getAddLength(source, srcOffset, target, tgtOffset)
+
+        if (0 < exactLength) or (0 < addLength):
+            if (0 < len(literal)):
+                patch += struct.pack("<BI", OPCODE_DATA, len(literal)) + literal
+                literal = bytearray()
+
+            if (0 < exactLength):
+                patch += struct.pack("<BII", OPCODE_COPY, srcOffset, exactLength)
+                srcOffset += exactLength
+                tgtOffset += exactLength
+            else:
+                diff = bytes((target[tgtOffset + idx] - source[srcOffset + idx]) & 0xFF for idx in range(addLength))
+                patch += struct.pack("<BII", OPCODE_ADD, srcOffset, addLength) + diff
+                srcOffset += addLength
+                tgtOffset += addLength
+        else:
+            srcOffset = index.get(target[tgtOffset:tgtOffset + BLOCK_SIZE])
+
+            if (None == srcOffset):
+                literal.append(target[tgtOffset])
+                tgtOffset += 1
+
+    if (0 < len(literal)):
+        patch += struct.pack("<BI", OPCODE_DATA, len(literal)) + literal
+
+    patch += bytes([OPCODE_END])
+
+    return bytes(patch)
+
+if ("__main__" == __name__):
+    parser = argparse.ArgumentParser(description="Create a binary delta patch.")
+    parser.add_argument("-s", "--source", required=True, help="Old image, which runs on the device")
+    parser.add_argument("-t", "--target", required=True, help="New image")
+    parser.add_argument("-o", "--output", default="firmware.patch", help="Patch file")
+    args = parser.parse_args()
+
+    with open(args.source, "rb") as file:
+        source = file.read()
+
+    with open(args.target, "rb") as file:
+        target = file.read()
+
+    patch = createDeltaPatch(source, target)
+
+    with open(args.output, "wb") as file:
+        file.write(patch)
+
+    print("Delta patch " + args.output + " (" + str(len(patch)) + " bytes) for " + str(len(target)) + " bytes target image.")
@@ -39,9 +39,18 @@ menu.data = [{
     }, {
         "title": "Rainbow Plugin",
         "hyperRef": "/plugins/RainbowPlugin.html"
+    }, {
+        "title": "RemoteFrame Plugin",
+        "hyperRef": "/plugins/RemoteFramePlugin.html"
     }, {
         "title": "ShellyPlugS Plugin",
         "hyperRef": "/plugins/ShellyPlugSPlugin.html"
+    }, {
+        "title": "Spectrum Plugin",
+        "hyperRef": "/plugins/SpectrumPlugin.html"
+    }, {
+        "title": "Stream Plugin",
+        "hyperRef": "/plugins/StreamPlugin.html"
     }, {
         "title": "Sunrise Plugin",
         "hyperRef": "/plugins/SunrisePlugin.html"
@@ -57,6 +66,9 @@ menu.data = [{
     }, {
         "title": "Volumio Plugin",
         "hyperRef": "/plugins/VolumioPlugin.html"
+    }, {
+        "title": "VuMeter Plugin",
+        "hyperRef": "/plugins/VuMeterPlugin.html"
     }, {
         "title": "WifiStatus Plugin",
         "hyperRef": "/plugins/WifiStatusPlugin.html"
@@ -76,6 +88,9 @@ menu.data = [{
     }, {
         "title": "Debug",
         "hyperRef": "/debug.html"
+    }, {
+        "title": "Performance",
+        "hyperRef": "/perf.html"
     }, {
         "title": "File Editor",
         "hyperRef": "/edit.html"
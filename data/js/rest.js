@@ -13,14 +13,15 @@ pixelix.rest.Client = function(options) {
     }
 };
 
-pixelix.rest.Client.prototype.listFiles = function(path = "/", page = "0") {
+pixelix.rest.Client.prototype.listFiles = function(path = "/", cursor = 0, limit = 50) {
     return utils.makeRequest({
         method: "GET",
         url: this._hostname + this._baseUri + "/fs",
         isJsonResponse: true,
         parameter: {
             dir: path,
-            page: page
+            cursor: cursor,
+            limit: limit
         }
     });
 };
@@ -91,3 +92,19 @@ pixelix.rest.Client.prototype.getPluginInstances = function() {
         isJsonResponse: true
     });
 };
+
+pixelix.rest.Client.prototype.getTasks = function() {
+    return utils.makeRequest({
+        method: "GET",
+        url: this._hostname + this._baseUri + "/tasks",
+        isJsonResponse: true
+    });
+};
+
+pixelix.rest.Client.prototype.getNetStack = function() {
+    return utils.makeRequest({
+        method: "GET",
+        url: this._hostname + this._baseUri + "/netstack",
+        isJsonResponse: true
+    });
+};
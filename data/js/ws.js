@@ -31,25 +31,58 @@ pixelix.ws.getLogLevelStr = function(logLevel) {
     return str;
 };
 
+/* Max. number of commands, which are sent in one batch. */
+pixelix.ws.MAX_BATCH_CMDS = 16;
+
+/* Max. number of pending messages, accepted by the server per client. */
+pixelix.ws.MAX_PENDING_BIN_CMDS = 2;
+
+/* Binary command ids */
+pixelix.ws.BIN_CMD_GETDISP      = 0x80;
+pixelix.ws.BIN_CMD_BRIGHTNESS   = 0x81;
+
+/* Binary response status */
+pixelix.ws.BIN_STATUS_ACK       = 0;
+
+/* Binary frame type of a metrics snapshot */
+pixelix.ws.FRAME_TYPE_METRICS   = 0x40;
+
 pixelix.ws.Client = function(options) {
 
     this._socket        = null;
     this._cmdQueue      = [];
-    this._pendingCmd    = null;
+    this._pendingCmds   = [];
+    this._pendingBinCmds = [];
+    this._binCmdQueue   = [];
     this._onEvent       = null;
+    this._onDisplayFrame = null;
+    this._onMetricsFrame = null;
 
     this._sendCmdFromQueue = function() {
         var msg = "";
+        var cmd = null;
+
+        /* All queued commands are sent as one batch, the responses
+         * will be received in the same order.
+         */
+        while((0 < this._cmdQueue.length) &&
+              (pixelix.ws.MAX_BATCH_CMDS > this._pendingCmds.length)) {
+            cmd = this._cmdQueue.shift();
 
-        if (0 < this._cmdQueue.length) {
-            this._pendingCmd = this._cmdQueue.shift();
+            if (0 < this._pendingCmds.length) {
+                msg += "\n";
+            }
 
-            msg = this._pendingCmd.name;
+            msg += cmd.name;
 
-            if (null !== this._pendingCmd.par) {
-                msg += ";" + this._pendingCmd.par;
+            if (null !== cmd.par) {
+                msg += ";" + cmd.par;
             }
 
+            this._pendingCmds.push(cmd);
+        }
+
+        if (0 < this._pendingCmds.length) {
             console.info("Websocket command: " + msg);
             this._socket.send(msg);
         }
@@ -59,11 +92,37 @@ pixelix.ws.Client = function(options) {
 
         this._cmdQueue.push(cmd);
 
-        if (null === this._pendingCmd) {
+        if (0 === this._pendingCmds.length) {
             this._sendCmdFromQueue();
         }
     };
 
+    this._sendBinCmdFromQueue = function() {
+        var buffer  = null;
+        var index   = 0;
+        var cmd     = null;
+
+        /* Don't exceed the number of pending messages the server accepts. */
+        while((0 < this._binCmdQueue.length) &&
+              (pixelix.ws.MAX_PENDING_BIN_CMDS > this._pendingBinCmds.length)) {
+            cmd = this._binCmdQueue.shift();
+            buffer = new Uint8Array(1 + cmd.par.length);
+
+            buffer[0] = cmd.id;
+            for(index = 0; index < cmd.par.length; ++index) {
+                buffer[1 + index] = cmd.par[index];
+            }
+
+            this._pendingBinCmds.push(cmd);
+            this._socket.send(buffer.buffer);
+        }
+    };
+
+    this._sendBinCmd = function(cmd) {
+        this._binCmdQueue.push(cmd);
+        this._sendBinCmdFromQueue();
+    };
+
     this._sendEvt = function(evt) {
         if (null !== this._onEvent) {
             this._onEvent(evt);
@@ -90,6 +149,7 @@ pixelix.ws.Client.prototype.connect = function(options) {
             try {
                 wsUrl = options.protocol + "://" + options.hostname + ":" + options.port + options.endpoint;
                 this._socket = new WebSocket(wsUrl);
+                this._socket.binaryType = "arraybuffer";
 
                 this._socket.onopen = function(openEvent) {
                     console.debug("Websocket opened.");
@@ -106,8 +166,12 @@ pixelix.ws.Client.prototype.connect = function(options) {
                 };
 
                 this._socket.onmessage = function(messageEvent) {
-                    console.debug("Websocket message: " + messageEvent.data);
-                    this._onMessage(messageEvent.data);
+                    if ("string" === typeof messageEvent.data) {
+                        console.debug("Websocket message: " + messageEvent.data);
+                        this._onMessage(messageEvent.data);
+                    } else {
+                        this._onBinaryMessage(messageEvent.data);
+                    }
                 }.bind(this);
 
             } catch (exception) {
@@ -137,84 +201,54 @@ pixelix.ws.Client.prototype.disconnect = function(options) {
 
 pixelix.ws.Client.prototype._onMessage = function(msg) {
     var data    = msg.split(";");
-    var status  = data.shift();
+    var status  = data[0];
     var rsp     = {};
+    var rsps    = [];
     var index   = 0;
+    var cmd     = null;
 
     if ("EVT" === status) {
-        rsp.timestamp = parseInt(data[0]);
-        rsp.level = parseInt(data[1]);
-        rsp.filename = data[2].substring(1, data[2].length - 1);
-        rsp.line = parseInt(data[3]);
-        rsp.text = data[4].substring(1, data[4].length - 1);
-        this._sendEvt(rsp);
+        /* Several events are separated by a line feed. */
+        rsps = msg.split("\n");
+        for(index = 0; index < rsps.length; ++index) {
+            data = rsps[index].split(";");
+            data.shift();
+            rsp = {};
+            rsp.timestamp = parseInt(data[0]);
+            rsp.level = parseInt(data[1]);
+            rsp.filename = data[2].substring(1, data[2].length - 1);
+            rsp.line = parseInt(data[3]);
+            rsp.text = data[4].substring(1, data[4].length - 1);
+            this._sendEvt(rsp);
+        }
+        /* Events don't complete a pending command. */
+        return;
     } else {
-        if (null === this._pendingCmd) {
+        if (0 === this._pendingCmds.length) {
             console.error("No pending command, but response received.");
-        } else if ("ACK" === status) {
-            if ("GETDISP" === this._pendingCmd.name) {
-                rsp.slotId = data.shift();
-                rsp.data = [];
-                for(index = 0; index < data.length; ++index) {
-                    rsp.data.push(parseInt(data[index], 16));
-                }
-                this._pendingCmd.resolve(rsp);
-            } else if ("BRIGHTNESS" === this._pendingCmd.name) {
-                rsp.brightness = parseInt(data[0]);
-                rsp.automaticBrightnessControl = (1 === parseInt(data[1])) ? true : false;
-                this._pendingCmd.resolve(rsp);
-            } else if ("BUTTON" === this._pendingCmd.name) {
-                this._pendingCmd.resolve(rsp);
-            } else if ("EFFECT" === this._pendingCmd.name) {
-                rsp.fadeEffect = parseInt(data[0]);
-                this._pendingCmd.resolve(rsp);
-            } else if ("INSTALL" === this._pendingCmd.name) {
-                rsp.slotId = parseInt(data[0]);
-                rsp.uid = parseInt(data[1]);
-                this._pendingCmd.resolve(rsp);
-            } else if ("IPERF" === this._pendingCmd.name) {
-                rsp.isEnabled = (0 === parseInt(data[0])) ? false : true;
-                this._pendingCmd.resolve(rsp);
-            } else if ("LOG" === this._pendingCmd.name) {
-                rsp.isEnabled = (0 === parseInt(data[0])) ? false : true;
-                this._pendingCmd.resolve(rsp);
-            } else if ("MOVE" === this._pendingCmd.name) {
-                this._pendingCmd.resolve(rsp);
-            } else if ("PLUGINS" === this._pendingCmd.name) {
-                rsp.plugins = [];
-                for(index = 0; index < data.length; ++index) {
-                    rsp.plugins.push(data[index].substring(1, data[index].length - 1));
-                }
-                this._pendingCmd.resolve(rsp);
-            } else if ("RESET" === this._pendingCmd.name) {
-                this._pendingCmd.resolve(rsp);
-            } else if ("SLOT_DURATION" === this._pendingCmd.name) {
-                rsp.duration = parseInt(data[0]);
-                this._pendingCmd.resolve(rsp);
-            } else if ("SLOTS" === this._pendingCmd.name) {
-                rsp.maxSlots = parseInt(data.shift());
-                rsp.slots = [];
-                for(index = 0; index < (data.length / 4); ++index) {
-                    rsp.slots.push({
-                        name: data[4 * index + 0].substring(1, data[4 * index + 0].length - 1),
-                        uid: parseInt(data[4 * index + 1]),
-                        isLocked: (0 == parseInt(data[4 * index + 2])) ? false : true,
-                        duration: parseInt(data[4 * index + 3])
-                    });
-                }
-                this._pendingCmd.resolve(rsp);
-            } else if ("UNINSTALL" === this._pendingCmd.name) {
-                this._pendingCmd.resolve(rsp);
+        } else {
+            /* The responses of a batch are separated by a line feed. */
+            if (1 === this._pendingCmds.length) {
+                rsps.push(msg);
             } else {
-                console.error("Unknown command: " + this._pendingCmd.name);
-                this._pendingCmd.reject();
+                rsps = msg.split("\n");
+            }
+
+            for(index = 0; index < this._pendingCmds.length; ++index) {
+                cmd = this._pendingCmds[index];
+
+                if (index < rsps.length) {
+                    data = rsps[index].split(";");
+                    status = data.shift();
+                    this._handleRsp(cmd, status, data);
+                } else {
+                    console.error("Command " + cmd.name + " got no response.");
+                    cmd.reject();
+                }
             }
-        } else {
-            console.error("Command " + this._pendingCmd.name + " failed.");
-            this._pendingCmd.reject();
         }
 
-        this._pendingCmd = null;
+        this._pendingCmds = [];
     }
 
     this._sendCmdFromQueue();
@@ -222,14 +256,335 @@ pixelix.ws.Client.prototype._onMessage = function(msg) {
     return;
 };
 
-pixelix.ws.Client.prototype.getDisplayContent = function() {
+pixelix.ws.Client.prototype._handleRsp = function(cmd, status, data) {
+    var rsp     = {};
+    var index   = 0;
+
+    if ("ACK" === status) {
+        if ("GETDISP" === cmd.name) {
+            rsp.slotId = data.shift();
+            rsp.data = [];
+            for(index = 0; index < data.length; ++index) {
+                rsp.data.push(parseInt(data[index], 16));
+            }
+            cmd.resolve(rsp);
+        } else if ("DISPSTREAM" === cmd.name) {
+            if (2 <= data.length) {
+                rsp.width = parseInt(data[0]);
+                rsp.height = parseInt(data[1]);
+            }
+            cmd.resolve(rsp);
+        } else if ("METRICSTREAM" === cmd.name) {
+            cmd.resolve(rsp);
+        } else if ("BRIGHTNESS" === cmd.name) {
+            rsp.brightness = parseInt(data[0]);
+            rsp.automaticBrightnessControl = (1 === parseInt(data[1])) ? true : false;
+            cmd.resolve(rsp);
+        } else if ("BUTTON" === cmd.name) {
+            cmd.resolve(rsp);
+        } else if ("EFFECT" === cmd.name) {
+            rsp.fadeEffect = parseInt(data[0]);
+            cmd.resolve(rsp);
+        } else if ("INSTALL" === cmd.name) {
+            rsp.slotId = parseInt(data[0]);
+            rsp.uid = parseInt(data[1]);
+            rsp.plugins = [];
+            for(index = 0; index < (data.length / 2); ++index) {
+                rsp.plugins.push({
+                    slotId: parseInt(data[2 * index + 0]),
+                    uid: parseInt(data[2 * index + 1])
+                });
+            }
+            cmd.resolve(rsp);
+        } else if ("IPERF" === cmd.name) {
+            rsp.isEnabled = (0 === parseInt(data[0])) ? false : true;
+            cmd.resolve(rsp);
+        } else if ("LOG" === cmd.name) {
+            rsp.isEnabled = (0 === parseInt(data[0])) ? false : true;
+            cmd.resolve(rsp);
+        } else if ("MOVE" === cmd.name) {
+            cmd.resolve(rsp);
+        } else if ("PLUGINS" === cmd.name) {
+            rsp.plugins = [];
+            for(index = 0; index < data.length; ++index) {
+                rsp.plugins.push(data[index].substring(1, data[index].length - 1));
+            }
+            cmd.resolve(rsp);
+        } else if ("RESET" === cmd.name) {
+            cmd.resolve(rsp);
+        } else if ("SLOT_DURATION" === cmd.name) {
+            rsp.duration = parseInt(data[0]);
+            cmd.resolve(rsp);
+        } else if ("SLOT_SCHEDULE" === cmd.name) {
+            rsp.weight = parseInt(data[0]);
+            rsp.timeBegin = parseInt(data[1]);
+            rsp.timeEnd = parseInt(data[2]);
+            cmd.resolve(rsp);
+        } else if ("SLOTS" === cmd.name) {
+            rsp.maxSlots = parseInt(data.shift());
+            rsp.slots = [];
+            for(index = 0; index < (data.length / 4); ++index) {
+                rsp.slots.push({
+                    name: data[4 * index + 0].substring(1, data[4 * index + 0].length - 1),
+                    uid: parseInt(data[4 * index + 1]),
+                    isLocked: (0 == parseInt(data[4 * index + 2])) ? false : true,
+                    duration: parseInt(data[4 * index + 3])
+                });
+            }
+            cmd.resolve(rsp);
+        } else if ("UNINSTALL" === cmd.name) {
+            cmd.resolve(rsp);
+        } else {
+            console.error("Unknown command: " + cmd.name);
+            cmd.reject();
+        }
+    } else {
+        console.error("Command " + cmd.name + " failed.");
+        cmd.reject();
+    }
+
+    return;
+};
+
+pixelix.ws.Client.prototype._onBinaryMessage = function(data) {
+    var view        = new DataView(data);
+    var frame       = {};
+    var format      = 0;
+    var offset      = 3;
+    var index       = 0;
+    var count       = 0;
+    var color       = 0;
+
+    /* Response of a binary command? */
+    if ((1 <= view.byteLength) &&
+        (pixelix.ws.BIN_CMD_GETDISP <= view.getUint8(0))) {
+        this._onBinaryRsp(view);
+        return;
+    }
+
+    /* Metrics snapshot? */
+    if ((1 <= view.byteLength) &&
+        (pixelix.ws.FRAME_TYPE_METRICS === view.getUint8(0))) {
+        this._onMetrics(view);
+        return;
+    }
+
+    if ((null === this._onDisplayFrame) ||
+        (3 > view.byteLength)) {
+        return;
+    }
+
+    frame.isKeyFrame    = (0 === view.getUint8(0)) ? true : false;
+    format              = view.getUint8(1);
+    frame.slotId        = view.getUint8(2);
+    frame.pixels        = [];
+
+    /* Pixel runs */
+    while((offset + 4) <= view.byteLength) {
+        index   = view.getUint16(offset, true);
+        count   = view.getUint16(offset + 2, true);
+        offset += 4;
+
+        while((0 < count) && (offset < view.byteLength)) {
+            /* RGB565 */
+            if (1 === format) {
+                color = view.getUint16(offset, true);
+                color = (((color >> 11) & 0x1f) << 19) | (((color >> 5) & 0x3f) << 10) | ((color & 0x1f) << 3);
+                offset += 2;
+            /* RGB888 */
+            } else {
+                color = (view.getUint8(offset) << 16) | (view.getUint8(offset + 1) << 8) | view.getUint8(offset + 2);
+                offset += 3;
+            }
+
+            frame.pixels.push({
+                index: index,
+                color: color
+            });
+
+            ++index;
+            --count;
+        }
+    }
+
+    this._onDisplayFrame(frame);
+
+    return;
+};
+
+pixelix.ws.Client.prototype._onMetrics = function(view) {
+    var metrics = {};
+    var slotCnt = 0;
+    var offset  = 38;
+    var index   = 0;
+
+    if ((null === this._onMetricsFrame) ||
+        (offset > view.byteLength)) {
+        return;
+    }
+
+    slotCnt                 = view.getUint8(1);
+    metrics.timestamp       = view.getUint32(2, true);
+    metrics.frames          = view.getUint32(6, true);
+    metrics.frameTimeUs     = view.getUint32(10, true);
+    metrics.maxFrameTimeUs  = view.getUint32(14, true);
+    metrics.skippedFrames   = view.getUint32(18, true);
+    metrics.heapFree        = view.getUint32(22, true);
+    metrics.heapLargestBlock = view.getUint32(26, true);
+    metrics.tcpPcbUsed      = view.getUint16(30, true);
+    metrics.tcpPcbSize      = view.getUint16(32, true);
+    metrics.pbufPoolUsed    = view.getUint16(34, true);
+    metrics.pbufPoolSize    = view.getUint16(36, true);
+    metrics.slots           = [];
+
+    for(index = 0; (index < slotCnt) && ((offset + 10) <= view.byteLength); ++index) {
+        metrics.slots.push({
+            uid: view.getUint16(offset, true),
+            processUs: view.getUint32(offset + 2, true),
+            updateUs: view.getUint32(offset + 6, true)
+        });
+        offset += 10;
+    }
+
+    this._onMetricsFrame(metrics);
+
+    return;
+};
+
+pixelix.ws.Client.prototype._onBinaryRsp = function(view) {
+    var cmd     = null;
+    var rsp     = {};
+    var offset  = 3;
+
+    if (0 === this._pendingBinCmds.length) {
+        console.error("No pending binary command, but response received.");
+    } else {
+        cmd = this._pendingBinCmds.shift();
+
+        if ((2 > view.byteLength) ||
+            (cmd.id !== view.getUint8(0)) ||
+            (pixelix.ws.BIN_STATUS_ACK !== view.getUint8(1))) {
+            console.error("Binary command " + cmd.id + " failed.");
+            cmd.reject();
+        } else if (pixelix.ws.BIN_CMD_GETDISP === cmd.id) {
+            rsp.slotId = view.getUint8(2);
+            rsp.data = [];
+            while((offset + 3) <= view.byteLength) {
+                rsp.data.push((view.getUint8(offset) << 16) | (view.getUint8(offset + 1) << 8) | view.getUint8(offset + 2));
+                offset += 3;
+            }
+            cmd.resolve(rsp);
+        } else if (pixelix.ws.BIN_CMD_BRIGHTNESS === cmd.id) {
+            rsp.brightness = view.getUint8(2);
+            rsp.automaticBrightnessControl = (1 === view.getUint8(3)) ? true : false;
+            cmd.resolve(rsp);
+        } else {
+            console.error("Unknown binary command: " + cmd.id);
+            cmd.reject();
+        }
+    }
+
+    this._sendBinCmdFromQueue();
+
+    return;
+};
+
+pixelix.ws.Client.prototype.subscribeDisplay = function(options) {
     return new Promise(function(resolve, reject) {
+        var par = "1";
+
         if (null === this._socket) {
             reject();
+        } else if ("function" !== typeof options.onFrame) {
+            reject();
         } else {
+            if ("number" === typeof options.format) {
+                par += ";" + options.format;
+
+                if ("number" === typeof options.fps) {
+                    par += ";" + options.fps;
+                }
+            }
+
+            this._onDisplayFrame = options.onFrame;
+
             this._sendCmd({
-                name: "GETDISP",
-                par: null,
+                name: "DISPSTREAM",
+                par: par,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.unsubscribeDisplay = function() {
+    return new Promise(function(resolve, reject) {
+        if (null === this._socket) {
+            reject();
+        } else {
+            this._onDisplayFrame = null;
+
+            this._sendCmd({
+                name: "DISPSTREAM",
+                par: "0",
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.subscribeMetrics = function(options) {
+    return new Promise(function(resolve, reject) {
+        var par = "1";
+
+        if (null === this._socket) {
+            reject();
+        } else if ("function" !== typeof options.onMetrics) {
+            reject();
+        } else {
+            if ("number" === typeof options.period) {
+                par += ";" + options.period;
+            }
+
+            this._onMetricsFrame = options.onMetrics;
+
+            this._sendCmd({
+                name: "METRICSTREAM",
+                par: par,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.unsubscribeMetrics = function() {
+    return new Promise(function(resolve, reject) {
+        if (null === this._socket) {
+            reject();
+        } else {
+            this._onMetricsFrame = null;
+
+            this._sendCmd({
+                name: "METRICSTREAM",
+                par: "0",
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.getDisplayContent = function() {
+    return new Promise(function(resolve, reject) {
+        if (null === this._socket) {
+            reject();
+        } else {
+            this._sendBinCmd({
+                id: pixelix.ws.BIN_CMD_GETDISP,
+                par: [],
                 resolve: resolve,
                 reject: reject
             });
@@ -272,9 +627,9 @@ pixelix.ws.Client.prototype.getBrightness = function() {
         if (null === this._socket) {
             reject();
         } else {
-            this._sendCmd({
-                name: "BRIGHTNESS",
-                par: null,
+            this._sendBinCmd({
+                id: pixelix.ws.BIN_CMD_BRIGHTNESS,
+                par: [],
                 resolve: resolve,
                 reject: reject
             });
@@ -284,7 +639,7 @@ pixelix.ws.Client.prototype.getBrightness = function() {
 
 pixelix.ws.Client.prototype.setBrightness = function(options) {
     return new Promise(function(resolve, reject) {
-        var par = "";
+        var par = [];
 
         if (null === this._socket) {
             reject();
@@ -292,15 +647,14 @@ pixelix.ws.Client.prototype.setBrightness = function(options) {
             reject();
         } else {
 
-            par += options.brightness;
+            par.push(options.brightness & 0xff);
 
             if ("boolean" === typeof options.automaticBrightnessControl) {
-                par += ";";
-                par += (false == options.automaticBrightnessControl) ? 0 : 1;
+                par.push((false == options.automaticBrightnessControl) ? 0 : 1);
             }
 
-            this._sendCmd({
-                name: "BRIGHTNESS",
+            this._sendBinCmd({
+                id: pixelix.ws.BIN_CMD_BRIGHTNESS,
                 par: par,
                 resolve: resolve,
                 reject: reject
@@ -328,6 +682,17 @@ pixelix.ws.Client.prototype.install = function(options) {
     return new Promise(function(resolve, reject) {
         if (null === this._socket) {
             reject();
+        } else if ((true === Array.isArray(options.pluginNames)) &&
+                   (0 < options.pluginNames.length)) {
+            /* Several plugins are installed at once. */
+            this._sendCmd({
+                name: "INSTALL",
+                par: options.pluginNames.map(function(pluginName) {
+                    return "\"" + pluginName + "\"";
+                }).join(";"),
+                resolve: resolve,
+                reject: reject
+            });
         } else if ("string" !== typeof options.pluginName) {
             reject();
         } else {
@@ -458,6 +823,56 @@ pixelix.ws.Client.prototype.setSlotDuration = function(options) {
     }.bind(this));
 };
 
+pixelix.ws.Client.prototype.getSlotSchedule = function(options) {
+    return new Promise(function(resolve, reject) {
+        if (null === this._socket) {
+            reject();
+        } else if ("number" !== typeof options.slotId) {
+            reject();
+        } else {
+            this._sendCmd({
+                name: "SLOT_SCHEDULE",
+                par: options.slotId,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.setSlotSchedule = function(options) {
+    return new Promise(function(resolve, reject) {
+        var par = "";
+        if (null === this._socket) {
+            reject();
+        } else if ("number" !== typeof options.slotId) {
+            reject();
+        } else if ("number" !== typeof options.weight) {
+            reject();
+        } else if ("number" !== typeof options.timeBegin) {
+            reject();
+        } else if ("number" !== typeof options.timeEnd) {
+            reject();
+        } else {
+
+            par += options.slotId;
+            par += ";";
+            par += options.weight;
+            par += ";";
+            par += options.timeBegin;
+            par += ";";
+            par += options.timeEnd;
+
+            this._sendCmd({
+                name: "SLOT_SCHEDULE",
+                par: par,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
 pixelix.ws.Client.prototype.getIperf = function(options) {
     return new Promise(function(resolve, reject) {
         if (null === this._socket) {
@@ -0,0 +1,82 @@
+# MIT License
+# 
+# Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import os
+import gzip
+
+Import("env")
+
+# Files, which are embedded gzip compressed into the firmware.
+# Each one is converted to a header with a byte array in program memory.
+# Source file, destination header, array name
+EMBEDDED_FILES = [
+    ( "embedded/captivePortal.html", "src/Web/CaptivePortalPage.h", "CAPTIVE_PORTAL_PAGE" )
+]
+
+def embedFile(srcFile, dstFile, name):
+    guard = "__" + name + "_H__"
+
+    with open(os.path.join(projectDir, srcFile), "rb") as file:
+        # The modification time is excluded, so the header is reproducible.
+        content = gzip.compress(file.read(), 9, mtime=0)
+
+    lines = []
+    lines.append("/* Generated by embedData.py from " + srcFile + ", don't edit. */")
+    lines.append("")
+    lines.append("#ifndef " + guard)
+    lines.append("#define " + guard)
+    lines.append("")
+    lines.append("#include <stdint.h>")
+    lines.append("#include <pgmspace.h>")
+    lines.append("")
+    lines.append("/** Size of " + name + " in byte. */")
+    lines.append("static const size_t " + name + "_SIZE = " + str(len(content)) + "U;")
+    lines.append("")
+    lines.append("/** " + os.path.basename(srcFile) + ", gzip compressed. */")
+    lines.append("static const uint8_t " + name + "[] PROGMEM = {")
+
+    for index in range(0, len(content), 16):
+        lines.append("    " + ", ".join("0x%02x" % value for value in content[index:index + 16]) + ",")
+
+    lines.append("};")
+    lines.append("")
+    lines.append("#endif  /* " + guard + " */")
+    lines.append("")
+
+    header = "\n".join(lines)
+    dstFile = os.path.join(projectDir, dstFile)
+
+    # Write only on change, otherwise every build would recompile the users.
+    if (True == os.path.isfile(dstFile)):
+        with open(dstFile, "r") as file:
+            if (header == file.read()):
+                return
+
+    with open(dstFile, "w") as file:
+        file.write(header)
+
+    print("Embedded: " + srcFile + " (" + str(len(content)) + " bytes)")
+
+projectDir = env.subst("$PROJECT_DIR")
+
+for srcFile, dstFile, name in EMBEDDED_FILES:
+    embedFile(srcFile, dstFile, name)
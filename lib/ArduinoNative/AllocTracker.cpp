@@ -0,0 +1,277 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap allocation tracker for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "AllocTracker.h"
+
+#include <stdlib.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+#if (0 != ALLOC_TRACKING)
+
+static void* allocate(size_t size);
+static void release(void* ptr);
+
+#if defined(__GLIBC__)
+
+/* The glibc internal allocator is used directly, because malloc() itself is replaced. */
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t num, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void __libc_free(void* ptr);
+
+#endif  /* defined(__GLIBC__) */
+
+#endif  /* (0 != ALLOC_TRACKING) */
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of allocations since last reset */
+static uint32_t gAllocCount = 0U;
+
+/** Number of allocated bytes since last reset */
+static size_t   gAllocBytes = 0U;
+
+/** Number of releases since last reset */
+static uint32_t gFreeCount  = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void AllocTracker::reset()
+{
+    gAllocCount = 0U;
+    gAllocBytes = 0U;
+    gFreeCount  = 0U;
+}
+
+uint32_t AllocTracker::getAllocCount()
+{
+    return gAllocCount;
+}
+
+size_t AllocTracker::getAllocBytes()
+{
+    return gAllocBytes;
+}
+
+uint32_t AllocTracker::getFreeCount()
+{
+    return gFreeCount;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+#if (0 != ALLOC_TRACKING)
+
+void* operator new(size_t size)
+{
+    void* ptr = allocate(size);
+
+    if (nullptr == ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t& tag) noexcept
+{
+    (void)tag;
+
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+    (void)tag;
+
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    release(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    release(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept
+{
+    (void)size;
+
+    release(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept
+{
+    (void)size;
+
+    release(ptr);
+}
+
+#if defined(__GLIBC__)
+
+extern "C" void* malloc(size_t size)
+{
+    return allocate(size);
+}
+
+extern "C" void* calloc(size_t num, size_t size)
+{
+    void* ptr = __libc_calloc(num, size);
+
+    if (nullptr != ptr)
+    {
+        ++gAllocCount;
+        gAllocBytes += num * size;
+    }
+
+    return ptr;
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    void* newPtr = __libc_realloc(ptr, size);
+
+    if (nullptr != newPtr)
+    {
+        ++gAllocCount;
+        gAllocBytes += size;
+
+        if (nullptr != ptr)
+        {
+            ++gFreeCount;
+        }
+    }
+
+    return newPtr;
+}
+
+extern "C" void free(void* ptr)
+{
+    release(ptr);
+}
+
+#endif  /* defined(__GLIBC__) */
+
+#endif  /* (0 != ALLOC_TRACKING) */
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#if (0 != ALLOC_TRACKING)
+
+/**
+ * Allocate memory from the heap and count it.
+ *
+ * @param[in] size  Size in bytes
+ *
+ * @return If successful, it will return the memory otherwise nullptr.
+ */
+static void* allocate(size_t size)
+{
+#if defined(__GLIBC__)
+    void* ptr = __libc_malloc(size);
+#else   /* defined(__GLIBC__) */
+    void* ptr = ::malloc(size);
+#endif  /* defined(__GLIBC__) */
+
+    if (nullptr != ptr)
+    {
+        ++gAllocCount;
+        gAllocBytes += size;
+    }
+
+    return ptr;
+}
+
+/**
+ * Release memory to the heap and count it.
+ *
+ * @param[in] ptr   Memory, which to release
+ */
+static void release(void* ptr)
+{
+    if (nullptr != ptr)
+    {
+        ++gFreeCount;
+
+#if defined(__GLIBC__)
+        __libc_free(ptr);
+#else   /* defined(__GLIBC__) */
+        ::free(ptr);
+#endif  /* defined(__GLIBC__) */
+    }
+}
+
+#endif  /* (0 != ALLOC_TRACKING) */
@@ -0,0 +1,126 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap allocation tracker for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef __ALLOC_TRACKER_H__
+#define __ALLOC_TRACKER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * If enabled, the global new/delete operators (and on glibc the malloc family)
+ * are replaced to count every heap allocation.
+ */
+#ifndef ALLOC_TRACKING
+#define ALLOC_TRACKING  (0)
+#endif  /* ALLOC_TRACKING */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Counts the heap allocations of the native test program. Reset it before
+ * the code under test runs and check the counters afterwards, e.g. to
+ * verify that rendering a frame doesn't allocate at all.
+ */
+class AllocTracker
+{
+public:
+
+    /**
+     * Is the allocation tracking available?
+     * It depends on the ALLOC_TRACKING compile switch.
+     *
+     * @return If available, it will return true otherwise false.
+     */
+    static bool isEnabled()
+    {
+        return (0 != ALLOC_TRACKING);
+    }
+
+    /**
+     * Reset all counters.
+     */
+    static void reset();
+
+    /**
+     * Get number of allocations since last reset.
+     *
+     * @return Number of allocations
+     */
+    static uint32_t getAllocCount();
+
+    /**
+     * Get number of allocated bytes since last reset.
+     *
+     * @return Number of allocated bytes
+     */
+    static size_t getAllocBytes();
+
+    /**
+     * Get number of releases since last reset.
+     *
+     * @return Number of releases
+     */
+    static uint32_t getFreeCount();
+
+private:
+
+    AllocTracker();
+    ~AllocTracker();
+    AllocTracker(const AllocTracker& tracker);
+    AllocTracker& operator=(const AllocTracker& tracker);
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __ALLOC_TRACKER_H__ */
+
+/** @} */
@@ -67,13 +67,44 @@
 /** Arduino boolean */
 typedef bool boolean;
 
+/**
+ * Native clock, which is used by millis(). If it is fixed, millis() returns
+ * the fixed time instead of the process time. This makes time dependent
+ * rendering deterministic, e.g. to replay recorded frames.
+ */
+struct NativeClock
+{
+    bool            isFixed;    /**< Is the clock fixed? */
+    unsigned long   now;        /**< Fixed time in ms */
+};
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
 
+/**
+ * Get the native clock, which is shared by all translation units.
+ *
+ * @return Native clock
+ */
+inline NativeClock& getNativeClock()
+{
+    static NativeClock nativeClock = { false, 0UL };
+
+    return nativeClock;
+}
+
 static unsigned long millis()
 {
-    clock_t now = clock();
+    const NativeClock&  nativeClock = getNativeClock();
+    clock_t             now         = 0;
+
+    if (true == nativeClock.isFixed)
+    {
+        return nativeClock.now;
+    }
+
+    now = clock();
 
     return (now * 1000UL) / CLOCKS_PER_SEC;
 }
@@ -0,0 +1,201 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Asset pack
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "AssetPack.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/* The image data is used as it is, therefore a pixel must be stored in exactly 4 byte. */
+static_assert(4U == sizeof(Color), "Color layout doesn't match the asset pack format.");
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Magic number at the begin of a pack: "PXAP" */
+static const uint8_t    MAGIC[]     = { 'P', 'X', 'A', 'P' };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool AssetPack::attach(const uint8_t* data, size_t size)
+{
+    bool status = false;
+
+    detach();
+
+    if (true == isValid(data, size))
+    {
+        m_data  = data;
+        m_size  = size;
+        m_count = readUInt16(&data[6]);
+
+        status = true;
+    }
+
+    return status;
+}
+
+void AssetPack::detach()
+{
+    m_data  = nullptr;
+    m_size  = 0U;
+    m_count = 0U;
+
+    return;
+}
+
+const Color* AssetPack::find(const String& name, uint16_t& width, uint16_t& height) const
+{
+    const Color*    image   = nullptr;
+    uint16_t        low     = 0U;
+    uint16_t        high    = m_count;
+
+    /* The entries are sorted by name, therefore use binary search. */
+    while((nullptr == image) && (low < high))
+    {
+        const uint16_t  MID     = low + ((high - low) / 2U);
+        const uint8_t*  ENTRY   = &m_data[HEADER_SIZE + (MID * ENTRY_SIZE)];
+        int             result  = strcmp(name.c_str(), getName(ENTRY));
+
+        if (0 == result)
+        {
+            width   = readUInt16(&ENTRY[NAME_SIZE + 0U]);
+            height  = readUInt16(&ENTRY[NAME_SIZE + 2U]);
+            image   = reinterpret_cast<const Color*>(&m_data[readUInt32(&ENTRY[NAME_SIZE + 4U])]);
+        }
+        else if (0 > result)
+        {
+            high = MID;
+        }
+        else
+        {
+            low = MID + 1U;
+        }
+    }
+
+    return image;
+}
+
+bool AssetPack::contains(const Color* image) const
+{
+    bool            isContained = false;
+    const uint8_t*  ptr         = reinterpret_cast<const uint8_t*>(image);
+
+    if ((nullptr != m_data) &&
+        (m_data <= ptr) &&
+        (&m_data[m_size] > ptr))
+    {
+        isContained = true;
+    }
+
+    return isContained;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool AssetPack::isValid(const uint8_t* data, size_t size)
+{
+    bool isValid = false;
+
+    if ((nullptr != data) &&
+        (0U == (reinterpret_cast<uintptr_t>(data) % DATA_ALIGNMENT)) &&
+        (HEADER_SIZE <= size) &&
+        (0 == memcmp(data, MAGIC, sizeof(MAGIC))) &&
+        (VERSION == readUInt16(&data[4])))
+    {
+        const uint16_t  COUNT       = readUInt16(&data[6]);
+        const size_t    TABLE_END   = HEADER_SIZE + (static_cast<size_t>(COUNT) * ENTRY_SIZE);
+        uint16_t        index       = 0U;
+        const char*     prevName    = nullptr;
+
+        isValid = (TABLE_END <= size);
+
+        /* Every entry must be consistent, so no check is necessary anymore during lookup. */
+        for(index = 0U; (true == isValid) && (index < COUNT); ++index)
+        {
+            const uint8_t*  ENTRY   = &data[HEADER_SIZE + (index * ENTRY_SIZE)];
+            const uint64_t  WIDTH   = readUInt16(&ENTRY[NAME_SIZE + 0U]);
+            const uint64_t  HEIGHT  = readUInt16(&ENTRY[NAME_SIZE + 2U]);
+            const uint64_t  OFFSET  = readUInt32(&ENTRY[NAME_SIZE + 4U]);
+            const char*     NAME    = getName(ENTRY);
+
+            if ((0U == ENTRY[0]) ||
+                (NAME_SIZE == strnlen(NAME, NAME_SIZE)) ||
+                ((nullptr != prevName) && (0 <= strcmp(prevName, NAME))) ||
+                (0U != (OFFSET % DATA_ALIGNMENT)) ||
+                (TABLE_END > OFFSET) ||
+                (size < (OFFSET + (WIDTH * HEIGHT * sizeof(Color)))))
+            {
+                isValid = false;
+            }
+
+            prevName = NAME;
+        }
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
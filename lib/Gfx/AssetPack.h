@@ -0,0 +1,232 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Asset pack
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __ASSET_PACK_H__
+#define __ASSET_PACK_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <WString.h>
+#include <Color.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The asset pack provides already decoded images, which are used directly
+ * from read-only memory, e.g. a memory mapped flash partition. They don't
+ * need to be read from filesystem, decoded and copied to RAM.
+ *
+ * Pack format (little endian):
+ * - Header: magic "PXAP" (4 byte), version (2 byte), number of entries (2 byte).
+ * - Entries, sorted by name in ascending order:
+ *   name incl. termination (32 byte), width (2 byte), height (2 byte),
+ *   offset of the image data from the begin of the pack (4 byte).
+ * - Image data, every image aligned to 4 byte: One Color per pixel,
+ *   which is red, green, blue and intensity (4 byte), row by row.
+ *
+ * The pack is attached once during startup and must not be changed while
+ * it is attached.
+ */
+class AssetPack
+{
+public:
+
+    /** Pack format version */
+    static const uint16_t   VERSION         = 1U;
+
+    /** Header size in byte */
+    static const size_t     HEADER_SIZE     = 8U;
+
+    /** Max. name length in byte, incl. string termination. */
+    static const size_t     NAME_SIZE       = 32U;
+
+    /** Entry size in byte */
+    static const size_t     ENTRY_SIZE      = NAME_SIZE + 8U;
+
+    /** Alignment of the image data in byte */
+    static const size_t     DATA_ALIGNMENT  = 4U;
+
+    /**
+     * Get the asset pack instance.
+     *
+     * @return Asset pack
+     */
+    static AssetPack& getInstance()
+    {
+        static AssetPack instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Attach the pack, after it is completely validated.
+     *
+     * @param[in] data  Begin of the pack, aligned to DATA_ALIGNMENT
+     * @param[in] size  Size of the memory, which contains the pack
+     *
+     * @return If the pack is valid, it will return true otherwise false.
+     */
+    bool attach(const uint8_t* data, size_t size);
+
+    /**
+     * Detach the pack.
+     */
+    void detach();
+
+    /**
+     * Get number of images in the pack.
+     *
+     * @return Number of images
+     */
+    uint16_t getCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Find a image in the pack.
+     *
+     * @param[in]  name     Image name, e.g. the filename
+     * @param[out] width    Image width in pixel
+     * @param[out] height   Image height in pixel
+     *
+     * @return If the image is not in the pack, it will return nullptr otherwise the image.
+     */
+    const Color* find(const String& name, uint16_t& width, uint16_t& height) const;
+
+    /**
+     * Is the image located in the pack?
+     *
+     * @param[in] image Image
+     *
+     * @return If the image is located in the pack, it will return true otherwise false.
+     */
+    bool contains(const Color* image) const;
+
+private:
+
+    const uint8_t*  m_data;     /**< Begin of the attached pack */
+    size_t          m_size;     /**< Size of the attached pack */
+    uint16_t        m_count;    /**< Number of images */
+
+    /**
+     * Constructs the asset pack without any image.
+     */
+    AssetPack() :
+        m_data(nullptr),
+        m_size(0U),
+        m_count(0U)
+    {
+    }
+
+    /**
+     * Destroys the asset pack.
+     */
+    ~AssetPack()
+    {
+    }
+
+    /* Prevent copying */
+    AssetPack(const AssetPack&);
+    AssetPack& operator=(const AssetPack&);
+
+    /**
+     * Validate the pack.
+     *
+     * @param[in] data  Begin of the pack
+     * @param[in] size  Size of the memory, which contains the pack
+     *
+     * @return If the pack is valid, it will return true otherwise false.
+     */
+    static bool isValid(const uint8_t* data, size_t size);
+
+    /**
+     * Get the entry name, which must be terminated.
+     *
+     * @param[in] entry Begin of the entry
+     *
+     * @return Name
+     */
+    static const char* getName(const uint8_t* entry)
+    {
+        return reinterpret_cast<const char*>(entry);
+    }
+
+    /**
+     * Read a unsigned 16-bit value in little endian.
+     *
+     * @param[in] data  Data
+     *
+     * @return Value
+     */
+    static uint16_t readUInt16(const uint8_t* data)
+    {
+        return static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8U);
+    }
+
+    /**
+     * Read a unsigned 32-bit value in little endian.
+     *
+     * @param[in] data  Data
+     *
+     * @return Value
+     */
+    static uint32_t readUInt32(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(readUInt16(&data[0])) | (static_cast<uint32_t>(readUInt16(&data[2])) << 16U);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __ASSET_PACK_H__ */
+
+/** @} */
\ No newline at end of file
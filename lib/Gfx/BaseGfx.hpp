@@ -47,6 +47,8 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <gfxfont.h>
+#include <GlyphCache.h>
+#include <GlyphMetrics.h>
 
 /******************************************************************************
  * Macros
@@ -91,6 +93,8 @@ public:
             m_cursorY           = gfx.m_cursorY;
             m_isTextWrapEnabled = gfx.m_isTextWrapEnabled;
             m_font              = gfx.m_font;
+
+            resetClip();
         }
 
         return *this;
@@ -122,9 +126,22 @@ public:
      * @param[in] x     x-coordinate
      * @param[in] y     y-coordinate
      *
-     * @return Color
+     * @return Color, which is black outside the clipping region.
      */
-    virtual TColor getColor(int16_t x, int16_t y) const = 0;
+    TColor getColor(int16_t x, int16_t y) const
+    {
+        TColor color = TColor();
+
+        x += m_originX;
+        y += m_originY;
+
+        if (true == isInsideClip(x, y))
+        {
+            color = getColorUnchecked(x, y);
+        }
+
+        return color;
+    }
 
     /**
      * Draw a single pixel at given position.
@@ -133,7 +150,16 @@ public:
      * @param[in] y     y-coordinate
      * @param[in] color Color
      */
-    virtual void drawPixel(int16_t x, int16_t y, const TColor& color) = 0;
+    void drawPixel(int16_t x, int16_t y, const TColor& color)
+    {
+        x += m_originX;
+        y += m_originY;
+
+        if (true == isInsideClip(x, y))
+        {
+            drawPixelUnchecked(x, y, color);
+        }
+    }
 
     /**
      * Dim color to black.
@@ -145,7 +171,182 @@ public:
      * @param[in] y     y-coordinate
      * @param[in] ratio Dim ration [0; 255]
      */
-    virtual void dimPixel(int16_t x, int16_t y, uint8_t ratio) = 0;
+    void dimPixel(int16_t x, int16_t y, uint8_t ratio)
+    {
+        x += m_originX;
+        y += m_originY;
+
+        if (true == isInsideClip(x, y))
+        {
+            dimPixelUnchecked(x, y, ratio);
+        }
+    }
+
+    /**
+     * Write a horizontal run of pixels, starting at the given position.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Colors of the pixels
+     * @param[in] length    Number of pixels
+     */
+    void writeSpan(int16_t x, int16_t y, const TColor* colors, uint16_t length)
+    {
+        uint16_t offset = 0U;
+
+        x += m_originX;
+        y += m_originY;
+
+        if (true == clipSpan(x, y, length, offset))
+        {
+            writeSpanUnchecked(x, y, &colors[offset], length);
+        }
+    }
+
+    /**
+     * Read a horizontal run of pixels, starting at the given position.
+     * The pixels outside the clipping region are black.
+     *
+     * @param[in]  x        x-coordinate of the first pixel
+     * @param[in]  y        y-coordinate of the first pixel
+     * @param[out] colors   Colors of the pixels
+     * @param[in]  length   Number of pixels
+     */
+    void readSpan(int16_t x, int16_t y, TColor* colors, uint16_t length) const
+    {
+        const uint16_t  LENGTH  = length;
+        uint16_t        offset  = 0U;
+        uint16_t        index   = 0U;
+
+        x += m_originX;
+        y += m_originY;
+
+        if (false == clipSpan(x, y, length, offset))
+        {
+            length = 0U;
+        }
+        else
+        {
+            readSpanUnchecked(x, y, &colors[offset], length);
+        }
+
+        for(index = 0U; index < offset; ++index)
+        {
+            colors[index] = TColor();
+        }
+
+        for(index = offset + length; index < LENGTH; ++index)
+        {
+            colors[index] = TColor();
+        }
+    }
+
+    /**
+     * Fill a horizontal run of pixels with a single color, starting at the given position.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillSpan(int16_t x, int16_t y, uint16_t length, const TColor& color)
+    {
+        uint16_t offset = 0U;
+
+        x += m_originX;
+        y += m_originY;
+
+        if (true == clipSpan(x, y, length, offset))
+        {
+            fillSpanUnchecked(x, y, length, color);
+        }
+    }
+
+    /**
+     * Limit the drawing to the given rectangle, additional to the current
+     * clipping region. Optional the origin is moved to its upper left
+     * corner, e.g. to draw a nested area with its own coordinates.
+     * Every successful push must be followed by a popClip().
+     *
+     * @param[in] x             x-coordinate of upper left point
+     * @param[in] y             y-coordinate of upper left point
+     * @param[in] width         Width in pixel
+     * @param[in] height        Height in pixel
+     * @param[in] isTranslated  Move the origin (true) or not (false)
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool pushClip(int16_t x, int16_t y, uint16_t width, uint16_t height, bool isTranslated = false)
+    {
+        const int16_t   X1      = x + m_originX;
+        const int16_t   Y1      = y + m_originY;
+        const int16_t   X2      = X1 + width - 1;
+        const int16_t   Y2      = Y1 + height - 1;
+        bool            status  = false;
+
+        if (MAX_CLIP_DEPTH > m_clipDepth)
+        {
+            ClipState& state = m_clipStack[m_clipDepth];
+
+            state.x1        = m_clipX1;
+            state.y1        = m_clipY1;
+            state.x2        = m_clipX2;
+            state.y2        = m_clipY2;
+            state.originX   = m_originX;
+            state.originY   = m_originY;
+            ++m_clipDepth;
+
+            /* The new clipping region is the intersection with the current one. */
+            if (m_clipX1 < X1)
+            {
+                m_clipX1 = X1;
+            }
+
+            if (m_clipY1 < Y1)
+            {
+                m_clipY1 = Y1;
+            }
+
+            if (m_clipX2 > X2)
+            {
+                m_clipX2 = X2;
+            }
+
+            if (m_clipY2 > Y2)
+            {
+                m_clipY2 = Y2;
+            }
+
+            if (true == isTranslated)
+            {
+                m_originX = X1;
+                m_originY = Y1;
+            }
+
+            status = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Restore the clipping region and origin before the last pushClip().
+     */
+    void popClip()
+    {
+        if (0U < m_clipDepth)
+        {
+            const ClipState& state = m_clipStack[m_clipDepth - 1U];
+
+            m_clipX1    = state.x1;
+            m_clipY1    = state.y1;
+            m_clipX2    = state.x2;
+            m_clipY2    = state.y2;
+            m_originX   = state.originX;
+            m_originY   = state.originY;
+            --m_clipDepth;
+        }
+    }
 
     /**
      * Copy framebuffer content.
@@ -154,15 +355,42 @@ public:
      */
     void copy(const BaseGfx<TColor>& gfx)
     {
-        int16_t x   = 0;
-        int16_t y   = 0;
+        int16_t y = 0;
 
         for(y = 0; y < m_height; ++y)
         {
-            for(x = 0; x < m_width; ++x)
+            copySpan(0, y, gfx, 0, y, m_width);
+        }
+    }
+
+    /**
+     * Copy a horizontal run of pixels from another framebuffer.
+     *
+     * @param[in] x         x-coordinate of the first destination pixel
+     * @param[in] y         y-coordinate of the first destination pixel
+     * @param[in] gfx       Graphics interface of framebuffer source
+     * @param[in] srcX      x-coordinate of the first source pixel
+     * @param[in] srcY      y-coordinate of the first source pixel
+     * @param[in] length    Number of pixels
+     */
+    void copySpan(int16_t x, int16_t y, const BaseGfx<TColor>& gfx, int16_t srcX, int16_t srcY, uint16_t length)
+    {
+        TColor      row[COPY_SPAN_LENGTH];
+        uint16_t    index   = 0U;
+
+        while(length > index)
+        {
+            uint16_t chunkLength = length - index;
+
+            if (COPY_SPAN_LENGTH < chunkLength)
             {
-                drawPixel(x, y, gfx.getColor(x, y));
+                chunkLength = COPY_SPAN_LENGTH;
             }
+
+            gfx.readSpan(srcX + index, srcY, row, chunkLength);
+            writeSpan(x + index, y, row, chunkLength);
+
+            index += chunkLength;
         }
     }
 
@@ -177,11 +405,15 @@ public:
      */
     void drawVLine(int16_t x, int16_t y, uint16_t height, const TColor& color)
     {
-        uint16_t index = 0U;
+        int16_t x1 = x;
+        int16_t y1 = y;
+        int16_t x2 = x;
+        int16_t y2 = y + height - 1;
 
-        for(index = 0U; index < height; ++index)
+        if ((0U < height) &&
+            (true == clipRect(x1, y1, x2, y2)))
         {
-            drawPixel(x, y + index, color);
+            fillVSpanUnchecked(x1, y1, y2 - y1 + 1, color);
         }
     }
 
@@ -196,16 +428,13 @@ public:
      */
     void drawHLine(int16_t x, int16_t y, uint16_t width, const TColor& color)
     {
-        uint16_t index = 0U;
-
-        for(index = 0U; index < width; ++index)
-        {
-            drawPixel(x + index, y, color);
-        }
+        fillSpan(x, y, width, color);
     }
 
     /**
      * Draw a line.
+     * Horizontal and vertical lines are drawn as spans, all others with a
+     * Bresenham loop, which is specialized for the major axis.
      *
      * @param[in] xs    x-coordinate of start point
      * @param[in] ys    y-coordinate of start point
@@ -215,36 +444,79 @@ public:
      */
     void drawLine(int16_t xs, int16_t ys, int16_t xe, int16_t ye, const TColor& color)
     {
-        int16_t dX      = abs(xe - xs);
-        int16_t stepX   = (xs < xe) ? 1 : -1;
-        int16_t dY      = - abs(ye - ys);
-        int16_t stepY   = (ys < ye) ? 1 : -1;
-        int16_t err     = dX + dY;  /* err_xy */
-        int16_t err2    = 0;
-
-        /* https://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm */
+        const int16_t   dX      = abs(xe - xs);
+        const int16_t   stepX   = (xs < xe) ? 1 : -1;
+        const int16_t   dY      = - abs(ye - ys);
+        const int16_t   stepY   = (ys < ye) ? 1 : -1;
+        int16_t         err     = dX + dY;  /* err_xy */
+        int16_t         err2    = 0;
+        int16_t         count   = 0;
+        bool            isInside;
+
+        if (ys == ye)
+        {
+            drawHLine((xs < xe) ? xs : xe, ys, dX + 1, color);
+            return;
+        }
 
-        while(1)
+        if (xs == xe)
         {
-            drawPixel(xs, ys, color);
+            drawVLine(xs, (ys < ye) ? ys : ye, -dY + 1, color);
+            return;
+        }
 
-            if ((xs == xe) && (ys == ye))
-            {
-                break;
-            }
+        xs += m_originX;
+        ys += m_originY;
+        xe += m_originX;
+        ye += m_originY;
 
-            err2 = 2 * err;
+        /* If both end points are inside, the whole line is inside. */
+        isInside = (true == isInsideClip(xs, ys)) && (true == isInsideClip(xe, ye));
 
-            if (err2 >= dY)
+        /* https://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
+         * Along the major axis every step moves one pixel, therefore only
+         * the minor axis needs a decision.
+         */
+        if (dX >= -dY)
+        {
+            for(count = 0; count <= dX; ++count)
             {
-                err += dY; /* err_xy + err_x > 0 */
-                xs  += stepX;
-            }
+                if ((true == isInside) ||
+                    (true == isInsideClip(xs, ys)))
+                {
+                    drawPixelUnchecked(xs, ys, color);
+                }
 
-            if (err2 <= dX)
+                err2    = 2 * err;
+                err    += dY; /* err_xy + err_x > 0 */
+                xs     += stepX;
+
+                if (err2 <= dX)
+                {
+                    err += dX; /* err_xy + err_y < 0 */
+                    ys  += stepY;
+                }
+            }
+        }
+        else
+        {
+            for(count = 0; count <= -dY; ++count)
             {
-                err += dX; /* err_xy + err_y < 0 */
-                ys  += stepY;
+                if ((true == isInside) ||
+                    (true == isInsideClip(xs, ys)))
+                {
+                    drawPixelUnchecked(xs, ys, color);
+                }
+
+                err2    = 2 * err;
+                err    += dX; /* err_xy + err_y < 0 */
+                ys     += stepY;
+
+                if (err2 >= dY)
+                {
+                    err += dY; /* err_xy + err_x > 0 */
+                    xs  += stepX;
+                }
             }
         }
     }
@@ -260,10 +532,128 @@ public:
      */
     void drawRectangle(int16_t x1, int16_t y1, uint16_t width, uint16_t height, const TColor& color)
     {
-        drawHLine(x1, y1, width, color);
-        drawHLine(x1, y1 + height - 1, width, color);
-        drawVLine(x1, y1 + 1, height - 2, color);
-        drawVLine(x1 + width - 1, y1 + 1, height -2, color);
+        /* A rectangle without inner area is completely filled. */
+        if ((2U >= width) ||
+            (2U >= height))
+        {
+            fillRect(x1, y1, width, height, color);
+        }
+        else
+        {
+            drawHLine(x1, y1, width, color);
+            drawHLine(x1, y1 + height - 1, width, color);
+            drawVLine(x1, y1 + 1, height - 2, color);
+            drawVLine(x1 + width - 1, y1 + 1, height - 2, color);
+        }
+    }
+
+    /**
+     * Draw a circle outline.
+     *
+     * @param[in] xc        x-coordinate of the center
+     * @param[in] yc        y-coordinate of the center
+     * @param[in] radius    Radius in pixel
+     * @param[in] color     Color
+     */
+    void drawCircle(int16_t xc, int16_t yc, uint16_t radius, const TColor& color)
+    {
+        int16_t x   = 0;
+        int16_t y   = radius;
+        int16_t err = 1 - static_cast<int16_t>(radius);
+
+        /* Midpoint circle algorithm, which walks along the second octant
+         * and mirrors it to the others.
+         */
+        /* Don't draw the pixels on the axes and diagonals twice. */
+        if (0 == radius)
+        {
+            drawPixel(xc, yc, color);
+            return;
+        }
+
+        while(x <= y)
+        {
+            if (0 == x)
+            {
+                drawPixel(xc, yc + y, color);
+                drawPixel(xc, yc - y, color);
+                drawPixel(xc + y, yc, color);
+                drawPixel(xc - y, yc, color);
+            }
+            else
+            {
+                drawPixel(xc + x, yc + y, color);
+                drawPixel(xc - x, yc + y, color);
+                drawPixel(xc + x, yc - y, color);
+                drawPixel(xc - x, yc - y, color);
+
+                if (x < y)
+                {
+                    drawPixel(xc + y, yc + x, color);
+                    drawPixel(xc - y, yc + x, color);
+                    drawPixel(xc + y, yc - x, color);
+                    drawPixel(xc - y, yc - x, color);
+                }
+            }
+
+            ++x;
+
+            if (0 > err)
+            {
+                err += 2 * x + 1;
+            }
+            else
+            {
+                --y;
+                err += 2 * (x - y) + 1;
+            }
+        }
+    }
+
+    /**
+     * Fill a circle, span by span.
+     *
+     * @param[in] xc        x-coordinate of the center
+     * @param[in] yc        y-coordinate of the center
+     * @param[in] radius    Radius in pixel
+     * @param[in] color     Color
+     */
+    void fillCircle(int16_t xc, int16_t yc, uint16_t radius, const TColor& color)
+    {
+        int16_t x   = 0;
+        int16_t y   = radius;
+        int16_t err = 1 - static_cast<int16_t>(radius);
+
+        /* The rows are derived like drawCircle() does, every row is filled once. */
+        drawHLine(xc - y, yc, 2 * y + 1, color);
+
+        while(x < y)
+        {
+            ++x;
+
+            if (0 > err)
+            {
+                err += 2 * x + 1;
+            }
+            else
+            {
+                /* The outer rows are completed, before y moves inwards. */
+                if (x <= y)
+                {
+                    drawHLine(xc - (x - 1), yc - y, 2 * (x - 1) + 1, color);
+                    drawHLine(xc - (x - 1), yc + y, 2 * (x - 1) + 1, color);
+                }
+
+                --y;
+                err += 2 * (x - y) + 1;
+            }
+
+            if (x <= y)
+            {
+                drawHLine(xc - y, yc - x, 2 * y + 1, color);
+                drawHLine(xc - y, yc + x, 2 * y + 1, color);
+            }
+        }
     }
 
     /**
@@ -277,14 +667,18 @@ public:
      */
     void fillRect(int16_t x, int16_t y, uint16_t width, uint16_t height, const TColor& color)
     {
-        int16_t xIndex = 0;
-        int16_t yIndex = 0;
-
-        for(yIndex = 0; yIndex < height; ++yIndex)
+        int16_t x1 = x;
+        int16_t y1 = y;
+        int16_t x2 = x + width - 1;
+        int16_t y2 = y + height - 1;
+
+        if ((0U < width) &&
+            (0U < height) &&
+            (true == clipRect(x1, y1, x2, y2)))
         {
-            for(xIndex = 0; xIndex < width; ++xIndex)
+            for(y = y1; y <= y2; ++y)
             {
-                drawPixel(x + xIndex, y + yIndex, color);
+                fillSpanUnchecked(x1, y, x2 - x1 + 1, color);
             }
         }
     }
@@ -311,14 +705,21 @@ public:
      */
     void dimRect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint8_t ratio)
     {
-        int16_t xIndex = 0;
-        int16_t yIndex = 0;
-
-        for(yIndex = 0; yIndex < height; ++yIndex)
+        int16_t x1 = x;
+        int16_t y1 = y;
+        int16_t x2 = x + width - 1;
+        int16_t y2 = y + height - 1;
+
+        if ((0U < width) &&
+            (0U < height) &&
+            (true == clipRect(x1, y1, x2, y2)))
         {
-            for(xIndex = 0; xIndex < width; ++xIndex)
+            for(y = y1; y <= y2; ++y)
             {
-                dimPixel(x + xIndex, y + yIndex, ratio);
+                for(x = x1; x <= x2; ++x)
+                {
+                    dimPixelUnchecked(x, y, ratio);
+                }
             }
         }
     }
@@ -345,14 +746,23 @@ public:
      */
     void drawRGBBitmap(int16_t x, int16_t y, const TColor* bitmap, uint16_t width, uint16_t height)
     {
-        int16_t xIndex = 0;
-        int16_t yIndex = 0;
-
-        for(yIndex = 0; yIndex < height; ++yIndex)
+        int16_t x1 = x;
+        int16_t y1 = y;
+        int16_t x2 = x + width - 1;
+        int16_t y2 = y + height - 1;
+
+        if ((0U < width) &&
+            (0U < height) &&
+            (true == clipRect(x1, y1, x2, y2)))
         {
-            for(xIndex = 0; xIndex < width; ++xIndex)
+            /* Position of the first visible pixel in the bitmap. */
+            const int16_t   BITMAP_X    = x1 - (x + m_originX);
+            const int16_t   BITMAP_Y    = y1 - (y + m_originY);
+            int16_t         yIndex      = 0;
+
+            for(yIndex = 0; yIndex <= (y2 - y1); ++yIndex)
             {
-                drawPixel(x + xIndex, y + yIndex, bitmap[xIndex + width * yIndex]);
+                writeSpanUnchecked(x1, y1 + yIndex, &bitmap[BITMAP_X + width * (BITMAP_Y + yIndex)], x2 - x1 + 1);
             }
         }
     }
@@ -467,13 +877,9 @@ public:
                  (m_font->first <= uChar) &&
                  (m_font->last >= uChar))
         {
-            uint8_t         glyphIndex      = uChar - m_font->first;
-            const GFXglyph* glyph           = &(m_font->glyph[glyphIndex]);
-            int16_t         x               = 0;
-            int16_t         y               = 0;
-            uint16_t        bitmapOffset    = glyph->bitmapOffset;
-            uint8_t         bitmapRowBits   = 0U;
-            uint8_t         bitCnt          = 0U;
+            uint8_t                     glyphIndex  = uChar - m_font->first;
+            const GFXglyph*             glyph       = &(m_font->glyph[glyphIndex]);
+            const GlyphCache::Glyph*    decoded     = nullptr;
 
             /* If text wrap around is enabled and the character is clipping,
              * jump to the next line.
@@ -487,26 +893,15 @@ public:
                 }
             }
 
-            for(y = 0U; y < glyph->height; ++y)
-            {
-                for(x = 0U; x < glyph->width; ++x)
-                {
-                    /* Every 8 bit, the bitmap offset must be increased. */
-                    if (0U == (bitCnt & 0x07))
-                    {
-                        bitmapRowBits = m_font->bitmap[bitmapOffset];
-                        ++bitmapOffset;
-                    }
-                    ++bitCnt;
-
-                    /* A 1b in the bitmap row bits must be drawn as single pixel. */
-                    if (0U != (bitmapRowBits & 0x80U))
-                    {
-                        drawPixel(m_cursorX + x + glyph->xOffset, m_cursorY + y + glyph->yOffset, m_textColor);
-                    }
+            decoded = GlyphCache::getInstance().get(m_font, uChar);
 
-                    bitmapRowBits <<= 1U;
-                }
+            if (nullptr != decoded)
+            {
+                drawGlyphRows(glyph, decoded->rows);
+            }
+            else
+            {
+                drawGlyphBits(glyph);
             }
 
             m_cursorX += glyph->xAdvance;
@@ -593,6 +988,8 @@ public:
 
     /**
      * Get bounding box of text.
+     * The character widths are taken from the advance table of the font,
+     * therefore the glyphs are not looked up character by character.
      *
      * @param[in]   text    Text
      * @param[out]  width   Width in pixel
@@ -605,16 +1002,17 @@ public:
         if ((nullptr != text) &&
             (nullptr != m_font))
         {
-            size_t      index       = 0U;
-            uint16_t    lineWidth   = 0U;
+            const uint8_t*  advances    = GlyphMetrics::getInstance().getAdvances(m_font);
+            size_t          index       = 0U;
+            uint16_t        lineWidth   = 0U;
 
             width   = 0U;
             height  = 0U;
 
             while('\0' != text[index])
             {
-                uint16_t charWidth  = 0U;
-                uint16_t charHeight = 0U;
+                uint8_t     uChar       = static_cast<uint8_t>(text[index]);
+                uint16_t    charWidth   = advances[uChar];
 
                 if ('\n' == text[index])
                 {
@@ -626,7 +1024,9 @@ public:
                     lineWidth = 0U;
                     height += m_font->yAdvance;;
                 }
-                else if (true == getCharBoundingBox(text[index], charWidth, charHeight))
+                else if ((m_font->first <= uChar) &&
+                         (m_font->last >= uChar) &&
+                         ('\r' != text[index]))
                 {
                     if (0U == index)
                     {
@@ -673,6 +1073,25 @@ public:
 
 protected:
 
+    /** Max. number of pixels, which are copied at once by copySpan(). */
+    static const uint16_t   COPY_SPAN_LENGTH    = 32U;
+
+    /** Max. number of nested clipping regions, see pushClip(). */
+    static const uint8_t    MAX_CLIP_DEPTH      = 4U;
+
+    /**
+     * Clipping region and origin, which is saved by pushClip().
+     */
+    struct ClipState
+    {
+        int16_t x1;         /**< Upper left x-coordinate */
+        int16_t y1;         /**< Upper left y-coordinate */
+        int16_t x2;         /**< Lower right x-coordinate (inclusive) */
+        int16_t y2;         /**< Lower right y-coordinate (inclusive) */
+        int16_t originX;    /**< Origin x-coordinate */
+        int16_t originY;    /**< Origin y-coordinate */
+    };
+
     uint16_t        m_width;                /**< Canvas width in pixel */
     uint16_t        m_height;               /**< Canvas height in pixel */
     int16_t         m_cursorX;              /**< Cursor x-coordinate */
@@ -680,6 +1099,326 @@ protected:
     TColor          m_textColor;            /**< Text color */
     bool            m_isTextWrapEnabled;    /**< Is text wrap around enabled or not? */
     const GFXfont*  m_font;                 /**< Current selected font */
+    int16_t         m_clipX1;               /**< Clipping region upper left x-coordinate */
+    int16_t         m_clipY1;               /**< Clipping region upper left y-coordinate */
+    int16_t         m_clipX2;               /**< Clipping region lower right x-coordinate (inclusive) */
+    int16_t         m_clipY2;               /**< Clipping region lower right y-coordinate (inclusive) */
+    int16_t         m_originX;              /**< Origin x-coordinate, which is added to every coordinate */
+    int16_t         m_originY;              /**< Origin y-coordinate, which is added to every coordinate */
+    ClipState       m_clipStack[MAX_CLIP_DEPTH];    /**< Saved clipping regions */
+    uint8_t         m_clipDepth;            /**< Number of saved clipping regions */
+
+    /**
+     * Get pixel color at given position, which is inside the clipping region.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     *
+     * @return Color
+     */
+    virtual TColor getColorUnchecked(int16_t x, int16_t y) const = 0;
+
+    /**
+     * Draw a single pixel at given position, which is inside the clipping region.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Color
+     */
+    virtual void drawPixelUnchecked(int16_t x, int16_t y, const TColor& color) = 0;
+
+    /**
+     * Dim color to black at given position, which is inside the clipping region.
+     * A dim ratio of 255 means no change.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] ratio Dim ration [0; 255]
+     */
+    virtual void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) = 0;
+
+    /**
+     * Write a horizontal run of pixels, which is inside the clipping region.
+     * Override it in case the framebuffer provides a faster access than per pixel.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Colors of the pixels
+     * @param[in] length    Number of pixels
+     */
+    virtual void writeSpanUnchecked(int16_t x, int16_t y, const TColor* colors, uint16_t length)
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            drawPixelUnchecked(x + index, y, colors[index]);
+        }
+    }
+
+    /**
+     * Read a horizontal run of pixels, which is inside the clipping region.
+     * Override it in case the framebuffer provides a faster access than per pixel.
+     *
+     * @param[in]  x        x-coordinate of the first pixel
+     * @param[in]  y        y-coordinate of the first pixel
+     * @param[out] colors   Colors of the pixels
+     * @param[in]  length   Number of pixels
+     */
+    virtual void readSpanUnchecked(int16_t x, int16_t y, TColor* colors, uint16_t length) const
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            colors[index] = getColorUnchecked(x + index, y);
+        }
+    }
+
+    /**
+     * Fill a horizontal run of pixels with a single color, which is inside
+     * the clipping region.
+     * Override it in case the framebuffer provides a faster access than per pixel.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    virtual void fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const TColor& color)
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            drawPixelUnchecked(x + index, y, color);
+        }
+    }
+
+    /**
+     * Fill a vertical run of pixels with a single color, which is inside
+     * the clipping region.
+     * Override it in case the framebuffer provides a faster access than per pixel,
+     * e.g. by stepping with the row stride.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    virtual void fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const TColor& color)
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            drawPixelUnchecked(x, y + index, color);
+        }
+    }
+
+    /**
+     * Set the clipping region, which is used if no other is pushed.
+     * Its the whole drawing area by default.
+     *
+     * @param[in] x1    Upper left x-coordinate
+     * @param[in] y1    Upper left y-coordinate
+     * @param[in] x2    Lower right x-coordinate (inclusive)
+     * @param[in] y2    Lower right y-coordinate (inclusive)
+     */
+    void setBaseClip(int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+    {
+        m_clipX1    = x1;
+        m_clipY1    = y1;
+        m_clipX2    = x2;
+        m_clipY2    = y2;
+        m_originX   = 0;
+        m_originY   = 0;
+        m_clipDepth = 0U;
+    }
+
+    /**
+     * Reset the clipping region to the whole drawing area.
+     */
+    void resetClip()
+    {
+        setBaseClip(0, 0, m_width - 1, m_height - 1);
+    }
+
+    /**
+     * Is the given position inside the clipping region?
+     *
+     * @param[in] x x-coordinate, incl. the origin
+     * @param[in] y y-coordinate, incl. the origin
+     *
+     * @return If inside, it will return true otherwise false.
+     */
+    bool isInsideClip(int16_t x, int16_t y) const
+    {
+        return (m_clipX1 <= x) &&
+               (m_clipX2 >= x) &&
+               (m_clipY1 <= y) &&
+               (m_clipY2 >= y);
+    }
+
+    /**
+     * Clip a horizontal run of pixels to the clipping region.
+     *
+     * @param[in,out]   x       x-coordinate of the first pixel, incl. the origin
+     * @param[in]       y       y-coordinate of the first pixel, incl. the origin
+     * @param[in,out]   length  Number of pixels
+     * @param[out]      offset  Number of pixels, which are skipped at the begin
+     *
+     * @return If any pixel is inside, it will return true otherwise false.
+     */
+    bool clipSpan(int16_t& x, int16_t y, uint16_t& length, uint16_t& offset) const
+    {
+        const int32_t   X2          = static_cast<int32_t>(x) + length - 1;
+        bool            isVisible   = false;
+
+        offset = 0U;
+
+        if ((0U < length) &&
+            (m_clipY1 <= y) &&
+            (m_clipY2 >= y) &&
+            (m_clipX2 >= x) &&
+            (m_clipX1 <= X2))
+        {
+            if (m_clipX1 > x)
+            {
+                offset  = m_clipX1 - x;
+                length -= offset;
+                x       = m_clipX1;
+            }
+
+            if (m_clipX2 < (static_cast<int32_t>(x) + length - 1))
+            {
+                length = m_clipX2 - x + 1;
+            }
+
+            isVisible = true;
+        }
+
+        return isVisible;
+    }
+
+    /**
+     * Move a rectangle by the origin and clip it to the clipping region.
+     *
+     * @param[in,out]   x1  Upper left x-coordinate
+     * @param[in,out]   y1  Upper left y-coordinate
+     * @param[in,out]   x2  Lower right x-coordinate (inclusive)
+     * @param[in,out]   y2  Lower right y-coordinate (inclusive)
+     *
+     * @return If any pixel is inside, it will return true otherwise false.
+     */
+    bool clipRect(int16_t& x1, int16_t& y1, int16_t& x2, int16_t& y2) const
+    {
+        x1 += m_originX;
+        y1 += m_originY;
+        x2 += m_originX;
+        y2 += m_originY;
+
+        if (m_clipX1 > x1)
+        {
+            x1 = m_clipX1;
+        }
+
+        if (m_clipY1 > y1)
+        {
+            y1 = m_clipY1;
+        }
+
+        if (m_clipX2 < x2)
+        {
+            x2 = m_clipX2;
+        }
+
+        if (m_clipY2 < y2)
+        {
+            y2 = m_clipY2;
+        }
+
+        return (x1 <= x2) && (y1 <= y2);
+    }
+
+    /**
+     * Draw a decoded glyph at the current cursor position.
+     * Every horizontal run of set pixels is drawn at once.
+     *
+     * @param[in] glyph Glyph of the current font
+     * @param[in] rows  Decoded glyph rows, the MSB is the leftmost pixel.
+     */
+    void drawGlyphRows(const GFXglyph* glyph, const uint16_t* rows)
+    {
+        const int16_t   X0  = m_cursorX + glyph->xOffset;
+        const int16_t   Y0  = m_cursorY + glyph->yOffset;
+        uint8_t         y   = 0U;
+
+        for(y = 0U; y < glyph->height; ++y)
+        {
+            uint16_t    row = rows[y];
+            int16_t     x   = X0;
+
+            while(0U != row)
+            {
+                uint16_t length = 0U;
+
+                /* Skip the not set pixels. */
+                while(0U == (row & 0x8000U))
+                {
+                    row <<= 1U;
+                    ++x;
+                }
+
+                /* Count the set pixels. */
+                while(0U != (row & 0x8000U))
+                {
+                    row <<= 1U;
+                    ++length;
+                }
+
+                fillSpan(x, Y0 + y, length, m_textColor);
+                x += length;
+            }
+        }
+    }
+
+    /**
+     * Draw a glyph at the current cursor position directly from the font
+     * bitmap, bit by bit. Its used for glyphs which are too large to be decoded.
+     *
+     * @param[in] glyph Glyph of the current font
+     */
+    void drawGlyphBits(const GFXglyph* glyph)
+    {
+        int16_t     x               = 0;
+        int16_t     y               = 0;
+        uint16_t    bitmapOffset    = glyph->bitmapOffset;
+        uint8_t     bitmapRowBits   = 0U;
+        uint8_t     bitCnt          = 0U;
+
+        for(y = 0U; y < glyph->height; ++y)
+        {
+            for(x = 0U; x < glyph->width; ++x)
+            {
+                /* Every 8 bit, the bitmap offset must be increased. */
+                if (0U == (bitCnt & 0x07))
+                {
+                    bitmapRowBits = m_font->bitmap[bitmapOffset];
+                    ++bitmapOffset;
+                }
+                ++bitCnt;
+
+                /* A 1b in the bitmap row bits must be drawn as single pixel. */
+                if (0U != (bitmapRowBits & 0x80U))
+                {
+                    drawPixel(m_cursorX + x + glyph->xOffset, m_cursorY + y + glyph->yOffset, m_textColor);
+                }
+
+                bitmapRowBits <<= 1U;
+            }
+        }
+    }
 
     /**
      * Constructs the base graphics functionality.
@@ -694,7 +1433,15 @@ protected:
         m_cursorY(0),
         m_textColor(0U),
         m_isTextWrapEnabled(false),
-        m_font(nullptr)
+        m_font(nullptr),
+        m_clipX1(0),
+        m_clipY1(0),
+        m_clipX2(width - 1),
+        m_clipY2(height - 1),
+        m_originX(0),
+        m_originY(0),
+        m_clipStack(),
+        m_clipDepth(0U)
     {
     }
 
@@ -709,7 +1456,15 @@ protected:
         m_cursorX(gfx.m_cursorX),
         m_cursorY(gfx.m_cursorY),
         m_isTextWrapEnabled(gfx.m_isTextWrapEnabled),
-        m_font(gfx.m_font)
+        m_font(gfx.m_font),
+        m_clipX1(0),
+        m_clipY1(0),
+        m_clipX2(gfx.m_width - 1),
+        m_clipY2(gfx.m_height - 1),
+        m_originX(0),
+        m_originY(0),
+        m_clipStack(),
+        m_clipDepth(0U)
     {
     }
 
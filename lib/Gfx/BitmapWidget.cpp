@@ -33,11 +33,13 @@
  * Includes
  *****************************************************************************/
 #include "BitmapWidget.h"
+#include <ImageCache.h>
 
 #ifndef NATIVE
 
-#include <NeoPixelBus.h>
-#include <Color.h>
+#include <AssetPack.h>
+#include <BmpDecoder.h>
+#include <MemPolicy.h>
 #include <Logging.h>
 
 #endif  /* NATIVE */
@@ -65,6 +67,13 @@
 /* Initialize bitmap widget type. */
 const char* BitmapWidget::WIDGET_TYPE = "bitmap";
 
+#ifndef NATIVE
+
+/* Initialize the filesystem job executor. Without it the bitmaps are loaded directly. */
+BitmapWidget::FileJobExecutor BitmapWidget::m_fileJobExecutor = nullptr;
+
+#endif  /* NATIVE */
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -73,79 +82,165 @@ BitmapWidget& BitmapWidget::operator=(const BitmapWidget& widget)
 {
     if (&widget != this)
     {
-        m_bufferSize    = widget.m_bufferSize;
-        m_width         = widget.m_width;
-        m_height        = widget.m_height;
+        clear();
+        copy(widget);
+    }
 
-        if (nullptr != m_buffer)
+    return *this;
+}
+
+bool BitmapWidget::set(const Color* bitmap, uint16_t width, uint16_t height)
+{
+    bool            status  = false;
+    IndexedImage*   image   = new IndexedImage();
+
+    if (nullptr != image)
+    {
+        if (false == image->set(bitmap, width, height))
+        {
+            delete image;
+            image = nullptr;
+        }
+        else
         {
-            delete[] m_buffer;
-            m_buffer = nullptr;
+            clear();
+
+            m_image     = image;
+            m_width     = width;
+            m_height    = height;
+
+            status = true;
         }
+    }
 
-        if (nullptr != widget.m_buffer)
+    return status;
+}
+
+#ifndef NATIVE
+
+bool BitmapWidget::load(FS& fs, const String& filename)
+{
+    bool                status  = false;
+    uint16_t            width   = 0U;
+    uint16_t            height  = 0U;
+    const Color*        buffer  = AssetPack::getInstance().find(filename, width, height);
+    const IndexedImage* image   = nullptr;
+
+    /* A bitmap of the asset pack is used directly and needs no reference counting. */
+    if (nullptr != buffer)
+    {
+        clear();
+
+        m_buffer        = buffer;
+        m_width         = width;
+        m_height        = height;
+
+        status = true;
+    }
+    else
+    {
+        image = ImageCache::getInstance().acquire(filename);
+
+        /* Already decoded by someone else? */
+        if (nullptr != image)
         {
-            m_buffer = new Color[m_bufferSize];
+            clear();
 
-            if (nullptr == m_buffer)
-            {
-                m_bufferSize = 0U;
-            }
-            else
-            {
-                size_t index = 0U;
+            m_image         = image;
+            m_width         = image->getWidth();
+            m_height        = image->getHeight();
+            m_isShared      = true;
 
-                for(index = 0U; index < m_bufferSize; ++index)
+            status = true;
+        }
+        else if (nullptr != m_fileJobExecutor)
+        {
+            status = m_fileJobExecutor(
+                [this, &fs, &filename]() -> bool
                 {
-                    m_buffer[index] = widget.m_buffer[index];
-                }
-            }
+                    return loadFile(fs, filename);
+                });
+        }
+        else
+        {
+            status = loadFile(fs, filename);
         }
     }
 
-    return *this;
+    return status;
 }
 
-void BitmapWidget::set(const Color* bitmap, uint16_t width, uint16_t height)
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+void BitmapWidget::drawColumns(IGfx& gfx, uint16_t srcX, uint16_t width) const
 {
-    if (nullptr != bitmap)
+    if (nullptr != m_image)
     {
-        if (nullptr != m_buffer)
+        m_image->draw(gfx, m_posX, m_posY, srcX, width);
+    }
+    else if ((nullptr != m_buffer) &&
+             (m_width > srcX))
+    {
+        uint16_t y = 0U;
+
+        if ((m_width - srcX) < width)
         {
-            delete[] m_buffer;
-            m_buffer = nullptr;
+            width = m_width - srcX;
         }
 
-        m_bufferSize    = width * height;
-        m_width         = width;
-        m_height        = height;
+        for(y = 0U; y < m_height; ++y)
+        {
+            gfx.writeSpan(m_posX, m_posY + y, &m_buffer[y * m_width + srcX], width);
+        }
+    }
+    else
+    {
+        ;
+    }
 
-        m_buffer = new Color[m_bufferSize];
+    return;
+}
 
-        if (nullptr == m_buffer)
+void BitmapWidget::clear()
+{
+    if (nullptr != m_image)
+    {
+        if (true == m_isShared)
         {
-            m_bufferSize = 0U;
+            ImageCache::getInstance().release(m_image);
         }
         else
         {
-            size_t index = 0U;
-
-            for(index = 0U; index < m_bufferSize; ++index)
-            {
-                m_buffer[index] = bitmap[index];
-            }
+            delete m_image;
         }
+
+        m_image = nullptr;
     }
 
+    m_buffer        = nullptr;
+    m_width         = 0U;
+    m_height        = 0U;
+    m_isShared      = false;
+
+    /* Usually a new bitmap follows, which must be drawn. */
+    invalidate();
+
     return;
 }
 
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
 #ifndef NATIVE
 
-bool BitmapWidget::load(FS& fs, const String& filename)
+bool BitmapWidget::loadFile(FS& fs, const String& filename)
 {
-    bool    status  = false;
-    File    fd;
+    bool status = false;
 
     if (false == fs.exists(filename))
     {
@@ -153,9 +248,7 @@ bool BitmapWidget::load(FS& fs, const String& filename)
     }
     else
     {
-        NeoBitmapFile<NeoGrbFeature, File>  neoFile;
-
-        fd = fs.open(filename, "r");
+        File fd = fs.open(filename, "r");
 
         if (false == fd)
         {
@@ -163,41 +256,92 @@ bool BitmapWidget::load(FS& fs, const String& filename)
         }
         else
         {
-            if (false == neoFile.Begin(fd))
+            BmpDecoder  decoder;
+            uint8_t     header[BmpDecoder::HEADER_SIZE];
+
+            if ((sizeof(header) != fd.read(header, sizeof(header))) ||
+                (false == decoder.parseHeader(header, sizeof(header))) ||
+                (false == fd.seek(decoder.getDataOffset())))
             {
                 LOG_ERROR("File %s has incompatible bitmap file format.", filename.c_str());
             }
             else
             {
-                m_width         = neoFile.Width();
-                m_height        = neoFile.Height();
-                m_bufferSize    = m_width * m_height;
-
-                if (nullptr != m_buffer)
+                const size_t    ROW_SIZE        = decoder.getRowSize();
+                const size_t    ROWS_PER_CHUNK  = (READ_CHUNK_SIZE > ROW_SIZE) ? (READ_CHUNK_SIZE / ROW_SIZE) : 1U;
+                const size_t    BUFFER_SIZE     = decoder.getWidth() * decoder.getHeight();
+                Color*          buffer          = MemPolicy::allocateArray<Color>(MemPolicy::REGION_LARGE, BUFFER_SIZE);
+                uint8_t*        chunk           = new uint8_t[ROWS_PER_CHUNK * ROW_SIZE];
+
+                if ((nullptr != buffer) &&
+                    (nullptr != chunk))
                 {
-                    delete[] m_buffer;
-                    m_buffer = nullptr;
-                }
-
-                m_buffer = new Color[m_bufferSize];
+                    uint16_t fileRow = 0U;
 
-                if (nullptr != m_buffer)
-                {
-                    uint16_t x = 0U;
-                    uint16_t y = 0U;
+                    status = true;
 
-                    for(y = 0U; y < m_height; ++y)
+                    /* Read the pixel data sequentially, several rows at once. */
+                    while((true == status) && (decoder.getHeight() > fileRow))
                     {
-                        for(x = 0U; x < m_width; ++x)
+                        size_t  rows    = decoder.getHeight() - fileRow;
+                        size_t  row     = 0U;
+
+                        if (ROWS_PER_CHUNK < rows)
                         {
-                            RgbColor rgbColor = neoFile.GetPixelColor(x, y);
+                            rows = ROWS_PER_CHUNK;
+                        }
 
-                            m_buffer[x + y * m_width].set(rgbColor.R, rgbColor.G, rgbColor.B);
+                        if ((rows * ROW_SIZE) != fd.read(chunk, rows * ROW_SIZE))
+                        {
+                            LOG_ERROR("File %s is truncated.", filename.c_str());
+                            status = false;
+                        }
+                        else
+                        {
+                            for(row = 0U; row < rows; ++row)
+                            {
+                                const uint16_t Y = decoder.getY(fileRow);
+
+                                decoder.decodeRow(&chunk[row * ROW_SIZE], &buffer[Y * decoder.getWidth()]);
+                                ++fileRow;
+                            }
                         }
                     }
+                }
 
-                    status = true;
+                if (nullptr != chunk)
+                {
+                    delete[] chunk;
+                    chunk = nullptr;
                 }
+
+                /* The decoded bitmap is only needed to create the palette indexed one. */
+                if (true == status)
+                {
+                    IndexedImage* image = new IndexedImage();
+
+                    if ((nullptr == image) ||
+                        (false == image->set(buffer, decoder.getWidth(), decoder.getHeight())))
+                    {
+                        LOG_ERROR("File %s has too many colors.", filename.c_str());
+                        delete image;
+                        status = false;
+                    }
+                    else
+                    {
+                        clear();
+
+                        m_image     = image;
+                        m_width     = decoder.getWidth();
+                        m_height    = decoder.getHeight();
+
+                        /* Share it with others. If the cache is full, the widget keeps the ownership. */
+                        m_isShared  = ImageCache::getInstance().add(filename, image);
+                    }
+                }
+
+                MemPolicy::releaseArray(buffer, BUFFER_SIZE);
+                buffer = nullptr;
             }
 
             fd.close();
@@ -209,13 +353,42 @@ bool BitmapWidget::load(FS& fs, const String& filename)
 
 #endif  /* NATIVE */
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
+void BitmapWidget::copy(const BitmapWidget& widget)
+{
+    if (nullptr != widget.m_buffer)
+    {
+        /* A bitmap of the asset pack is never freed. */
+        m_buffer        = widget.m_buffer;
+        m_width         = widget.m_width;
+        m_height        = widget.m_height;
+    }
+    else if (nullptr != widget.m_image)
+    {
+        /* A shared bitmap is shared with this widget too. */
+        if ((true == widget.m_isShared) &&
+            (true == ImageCache::getInstance().addRef(widget.m_image)))
+        {
+            m_image     = widget.m_image;
+            m_isShared  = true;
+        }
+        else
+        {
+            m_image     = new IndexedImage(*widget.m_image);
+        }
 
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
+        if (nullptr != m_image)
+        {
+            m_width     = widget.m_width;
+            m_height    = widget.m_height;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return;
+}
 
 /******************************************************************************
  * External Functions
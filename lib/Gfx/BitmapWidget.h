@@ -45,9 +45,11 @@
  *****************************************************************************/
 #include <stdint.h>
 #include <Widget.hpp>
+#include <IndexedImage.h>
 
 #ifndef NATIVE
 #include <FS.h>
+#include <functional>
 #endif  /* NATIVE */
 
 /******************************************************************************
@@ -60,6 +62,10 @@
 
 /**
  * Bitmap widget, showing a simple bitmap.
+ *
+ * Bitmaps are stored palette indexed, see IndexedImage. Only the images of
+ * the asset pack are used directly with one color per pixel, because they
+ * are located in read-only memory.
  */
 class BitmapWidget : public Widget
 {
@@ -71,9 +77,10 @@ public:
     BitmapWidget() :
         Widget(WIDGET_TYPE),
         m_buffer(nullptr),
-        m_bufferSize(0U),
+        m_image(nullptr),
         m_width(0U),
-        m_height(0U)
+        m_height(0U),
+        m_isShared(false)
     {
     }
 
@@ -85,28 +92,12 @@ public:
     BitmapWidget(const BitmapWidget& widget) :
         Widget(WIDGET_TYPE),
         m_buffer(nullptr),
-        m_bufferSize(widget.m_bufferSize),
-        m_width(widget.m_width),
-        m_height(widget.m_height)
+        m_image(nullptr),
+        m_width(0U),
+        m_height(0U),
+        m_isShared(false)
     {
-        if (nullptr != widget.m_buffer)
-        {
-            m_buffer = new Color[m_bufferSize];
-
-            if (nullptr == m_buffer)
-            {
-                m_bufferSize = 0U;
-            }
-            else
-            {
-                size_t index = 0U;
-
-                for(index = 0U; index < m_bufferSize; ++index)
-                {
-                    m_buffer[index] = widget.m_buffer[index];
-                }
-            }
-        }
+        copy(widget);
     }
 
     /**
@@ -114,12 +105,7 @@ public:
      */
     ~BitmapWidget()
     {
-        if (nullptr != m_buffer)
-        {
-            delete[] m_buffer;
-            m_buffer = nullptr;
-            m_bufferSize = 0U;
-        }
+        clear();
     }
 
     /**
@@ -136,43 +122,70 @@ public:
      */
     void update(IGfx& gfx) override
     {
-        if (nullptr != m_buffer)
-        {
-            gfx.drawRGBBitmap(m_posX, m_posY, m_buffer, m_width, m_height);
-        }
+        drawColumns(gfx, 0U, m_width);
 
         return;
     }
 
     /**
-     * Set a new bitmap.
+     * Set a new bitmap. It is converted to a palette indexed image.
      *
      * @param[in] bitmap    Ext. bitmap buffer
      * @param[in] width     Bitmap width in pixel
      * @param[in] height    Bitmap height in pixel
+     *
+     * @return If successful, it will return true otherwise false, e.g. if
+     *          the bitmap has more than IndexedImage::MAX_PALETTE_SIZE colors.
      */
-    void set(const Color* bitmap, uint16_t width, uint16_t height);
+    bool set(const Color* bitmap, uint16_t width, uint16_t height);
 
     /**
-     * Get the bitmap.
+     * Get the bitmap size.
      *
      * @param[out] width    Bitmap width in pixel
      * @param[out] height   Bitmap height in pixel
-     *
-     * @return Bitmap buffer
      */
-    const Color* get(uint16_t& width, uint16_t& height) const
+    void getSize(uint16_t& width, uint16_t& height) const
     {
         width   = m_width;
         height  = m_height;
+    }
 
-        return m_buffer;
+    /**
+     * Get the palette indexed image.
+     *
+     * @return If the bitmap is not indexed or there is no bitmap, it will return nullptr otherwise the image.
+     */
+    const IndexedImage* getImage() const
+    {
+        return m_image;
     }
 
     #ifndef NATIVE
 
+    /**
+     * Prototype of a function, which executes a filesystem job and returns
+     * its result.
+     */
+    typedef bool (*FileJobExecutor)(const std::function<bool(void)>& job);
+
+    /**
+     * Set the executor of all bitmap widgets, which shall access the
+     * filesystem for them, e.g. in a dedicated task.
+     *
+     * @param[in] executor  Filesystem job executor, nullptr to access the filesystem directly
+     */
+    static void setFileJobExecutor(FileJobExecutor executor)
+    {
+        m_fileJobExecutor = executor;
+        return;
+    }
+
     /**
      * Load bitmap image from filesystem.
+     * Bitmaps are shared via the image cache, which means that a bitmap,
+     * which was already loaded by another widget, won't be decoded again.
+     * A bitmap of the asset pack is used directly.
      *
      * @param[in] fs        Filesystem
      * @param[in] filename  Filename with full path
@@ -183,15 +196,75 @@ public:
 
     #endif  /* NATIVE */
 
+    /**
+     * Release the bitmap.
+     */
+    void clear();
+
     /** Widget type string */
     static const char* WIDGET_TYPE;
 
+protected:
+
+    /**
+     * Constructs a empty bitmap widget with a derived widget type.
+     *
+     * @param[in] type  Widget type string
+     */
+    explicit BitmapWidget(const char* type) :
+        Widget(type),
+        m_buffer(nullptr),
+        m_image(nullptr),
+        m_width(0U),
+        m_height(0U),
+        m_isShared(false)
+    {
+    }
+
+    /**
+     * Draw all rows of the columns [srcX; srcX + width) of the bitmap.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] srcX  First column in the bitmap
+     * @param[in] width Number of columns
+     */
+    void drawColumns(IGfx& gfx, uint16_t srcX, uint16_t width) const;
+
 private:
 
-    Color*      m_buffer;       /**< Raw bitmap buffer */
-    size_t      m_bufferSize;   /**< Raw bitmap buffer size in number of elements */
-    uint16_t    m_width;        /**< Bitmap width in pixel */
-    uint16_t    m_height;       /**< Bitmap height in pixel */
+    /** Max. number of bytes, which are read at once from a bitmap file. */
+    static const size_t READ_CHUNK_SIZE = 512U;
+
+    const Color*        m_buffer;   /**< Bitmap of the asset pack, one color per pixel */
+    const IndexedImage* m_image;    /**< Palette indexed bitmap */
+    uint16_t            m_width;    /**< Bitmap width in pixel */
+    uint16_t            m_height;   /**< Bitmap height in pixel */
+    bool                m_isShared; /**< Indexed bitmap is owned by the image cache */
+
+    #ifndef NATIVE
+
+    /** Filesystem job executor of all bitmap widgets. */
+    static FileJobExecutor  m_fileJobExecutor;
+
+    /**
+     * Load and decode the bitmap image file.
+     *
+     * @param[in] fs        Filesystem
+     * @param[in] filename  Filename with full path
+     *
+     * @return If successful loaded it will return true otherwise false.
+     */
+    bool loadFile(FS& fs, const String& filename);
+
+    #endif  /* NATIVE */
+
+    /**
+     * Copy the bitmap of another widget. A shared bitmap is not copied,
+     * instead its reference counter is increased.
+     *
+     * @param[in] widget Bitmap widget, which to copy
+     */
+    void copy(const BitmapWidget& widget);
 
 };
 
@@ -0,0 +1,232 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Blend view
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __BLENDVIEW_HPP__
+#define __BLENDVIEW_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A blend view covers the whole parent graphics. Every drawn pixel is alpha
+ * blended with the pixel, which the parent shows already. Reading pixels
+ * returns the parent content.
+ *
+ * Like the canvas view, it doesn't allocate anything and the parent must
+ * live longer than the view.
+ */
+class BlendView : public IGfx
+{
+public:
+
+    /**
+     * Constructs a blend view onto the parent graphics.
+     *
+     * @param[in] parent    Parent graphics
+     * @param[in] ratio     Blend ratio [0; 255] - 0: only parent / 255: only drawn pixel
+     */
+    BlendView(IGfx& parent, uint8_t ratio) :
+        IGfx(parent.getWidth(), parent.getHeight()),
+        m_parent(parent),
+        m_ratio(ratio)
+    {
+    }
+
+    /**
+     * Destroys the view. The parent content is kept.
+     */
+    ~BlendView()
+    {
+    }
+
+    /**
+     * Get blend ratio.
+     *
+     * @return Blend ratio [0; 255] - 0: only parent / 255: only drawn pixel
+     */
+    uint8_t getRatio() const
+    {
+        return m_ratio;
+    }
+
+private:
+
+    IGfx&   m_parent;   /**< Parent graphics */
+    uint8_t m_ratio;    /**< Blend ratio [0; 255] - 0: only parent / 255: only drawn pixel */
+
+    BlendView();
+    BlendView(const BlendView& view);
+    BlendView& operator=(const BlendView& view);
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    Color getColorUnchecked(int16_t x, int16_t y) const final
+    {
+        return m_parent.getColor(x, y);
+    }
+
+    /**
+     * Draw a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
+     */
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
+    {
+        m_parent.blendPixel(x, y, color, m_ratio);
+
+        return;
+    }
+
+    /**
+     * Dim pixel to black.
+     * A dim ratio of 255 means no change.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] ratio Dim ratio [0; 255]
+     */
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
+    {
+        m_parent.dimPixel(x, y, ratio);
+
+        return;
+    }
+
+    /**
+     * Write a horizontal run of pixels.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Colors of the pixels
+     * @param[in] length    Number of pixels
+     */
+    void writeSpanUnchecked(int16_t x, int16_t y, const Color* colors, uint16_t length) final
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            m_parent.blendPixel(x + index, y, colors[index], m_ratio);
+        }
+
+        return;
+    }
+
+    /**
+     * Read a horizontal run of pixels.
+     *
+     * @param[in]  x        x-coordinate of the first pixel
+     * @param[in]  y        y-coordinate of the first pixel
+     * @param[out] colors   Colors of the pixels
+     * @param[in]  length   Number of pixels
+     */
+    void readSpanUnchecked(int16_t x, int16_t y, Color* colors, uint16_t length) const final
+    {
+        m_parent.readSpan(x, y, colors, length);
+
+        return;
+    }
+
+    /**
+     * Fill a horizontal run of pixels with a single color.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            m_parent.blendPixel(x + index, y, color, m_ratio);
+        }
+
+        return;
+    }
+
+    /**
+     * Fill a vertical run of pixels with a single color.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            m_parent.blendPixel(x, y + index, color, m_ratio);
+        }
+
+        return;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BLENDVIEW_HPP__ */
+
+/** @} */
@@ -0,0 +1,140 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  BMP decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "BmpDecoder.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool BmpDecoder::parseHeader(const uint8_t* data, size_t size)
+{
+    bool status = false;
+
+    if ((nullptr != data) &&
+        (HEADER_SIZE <= size) &&
+        ('B' == data[0]) &&
+        ('M' == data[1]))
+    {
+        const uint32_t  DATA_OFFSET = readUInt32(&data[10]);
+        const uint32_t  DIB_SIZE    = readUInt32(&data[14]);
+        const int32_t   WIDTH       = static_cast<int32_t>(readUInt32(&data[18]));
+        int32_t         height      = static_cast<int32_t>(readUInt32(&data[22]));
+        const uint16_t  PLANES      = readUInt16(&data[26]);
+        const uint16_t  BPP         = readUInt16(&data[28]);
+        const uint32_t  COMPRESSION = readUInt32(&data[30]);
+        bool            isTopDown   = false;
+
+        /* A negative height means that the rows are stored top-down. */
+        if (0 > height)
+        {
+            height      = -height;
+            isTopDown   = true;
+        }
+
+        if ((40U <= DIB_SIZE) &&
+            (1U == PLANES) &&
+            (0 < WIDTH) &&
+            (MAX_SIZE >= WIDTH) &&
+            (0 < height) &&
+            (MAX_SIZE >= height) &&
+            (((24U == BPP) && (COMPRESSION_RGB == COMPRESSION)) ||
+             ((32U == BPP) && ((COMPRESSION_RGB == COMPRESSION) || (COMPRESSION_BITFIELDS == COMPRESSION)))))
+        {
+            m_width         = static_cast<uint16_t>(WIDTH);
+            m_height        = static_cast<uint16_t>(height);
+            m_isTopDown     = isTopDown;
+            m_bytesPerPixel = BPP / 8U;
+            m_dataOffset    = DATA_OFFSET;
+
+            /* Every row is padded to a multiple of 4 bytes. */
+            m_rowSize       = ((static_cast<uint32_t>(BPP) * m_width + 31U) / 32U) * 4U;
+
+            status = true;
+        }
+    }
+
+    return status;
+}
+
+void BmpDecoder::decodeRow(const uint8_t* data, Color* row) const
+{
+    uint16_t x = 0U;
+
+    /* The pixels are stored in BGR(A) order. */
+    for(x = 0U; x < m_width; ++x)
+    {
+        row[x].set(data[2], data[1], data[0]);
+        data += m_bytesPerPixel;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
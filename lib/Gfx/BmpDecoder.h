@@ -0,0 +1,221 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  BMP decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __BMP_DECODER_H__
+#define __BMP_DECODER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <Color.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decoder for uncompressed 24-bit and 32-bit Windows bitmap files.
+ *
+ * The decoder doesn't access the file itself. The caller reads the header
+ * and afterwards the pixel data sequentially in chunks of complete rows,
+ * which are converted row by row. This way the file is read without seeking
+ * for every pixel.
+ */
+class BmpDecoder
+{
+public:
+
+    /** Number of bytes at the begin of the file, which are necessary to parse the header. */
+    static const size_t HEADER_SIZE = 34U;
+
+    /**
+     * Constructs a bitmap decoder.
+     */
+    BmpDecoder() :
+        m_width(0U),
+        m_height(0U),
+        m_isTopDown(false),
+        m_bytesPerPixel(0U),
+        m_dataOffset(0U),
+        m_rowSize(0U)
+    {
+    }
+
+    /**
+     * Destroys the bitmap decoder.
+     */
+    ~BmpDecoder()
+    {
+    }
+
+    /**
+     * Parse the bitmap file header.
+     *
+     * @param[in] data  Begin of the bitmap file
+     * @param[in] size  Number of bytes, must be at least HEADER_SIZE.
+     *
+     * @return If the bitmap format is supported, it will return true otherwise false.
+     */
+    bool parseHeader(const uint8_t* data, size_t size);
+
+    /**
+     * Get bitmap width.
+     *
+     * @return Bitmap width in pixel
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Get bitmap height.
+     *
+     * @return Bitmap height in pixel
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Get the file offset of the pixel data.
+     *
+     * @return Offset in byte
+     */
+    uint32_t getDataOffset() const
+    {
+        return m_dataOffset;
+    }
+
+    /**
+     * Get the size of a single row in the file, incl. padding.
+     *
+     * @return Row size in byte
+     */
+    uint32_t getRowSize() const
+    {
+        return m_rowSize;
+    }
+
+    /**
+     * Get the y-coordinate in the bitmap of a row in the file.
+     * Usually the rows are stored bottom-up.
+     *
+     * @param[in] fileRow   Index of the row in the file
+     *
+     * @return y-coordinate in the bitmap
+     */
+    uint16_t getY(uint16_t fileRow) const
+    {
+        uint16_t y = fileRow;
+
+        if (false == m_isTopDown)
+        {
+            y = m_height - 1U - fileRow;
+        }
+
+        return y;
+    }
+
+    /**
+     * Convert a single row of the file to colors.
+     *
+     * @param[in]  data Row data, must be getRowSize() bytes.
+     * @param[out] row  Colors, must be getWidth() elements.
+     */
+    void decodeRow(const uint8_t* data, Color* row) const;
+
+private:
+
+    /** Compression method: none */
+    static const uint32_t   COMPRESSION_RGB         = 0U;
+
+    /** Compression method: bitfields, supported only with the default BGRA masks */
+    static const uint32_t   COMPRESSION_BITFIELDS   = 3U;
+
+    /** Max. supported width/height in pixel */
+    static const int32_t    MAX_SIZE                = 1024;
+
+    uint16_t    m_width;            /**< Bitmap width in pixel */
+    uint16_t    m_height;           /**< Bitmap height in pixel */
+    bool        m_isTopDown;        /**< Rows are stored top-down instead of bottom-up */
+    uint8_t     m_bytesPerPixel;    /**< Number of bytes per pixel */
+    uint32_t    m_dataOffset;       /**< File offset of the pixel data in byte */
+    uint32_t    m_rowSize;          /**< Row size in the file incl. padding in byte */
+
+    /**
+     * Read a little endian 16-bit value.
+     *
+     * @param[in] data  Data
+     *
+     * @return Value
+     */
+    static uint16_t readUInt16(const uint8_t* data)
+    {
+        return static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8U);
+    }
+
+    /**
+     * Read a little endian 32-bit value.
+     *
+     * @param[in] data  Data
+     *
+     * @return Value
+     */
+    static uint32_t readUInt32(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(readUInt16(&data[0])) | (static_cast<uint32_t>(readUInt16(&data[2])) << 16U);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BMP_DECODER_H__ */
+
+/** @} */
\ No newline at end of file
@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "Canvas.h"
 
+#include <ColorDef.hpp>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -61,6 +63,90 @@ const char* Canvas::WIDGET_TYPE = "canvas";
  * Public Methods
  *****************************************************************************/
 
+void Canvas::update(IGfx& gfx)
+{
+    if (nullptr != m_buffer)
+    {
+        updateBuffered(gfx);
+    }
+    else
+    {
+        updateRetained(gfx);
+    }
+
+    return;
+}
+
+Widget* Canvas::find(uint32_t id)
+{
+    Widget* widget  = nullptr;
+    uint8_t index   = 0U;
+
+    if (ID_NONE == id)
+    {
+        return nullptr;
+    }
+
+    /* Flatten the widget tree again, if it changed since the last lookup. */
+    if (getTreeGeneration() != m_lookupGeneration)
+    {
+        m_lookupCount       = 0U;
+        m_isLookupComplete  = collectIds(m_lookup, m_lookupCount, MAX_LOOKUP_ENTRIES);
+        m_lookupGeneration  = getTreeGeneration();
+    }
+
+    while((nullptr == widget) && (m_lookupCount > index))
+    {
+        if (id == m_lookup[index].id)
+        {
+            widget = m_lookup[index].widget;
+        }
+
+        ++index;
+    }
+
+    /* If the widget tree doesn't fit into the lookup table, the widgets
+     * which are not in the table are searched the slow way.
+     */
+    if ((nullptr == widget) &&
+        (false == m_isLookupComplete))
+    {
+        WidgetListIterator it(m_widgets);
+
+        if (true == it.first())
+        {
+            do
+            {
+                widget = (*it.current())->find(id);
+            }
+            while(  (nullptr == widget) &&
+                    (true == it.next()));
+        }
+    }
+
+    return widget;
+}
+
+bool Canvas::collectIds(IdEntry* entries, uint8_t& count, uint8_t maxEntries)
+{
+    bool                isComplete  = Widget::collectIds(entries, count, maxEntries);
+    WidgetListIterator  it(m_widgets);
+
+    if (true == it.first())
+    {
+        do
+        {
+            if (false == (*it.current())->collectIds(entries, count, maxEntries))
+            {
+                isComplete = false;
+            }
+        }
+        while(true == it.next());
+    }
+
+    return isComplete;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -69,6 +155,203 @@ const char* Canvas::WIDGET_TYPE = "canvas";
  * Private Methods
  *****************************************************************************/
 
+void Canvas::updateBuffered(IGfx& gfx)
+{
+    WidgetListIterator              it(m_widgets);
+    const bool                      IS_FULL_UPDATE  = (true == m_isInvalid) ||
+                                                      (true == m_isRedrawPending) ||
+                                                      (&gfx != m_lastGfx);
+
+    m_isInvalid = false;
+    m_lastGfx   = &gfx;
+
+    /* Walk through all widgets and draw them in the priority as
+     * they were added.
+     */
+    if (true == it.first())
+    {
+        do
+        {
+            Widget* widget = *it.current();
+
+            widget->m_isInvalid = false;
+            widget->update(*this);
+        }
+        while(true == it.next());
+    }
+
+    /* The content of the underlying canvas is unknown, copy the whole buffer. */
+    if (true == IS_FULL_UPDATE)
+    {
+        markDirty();
+    }
+
+    updateFromBuffer(gfx);
+
+    return;
+}
+
+void Canvas::updateRetained(IGfx& gfx)
+{
+    WidgetListIterator              it(m_widgets);
+    const bool                      IS_FULL_REDRAW  = (true == m_isInvalid) ||
+                                                      (true == m_isRedrawPending) ||
+                                                      (&gfx != m_lastGfx);
+    int16_t                         x1              = 0;
+    int16_t                         y1              = 0;
+    int16_t                         x2              = -1;
+    int16_t                         y2              = -1;
+    bool                            isAnyPending    = false;
+
+    m_isInvalid = false;
+    m_lastGfx   = &gfx;
+
+    /* The content of the underlying canvas is unknown, draw everything. */
+    if (true == IS_FULL_REDRAW)
+    {
+        x2 = getWidth() - 1;
+        y2 = getHeight() - 1;
+    }
+
+    /* Determine the widgets, which must be drawn again and the area they covered so far. */
+    if (true == it.first())
+    {
+        do
+        {
+            Widget* widget = *it.current();
+
+            widget->m_isRedrawPending = (true == IS_FULL_REDRAW) || (true == widget->isInvalid());
+
+            if (true == widget->m_isRedrawPending)
+            {
+                uniteArea(x1, y1, x2, y2, widget->m_areaX1, widget->m_areaY1, widget->m_areaX2, widget->m_areaY2);
+                isAnyPending = true;
+            }
+        }
+        while(true == it.next());
+    }
+
+    /* Anything to draw? */
+    if ((true == isAnyPending) ||
+        ((x1 <= x2) && (y1 <= y2)))
+    {
+        int16_t y = 0;
+
+        m_gfx = &gfx;
+
+        /* Clear the area. */
+        for(y = y1; y <= y2; ++y)
+        {
+            fillSpan(x1, y, x2 - x1 + 1, ColorDef::BLACK);
+        }
+
+        /* Walk through all widgets and draw them in the priority as
+         * they were added.
+         */
+        if (true == it.first())
+        {
+            do
+            {
+                Widget* widget = *it.current();
+
+                /* The invalid widgets may draw anywhere, their new area is recorded. */
+                if (true == widget->m_isRedrawPending)
+                {
+                    widget->m_isInvalid = false;
+
+                    m_recordX1      = 0;
+                    m_recordY1      = 0;
+                    m_recordX2      = -1;
+                    m_recordY2      = -1;
+                    m_isRecording   = true;
+
+                    widget->update(*this);
+
+                    m_isRecording   = false;
+
+                    widget->m_areaX1 = m_recordX1;
+                    widget->m_areaY1 = m_recordY1;
+                    widget->m_areaX2 = m_recordX2;
+                    widget->m_areaY2 = m_recordY2;
+
+                    /* The widgets above must be drawn again in the new area too. */
+                    uniteArea(x1, y1, x2, y2, m_recordX1, m_recordY1, m_recordX2, m_recordY2);
+                }
+                /* The valid widgets are drawn only in the cleared area, if they overlap it. */
+                else if ((widget->m_areaX1 <= widget->m_areaX2) &&
+                         (widget->m_areaX1 <= x2) &&
+                         (widget->m_areaX2 >= x1) &&
+                         (widget->m_areaY1 <= y2) &&
+                         (widget->m_areaY2 >= y1))
+                {
+                    /* The clipping stack is empty here, therefore the push can't fail. */
+                    (void)pushClip(x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+
+                    /* A canvas widget shall draw all of its widgets. */
+                    widget->m_isRedrawPending = true;
+                    widget->update(*this);
+
+                    popClip();
+                }
+                else
+                {
+                    ;
+                }
+
+                widget->m_isRedrawPending = false;
+            }
+            while(true == it.next());
+        }
+
+        m_gfx = nullptr;
+    }
+
+    return;
+}
+
+void Canvas::uniteArea(int16_t& x1, int16_t& y1, int16_t& x2, int16_t& y2, int16_t ox1, int16_t oy1, int16_t ox2, int16_t oy2)
+{
+    /* Other area is empty? */
+    if ((ox1 > ox2) ||
+        (oy1 > oy2))
+    {
+        ;
+    }
+    /* Area is empty? */
+    else if ((x1 > x2) ||
+             (y1 > y2))
+    {
+        x1 = ox1;
+        y1 = oy1;
+        x2 = ox2;
+        y2 = oy2;
+    }
+    else
+    {
+        if (x1 > ox1)
+        {
+            x1 = ox1;
+        }
+
+        if (y1 > oy1)
+        {
+            y1 = oy1;
+        }
+
+        if (x2 < ox2)
+        {
+            x2 = ox2;
+        }
+
+        if (y2 < oy2)
+        {
+            y2 = oy2;
+        }
+    }
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
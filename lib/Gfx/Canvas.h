@@ -40,13 +40,24 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Pixel storage format of a buffered canvas:
+ * 0: RGB888 format (3 byte per pixel)
+ * 1: RGB565 format (2 byte per pixel)
+ */
+#ifndef CANVAS_PIXEL_FORMAT
+#define CANVAS_PIXEL_FORMAT (0)
+#endif  /* CANVAS_PIXEL_FORMAT */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <stdint.h>
 #include <WString.h>
-#include <LinkedList.hpp>
+#include <FixedList.hpp>
 #include <Widget.hpp>
+#include <PixelFormat.hpp>
+#include <MemPolicy.h>
 
 /******************************************************************************
  * Macros
@@ -59,11 +70,43 @@
 /**
  * This class defines a drawing canvas. The canvas can contain several widgets
  * and will update their drawings.
+ *
+ * A canvas, which is not buffered, keeps the look of the underlying canvas
+ * between two updates. Only the area of invalid widgets is cleared with
+ * the background color and drawn again, incl. the parts of other widgets,
+ * which overlap it. If no widget changed, an update costs nearly nothing.
+ * Therefore the underlying canvas must not be changed by anyone else in
+ * between, otherwise call invalidate() before.
+ *
+ * A buffered canvas draws all widgets in its buffer with every update and
+ * copies only the changed pixels to the underlying canvas.
  */
 class Canvas : public IGfx, public Widget
 {
 public:
 
+#if (0 == CANVAS_PIXEL_FORMAT)
+    /** Pixel storage of a buffered canvas */
+    typedef Rgb888Pixel Pixel;
+#elif (1 == CANVAS_PIXEL_FORMAT)
+    /** Pixel storage of a buffered canvas */
+    typedef Rgb565Pixel Pixel;
+#else
+#error Unsupported canvas pixel format.
+#endif
+
+    /** Max. number of widgets in a canvas */
+    static const uint32_t MAX_WIDGETS = 8U;
+
+    /** Max. number of widgets in the lookup table of a canvas, incl. the widgets of nested canvases. */
+    static const uint8_t MAX_LOOKUP_ENTRIES = 16U;
+
+    /** Widgets in a canvas */
+    typedef FixedList<Widget*, MAX_WIDGETS> WidgetList;
+
+    /** Iterator over the widgets in a canvas */
+    typedef FixedListIterator<Widget*, MAX_WIDGETS> WidgetListIterator;
+
     /**
      * Constructs a canvas.
      *
@@ -71,18 +114,40 @@ public:
      * @param[in] height        Canvas height in pixel.
      * @param[in] x             x-coordinate position in the matrix.
      * @param[in] y             y-coordinate position in the matrix.
-     * @param[in] isBuffered    Create a buffered (true) canvas or not (false)
+     * @param[in] isBuffered    Create a buffered (true) canvas or not (false).
+     *                          The buffer stores the pixels in the format
+     *                          selected by CANVAS_PIXEL_FORMAT.
      */
     Canvas(uint16_t width, uint16_t height, int16_t x, int16_t y, bool isBuffered = false) :
         IGfx(width, height),
         Widget(WIDGET_TYPE, x, y),
         m_gfx(nullptr),
         m_widgets(),
-        m_buffer(nullptr)
+        m_buffer(nullptr),
+        m_dirtyX1(0),
+        m_dirtyY1(0),
+        m_dirtyX2(-1),
+        m_dirtyY2(-1),
+        m_lastGfx(nullptr),
+        m_isRecording(false),
+        m_recordX1(0),
+        m_recordY1(0),
+        m_recordX2(-1),
+        m_recordY2(-1),
+        m_lookup(),
+        m_lookupCount(0U),
+        m_isLookupComplete(false),
+        m_lookupGeneration(getTreeGeneration() - 1U)
     {
         if (true == isBuffered)
         {
-            m_buffer = new Color[width * height];
+            /* The buffer is accessed with every update, keep it in the internal SRAM. */
+            m_buffer = MemPolicy::allocateArray<Pixel>(MemPolicy::REGION_FAST, width * height);
+
+            /* The underlying canvas content is unknown, therefore the
+             * whole buffer must be copied with the first flush.
+             */
+            markDirty();
         }
     }
 
@@ -97,7 +162,7 @@ public:
         /* Release buffer */
         if (nullptr != m_buffer)
         {
-            delete[] m_buffer;
+            MemPolicy::releaseArray(m_buffer, getWidth() * getHeight());
             m_buffer = nullptr;
         }
     }
@@ -112,6 +177,13 @@ public:
     bool addWidget(Widget& widget)
     {
         Widget* ptr = &widget;
+
+        /* A new widget is drawn completely with the next update. */
+        widget.invalidate();
+
+        /* The lookup tables must be built again. */
+        ++getTreeGeneration();
+
         return m_widgets.append(ptr);
     }
 
@@ -125,7 +197,7 @@ public:
     bool removeWidget(const Widget& widget)
     {
         bool                            status = false;
-        DLinkedListIterator<Widget*>    it(m_widgets);
+        WidgetListIterator              it(m_widgets);
 
         /* Find widget in the list */
         if (true == it.find(&const_cast<Widget&>(widget)))
@@ -133,6 +205,12 @@ public:
             /* Remove widget */
             it.remove();
             status = true;
+
+            /* The area of the removed widget must be cleared. */
+            invalidate();
+
+            /* The lookup tables must be built again. */
+            ++getTreeGeneration();
         }
 
         return status;
@@ -143,7 +221,7 @@ public:
      *
      * @return Children
      */
-    const DLinkedList<Widget*>& children() const
+    const WidgetList& children() const
     {
         return m_widgets;
     }
@@ -154,76 +232,295 @@ public:
      *
      * @param[in] gfx   Graphics interface
      */
-    void update(IGfx& gfx) override
+    void update(IGfx& gfx) override;
+
+    /**
+     * Is the canvas invalid and needs to be drawn again?
+     * It is, if any of its widgets is invalid or in a buffered canvas any
+     * pixel changed.
+     *
+     * @return If invalid, it will return true otherwise false.
+     */
+    bool isInvalid() override
     {
-        DLinkedListIterator<Widget*> it(m_widgets);
+        bool                            isInvalid   = Widget::isInvalid();
+        WidgetListIterator              it(m_widgets);
+
+        if ((false == isInvalid) &&
+            (nullptr != m_buffer))
+        {
+            isInvalid = isDirty();
+        }
 
-        /* Walk through all widgets and draw them in the priority as
-         * they were added.
-         */
-        if (true == it.first())
+        if ((false == isInvalid) &&
+            (true == it.first()))
         {
-            /* If canvas is not buffered, draw directly on the underlying canvas. */
-            if (nullptr == m_buffer)
+            do
             {
-                m_gfx = &gfx;
+                isInvalid = (*it.current())->isInvalid();
             }
+            while((false == isInvalid) &&
+                  (true == it.next()));
+        }
 
-            do
+        return isInvalid;
+    }
+
+    /**
+     * Update from the canvas buffer with the given graphics interface.
+     * Only the pixels which changed since the last call (dirty region) are
+     * copied, therefore the given graphics interface must be always the same
+     * and must not be modified by anyone else in between. Otherwise call
+     * markDirty() before.
+     * Note, only useable in case the canvas is buffered.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void updateFromBuffer(IGfx& gfx)
+    {
+        /* In a buffered canvas, only the dirty region of the buffer into the underlying canvas. */
+        if ((nullptr != m_buffer) &&
+            (true == isDirty()))
+        {
+            const uint16_t  LENGTH  = m_dirtyX2 - m_dirtyX1 + 1;
+            int16_t         y       = 0;
+
+            for(y = m_dirtyY1; y <= m_dirtyY2; ++y)
             {
-                (*it.current())->update(*this);
+                flushSpan(gfx, m_dirtyX1, y, LENGTH);
             }
-            while(true == it.next());
 
-            m_gfx = nullptr;
+            clearDirty();
         }
 
-        /* In a buffered canvas, only the buffer into the underlying canvas. */
-        if (nullptr != m_buffer)
+        return;
+    }
+
+    /**
+     * Is the buffer content changed since the last updateFromBuffer() call?
+     * Note, only useable in case the canvas is buffered.
+     *
+     * @return If any pixel changed, it will return true otherwise false.
+     */
+    bool isDirty() const
+    {
+        return (m_dirtyX1 <= m_dirtyX2) && (m_dirtyY1 <= m_dirtyY2);
+    }
+
+    /**
+     * Mark the whole canvas as dirty, which forces the next updateFromBuffer()
+     * call to copy the complete buffer. Use it in case the content of the
+     * underlying canvas was changed by someone else.
+     */
+    void markDirty()
+    {
+        m_dirtyX1 = 0;
+        m_dirtyY1 = 0;
+        m_dirtyX2 = getWidth() - 1;
+        m_dirtyY2 = getHeight() - 1;
+
+        return;
+    }
+
+    /* Find by name is provided by the base widget. */
+    using Widget::find;
+
+    /**
+     * Find widget by its id in the canvas and all nested canvases.
+     * The widget tree is flattened once into a lookup table, which is only
+     * built again after a widget id or the children of a canvas changed.
+     *
+     * @param[in] id    Widget id to search for
+     *
+     * @return If widget is found, it will be returned otherwise nullptr.
+     */
+    Widget* find(uint32_t id) override;
+
+    /**
+     * Collect the ids of the canvas and all of its widgets in a flat lookup
+     * table. Widgets without id are skipped.
+     *
+     * @param[out]    entries     Lookup table
+     * @param[in,out] count       Number of used entries
+     * @param[in]     maxEntries  Max. number of entries
+     *
+     * @return If all ids fit into the lookup table, it will return true otherwise false.
+     */
+    bool collectIds(IdEntry* entries, uint8_t& count, uint8_t maxEntries) override;
+
+    /** Widget type string */
+    static const char*      WIDGET_TYPE;
+
+private:
+
+    IGfx*                   m_gfx;      /**< Graphics interface of the underlying layer */
+    WidgetList              m_widgets;  /**< Widgets in the canvas */
+    Pixel*                  m_buffer;   /**< Buffer */
+    int16_t                 m_dirtyX1;  /**< Dirty region upper left x-coordinate */
+    int16_t                 m_dirtyY1;  /**< Dirty region upper left y-coordinate */
+    int16_t                 m_dirtyX2;  /**< Dirty region lower right x-coordinate (inclusive) */
+    int16_t                 m_dirtyY2;  /**< Dirty region lower right y-coordinate (inclusive) */
+    const IGfx*             m_lastGfx;  /**< Graphics interface used by the last update */
+    bool                    m_isRecording;  /**< Record the area of the drawn pixels */
+    int16_t                 m_recordX1; /**< Recorded area upper left x-coordinate */
+    int16_t                 m_recordY1; /**< Recorded area upper left y-coordinate */
+    int16_t                 m_recordX2; /**< Recorded area lower right x-coordinate (inclusive) */
+    int16_t                 m_recordY2; /**< Recorded area lower right y-coordinate (inclusive) */
+    IdEntry                 m_lookup[MAX_LOOKUP_ENTRIES];   /**< Flat lookup table of the widget tree */
+    uint8_t                 m_lookupCount;      /**< Number of used lookup table entries */
+    bool                    m_isLookupComplete; /**< Contains the lookup table all widgets with id? */
+    uint32_t                m_lookupGeneration; /**< Widget tree generation, the lookup table was built for. */
+
+    Canvas(const Canvas& canvas);
+    Canvas& operator=(const Canvas& canvas);
+
+    /**
+     * Copy a horizontal run of pixels from the buffer to the given graphics interface.
+     * The run must be completely inside the canvas.
+     *
+     * @param[in] gfx       Graphics interface
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     */
+    void flushSpan(IGfx& gfx, int16_t x, int16_t y, uint16_t length) const
+    {
+        Color           row[COPY_SPAN_LENGTH];
+        const Pixel*    pixel   = &m_buffer[x + y * getWidth()];
+        uint16_t        index   = 0U;
+
+        while(length > index)
         {
-            int16_t x = 0;
-            int16_t y = 0;
+            uint16_t chunkLength    = length - index;
+            uint16_t chunkIndex     = 0U;
 
-            for(y = 0; y < getHeight(); ++y)
+            if (COPY_SPAN_LENGTH < chunkLength)
             {
-                for(x = 0; x < getWidth(); ++x)
-                {
-                    gfx.drawPixel(x, y, m_buffer[x + y * getWidth()]);
-                }
+                chunkLength = COPY_SPAN_LENGTH;
+            }
+
+            for(chunkIndex = 0U; chunkIndex < chunkLength; ++chunkIndex)
+            {
+                row[chunkIndex] = pixel[index + chunkIndex].get();
             }
+
+            gfx.writeSpan(x + index, y, row, chunkLength);
+
+            index += chunkLength;
         }
 
         return;
     }
 
     /**
-     * Update from the canvas buffer with the given graphics interface.
-     * Note, only useable in case the canvas is buffered.
+     * Extend the dirty region by the given pixel.
      *
-     * @param[in] gfx   Graphics interface
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
      */
-    void updateFromBuffer(IGfx& gfx)
+    void addDirty(int16_t x, int16_t y)
     {
-        /* In a buffered canvas, only the buffer into the underlying canvas. */
-        if (nullptr != m_buffer)
+        if (false == isDirty())
+        {
+            m_dirtyX1 = x;
+            m_dirtyY1 = y;
+            m_dirtyX2 = x;
+            m_dirtyY2 = y;
+        }
+        else
         {
-            int16_t x = 0;
-            int16_t y = 0;
+            if (m_dirtyX1 > x)
+            {
+                m_dirtyX1 = x;
+            }
+            else if (m_dirtyX2 < x)
+            {
+                m_dirtyX2 = x;
+            }
+            else
+            {
+                ;
+            }
 
-            for(y = 0; y < getHeight(); ++y)
+            if (m_dirtyY1 > y)
             {
-                for(x = 0; x < getWidth(); ++x)
-                {
-                    gfx.drawPixel(x, y, m_buffer[x + y * getWidth()]);
-                }
+                m_dirtyY1 = y;
+            }
+            else if (m_dirtyY2 < y)
+            {
+                m_dirtyY2 = y;
             }
+            else
+            {
+                ;
+            }
+        }
+
+        return;
+    }
+
+    /**
+     * Clear the dirty region.
+     */
+    void clearDirty()
+    {
+        m_dirtyX1 = 0;
+        m_dirtyY1 = 0;
+        m_dirtyX2 = -1;
+        m_dirtyY2 = -1;
+
+        return;
+    }
+
+    /**
+     * Update the widgets in the buffer and copy the changed pixels to the
+     * given graphics interface.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void updateBuffered(IGfx& gfx);
+
+    /**
+     * Update only the area of the invalid widgets directly on the given
+     * graphics interface.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void updateRetained(IGfx& gfx);
+
+    /**
+     * Unite an area with another one. An area with x1 > x2 is empty.
+     *
+     * @param[in,out]   x1  Upper left x-coordinate
+     * @param[in,out]   y1  Upper left y-coordinate
+     * @param[in,out]   x2  Lower right x-coordinate (inclusive)
+     * @param[in,out]   y2  Lower right y-coordinate (inclusive)
+     * @param[in]       ox1 Other upper left x-coordinate
+     * @param[in]       oy1 Other upper left y-coordinate
+     * @param[in]       ox2 Other lower right x-coordinate (inclusive)
+     * @param[in]       oy2 Other lower right y-coordinate (inclusive)
+     */
+    static void uniteArea(int16_t& x1, int16_t& y1, int16_t& x2, int16_t& y2, int16_t ox1, int16_t oy1, int16_t ox2, int16_t oy2);
+
+    /**
+     * Record a horizontal run of drawn pixels, if recording is enabled.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     */
+    void record(int16_t x, int16_t y, uint16_t length)
+    {
+        if (true == m_isRecording)
+        {
+            uniteArea(m_recordX1, m_recordY1, m_recordX2, m_recordY2, x, y, x + length - 1, y);
         }
 
         return;
     }
 
     /**
-     * Get pixel color at given position.
+     * Get pixel color at given position, which is inside the clipping region.
      * Note, only useable in case the canvas is buffered.
      *
      * @param[in] x x-coordinate
@@ -231,139 +528,300 @@ public:
      *
      * @return Color in RGB888 format.
      */
-    Color getColor(int16_t x, int16_t y) const final
+    Color getColorUnchecked(int16_t x, int16_t y) const final
     {
         Color color;
 
-        if ((0 <= x) &&
-            (0 <= y) &&
-            (getWidth() > x) &&
-            (getHeight() > y) &&
-            (nullptr != m_buffer))
+        if (nullptr != m_buffer)
         {
-            color = m_buffer[x + y * getWidth()];
+            color = m_buffer[x + y * getWidth()].get();
         }
 
         return color;
     }
 
     /**
-     * Find widget by its name.
+     * Read a horizontal run of pixels, which is inside the clipping region.
+     * Note, only useable in case the canvas is buffered.
      *
-     * @param[in] name  Widget name to search for
+     * @param[in]  x        x-coordinate of the first pixel
+     * @param[in]  y        y-coordinate of the first pixel
+     * @param[out] colors   Colors of the pixels in RGB888 format
+     * @param[in]  length   Number of pixels
+     */
+    void readSpanUnchecked(int16_t x, int16_t y, Color* colors, uint16_t length) const final
+    {
+        if (nullptr != m_buffer)
+        {
+            const Pixel*    pixel   = &m_buffer[x + y * getWidth()];
+            uint16_t        index   = 0U;
+
+            for(index = 0U; index < length; ++index)
+            {
+                colors[index] = pixel[index].get();
+            }
+        }
+        else
+        {
+            IGfx::readSpanUnchecked(x, y, colors, length);
+        }
+
+        return;
+    }
+
+    /**
+     * Draw a single pixel, which is inside the clipping region.
      *
-     * @return If widget is found, it will be returned otherwise nullptr.
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
      */
-    Widget* find(const String& name) override
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
     {
-        Widget* widget = nullptr;
+        record(x, y, 1U);
+
+        /* Draw on the real underlying canvas? */
+        if (nullptr != m_gfx)
+        {
+            m_gfx->drawPixel(m_posX + x, m_posY + y, color);
+        }
+        /* Draw into buffer? */
+        else if (nullptr != m_buffer)
+        {
+            Pixel&      pixel   = m_buffer[x + y * getWidth()];
+            const Pixel NEW_PIXEL(color);
 
-        if (name == m_name)
+            /* Only a change shall be flushed later. */
+            if (pixel != NEW_PIXEL)
+            {
+                pixel = NEW_PIXEL;
+                addDirty(x, y);
+            }
+        }
+        /* Skip drawing */
+        else
         {
-            widget = this;
+            ;
         }
 
-        /* If its not the canvas itself, continue searching in the widget list. */
-        if (nullptr == widget)
+        return;
+    }
+
+    /**
+     * Write a horizontal run of pixels, which is inside the clipping region.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Colors of the pixels
+     * @param[in] length    Number of pixels
+     */
+    void writeSpanUnchecked(int16_t x, int16_t y, const Color* colors, uint16_t length) final
+    {
+        record(x, y, length);
+
+        /* Draw on the real underlying canvas? */
+        if (nullptr != m_gfx)
+        {
+            m_gfx->writeSpan(m_posX + x, m_posY + y, colors, length);
+        }
+        /* Draw into buffer? */
+        else if (nullptr != m_buffer)
         {
-            DLinkedListIterator<Widget*> it(m_widgets);
+            Pixel*      pixel       = &m_buffer[x + y * getWidth()];
+            uint16_t    index       = 0U;
+            int16_t     firstDirty  = -1;
+            int16_t     lastDirty   = -1;
 
-            if (true == it.first())
+            for(index = 0U; index < length; ++index)
             {
-                do
+                const Pixel NEW_PIXEL(colors[index]);
+
+                /* Only a change shall be flushed later. */
+                if (pixel[index] != NEW_PIXEL)
                 {
-                    widget = (*it.current())->find(name);
+                    if (0 > firstDirty)
+                    {
+                        firstDirty = index;
+                    }
+
+                    lastDirty       = index;
+                    pixel[index]    = NEW_PIXEL;
                 }
-                while(  (nullptr == widget) &&
-                        (true == it.next()));
             }
+
+            if (0 <= firstDirty)
+            {
+                addDirty(x + firstDirty, y);
+                addDirty(x + lastDirty, y);
+            }
+        }
+        /* Skip drawing */
+        else
+        {
+            ;
         }
 
-        return widget;
+        return;
     }
 
-    /** Widget type string */
-    static const char*      WIDGET_TYPE;
+    /**
+     * Fill a horizontal run of pixels with a single color, which is inside
+     * the clipping region.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        record(x, y, length);
 
-private:
+        /* Draw on the real underlying canvas? */
+        if (nullptr != m_gfx)
+        {
+            m_gfx->fillSpan(m_posX + x, m_posY + y, length, color);
+        }
+        /* Draw into buffer? */
+        else if (nullptr != m_buffer)
+        {
+            const Pixel NEW_PIXEL(color);
+            Pixel*      pixel       = &m_buffer[x + y * getWidth()];
+            uint16_t    index       = 0U;
+            int16_t     firstDirty  = -1;
+            int16_t     lastDirty   = -1;
 
-    IGfx*                   m_gfx;      /**< Graphics interface of the underlying layer */
-    DLinkedList<Widget*>    m_widgets;  /**< Widgets in the canvas */
-    Color*                  m_buffer;   /**< Buffer */
+            for(index = 0U; index < length; ++index)
+            {
+                /* Only a change shall be flushed later. */
+                if (pixel[index] != NEW_PIXEL)
+                {
+                    if (0 > firstDirty)
+                    {
+                        firstDirty = index;
+                    }
 
-    Canvas(const Canvas& canvas);
-    Canvas& operator=(const Canvas& canvas);
+                    lastDirty       = index;
+                    pixel[index]    = NEW_PIXEL;
+                }
+            }
+
+            if (0 <= firstDirty)
+            {
+                addDirty(x + firstDirty, y);
+                addDirty(x + lastDirty, y);
+            }
+        }
+        /* Skip drawing */
+        else
+        {
+            ;
+        }
+
+        return;
+    }
 
     /**
-     * Draw a single pixel in the matrix and ensure that the drawing borders
-     * are not violated.
+     * Fill a vertical run of pixels with a single color, which is inside
+     * the clipping region.
      *
-     * @param[in] x     x-coordinate
-     * @param[in] y     y-coordinate
-     * @param[in] color Pixel color
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
      */
-    void drawPixel(int16_t x, int16_t y, const Color& color) final
+    void fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
     {
-        /* Don't draw outside the canvas. */
-        if ((0 <= x) &&
-            (getWidth() > x) &&
-            (0 <= y) &&
-            (getHeight() > y))
+        if (true == m_isRecording)
         {
-            /* Draw on the real underlying canvas? */
-            if (nullptr != m_gfx)
-            {
-                m_gfx->drawPixel(m_posX + x, m_posY + y, color);
-            }
-            /* Draw into buffer? */
-            else if (nullptr != m_buffer)
+            uniteArea(m_recordX1, m_recordY1, m_recordX2, m_recordY2, x, y, x, y + length - 1);
+        }
+
+        /* Draw on the real underlying canvas? */
+        if (nullptr != m_gfx)
+        {
+            m_gfx->drawVLine(m_posX + x, m_posY + y, length, color);
+        }
+        /* Draw into buffer? */
+        else if (nullptr != m_buffer)
+        {
+            const Pixel NEW_PIXEL(color);
+            Pixel*      pixel       = &m_buffer[x + y * getWidth()];
+            uint16_t    index       = 0U;
+            int16_t     firstDirty  = -1;
+            int16_t     lastDirty   = -1;
+
+            for(index = 0U; index < length; ++index)
             {
-                m_buffer[x + y * getWidth()] = color;
+                /* Only a change shall be flushed later. */
+                if (*pixel != NEW_PIXEL)
+                {
+                    if (0 > firstDirty)
+                    {
+                        firstDirty = index;
+                    }
+
+                    lastDirty   = index;
+                    *pixel      = NEW_PIXEL;
+                }
+
+                pixel += getWidth();
             }
-            /* Skip drawing */
-            else
+
+            if (0 <= firstDirty)
             {
-                ;
+                addDirty(x, y + firstDirty);
+                addDirty(x, y + lastDirty);
             }
         }
+        /* Skip drawing */
+        else
+        {
+            ;
+        }
 
         return;
     }
 
     /**
-     * Dim color to black.
+     * Dim color to black, which is inside the clipping region.
      * A dim ratio of 255 means no change.
      * 
-     * Note, the base colors may be destroyed, depends on the color type.
+     * Note, in a buffered canvas the base colors are destroyed, because the
+     * pixels are stored with the intensity already applied.
      *
      * @param[in] x     x-coordinate
      * @param[in] y     y-coordinate
      * @param[in] ratio Dim ration [0; 255]
      */
-    void dimPixel(int16_t x, int16_t y, uint8_t ratio) final
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
     {
-        /* Don't draw outside the canvas. */
-        if ((0 <= x) &&
-            (getWidth() > x) &&
-            (0 <= y) &&
-            (getHeight() > y))
+        record(x, y, 1U);
+
+        /* Draw on the real underlying canvas? */
+        if (nullptr != m_gfx)
         {
-            /* Draw on the real underlying canvas? */
-            if (nullptr != m_gfx)
-            {
-                m_gfx->dimPixel(m_posX + x, m_posY + y, ratio);
-            }
-            /* Draw into buffer? */
-            else if (nullptr != m_buffer)
-            {
-                m_buffer[x + y * getWidth()].setIntensity(ratio);
-            }
-            /* Skip drawing */
-            else
+            m_gfx->dimPixel(m_posX + x, m_posY + y, ratio);
+        }
+        /* Draw into buffer? */
+        else if (nullptr != m_buffer)
+        {
+            Pixel&      pixel       = m_buffer[x + y * getWidth()];
+            const Pixel PREV_PIXEL  = pixel;
+
+            pixel.dim(ratio);
+
+            /* Only a change shall be flushed later. */
+            if (PREV_PIXEL != pixel)
             {
-                ;
+                addDirty(x, y);
             }
         }
+        /* Skip drawing */
+        else
+        {
+            ;
+        }
 
         return;
     }
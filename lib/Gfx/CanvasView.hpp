@@ -0,0 +1,266 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Clipped and translated view onto a parent graphics
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __CANVASVIEW_HPP__
+#define __CANVASVIEW_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+#include <Widget.hpp>
+#include <ColorDef.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A canvas view is a rectangular window onto a parent graphics. It has no
+ * pixel buffer and no widget list, every drawing is clipped to the window
+ * and forwarded translated to the parent. Horizontal and vertical runs are
+ * forwarded as a whole, not pixel by pixel.
+ *
+ * It doesn't allocate anything, therefore it can be created on the stack
+ * right before drawing, e.g. in the update() of a plugin, or kept as member.
+ * The parent must live longer than the view.
+ *
+ * In contrast to a canvas, it doesn't track the area of several widgets.
+ * A widget, which owns the whole view, is drawn again only if it is invalid,
+ * see drawWidget().
+ */
+class CanvasView : public IGfx
+{
+public:
+
+    /**
+     * Constructs a view onto the parent graphics.
+     *
+     * @param[in] parent    Parent graphics
+     * @param[in] x         x-coordinate of the upper left view corner in the parent
+     * @param[in] y         y-coordinate of the upper left view corner in the parent
+     * @param[in] width     View width in pixel
+     * @param[in] height    View height in pixel
+     */
+    CanvasView(IGfx& parent, int16_t x, int16_t y, uint16_t width, uint16_t height) :
+        IGfx(width, height),
+        m_parent(parent),
+        m_offsetX(x),
+        m_offsetY(y)
+    {
+    }
+
+    /**
+     * Destroys the view. The parent content is kept.
+     */
+    ~CanvasView()
+    {
+    }
+
+    /**
+     * Get the x-coordinate of the upper left view corner in the parent.
+     *
+     * @return x-coordinate
+     */
+    int16_t getOffsetX() const
+    {
+        return m_offsetX;
+    }
+
+    /**
+     * Get the y-coordinate of the upper left view corner in the parent.
+     *
+     * @return y-coordinate
+     */
+    int16_t getOffsetY() const
+    {
+        return m_offsetY;
+    }
+
+    /**
+     * Draw a widget, which owns the whole view. If the widget is invalid,
+     * the view is cleared and the widget is drawn again. Otherwise nothing
+     * happens, because the parent still shows it.
+     *
+     * @param[in] widget    Widget
+     *
+     * @return If the widget was drawn, it will return true otherwise false.
+     */
+    bool drawWidget(Widget& widget)
+    {
+        bool isDrawn = false;
+
+        if (true == widget.isInvalid())
+        {
+            widget.m_isInvalid = false;
+
+            fillScreen(ColorDef::BLACK);
+            widget.update(*this);
+
+            isDrawn = true;
+        }
+
+        return isDrawn;
+    }
+
+private:
+
+    IGfx&   m_parent;   /**< Parent graphics */
+    int16_t m_offsetX;  /**< x-coordinate of the upper left view corner in the parent */
+    int16_t m_offsetY;  /**< y-coordinate of the upper left view corner in the parent */
+
+    CanvasView();
+    CanvasView(const CanvasView& view);
+    CanvasView& operator=(const CanvasView& view);
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    Color getColorUnchecked(int16_t x, int16_t y) const final
+    {
+        return m_parent.getColor(m_offsetX + x, m_offsetY + y);
+    }
+
+    /**
+     * Draw a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
+     */
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
+    {
+        m_parent.drawPixel(m_offsetX + x, m_offsetY + y, color);
+
+        return;
+    }
+
+    /**
+     * Dim pixel to black.
+     * A dim ratio of 255 means no change.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] ratio Dim ratio [0; 255]
+     */
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
+    {
+        m_parent.dimPixel(m_offsetX + x, m_offsetY + y, ratio);
+
+        return;
+    }
+
+    /**
+     * Write a horizontal run of pixels.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Colors of the pixels
+     * @param[in] length    Number of pixels
+     */
+    void writeSpanUnchecked(int16_t x, int16_t y, const Color* colors, uint16_t length) final
+    {
+        m_parent.writeSpan(m_offsetX + x, m_offsetY + y, colors, length);
+
+        return;
+    }
+
+    /**
+     * Read a horizontal run of pixels.
+     *
+     * @param[in]  x        x-coordinate of the first pixel
+     * @param[in]  y        y-coordinate of the first pixel
+     * @param[out] colors   Colors of the pixels
+     * @param[in]  length   Number of pixels
+     */
+    void readSpanUnchecked(int16_t x, int16_t y, Color* colors, uint16_t length) const final
+    {
+        m_parent.readSpan(m_offsetX + x, m_offsetY + y, colors, length);
+
+        return;
+    }
+
+    /**
+     * Fill a horizontal run of pixels with a single color.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        m_parent.fillSpan(m_offsetX + x, m_offsetY + y, length, color);
+
+        return;
+    }
+
+    /**
+     * Fill a vertical run of pixels with a single color.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        m_parent.drawVLine(m_offsetX + x, m_offsetY + y, length, color);
+
+        return;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __CANVASVIEW_HPP__ */
+
+/** @} */
@@ -54,41 +54,101 @@
  * Local Variables
  *****************************************************************************/
 
+/* Color wheel, which runs from red over blue and green back to red.
+ * Every color is based on only two base colors with a ramp of 3 per position.
+ */
+const uint32_t Color::COLOR_WHEEL[Color::COLOR_WHEEL_SIZE] =
+{
+    0x00ff0000U, 0x00fc0300U, 0x00f90600U, 0x00f60900U, 0x00f30c00U, 0x00f00f00U, 0x00ed1200U, 0x00ea1500U,
+    0x00e71800U, 0x00e41b00U, 0x00e11e00U, 0x00de2100U, 0x00db2400U, 0x00d82700U, 0x00d52a00U, 0x00d22d00U,
+    0x00cf3000U, 0x00cc3300U, 0x00c93600U, 0x00c63900U, 0x00c33c00U, 0x00c03f00U, 0x00bd4200U, 0x00ba4500U,
+    0x00b74800U, 0x00b44b00U, 0x00b14e00U, 0x00ae5100U, 0x00ab5400U, 0x00a85700U, 0x00a55a00U, 0x00a25d00U,
+    0x009f6000U, 0x009c6300U, 0x00996600U, 0x00966900U, 0x00936c00U, 0x00906f00U, 0x008d7200U, 0x008a7500U,
+    0x00877800U, 0x00847b00U, 0x00817e00U, 0x007e8100U, 0x007b8400U, 0x00788700U, 0x00758a00U, 0x00728d00U,
+    0x006f9000U, 0x006c9300U, 0x00699600U, 0x00669900U, 0x00639c00U, 0x00609f00U, 0x005da200U, 0x005aa500U,
+    0x0057a800U, 0x0054ab00U, 0x0051ae00U, 0x004eb100U, 0x004bb400U, 0x0048b700U, 0x0045ba00U, 0x0042bd00U,
+    0x003fc000U, 0x003cc300U, 0x0039c600U, 0x0036c900U, 0x0033cc00U, 0x0030cf00U, 0x002dd200U, 0x002ad500U,
+    0x0027d800U, 0x0024db00U, 0x0021de00U, 0x001ee100U, 0x001be400U, 0x0018e700U, 0x0015ea00U, 0x0012ed00U,
+    0x000ff000U, 0x000cf300U, 0x0009f600U, 0x0006f900U, 0x0003fc00U, 0x0000ff00U, 0x0000fc03U, 0x0000f906U,
+    0x0000f609U, 0x0000f30cU, 0x0000f00fU, 0x0000ed12U, 0x0000ea15U, 0x0000e718U, 0x0000e41bU, 0x0000e11eU,
+    0x0000de21U, 0x0000db24U, 0x0000d827U, 0x0000d52aU, 0x0000d22dU, 0x0000cf30U, 0x0000cc33U, 0x0000c936U,
+    0x0000c639U, 0x0000c33cU, 0x0000c03fU, 0x0000bd42U, 0x0000ba45U, 0x0000b748U, 0x0000b44bU, 0x0000b14eU,
+    0x0000ae51U, 0x0000ab54U, 0x0000a857U, 0x0000a55aU, 0x0000a25dU, 0x00009f60U, 0x00009c63U, 0x00009966U,
+    0x00009669U, 0x0000936cU, 0x0000906fU, 0x00008d72U, 0x00008a75U, 0x00008778U, 0x0000847bU, 0x0000817eU,
+    0x00007e81U, 0x00007b84U, 0x00007887U, 0x0000758aU, 0x0000728dU, 0x00006f90U, 0x00006c93U, 0x00006996U,
+    0x00006699U, 0x0000639cU, 0x0000609fU, 0x00005da2U, 0x00005aa5U, 0x000057a8U, 0x000054abU, 0x000051aeU,
+    0x00004eb1U, 0x00004bb4U, 0x000048b7U, 0x000045baU, 0x000042bdU, 0x00003fc0U, 0x00003cc3U, 0x000039c6U,
+    0x000036c9U, 0x000033ccU, 0x000030cfU, 0x00002dd2U, 0x00002ad5U, 0x000027d8U, 0x000024dbU, 0x000021deU,
+    0x00001ee1U, 0x00001be4U, 0x000018e7U, 0x000015eaU, 0x000012edU, 0x00000ff0U, 0x00000cf3U, 0x000009f6U,
+    0x000006f9U, 0x000003fcU, 0x000000ffU, 0x000300fcU, 0x000600f9U, 0x000900f6U, 0x000c00f3U, 0x000f00f0U,
+    0x001200edU, 0x001500eaU, 0x001800e7U, 0x001b00e4U, 0x001e00e1U, 0x002100deU, 0x002400dbU, 0x002700d8U,
+    0x002a00d5U, 0x002d00d2U, 0x003000cfU, 0x003300ccU, 0x003600c9U, 0x003900c6U, 0x003c00c3U, 0x003f00c0U,
+    0x004200bdU, 0x004500baU, 0x004800b7U, 0x004b00b4U, 0x004e00b1U, 0x005100aeU, 0x005400abU, 0x005700a8U,
+    0x005a00a5U, 0x005d00a2U, 0x0060009fU, 0x0063009cU, 0x00660099U, 0x00690096U, 0x006c0093U, 0x006f0090U,
+    0x0072008dU, 0x0075008aU, 0x00780087U, 0x007b0084U, 0x007e0081U, 0x0081007eU, 0x0084007bU, 0x00870078U,
+    0x008a0075U, 0x008d0072U, 0x0090006fU, 0x0093006cU, 0x00960069U, 0x00990066U, 0x009c0063U, 0x009f0060U,
+    0x00a2005dU, 0x00a5005aU, 0x00a80057U, 0x00ab0054U, 0x00ae0051U, 0x00b1004eU, 0x00b4004bU, 0x00b70048U,
+    0x00ba0045U, 0x00bd0042U, 0x00c0003fU, 0x00c3003cU, 0x00c60039U, 0x00c90036U, 0x00cc0033U, 0x00cf0030U,
+    0x00d2002dU, 0x00d5002aU, 0x00d80027U, 0x00db0024U, 0x00de0021U, 0x00e1001eU, 0x00e4001bU, 0x00e70018U,
+    0x00ea0015U, 0x00ed0012U, 0x00f0000fU, 0x00f3000cU, 0x00f60009U, 0x00f90006U, 0x00fc0003U, 0x00ff0000U
+};
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-void Color::turnColorWheel(uint8_t wheelPos)
+void Color::setHsv(uint8_t hue, uint8_t saturation, uint8_t value)
 {
-    const uint8_t COL_PARTS = 3U;
-    const uint8_t COL_RANGE = UINT8_MAX / COL_PARTS;
-
-    wheelPos = UINT8_MAX - wheelPos;
-
-    /* Red + Blue ? */
-    if (wheelPos < COL_RANGE)
-    {
-        m_red   = UINT8_MAX - wheelPos * COL_PARTS;
-        m_green = 0U;
-        m_blue  = COL_PARTS * wheelPos;
-    }
-    /* Green + Blue ? */
-    else if (wheelPos < (2 * COL_RANGE))
-    {
-        wheelPos -= COL_RANGE;
-        
-        m_red   = 0U;
-        m_green = COL_PARTS * wheelPos;
-        m_blue  = UINT8_MAX - wheelPos * COL_PARTS;
-    }
-    /* Red + Green */
-    else
+    /* The hue is split into 6 sectors. The upper byte is the sector and the
+     * lower byte the position inside the sector, which avoids a division.
+     * Factors are mapped to [0; 256], so the shift replaces the division.
+     */
+    const uint16_t  HUE6        = static_cast<uint16_t>(hue) * 6U;
+    const uint8_t   SECTOR      = static_cast<uint8_t>(HUE6 >> 8U);
+    const uint16_t  REMAINDER   = HUE6 & 0xffU;
+    const uint16_t  VALUE       = value;
+    const uint16_t  SATURATION  = saturation;
+    const uint8_t   P           = (VALUE * (256U - SATURATION)) >> 8U;
+    const uint8_t   Q           = (VALUE * (256U - ((SATURATION * REMAINDER) >> 8U))) >> 8U;
+    const uint8_t   T           = (VALUE * (256U - ((SATURATION * (256U - REMAINDER)) >> 8U))) >> 8U;
+
+    switch(SECTOR)
     {
-        wheelPos -= ((COL_PARTS - 1U) * COL_RANGE);
-        
-        m_red   = COL_PARTS * wheelPos;
-        m_green = UINT8_MAX - wheelPos * COL_PARTS;
-        m_blue  = 0U;
+    case 0U:
+        m_red   = value;
+        m_green = T;
+        m_blue  = P;
+        break;
+
+    case 1U:
+        m_red   = Q;
+        m_green = value;
+        m_blue  = P;
+        break;
+
+    case 2U:
+        m_red   = P;
+        m_green = value;
+        m_blue  = T;
+        break;
+
+    case 3U:
+        m_red   = P;
+        m_green = Q;
+        m_blue  = value;
+        break;
+
+    case 4U:
+        m_red   = T;
+        m_green = P;
+        m_blue  = value;
+        break;
+
+    default:
+        m_red   = value;
+        m_green = P;
+        m_blue  = Q;
+        break;
     }
 
     return;
@@ -355,24 +355,65 @@ public:
     /**
      * Set color according to the position in the color wheel.
      * It provides typical rainbow colors, which means a color is based on
-     * only two base colors.
+     * only two base colors. The colors are precalculated, so its a single
+     * table lookup.
      *
      * @param[in] wheelPos  Color wheel position
      */
-    void turnColorWheel(uint8_t wheelPos);
+    void turnColorWheel(uint8_t wheelPos)
+    {
+        const uint32_t value = COLOR_WHEEL[wheelPos];
+
+        m_red   = ColorDef::getRed(value);
+        m_green = ColorDef::getGreen(value);
+        m_blue  = ColorDef::getBlue(value);
+
+        return;
+    }
+
+    /**
+     * Set color by hue, saturation and value (HSV). The conversion uses
+     * fixed-point arithmetic only.
+     *
+     * @param[in] hue           Hue [0; 255], which corresponds to [0; 360) degree
+     * @param[in] saturation    Saturation [0; 255] - 0: grey / 255: full color
+     * @param[in] value         Value [0; 255] - 0: black / 255: max. bright
+     */
+    void setHsv(uint8_t hue, uint8_t saturation, uint8_t value);
 
 protected:
 
 private:
 
+    /** Number of color wheel positions. */
+    static const uint16_t   COLOR_WHEEL_SIZE    = UINT8_MAX + 1U;
+
+    /** Precalculated color wheel in RGB888 format, one color per position. */
+    static const uint32_t   COLOR_WHEEL[COLOR_WHEEL_SIZE];
+
     uint8_t m_red;          /**< Red intensity value */
     uint8_t m_green;        /**< Green intensity value */
     uint8_t m_blue;         /**< Blue intensity value */
     uint8_t m_intensity;    /**< Color intensity [0; 255] - 0: min. bright / 255: max. bright */
 
+    /**
+     * Apply the color intensity to a base color.
+     * Most colors have max. intensity, which needs no calculation.
+     *
+     * @param[in] baseColor Base color value
+     *
+     * @return Base color value with intensity applied
+     */
     inline uint8_t applyIntensity(uint8_t baseColor) const
     {
-        return (static_cast<uint16_t>(baseColor) * static_cast<uint16_t>(m_intensity)) / MAX_BRIGHT;
+        uint8_t value = baseColor;
+
+        if (MAX_BRIGHT != m_intensity)
+        {
+            value = (static_cast<uint16_t>(baseColor) * static_cast<uint16_t>(m_intensity)) / MAX_BRIGHT;
+        }
+
+        return value;
     }
 
 };
@@ -0,0 +1,223 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Compositor
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Compositor.h"
+#include "BlendView.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Compositor::Compositor() :
+    m_layers(),
+    m_count(0U),
+    m_isUncovered(false)
+{
+}
+
+Compositor::~Compositor()
+{
+}
+
+bool Compositor::addLayer(Widget& widget, uint8_t z, uint8_t alpha)
+{
+    bool    isAdded = false;
+    uint8_t index   = find(widget);
+    bool    isDrawn = false;
+
+    /* Already a layer? Remove it to insert it again at its new z-order. */
+    if (MAX_LAYERS > index)
+    {
+        isDrawn = m_layers[index].isDrawn;
+        removeAt(index);
+    }
+
+    if (MAX_LAYERS > m_count)
+    {
+        /* Layers with the same z-order are drawn in the order they were added. */
+        index = m_count;
+        while((0U < index) && (z < m_layers[index - 1U].z))
+        {
+            m_layers[index] = m_layers[index - 1U];
+            --index;
+        }
+
+        m_layers[index].widget  = &widget;
+        m_layers[index].z       = z;
+        m_layers[index].alpha   = alpha;
+        m_layers[index].isDrawn = isDrawn;
+        ++m_count;
+
+        isAdded = true;
+    }
+
+    return isAdded;
+}
+
+void Compositor::removeLayer(Widget& widget)
+{
+    uint8_t index = find(widget);
+
+    if (MAX_LAYERS > index)
+    {
+        if (true == m_layers[index].isDrawn)
+        {
+            m_isUncovered = true;
+        }
+
+        removeAt(index);
+    }
+
+    return;
+}
+
+bool Compositor::setAlpha(Widget& widget, uint8_t alpha)
+{
+    bool    isFound = false;
+    uint8_t index   = find(widget);
+
+    if (MAX_LAYERS > index)
+    {
+        m_layers[index].alpha = alpha;
+        isFound = true;
+    }
+
+    return isFound;
+}
+
+bool Compositor::draw(IGfx& gfx)
+{
+    bool    isRedrawRequired    = m_isUncovered;
+    uint8_t index               = 0U;
+
+    m_isUncovered = false;
+
+    for(index = 0U; index < m_count; ++index)
+    {
+        Layer&      layer       = m_layers[index];
+        const bool  IS_SHOWN    = (0U < layer.alpha) && (true == layer.widget->isVisible());
+
+        if (true == IS_SHOWN)
+        {
+            if (ALPHA_OPAQUE == layer.alpha)
+            {
+                layer.widget->update(gfx);
+            }
+            else
+            {
+                BlendView view(gfx, layer.alpha);
+
+                layer.widget->update(view);
+                isRedrawRequired = true;
+            }
+        }
+        /* The area of a layer, which disappears, is uncovered now. */
+        else if (true == layer.isDrawn)
+        {
+            isRedrawRequired = true;
+        }
+        else
+        {
+            ;
+        }
+
+        layer.isDrawn = IS_SHOWN;
+    }
+
+    return isRedrawRequired;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint8_t Compositor::find(const Widget& widget) const
+{
+    uint8_t index = 0U;
+
+    while((index < m_count) && (&widget != m_layers[index].widget))
+    {
+        ++index;
+    }
+
+    return (index < m_count) ? index : MAX_LAYERS;
+}
+
+void Compositor::removeAt(uint8_t index)
+{
+    if (m_count > index)
+    {
+        --m_count;
+
+        while(index < m_count)
+        {
+            m_layers[index] = m_layers[index + 1U];
+            ++index;
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
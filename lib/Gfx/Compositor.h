@@ -0,0 +1,186 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Compositor
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __COMPOSITOR_H__
+#define __COMPOSITOR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+#include <Widget.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The compositor draws overlay layers on top of the base content, e.g. a
+ * system message on top of the active plugin. Every layer is a widget with
+ * a z-order and a alpha value. Layers with a higher z-order are drawn later
+ * and therefore on top. A hidden widget (see Widget::isVisible()) is skipped.
+ *
+ * The compositor doesn't own the widgets. It doesn't restore the base
+ * content either, but it tells the caller when the base content is covered
+ * no longer or is blended, so the caller can draw it again completely.
+ */
+class Compositor
+{
+public:
+
+    /** Max. number of layers */
+    static const uint8_t    MAX_LAYERS      = 4U;
+
+    /** Alpha value of a opaque layer */
+    static const uint8_t    ALPHA_OPAQUE    = 255U;
+
+    /**
+     * Constructs a compositor without layers.
+     */
+    Compositor();
+
+    /**
+     * Destroys the compositor.
+     */
+    ~Compositor();
+
+    /**
+     * Add a widget as layer. If the widget is already a layer, only its
+     * z-order and alpha value are changed.
+     *
+     * @param[in] widget    Widget, which must live as long as it is a layer.
+     * @param[in] z         z-order, higher layers are drawn on top.
+     * @param[in] alpha     Alpha value [0; 255] - 0: invisible / 255: opaque
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool addLayer(Widget& widget, uint8_t z, uint8_t alpha = ALPHA_OPAQUE);
+
+    /**
+     * Remove the layer of the widget. Nothing happens, if the widget is not
+     * a layer.
+     *
+     * @param[in] widget    Widget
+     */
+    void removeLayer(Widget& widget);
+
+    /**
+     * Set the alpha value of the widget layer.
+     *
+     * @param[in] widget    Widget
+     * @param[in] alpha     Alpha value [0; 255] - 0: invisible / 255: opaque
+     *
+     * @return If the widget is a layer, it will return true otherwise false.
+     */
+    bool setAlpha(Widget& widget, uint8_t alpha);
+
+    /**
+     * Get number of layers.
+     *
+     * @return Number of layers
+     */
+    uint8_t getLayerCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Draw all visible layers in z-order on top of the base content.
+     *
+     * The base content must be drawn again completely before the next
+     * call, if it returns true. This is the case, if a layer was removed
+     * or hidden since the last call, because its area is uncovered now.
+     * It is the case too, if a translucent layer was drawn, because it
+     * blends with the base content.
+     *
+     * @param[in] gfx   Graphics interface, which shows the base content.
+     *
+     * @return If the base content shall be drawn again completely, it will return true otherwise false.
+     */
+    bool draw(IGfx& gfx);
+
+private:
+
+    /**
+     * A single overlay layer.
+     */
+    struct Layer
+    {
+        Widget* widget;     /**< Widget, which is drawn. */
+        uint8_t z;          /**< z-order */
+        uint8_t alpha;      /**< Alpha value [0; 255] */
+        bool    isDrawn;    /**< Was the layer drawn the last time? */
+    };
+
+    Layer   m_layers[MAX_LAYERS];   /**< Layers sorted by z-order, lowest first. */
+    uint8_t m_count;                /**< Number of layers */
+    bool    m_isUncovered;          /**< Is a part of the base content uncovered since the last draw? */
+
+    Compositor(const Compositor& compositor);
+    Compositor& operator=(const Compositor& compositor);
+
+    /**
+     * Find the layer of the widget.
+     *
+     * @param[in] widget    Widget
+     *
+     * @return Layer index or MAX_LAYERS if the widget is not a layer.
+     */
+    uint8_t find(const Widget& widget) const;
+
+    /**
+     * Remove the layer at the given index and close the gap.
+     *
+     * @param[in] index Layer index
+     */
+    void removeAt(uint8_t index);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __COMPOSITOR_H__ */
+
+/** @} */
@@ -0,0 +1,255 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Effect runner for procedural effects
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __EFFECT_RUNNER_HPP__
+#define __EFFECT_RUNNER_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+#include <Geometry.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The effect runner executes a kernel over the whole framebuffer. The kernel
+ * calculates only the colors, the runner takes care about the loops and writes
+ * the colors span by span into the framebuffer.
+ *
+ * The kernel is a template parameter, which means the kernel call is resolved
+ * at compile time and usually inlined into the loop. The same applies to the
+ * framebuffer geometry, if the runner is specialized for a fixed one.
+ *
+ * A pixel kernel provides:
+ * Color operator()(int16_t x, int16_t y, uint32_t time)
+ *
+ * A row kernel provides:
+ * void operator()(int16_t x, int16_t y, uint32_t time, Color* colors, uint16_t length)
+ * It shall calculate the colors of the span, which starts at x, y.
+ */
+namespace EffectRunner
+{
+
+/** Max. number of pixels, which are calculated before they are written at once. */
+static const uint16_t   SPAN_LENGTH = 32U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Run a pixel kernel over the framebuffer with the given geometry.
+ *
+ * @tparam TKernel      Kernel type
+ * @tparam TGeometry    Geometry type, see DynamicGeometry and FixedGeometry
+ *
+ * @param[in] gfx       Graphics interface of the framebuffer
+ * @param[in] kernel    Pixel kernel
+ * @param[in] time      Effect time, passed through to the kernel
+ * @param[in] geometry  Geometry of the framebuffer
+ */
+template < typename TKernel, typename TGeometry >
+void forEachPixel(IGfx& gfx, TKernel& kernel, uint32_t time, const TGeometry& geometry)
+{
+    Color   colors[SPAN_LENGTH];
+    int16_t x       = 0;
+    int16_t y       = 0;
+
+    for(y = 0; y < geometry.getHeight(); ++y)
+    {
+        for(x = 0; x < geometry.getWidth(); x += SPAN_LENGTH)
+        {
+            uint16_t    length  = geometry.getWidth() - x;
+            uint16_t    index   = 0U;
+
+            if (SPAN_LENGTH < length)
+            {
+                length = SPAN_LENGTH;
+            }
+
+            for(index = 0U; index < length; ++index)
+            {
+                colors[index] = kernel(x + index, y, time);
+            }
+
+            gfx.writeSpan(x, y, colors, length);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Run a pixel kernel over the framebuffer.
+ *
+ * @tparam TKernel  Kernel type
+ *
+ * @param[in] gfx       Graphics interface of the framebuffer
+ * @param[in] kernel    Pixel kernel
+ * @param[in] time      Effect time, passed through to the kernel
+ */
+template < typename TKernel >
+void forEachPixel(IGfx& gfx, TKernel& kernel, uint32_t time)
+{
+    forEachPixel(gfx, kernel, time, DynamicGeometry(gfx.getWidth(), gfx.getHeight()));
+
+    return;
+}
+
+/**
+ * Run a pixel kernel over the framebuffer. If the framebuffer has the
+ * given size, the loops are specialized for it.
+ *
+ * @tparam WIDTH    Width of the specialized geometry in pixels
+ * @tparam HEIGHT   Height of the specialized geometry in pixels
+ * @tparam TKernel  Kernel type
+ *
+ * @param[in] gfx       Graphics interface of the framebuffer
+ * @param[in] kernel    Pixel kernel
+ * @param[in] time      Effect time, passed through to the kernel
+ */
+template < uint16_t WIDTH, uint16_t HEIGHT, typename TKernel >
+void forEachPixel(IGfx& gfx, TKernel& kernel, uint32_t time)
+{
+    if (true == FixedGeometry<WIDTH, HEIGHT>::matches(gfx.getWidth(), gfx.getHeight()))
+    {
+        forEachPixel(gfx, kernel, time, FixedGeometry<WIDTH, HEIGHT>());
+    }
+    else
+    {
+        forEachPixel(gfx, kernel, time);
+    }
+
+    return;
+}
+
+/**
+ * Run a row kernel over the framebuffer with the given geometry.
+ *
+ * @tparam TKernel      Kernel type
+ * @tparam TGeometry    Geometry type, see DynamicGeometry and FixedGeometry
+ *
+ * @param[in] gfx       Graphics interface of the framebuffer
+ * @param[in] kernel    Row kernel
+ * @param[in] time      Effect time, passed through to the kernel
+ * @param[in] geometry  Geometry of the framebuffer
+ */
+template < typename TKernel, typename TGeometry >
+void forEachRow(IGfx& gfx, TKernel& kernel, uint32_t time, const TGeometry& geometry)
+{
+    Color   colors[SPAN_LENGTH];
+    int16_t x       = 0;
+    int16_t y       = 0;
+
+    for(y = 0; y < geometry.getHeight(); ++y)
+    {
+        for(x = 0; x < geometry.getWidth(); x += SPAN_LENGTH)
+        {
+            uint16_t length = geometry.getWidth() - x;
+
+            if (SPAN_LENGTH < length)
+            {
+                length = SPAN_LENGTH;
+            }
+
+            kernel(x, y, time, colors, length);
+            gfx.writeSpan(x, y, colors, length);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Run a row kernel over the framebuffer.
+ *
+ * @tparam TKernel  Kernel type
+ *
+ * @param[in] gfx       Graphics interface of the framebuffer
+ * @param[in] kernel    Row kernel
+ * @param[in] time      Effect time, passed through to the kernel
+ */
+template < typename TKernel >
+void forEachRow(IGfx& gfx, TKernel& kernel, uint32_t time)
+{
+    forEachRow(gfx, kernel, time, DynamicGeometry(gfx.getWidth(), gfx.getHeight()));
+
+    return;
+}
+
+/**
+ * Run a row kernel over the framebuffer. If the framebuffer has the
+ * given size, the loops are specialized for it.
+ *
+ * @tparam WIDTH    Width of the specialized geometry in pixels
+ * @tparam HEIGHT   Height of the specialized geometry in pixels
+ * @tparam TKernel  Kernel type
+ *
+ * @param[in] gfx       Graphics interface of the framebuffer
+ * @param[in] kernel    Row kernel
+ * @param[in] time      Effect time, passed through to the kernel
+ */
+template < uint16_t WIDTH, uint16_t HEIGHT, typename TKernel >
+void forEachRow(IGfx& gfx, TKernel& kernel, uint32_t time)
+{
+    if (true == FixedGeometry<WIDTH, HEIGHT>::matches(gfx.getWidth(), gfx.getHeight()))
+    {
+        forEachRow(gfx, kernel, time, FixedGeometry<WIDTH, HEIGHT>());
+    }
+    else
+    {
+        forEachRow(gfx, kernel, time);
+    }
+
+    return;
+}
+
+}
+
+#endif  /* __EFFECT_RUNNER_HPP__ */
+
+/** @} */
\ No newline at end of file
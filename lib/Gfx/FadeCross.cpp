@@ -0,0 +1,119 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cross fade effect
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FadeCross.h"
+#include "FadeKernel.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void FadeCross::init()
+{
+    m_state = FADE_STATE_INIT;
+}
+
+bool FadeCross::fadeIn(IGfx& gfx, IGfx& prev, IGfx& next)
+{
+    (void)prev;
+
+    /* The whole transition already happened during fading out. */
+    gfx.copy(next);
+
+    return true;
+}
+
+bool FadeCross::fadeOut(IGfx& gfx, IGfx& prev, IGfx& next)
+{
+    bool isFinished = false;
+
+    if (FADE_STATE_OUT != m_state)
+    {
+        m_timer.start();
+        m_state = FADE_STATE_OUT;
+    }
+
+    /* The next content is updated continuously by the plugin, therefore
+     * both framebuffers are blended again with every step.
+     */
+    if (true == m_timer.isFinished())
+    {
+        gfx.copy(next);
+        m_state     = FADE_STATE_INIT;
+        isFinished  = true;
+    }
+    else
+    {
+        FadeKernel::blend(gfx, prev, next, m_timer.getProgress());
+    }
+
+    return isFinished;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
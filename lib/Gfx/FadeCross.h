@@ -0,0 +1,139 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cross fade effect
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __FADE_CROSS_H__
+#define __FADE_CROSS_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IFadeEffect.hpp>
+#include <FadeTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A cross fade effect, which alpha blends the old content into the new
+ * content. In contrast to the linear fade effect, the display never gets
+ * dark in between.
+ */
+class FadeCross : public IFadeEffect
+{
+public:
+
+    /**
+     * Constructs the fade effect.
+     *
+     * @param[in] duration    Duration of the fade effect in ms
+     * @param[in] easing      Easing curve
+     */
+    FadeCross(uint32_t duration = DEFAULT_DURATION, FadeTimer::Easing easing = FadeTimer::EASING_LINEAR) :
+        m_state(FADE_STATE_INIT),
+        m_timer(duration, easing)
+    {
+    }
+
+    /**
+     * Destroys the fade effect instance.
+     */
+    ~FadeCross()
+    {
+    }
+
+    /**
+     * Initializes/reset fade effect. May be necessary in case a fade effect was aborted.
+     */
+    void init() final;
+
+    /**
+     * Achieves a fade in effect. Call this method as long as the effect is not completed.
+     *
+     * @param[in] gfx   Graphics interface to display
+     * @param[in] prev  Graphics interface to previous framebuffer
+     * @param[in] next  Graphics interface to next framebuffer
+     *
+     * @return If the effect is complete, it will return true otherwise false.
+     */
+    bool fadeIn(IGfx& gfx, IGfx& prev, IGfx& next) final;
+
+    /**
+     * Achieves a fade out effect. Call this method as long as the effect is not completed.
+     *
+     * @param[in] gfx   Graphics interface to display
+     * @param[in] prev  Graphics interface to previous framebuffer
+     * @param[in] next  Graphics interface to next framebuffer
+     *
+     * @return If the effect is complete, it will return true otherwise false.
+     */
+    bool fadeOut(IGfx& gfx, IGfx& prev, IGfx& next) final;
+
+    /**
+     * Default duration of the cross fade in ms.
+     */
+    static const uint32_t DEFAULT_DURATION  = 1000U;
+
+private:
+
+    /** Fading states. */
+    enum FadeState
+    {
+        FADE_STATE_INIT = 0,    /**< Initialize fadeing */
+        FADE_STATE_OUT          /**< Fading out is pending */
+    };
+
+    FadeState   m_state;        /**< Current fading state */
+    FadeTimer   m_timer;        /**< Derives the progress from the elapsed time */
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FADE_CROSS_H__ */
+
+/** @} */
\ No newline at end of file
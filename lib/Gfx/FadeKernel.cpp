@@ -0,0 +1,151 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fade effect kernels
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FadeKernel.h"
+#include "PixelKernel.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isFixedGeometry(const IGfx& dst);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Kernels specialized for a fixed geometry, may be nullptr. */
+static const FadeKernel::FixedKernels*  gFixedKernels   = nullptr;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern void FadeKernel::dim(IGfx& dst, const IGfx& src, uint8_t intensity)
+{
+    if (true == isFixedGeometry(dst))
+    {
+        gFixedKernels->dim(dst, src, intensity);
+    }
+    else
+    {
+        dim(dst, src, intensity, DynamicGeometry(dst.getWidth(), dst.getHeight()));
+    }
+
+    return;
+}
+
+extern void FadeKernel::blend(IGfx& dst, const IGfx& src1, const IGfx& src2, uint8_t ratio)
+{
+    if (true == isFixedGeometry(dst))
+    {
+        gFixedKernels->blend(dst, src1, src2, ratio);
+    }
+    else
+    {
+        blend(dst, src1, src2, ratio, DynamicGeometry(dst.getWidth(), dst.getHeight()));
+    }
+
+    return;
+}
+
+extern void FadeKernel::wipeX(IGfx& dst, const IGfx& src1, const IGfx& src2, int16_t edge)
+{
+    if (true == isFixedGeometry(dst))
+    {
+        gFixedKernels->wipeX(dst, src1, src2, edge);
+    }
+    else
+    {
+        wipeX(dst, src1, src2, edge, DynamicGeometry(dst.getWidth(), dst.getHeight()));
+    }
+
+    return;
+}
+
+extern void FadeKernel::setFixedKernels(const FixedKernels* kernels)
+{
+    gFixedKernels = kernels;
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Is the destination geometry the same as the fixed one?
+ *
+ * @param[in] dst   Graphics interface of destination framebuffer
+ *
+ * @return If fixed geometry kernels shall be used, it will return true otherwise false.
+ */
+static bool isFixedGeometry(const IGfx& dst)
+{
+    bool isFixed = false;
+
+    if ((nullptr != gFixedKernels) &&
+        (gFixedKernels->width == dst.getWidth()) &&
+        (gFixedKernels->height == dst.getHeight()))
+    {
+        isFixed = true;
+    }
+
+    return isFixed;
+}
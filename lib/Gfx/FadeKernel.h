@@ -0,0 +1,377 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fade effect kernels
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __FADE_KERNEL_H__
+#define __FADE_KERNEL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+#include <Geometry.hpp>
+#include <PixelKernel.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Kernels, which compose a whole fade effect frame in a single pass.
+ * They work span-wise on the framebuffers, so every source pixel is read
+ * exactly once and every destination pixel is written exactly once per frame.
+ * The source framebuffers are never modified.
+ */
+namespace FadeKernel
+{
+
+/** Max. number of pixels, which are processed at once. */
+static const uint16_t   SPAN_LENGTH = 32U;
+
+/**
+ * Kernels, which are specialized for a fixed geometry.
+ * See useFixedGeometry().
+ */
+struct FixedKernels
+{
+    uint16_t    width;  /**< Width in pixels */
+    uint16_t    height; /**< Height in pixels */
+
+    /** Kernel to dim */
+    void (*dim)(IGfx& dst, const IGfx& src, uint8_t intensity);
+
+    /** Kernel to blend */
+    void (*blend)(IGfx& dst, const IGfx& src1, const IGfx& src2, uint8_t ratio);
+
+    /** Kernel to wipe along the x-axis */
+    void (*wipeX)(IGfx& dst, const IGfx& src1, const IGfx& src2, int16_t edge);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Copy the source framebuffer with the given intensity to the destination.
+ * If the destination has the fixed geometry, the specialized kernel is used.
+ *
+ * @param[in] dst       Graphics interface of destination framebuffer
+ * @param[in] src       Graphics interface of source framebuffer
+ * @param[in] intensity Color intensity [0; 255] - 0: min. bright / 255: max. bright
+ */
+extern void dim(IGfx& dst, const IGfx& src, uint8_t intensity);
+
+/**
+ * Alpha blend two source framebuffers into the destination.
+ * If the destination has the fixed geometry, the specialized kernel is used.
+ *
+ * @param[in] dst   Graphics interface of destination framebuffer
+ * @param[in] src1  Graphics interface of first source framebuffer
+ * @param[in] src2  Graphics interface of second source framebuffer
+ * @param[in] ratio Blend ratio [0; 255] - 0: only first source / 255: only second source
+ */
+extern void blend(IGfx& dst, const IGfx& src1, const IGfx& src2, uint8_t ratio);
+
+/**
+ * Wipe from the first source framebuffer to the second one, along the x-axis.
+ * Left of the edge the second source is shown, at and right of the edge the
+ * first source.
+ * If the destination has the fixed geometry, the specialized kernel is used.
+ *
+ * @param[in] dst   Graphics interface of destination framebuffer
+ * @param[in] src1  Graphics interface of first source framebuffer
+ * @param[in] src2  Graphics interface of second source framebuffer
+ * @param[in] edge  x-coordinate of the wipe edge [0; width]
+ */
+extern void wipeX(IGfx& dst, const IGfx& src1, const IGfx& src2, int16_t edge);
+
+/**
+ * Set the kernels, which are specialized for a fixed geometry.
+ *
+ * @param[in] kernels   Specialized kernels or nullptr to use only the generic ones.
+ */
+extern void setFixedKernels(const FixedKernels* kernels);
+
+/**
+ * Convert colors to pixels in RGB888 format. The color intensity is applied.
+ *
+ * @param[out] pixels   Pixels in RGB888 format
+ * @param[in]  colors   Colors
+ * @param[in]  length   Number of pixels
+ */
+inline void toPixels(uint32_t* pixels, const Color* colors, uint16_t length)
+{
+    uint16_t index = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        pixels[index] = colors[index];
+    }
+
+    return;
+}
+
+/**
+ * Convert pixels in RGB888 format to colors with max. intensity.
+ *
+ * @param[out] colors   Colors
+ * @param[in]  pixels   Pixels in RGB888 format
+ * @param[in]  length   Number of pixels
+ */
+inline void toColors(Color* colors, const uint32_t* pixels, uint16_t length)
+{
+    uint16_t index = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        colors[index] = Color(pixels[index]);
+    }
+
+    return;
+}
+
+/**
+ * Copy the source framebuffer with the given intensity to the destination.
+ *
+ * @tparam TGeometry    Geometry type, see DynamicGeometry and FixedGeometry
+ *
+ * @param[in] dst       Graphics interface of destination framebuffer
+ * @param[in] src       Graphics interface of source framebuffer
+ * @param[in] intensity Color intensity [0; 255] - 0: min. bright / 255: max. bright
+ * @param[in] geometry  Geometry of the destination framebuffer
+ */
+template < typename TGeometry >
+void dim(IGfx& dst, const IGfx& src, uint8_t intensity, const TGeometry& geometry)
+{
+    Color       row[SPAN_LENGTH];
+    uint32_t    pixels[SPAN_LENGTH];
+    int16_t     y   = 0;
+
+    for(y = 0; y < geometry.getHeight(); ++y)
+    {
+        int16_t x = 0;
+
+        for(x = 0; x < geometry.getWidth(); x += SPAN_LENGTH)
+        {
+            uint16_t length = geometry.getWidth() - x;
+
+            if (SPAN_LENGTH < length)
+            {
+                length = SPAN_LENGTH;
+            }
+
+            src.readSpan(x, y, row, length);
+            toPixels(pixels, row, length);
+            PixelKernel::scale(pixels, pixels, length, intensity);
+            toColors(row, pixels, length);
+            dst.writeSpan(x, y, row, length);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Alpha blend two source framebuffers into the destination.
+ *
+ * @tparam TGeometry    Geometry type, see DynamicGeometry and FixedGeometry
+ *
+ * @param[in] dst       Graphics interface of destination framebuffer
+ * @param[in] src1      Graphics interface of first source framebuffer
+ * @param[in] src2      Graphics interface of second source framebuffer
+ * @param[in] ratio     Blend ratio [0; 255] - 0: only first source / 255: only second source
+ * @param[in] geometry  Geometry of the destination framebuffer
+ */
+template < typename TGeometry >
+void blend(IGfx& dst, const IGfx& src1, const IGfx& src2, uint8_t ratio, const TGeometry& geometry)
+{
+    Color       row[SPAN_LENGTH];
+    uint32_t    pixels1[SPAN_LENGTH];
+    uint32_t    pixels2[SPAN_LENGTH];
+    int16_t     y       = 0;
+
+    for(y = 0; y < geometry.getHeight(); ++y)
+    {
+        int16_t x = 0;
+
+        for(x = 0; x < geometry.getWidth(); x += SPAN_LENGTH)
+        {
+            uint16_t length = geometry.getWidth() - x;
+
+            if (SPAN_LENGTH < length)
+            {
+                length = SPAN_LENGTH;
+            }
+
+            src1.readSpan(x, y, row, length);
+            toPixels(pixels1, row, length);
+            src2.readSpan(x, y, row, length);
+            toPixels(pixels2, row, length);
+            PixelKernel::blend(pixels1, pixels1, pixels2, length, ratio);
+            toColors(row, pixels1, length);
+            dst.writeSpan(x, y, row, length);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Wipe from the first source framebuffer to the second one, along the x-axis.
+ * Left of the edge the second source is shown, at and right of the edge the
+ * first source.
+ *
+ * @tparam TGeometry    Geometry type, see DynamicGeometry and FixedGeometry
+ *
+ * @param[in] dst       Graphics interface of destination framebuffer
+ * @param[in] src1      Graphics interface of first source framebuffer
+ * @param[in] src2      Graphics interface of second source framebuffer
+ * @param[in] edge      x-coordinate of the wipe edge [0; width]
+ * @param[in] geometry  Geometry of the destination framebuffer
+ */
+template < typename TGeometry >
+void wipeX(IGfx& dst, const IGfx& src1, const IGfx& src2, int16_t edge, const TGeometry& geometry)
+{
+    int16_t y = 0;
+
+    if (0 > edge)
+    {
+        edge = 0;
+    }
+    else if (geometry.getWidth() < edge)
+    {
+        edge = geometry.getWidth();
+    }
+    else
+    {
+        ;
+    }
+
+    for(y = 0; y < geometry.getHeight(); ++y)
+    {
+        dst.copySpan(0, y, src2, 0, y, edge);
+        dst.copySpan(edge, y, src1, edge, y, geometry.getWidth() - edge);
+    }
+
+    return;
+}
+
+/**
+ * Kernels with a fixed geometry, which can be referenced by FixedKernels.
+ *
+ * @tparam WIDTH    Width in pixels
+ * @tparam HEIGHT   Height in pixels
+ */
+template < uint16_t WIDTH, uint16_t HEIGHT >
+struct Fixed
+{
+    /**
+     * Copy the source framebuffer with the given intensity to the destination.
+     *
+     * @param[in] dst       Graphics interface of destination framebuffer
+     * @param[in] src       Graphics interface of source framebuffer
+     * @param[in] intensity Color intensity [0; 255] - 0: min. bright / 255: max. bright
+     */
+    static void dim(IGfx& dst, const IGfx& src, uint8_t intensity)
+    {
+        FadeKernel::dim(dst, src, intensity, FixedGeometry<WIDTH, HEIGHT>());
+    }
+
+    /**
+     * Alpha blend two source framebuffers into the destination.
+     *
+     * @param[in] dst   Graphics interface of destination framebuffer
+     * @param[in] src1  Graphics interface of first source framebuffer
+     * @param[in] src2  Graphics interface of second source framebuffer
+     * @param[in] ratio Blend ratio [0; 255] - 0: only first source / 255: only second source
+     */
+    static void blend(IGfx& dst, const IGfx& src1, const IGfx& src2, uint8_t ratio)
+    {
+        FadeKernel::blend(dst, src1, src2, ratio, FixedGeometry<WIDTH, HEIGHT>());
+    }
+
+    /**
+     * Wipe from the first source framebuffer to the second one, along the x-axis.
+     *
+     * @param[in] dst   Graphics interface of destination framebuffer
+     * @param[in] src1  Graphics interface of first source framebuffer
+     * @param[in] src2  Graphics interface of second source framebuffer
+     * @param[in] edge  x-coordinate of the wipe edge [0; width]
+     */
+    static void wipeX(IGfx& dst, const IGfx& src1, const IGfx& src2, int16_t edge)
+    {
+        FadeKernel::wipeX(dst, src1, src2, edge, FixedGeometry<WIDTH, HEIGHT>());
+    }
+};
+
+/**
+ * Specialize the fade kernels for a fixed geometry, e.g. the LED matrix
+ * size. Framebuffers with another size are still supported by the generic
+ * kernels.
+ *
+ * @tparam WIDTH    Width in pixels
+ * @tparam HEIGHT   Height in pixels
+ */
+template < uint16_t WIDTH, uint16_t HEIGHT >
+void useFixedGeometry()
+{
+    static const FixedKernels KERNELS =
+    {
+        WIDTH,
+        HEIGHT,
+        &Fixed<WIDTH, HEIGHT>::dim,
+        &Fixed<WIDTH, HEIGHT>::blend,
+        &Fixed<WIDTH, HEIGHT>::wipeX
+    };
+
+    setFixedKernels(&KERNELS);
+
+    return;
+}
+
+}
+
+#endif  /* __FADE_KERNEL_H__ */
+
+/** @} */
\ No newline at end of file
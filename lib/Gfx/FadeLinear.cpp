@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "FadeLinear.h"
+#include "FadeKernel.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -69,27 +70,24 @@ bool FadeLinear::fadeIn(IGfx& gfx, IGfx& prev, IGfx& next)
 
     (void)prev;
 
-    /* Copy next framebuffer initial to display once and fade it smooth in. */
+    /* Fade the next framebuffer smooth in, the intensity follows the elapsed time. */
     if (FADE_STATE_IN != m_state)
     {
-        m_intensity = Color::MIN_BRIGHT;
-        m_state     = FADE_STATE_IN;
+        m_timer.start();
+        m_state = FADE_STATE_IN;
     }
 
-    if ((Color::MAX_BRIGHT - FADING_STEP) <= m_intensity)
+    if (true == m_timer.isFinished())
     {
-        next.dimScreen(Color::MAX_BRIGHT);
+        gfx.copy(next);
         m_state     = FADE_STATE_INIT;
         isFinished  = true;
     }
     else
     {
-        next.dimScreen(m_intensity);
-        m_intensity += FADING_STEP;
+        FadeKernel::dim(gfx, next, m_timer.getProgress());
     }
 
-    gfx.copy(next);
-
     return isFinished;
 }
 
@@ -99,27 +97,24 @@ bool FadeLinear::fadeOut(IGfx& gfx, IGfx& prev, IGfx& next)
 
     (void)next;
 
-    /* Copy previous framebuffer initial to display once and fade it smooth out. */
+    /* Fade the previous framebuffer smooth out, the intensity follows the elapsed time. */
     if (FADE_STATE_OUT != m_state)
     {
-        m_intensity = Color::MAX_BRIGHT;
-        m_state     = FADE_STATE_OUT;
+        m_timer.start();
+        m_state = FADE_STATE_OUT;
     }
 
-    if ((Color::MIN_BRIGHT + FADING_STEP) >= m_intensity)
+    if (true == m_timer.isFinished())
     {
-        prev.dimScreen(Color::MIN_BRIGHT);
+        FadeKernel::dim(gfx, prev, Color::MIN_BRIGHT);
         m_state     = FADE_STATE_INIT;
         isFinished  = true;
     }
     else
     {
-        prev.dimScreen(m_intensity);
-        m_intensity -= FADING_STEP;
+        FadeKernel::dim(gfx, prev, Color::MAX_BRIGHT - m_timer.getProgress());
     }
 
-    gfx.copy(prev);
-
     return isFinished;
 }
 
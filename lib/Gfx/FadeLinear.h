@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include <IFadeEffect.hpp>
+#include <FadeTimer.hpp>
 
 /******************************************************************************
  * Macros
@@ -63,10 +64,13 @@ public:
 
     /**
      * Constructs the linear fade effect.
+     *
+     * @param[in] duration    Duration of the fade effect in ms
+     * @param[in] easing      Easing curve
      */
-    FadeLinear() :
+    FadeLinear(uint32_t duration = DEFAULT_DURATION, FadeTimer::Easing easing = FadeTimer::EASING_LINEAR) :
         m_state(FADE_STATE_INIT),
-        m_intensity(Color::MIN_BRIGHT)
+        m_timer(duration, easing)
     {
     }
 
@@ -105,11 +109,9 @@ public:
     bool fadeOut(IGfx& gfx, IGfx& prev, IGfx& next) final;
 
     /**
-     * Fading step per fadeIn/fadeOut call.
-     * If the fade effect shall take place 1s and the call period is 20ms, it will need a
-     * fading step of 5 digits.
+     * Default duration of a fade in or fade out in ms.
      */
-    static const uint8_t FADING_STEP    = 5U;
+    static const uint32_t DEFAULT_DURATION  = 1000U;
 
 private:
 
@@ -122,7 +124,8 @@ private:
     };
 
     FadeState   m_state;        /**< Current fading state */
-    uint8_t     m_intensity;    /**< Current color intensity [0; 255] - 0: min. bright / 255: max. bright */
+    FadeTimer   m_timer;        /**< Derives the progress from the elapsed time */
+
 };
 
 /******************************************************************************
@@ -74,38 +74,35 @@ bool FadeMoveX::fadeIn(IGfx& gfx, IGfx& prev, IGfx& next)
 
 bool FadeMoveX::fadeOut(IGfx& gfx, IGfx& prev, IGfx& next)
 {
-    bool    isFinished  = false;
-    int16_t x           = 0;
-    int16_t y           = 0;
+    bool        isFinished  = false;
+    int16_t     y           = 0;
+    int16_t     xOffset     = 0;
+    uint16_t    prevWidth   = 0U;
 
     if (FADE_STATE_OUT != m_state)
     {
-        m_state     = FADE_STATE_OUT;
-        m_xOffset   = 0;
+        m_timer.start();
+        m_state = FADE_STATE_OUT;
     }
 
-    for(x = 0; x < (gfx.getWidth() - m_xOffset); ++x)
+    if (true == m_timer.isFinished())
     {
-        for(y = 0; y < gfx.getHeight(); ++y)
-        {
-            gfx.drawPixel(x, y, prev.getColor(x + m_xOffset, y));
-        }
+        xOffset     = gfx.getWidth();
+        m_state     = FADE_STATE_INIT;
+        isFinished  = true;
     }
-
-    for(x = gfx.getWidth() - m_xOffset; x < gfx.getWidth(); ++x)
+    else
     {
-        for(y = 0; y < gfx.getHeight(); ++y)
-        {
-            gfx.drawPixel(x, y, next.getColor((x + m_xOffset) - gfx.getWidth(), y));
-        }
+        xOffset = (gfx.getWidth() * m_timer.getProgress()) / FadeTimer::PROGRESS_MAX;
     }
 
-    ++m_xOffset;
+    /* The previous content moves out to the left, the next content follows from the right. */
+    prevWidth = gfx.getWidth() - xOffset;
 
-    if (gfx.getWidth() <= m_xOffset)
+    for(y = 0; y < gfx.getHeight(); ++y)
     {
-        m_state     = FADE_STATE_INIT;
-        isFinished  = true;
+        gfx.copySpan(0, y, prev, xOffset, y, prevWidth);
+        gfx.copySpan(prevWidth, y, next, 0, y, xOffset);
     }
 
     return isFinished;
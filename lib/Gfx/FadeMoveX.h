@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include <IFadeEffect.hpp>
+#include <FadeTimer.hpp>
 
 /******************************************************************************
  * Macros
@@ -65,10 +66,13 @@ public:
 
     /**
      * Constructs the fade effect.
+     *
+     * @param[in] duration    Duration of the fade effect in ms
+     * @param[in] easing      Easing curve
      */
-    FadeMoveX() :
+    FadeMoveX(uint32_t duration = DEFAULT_DURATION, FadeTimer::Easing easing = FadeTimer::EASING_IN_OUT) :
         m_state(FADE_STATE_INIT),
-        m_xOffset(0)
+        m_timer(duration, easing)
     {
     }
 
@@ -106,6 +110,11 @@ public:
      */
     bool fadeOut(IGfx& gfx, IGfx& prev, IGfx& next) final;
 
+    /**
+     * Default duration of the movement in ms.
+     */
+    static const uint32_t DEFAULT_DURATION  = 640U;
+
 private:
 
     /** Fading states. */
@@ -116,7 +125,7 @@ private:
     };
 
     FadeState   m_state;        /**< Current fading state */
-    int16_t     m_xOffset;      /**< Current x-offset regarding movement */
+    FadeTimer   m_timer;        /**< Derives the progress from the elapsed time */
 
 };
 
@@ -75,37 +75,35 @@ bool FadeMoveY::fadeIn(IGfx& gfx, IGfx& prev, IGfx& next)
 bool FadeMoveY::fadeOut(IGfx& gfx, IGfx& prev, IGfx& next)
 {
     bool    isFinished  = false;
-    int16_t x           = 0;
     int16_t y           = 0;
+    int16_t yOffset     = 0;
 
     if (FADE_STATE_OUT != m_state)
     {
-        m_state     = FADE_STATE_OUT;
-        m_yOffset   = 0;
+        m_timer.start();
+        m_state = FADE_STATE_OUT;
     }
 
-    for(y = 0; y < (gfx.getHeight() - m_yOffset); ++y)
+    if (true == m_timer.isFinished())
     {
-        for(x = 0; x < gfx.getWidth(); ++x)
-        {
-            gfx.drawPixel(x, y, prev.getColor(x , (y + m_yOffset)));
-        }
+        yOffset     = gfx.getHeight();
+        m_state     = FADE_STATE_INIT;
+        isFinished  = true;
     }
-
-    for(y = gfx.getHeight() - m_yOffset; y < gfx.getHeight(); ++y)
+    else
     {
-        for(x = 0; x < gfx.getWidth(); ++x)
-        {
-            gfx.drawPixel(x, y, next.getColor(x, ((y + m_yOffset) - gfx.getHeight())));
-        }
+        yOffset = (gfx.getHeight() * m_timer.getProgress()) / FadeTimer::PROGRESS_MAX;
     }
 
-    ++m_yOffset;
+    /* The previous content moves out to the top, the next content follows from the bottom. */
+    for(y = 0; y < (gfx.getHeight() - yOffset); ++y)
+    {
+        gfx.copySpan(0, y, prev, 0, y + yOffset, gfx.getWidth());
+    }
 
-    if (gfx.getHeight() <= m_yOffset)
+    for(y = gfx.getHeight() - yOffset; y < gfx.getHeight(); ++y)
     {
-        m_state     = FADE_STATE_INIT;
-        isFinished  = true;
+        gfx.copySpan(0, y, next, 0, (y + yOffset) - gfx.getHeight(), gfx.getWidth());
     }
 
     return isFinished;
@@ -0,0 +1,240 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fade timer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __FADE_TIMER_HPP__
+#define __FADE_TIMER_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The fade timer derives the progress of a fade effect from the elapsed
+ * time since its start. A fade effect therefore takes always the same
+ * duration, independent of how often it is called. If frames are dropped,
+ * the effect just skips the intermediate steps.
+ */
+class FadeTimer
+{
+public:
+
+    /** Easing curves, which shape the progress over time. */
+    enum Easing
+    {
+        EASING_LINEAR = 0,  /**< Constant speed */
+        EASING_IN,          /**< Starts slow and accelerates (quadratic) */
+        EASING_OUT,         /**< Starts fast and decelerates (quadratic) */
+        EASING_IN_OUT       /**< Starts and ends slow (smoothstep) */
+    };
+
+    /** Progress at the beginning of the fade effect. */
+    static const uint8_t PROGRESS_MIN   = 0U;
+
+    /** Progress at the end of the fade effect. */
+    static const uint8_t PROGRESS_MAX   = UINT8_MAX;
+
+    /**
+     * Constructs the fade timer.
+     *
+     * @param[in] duration  Duration of the fade effect in ms
+     * @param[in] easing    Easing curve
+     */
+    FadeTimer(uint32_t duration, Easing easing) :
+        m_duration(duration),
+        m_easing(easing),
+        m_startTimestamp(0U)
+    {
+    }
+
+    /**
+     * Destroys the fade timer.
+     */
+    ~FadeTimer()
+    {
+    }
+
+    /**
+     * Start the fade timer with the current time.
+     */
+    void start()
+    {
+        m_startTimestamp = millis();
+        return;
+    }
+
+    /**
+     * Get the duration of the fade effect.
+     *
+     * @return Duration in ms
+     */
+    uint32_t getDuration() const
+    {
+        return m_duration;
+    }
+
+    /**
+     * Set the duration of the fade effect. It takes effect with the next
+     * call of getProgress().
+     *
+     * @param[in] duration  Duration in ms
+     */
+    void setDuration(uint32_t duration)
+    {
+        m_duration = duration;
+        return;
+    }
+
+    /**
+     * Get the easing curve.
+     *
+     * @return Easing curve
+     */
+    Easing getEasing() const
+    {
+        return m_easing;
+    }
+
+    /**
+     * Set the easing curve.
+     *
+     * @param[in] easing    Easing curve
+     */
+    void setEasing(Easing easing)
+    {
+        m_easing = easing;
+        return;
+    }
+
+    /**
+     * Get the eased progress of the fade effect, derived from the elapsed
+     * time since start.
+     *
+     * @return Progress [0; 255] - 0: just started / 255: complete
+     */
+    uint8_t getProgress() const
+    {
+        uint32_t    elapsed     = millis() - m_startTimestamp;
+        uint8_t     progress    = PROGRESS_MAX;
+
+        if (m_duration > elapsed)
+        {
+            /* 64-bit intermediate, because long durations would overflow. */
+            uint64_t scaled = (static_cast<uint64_t>(elapsed) * PROGRESS_MAX) / m_duration;
+
+            progress = ease(m_easing, static_cast<uint8_t>(scaled));
+        }
+
+        return progress;
+    }
+
+    /**
+     * Is the fade effect complete?
+     *
+     * @return If the duration elapsed, it will return true otherwise false.
+     */
+    bool isFinished() const
+    {
+        return (m_duration <= (millis() - m_startTimestamp));
+    }
+
+    /**
+     * Apply a easing curve on a linear progress.
+     *
+     * @param[in] easing    Easing curve
+     * @param[in] progress  Linear progress [0; 255]
+     *
+     * @return Eased progress [0; 255]
+     */
+    static uint8_t ease(Easing easing, uint8_t progress)
+    {
+        const uint32_t  MAX     = PROGRESS_MAX;
+        uint32_t        p       = progress;
+        uint32_t        eased   = p;
+
+        switch(easing)
+        {
+        case EASING_LINEAR:
+            break;
+
+        case EASING_IN:
+            eased = (p * p) / MAX;
+            break;
+
+        case EASING_OUT:
+            eased = MAX - (((MAX - p) * (MAX - p)) / MAX);
+            break;
+
+        case EASING_IN_OUT:
+            /* Smoothstep: 3p^2 - 2p^3, scaled to [0; 255] */
+            eased = (p * p * ((3U * MAX) - (2U * p))) / (MAX * MAX);
+            break;
+
+        default:
+            break;
+        }
+
+        return static_cast<uint8_t>(eased);
+    }
+
+private:
+
+    uint32_t    m_duration;         /**< Duration in ms */
+    Easing      m_easing;           /**< Easing curve */
+    uint32_t    m_startTimestamp;   /**< Timestamp in ms, when the fade effect started. */
+
+    FadeTimer();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FADE_TIMER_HPP__ */
+
+/** @} */
@@ -0,0 +1,502 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Font with 5x7 pixel glyphs and 8 pixel line height
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The glyphs are stored in the Adafruit GFX font format, which crops every
+ * glyph to its bounding box and packs the pixels bitwise.
+ * The character codes are Windows-1252: ASCII, Latin-1 and the Windows-1252
+ * additions like the euro sign, typographic quotes and dashes. Not available
+ * characters are empty.
+ * Capital letters with diacritics have a reduced height, to fit into the
+ * line height.
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __FONT5X8_H__
+#define __FONT5X8_H__
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <gfxfont.h>
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** Glyph bitmaps */
+const uint8_t Font5x8Bitmaps[] PROGMEM = {
+    0xFA,                          /* 0x21 exclam */
+    0xB4,                          /* 0x22 quotedbl */
+    0x52, 0xBE, 0xAF, 0xA9, 0x40,  /* 0x23 numbersign */
+    0x23, 0xE8, 0xE2, 0xF8, 0x80,  /* 0x24 dollar */
+    0xC6, 0x44, 0x44, 0x4C, 0x60,  /* 0x25 percent */
+    0x64, 0xA8, 0x8A, 0xC9, 0xA0,  /* 0x26 ampersand */
+    0xC0,                          /* 0x27 quotesingle */
+    0x2A, 0x48, 0x88,              /* 0x28 parenleft */
+    0x88, 0x92, 0xA0,              /* 0x29 parenright */
+    0x25, 0x5D, 0x52, 0x00,        /* 0x2A asterisk */
+    0x21, 0x3E, 0x42, 0x00,        /* 0x2B plus */
+    0x58,                          /* 0x2C comma */
+    0xF0,                          /* 0x2D hyphen */
+    0x80,                          /* 0x2E period */
+    0x08, 0x88, 0x88, 0x00,        /* 0x2F slash */
+    0x74, 0x67, 0x5C, 0xC5, 0xC0,  /* 0x30 zero */
+    0x59, 0x24, 0xB8,              /* 0x31 one */
+    0x74, 0x42, 0x22, 0x23, 0xE0,  /* 0x32 two */
+    0xF8, 0x88, 0x20, 0xC5, 0xC0,  /* 0x33 three */
+    0x11, 0x95, 0x2F, 0x88, 0x40,  /* 0x34 four */
+    0xFC, 0x3C, 0x10, 0xC5, 0xC0,  /* 0x35 five */
+    0x32, 0x21, 0xE8, 0xC5, 0xC0,  /* 0x36 six */
+    0xF8, 0x44, 0x44, 0x21, 0x00,  /* 0x37 seven */
+    0x74, 0x62, 0xE8, 0xC5, 0xC0,  /* 0x38 eight */
+    0x74, 0x62, 0xF0, 0x89, 0x80,  /* 0x39 nine */
+    0x90,                          /* 0x3A colon */
+    0x41, 0x60,                    /* 0x3B semicolon */
+    0x12, 0x48, 0x42, 0x10,        /* 0x3C less */
+    0xF0, 0xF0,                    /* 0x3D equal */
+    0x84, 0x21, 0x24, 0x80,        /* 0x3E greater */
+    0x74, 0x42, 0x22, 0x00, 0x80,  /* 0x3F question */
+    0x74, 0x6F, 0x5B, 0xC1, 0xC0,  /* 0x40 at */
+    0x74, 0x63, 0xF8, 0xC6, 0x20,  /* 0x41 A */
+    0xF4, 0x63, 0xE8, 0xC7, 0xC0,  /* 0x42 B */
+    0x74, 0x61, 0x08, 0x45, 0xC0,  /* 0x43 C */
+    0xE4, 0xA3, 0x18, 0xCB, 0x80,  /* 0x44 D */
+    0xFC, 0x21, 0xE8, 0x43, 0xE0,  /* 0x45 E */
+    0xFC, 0x21, 0xE8, 0x42, 0x00,  /* 0x46 F */
+    0x74, 0x61, 0x78, 0xC5, 0xE0,  /* 0x47 G */
+    0x8C, 0x63, 0xF8, 0xC6, 0x20,  /* 0x48 H */
+    0xE9, 0x24, 0xB8,              /* 0x49 I */
+    0x38, 0x84, 0x21, 0x49, 0x80,  /* 0x4A J */
+    0x8C, 0xA9, 0x8A, 0x4A, 0x20,  /* 0x4B K */
+    0x84, 0x21, 0x08, 0x43, 0xE0,  /* 0x4C L */
+    0x8E, 0xEB, 0x58, 0xC6, 0x20,  /* 0x4D M */
+    0x8C, 0x73, 0x59, 0xC6, 0x20,  /* 0x4E N */
+    0x74, 0x63, 0x18, 0xC5, 0xC0,  /* 0x4F O */
+    0xF4, 0x63, 0xE8, 0x42, 0x00,  /* 0x50 P */
+    0x74, 0x63, 0x1A, 0xC9, 0xA0,  /* 0x51 Q */
+    0xF4, 0x63, 0xEA, 0x4A, 0x20,  /* 0x52 R */
+    0x7C, 0x20, 0xE0, 0x87, 0xC0,  /* 0x53 S */
+    0xF9, 0x08, 0x42, 0x10, 0x80,  /* 0x54 T */
+    0x8C, 0x63, 0x18, 0xC5, 0xC0,  /* 0x55 U */
+    0x8C, 0x63, 0x18, 0xA8, 0x80,  /* 0x56 V */
+    0x8C, 0x63, 0x5A, 0xD5, 0x40,  /* 0x57 W */
+    0x8C, 0x54, 0x45, 0x46, 0x20,  /* 0x58 X */
+    0x8C, 0x62, 0xA2, 0x10, 0x80,  /* 0x59 Y */
+    0xF8, 0x44, 0x44, 0x43, 0xE0,  /* 0x5A Z */
+    0xF2, 0x49, 0x38,              /* 0x5B bracketleft */
+    0x82, 0x08, 0x20, 0x80,        /* 0x5C backslash */
+    0xE4, 0x92, 0x78,              /* 0x5D bracketright */
+    0x22, 0xA2,                    /* 0x5E asciicircum */
+    0xF8,                          /* 0x5F underscore */
+    0x90,                          /* 0x60 grave */
+    0x70, 0x5F, 0x17, 0x80,        /* 0x61 a */
+    0x84, 0x3D, 0x18, 0xC7, 0xC0,  /* 0x62 b */
+    0x78, 0x88, 0x70,              /* 0x63 c */
+    0x08, 0x5F, 0x18, 0xC5, 0xE0,  /* 0x64 d */
+    0x74, 0x7F, 0x07, 0x00,        /* 0x65 e */
+    0x34, 0xF4, 0x44, 0x40,        /* 0x66 f */
+    0x7C, 0x62, 0xF0, 0xB8,        /* 0x67 g */
+    0x84, 0x3D, 0x18, 0xC6, 0x20,  /* 0x68 h */
+    0xBE,                          /* 0x69 i */
+    0x20, 0x92, 0x6A,              /* 0x6A j */
+    0x88, 0x9A, 0xCA, 0x90,        /* 0x6B k */
+    0xC9, 0x24, 0x88,              /* 0x6C l */
+    0xD5, 0x6B, 0x5A, 0x80,        /* 0x6D m */
+    0xF4, 0x63, 0x18, 0x80,        /* 0x6E n */
+    0x74, 0x63, 0x17, 0x00,        /* 0x6F o */
+    0xF4, 0x63, 0xE8, 0x40,        /* 0x70 p */
+    0x7C, 0x62, 0xF0, 0x84,        /* 0x71 q */
+    0xBC, 0x88, 0x80,              /* 0x72 r */
+    0x78, 0x61, 0xE0,              /* 0x73 s */
+    0x44, 0xF4, 0x44, 0x30,        /* 0x74 t */
+    0x8C, 0x63, 0x17, 0x80,        /* 0x75 u */
+    0x8C, 0x62, 0xA2, 0x00,        /* 0x76 v */
+    0x8C, 0x6B, 0x55, 0x00,        /* 0x77 w */
+    0x8A, 0x88, 0xA8, 0x80,        /* 0x78 x */
+    0x8C, 0x62, 0xF0, 0xB8,        /* 0x79 y */
+    0xF8, 0x88, 0x8F, 0x80,        /* 0x7A z */
+    0x29, 0x44, 0x88,              /* 0x7B braceleft */
+    0xFE,                          /* 0x7C bar */
+    0x89, 0x14, 0xA0,              /* 0x7D braceright */
+    0x45, 0x44,                    /* 0x7E asciitilde */
+    0x3A, 0x3C, 0x8F, 0x20, 0xE0,  /* 0x80 Euro */
+    0xA8,                          /* 0x85 ellipsis */
+    0x51, 0x1F, 0x07, 0x07, 0xC0,  /* 0x8A Scaron */
+    0x51, 0x3E, 0x22, 0x23, 0xE0,  /* 0x8E Zcaron */
+    0xC0,                          /* 0x91 quoteleft */
+    0xC0,                          /* 0x92 quoteright */
+    0xB4,                          /* 0x93 quotedblleft */
+    0xB4,                          /* 0x94 quotedblright */
+    0x5D, 0x00,                    /* 0x95 bullet */
+    0xF0,                          /* 0x96 endash */
+    0xF8,                          /* 0x97 emdash */
+    0x96, 0x78, 0x61, 0xE0,        /* 0x9A scaron */
+    0x51, 0x3E, 0x22, 0x23, 0xE0,  /* 0x9E zcaron */
+    0x50, 0x22, 0xA2, 0x10, 0x80,  /* 0x9F Ydieresis */
+    0xBE,                          /* 0xA1 exclamdown */
+    0x23, 0xE9, 0x4A, 0x3C, 0x80,  /* 0xA2 cent */
+    0x32, 0x51, 0xC4, 0x26, 0xC0,  /* 0xA3 sterling */
+    0x8B, 0x94, 0xE8, 0x80,        /* 0xA4 currency */
+    0x8A, 0x89, 0xF2, 0x7C, 0x80,  /* 0xA5 yen */
+    0xEE,                          /* 0xA6 brokenbar */
+    0x78, 0x69, 0x61, 0xE0,        /* 0xA7 section */
+    0xA0,                          /* 0xA8 dieresis */
+    0x74, 0x6B, 0x9A, 0xC5, 0xC0,  /* 0xA9 copyright */
+    0xC7, 0xDE,                    /* 0xAA ordfeminine */
+    0x2A, 0xA8, 0xA2, 0x80,        /* 0xAB guillemotleft */
+    0xF1,                          /* 0xAC logicalnot */
+    0xE0,                          /* 0xAD softhyphen */
+    0x74, 0x7B, 0xBD, 0xC5, 0xC0,  /* 0xAE registered */
+    0xE0,                          /* 0xAF macron */
+    0x55, 0x00,                    /* 0xB0 degree */
+    0x27, 0xC8, 0x0F, 0x80,        /* 0xB1 plusminus */
+    0xC5, 0x70,                    /* 0xB2 twosuperior */
+    0xCC, 0xE0,                    /* 0xB3 threesuperior */
+    0x60,                          /* 0xB4 acute */
+    0x8C, 0x63, 0x9B, 0x40,        /* 0xB5 mu */
+    0x7F, 0x7A, 0xD2, 0x94, 0xA0,  /* 0xB6 paragraph */
+    0x80,                          /* 0xB7 periodcentered */
+    0x60,                          /* 0xB8 cedilla */
+    0x75,                          /* 0xB9 onesuperior */
+    0x55, 0x0E,                    /* 0xBA ordmasculine */
+    0xA2, 0x8A, 0xAA, 0x00,        /* 0xBB guillemotright */
+    0x8C, 0xA8, 0xAB, 0x3C, 0x40,  /* 0xBC onequarter */
+    0x8C, 0xA8, 0xB8, 0x88, 0xE0,  /* 0xBD onehalf */
+    0xCA, 0xB4, 0x55, 0xDC, 0x20,  /* 0xBE threequarters */
+    0x20, 0x08, 0x88, 0x45, 0xC0,  /* 0xBF questiondown */
+    0x41, 0x1D, 0x1F, 0xC6, 0x20,  /* 0xC0 Agrave */
+    0x11, 0x1D, 0x1F, 0xC6, 0x20,  /* 0xC1 Aacute */
+    0x22, 0x9D, 0x1F, 0xC6, 0x20,  /* 0xC2 Acircumflex */
+    0x4D, 0x9D, 0x1F, 0xC6, 0x20,  /* 0xC3 Atilde */
+    0x50, 0x1D, 0x1F, 0xC6, 0x20,  /* 0xC4 Adieresis */
+    0x20, 0x1D, 0x1F, 0xC6, 0x20,  /* 0xC5 Aring */
+    0x7D, 0x29, 0xEA, 0x52, 0xE0,  /* 0xC6 AE */
+    0x74, 0x61, 0x08, 0x45, 0xC4,  /* 0xC7 Ccedilla */
+    0x41, 0x3F, 0x0F, 0x43, 0xE0,  /* 0xC8 Egrave */
+    0x11, 0x3F, 0x0F, 0x43, 0xE0,  /* 0xC9 Eacute */
+    0x22, 0xBF, 0x0F, 0x43, 0xE0,  /* 0xCA Ecircumflex */
+    0x50, 0x3F, 0x0F, 0x43, 0xE0,  /* 0xCB Edieresis */
+    0x8B, 0xA4, 0xB8,              /* 0xCC Igrave */
+    0x2B, 0xA4, 0xB8,              /* 0xCD Iacute */
+    0x57, 0xA4, 0xB8,              /* 0xCE Icircumflex */
+    0xA3, 0xA4, 0xB8,              /* 0xCF Idieresis */
+    0xE4, 0xA3, 0xD8, 0xCB, 0x80,  /* 0xD0 Eth */
+    0x4D, 0xA3, 0x9A, 0xCE, 0x20,  /* 0xD1 Ntilde */
+    0x41, 0x1D, 0x18, 0xC5, 0xC0,  /* 0xD2 Ograve */
+    0x11, 0x1D, 0x18, 0xC5, 0xC0,  /* 0xD3 Oacute */
+    0x22, 0x9D, 0x18, 0xC5, 0xC0,  /* 0xD4 Ocircumflex */
+    0x4D, 0x9D, 0x18, 0xC5, 0xC0,  /* 0xD5 Otilde */
+    0x50, 0x1D, 0x18, 0xC5, 0xC0,  /* 0xD6 Odieresis */
+    0x8A, 0x88, 0xA8, 0x80,        /* 0xD7 multiply */
+    0x74, 0xEB, 0x5A, 0xE5, 0xC0,  /* 0xD8 Oslash */
+    0x41, 0x23, 0x18, 0xC5, 0xC0,  /* 0xD9 Ugrave */
+    0x11, 0x23, 0x18, 0xC5, 0xC0,  /* 0xDA Uacute */
+    0x22, 0xA3, 0x18, 0xC5, 0xC0,  /* 0xDB Ucircumflex */
+    0x50, 0x23, 0x18, 0xC5, 0xC0,  /* 0xDC Udieresis */
+    0x11, 0x22, 0xA2, 0x10, 0x80,  /* 0xDD Yacute */
+    0x87, 0xA3, 0x1F, 0x42, 0x00,  /* 0xDE Thorn */
+    0x64, 0xA5, 0x49, 0x46, 0xC0,  /* 0xDF germandbls */
+    0x41, 0x1C, 0x17, 0xC5, 0xE0,  /* 0xE0 agrave */
+    0x11, 0x1C, 0x17, 0xC5, 0xE0,  /* 0xE1 aacute */
+    0x22, 0x9C, 0x17, 0xC5, 0xE0,  /* 0xE2 acircumflex */
+    0x4D, 0x9C, 0x17, 0xC5, 0xE0,  /* 0xE3 atilde */
+    0x50, 0x1C, 0x17, 0xC5, 0xE0,  /* 0xE4 adieresis */
+    0x20, 0x1C, 0x17, 0xC5, 0xE0,  /* 0xE5 aring */
+    0x50, 0xDF, 0x45, 0x80,        /* 0xE6 ae */
+    0x78, 0x88, 0x74,              /* 0xE7 ccedilla */
+    0x41, 0x1D, 0x1F, 0xC1, 0xC0,  /* 0xE8 egrave */
+    0x11, 0x1D, 0x1F, 0xC1, 0xC0,  /* 0xE9 eacute */
+    0x22, 0x9D, 0x1F, 0xC1, 0xC0,  /* 0xEA ecircumflex */
+    0x50, 0x1D, 0x1F, 0xC1, 0xC0,  /* 0xEB edieresis */
+    0x95, 0x54,                    /* 0xEC igrave */
+    0x6A, 0xA8,                    /* 0xED iacute */
+    0x55, 0x24, 0x90,              /* 0xEE icircumflex */
+    0xA1, 0x24, 0x90,              /* 0xEF idieresis */
+    0x60, 0x9F, 0x18, 0xC5, 0xC0,  /* 0xF0 eth */
+    0x4D, 0xBD, 0x18, 0xC6, 0x20,  /* 0xF1 ntilde */
+    0x41, 0x1D, 0x18, 0xC5, 0xC0,  /* 0xF2 ograve */
+    0x11, 0x1D, 0x18, 0xC5, 0xC0,  /* 0xF3 oacute */
+    0x22, 0x9D, 0x18, 0xC5, 0xC0,  /* 0xF4 ocircumflex */
+    0x4D, 0x9D, 0x18, 0xC5, 0xC0,  /* 0xF5 otilde */
+    0x50, 0x1D, 0x18, 0xC5, 0xC0,  /* 0xF6 odieresis */
+    0x20, 0x3E, 0x02, 0x00,        /* 0xF7 divide */
+    0x74, 0xEB, 0x97, 0x00,        /* 0xF8 oslash */
+    0x41, 0x23, 0x18, 0xC5, 0xE0,  /* 0xF9 ugrave */
+    0x11, 0x23, 0x18, 0xC5, 0xE0,  /* 0xFA uacute */
+    0x22, 0xA3, 0x18, 0xC5, 0xE0,  /* 0xFB ucircumflex */
+    0x50, 0x23, 0x18, 0xC5, 0xE0,  /* 0xFC udieresis */
+    0x11, 0x23, 0x18, 0xBC, 0x2E,  /* 0xFD yacute */
+    0x84, 0x3D, 0x18, 0xFA, 0x10,  /* 0xFE thorn */
+    0x50, 0x23, 0x18, 0xBC, 0x2E,  /* 0xFF ydieresis */
+};
+
+/* {offset, width, height, advance cursor, x offset, y offset} */
+/** Glyphs */
+const GFXglyph Font5x8Glyphs[] PROGMEM = {
+    { 0, 0, 0, 4, 0, 0 }, /* 0x20 space */
+    { 0, 1, 7, 2, 0, -7 }, /* 0x21 exclam */
+    { 1, 3, 2, 4, 0, -7 }, /* 0x22 quotedbl */
+    { 2, 5, 7, 6, 0, -7 }, /* 0x23 numbersign */
+    { 7, 5, 7, 6, 0, -7 }, /* 0x24 dollar */
+    { 12, 5, 7, 6, 0, -7 }, /* 0x25 percent */
+    { 17, 5, 7, 6, 0, -7 }, /* 0x26 ampersand */
+    { 22, 1, 2, 2, 0, -7 }, /* 0x27 quotesingle */
+    { 23, 3, 7, 4, 0, -7 }, /* 0x28 parenleft */
+    { 26, 3, 7, 4, 0, -7 }, /* 0x29 parenright */
+    { 29, 5, 5, 6, 0, -6 }, /* 0x2A asterisk */
+    { 33, 5, 5, 6, 0, -6 }, /* 0x2B plus */
+    { 37, 2, 3, 3, 0, -2 }, /* 0x2C comma */
+    { 38, 4, 1, 5, 0, -4 }, /* 0x2D hyphen */
+    { 39, 1, 1, 2, 0, -1 }, /* 0x2E period */
+    { 40, 5, 5, 6, 0, -6 }, /* 0x2F slash */
+    { 44, 5, 7, 6, 0, -7 }, /* 0x30 zero */
+    { 49, 3, 7, 6, 1, -7 }, /* 0x31 one */
+    { 52, 5, 7, 6, 0, -7 }, /* 0x32 two */
+    { 57, 5, 7, 6, 0, -7 }, /* 0x33 three */
+    { 62, 5, 7, 6, 0, -7 }, /* 0x34 four */
+    { 67, 5, 7, 6, 0, -7 }, /* 0x35 five */
+    { 72, 5, 7, 6, 0, -7 }, /* 0x36 six */
+    { 77, 5, 7, 6, 0, -7 }, /* 0x37 seven */
+    { 82, 5, 7, 6, 0, -7 }, /* 0x38 eight */
+    { 87, 5, 7, 6, 0, -7 }, /* 0x39 nine */
+    { 92, 1, 4, 2, 0, -5 }, /* 0x3A colon */
+    { 93, 2, 6, 3, 0, -5 }, /* 0x3B semicolon */
+    { 95, 4, 7, 5, 0, -7 }, /* 0x3C less */
+    { 99, 4, 3, 5, 0, -5 }, /* 0x3D equal */
+    { 101, 4, 7, 5, 0, -7 }, /* 0x3E greater */
+    { 105, 5, 7, 6, 0, -7 }, /* 0x3F question */
+    { 110, 5, 7, 6, 0, -7 }, /* 0x40 at */
+    { 115, 5, 7, 6, 0, -7 }, /* 0x41 A */
+    { 120, 5, 7, 6, 0, -7 }, /* 0x42 B */
+    { 125, 5, 7, 6, 0, -7 }, /* 0x43 C */
+    { 130, 5, 7, 6, 0, -7 }, /* 0x44 D */
+    { 135, 5, 7, 6, 0, -7 }, /* 0x45 E */
+    { 140, 5, 7, 6, 0, -7 }, /* 0x46 F */
+    { 145, 5, 7, 6, 0, -7 }, /* 0x47 G */
+    { 150, 5, 7, 6, 0, -7 }, /* 0x48 H */
+    { 155, 3, 7, 4, 0, -7 }, /* 0x49 I */
+    { 158, 5, 7, 6, 0, -7 }, /* 0x4A J */
+    { 163, 5, 7, 6, 0, -7 }, /* 0x4B K */
+    { 168, 5, 7, 6, 0, -7 }, /* 0x4C L */
+    { 173, 5, 7, 6, 0, -7 }, /* 0x4D M */
+    { 178, 5, 7, 6, 0, -7 }, /* 0x4E N */
+    { 183, 5, 7, 6, 0, -7 }, /* 0x4F O */
+    { 188, 5, 7, 6, 0, -7 }, /* 0x50 P */
+    { 193, 5, 7, 6, 0, -7 }, /* 0x51 Q */
+    { 198, 5, 7, 6, 0, -7 }, /* 0x52 R */
+    { 203, 5, 7, 6, 0, -7 }, /* 0x53 S */
+    { 208, 5, 7, 6, 0, -7 }, /* 0x54 T */
+    { 213, 5, 7, 6, 0, -7 }, /* 0x55 U */
+    { 218, 5, 7, 6, 0, -7 }, /* 0x56 V */
+    { 223, 5, 7, 6, 0, -7 }, /* 0x57 W */
+    { 228, 5, 7, 6, 0, -7 }, /* 0x58 X */
+    { 233, 5, 7, 6, 0, -7 }, /* 0x59 Y */
+    { 238, 5, 7, 6, 0, -7 }, /* 0x5A Z */
+    { 243, 3, 7, 4, 0, -7 }, /* 0x5B bracketleft */
+    { 246, 5, 5, 6, 0, -6 }, /* 0x5C backslash */
+    { 250, 3, 7, 4, 0, -7 }, /* 0x5D bracketright */
+    { 253, 5, 3, 6, 0, -7 }, /* 0x5E asciicircum */
+    { 255, 5, 1, 6, 0, 0 }, /* 0x5F underscore */
+    { 256, 2, 2, 3, 0, -7 }, /* 0x60 grave */
+    { 257, 5, 5, 6, 0, -5 }, /* 0x61 a */
+    { 261, 5, 7, 6, 0, -7 }, /* 0x62 b */
+    { 266, 4, 5, 5, 0, -5 }, /* 0x63 c */
+    { 269, 5, 7, 6, 0, -7 }, /* 0x64 d */
+    { 274, 5, 5, 6, 0, -5 }, /* 0x65 e */
+    { 278, 4, 7, 5, 0, -7 }, /* 0x66 f */
+    { 282, 5, 6, 6, 0, -5 }, /* 0x67 g */
+    { 286, 5, 7, 6, 0, -7 }, /* 0x68 h */
+    { 291, 1, 7, 2, 0, -7 }, /* 0x69 i */
+    { 292, 3, 8, 4, 0, -7 }, /* 0x6A j */
+    { 295, 4, 7, 5, 0, -7 }, /* 0x6B k */
+    { 299, 3, 7, 4, 0, -7 }, /* 0x6C l */
+    { 302, 5, 5, 6, 0, -5 }, /* 0x6D m */
+    { 306, 5, 5, 6, 0, -5 }, /* 0x6E n */
+    { 310, 5, 5, 6, 0, -5 }, /* 0x6F o */
+    { 314, 5, 6, 6, 0, -5 }, /* 0x70 p */
+    { 318, 5, 6, 6, 0, -5 }, /* 0x71 q */
+    { 322, 4, 5, 5, 0, -5 }, /* 0x72 r */
+    { 325, 4, 5, 5, 0, -5 }, /* 0x73 s */
+    { 328, 4, 7, 5, 0, -7 }, /* 0x74 t */
+    { 332, 5, 5, 6, 0, -5 }, /* 0x75 u */
+    { 336, 5, 5, 6, 0, -5 }, /* 0x76 v */
+    { 340, 5, 5, 6, 0, -5 }, /* 0x77 w */
+    { 344, 5, 5, 6, 0, -5 }, /* 0x78 x */
+    { 348, 5, 6, 6, 0, -5 }, /* 0x79 y */
+    { 352, 5, 5, 6, 0, -5 }, /* 0x7A z */
+    { 356, 3, 7, 4, 0, -7 }, /* 0x7B braceleft */
+    { 359, 1, 7, 2, 0, -7 }, /* 0x7C bar */
+    { 360, 3, 7, 4, 0, -7 }, /* 0x7D braceright */
+    { 363, 5, 3, 6, 0, -5 }, /* 0x7E asciitilde */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x7F */
+    { 365, 5, 7, 6, 0, -7 }, /* 0x80 Euro */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x81 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x82 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x83 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x84 */
+    { 370, 5, 1, 6, 0, -1 }, /* 0x85 ellipsis */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x86 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x87 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x88 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x89 */
+    { 371, 5, 7, 6, 0, -7 }, /* 0x8A Scaron */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x8B */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x8C */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x8D */
+    { 376, 5, 7, 6, 0, -7 }, /* 0x8E Zcaron */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x8F */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x90 */
+    { 381, 1, 2, 2, 0, -7 }, /* 0x91 quoteleft */
+    { 382, 1, 2, 2, 0, -7 }, /* 0x92 quoteright */
+    { 383, 3, 2, 4, 0, -7 }, /* 0x93 quotedblleft */
+    { 384, 3, 2, 4, 0, -7 }, /* 0x94 quotedblright */
+    { 385, 3, 3, 4, 0, -5 }, /* 0x95 bullet */
+    { 387, 4, 1, 5, 0, -4 }, /* 0x96 endash */
+    { 388, 5, 1, 6, 0, -4 }, /* 0x97 emdash */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x98 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x99 */
+    { 389, 4, 7, 5, 0, -7 }, /* 0x9A scaron */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x9B */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x9C */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x9D */
+    { 393, 5, 7, 6, 0, -7 }, /* 0x9E zcaron */
+    { 398, 5, 7, 6, 0, -7 }, /* 0x9F Ydieresis */
+    { 403, 0, 0, 4, 0, 0 }, /* 0xA0 nbspace */
+    { 403, 1, 7, 2, 0, -7 }, /* 0xA1 exclamdown */
+    { 404, 5, 7, 6, 0, -7 }, /* 0xA2 cent */
+    { 409, 5, 7, 6, 0, -7 }, /* 0xA3 sterling */
+    { 414, 5, 5, 6, 0, -6 }, /* 0xA4 currency */
+    { 418, 5, 7, 6, 0, -7 }, /* 0xA5 yen */
+    { 423, 1, 7, 2, 0, -7 }, /* 0xA6 brokenbar */
+    { 424, 4, 7, 5, 0, -7 }, /* 0xA7 section */
+    { 428, 3, 1, 4, 0, -7 }, /* 0xA8 dieresis */
+    { 429, 5, 7, 6, 0, -7 }, /* 0xA9 copyright */
+    { 434, 3, 5, 4, 0, -7 }, /* 0xAA ordfeminine */
+    { 436, 5, 5, 6, 0, -5 }, /* 0xAB guillemotleft */
+    { 440, 4, 2, 5, 0, -4 }, /* 0xAC logicalnot */
+    { 441, 3, 1, 4, 0, -4 }, /* 0xAD softhyphen */
+    { 442, 5, 7, 6, 0, -7 }, /* 0xAE registered */
+    { 447, 3, 1, 4, 0, -7 }, /* 0xAF macron */
+    { 448, 3, 3, 4, 0, -7 }, /* 0xB0 degree */
+    { 450, 5, 5, 6, 0, -6 }, /* 0xB1 plusminus */
+    { 454, 3, 4, 4, 0, -7 }, /* 0xB2 twosuperior */
+    { 456, 3, 4, 4, 0, -7 }, /* 0xB3 threesuperior */
+    { 458, 2, 2, 3, 0, -7 }, /* 0xB4 acute */
+    { 459, 5, 6, 6, 0, -5 }, /* 0xB5 mu */
+    { 463, 5, 7, 6, 0, -7 }, /* 0xB6 paragraph */
+    { 468, 1, 1, 2, 0, -4 }, /* 0xB7 periodcentered */
+    { 469, 2, 2, 3, 0, -1 }, /* 0xB8 cedilla */
+    { 470, 2, 4, 3, 0, -7 }, /* 0xB9 onesuperior */
+    { 471, 3, 5, 4, 0, -7 }, /* 0xBA ordmasculine */
+    { 473, 5, 5, 6, 0, -5 }, /* 0xBB guillemotright */
+    { 477, 5, 7, 6, 0, -7 }, /* 0xBC onequarter */
+    { 482, 5, 7, 6, 0, -7 }, /* 0xBD onehalf */
+    { 487, 5, 7, 6, 0, -7 }, /* 0xBE threequarters */
+    { 492, 5, 7, 6, 0, -7 }, /* 0xBF questiondown */
+    { 497, 5, 7, 6, 0, -7 }, /* 0xC0 Agrave */
+    { 502, 5, 7, 6, 0, -7 }, /* 0xC1 Aacute */
+    { 507, 5, 7, 6, 0, -7 }, /* 0xC2 Acircumflex */
+    { 512, 5, 7, 6, 0, -7 }, /* 0xC3 Atilde */
+    { 517, 5, 7, 6, 0, -7 }, /* 0xC4 Adieresis */
+    { 522, 5, 7, 6, 0, -7 }, /* 0xC5 Aring */
+    { 527, 5, 7, 6, 0, -7 }, /* 0xC6 AE */
+    { 532, 5, 8, 6, 0, -7 }, /* 0xC7 Ccedilla */
+    { 537, 5, 7, 6, 0, -7 }, /* 0xC8 Egrave */
+    { 542, 5, 7, 6, 0, -7 }, /* 0xC9 Eacute */
+    { 547, 5, 7, 6, 0, -7 }, /* 0xCA Ecircumflex */
+    { 552, 5, 7, 6, 0, -7 }, /* 0xCB Edieresis */
+    { 557, 3, 7, 4, 0, -7 }, /* 0xCC Igrave */
+    { 560, 3, 7, 4, 0, -7 }, /* 0xCD Iacute */
+    { 563, 3, 7, 4, 0, -7 }, /* 0xCE Icircumflex */
+    { 566, 3, 7, 4, 0, -7 }, /* 0xCF Idieresis */
+    { 569, 5, 7, 6, 0, -7 }, /* 0xD0 Eth */
+    { 574, 5, 7, 6, 0, -7 }, /* 0xD1 Ntilde */
+    { 579, 5, 7, 6, 0, -7 }, /* 0xD2 Ograve */
+    { 584, 5, 7, 6, 0, -7 }, /* 0xD3 Oacute */
+    { 589, 5, 7, 6, 0, -7 }, /* 0xD4 Ocircumflex */
+    { 594, 5, 7, 6, 0, -7 }, /* 0xD5 Otilde */
+    { 599, 5, 7, 6, 0, -7 }, /* 0xD6 Odieresis */
+    { 604, 5, 5, 6, 0, -5 }, /* 0xD7 multiply */
+    { 608, 5, 7, 6, 0, -7 }, /* 0xD8 Oslash */
+    { 613, 5, 7, 6, 0, -7 }, /* 0xD9 Ugrave */
+    { 618, 5, 7, 6, 0, -7 }, /* 0xDA Uacute */
+    { 623, 5, 7, 6, 0, -7 }, /* 0xDB Ucircumflex */
+    { 628, 5, 7, 6, 0, -7 }, /* 0xDC Udieresis */
+    { 633, 5, 7, 6, 0, -7 }, /* 0xDD Yacute */
+    { 638, 5, 7, 6, 0, -7 }, /* 0xDE Thorn */
+    { 643, 5, 7, 6, 0, -7 }, /* 0xDF germandbls */
+    { 648, 5, 7, 6, 0, -7 }, /* 0xE0 agrave */
+    { 653, 5, 7, 6, 0, -7 }, /* 0xE1 aacute */
+    { 658, 5, 7, 6, 0, -7 }, /* 0xE2 acircumflex */
+    { 663, 5, 7, 6, 0, -7 }, /* 0xE3 atilde */
+    { 668, 5, 7, 6, 0, -7 }, /* 0xE4 adieresis */
+    { 673, 5, 7, 6, 0, -7 }, /* 0xE5 aring */
+    { 678, 5, 5, 6, 0, -5 }, /* 0xE6 ae */
+    { 682, 4, 6, 5, 0, -5 }, /* 0xE7 ccedilla */
+    { 685, 5, 7, 6, 0, -7 }, /* 0xE8 egrave */
+    { 690, 5, 7, 6, 0, -7 }, /* 0xE9 eacute */
+    { 695, 5, 7, 6, 0, -7 }, /* 0xEA ecircumflex */
+    { 700, 5, 7, 6, 0, -7 }, /* 0xEB edieresis */
+    { 705, 2, 7, 4, 0, -7 }, /* 0xEC igrave */
+    { 707, 2, 7, 4, 1, -7 }, /* 0xED iacute */
+    { 709, 3, 7, 4, 0, -7 }, /* 0xEE icircumflex */
+    { 712, 3, 7, 4, 0, -7 }, /* 0xEF idieresis */
+    { 715, 5, 7, 6, 0, -7 }, /* 0xF0 eth */
+    { 720, 5, 7, 6, 0, -7 }, /* 0xF1 ntilde */
+    { 725, 5, 7, 6, 0, -7 }, /* 0xF2 ograve */
+    { 730, 5, 7, 6, 0, -7 }, /* 0xF3 oacute */
+    { 735, 5, 7, 6, 0, -7 }, /* 0xF4 ocircumflex */
+    { 740, 5, 7, 6, 0, -7 }, /* 0xF5 otilde */
+    { 745, 5, 7, 6, 0, -7 }, /* 0xF6 odieresis */
+    { 750, 5, 5, 6, 0, -6 }, /* 0xF7 divide */
+    { 754, 5, 5, 6, 0, -5 }, /* 0xF8 oslash */
+    { 758, 5, 7, 6, 0, -7 }, /* 0xF9 ugrave */
+    { 763, 5, 7, 6, 0, -7 }, /* 0xFA uacute */
+    { 768, 5, 7, 6, 0, -7 }, /* 0xFB ucircumflex */
+    { 773, 5, 7, 6, 0, -7 }, /* 0xFC udieresis */
+    { 778, 5, 8, 6, 0, -7 }, /* 0xFD yacute */
+    { 783, 5, 8, 6, 0, -7 }, /* 0xFE thorn */
+    { 788, 5, 8, 6, 0, -7 }, /* 0xFF ydieresis */
+};
+
+/** Font with 5x7 pixel glyphs and 8 pixel line height */
+const GFXfont Font5x8 PROGMEM = {
+    (uint8_t  *)Font5x8Bitmaps,
+    (GFXglyph *)Font5x8Glyphs,
+    0x20, 0xFF, 8 };
+
+#endif  /* __FONT5X8_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,418 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Frame record codec
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FrameCodec.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static inline void writeUInt16(uint8_t* buffer, uint16_t value);
+static inline void writeUInt32(uint8_t* buffer, uint32_t value);
+static inline uint16_t readUInt16(const uint8_t* buffer);
+static inline uint32_t readUInt32(const uint8_t* buffer);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Magic at the begin of a recording. */
+static const uint8_t    MAGIC[]     = { 'P', 'X', 'R', 'C' };
+
+/** FNV-1a prime */
+static const uint32_t   FNV_PRIME   = 16777619U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+FrameEncoder::FrameEncoder(size_t pixelCount) :
+    m_pixelCount(pixelCount),
+    m_prevFrame(new uint32_t[pixelCount]),
+    m_isKeyFrameRequired(true)
+{
+}
+
+FrameEncoder::~FrameEncoder()
+{
+    if (nullptr != m_prevFrame)
+    {
+        delete[] m_prevFrame;
+        m_prevFrame = nullptr;
+    }
+}
+
+size_t FrameEncoder::encode(const uint32_t* frame, uint32_t timestamp, uint8_t* buffer)
+{
+    const size_t    KEY_RECORD_SIZE = FrameCodec::getMaxRecordSize(m_pixelCount);
+    size_t          offset          = FrameCodec::RECORD_HEADER_SIZE;
+    bool            isKeyFrame      = m_isKeyFrameRequired;
+
+    if ((nullptr == m_prevFrame) ||
+        (nullptr == frame) ||
+        (nullptr == buffer))
+    {
+        return 0U;
+    }
+
+    if (false == isKeyFrame)
+    {
+        size_t index = 0U;
+
+        while((m_pixelCount > index) && (false == isKeyFrame))
+        {
+            /* Skip unchanged pixels. */
+            if (m_prevFrame[index] == frame[index])
+            {
+                ++index;
+            }
+            else
+            {
+                const size_t    BEGIN   = index;
+                size_t          end     = index + 1U;
+
+                ++index;
+
+                /* Gaps of unchanged pixels, which are cheaper to record than
+                 * a new run header, are taken over into the run.
+                 */
+                while(m_pixelCount > index)
+                {
+                    if (m_prevFrame[index] != frame[index])
+                    {
+                        ++index;
+                        end = index;
+                    }
+                    else if (((index - end + 1U) * FrameCodec::BYTES_PER_PIXEL) <= FrameCodec::RUN_HEADER_SIZE)
+                    {
+                        ++index;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+
+                /* If the delta record gets larger than a key record, record a key frame. */
+                if (KEY_RECORD_SIZE < (offset + FrameCodec::RUN_HEADER_SIZE + ((end - BEGIN) * FrameCodec::BYTES_PER_PIXEL)))
+                {
+                    isKeyFrame = true;
+                }
+                else
+                {
+                    offset = appendRun(frame, buffer, offset, BEGIN, end);
+                }
+            }
+        }
+
+        /* Nothing changed? */
+        if ((false == isKeyFrame) &&
+            (FrameCodec::RECORD_HEADER_SIZE == offset))
+        {
+            offset = 0U;
+        }
+    }
+
+    if (true == isKeyFrame)
+    {
+        offset = appendRun(frame, buffer, FrameCodec::RECORD_HEADER_SIZE, 0U, m_pixelCount);
+    }
+
+    if (0U < offset)
+    {
+        buffer[0] = static_cast<uint8_t>((true == isKeyFrame) ? FrameCodec::RECORD_TYPE_KEY : FrameCodec::RECORD_TYPE_DELTA);
+        writeUInt32(&buffer[1], timestamp);
+        writeUInt16(&buffer[5], static_cast<uint16_t>(offset - FrameCodec::RECORD_HEADER_SIZE));
+
+        memcpy(m_prevFrame, frame, m_pixelCount * sizeof(m_prevFrame[0]));
+        m_isKeyFrameRequired = false;
+    }
+
+    return offset;
+}
+
+FrameDecoder::FrameDecoder(size_t pixelCount) :
+    m_pixelCount(pixelCount),
+    m_frame(new uint32_t[pixelCount])
+{
+    if (nullptr != m_frame)
+    {
+        memset(m_frame, 0, m_pixelCount * sizeof(m_frame[0]));
+    }
+}
+
+FrameDecoder::~FrameDecoder()
+{
+    if (nullptr != m_frame)
+    {
+        delete[] m_frame;
+        m_frame = nullptr;
+    }
+}
+
+size_t FrameDecoder::decode(const uint8_t* buffer, size_t size, uint32_t& timestamp)
+{
+    size_t  payloadSize = 0U;
+    size_t  offset      = FrameCodec::RECORD_HEADER_SIZE;
+    size_t  end         = 0U;
+
+    if ((nullptr == m_frame) ||
+        (nullptr == buffer) ||
+        (FrameCodec::RECORD_HEADER_SIZE > size))
+    {
+        return 0U;
+    }
+
+    if ((FrameCodec::RECORD_TYPE_KEY != buffer[0]) &&
+        (FrameCodec::RECORD_TYPE_DELTA != buffer[0]))
+    {
+        return 0U;
+    }
+
+    payloadSize = readUInt16(&buffer[5]);
+    end         = FrameCodec::RECORD_HEADER_SIZE + payloadSize;
+
+    if (size < end)
+    {
+        return 0U;
+    }
+
+    /* Validate all runs first, so an invalid record doesn't change the frame. */
+    while(end > offset)
+    {
+        size_t begin = 0U;
+        size_t count = 0U;
+
+        if (end < (offset + FrameCodec::RUN_HEADER_SIZE))
+        {
+            return 0U;
+        }
+
+        begin   = readUInt16(&buffer[offset + 0U]);
+        count   = readUInt16(&buffer[offset + 2U]);
+        offset += FrameCodec::RUN_HEADER_SIZE + (count * FrameCodec::BYTES_PER_PIXEL);
+
+        if ((m_pixelCount < (begin + count)) ||
+            (end < offset))
+        {
+            return 0U;
+        }
+    }
+
+    offset = FrameCodec::RECORD_HEADER_SIZE;
+
+    while(end > offset)
+    {
+        size_t begin = readUInt16(&buffer[offset + 0U]);
+        size_t count = readUInt16(&buffer[offset + 2U]);
+        size_t index = 0U;
+
+        offset += FrameCodec::RUN_HEADER_SIZE;
+
+        for(index = begin; index < (begin + count); ++index)
+        {
+            m_frame[index]  = (static_cast<uint32_t>(buffer[offset + 0U]) << 16U) |
+                              (static_cast<uint32_t>(buffer[offset + 1U]) << 8U) |
+                              (static_cast<uint32_t>(buffer[offset + 2U]) << 0U);
+            offset         += FrameCodec::BYTES_PER_PIXEL;
+        }
+    }
+
+    timestamp = readUInt32(&buffer[1]);
+
+    return end;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+size_t FrameEncoder::appendRun(const uint32_t* frame, uint8_t* buffer, size_t offset, size_t begin, size_t end)
+{
+    size_t index = 0U;
+
+    writeUInt16(&buffer[offset + 0U], static_cast<uint16_t>(begin));
+    writeUInt16(&buffer[offset + 2U], static_cast<uint16_t>(end - begin));
+    offset += FrameCodec::RUN_HEADER_SIZE;
+
+    for(index = begin; index < end; ++index)
+    {
+        const uint32_t COLOR = frame[index];
+
+        buffer[offset + 0U] = static_cast<uint8_t>((COLOR >> 16U) & 0xffU);
+        buffer[offset + 1U] = static_cast<uint8_t>((COLOR >>  8U) & 0xffU);
+        buffer[offset + 2U] = static_cast<uint8_t>((COLOR >>  0U) & 0xffU);
+        offset += FrameCodec::BYTES_PER_PIXEL;
+    }
+
+    return offset;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+size_t FrameCodec::writeFileHeader(uint8_t* buffer, const FileHeader& header)
+{
+    if (nullptr == buffer)
+    {
+        return 0U;
+    }
+
+    memset(buffer, 0, FILE_HEADER_SIZE);
+    memcpy(&buffer[0], MAGIC, sizeof(MAGIC));
+    buffer[4] = VERSION;
+    writeUInt16(&buffer[6], header.width);
+    writeUInt16(&buffer[8], header.height);
+    writeUInt32(&buffer[12], header.seed);
+
+    return FILE_HEADER_SIZE;
+}
+
+bool FrameCodec::readFileHeader(const uint8_t* buffer, size_t size, FileHeader& header)
+{
+    if ((nullptr == buffer) ||
+        (FILE_HEADER_SIZE > size) ||
+        (0 != memcmp(&buffer[0], MAGIC, sizeof(MAGIC))) ||
+        (VERSION != buffer[4]))
+    {
+        return false;
+    }
+
+    header.width    = readUInt16(&buffer[6]);
+    header.height   = readUInt16(&buffer[8]);
+    header.seed     = readUInt32(&buffer[12]);
+
+    return true;
+}
+
+uint32_t FrameCodec::hash(const uint32_t* frame, size_t pixelCount, uint32_t prevHash)
+{
+    uint32_t    hash    = prevHash;
+    size_t      index   = 0U;
+
+    if (nullptr != frame)
+    {
+        for(index = 0U; index < pixelCount; ++index)
+        {
+            const uint32_t  COLOR   = frame[index];
+            uint8_t         shift   = 0U;
+
+            /* Only the color channels are hashed, byte by byte. */
+            for(shift = 0U; shift < 24U; shift += 8U)
+            {
+                hash ^= (COLOR >> shift) & 0xffU;
+                hash *= FNV_PRIME;
+            }
+        }
+    }
+
+    return hash;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a uint16_t in little endian.
+ *
+ * @param[out] buffer   Buffer
+ * @param[in]  value    Value
+ */
+static inline void writeUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = static_cast<uint8_t>((value >> 0U) & 0xffU);
+    buffer[1] = static_cast<uint8_t>((value >> 8U) & 0xffU);
+}
+
+/**
+ * Write a uint32_t in little endian.
+ *
+ * @param[out] buffer   Buffer
+ * @param[in]  value    Value
+ */
+static inline void writeUInt32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = static_cast<uint8_t>((value >>  0U) & 0xffU);
+    buffer[1] = static_cast<uint8_t>((value >>  8U) & 0xffU);
+    buffer[2] = static_cast<uint8_t>((value >> 16U) & 0xffU);
+    buffer[3] = static_cast<uint8_t>((value >> 24U) & 0xffU);
+}
+
+/**
+ * Read a uint16_t in little endian.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static inline uint16_t readUInt16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0]) |
+           (static_cast<uint16_t>(buffer[1]) << 8U);
+}
+
+/**
+ * Read a uint32_t in little endian.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static inline uint32_t readUInt32(const uint8_t* buffer)
+{
+    return static_cast<uint32_t>(buffer[0]) |
+           (static_cast<uint32_t>(buffer[1]) << 8U) |
+           (static_cast<uint32_t>(buffer[2]) << 16U) |
+           (static_cast<uint32_t>(buffer[3]) << 24U);
+}
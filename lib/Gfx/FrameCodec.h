@@ -0,0 +1,302 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Frame record codec
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __FRAME_CODEC_H__
+#define __FRAME_CODEC_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A frame recording contains the sequence of rendered frames plus timing.
+ * The frames are in RGB888 format (0x00RRGGBB), row by row. Only the changed
+ * pixel runs relative to the previous frame are recorded.
+ *
+ * Recording layout (all values in little endian):
+ * - File header (FILE_HEADER_SIZE bytes):
+ *   - Magic "PXRC" (4 bytes)
+ *   - Version (uint8_t)
+ *   - Reserved (uint8_t)
+ *   - Width in pixel (uint16_t)
+ *   - Height in pixel (uint16_t)
+ *   - Reserved (uint16_t)
+ *   - Random seed (uint32_t), which was used during recording.
+ * - Followed by the frame records:
+ *   - Record type (uint8_t): RECORD_TYPE_KEY or RECORD_TYPE_DELTA
+ *   - Timestamp in ms (uint32_t), relative to the begin of the recording.
+ *   - Payload size in bytes (uint16_t)
+ *   - Payload: Pixel runs, each:
+ *     - Index of the first pixel in the run (uint16_t)
+ *     - Number of pixels in the run (uint16_t)
+ *     - The pixel colors as red, green and blue byte.
+ */
+namespace FrameCodec
+{
+
+/** Version of the recording layout. */
+static const uint8_t    VERSION             = 1U;
+
+/** Size of the file header in bytes. */
+static const size_t     FILE_HEADER_SIZE    = 16U;
+
+/** Size of the record header in bytes. */
+static const size_t     RECORD_HEADER_SIZE  = 7U;
+
+/** Size of the run header in bytes. */
+static const size_t     RUN_HEADER_SIZE     = 4U;
+
+/** Number of bytes per pixel. */
+static const size_t     BYTES_PER_PIXEL     = 3U;
+
+/** Record types */
+enum RecordType
+{
+    RECORD_TYPE_KEY     = 0,    /**< Record contains all pixels. */
+    RECORD_TYPE_DELTA   = 1     /**< Record contains only the changed pixels. */
+};
+
+/** File header */
+struct FileHeader
+{
+    uint16_t    width;  /**< Width in pixel */
+    uint16_t    height; /**< Height in pixel */
+    uint32_t    seed;   /**< Random seed */
+};
+
+/**
+ * Get the max. size of a single record.
+ *
+ * @param[in] pixelCount    Number of pixels per frame
+ *
+ * @return Max. record size in bytes
+ */
+inline size_t getMaxRecordSize(size_t pixelCount)
+{
+    return RECORD_HEADER_SIZE + RUN_HEADER_SIZE + (BYTES_PER_PIXEL * pixelCount);
+}
+
+/**
+ * Write the file header.
+ *
+ * @param[out] buffer   Buffer with at least FILE_HEADER_SIZE bytes
+ * @param[in]  header   File header
+ *
+ * @return Number of written bytes
+ */
+extern size_t writeFileHeader(uint8_t* buffer, const FileHeader& header);
+
+/**
+ * Read the file header.
+ *
+ * @param[in]  buffer   Buffer
+ * @param[in]  size     Buffer size in bytes
+ * @param[out] header   File header
+ *
+ * @return If the header is valid, it will return true otherwise false.
+ */
+extern bool readFileHeader(const uint8_t* buffer, size_t size, FileHeader& header);
+
+/**
+ * Calculate the FNV-1a hash of a frame. It can be continued over several
+ * frames, by passing the previous hash.
+ *
+ * @param[in] frame         Frame in RGB888 format
+ * @param[in] pixelCount    Number of pixels
+ * @param[in] prevHash      Previous hash
+ *
+ * @return Hash
+ */
+extern uint32_t hash(const uint32_t* frame, size_t pixelCount, uint32_t prevHash = 2166136261U);
+
+}
+
+/**
+ * Encodes frames into records.
+ */
+class FrameEncoder
+{
+public:
+
+    /**
+     * Constructs the encoder.
+     *
+     * @param[in] pixelCount    Number of pixels per frame
+     */
+    FrameEncoder(size_t pixelCount);
+
+    /**
+     * Destroys the encoder.
+     */
+    ~FrameEncoder();
+
+    /**
+     * Is the encoder ready? If the frame buffer allocation failed,
+     * it is not ready.
+     *
+     * @return If ready, it will return true otherwise false.
+     */
+    bool isReady() const
+    {
+        return (nullptr != m_prevFrame);
+    }
+
+    /**
+     * Force the next record to be a key frame, e.g. if the previous record
+     * couldn't be stored.
+     */
+    void requestKeyFrame()
+    {
+        m_isKeyFrameRequired = true;
+    }
+
+    /**
+     * Encode a frame into a record. If it is not worth to record only the
+     * changed pixels, a key frame is encoded.
+     *
+     * @param[in]  frame        Frame in RGB888 format
+     * @param[in]  timestamp    Timestamp in ms, relative to the begin of the recording.
+     * @param[out] buffer       Record buffer with at least FrameCodec::getMaxRecordSize() bytes
+     *
+     * @return Size of the record in bytes. If nothing changed, it will be 0.
+     */
+    size_t encode(const uint32_t* frame, uint32_t timestamp, uint8_t* buffer);
+
+private:
+
+    size_t      m_pixelCount;           /**< Number of pixels per frame */
+    uint32_t*   m_prevFrame;            /**< Previous frame */
+    bool        m_isKeyFrameRequired;   /**< Shall the next record be a key frame? */
+
+    FrameEncoder();
+    FrameEncoder(const FrameEncoder& encoder);
+    FrameEncoder& operator=(const FrameEncoder& encoder);
+
+    /**
+     * Append a pixel run to the record buffer.
+     *
+     * @param[in] frame     Frame
+     * @param[in] buffer    Record buffer
+     * @param[in] offset    Offset in the record buffer
+     * @param[in] begin     Index of the first pixel
+     * @param[in] end       Index after the last pixel
+     *
+     * @return Offset after the appended run.
+     */
+    size_t appendRun(const uint32_t* frame, uint8_t* buffer, size_t offset, size_t begin, size_t end);
+};
+
+/**
+ * Decodes records into frames.
+ */
+class FrameDecoder
+{
+public:
+
+    /**
+     * Constructs the decoder.
+     *
+     * @param[in] pixelCount    Number of pixels per frame
+     */
+    FrameDecoder(size_t pixelCount);
+
+    /**
+     * Destroys the decoder.
+     */
+    ~FrameDecoder();
+
+    /**
+     * Is the decoder ready? If the frame buffer allocation failed,
+     * it is not ready.
+     *
+     * @return If ready, it will return true otherwise false.
+     */
+    bool isReady() const
+    {
+        return (nullptr != m_frame);
+    }
+
+    /**
+     * Decode the next record and apply it on the frame.
+     *
+     * @param[in]  buffer       Buffer, which starts with the record.
+     * @param[in]  size         Buffer size in bytes
+     * @param[out] timestamp    Timestamp in ms of the record
+     *
+     * @return Size of the decoded record in bytes. If the record is incomplete or invalid, it will be 0.
+     */
+    size_t decode(const uint8_t* buffer, size_t size, uint32_t& timestamp);
+
+    /**
+     * Get the decoded frame.
+     *
+     * @return Frame in RGB888 format
+     */
+    const uint32_t* getFrame() const
+    {
+        return m_frame;
+    }
+
+private:
+
+    size_t      m_pixelCount;   /**< Number of pixels per frame */
+    uint32_t*   m_frame;        /**< Decoded frame */
+
+    FrameDecoder();
+    FrameDecoder(const FrameDecoder& decoder);
+    FrameDecoder& operator=(const FrameDecoder& decoder);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FRAME_CODEC_H__ */
+
+/** @} */
@@ -0,0 +1,187 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Framebuffer geometry
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __GEOMETRY_HPP__
+#define __GEOMETRY_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Geometry of a framebuffer, which is known only at runtime.
+ *
+ * Kernels, which loop over a framebuffer, take the geometry as template
+ * parameter. With a DynamicGeometry they work with any framebuffer size,
+ * with a FixedGeometry they get constant loop bounds and strides.
+ */
+class DynamicGeometry
+{
+public:
+
+    /**
+     * Constructs the geometry.
+     *
+     * @param[in] width     Width in pixels
+     * @param[in] height    Height in pixels
+     */
+    DynamicGeometry(uint16_t width, uint16_t height) :
+        m_width(width),
+        m_height(height)
+    {
+    }
+
+    /**
+     * Get width in pixels.
+     *
+     * @return Width in pixels
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Get height in pixels.
+     *
+     * @return Height in pixels
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Get number of pixels.
+     *
+     * @return Number of pixels
+     */
+    uint32_t getPixelCount() const
+    {
+        return static_cast<uint32_t>(m_width) * m_height;
+    }
+
+private:
+
+    uint16_t    m_width;    /**< Width in pixels */
+    uint16_t    m_height;   /**< Height in pixels */
+};
+
+/**
+ * Geometry of a framebuffer, which is known at compile time, e.g. the
+ * LED matrix size. It has the same interface as the DynamicGeometry, but
+ * returns constants, which allows the compiler to unroll the loops and to
+ * replace the multiplications with the width.
+ *
+ * @tparam WIDTH    Width in pixels
+ * @tparam HEIGHT   Height in pixels
+ */
+template < uint16_t WIDTH, uint16_t HEIGHT >
+class FixedGeometry
+{
+public:
+
+    /**
+     * Constructs the geometry.
+     */
+    FixedGeometry()
+    {
+    }
+
+    /**
+     * Get width in pixels.
+     *
+     * @return Width in pixels
+     */
+    uint16_t getWidth() const
+    {
+        return WIDTH;
+    }
+
+    /**
+     * Get height in pixels.
+     *
+     * @return Height in pixels
+     */
+    uint16_t getHeight() const
+    {
+        return HEIGHT;
+    }
+
+    /**
+     * Get number of pixels.
+     *
+     * @return Number of pixels
+     */
+    uint32_t getPixelCount() const
+    {
+        return static_cast<uint32_t>(WIDTH) * HEIGHT;
+    }
+
+    /**
+     * Has a framebuffer this geometry? Only then the fixed geometry can be
+     * used instead of the dynamic one.
+     *
+     * @param[in] width     Framebuffer width in pixels
+     * @param[in] height    Framebuffer height in pixels
+     *
+     * @return If the geometry matches, it will return true otherwise false.
+     */
+    static bool matches(uint16_t width, uint16_t height)
+    {
+        return ((WIDTH == width) && (HEIGHT == height));
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GEOMETRY_HPP__ */
+
+/** @} */
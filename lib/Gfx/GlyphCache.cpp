@@ -0,0 +1,146 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Glyph decode cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GlyphCache.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+const GlyphCache::Glyph* GlyphCache::get(const GFXfont* font, uint8_t code)
+{
+    const GFXglyph* glyph   = &(font->glyph[code - font->first]);
+    const Glyph*    result  = nullptr;
+
+    if ((MAX_WIDTH >= glyph->width) &&
+        (MAX_HEIGHT >= glyph->height))
+    {
+        /* Mix the font address in, to avoid that the same character of
+         * different fonts displace each other.
+         */
+        const uintptr_t FONT_HASH   = reinterpret_cast<uintptr_t>(font) >> 4U;
+        const uint8_t   INDEX       = (code ^ static_cast<uint8_t>(FONT_HASH)) & (ENTRIES - 1U);
+        Glyph&          entry       = m_entries[INDEX];
+
+        if ((font != entry.font) ||
+            (code != entry.code))
+        {
+            decode(entry, font, glyph, code);
+        }
+
+        result = &entry;
+    }
+
+    return result;
+}
+
+void GlyphCache::clear()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < ENTRIES; ++index)
+    {
+        m_entries[index].font = nullptr;
+        m_entries[index].code = 0U;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void GlyphCache::decode(Glyph& entry, const GFXfont* font, const GFXglyph* glyph, uint8_t code)
+{
+    const uint8_t*  bitmap      = &font->bitmap[glyph->bitmapOffset];
+    uint32_t        bitIndex    = 0U;
+    uint8_t         y           = 0U;
+
+    for(y = 0U; y < glyph->height; ++y)
+    {
+        uint16_t    row = 0U;
+        uint8_t     x   = 0U;
+
+        for(x = 0U; x < glyph->width; ++x)
+        {
+            if (0U != (bitmap[bitIndex >> 3U] & (0x80U >> (bitIndex & 0x07U))))
+            {
+                row |= static_cast<uint16_t>(0x8000U >> x);
+            }
+
+            ++bitIndex;
+        }
+
+        entry.rows[y] = row;
+    }
+
+    entry.font = font;
+    entry.code = code;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,160 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Glyph decode cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __GLYPH_CACHE_H__
+#define __GLYPH_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <gfxfont.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The glyph cache keeps the recently drawn glyphs decoded in RAM.
+ * A glyph bitmap in the font is a continuous bit stream, which is expensive
+ * to walk through bit by bit. A decoded glyph provides every row as bitmask
+ * instead, which allows to draw horizontal runs of pixels at once.
+ *
+ * The cache is direct mapped by the character code and the font. Note, it
+ * is not thread-safe, therefore it shall be used only by the task, which
+ * draws on the display.
+ */
+class GlyphCache
+{
+public:
+
+    /** Max. glyph width in pixel, which can be decoded. */
+    static const uint8_t    MAX_WIDTH   = 16U;
+
+    /** Max. glyph height in pixel, which can be decoded. */
+    static const uint8_t    MAX_HEIGHT  = 16U;
+
+    /**
+     * A decoded glyph.
+     */
+    struct Glyph
+    {
+        const GFXfont*  font;               /**< Font, the glyph belongs to. */
+        uint8_t         code;               /**< Character code */
+        uint16_t        rows[MAX_HEIGHT];   /**< Glyph rows, the MSB is the leftmost pixel. */
+    };
+
+    /**
+     * Get the glyph cache instance.
+     *
+     * @return Glyph cache
+     */
+    static GlyphCache& getInstance()
+    {
+        static GlyphCache instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Get the decoded glyph of a character. If its not in the cache yet,
+     * it will be decoded.
+     *
+     * @param[in] font  Font
+     * @param[in] code  Character code, which must be available in the font.
+     *
+     * @return If the glyph is too large to be decoded, it will return nullptr otherwise the glyph.
+     */
+    const Glyph* get(const GFXfont* font, uint8_t code);
+
+    /**
+     * Invalidate all cached glyphs.
+     */
+    void clear();
+
+private:
+
+    /** Number of cached glyphs, must be a power of 2. */
+    static const uint8_t    ENTRIES     = 32U;
+
+    Glyph   m_entries[ENTRIES];     /**< Cached glyphs */
+
+    /**
+     * Constructs the glyph cache.
+     */
+    GlyphCache() :
+        m_entries()
+    {
+        clear();
+    }
+
+    /**
+     * Destroys the glyph cache.
+     */
+    ~GlyphCache()
+    {
+    }
+
+    /* Prevent copying */
+    GlyphCache(const GlyphCache&);
+    GlyphCache& operator=(const GlyphCache&);
+
+    /**
+     * Decode a glyph from the font bitmap.
+     *
+     * @param[out] entry    Cache entry, which to fill
+     * @param[in]  font     Font
+     * @param[in]  glyph    Glyph of the font
+     * @param[in]  code     Character code
+     */
+    static void decode(Glyph& entry, const GFXfont* font, const GFXglyph* glyph, uint8_t code);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GLYPH_CACHE_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,176 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Glyph metrics cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GlyphMetrics.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+const uint8_t* GlyphMetrics::getAdvances(const GFXfont* font)
+{
+    uint8_t index = 0U;
+
+    /* Usually only a few fonts are used, therefore a linear search is fine. */
+    while((MAX_FONTS > index) &&
+          (font != m_entries[index].font))
+    {
+        ++index;
+    }
+
+    if (MAX_FONTS <= index)
+    {
+        index = m_nextEntry;
+        build(m_entries[index], font);
+
+        m_nextEntry = (m_nextEntry + 1U) % MAX_FONTS;
+    }
+
+    return m_entries[index].advances;
+}
+
+uint16_t GlyphMetrics::getTextWidth(const GFXfont* font, const char* text, size_t length)
+{
+    uint16_t width = 0U;
+
+    if ((nullptr != font) &&
+        (nullptr != text))
+    {
+        const uint8_t*  advances    = getAdvances(font);
+        uint16_t        lineWidth   = 0U;
+        size_t          index       = 0U;
+
+        while((length > index) &&
+              ('\0' != text[index]))
+        {
+            if ('\n' == text[index])
+            {
+                if (width < lineWidth)
+                {
+                    width = lineWidth;
+                }
+
+                lineWidth = 0U;
+            }
+            else
+            {
+                lineWidth += advances[static_cast<uint8_t>(text[index])];
+            }
+
+            ++index;
+        }
+
+        if (width < lineWidth)
+        {
+            width = lineWidth;
+        }
+    }
+
+    return width;
+}
+
+void GlyphMetrics::clear()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_FONTS; ++index)
+    {
+        m_entries[index].font = nullptr;
+    }
+
+    m_nextEntry = 0U;
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void GlyphMetrics::build(Entry& entry, const GFXfont* font)
+{
+    uint16_t code = 0U;
+
+    for(code = 0U; code < CODES; ++code)
+    {
+        if ((font->first <= code) &&
+            (font->last >= code) &&
+            ('\n' != code) &&
+            ('\r' != code))
+        {
+            entry.advances[code] = font->glyph[code - font->first].xAdvance;
+        }
+        else
+        {
+            entry.advances[code] = 0U;
+        }
+    }
+
+    entry.font = font;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,168 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Glyph metrics cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __GLYPH_METRICS_H__
+#define __GLYPH_METRICS_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <gfxfont.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The glyph metrics cache provides the horizontal advance of every character
+ * of a font as plain table, indexed by the character code. It is built once
+ * per font, so measuring a text is just a table sum instead of looking up
+ * every glyph in the font.
+ *
+ * Note, it is not thread-safe, therefore it shall be used only by the task,
+ * which draws on the display.
+ */
+class GlyphMetrics
+{
+public:
+
+    /** Number of character codes in a advance table. */
+    static const uint16_t   CODES       = 256U;
+
+    /**
+     * Get the glyph metrics instance.
+     *
+     * @return Glyph metrics
+     */
+    static GlyphMetrics& getInstance()
+    {
+        static GlyphMetrics instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Get the advance table of a font. If its not in the cache yet, it will
+     * be built. The advance of characters, which are not available in the
+     * font, is 0. Line feed and carriage return have no advance too.
+     *
+     * @param[in] font  Font
+     *
+     * @return Advance table with CODES entries, indexed by the character code.
+     */
+    const uint8_t* getAdvances(const GFXfont* font);
+
+    /**
+     * Get the width of a text without text wrap around. If the text contains
+     * several lines, the width of the widest line is returned.
+     *
+     * @param[in] font      Font
+     * @param[in] text      Text
+     * @param[in] length    Max. number of characters, which to measure
+     *
+     * @return Text width in pixel
+     */
+    uint16_t getTextWidth(const GFXfont* font, const char* text, size_t length = SIZE_MAX);
+
+    /**
+     * Invalidate all cached advance tables.
+     */
+    void clear();
+
+private:
+
+    /** Number of fonts, whose advance table is cached. */
+    static const uint8_t    MAX_FONTS   = 4U;
+
+    /**
+     * The advance table of a font.
+     */
+    struct Entry
+    {
+        const GFXfont*  font;               /**< Font, the table belongs to. */
+        uint8_t         advances[CODES];    /**< Horizontal advance in pixel per character code */
+    };
+
+    Entry   m_entries[MAX_FONTS];   /**< Cached advance tables */
+    uint8_t m_nextEntry;            /**< Entry, which is replaced next. */
+
+    /**
+     * Constructs the glyph metrics cache.
+     */
+    GlyphMetrics() :
+        m_entries(),
+        m_nextEntry(0U)
+    {
+        clear();
+    }
+
+    /**
+     * Destroys the glyph metrics cache.
+     */
+    ~GlyphMetrics()
+    {
+    }
+
+    /* Prevent copying */
+    GlyphMetrics(const GlyphMetrics&);
+    GlyphMetrics& operator=(const GlyphMetrics&);
+
+    /**
+     * Build the advance table of a font.
+     *
+     * @param[out] entry    Cache entry, which to fill
+     * @param[in]  font     Font
+     */
+    static void build(Entry& entry, const GFXfont* font);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GLYPH_METRICS_H__ */
+
+/** @} */
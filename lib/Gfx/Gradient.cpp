@@ -0,0 +1,187 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Color gradient
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Gradient.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void Gradient::set(const Stop* stops, uint8_t count)
+{
+    uint16_t    position    = 0U;
+    uint8_t     index       = 0U;
+
+    if ((nullptr == stops) ||
+        (0U == count))
+    {
+        for(position = 0U; position < SIZE; ++position)
+        {
+            m_palette[position] = ColorDef::BLACK;
+        }
+
+        return;
+    }
+
+    for(position = 0U; position < SIZE; ++position)
+    {
+        /* Find the next stop behind the position. */
+        while((count > index) && (stops[index].position < position))
+        {
+            ++index;
+        }
+
+        /* Before the first stop or after the last stop? */
+        if (0U == index)
+        {
+            m_palette[position] = stops[0U].color;
+        }
+        else if (count <= index)
+        {
+            m_palette[position] = stops[count - 1U].color;
+        }
+        else
+        {
+            const Stop&     stop1   = stops[index - 1U];
+            const Stop&     stop2   = stops[index];
+            const uint16_t  RANGE   = stop2.position - stop1.position;
+            const uint16_t  WEIGHT  = ((position - stop1.position) * 256U) / RANGE;
+
+            m_palette[position] = Color(lerp(ColorDef::getRed(stop1.color), ColorDef::getRed(stop2.color), WEIGHT),
+                                        lerp(ColorDef::getGreen(stop1.color), ColorDef::getGreen(stop2.color), WEIGHT),
+                                        lerp(ColorDef::getBlue(stop1.color), ColorDef::getBlue(stop2.color), WEIGHT));
+        }
+    }
+
+    return;
+}
+
+void Gradient::fill(Color* colors, uint16_t length, uint8_t from, uint8_t to) const
+{
+    uint16_t    index       = 0U;
+    int32_t     position    = (static_cast<int32_t>(from) << 8U) + 128; /* Rounded */
+    int32_t     step        = 0;
+
+    if ((nullptr == colors) ||
+        (0U == length))
+    {
+        return;
+    }
+
+    /* A descending gradient has a negative step, which must not be shifted. */
+    if (1U < length)
+    {
+        step = ((static_cast<int32_t>(to) - static_cast<int32_t>(from)) * 256) / static_cast<int32_t>(length - 1U);
+    }
+
+    for(index = 0U; index < length; ++index)
+    {
+        colors[index]   = m_palette[static_cast<uint8_t>(position >> 8U)];
+        position        += step;
+    }
+
+    return;
+}
+
+void Gradient::writeSpan(IGfx& gfx, int16_t x, int16_t y, uint16_t length, uint8_t from, uint8_t to) const
+{
+    Color       colors[SPAN_LENGTH];
+    uint16_t    index       = 0U;
+    int32_t     position    = (static_cast<int32_t>(from) << 8U) + 128; /* Rounded */
+    int32_t     step        = 0;
+
+    /* A descending gradient has a negative step, which must not be shifted. */
+    if (1U < length)
+    {
+        step = ((static_cast<int32_t>(to) - static_cast<int32_t>(from)) * 256) / static_cast<int32_t>(length - 1U);
+    }
+
+    /* The span is written chunk by chunk, every chunk at once. */
+    for(index = 0U; index < length; index += SPAN_LENGTH)
+    {
+        uint16_t    chunkLength = length - index;
+        uint16_t    chunkIndex  = 0U;
+
+        if (SPAN_LENGTH < chunkLength)
+        {
+            chunkLength = SPAN_LENGTH;
+        }
+
+        for(chunkIndex = 0U; chunkIndex < chunkLength; ++chunkIndex)
+        {
+            colors[chunkIndex]  = m_palette[static_cast<uint8_t>(position >> 8U)];
+            position            += step;
+        }
+
+        gfx.writeSpan(x + index, y, colors, chunkLength);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,173 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Color gradient
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __GRADIENT_H__
+#define __GRADIENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+#include <Color.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A color gradient, which is defined by color stops. Between two stops the
+ * colors are interpolated linear. The gradient is precalculated once into a
+ * palette with one color per position, therefore filling a span is a
+ * table lookup per pixel.
+ */
+class Gradient
+{
+public:
+
+    /** Number of gradient positions. */
+    static const uint16_t   SIZE        = UINT8_MAX + 1U;
+
+    /** Max. number of pixels, which are calculated before they are written at once. */
+    static const uint16_t   SPAN_LENGTH = 32U;
+
+    /**
+     * A color stop of the gradient.
+     */
+    struct Stop
+    {
+        uint8_t     position;   /**< Position in the gradient [0; 255] */
+        uint32_t    color;      /**< Color in RGB888 format */
+    };
+
+    /**
+     * Constructs a black gradient.
+     */
+    Gradient() :
+        m_palette()
+    {
+    }
+
+    /**
+     * Destroys the gradient.
+     */
+    ~Gradient()
+    {
+    }
+
+    /**
+     * Set the color stops and calculate the palette.
+     * The stops must be sorted by position in ascending order. Before the
+     * first stop its color is used and after the last stop its color.
+     *
+     * @param[in] stops Color stops
+     * @param[in] count Number of color stops
+     */
+    void set(const Stop* stops, uint8_t count);
+
+    /**
+     * Get the color at a gradient position.
+     *
+     * @param[in] position  Gradient position
+     *
+     * @return Color
+     */
+    const Color& get(uint8_t position) const
+    {
+        return m_palette[position];
+    }
+
+    /**
+     * Fill colors with the gradient from the start position to the end
+     * position. The position is stepped in 8.8 fixed-point, so the
+     * gradient can be stretched or compressed over the length.
+     *
+     * @param[out] colors   Colors
+     * @param[in]  length   Number of colors
+     * @param[in]  from     Gradient position of the first color
+     * @param[in]  to       Gradient position of the last color
+     */
+    void fill(Color* colors, uint16_t length, uint8_t from, uint8_t to) const;
+
+    /**
+     * Write a horizontal span with the gradient from the start position to
+     * the end position.
+     *
+     * @param[in] gfx       Graphics interface
+     * @param[in] x         x-coordinate of the span start
+     * @param[in] y         y-coordinate
+     * @param[in] length    Span length in pixels
+     * @param[in] from      Gradient position of the first pixel
+     * @param[in] to        Gradient position of the last pixel
+     */
+    void writeSpan(IGfx& gfx, int16_t x, int16_t y, uint16_t length, uint8_t from, uint8_t to) const;
+
+private:
+
+    Color   m_palette[SIZE];    /**< Precalculated colors, one per position. */
+
+    Gradient(const Gradient& gradient);
+    Gradient& operator=(const Gradient& gradient);
+
+    /**
+     * Interpolate a single base color linear.
+     *
+     * @param[in] value1    Base color value at the start
+     * @param[in] value2    Base color value at the end
+     * @param[in] weight    Weight of the end value [0; 256]
+     *
+     * @return Interpolated base color value
+     */
+    static uint8_t lerp(uint8_t value1, uint8_t value2, uint16_t weight)
+    {
+        return static_cast<uint8_t>(((static_cast<uint16_t>(value1) * (256U - weight)) + (static_cast<uint16_t>(value2) * weight)) >> 8U);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GRADIENT_H__ */
+
+/** @} */
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <BaseGfx.hpp>
 #include <Color.h>
+#include <PixelKernel.h>
 #include <Print.h>
 
 /******************************************************************************
@@ -90,6 +91,151 @@ public:
         return 1U;
     }
 
+    /**
+     * Blend a single pixel with the background.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
+     * @param[in] ratio Blend ratio [0; 255] - 0: only background / 255: only pixel color
+     */
+    void blendPixel(int16_t x, int16_t y, const Color& color, uint8_t ratio)
+    {
+        x += m_originX;
+        y += m_originY;
+
+        if ((0U < ratio) &&
+            (true == isInsideClip(x, y)))
+        {
+            const uint32_t  BACKGROUND  = getColorUnchecked(x, y);
+            const uint32_t  FOREGROUND  = color;
+            uint32_t        mixed       = 0U;
+
+            PixelKernel::blend(&mixed, &BACKGROUND, &FOREGROUND, 1U, ratio);
+            drawPixelUnchecked(x, y, mixed);
+        }
+
+        return;
+    }
+
+    /**
+     * Draw an antialiased line (Xiaolin Wu). Every pixel along the major
+     * axis is split between the two nearest pixels of the minor axis,
+     * which are blended with the background.
+     * Horizontal, vertical and diagonal lines need no antialiasing and
+     * are drawn like drawLine() does.
+     *
+     * @param[in] xs    x-coordinate of start point
+     * @param[in] ys    y-coordinate of start point
+     * @param[in] xe    x-coordinate of end point
+     * @param[in] ye    y-coordinate of end point
+     * @param[in] color Color
+     */
+    void drawLineAntialiased(int16_t xs, int16_t ys, int16_t xe, int16_t ye, const Color& color)
+    {
+        const bool  IS_STEEP    = abs(ye - ys) > abs(xe - xs);
+        int32_t     gradient    = 0;
+        int32_t     intery      = 0;
+        int16_t     x           = 0;
+
+        if ((xs == xe) ||
+            (ys == ye) ||
+            (abs(xe - xs) == abs(ye - ys)))
+        {
+            drawLine(xs, ys, xe, ye, color);
+            return;
+        }
+
+        /* Walk along the major axis, from left to right. */
+        if (true == IS_STEEP)
+        {
+            swap(xs, ys);
+            swap(xe, ye);
+        }
+
+        if (xs > xe)
+        {
+            swap(xs, xe);
+            swap(ys, ye);
+        }
+
+        /* Minor axis position in 16.16 fixed point. */
+        gradient    = (static_cast<int32_t>(ye - ys) * 65536) / (xe - xs);
+        intery      = static_cast<int32_t>(ys) * 65536;
+
+        for(x = xs; x <= xe; ++x)
+        {
+            const int16_t   Y           = intery >> 16;
+            const uint8_t   FRACTION    = (intery >> 8) & 0xffU;
+
+            if (true == IS_STEEP)
+            {
+                blendPixel(Y, x, color, UINT8_MAX - FRACTION);
+                blendPixel(Y + 1, x, color, FRACTION);
+            }
+            else
+            {
+                blendPixel(x, Y, color, UINT8_MAX - FRACTION);
+                blendPixel(x, Y + 1, color, FRACTION);
+            }
+
+            intery += gradient;
+        }
+
+        return;
+    }
+
+    /**
+     * Draw an antialiased circle outline (Xiaolin Wu). Every pixel along
+     * the outline is split between the two nearest pixels in radial
+     * direction, which are blended with the background.
+     *
+     * @param[in] xc        x-coordinate of the center
+     * @param[in] yc        y-coordinate of the center
+     * @param[in] radius    Radius in pixel, limited to MAX_AA_RADIUS
+     * @param[in] color     Color
+     */
+    void drawCircleAntialiased(int16_t xc, int16_t yc, uint16_t radius, const Color& color)
+    {
+        const uint32_t  RADIUS_SQUARE   = static_cast<uint32_t>(radius) * radius;
+        int16_t         x               = 0;
+        int16_t         y               = radius;
+
+        if (MAX_AA_RADIUS < radius)
+        {
+            return;
+        }
+
+        if (0U == radius)
+        {
+            drawPixel(xc, yc, color);
+            return;
+        }
+
+        /* Walk along the second octant and mirror it to the others. */
+        while(x <= y)
+        {
+            /* Exact y-coordinate in 8.8 fixed point. */
+            const uint32_t  Y_FIXED     = sqrtInt((RADIUS_SQUARE - static_cast<uint32_t>(x) * x) << 16U);
+            const uint8_t   FRACTION    = Y_FIXED & 0xffU;
+
+            y = Y_FIXED >> 8U;
+
+            if (x <= y)
+            {
+                blendCirclePoints(xc, yc, x, y, color, UINT8_MAX - FRACTION);
+                blendCirclePoints(xc, yc, x, y + 1, color, FRACTION);
+            }
+
+            ++x;
+        }
+
+        return;
+    }
+
+    /** Max. radius of an antialiased circle in pixel */
+    static const uint16_t MAX_AA_RADIUS = 255U;
+
 protected:
 
     /**
@@ -107,6 +253,93 @@ private:
 
     /* Default constructor not allowed. */
     IGfx();
+
+    /**
+     * Swap two coordinates.
+     *
+     * @param[in,out] a First coordinate
+     * @param[in,out] b Second coordinate
+     */
+    static void swap(int16_t& a, int16_t& b)
+    {
+        const int16_t TMP = a;
+
+        a = b;
+        b = TMP;
+    }
+
+    /**
+     * Calculate the integer square root.
+     *
+     * @param[in] value Value
+     *
+     * @return Square root, rounded down.
+     */
+    static uint32_t sqrtInt(uint32_t value)
+    {
+        uint32_t result = 0U;
+        uint32_t bit    = 1UL << 30U;
+
+        while(bit > value)
+        {
+            bit >>= 2U;
+        }
+
+        while(0U != bit)
+        {
+            if (value >= (result + bit))
+            {
+                value  -= result + bit;
+                result  = (result >> 1U) + bit;
+            }
+            else
+            {
+                result >>= 1U;
+            }
+
+            bit >>= 2U;
+        }
+
+        return result;
+    }
+
+    /**
+     * Blend the point of the second circle octant and all its mirrored
+     * points in the other octants. Points on the axes and the diagonals
+     * are blended only once.
+     *
+     * @param[in] xc    x-coordinate of the center
+     * @param[in] yc    y-coordinate of the center
+     * @param[in] x     x-offset in the second octant
+     * @param[in] y     y-offset in the second octant
+     * @param[in] color Color
+     * @param[in] ratio Blend ratio [0; 255]
+     */
+    void blendCirclePoints(int16_t xc, int16_t yc, int16_t x, int16_t y, const Color& color, uint8_t ratio)
+    {
+        if (0 == x)
+        {
+            blendPixel(xc, yc + y, color, ratio);
+            blendPixel(xc, yc - y, color, ratio);
+            blendPixel(xc + y, yc, color, ratio);
+            blendPixel(xc - y, yc, color, ratio);
+        }
+        else
+        {
+            blendPixel(xc + x, yc + y, color, ratio);
+            blendPixel(xc - x, yc + y, color, ratio);
+            blendPixel(xc + x, yc - y, color, ratio);
+            blendPixel(xc - x, yc - y, color, ratio);
+
+            if (x != y)
+            {
+                blendPixel(xc + y, yc + x, color, ratio);
+                blendPixel(xc - y, yc + x, color, ratio);
+                blendPixel(xc + y, yc - x, color, ratio);
+                blendPixel(xc - y, yc - x, color, ratio);
+            }
+        }
+    }
 };
 
 /******************************************************************************
@@ -0,0 +1,336 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Shared image cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ImageCache.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+const IndexedImage* ImageCache::acquire(const String& name)
+{
+    const IndexedImage* image   = nullptr;
+    uint8_t             index   = 0U;
+
+    lock();
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        Entry& entry = m_entries[index];
+
+        if ((nullptr != entry.image) &&
+            (0U < name.length()) &&
+            (name == entry.name) &&
+            (UINT8_MAX > entry.refCount))
+        {
+            ++entry.refCount;
+            ++m_usageCounter;
+            entry.lastUsage = m_usageCounter;
+
+            image = entry.image;
+            break;
+        }
+    }
+
+    unlock();
+
+    return image;
+}
+
+bool ImageCache::add(const String& name, IndexedImage* image)
+{
+    bool    status  = false;
+    Entry*  victim  = nullptr;
+    uint8_t index   = 0U;
+
+    if ((nullptr != image) &&
+        (0U < name.length()))
+    {
+        lock();
+
+        /* Use a free entry or the least recently used one, which is not used anymore. */
+        for(index = 0U; index < MAX_ENTRIES; ++index)
+        {
+            Entry& entry = m_entries[index];
+
+            if (nullptr == entry.image)
+            {
+                victim = &entry;
+                break;
+            }
+            else if ((0U == entry.refCount) &&
+                     ((nullptr == victim) || (victim->lastUsage > entry.lastUsage)))
+            {
+                victim = &entry;
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        if (nullptr != victim)
+        {
+            /* An older image with the same name is not provided anymore. */
+            for(index = 0U; index < MAX_ENTRIES; ++index)
+            {
+                if (name == m_entries[index].name)
+                {
+                    m_entries[index].name = "";
+
+                    if (0U == m_entries[index].refCount)
+                    {
+                        freeEntry(m_entries[index]);
+                    }
+                }
+            }
+
+            freeEntry(*victim);
+
+            ++m_usageCounter;
+            victim->name        = name;
+            victim->image       = image;
+            victim->refCount    = 1U;
+            victim->lastUsage   = m_usageCounter;
+
+            status = true;
+        }
+
+        unlock();
+    }
+
+    return status;
+}
+
+bool ImageCache::addRef(const IndexedImage* image)
+{
+    bool    status  = false;
+    uint8_t index   = 0U;
+
+    if (nullptr != image)
+    {
+        lock();
+
+        for(index = 0U; index < MAX_ENTRIES; ++index)
+        {
+            Entry& entry = m_entries[index];
+
+            if ((image == entry.image) &&
+                (UINT8_MAX > entry.refCount))
+            {
+                ++entry.refCount;
+                status = true;
+                break;
+            }
+        }
+
+        unlock();
+    }
+
+    return status;
+}
+
+void ImageCache::release(const IndexedImage* image)
+{
+    uint8_t index = 0U;
+
+    if (nullptr != image)
+    {
+        lock();
+
+        for(index = 0U; index < MAX_ENTRIES; ++index)
+        {
+            Entry& entry = m_entries[index];
+
+            if ((image == entry.image) &&
+                (0U < entry.refCount))
+            {
+                --entry.refCount;
+
+                /* A invalidated image can't be used anymore. */
+                if ((0U == entry.refCount) &&
+                    (0U == entry.name.length()))
+                {
+                    freeEntry(entry);
+                }
+
+                break;
+            }
+        }
+
+        unlock();
+    }
+
+    return;
+}
+
+void ImageCache::invalidate(const String& name)
+{
+    uint8_t index = 0U;
+
+    lock();
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        Entry& entry = m_entries[index];
+
+        if ((nullptr != entry.image) &&
+            (name == entry.name))
+        {
+            entry.name = "";
+
+            if (0U == entry.refCount)
+            {
+                freeEntry(entry);
+            }
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void ImageCache::clear()
+{
+    uint8_t index = 0U;
+
+    lock();
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        if (0U == m_entries[index].refCount)
+        {
+            freeEntry(m_entries[index]);
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ImageCache::~ImageCache()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        freeEntry(m_entries[index]);
+    }
+
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+#endif  /* NATIVE */
+}
+
+void ImageCache::freeEntry(Entry& entry)
+{
+    if (nullptr != entry.image)
+    {
+        delete entry.image;
+        entry.image = nullptr;
+    }
+
+    entry.name      = "";
+    entry.refCount  = 0U;
+    entry.lastUsage = 0U;
+
+    return;
+}
+
+void ImageCache::lock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
+void ImageCache::unlock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGive(m_xMutex);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
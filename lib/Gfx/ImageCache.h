@@ -0,0 +1,215 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Shared image cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __IMAGE_CACHE_H__
+#define __IMAGE_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <IndexedImage.h>
+
+#ifndef NATIVE
+#include <Arduino.h>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The image cache keeps decoded images, identified by their filename.
+ * Several users of the same image share one decoded copy, which is
+ * reference counted. An image, which is not used anymore, stays in the
+ * cache until its entry is needed for another image. This way a image,
+ * which is loaded again shortly after, don't need to be decoded again.
+ *
+ * The images are palette indexed to keep the memory footprint low.
+ */
+class ImageCache
+{
+public:
+
+    /**
+     * Get the image cache instance.
+     *
+     * @return Image cache
+     */
+    static ImageCache& getInstance()
+    {
+        static ImageCache instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Get a image from the cache and increase its reference counter.
+     *
+     * @param[in]  name     Image name, e.g. the filename
+     *
+     * @return If the image is not cached, it will return nullptr otherwise the image.
+     */
+    const IndexedImage* acquire(const String& name);
+
+    /**
+     * Add a image to the cache. The cache takes over the ownership
+     * and the reference counter is set to 1.
+     * If there is no free entry, the ownership stays at the caller.
+     *
+     * @param[in] name      Image name, e.g. the filename
+     * @param[in] image     Image, allocated with new
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool add(const String& name, IndexedImage* image);
+
+    /**
+     * Increase the reference counter of a cached image.
+     *
+     * @param[in] image Image
+     *
+     * @return If the image is cached, it will return true otherwise false.
+     */
+    bool addRef(const IndexedImage* image);
+
+    /**
+     * Decrease the reference counter of a cached image.
+     *
+     * @param[in] image Image
+     */
+    void release(const IndexedImage* image);
+
+    /**
+     * Forget a image, e.g. because its file was changed. Users of the image
+     * keep it until they release it, but it won't be provided anymore.
+     *
+     * @param[in] name  Image name, e.g. the filename
+     */
+    void invalidate(const String& name);
+
+    /**
+     * Free all images, which are not used anymore.
+     */
+    void clear();
+
+    /** Max. number of cached images */
+    static const uint8_t    MAX_ENTRIES = 16U;
+
+private:
+
+    /**
+     * A cached image.
+     */
+    struct Entry
+    {
+        String          name;       /**< Image name, empty if invalidated */
+        IndexedImage*   image;      /**< Image, nullptr if entry is free */
+        uint8_t         refCount;   /**< Number of users */
+        uint32_t        lastUsage;  /**< Usage counter value of the last usage */
+    };
+
+    Entry       m_entries[MAX_ENTRIES]; /**< Cached images */
+    uint32_t    m_usageCounter;         /**< Incremented for every usage, to find the least recently used entry. */
+
+#ifndef NATIVE
+    SemaphoreHandle_t   m_xMutex;       /**< Mutex to protect against concurrent access. */
+#endif  /* NATIVE */
+
+    /**
+     * Constructs the image cache.
+     */
+    ImageCache() :
+        m_entries(),
+        m_usageCounter(0U)
+#ifndef NATIVE
+        ,
+        m_xMutex(xSemaphoreCreateMutex())
+#endif  /* NATIVE */
+    {
+        uint8_t index = 0U;
+
+        for(index = 0U; index < MAX_ENTRIES; ++index)
+        {
+            m_entries[index].image      = nullptr;
+            m_entries[index].refCount   = 0U;
+            m_entries[index].lastUsage  = 0U;
+        }
+    }
+
+    /**
+     * Destroys the image cache.
+     */
+    ~ImageCache();
+
+    /* Prevent copying */
+    ImageCache(const ImageCache&);
+    ImageCache& operator=(const ImageCache&);
+
+    /**
+     * Free the image of a entry.
+     *
+     * @param[in] entry Cache entry
+     */
+    static void freeEntry(Entry& entry);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock();
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __IMAGE_CACHE_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,390 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming image encoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ImageEncoder.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static inline void writeLe16(uint8_t* buffer, uint16_t value);
+static inline void writeLe32(uint8_t* buffer, uint32_t value);
+static inline void writeBe32(uint8_t* buffer, uint32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** PNG signature, IHDR chunk header and the fixed IHDR fields, see constructor. */
+static const uint8_t    PNG_SIGNATURE[]     = { 0x89U, 'P', 'N', 'G', 0x0dU, 0x0aU, 0x1aU, 0x0aU };
+
+/** PNG IEND chunk, incl. its CRC. */
+static const uint8_t    PNG_IEND[]          = { 0x00U, 0x00U, 0x00U, 0x00U, 'I', 'E', 'N', 'D', 0xaeU, 0x42U, 0x60U, 0x82U };
+
+/** Adler-32 modulus */
+static const uint32_t   ADLER_MOD           = 65521U;
+
+/** Number of bytes per pixel. */
+static const size_t     BYTES_PER_PIXEL     = 3U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ImageEncoder::ImageEncoder(Format format, const uint32_t* frame, uint16_t width, uint16_t height, uint8_t scale) :
+    m_format(format),
+    m_frame(frame),
+    m_frameWidth(width),
+    m_scale(scale),
+    m_width(static_cast<uint32_t>(width) * scale),
+    m_height(static_cast<uint32_t>(height) * scale),
+    m_rowSize(0U),
+    m_dataSize(0U),
+    m_size(0U),
+    m_pos(0U),
+    m_header(),
+    m_headerSize(0U),
+    m_rawPos(0U),
+    m_rawSize(0U),
+    m_blockRemaining(0U),
+    m_blockHeader(),
+    m_blockHeaderPos(sizeof(m_blockHeader)),
+    m_crc(0xffffffffU),
+    m_adlerA(1U),
+    m_adlerB(0U),
+    m_trailer()
+{
+    if ((nullptr == frame) ||
+        (0U == m_width) ||
+        (0U == m_height))
+    {
+        /* Nothing to encode, the image is empty. */
+        ;
+    }
+    else if (FORMAT_BMP == m_format)
+    {
+        /* Rows are padded to a multiple of 4 bytes. */
+        m_rowSize       = (BYTES_PER_PIXEL * m_width + 3U) & ~static_cast<size_t>(3U);
+        m_dataSize      = m_rowSize * m_height;
+        m_headerSize    = BMP_HEADER_SIZE;
+        m_size          = m_headerSize + m_dataSize;
+
+        /* File header */
+        m_header[0] = 'B';
+        m_header[1] = 'M';
+        writeLe32(&m_header[2], m_size);
+        writeLe32(&m_header[6], 0U);
+        writeLe32(&m_header[10], BMP_HEADER_SIZE);
+
+        /* Info header, a positive height means bottom-up rows. */
+        writeLe32(&m_header[14], 40U);
+        writeLe32(&m_header[18], m_width);
+        writeLe32(&m_header[22], m_height);
+        writeLe16(&m_header[26], 1U);   /* Planes */
+        writeLe16(&m_header[28], 24U);  /* Bits per pixel */
+        writeLe32(&m_header[30], 0U);   /* No compression */
+        writeLe32(&m_header[34], m_dataSize);
+        writeLe32(&m_header[38], 2835U); /* 72 dpi */
+        writeLe32(&m_header[42], 2835U);
+        writeLe32(&m_header[46], 0U);
+        writeLe32(&m_header[50], 0U);
+    }
+    else
+    {
+        const size_t    BLOCK_HEADER_SIZE   = sizeof(m_blockHeader);
+        const size_t    ZLIB_HEADER_SIZE    = 2U;
+        const size_t    ADLER_SIZE          = 4U;
+        uint32_t        crc                 = 0xffffffffU;
+        size_t          blocks              = 0U;
+        size_t          index               = 0U;
+
+        /* Every row starts with the filter type. */
+        m_rowSize       = 1U + BYTES_PER_PIXEL * m_width;
+        m_rawSize       = m_rowSize * m_height;
+        blocks          = (m_rawSize + MAX_BLOCK_SIZE - 1U) / MAX_BLOCK_SIZE;
+        m_dataSize      = blocks * BLOCK_HEADER_SIZE + m_rawSize;
+        m_headerSize    = PNG_HEADER_SIZE;
+        m_size          = m_headerSize + m_dataSize + sizeof(m_trailer);
+
+        memcpy(&m_header[0], PNG_SIGNATURE, sizeof(PNG_SIGNATURE));
+
+        /* IHDR chunk: 8 bit per channel, truecolor, no interlace */
+        writeBe32(&m_header[8], 13U);
+        m_header[12] = 'I';
+        m_header[13] = 'H';
+        m_header[14] = 'D';
+        m_header[15] = 'R';
+        writeBe32(&m_header[16], m_width);
+        writeBe32(&m_header[20], m_height);
+        m_header[24] = 8U;
+        m_header[25] = 2U;
+        m_header[26] = 0U;
+        m_header[27] = 0U;
+        m_header[28] = 0U;
+
+        for(index = 12U; index < 29U; ++index)
+        {
+            crc = updateCrc(crc, m_header[index]);
+        }
+
+        writeBe32(&m_header[29], ~crc);
+
+        /* IDAT chunk with the zlib stream. Its CRC is calculated during reading. */
+        writeBe32(&m_header[33], ZLIB_HEADER_SIZE + m_dataSize + ADLER_SIZE);
+        m_header[37] = 'I';
+        m_header[38] = 'D';
+        m_header[39] = 'A';
+        m_header[40] = 'T';
+        m_header[41] = 0x78U;   /* Deflate, 32K window */
+        m_header[42] = 0x01U;   /* No preset dictionary, lowest compression level */
+
+        for(index = 37U; index < PNG_HEADER_SIZE; ++index)
+        {
+            m_crc = updateCrc(m_crc, m_header[index]);
+        }
+
+        startBlock();
+    }
+}
+
+size_t ImageEncoder::read(uint8_t* buffer, size_t size)
+{
+    size_t count = 0U;
+
+    if (nullptr == buffer)
+    {
+        return 0U;
+    }
+
+    while((size > count) && (m_size > m_pos))
+    {
+        if (m_headerSize > m_pos)
+        {
+            buffer[count] = m_header[m_pos];
+        }
+        else if ((m_headerSize + m_dataSize) > m_pos)
+        {
+            if (FORMAT_BMP == m_format)
+            {
+                buffer[count] = getBmpData(m_pos - m_headerSize);
+            }
+            else
+            {
+                buffer[count] = getPngData();
+            }
+        }
+        else
+        {
+            buffer[count] = m_trailer[m_pos - m_headerSize - m_dataSize];
+        }
+
+        ++count;
+        ++m_pos;
+    }
+
+    return count;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint8_t ImageEncoder::getBmpData(size_t dataPos) const
+{
+    uint8_t value   = 0U;
+    size_t  row     = dataPos / m_rowSize;
+    size_t  column  = dataPos % m_rowSize;
+
+    /* Skip the padding. The channel order is blue, green, red. */
+    if ((BYTES_PER_PIXEL * m_width) > column)
+    {
+        value = getChannel(column / BYTES_PER_PIXEL, m_height - 1U - row, 8U * (column % BYTES_PER_PIXEL));
+    }
+
+    return value;
+}
+
+uint8_t ImageEncoder::getPngData()
+{
+    uint8_t value = 0U;
+
+    if (sizeof(m_blockHeader) > m_blockHeaderPos)
+    {
+        value = m_blockHeader[m_blockHeaderPos];
+        ++m_blockHeaderPos;
+    }
+    else
+    {
+        size_t  row     = m_rawPos / m_rowSize;
+        size_t  column  = m_rawPos % m_rowSize;
+
+        /* The first byte of a row is the filter type none. The channel order is red, green, blue. */
+        if (0U < column)
+        {
+            --column;
+            value = getChannel(column / BYTES_PER_PIXEL, row, 16U - 8U * (column % BYTES_PER_PIXEL));
+        }
+
+        m_adlerA = (m_adlerA + value) % ADLER_MOD;
+        m_adlerB = (m_adlerB + m_adlerA) % ADLER_MOD;
+
+        ++m_rawPos;
+        --m_blockRemaining;
+    }
+
+    m_crc = updateCrc(m_crc, value);
+
+    if ((sizeof(m_blockHeader) <= m_blockHeaderPos) &&
+        (0U == m_blockRemaining))
+    {
+        if (m_rawSize > m_rawPos)
+        {
+            startBlock();
+        }
+        else
+        {
+            finishPng();
+        }
+    }
+
+    return value;
+}
+
+void ImageEncoder::startBlock()
+{
+    size_t      remaining   = m_rawSize - m_rawPos;
+    uint16_t    length      = (MAX_BLOCK_SIZE < remaining) ? MAX_BLOCK_SIZE : static_cast<uint16_t>(remaining);
+
+    /* Stored block, the last one has the final flag. */
+    m_blockHeader[0]    = (length == remaining) ? 1U : 0U;
+    writeLe16(&m_blockHeader[1], length);
+    writeLe16(&m_blockHeader[3], ~length);
+    m_blockHeaderPos    = 0U;
+    m_blockRemaining    = length;
+}
+
+void ImageEncoder::finishPng()
+{
+    size_t index = 0U;
+
+    writeBe32(&m_trailer[0], (m_adlerB << 16U) | m_adlerA);
+
+    for(index = 0U; index < 4U; ++index)
+    {
+        m_crc = updateCrc(m_crc, m_trailer[index]);
+    }
+
+    writeBe32(&m_trailer[4], ~m_crc);
+    memcpy(&m_trailer[8], PNG_IEND, sizeof(PNG_IEND));
+}
+
+uint32_t ImageEncoder::updateCrc(uint32_t crc, uint8_t value)
+{
+    uint8_t bit = 0U;
+
+    crc ^= value;
+
+    for(bit = 0U; bit < 8U; ++bit)
+    {
+        crc = (crc >> 1U) ^ (0xedb88320U & (0U - (crc & 1U)));
+    }
+
+    return crc;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a 16-bit value in little endian.
+ *
+ * @param[out] buffer   Buffer
+ * @param[in]  value    Value
+ */
+static inline void writeLe16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 0U);
+    buffer[1] = static_cast<uint8_t>(value >> 8U);
+}
+
+/**
+ * Write a 32-bit value in little endian.
+ *
+ * @param[out] buffer   Buffer
+ * @param[in]  value    Value
+ */
+static inline void writeLe32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 0U);
+    buffer[1] = static_cast<uint8_t>(value >> 8U);
+    buffer[2] = static_cast<uint8_t>(value >> 16U);
+    buffer[3] = static_cast<uint8_t>(value >> 24U);
+}
+
+/**
+ * Write a 32-bit value in big endian.
+ *
+ * @param[out] buffer   Buffer
+ * @param[in]  value    Value
+ */
+static inline void writeBe32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 24U);
+    buffer[1] = static_cast<uint8_t>(value >> 16U);
+    buffer[2] = static_cast<uint8_t>(value >> 8U);
+    buffer[3] = static_cast<uint8_t>(value >> 0U);
+}
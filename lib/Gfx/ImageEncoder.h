@@ -0,0 +1,222 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming image encoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __IMAGE_ENCODER_H__
+#define __IMAGE_ENCODER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Encodes a frame in RGB888 format (0x00RRGGBB, row by row) as 24-bit BMP
+ * or as uncompressed PNG, optionally upscaled by an integer factor.
+ *
+ * The image is produced piece by piece with read(), directly from the frame.
+ * There is no intermediate buffer for the whole image, therefore the frame
+ * must stay valid until the image is completely read. The image size is
+ * known in advance, see getSize().
+ *
+ * The PNG image data is a zlib stream with stored (not compressed) deflate
+ * blocks, each row with filter type none.
+ */
+class ImageEncoder
+{
+public:
+
+    /** Supported image formats */
+    enum Format
+    {
+        FORMAT_BMP = 0, /**< Windows bitmap, 24 bit per pixel */
+        FORMAT_PNG      /**< Portable network graphics, truecolor 8 bit per channel */
+    };
+
+    /**
+     * Constructs the encoder.
+     *
+     * @param[in] format    Image format
+     * @param[in] frame     Frame in RGB888 format
+     * @param[in] width     Frame width in pixel
+     * @param[in] height    Frame height in pixel
+     * @param[in] scale     Upscale factor, at least 1.
+     */
+    ImageEncoder(Format format, const uint32_t* frame, uint16_t width, uint16_t height, uint8_t scale);
+
+    /**
+     * Destroys the encoder.
+     */
+    ~ImageEncoder()
+    {
+    }
+
+    /**
+     * Get the image size.
+     *
+     * @return Image size in bytes
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Is the image completely read?
+     *
+     * @return If completely read, it will return true otherwise false.
+     */
+    bool isFinished() const
+    {
+        return (m_size <= m_pos);
+    }
+
+    /**
+     * Read the next part of the image.
+     *
+     * @param[out] buffer   Buffer
+     * @param[in]  size     Buffer size in bytes
+     *
+     * @return Number of bytes written to the buffer. If the image is completely read, it will return 0.
+     */
+    size_t read(uint8_t* buffer, size_t size);
+
+    /** BMP file and info header size in bytes. */
+    static const size_t     BMP_HEADER_SIZE     = 54U;
+
+    /** PNG signature, IHDR chunk, IDAT chunk header and zlib header size in bytes. */
+    static const size_t     PNG_HEADER_SIZE     = 43U;
+
+    /** Max. size of a stored deflate block in bytes. */
+    static const uint16_t   MAX_BLOCK_SIZE      = 65535U;
+
+private:
+
+    Format          m_format;                           /**< Image format */
+    const uint32_t* m_frame;                            /**< Frame in RGB888 format */
+    uint16_t        m_frameWidth;                       /**< Frame width in pixel */
+    uint8_t         m_scale;                            /**< Upscale factor */
+    uint32_t        m_width;                            /**< Image width in pixel */
+    uint32_t        m_height;                           /**< Image height in pixel */
+    size_t          m_rowSize;                          /**< Size of a image row in bytes, incl. padding or filter type. */
+    size_t          m_dataSize;                         /**< Size of the image data in bytes, without header and trailer. */
+    size_t          m_size;                             /**< Image size in bytes */
+    size_t          m_pos;                              /**< Read position in bytes */
+    uint8_t         m_header[BMP_HEADER_SIZE];          /**< Image header */
+    size_t          m_headerSize;                       /**< Image header size in bytes */
+    size_t          m_rawPos;                           /**< Position in the PNG raw image data (filter type and pixels) */
+    size_t          m_rawSize;                          /**< Size of the PNG raw image data in bytes */
+    size_t          m_blockRemaining;                   /**< Remaining raw bytes in the current deflate block. */
+    uint8_t         m_blockHeader[5U];                  /**< Current deflate block header */
+    uint8_t         m_blockHeaderPos;                   /**< Read position in the current deflate block header */
+    uint32_t        m_crc;                              /**< CRC-32 of the PNG IDAT chunk */
+    uint32_t        m_adlerA;                           /**< Adler-32 sum A of the PNG raw image data */
+    uint32_t        m_adlerB;                           /**< Adler-32 sum B of the PNG raw image data */
+    uint8_t         m_trailer[20U];                     /**< PNG trailer: Adler-32, IDAT CRC and IEND chunk */
+
+    ImageEncoder();
+    ImageEncoder(const ImageEncoder& encoder);
+    ImageEncoder& operator=(const ImageEncoder& encoder);
+
+    /**
+     * Get a color channel of an image pixel.
+     *
+     * @param[in] x         Image x-coordinate
+     * @param[in] y         Image y-coordinate
+     * @param[in] shift     Bit position of the color channel in RGB888
+     *
+     * @return Color channel value
+     */
+    uint8_t getChannel(uint32_t x, uint32_t y, uint8_t shift) const
+    {
+        return static_cast<uint8_t>(m_frame[(y / m_scale) * m_frameWidth + (x / m_scale)] >> shift);
+    }
+
+    /**
+     * Get the next byte of the BMP pixel data.
+     *
+     * @param[in] dataPos   Position in the pixel data
+     *
+     * @return Byte
+     */
+    uint8_t getBmpData(size_t dataPos) const;
+
+    /**
+     * Get the next byte of the PNG image data (deflate block headers and raw image data).
+     *
+     * @return Byte
+     */
+    uint8_t getPngData();
+
+    /**
+     * Start the next stored deflate block.
+     */
+    void startBlock();
+
+    /**
+     * Prepare the PNG trailer.
+     */
+    void finishPng();
+
+    /**
+     * Update the CRC-32 with a byte.
+     *
+     * @param[in] crc   Current CRC-32, without final xor.
+     * @param[in] value Byte
+     *
+     * @return Updated CRC-32
+     */
+    static uint32_t updateCrc(uint32_t crc, uint8_t value);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __IMAGE_ENCODER_H__ */
+
+/** @} */
@@ -0,0 +1,316 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Palette indexed image
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IndexedImage.h"
+#include <MemPolicy.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isSameColor(const Color& color1, const Color& color2);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool IndexedImage::set(const Color* bitmap, uint16_t width, uint16_t height)
+{
+    bool status = false;
+
+    if ((nullptr != bitmap) &&
+        (0U < width) &&
+        (0U < height))
+    {
+        const size_t    PIXEL_COUNT = static_cast<size_t>(width) * height;
+        Color*          palette     = MemPolicy::allocateArray<Color>(MemPolicy::REGION_LARGE, MAX_PALETTE_SIZE);
+        uint8_t*        pixels      = MemPolicy::allocateArray<uint8_t>(MemPolicy::REGION_LARGE, PIXEL_COUNT);
+        uint16_t        paletteSize = 0U;
+
+        /* Build the palette and map every pixel to its index first. */
+        if ((nullptr != palette) &&
+            (nullptr != pixels))
+        {
+            size_t pixelIndex = 0U;
+
+            status = true;
+
+            for(pixelIndex = 0U; (true == status) && (PIXEL_COUNT > pixelIndex); ++pixelIndex)
+            {
+                uint16_t paletteIndex = 0U;
+
+                while((paletteSize > paletteIndex) &&
+                      (false == isSameColor(palette[paletteIndex], bitmap[pixelIndex])))
+                {
+                    ++paletteIndex;
+                }
+
+                if (paletteSize == paletteIndex)
+                {
+                    if (MAX_PALETTE_SIZE <= paletteSize)
+                    {
+                        status = false;
+                    }
+                    else
+                    {
+                        palette[paletteIndex] = bitmap[pixelIndex];
+                        ++paletteSize;
+                    }
+                }
+
+                pixels[pixelIndex] = static_cast<uint8_t>(paletteIndex);
+            }
+        }
+
+        /* Keep only the used part of the palette and pack the indices. */
+        if (true == status)
+        {
+            const uint8_t   BITS_PER_PIXEL  = (MAX_PALETTE_SIZE_4BPP >= paletteSize) ? 4U : 8U;
+            const size_t    ROW_SIZE        = (static_cast<size_t>(width) * BITS_PER_PIXEL + 7U) / 8U;
+            Color*          usedPalette     = MemPolicy::allocateArray<Color>(MemPolicy::REGION_LARGE, paletteSize);
+            uint8_t*        indices         = MemPolicy::allocateArray<uint8_t>(MemPolicy::REGION_LARGE, ROW_SIZE * height);
+
+            if ((nullptr == usedPalette) ||
+                (nullptr == indices))
+            {
+                MemPolicy::releaseArray(usedPalette, paletteSize);
+                MemPolicy::releaseArray(indices, ROW_SIZE * height);
+                status = false;
+            }
+            else
+            {
+                uint16_t paletteIndex = 0U;
+                uint16_t y            = 0U;
+
+                for(paletteIndex = 0U; paletteIndex < paletteSize; ++paletteIndex)
+                {
+                    usedPalette[paletteIndex] = palette[paletteIndex];
+                }
+
+                for(y = 0U; y < height; ++y)
+                {
+                    const uint8_t*  pixelRow    = &pixels[static_cast<size_t>(y) * width];
+                    uint8_t*        indexRow    = &indices[y * ROW_SIZE];
+                    uint16_t        x           = 0U;
+
+                    if (4U == BITS_PER_PIXEL)
+                    {
+                        for(x = 0U; x < width; ++x)
+                        {
+                            if (0U == (x & 1U))
+                            {
+                                indexRow[x >> 1U] = static_cast<uint8_t>(pixelRow[x] << 4U);
+                            }
+                            else
+                            {
+                                indexRow[x >> 1U] |= pixelRow[x];
+                            }
+                        }
+                    }
+                    else
+                    {
+                        for(x = 0U; x < width; ++x)
+                        {
+                            indexRow[x] = pixelRow[x];
+                        }
+                    }
+                }
+
+                release();
+
+                m_palette       = usedPalette;
+                m_paletteSize   = paletteSize;
+                m_indices       = indices;
+                m_rowSize       = ROW_SIZE;
+                m_width         = width;
+                m_height        = height;
+                m_bitsPerPixel  = BITS_PER_PIXEL;
+            }
+        }
+
+        MemPolicy::releaseArray(palette, MAX_PALETTE_SIZE);
+        MemPolicy::releaseArray(pixels, PIXEL_COUNT);
+    }
+
+    return status;
+}
+
+void IndexedImage::release()
+{
+    MemPolicy::releaseArray(m_palette, m_paletteSize);
+    m_palette = nullptr;
+
+    MemPolicy::releaseArray(m_indices, m_rowSize * m_height);
+    m_indices = nullptr;
+
+    m_paletteSize   = 0U;
+    m_rowSize       = 0U;
+    m_width         = 0U;
+    m_height        = 0U;
+    m_bitsPerPixel  = 0U;
+
+    return;
+}
+
+void IndexedImage::draw(IGfx& gfx, int16_t x, int16_t y, uint16_t srcX, uint16_t width) const
+{
+    if ((nullptr != m_indices) &&
+        (m_width > srcX))
+    {
+        Color       span[SPAN_SIZE];
+        uint16_t    row = 0U;
+
+        if ((m_width - srcX) < width)
+        {
+            width = m_width - srcX;
+        }
+
+        for(row = 0U; row < m_height; ++row)
+        {
+            const uint8_t*  indexRow    = &m_indices[row * m_rowSize];
+            uint16_t        offset      = 0U;
+
+            while(width > offset)
+            {
+                uint16_t length = width - offset;
+                uint16_t index  = 0U;
+
+                if (SPAN_SIZE < length)
+                {
+                    length = SPAN_SIZE;
+                }
+
+                for(index = 0U; index < length; ++index)
+                {
+                    span[index] = m_palette[getIndex(indexRow, srcX + offset + index)];
+                }
+
+                gfx.writeSpan(x + offset, y + row, span, length);
+                offset += length;
+            }
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void IndexedImage::copy(const IndexedImage& image)
+{
+    if (nullptr != image.m_indices)
+    {
+        const size_t    INDICES_SIZE    = image.m_rowSize * image.m_height;
+        Color*          palette         = MemPolicy::allocateArray<Color>(MemPolicy::REGION_LARGE, image.m_paletteSize);
+        uint8_t*        indices         = MemPolicy::allocateArray<uint8_t>(MemPolicy::REGION_LARGE, INDICES_SIZE);
+
+        if ((nullptr == palette) ||
+            (nullptr == indices))
+        {
+            MemPolicy::releaseArray(palette, image.m_paletteSize);
+            MemPolicy::releaseArray(indices, INDICES_SIZE);
+        }
+        else
+        {
+            uint16_t    paletteIndex    = 0U;
+            size_t      index           = 0U;
+
+            for(paletteIndex = 0U; paletteIndex < image.m_paletteSize; ++paletteIndex)
+            {
+                palette[paletteIndex] = image.m_palette[paletteIndex];
+            }
+
+            for(index = 0U; index < INDICES_SIZE; ++index)
+            {
+                indices[index] = image.m_indices[index];
+            }
+
+            m_palette       = palette;
+            m_paletteSize   = image.m_paletteSize;
+            m_indices       = indices;
+            m_rowSize       = image.m_rowSize;
+            m_width         = image.m_width;
+            m_height        = image.m_height;
+            m_bitsPerPixel  = image.m_bitsPerPixel;
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Compares two colors, including their intensity.
+ *
+ * @param[in] color1    Color 1
+ * @param[in] color2    Color 2
+ *
+ * @return If both colors are the same, it will return true otherwise false.
+ */
+static bool isSameColor(const Color& color1, const Color& color2)
+{
+    return (color1.getRed() == color2.getRed()) &&
+           (color1.getGreen() == color2.getGreen()) &&
+           (color1.getBlue() == color2.getBlue()) &&
+           (color1.getIntensity() == color2.getIntensity());
+}
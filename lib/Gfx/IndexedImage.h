@@ -0,0 +1,288 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Palette indexed image
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __INDEXED_IMAGE_H__
+#define __INDEXED_IMAGE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <Color.h>
+#include <IGfx.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A image, which stores a palette index per pixel instead of the color.
+ * Up to 16 colors 4 bit per pixel are used, otherwise 8 bit per pixel.
+ * Icons usually have only a few colors, therefore they need only a fraction
+ * of the memory, which a image with one Color per pixel needs.
+ *
+ * Drawing resolves the indices row by row via the palette and writes every
+ * row as span.
+ */
+class IndexedImage
+{
+public:
+
+    /**
+     * Constructs a empty image.
+     */
+    IndexedImage() :
+        m_palette(nullptr),
+        m_paletteSize(0U),
+        m_indices(nullptr),
+        m_rowSize(0U),
+        m_width(0U),
+        m_height(0U),
+        m_bitsPerPixel(0U)
+    {
+    }
+
+    /**
+     * Constructs a image by copying another one.
+     *
+     * @param[in] image Image, which to copy
+     */
+    IndexedImage(const IndexedImage& image) :
+        m_palette(nullptr),
+        m_paletteSize(0U),
+        m_indices(nullptr),
+        m_rowSize(0U),
+        m_width(0U),
+        m_height(0U),
+        m_bitsPerPixel(0U)
+    {
+        copy(image);
+    }
+
+    /**
+     * Destroys the image.
+     */
+    ~IndexedImage()
+    {
+        release();
+    }
+
+    /**
+     * Assigns a existing image.
+     *
+     * @param[in] image Image, which to assign
+     */
+    IndexedImage& operator=(const IndexedImage& image)
+    {
+        if (&image != this)
+        {
+            release();
+            copy(image);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Create the image from a bitmap with one color per pixel.
+     * If it fails, the image keeps its previous content.
+     *
+     * @param[in] bitmap    Bitmap
+     * @param[in] width     Bitmap width in pixel
+     * @param[in] height    Bitmap height in pixel
+     *
+     * @return If successful, it will return true otherwise false, e.g. if
+     *          the bitmap has more than MAX_PALETTE_SIZE colors.
+     */
+    bool set(const Color* bitmap, uint16_t width, uint16_t height);
+
+    /**
+     * Release the image, which is empty afterwards.
+     */
+    void release();
+
+    /**
+     * Is the image empty?
+     *
+     * @return If empty, it will return true otherwise false.
+     */
+    bool isEmpty() const
+    {
+        return (nullptr == m_indices);
+    }
+
+    /**
+     * Get image width.
+     *
+     * @return Width in pixel
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Get image height.
+     *
+     * @return Height in pixel
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Get the number of colors in the palette.
+     *
+     * @return Number of colors
+     */
+    uint16_t getPaletteSize() const
+    {
+        return m_paletteSize;
+    }
+
+    /**
+     * Get the number of bits per pixel, which are used for the palette index.
+     *
+     * @return Bits per pixel
+     */
+    uint8_t getBitsPerPixel() const
+    {
+        return m_bitsPerPixel;
+    }
+
+    /**
+     * Get the memory, which is used by the palette and the indices.
+     *
+     * @return Memory size in byte
+     */
+    size_t getMemorySize() const
+    {
+        return (m_paletteSize * sizeof(Color)) + (m_rowSize * m_height);
+    }
+
+    /**
+     * Get the color of a single pixel.
+     *
+     * @param[in] x x-coordinate, must be inside the image
+     * @param[in] y y-coordinate, must be inside the image
+     *
+     * @return Color
+     */
+    const Color& getColor(uint16_t x, uint16_t y) const
+    {
+        return m_palette[getIndex(&m_indices[y * m_rowSize], x)];
+    }
+
+    /**
+     * Draw a part of the image. All rows of the columns [srcX; srcX + width)
+     * are drawn.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left point on the canvas
+     * @param[in] y     y-coordinate of the upper left point on the canvas
+     * @param[in] srcX  First column in the image
+     * @param[in] width Number of columns
+     */
+    void draw(IGfx& gfx, int16_t x, int16_t y, uint16_t srcX, uint16_t width) const;
+
+    /** Max. number of colors */
+    static const uint16_t   MAX_PALETTE_SIZE        = 256U;
+
+    /** Max. number of colors, which are stored with 4 bit per pixel */
+    static const uint16_t   MAX_PALETTE_SIZE_4BPP   = 16U;
+
+private:
+
+    /** Number of pixels, which are resolved at once during drawing. */
+    static const uint16_t   SPAN_SIZE   = 32U;
+
+    Color*      m_palette;      /**< Colors */
+    uint16_t    m_paletteSize;  /**< Number of colors in the palette */
+    uint8_t*    m_indices;      /**< Palette indices row by row, every row starts at a byte boundary */
+    size_t      m_rowSize;      /**< Size of a row in byte */
+    uint16_t    m_width;        /**< Image width in pixel */
+    uint16_t    m_height;       /**< Image height in pixel */
+    uint8_t     m_bitsPerPixel; /**< Bits per pixel: 4 or 8 */
+
+    /**
+     * Get the palette index of a pixel in a row.
+     *
+     * @param[in] row   Row
+     * @param[in] x     x-coordinate
+     *
+     * @return Palette index
+     */
+    uint8_t getIndex(const uint8_t* row, uint16_t x) const
+    {
+        uint8_t index = 0U;
+
+        if (4U == m_bitsPerPixel)
+        {
+            /* The left pixel is in the high nibble. */
+            index = (0U == (x & 1U)) ? (row[x >> 1U] >> 4U) : (row[x >> 1U] & 0x0FU);
+        }
+        else
+        {
+            index = row[x];
+        }
+
+        return index;
+    }
+
+    /**
+     * Copy another image.
+     *
+     * @param[in] image Image, which to copy
+     */
+    void copy(const IndexedImage& image);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __INDEXED_IMAGE_H__ */
+
+/** @} */
@@ -0,0 +1,971 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming JPEG thumbnail decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JpegThumbDecoder.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int32_t extend(uint16_t value, uint8_t length);
+static uint8_t clamp(int32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Marker: Start of frame, baseline DCT */
+static const uint8_t    MARKER_SOF0     = 0xC0U;
+
+/** Marker: Start of frame, extended sequential DCT */
+static const uint8_t    MARKER_SOF1     = 0xC1U;
+
+/** Marker: Start of frame, progressive DCT */
+static const uint8_t    MARKER_SOF2     = 0xC2U;
+
+/** Marker: Define huffman tables */
+static const uint8_t    MARKER_DHT      = 0xC4U;
+
+/** Marker: Restart 0, the restart markers 1-7 follow. */
+static const uint8_t    MARKER_RST0     = 0xD0U;
+
+/** Marker: Restart 7 */
+static const uint8_t    MARKER_RST7     = 0xD7U;
+
+/** Marker: Start of image */
+static const uint8_t    MARKER_SOI      = 0xD8U;
+
+/** Marker: End of image */
+static const uint8_t    MARKER_EOI      = 0xD9U;
+
+/** Marker: Start of scan */
+static const uint8_t    MARKER_SOS      = 0xDAU;
+
+/** Marker: Define quantization tables */
+static const uint8_t    MARKER_DQT      = 0xDBU;
+
+/** Marker: Temporary private use, without segment */
+static const uint8_t    MARKER_TEM      = 0x01U;
+
+/** Marker prefix */
+static const uint8_t    MARKER_PREFIX   = 0xFFU;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool JpegThumbDecoder::begin(uint16_t thumbWidth, uint16_t thumbHeight)
+{
+    bool status = false;
+
+    if ((0U < thumbWidth) &&
+        (MAX_THUMB_WIDTH >= thumbWidth) &&
+        (0U < thumbHeight) &&
+        (MAX_THUMB_HEIGHT >= thumbHeight))
+    {
+        uint8_t idx = 0U;
+
+        m_thumbWidth    = thumbWidth;
+        m_thumbHeight   = thumbHeight;
+        m_state         = STATE_SOI;
+        m_width         = 0U;
+        m_height        = 0U;
+        m_componentCnt  = 0U;
+        m_mcuCntX       = 0U;
+        m_mcuCntY       = 0U;
+        m_mcuY          = 0U;
+        m_bitState      = BIT_STATE_DC_CODE;
+
+        for(idx = 0U; idx < MAX_QT; ++idx)
+        {
+            m_qtDc[idx] = 0U;
+        }
+
+        m_huffmanTables[0U][0U].isValid = false;
+        m_huffmanTables[0U][1U].isValid = false;
+        m_huffmanTables[1U][0U].isValid = false;
+        m_huffmanTables[1U][1U].isValid = false;
+
+        memset(m_sumRed, 0, sizeof(m_sumRed));
+        memset(m_sumGreen, 0, sizeof(m_sumGreen));
+        memset(m_sumBlue, 0, sizeof(m_sumBlue));
+        memset(m_count, 0, sizeof(m_count));
+
+        status = true;
+    }
+    else
+    {
+        m_state = STATE_ERROR;
+    }
+
+    return status;
+}
+
+bool JpegThumbDecoder::parse(const uint8_t* data, size_t size)
+{
+    size_t idx = 0U;
+
+    if (nullptr == data)
+    {
+        size = 0U;
+    }
+
+    while((size > idx) &&
+          (STATE_COMPLETE != m_state) &&
+          (STATE_ERROR != m_state))
+    {
+        uint8_t value = data[idx];
+
+        switch(m_state)
+        {
+        /* The image must start with SOI. */
+        case STATE_SOI:
+            m_state = (MARKER_PREFIX == value) ? STATE_SOI_ID : STATE_ERROR;
+            break;
+
+        case STATE_SOI_ID:
+            m_state = (MARKER_SOI == value) ? STATE_MARKER : STATE_ERROR;
+            break;
+
+        case STATE_MARKER:
+            m_state = (MARKER_PREFIX == value) ? STATE_MARKER_ID : STATE_ERROR;
+            break;
+
+        case STATE_MARKER_ID:
+            /* Fill bytes may precede a marker. */
+            if (MARKER_PREFIX != value)
+            {
+                handleMarker(value);
+            }
+            break;
+
+        case STATE_LENGTH_HIGH:
+            m_segmentLength = static_cast<size_t>(value) << 8U;
+            m_state         = STATE_LENGTH_LOW;
+            break;
+
+        case STATE_LENGTH_LOW:
+            m_segmentLength |= value;
+
+            /* The length includes the length field itself. */
+            if (2U > m_segmentLength)
+            {
+                m_state = STATE_ERROR;
+            }
+            else
+            {
+                m_segmentLength -= 2U;
+                m_segmentIdx     = 0U;
+                m_state          = STATE_SEGMENT;
+
+                if ((0U == m_segmentLength) &&
+                    (false == handleSegment()))
+                {
+                    m_state = STATE_ERROR;
+                }
+            }
+            break;
+
+        case STATE_SEGMENT:
+            /* Only the segments of interest are collected, all others
+             * are skipped.
+             */
+            if (SEGMENT_SIZE > m_segmentIdx)
+            {
+                m_segment[m_segmentIdx] = value;
+            }
+
+            ++m_segmentIdx;
+
+            if ((m_segmentLength == m_segmentIdx) &&
+                (false == handleSegment()))
+            {
+                m_state = STATE_ERROR;
+            }
+            break;
+
+        case STATE_ENTROPY:
+            if (MARKER_PREFIX == value)
+            {
+                m_state = STATE_ENTROPY_FF;
+            }
+            else
+            {
+                handleEntropyByte(value);
+            }
+            break;
+
+        case STATE_ENTROPY_FF:
+            /* A stuffed zero byte follows a 0xFF data byte. */
+            if (0x00U == value)
+            {
+                m_state = STATE_ENTROPY;
+                handleEntropyByte(MARKER_PREFIX);
+            }
+            else if ((MARKER_RST0 <= value) &&
+                     (MARKER_RST7 >= value))
+            {
+                m_state = STATE_ENTROPY;
+                restart();
+            }
+            else if (MARKER_PREFIX == value)
+            {
+                ;
+            }
+            else
+            {
+                handleMarker(value);
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        /* The entropy decoding may detect a corrupt image too. */
+        if (BIT_STATE_ERROR == m_bitState)
+        {
+            m_state = STATE_ERROR;
+        }
+
+        ++idx;
+    }
+
+    return (STATE_ERROR != m_state);
+}
+
+bool JpegThumbDecoder::getThumbnail(Color* bitmap) const
+{
+    bool status = false;
+
+    if ((nullptr != bitmap) &&
+        (STATE_COMPLETE == m_state))
+    {
+        uint16_t idx = 0U;
+
+        for(idx = 0U; idx < (m_thumbWidth * m_thumbHeight); ++idx)
+        {
+            if (0U == m_count[idx])
+            {
+                bitmap[idx] = Color(0U, 0U, 0U);
+            }
+            else
+            {
+                bitmap[idx] = Color(static_cast<uint8_t>(m_sumRed[idx] / m_count[idx]),
+                                    static_cast<uint8_t>(m_sumGreen[idx] / m_count[idx]),
+                                    static_cast<uint8_t>(m_sumBlue[idx] / m_count[idx]));
+            }
+        }
+
+        status = true;
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void JpegThumbDecoder::handleMarker(uint8_t marker)
+{
+    m_marker = marker;
+
+    if (MARKER_EOI == marker)
+    {
+        /* Only a decoded image is complete. */
+        if ((0U < m_mcuCntY) &&
+            (m_mcuCntY <= m_mcuY))
+        {
+            m_state = STATE_COMPLETE;
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+    }
+    /* Markers without segment */
+    else if ((MARKER_TEM == marker) ||
+             ((MARKER_RST0 <= marker) && (MARKER_RST7 >= marker)))
+    {
+        m_state = STATE_MARKER;
+    }
+    else if ((MARKER_SOI == marker) ||
+             (0x00U == marker))
+    {
+        m_state = STATE_ERROR;
+    }
+    else
+    {
+        m_state = STATE_LENGTH_HIGH;
+    }
+
+    return;
+}
+
+bool JpegThumbDecoder::handleSegment()
+{
+    bool isValid = true;
+
+    m_state = STATE_MARKER;
+
+    switch(m_marker)
+    {
+    case MARKER_DQT:
+        isValid = parseDqt();
+        break;
+
+    case MARKER_DHT:
+        isValid = parseDht();
+        break;
+
+    case MARKER_SOF0:
+    case MARKER_SOF1:
+        isValid = parseSof();
+        break;
+
+    case MARKER_SOS:
+        isValid = parseSos();
+        break;
+
+    default:
+        /* All other start of frame markers are not supported. */
+        if ((MARKER_SOF2 <= m_marker) &&
+            (0xCFU >= m_marker) &&
+            (MARKER_DHT != m_marker) &&
+            (0xC8U != m_marker) &&
+            (0xCCU != m_marker))
+        {
+            isValid = false;
+        }
+        break;
+    }
+
+    return isValid;
+}
+
+bool JpegThumbDecoder::parseDqt()
+{
+    bool    isValid = (SEGMENT_SIZE >= m_segmentLength);
+    size_t  idx     = 0U;
+
+    while((true == isValid) && (m_segmentLength > idx))
+    {
+        uint8_t precision   = m_segment[idx] >> 4U;
+        uint8_t tableIdx    = m_segment[idx] & 0x0FU;
+        size_t  tableSize   = (0U == precision) ? BLOCK_COEFFS : (2U * BLOCK_COEFFS);
+
+        if ((MAX_QT <= tableIdx) ||
+            (1U < precision) ||
+            (m_segmentLength < (idx + 1U + tableSize)))
+        {
+            isValid = false;
+        }
+        else
+        {
+            /* Only the DC value is necessary, it is the first in zigzag order. */
+            if (0U == precision)
+            {
+                m_qtDc[tableIdx] = m_segment[idx + 1U];
+            }
+            else
+            {
+                m_qtDc[tableIdx] = (static_cast<uint16_t>(m_segment[idx + 1U]) << 8U) | m_segment[idx + 2U];
+            }
+
+            idx += 1U + tableSize;
+        }
+    }
+
+    return isValid;
+}
+
+bool JpegThumbDecoder::parseDht()
+{
+    bool    isValid = (SEGMENT_SIZE >= m_segmentLength);
+    size_t  idx     = 0U;
+
+    while((true == isValid) && (m_segmentLength > idx))
+    {
+        uint8_t tableClass  = m_segment[idx] >> 4U;
+        uint8_t tableIdx    = m_segment[idx] & 0x0FU;
+        size_t  symbolCnt   = 0U;
+        uint8_t length      = 0U;
+
+        if ((1U < tableClass) ||
+            (1U < tableIdx) ||
+            (m_segmentLength < (idx + 17U)))
+        {
+            isValid = false;
+        }
+        else
+        {
+            HuffmanTable&   table   = m_huffmanTables[tableClass][tableIdx];
+            uint16_t        code    = 0U;
+
+            /* Canonical huffman codes, see JPEG specification Annex C. */
+            for(length = 0U; length < 16U; ++length)
+            {
+                uint8_t cnt = m_segment[idx + 1U + length];
+
+                table.valPtr[length]    = static_cast<uint8_t>(symbolCnt);
+                table.minCode[length]   = code;
+                table.maxCode[length]   = (0U == cnt) ? -1 : static_cast<int32_t>(code + cnt - 1U);
+
+                code        += cnt;
+                code       <<= 1U;
+                symbolCnt   += cnt;
+            }
+
+            if ((MAX_SYMBOLS < symbolCnt) ||
+                (m_segmentLength < (idx + 17U + symbolCnt)))
+            {
+                isValid = false;
+            }
+            else
+            {
+                memcpy(table.symbols, &m_segment[idx + 17U], symbolCnt);
+                table.isValid = true;
+
+                idx += 17U + symbolCnt;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+bool JpegThumbDecoder::parseSof()
+{
+    bool isValid = false;
+
+    if ((SEGMENT_SIZE >= m_segmentLength) &&
+        (6U <= m_segmentLength) &&
+        (8U == m_segment[0U]))
+    {
+        uint8_t componentCnt    = m_segment[5U];
+        uint8_t idx             = 0U;
+
+        m_height    = (static_cast<uint16_t>(m_segment[1U]) << 8U) | m_segment[2U];
+        m_width     = (static_cast<uint16_t>(m_segment[3U]) << 8U) | m_segment[4U];
+
+        if ((0U < m_width) &&
+            (0U < m_height) &&
+            ((1U == componentCnt) || (MAX_COMPONENTS == componentCnt)) &&
+            ((6U + (3U * componentCnt)) <= m_segmentLength))
+        {
+            isValid = true;
+
+            for(idx = 0U; idx < componentCnt; ++idx)
+            {
+                Component& component = m_components[idx];
+
+                component.id        = m_segment[6U + (3U * idx)];
+                component.hFactor   = m_segment[7U + (3U * idx)] >> 4U;
+                component.vFactor   = m_segment[7U + (3U * idx)] & 0x0FU;
+                component.qtIdx     = m_segment[8U + (3U * idx)];
+
+                if (MAX_QT <= component.qtIdx)
+                {
+                    isValid = false;
+                }
+                /* A single component is not interleaved, which means every
+                 * block is a MCU.
+                 */
+                else if (1U == componentCnt)
+                {
+                    component.hFactor = 1U;
+                    component.vFactor = 1U;
+                }
+                /* The luma may be subsampled 2x2 at most, the chroma not at all. */
+                else if (0U == idx)
+                {
+                    if ((0U == component.hFactor) ||
+                        (2U < component.hFactor) ||
+                        (0U == component.vFactor) ||
+                        (2U < component.vFactor))
+                    {
+                        isValid = false;
+                    }
+                }
+                else if ((1U != component.hFactor) ||
+                         (1U != component.vFactor))
+                {
+                    isValid = false;
+                }
+                else
+                {
+                    ;
+                }
+            }
+
+            if (true == isValid)
+            {
+                const uint16_t  SCALED_WIDTH    = (m_width + 7U) / 8U;
+                const uint16_t  SCALED_HEIGHT   = (m_height + 7U) / 8U;
+                const uint8_t   H_FACTOR        = m_components[0U].hFactor;
+                const uint8_t   V_FACTOR        = m_components[0U].vFactor;
+
+                m_componentCnt  = componentCnt;
+                m_blocksPerMcu  = (H_FACTOR * V_FACTOR) + (componentCnt - 1U);
+                m_mcuCntX       = (SCALED_WIDTH + H_FACTOR - 1U) / H_FACTOR;
+                m_mcuCntY       = (SCALED_HEIGHT + V_FACTOR - 1U) / V_FACTOR;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+bool JpegThumbDecoder::parseSos()
+{
+    bool isValid = false;
+
+    /* Only a single scan with all components is supported. */
+    if ((0U < m_componentCnt) &&
+        (SEGMENT_SIZE >= m_segmentLength) &&
+        (1U <= m_segmentLength) &&
+        (m_componentCnt == m_segment[0U]) &&
+        ((1U + (2U * m_componentCnt) + 3U) <= m_segmentLength))
+    {
+        uint8_t idx = 0U;
+
+        isValid = true;
+
+        for(idx = 0U; idx < m_componentCnt; ++idx)
+        {
+            Component&  component   = m_components[idx];
+            uint8_t     tables      = m_segment[2U + (2U * idx)];
+
+            component.dcIdx = tables >> 4U;
+            component.acIdx = tables & 0x0FU;
+
+            if ((m_segment[1U + (2U * idx)] != component.id) ||
+                (1U < component.dcIdx) ||
+                (1U < component.acIdx) ||
+                (false == m_huffmanTables[0U][component.dcIdx].isValid) ||
+                (false == m_huffmanTables[1U][component.acIdx].isValid))
+            {
+                isValid = false;
+            }
+        }
+
+        if (true == isValid)
+        {
+            m_mcuX      = 0U;
+            m_mcuY      = 0U;
+            m_state     = STATE_ENTROPY;
+
+            restart();
+        }
+    }
+
+    return isValid;
+}
+
+void JpegThumbDecoder::handleEntropyByte(uint8_t data)
+{
+    uint8_t mask = 0x80U;
+
+    while((0U != mask) &&
+          (BIT_STATE_DONE != m_bitState) &&
+          (BIT_STATE_ERROR != m_bitState))
+    {
+        handleBit((0U != (data & mask)) ? 1U : 0U);
+        mask >>= 1U;
+    }
+
+    return;
+}
+
+void JpegThumbDecoder::handleBit(uint8_t bit)
+{
+    const Component&    component   = m_components[getBlockComponent()];
+    uint8_t             symbol      = 0U;
+
+    switch(m_bitState)
+    {
+    case BIT_STATE_DC_CODE:
+        if (true == decodeSymbol(m_huffmanTables[0U][component.dcIdx], bit, symbol))
+        {
+            m_valueLength   = symbol;
+            m_valueBits     = 0U;
+            m_value         = 0U;
+
+            if (16U <= symbol)
+            {
+                m_bitState = BIT_STATE_ERROR;
+            }
+            /* No difference to the prediction. */
+            else if (0U == symbol)
+            {
+                finishDc();
+            }
+            else
+            {
+                m_bitState = BIT_STATE_DC_VALUE;
+            }
+        }
+        break;
+
+    case BIT_STATE_DC_VALUE:
+        m_value = (m_value << 1U) | bit;
+        ++m_valueBits;
+
+        if (m_valueLength == m_valueBits)
+        {
+            finishDc();
+        }
+        break;
+
+    case BIT_STATE_AC_CODE:
+        if (true == decodeSymbol(m_huffmanTables[1U][component.acIdx], bit, symbol))
+        {
+            uint8_t run     = symbol >> 4U;
+            uint8_t length  = symbol & 0x0FU;
+
+            if (0U == length)
+            {
+                /* ZRL: 16 zero coefficients, otherwise end of block. */
+                if (15U == run)
+                {
+                    m_coeffIdx += 16U;
+                }
+                else
+                {
+                    m_coeffIdx = BLOCK_COEFFS;
+                }
+            }
+            else
+            {
+                m_coeffIdx      += run;
+                m_valueLength    = length;
+                m_valueBits      = 0U;
+                m_bitState       = BIT_STATE_AC_VALUE;
+            }
+
+            if (BLOCK_COEFFS <= m_coeffIdx)
+            {
+                finishBlock();
+            }
+        }
+        break;
+
+    case BIT_STATE_AC_VALUE:
+        ++m_valueBits;
+
+        /* The AC value itself is not used. */
+        if (m_valueLength == m_valueBits)
+        {
+            ++m_coeffIdx;
+
+            if (BLOCK_COEFFS <= m_coeffIdx)
+            {
+                finishBlock();
+            }
+            else
+            {
+                m_bitState = BIT_STATE_AC_CODE;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+void JpegThumbDecoder::finishDc()
+{
+    Component&  component   = m_components[getBlockComponent()];
+    int32_t     level       = 0;
+
+    component.pred += extend(m_value, m_valueLength);
+
+    /* The DC coefficient is 8 times the average of the block. */
+    level = 128 + ((component.pred * static_cast<int32_t>(m_qtDc[component.qtIdx])) / 8);
+
+    m_mcuLevels[m_blockIdx] = clamp(level);
+    m_coeffIdx              = 1U;
+    m_bitState              = BIT_STATE_AC_CODE;
+
+    return;
+}
+
+bool JpegThumbDecoder::decodeSymbol(const HuffmanTable& table, uint8_t bit, uint8_t& symbol)
+{
+    bool isComplete = false;
+
+    m_code = (m_code << 1U) | bit;
+    ++m_codeLength;
+
+    if (16U < m_codeLength)
+    {
+        /* Invalid code */
+        m_bitState = BIT_STATE_ERROR;
+    }
+    else if ((0 <= table.maxCode[m_codeLength - 1U]) &&
+             (table.maxCode[m_codeLength - 1U] >= static_cast<int32_t>(m_code)))
+    {
+        size_t symbolIdx = table.valPtr[m_codeLength - 1U] + (m_code - table.minCode[m_codeLength - 1U]);
+
+        if (MAX_SYMBOLS <= symbolIdx)
+        {
+            m_bitState = BIT_STATE_ERROR;
+        }
+        else
+        {
+            symbol      = table.symbols[symbolIdx];
+            isComplete  = true;
+        }
+
+        m_code          = 0U;
+        m_codeLength    = 0U;
+    }
+    else
+    {
+        ;
+    }
+
+    return isComplete;
+}
+
+uint8_t JpegThumbDecoder::getBlockComponent() const
+{
+    const uint8_t   LUMA_BLOCKS = m_components[0U].hFactor * m_components[0U].vFactor;
+    uint8_t         component   = 0U;
+
+    if (LUMA_BLOCKS <= m_blockIdx)
+    {
+        component = 1U + (m_blockIdx - LUMA_BLOCKS);
+    }
+
+    return component;
+}
+
+void JpegThumbDecoder::finishBlock()
+{
+    ++m_blockIdx;
+
+    if (m_blocksPerMcu <= m_blockIdx)
+    {
+        finishMcu();
+        m_blockIdx = 0U;
+    }
+
+    m_bitState = (m_mcuCntY <= m_mcuY) ? BIT_STATE_DONE : BIT_STATE_DC_CODE;
+
+    return;
+}
+
+void JpegThumbDecoder::finishMcu()
+{
+    const uint8_t   H_FACTOR    = m_components[0U].hFactor;
+    const uint8_t   V_FACTOR    = m_components[0U].vFactor;
+    const uint8_t   LUMA_BLOCKS = H_FACTOR * V_FACTOR;
+    const uint16_t  WIDTH       = (m_width + 7U) / 8U;
+    const uint16_t  HEIGHT      = (m_height + 7U) / 8U;
+    int32_t         cb          = 0;
+    int32_t         cr          = 0;
+    uint8_t         blockIdx    = 0U;
+
+    if (1U < m_componentCnt)
+    {
+        cb = static_cast<int32_t>(m_mcuLevels[LUMA_BLOCKS]) - 128;
+        cr = static_cast<int32_t>(m_mcuLevels[LUMA_BLOCKS + 1U]) - 128;
+    }
+
+    /* Every luma block is a pixel in the 1/8 scaled image. Blocks beyond
+     * the image border only fill the last MCU.
+     */
+    for(blockIdx = 0U; blockIdx < LUMA_BLOCKS; ++blockIdx)
+    {
+        uint16_t x = (m_mcuX * H_FACTOR) + (blockIdx % H_FACTOR);
+        uint16_t y = (m_mcuY * V_FACTOR) + (blockIdx / H_FACTOR);
+
+        if ((WIDTH > x) &&
+            (HEIGHT > y))
+        {
+            /* YCbCr to RGB (JFIF), fixed point with 10 bit fraction */
+            int32_t luma    = m_mcuLevels[blockIdx];
+            int32_t red     = luma + ((1436 * cr) / 1024);
+            int32_t green   = luma - (((352 * cb) + (731 * cr)) / 1024);
+            int32_t blue    = luma + ((1815 * cb) / 1024);
+
+            addPixel(x, y, Color(clamp(red), clamp(green), clamp(blue)));
+        }
+    }
+
+    ++m_mcuX;
+
+    if (m_mcuCntX <= m_mcuX)
+    {
+        m_mcuX = 0U;
+        ++m_mcuY;
+    }
+
+    return;
+}
+
+void JpegThumbDecoder::restart()
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < m_componentCnt; ++idx)
+    {
+        m_components[idx].pred = 0;
+    }
+
+    m_blockIdx      = 0U;
+    m_code          = 0U;
+    m_codeLength    = 0U;
+    m_bitState      = (m_mcuCntY <= m_mcuY) ? BIT_STATE_DONE : BIT_STATE_DC_CODE;
+
+    return;
+}
+
+void JpegThumbDecoder::addPixel(uint16_t x, uint16_t y, const Color& color)
+{
+    const uint32_t  WIDTH       = (m_width + 7U) / 8U;
+    const uint32_t  HEIGHT      = (m_height + 7U) / 8U;
+    uint32_t        beginX      = (x * m_thumbWidth) / WIDTH;
+    uint32_t        endX        = ((x + 1U) * m_thumbWidth) / WIDTH;
+    uint32_t        beginY      = (y * m_thumbHeight) / HEIGHT;
+    uint32_t        endY        = ((y + 1U) * m_thumbHeight) / HEIGHT;
+    uint32_t        thumbX      = 0U;
+    uint32_t        thumbY      = 0U;
+
+    /* Area-averaging: A pixel contributes to every thumbnail pixel, which
+     * it covers. If the image is smaller than the thumbnail, it covers
+     * several, otherwise at least one.
+     */
+    if (beginX == endX)
+    {
+        endX = beginX + 1U;
+    }
+
+    if (beginY == endY)
+    {
+        endY = beginY + 1U;
+    }
+
+    for(thumbY = beginY; thumbY < endY; ++thumbY)
+    {
+        for(thumbX = beginX; thumbX < endX; ++thumbX)
+        {
+            uint32_t idx = (thumbY * m_thumbWidth) + thumbX;
+
+            m_sumRed[idx]   += color.getRed();
+            m_sumGreen[idx] += color.getGreen();
+            m_sumBlue[idx]  += color.getBlue();
+            ++m_count[idx];
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Extend the value to a signed value, see JPEG specification F.2.2.1.
+ *
+ * @param[in] value     Value
+ * @param[in] length    Value length in bit
+ *
+ * @return Signed value
+ */
+static int32_t extend(uint16_t value, uint8_t length)
+{
+    int32_t result = value;
+
+    if ((0U < length) &&
+        (0U == (value & (1U << (length - 1U)))))
+    {
+        result = static_cast<int32_t>(value) - static_cast<int32_t>((1U << length) - 1U);
+    }
+
+    return result;
+}
+
+/**
+ * Clamp the value to the range of 8 bit.
+ *
+ * @param[in] value Value
+ *
+ * @return Clamped value
+ */
+static uint8_t clamp(int32_t value)
+{
+    if (0 > value)
+    {
+        value = 0;
+    }
+    else if (255 < value)
+    {
+        value = 255;
+    }
+    else
+    {
+        ;
+    }
+
+    return static_cast<uint8_t>(value);
+}
@@ -0,0 +1,409 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming JPEG thumbnail decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __JPEGTHUMBDECODER_H__
+#define __JPEGTHUMBDECODER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <Color.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decoder for baseline JPEG images, which creates a small thumbnail of
+ * the image. The image is fed in parts, e.g. directly from the TCP buffer,
+ * and is never hold completely in memory.
+ *
+ * Only the DC coefficient of every block is used, which is the average of
+ * its 8x8 pixels. This corresponds to a 1/8 scaled image, without any
+ * inverse DCT. The AC coefficients are only decoded to skip them. The
+ * scaled image is reduced further to the thumbnail by area-averaging.
+ *
+ * Supported are grayscale and YCbCr images with 8 bit precision, with
+ * 4:4:4, 4:2:2 and 4:2:0 chroma subsampling and restart intervals.
+ * Progressive and arithmetic coded images are not supported.
+ */
+class JpegThumbDecoder
+{
+public:
+
+    /** Max. thumbnail width in pixel */
+    static const uint16_t   MAX_THUMB_WIDTH     = 8U;
+
+    /** Max. thumbnail height in pixel */
+    static const uint16_t   MAX_THUMB_HEIGHT    = 8U;
+
+    /**
+     * Constructs a JPEG thumbnail decoder for a thumbnail with the max. size.
+     */
+    JpegThumbDecoder() :
+        m_thumbWidth(MAX_THUMB_WIDTH),
+        m_thumbHeight(MAX_THUMB_HEIGHT),
+        m_state(STATE_ERROR),
+        m_marker(0U),
+        m_segment(),
+        m_segmentLength(0U),
+        m_segmentIdx(0U),
+        m_width(0U),
+        m_height(0U),
+        m_qtDc(),
+        m_huffmanTables(),
+        m_components(),
+        m_componentCnt(0U),
+        m_mcuCntX(0U),
+        m_mcuCntY(0U),
+        m_mcuX(0U),
+        m_mcuY(0U),
+        m_blockIdx(0U),
+        m_blocksPerMcu(0U),
+        m_mcuLevels(),
+        m_bitState(BIT_STATE_DC_CODE),
+        m_code(0U),
+        m_codeLength(0U),
+        m_value(0U),
+        m_valueBits(0U),
+        m_valueLength(0U),
+        m_coeffIdx(0U),
+        m_sumRed(),
+        m_sumGreen(),
+        m_sumBlue(),
+        m_count()
+    {
+    }
+
+    /**
+     * Destroys the JPEG thumbnail decoder.
+     */
+    ~JpegThumbDecoder()
+    {
+    }
+
+    /**
+     * Start decoding a new image.
+     *
+     * @param[in] thumbWidth    Thumbnail width in pixel
+     * @param[in] thumbHeight   Thumbnail height in pixel
+     *
+     * @return If the thumbnail size is supported, it will return true otherwise false.
+     */
+    bool begin(uint16_t thumbWidth, uint16_t thumbHeight);
+
+    /**
+     * Feed the next part of the image.
+     *
+     * @param[in] data  Image data
+     * @param[in] size  Image data size in byte
+     *
+     * @return If the image is corrupt or not supported, it will return false otherwise true.
+     */
+    bool parse(const uint8_t* data, size_t size);
+
+    /**
+     * Is the image completely decoded?
+     *
+     * @return If completely decoded, it will return true otherwise false.
+     */
+    bool isComplete() const
+    {
+        return (STATE_COMPLETE == m_state);
+    }
+
+    /**
+     * Get image width.
+     *
+     * @return Image width in pixel
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Get image height.
+     *
+     * @return Image height in pixel
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Get the thumbnail of the completely decoded image.
+     *
+     * @param[out] bitmap   Bitmap with thumbnail width x height pixels
+     *
+     * @return If the image is completely decoded, it will return true otherwise false.
+     */
+    bool getThumbnail(Color* bitmap) const;
+
+private:
+
+    /** Size of the segment buffer in byte, which is sufficient for 4 quantization or huffman tables. */
+    static const size_t     SEGMENT_SIZE        = 544U;
+
+    /** Max. number of symbols of a huffman table */
+    static const size_t     MAX_SYMBOLS         = 162U;
+
+    /** Max. number of image components */
+    static const uint8_t    MAX_COMPONENTS      = 3U;
+
+    /** Max. number of blocks of a MCU (4:2:0) */
+    static const uint8_t    MAX_BLOCKS_PER_MCU  = 6U;
+
+    /** Max. number of quantization tables */
+    static const uint8_t    MAX_QT              = 4U;
+
+    /** Number of coefficients of a block */
+    static const uint8_t    BLOCK_COEFFS        = 64U;
+
+    /**
+     * Decoder states.
+     */
+    enum State
+    {
+        STATE_SOI = 0,      /**< Wait for the marker prefix of the start of image marker */
+        STATE_SOI_ID,       /**< Wait for the start of image marker id */
+        STATE_MARKER,       /**< Wait for the marker prefix */
+        STATE_MARKER_ID,    /**< Wait for the marker id */
+        STATE_LENGTH_HIGH,  /**< Wait for the high byte of the segment length */
+        STATE_LENGTH_LOW,   /**< Wait for the low byte of the segment length */
+        STATE_SEGMENT,      /**< Collect or skip the segment */
+        STATE_ENTROPY,      /**< Decode the entropy coded data */
+        STATE_ENTROPY_FF,   /**< Entropy coded data contains a 0xFF */
+        STATE_COMPLETE,     /**< End of image */
+        STATE_ERROR         /**< Corrupt or unsupported image */
+    };
+
+    /**
+     * States of the entropy decoding.
+     */
+    enum BitState
+    {
+        BIT_STATE_DC_CODE = 0,  /**< Decode the DC huffman code */
+        BIT_STATE_DC_VALUE,     /**< Read the DC difference */
+        BIT_STATE_AC_CODE,      /**< Decode the AC huffman code */
+        BIT_STATE_AC_VALUE,     /**< Skip the AC value */
+        BIT_STATE_DONE,         /**< All MCUs decoded, the rest is padding */
+        BIT_STATE_ERROR         /**< Invalid huffman code */
+    };
+
+    /**
+     * Huffman table for decoding bit by bit.
+     */
+    struct HuffmanTable
+    {
+        int32_t     maxCode[16];            /**< Max. code per code length, -1 if there is none. */
+        uint16_t    minCode[16];            /**< Min. code per code length */
+        uint8_t     valPtr[16];             /**< Index of the first symbol per code length */
+        uint8_t     symbols[MAX_SYMBOLS];   /**< Symbols */
+        bool        isValid;                /**< Is the table defined? */
+    };
+
+    /**
+     * Image component.
+     */
+    struct Component
+    {
+        uint8_t     id;         /**< Component id */
+        uint8_t     hFactor;    /**< Horizontal sampling factor */
+        uint8_t     vFactor;    /**< Vertical sampling factor */
+        uint8_t     qtIdx;      /**< Quantization table index */
+        uint8_t     dcIdx;      /**< DC huffman table index */
+        uint8_t     acIdx;      /**< AC huffman table index */
+        int32_t     pred;       /**< DC prediction */
+    };
+
+    uint16_t        m_thumbWidth;                           /**< Thumbnail width in pixel */
+    uint16_t        m_thumbHeight;                          /**< Thumbnail height in pixel */
+    State           m_state;                                /**< Decoder state */
+    uint8_t         m_marker;                               /**< Current marker id */
+    uint8_t         m_segment[SEGMENT_SIZE];                /**< Segment buffer */
+    size_t          m_segmentLength;                        /**< Segment length in byte, without the length field */
+    size_t          m_segmentIdx;                           /**< Number of received segment bytes */
+    uint16_t        m_width;                                /**< Image width in pixel */
+    uint16_t        m_height;                               /**< Image height in pixel */
+    uint16_t        m_qtDc[MAX_QT];                         /**< DC quantization values */
+    HuffmanTable    m_huffmanTables[2U][2U];                /**< Huffman tables, DC and AC, each 2 */
+    Component       m_components[MAX_COMPONENTS];           /**< Image components */
+    uint8_t         m_componentCnt;                         /**< Number of image components */
+    uint16_t        m_mcuCntX;                              /**< Number of MCUs per row */
+    uint16_t        m_mcuCntY;                              /**< Number of MCU rows */
+    uint16_t        m_mcuX;                                 /**< Column of the current MCU */
+    uint16_t        m_mcuY;                                 /**< Row of the current MCU */
+    uint8_t         m_blockIdx;                             /**< Index of the current block in the MCU */
+    uint8_t         m_blocksPerMcu;                         /**< Number of blocks per MCU */
+    uint8_t         m_mcuLevels[MAX_BLOCKS_PER_MCU];        /**< Average level of every block of the current MCU */
+    BitState        m_bitState;                             /**< Entropy decoding state */
+    uint16_t        m_code;                                 /**< Huffman code, read so far */
+    uint8_t         m_codeLength;                           /**< Huffman code length in bit, read so far */
+    uint16_t        m_value;                                /**< Value, read so far */
+    uint8_t         m_valueBits;                            /**< Value bits, read so far */
+    uint8_t         m_valueLength;                          /**< Value length in bit */
+    uint8_t         m_coeffIdx;                             /**< Index of the current coefficient in the block */
+    uint32_t        m_sumRed[MAX_THUMB_WIDTH * MAX_THUMB_HEIGHT];   /**< Sum of red per thumbnail pixel */
+    uint32_t        m_sumGreen[MAX_THUMB_WIDTH * MAX_THUMB_HEIGHT]; /**< Sum of green per thumbnail pixel */
+    uint32_t        m_sumBlue[MAX_THUMB_WIDTH * MAX_THUMB_HEIGHT];  /**< Sum of blue per thumbnail pixel */
+    uint16_t        m_count[MAX_THUMB_WIDTH * MAX_THUMB_HEIGHT];    /**< Number of summed up pixels per thumbnail pixel */
+
+    /* Prevent copying */
+    JpegThumbDecoder(const JpegThumbDecoder& decoder);
+    JpegThumbDecoder& operator=(const JpegThumbDecoder& decoder);
+
+    /**
+     * Handle a marker, which is followed by a segment or not.
+     *
+     * @param[in] marker    Marker id
+     */
+    void handleMarker(uint8_t marker);
+
+    /**
+     * Handle a completely received segment.
+     *
+     * @return If the segment is valid, it will return true otherwise false.
+     */
+    bool handleSegment();
+
+    /**
+     * Parse a quantization table segment.
+     *
+     * @return If the segment is valid, it will return true otherwise false.
+     */
+    bool parseDqt();
+
+    /**
+     * Parse a huffman table segment.
+     *
+     * @return If the segment is valid, it will return true otherwise false.
+     */
+    bool parseDht();
+
+    /**
+     * Parse a baseline start of frame segment.
+     *
+     * @return If the segment is valid and supported, it will return true otherwise false.
+     */
+    bool parseSof();
+
+    /**
+     * Parse a start of scan segment.
+     *
+     * @return If the segment is valid and supported, it will return true otherwise false.
+     */
+    bool parseSos();
+
+    /**
+     * Handle entropy coded data bit by bit.
+     *
+     * @param[in] data  Entropy coded byte, already unstuffed.
+     */
+    void handleEntropyByte(uint8_t data);
+
+    /**
+     * Handle a single bit of the entropy coded data.
+     *
+     * @param[in] bit   Bit
+     */
+    void handleBit(uint8_t bit);
+
+    /**
+     * Handle the end of the DC difference of the current block.
+     */
+    void finishDc();
+
+    /**
+     * Decode a huffman symbol with the next bit.
+     *
+     * @param[in]  table    Huffman table
+     * @param[in]  bit      Next bit
+     * @param[out] symbol   Decoded symbol
+     *
+     * @return If the symbol is complete, it will return true otherwise false.
+     */
+    bool decodeSymbol(const HuffmanTable& table, uint8_t bit, uint8_t& symbol);
+
+    /**
+     * Get the component of the current block.
+     *
+     * @return Component index
+     */
+    uint8_t getBlockComponent() const;
+
+    /**
+     * Handle the end of the current block.
+     */
+    void finishBlock();
+
+    /**
+     * Handle the end of the current MCU and add its pixels to the thumbnail.
+     */
+    void finishMcu();
+
+    /**
+     * Reset the entropy decoding at a restart marker.
+     */
+    void restart();
+
+    /**
+     * Add a pixel of the 1/8 scaled image to the thumbnail.
+     *
+     * @param[in] x     x-coordinate in the scaled image
+     * @param[in] y     y-coordinate in the scaled image
+     * @param[in] color Pixel color
+     */
+    void addPixel(uint16_t x, uint16_t y, const Color& color);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __JPEGTHUMBDECODER_H__ */
+
+/** @} */
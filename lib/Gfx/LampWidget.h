@@ -124,6 +124,8 @@ public:
         m_colorOn   = widget.m_colorOn;
         m_width     = widget.m_width;
 
+        invalidate();
+
         return *this;
     }
 
@@ -153,7 +155,11 @@ public:
      */
     void setOnState(bool state)
     {
-        m_isOn = state;
+        if (m_isOn != state)
+        {
+            m_isOn = state;
+            invalidate();
+        }
 
         return;
     }
@@ -175,7 +181,11 @@ public:
      */
     void setColorOff(const Color& color)
     {
-        m_colorOff = color;
+        if (m_colorOff != color)
+        {
+            m_colorOff = color;
+            invalidate();
+        }
 
         return;
     }
@@ -197,7 +207,11 @@ public:
      */
     void setColorOn(const Color& color)
     {
-        m_colorOn = color;
+        if (m_colorOn != color)
+        {
+            m_colorOn = color;
+            invalidate();
+        }
 
         return;
     }
@@ -219,7 +233,11 @@ public:
      */
     void setWidth(uint16_t width)
     {
-        m_width = width;
+        if (m_width != width)
+        {
+            m_width = width;
+            invalidate();
+        }
 
         return;
     }
@@ -0,0 +1,255 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Packed pixel storage formats
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __PIXELFORMAT_HPP__
+#define __PIXELFORMAT_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Color.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Pixel stored in RGB888 format (3 byte).
+ * In contrast to the Color, the intensity is applied on write. Therefore
+ * dimming a pixel is destructive.
+ */
+class Rgb888Pixel
+{
+public:
+
+    /**
+     * Constructs a black pixel.
+     */
+    Rgb888Pixel() :
+        m_red(0U),
+        m_green(0U),
+        m_blue(0U)
+    {
+    }
+
+    /**
+     * Constructs a pixel from a color. The color intensity is applied.
+     *
+     * @param[in] color Color
+     */
+    explicit Rgb888Pixel(const Color& color) :
+        m_red(0U),
+        m_green(0U),
+        m_blue(0U)
+    {
+        color.get(m_red, m_green, m_blue);
+    }
+
+    /**
+     * Get pixel color.
+     *
+     * @return Color with max. intensity
+     */
+    Color get() const
+    {
+        return Color(m_red, m_green, m_blue);
+    }
+
+    /**
+     * Dim pixel to black.
+     * A dim ratio of 255 means no change.
+     *
+     * @param[in] ratio Dim ratio [0; 255]
+     */
+    void dim(uint8_t ratio)
+    {
+        m_red   = (static_cast<uint16_t>(m_red) * ratio) / UINT8_MAX;
+        m_green = (static_cast<uint16_t>(m_green) * ratio) / UINT8_MAX;
+        m_blue  = (static_cast<uint16_t>(m_blue) * ratio) / UINT8_MAX;
+    }
+
+    /**
+     * Compare with another pixel.
+     *
+     * @param[in] pixel Pixel to compare with
+     *
+     * @return If both pixels are equal, it will return true otherwise false.
+     */
+    bool operator==(const Rgb888Pixel& pixel) const
+    {
+        return (m_red == pixel.m_red) && (m_green == pixel.m_green) && (m_blue == pixel.m_blue);
+    }
+
+    /**
+     * Compare with another pixel.
+     *
+     * @param[in] pixel Pixel to compare with
+     *
+     * @return If both pixels are not equal, it will return true otherwise false.
+     */
+    bool operator!=(const Rgb888Pixel& pixel) const
+    {
+        return !(*this == pixel);
+    }
+
+private:
+
+    uint8_t m_red;      /**< Red value */
+    uint8_t m_green;    /**< Green value */
+    uint8_t m_blue;     /**< Blue value */
+};
+
+/**
+ * Pixel stored in RGB565 format (2 byte).
+ * In contrast to the Color, the intensity is applied on write. Therefore
+ * dimming a pixel is destructive. The lower bits of the base colors are lost.
+ */
+class Rgb565Pixel
+{
+public:
+
+    /**
+     * Constructs a black pixel.
+     */
+    Rgb565Pixel() :
+        m_value(0U)
+    {
+    }
+
+    /**
+     * Constructs a pixel from a color. The color intensity is applied.
+     *
+     * @param[in] color Color
+     */
+    explicit Rgb565Pixel(const Color& color) :
+        m_value(color.to565())
+    {
+    }
+
+    /**
+     * Get pixel color.
+     *
+     * @return Color with max. intensity
+     */
+    Color get() const
+    {
+        const uint8_t RED5      = (m_value >> 11U) & 0x1fU;
+        const uint8_t GREEN6    = (m_value >> 5U) & 0x3fU;
+        const uint8_t BLUE5     = (m_value >> 0U) & 0x1fU;
+
+        /* Replicate the upper bits to the lower bits to reach the full range. */
+        return Color(   (RED5 << 3U) | (RED5 >> 2U),
+                        (GREEN6 << 2U) | (GREEN6 >> 4U),
+                        (BLUE5 << 3U) | (BLUE5 >> 2U));
+    }
+
+    /**
+     * Dim pixel to black.
+     * A dim ratio of 255 means no change.
+     *
+     * @param[in] ratio Dim ratio [0; 255]
+     */
+    void dim(uint8_t ratio)
+    {
+        const uint16_t  RED5    = (((m_value >> 11U) & 0x1fU) * ratio) / UINT8_MAX;
+        const uint16_t  GREEN6  = (((m_value >> 5U) & 0x3fU) * ratio) / UINT8_MAX;
+        const uint16_t  BLUE5   = (((m_value >> 0U) & 0x1fU) * ratio) / UINT8_MAX;
+
+        m_value = (RED5 << 11U) | (GREEN6 << 5U) | (BLUE5 << 0U);
+    }
+
+    /**
+     * Compare with another pixel.
+     *
+     * @param[in] pixel Pixel to compare with
+     *
+     * @return If both pixels are equal, it will return true otherwise false.
+     */
+    bool operator==(const Rgb565Pixel& pixel) const
+    {
+        return m_value == pixel.m_value;
+    }
+
+    /**
+     * Compare with another pixel.
+     *
+     * @param[in] pixel Pixel to compare with
+     *
+     * @return If both pixels are not equal, it will return true otherwise false.
+     */
+    bool operator!=(const Rgb565Pixel& pixel) const
+    {
+        return m_value != pixel.m_value;
+    }
+
+private:
+
+    uint16_t    m_value;    /**< Color value in 5-6-5 RGB format */
+};
+
+/**
+ * Pixel stored in monochrome format (1 bit).
+ * A set pixel has the foreground color, otherwise its black. The pixels
+ * can't be stored one by one, therefore this type only selects the packed
+ * storage of the PixelGfx, with 32 pixels per word.
+ */
+class Mono1Pixel
+{
+public:
+
+    /** Number of pixels per storage word */
+    static const uint8_t    PIXELS_PER_WORD = 32U;
+
+private:
+
+    Mono1Pixel();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PIXELFORMAT_HPP__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,639 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Graphics with a pixel buffer in a selectable storage format
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __PIXELGFX_HPP__
+#define __PIXELGFX_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IGfx.hpp>
+#include <ColorDef.hpp>
+#include <PixelFormat.hpp>
+#include <MemPolicy.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Graphics, which draws into its own pixel buffer. The pixels are stored in
+ * the format given by the pixel type, e.g. Rgb888Pixel or Rgb565Pixel.
+ * Widgets can be drawn into it like into every other graphics interface and
+ * its content is converted to the target format by blit() or copy().
+ *
+ * @tparam TPixel Pixel storage format
+ */
+template < typename TPixel >
+class PixelGfx : public IGfx
+{
+public:
+
+    /**
+     * Constructs the graphics and allocates its black pixel buffer.
+     *
+     * @param[in] width     Width in pixel
+     * @param[in] height    Height in pixel
+     * @param[in] region    Memory region of the pixel buffer
+     */
+    PixelGfx(uint16_t width, uint16_t height, MemPolicy::Region region = MemPolicy::REGION_FAST) :
+        IGfx(width, height),
+        m_buffer(MemPolicy::allocateArray<TPixel>(region, width * height))
+    {
+        /* Nothing is drawn without a pixel buffer. */
+        if (nullptr == m_buffer)
+        {
+            setBaseClip(0, 0, -1, -1);
+        }
+    }
+
+    /**
+     * Destroys the graphics and releases its pixel buffer.
+     */
+    ~PixelGfx()
+    {
+        MemPolicy::releaseArray(m_buffer, getWidth() * getHeight());
+        m_buffer = nullptr;
+    }
+
+    /**
+     * Is the pixel buffer allocated?
+     *
+     * @return If allocated, it will return true otherwise false.
+     */
+    bool isAllocated() const
+    {
+        return (nullptr != m_buffer);
+    }
+
+    /**
+     * Get size of the pixel buffer.
+     *
+     * @return Buffer size in byte
+     */
+    size_t getBufferSize() const
+    {
+        return sizeof(TPixel) * getWidth() * getHeight();
+    }
+
+    /**
+     * Copy the whole content to the given graphics interface and convert
+     * it to its color format.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left destination pixel
+     * @param[in] y     y-coordinate of the upper left destination pixel
+     */
+    void blit(IGfx& gfx, int16_t x, int16_t y) const
+    {
+        blit(gfx, x, y, 0U, getWidth());
+
+        return;
+    }
+
+    /**
+     * Copy a window of columns to the given graphics interface and convert
+     * it to its color format. The window is limited to the buffer.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left destination pixel
+     * @param[in] y     y-coordinate of the upper left destination pixel
+     * @param[in] srcX  x-coordinate of the first column in the buffer
+     * @param[in] width Number of columns
+     */
+    void blit(IGfx& gfx, int16_t x, int16_t y, uint16_t srcX, uint16_t width) const
+    {
+        Color   row[COPY_SPAN_LENGTH];
+        int16_t rowY    = 0;
+
+        if ((nullptr == m_buffer) ||
+            (getWidth() <= srcX))
+        {
+            return;
+        }
+
+        if ((getWidth() - srcX) < width)
+        {
+            width = getWidth() - srcX;
+        }
+
+        for(rowY = 0; rowY < getHeight(); ++rowY)
+        {
+            const TPixel*   pixel   = &m_buffer[srcX + rowY * getWidth()];
+            uint16_t        index   = 0U;
+
+            while(width > index)
+            {
+                uint16_t chunkLength    = width - index;
+                uint16_t chunkIndex     = 0U;
+
+                if (COPY_SPAN_LENGTH < chunkLength)
+                {
+                    chunkLength = COPY_SPAN_LENGTH;
+                }
+
+                for(chunkIndex = 0U; chunkIndex < chunkLength; ++chunkIndex)
+                {
+                    row[chunkIndex] = pixel[index + chunkIndex].get();
+                }
+
+                gfx.writeSpan(x + index, y + rowY, row, chunkLength);
+
+                index += chunkLength;
+            }
+        }
+
+        return;
+    }
+
+private:
+
+    TPixel* m_buffer;   /**< Pixel buffer */
+
+    PixelGfx();
+    PixelGfx(const PixelGfx& gfx);
+    PixelGfx& operator=(const PixelGfx& gfx);
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    Color getColorUnchecked(int16_t x, int16_t y) const final
+    {
+        return m_buffer[x + y * getWidth()].get();
+    }
+
+    /**
+     * Draw a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
+     */
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
+    {
+        m_buffer[x + y * getWidth()] = TPixel(color);
+
+        return;
+    }
+
+    /**
+     * Dim pixel to black.
+     * A dim ratio of 255 means no change.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] ratio Dim ratio [0; 255]
+     */
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
+    {
+        m_buffer[x + y * getWidth()].dim(ratio);
+
+        return;
+    }
+
+    /**
+     * Fill a horizontal run of pixels with a single color.
+     * The color is converted to the storage format only once.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        const TPixel    PIXEL   = TPixel(color);
+        TPixel*         pixel   = &m_buffer[x + y * getWidth()];
+        uint16_t        index   = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            pixel[index] = PIXEL;
+        }
+
+        return;
+    }
+
+    /**
+     * Fill a vertical run of pixels with a single color.
+     * The color is converted to the storage format only once.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        const TPixel    PIXEL   = TPixel(color);
+        TPixel*         pixel   = &m_buffer[x + y * getWidth()];
+        uint16_t        index   = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            *pixel  = PIXEL;
+            pixel  += getWidth();
+        }
+
+        return;
+    }
+};
+
+/**
+ * Graphics with a monochrome pixel buffer, 1 bit per pixel. Every drawn pixel,
+ * which is not black, is set and shown in the foreground color. Therefore
+ * its suitable for monochrome content, like a single colored text or masks.
+ *
+ * The pixels are packed in 32-bit words per row, bit 0 is the leftmost
+ * pixel. Filling and copying works on whole words where possible.
+ */
+template <>
+class PixelGfx<Mono1Pixel> : public IGfx
+{
+public:
+
+    /**
+     * Constructs the graphics and allocates its pixel buffer, with all
+     * pixels cleared.
+     *
+     * @param[in] width         Width in pixel
+     * @param[in] height        Height in pixel
+     * @param[in] foreground    Color of the set pixels
+     */
+    PixelGfx(uint16_t width, uint16_t height, const Color& foreground = ColorDef::WHITE) :
+        IGfx(width, height),
+        m_foreground(foreground),
+        m_wordsPerRow((width + Mono1Pixel::PIXELS_PER_WORD - 1U) / Mono1Pixel::PIXELS_PER_WORD),
+        m_buffer(MemPolicy::allocateArray<uint32_t>(MemPolicy::REGION_FAST, m_wordsPerRow * height))
+    {
+        /* Nothing is drawn without a pixel buffer. */
+        if (nullptr == m_buffer)
+        {
+            setBaseClip(0, 0, -1, -1);
+        }
+    }
+
+    /**
+     * Destroys the graphics and releases its pixel buffer.
+     */
+    ~PixelGfx()
+    {
+        MemPolicy::releaseArray(m_buffer, m_wordsPerRow * getHeight());
+        m_buffer = nullptr;
+    }
+
+    /**
+     * Is the pixel buffer allocated?
+     *
+     * @return If allocated, it will return true otherwise false.
+     */
+    bool isAllocated() const
+    {
+        return (nullptr != m_buffer);
+    }
+
+    /**
+     * Get size of the pixel buffer.
+     *
+     * @return Buffer size in byte
+     */
+    size_t getBufferSize() const
+    {
+        return sizeof(uint32_t) * m_wordsPerRow * getHeight();
+    }
+
+    /**
+     * Set the color of the set pixels.
+     *
+     * @param[in] foreground    Foreground color
+     */
+    void setForeground(const Color& foreground)
+    {
+        m_foreground = foreground;
+    }
+
+    /**
+     * Get the color of the set pixels.
+     *
+     * @return Foreground color
+     */
+    const Color& getForeground() const
+    {
+        return m_foreground;
+    }
+
+    /**
+     * Get number of words per row.
+     *
+     * @return Number of words per row
+     */
+    uint16_t getWordsPerRow() const
+    {
+        return m_wordsPerRow;
+    }
+
+    /**
+     * Get a row of packed pixels, e.g. to process it word by word.
+     *
+     * @param[in] y y-coordinate
+     *
+     * @return If available, the row will be returned otherwise nullptr.
+     */
+    uint32_t* getRow(int16_t y)
+    {
+        uint32_t* row = nullptr;
+
+        if ((nullptr != m_buffer) &&
+            (0 <= y) &&
+            (getHeight() > y))
+        {
+            row = &m_buffer[y * m_wordsPerRow];
+        }
+
+        return row;
+    }
+
+    /**
+     * Copy the whole content to the given graphics interface. The set
+     * pixels are drawn in the foreground color as runs. If transparent,
+     * the cleared pixels are skipped otherwise they are drawn black.
+     *
+     * @param[in] gfx           Graphics interface
+     * @param[in] x             x-coordinate of the upper left destination pixel
+     * @param[in] y             y-coordinate of the upper left destination pixel
+     * @param[in] isTransparent Skip cleared pixels (true) or draw them black (false)
+     */
+    void blit(IGfx& gfx, int16_t x, int16_t y, bool isTransparent = true) const
+    {
+        int16_t rowY = 0;
+
+        if (nullptr == m_buffer)
+        {
+            return;
+        }
+
+        for(rowY = 0; rowY < getHeight(); ++rowY)
+        {
+            const uint32_t* row     = &m_buffer[rowY * m_wordsPerRow];
+            uint16_t        index   = 0U;
+
+            while(getWidth() > index)
+            {
+                const uint32_t  WORD    = row[index / Mono1Pixel::PIXELS_PER_WORD];
+                const uint8_t   BIT     = index % Mono1Pixel::PIXELS_PER_WORD;
+                const bool      IS_SET  = (0U != (WORD & (1U << BIT)));
+                uint16_t        end     = index + 1U;
+
+                /* A whole word of cleared pixels is skipped at once. */
+                if ((true == isTransparent) &&
+                    (0U == BIT) &&
+                    (0U == WORD))
+                {
+                    index += Mono1Pixel::PIXELS_PER_WORD;
+                    continue;
+                }
+
+                /* Find the end of the run with the same pixel state. */
+                while((getWidth() > end) &&
+                      (IS_SET == (0U != (row[end / Mono1Pixel::PIXELS_PER_WORD] & (1U << (end % Mono1Pixel::PIXELS_PER_WORD))))))
+                {
+                    ++end;
+                }
+
+                if (true == IS_SET)
+                {
+                    gfx.fillSpan(x + index, y + rowY, end - index, m_foreground);
+                }
+                else if (false == isTransparent)
+                {
+                    gfx.fillSpan(x + index, y + rowY, end - index, ColorDef::BLACK);
+                }
+                else
+                {
+                    ;
+                }
+
+                index = end;
+            }
+        }
+
+        return;
+    }
+
+private:
+
+    Color       m_foreground;   /**< Color of the set pixels */
+    uint16_t    m_wordsPerRow;  /**< Number of words per row */
+    uint32_t*   m_buffer;       /**< Packed pixel buffer */
+
+    PixelGfx();
+    PixelGfx(const PixelGfx& gfx);
+    PixelGfx& operator=(const PixelGfx& gfx);
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Foreground color if the pixel is set, otherwise black.
+     */
+    Color getColorUnchecked(int16_t x, int16_t y) const final
+    {
+        Color color;
+
+        if (0U != (getWord(x, y) & getMask(x)))
+        {
+            color = m_foreground;
+        }
+
+        return color;
+    }
+
+    /**
+     * Draw a single pixel. Its set, if the color is not black.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
+     */
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
+    {
+        if (true == isSet(color))
+        {
+            getWord(x, y) |= getMask(x);
+        }
+        else
+        {
+            getWord(x, y) &= ~getMask(x);
+        }
+
+        return;
+    }
+
+    /**
+     * Dim pixel to black. A pixel can't be dimmed partly, therefore
+     * its cleared if the ratio is less than the half.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] ratio Dim ratio [0; 255]
+     */
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
+    {
+        if ((UINT8_MAX / 2U) > ratio)
+        {
+            getWord(x, y) &= ~getMask(x);
+        }
+
+        return;
+    }
+
+    /**
+     * Fill a horizontal run of pixels. Its set, if the color is not black.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color
+     */
+    void fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final
+    {
+        fillBits(&m_buffer[y * m_wordsPerRow], x, static_cast<int32_t>(x) + length, isSet(color));
+
+        return;
+    }
+
+    /**
+     * Is a pixel with the given color set?
+     *
+     * @param[in] color Color
+     *
+     * @return If set, it will return true otherwise false.
+     */
+    static bool isSet(const Color& color)
+    {
+        return (0U != static_cast<uint32_t>(color));
+    }
+
+    /**
+     * Get the mask of the pixel in its word.
+     *
+     * @param[in] x x-coordinate
+     *
+     * @return Mask
+     */
+    static uint32_t getMask(int16_t x)
+    {
+        return 1U << (x % Mono1Pixel::PIXELS_PER_WORD);
+    }
+
+    /**
+     * Get the word, which contains the pixel.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Word
+     */
+    uint32_t& getWord(int16_t x, int16_t y) const
+    {
+        return m_buffer[(x / Mono1Pixel::PIXELS_PER_WORD) + y * m_wordsPerRow];
+    }
+
+    /**
+     * Set or clear the bits [x1; x2[ of a row, word by word.
+     *
+     * @param[in] row   Row
+     * @param[in] x1    First pixel
+     * @param[in] x2    Pixel after the last one
+     * @param[in] isSet Set (true) or clear (false) the bits
+     */
+    static void fillBits(uint32_t* row, int32_t x1, int32_t x2, bool isSet)
+    {
+        while(x1 < x2)
+        {
+            const uint8_t   BIT     = x1 % Mono1Pixel::PIXELS_PER_WORD;
+            int32_t         count   = Mono1Pixel::PIXELS_PER_WORD - BIT;
+            uint32_t        mask    = UINT32_MAX;
+            uint32_t&       word    = row[x1 / Mono1Pixel::PIXELS_PER_WORD];
+
+            if ((x2 - x1) < count)
+            {
+                count = x2 - x1;
+            }
+
+            if (Mono1Pixel::PIXELS_PER_WORD > count)
+            {
+                mask = ((1U << count) - 1U) << BIT;
+            }
+
+            if (true == isSet)
+            {
+                word |= mask;
+            }
+            else
+            {
+                word &= ~mask;
+            }
+
+            x1 += count;
+        }
+
+        return;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PIXELGFX_HPP__ */
+
+/** @} */
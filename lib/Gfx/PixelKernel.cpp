@@ -0,0 +1,245 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pixel span kernels
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PixelKernel.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static inline uint16_t toWeight(uint8_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Mask of the red and blue color channel. */
+static const uint32_t   MASK_RB     = 0x00ff00ffU;
+
+/** Mask of the green color channel. */
+static const uint32_t   MASK_G      = 0x0000ff00U;
+
+/** Mask of all color channels. */
+static const uint32_t   MASK_RGB    = 0x00ffffffU;
+
+/** Mask of the most significant bit of every color channel. */
+static const uint32_t   MASK_MSB    = 0x00808080U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern void PixelKernel::Reference::scale(uint32_t* dst, const uint32_t* src, uint16_t length, uint8_t factor)
+{
+    const uint16_t  WEIGHT  = toWeight(factor);
+    uint16_t        index   = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        const uint32_t  PIXEL   = src[index];
+        const uint32_t  RED     = (((PIXEL >> 16U) & 0xffU) * WEIGHT) >> 8U;
+        const uint32_t  GREEN   = (((PIXEL >> 8U) & 0xffU) * WEIGHT) >> 8U;
+        const uint32_t  BLUE    = (((PIXEL >> 0U) & 0xffU) * WEIGHT) >> 8U;
+
+        dst[index] = (RED << 16U) | (GREEN << 8U) | (BLUE << 0U);
+    }
+
+    return;
+}
+
+extern void PixelKernel::Reference::blend(uint32_t* dst, const uint32_t* src1, const uint32_t* src2, uint16_t length, uint8_t ratio)
+{
+    const uint16_t  WEIGHT2 = toWeight(ratio);
+    const uint16_t  WEIGHT1 = 256U - WEIGHT2;
+    uint16_t        index   = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        const uint32_t  PIXEL1  = src1[index];
+        const uint32_t  PIXEL2  = src2[index];
+        const uint32_t  RED     = (((PIXEL1 >> 16U) & 0xffU) * WEIGHT1 + ((PIXEL2 >> 16U) & 0xffU) * WEIGHT2) >> 8U;
+        const uint32_t  GREEN   = (((PIXEL1 >> 8U) & 0xffU) * WEIGHT1 + ((PIXEL2 >> 8U) & 0xffU) * WEIGHT2) >> 8U;
+        const uint32_t  BLUE    = (((PIXEL1 >> 0U) & 0xffU) * WEIGHT1 + ((PIXEL2 >> 0U) & 0xffU) * WEIGHT2) >> 8U;
+
+        dst[index] = (RED << 16U) | (GREEN << 8U) | (BLUE << 0U);
+    }
+
+    return;
+}
+
+extern void PixelKernel::Reference::addSaturated(uint32_t* dst, const uint32_t* src, uint16_t length)
+{
+    uint16_t index = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        uint32_t    pixel   = 0U;
+        uint8_t     shift   = 0U;
+
+        for(shift = 0U; shift <= 16U; shift += 8U)
+        {
+            uint32_t value = ((dst[index] >> shift) & 0xffU) + ((src[index] >> shift) & 0xffU);
+
+            if (UINT8_MAX < value)
+            {
+                value = UINT8_MAX;
+            }
+
+            pixel |= value << shift;
+        }
+
+        dst[index] = pixel;
+    }
+
+    return;
+}
+
+extern void PixelKernel::Packed::scale(uint32_t* dst, const uint32_t* src, uint16_t length, uint8_t factor)
+{
+    const uint32_t  WEIGHT  = toWeight(factor);
+    uint16_t        index   = 0U;
+
+    /* Red and blue are multiplied at once. The products need max. 16 bit and
+     * can't overlap.
+     */
+    for(index = 0U; index < length; ++index)
+    {
+        const uint32_t  PIXEL   = src[index];
+        const uint32_t  RB      = (((PIXEL & MASK_RB) * WEIGHT) >> 8U) & MASK_RB;
+        const uint32_t  G       = (((PIXEL & MASK_G) * WEIGHT) >> 8U) & MASK_G;
+
+        dst[index] = RB | G;
+    }
+
+    return;
+}
+
+extern void PixelKernel::Packed::blend(uint32_t* dst, const uint32_t* src1, const uint32_t* src2, uint16_t length, uint8_t ratio)
+{
+    const uint32_t  WEIGHT2 = toWeight(ratio);
+    const uint32_t  WEIGHT1 = 256U - WEIGHT2;
+    uint16_t        index   = 0U;
+
+    /* The weights sum up to 256, therefore the sum of the products of a
+     * channel needs max. 16 bit too.
+     */
+    for(index = 0U; index < length; ++index)
+    {
+        const uint32_t  PIXEL1  = src1[index];
+        const uint32_t  PIXEL2  = src2[index];
+        const uint32_t  RB      = ((((PIXEL1 & MASK_RB) * WEIGHT1) + ((PIXEL2 & MASK_RB) * WEIGHT2)) >> 8U) & MASK_RB;
+        const uint32_t  G       = ((((PIXEL1 & MASK_G) * WEIGHT1) + ((PIXEL2 & MASK_G) * WEIGHT2)) >> 8U) & MASK_G;
+
+        dst[index] = RB | G;
+    }
+
+    return;
+}
+
+extern void PixelKernel::Packed::addSaturated(uint32_t* dst, const uint32_t* src, uint16_t length)
+{
+    uint16_t index = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        const uint32_t  PIXEL1  = dst[index] & MASK_RGB;
+        const uint32_t  PIXEL2  = src[index] & MASK_RGB;
+
+        /* Add without the most significant bits, so no carry crosses a channel border. */
+        const uint32_t  LOW_SUM = (PIXEL1 & ~MASK_MSB) + (PIXEL2 & ~MASK_MSB);
+        const uint32_t  SUM     = LOW_SUM ^ ((PIXEL1 ^ PIXEL2) & MASK_MSB);
+
+        /* A channel overflows, if both most significant bits are set or one of
+         * them is set together with the carry of the lower bits.
+         */
+        const uint32_t  CARRY   = ((PIXEL1 & PIXEL2) | ((PIXEL1 ^ PIXEL2) & LOW_SUM)) & MASK_MSB;
+
+        dst[index] = SUM | ((CARRY >> 7U) * 0xffU);
+    }
+
+    return;
+}
+
+extern void PixelKernel::fill(uint32_t* dst, uint16_t length, uint32_t color)
+{
+    uint16_t index = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        dst[index] = color;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Map a factor or ratio in [0; 255] to a weight in [0; 256].
+ *
+ * @param[in] value Factor or ratio [0; 255]
+ *
+ * @return Weight [0; 256]
+ */
+static inline uint16_t toWeight(uint8_t value)
+{
+    return static_cast<uint16_t>(value) + (value >> 7U);
+}
@@ -0,0 +1,223 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pixel span kernels
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __PIXEL_KERNEL_H__
+#define __PIXEL_KERNEL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Select the kernel implementation:
+ * 0: Reference implementation, which processes every color channel on its own.
+ * 1: Packed implementation, which processes two color channels with a single
+ *    32-bit operation.
+ */
+#ifndef PIXEL_KERNEL_PACKED
+#ifdef ESP32
+#define PIXEL_KERNEL_PACKED (1)
+#else   /* ESP32 */
+#define PIXEL_KERNEL_PACKED (0)
+#endif  /* ESP32 */
+#endif  /* PIXEL_KERNEL_PACKED */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Kernels, which process a span of pixels in RGB888 format (0x00RRGGBB).
+ * Factors and ratios in [0; 255] are mapped to weights in [0; 256], so the
+ * max. value results in no change and a shift replaces the division.
+ * All implementations deliver bit exact the same results.
+ */
+namespace PixelKernel
+{
+
+/** Reference implementation */
+namespace Reference
+{
+
+/**
+ * Scale the pixels to black.
+ *
+ * @param[out] dst      Destination pixels, may be the same as the source
+ * @param[in]  src      Source pixels
+ * @param[in]  length   Number of pixels
+ * @param[in]  factor   Scale factor [0; 255] - 0: black / 255: no change
+ */
+extern void scale(uint32_t* dst, const uint32_t* src, uint16_t length, uint8_t factor);
+
+/**
+ * Alpha blend two pixel spans.
+ *
+ * @param[out] dst      Destination pixels, may be the same as one of the sources
+ * @param[in]  src1     First source pixels
+ * @param[in]  src2     Second source pixels
+ * @param[in]  length   Number of pixels
+ * @param[in]  ratio    Blend ratio [0; 255] - 0: only first source / 255: only second source
+ */
+extern void blend(uint32_t* dst, const uint32_t* src1, const uint32_t* src2, uint16_t length, uint8_t ratio);
+
+/**
+ * Add the source pixels to the destination pixels. Every color channel
+ * saturates at its max. value.
+ *
+ * @param[in,out] dst       Destination pixels
+ * @param[in]     src       Source pixels
+ * @param[in]     length    Number of pixels
+ */
+extern void addSaturated(uint32_t* dst, const uint32_t* src, uint16_t length);
+
+}
+
+/** Packed implementation, which uses 32-bit arithmetic for several color channels at once. */
+namespace Packed
+{
+
+/**
+ * Scale the pixels to black.
+ *
+ * @param[out] dst      Destination pixels, may be the same as the source
+ * @param[in]  src      Source pixels
+ * @param[in]  length   Number of pixels
+ * @param[in]  factor   Scale factor [0; 255] - 0: black / 255: no change
+ */
+extern void scale(uint32_t* dst, const uint32_t* src, uint16_t length, uint8_t factor);
+
+/**
+ * Alpha blend two pixel spans.
+ *
+ * @param[out] dst      Destination pixels, may be the same as one of the sources
+ * @param[in]  src1     First source pixels
+ * @param[in]  src2     Second source pixels
+ * @param[in]  length   Number of pixels
+ * @param[in]  ratio    Blend ratio [0; 255] - 0: only first source / 255: only second source
+ */
+extern void blend(uint32_t* dst, const uint32_t* src1, const uint32_t* src2, uint16_t length, uint8_t ratio);
+
+/**
+ * Add the source pixels to the destination pixels. Every color channel
+ * saturates at its max. value.
+ *
+ * @param[in,out] dst       Destination pixels
+ * @param[in]     src       Source pixels
+ * @param[in]     length    Number of pixels
+ */
+extern void addSaturated(uint32_t* dst, const uint32_t* src, uint16_t length);
+
+}
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Scale the pixels to black, using the selected implementation.
+ *
+ * @param[out] dst      Destination pixels, may be the same as the source
+ * @param[in]  src      Source pixels
+ * @param[in]  length   Number of pixels
+ * @param[in]  factor   Scale factor [0; 255] - 0: black / 255: no change
+ */
+inline void scale(uint32_t* dst, const uint32_t* src, uint16_t length, uint8_t factor)
+{
+#if (0 != PIXEL_KERNEL_PACKED)
+    Packed::scale(dst, src, length, factor);
+#else
+    Reference::scale(dst, src, length, factor);
+#endif
+}
+
+/**
+ * Alpha blend two pixel spans, using the selected implementation.
+ *
+ * @param[out] dst      Destination pixels, may be the same as one of the sources
+ * @param[in]  src1     First source pixels
+ * @param[in]  src2     Second source pixels
+ * @param[in]  length   Number of pixels
+ * @param[in]  ratio    Blend ratio [0; 255] - 0: only first source / 255: only second source
+ */
+inline void blend(uint32_t* dst, const uint32_t* src1, const uint32_t* src2, uint16_t length, uint8_t ratio)
+{
+#if (0 != PIXEL_KERNEL_PACKED)
+    Packed::blend(dst, src1, src2, length, ratio);
+#else
+    Reference::blend(dst, src1, src2, length, ratio);
+#endif
+}
+
+/**
+ * Add the source pixels to the destination pixels, using the selected
+ * implementation. Every color channel saturates at its max. value.
+ *
+ * @param[in,out] dst       Destination pixels
+ * @param[in]     src       Source pixels
+ * @param[in]     length    Number of pixels
+ */
+inline void addSaturated(uint32_t* dst, const uint32_t* src, uint16_t length)
+{
+#if (0 != PIXEL_KERNEL_PACKED)
+    Packed::addSaturated(dst, src, length);
+#else
+    Reference::addSaturated(dst, src, length);
+#endif
+}
+
+/**
+ * Fill the pixels with a single color.
+ *
+ * @param[out] dst      Destination pixels
+ * @param[in]  length   Number of pixels
+ * @param[in]  color    Color in RGB888 format
+ */
+extern void fill(uint32_t* dst, uint16_t length, uint32_t color);
+
+}
+
+#endif  /* __PIXEL_KERNEL_H__ */
+
+/** @} */
\ No newline at end of file
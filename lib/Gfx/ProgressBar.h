@@ -114,6 +114,8 @@ public:
         m_color     = widget.m_color;
         m_algorithm = widget.m_algorithm;
 
+        invalidate();
+
         return *this;
     }
 
@@ -140,6 +142,8 @@ public:
             m_progress = progress;
         }
 
+        invalidate();
+
         return;
     }
 
@@ -151,6 +155,8 @@ public:
     void setColor(const Color& color)
     {
         m_color = color;
+        invalidate();
+
         return;
     }
 
@@ -164,6 +170,7 @@ public:
         if (ALGORITHM_MAX > algorithm)
         {
             m_algorithm = algorithm;
+            invalidate();
         }
 
         return;
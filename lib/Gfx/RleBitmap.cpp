@@ -1,110 +1,112 @@
-/* MIT License
- *
- * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all
- * copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
- * SOFTWARE.
- */
-
-/*******************************************************************************
-    DESCRIPTION
-*******************************************************************************/
-/**
- * @brief  HTTP header
- * @author Andreas Merkle <web@blue-andi.de>
- */
-
-/******************************************************************************
- * Includes
- *****************************************************************************/
-#include "HttpHeader.h"
-
-/******************************************************************************
- * Compiler Switches
- *****************************************************************************/
-
-/******************************************************************************
- * Macros
- *****************************************************************************/
-
-/******************************************************************************
- * Types and classes
- *****************************************************************************/
-
-/******************************************************************************
- * Prototypes
- *****************************************************************************/
-
-/******************************************************************************
- * Local Variables
- *****************************************************************************/
-
-/******************************************************************************
- * Public Methods
- *****************************************************************************/
-
-HttpHeader& HttpHeader::operator=(const HttpHeader& hdr)
-{
-    if (this != &hdr)
-    {
-        m_name = hdr.m_name;
-        m_value = hdr.m_value;
-    }
-
-    return *this;
-}
-
-void HttpHeader::parse(const String& line)
-{
-    int idx = line.indexOf(':');
-
-    if (0 <= idx)
-    {
-        m_name = line.substring(0, idx);
-        m_value = line.substring(idx + 2);
-
-        /* There may be CRLF at the end, which must be removed. */
-        idx = m_value.indexOf("\r\n");
-
-        if (0 <= idx)
-        {
-            m_value.remove(idx);
-        }
-    }
-}
-
-String HttpHeader::toString() const
-{
-    return String(m_name + ": " + m_value);
-}
-
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
-
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
-
-/******************************************************************************
- * External Functions
- *****************************************************************************/
-
-/******************************************************************************
- * Local Functions
- *****************************************************************************/
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Run-length encoded bitmap
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "RleBitmap.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void RleBitmap::draw(IGfx& gfx, int16_t x, int16_t y) const
+{
+    uint16_t    column  = 0U;
+    uint16_t    row     = 0U;
+    size_t      index   = 0U;
+
+    if ((nullptr == runs) ||
+        (nullptr == palette))
+    {
+        return;
+    }
+
+    while((runCount > index) && (height > row))
+    {
+        uint8_t     run         = runs[index];
+        uint8_t     colorIndex  = run >> LENGTH_BITS;
+        uint16_t    length      = static_cast<uint16_t>(run & LENGTH_MASK) + 1U;
+
+        if ((COLOR_TRANSPARENT != colorIndex) &&
+            (paletteSize >= colorIndex))
+        {
+            gfx.fillSpan(x + static_cast<int16_t>(column), y + static_cast<int16_t>(row), length, palette[colorIndex - 1U]);
+        }
+
+        column += length;
+        if (width <= column)
+        {
+            column = 0U;
+            ++row;
+        }
+
+        ++index;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
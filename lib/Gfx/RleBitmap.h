@@ -0,0 +1,114 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Run-length encoded bitmap
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __RLEBITMAP_H__
+#define __RLEBITMAP_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <IGfx.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A bitmap with a small color palette, which is stored run-length encoded.
+ * It is intended for constant bitmaps, which are generated at build time and
+ * stay in the program memory. Drawing it needs no heap and no decode buffer,
+ * because every run is written directly as horizontal span.
+ *
+ * Every byte is one run: the upper 3 bits are the color index and the lower
+ * 5 bits are the run length minus 1. Color index 0 is transparent, the other
+ * indices refer to the palette entries 0 to 6. The runs are ordered row by
+ * row and a run never crosses the end of a row.
+ *
+ * The bitmap is an aggregate, so a constant instance is initialized at
+ * compile time and needs no constructor call.
+ */
+struct RleBitmap
+{
+    /** Number of bits of the run length. */
+    static const uint8_t    LENGTH_BITS         = 5U;
+
+    /** Mask of the run length. */
+    static const uint8_t    LENGTH_MASK         = (1U << LENGTH_BITS) - 1U;
+
+    /** Max. run length in pixels. */
+    static const uint8_t    MAX_RUN_LENGTH      = LENGTH_MASK + 1U;
+
+    /** Color index of transparent runs. */
+    static const uint8_t    COLOR_TRANSPARENT   = 0U;
+
+    /** Max. number of palette colors. */
+    static const uint8_t    MAX_PALETTE_SIZE    = (UINT8_MAX >> LENGTH_BITS);
+
+    uint16_t        width;          /**< Bitmap width in pixels */
+    uint16_t        height;         /**< Bitmap height in pixels */
+    const uint32_t* palette;        /**< Palette colors in RGB888 format */
+    uint8_t         paletteSize;    /**< Number of palette colors */
+    const uint8_t*  runs;           /**< Runs */
+    size_t          runCount;       /**< Number of runs */
+
+    /**
+     * Draw the bitmap with its top left corner at the given position.
+     * Pixels outside the canvas are clipped, which allows to scroll the
+     * bitmap in and out.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the top left corner
+     * @param[in] y     y-coordinate of the top left corner
+     */
+    void draw(IGfx& gfx, int16_t x, int16_t y) const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __RLEBITMAP_H__ */
+
+/** @} */
@@ -0,0 +1,213 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sprite Widget
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SpriteWidget.h"
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize sprite widget type. */
+const char* SpriteWidget::WIDGET_TYPE = "sprite";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SpriteWidget& SpriteWidget::operator=(const SpriteWidget& widget)
+{
+    if (&widget != this)
+    {
+        clear();
+        copy(widget);
+    }
+
+    return *this;
+}
+
+void SpriteWidget::update(IGfx& gfx)
+{
+    if (0U < m_frameCount)
+    {
+        const uint16_t FRAME_INDEX = getFrameIndex();
+
+        drawColumns(gfx, FRAME_INDEX * m_frameWidth, m_frameWidth);
+        m_shownFrame = FRAME_INDEX;
+    }
+
+    return;
+}
+
+bool SpriteWidget::set(const Color* sheet, uint16_t width, uint16_t height, uint16_t frameWidth)
+{
+    bool status = false;
+
+    if ((0U < frameWidth) &&
+        (0U == (width % frameWidth)) &&
+        (true == BitmapWidget::set(sheet, width, height)))
+    {
+        m_frameWidth    = frameWidth;
+        m_frameCount    = width / frameWidth;
+        m_filename.clear();
+
+        restart();
+
+        status = true;
+    }
+
+    return status;
+}
+
+void SpriteWidget::restart()
+{
+    m_startTimestamp    = millis();
+    m_shownFrame        = 0U;
+    invalidate();
+
+    return;
+}
+
+void SpriteWidget::clear()
+{
+    BitmapWidget::clear();
+
+    m_frameWidth    = 0U;
+    m_frameCount    = 0U;
+    m_shownFrame    = 0U;
+    m_filename.clear();
+
+    return;
+}
+
+#ifndef NATIVE
+
+bool SpriteWidget::load(FS& fs, const String& filename)
+{
+    bool            status      = false;
+    const bool      IS_RELOAD   = (filename == m_filename);
+    const uint32_t  TIMESTAMP   = m_startTimestamp;
+
+    if (true == BitmapWidget::load(fs, filename))
+    {
+        uint16_t width  = 0U;
+        uint16_t height = 0U;
+
+        getSize(width, height);
+
+        if ((0U < height) &&
+            (0U == (width % height)))
+        {
+            m_frameWidth = height;
+        }
+        else
+        {
+            m_frameWidth = width;
+        }
+
+        m_frameCount = (0U < m_frameWidth) ? (width / m_frameWidth) : 0U;
+
+        restart();
+
+        /* A reloaded animation continues, instead of restarting. */
+        if (true == IS_RELOAD)
+        {
+            m_startTimestamp = TIMESTAMP;
+        }
+
+        m_filename  = filename;
+        status      = true;
+    }
+
+    return status;
+}
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint16_t SpriteWidget::getFrameIndex() const
+{
+    uint16_t frameIndex = 0U;
+
+    if (1U < m_frameCount)
+    {
+        frameIndex = ((millis() - m_startTimestamp) / m_frameDuration) % m_frameCount;
+    }
+
+    return frameIndex;
+}
+
+void SpriteWidget::copy(const SpriteWidget& widget)
+{
+    BitmapWidget::operator=(widget);
+
+    m_frameWidth        = widget.m_frameWidth;
+    m_frameCount        = widget.m_frameCount;
+    m_frameDuration     = widget.m_frameDuration;
+    m_startTimestamp    = widget.m_startTimestamp;
+    m_filename          = widget.m_filename;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
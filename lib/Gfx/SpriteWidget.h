@@ -0,0 +1,277 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sprite Widget
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __SPRITEWIDGET_H__
+#define __SPRITEWIDGET_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <BitmapWidget.h>
+
+#ifndef NATIVE
+#include <FS.h>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Sprite widget, showing an animation of several frames.
+ *
+ * The frames are given as sprite sheet, which is a bitmap with all frames
+ * side by side. The sheet is stored palette indexed like by the bitmap
+ * widget. The frame, which is shown, depends only on the time, therefore
+ * no decoding is necessary during the animation.
+ *
+ * A sheet with a single frame is shown like a static bitmap.
+ */
+class SpriteWidget : public BitmapWidget
+{
+public:
+
+    /**
+     * Constructs a sprite widget, which is empty.
+     */
+    SpriteWidget() :
+        BitmapWidget(WIDGET_TYPE),
+        m_frameWidth(0U),
+        m_frameCount(0U),
+        m_frameDuration(DEFAULT_FRAME_DURATION),
+        m_startTimestamp(0U),
+        m_shownFrame(0U),
+        m_filename()
+    {
+    }
+
+    /**
+     * Constructs a sprite widget by copying another one.
+     *
+     * @param[in] widget Sprite widget, which to copy
+     */
+    SpriteWidget(const SpriteWidget& widget) :
+        BitmapWidget(WIDGET_TYPE),
+        m_frameWidth(0U),
+        m_frameCount(0U),
+        m_frameDuration(DEFAULT_FRAME_DURATION),
+        m_startTimestamp(0U),
+        m_shownFrame(0U),
+        m_filename()
+    {
+        copy(widget);
+    }
+
+    /**
+     * Destroys the sprite widget.
+     */
+    ~SpriteWidget()
+    {
+    }
+
+    /**
+     * Assigns a existing sprite widget.
+     *
+     * @param[in] widget Sprite widget, which to assign
+     */
+    SpriteWidget& operator=(const SpriteWidget& widget);
+
+    /**
+     * Update/Draw the current frame on the canvas.
+     *
+     * @param[in] gfx Graphics interface
+     */
+    void update(IGfx& gfx) override;
+
+    /**
+     * Is the sprite widget invalid and needs to be drawn again?
+     * An animation changes its look by itself, whenever the next frame
+     * is due.
+     *
+     * @return If invalid, it will return true otherwise false.
+     */
+    bool isInvalid() override
+    {
+        bool isInvalid = Widget::isInvalid();
+
+        if ((false == isInvalid) &&
+            (1U < m_frameCount))
+        {
+            isInvalid = (getFrameIndex() != m_shownFrame);
+        }
+
+        return isInvalid;
+    }
+
+    /**
+     * Set a new sprite sheet. The frames are side by side in the sheet.
+     * The animation starts with the first frame.
+     *
+     * @param[in] sheet         Sprite sheet
+     * @param[in] width         Sheet width in pixel
+     * @param[in] height        Sheet height in pixel, which is the frame height too
+     * @param[in] frameWidth    Frame width in pixel, the sheet width must be a multiple of it
+     *
+     * @return If successful, it will return true otherwise false, e.g. if
+     *          the sheet has more than IndexedImage::MAX_PALETTE_SIZE colors.
+     */
+    bool set(const Color* sheet, uint16_t width, uint16_t height, uint16_t frameWidth);
+
+    /**
+     * Get the number of frames.
+     *
+     * @return Number of frames
+     */
+    uint16_t getFrameCount() const
+    {
+        return m_frameCount;
+    }
+
+    /**
+     * Get frame size.
+     *
+     * @param[out] width    Frame width in pixel
+     * @param[out] height   Frame height in pixel
+     */
+    void getFrameSize(uint16_t& width, uint16_t& height) const
+    {
+        uint16_t sheetWidth = 0U;
+
+        getSize(sheetWidth, height);
+        width = m_frameWidth;
+    }
+
+    /**
+     * Set the duration how long every frame is shown.
+     *
+     * @param[in] duration  Frame duration in ms, 0 is not allowed
+     */
+    void setFrameDuration(uint32_t duration)
+    {
+        if ((0U < duration) &&
+            (m_frameDuration != duration))
+        {
+            m_frameDuration = duration;
+            invalidate();
+        }
+
+        return;
+    }
+
+    /**
+     * Get the duration how long every frame is shown.
+     *
+     * @return Frame duration in ms
+     */
+    uint32_t getFrameDuration() const
+    {
+        return m_frameDuration;
+    }
+
+    /**
+     * Restart the animation with the first frame.
+     */
+    void restart();
+
+    /**
+     * Remove the sprite sheet.
+     */
+    void clear();
+
+    #ifndef NATIVE
+
+    /**
+     * Load a sprite sheet from a bitmap file. The frames are square, which
+     * means the frame width is the bitmap height. If the bitmap width is
+     * not a multiple of it, the whole bitmap is a single frame.
+     * The sheet is shared via the image cache, like by the bitmap widget.
+     * If the same file is loaded again, e.g. because its content changed,
+     * the animation continues with the current frame.
+     *
+     * @param[in] fs        Filesystem
+     * @param[in] filename  Filename with full path
+     *
+     * @return If successful loaded it will return true otherwise false.
+     */
+    bool load(FS& fs, const String& filename);
+
+    #endif  /* NATIVE */
+
+    /** Widget type string */
+    static const char*      WIDGET_TYPE;
+
+    /** Default frame duration in ms */
+    static const uint32_t   DEFAULT_FRAME_DURATION  = 100U;
+
+private:
+
+    uint16_t    m_frameWidth;       /**< Frame width in pixel */
+    uint16_t    m_frameCount;       /**< Number of frames */
+    uint32_t    m_frameDuration;    /**< Frame duration in ms */
+    uint32_t    m_startTimestamp;   /**< Timestamp in ms, when the animation started */
+    uint16_t    m_shownFrame;       /**< Index of the last drawn frame */
+    String      m_filename;         /**< Filename of the loaded sprite sheet, empty if set directly */
+
+    /**
+     * Get the index of the frame, which shall be shown now.
+     *
+     * @return Frame index
+     */
+    uint16_t getFrameIndex() const;
+
+    /**
+     * Copy the sprite sheet and the animation of another widget.
+     *
+     * @param[in] widget Sprite widget, which to copy
+     */
+    void copy(const SpriteWidget& widget);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SPRITEWIDGET_H__ */
+
+/** @} */
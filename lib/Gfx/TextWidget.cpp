@@ -34,7 +34,9 @@
  *****************************************************************************/
 #include "TextWidget.h"
 
+#include <GlyphMetrics.h>
 #include <TomThumb.h>
+#include <Font5x8.h>
 #include <Util.h>
 
 #include <Logging.h>
@@ -51,6 +53,147 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Graphics interface, which is used to render the text layout once.
+ * It has the same size as the target canvas, but its buffer covers only a
+ * window of the text, which is moved over the whole text width. The text
+ * may be much wider than the canvas because of scrolling.
+ * Every drawn pixel is marked, which allows to keep the transparency of
+ * the text background.
+ */
+class TextLayoutGfx : public IGfx
+{
+public:
+
+    /**
+     * Constructs the graphics interface for text layout rendering.
+     *
+     * @param[in] width         Target canvas width in pixel
+     * @param[in] height        Target canvas height in pixel
+     * @param[in] bufferWidth   Buffer width in pixel
+     */
+    TextLayoutGfx(uint16_t width, uint16_t height, uint16_t bufferWidth) :
+        IGfx(width, height),
+        m_bufferX(0),
+        m_bufferWidth(bufferWidth),
+        m_buffer(new uint32_t[bufferWidth * height]())
+    {
+        setWindow(0);
+    }
+
+    /**
+     * Destroys the graphics interface.
+     */
+    ~TextLayoutGfx()
+    {
+        delete[] m_buffer;
+    }
+
+    /**
+     * Move the buffer window and clear it.
+     *
+     * @param[in] bufferX   x-coordinate of the first pixel in the buffer
+     */
+    void setWindow(int16_t bufferX)
+    {
+        uint32_t index = 0U;
+
+        for(index = 0U; index < (static_cast<uint32_t>(m_bufferWidth) * getHeight()); ++index)
+        {
+            m_buffer[index] = 0U;
+        }
+
+        m_bufferX = bufferX;
+
+        /* Only the buffer range is drawn. */
+        setBaseClip(bufferX, 0, bufferX + m_bufferWidth - 1, getHeight() - 1);
+
+        return;
+    }
+
+    /**
+     * Get x-coordinate of the first pixel in the buffer.
+     *
+     * @return x-coordinate
+     */
+    int16_t getBufferX() const
+    {
+        return m_bufferX;
+    }
+
+    /**
+     * Get a buffer row. The color is stored in RGB888 format, with the
+     * DRAWN_FLAG set for every drawn pixel.
+     *
+     * @param[in] y y-coordinate
+     *
+     * @return Buffer row
+     */
+    const uint32_t* getRow(int16_t y) const
+    {
+        return &m_buffer[y * m_bufferWidth];
+    }
+
+    /** Color bits of a buffer pixel. */
+    static const uint32_t   COLOR_MASK  = 0x00ffffffU;
+
+    /** Flag of a buffer pixel, which marks it as drawn. */
+    static const uint32_t   DRAWN_FLAG  = 0x01000000U;
+
+private:
+
+    int16_t     m_bufferX;      /**< x-coordinate of the first pixel in the buffer */
+    uint16_t    m_bufferWidth;  /**< Buffer width in pixel */
+    uint32_t*   m_buffer;       /**< Buffer with all rendered pixels */
+
+    TextLayoutGfx();
+    TextLayoutGfx(const TextLayoutGfx& gfx);
+    TextLayoutGfx& operator=(const TextLayoutGfx& gfx);
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color in RGB888 format.
+     */
+    Color getColorUnchecked(int16_t x, int16_t y) const final
+    {
+        return m_buffer[(x - m_bufferX) + y * m_bufferWidth] & COLOR_MASK;
+    }
+
+    /**
+     * Draw a single pixel and mark it as drawn.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Pixel color
+     */
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
+    {
+        m_buffer[(x - m_bufferX) + y * m_bufferWidth] = (static_cast<uint32_t>(color) & COLOR_MASK) | DRAWN_FLAG;
+
+        return;
+    }
+
+    /**
+     * Dimming is not supported, because the text is drawn only.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] ratio Dim ratio [0; 255]
+     */
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
+    {
+        UTIL_NOT_USED(x);
+        UTIL_NOT_USED(y);
+        UTIL_NOT_USED(ratio);
+
+        return;
+    }
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -68,63 +211,121 @@ const GFXfont*              TextWidget::DEFAULT_FONT        = &TomThumb;
 /* Initialize keyword list */
 TextWidget::KeywordHandler  TextWidget::m_keywordHandlers[] =
 {
-    &TextWidget::handleColor,
-    &TextWidget::handleAlignment
+    &TextWidget::parseColor,
+    &TextWidget::parseAlignment,
+    &TextWidget::parseFont
+};
+
+/* Initialize font keyword list */
+const TextWidget::FontKeyword   TextWidget::m_fontKeywords[] =
+{
+    { "fsmall", &TomThumb },
+    { "flarge", &Font5x8 }
 };
 
 /* Set default scroll pause in ms. */
 uint32_t                    TextWidget::m_scrollPause       = TextWidget::DEFAULT_SCROLL_PAUSE;
 
+/* No text span by default. */
+uint16_t                    TextWidget::m_spanWidth         = 0U;
+uint16_t                    TextWidget::m_spanOffset        = 0U;
+TextWidget::SpanClock       TextWidget::m_spanClock         = nullptr;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void TextWidget::update(IGfx& gfx)
 {
-    int16_t cursorX = m_posX;
-    int16_t cursorY = m_posY + m_font->yAdvance - 1; /* Set cursor to baseline */
-
     /* Set base parameters */
     gfx.setFont(m_font);
     gfx.setTextColor(m_textColor);
     gfx.setTextWrap(false); /* If text is too long, don't wrap around. */
 
+    /* The text is only parsed and rendered again, if something changed. */
+    if ((false == m_isLayoutValid) ||
+        (gfx.getWidth() != m_layoutWidth) ||
+        (gfx.getHeight() != m_layoutHeight) ||
+        (m_posX != m_layoutPosX) ||
+        (m_posY != m_layoutPosY))
+    {
+        updateLayout(gfx);
+    }
+
+    /* The scrolling need depends on the span too. */
+    if (getSpanWidth() != m_scrollSpanWidth)
+    {
+        m_scrollSpanWidth       = getSpanWidth();
+        m_checkScrollingNeed    = true;
+    }
+
     /* Text changed, check whether scrolling is necessary? */
     if (true == m_checkScrollingNeed)
     {
-        uint16_t    textHeight      = 0U;
-        String      str             = removeFormatTags(m_formatStr);
-
-        if (true == gfx.getTextBoundingBox(str.c_str(), m_textWidth, textHeight))
+        /* Text too long for the span? */
+        if ((0U != m_scrollSpanWidth) &&
+            (m_scrollSpanWidth < m_textWidth))
         {
-            /* Text too long for the display? */
-            if (gfx.getWidth() < m_textWidth)
-            {
-                m_isScrollingEnabled    = true;
-                m_scrollOffset          = ((-1) * gfx.getWidth()) + 1;  /* The user can see the first characters better, if starting nearly outside the canvas. */
-                m_scrollTimer.start(0U);                                /* Ensure immediate update */
-            }
-            else
-            {
-                m_isScrollingEnabled    = false;
-                m_scrollOffset          = 0;
-                m_scrollTimer.stop();
-            }
+            m_isScrollingEnabled    = true;
+        }
+        /* Text too long for the display? */
+        else if ((0U == m_scrollSpanWidth) &&
+                 (gfx.getWidth() < m_textWidth))
+        {
+            m_isScrollingEnabled    = true;
+            m_scrollOffset          = ((-1) * gfx.getWidth()) + 1;  /* The user can see the first characters better, if starting nearly outside the canvas. */
+            m_scrollTimer.start(0U);                                /* Ensure immediate update */
+        }
+        else
+        {
+            m_isScrollingEnabled    = false;
+            m_scrollOffset          = 0;
+            m_scrollTimer.stop();
         }
 
+        m_scrollTimestamp       = millis();
+        m_scrollPos             = 0U;
+        m_scrollRemainder       = 0U;
+        m_scrollFraction        = 0U;
+
         m_checkScrollingNeed    = false;
         m_scrollingCnt          = 0U;
     }
 
-    /* Move cursor to right position */
-    cursorX -= m_scrollOffset;
-    gfx.setTextCursorPos(cursorX, cursorY);
+    if ((true == m_isScrollingEnabled) &&
+        (0U != m_scrollSpanWidth))
+    {
+        updateSpanScrolling();
+    }
+    else if ((true == m_isScrollingEnabled) &&
+             (SCROLL_MODE_PIXEL != m_scrollMode))
+    {
+        updateSmoothScrolling(gfx.getWidth());
+    }
+    /* Text fits into the span, every display shows its part of it. */
+    else if (0U != m_scrollSpanWidth)
+    {
+        m_scrollOffset = static_cast<int16_t>(m_spanOffset);
+    }
+    else
+    {
+        ;
+    }
 
     /* Show text */
-    show(gfx, m_formatStr);
+    if ((SCROLL_MODE_SMOOTH_ANTIALIASED == m_scrollMode) &&
+        (0U != m_scrollFraction))
+    {
+        drawLayoutAntialiased(gfx);
+    }
+    else
+    {
+        drawLayout(gfx);
+    }
 
     /* Shall we scroll again? */
-    if (true == m_scrollTimer.isTimeout())
+    if ((SCROLL_MODE_PIXEL == m_scrollMode) &&
+        (true == m_scrollTimer.isTimeout()))
     {
         /* Text scrolls completly out, until it starts from the beginning again. */
         ++m_scrollOffset;
@@ -137,6 +338,9 @@ void TextWidget::update(IGfx& gfx)
         }
 
         m_scrollTimer.start(m_scrollPause);
+
+        /* The text moved, draw it again with the next update. */
+        invalidate();
     }
 
     return;
@@ -150,77 +354,307 @@ void TextWidget::update(IGfx& gfx)
  * Private Methods
  *****************************************************************************/
 
-String TextWidget::removeFormatTags(const String& formatStr) const
+void TextWidget::updateLayout(IGfx& gfx)
 {
-    uint32_t    index       = 0U;
-    bool        escapeFound = false;
-    bool        useChar     = false;
-    String      str;
-    uint32_t    length      = formatStr.length();
+    const int16_t   CURSOR_Y    = m_posY + m_font->yAdvance - 1; /* Set cursor to baseline */
+    int16_t         bufferX     = 0;
+    int32_t         bufferEnd   = gfx.getWidth();
+    uint32_t        runCount    = 0U;
+    int16_t         y           = 0;
 
-    while(length > index)
+    clearLayout();
+
+    m_layoutWidth   = gfx.getWidth();
+    m_layoutHeight  = gfx.getHeight();
+    m_layoutPosX    = m_posX;
+    m_layoutPosY    = m_posY;
+    m_isLayoutValid = true;
+
+    /* The text width only changes with the text, its position or the
+     * canvas width, which is considered by the alignment. Otherwise
+     * e.g. a color change doesn't need to measure it again.
+     */
+    if ((false == m_isTextWidthValid) ||
+        (m_posX != m_textWidthPosX) ||
+        (gfx.getWidth() != m_textWidthCanvas))
     {
-        /* Escape found? */
-        if ('\\' == formatStr[index])
+        int16_t rightBorder = measure(m_posX, gfx.getWidth());
+
+        if (m_posX < rightBorder)
         {
-            /* Another escape found? */
-            if (true == escapeFound)
-            {
-                escapeFound = false;
-                useChar     = true;
-            }
-            else
-            {
-                escapeFound = true;
-                ++index;
-            }
+            m_textWidth = rightBorder - m_posX;
         }
-        else if (true == escapeFound)
+        else
         {
-            uint32_t keywordIndex = 0U;
+            m_textWidth = 0U;
+        }
 
-            for(keywordIndex = 0U; keywordIndex < UTIL_ARRAY_NUM(m_keywordHandlers); ++keywordIndex)
+        m_isTextWidthValid  = true;
+        m_textWidthPosX     = m_posX;
+        m_textWidthCanvas   = gfx.getWidth();
+    }
+
+    /* The buffer must cover the whole text, which may be outside the canvas. */
+    if (0 > m_posX)
+    {
+        bufferX = m_posX;
+    }
+
+    if (bufferEnd < (m_posX + m_textWidth))
+    {
+        bufferEnd = m_posX + m_textWidth;
+    }
+
+    {
+        /* The buffer covers only a window of the canvas width, which is moved
+         * over the whole text. Its first column overlaps with the previous
+         * window and is only used to join the runs across the window border.
+         */
+        const uint16_t  WINDOW_WIDTH    = (0U < gfx.getWidth()) ? gfx.getWidth() : 1U;
+        TextLayoutGfx   layoutGfx(gfx.getWidth(), gfx.getHeight(), WINDOW_WIDTH + 1U);
+        uint8_t         pass            = 0U;
+
+        /* The first pass counts the runs, to allocate the layout at once.
+         * The second pass stores them.
+         */
+        for(pass = 0U; (2U > pass) && ((0U == pass) || (0U < runCount)); ++pass)
+        {
+            int32_t     windowX     = bufferX;
+            uint32_t    runIndex    = 0U;
+
+            while(bufferEnd > windowX)
             {
-                KeywordHandler  handler     = m_keywordHandlers[keywordIndex];
-                uint8_t         overstep    = 0U;
-                bool            status      = (this->*handler)(nullptr, false, formatStr.substring(index), overstep);
+                const uint16_t  COLUMNS = static_cast<uint16_t>(((bufferEnd - windowX) < WINDOW_WIDTH) ? (bufferEnd - windowX) : WINDOW_WIDTH);
 
-                if (true == status)
+                layoutGfx.setWindow(static_cast<int16_t>(windowX - 1));
+                layoutGfx.setFont(m_font);
+                layoutGfx.setTextColor(m_textColor);
+                layoutGfx.setTextWrap(false);
+                layoutGfx.setTextCursorPos(m_posX, CURSOR_Y);
+
+                (void)show(layoutGfx);
+
+                for(y = 0; y < layoutGfx.getHeight(); ++y)
                 {
-                    index += overstep;
-                    break;
+                    const uint32_t* row     = layoutGfx.getRow(y);
+                    uint32_t        prev    = (bufferX < windowX) ? row[0] : 0U;
+                    uint16_t        index   = 0U;
+
+                    for(index = 1U; index <= COLUMNS; ++index)
+                    {
+                        if (0U != (row[index] & TextLayoutGfx::DRAWN_FLAG))
+                        {
+                            /* Start of a new run? */
+                            if (prev != row[index])
+                            {
+                                if (nullptr != m_runs)
+                                {
+                                    m_runs[runIndex].x      = layoutGfx.getBufferX() + index;
+                                    m_runs[runIndex].y      = y;
+                                    m_runs[runIndex].length = 1U;
+                                    m_runs[runIndex].color  = row[index] & TextLayoutGfx::COLOR_MASK;
+                                }
+
+                                ++runIndex;
+                            }
+                            else if (nullptr != m_runs)
+                            {
+                                uint32_t lastIndex = runIndex - 1U;
+
+                                /* A run, which continues from the previous window,
+                                 * is the latest one of its row, but not overall.
+                                 */
+                                while(y != m_runs[lastIndex].y)
+                                {
+                                    --lastIndex;
+                                }
+
+                                ++m_runs[lastIndex].length;
+                            }
+                            else
+                            {
+                                ;
+                            }
+                        }
+
+                        prev = row[index];
+                    }
                 }
+
+                windowX += WINDOW_WIDTH;
             }
 
-            if (UTIL_ARRAY_NUM(m_keywordHandlers) <= keywordIndex)
+            if ((0U == pass) &&
+                (0U < runIndex))
             {
-                useChar = true;
+                runCount    = runIndex;
+                m_runs      = new TextRun[runCount];
+                m_runCount  = runCount;
             }
+        }
+    }
 
-            escapeFound = false;
+    return;
+}
+
+void TextWidget::updateSmoothScrolling(uint16_t width)
+{
+    const uint32_t  NOW         = millis();
+    /* Scroll offset runs from (1 - width) to the text width, see update(). */
+    const uint32_t  RANGE       = (static_cast<uint32_t>(m_textWidth) + width) << SCROLL_FRACTION_BITS;
+    uint32_t        elapsed     = NOW - m_scrollTimestamp;
+    uint32_t        distance    = 0U;
+
+    if (SCROLL_MAX_ELAPSED_TIME < elapsed)
+    {
+        elapsed = SCROLL_MAX_ELAPSED_TIME;
+    }
+
+    /* The text moves one pixel per scroll pause. Keep the remainder of the
+     * division, otherwise the scroll speed would drift.
+     */
+    distance            = (elapsed << SCROLL_FRACTION_BITS) + m_scrollRemainder;
+    m_scrollRemainder   = distance % m_scrollPause;
+    m_scrollPos        += distance / m_scrollPause;
+    m_scrollTimestamp   = NOW;
+
+    if (RANGE <= m_scrollPos)
+    {
+        /* Here we know that the text was once complete scrolled through the display. */
+        m_scrollingCnt  += m_scrollPos / RANGE;
+        m_scrollPos     %= RANGE;
+    }
+
+    m_scrollOffset      = ((-1) * width) + 1 + static_cast<int16_t>(m_scrollPos >> SCROLL_FRACTION_BITS);
+    m_scrollFraction    = static_cast<uint8_t>(m_scrollPos & ((1U << SCROLL_FRACTION_BITS) - 1U));
+
+    return;
+}
+
+void TextWidget::updateSpanScrolling()
+{
+    const uint32_t  NOW         = (nullptr != m_spanClock) ? m_spanClock() : millis();
+    /* Scroll offset runs from (1 - span width) to the text width in the span. */
+    const uint64_t  RANGE       = (static_cast<uint64_t>(m_textWidth) + m_scrollSpanWidth) << SCROLL_FRACTION_BITS;
+    uint32_t        pos         = 0U;
+
+    /* The position is derived from the absolute time instead of the elapsed
+     * time, so all displays of the span calculate the same position.
+     */
+    pos = static_cast<uint32_t>(((static_cast<uint64_t>(NOW) << SCROLL_FRACTION_BITS) / m_scrollPause) % RANGE);
+
+    /* Here we know that the text was once complete scrolled through the span. */
+    if (m_scrollPos > pos)
+    {
+        ++m_scrollingCnt;
+    }
+
+    m_scrollPos         = pos;
+    m_scrollOffset      = ((-1) * m_scrollSpanWidth) + 1 + static_cast<int16_t>(m_scrollPos >> SCROLL_FRACTION_BITS) + m_spanOffset;
+    m_scrollFraction    = static_cast<uint8_t>(m_scrollPos & ((1U << SCROLL_FRACTION_BITS) - 1U));
+
+    return;
+}
+
+void TextWidget::drawLayout(IGfx& gfx) const
+{
+    const int16_t   WIDTH       = gfx.getWidth();
+    uint32_t        runIndex    = 0U;
+
+    for(runIndex = 0U; runIndex < m_runCount; ++runIndex)
+    {
+        const TextRun&  run = m_runs[runIndex];
+        int16_t         x1  = run.x - m_scrollOffset;
+        int16_t         x2  = x1 + run.length;
+
+        /* Clip the run to the visible part */
+        if (0 > x1)
+        {
+            x1 = 0;
         }
-        else
+
+        if (WIDTH < x2)
         {
-            useChar = true;
+            x2 = WIDTH;
         }
 
-        if (true == useChar)
+        if (x1 < x2)
         {
-            useChar = false;
-            str += formatStr[index];
-            ++index;
+            gfx.fillSpan(x1, run.y, x2 - x1, run.color);
         }
     }
 
-    return str;
+    return;
+}
+
+void TextWidget::drawLayoutAntialiased(IGfx& gfx) const
+{
+    const int16_t   WIDTH       = gfx.getWidth();
+    const uint8_t   FRACTION    = m_scrollFraction;
+    uint32_t        runIndex    = 0U;
+
+    /* Every pixel is a mix of its source pixel and the right neighbour,
+     * weighted by the fractional scroll offset. Therefore only the first
+     * and the last pixel of a run are blended with the background.
+     */
+    for(runIndex = 0U; runIndex < m_runCount; ++runIndex)
+    {
+        const TextRun&  run = m_runs[runIndex];
+        int16_t         x1  = run.x - m_scrollOffset;
+        int16_t         x2  = x1 + run.length - 1;
+
+        gfx.blendPixel(x1 - 1, run.y, run.color, FRACTION);
+        gfx.blendPixel(x2, run.y, run.color, UINT8_MAX - FRACTION);
+
+        /* Clip the inner part of the run to the visible part */
+        if (0 > x1)
+        {
+            x1 = 0;
+        }
+
+        if (WIDTH < x2)
+        {
+            x2 = WIDTH;
+        }
+
+        if (x1 < x2)
+        {
+            gfx.fillSpan(x1, run.y, x2 - x1, run.color);
+        }
+    }
+
+    return;
+}
+
+void TextWidget::clearLayout()
+{
+    if (nullptr != m_runs)
+    {
+        delete[] m_runs;
+        m_runs = nullptr;
+    }
+
+    m_runCount      = 0U;
+    m_isLayoutValid = false;
+
+    return;
 }
 
-void TextWidget::show(IGfx& gfx, const String& formatStr) const
+void TextWidget::compileFormatStr()
 {
-    uint32_t    index       = 0U;
-    bool        escapeFound = false;
-    bool        useChar     = false;
-    uint32_t    length      = formatStr.length();
+    const String    TEXT        = Util::utf8ToCp1252(m_formatStr);
+    const char*     formatStr   = TEXT.c_str();
+    uint32_t        length      = TEXT.length();
+    uint32_t        index       = 0U;
+    uint16_t        textLength  = 0U;
+    bool            escapeFound = false;
+    bool            useChar     = false;
+
+    clearText();
+    m_isTextWidthValid = false;
+
+    /* The text without format tags is never longer than the format string. */
+    m_text = new char[length + 1U];
 
     while(length > index)
     {
@@ -245,12 +679,42 @@ void TextWidget::show(IGfx& gfx, const String& formatStr) const
 
             for(keywordIndex = 0U; keywordIndex < UTIL_ARRAY_NUM(m_keywordHandlers); ++keywordIndex)
             {
-                KeywordHandler  handler     = m_keywordHandlers[keywordIndex];
-                uint8_t         overstep    = 0U;
-                bool            status      = (this->*handler)(&gfx, false, formatStr.substring(index), overstep);
+                TextSpan    tag         = { textLength, 0U, 0U, false, FONT_INDEX_NONE, ALIGNMENT_NONE };
+                uint8_t     overstep    = 0U;
+                bool        status      = m_keywordHandlers[keywordIndex](&formatStr[index], tag, overstep);
 
                 if (true == status)
                 {
+                    if ((true == tag.isColorSet) ||
+                        (FONT_INDEX_NONE != tag.fontIndex) ||
+                        (ALIGNMENT_NONE != tag.alignment))
+                    {
+                        TextSpan* span = getTagSpan(textLength);
+
+                        if (nullptr == span)
+                        {
+                            LOG_WARNING("Too many format tags, ignored.");
+                        }
+                        else
+                        {
+                            if (true == tag.isColorSet)
+                            {
+                                span->color         = tag.color;
+                                span->isColorSet    = true;
+                            }
+
+                            if (FONT_INDEX_NONE != tag.fontIndex)
+                            {
+                                span->fontIndex = tag.fontIndex;
+                            }
+
+                            if (ALIGNMENT_NONE != tag.alignment)
+                            {
+                                span->alignment = tag.alignment;
+                            }
+                        }
+                    }
+
                     index += overstep;
                     break;
                 }
@@ -272,93 +736,277 @@ void TextWidget::show(IGfx& gfx, const String& formatStr) const
         {
             useChar = false;
 
-            gfx.print(formatStr[index]);
+            /* The text always belongs to the last span. */
+            if (0U == m_spanCount)
+            {
+                (void)getTagSpan(textLength);
+            }
+
+            ++m_spans[m_spanCount - 1U].length;
+
+            m_text[textLength] = formatStr[index];
+            ++textLength;
             ++index;
         }
     }
 
-    /* Text color might be changed, restore original. */
-    gfx.setTextColor(m_textColor);
+    m_text[textLength] = '\0';
 
     return;
 }
 
-bool TextWidget::handleColor(IGfx* gfx, bool noAction, const String& formatStr, uint8_t& overstep) const
+TextWidget::TextSpan* TextWidget::getTagSpan(uint16_t offset)
 {
-    bool status = false;
+    TextSpan* span = nullptr;
 
-    if ('#' == formatStr[0])
+    /* The alignment depends on the font, therefore a following font
+     * change must not be applied before it.
+     */
+    if ((0U < m_spanCount) &&
+        (0U == m_spans[m_spanCount - 1U].length) &&
+        (ALIGNMENT_NONE == m_spans[m_spanCount - 1U].alignment))
     {
-        const uint8_t   RGB_HEX_LEN = 6U;
-        String          colorStr    = String("0x") + formatStr.substring(1, 1 + RGB_HEX_LEN);
-        uint32_t        colorRGB888 = 0U;
-        bool            convStatus  = Util::strToUInt32(colorStr, colorRGB888);
+        span = &m_spans[m_spanCount - 1U];
+    }
+    else if (MAX_SPANS > m_spanCount)
+    {
+        span = &m_spans[m_spanCount];
+
+        span->offset        = offset;
+        span->length        = 0U;
+        span->color         = 0U;
+        span->isColorSet    = false;
+        span->fontIndex     = FONT_INDEX_NONE;
+        span->alignment     = ALIGNMENT_NONE;
 
-        if (true == convStatus)
+        ++m_spanCount;
+    }
+    else
+    {
+        ;
+    }
+
+    return span;
+}
+
+void TextWidget::clearText()
+{
+    if (nullptr != m_text)
+    {
+        delete[] m_text;
+        m_text = nullptr;
+    }
+
+    m_spanCount = 0U;
+
+    return;
+}
+
+int16_t TextWidget::show(IGfx& gfx) const
+{
+    int16_t rightBorder = gfx.getTextCursorPosX();
+    uint8_t spanIndex   = 0U;
+
+    for(spanIndex = 0U; spanIndex < m_spanCount; ++spanIndex)
+    {
+        const TextSpan& span        = m_spans[spanIndex];
+        const char*     text        = &m_text[span.offset];
+        uint16_t        charIndex   = 0U;
+
+        if (true == span.isColorSet)
         {
-            if ((false == noAction) &&
-                (nullptr != gfx))
+            gfx.setTextColor(span.color);
+        }
+
+        if (FONT_INDEX_NONE != span.fontIndex)
+        {
+            const GFXfont*  currentFont = gfx.getFont();
+            const GFXfont*  newFont     = m_fontKeywords[span.fontIndex].font;
+            int16_t         cursorY     = gfx.getTextCursorPosY();
+
+            /* The text is top aligned, therefore the baseline moves with the line height. */
+            if (nullptr != currentFont)
+            {
+                cursorY += static_cast<int16_t>(newFont->yAdvance) - static_cast<int16_t>(currentFont->yAdvance);
+            }
+
+            gfx.setFont(newFont);
+            gfx.setTextCursorPos(gfx.getTextCursorPosX(), cursorY);
+        }
+
+        if (ALIGNMENT_NONE != span.alignment)
+        {
+            uint16_t    textWidth   = 0U;
+            uint16_t    textHeight  = 0U;
+
+            /* The rest of the text is aligned. */
+            if (true == gfx.getTextBoundingBox(text, textWidth, textHeight))
             {
-                gfx->setTextColor(colorRGB888);
+                if (ALIGNMENT_RIGHT == span.alignment)
+                {
+                    gfx.setTextCursorPos(gfx.getWidth() - textWidth, gfx.getTextCursorPosY());
+                }
+                else
+                {
+                    gfx.setTextCursorPos(gfx.getTextCursorPosX() + (gfx.getWidth() - gfx.getTextCursorPosX() - textWidth) / 2, gfx.getTextCursorPosY());
+                }
             }
+        }
 
-            overstep    = 1U + RGB_HEX_LEN;
-            status      = true;
+        for(charIndex = 0U; charIndex < span.length; ++charIndex)
+        {
+            gfx.print(text[charIndex]);
+
+            if (rightBorder < gfx.getTextCursorPosX())
+            {
+                rightBorder = gfx.getTextCursorPosX();
+            }
         }
     }
 
-    return status;
+    /* Text color and font might be changed, restore original. */
+    gfx.setTextColor(m_textColor);
+    gfx.setFont(m_font);
+
+    return rightBorder;
 }
 
-bool TextWidget::handleAlignment(IGfx* gfx, bool noAction, const String& formatStr, uint8_t& overstep) const
+int16_t TextWidget::measure(int16_t posX, uint16_t width) const
 {
-    bool status                 = false;
-    const uint8_t   KEYWORD_LEN = 6U;
+    GlyphMetrics&   metrics     = GlyphMetrics::getInstance();
+    const GFXfont*  font        = m_font;
+    int16_t         cursorX     = posX;
+    int16_t         rightBorder = posX;
+    uint8_t         spanIndex   = 0U;
 
-    /* Alignment left? */
-    if (true == formatStr.startsWith("lalign"))
+    for(spanIndex = 0U; spanIndex < m_spanCount; ++spanIndex)
     {
-        overstep    = KEYWORD_LEN;
-        status      = true;
-    }
-    /* Alignment right? */
-    else if (true == formatStr.startsWith("ralign"))
-    {
-        if ((false == noAction) &&
-            (nullptr != gfx))
+        const TextSpan& span        = m_spans[spanIndex];
+        const char*     text        = &m_text[span.offset];
+        const uint8_t*  advances    = nullptr;
+        uint16_t        charIndex   = 0U;
+
+        if (FONT_INDEX_NONE != span.fontIndex)
         {
-            String      text        = removeFormatTags(formatStr.substring(KEYWORD_LEN));
-            uint16_t    textWidth   = 0U;
-            uint16_t    textHeight  = 0U;
+            font = m_fontKeywords[span.fontIndex].font;
+        }
 
-            if (true == gfx->getTextBoundingBox(text.c_str(), textWidth, textHeight))
+        /* The rest of the text is aligned, see show(). */
+        if ((nullptr != font) &&
+            (ALIGNMENT_NONE != span.alignment))
+        {
+            uint16_t textWidth = metrics.getTextWidth(font, text);
+
+            if (ALIGNMENT_RIGHT == span.alignment)
+            {
+                cursorX = width - textWidth;
+            }
+            else
             {
-                gfx->setTextCursorPos(gfx->getWidth() - textWidth, gfx->getTextCursorPosY());
+                cursorX = cursorX + (width - cursorX - textWidth) / 2;
             }
         }
 
-        overstep    = KEYWORD_LEN;
-        status      = true;
+        if (nullptr != font)
+        {
+            advances = metrics.getAdvances(font);
+        }
+
+        for(charIndex = 0U; (nullptr != advances) && (charIndex < span.length); ++charIndex)
+        {
+            if ('\n' == text[charIndex])
+            {
+                cursorX = 0;
+            }
+            else
+            {
+                cursorX += advances[static_cast<uint8_t>(text[charIndex])];
+            }
+
+            if (rightBorder < cursorX)
+            {
+                rightBorder = cursorX;
+            }
+        }
     }
-    /* Alignment center? */
-    else if (true == formatStr.startsWith("calign"))
+
+    return rightBorder;
+}
+
+bool TextWidget::parseColor(const char* str, TextSpan& span, uint8_t& overstep)
+{
+    const uint8_t   RGB_HEX_LEN = 6U;
+    bool            status      = false;
+
+    if ('#' == str[0])
     {
-        if ((false == noAction) &&
-            (nullptr != gfx))
+        uint32_t    colorRGB888 = 0U;
+        uint8_t     index       = 0U;
+
+        status = true;
+
+        for(index = 1U; (true == status) && (RGB_HEX_LEN >= index); ++index)
         {
-            String      text        = removeFormatTags(formatStr.substring(KEYWORD_LEN));
-            uint16_t    textWidth   = 0U;
-            uint16_t    textHeight  = 0U;
+            const char  DIGIT   = str[index];
+            uint8_t     nibble  = 0U;
 
-            if (true == gfx->getTextBoundingBox(text.c_str(), textWidth, textHeight))
+            if (('0' <= DIGIT) && ('9' >= DIGIT))
+            {
+                nibble = DIGIT - '0';
+            }
+            else if (('a' <= DIGIT) && ('f' >= DIGIT))
+            {
+                nibble = DIGIT - 'a' + 10U;
+            }
+            else if (('A' <= DIGIT) && ('F' >= DIGIT))
+            {
+                nibble = DIGIT - 'A' + 10U;
+            }
+            else
             {
-                gfx->setTextCursorPos(gfx->getTextCursorPosX() + (gfx->getWidth() - gfx->getTextCursorPosX() - textWidth) / 2, gfx->getTextCursorPosY());
+                /* Not a hex digit or the end of the string. */
+                status = false;
             }
+
+            colorRGB888 = (colorRGB888 << 4U) | nibble;
         }
 
+        if (true == status)
+        {
+            span.color      = colorRGB888;
+            span.isColorSet = true;
+            overstep        = 1U + RGB_HEX_LEN;
+        }
+    }
+
+    return status;
+}
+
+bool TextWidget::parseAlignment(const char* str, TextSpan& span, uint8_t& overstep)
+{
+    bool            status      = false;
+    const uint8_t   KEYWORD_LEN = 6U;
+
+    /* Alignment left? */
+    if (0 == strncmp(str, "lalign", KEYWORD_LEN))
+    {
         overstep    = KEYWORD_LEN;
         status      = true;
     }
+    /* Alignment right? */
+    else if (0 == strncmp(str, "ralign", KEYWORD_LEN))
+    {
+        span.alignment  = ALIGNMENT_RIGHT;
+        overstep        = KEYWORD_LEN;
+        status          = true;
+    }
+    /* Alignment center? */
+    else if (0 == strncmp(str, "calign", KEYWORD_LEN))
+    {
+        span.alignment  = ALIGNMENT_CENTER;
+        overstep        = KEYWORD_LEN;
+        status          = true;
+    }
     else
     {
         ;
@@ -367,6 +1015,27 @@ bool TextWidget::handleAlignment(IGfx* gfx, bool noAction, const String& formatS
     return status;
 }
 
+bool TextWidget::parseFont(const char* str, TextSpan& span, uint8_t& overstep)
+{
+    bool    status  = false;
+    uint8_t index   = 0U;
+
+    for(index = 0U; index < UTIL_ARRAY_NUM(m_fontKeywords); ++index)
+    {
+        const size_t KEYWORD_LEN = strlen(m_fontKeywords[index].keyword);
+
+        if (0 == strncmp(str, m_fontKeywords[index].keyword, KEYWORD_LEN))
+        {
+            span.fontIndex  = index;
+            overstep        = KEYWORD_LEN;
+            status          = true;
+            break;
+        }
+    }
+
+    return status;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
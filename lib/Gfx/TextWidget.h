@@ -70,11 +70,31 @@
  * - "\\lalign" : Alignment left
  * - "\\ralign" : Alignment right
  * - "\\calign" : Alignment center
+ * - "\\fsmall" : Select the small font (TomThumb)
+ * - "\\flarge" : Select the large font (5x7 glyphs, 8 pixel line height)
+ *
+ * The text is top aligned, therefore the baseline moves with the line height
+ * of the selected font.
+ * The text is expected in UTF-8 and converted to the font character set
+ * Windows-1252.
  */
 class TextWidget : public Widget
 {
 public:
 
+    /**
+     * Scroll modes, used if the text doesn't fit into the canvas.
+     */
+    enum ScrollMode
+    {
+        SCROLL_MODE_PIXEL = 0,          /**< Move one pixel after every scroll pause. */
+        SCROLL_MODE_SMOOTH,             /**< Move according to the elapsed time. */
+        SCROLL_MODE_SMOOTH_ANTIALIASED  /**< Move according to the elapsed time with sub-pixel antialiasing. */
+    };
+
+    /** Span clock, which returns the timestamp in ms. */
+    typedef uint32_t (*SpanClock)();
+
     /**
      * Constructs a text widget with a empty string in default color.
      */
@@ -88,7 +108,26 @@ public:
         m_scrollingCnt(0U),
         m_textWidth(0U),
         m_scrollOffset(0),
-        m_scrollTimer()
+        m_scrollTimer(),
+        m_scrollMode(DEFAULT_SCROLL_MODE),
+        m_scrollTimestamp(0U),
+        m_scrollPos(0U),
+        m_scrollRemainder(0U),
+        m_scrollFraction(0U),
+        m_scrollSpanWidth(0U),
+        m_isTextWidthValid(false),
+        m_textWidthPosX(0),
+        m_textWidthCanvas(0U),
+        m_isLayoutValid(false),
+        m_layoutWidth(0U),
+        m_layoutHeight(0U),
+        m_layoutPosX(0),
+        m_layoutPosY(0),
+        m_runs(nullptr),
+        m_runCount(0U),
+        m_text(nullptr),
+        m_spans(),
+        m_spanCount(0U)
     {
     }
 
@@ -109,8 +148,28 @@ public:
         m_scrollingCnt(0U),
         m_textWidth(0U),
         m_scrollOffset(0),
-        m_scrollTimer()
+        m_scrollTimer(),
+        m_scrollMode(DEFAULT_SCROLL_MODE),
+        m_scrollTimestamp(0U),
+        m_scrollPos(0U),
+        m_scrollRemainder(0U),
+        m_scrollFraction(0U),
+        m_scrollSpanWidth(0U),
+        m_isTextWidthValid(false),
+        m_textWidthPosX(0),
+        m_textWidthCanvas(0U),
+        m_isLayoutValid(false),
+        m_layoutWidth(0U),
+        m_layoutHeight(0U),
+        m_layoutPosX(0),
+        m_layoutPosY(0),
+        m_runs(nullptr),
+        m_runCount(0U),
+        m_text(nullptr),
+        m_spans(),
+        m_spanCount(0U)
     {
+        compileFormatStr();
     }
 
     /**
@@ -128,8 +187,28 @@ public:
         m_scrollingCnt(widget.m_scrollingCnt),
         m_textWidth(widget.m_textWidth),
         m_scrollOffset(widget.m_scrollOffset),
-        m_scrollTimer(widget.m_scrollTimer)
+        m_scrollTimer(widget.m_scrollTimer),
+        m_scrollMode(widget.m_scrollMode),
+        m_scrollTimestamp(widget.m_scrollTimestamp),
+        m_scrollPos(widget.m_scrollPos),
+        m_scrollRemainder(widget.m_scrollRemainder),
+        m_scrollFraction(widget.m_scrollFraction),
+        m_scrollSpanWidth(widget.m_scrollSpanWidth),
+        m_isTextWidthValid(false),
+        m_textWidthPosX(0),
+        m_textWidthCanvas(0U),
+        m_isLayoutValid(false),
+        m_layoutWidth(0U),
+        m_layoutHeight(0U),
+        m_layoutPosX(0),
+        m_layoutPosY(0),
+        m_runs(nullptr),
+        m_runCount(0U),
+        m_text(nullptr),
+        m_spans(),
+        m_spanCount(0U)
     {
+        compileFormatStr();
     }
 
     /**
@@ -137,6 +216,8 @@ public:
      */
     ~TextWidget()
     {
+        clearLayout();
+        clearText();
     }
 
     /**
@@ -157,6 +238,18 @@ public:
             m_textWidth             = widget.m_textWidth;
             m_scrollOffset          = widget.m_scrollOffset;
             m_scrollTimer           = widget.m_scrollTimer;
+            m_scrollMode            = widget.m_scrollMode;
+            m_scrollTimestamp       = widget.m_scrollTimestamp;
+            m_scrollPos             = widget.m_scrollPos;
+            m_scrollRemainder       = widget.m_scrollRemainder;
+            m_scrollFraction        = widget.m_scrollFraction;
+            m_scrollSpanWidth       = widget.m_scrollSpanWidth;
+
+            compileFormatStr();
+
+            /* The layout is rendered again with the next update. */
+            clearLayout();
+            invalidate();
         }
 
         return *this;
@@ -169,6 +262,33 @@ public:
      */
     void update(IGfx& gfx) override;
 
+    /**
+     * Is the text widget invalid and needs to be drawn again?
+     * A scrolling text changes its look by itself.
+     *
+     * @return If invalid, it will return true otherwise false.
+     */
+    bool isInvalid() override
+    {
+        bool isInvalid = Widget::isInvalid();
+
+        if ((false == isInvalid) &&
+            (true == m_isScrollingEnabled))
+        {
+            /* In the smooth modes the position depends on the time. */
+            if (SCROLL_MODE_PIXEL != m_scrollMode)
+            {
+                isInvalid = true;
+            }
+            else
+            {
+                isInvalid = m_scrollTimer.isTimeout();
+            }
+        }
+
+        return isInvalid;
+    }
+
     /**
      * Set the text string. It can contain format tags like:
      * - "#RRGGBB" Color information in RGB888 format
@@ -182,6 +302,11 @@ public:
         {
             m_formatStr             = formatStr;
             m_checkScrollingNeed    = true;
+            m_isLayoutValid         = false;
+
+            compileFormatStr();
+
+            invalidate();
         }
 
         return;
@@ -199,12 +324,13 @@ public:
 
     /**
      * Get the text string, without format tags.
+     * It is in the font character set Windows-1252.
      *
      * @return String
      */
     String getStr() const
     {
-        return removeFormatTags(m_formatStr);
+        return String((nullptr != m_text) ? m_text : "");
     }
 
     /**
@@ -214,7 +340,15 @@ public:
      */
     void setTextColor(const Color& color)
     {
-        m_textColor = color;
+        /* Avoid rendering the layout again if not necessary. */
+        if (m_textColor != color)
+        {
+            m_textColor     = color;
+            m_isLayoutValid = false;
+
+            invalidate();
+        }
+
         return;
     }
 
@@ -237,6 +371,10 @@ public:
     {
         m_font                  = font;
         m_checkScrollingNeed    = true;
+        m_isTextWidthValid      = false;
+        m_isLayoutValid         = false;
+
+        invalidate();
 
         return;
     }
@@ -272,6 +410,75 @@ public:
         return status;
     }
 
+    /**
+     * Get the pause between each movement of all text widgets.
+     *
+     * @return Scroll pause in ms
+     */
+    static uint32_t getScrollPause()
+    {
+        return m_scrollPause;
+    }
+
+    /**
+     * Set the text span of all text widgets, which is shared by a group of
+     * displays side by side. In the smooth scroll modes, a text is scrolled
+     * over the whole span and every display shows only its part of it.
+     * The scroll position is derived from the span clock, therefore the
+     * displays stay in lockstep, as long as their span clocks are synchronized.
+     *
+     * @param[in] width     Span width in pixel, 0 disables the span.
+     * @param[in] offset    Offset of this display in the span in pixel
+     */
+    static void setSpan(uint16_t width, uint16_t offset)
+    {
+        m_spanOffset    = offset;
+        m_spanWidth     = width;
+
+        return;
+    }
+
+    /**
+     * Set the clock, which drives the scroll position in the span.
+     *
+     * @param[in] clock Span clock, nullptr for the local clock.
+     */
+    static void setSpanClock(SpanClock clock)
+    {
+        m_spanClock = clock;
+        return;
+    }
+
+    /**
+     * Set the scroll mode, which is used if the text doesn't fit into the canvas.
+     * In the smooth modes the scroll offset is derived from the elapsed time,
+     * therefore a late update won't slow down the text.
+     *
+     * @param[in] mode  Scroll mode
+     */
+    void setScrollMode(ScrollMode mode)
+    {
+        if (m_scrollMode != mode)
+        {
+            m_scrollMode            = mode;
+            m_checkScrollingNeed    = true;
+
+            invalidate();
+        }
+
+        return;
+    }
+
+    /**
+     * Get the scroll mode.
+     *
+     * @return Scroll mode
+     */
+    ScrollMode getScrollMode() const
+    {
+        return m_scrollMode;
+    }
+
     /**
      * Get scrolling informations.
      *
@@ -311,10 +518,66 @@ public:
     /** Maximal scroll pause in ms */
     static const uint32_t   MAX_SCROLL_PAUSE        = 500U;
 
+    /** Default scroll mode */
+    static const ScrollMode DEFAULT_SCROLL_MODE     = SCROLL_MODE_SMOOTH;
+
+    /**
+     * Max. number of text spans. Every format tag starts a new span, further
+     * format tags are ignored.
+     */
+    static const uint8_t    MAX_SPANS               = 8U;
+
 private:
 
-    /** Keyword handler method. */
-    typedef bool (TextWidget::*KeywordHandler)(IGfx* gfx, bool noAction, const String& formatStr, uint8_t& overstep) const;
+    /**
+     * A horizontal run of equal colored text pixels. The text layout
+     * is stored as list of runs, which are drawn independent of the
+     * text content.
+     */
+    struct TextRun
+    {
+        int16_t     x;      /**< x-coordinate of the first pixel, without scroll offset */
+        int16_t     y;      /**< y-coordinate */
+        uint16_t    length; /**< Number of pixels */
+        Color       color;  /**< Pixel color */
+    };
+
+    /**
+     * Text alignment of a span.
+     */
+    enum Alignment
+    {
+        ALIGNMENT_NONE = 0, /**< Keep the text cursor position */
+        ALIGNMENT_RIGHT,    /**< Align the rest of the text right */
+        ALIGNMENT_CENTER    /**< Align the rest of the text centered */
+    };
+
+    /**
+     * A part of the text without format tags, with the attributes given by
+     * the format tags in front of it. The attributes are applied before the
+     * span is drawn and stay valid for the following spans.
+     */
+    struct TextSpan
+    {
+        uint16_t    offset;     /**< Index of the first character in the text */
+        uint16_t    length;     /**< Number of characters */
+        uint32_t    color;      /**< Text color in RGB888 format, only valid if isColorSet */
+        bool        isColorSet; /**< Change the text color? */
+        uint8_t     fontIndex;  /**< Index of the font keyword or FONT_INDEX_NONE to keep the font */
+        Alignment   alignment;  /**< Text alignment */
+    };
+
+    /**
+     * A font, which can be selected by keyword.
+     */
+    struct FontKeyword
+    {
+        const char*     keyword;    /**< Keyword without the leading '\\' */
+        const GFXfont*  font;       /**< Font */
+    };
+
+    /** Keyword handler, which parses a keyword into the span attributes. */
+    typedef bool (*KeywordHandler)(const char* str, TextSpan& span, uint8_t& overstep);
 
     String          m_formatStr;            /**< String, which contains format tags. */
     Color           m_textColor;            /**< Text color of the string */
@@ -325,52 +588,176 @@ private:
     uint16_t        m_textWidth;            /**< Text width in pixel */
     int16_t         m_scrollOffset;         /**< Pixel offset of cursor x position, used for scrolling. */
     SimpleTimer     m_scrollTimer;          /**< Timer, used for scrolling */
+    ScrollMode      m_scrollMode;           /**< Scroll mode */
+    uint32_t        m_scrollTimestamp;      /**< Timestamp in ms of the last smooth scroll position update */
+    uint32_t        m_scrollPos;            /**< Smooth scroll position in fixed point format, see SCROLL_FRACTION_BITS. */
+    uint32_t        m_scrollRemainder;      /**< Remainder of the last smooth scroll position calculation */
+    uint8_t         m_scrollFraction;       /**< Fractional part of the scroll offset [0; 255] */
+    uint16_t        m_scrollSpanWidth;      /**< Span width in pixel, the scrolling need was checked for. */
+    bool            m_isTextWidthValid;     /**< Is the measured text width valid or not? */
+    int16_t         m_textWidthPosX;        /**< Widget x-coordinate, the text width was measured for. */
+    uint16_t        m_textWidthCanvas;      /**< Canvas width in pixel, the text width was measured for. */
+    bool            m_isLayoutValid;        /**< Is the rendered text layout valid or not? */
+    uint16_t        m_layoutWidth;          /**< Canvas width in pixel, the layout was rendered for. */
+    uint16_t        m_layoutHeight;         /**< Canvas height in pixel, the layout was rendered for. */
+    int16_t         m_layoutPosX;           /**< Widget x-coordinate, the layout was rendered for. */
+    int16_t         m_layoutPosY;           /**< Widget y-coordinate, the layout was rendered for. */
+    TextRun*        m_runs;                 /**< Rendered text layout */
+    uint32_t        m_runCount;             /**< Number of runs in the text layout */
+    char*           m_text;                 /**< Text without format tags in Windows-1252 */
+    TextSpan        m_spans[MAX_SPANS];     /**< Text spans, compiled from the format string */
+    uint8_t         m_spanCount;            /**< Number of text spans */
+
+    /** Font index of a span, which keeps the font. */
+    static const uint8_t    FONT_INDEX_NONE         = UINT8_MAX;
+
+    /** Number of fractional bits of the smooth scroll position. */
+    static const uint8_t    SCROLL_FRACTION_BITS    = 8U;
+
+    /**
+     * Max. time in ms, which is considered for the smooth scroll position.
+     * It avoids a jump of the text, if the widget was not drawn for a
+     * long time.
+     */
+    static const uint32_t   SCROLL_MAX_ELAPSED_TIME = 1000U;
 
     static KeywordHandler   m_keywordHandlers[];    /**< List of all supported keyword handlers. */
+    static const FontKeyword    m_fontKeywords[];   /**< List of all fonts, which can be selected by keyword. */
     static uint32_t         m_scrollPause;          /**< Pause in ms, between each scroll movement. */
+    static uint16_t         m_spanWidth;            /**< Width of the text span over all displays in pixel */
+    static uint16_t         m_spanOffset;           /**< Offset of this display in the text span in pixel */
+    static SpanClock        m_spanClock;            /**< Clock, which drives the scroll position in the span. */
+
+    /**
+     * Compile the format string into the text without format tags and the
+     * list of text spans. Its done only once if the format string changes,
+     * therefore drawing the text doesn't need to parse it again.
+     */
+    void compileFormatStr();
+
+    /**
+     * Get the span, which gets the attributes of the next format tag.
+     * A new span is started, if the last one contains already text or
+     * an alignment, which depends on the previous attributes.
+     *
+     * @param[in] offset    Index of the next character in the text
+     *
+     * @return If available, the span will be returned otherwise nullptr.
+     */
+    TextSpan* getTagSpan(uint16_t offset);
+
+    /**
+     * Release the text and the text spans.
+     */
+    void clearText();
 
     /**
-     * Remove format tags from string.
+     * Parse the format string and render the text once into the text layout.
+     * Its done only if the text, the font or the color changed, as well as
+     * if the widget is drawn with another canvas size or position.
      *
-     * @param[in] formatStr String which contains format tags
+     * @param[in] gfx   Graphics interface, the text will be drawn on.
+     */
+    void updateLayout(IGfx& gfx);
+
+    /**
+     * Update the scroll offset in the smooth scroll modes according to
+     * the elapsed time since the last update.
      *
-     * @return String without format tags
+     * @param[in] width Canvas width in pixel
      */
-    String removeFormatTags(const String& formatStr) const;
+    void updateSmoothScrolling(uint16_t width);
 
     /**
-     * Show formatted text.
-     * Format tags:
-     * - #RRGGBB Color in HTML form (RGB888)
+     * Get the effective span width. The span is only used in the smooth
+     * scroll modes.
+     *
+     * @return Span width in pixel, 0 if no span is used.
+     */
+    uint16_t getSpanWidth() const
+    {
+        return (SCROLL_MODE_PIXEL == m_scrollMode) ? 0U : m_spanWidth;
+    }
+
+    /**
+     * Update the scroll offset in the span according to the span clock.
+     */
+    void updateSpanScrolling();
+
+    /**
+     * Draw the visible part of the text layout.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void drawLayout(IGfx& gfx) const;
+
+    /**
+     * Draw the visible part of the text layout with sub-pixel antialiasing.
+     * The edges of every run are blended with the background according
+     * to the fractional part of the scroll offset.
+     *
+     * @param[in] gfx   Graphics interface
+     */
+    void drawLayoutAntialiased(IGfx& gfx) const;
+
+    /**
+     * Release the text layout.
+     */
+    void clearLayout();
+
+    /**
+     * Show the compiled text with all its span attributes.
      *
      * @param[in] gfx       Graphics, used to draw the characters
-     * @param[in] formatStr String which contains format tags
+     *
+     * @return Rightmost x-coordinate of the text cursor, which is the right border of the text.
+     */
+    int16_t show(IGfx& gfx) const;
+
+    /**
+     * Measure the compiled text with all its span attributes, like it would
+     * be shown with show(). Only the advance tables of the fonts are used,
+     * therefore no glyph is drawn.
+     *
+     * @param[in] posX      X-coordinate of the text cursor at the begin
+     * @param[in] width     Canvas width in pixel, used for the alignment
+     *
+     * @return Rightmost x-coordinate of the text cursor, which is the right border of the text.
+     */
+    int16_t measure(int16_t posX, uint16_t width) const;
+
+    /**
+     * Parses the keyword for color changes.
+     *
+     * @param[in] str       String, which may start with the keyword.
+     * @param[out] span     Span, which gets the attribute.
+     * @param[out] overstep Number of characters, which must be overstepped before the next normal character comes.
+     *
+     * @return If keyword is parsed successful, it returns true otherwise false.
      */
-    void show(IGfx& gfx, const String& formatStr) const;
+    static bool parseColor(const char* str, TextSpan& span, uint8_t& overstep);
 
     /**
-     * Handles the keyword for color changes.
+     * Parses the keyword for alignment changes.
      *
-     * @param[in] gfx       Graphics interface, only necessary if actions shall take place.
-     * @param[in] noAction  The handler shall take no action. This is only used to get rid of the keywords in the text.
-     * @param[in] formatStr String which may contain keywords.
+     * @param[in] str       String, which may start with the keyword.
+     * @param[out] span     Span, which gets the attribute.
      * @param[out] overstep Number of characters, which must be overstepped before the next normal character comes.
      *
-     * @return If keyword is handled successful, it returns true otherwise false.
+     * @return If keyword is parsed successful, it returns true otherwise false.
      */
-    bool handleColor(IGfx* gfx, bool noAction, const String& formatStr, uint8_t& overstep) const;
+    static bool parseAlignment(const char* str, TextSpan& span, uint8_t& overstep);
 
     /**
-     * Handles the keyword for alignment changes.
+     * Parses the keyword for font changes.
      *
-     * @param[in] gfx       Graphics interface, only necessary if actions shall take place.
-     * @param[in] noAction  The handler shall take no action. This is only used to get rid of the keywords in the text.
-     * @param[in] formatStr String which may contain keywords.
+     * @param[in] str       String, which may start with the keyword.
+     * @param[out] span     Span, which gets the attribute.
      * @param[out] overstep Number of characters, which must be overstepped before the next normal character comes.
      *
-     * @return If keyword is handled successful, it returns true otherwise false.
+     * @return If keyword is parsed successful, it returns true otherwise false.
      */
-    bool handleAlignment(IGfx* gfx, bool noAction, const String& formatStr, uint8_t& overstep) const;
+    static bool parseFont(const char* str, TextSpan& span, uint8_t& overstep);
 };
 
 /******************************************************************************
@@ -0,0 +1,236 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Ticker Widget
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TickerWidget.h"
+#include <Arduino.h>
+#include <TextWidget.h>
+#include <GlyphMetrics.h>
+#include <TomThumb.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize ticker widget type. */
+const char*     TickerWidget::WIDGET_TYPE   = "ticker";
+
+/* Initialize default font */
+const GFXfont*  TickerWidget::DEFAULT_FONT  = &TomThumb;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void TickerWidget::update(IGfx& gfx)
+{
+    const int32_t VIEW_WIDTH = static_cast<int32_t>(gfx.getWidth()) - m_posX;
+
+    m_viewWidth = (0 < VIEW_WIDTH) ? static_cast<uint16_t>(VIEW_WIDTH) : 0U;
+
+    if (nullptr != m_strip)
+    {
+        const uint16_t  STRIP_WIDTH = m_strip->getWidth();
+        const uint16_t  OFFSET      = getScrollOffset();
+        uint16_t        width       = STRIP_WIDTH - OFFSET;
+
+        /* Here we know that the strip was once complete scrolled through the window. */
+        if (m_shownOffset > OFFSET)
+        {
+            ++m_scrollingCnt;
+        }
+
+        if (m_viewWidth < width)
+        {
+            width = m_viewWidth;
+        }
+
+        m_strip->blit(gfx, m_posX, m_posY, OFFSET, width);
+
+        /* A scrolling strip continues with its beginning. */
+        if ((STRIP_WIDTH > m_viewWidth) &&
+            (m_viewWidth > width))
+        {
+            m_strip->blit(gfx, m_posX + width, m_posY, 0U, m_viewWidth - width);
+        }
+
+        m_shownOffset = OFFSET;
+    }
+
+    return;
+}
+
+bool TickerWidget::appendText(const char* text, const Color& color)
+{
+    bool status = false;
+
+    if ((nullptr != text) &&
+        ('\0' != text[0]))
+    {
+        const uint16_t  WIDTH   = GlyphMetrics::getInstance().getTextWidth(m_font, text);
+        const int32_t   POS_X   = extend(WIDTH);
+
+        if (0 <= POS_X)
+        {
+            m_strip->setFont(m_font);
+            m_strip->setTextColor(color);
+            m_strip->setTextWrap(false);
+            m_strip->setTextCursorPos(static_cast<int16_t>(POS_X), m_font->yAdvance - 1); /* Set cursor to baseline */
+            m_strip->drawText(text);
+
+            status = true;
+        }
+    }
+
+    return status;
+}
+
+bool TickerWidget::appendBitmap(const Color* bitmap, uint16_t width, uint16_t height)
+{
+    bool status = false;
+
+    if (nullptr != bitmap)
+    {
+        const int32_t POS_X = extend(width);
+
+        if (0 <= POS_X)
+        {
+            m_strip->drawRGBBitmap(static_cast<int16_t>(POS_X), 0, bitmap, width, height);
+
+            status = true;
+        }
+    }
+
+    return status;
+}
+
+bool TickerWidget::appendGap(uint16_t width)
+{
+    return (0 <= extend(width));
+}
+
+void TickerWidget::clear()
+{
+    if (nullptr != m_strip)
+    {
+        delete m_strip;
+        m_strip = nullptr;
+    }
+
+    m_shownOffset   = 0U;
+    m_scrollingCnt  = 0U;
+    invalidate();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+int32_t TickerWidget::extend(uint16_t width)
+{
+    int32_t         posX        = -1;
+    const uint32_t  STRIP_WIDTH = getStripWidth();
+
+    if ((0U < width) &&
+        (0U < m_height) &&
+        (MAX_STRIP_WIDTH >= (STRIP_WIDTH + width)))
+    {
+        /* The strip is composed seldom, but may be long. */
+        Strip* strip = new Strip(STRIP_WIDTH + width, m_height, MemPolicy::REGION_LARGE);
+
+        if (false == strip->isAllocated())
+        {
+            delete strip;
+        }
+        else
+        {
+            if (nullptr != m_strip)
+            {
+                m_strip->blit(*strip, 0, 0);
+                delete m_strip;
+            }
+
+            m_strip         = strip;
+            m_shownOffset   = 0U;
+            m_scrollingCnt  = 0U;
+            posX            = static_cast<int32_t>(STRIP_WIDTH);
+            invalidate();
+        }
+    }
+
+    return posX;
+}
+
+uint16_t TickerWidget::getScrollOffset() const
+{
+    uint16_t offset = 0U;
+
+    /* The offset depends only on the time, like the span scrolling of the text widget. */
+    if ((nullptr != m_strip) &&
+        (m_viewWidth < m_strip->getWidth()))
+    {
+        offset = static_cast<uint16_t>((millis() / TextWidget::getScrollPause()) % m_strip->getWidth());
+    }
+
+    return offset;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,274 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Ticker Widget
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __TICKERWIDGET_H__
+#define __TICKERWIDGET_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Widget.hpp>
+#include <Canvas.h>
+#include <PixelGfx.hpp>
+#include <ColorDef.hpp>
+#include <gfxfont.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The ticker widget scrolls a strip of several text and bitmap segments
+ * as one unit through the graphics, like a news ticker.
+ *
+ * The segments are rendered once into the strip, when they are appended.
+ * Scrolling costs only one copy of the visible strip window per frame,
+ * independent of the number of segments. The strip moves one pixel per
+ * text widget scroll pause and its position depends only on the time, like
+ * the text widget span scrolling. After the last segment, the strip
+ * continues with the first one. A strip, which fits into the graphics,
+ * doesn't scroll.
+ *
+ * The strip is kept in PSRAM if available, therefore long tickers don't
+ * reduce the internal SRAM.
+ */
+class TickerWidget : public Widget
+{
+public:
+
+    /**
+     * Constructs a ticker widget without segments.
+     *
+     * @param[in] height    Strip height in pixel
+     * @param[in] x         Upper left corner (x-coordinate) of the widget in a canvas.
+     * @param[in] y         Upper left corner (y-coordinate) of the widget in a canvas.
+     */
+    TickerWidget(uint16_t height = DEFAULT_HEIGHT, int16_t x = 0, int16_t y = 0) :
+        Widget(WIDGET_TYPE, x, y),
+        m_height(height),
+        m_strip(nullptr),
+        m_font(DEFAULT_FONT),
+        m_viewWidth(0U),
+        m_shownOffset(0U),
+        m_scrollingCnt(0U)
+    {
+    }
+
+    /**
+     * Destroys the ticker widget.
+     */
+    ~TickerWidget()
+    {
+        clear();
+    }
+
+    /**
+     * Update/Draw the visible strip window on the canvas.
+     *
+     * @param[in] gfx Graphics interface
+     */
+    void update(IGfx& gfx) override;
+
+    /**
+     * Is the ticker widget invalid and needs to be drawn again?
+     * A scrolling strip changes its look by itself, whenever it moved.
+     *
+     * @return If invalid, it will return true otherwise false.
+     */
+    bool isInvalid() override
+    {
+        bool isInvalid = Widget::isInvalid();
+
+        if (false == isInvalid)
+        {
+            isInvalid = (getScrollOffset() != m_shownOffset);
+        }
+
+        return isInvalid;
+    }
+
+    /**
+     * Append a text segment to the strip. The text is top aligned and drawn
+     * with the current font. Format tags are not supported.
+     *
+     * @param[in] text  Text
+     * @param[in] color Text color
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool appendText(const char* text, const Color& color = ColorDef::WHITE);
+
+    /**
+     * Append a bitmap segment to the strip. The bitmap is copied, therefore
+     * it can be released afterwards. Rows below the strip height are cut.
+     *
+     * @param[in] bitmap    Bitmap pixels
+     * @param[in] width     Bitmap width in pixel
+     * @param[in] height    Bitmap height in pixel
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool appendBitmap(const Color* bitmap, uint16_t width, uint16_t height);
+
+    /**
+     * Append a black gap to the strip, e.g. to separate two segments.
+     *
+     * @param[in] width Gap width in pixel
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool appendGap(uint16_t width);
+
+    /**
+     * Remove all segments and release the strip.
+     */
+    void clear();
+
+    /**
+     * Get the strip width, which is the sum of all segment widths.
+     *
+     * @return Strip width in pixel
+     */
+    uint16_t getStripWidth() const
+    {
+        return (nullptr == m_strip) ? 0U : m_strip->getWidth();
+    }
+
+    /**
+     * Get the strip height.
+     *
+     * @return Strip height in pixel
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Set the font of the following text segments.
+     *
+     * @param[in] font  Font
+     */
+    void setFont(const GFXfont* font)
+    {
+        if (nullptr != font)
+        {
+            m_font = font;
+        }
+
+        return;
+    }
+
+    /**
+     * Get the font of the following text segments.
+     *
+     * @return Font
+     */
+    const GFXfont* getFont() const
+    {
+        return m_font;
+    }
+
+    /**
+     * Get the number of complete passes of the strip, since it was composed.
+     *
+     * @return Number of passes
+     */
+    uint32_t getScrollingCnt() const
+    {
+        return m_scrollingCnt;
+    }
+
+    /** Widget type string */
+    static const char*      WIDGET_TYPE;
+
+    /** Default strip height in pixel */
+    static const uint16_t   DEFAULT_HEIGHT  = 8U;
+
+    /** Max. strip width in pixel */
+    static const uint16_t   MAX_STRIP_WIDTH = 4096U;
+
+    /** Default font */
+    static const GFXfont*   DEFAULT_FONT;
+
+private:
+
+    /** The strip stores the pixels like a buffered canvas. */
+    typedef PixelGfx<Canvas::Pixel> Strip;
+
+    uint16_t        m_height;       /**< Strip height in pixel */
+    Strip*          m_strip;        /**< Pre-rendered strip with all segments */
+    const GFXfont*  m_font;         /**< Font of the following text segments */
+    uint16_t        m_viewWidth;    /**< Width of the strip window in pixel, given by the last update */
+    uint16_t        m_shownOffset;  /**< Strip offset of the last drawn window */
+    uint32_t        m_scrollingCnt; /**< Number of complete passes of the strip */
+
+    TickerWidget(const TickerWidget& widget);
+    TickerWidget& operator=(const TickerWidget& widget);
+
+    /**
+     * Extend the strip by the given width. The existing segments are kept
+     * and the new columns are black.
+     *
+     * @param[in] width Width in pixel
+     *
+     * @return If successful, it will return the x-coordinate of the new columns otherwise -1.
+     */
+    int32_t extend(uint16_t width);
+
+    /**
+     * Get the strip offset of the left window border, which shall be shown now.
+     *
+     * @return Strip offset in pixel
+     */
+    uint16_t getScrollOffset() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TICKERWIDGET_H__ */
+
+/** @} */
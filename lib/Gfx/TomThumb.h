@@ -53,7 +53,7 @@
 ** Yann Le Glaz (yann_le@web.de)
 */
 
-#define TOMTHUMB_USE_EXTENDED 0
+#define TOMTHUMB_USE_EXTENDED 1
 
 const uint8_t TomThumbBitmaps[] PROGMEM = {
     0x00,                /* 0x20 space */
@@ -363,6 +363,41 @@ const GFXglyph TomThumbGlyphs[] PROGMEM = {
     { 178, 3, 5, 4, 0, -5 }, /* 0x7D braceright */
     { 180, 3, 2, 4, 0, -5 }, /* 0x7E asciitilde */
 #if (TOMTHUMB_USE_EXTENDED)
+    /* 0x7F - 0x9F are mapped according to Windows-1252, not available characters are empty. */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x7F */
+    { 384, 3, 5, 4, 0, -5 }, /* 0x80 Euro */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x81 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x82 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x83 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x84 */
+    { 383, 3, 1, 4, 0, -1 }, /* 0x85 ellipsis */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x86 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x87 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x88 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x89 */
+    { 370, 3, 5, 4, 0, -5 }, /* 0x8A Scaron */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x8B */
+    { 366, 3, 5, 4, 0, -5 }, /* 0x8C OE */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x8D */
+    { 376, 3, 5, 4, 0, -5 }, /* 0x8E Zcaron */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x8F */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x90 */
+    { 11, 1, 2, 2, 0, -5 }, /* 0x91 quoteleft */
+    { 11, 1, 2, 2, 0, -5 }, /* 0x92 quoteright */
+    { 2, 3, 2, 4, 0, -5 }, /* 0x93 quotedblleft */
+    { 2, 3, 2, 4, 0, -5 }, /* 0x94 quotedblright */
+    { 382, 1, 1, 2, 0, -3 }, /* 0x95 bullet */
+    { 21, 3, 1, 4, 0, -3 }, /* 0x96 endash */
+    { 21, 3, 1, 4, 0, -3 }, /* 0x97 emdash */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x98 */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x99 */
+    { 372, 3, 5, 4, 0, -5 }, /* 0x9A scaron */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x9B */
+    { 368, 3, 4, 4, 0, -4 }, /* 0x9C oe */
+    { 0, 0, 0, 0, 0, 0 }, /* 0x9D */
+    { 378, 3, 5, 4, 0, -5 }, /* 0x9E zcaron */
+    { 374, 3, 5, 4, 0, -5 }, /* 0x9F Ydieresis */
+    { 0, 1, 1, 2, 0, -5 }, /* 0xA0 nbspace */
     { 181, 1, 5, 2, 0, -5 }, /* 0xA1 exclamdown */
     { 182, 3, 5, 4, 0, -5 }, /* 0xA2 cent */
     { 184, 3, 5, 4, 0, -5 }, /* 0xA3 sterling */
@@ -458,24 +493,14 @@ const GFXglyph TomThumbGlyphs[] PROGMEM = {
     { 357, 3, 6, 4, 0, -5 }, /* 0xFD yacute */
     { 360, 3, 5, 4, 0, -4 }, /* 0xFE thorn */
     { 362, 3, 6, 4, 0, -5 }, /* 0xFF ydieresis */
-    { 365, 1, 1, 2, 0, -1 }, /* 0x11D gcircumflex */
-    { 366, 3, 5, 4, 0, -5 }, /* 0x152 OE */
-    { 368, 3, 4, 4, 0, -4 }, /* 0x153 oe */
-    { 370, 3, 5, 4, 0, -5 }, /* 0x160 Scaron */
-    { 372, 3, 5, 4, 0, -5 }, /* 0x161 scaron */
-    { 374, 3, 5, 4, 0, -5 }, /* 0x178 Ydieresis */
-    { 376, 3, 5, 4, 0, -5 }, /* 0x17D Zcaron */
-    { 378, 3, 5, 4, 0, -5 }, /* 0x17E zcaron */
-    { 380, 1, 1, 2, 0, -1 }, /* 0xEA4 uni0EA4 */
-    { 381, 1, 1, 2, 0, -1 }, /* 0x13A0 uni13A0 */
-    { 382, 1, 1, 2, 0, -3 }, /* 0x2022 bullet */
-    { 383, 3, 1, 4, 0, -1 }, /* 0x2026 ellipsis */
-    { 384, 3, 5, 4, 0, -5 }, /* 0x20AC Euro */
-    { 386, 4, 5, 5, 0, -5 }, /* 0xFFFD uniFFFD */
 #endif /* (TOMTHUMB_USE_EXTENDED) */
 };
 
 const GFXfont TomThumb PROGMEM = {
     (uint8_t  *)TomThumbBitmaps,
     (GFXglyph *)TomThumbGlyphs,
+#if (TOMTHUMB_USE_EXTENDED)
+    0x20, 0xFF, 6 };
+#else  /* (TOMTHUMB_USE_EXTENDED) */
     0x20, 0x7E, 6 };
+#endif  /* (TOMTHUMB_USE_EXTENDED) */
@@ -58,11 +58,29 @@
 /**
  * Base widget, which contains the position
  * inside a canvas and declares the graphics interface.
+ *
+ * A widget in a canvas is only drawn again, if it is invalid. Every widget
+ * shall invalidate itself, as soon as its look changes.
+ *
+ * A widget is identified by a compact numeric id. A name is hashed once to
+ * its id, the name itself is not stored.
  */
 class Widget
 {
 public:
 
+    /** Id of a widget without name. */
+    static const uint32_t   ID_NONE = 0U;
+
+    /**
+     * Entry of a flat widget lookup table.
+     */
+    struct IdEntry
+    {
+        uint32_t    id;     /**< Widget id */
+        Widget*     widget; /**< Widget */
+    };
+
     /**
      * Destroys a widget.
      */
@@ -72,7 +90,7 @@ public:
 
     /**
      * Assign content of another widget.
-     * Note, its name won't be assigned.
+     * Note, its id won't be assigned.
      * 
      * @param[in] widget The widget, which to copy.
      * 
@@ -83,7 +101,9 @@ public:
         m_type = widget.m_type;
         m_posX = widget.m_posX;
         m_posY = widget.m_posY;
-        /* m_name is not assigned! */
+        /* m_id is not assigned! */
+
+        invalidate();
 
         return *this;
     }
@@ -96,8 +116,15 @@ public:
      */
     void move(int16_t x, int16_t y)
     {
-        m_posX = x;
-        m_posY = y;
+        if ((m_posX != x) ||
+            (m_posY != y))
+        {
+            m_posX = x;
+            m_posY = y;
+
+            invalidate();
+        }
+
         return;
     }
 
@@ -122,6 +149,40 @@ public:
      */
     virtual void update(IGfx& gfx) = 0;
 
+    /**
+     * Invalidate the widget, which forces the canvas to draw it again
+     * with the next update.
+     */
+    void invalidate()
+    {
+        m_isInvalid = true;
+        return;
+    }
+
+    /**
+     * Is the widget invalid and needs to be drawn again?
+     * Note, it must be overriden by the inherited widget, if its look
+     * changes without any call, e.g. because of an animation.
+     *
+     * @return If invalid, it will return true otherwise false.
+     */
+    virtual bool isInvalid()
+    {
+        return m_isInvalid;
+    }
+
+    /**
+     * Is the widget visible? A hidden widget is skipped by the compositor.
+     * Note, it must be overriden by the inherited widget, if it hides
+     * itself, e.g. after a message was shown long enough.
+     *
+     * @return If visible, it will return true otherwise false.
+     */
+    virtual bool isVisible() const
+    {
+        return true;
+    }
+
     /**
      * Get widget type as string.
      * 
@@ -133,41 +194,60 @@ public:
     }
 
     /**
-     * Get widget name.
-     * If no name is set, an empty string will be returned.
+     * Get widget id.
+     * If no id is set, ID_NONE will be returned.
      * 
-     * @return Name
+     * @return Id
      */
-    const String& getName() const
+    uint32_t getId() const
     {
-        return m_name;
+        return m_id;
     }
 
     /**
-     * Set widget name.
+     * Set widget id.
+     * 
+     * @param[in] id Id to set
+     */
+    void setId(uint32_t id)
+    {
+        if (m_id != id)
+        {
+            m_id = id;
+
+            /* The lookup tables of all canvases must be built again. */
+            ++getTreeGeneration();
+        }
+
+        return;
+    }
+
+    /**
+     * Set widget name. Only the id, which is hashed from the name, is stored.
      * 
      * @param[in] name Name to set
      */
     void setName(const String& name)
     {
-        m_name = name;
+        setId(toId(name.c_str()));
         return;
     }
 
     /**
-     * Find widget by its name.
+     * Find widget by its id.
      * Note, it must be overriden by the inherited widget, if it is like a
      * container of widgets.
      * 
-     * @param[in] name  Widget name to search for
+     * @param[in] id    Widget id to search for
      * 
      * @return If widget is found, it will be returned otherwise nullptr.
      */
-    virtual Widget* find(const String& name)
+    virtual Widget* find(uint32_t id)
     {
         Widget* widget = nullptr;
 
-        if (name == m_name)
+        if ((ID_NONE != id) &&
+            (id == m_id))
         {
             widget = this;
         }
@@ -175,12 +255,106 @@ public:
         return widget;
     }
 
+    /**
+     * Find widget by its name.
+     * 
+     * @param[in] name  Widget name to search for
+     * 
+     * @return If widget is found, it will be returned otherwise nullptr.
+     */
+    Widget* find(const String& name)
+    {
+        return find(toId(name.c_str()));
+    }
+
+    /**
+     * Collect the ids of the widget and all of its children in a flat
+     * lookup table. Widgets without id are skipped.
+     * Note, it must be overriden by the inherited widget, if it is like a
+     * container of widgets.
+     *
+     * @param[out]    entries     Lookup table
+     * @param[in,out] count       Number of used entries
+     * @param[in]     maxEntries  Max. number of entries
+     *
+     * @return If all ids fit into the lookup table, it will return true otherwise false.
+     */
+    virtual bool collectIds(IdEntry* entries, uint8_t& count, uint8_t maxEntries)
+    {
+        bool isComplete = true;
+
+        if (ID_NONE != m_id)
+        {
+            if (maxEntries <= count)
+            {
+                isComplete = false;
+            }
+            else
+            {
+                entries[count].id       = m_id;
+                entries[count].widget   = this;
+                ++count;
+            }
+        }
+
+        return isComplete;
+    }
+
+    /**
+     * Hash a widget name to its id (32-bit FNV-1a).
+     * 
+     * @param[in] name  Widget name
+     * 
+     * @return Widget id or ID_NONE for a empty name
+     */
+    static uint32_t toId(const char* name)
+    {
+        const uint32_t  FNV_OFFSET_BASIS    = 2166136261U;
+        const uint32_t  FNV_PRIME           = 16777619U;
+        uint32_t        id                  = ID_NONE;
+
+        if ((nullptr != name) &&
+            ('\0' != name[0]))
+        {
+            id = FNV_OFFSET_BASIS;
+
+            while('\0' != *name)
+            {
+                id ^= static_cast<uint8_t>(*name);
+                id *= FNV_PRIME;
+                ++name;
+            }
+
+            /* A name must never result in the id of a widget without name. */
+            if (ID_NONE == id)
+            {
+                id = 1U;
+            }
+        }
+
+        return id;
+    }
+
 protected:
 
     const char* m_type; /**< Widget type string */
     int16_t     m_posX; /**< Upper left corner (x-coordinate) of the widget in a canvas. */
     int16_t     m_posY; /**< Upper left corner (y-coordinate) of the widget in a canvas. */
-    String      m_name; /**< Widget name for identification. */
+    uint32_t    m_id;   /**< Widget id for identification, hashed from its name. */
+
+    /**
+     * Get the generation of all widget trees. It changes whenever a widget
+     * id or the children of a canvas change, which invalidates the lookup
+     * tables of the canvases.
+     *
+     * @return Tree generation
+     */
+    static uint32_t& getTreeGeneration()
+    {
+        static uint32_t generation = 0U;
+
+        return generation;
+    }
 
     /**
      * Constructs a widget at position (0, 0) in the canvas.
@@ -191,7 +365,13 @@ protected:
         m_type(type),
         m_posX(0),
         m_posY(0),
-        m_name()
+        m_id(ID_NONE),
+        m_isInvalid(true),
+        m_isRedrawPending(false),
+        m_areaX1(0),
+        m_areaY1(0),
+        m_areaX2(-1),
+        m_areaY2(-1)
     {
     }
 
@@ -206,13 +386,19 @@ protected:
         m_type(type),
         m_posX(x),
         m_posY(y),
-        m_name()
+        m_id(ID_NONE),
+        m_isInvalid(true),
+        m_isRedrawPending(false),
+        m_areaX1(0),
+        m_areaY1(0),
+        m_areaX2(-1),
+        m_areaY2(-1)
     {
     }
 
     /**
      * Constructs a widget by copying a widget.
-     * Note, its name won't be assigned.
+     * Note, its id won't be assigned.
      * 
      * @param[in] widget The widget, which to copy.
     */
@@ -220,12 +406,31 @@ protected:
         m_type(widget.m_type),
         m_posX(widget.m_posX),
         m_posY(widget.m_posY),
-        m_name()
+        m_id(ID_NONE),
+        m_isInvalid(true),
+        m_isRedrawPending(false),
+        m_areaX1(0),
+        m_areaY1(0),
+        m_areaX2(-1),
+        m_areaY2(-1)
     {
     }
 
 private:
 
+    /* The canvas keeps track of the area, every widget covers. */
+    friend class Canvas;
+
+    /* The canvas view draws a widget only if it is invalid. */
+    friend class CanvasView;
+
+    bool        m_isInvalid;        /**< Widget shall be drawn again. */
+    bool        m_isRedrawPending;  /**< Widget is drawn again in the current canvas update. */
+    int16_t     m_areaX1;           /**< Area covered in the canvas, upper left x-coordinate */
+    int16_t     m_areaY1;           /**< Area covered in the canvas, upper left y-coordinate */
+    int16_t     m_areaX2;           /**< Area covered in the canvas, lower right x-coordinate (inclusive) */
+    int16_t     m_areaY2;           /**< Area covered in the canvas, lower right y-coordinate (inclusive) */
+
     /* Default constructor not allowed. */
     Widget();
 };
@@ -0,0 +1,549 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed capacity list
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __FIXEDLIST_HPP__
+#define __FIXEDLIST_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+template < typename T, uint32_t CAPACITY >
+class FixedList;
+
+/**
+ * Fixed capacity list iterator.
+ * It provides the same interface as the doubly linked list iterator.
+ */
+template < typename T, uint32_t CAPACITY >
+class FixedListIterator
+{
+public:
+
+    /**
+     * Constructs a iterator for the fixed capacity list.
+     *
+     * @param[in] list  Fixed capacity list
+     */
+    FixedListIterator(FixedList<T, CAPACITY>& list) :
+        m_list(list),
+        m_index(0U)
+    {
+    }
+
+    /**
+     * Destroys the iterator of the fixed capacity list.
+     */
+    ~FixedListIterator()
+    {
+    }
+
+    /**
+     * Select first element.
+     *
+     * @return If list is empty, it will return false otherwise true.
+     */
+    bool first()
+    {
+        bool status = false;
+
+        if (0U < m_list.m_count)
+        {
+            m_index = 0U;
+            status  = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Select last element.
+     *
+     * @return If list is empty, it will return false otherwise true.
+     */
+    bool last()
+    {
+        bool status = false;
+
+        if (0U < m_list.m_count)
+        {
+            m_index = m_list.m_count - 1U;
+            status  = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Select next element in the list.
+     * If the current selected element is the last element, it will return false
+     * otherwise true.
+     *
+     * @return If the current selected element is the last element, it will return false otherwise true.
+     */
+    bool next()
+    {
+        bool status = false;
+
+        if (m_list.m_count > (m_index + 1U))
+        {
+            ++m_index;
+            status = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Select previous element in the list.
+     * If the current selected element is the first element, it will return false
+     * otherwise true.
+     *
+     * @return If the current selected element is the first element, it will return false otherwise true.
+     */
+    bool prev()
+    {
+        bool status = false;
+
+        if ((0U < m_index) &&
+            (m_list.m_count > m_index))
+        {
+            --m_index;
+            status = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Get current selected element.
+     *
+     * @return Selected element
+     */
+    T* current()
+    {
+        T* elem = nullptr;
+
+        if (m_list.m_count > m_index)
+        {
+            elem = &m_list.m_elements[m_index];
+        }
+
+        return elem;
+    }
+
+    /**
+     * Search for a specific element in the list and select it.
+     * It starts searching from the current selected element till end of the list.
+     * If element is not found, the last element in the list is selected.
+     *
+     * @param[in] element   Element to find
+     */
+    bool find(const T& element)
+    {
+        bool found = false;
+
+        if (m_list.m_count > m_index)
+        {
+            do
+            {
+                if (element == m_list.m_elements[m_index])
+                {
+                    found = true;
+                }
+            }
+            while((false == found) && (true == next()));
+        }
+
+        return found;
+    }
+
+    /**
+     * Remove selected element from list.
+     * Afterwards the first element is selected.
+     */
+    void remove()
+    {
+        m_list.remove(m_index);
+        m_index = 0U;
+
+        return;
+    }
+
+private:
+
+    FixedList<T, CAPACITY>& m_list;     /**< Fixed capacity list */
+    uint32_t                m_index;    /**< Index of current selected element */
+
+    FixedListIterator();
+};
+
+/**
+ * Fixed capacity list const iterator.
+ * It provides the same interface as the doubly linked list const iterator.
+ */
+template < typename T, uint32_t CAPACITY >
+class FixedListConstIterator
+{
+public:
+
+    /**
+     * Constructs a const iterator for the fixed capacity list.
+     *
+     * @param[in] list  Fixed capacity list
+     */
+    FixedListConstIterator(const FixedList<T, CAPACITY>& list) :
+        m_list(list),
+        m_index(0U)
+    {
+    }
+
+    /**
+     * Destroys the const iterator of the fixed capacity list.
+     */
+    ~FixedListConstIterator()
+    {
+    }
+
+    /**
+     * Select first element.
+     *
+     * @return If list is empty, it will return false otherwise true.
+     */
+    bool first()
+    {
+        bool status = false;
+
+        if (0U < m_list.m_count)
+        {
+            m_index = 0U;
+            status  = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Select last element.
+     *
+     * @return If list is empty, it will return false otherwise true.
+     */
+    bool last()
+    {
+        bool status = false;
+
+        if (0U < m_list.m_count)
+        {
+            m_index = m_list.m_count - 1U;
+            status  = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Select next element in the list.
+     * If the current selected element is the last element, it will return false
+     * otherwise true.
+     *
+     * @return If the current selected element is the last element, it will return false otherwise true.
+     */
+    bool next()
+    {
+        bool status = false;
+
+        if (m_list.m_count > (m_index + 1U))
+        {
+            ++m_index;
+            status = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Select previous element in the list.
+     * If the current selected element is the first element, it will return false
+     * otherwise true.
+     *
+     * @return If the current selected element is the first element, it will return false otherwise true.
+     */
+    bool prev()
+    {
+        bool status = false;
+
+        if ((0U < m_index) &&
+            (m_list.m_count > m_index))
+        {
+            --m_index;
+            status = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Get current selected element.
+     *
+     * @return Selected element
+     */
+    const T* current()
+    {
+        const T* elem = nullptr;
+
+        if (m_list.m_count > m_index)
+        {
+            elem = &m_list.m_elements[m_index];
+        }
+
+        return elem;
+    }
+
+    /**
+     * Search for a specific element in the list and select it.
+     * It starts searching from the current selected element till end of the list.
+     * If element is not found, the last element in the list is selected.
+     *
+     * @param[in] element   Element to find
+     */
+    bool find(const T& element)
+    {
+        bool found = false;
+
+        if (m_list.m_count > m_index)
+        {
+            do
+            {
+                if (element == m_list.m_elements[m_index])
+                {
+                    found = true;
+                }
+            }
+            while((false == found) && (true == next()));
+        }
+
+        return found;
+    }
+
+private:
+
+    const FixedList<T, CAPACITY>&   m_list;     /**< Fixed capacity list */
+    uint32_t                        m_index;    /**< Index of current selected element */
+
+    FixedListConstIterator();
+};
+
+/**
+ * List with a fixed capacity, which stores its elements in a preallocated
+ * array. In contrast to the doubly linked list, appending an element doesn't
+ * allocate memory on the heap and the elements are contiguous in memory.
+ *
+ * @param[in] T         Type of element
+ * @param[in] CAPACITY  Max. number of elements
+ */
+template < typename T, uint32_t CAPACITY >
+class FixedList
+{
+public:
+
+    /**
+     * Constructs an empty list.
+     */
+    FixedList() :
+        m_elements(),
+        m_count(0U)
+    {
+    }
+
+    /**
+     * Constructs a list by copying a existing one.
+     *
+     * @param[in] list  List, which to copy
+     */
+    FixedList(const FixedList& list) :
+        m_elements(),
+        m_count(0U)
+    {
+        while(list.m_count > m_count)
+        {
+            m_elements[m_count] = list.m_elements[m_count];
+            ++m_count;
+        }
+    }
+
+    /**
+     * Destroys the list.
+     */
+    ~FixedList()
+    {
+        clear();
+    }
+
+    /**
+     * Assigns a existing list.
+     *
+     * @param[in] list  List, which to assign
+     *
+     * @return List
+     */
+    FixedList& operator=(const FixedList& list)
+    {
+        if (this != &list)
+        {
+            clear();
+
+            while(list.m_count > m_count)
+            {
+                m_elements[m_count] = list.m_elements[m_count];
+                ++m_count;
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * Append element to the list tail.
+     *
+     * @param[in] element New element in the list.
+     *
+     * @return If element is appended, it will return true otherwise false.
+     */
+    bool append(const T& element)
+    {
+        bool status = false;
+
+        if (CAPACITY > m_count)
+        {
+            m_elements[m_count] = element;
+            ++m_count;
+
+            status = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Clear list.
+     */
+    void clear()
+    {
+        while(0U < m_count)
+        {
+            --m_count;
+            m_elements[m_count] = T();
+        }
+
+        return;
+    }
+
+    /**
+     * Get number of elements in the list.
+     *
+     * @return Number of elements in the list.
+     */
+    uint32_t getNumOfElements() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Get max. number of elements, the list can store.
+     *
+     * @return Max. number of elements
+     */
+    uint32_t getCapacity() const
+    {
+        return CAPACITY;
+    }
+
+private:
+
+    T           m_elements[CAPACITY];   /**< Elements */
+    uint32_t    m_count;                /**< Number of elements in the list */
+
+    /**
+     * Remove element from list.
+     * The following elements are moved up, to keep the order.
+     *
+     * @param[in] index Index of the element, which to remove
+     */
+    void remove(uint32_t index)
+    {
+        if (m_count > index)
+        {
+            --m_count;
+
+            while(m_count > index)
+            {
+                m_elements[index] = m_elements[index + 1U];
+                ++index;
+            }
+
+            m_elements[m_count] = T();
+        }
+
+        return;
+    }
+
+    template < typename T0, uint32_t C0 >
+    friend class FixedListIterator;
+
+    template < typename T1, uint32_t C1 >
+    friend class FixedListConstIterator;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FIXEDLIST_HPP__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,310 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed capacity hash map with 16-bit keys
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __UIDMAP_HPP__
+#define __UIDMAP_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Fixed capacity hash map, which maps a 16-bit unique id (e.g. a plugin UID)
+ * to a value. It uses open addressing with linear probing and needs no heap.
+ *
+ * One entry is always kept free, so the max. number of elements is SIZE - 1.
+ *
+ * @tparam T    Value type
+ * @tparam SIZE Number of entries, must be a power of two.
+ */
+template < typename T, uint16_t SIZE >
+class UidMap
+{
+public:
+
+    /**
+     * Constructs a empty map.
+     */
+    UidMap() :
+        m_entries(),
+        m_count(0U)
+    {
+        clear();
+    }
+
+    /**
+     * Destroys the map.
+     */
+    ~UidMap()
+    {
+    }
+
+    /**
+     * Insert a element. If the UID already exists, its value will be replaced.
+     *
+     * @param[in] uid   Unique id
+     * @param[in] value Value
+     *
+     * @return If the map is full, it will return false otherwise true.
+     */
+    bool insert(uint16_t uid, const T& value)
+    {
+        bool        status  = false;
+        uint16_t    index   = getIndex(uid);
+
+        if (SIZE > index)
+        {
+            m_entries[index].value = value;
+            status = true;
+        }
+        else if ((SIZE - 1U) > m_count)
+        {
+            index = getHomeIndex(uid);
+
+            while(true == m_entries[index].isUsed)
+            {
+                index = (index + 1U) & MASK;
+            }
+
+            m_entries[index].uid    = uid;
+            m_entries[index].value  = value;
+            m_entries[index].isUsed = true;
+            ++m_count;
+
+            status = true;
+        }
+        else
+        {
+            ;
+        }
+
+        return status;
+    }
+
+    /**
+     * Find a element.
+     *
+     * @param[in]   uid     Unique id
+     * @param[out]  value   Value
+     *
+     * @return If found, it will return true otherwise false.
+     */
+    bool find(uint16_t uid, T& value) const
+    {
+        bool        status  = false;
+        uint16_t    index   = getIndex(uid);
+
+        if (SIZE > index)
+        {
+            value   = m_entries[index].value;
+            status  = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Remove a element.
+     *
+     * @param[in] uid   Unique id
+     *
+     * @return If removed, it will return true otherwise false.
+     */
+    bool remove(uint16_t uid)
+    {
+        bool        status  = false;
+        uint16_t    index   = getIndex(uid);
+
+        if (SIZE > index)
+        {
+            uint16_t next = (index + 1U) & MASK;
+
+            /* Shift the following elements of the probe sequence backwards,
+             * so no deleted markers are necessary.
+             */
+            while(true == m_entries[next].isUsed)
+            {
+                uint16_t home = getHomeIndex(m_entries[next].uid);
+
+                if (false == isInRange(home, index, next))
+                {
+                    m_entries[index]    = m_entries[next];
+                    index               = next;
+                }
+
+                next = (next + 1U) & MASK;
+            }
+
+            m_entries[index].isUsed = false;
+            --m_count;
+
+            status = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Remove all elements.
+     */
+    void clear()
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < SIZE; ++index)
+        {
+            m_entries[index].isUsed = false;
+        }
+
+        m_count = 0U;
+
+        return;
+    }
+
+    /**
+     * Get number of elements.
+     *
+     * @return Number of elements
+     */
+    uint16_t getCount() const
+    {
+        return m_count;
+    }
+
+private:
+
+    /** Mask for the entry index. */
+    static const uint16_t MASK = SIZE - 1U;
+
+    /**
+     * Map entry.
+     */
+    struct Entry
+    {
+        uint16_t    uid;    /**< Unique id */
+        T           value;  /**< Value */
+        bool        isUsed; /**< Is entry used? */
+    };
+
+    Entry       m_entries[SIZE];    /**< Entries */
+    uint16_t    m_count;            /**< Number of elements */
+
+    /**
+     * Get the entry index, where the element is expected first.
+     *
+     * @param[in] uid   Unique id
+     *
+     * @return Entry index
+     */
+    static uint16_t getHomeIndex(uint16_t uid)
+    {
+        return (uid ^ (uid >> 8U)) & MASK;
+    }
+
+    /**
+     * Get the entry index of a element.
+     *
+     * @param[in] uid   Unique id
+     *
+     * @return If found, it will return the entry index otherwise SIZE.
+     */
+    uint16_t getIndex(uint16_t uid) const
+    {
+        uint16_t    index   = getHomeIndex(uid);
+        uint16_t    result  = SIZE;
+
+        while((SIZE <= result) && (true == m_entries[index].isUsed))
+        {
+            if (uid == m_entries[index].uid)
+            {
+                result = index;
+            }
+            else
+            {
+                index = (index + 1U) & MASK;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * Is the entry index in the cyclic range (first; last]?
+     *
+     * @param[in] index Entry index
+     * @param[in] first First entry index (excluded)
+     * @param[in] last  Last entry index (included)
+     *
+     * @return If in range, it will return true otherwise false.
+     */
+    static bool isInRange(uint16_t index, uint16_t first, uint16_t last)
+    {
+        bool isIn = false;
+
+        if (first <= last)
+        {
+            isIn = (first < index) && (index <= last);
+        }
+        else
+        {
+            isIn = (first < index) || (index <= last);
+        }
+
+        return isIn;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __UIDMAP_HPP__ */
+
+/** @} */
\ No newline at end of file
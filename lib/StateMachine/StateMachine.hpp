@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <stddef.h>
+#include <stdint.h>
 
 /******************************************************************************
  * Macros
@@ -90,6 +91,18 @@ public:
      */
     virtual void process(StateMachine& sm) = 0;
 
+    /**
+     * Get the max. time, the state may wait for an event, until it needs to
+     * be processed again. A state, which only reacts on events, doesn't need
+     * to override it.
+     *
+     * @return Wait time in ms or WAIT_FOREVER
+     */
+    virtual uint32_t getWaitTime() const
+    {
+        return WAIT_FOREVER;
+    }
+
     /**
      * The exit is called once, a state will be left.
      * 
@@ -97,6 +110,9 @@ public:
      */
     virtual void exit(StateMachine& sm) = 0;
 
+    /** Wait time, if the state is processed only on events. */
+    static const uint32_t   WAIT_FOREVER    = UINT32_MAX;
+
 private:
 
     AbstractState(const AbstractState& state);
@@ -140,6 +156,33 @@ public:
         return m_currentState;
     }
 
+    /**
+     * Get the max. time, the state machine may wait for an event, until it
+     * needs to be processed again. A pending state change is processed
+     * immediately.
+     *
+     * @return Wait time in ms or AbstractState::WAIT_FOREVER
+     */
+    uint32_t getWaitTime() const
+    {
+        uint32_t waitTime = AbstractState::WAIT_FOREVER;
+
+        if (nullptr != m_nextState)
+        {
+            waitTime = 0U;
+        }
+        else if (nullptr != m_currentState)
+        {
+            waitTime = m_currentState->getWaitTime();
+        }
+        else
+        {
+            ;
+        }
+
+        return waitTime;
+    }
+
     /**
      * Set next state.
      * 
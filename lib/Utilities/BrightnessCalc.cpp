@@ -0,0 +1,275 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Brightness calculation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "BrightnessCalc.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t log2Fixed(uint32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of fractional bits of a fixed-point logarithm. */
+static const uint8_t    LOG_FRAC_BITS   = 16U;
+
+/** Illuminance of UINT16_MAX: 100000 lux, fixed-point with LUX_FRAC_BITS */
+static const uint32_t   LUX_LIMIT_HIGH  = 100000UL << BrightnessCalc::LUX_FRAC_BITS;
+
+/**
+ * Factor from log2 of the illuminance to the normalized light:
+ * log10(2) / 5 * UINT16_MAX / 2^LOG_FRAC_BITS, scaled by 2^32.
+ */
+static const uint64_t   LOG2_TO_NORM    = 258578852ULL;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+BrightnessCalc::BrightnessCalc(uint8_t brighteningHysteresis, uint8_t darkeningHysteresis, uint32_t shortTermTimeConst, uint32_t longTermTimeConst) :
+    m_brighteningHysteresis(brighteningHysteresis),
+    m_darkeningHysteresis(darkeningHysteresis),
+    m_shortTermTimeConst(shortTermTimeConst),
+    m_longTermTimeConst(longTermTimeConst),
+    m_shortTermAverage(0U),
+    m_longTermAverage(0U),
+    m_ambientLight(0U),
+    m_brighteningThreshold(0U),
+    m_darkeningThreshold(0U),
+    m_responseCurve()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < RESPONSE_CURVE_SIZE; ++index)
+    {
+        m_responseCurve[index] = static_cast<uint16_t>((static_cast<uint32_t>(index) * UINT16_MAX) / (RESPONSE_CURVE_SIZE - 1U));
+    }
+}
+
+void BrightnessCalc::reset(uint16_t light)
+{
+    m_shortTermAverage  = static_cast<uint32_t>(light) << AVG_FRAC_BITS;
+    m_longTermAverage   = m_shortTermAverage;
+
+    return;
+}
+
+void BrightnessCalc::applyMeasurement(uint32_t dTime, uint16_t light)
+{
+    m_shortTermAverage  = applyToAverage(m_shortTermAverage, m_shortTermTimeConst, dTime, light);
+    m_longTermAverage   = applyToAverage(m_longTermAverage, m_longTermTimeConst, dTime, light);
+
+    return;
+}
+
+void BrightnessCalc::setAmbientLight(uint16_t light)
+{
+    m_ambientLight          = light;
+    m_brighteningThreshold  = (static_cast<uint32_t>(light) * (100U + m_brighteningHysteresis)) / 100U;
+    m_darkeningThreshold    = (static_cast<uint32_t>(light) * (100U - m_darkeningHysteresis)) / 100U;
+
+    return;
+}
+
+bool BrightnessCalc::isBrightening() const
+{
+    const uint64_t THRESHOLD = static_cast<uint64_t>(m_brighteningThreshold) << AVG_FRAC_BITS;
+
+    return ((THRESHOLD < m_shortTermAverage) && (THRESHOLD < m_longTermAverage));
+}
+
+bool BrightnessCalc::isDarkening() const
+{
+    const uint64_t THRESHOLD = static_cast<uint64_t>(m_darkeningThreshold) << AVG_FRAC_BITS;
+
+    return ((THRESHOLD > m_shortTermAverage) && (THRESHOLD > m_longTermAverage));
+}
+
+uint8_t BrightnessCalc::calcBrightness(uint8_t minBrightness, uint8_t maxBrightness) const
+{
+    const uint32_t  POSITION    = static_cast<uint32_t>(m_ambientLight) * (RESPONSE_CURVE_SIZE - 1U);
+    const uint32_t  INDEX       = POSITION / UINT16_MAX;
+    const uint32_t  FRAC        = POSITION % UINT16_MAX;
+    uint32_t        fraction    = m_responseCurve[INDEX];
+    uint32_t        brightness  = minBrightness;
+
+    if ((RESPONSE_CURVE_SIZE - 1U) > INDEX)
+    {
+        fraction = ((fraction * (UINT16_MAX - FRAC)) + (static_cast<uint32_t>(m_responseCurve[INDEX + 1U]) * FRAC)) / UINT16_MAX;
+    }
+
+    if (maxBrightness > minBrightness)
+    {
+        brightness += ((maxBrightness - minBrightness) * fraction) / UINT16_MAX;
+    }
+
+    return static_cast<uint8_t>(brightness);
+}
+
+void BrightnessCalc::setResponseCurve(const uint16_t* curve)
+{
+    uint8_t index = 0U;
+
+    if (nullptr != curve)
+    {
+        for(index = 0U; index < RESPONSE_CURVE_SIZE; ++index)
+        {
+            m_responseCurve[index] = curve[index];
+        }
+    }
+
+    return;
+}
+
+void BrightnessCalc::getResponseCurve(uint16_t* curve) const
+{
+    uint8_t index = 0U;
+
+    if (nullptr != curve)
+    {
+        for(index = 0U; index < RESPONSE_CURVE_SIZE; ++index)
+        {
+            curve[index] = m_responseCurve[index];
+        }
+    }
+
+    return;
+}
+
+uint16_t BrightnessCalc::normalizeIlluminance(uint32_t illuminance)
+{
+    const uint32_t  LUX_LIMIT_LOW   = 1UL << LUX_FRAC_BITS;
+    uint16_t        light           = 0U;
+
+    if (LUX_LIMIT_HIGH <= illuminance)
+    {
+        light = UINT16_MAX;
+    }
+    else if (LUX_LIMIT_LOW < illuminance)
+    {
+        /* log2 of the integer illuminance is log2 of the fixed-point value minus its fractional bits. */
+        const uint64_t LOG2_LUX = log2Fixed(illuminance) - (static_cast<uint32_t>(LUX_FRAC_BITS) << LOG_FRAC_BITS);
+
+        light = static_cast<uint16_t>((LOG2_LUX * LOG2_TO_NORM) >> 32U);
+    }
+    else
+    {
+        ;
+    }
+
+    return light;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint32_t BrightnessCalc::applyToAverage(uint32_t average, uint32_t timeConst, uint32_t dTime, uint16_t light)
+{
+    const int64_t   TARGET  = static_cast<int64_t>(light) << AVG_FRAC_BITS;
+    const int64_t   DELTA   = TARGET - static_cast<int64_t>(average);
+
+    /* y += (x - y) * dt / (T + dt) */
+    return static_cast<uint32_t>(static_cast<int64_t>(average) + ((DELTA * dTime) / static_cast<int64_t>(timeConst + dTime)));
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Calculate the binary logarithm digit by digit.
+ *
+ * @param[in] value Value, must be greater than 0
+ *
+ * @return log2 of the value, fixed-point with LOG_FRAC_BITS
+ */
+static uint32_t log2Fixed(uint32_t value)
+{
+    const uint8_t   MANTISSA_BITS   = 31U;
+    const uint64_t  TWO             = 2ULL << MANTISSA_BITS;
+    uint32_t        result          = 0U;
+    uint8_t         msb             = 0U;
+    uint32_t        tmp             = value;
+    uint64_t        mantissa        = 0U;
+    uint32_t        bit             = 0U;
+
+    while(1U < tmp)
+    {
+        tmp >>= 1U;
+        ++msb;
+    }
+
+    result      = static_cast<uint32_t>(msb) << LOG_FRAC_BITS;
+    mantissa    = static_cast<uint64_t>(value) << (MANTISSA_BITS - msb);    /* [1; 2) */
+
+    /* Squaring the mantissa doubles its logarithm, which shifts the next
+     * fractional bit into the integer part.
+     */
+    for(bit = 1UL << (LOG_FRAC_BITS - 1U); 0U < bit; bit >>= 1U)
+    {
+        mantissa = (mantissa * mantissa) >> MANTISSA_BITS;
+
+        if (TWO <= mantissa)
+        {
+            mantissa >>= 1U;
+            result |= bit;
+        }
+    }
+
+    return result;
+}
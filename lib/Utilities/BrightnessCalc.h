@@ -0,0 +1,260 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Brightness calculation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __BRIGHTNESSCALC_H__
+#define __BRIGHTNESSCALC_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The brightness calculation derives the display brightness from the
+ * ambient light, using fixed-point arithmetic only.
+ *
+ * The normalized light is in the range of [0; UINT16_MAX], which
+ * corresponds to 1 - 100000 lux on a logarithmic scale. The measured light
+ * is smoothed by a short-term and a long-term moving average. A change of
+ * the ambient light is considered, if both averages are outside the
+ * hysteresis around the current ambient light.
+ *
+ * The brightness follows the ambient light by a response curve, which is a
+ * lookup table with linear interpolation between its points.
+ */
+class BrightnessCalc
+{
+public:
+
+    /** Number of points of the response curve. */
+    static const uint8_t    RESPONSE_CURVE_SIZE = 9U;
+
+    /** Number of fractional bits of a fixed-point illuminance. */
+    static const uint8_t    LUX_FRAC_BITS       = 8U;
+
+    /** Number of fractional bits of the moving averages. */
+    static const uint8_t    AVG_FRAC_BITS       = 16U;
+
+    /**
+     * Constructs the brightness calculation with a linear response curve.
+     *
+     * @param[in] brighteningHysteresis Hysteresis for brightening in percent
+     * @param[in] darkeningHysteresis   Hysteresis for darkening in percent
+     * @param[in] shortTermTimeConst    Time constant in ms of the short-term moving average
+     * @param[in] longTermTimeConst     Time constant in ms of the long-term moving average
+     */
+    BrightnessCalc(uint8_t brighteningHysteresis, uint8_t darkeningHysteresis, uint32_t shortTermTimeConst, uint32_t longTermTimeConst);
+
+    /**
+     * Destroys the brightness calculation.
+     */
+    ~BrightnessCalc()
+    {
+    }
+
+    /**
+     * Set both moving averages to the light.
+     *
+     * @param[in] light Light (normalized) [0; UINT16_MAX]
+     */
+    void reset(uint16_t light);
+
+    /**
+     * Apply a light measurement to the short-term and long-term moving
+     * average.
+     *
+     * @param[in] dTime Delta time in ms, between current and last measurement.
+     * @param[in] light Measured light (normalized) [0; UINT16_MAX]
+     */
+    void applyMeasurement(uint32_t dTime, uint16_t light);
+
+    /**
+     * Get the short-term moving average.
+     *
+     * @return Light (normalized) [0; UINT16_MAX]
+     */
+    uint16_t getShortTermAverage() const
+    {
+        return static_cast<uint16_t>(m_shortTermAverage >> AVG_FRAC_BITS);
+    }
+
+    /**
+     * Get the long-term moving average.
+     *
+     * @return Light (normalized) [0; UINT16_MAX]
+     */
+    uint16_t getLongTermAverage() const
+    {
+        return static_cast<uint16_t>(m_longTermAverage >> AVG_FRAC_BITS);
+    }
+
+    /**
+     * Set the ambient light and update the brightening and darkening
+     * thresholds.
+     *
+     * @param[in] light Ambient light (normalized) [0; UINT16_MAX]
+     */
+    void setAmbientLight(uint16_t light);
+
+    /**
+     * Get the ambient light.
+     *
+     * @return Ambient light (normalized) [0; UINT16_MAX]
+     */
+    uint16_t getAmbientLight() const
+    {
+        return m_ambientLight;
+    }
+
+    /**
+     * Get the brightening threshold, which may be greater than UINT16_MAX.
+     *
+     * @return Threshold (normalized)
+     */
+    uint32_t getBrighteningThreshold() const
+    {
+        return m_brighteningThreshold;
+    }
+
+    /**
+     * Get the darkening threshold.
+     *
+     * @return Threshold (normalized)
+     */
+    uint32_t getDarkeningThreshold() const
+    {
+        return m_darkeningThreshold;
+    }
+
+    /**
+     * Is the ambient environment brightening? Both averages are above the
+     * brightening threshold.
+     *
+     * @return If brightening, it will return true otherwise false.
+     */
+    bool isBrightening() const;
+
+    /**
+     * Is the ambient environment darkening? Both averages are below the
+     * darkening threshold.
+     *
+     * @return If darkening, it will return true otherwise false.
+     */
+    bool isDarkening() const;
+
+    /**
+     * Calculate the brightness of the ambient light by the response curve.
+     *
+     * @param[in] minBrightness Min. brightness in digits [0; 255]
+     * @param[in] maxBrightness Max. brightness in digits [0; 255]
+     *
+     * @return Brightness in digits [minBrightness; maxBrightness]
+     */
+    uint8_t calcBrightness(uint8_t minBrightness, uint8_t maxBrightness) const;
+
+    /**
+     * Set the response curve. The points are equally distributed over the
+     * normalized light, from 0 to UINT16_MAX. Every point is the fraction
+     * [0; UINT16_MAX] of the brightness range between min. and max.
+     * brightness.
+     *
+     * @param[in] curve Response curve with RESPONSE_CURVE_SIZE points
+     */
+    void setResponseCurve(const uint16_t* curve);
+
+    /**
+     * Get the response curve.
+     *
+     * @param[out] curve    Response curve with RESPONSE_CURVE_SIZE points
+     */
+    void getResponseCurve(uint16_t* curve) const;
+
+    /**
+     * Normalize the illuminance on a logarithmic scale, which maps lux values
+     * to human perception, according to
+     * https://docs.microsoft.com/en-us/windows/win32/sensorsapi/understanding-and-interpreting-lux-values
+     * 1 lux and below results in 0, 100000 lux and above in UINT16_MAX.
+     *
+     * @param[in] illuminance   Illuminance in lux, fixed-point with LUX_FRAC_BITS
+     *
+     * @return Light (normalized) [0; UINT16_MAX]
+     */
+    static uint16_t normalizeIlluminance(uint32_t illuminance);
+
+private:
+
+    uint8_t     m_brighteningHysteresis;                /**< Hysteresis for brightening in percent */
+    uint8_t     m_darkeningHysteresis;                  /**< Hysteresis for darkening in percent */
+    uint32_t    m_shortTermTimeConst;                   /**< Time constant in ms of the short-term moving average */
+    uint32_t    m_longTermTimeConst;                    /**< Time constant in ms of the long-term moving average */
+    uint32_t    m_shortTermAverage;                     /**< Short-term moving average, fixed-point with AVG_FRAC_BITS */
+    uint32_t    m_longTermAverage;                      /**< Long-term moving average, fixed-point with AVG_FRAC_BITS */
+    uint16_t    m_ambientLight;                         /**< Ambient light (normalized) */
+    uint32_t    m_brighteningThreshold;                 /**< Brightening threshold (normalized) */
+    uint32_t    m_darkeningThreshold;                   /**< Darkening threshold (normalized) */
+    uint16_t    m_responseCurve[RESPONSE_CURVE_SIZE];   /**< Response curve */
+
+    /**
+     * Apply a light measurement to a moving average.
+     *
+     * @param[in] average   Moving average, fixed-point with AVG_FRAC_BITS
+     * @param[in] timeConst Time constant in ms
+     * @param[in] dTime     Delta time in ms
+     * @param[in] light     Measured light (normalized)
+     *
+     * @return New moving average
+     */
+    static uint32_t applyToAverage(uint32_t average, uint32_t timeConst, uint32_t dTime, uint16_t light);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BRIGHTNESSCALC_H__ */
+
+/** @} */
@@ -0,0 +1,136 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  CPU budget watchdog
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "BudgetWatchdog.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void BudgetWatchdog::reset()
+{
+    m_level     = LEVEL_NORMAL;
+    m_throttle  = 0U;
+    m_overruns  = 0U;
+    m_passes    = 0U;
+
+    return;
+}
+
+BudgetWatchdog::Level BudgetWatchdog::addSample(uint32_t duration, uint32_t budget)
+{
+    /* A exceeded budget is kept until reset. */
+    if (LEVEL_EXCEEDED == m_level)
+    {
+        ;
+    }
+    else if (budget < duration)
+    {
+        m_passes = 0U;
+        ++m_overruns;
+
+        if (OVERRUN_LIMIT <= m_overruns)
+        {
+            m_overruns = 0U;
+
+            if (MAX_THROTTLE > m_throttle)
+            {
+                ++m_throttle;
+                m_level = LEVEL_THROTTLED;
+            }
+            else
+            {
+                m_level = LEVEL_EXCEEDED;
+            }
+        }
+    }
+    else
+    {
+        ++m_passes;
+
+        if (RECOVERY_LIMIT <= m_passes)
+        {
+            m_passes    = 0U;
+            m_overruns  = 0U;
+
+            if (0U < m_throttle)
+            {
+                --m_throttle;
+
+                if (0U == m_throttle)
+                {
+                    m_level = LEVEL_NORMAL;
+                }
+            }
+        }
+    }
+
+    return m_level;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,173 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  CPU budget watchdog
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __BUDGETWATCHDOG_H__
+#define __BUDGETWATCHDOG_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The budget watchdog observes the runtime of a periodic call, e.g. of a
+ * plugin. If the runtime exceeds its budget repeatedly, the watchdog
+ * throttles the call step by step by a longer min. period. If the budget
+ * is still exceeded at the last throttle step, the budget is considered
+ * as exceeded for good until the watchdog is reset.
+ * A sufficient number of calls within the budget relaxes the throttling
+ * again by one step.
+ */
+class BudgetWatchdog
+{
+public:
+
+    /** Watchdog levels */
+    enum Level
+    {
+        LEVEL_NORMAL = 0,   /**< Within budget, no throttling */
+        LEVEL_THROTTLED,    /**< Budget exceeded repeatedly, throttled */
+        LEVEL_EXCEEDED      /**< Budget exceeded despite max. throttling */
+    };
+
+    /** Number of budget overruns, which lead to the next throttle step. */
+    static const uint8_t    OVERRUN_LIMIT       = 8U;
+
+    /** Number of calls within budget, which relax the throttling by one step. */
+    static const uint16_t   RECOVERY_LIMIT      = 256U;
+
+    /** Max. throttle step. */
+    static const uint8_t    MAX_THROTTLE        = 4U;
+
+    /** Min. period in ms at the first throttle step. It doubles with every further step. */
+    static const uint32_t   THROTTLE_PERIOD     = 50U;
+
+    /**
+     * Constructs the watchdog at normal level.
+     */
+    BudgetWatchdog() :
+        m_level(LEVEL_NORMAL),
+        m_throttle(0U),
+        m_overruns(0U),
+        m_passes(0U)
+    {
+    }
+
+    /**
+     * Destroys the watchdog.
+     */
+    ~BudgetWatchdog()
+    {
+    }
+
+    /**
+     * Reset the watchdog to normal level.
+     */
+    void reset();
+
+    /**
+     * Add the runtime of a call and check it against the budget.
+     *
+     * @param[in] duration  Runtime of the call
+     * @param[in] budget    Budget in the same unit as the runtime
+     *
+     * @return Watchdog level after the check
+     */
+    Level addSample(uint32_t duration, uint32_t budget);
+
+    /**
+     * Get the watchdog level.
+     *
+     * @return Watchdog level
+     */
+    Level getLevel() const
+    {
+        return m_level;
+    }
+
+    /**
+     * Get the current throttle step.
+     *
+     * @return Throttle step [0; MAX_THROTTLE] - 0 means not throttled.
+     */
+    uint8_t getThrottle() const
+    {
+        return m_throttle;
+    }
+
+    /**
+     * Get the min. period between two calls, caused by throttling.
+     *
+     * @return Min. period in ms. If not throttled, it will return 0.
+     */
+    uint32_t getMinPeriod() const
+    {
+        uint32_t minPeriod = 0U;
+
+        if (0U < m_throttle)
+        {
+            minPeriod = THROTTLE_PERIOD << (m_throttle - 1U);
+        }
+
+        return minPeriod;
+    }
+
+private:
+
+    Level       m_level;    /**< Watchdog level */
+    uint8_t     m_throttle; /**< Throttle step */
+    uint8_t     m_overruns; /**< Budget overruns since the last step */
+    uint16_t    m_passes;   /**< Calls within budget since the last overrun */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BUDGETWATCHDOG_H__ */
+
+/** @} */
@@ -0,0 +1,139 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Button gesture detection
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ButtonGesture.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+uint8_t ButtonGesture::process(bool isPressed, uint32_t timestamp)
+{
+    uint8_t events = EVENT_NONE;
+
+    /* A pending click, which didn't become a double click in time? */
+    if ((true == m_isClickPending) &&
+        (m_doubleClickTime < (timestamp - m_releaseTimestamp)))
+    {
+        m_isClickPending = false;
+        events |= EVENT_CLICK;
+    }
+
+    /* Button pressed now? */
+    if ((false == m_isPressed) &&
+        (true == isPressed))
+    {
+        m_isPressed         = true;
+        m_isLongPress       = false;
+        m_isSecondPress     = m_isClickPending;
+        m_isClickPending    = false;
+        m_pressTimestamp    = timestamp;
+        events |= EVENT_PRESSED;
+    }
+    /* Button released now? */
+    else if ((true == m_isPressed) &&
+             (false == isPressed))
+    {
+        m_isPressed         = false;
+        m_releaseTimestamp  = timestamp;
+        events |= EVENT_RELEASED;
+
+        /* The release after a long press is no click. */
+        if (true == m_isLongPress)
+        {
+            ;
+        }
+        else if (true == m_isSecondPress)
+        {
+            events |= EVENT_DOUBLE_CLICK;
+        }
+        else
+        {
+            m_isClickPending = true;
+        }
+
+        m_isSecondPress = false;
+    }
+    /* Button pressed long enough? */
+    else if ((true == m_isPressed) &&
+             (false == m_isLongPress) &&
+             (m_longPressTime <= (timestamp - m_pressTimestamp)))
+    {
+        m_isLongPress = true;
+        events |= EVENT_LONG_PRESS;
+    }
+    else
+    {
+        ;
+    }
+
+    return events;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,159 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Button gesture detection
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __BUTTONGESTURE_H__
+#define __BUTTONGESTURE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Detects the gestures of a single button from its debounced state.
+ * A click is reported only after the double click time, because it may
+ * become a double click. After a long press, the release isn't reported
+ * as click.
+ */
+class ButtonGesture
+{
+public:
+
+    /**
+     * Gesture events, which may be combined.
+     */
+    enum Event
+    {
+        EVENT_NONE          = 0x00U,    /**< No event */
+        EVENT_PRESSED       = 0x01U,    /**< Button is pressed */
+        EVENT_RELEASED      = 0x02U,    /**< Button is released */
+        EVENT_CLICK         = 0x04U,    /**< Button was pressed and released once */
+        EVENT_DOUBLE_CLICK  = 0x08U,    /**< Button was pressed and released twice */
+        EVENT_LONG_PRESS    = 0x10U     /**< Button is pressed longer than the long press time */
+    };
+
+    /** Default min. duration in ms of a long press. */
+    static const uint32_t   LONG_PRESS_TIME_DEFAULT     = 1000U;
+
+    /** Default max. duration in ms between the release and the next press of a double click. */
+    static const uint32_t   DOUBLE_CLICK_TIME_DEFAULT   = 300U;
+
+    /**
+     * Constructs the gesture detection for a released button.
+     *
+     * @param[in] longPressTime     Min. duration in ms of a long press
+     * @param[in] doubleClickTime   Max. duration in ms between the release and the next press of a double click
+     */
+    ButtonGesture(uint32_t longPressTime = LONG_PRESS_TIME_DEFAULT, uint32_t doubleClickTime = DOUBLE_CLICK_TIME_DEFAULT) :
+        m_longPressTime(longPressTime),
+        m_doubleClickTime(doubleClickTime),
+        m_isPressed(false),
+        m_isLongPress(false),
+        m_isClickPending(false),
+        m_isSecondPress(false),
+        m_pressTimestamp(0U),
+        m_releaseTimestamp(0U)
+    {
+    }
+
+    /**
+     * Destroys the gesture detection.
+     */
+    ~ButtonGesture()
+    {
+    }
+
+    /**
+     * Process the debounced button state. Call it on every state change and
+     * periodically, as long as the gesture detection is not idle.
+     *
+     * @param[in] isPressed Is the button pressed?
+     * @param[in] timestamp Timestamp in ms
+     *
+     * @return Detected events, see Event.
+     */
+    uint8_t process(bool isPressed, uint32_t timestamp);
+
+    /**
+     * Is the gesture detection idle? If idle, it needs no periodic processing
+     * until the next button state change.
+     *
+     * @return If idle, it will return true otherwise false.
+     */
+    bool isIdle() const
+    {
+        bool isIdle = false;
+
+        if ((false == m_isClickPending) &&
+            ((false == m_isPressed) || (true == m_isLongPress)))
+        {
+            isIdle = true;
+        }
+
+        return isIdle;
+    }
+
+private:
+
+    uint32_t    m_longPressTime;        /**< Min. duration in ms of a long press */
+    uint32_t    m_doubleClickTime;      /**< Max. duration in ms between release and next press of a double click */
+    bool        m_isPressed;            /**< Is the button pressed? */
+    bool        m_isLongPress;          /**< Is the current press reported as long press? */
+    bool        m_isClickPending;       /**< Is a click pending, which may become a double click? */
+    bool        m_isSecondPress;        /**< Is the current press the second one of a double click? */
+    uint32_t    m_pressTimestamp;       /**< Timestamp in ms of the last press */
+    uint32_t    m_releaseTimestamp;     /**< Timestamp in ms of the last release */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BUTTONGESTURE_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,220 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Configuration journal
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ConfigJournal.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeUInt16(uint8_t* buffer, uint16_t value);
+static uint16_t readUInt16(const uint8_t* buffer);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t ConfigJournal::writeHeader(uint8_t* buffer, size_t size)
+{
+    size_t written = 0U;
+
+    if ((nullptr != buffer) &&
+        (HEADER_SIZE <= size))
+    {
+        buffer[0] = MAGIC;
+        buffer[1] = VERSION;
+        buffer[2] = 0U;
+        buffer[3] = 0U;
+
+        written = HEADER_SIZE;
+    }
+
+    return written;
+}
+
+bool ConfigJournal::isHeaderValid(const uint8_t* buffer, size_t size)
+{
+    bool isValid = false;
+
+    /* Later versions must keep the entry format, otherwise they need a
+     * different magic.
+     */
+    if ((nullptr != buffer) &&
+        (HEADER_SIZE <= size) &&
+        (MAGIC == buffer[0]) &&
+        (0U < buffer[1]))
+    {
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+size_t ConfigJournal::writeEntry(uint16_t uid, const uint8_t* data, size_t dataSize, uint8_t* buffer, size_t size)
+{
+    size_t written = 0U;
+
+    if ((nullptr != buffer) &&
+        (MAX_DATA_SIZE >= dataSize) &&
+        (getEntrySize(dataSize) <= size) &&
+        ((nullptr != data) || (0U == dataSize)))
+    {
+        writeUInt16(&buffer[0], uid);
+        writeUInt16(&buffer[2], static_cast<uint16_t>(dataSize));
+
+        if (0U < dataSize)
+        {
+            memcpy(&buffer[ENTRY_HEADER_SIZE], data, dataSize);
+        }
+
+        writeUInt16(&buffer[4], getChecksum(buffer, &buffer[ENTRY_HEADER_SIZE], dataSize));
+
+        written = getEntrySize(dataSize);
+    }
+
+    return written;
+}
+
+size_t ConfigJournal::readEntry(const uint8_t* buffer, size_t size, Entry& entry)
+{
+    size_t read = 0U;
+
+    if ((nullptr != buffer) &&
+        (ENTRY_HEADER_SIZE <= size))
+    {
+        const uint16_t DATA_SIZE = readUInt16(&buffer[2]);
+
+        if (getEntrySize(DATA_SIZE) <= size)
+        {
+            const uint8_t* data = &buffer[ENTRY_HEADER_SIZE];
+
+            if (readUInt16(&buffer[4]) == getChecksum(buffer, data, DATA_SIZE))
+            {
+                entry.uid   = readUInt16(&buffer[0]);
+                entry.data  = data;
+                entry.size  = DATA_SIZE;
+
+                read = getEntrySize(DATA_SIZE);
+            }
+        }
+    }
+
+    return read;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void ConfigJournal::addToChecksum(const uint8_t* data, size_t size, uint16_t& sum1, uint16_t& sum2)
+{
+    size_t index = 0U;
+
+    for(index = 0U; index < size; ++index)
+    {
+        sum1 = (sum1 + data[index]) % 255U;
+        sum2 = (sum2 + sum1) % 255U;
+    }
+
+    return;
+}
+
+uint16_t ConfigJournal::getChecksum(const uint8_t* header, const uint8_t* data, size_t dataSize)
+{
+    const size_t    CHECKED_HEADER_SIZE = 4U;   /* UID and data size */
+    uint16_t        sum1                = 0U;
+    uint16_t        sum2                = 0U;
+
+    addToChecksum(header, CHECKED_HEADER_SIZE, sum1, sum2);
+    addToChecksum(data, dataSize, sum1, sum2);
+
+    return static_cast<uint16_t>((sum2 << 8U) | sum1);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a 16-bit value in little endian order.
+ *
+ * @param[out]  buffer  Buffer
+ * @param[in]   value   Value
+ */
+static void writeUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 0U);
+    buffer[1] = static_cast<uint8_t>(value >> 8U);
+
+    return;
+}
+
+/**
+ * Read a 16-bit value in little endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint16_t readUInt16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0]) |
+           (static_cast<uint16_t>(buffer[1]) << 8U);
+}
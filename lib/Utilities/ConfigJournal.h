@@ -0,0 +1,193 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Configuration journal
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __CONFIGJOURNAL_H__
+#define __CONFIGJOURNAL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Binary format of the configuration journal, which contains the
+ * configurations of all plugins in a single file. A changed configuration
+ * is appended as new entry, so a write never touches the existing data.
+ * The last entry of a UID is the valid one, a entry without data removes
+ * the configuration.
+ *
+ * Format (little endian):
+ * - Header: magic (1 byte), version (1 byte), reserved (2 byte)
+ * - Entry: UID (2 byte), data size (2 byte), checksum (2 byte), data
+ *
+ * The checksum (Fletcher-16) covers the UID, the data size and the data.
+ * A entry, which was not written completely e.g. because of a power loss,
+ * fails the check. It and all following entries are ignored then.
+ */
+class ConfigJournal
+{
+public:
+
+    /** Format identification */
+    static const uint8_t    MAGIC               = 0xC5U;
+
+    /** Current format version */
+    static const uint8_t    VERSION             = 1U;
+
+    /** Header size in byte */
+    static const size_t     HEADER_SIZE         = 4U;
+
+    /** Entry header size in byte */
+    static const size_t     ENTRY_HEADER_SIZE   = 6U;
+
+    /** Max. data size in byte of a single entry */
+    static const size_t     MAX_DATA_SIZE       = UINT16_MAX;
+
+    /**
+     * A journal entry.
+     */
+    struct Entry
+    {
+        uint16_t        uid;    /**< Plugin UID */
+        const uint8_t*  data;   /**< Configuration data, which is located in the journal buffer */
+        uint16_t        size;   /**< Data size in byte, 0 means the configuration is removed */
+    };
+
+    /**
+     * Get the number of bytes, which are necessary to store a entry.
+     *
+     * @param[in] dataSize  Data size in byte
+     *
+     * @return Entry size in byte
+     */
+    static size_t getEntrySize(size_t dataSize)
+    {
+        return ENTRY_HEADER_SIZE + dataSize;
+    }
+
+    /**
+     * Write the journal header.
+     *
+     * @param[out]  buffer  Buffer, which to fill
+     * @param[in]   size    Buffer size in byte
+     *
+     * @return Number of written bytes. If the buffer is too small, it will return 0.
+     */
+    static size_t writeHeader(uint8_t* buffer, size_t size);
+
+    /**
+     * Check the journal header.
+     *
+     * @param[in] buffer    Buffer with binary data
+     * @param[in] size      Number of bytes in the buffer
+     *
+     * @return If the header is valid, it will return true otherwise false.
+     */
+    static bool isHeaderValid(const uint8_t* buffer, size_t size);
+
+    /**
+     * Write a entry.
+     *
+     * @param[in]   uid         Plugin UID
+     * @param[in]   data        Configuration data, may be nullptr if the data size is 0.
+     * @param[in]   dataSize    Data size in byte
+     * @param[out]  buffer      Buffer, which to fill
+     * @param[in]   size        Buffer size in byte
+     *
+     * @return Number of written bytes. If the buffer is too small or the data too large, it will return 0.
+     */
+    static size_t writeEntry(uint16_t uid, const uint8_t* data, size_t dataSize, uint8_t* buffer, size_t size);
+
+    /**
+     * Read a entry.
+     *
+     * @param[in]   buffer  Buffer with binary data, starting at the entry.
+     * @param[in]   size    Number of bytes in the buffer
+     * @param[out]  entry   Entry, whose data refers to the buffer.
+     *
+     * @return Number of read bytes. If the entry is incomplete or corrupt, it will return 0.
+     */
+    static size_t readEntry(const uint8_t* buffer, size_t size, Entry& entry);
+
+private:
+
+    /**
+     * Constructs the journal.
+     * Not allowed, only the static methods shall be used.
+     */
+    ConfigJournal();
+
+    /**
+     * Continue the Fletcher-16 checksum calculation.
+     *
+     * @param[in]       data    Data
+     * @param[in]       size    Data size in byte
+     * @param[in,out]   sum1    First sum
+     * @param[in,out]   sum2    Second sum
+     */
+    static void addToChecksum(const uint8_t* data, size_t size, uint16_t& sum1, uint16_t& sum2);
+
+    /**
+     * Calculate the checksum of a entry.
+     *
+     * @param[in] header    Entry header, the UID and data size are used.
+     * @param[in] data      Configuration data
+     * @param[in] dataSize  Data size in byte
+     *
+     * @return Checksum
+     */
+    static uint16_t getChecksum(const uint8_t* header, const uint8_t* data, size_t dataSize);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __CONFIGJOURNAL_H__ */
+
+/** @} */
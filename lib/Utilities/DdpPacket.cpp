@@ -0,0 +1,157 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DDP packet
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DdpPacket.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint16_t readUInt16(const uint8_t* buffer);
+static uint32_t readUInt32(const uint8_t* buffer);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool DdpPacket::decode(const uint8_t* buffer, size_t size, DdpPacket& packet)
+{
+    bool isValid = false;
+
+    if ((nullptr != buffer) &&
+        (HEADER_SIZE <= size) &&
+        (VERSION_1 == (buffer[0] & VERSION_MASK)))
+    {
+        size_t dataOffset = HEADER_SIZE;
+
+        if (0U != (buffer[0] & FLAG_TIMECODE))
+        {
+            dataOffset += TIMECODE_SIZE;
+        }
+
+        if (dataOffset <= size)
+        {
+            const uint16_t LENGTH = readUInt16(&buffer[8]);
+
+            if ((dataOffset + LENGTH) <= size)
+            {
+                packet.flags    = buffer[0];
+                packet.sequence = buffer[1] & SEQUENCE_MASK;
+                packet.dataType = buffer[2];
+                packet.id       = buffer[3];
+                packet.offset   = readUInt32(&buffer[4]);
+                packet.length   = LENGTH;
+                packet.data     = &buffer[dataOffset];
+
+                isValid = true;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+uint8_t DdpPacket::getLostPackets(uint8_t prevSequence, uint8_t sequence)
+{
+    uint8_t lost = 0U;
+
+    /* The sequence numbers run from 1 to 15, 0 means not used. */
+    if ((0U != prevSequence) &&
+        (0U != sequence))
+    {
+        lost = static_cast<uint8_t>((sequence + SEQUENCE_MAX - prevSequence - 1U) % SEQUENCE_MAX);
+    }
+
+    return lost;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read a 16-bit value in big endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint16_t readUInt16(const uint8_t* buffer)
+{
+    return (static_cast<uint16_t>(buffer[0]) << 8U) |
+           static_cast<uint16_t>(buffer[1]);
+}
+
+/**
+ * Read a 32-bit value in big endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint32_t readUInt32(const uint8_t* buffer)
+{
+    return (static_cast<uint32_t>(buffer[0]) << 24U) |
+           (static_cast<uint32_t>(buffer[1]) << 16U) |
+           (static_cast<uint32_t>(buffer[2]) << 8U) |
+           static_cast<uint32_t>(buffer[3]);
+}
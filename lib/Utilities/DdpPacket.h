@@ -0,0 +1,183 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DDP packet
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __DDPPACKET_H__
+#define __DDPPACKET_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Packet of the Distributed Display Protocol (DDP), which streams raw pixel
+ * data via UDP. See http://www.3waylabs.com/ddp/
+ *
+ * Binary format (big endian):
+ * - Header: flags (1 byte), sequence number (1 byte), data type (1 byte), destination id (1 byte),
+ *   data offset in byte (4 byte), data length in byte (2 byte)
+ * - Optional timecode (4 byte), if the timecode flag is set.
+ * - Data
+ */
+class DdpPacket
+{
+public:
+
+    /** Default UDP port */
+    static const uint16_t   PORT            = 4048U;
+
+    /** Header size in byte */
+    static const size_t     HEADER_SIZE     = 10U;
+
+    /** Timecode size in byte */
+    static const size_t     TIMECODE_SIZE   = 4U;
+
+    /** Mask of the version in the flags */
+    static const uint8_t    VERSION_MASK    = 0xC0U;
+
+    /** Protocol version 1 */
+    static const uint8_t    VERSION_1       = 0x40U;
+
+    /** Flag: Timecode follows the header. */
+    static const uint8_t    FLAG_TIMECODE   = 0x10U;
+
+    /** Flag: Storage access */
+    static const uint8_t    FLAG_STORAGE    = 0x08U;
+
+    /** Flag: Reply to a query */
+    static const uint8_t    FLAG_REPLY      = 0x04U;
+
+    /** Flag: Query */
+    static const uint8_t    FLAG_QUERY      = 0x02U;
+
+    /** Flag: Push the received data to the display. */
+    static const uint8_t    FLAG_PUSH       = 0x01U;
+
+    /** Mask of the sequence number */
+    static const uint8_t    SEQUENCE_MASK   = 0x0FU;
+
+    /** Max. sequence number, 0 means not used. */
+    static const uint8_t    SEQUENCE_MAX    = 15U;
+
+    /** Destination id of the default output device */
+    static const uint8_t    ID_DISPLAY      = 1U;
+
+    uint8_t         flags;      /**< Flags, including the version */
+    uint8_t         sequence;   /**< Sequence number [1; 15], 0 if not used */
+    uint8_t         dataType;   /**< Data type */
+    uint8_t         id;         /**< Destination id */
+    uint32_t        offset;     /**< Data offset in byte */
+    uint16_t        length;     /**< Data length in byte */
+    const uint8_t*  data;       /**< Data, which points into the decoded buffer. */
+
+    /**
+     * Constructs a empty packet.
+     */
+    DdpPacket() :
+        flags(VERSION_1),
+        sequence(0U),
+        dataType(0U),
+        id(ID_DISPLAY),
+        offset(0U),
+        length(0U),
+        data(nullptr)
+    {
+    }
+
+    /**
+     * Is the data of a display frame complete and shall be shown?
+     *
+     * @return If pushed, it will return true otherwise false.
+     */
+    bool isPush() const
+    {
+        return (0U != (flags & FLAG_PUSH));
+    }
+
+    /**
+     * Does the packet contain pixel data for the display?
+     * Queries, replies and storage accesses don't.
+     *
+     * @return If it contains pixel data, it will return true otherwise false.
+     */
+    bool isPixelData() const
+    {
+        return (0U == (flags & (FLAG_STORAGE | FLAG_REPLY | FLAG_QUERY))) &&
+               (ID_DISPLAY == id);
+    }
+
+    /**
+     * Decode the packet. The data is not copied.
+     *
+     * @param[in]   buffer  Buffer with binary data
+     * @param[in]   size    Number of bytes in the buffer
+     * @param[out]  packet  Packet, which to fill
+     *
+     * @return If the packet is valid, it will return true otherwise false.
+     */
+    static bool decode(const uint8_t* buffer, size_t size, DdpPacket& packet);
+
+    /**
+     * Get the number of lost packets between two received packets by their
+     * sequence numbers.
+     *
+     * @param[in] prevSequence  Sequence number of the previous packet
+     * @param[in] sequence      Sequence number of the current packet
+     *
+     * @return Number of lost packets. If a sequence number is not used, it will be 0.
+     */
+    static uint8_t getLostPackets(uint8_t prevSequence, uint8_t sequence);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DDPPACKET_H__ */
+
+/** @} */
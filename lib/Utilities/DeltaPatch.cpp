@@ -0,0 +1,335 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary delta patch
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DeltaPatch.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void DeltaPatch::init()
+{
+    m_state         = STATE_HEADER;
+    m_opcode        = OPCODE_END;
+    m_argsLen       = 0U;
+    m_argsExpected  = HEADER_SIZE;
+    m_srcOffset     = 0U;
+    m_remaining     = 0U;
+    m_targetSize    = 0U;
+    m_written       = 0U;
+
+    return;
+}
+
+bool DeltaPatch::process(const uint8_t* data, size_t size)
+{
+    size_t index = 0U;
+
+    if (nullptr == data)
+    {
+        size = 0U;
+    }
+
+    while((size > index) &&
+          (STATE_FINISHED != m_state) &&
+          (STATE_ERROR != m_state))
+    {
+        size_t available = size - index;
+
+        if ((STATE_HEADER == m_state) ||
+            (STATE_ARGS == m_state))
+        {
+            m_args[m_argsLen] = data[index];
+            ++m_argsLen;
+            ++index;
+
+            if (m_argsExpected <= m_argsLen)
+            {
+                handleArgs();
+            }
+        }
+        else if (STATE_OPCODE == m_state)
+        {
+            handleOpcode(data[index]);
+            ++index;
+        }
+        else if (STATE_ADD == m_state)
+        {
+            if (CHUNK_SIZE < available)
+            {
+                available = CHUNK_SIZE;
+            }
+
+            if (m_remaining < available)
+            {
+                available = m_remaining;
+            }
+
+            add(&data[index], available);
+            index += available;
+        }
+        /* STATE_DATA */
+        else
+        {
+            if (m_remaining < available)
+            {
+                available = m_remaining;
+            }
+
+            write(&data[index], available);
+            m_remaining -= available;
+            index       += available;
+
+            if ((STATE_ERROR != m_state) &&
+                (0U == m_remaining))
+            {
+                m_state = STATE_OPCODE;
+            }
+        }
+    }
+
+    /* Data after the end of the patch is not accepted. */
+    if ((STATE_FINISHED == m_state) &&
+        (size > index))
+    {
+        m_state = STATE_ERROR;
+    }
+
+    return (STATE_ERROR != m_state);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void DeltaPatch::handleArgs()
+{
+    if (STATE_HEADER == m_state)
+    {
+        if (MAGIC != toUInt32(&m_args[0U]))
+        {
+            m_state = STATE_ERROR;
+        }
+        else
+        {
+            m_targetSize    = toUInt32(&m_args[4U]);
+            m_state         = STATE_OPCODE;
+        }
+    }
+    else if (OPCODE_DATA == m_opcode)
+    {
+        m_remaining = toUInt32(&m_args[0U]);
+        m_state     = (0U == m_remaining) ? STATE_OPCODE : STATE_DATA;
+    }
+    else
+    {
+        m_srcOffset = toUInt32(&m_args[0U]);
+        m_remaining = toUInt32(&m_args[4U]);
+
+        if (OPCODE_COPY == m_opcode)
+        {
+            /* A copy needs no further patch data. */
+            copy();
+        }
+        else
+        {
+            m_state = (0U == m_remaining) ? STATE_OPCODE : STATE_ADD;
+        }
+    }
+
+    m_argsLen = 0U;
+
+    return;
+}
+
+void DeltaPatch::handleOpcode(uint8_t opcode)
+{
+    m_opcode = opcode;
+
+    switch(opcode)
+    {
+    case OPCODE_END:
+        if (m_targetSize != m_written)
+        {
+            m_state = STATE_ERROR;
+        }
+        else
+        {
+            m_state = STATE_FINISHED;
+        }
+        break;
+
+    case OPCODE_COPY:
+        m_argsExpected  = 8U;
+        m_state         = STATE_ARGS;
+        break;
+
+    case OPCODE_ADD:
+        m_argsExpected  = 8U;
+        m_state         = STATE_ARGS;
+        break;
+
+    case OPCODE_DATA:
+        m_argsExpected  = 4U;
+        m_state         = STATE_ARGS;
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    return;
+}
+
+void DeltaPatch::copy()
+{
+    m_state = STATE_OPCODE;
+
+    while((0U < m_remaining) &&
+          (STATE_ERROR != m_state))
+    {
+        size_t chunkSize = CHUNK_SIZE;
+
+        if (m_remaining < chunkSize)
+        {
+            chunkSize = m_remaining;
+        }
+
+        if ((nullptr == m_readSource) ||
+            (false == m_readSource(m_srcOffset, m_buffer, chunkSize)))
+        {
+            m_state = STATE_ERROR;
+        }
+        else
+        {
+            write(m_buffer, chunkSize);
+
+            m_srcOffset += chunkSize;
+            m_remaining -= chunkSize;
+        }
+    }
+
+    return;
+}
+
+void DeltaPatch::add(const uint8_t* data, size_t size)
+{
+    if ((nullptr == m_readSource) ||
+        (false == m_readSource(m_srcOffset, m_buffer, size)))
+    {
+        m_state = STATE_ERROR;
+    }
+    else
+    {
+        size_t idx = 0U;
+
+        for(idx = 0U; idx < size; ++idx)
+        {
+            m_buffer[idx] += data[idx];
+        }
+
+        write(m_buffer, size);
+
+        m_srcOffset += size;
+        m_remaining -= size;
+
+        if ((STATE_ERROR != m_state) &&
+            (0U == m_remaining))
+        {
+            m_state = STATE_OPCODE;
+        }
+    }
+
+    return;
+}
+
+void DeltaPatch::write(const uint8_t* data, size_t size)
+{
+    /* The target image must not exceed its size. */
+    if ((m_targetSize < m_written) ||
+        ((m_targetSize - m_written) < size) ||
+        (nullptr == m_writeTarget) ||
+        (false == m_writeTarget(data, size)))
+    {
+        m_state = STATE_ERROR;
+    }
+    else
+    {
+        m_written += size;
+    }
+
+    return;
+}
+
+uint32_t DeltaPatch::toUInt32(const uint8_t* data)
+{
+    return  (static_cast<uint32_t>(data[0U]) <<  0U) |
+            (static_cast<uint32_t>(data[1U]) <<  8U) |
+            (static_cast<uint32_t>(data[2U]) << 16U) |
+            (static_cast<uint32_t>(data[3U]) << 24U);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
\ No newline at end of file
@@ -0,0 +1,291 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary delta patch
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __DELTAPATCH_H__
+#define __DELTAPATCH_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Applies a binary delta patch, which creates the target image from a
+ * source image, e.g. the running firmware. The patch is processed as a
+ * stream, so it never needs to be completely in memory.
+ *
+ * All values are little endian. The patch starts with the header:
+ * - Magic "PXDP" (4 byte)
+ * - Target image size in byte (4 byte)
+ *
+ * Followed by the commands, each starting with its opcode (1 byte):
+ * - END: The target image is complete.
+ * - COPY: Source offset (4 byte), length (4 byte). Copies from the source.
+ * - ADD: Source offset (4 byte), length (4 byte), length diff bytes. Adds
+ *   the diff bytes to the source bytes, which suits moved code with
+ *   changed addresses.
+ * - DATA: Length (4 byte), length bytes. Literal data.
+ *
+ * See createDeltaPatch.py, which creates the patch.
+ */
+class DeltaPatch
+{
+public:
+
+    /**
+     * Prototype of the function, which reads from the source image.
+     *
+     * @param[in]  offset   Offset in the source image
+     * @param[out] buffer   Buffer, which to fill
+     * @param[in]  size     Number of bytes, which to read
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    typedef std::function<bool(uint32_t offset, uint8_t* buffer, size_t size)> ReadSource;
+
+    /**
+     * Prototype of the function, which writes the next part of the target image.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    typedef std::function<bool(const uint8_t* data, size_t size)> WriteTarget;
+
+    /** Patch magic "PXDP" */
+    static const uint32_t   MAGIC           = 0x50445850U;
+
+    /** Max. number of bytes, which are read from the source image at once. */
+    static const size_t     CHUNK_SIZE      = 256U;
+
+    /**
+     * Patch opcodes.
+     */
+    enum Opcode
+    {
+        OPCODE_END = 0, /**< Target image is complete */
+        OPCODE_COPY,    /**< Copy from source image */
+        OPCODE_ADD,     /**< Add diff bytes to the source image */
+        OPCODE_DATA     /**< Literal data */
+    };
+
+    /**
+     * Constructs the delta patch.
+     *
+     * @param[in] readSource    Function, which reads from the source image
+     * @param[in] writeTarget   Function, which writes the target image
+     */
+    DeltaPatch(const ReadSource& readSource, const WriteTarget& writeTarget) :
+        m_readSource(readSource),
+        m_writeTarget(writeTarget),
+        m_state(STATE_HEADER),
+        m_opcode(OPCODE_END),
+        m_args(),
+        m_argsLen(0U),
+        m_argsExpected(HEADER_SIZE),
+        m_srcOffset(0U),
+        m_remaining(0U),
+        m_targetSize(0U),
+        m_written(0U),
+        m_buffer()
+    {
+    }
+
+    /**
+     * Destroys the delta patch.
+     */
+    ~DeltaPatch()
+    {
+    }
+
+    /**
+     * Initialize the patch, to apply it again from the beginning.
+     */
+    void init();
+
+    /**
+     * Process the next part of the patch.
+     *
+     * @param[in] data  Patch data
+     * @param[in] size  Patch data size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool process(const uint8_t* data, size_t size);
+
+    /**
+     * Is the target image complete?
+     *
+     * @return If the target image is complete, it will return true otherwise false.
+     */
+    bool isFinished() const
+    {
+        return (STATE_FINISHED == m_state);
+    }
+
+    /**
+     * Is the patch invalid or failed reading/writing?
+     *
+     * @return If an error happened, it will return true otherwise false.
+     */
+    bool isError() const
+    {
+        return (STATE_ERROR == m_state);
+    }
+
+    /**
+     * Get the target image size, which is known after the header.
+     *
+     * @return Target image size in byte
+     */
+    uint32_t getTargetSize() const
+    {
+        return m_targetSize;
+    }
+
+    /**
+     * Get the number of written target image bytes.
+     *
+     * @return Number of written bytes
+     */
+    uint32_t getWritten() const
+    {
+        return m_written;
+    }
+
+private:
+
+    /** Header size in byte */
+    static const uint8_t    HEADER_SIZE     = 8U;
+
+    /** Max. size of the command arguments in byte */
+    static const uint8_t    MAX_ARGS_SIZE   = 8U;
+
+    /**
+     * Patch processing states.
+     */
+    enum State
+    {
+        STATE_HEADER = 0,   /**< Collect the header */
+        STATE_OPCODE,       /**< Wait for the next opcode */
+        STATE_ARGS,         /**< Collect the command arguments */
+        STATE_ADD,          /**< Add the diff bytes to the source */
+        STATE_DATA,         /**< Write the literal data */
+        STATE_FINISHED,     /**< Target image is complete */
+        STATE_ERROR         /**< Patch failed */
+    };
+
+    ReadSource  m_readSource;               /**< Reads from the source image */
+    WriteTarget m_writeTarget;              /**< Writes the target image */
+    State       m_state;                    /**< Current state */
+    uint8_t     m_opcode;                   /**< Opcode of the current command */
+    uint8_t     m_args[MAX_ARGS_SIZE];      /**< Header or command arguments */
+    uint8_t     m_argsLen;                  /**< Number of collected arguments in byte */
+    uint8_t     m_argsExpected;             /**< Number of expected arguments in byte */
+    uint32_t    m_srcOffset;                /**< Source offset of the current command */
+    uint32_t    m_remaining;                /**< Remaining length of the current command */
+    uint32_t    m_targetSize;               /**< Target image size in byte */
+    uint32_t    m_written;                  /**< Number of written target image bytes */
+    uint8_t     m_buffer[CHUNK_SIZE];       /**< Buffer for the source image data */
+
+    DeltaPatch(const DeltaPatch& patch);
+    DeltaPatch& operator=(const DeltaPatch& patch);
+
+    /**
+     * Handle the collected header or command arguments.
+     */
+    void handleArgs();
+
+    /**
+     * Handle an opcode.
+     *
+     * @param[in] opcode    Opcode
+     */
+    void handleOpcode(uint8_t opcode);
+
+    /**
+     * Copy the current command length from the source image.
+     */
+    void copy();
+
+    /**
+     * Add the diff bytes to the source image.
+     *
+     * @param[in] data  Diff bytes
+     * @param[in] size  Number of diff bytes, max. CHUNK_SIZE
+     */
+    void add(const uint8_t* data, size_t size);
+
+    /**
+     * Write the next part of the target image.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     */
+    void write(const uint8_t* data, size_t size);
+
+    /**
+     * Get an little endian 32-bit value.
+     *
+     * @param[in] data  Data
+     *
+     * @return Value
+     */
+    static uint32_t toUInt32(const uint8_t* data);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DELTAPATCH_H__ */
+
+/** @} */
\ No newline at end of file
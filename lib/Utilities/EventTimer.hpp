@@ -0,0 +1,177 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Event timer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __EVENTTIMER_HPP__
+#define __EVENTTIMER_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "ITimerListener.hpp"
+#include "TimerService.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A event timer has the same semantic as the simple timer, but it needs not
+ * to be polled. The timer service notifies the listener, if the timer timed out.
+ */
+class EventTimer
+{
+public:
+
+    /**
+     * Constructs a stopped event timer.
+     *
+     * @param[in] listener  Listener, which will be notified about the timeout.
+     */
+    EventTimer(ITimerListener& listener) :
+        m_listener(listener),
+        m_isRunning(false),
+        m_duration(0U),
+        m_deadline(0U),
+        m_prev(nullptr),
+        m_next(nullptr),
+        m_list(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the event timer. A running timer is stopped.
+     */
+    ~EventTimer()
+    {
+        stop();
+    }
+
+    /**
+     * Start the timer. If the timer is running, it will be restarted with
+     * the new duration.
+     *
+     * @param[in] duration  Duration in ms
+     */
+    void start(uint32_t duration)
+    {
+        TimerService::getInstance().start(*this, duration);
+        return;
+    }
+
+    /**
+     * Stop the timer.
+     */
+    void stop()
+    {
+        TimerService::getInstance().stop(*this);
+        return;
+    }
+
+    /**
+     * Restart the timer with the last duration.
+     */
+    void restart()
+    {
+        TimerService::getInstance().start(*this, m_duration);
+        return;
+    }
+
+    /**
+     * Is the timer running?
+     *
+     * @return If the timer is running, it will return true otherwise false.
+     */
+    bool isTimerRunning() const
+    {
+        return m_isRunning;
+    }
+
+    /**
+     * Get remaining time till timeout.
+     * If the timer is not running or timed out already, it will return 0.
+     *
+     * @return Remaining time in ms
+     */
+    uint32_t getRemaining() const
+    {
+        uint32_t remaining = 0U;
+
+        if (true == m_isRunning)
+        {
+            uint32_t delta = m_deadline - MonoTime::getMillis();
+
+            /* After the deadline the difference wraps around. */
+            if (m_duration >= delta)
+            {
+                remaining = delta;
+            }
+        }
+
+        return remaining;
+    }
+
+private:
+
+    ITimerListener&     m_listener;     /**< Listener, which is notified about the timeout. */
+    volatile bool       m_isRunning;    /**< Timer is running or not. */
+    uint32_t            m_duration;     /**< Duration in ms */
+    uint32_t            m_deadline;     /**< Timestamp in ms, when the timer times out. */
+    EventTimer*         m_prev;         /**< Previous timer in the same list, managed by the timer service. */
+    EventTimer*         m_next;         /**< Next timer in the same list, managed by the timer service. */
+    TimerService::List* m_list;         /**< List, which contains the timer, managed by the timer service. */
+
+    /* Prevent copying */
+    EventTimer(const EventTimer& timer);
+    EventTimer& operator=(const EventTimer& timer);
+
+    friend class TimerService;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __EVENTTIMER_HPP__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,206 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Frame patch
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FramePatch.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint16_t readUInt16(const uint8_t* buffer);
+static uint32_t readUInt32(const uint8_t* buffer);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool FramePatch::decode(const uint8_t* buffer, size_t size, FramePatch& patch)
+{
+    bool isValid = false;
+
+    if ((nullptr != buffer) &&
+        (HEADER_SIZE <= size) &&
+        (MAGIC == buffer[0]) &&
+        (VERSION == buffer[1]))
+    {
+        patch.flags     = buffer[2];
+        patch.sequence  = readUInt32(&buffer[4]);
+        patch.x         = readUInt16(&buffer[8]);
+        patch.y         = readUInt16(&buffer[10]);
+        patch.width     = readUInt16(&buffer[12]);
+        patch.height    = readUInt16(&buffer[14]);
+        patch.data      = &buffer[HEADER_SIZE];
+        patch.size      = size - HEADER_SIZE;
+
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+bool FramePatch::apply(uint16_t* frame, uint16_t frameWidth, uint16_t frameHeight) const
+{
+    const uint32_t  PIXELS          = static_cast<uint32_t>(width) * height;
+    bool            isSuccessful    = false;
+
+    if ((nullptr != frame) &&
+        (nullptr != data) &&
+        (0U < PIXELS) &&
+        (frameWidth >= width) &&
+        (frameHeight >= height) &&
+        ((frameWidth - width) >= x) &&
+        ((frameHeight - height) >= y) &&
+        (true == isDataValid()))
+    {
+        const uint8_t*  src         = data;
+        uint32_t        index       = 0U;
+        uint16_t        runLength   = 0U;
+        uint16_t        pixel       = 0U;
+
+        while(PIXELS > index)
+        {
+            if (0U == runLength)
+            {
+                if (0U != (flags & FLAG_RLE))
+                {
+                    runLength   = static_cast<uint16_t>(src[0]) + 1U;
+                    pixel       = readUInt16(&src[1]);
+                    src        += RUN_SIZE;
+                }
+                else
+                {
+                    runLength   = 1U;
+                    pixel       = readUInt16(src);
+                    src        += PIXEL_SIZE;
+                }
+            }
+
+            frame[(y + (index / width)) * frameWidth + x + (index % width)] = pixel;
+
+            --runLength;
+            ++index;
+        }
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool FramePatch::isDataValid() const
+{
+    const uint32_t  PIXELS  = static_cast<uint32_t>(width) * height;
+    bool            isValid = false;
+
+    if (0U == (flags & FLAG_RLE))
+    {
+        isValid = ((PIXELS * PIXEL_SIZE) == size);
+    }
+    else
+    {
+        /* The runs must cover exactly all pixels. */
+        uint32_t    count   = 0U;
+        size_t      offset  = 0U;
+
+        while((PIXELS > count) && ((offset + RUN_SIZE) <= size))
+        {
+            count  += static_cast<uint32_t>(data[offset]) + 1U;
+            offset += RUN_SIZE;
+        }
+
+        isValid = ((PIXELS == count) && (offset == size));
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read a 16-bit value in little endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint16_t readUInt16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0]) |
+           (static_cast<uint16_t>(buffer[1]) << 8U);
+}
+
+/**
+ * Read a 32-bit value in little endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint32_t readUInt32(const uint8_t* buffer)
+{
+    return static_cast<uint32_t>(buffer[0]) |
+           (static_cast<uint32_t>(buffer[1]) << 8U) |
+           (static_cast<uint32_t>(buffer[2]) << 16U) |
+           (static_cast<uint32_t>(buffer[3]) << 24U);
+}
@@ -0,0 +1,171 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Frame patch
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __FRAMEPATCH_H__
+#define __FRAMEPATCH_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A frame patch contains the pixels of a rectangle, which shall be written
+ * into a frame. It may cover the whole frame or only a part of it and is
+ * used to push content, which is rendered somewhere else.
+ *
+ * Binary format (little endian):
+ * - Header: magic (1 byte), version (1 byte), flags (1 byte), reserved (1 byte),
+ *   sequence number (4 byte), x (2 byte), y (2 byte), width (2 byte), height (2 byte)
+ * - Pixels in RGB565 (2 byte each), row by row.
+ *   If the RLE flag is set, the pixels are run-length encoded: Every run
+ *   consists of the number of pixels minus 1 (1 byte) and the pixel (2 byte).
+ */
+class FramePatch
+{
+public:
+
+    /** Magic byte to identify a patch */
+    static const uint8_t    MAGIC           = 0xF5U;
+
+    /** Format version */
+    static const uint8_t    VERSION         = 1U;
+
+    /** Header size in byte */
+    static const size_t     HEADER_SIZE     = 16U;
+
+    /** Size of a RGB565 pixel in byte */
+    static const size_t     PIXEL_SIZE      = 2U;
+
+    /** Size of a run in byte */
+    static const size_t     RUN_SIZE        = 3U;
+
+    /** Max. number of pixels in a run */
+    static const uint16_t   RUN_MAX         = 256U;
+
+    /** Flag: Pixels are run-length encoded. */
+    static const uint8_t    FLAG_RLE        = 0x01U;
+
+    uint8_t         flags;      /**< Flags */
+    uint32_t        sequence;   /**< Sequence number, which increases with every patch. */
+    uint16_t        x;          /**< x-coordinate of the upper left corner */
+    uint16_t        y;          /**< y-coordinate of the upper left corner */
+    uint16_t        width;      /**< Width in pixel */
+    uint16_t        height;     /**< Height in pixel */
+    const uint8_t*  data;       /**< Pixel data, which points into the decoded buffer. */
+    size_t          size;       /**< Pixel data size in byte */
+
+    /**
+     * Constructs a empty patch.
+     */
+    FramePatch() :
+        flags(0U),
+        sequence(0U),
+        x(0U),
+        y(0U),
+        width(0U),
+        height(0U),
+        data(nullptr),
+        size(0U)
+    {
+    }
+
+    /**
+     * Decode the patch header. The pixel data is not copied.
+     *
+     * @param[in]   buffer  Buffer with binary data
+     * @param[in]   size    Number of bytes in the buffer
+     * @param[out]  patch   Patch, which to fill
+     *
+     * @return If the header is valid, it will return true otherwise false.
+     */
+    static bool decode(const uint8_t* buffer, size_t size, FramePatch& patch);
+
+    /**
+     * Write the patch pixels into a frame. The frame is only changed if the
+     * patch fits into it and the pixel data is complete.
+     *
+     * @param[in,out]   frame       Frame with RGB565 pixels, row by row
+     * @param[in]       frameWidth  Frame width in pixel
+     * @param[in]       frameHeight Frame height in pixel
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool apply(uint16_t* frame, uint16_t frameWidth, uint16_t frameHeight) const;
+
+    /**
+     * Is a sequence number newer than the last one? It considers the
+     * wrap around.
+     *
+     * @param[in] sequence      Sequence number
+     * @param[in] lastSequence  Last sequence number
+     *
+     * @return If newer, it will return true otherwise false.
+     */
+    static bool isNewer(uint32_t sequence, uint32_t lastSequence)
+    {
+        return (0 < static_cast<int32_t>(sequence - lastSequence));
+    }
+
+private:
+
+    /**
+     * Check the pixel data, without writing anything.
+     *
+     * @return If the pixel data is complete, it will return true otherwise false.
+     */
+    bool isDataValid() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FRAMEPATCH_H__ */
+
+/** @} */
@@ -0,0 +1,295 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Header store
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HeaderStore.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static char toLower(char c);
+static bool isWhitespace(char c);
+static bool isEqualIgnoreCase(const char* a, const char* b, size_t length);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** FNV-1a offset basis */
+static const uint32_t   HASH_INIT   = 2166136261U;
+
+/** FNV-1a prime */
+static const uint32_t   HASH_PRIME  = 16777619U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool HeaderStore::addInterest(const char* name)
+{
+    bool isSuccessful = false;
+
+    if (nullptr != name)
+    {
+        uint32_t nameHash = hash(name, strlen(name));
+
+        /* Without any interest, every header field is of interest. */
+        if ((0U < m_interestCount) &&
+            (true == isOfInterest(nameHash)))
+        {
+            isSuccessful = true;
+        }
+        else if (MAX_INTERESTS > m_interestCount)
+        {
+            m_interests[m_interestCount] = nameHash;
+            ++m_interestCount;
+
+            isSuccessful = true;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool HeaderStore::add(const char* line, size_t length)
+{
+    bool        isStored    = false;
+    const char* colon       = nullptr;
+
+    if (nullptr != line)
+    {
+        colon = static_cast<const char*>(memchr(line, ':', length));
+    }
+
+    /* RFC7230 - 3.2. Header Fields
+     * header-field = field-name ":" OWS field-value OWS
+     */
+    if ((nullptr != colon) &&
+        (line != colon) &&
+        (MAX_HEADERS > m_count))
+    {
+        size_t      nameLength  = colon - line;
+        uint32_t    nameHash    = hash(line, nameLength);
+
+        if (true == isOfInterest(nameHash))
+        {
+            const char* value       = colon + 1;
+            size_t      valueLength = length - nameLength - 1U;
+
+            while((0U < valueLength) && (true == isWhitespace(value[0])))
+            {
+                ++value;
+                --valueLength;
+            }
+
+            while((0U < valueLength) && (true == isWhitespace(value[valueLength - 1U])))
+            {
+                --valueLength;
+            }
+
+            /* Name and value are stored terminated. */
+            if ((ARENA_SIZE - m_arenaIdx) >= (nameLength + 1U + valueLength + 1U))
+            {
+                View& view = m_views[m_count];
+
+                view.nameHash       = nameHash;
+                view.nameOffset     = static_cast<uint16_t>(m_arenaIdx);
+                view.nameLength     = static_cast<uint16_t>(nameLength);
+                view.valueOffset    = static_cast<uint16_t>(m_arenaIdx + nameLength + 1U);
+
+                memcpy(&m_arena[view.nameOffset], line, nameLength);
+                m_arena[view.nameOffset + nameLength] = '\0';
+                memcpy(&m_arena[view.valueOffset], value, valueLength);
+                m_arena[view.valueOffset + valueLength] = '\0';
+
+                m_arenaIdx += nameLength + 1U + valueLength + 1U;
+                ++m_count;
+
+                isStored = true;
+            }
+        }
+    }
+
+    return isStored;
+}
+
+const char* HeaderStore::find(const char* name) const
+{
+    const char* value = nullptr;
+
+    if (nullptr != name)
+    {
+        size_t      nameLength  = strlen(name);
+        uint32_t    nameHash    = hash(name, nameLength);
+        uint8_t     idx         = 0U;
+
+        while((nullptr == value) && (m_count > idx))
+        {
+            const View& view = m_views[idx];
+
+            if ((nameHash == view.nameHash) &&
+                (nameLength == view.nameLength) &&
+                (true == isEqualIgnoreCase(&m_arena[view.nameOffset], name, nameLength)))
+            {
+                value = &m_arena[view.valueOffset];
+            }
+
+            ++idx;
+        }
+    }
+
+    return value;
+}
+
+uint32_t HeaderStore::hash(const char* name, size_t length)
+{
+    uint32_t    value   = HASH_INIT;
+    size_t      idx     = 0U;
+
+    for(idx = 0U; idx < length; ++idx)
+    {
+        value ^= static_cast<uint8_t>(toLower(name[idx]));
+        value *= HASH_PRIME;
+    }
+
+    return value;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool HeaderStore::isOfInterest(uint32_t nameHash) const
+{
+    bool    isInterested    = (0U == m_interestCount);
+    uint8_t idx             = 0U;
+
+    while((false == isInterested) && (m_interestCount > idx))
+    {
+        if (nameHash == m_interests[idx])
+        {
+            isInterested = true;
+        }
+
+        ++idx;
+    }
+
+    return isInterested;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a ASCII character to lower case.
+ *
+ * @param[in] c Character
+ *
+ * @return Lower case character
+ */
+static char toLower(char c)
+{
+    if (('A' <= c) && ('Z' >= c))
+    {
+        c = c - 'A' + 'a';
+    }
+
+    return c;
+}
+
+/**
+ * Is the character a optional whitespace (OWS)?
+ *
+ * @param[in] c Character
+ *
+ * @return If whitespace, it will return true otherwise false.
+ */
+static bool isWhitespace(char c)
+{
+    return ((' ' == c) || ('\t' == c) || ('\r' == c) || ('\n' == c));
+}
+
+/**
+ * Compare two strings case insensitive.
+ *
+ * @param[in] a         String a
+ * @param[in] b         String b
+ * @param[in] length    Number of characters to compare
+ *
+ * @return If equal, it will return true otherwise false.
+ */
+static bool isEqualIgnoreCase(const char* a, const char* b, size_t length)
+{
+    bool    isEqual = true;
+    size_t  idx     = 0U;
+
+    while((true == isEqual) && (length > idx))
+    {
+        if (toLower(a[idx]) != toLower(b[idx]))
+        {
+            isEqual = false;
+        }
+
+        ++idx;
+    }
+
+    return isEqual;
+}
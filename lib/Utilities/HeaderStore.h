@@ -0,0 +1,197 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Header store
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __HEADERSTORE_H__
+#define __HEADERSTORE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The header store keeps the header fields of a single message without any
+ * heap allocation. The names and values are copied into an arena, which is
+ * part of the store. Every header field is described by a view with offset
+ * and length into the arena and the hash of its name, so a lookup compares
+ * the hash first and the name only on a hash match.
+ *
+ * Optionally the header fields of interest can be registered. If at least
+ * one is registered, all others are dropped while parsing. The interests
+ * survive clearing the store.
+ */
+class HeaderStore
+{
+public:
+
+    /** Arena size in byte */
+    static const size_t     ARENA_SIZE      = 512U;
+
+    /** Max. number of header fields */
+    static const uint8_t    MAX_HEADERS     = 16U;
+
+    /** Max. number of header fields of interest */
+    static const uint8_t    MAX_INTERESTS   = 8U;
+
+    /**
+     * Constructs a empty store without any interest.
+     */
+    HeaderStore() :
+        m_arena(),
+        m_arenaIdx(0U),
+        m_views(),
+        m_count(0U),
+        m_interests(),
+        m_interestCount(0U)
+    {
+    }
+
+    /**
+     * Register a header field of interest.
+     *
+     * @param[in] name  Field name, case insensitive
+     *
+     * @return If successful registered, it will return true otherwise false.
+     */
+    bool addInterest(const char* name);
+
+    /**
+     * Remove all registered interests. Afterwards all header fields are kept.
+     */
+    void clearInterests()
+    {
+        m_interestCount = 0U;
+    }
+
+    /**
+     * Add a header field line, e.g. "Content-Length: 42". The value is
+     * trimmed. A line without colon, of no interest or which doesn't fit
+     * into the arena anymore, is dropped.
+     *
+     * @param[in] line      Header field line, doesn't need to be terminated.
+     * @param[in] length    Line length in byte
+     *
+     * @return If the header field is stored, it will return true otherwise false.
+     */
+    bool add(const char* line, size_t length);
+
+    /**
+     * Find a header field value by its name.
+     *
+     * @param[in] name  Field name, case insensitive
+     *
+     * @return If found, it will return the terminated value otherwise nullptr.
+     */
+    const char* find(const char* name) const;
+
+    /**
+     * Remove all header fields. The interests are kept.
+     */
+    void clear()
+    {
+        m_arenaIdx  = 0U;
+        m_count     = 0U;
+    }
+
+    /**
+     * Get number of stored header fields.
+     *
+     * @return Number of header fields
+     */
+    uint8_t getCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Calculate the case insensitive hash (FNV-1a) of a field name.
+     *
+     * @param[in] name      Field name
+     * @param[in] length    Field name length in byte
+     *
+     * @return Hash
+     */
+    static uint32_t hash(const char* name, size_t length);
+
+private:
+
+    /**
+     * View of a single header field into the arena.
+     */
+    struct View
+    {
+        uint32_t    nameHash;       /**< Hash of the field name */
+        uint16_t    nameOffset;     /**< Field name offset in the arena */
+        uint16_t    nameLength;     /**< Field name length in byte */
+        uint16_t    valueOffset;    /**< Field value offset in the arena, value is terminated. */
+    };
+
+    char        m_arena[ARENA_SIZE];        /**< Arena with the terminated field names and values */
+    size_t      m_arenaIdx;                 /**< Arena fill index */
+    View        m_views[MAX_HEADERS];       /**< Header field views */
+    uint8_t     m_count;                    /**< Number of header fields */
+    uint32_t    m_interests[MAX_INTERESTS]; /**< Name hashes of the header fields of interest */
+    uint8_t     m_interestCount;            /**< Number of header fields of interest */
+
+    /**
+     * Is a header field of interest?
+     *
+     * @param[in] nameHash  Hash of the field name
+     *
+     * @return If of interest, it will return true otherwise false.
+     */
+    bool isOfInterest(uint32_t nameHash) const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HEADERSTORE_H__ */
+
+/** @} */
@@ -0,0 +1,474 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP response parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HttpRspParser.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int8_t hexToValue(uint8_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. chunk size, before a further hex digit would overflow. */
+static const size_t MAX_CHUNK_SIZE_BEFORE_DIGIT = (static_cast<size_t>(-1) >> 4U);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool HttpRspParser::parse(const uint8_t* data, size_t size)
+{
+    size_t index = 0U;
+
+    while((size > index) && (STATE_ERROR != m_state))
+    {
+        switch(m_state)
+        {
+        case STATE_STATUS_LINE:
+        case STATE_HEADER:
+        case STATE_TRAILER:
+            if (true == readLine(data, size, index))
+            {
+                handleLine();
+            }
+            break;
+
+        case STATE_BODY_LENGTH:
+            if (true == handleBody(data, size, index))
+            {
+                complete();
+            }
+            break;
+
+        case STATE_BODY_UNTIL_CLOSE:
+            m_listener.onBody(&data[index], size - index);
+            index = size;
+            break;
+
+        case STATE_CHUNK_DATA:
+            if (true == handleBody(data, size, index))
+            {
+                m_state = STATE_CHUNK_DATA_CR;
+            }
+            break;
+
+        case STATE_CHUNK_SIZE:
+        case STATE_CHUNK_EXT:
+        case STATE_CHUNK_SIZE_LF:
+        case STATE_CHUNK_DATA_CR:
+        case STATE_CHUNK_DATA_LF:
+            handleChunkByte(data[index]);
+            ++index;
+            break;
+
+        default:
+            m_state = STATE_ERROR;
+            break;
+        }
+    }
+
+    return (STATE_ERROR != m_state);
+}
+
+bool HttpRspParser::finish()
+{
+    bool isCompleted = false;
+
+    if (STATE_BODY_UNTIL_CLOSE == m_state)
+    {
+        reset();
+        m_listener.onComplete();
+        isCompleted = true;
+    }
+    else
+    {
+        reset();
+    }
+
+    return isCompleted;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool HttpRspParser::readLine(const uint8_t* data, size_t size, size_t& index)
+{
+    bool            isEOL       = false;
+    const uint8_t*  begin       = &data[index];
+    size_t          available   = size - index;
+    const uint8_t*  lf          = static_cast<const uint8_t*>(memchr(begin, '\n', available));
+    size_t          lineSize    = (nullptr == lf) ? available : static_cast<size_t>(lf - begin);
+    size_t          copySize    = LINE_SIZE - 1U - m_lineLength;
+
+    /* A too long line is truncated. */
+    if (lineSize < copySize)
+    {
+        copySize = lineSize;
+    }
+
+    memcpy(&m_line[m_lineLength], begin, copySize);
+    m_lineLength += copySize;
+
+    if (nullptr == lf)
+    {
+        index = size;
+    }
+    else
+    {
+        /* Overstep the LF too. */
+        index += lineSize + 1U;
+
+        /* RFC7230 - 3.5. Message Parsing Robustness
+         * Although the line terminator for the start-line and header fields is
+         * the sequence CRLF, a recipient MAY recognize a single LF as a line
+         * terminator and ignore any preceding CR.
+         */
+        if ((0U < m_lineLength) &&
+            ('\r' == m_line[m_lineLength - 1U]))
+        {
+            --m_lineLength;
+        }
+
+        m_line[m_lineLength] = '\0';
+        isEOL = true;
+    }
+
+    return isEOL;
+}
+
+void HttpRspParser::handleLine()
+{
+    switch(m_state)
+    {
+    case STATE_STATUS_LINE:
+        /* RFC7230 - 3.5. Message Parsing Robustness
+         * A recipient SHOULD ignore at least one empty line received prior
+         * to the status line.
+         */
+        if (0U < m_lineLength)
+        {
+            m_listener.onStatusLine(m_line, m_lineLength);
+            m_state = STATE_HEADER;
+        }
+        break;
+
+    case STATE_HEADER:
+        if (0U == m_lineLength)
+        {
+            handleHeaderEnd();
+        }
+        else
+        {
+            m_listener.onHeader(m_line, m_lineLength);
+        }
+        break;
+
+    case STATE_TRAILER:
+        /* The trailer fields are ignored. */
+        if (0U == m_lineLength)
+        {
+            complete();
+        }
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    m_lineLength = 0U;
+
+    return;
+}
+
+void HttpRspParser::handleHeaderEnd()
+{
+    size_t contentLength = 0U;
+
+    switch(m_listener.onHeaderEnd(contentLength))
+    {
+    case IHttpRspListener::BODY_NONE:
+        complete();
+        break;
+
+    case IHttpRspListener::BODY_LENGTH:
+        if (0U == contentLength)
+        {
+            complete();
+        }
+        else
+        {
+            m_remaining = contentLength;
+            m_state     = STATE_BODY_LENGTH;
+        }
+        break;
+
+    case IHttpRspListener::BODY_CHUNKED:
+        waitForChunkSize();
+        break;
+
+    case IHttpRspListener::BODY_UNTIL_CLOSE:
+        m_state = STATE_BODY_UNTIL_CLOSE;
+        break;
+
+    case IHttpRspListener::BODY_INVALID:
+        /* fallthrough */
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    return;
+}
+
+void HttpRspParser::handleChunkByte(uint8_t value)
+{
+    /* RFC7230 - 4.1. Chunked Transfer Coding
+     * chunk      = chunk-size [ chunk-ext ] CRLF
+     *              chunk-data CRLF
+     * last-chunk = 1*("0") [ chunk-ext ] CRLF
+     */
+    switch(m_state)
+    {
+    case STATE_CHUNK_SIZE:
+        {
+            int8_t digit = hexToValue(value);
+
+            if (0 <= digit)
+            {
+                if (MAX_CHUNK_SIZE_BEFORE_DIGIT < m_remaining)
+                {
+                    m_state = STATE_ERROR;
+                }
+                else
+                {
+                    m_remaining     = (m_remaining << 4U) | static_cast<size_t>(digit);
+                    m_hasChunkSize  = true;
+                }
+            }
+            else if (false == m_hasChunkSize)
+            {
+                m_state = STATE_ERROR;
+            }
+            else if ((';' == value) || (' ' == value) || ('\t' == value))
+            {
+                m_state = STATE_CHUNK_EXT;
+            }
+            else if ('\r' == value)
+            {
+                m_state = STATE_CHUNK_SIZE_LF;
+            }
+            else if ('\n' == value)
+            {
+                handleChunkSizeEnd();
+            }
+            else
+            {
+                m_state = STATE_ERROR;
+            }
+        }
+        break;
+
+    case STATE_CHUNK_EXT:
+        /* The chunk extension is skipped, incl. the CR. */
+        if ('\n' == value)
+        {
+            handleChunkSizeEnd();
+        }
+        break;
+
+    case STATE_CHUNK_SIZE_LF:
+        if ('\n' == value)
+        {
+            handleChunkSizeEnd();
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_CHUNK_DATA_CR:
+        if ('\r' == value)
+        {
+            m_state = STATE_CHUNK_DATA_LF;
+        }
+        /* A single LF is accepted too. */
+        else if ('\n' == value)
+        {
+            waitForChunkSize();
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    case STATE_CHUNK_DATA_LF:
+        if ('\n' == value)
+        {
+            waitForChunkSize();
+        }
+        else
+        {
+            m_state = STATE_ERROR;
+        }
+        break;
+
+    default:
+        m_state = STATE_ERROR;
+        break;
+    }
+
+    return;
+}
+
+void HttpRspParser::waitForChunkSize()
+{
+    m_remaining     = 0U;
+    m_hasChunkSize  = false;
+    m_state         = STATE_CHUNK_SIZE;
+
+    return;
+}
+
+void HttpRspParser::handleChunkSizeEnd()
+{
+    /* The last chunk is followed by the trailer. */
+    if (0U == m_remaining)
+    {
+        m_lineLength    = 0U;
+        m_state         = STATE_TRAILER;
+    }
+    else
+    {
+        m_listener.onChunk(m_remaining);
+        m_state = STATE_CHUNK_DATA;
+    }
+
+    return;
+}
+
+bool HttpRspParser::handleBody(const uint8_t* data, size_t size, size_t& index)
+{
+    size_t  available   = size - index;
+    size_t  copySize    = (m_remaining < available) ? m_remaining : available;
+    State   state       = m_state;
+    bool    isDone      = false;
+
+    /* The listener may reset the parser, therefore update before notifying. */
+    m_remaining -= copySize;
+    isDone = (0U == m_remaining);
+
+    if (0U < copySize)
+    {
+        m_listener.onBody(&data[index], copySize);
+    }
+
+    index += copySize;
+
+    return ((true == isDone) && (state == m_state));
+}
+
+void HttpRspParser::complete()
+{
+    m_state     = STATE_STATUS_LINE;
+    m_remaining = 0U;
+
+    m_listener.onComplete();
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a hex digit to its value.
+ *
+ * @param[in] value ASCII hex digit
+ *
+ * @return Value or -1 if it is no hex digit.
+ */
+static int8_t hexToValue(uint8_t value)
+{
+    int8_t result = -1;
+
+    if (('0' <= value) && ('9' >= value))
+    {
+        result = static_cast<int8_t>(value - '0');
+    }
+    else if (('a' <= value) && ('f' >= value))
+    {
+        result = static_cast<int8_t>(value - 'a' + 10);
+    }
+    else if (('A' <= value) && ('F' >= value))
+    {
+        result = static_cast<int8_t>(value - 'A' + 10);
+    }
+    else
+    {
+        ;
+    }
+
+    return result;
+}
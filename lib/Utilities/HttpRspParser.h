@@ -0,0 +1,228 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP response parser
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __HTTPRSPPARSER_H__
+#define __HTTPRSPPARSER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "IHttpRspListener.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Incremental HTTP/1.x response parser (RFC7230). It is a state machine,
+ * which parses the received data directly, independent of how the response
+ * is split into packets. Only the status line, the header field lines and
+ * the chunk trailer are copied into a fixed line buffer, body data is
+ * provided to the listener without copying.
+ *
+ * Several responses may follow each other on the same connection.
+ */
+class HttpRspParser
+{
+public:
+
+    /** Line buffer size in byte, incl. string termination. Longer lines are truncated. */
+    static const size_t LINE_SIZE   = 256U;
+
+    /**
+     * Constructs the parser, which waits for the status line.
+     *
+     * @param[in] listener  Listener, which is notified about the response parts.
+     */
+    HttpRspParser(IHttpRspListener& listener) :
+        m_listener(listener),
+        m_state(STATE_STATUS_LINE),
+        m_line(),
+        m_lineLength(0U),
+        m_remaining(0U),
+        m_hasChunkSize(false)
+    {
+    }
+
+    /**
+     * Destroys the parser.
+     */
+    ~HttpRspParser()
+    {
+    }
+
+    /**
+     * Parse received data. All of it is consumed.
+     *
+     * @param[in] data  Received data
+     * @param[in] size  Data size in byte
+     *
+     * @return If the data is valid, it will return true otherwise false. After a error, the parser must be reset.
+     */
+    bool parse(const uint8_t* data, size_t size);
+
+    /**
+     * The connection is closed. A body, which ends with the connection, is
+     * complete now. The parser is reset afterwards.
+     *
+     * @return If a response is completed, it will return true otherwise false.
+     */
+    bool finish();
+
+    /**
+     * Reset the parser. It waits for the status line afterwards.
+     */
+    void reset()
+    {
+        m_state             = STATE_STATUS_LINE;
+        m_lineLength        = 0U;
+        m_remaining         = 0U;
+        m_hasChunkSize      = false;
+    }
+
+    /**
+     * Is the parser between two responses?
+     *
+     * @return If no response is in progress, it will return true otherwise false.
+     */
+    bool isIdle() const
+    {
+        return ((STATE_STATUS_LINE == m_state) && (0U == m_lineLength));
+    }
+
+private:
+
+    /**
+     * Parser states
+     */
+    enum State
+    {
+        STATE_STATUS_LINE = 0,  /**< Status line */
+        STATE_HEADER,           /**< Header field lines, until empty line */
+        STATE_BODY_LENGTH,      /**< Body with content length */
+        STATE_BODY_UNTIL_CLOSE, /**< Body until the connection is closed */
+        STATE_CHUNK_SIZE,       /**< Chunk size in hex digits */
+        STATE_CHUNK_EXT,        /**< Chunk extension, which is skipped */
+        STATE_CHUNK_SIZE_LF,    /**< LF after chunk size */
+        STATE_CHUNK_DATA,       /**< Chunk data */
+        STATE_CHUNK_DATA_CR,    /**< CR after chunk data */
+        STATE_CHUNK_DATA_LF,    /**< LF after chunk data */
+        STATE_TRAILER,          /**< Trailer field lines, until empty line */
+        STATE_ERROR             /**< Invalid response */
+    };
+
+    IHttpRspListener&   m_listener;         /**< Listener */
+    State               m_state;            /**< Current state */
+    char                m_line[LINE_SIZE];  /**< Line buffer */
+    size_t              m_lineLength;       /**< Line length in byte */
+    size_t              m_remaining;        /**< Remaining body or chunk data in byte */
+    bool                m_hasChunkSize;     /**< Is at least one chunk size digit parsed? */
+
+    /* Prevent copying */
+    HttpRspParser(const HttpRspParser& parser);
+    HttpRspParser& operator=(const HttpRspParser& parser);
+
+    /**
+     * Collect a line until LF.
+     *
+     * @param[in]       data    Data
+     * @param[in]       size    Data size in byte
+     * @param[in,out]   index   Index of the next byte, which to parse
+     *
+     * @return If the line is complete, it will return true otherwise false.
+     */
+    bool readLine(const uint8_t* data, size_t size, size_t& index);
+
+    /**
+     * Handle a complete line, depended on the current state.
+     */
+    void handleLine();
+
+    /**
+     * Handle the end of the header.
+     */
+    void handleHeaderEnd();
+
+    /**
+     * Handle a single chunk size or chunk delimiter byte.
+     *
+     * @param[in] value Byte
+     */
+    void handleChunkByte(uint8_t value);
+
+    /**
+     * Wait for the next chunk size.
+     */
+    void waitForChunkSize();
+
+    /**
+     * Handle the end of the chunk size line.
+     */
+    void handleChunkSizeEnd();
+
+    /**
+     * Provide body data to the listener.
+     *
+     * @param[in]       data    Data
+     * @param[in]       size    Data size in byte
+     * @param[in,out]   index   Index of the next byte, which to parse
+     *
+     * @return If all remaining body data is provided, it will return true otherwise false.
+     */
+    bool handleBody(const uint8_t* data, size_t size, size_t& index);
+
+    /**
+     * Complete the response and wait for the next one.
+     */
+    void complete();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HTTPRSPPARSER_H__ */
+
+/** @} */
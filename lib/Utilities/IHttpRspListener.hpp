@@ -0,0 +1,149 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP response parser listener interface
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __IHTTPRSPLISTENER_HPP__
+#define __IHTTPRSPLISTENER_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The HTTP response listener is notified by the HTTP response parser about
+ * every part of a response.
+ */
+class IHttpRspListener
+{
+public:
+
+    /**
+     * The kind of message body, which follows the header.
+     */
+    enum BodyType
+    {
+        BODY_NONE = 0,      /**< No body, the response is complete with the header. */
+        BODY_LENGTH,        /**< Body with the given content length */
+        BODY_CHUNKED,       /**< Chunked transfer coding */
+        BODY_UNTIL_CLOSE,   /**< Body ends when the connection is closed. */
+        BODY_INVALID        /**< Invalid header, parsing fails. */
+    };
+
+    /**
+     * Destroys the HTTP response listener interface.
+     */
+    virtual ~IHttpRspListener()
+    {
+    }
+
+    /**
+     * Will be called for the status line.
+     *
+     * @param[in] line      Terminated status line, without CRLF
+     * @param[in] length    Line length in byte
+     */
+    virtual void onStatusLine(const char* line, size_t length) = 0;
+
+    /**
+     * Will be called for every header field line.
+     *
+     * @param[in] line      Terminated header field line, without CRLF
+     * @param[in] length    Line length in byte
+     */
+    virtual void onHeader(const char* line, size_t length) = 0;
+
+    /**
+     * Will be called after the last header field. The listener determines
+     * how the body is transferred.
+     *
+     * @param[out] contentLength    Content length in byte, only used for BODY_LENGTH.
+     *
+     * @return Kind of body
+     */
+    virtual BodyType onHeaderEnd(size_t& contentLength) = 0;
+
+    /**
+     * Will be called for every chunk of the chunked transfer coding, before
+     * its data is provided.
+     *
+     * @param[in] size  Chunk size in byte
+     */
+    virtual void onChunk(size_t size) = 0;
+
+    /**
+     * Will be called for body data. It points directly into the parsed data.
+     *
+     * @param[in] data  Body data
+     * @param[in] size  Body data size in byte
+     */
+    virtual void onBody(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * Will be called if the response is complete. The parser is ready for
+     * the next response already.
+     */
+    virtual void onComplete() = 0;
+
+protected:
+
+    /**
+     * Constructs the HTTP response listener interface.
+     */
+    IHttpRspListener()
+    {
+    }
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __IHTTPRSPLISTENER_HPP__ */
+
+/** @} */
@@ -0,0 +1,157 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Latency statistics
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LatencyStat.h"
+
+#include <algorithm>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void LatencyStat::clear()
+{
+    m_count = 0U;
+    m_min   = UINT32_MAX;
+    m_max   = 0U;
+    m_sum   = 0U;
+
+    return;
+}
+
+void LatencyStat::addSample(uint32_t value)
+{
+    if (MAX_SAMPLES > m_count)
+    {
+        m_samples[m_count] = value;
+    }
+
+    if (m_min > value)
+    {
+        m_min = value;
+    }
+
+    if (m_max < value)
+    {
+        m_max = value;
+    }
+
+    m_sum += value;
+
+    if (UINT32_MAX > m_count)
+    {
+        ++m_count;
+    }
+
+    return;
+}
+
+void LatencyStat::getSummary(Summary& summary)
+{
+    summary.count = m_count;
+
+    if (0U == m_count)
+    {
+        summary.min = 0U;
+        summary.avg = 0U;
+        summary.max = 0U;
+        summary.p50 = 0U;
+        summary.p90 = 0U;
+        summary.p99 = 0U;
+    }
+    else
+    {
+        uint16_t num = (MAX_SAMPLES < m_count) ? MAX_SAMPLES : static_cast<uint16_t>(m_count);
+
+        std::sort(&m_samples[0], &m_samples[num]);
+
+        summary.min = m_min;
+        summary.avg = static_cast<uint32_t>(m_sum / m_count);
+        summary.max = m_max;
+        summary.p50 = getPercentile(num, 50U);
+        summary.p90 = getPercentile(num, 90U);
+        summary.p99 = getPercentile(num, 99U);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint32_t LatencyStat::getPercentile(uint16_t num, uint8_t percent) const
+{
+    /* Nearest rank: ceil(percent / 100 * num), which is 1-based. */
+    uint32_t rank = (static_cast<uint32_t>(percent) * num + 99U) / 100U;
+
+    if (0U == rank)
+    {
+        rank = 1U;
+    }
+
+    return m_samples[rank - 1U];
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,156 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Latency statistics
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __LATENCYSTAT_H__
+#define __LATENCYSTAT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Statistics about measured latencies, e.g. in us.
+ *
+ * In contrast to the ProfileStat, the samples itself are stored, which
+ * results in exact percentiles (nearest rank method). If more than
+ * MAX_SAMPLES samples are added, the min., avg. and max. value consider all
+ * of them, but the percentiles only the first MAX_SAMPLES samples.
+ */
+class LatencyStat
+{
+public:
+
+    /** Summary of all samples. */
+    struct Summary
+    {
+        uint32_t    count;  /**< Number of samples */
+        uint32_t    min;    /**< Min. value */
+        uint32_t    avg;    /**< Average value */
+        uint32_t    max;    /**< Max. value */
+        uint32_t    p50;    /**< 50th percentile (median) */
+        uint32_t    p90;    /**< 90th percentile */
+        uint32_t    p99;    /**< 99th percentile */
+    };
+
+    /** Max. number of stored samples. */
+    static const uint16_t   MAX_SAMPLES = 512U;
+
+    /**
+     * Constructs empty latency statistics.
+     */
+    LatencyStat() :
+        m_count(0U),
+        m_min(UINT32_MAX),
+        m_max(0U),
+        m_sum(0U),
+        m_samples()
+    {
+    }
+
+    /**
+     * Destroys the latency statistics.
+     */
+    ~LatencyStat()
+    {
+    }
+
+    /**
+     * Remove all samples.
+     */
+    void clear();
+
+    /**
+     * Add a sample.
+     *
+     * @param[in] value Measured value
+     */
+    void addSample(uint32_t value);
+
+    /**
+     * Get number of added samples.
+     *
+     * @return Number of samples
+     */
+    uint32_t getCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Get summary of all samples. The stored samples are sorted for it.
+     *
+     * @param[out] summary  Summary
+     */
+    void getSummary(Summary& summary);
+
+private:
+
+    uint32_t    m_count;                /**< Number of added samples */
+    uint32_t    m_min;                  /**< Min. value */
+    uint32_t    m_max;                  /**< Max. value */
+    uint64_t    m_sum;                  /**< Sum of all values */
+    uint32_t    m_samples[MAX_SAMPLES]; /**< Stored samples */
+
+    /**
+     * Get the percentile of the sorted samples.
+     *
+     * @param[in] num       Number of sorted samples, must not be 0.
+     * @param[in] percent   Percentile in percent [1; 100]
+     *
+     * @return Percentile value
+     */
+    uint32_t getPercentile(uint16_t num, uint8_t percent) const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LATENCYSTAT_H__ */
+
+/** @} */
@@ -58,6 +58,26 @@
  * Public Methods
  *****************************************************************************/
 
+Logging::Module::Module(const char* name) :
+    m_name(name),
+    m_level(LOGLEVEL_INFO),
+    m_isGlobal(true),
+    m_next(nullptr)
+{
+    Logging::getInstance().addModule(*this);
+}
+
+Logging::Module::~Module()
+{
+    Logging::getInstance().removeModule(*this);
+}
+
+void Logging::Module::useGlobalLogLevel()
+{
+    m_isGlobal  = true;
+    m_level     = Logging::getInstance().getLogLevel();
+}
+
 bool Logging::registerSink(LogSink* sink)
 {
     bool status = false;
@@ -135,7 +155,19 @@ LogSink* Logging::getSelectedSink()
 
 void Logging::setLogLevel(const LogLevel logLevel)
 {
+    Module* module = m_modules;
+
     m_currentLogLevel = logLevel;
+
+    while(nullptr != module)
+    {
+        if (true == module->m_isGlobal)
+        {
+            module->m_level = logLevel;
+        }
+
+        module = module->m_next;
+    }
 }
 
 Logging::LogLevel Logging::getLogLevel() const
@@ -143,10 +175,26 @@ Logging::LogLevel Logging::getLogLevel() const
     return m_currentLogLevel;
 }
 
+Logging::Module* Logging::getModule(const char* name)
+{
+    Module* module = m_modules;
+
+    if (nullptr == name)
+    {
+        return nullptr;
+    }
+
+    while((nullptr != module) && (0 != strcmp(module->m_name, name)))
+    {
+        module = module->m_next;
+    }
+
+    return module;
+}
+
 void Logging::processLogMessage(const char* file, int line, const Logging::LogLevel messageLogLevel, const char* format, ...)
 {
-    if ((true == isSeverityValid(messageLogLevel)) &&
-        (nullptr != m_selectedSink))
+    if (nullptr != m_selectedSink)
     {
         char            buffer[MESSAGE_BUFFER_SIZE];
         int             written             = 0;
@@ -184,8 +232,7 @@ void Logging::processLogMessage(const char* file, int line, const Logging::LogLe
 
 void Logging::processLogMessage(const char* file, int line, const Logging::LogLevel messageLogLevel, const String& message)
 {
-    if ((true == isSeverityValid(messageLogLevel)) &&
-        (nullptr != m_selectedSink))
+    if (nullptr != m_selectedSink)
     {
         Msg msg;
 
@@ -224,6 +271,74 @@ void Logging::processLogMessage(uint32_t timestamp, const String& logger, const
     }
 }
 
+void Logging::processDeferred()
+{
+    DeferredMsg msg;
+    bool        isAvailable = true;
+    uint32_t    dropped     = 0U;
+
+    lock();
+    dropped             = m_deferredDropped;
+    m_deferredDropped   = 0U;
+    unlock();
+
+    if ((0U < dropped) &&
+        (nullptr != m_selectedSink))
+    {
+        char    buffer[MESSAGE_BUFFER_SIZE];
+        Msg     dropMsg;
+
+        (void)snprintf(buffer, sizeof(buffer), "%u deferred log messages dropped.", dropped);
+
+        dropMsg.timestamp   = esp_log_timestamp();
+        dropMsg.level       = LOGLEVEL_WARNING;
+        dropMsg.filename    = getBaseNameFromPath(__FILE__);
+        dropMsg.line        = __LINE__;
+        dropMsg.str         = buffer;
+
+        m_selectedSink->send(dropMsg);
+    }
+
+    while(true == isAvailable)
+    {
+        lock();
+
+        if (0U == m_deferredCount)
+        {
+            isAvailable = false;
+        }
+        else
+        {
+            msg = m_deferred[m_deferredHead];
+
+            m_deferredHead = (m_deferredHead + 1U) % DEFERRED_QUEUE_SIZE;
+            --m_deferredCount;
+        }
+
+        unlock();
+
+        /* The formatting is done without lock, so the producers are not blocked. */
+        if ((true == isAvailable) &&
+            (nullptr != m_selectedSink))
+        {
+            char    buffer[MESSAGE_BUFFER_SIZE];
+            Msg     outMsg;
+
+            formatDeferred(msg, buffer, sizeof(buffer));
+
+            outMsg.timestamp    = msg.timestamp;
+            outMsg.level        = msg.level;
+            outMsg.filename     = getBaseNameFromPath(msg.file);
+            outMsg.line         = msg.line;
+            outMsg.str          = buffer;
+
+            m_selectedSink->send(outMsg);
+        }
+    }
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -256,6 +371,341 @@ const char* Logging::getBaseNameFromPath(const char* path) const
     return basename;
 }
 
+void Logging::addModule(Module& module)
+{
+    /* Modules are static objects, therefore they are added during the
+     * static initialization and there is no concurrent access.
+     */
+    module.m_level  = m_currentLogLevel;
+    module.m_next   = m_modules;
+    m_modules       = &module;
+}
+
+void Logging::removeModule(Module& module)
+{
+    Module** link = &m_modules;
+
+    while((nullptr != *link) && (&module != *link))
+    {
+        link = &(*link)->m_next;
+    }
+
+    if (nullptr != *link)
+    {
+        *link = module.m_next;
+    }
+
+    module.m_next = nullptr;
+}
+
+void Logging::addDeferredArg(DeferredMsg& msg, const char* arg)
+{
+    const char*     STR     = (nullptr == arg) ? "(null)" : arg;
+    const size_t    AVAIL   = sizeof(msg.strBuffer) - msg.strLen;
+
+    msg.args[msg.argc].type         = DEFERRED_ARG_STR;
+    msg.args[msg.argc].value.strIdx = msg.strLen;
+    ++msg.argc;
+
+    /* Copy as much as fits, the string will be truncated otherwise. */
+    if (0U < AVAIL)
+    {
+        size_t len = strlen(STR);
+
+        if ((AVAIL - 1U) < len)
+        {
+            len = AVAIL - 1U;
+        }
+
+        memcpy(&msg.strBuffer[msg.strLen], STR, len);
+        msg.strBuffer[msg.strLen + len] = '\0';
+        msg.strLen += len + 1U;
+    }
+    else
+    {
+        /* Refer to the terminating null character of the last string. */
+        msg.args[msg.argc - 1U].value.strIdx = sizeof(msg.strBuffer) - 1U;
+    }
+
+    return;
+}
+
+void Logging::pushDeferred(const DeferredMsg& msg)
+{
+    bool isFirst = false;
+
+    lock();
+
+    if (DEFERRED_QUEUE_SIZE <= m_deferredCount)
+    {
+        ++m_deferredDropped;
+    }
+    else
+    {
+        m_deferred[(m_deferredHead + m_deferredCount) % DEFERRED_QUEUE_SIZE] = msg;
+        ++m_deferredCount;
+
+        isFirst = (1U == m_deferredCount) ? true : false;
+    }
+
+    unlock();
+
+    /* Only the first pending message needs to be notified. */
+    if ((true == isFirst) &&
+        (nullptr != m_deferredNotify))
+    {
+        m_deferredNotify();
+    }
+
+    return;
+}
+
+void Logging::formatDeferred(const DeferredMsg& msg, char* buffer, size_t size) const
+{
+    const char*     STR_CUT_OFF_SEQ     = "...";
+    const size_t    STR_CUT_OFF_SEQ_LEN = strlen(STR_CUT_OFF_SEQ);
+    const char*     fmt                 = msg.format;
+    size_t          len                 = 0U;
+    uint8_t         argIdx              = 0U;
+    bool            isCutOff            = false;
+
+    if ((nullptr == buffer) ||
+        (STR_CUT_OFF_SEQ_LEN >= size))
+    {
+        return;
+    }
+
+    buffer[0] = '\0';
+
+    if (nullptr == fmt)
+    {
+        return;
+    }
+
+    /* The text is formatted conversion by conversion, because every argument
+     * type must be passed correctly to snprintf().
+     */
+    while(('\0' != *fmt) && (false == isCutOff))
+    {
+        /* Space for the cut off sequence and the string termination is kept free. */
+        const size_t    AVAIL   = size - STR_CUT_OFF_SEQ_LEN - 1U - len;
+        int             written = 0;
+
+        if ('%' != *fmt)
+        {
+            if (0U < AVAIL)
+            {
+                buffer[len] = *fmt;
+            }
+
+            written = 1;
+            ++fmt;
+        }
+        else if ('%' == fmt[1])
+        {
+            if (0U < AVAIL)
+            {
+                buffer[len] = '%';
+            }
+
+            written = 1;
+            fmt += 2;
+        }
+        else
+        {
+            /* Max. length of a single conversion specification. */
+            const size_t    SPEC_SIZE       = 16U;
+            const char*     CONVERSIONS     = "diouxXcsfFeEgGaApn";
+            const char*     LENGTH_MODIFIER = "hlLqjzt";
+            char            spec[SPEC_SIZE];
+            size_t          specLen         = 0U;
+            char            conversion      = '\0';
+
+            spec[specLen] = *fmt;
+            ++specLen;
+            ++fmt;
+
+            /* Copy flags, width and precision, but skip the length modifier.
+             * The arguments are stored with their promoted type.
+             */
+            while(('\0' != *fmt) && ('\0' == conversion))
+            {
+                if (nullptr != strchr(CONVERSIONS, *fmt))
+                {
+                    conversion = *fmt;
+                }
+
+                if ((nullptr == strchr(LENGTH_MODIFIER, *fmt)) &&
+                    ((SPEC_SIZE - 1U) > specLen))
+                {
+                    spec[specLen] = *fmt;
+                    ++specLen;
+                }
+
+                ++fmt;
+            }
+
+            spec[specLen] = '\0';
+
+            if (('\0' == conversion) ||
+                ('n' == conversion) ||
+                (msg.argc <= argIdx))
+            {
+                /* Invalid conversion or argument missing. */
+                written = 0;
+            }
+            else
+            {
+                const DeferredArg& arg = msg.args[argIdx];
+
+                ++argIdx;
+
+                if (nullptr != strchr("fFeEgGaA", conversion))
+                {
+                    double value = 0.0;
+
+                    if (DEFERRED_ARG_DOUBLE == arg.type)
+                    {
+                        value = arg.value.d;
+                    }
+                    else if (DEFERRED_ARG_INT == arg.type)
+                    {
+                        value = arg.value.i;
+                    }
+                    else if (DEFERRED_ARG_UINT == arg.type)
+                    {
+                        value = arg.value.u;
+                    }
+                    else
+                    {
+                        ;
+                    }
+
+                    written = snprintf(&buffer[len], AVAIL + 1U, spec, value);
+                }
+                else if ('s' == conversion)
+                {
+                    const char* value = "?";
+
+                    if (DEFERRED_ARG_STR == arg.type)
+                    {
+                        value = &msg.strBuffer[arg.value.strIdx];
+                    }
+
+                    written = snprintf(&buffer[len], AVAIL + 1U, spec, value);
+                }
+                else if ('p' == conversion)
+                {
+                    const void* value = nullptr;
+
+                    if (DEFERRED_ARG_PTR == arg.type)
+                    {
+                        value = arg.value.p;
+                    }
+
+                    written = snprintf(&buffer[len], AVAIL + 1U, spec, value);
+                }
+                else if (nullptr != strchr("di", conversion))
+                {
+                    int value = 0;
+
+                    if (DEFERRED_ARG_DOUBLE == arg.type)
+                    {
+                        value = static_cast<int>(arg.value.d);
+                    }
+                    else if (DEFERRED_ARG_INT == arg.type)
+                    {
+                        value = arg.value.i;
+                    }
+                    else if (DEFERRED_ARG_UINT == arg.type)
+                    {
+                        value = static_cast<int>(arg.value.u);
+                    }
+                    else
+                    {
+                        ;
+                    }
+
+                    written = snprintf(&buffer[len], AVAIL + 1U, spec, value);
+                }
+                else
+                {
+                    unsigned int value = 0U;
+
+                    if (DEFERRED_ARG_DOUBLE == arg.type)
+                    {
+                        value = static_cast<unsigned int>(arg.value.d);
+                    }
+                    else if (DEFERRED_ARG_INT == arg.type)
+                    {
+                        value = static_cast<unsigned int>(arg.value.i);
+                    }
+                    else if (DEFERRED_ARG_UINT == arg.type)
+                    {
+                        value = arg.value.u;
+                    }
+                    else
+                    {
+                        ;
+                    }
+
+                    written = snprintf(&buffer[len], AVAIL + 1U, spec, value);
+                }
+            }
+        }
+
+        if (0 > written)
+        {
+            isCutOff = true;
+        }
+        /* Text truncated? */
+        else if (AVAIL < static_cast<size_t>(written))
+        {
+            len += AVAIL;
+            isCutOff = true;
+        }
+        else
+        {
+            len += written;
+        }
+    }
+
+    if (true == isCutOff)
+    {
+        strcpy(&buffer[len], STR_CUT_OFF_SEQ);
+    }
+    else
+    {
+        buffer[len] = '\0';
+    }
+
+    return;
+}
+
+void Logging::lock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
+void Logging::unlock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGive(m_xMutex);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
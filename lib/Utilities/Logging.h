@@ -40,6 +40,24 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Deferred logging (1) or not (0).
+ * If enabled, the LOG_xxx_DEFERRED macros only record the format string and
+ * the raw arguments. The formatting happens later in processDeferred().
+ * If disabled, they behave like the LOG_xxx macros.
+ */
+#ifndef LOGGING_DEFERRED
+#define LOGGING_DEFERRED    (1)
+#endif  /* LOGGING_DEFERRED */
+
+/**
+ * Min. log level, which is compiled in (0: info, 1: warning, 2: error, 3: fatal).
+ * Log macros below it are compiled out and their arguments are never evaluated.
+ */
+#ifndef LOGGING_MIN_LEVEL
+#define LOGGING_MIN_LEVEL   (0)
+#endif  /* LOGGING_MIN_LEVEL */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
@@ -63,17 +81,98 @@
 /** Severity: FatalLevel. */
 #define LL_FATAL (Logging::LOGLEVEL_FATAL)
 
+/**
+ * Log module, which provides the runtime log level to the log macros.
+ * By default it is the global log level. A source file may use its own
+ * log module, see Logging::Module.
+ */
+#ifndef LOG_MODULE
+#define LOG_MODULE (Logging::getInstance())
+#endif  /* LOG_MODULE */
+
+/**
+ * Log a message, if the log level is enabled in the log module.
+ * The log level is checked inline, before any argument is evaluated.
+ */
+#define LOG_MESSAGE(__level, ...) ((true == LOG_MODULE.isEnabled(__level)) ? Logging::getInstance().processLogMessage(__FILE__, __LINE__, (__level), __VA_ARGS__) : (void)0)
+
+/**
+ * Record a deferred log message, if the log level is enabled in the log module.
+ * The log level is checked inline, before any argument is evaluated.
+ */
+#define LOG_MESSAGE_DEFERRED(__level, ...) ((true == LOG_MODULE.isEnabled(__level)) ? Logging::getInstance().processDeferredLogMessage(__FILE__, __LINE__, (__level), __VA_ARGS__) : (void)0)
+
+/**
+ * Log message, which is compiled out. The arguments are still checked by the
+ * compiler, but never evaluated.
+ */
+#define LOG_MESSAGE_DISABLED(__level, ...) ((false) ? Logging::getInstance().processLogMessage(__FILE__, __LINE__, (__level), __VA_ARGS__) : (void)0)
+
+#if (0 >= LOGGING_MIN_LEVEL)
 /** Macro for Logging with LOGLEVEL_INFO. */
-#define LOG_INFO(...) (Logging::getInstance().processLogMessage(__FILE__, __LINE__, LL_INFO, __VA_ARGS__))
+#define LOG_INFO(...) LOG_MESSAGE(LL_INFO, __VA_ARGS__)
+#else   /* (0 >= LOGGING_MIN_LEVEL) */
+/** Macro for Logging with LOGLEVEL_INFO, compiled out. */
+#define LOG_INFO(...) LOG_MESSAGE_DISABLED(LL_INFO, __VA_ARGS__)
+#endif  /* (0 >= LOGGING_MIN_LEVEL) */
 
+#if (1 >= LOGGING_MIN_LEVEL)
 /** Macro for Logging with LOGLEVEL_WARNING. */
-#define LOG_WARNING(...) (Logging::getInstance().processLogMessage(__FILE__, __LINE__, LL_WARNING, __VA_ARGS__))
+#define LOG_WARNING(...) LOG_MESSAGE(LL_WARNING, __VA_ARGS__)
+#else   /* (1 >= LOGGING_MIN_LEVEL) */
+/** Macro for Logging with LOGLEVEL_WARNING, compiled out. */
+#define LOG_WARNING(...) LOG_MESSAGE_DISABLED(LL_WARNING, __VA_ARGS__)
+#endif  /* (1 >= LOGGING_MIN_LEVEL) */
 
+#if (2 >= LOGGING_MIN_LEVEL)
 /** Macro for Logging with LOGLEVEL_ERROR. */
-#define LOG_ERROR(...) (Logging::getInstance().processLogMessage(__FILE__, __LINE__, LL_ERROR, __VA_ARGS__))
-
-/** Macro for Logging with LOGLEVEL_FATAL. */
-#define LOG_FATAL(...) (Logging::getInstance().processLogMessage(__FILE__, __LINE__, LL_FATAL, __VA_ARGS__))
+#define LOG_ERROR(...) LOG_MESSAGE(LL_ERROR, __VA_ARGS__)
+#else   /* (2 >= LOGGING_MIN_LEVEL) */
+/** Macro for Logging with LOGLEVEL_ERROR, compiled out. */
+#define LOG_ERROR(...) LOG_MESSAGE_DISABLED(LL_ERROR, __VA_ARGS__)
+#endif  /* (2 >= LOGGING_MIN_LEVEL) */
+
+/** Macro for Logging with LOGLEVEL_FATAL. Fatal messages are never compiled out. */
+#define LOG_FATAL(...) LOG_MESSAGE(LL_FATAL, __VA_ARGS__)
+
+#if (0 != LOGGING_DEFERRED)
+
+#if (0 >= LOGGING_MIN_LEVEL)
+/** Macro for deferred Logging with LOGLEVEL_INFO. */
+#define LOG_INFO_DEFERRED(...) LOG_MESSAGE_DEFERRED(LL_INFO, __VA_ARGS__)
+#else   /* (0 >= LOGGING_MIN_LEVEL) */
+/** Macro for deferred Logging with LOGLEVEL_INFO, compiled out. */
+#define LOG_INFO_DEFERRED(...) LOG_INFO(__VA_ARGS__)
+#endif  /* (0 >= LOGGING_MIN_LEVEL) */
+
+#if (1 >= LOGGING_MIN_LEVEL)
+/** Macro for deferred Logging with LOGLEVEL_WARNING. */
+#define LOG_WARNING_DEFERRED(...) LOG_MESSAGE_DEFERRED(LL_WARNING, __VA_ARGS__)
+#else   /* (1 >= LOGGING_MIN_LEVEL) */
+/** Macro for deferred Logging with LOGLEVEL_WARNING, compiled out. */
+#define LOG_WARNING_DEFERRED(...) LOG_WARNING(__VA_ARGS__)
+#endif  /* (1 >= LOGGING_MIN_LEVEL) */
+
+#if (2 >= LOGGING_MIN_LEVEL)
+/** Macro for deferred Logging with LOGLEVEL_ERROR. */
+#define LOG_ERROR_DEFERRED(...) LOG_MESSAGE_DEFERRED(LL_ERROR, __VA_ARGS__)
+#else   /* (2 >= LOGGING_MIN_LEVEL) */
+/** Macro for deferred Logging with LOGLEVEL_ERROR, compiled out. */
+#define LOG_ERROR_DEFERRED(...) LOG_ERROR(__VA_ARGS__)
+#endif  /* (2 >= LOGGING_MIN_LEVEL) */
+
+#else   /* (0 != LOGGING_DEFERRED) */
+
+/** Macro for deferred Logging with LOGLEVEL_INFO. */
+#define LOG_INFO_DEFERRED(...) LOG_INFO(__VA_ARGS__)
+
+/** Macro for deferred Logging with LOGLEVEL_WARNING. */
+#define LOG_WARNING_DEFERRED(...) LOG_WARNING(__VA_ARGS__)
+
+/** Macro for deferred Logging with LOGLEVEL_ERROR. */
+#define LOG_ERROR_DEFERRED(...) LOG_ERROR(__VA_ARGS__)
+
+#endif  /* (0 != LOGGING_DEFERRED) */
 
 /** Macro for switching the LogLevel. */
 #define SWITCH_LOG_LEVEL_TO(logLevel) (Logging::getInstance().setLogLevel(logLevel))
@@ -127,6 +226,107 @@ public:
         }
     };
 
+    /**
+     * A log module has its own runtime log level, e.g. for a single source
+     * file. As long as no own log level is set, it follows the global log level.
+     * Log modules are registered at the logging and shall be static objects.
+     *
+     * A source file uses its own log module after the includes with:
+     * @code
+     * static Logging::Module gLogModule("MyModule");
+     *
+     * #undef LOG_MODULE
+     * #define LOG_MODULE (gLogModule)
+     * @endcode
+     */
+    class Module
+    {
+    public:
+
+        /**
+         * Constructs the log module and registers it at the logging.
+         *
+         * @param[in] name  Module name (string literal), which is used to address it at runtime.
+         */
+        explicit Module(const char* name);
+
+        /**
+         * Destroys the log module and removes it from the logging.
+         */
+        ~Module();
+
+        /**
+         * Get module name.
+         *
+         * @return Module name
+         */
+        const char* getName() const
+        {
+            return m_name;
+        }
+
+        /**
+         * Is the log level enabled in this module?
+         *
+         * @param[in] logLevel  Log level
+         *
+         * @return If enabled, it will return true otherwise false.
+         */
+        bool isEnabled(LogLevel logLevel) const
+        {
+            return (logLevel >= m_level);
+        }
+
+        /**
+         * Get the log level of this module.
+         *
+         * @return Log level
+         */
+        LogLevel getLogLevel() const
+        {
+            return m_level;
+        }
+
+        /**
+         * Set a own log level for this module.
+         *
+         * @param[in] logLevel  Log level
+         */
+        void setLogLevel(LogLevel logLevel)
+        {
+            m_isGlobal  = false;
+            m_level     = logLevel;
+        }
+
+        /**
+         * Follow the global log level again.
+         */
+        void useGlobalLogLevel();
+
+        /**
+         * Does the module follow the global log level?
+         *
+         * @return If it follows the global log level, it will return true otherwise false.
+         */
+        bool isGlobalLogLevel() const
+        {
+            return m_isGlobal;
+        }
+
+    private:
+
+        const char*         m_name;     /**< Module name */
+        volatile LogLevel   m_level;    /**< Log level of this module */
+        volatile bool       m_isGlobal; /**< Follows the global log level? */
+        Module*             m_next;     /**< Next registered module */
+
+        Module();
+        Module(const Module& module);
+        Module& operator=(const Module& module);
+
+        friend class Logging;
+    };
+
     /** The maximum size of the logMessage buffer to get the variable arguments. */
     static const uint16_t MESSAGE_BUFFER_SIZE   = 80U;
 
@@ -175,7 +375,7 @@ public:
     LogSink* getSelectedSink();
 
     /**
-     * Set the logLevel.
+     * Set the logLevel. All log modules without own log level follow it.
      *
      * @param[in] logLevel The new logLevel.
     */
@@ -189,8 +389,30 @@ public:
     LogLevel getLogLevel() const;
 
     /**
-     * Write a formatable logMessage to the current output,
-     * if the severity is >= the current logLevel, otherwise the logMessage is discarded.
+     * Is the log level enabled by the global log level?
+     * It is used by the log macros in files without own log module.
+     *
+     * @param[in] logLevel  Log level
+     *
+     * @return If enabled, it will return true otherwise false.
+     */
+    bool isEnabled(LogLevel logLevel) const
+    {
+        return (logLevel >= m_currentLogLevel);
+    }
+
+    /**
+     * Get a log module by its name.
+     *
+     * @param[in] name  Module name
+     *
+     * @return Log module or nullptr, if not found.
+     */
+    Module* getModule(const char* name);
+
+    /**
+     * Write a formatable logMessage to the current output.
+     * The log level is checked by the log macros before, see LOG_MESSAGE.
      *
      * @param[in] file              Name of the file
      * @param[in] line              Line number in the file
@@ -203,8 +425,8 @@ public:
     void processLogMessage(const char* file, int line, const LogLevel messageLogLevel, const char* format, ...);
 
     /**
-     * Write a formatable logMessage to the current output,
-     * if the severity is >= the current logLevel, otherwise the logMessage is discarded.
+     * Write a logMessage to the current output.
+     * The log level is checked by the log macros before, see LOG_MESSAGE.
      *
      * @param[in] file              Name of the file
      * @param[in] line              Line number in the file
@@ -228,20 +450,181 @@ public:
      */
     void processLogMessage(uint32_t timestamp, const String& logger, const LogLevel messageLogLevel, const String& message);
 
+    /**
+     * Record a log message for deferred formatting.
+     * The log level is checked by the log macros before, see LOG_MESSAGE_DEFERRED.
+     * Only integer, floating point, string and pointer arguments are supported.
+     * String arguments are copied, up to DEFERRED_STR_BUFFER_SIZE in total.
+     * The format string must be a literal, because only its address is kept.
+     *
+     * @param[in] file              Name of the file
+     * @param[in] line              Line number in the file
+     * @param[in] messageLogLevel   The logLevel.
+     * @param[in] format            The format of the arguments (string literal).
+     * @param[in] args              The arguments, up to MAX_DEFERRED_ARGS.
+     */
+    template < typename ... Args >
+    void processDeferredLogMessage(const char* file, int line, const LogLevel messageLogLevel, const char* format, Args ... args)
+    {
+        static_assert(MAX_DEFERRED_ARGS >= sizeof...(Args), "Too many deferred log arguments.");
+
+        if (nullptr != m_selectedSink)
+        {
+            DeferredMsg msg;
+
+            msg.timestamp   = esp_log_timestamp();
+            msg.level       = messageLogLevel;
+            msg.file        = file;
+            msg.line        = line;
+            msg.format      = format;
+
+            addDeferredArgs(msg, args...);
+            pushDeferred(msg);
+        }
+    }
+
+    /**
+     * Format the deferred log messages and send them to the selected sink.
+     * Call this periodically in a context, where the formatting doesn't hurt.
+     */
+    void processDeferred();
+
+    /**
+     * Notification, that deferred log messages are available.
+     * It is called in the context of the logging task and must not block.
+     */
+    typedef void (*DeferredNotifyFunc)(void);
+
+    /**
+     * Set the notification, which is called if a deferred log message is
+     * recorded while no other is pending. This allows to call
+     * processDeferred() on demand, instead of periodically.
+     *
+     * @param[in] notify    Notification or nullptr to remove it
+     */
+    void setDeferredNotify(DeferredNotifyFunc notify)
+    {
+        m_deferredNotify = notify;
+    }
+
+    /**
+     * Get the number of deferred log messages, which were dropped because
+     * the deferred queue was full and are not reported yet.
+     *
+     * @return Number of dropped deferred log messages
+     */
+    uint32_t getDeferredDropCount() const
+    {
+        return m_deferredDropped;
+    }
+
     /** Number of supported log sinks. */
     static const uint8_t MAX_SINKS = 2U;
 
+    /** Max. number of arguments of a deferred log message. */
+    static const uint8_t MAX_DEFERRED_ARGS = 4U;
+
+    /** Max. number of deferred log messages. */
+    static const uint8_t DEFERRED_QUEUE_SIZE = 16U;
+
+    /** Buffer size for the copied string arguments of a deferred log message. */
+    static const uint8_t DEFERRED_STR_BUFFER_SIZE = 32U;
+
 private:
 
+    /**
+     * Type of a deferred log message argument.
+     */
+    enum DeferredArgType
+    {
+        DEFERRED_ARG_INT = 0,   /**< Signed integer */
+        DEFERRED_ARG_UINT,      /**< Unsigned integer */
+        DEFERRED_ARG_DOUBLE,    /**< Floating point */
+        DEFERRED_ARG_STR,       /**< String, copied to the string buffer */
+        DEFERRED_ARG_PTR        /**< Pointer */
+    };
+
+    /**
+     * A argument of a deferred log message.
+     */
+    struct DeferredArg
+    {
+        DeferredArgType type;   /**< Argument type */
+
+        /** Argument value */
+        union
+        {
+            int32_t     i;      /**< Signed integer */
+            uint32_t    u;      /**< Unsigned integer */
+            double      d;      /**< Floating point */
+            uint8_t     strIdx; /**< Index of the string in the string buffer */
+            const void* p;      /**< Pointer */
+        } value;
+    };
+
+    /**
+     * A deferred log message, which is not formatted yet.
+     */
+    struct DeferredMsg
+    {
+        uint32_t    timestamp;                          /**< Timestamp in ms */
+        LogLevel    level;                              /**< Log level */
+        const char* file;                               /**< File path as retrieved from __FILE__ */
+        int         line;                               /**< Line number in the file */
+        const char* format;                             /**< Format string */
+        uint8_t     argc;                               /**< Number of arguments */
+        DeferredArg args[MAX_DEFERRED_ARGS];            /**< Arguments */
+        uint8_t     strLen;                             /**< Used size of the string buffer */
+        char        strBuffer[DEFERRED_STR_BUFFER_SIZE];/**< Copied string arguments */
+
+        /**
+         * Initializes a empty deferred message.
+         */
+        DeferredMsg() :
+            timestamp(0U),
+            level(LOGLEVEL_INFO),
+            file(nullptr),
+            line(0),
+            format(nullptr),
+            argc(0U),
+            args(),
+            strLen(0U),
+            strBuffer()
+        {
+        }
+    };
+
     /** The current log level. */
     LogLevel    m_currentLogLevel;
 
     /** List of log sinks */
     LogSink*    m_sinks[MAX_SINKS];
 
+    /** Registered log modules */
+    Module*     m_modules;
+
     /** Active sink */
     LogSink*    m_selectedSink;
 
+    /** Ring buffer with deferred log messages */
+    DeferredMsg m_deferred[DEFERRED_QUEUE_SIZE];
+
+    /** Index of the oldest deferred log message */
+    uint8_t     m_deferredHead;
+
+    /** Number of deferred log messages */
+    uint8_t     m_deferredCount;
+
+    /** Number of dropped deferred log messages */
+    uint32_t    m_deferredDropped;
+
+    /** Notification about pending deferred log messages */
+    DeferredNotifyFunc  m_deferredNotify;
+
+#ifndef NATIVE
+    SemaphoreHandle_t   m_xMutex;   /**< Mutex to protect the deferred log messages. */
+#endif  /* NATIVE */
+
     /**
      * Checks wether the given severity of a logMessage is valid to be printed.
      *
@@ -260,13 +643,183 @@ private:
     */
     const char* getBaseNameFromPath(const char* path) const;
 
+    /**
+     * Add a log module. It follows the global log level.
+     *
+     * @param[in] module    Log module
+     */
+    void addModule(Module& module);
+
+    /**
+     * Remove a log module.
+     *
+     * @param[in] module    Log module
+     */
+    void removeModule(Module& module);
+
+    /**
+     * Stop adding deferred arguments.
+     *
+     * @param[in,out] msg   Deferred log message
+     */
+    void addDeferredArgs(DeferredMsg& msg)
+    {
+        (void)msg;
+    }
+
+    /**
+     * Add the arguments to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       First argument
+     * @param[in] args      Further arguments
+     */
+    template < typename T, typename ... Args >
+    void addDeferredArgs(DeferredMsg& msg, T arg, Args ... args)
+    {
+        addDeferredArg(msg, arg);
+        addDeferredArgs(msg, args...);
+    }
+
+    /**
+     * Add a signed integer argument to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    void addDeferredArg(DeferredMsg& msg, int arg)
+    {
+        msg.args[msg.argc].type     = DEFERRED_ARG_INT;
+        msg.args[msg.argc].value.i  = arg;
+        ++msg.argc;
+    }
+
+    /**
+     * Add a signed integer argument to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    void addDeferredArg(DeferredMsg& msg, long arg)
+    {
+        addDeferredArg(msg, static_cast<int>(arg));
+    }
+
+    /**
+     * Add a unsigned integer argument to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    void addDeferredArg(DeferredMsg& msg, unsigned int arg)
+    {
+        msg.args[msg.argc].type     = DEFERRED_ARG_UINT;
+        msg.args[msg.argc].value.u  = arg;
+        ++msg.argc;
+    }
+
+    /**
+     * Add a unsigned integer argument to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    void addDeferredArg(DeferredMsg& msg, unsigned long arg)
+    {
+        addDeferredArg(msg, static_cast<unsigned int>(arg));
+    }
+
+    /**
+     * Add a floating point argument to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    void addDeferredArg(DeferredMsg& msg, double arg)
+    {
+        msg.args[msg.argc].type     = DEFERRED_ARG_DOUBLE;
+        msg.args[msg.argc].value.d  = arg;
+        ++msg.argc;
+    }
+
+    /**
+     * Add a string argument to a deferred log message.
+     * The string is copied, because it may not live long enough.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    void addDeferredArg(DeferredMsg& msg, const char* arg);
+
+    /**
+     * Add a string argument to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    void addDeferredArg(DeferredMsg& msg, char* arg)
+    {
+        addDeferredArg(msg, static_cast<const char*>(arg));
+    }
+
+    /**
+     * Add a pointer argument to a deferred log message.
+     *
+     * @param[in,out] msg   Deferred log message
+     * @param[in] arg       Argument
+     */
+    template < typename T >
+    void addDeferredArg(DeferredMsg& msg, const T* arg)
+    {
+        msg.args[msg.argc].type     = DEFERRED_ARG_PTR;
+        msg.args[msg.argc].value.p  = arg;
+        ++msg.argc;
+    }
+
+    /**
+     * Push a deferred log message to the ring buffer.
+     * If the ring buffer is full, the message is dropped.
+     *
+     * @param[in] msg   Deferred log message
+     */
+    void pushDeferred(const DeferredMsg& msg);
+
+    /**
+     * Format a deferred log message.
+     *
+     * @param[in]   msg     Deferred log message
+     * @param[out]  buffer  Buffer for the formatted text
+     * @param[in]   size    Buffer size in bytes
+     */
+    void formatDeferred(const DeferredMsg& msg, char* buffer, size_t size) const;
+
+    /**
+     * Lock the deferred log messages.
+     */
+    void lock();
+
+    /**
+     * Unlock the deferred log messages.
+     */
+    void unlock();
+
     /**
      * Construct Logging.
      */
     Logging() :
         m_currentLogLevel(LOGLEVEL_ERROR),
         m_sinks(),
-        m_selectedSink(nullptr)
+        m_modules(nullptr),
+        m_selectedSink(nullptr),
+        m_deferred(),
+        m_deferredHead(0U),
+        m_deferredCount(0U),
+        m_deferredDropped(0U),
+        m_deferredNotify(nullptr)
+#ifndef NATIVE
+        ,
+        m_xMutex(xSemaphoreCreateMutex())
+#endif  /* NATIVE */
     {
         uint8_t index = 0U;
 
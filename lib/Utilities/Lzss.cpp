@@ -0,0 +1,242 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  LZSS compression
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Lzss.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+size_t Lzss::compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+    size_t  srcIndex    = 0U;
+    size_t  dstIndex    = 0U;
+    size_t  flagIndex   = 0U;
+    uint8_t flagBit     = 0U;
+
+    if ((nullptr == src) ||
+        (nullptr == dst))
+    {
+        return 0U;
+    }
+
+    while(srcSize > srcIndex)
+    {
+        const size_t    WINDOW_BEGIN    = (WINDOW_SIZE < srcIndex) ? (srcIndex - WINDOW_SIZE) : 0U;
+        const size_t    MAX_LENGTH      = ((srcSize - srcIndex) < MAX_MATCH) ? (srcSize - srcIndex) : MAX_MATCH;
+        size_t          bestLength      = 0U;
+        size_t          bestDistance    = 0U;
+        size_t          candidate       = 0U;
+
+        /* Start a new group with its flag byte. */
+        if (0U == flagBit)
+        {
+            if (dstSize <= dstIndex)
+            {
+                return 0U;
+            }
+
+            flagIndex       = dstIndex;
+            dst[flagIndex]  = 0U;
+            ++dstIndex;
+        }
+
+        /* Find the longest match in the window. A match may overlap the
+         * current position, which compresses repeated bytes too.
+         */
+        for(candidate = WINDOW_BEGIN; candidate < srcIndex; ++candidate)
+        {
+            size_t length = 0U;
+
+            while((MAX_LENGTH > length) &&
+                  (src[candidate + length] == src[srcIndex + length]))
+            {
+                ++length;
+            }
+
+            if (bestLength < length)
+            {
+                bestLength      = length;
+                bestDistance    = srcIndex - candidate;
+
+                if (MAX_LENGTH == length)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (MIN_MATCH <= bestLength)
+        {
+            const uint16_t MATCH = static_cast<uint16_t>(((bestDistance - 1U) << LENGTH_BITS) | (bestLength - MIN_MATCH));
+
+            if (dstSize < (dstIndex + 2U))
+            {
+                return 0U;
+            }
+
+            dst[dstIndex + 0U] = static_cast<uint8_t>(MATCH >> 8U);
+            dst[dstIndex + 1U] = static_cast<uint8_t>(MATCH & 0xffU);
+            dstIndex += 2U;
+            srcIndex += bestLength;
+        }
+        else
+        {
+            if (dstSize <= dstIndex)
+            {
+                return 0U;
+            }
+
+            dst[flagIndex] |= (1U << flagBit);
+            dst[dstIndex] = src[srcIndex];
+            ++dstIndex;
+            ++srcIndex;
+        }
+
+        flagBit = (flagBit + 1U) % 8U;
+    }
+
+    return dstIndex;
+}
+
+size_t Lzss::decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+    size_t  srcIndex    = 0U;
+    size_t  dstIndex    = 0U;
+    uint8_t flags       = 0U;
+    uint8_t flagBit     = 0U;
+
+    if ((nullptr == src) ||
+        (nullptr == dst))
+    {
+        return 0U;
+    }
+
+    while(srcSize > srcIndex)
+    {
+        if (0U == flagBit)
+        {
+            flags = src[srcIndex];
+            ++srcIndex;
+
+            /* A group without items is only valid at the end. */
+            if (srcSize <= srcIndex)
+            {
+                break;
+            }
+        }
+
+        if (0U != (flags & (1U << flagBit)))
+        {
+            if (dstSize <= dstIndex)
+            {
+                return 0U;
+            }
+
+            dst[dstIndex] = src[srcIndex];
+            ++dstIndex;
+            ++srcIndex;
+        }
+        else
+        {
+            uint16_t    match       = 0U;
+            size_t      distance    = 0U;
+            size_t      length      = 0U;
+
+            if (srcSize < (srcIndex + 2U))
+            {
+                return 0U;
+            }
+
+            match       = (static_cast<uint16_t>(src[srcIndex + 0U]) << 8U) | static_cast<uint16_t>(src[srcIndex + 1U]);
+            distance    = static_cast<size_t>(match >> LENGTH_BITS) + 1U;
+            length      = static_cast<size_t>(match & ((1U << LENGTH_BITS) - 1U)) + MIN_MATCH;
+            srcIndex   += 2U;
+
+            if ((distance > dstIndex) ||
+                (dstSize < (dstIndex + length)))
+            {
+                return 0U;
+            }
+
+            /* Copy byte by byte, because the match may overlap. */
+            while(0U < length)
+            {
+                dst[dstIndex] = dst[dstIndex - distance];
+                ++dstIndex;
+                --length;
+            }
+        }
+
+        flagBit = (flagBit + 1U) % 8U;
+    }
+
+    return dstIndex;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,133 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  LZSS compression
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __LZSS_H__
+#define __LZSS_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A small footprint LZSS codec for short texts like JSON configurations.
+ * It works buffer to buffer and needs no additional memory, because the
+ * already processed data is used as dictionary.
+ *
+ * The compressed data is a sequence of groups. Every group starts with a
+ * flag byte, followed by up to 8 items. The flag bits are assigned LSB
+ * first to the items:
+ * - 1: Literal byte.
+ * - 0: Match (2 bytes, big endian), which copies a sequence of the already
+ *   decompressed data. The upper 10 bits are the distance minus 1 and
+ *   the lower 6 bits are the length minus MIN_MATCH.
+ */
+namespace Lzss
+{
+
+/** Number of bits of the match distance. */
+static const uint8_t    DISTANCE_BITS   = 10U;
+
+/** Number of bits of the match length. */
+static const uint8_t    LENGTH_BITS     = 6U;
+
+/** Max. match distance in byte. */
+static const size_t     WINDOW_SIZE     = (1U << DISTANCE_BITS);
+
+/** Min. match length in byte. Shorter matches are stored as literals. */
+static const size_t     MIN_MATCH       = 3U;
+
+/** Max. match length in byte. */
+static const size_t     MAX_MATCH       = MIN_MATCH + (1U << LENGTH_BITS) - 1U;
+
+/**
+ * Get the max. compressed size, which is reached by data without any
+ * match.
+ *
+ * @param[in] size  Uncompressed size in byte
+ *
+ * @return Max. compressed size in byte
+ */
+inline size_t getMaxCompressedSize(size_t size)
+{
+    return size + ((size + 7U) / 8U);
+}
+
+/**
+ * Compress data.
+ *
+ * @param[in]  src      Uncompressed data
+ * @param[in]  srcSize  Uncompressed data size in byte
+ * @param[out] dst      Buffer for the compressed data
+ * @param[in]  dstSize  Buffer size in byte
+ *
+ * @return Compressed size in byte. If the buffer is too small, it will return 0.
+ */
+extern size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+/**
+ * Decompress data.
+ *
+ * @param[in]  src      Compressed data
+ * @param[in]  srcSize  Compressed data size in byte
+ * @param[out] dst      Buffer for the uncompressed data
+ * @param[in]  dstSize  Buffer size in byte
+ *
+ * @return Uncompressed size in byte. If the data is invalid or the buffer is too small, it will return 0.
+ */
+extern size_t decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+}
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LZSS_H__ */
+
+/** @} */
@@ -0,0 +1,179 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Memory allocation policy
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MemPolicy.h"
+#include <stdlib.h>
+
+#ifndef NATIVE
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+static uint32_t getCaps(MemPolicy::Region region);
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/** Capabilities of the internal SRAM. */
+static const uint32_t   CAPS_INTERNAL   = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+
+/** Capabilities of the PSRAM. */
+static const uint32_t   CAPS_PSRAM      = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern void* MemPolicy::allocate(Region region, size_t size)
+{
+#ifdef NATIVE
+    (void)region;
+
+    return malloc(size);
+#else   /* NATIVE */
+    void* ptr = heap_caps_malloc(size, getCaps(region));
+
+    /* Fallback to the internal SRAM, in case the PSRAM is exhausted. */
+    if ((nullptr == ptr) &&
+        (REGION_LARGE == region) &&
+        (true == isPsramAvailable()))
+    {
+        ptr = heap_caps_malloc(size, CAPS_INTERNAL);
+    }
+
+    return ptr;
+#endif  /* NATIVE */
+}
+
+extern void* MemPolicy::reallocate(Region region, void* ptr, size_t size)
+{
+#ifdef NATIVE
+    (void)region;
+
+    return realloc(ptr, size);
+#else   /* NATIVE */
+    void* newPtr = heap_caps_realloc(ptr, size, getCaps(region));
+
+    /* Fallback to the internal SRAM, in case the PSRAM is exhausted. */
+    if ((nullptr == newPtr) &&
+        (REGION_LARGE == region) &&
+        (true == isPsramAvailable()))
+    {
+        newPtr = heap_caps_realloc(ptr, size, CAPS_INTERNAL);
+    }
+
+    return newPtr;
+#endif  /* NATIVE */
+}
+
+extern void MemPolicy::release(void* ptr)
+{
+    free(ptr);
+    return;
+}
+
+extern bool MemPolicy::isPsramAvailable()
+{
+#ifdef NATIVE
+    return false;
+#else   /* NATIVE */
+    return psramFound();
+#endif  /* NATIVE */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#ifndef NATIVE
+
+/**
+ * Get the heap capabilities of a memory region.
+ * Without PSRAM, large buffers are located in the internal SRAM.
+ *
+ * @param[in] region    Memory region
+ *
+ * @return Heap capabilities
+ */
+static uint32_t getCaps(MemPolicy::Region region)
+{
+    uint32_t caps = CAPS_INTERNAL;
+
+    if ((MemPolicy::REGION_LARGE == region) &&
+        (true == MemPolicy::isPsramAvailable()))
+    {
+        caps = CAPS_PSRAM;
+    }
+
+    return caps;
+}
+
+#endif  /* NATIVE */
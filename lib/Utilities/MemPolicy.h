@@ -0,0 +1,168 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Memory allocation policy
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __MEM_POLICY_H__
+#define __MEM_POLICY_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The memory allocation policy decides where a buffer is located.
+ * Buffers, which are accessed with every frame, shall be located in the
+ * internal SRAM. Large buffers, which are not latency critical, shall be
+ * located in the external PSRAM if available, to keep the internal heap free.
+ */
+namespace MemPolicy
+{
+
+/** Memory regions */
+enum Region
+{
+    REGION_FAST = 0,    /**< Internal SRAM, used for render buffers */
+    REGION_LARGE        /**< PSRAM if available, otherwise internal SRAM. Used for large, not latency critical buffers. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Allocate memory in the given region.
+ *
+ * @param[in] region    Memory region
+ * @param[in] size      Size in byte
+ *
+ * @return If successful, it will return a pointer to the memory otherwise nullptr.
+ */
+extern void* allocate(Region region, size_t size);
+
+/**
+ * Change the size of memory, which was allocated with allocate() before.
+ * The content is kept up to the lower of the old and new size.
+ *
+ * @param[in] region    Memory region
+ * @param[in] ptr       Pointer to the memory, may be nullptr.
+ * @param[in] size      New size in byte
+ *
+ * @return If successful, it will return a pointer to the memory otherwise nullptr.
+ */
+extern void* reallocate(Region region, void* ptr, size_t size);
+
+/**
+ * Release memory, which was allocated with allocate() or reallocate() before.
+ *
+ * @param[in] ptr   Pointer to the memory, may be nullptr.
+ */
+extern void release(void* ptr);
+
+/**
+ * Is PSRAM available?
+ *
+ * @return If PSRAM is available, it will return true otherwise false.
+ */
+extern bool isPsramAvailable();
+
+/**
+ * Allocate and construct an array in the given region.
+ *
+ * @param[in] region    Memory region
+ * @param[in] count     Number of elements
+ *
+ * @return If successful, it will return a pointer to the array otherwise nullptr.
+ */
+template < typename T >
+T* allocateArray(Region region, size_t count)
+{
+    T* array = static_cast<T*>(allocate(region, count * sizeof(T)));
+
+    if (nullptr != array)
+    {
+        size_t index = 0U;
+
+        for(index = 0U; index < count; ++index)
+        {
+            (void)new(&array[index]) T();
+        }
+    }
+
+    return array;
+}
+
+/**
+ * Destroy and release an array, which was allocated with allocateArray() before.
+ *
+ * @param[in] array Array, may be nullptr.
+ * @param[in] count Number of elements
+ */
+template < typename T >
+void releaseArray(T* array, size_t count)
+{
+    if (nullptr != array)
+    {
+        size_t index = 0U;
+
+        for(index = 0U; index < count; ++index)
+        {
+            array[index].~T();
+        }
+
+        release(array);
+    }
+
+    return;
+}
+
+}
+
+#endif  /* __MEM_POLICY_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,463 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Metrics registry
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Metrics.h"
+
+#include <stdio.h>
+#include <inttypes.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Metric::~Metric()
+{
+    Metrics::getInstance().unregisterMetric(*this);
+}
+
+void MetricCounter::writeSamples(Print& out) const
+{
+    writeSample(out, nullptr, nullptr, get());
+
+    return;
+}
+
+void MetricCounter::writeStatsdSamples(Print& out, const char* prefix) const
+{
+    writeStatsdSample(out, prefix, nullptr, get());
+
+    return;
+}
+
+int32_t MetricGauge::get() const
+{
+    int32_t value = 0;
+
+    if (nullptr != m_source)
+    {
+        value = m_source();
+    }
+    else
+    {
+        value = m_value.load(std::memory_order_relaxed);
+    }
+
+    return value;
+}
+
+void MetricGauge::writeSamples(Print& out) const
+{
+    writeSample(out, nullptr, nullptr, get());
+
+    return;
+}
+
+void MetricGauge::writeStatsdSamples(Print& out, const char* prefix) const
+{
+    writeStatsdSample(out, prefix, nullptr, get());
+
+    return;
+}
+
+MetricHistogram::MetricHistogram(const char* name, const char* help, const uint32_t* bounds, uint8_t count) :
+    Metric(name, help, TYPE_HISTOGRAM),
+    m_bounds(bounds),
+    m_bucketCnt(count),
+    m_count(0U),
+    m_sum(0U)
+{
+    uint8_t index = 0U;
+
+    if (nullptr == m_bounds)
+    {
+        m_bucketCnt = 0U;
+    }
+    else if (MAX_BUCKETS < m_bucketCnt)
+    {
+        m_bucketCnt = MAX_BUCKETS;
+    }
+    else
+    {
+        ;
+    }
+
+    for(index = 0U; index < MAX_BUCKETS; ++index)
+    {
+        m_buckets[index].store(0U, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(uint32_t value)
+{
+    uint8_t index = 0U;
+
+    /* Only the first matching bucket is increased, the cumulative
+     * counts are calculated during export.
+     */
+    while((index < m_bucketCnt) && (m_bounds[index] < value))
+    {
+        ++index;
+    }
+
+    if (index < m_bucketCnt)
+    {
+        (void)m_buckets[index].fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    (void)m_sum.fetch_add(value, std::memory_order_relaxed);
+    (void)m_count.fetch_add(1U, std::memory_order_relaxed);
+
+    return;
+}
+
+void MetricHistogram::writeSamples(Print& out) const
+{
+    uint8_t     index       = 0U;
+    uint32_t    cumulative  = 0U;
+    char        label[24];
+
+    for(index = 0U; index < m_bucketCnt; ++index)
+    {
+        cumulative += m_buckets[index].load(std::memory_order_relaxed);
+
+        (void)snprintf(label, sizeof(label), "le=\"%" PRIu32 "\"", m_bounds[index]);
+        writeSample(out, "_bucket", label, cumulative);
+    }
+
+    writeSample(out, "_bucket", "le=\"+Inf\"", getCount());
+    writeSample(out, "_sum", nullptr, getSum());
+    writeSample(out, "_count", nullptr, getCount());
+
+    return;
+}
+
+uint32_t MetricHistogram::getPercentile(uint8_t percent) const
+{
+    uint32_t    value       = 0U;
+    uint32_t    count       = getCount();
+    uint32_t    rank        = 0U;
+    uint32_t    cumulative  = 0U;
+    uint8_t     index       = 0U;
+
+    if ((0U < count) &&
+        (0U < m_bucketCnt))
+    {
+        if (100U < percent)
+        {
+            percent = 100U;
+        }
+
+        /* Rank of the percentile, rounded up. */
+        rank = static_cast<uint32_t>((static_cast<uint64_t>(count) * percent + 99U) / 100U);
+
+        if (0U == rank)
+        {
+            rank = 1U;
+        }
+
+        value = m_bounds[m_bucketCnt - 1U];
+
+        while(index < m_bucketCnt)
+        {
+            cumulative += m_buckets[index].load(std::memory_order_relaxed);
+
+            if (rank <= cumulative)
+            {
+                value = m_bounds[index];
+                break;
+            }
+
+            ++index;
+        }
+    }
+
+    return value;
+}
+
+void MetricHistogram::writeStatsdSamples(Print& out, const char* prefix) const
+{
+    writeStatsdSample(out, prefix, ".count", getCount());
+    writeStatsdSample(out, prefix, ".sum", getSum());
+    writeStatsdSample(out, prefix, ".p50", getPercentile(50U));
+    writeStatsdSample(out, prefix, ".p90", getPercentile(90U));
+    writeStatsdSample(out, prefix, ".p99", getPercentile(99U));
+
+    return;
+}
+
+void Metrics::registerMetric(Metric& metric)
+{
+    lock();
+    metric.m_next   = m_head;
+    m_head          = &metric;
+    unlock();
+
+    return;
+}
+
+void Metrics::unregisterMetric(Metric& metric)
+{
+    Metric* prev    = nullptr;
+    Metric* current = nullptr;
+
+    lock();
+
+    current = m_head;
+
+    while((nullptr != current) && (&metric != current))
+    {
+        prev    = current;
+        current = current->m_next;
+    }
+
+    if (nullptr != current)
+    {
+        if (nullptr == prev)
+        {
+            m_head = current->m_next;
+        }
+        else
+        {
+            prev->m_next = current->m_next;
+        }
+
+        current->m_next = nullptr;
+    }
+
+    unlock();
+
+    return;
+}
+
+void Metrics::write(Print& out)
+{
+    const char* TYPE_NAMES[] =
+    {
+        "counter",
+        "gauge",
+        "histogram"
+    };
+    Metric*     metric  = nullptr;
+
+    lock();
+
+    metric = m_head;
+
+    while(nullptr != metric)
+    {
+        (void)out.print("# HELP ");
+        (void)out.print(metric->getName());
+        (void)out.print(" ");
+        (void)out.print(metric->getHelp());
+        (void)out.print("\n# TYPE ");
+        (void)out.print(metric->getName());
+        (void)out.print(" ");
+        (void)out.print(TYPE_NAMES[metric->getType()]);
+        (void)out.print("\n");
+
+        metric->writeSamples(out);
+
+        metric = metric->m_next;
+    }
+
+    unlock();
+
+    return;
+}
+
+void Metrics::writeStatsd(Print& out, const char* prefix)
+{
+    Metric* metric = nullptr;
+
+    lock();
+
+    metric = m_head;
+
+    while(nullptr != metric)
+    {
+        metric->writeStatsdSamples(out, prefix);
+        metric = metric->m_next;
+    }
+
+    unlock();
+
+    return;
+}
+
+uint32_t Metrics::getNumOfMetrics()
+{
+    uint32_t    count   = 0U;
+    Metric*     metric  = nullptr;
+
+    lock();
+
+    metric = m_head;
+
+    while(nullptr != metric)
+    {
+        ++count;
+        metric = metric->m_next;
+    }
+
+    unlock();
+
+    return count;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+Metric::Metric(const char* name, const char* help, Type type) :
+    m_name(name),
+    m_help(help),
+    m_type(type),
+    m_next(nullptr)
+{
+    Metrics::getInstance().registerMetric(*this);
+}
+
+void Metric::writeSample(Print& out, const char* suffix, const char* label, int64_t value) const
+{
+    char buffer[24];
+
+    (void)out.print(m_name);
+
+    if (nullptr != suffix)
+    {
+        (void)out.print(suffix);
+    }
+
+    if (nullptr != label)
+    {
+        (void)out.print("{");
+        (void)out.print(label);
+        (void)out.print("}");
+    }
+
+    (void)snprintf(buffer, sizeof(buffer), " %" PRId64 "\n", value);
+    (void)out.print(buffer);
+
+    return;
+}
+
+void Metric::writeStatsdSample(Print& out, const char* prefix, const char* suffix, int64_t value) const
+{
+    char    line[160];
+    int     length  = 0;
+
+    length = snprintf(line, sizeof(line), "%s%s%s%s:%" PRId64 "|g\n",
+                        (nullptr != prefix) ? prefix : "",
+                        (nullptr != prefix) ? "." : "",
+                        m_name,
+                        (nullptr != suffix) ? suffix : "",
+                        value);
+
+    /* A truncated line would be a invalid sample. */
+    if ((0 < length) &&
+        (sizeof(line) > static_cast<size_t>(length)))
+    {
+        (void)out.write(reinterpret_cast<const uint8_t*>(line), static_cast<size_t>(length));
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+Metrics::~Metrics()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+#endif  /* NATIVE */
+}
+
+void Metrics::lock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
+void Metrics::unlock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGive(m_xMutex);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,529 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Metrics registry
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+#include <Arduino.h>
+#include <Print.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Base class of a metric. A metric registers itself in the metrics registry
+ * on construction and unregisters itself on destruction.
+ *
+ * The metric values are updated lock-free, therefore they can be updated
+ * from any task on any core.
+ */
+class Metric
+{
+public:
+
+    /**
+     * Metric type.
+     */
+    enum Type
+    {
+        TYPE_COUNTER = 0,   /**< Monotonic increasing counter */
+        TYPE_GAUGE,         /**< Value, which can go up and down */
+        TYPE_HISTOGRAM      /**< Distribution of observed values in buckets */
+    };
+
+    /**
+     * Destroys the metric and unregisters it.
+     */
+    virtual ~Metric();
+
+    /**
+     * Get metric name.
+     *
+     * @return Metric name
+     */
+    const char* getName() const
+    {
+        return m_name;
+    }
+
+    /**
+     * Get metric description.
+     *
+     * @return Metric description
+     */
+    const char* getHelp() const
+    {
+        return m_help;
+    }
+
+    /**
+     * Get metric type.
+     *
+     * @return Metric type
+     */
+    Type getType() const
+    {
+        return m_type;
+    }
+
+    /**
+     * Write the samples of the metric in Prometheus text format.
+     *
+     * @param[in] out   Output
+     */
+    virtual void writeSamples(Print& out) const = 0;
+
+    /**
+     * Write the samples of the metric in StatsD format. Every sample is
+     * written as gauge, counters too. This way a lost datagram doesn't
+     * falsify the values.
+     *
+     * @param[in] out       Output
+     * @param[in] prefix    Prefix of the metric name, may be nullptr.
+     */
+    virtual void writeStatsdSamples(Print& out, const char* prefix) const = 0;
+
+protected:
+
+    /**
+     * Constructs the metric and registers it.
+     *
+     * @param[in] name  Metric name, must be a string literal.
+     * @param[in] help  Metric description, must be a string literal.
+     * @param[in] type  Metric type
+     */
+    Metric(const char* name, const char* help, Type type);
+
+    /**
+     * Write a single sample line.
+     *
+     * @param[in] out       Output
+     * @param[in] suffix    Suffix of the metric name, may be nullptr.
+     * @param[in] label     Label, may be nullptr.
+     * @param[in] value     Sample value
+     */
+    void writeSample(Print& out, const char* suffix, const char* label, int64_t value) const;
+
+    /**
+     * Write a single sample line in StatsD format with a single write, so
+     * a datagram oriented output never splits a line.
+     *
+     * @param[in] out       Output
+     * @param[in] prefix    Prefix of the metric name, may be nullptr.
+     * @param[in] suffix    Suffix of the metric name, may be nullptr.
+     * @param[in] value     Sample value
+     */
+    void writeStatsdSample(Print& out, const char* prefix, const char* suffix, int64_t value) const;
+
+private:
+
+    friend class Metrics;
+
+    const char* m_name;     /**< Metric name */
+    const char* m_help;     /**< Metric description */
+    Type        m_type;     /**< Metric type */
+    Metric*     m_next;     /**< Next metric in the registry */
+
+    Metric(const Metric& metric);
+    Metric& operator=(const Metric& metric);
+};
+
+/**
+ * Monotonic increasing counter metric.
+ */
+class MetricCounter : public Metric
+{
+public:
+
+    /**
+     * Constructs the counter metric.
+     *
+     * @param[in] name  Metric name, must be a string literal.
+     * @param[in] help  Metric description, must be a string literal.
+     */
+    MetricCounter(const char* name, const char* help) :
+        Metric(name, help, TYPE_COUNTER),
+        m_value(0U)
+    {
+    }
+
+    /**
+     * Destroys the counter metric.
+     */
+    ~MetricCounter()
+    {
+    }
+
+    /**
+     * Increase the counter.
+     *
+     * @param[in] value Value to add
+     */
+    void inc(uint32_t value = 1U)
+    {
+        (void)m_value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get counter value.
+     *
+     * @return Counter value
+     */
+    uint32_t get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Write the samples of the metric in Prometheus text format.
+     *
+     * @param[in] out   Output
+     */
+    void writeSamples(Print& out) const final;
+
+    /**
+     * Write the samples of the metric in StatsD format.
+     *
+     * @param[in] out       Output
+     * @param[in] prefix    Prefix of the metric name, may be nullptr.
+     */
+    void writeStatsdSamples(Print& out, const char* prefix) const final;
+
+private:
+
+    std::atomic<uint32_t>   m_value;    /**< Counter value */
+};
+
+/**
+ * Gauge metric, which value can go up and down.
+ * Optional the value is retrieved from a source function during export,
+ * which is useful for values that are cheap to read, like the free heap.
+ */
+class MetricGauge : public Metric
+{
+public:
+
+    /**
+     * Source function, which provides the gauge value.
+     */
+    typedef int32_t (*Source)(void);
+
+    /**
+     * Constructs the gauge metric.
+     *
+     * @param[in] name      Metric name, must be a string literal.
+     * @param[in] help      Metric description, must be a string literal.
+     * @param[in] source    Optional source function of the value.
+     */
+    MetricGauge(const char* name, const char* help, Source source = nullptr) :
+        Metric(name, help, TYPE_GAUGE),
+        m_value(0),
+        m_source(source)
+    {
+    }
+
+    /**
+     * Destroys the gauge metric.
+     */
+    ~MetricGauge()
+    {
+    }
+
+    /**
+     * Set gauge value.
+     *
+     * @param[in] value Value
+     */
+    void set(int32_t value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Increase the gauge value.
+     *
+     * @param[in] value Value to add
+     */
+    void inc(int32_t value = 1)
+    {
+        (void)m_value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Decrease the gauge value.
+     *
+     * @param[in] value Value to subtract
+     */
+    void dec(int32_t value = 1)
+    {
+        (void)m_value.fetch_sub(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get gauge value.
+     *
+     * @return Gauge value
+     */
+    int32_t get() const;
+
+    /**
+     * Write the samples of the metric in Prometheus text format.
+     *
+     * @param[in] out   Output
+     */
+    void writeSamples(Print& out) const final;
+
+    /**
+     * Write the samples of the metric in StatsD format.
+     *
+     * @param[in] out       Output
+     * @param[in] prefix    Prefix of the metric name, may be nullptr.
+     */
+    void writeStatsdSamples(Print& out, const char* prefix) const final;
+
+private:
+
+    std::atomic<int32_t>    m_value;    /**< Gauge value */
+    Source                  m_source;   /**< Source function of the value */
+};
+
+/**
+ * Histogram metric, which counts the observed values in buckets.
+ */
+class MetricHistogram : public Metric
+{
+public:
+
+    /** Max. number of buckets, without the +Inf bucket. */
+    static const uint8_t MAX_BUCKETS = 12U;
+
+    /**
+     * Constructs the histogram metric.
+     *
+     * @param[in] name      Metric name, must be a string literal.
+     * @param[in] help      Metric description, must be a string literal.
+     * @param[in] bounds    Upper bounds of the buckets in ascending order. The array must live as long as the metric.
+     * @param[in] count     Number of buckets, limited to MAX_BUCKETS.
+     */
+    MetricHistogram(const char* name, const char* help, const uint32_t* bounds, uint8_t count);
+
+    /**
+     * Destroys the histogram metric.
+     */
+    ~MetricHistogram()
+    {
+    }
+
+    /**
+     * Observe a value.
+     *
+     * @param[in] value Observed value
+     */
+    void observe(uint32_t value);
+
+    /**
+     * Get number of observed values.
+     *
+     * @return Number of observed values
+     */
+    uint32_t getCount() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get sum of observed values.
+     *
+     * @return Sum of observed values
+     */
+    uint32_t getSum() const
+    {
+        return m_sum.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the percentile of the observed values. Its the upper bound of the
+     * bucket, which contains it. A percentile above the last bucket is
+     * reported as upper bound of the last bucket.
+     *
+     * @param[in] percent   Percentile [1; 100]
+     *
+     * @return Percentile value. If nothing is observed, it will return 0.
+     */
+    uint32_t getPercentile(uint8_t percent) const;
+
+    /**
+     * Write the samples of the metric in Prometheus text format.
+     *
+     * @param[in] out   Output
+     */
+    void writeSamples(Print& out) const final;
+
+    /**
+     * Write the samples of the metric in StatsD format.
+     *
+     * @param[in] out       Output
+     * @param[in] prefix    Prefix of the metric name, may be nullptr.
+     */
+    void writeStatsdSamples(Print& out, const char* prefix) const final;
+
+private:
+
+    const uint32_t*         m_bounds;               /**< Upper bounds of the buckets */
+    uint8_t                 m_bucketCnt;            /**< Number of buckets */
+    std::atomic<uint32_t>   m_buckets[MAX_BUCKETS]; /**< Number of values per bucket, not cumulative */
+    std::atomic<uint32_t>   m_count;                /**< Number of observed values */
+    std::atomic<uint32_t>   m_sum;                  /**< Sum of observed values */
+};
+
+/**
+ * Metrics registry, which exports all registered metrics.
+ */
+class Metrics
+{
+public:
+
+    /**
+     * Get the metrics registry instance.
+     *
+     * @return Metrics registry
+     */
+    static Metrics& getInstance()
+    {
+        static Metrics instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Register a metric.
+     *
+     * @param[in] metric    Metric
+     */
+    void registerMetric(Metric& metric);
+
+    /**
+     * Unregister a metric.
+     *
+     * @param[in] metric    Metric
+     */
+    void unregisterMetric(Metric& metric);
+
+    /**
+     * Write all registered metrics in Prometheus text format.
+     * Nothing is allocated, every line is written directly to the output.
+     *
+     * @param[in] out   Output
+     */
+    void write(Print& out);
+
+    /**
+     * Write all registered metrics in StatsD format, see Metric::writeStatsdSamples().
+     * Nothing is allocated, every line is written with a single write to
+     * the output.
+     *
+     * @param[in] out       Output
+     * @param[in] prefix    Prefix of the metric names, e.g. the hostname. May be nullptr.
+     */
+    void writeStatsd(Print& out, const char* prefix);
+
+    /**
+     * Get number of registered metrics.
+     *
+     * @return Number of registered metrics
+     */
+    uint32_t getNumOfMetrics();
+
+private:
+
+    Metric*             m_head;     /**< First registered metric */
+
+#ifndef NATIVE
+    SemaphoreHandle_t   m_xMutex;   /**< Mutex to protect the registry. */
+#endif  /* NATIVE */
+
+    /**
+     * Constructs the metrics registry.
+     */
+    Metrics() :
+        m_head(nullptr)
+#ifndef NATIVE
+        ,
+        m_xMutex(xSemaphoreCreateMutex())
+#endif  /* NATIVE */
+    {
+    }
+
+    /**
+     * Destroys the metrics registry.
+     */
+    ~Metrics();
+
+    Metrics(const Metrics& metrics);
+    Metrics& operator=(const Metrics& metrics);
+
+    /**
+     * Lock the registry.
+     */
+    void lock();
+
+    /**
+     * Unlock the registry.
+     */
+    void unlock();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __METRICS_H__ */
+
+/** @} */
\ No newline at end of file
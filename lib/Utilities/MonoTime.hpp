@@ -0,0 +1,119 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Monotonic time base
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __MONOTIME_HPP__
+#define __MONOTIME_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+#ifndef NATIVE
+#include <esp_timer.h>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The monotonic time base is shared by the timers, the display task and the
+ * slot scheduling. It counts in microseconds since the start with 64 bit,
+ * which doesn't wrap around during the lifetime of a device.
+ *
+ * Timestamps in ms with 32 bit, like provided by millis(), wrap around after
+ * about 49 days. Their differences are still valid for durations below
+ * about 24 days, which is sufficient for the most timers. Use the 64-bit
+ * timestamps for anything, which may last longer, or which needs a resolution
+ * below 1 ms.
+ */
+namespace MonoTime
+{
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get the time since start.
+ *
+ * @return Time in us
+ */
+inline uint64_t getMicros()
+{
+#ifndef NATIVE
+    return static_cast<uint64_t>(esp_timer_get_time());
+#else   /* NATIVE */
+    /* Derived from the native clock, which may be fixed by the tests. */
+    return static_cast<uint64_t>(millis()) * 1000U;
+#endif  /* NATIVE */
+}
+
+/**
+ * Get the time since start.
+ *
+ * @return Time in ms
+ */
+inline uint64_t getMillis64()
+{
+    return getMicros() / 1000U;
+}
+
+/**
+ * Get the time since start, compatible to millis(). It wraps around after
+ * about 49 days, therefore only the difference of two timestamps is valid.
+ *
+ * @return Time in ms
+ */
+inline uint32_t getMillis()
+{
+    return static_cast<uint32_t>(getMillis64());
+}
+
+}
+
+#endif  /* __MONOTIME_HPP__ */
+
+/** @} */
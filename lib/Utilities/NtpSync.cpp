@@ -0,0 +1,282 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  NTP synchronization
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "NtpSync.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeTimestamp(uint8_t* buffer, uint64_t time);
+static uint64_t readTimestamp(const uint8_t* buffer);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Seconds from the NTP era (1900-01-01) to the unix epoch (1970-01-01). */
+static const uint64_t   NTP_UNIX_OFFSET         = 2208988800ULL;
+
+/** Microseconds per second */
+static const uint64_t   US_PER_S                = 1000000ULL;
+
+/** Leap indicator 0, version 4 and client mode */
+static const uint8_t    NTP_CLIENT_HEADER       = 0x23U;
+
+/** Server mode */
+static const uint8_t    NTP_MODE_SERVER         = 4U;
+
+/** Mask of the mode in the first byte */
+static const uint8_t    NTP_MODE_MASK           = 0x07U;
+
+/** Leap indicator "clock not synchronized" */
+static const uint8_t    NTP_LI_ALARM            = 0xC0U;
+
+/** Offset of the stratum */
+static const size_t     NTP_STRATUM_OFFSET      = 1U;
+
+/** Offset of the origin timestamp */
+static const size_t     NTP_ORIGIN_OFFSET       = 24U;
+
+/** Offset of the receive timestamp */
+static const size_t     NTP_RECEIVE_OFFSET      = 32U;
+
+/** Offset of the transmit timestamp */
+static const size_t     NTP_TRANSMIT_OFFSET     = 40U;
+
+/** NTP timestamp size in byte */
+static const size_t     NTP_TIMESTAMP_SIZE      = 8U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void NtpSync::reset()
+{
+    m_offset            = 0;
+    m_delay             = 0;
+    m_jitter            = 0U;
+    m_pollInterval      = MIN_POLL_INTERVAL;
+    m_stableSamples     = 0U;
+    m_isSynchronized    = false;
+
+    return;
+}
+
+size_t NtpSync::writeRequest(uint8_t* buffer, size_t size, uint64_t transmitTime)
+{
+    size_t written = 0U;
+
+    if ((nullptr != buffer) &&
+        (PACKET_SIZE <= size))
+    {
+        memset(buffer, 0, PACKET_SIZE);
+
+        buffer[0] = NTP_CLIENT_HEADER;
+
+        /* The server returns the transmit timestamp as origin timestamp,
+         * which identifies the response.
+         */
+        writeTimestamp(&buffer[NTP_TRANSMIT_OFFSET], transmitTime);
+
+        written = PACKET_SIZE;
+    }
+
+    return written;
+}
+
+bool NtpSync::readResponse(const uint8_t* buffer, size_t size, uint64_t originTime, uint64_t& receiveTime, uint64_t& transmitTime)
+{
+    bool isValid = false;
+
+    if ((nullptr != buffer) &&
+        (PACKET_SIZE <= size))
+    {
+        uint8_t origin[NTP_TIMESTAMP_SIZE];
+
+        writeTimestamp(origin, originTime);
+
+        /* A kiss-o'-death (stratum 0) and a not synchronized server are
+         * rejected as well as responses to other requests.
+         */
+        if ((NTP_MODE_SERVER == (buffer[0] & NTP_MODE_MASK)) &&
+            (NTP_LI_ALARM != (buffer[0] & NTP_LI_ALARM)) &&
+            (0U != buffer[NTP_STRATUM_OFFSET]) &&
+            (0 == memcmp(origin, &buffer[NTP_ORIGIN_OFFSET], NTP_TIMESTAMP_SIZE)))
+        {
+            receiveTime     = readTimestamp(&buffer[NTP_RECEIVE_OFFSET]);
+            transmitTime    = readTimestamp(&buffer[NTP_TRANSMIT_OFFSET]);
+            isValid         = true;
+        }
+    }
+
+    return isValid;
+}
+
+NtpSync::Correction NtpSync::addSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4)
+{
+    Correction      correction  = CORRECTION_NONE;
+    const int64_t   ROUND_TRIP  = static_cast<int64_t>(t4 - t1);
+    const int64_t   PROCESSING  = static_cast<int64_t>(t3 - t2);
+    const int64_t   DELAY       = (ROUND_TRIP - PROCESSING) / 2;
+
+    /* A negative delay means the timestamps are not from the same exchange. */
+    if ((0 <= DELAY) &&
+        (0 <= PROCESSING))
+    {
+        const int64_t   OFFSET      = (static_cast<int64_t>(t2 - t1) + static_cast<int64_t>(t3 - t4)) / 2;
+        const int64_t   ABS_OFFSET  = (0 > OFFSET) ? -OFFSET : OFFSET;
+
+        if ((false == m_isSynchronized) ||
+            (STEP_THRESHOLD <= ABS_OFFSET))
+        {
+            correction      = CORRECTION_STEP;
+            m_jitter        = 0U;
+            m_pollInterval  = MIN_POLL_INTERVAL;
+            m_stableSamples = 0U;
+        }
+        else
+        {
+            const int64_t   CHANGE      = OFFSET - m_offset;
+            const uint32_t  ABS_CHANGE  = static_cast<uint32_t>((0 > CHANGE) ? -CHANGE : CHANGE);
+
+            if (0 != OFFSET)
+            {
+                correction = CORRECTION_SLEW;
+            }
+
+            m_jitter += (static_cast<int32_t>(ABS_CHANGE - m_jitter)) >> JITTER_SHIFT;
+
+            /* A stable clock is polled less frequently, a unstable clock more. */
+            if (STABLE_THRESHOLD > ABS_OFFSET)
+            {
+                ++m_stableSamples;
+
+                if ((STABLE_SAMPLES <= m_stableSamples) &&
+                    (MAX_POLL_INTERVAL > m_pollInterval))
+                {
+                    m_pollInterval  *= 2U;
+                    m_stableSamples = 0U;
+                }
+            }
+            else
+            {
+                m_stableSamples = 0U;
+
+                if (MIN_POLL_INTERVAL < m_pollInterval)
+                {
+                    m_pollInterval /= 2U;
+                }
+            }
+        }
+
+        m_offset            = OFFSET;
+        m_delay             = DELAY;
+        m_isSynchronized    = true;
+    }
+
+    return correction;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a unix timestamp as NTP timestamp (big endian).
+ *
+ * @param[out]  buffer  Buffer with at least 8 byte
+ * @param[in]   time    Unix timestamp in us
+ */
+static void writeTimestamp(uint8_t* buffer, uint64_t time)
+{
+    uint64_t    seconds     = (time / US_PER_S) + NTP_UNIX_OFFSET;
+    uint64_t    fraction    = ((time % US_PER_S) << 32U) / US_PER_S;
+    uint64_t    ntpTime     = (seconds << 32U) | (fraction & 0xFFFFFFFFULL);
+    size_t      index       = 0U;
+
+    for(index = 0U; index < NTP_TIMESTAMP_SIZE; ++index)
+    {
+        buffer[index] = static_cast<uint8_t>(ntpTime >> (8U * (NTP_TIMESTAMP_SIZE - 1U - index)));
+    }
+
+    return;
+}
+
+/**
+ * Read a NTP timestamp (big endian) as unix timestamp.
+ *
+ * @param[in] buffer    Buffer with at least 8 byte
+ *
+ * @return Unix timestamp in us
+ */
+static uint64_t readTimestamp(const uint8_t* buffer)
+{
+    uint64_t    ntpTime = 0U;
+    size_t      index   = 0U;
+
+    for(index = 0U; index < NTP_TIMESTAMP_SIZE; ++index)
+    {
+        ntpTime = (ntpTime << 8U) | buffer[index];
+    }
+
+    return (((ntpTime >> 32U) - NTP_UNIX_OFFSET) * US_PER_S) +
+           (((ntpTime & 0xFFFFFFFFULL) * US_PER_S) >> 32U);
+}
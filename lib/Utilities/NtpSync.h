@@ -0,0 +1,237 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  NTP synchronization
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __NTPSYNC_H__
+#define __NTPSYNC_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The NTP synchronization handles the client side of the NTP protocol and
+ * decides how the local clock is corrected. It is fed with the timestamps
+ * of a request-response exchange:
+ * - t1: Request sent (local clock).
+ * - t2: Request received by the server (server clock).
+ * - t3: Response sent by the server (server clock).
+ * - t4: Response received (local clock).
+ *
+ * All timestamps are unix timestamps in us. The first and any large
+ * correction is stepped, all others are slewed, so the time never jumps
+ * during normal operation.
+ *
+ * The poll interval adapts to the measured offset: as long as the clock
+ * stays within the stable threshold, the interval is doubled after some
+ * samples, otherwise it is shortened.
+ */
+class NtpSync
+{
+public:
+
+    /**
+     * Correction of the local clock.
+     */
+    enum Correction
+    {
+        CORRECTION_NONE = 0,    /**< No correction */
+        CORRECTION_SLEW,        /**< Slew the clock by the offset */
+        CORRECTION_STEP         /**< Step the clock by the offset */
+    };
+
+    /** NTP packet size in byte */
+    static const size_t     PACKET_SIZE         = 48U;
+
+    /** NTP server port */
+    static const uint16_t   PORT                = 123U;
+
+    /** Min. poll interval in s */
+    static const uint32_t   MIN_POLL_INTERVAL   = 64U;
+
+    /** Max. poll interval in s */
+    static const uint32_t   MAX_POLL_INTERVAL   = 4096U;
+
+    /** Above this offset in us the clock is stepped, otherwise it is slewed. */
+    static const int64_t    STEP_THRESHOLD      = 2000000;
+
+    /** Below this offset in us the clock is stable. */
+    static const int64_t    STABLE_THRESHOLD    = 20000;
+
+    /** Number of stable samples in a row, till the poll interval is doubled. */
+    static const uint8_t    STABLE_SAMPLES      = 4U;
+
+    /**
+     * Constructs a not synchronized NTP synchronization.
+     */
+    NtpSync()
+    {
+        reset();
+    }
+
+    /**
+     * Destroys the NTP synchronization.
+     */
+    ~NtpSync()
+    {
+    }
+
+    /**
+     * Forget all samples. The clock is not synchronized afterwards.
+     */
+    void reset();
+
+    /**
+     * Write a NTP client request.
+     *
+     * @param[out]  buffer          Buffer with at least PACKET_SIZE byte
+     * @param[in]   size            Buffer size in byte
+     * @param[in]   transmitTime    Local time of sending (t1) in us
+     *
+     * @return Number of written bytes. If the buffer is too small, it will return 0.
+     */
+    static size_t writeRequest(uint8_t* buffer, size_t size, uint64_t transmitTime);
+
+    /**
+     * Read a NTP server response to the request, which was sent at the
+     * given time.
+     *
+     * @param[in]   buffer          Received packet
+     * @param[in]   size            Packet size in byte
+     * @param[in]   originTime      Local time of sending the request (t1) in us
+     * @param[out]  receiveTime     Server time of receiving the request (t2) in us
+     * @param[out]  transmitTime    Server time of sending the response (t3) in us
+     *
+     * @return If it is a valid response to the request, it will return true otherwise false.
+     */
+    static bool readResponse(const uint8_t* buffer, size_t size, uint64_t originTime, uint64_t& receiveTime, uint64_t& transmitTime);
+
+    /**
+     * Add the timestamps of a request-response exchange.
+     *
+     * @param[in] t1    Request sent in us (local clock)
+     * @param[in] t2    Request received in us (server clock)
+     * @param[in] t3    Response sent in us (server clock)
+     * @param[in] t4    Response received in us (local clock)
+     *
+     * @return Correction of the local clock by the offset.
+     */
+    Correction addSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
+
+    /**
+     * Is the clock synchronized?
+     *
+     * @return If synchronized, it will return true otherwise false.
+     */
+    bool isSynchronized() const
+    {
+        return m_isSynchronized;
+    }
+
+    /**
+     * Get the offset of the server clock to the local clock of the last
+     * sample.
+     *
+     * @return Offset in us
+     */
+    int64_t getOffset() const
+    {
+        return m_offset;
+    }
+
+    /**
+     * Get the one way delay of the last sample.
+     *
+     * @return Delay in us
+     */
+    int64_t getDelay() const
+    {
+        return m_delay;
+    }
+
+    /**
+     * Get the jitter, which is the smoothed offset change between two
+     * samples.
+     *
+     * @return Jitter in us
+     */
+    uint32_t getJitter() const
+    {
+        return m_jitter;
+    }
+
+    /**
+     * Get the current poll interval.
+     *
+     * @return Poll interval in s
+     */
+    uint32_t getPollInterval() const
+    {
+        return m_pollInterval;
+    }
+
+private:
+
+    /** Weight of the latest offset change in the jitter, as right shift. */
+    static const uint8_t    JITTER_SHIFT        = 2U;
+
+    int64_t     m_offset;           /**< Offset of the last sample in us */
+    int64_t     m_delay;            /**< One way delay of the last sample in us */
+    uint32_t    m_jitter;           /**< Jitter in us */
+    uint32_t    m_pollInterval;     /**< Poll interval in s */
+    uint8_t     m_stableSamples;    /**< Number of stable samples in a row */
+    bool        m_isSynchronized;   /**< Is clock synchronized? */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __NTPSYNC_H__ */
+
+/** @} */
@@ -0,0 +1,214 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profile statistics
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ProfileStat.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void ProfileStat::clear()
+{
+    uint8_t bucket = 0U;
+
+    m_count = 0U;
+    m_min   = UINT32_MAX;
+    m_max   = 0U;
+    m_sum   = 0U;
+
+    for(bucket = 0U; bucket < BUCKET_NUM; ++bucket)
+    {
+        m_histogram[bucket] = 0U;
+    }
+
+    m_summary.count     = 0U;
+    m_summary.min       = 0U;
+    m_summary.avg       = 0U;
+    m_summary.max       = 0U;
+    m_summary.p99       = 0U;
+    m_isSummaryValid    = false;
+
+    return;
+}
+
+void ProfileStat::addSample(uint32_t value)
+{
+    if (m_min > value)
+    {
+        m_min = value;
+    }
+
+    if (m_max < value)
+    {
+        m_max = value;
+    }
+
+    m_sum += value;
+    ++m_histogram[getBucket(value)];
+    ++m_count;
+
+    /* Window complete? */
+    if (WINDOW_SIZE <= m_count)
+    {
+        uint8_t bucket = 0U;
+
+        calcSummary(m_summary);
+        m_isSummaryValid = true;
+
+        /* Start next window */
+        m_count = 0U;
+        m_min   = UINT32_MAX;
+        m_max   = 0U;
+        m_sum   = 0U;
+
+        for(bucket = 0U; bucket < BUCKET_NUM; ++bucket)
+        {
+            m_histogram[bucket] = 0U;
+        }
+    }
+
+    return;
+}
+
+void ProfileStat::getSummary(Summary& summary) const
+{
+    if (true == m_isSummaryValid)
+    {
+        summary = m_summary;
+    }
+    else
+    {
+        calcSummary(summary);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void ProfileStat::calcSummary(Summary& summary) const
+{
+    summary.count = m_count;
+
+    if (0U == m_count)
+    {
+        summary.min = 0U;
+        summary.avg = 0U;
+        summary.max = 0U;
+        summary.p99 = 0U;
+    }
+    else
+    {
+        /* Number of samples, which are allowed above the 99th percentile. */
+        const uint32_t  TAIL_COUNT  = m_count / 100U;
+        uint32_t        count       = 0U;
+        uint8_t         bucket      = BUCKET_NUM;
+
+        /* Walk from the highest bucket down, until the bucket is found
+         * which contains the 99th percentile.
+         */
+        while((0U < bucket) && (TAIL_COUNT >= count))
+        {
+            --bucket;
+            count += m_histogram[bucket];
+        }
+
+        summary.min = m_min;
+        summary.avg = static_cast<uint32_t>(m_sum / m_count);
+        summary.max = m_max;
+
+        /* Upper bound of the bucket, but never above the max. value. */
+        if ((BUCKET_NUM - 1U) <= bucket)
+        {
+            summary.p99 = UINT32_MAX;
+        }
+        else
+        {
+            summary.p99 = (1UL << bucket) - 1U;
+        }
+
+        if (m_max < summary.p99)
+        {
+            summary.p99 = m_max;
+        }
+    }
+
+    return;
+}
+
+uint8_t ProfileStat::getBucket(uint32_t value)
+{
+    uint8_t bucket = 0U;
+
+    if (0U != value)
+    {
+        bucket = 32U - static_cast<uint8_t>(__builtin_clz(value));
+    }
+
+    return bucket;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
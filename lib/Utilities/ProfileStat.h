@@ -0,0 +1,160 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profile statistics
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __PROFILESTAT_H__
+#define __PROFILESTAT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Rolling statistics about measured durations, e.g. in CPU cycles.
+ *
+ * The samples are collected in a window of WINDOW_SIZE samples. After a window
+ * is complete, its min., avg., max. and 99th percentile are taken over as
+ * summary and the next window starts. The percentile is determined by a
+ * logarithmic histogram, which means it is the upper bound of the histogram
+ * bucket (a power of two) and limited by the max. value.
+ */
+class ProfileStat
+{
+public:
+
+    /** Summary of a sample window. */
+    struct Summary
+    {
+        uint32_t    count;  /**< Number of samples */
+        uint32_t    min;    /**< Min. value */
+        uint32_t    avg;    /**< Average value */
+        uint32_t    max;    /**< Max. value */
+        uint32_t    p99;    /**< 99th percentile */
+    };
+
+    /** Number of samples in a window. */
+    static const uint16_t   WINDOW_SIZE = 256U;
+
+    /**
+     * Constructs empty profile statistics.
+     */
+    ProfileStat() :
+        m_count(0U),
+        m_min(UINT32_MAX),
+        m_max(0U),
+        m_sum(0U),
+        m_histogram(),
+        m_summary(),
+        m_isSummaryValid(false)
+    {
+        clear();
+    }
+
+    /**
+     * Destroys the profile statistics.
+     */
+    ~ProfileStat()
+    {
+    }
+
+    /**
+     * Remove all samples and the summary.
+     */
+    void clear();
+
+    /**
+     * Add a sample.
+     *
+     * @param[in] value Measured value
+     */
+    void addSample(uint32_t value);
+
+    /**
+     * Get summary of the last complete window. As long as no window is
+     * complete, the summary of the current window is provided.
+     *
+     * @param[out] summary  Summary
+     */
+    void getSummary(Summary& summary) const;
+
+private:
+
+    /** Number of histogram buckets. Bucket n contains the values with n significant bits. */
+    static const uint8_t    BUCKET_NUM  = 33U;
+
+    uint16_t    m_count;                    /**< Number of samples in the current window */
+    uint32_t    m_min;                      /**< Min. value in the current window */
+    uint32_t    m_max;                      /**< Max. value in the current window */
+    uint64_t    m_sum;                      /**< Sum of all values in the current window */
+    uint16_t    m_histogram[BUCKET_NUM];    /**< Histogram of the current window */
+    Summary     m_summary;                  /**< Summary of the last complete window */
+    bool        m_isSummaryValid;           /**< Is the summary of the last complete window valid? */
+
+    /**
+     * Calculate the summary of the current window.
+     *
+     * @param[out] summary  Summary
+     */
+    void calcSummary(Summary& summary) const;
+
+    /**
+     * Get histogram bucket index of a value.
+     *
+     * @param[in] value Value
+     *
+     * @return Bucket index
+     */
+    static uint8_t getBucket(uint32_t value);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PROFILESTAT_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,195 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Simple event timer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SIMPLEEVENTTIMER_HPP__
+#define __SIMPLEEVENTTIMER_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "EventTimer.hpp"
+#include "Util.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The simple event timer has the interface of the simple timer, but is
+ * managed by the timer service. It allows to migrate a polling user of the
+ * simple timer step by step to event timers.
+ *
+ * The timeout is detected by polling or by the timer service, whatever comes
+ * first. Like the simple timer, it keeps running after the timeout, until it
+ * is stopped or restarted.
+ */
+class SimpleEventTimer : private ITimerListener
+{
+public:
+
+    /**
+     * Constructs a stopped simple event timer.
+     */
+    SimpleEventTimer() :
+        ITimerListener(),
+        m_timer(*this),
+        m_isRunning(false),
+        m_isTimeout(false)
+    {
+    }
+
+    /**
+     * Destroys the simple event timer.
+     */
+    ~SimpleEventTimer()
+    {
+    }
+
+    /**
+     * Start timer with the given duration.
+     *
+     * @param[in] duration  Duration in ms
+     */
+    void start(uint32_t duration)
+    {
+        m_isRunning = true;
+        m_isTimeout = false;
+        m_timer.start(duration);
+
+        return;
+    }
+
+    /**
+     * Stop timer.
+     */
+    void stop()
+    {
+        m_isRunning = false;
+        m_isTimeout = false;
+        m_timer.stop();
+
+        return;
+    }
+
+    /**
+     * Restart timer with the previous specified duration.
+     */
+    void restart()
+    {
+        m_isRunning = true;
+        m_isTimeout = false;
+        m_timer.restart();
+
+        return;
+    }
+
+    /**
+     * Is timer running?
+     *
+     * @return If timer is running, it will return true otherwise false.
+     */
+    bool isTimerRunning() const
+    {
+        return m_isRunning;
+    }
+
+    /**
+     * Is timeout?
+     * If timer is not running, it will always return false.
+     *
+     * @return If timeout it will return true, otherwise false.
+     */
+    bool isTimeout()
+    {
+        if ((true == m_isRunning) &&
+            (false == m_isTimeout) &&
+            (0U == m_timer.getRemaining()))
+        {
+            m_isTimeout = true;
+        }
+
+        return (true == m_isRunning) ? m_isTimeout : false;
+    }
+
+    /**
+     * Get the remaining time until timeout.
+     * If timer is not running or timeout already happened, it will return 0.
+     *
+     * @return Remaining time in ms
+     */
+    uint32_t getRemaining() const
+    {
+        return m_timer.getRemaining();
+    }
+
+private:
+
+    EventTimer      m_timer;        /**< Event timer, managed by the timer service. */
+    volatile bool   m_isRunning;    /**< Timer is running or not. */
+    volatile bool   m_isTimeout;    /**< Timeout happened or not. */
+
+    /* Prevent copying */
+    SimpleEventTimer(const SimpleEventTimer& timer);
+    SimpleEventTimer& operator=(const SimpleEventTimer& timer);
+
+    /**
+     * Will be called by the timer service, if the event timer timed out.
+     *
+     * @param[in] timer Event timer, which timed out
+     */
+    void onTimeout(EventTimer& timer) final
+    {
+        UTIL_NOT_USED(timer);
+
+        m_isTimeout = true;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SIMPLEEVENTTIMER_HPP__ */
+
+/** @} */
@@ -44,7 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
-#include <Arduino.h>
+#include <MonoTime.hpp>
 
 /******************************************************************************
  * Macros
@@ -55,7 +55,8 @@
  *****************************************************************************/
 
 /**
- * Simple timer, based on millis().
+ * Simple timer, based on the 64-bit monotonic time base. Therefore it
+ * doesn't wrap around, even if the device runs for months.
  */
 class SimpleTimer
 {
@@ -117,7 +118,7 @@ public:
         m_isRunning = true;
         m_isTimeout = false;
         m_duration  = duration;
-        m_start     = millis();
+        m_start     = MonoTime::getMillis64();
 
         return;
     }
@@ -140,7 +141,7 @@ public:
     {
         m_isRunning = true;
         m_isTimeout = false;
-        m_start     = millis();
+        m_start     = MonoTime::getMillis64();
 
         return;
     }
@@ -169,7 +170,7 @@ public:
         {            
             if (false == m_isTimeout)
             {
-                uint32_t delta = millis() - m_start;
+                uint64_t delta = MonoTime::getMillis64() - m_start;
 
                 if (m_duration <= delta)
                 {
@@ -183,12 +184,36 @@ public:
         return isTimeout;
     }
 
+    /**
+     * Get the remaining time until timeout.
+     * If timer is not running or timeout already happened, it will return 0.
+     * 
+     * @return Remaining time in ms
+     */
+    uint32_t getRemaining() const
+    {
+        uint32_t remaining = 0U;
+
+        if ((true == m_isRunning) &&
+            (false == m_isTimeout))
+        {
+            uint64_t delta = MonoTime::getMillis64() - m_start;
+
+            if (m_duration > delta)
+            {
+                remaining = m_duration - static_cast<uint32_t>(delta);
+            }
+        }
+
+        return remaining;
+    }
+
 private:
 
     bool        m_isRunning;    /**< Timer is running or not. */
     bool        m_isTimeout;    /**< Timer timeout active or not. */
     uint32_t    m_duration;     /**< Duration in ms */
-    uint32_t    m_start;        /**< Timestamp at start time */
+    uint64_t    m_start;        /**< Timestamp in ms at start time */
 };
 
 /******************************************************************************
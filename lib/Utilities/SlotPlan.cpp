@@ -0,0 +1,152 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Slot rotation plan
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SlotPlan.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void SlotPlan::build(const uint8_t* weights, uint8_t num)
+{
+    int16_t current[MAX_SLOTS];
+    uint8_t limited[MAX_SLOTS];
+    int16_t total   = 0;
+    uint8_t slotId  = 0U;
+
+    m_length = 0U;
+
+    if (nullptr != weights)
+    {
+        if (MAX_SLOTS < num)
+        {
+            num = MAX_SLOTS;
+        }
+
+        for(slotId = 0U; slotId < num; ++slotId)
+        {
+            limited[slotId] = weights[slotId];
+
+            if (MAX_WEIGHT < limited[slotId])
+            {
+                limited[slotId] = MAX_WEIGHT;
+            }
+
+            current[slotId] = 0;
+            total += limited[slotId];
+        }
+
+        /* In every step the slot with the highest current weight is chosen,
+         * which spreads the appearances of a slot evenly.
+         */
+        while(total > m_length)
+        {
+            uint8_t selected = 0U;
+
+            for(slotId = 0U; slotId < num; ++slotId)
+            {
+                current[slotId] += limited[slotId];
+
+                if (current[selected] < current[slotId])
+                {
+                    selected = slotId;
+                }
+            }
+
+            current[selected] -= total;
+
+            m_plan[m_length] = selected;
+            ++m_length;
+        }
+    }
+
+    return;
+}
+
+bool SlotPlan::isInTimeWindow(uint16_t begin, uint16_t end, uint16_t minuteOfDay)
+{
+    bool isInside = false;
+
+    if (begin == end)
+    {
+        isInside = true;
+    }
+    else if (begin < end)
+    {
+        isInside = (begin <= minuteOfDay) && (end > minuteOfDay);
+    }
+    else
+    {
+        isInside = (begin <= minuteOfDay) || (end > minuteOfDay);
+    }
+
+    return isInside;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
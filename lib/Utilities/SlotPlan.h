@@ -0,0 +1,166 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Slot rotation plan
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SLOTPLAN_H__
+#define __SLOTPLAN_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The slot rotation plan is a precomputed sequence of slot ids. Every slot
+ * appears in it according to its weight and the appearances are spread
+ * evenly over the sequence (smooth weighted round robin). With all weights
+ * equal to 1, it is the plain round robin sequence.
+ *
+ * The plan is only built again if a weight changes. Whether a slot in the
+ * plan can be shown at all (plugin installed, time window, etc.) is decided
+ * by the user of the plan.
+ */
+class SlotPlan
+{
+public:
+
+    /** Max. number of slots */
+    static const uint8_t    MAX_SLOTS       = 16U;
+
+    /** Max. slot weight */
+    static const uint8_t    MAX_WEIGHT      = 4U;
+
+    /** Default slot weight */
+    static const uint8_t    DEFAULT_WEIGHT  = 1U;
+
+    /** Max. plan length */
+    static const uint8_t    MAX_LENGTH      = MAX_SLOTS * MAX_WEIGHT;
+
+    /** Number of minutes per day */
+    static const uint16_t   MINUTES_PER_DAY = 24U * 60U;
+
+    /**
+     * Constructs a empty plan.
+     */
+    SlotPlan() :
+        m_plan(),
+        m_length(0U)
+    {
+    }
+
+    /**
+     * Destroys the plan.
+     */
+    ~SlotPlan()
+    {
+    }
+
+    /**
+     * Build the plan from the slot weights. A slot with weight 0 won't
+     * be part of the plan. Weights greater than MAX_WEIGHT are limited.
+     *
+     * @param[in] weights   Weight of every slot, the index is the slot id.
+     * @param[in] num       Number of slots
+     */
+    void build(const uint8_t* weights, uint8_t num);
+
+    /**
+     * Get plan length.
+     *
+     * @return Number of entries in the plan
+     */
+    uint8_t getLength() const
+    {
+        return m_length;
+    }
+
+    /**
+     * Get the slot id of a plan entry.
+     *
+     * @param[in] index Plan index [0; getLength() - 1]
+     *
+     * @return Slot id. If the index is invalid, it will return MAX_SLOTS.
+     */
+    uint8_t getSlotId(uint8_t index) const
+    {
+        uint8_t slotId = MAX_SLOTS;
+
+        if (m_length > index)
+        {
+            slotId = m_plan[index];
+        }
+
+        return slotId;
+    }
+
+    /**
+     * Is the minute of the day inside the time window [begin; end)?
+     * The window may wrap around midnight. If begin and end are equal,
+     * the window covers the whole day.
+     *
+     * @param[in] begin         Window begin in minutes of the day
+     * @param[in] end           Window end in minutes of the day
+     * @param[in] minuteOfDay   Minute of the day
+     *
+     * @return If inside, it will return true otherwise false.
+     */
+    static bool isInTimeWindow(uint16_t begin, uint16_t end, uint16_t minuteOfDay);
+
+private:
+
+    uint8_t m_plan[MAX_LENGTH]; /**< Slot ids in rotation order */
+    uint8_t m_length;           /**< Number of entries in the plan */
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SLOTPLAN_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,234 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Slot record
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SlotRecord.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeUInt16(uint8_t* buffer, uint16_t value);
+static void writeUInt32(uint8_t* buffer, uint32_t value);
+static uint16_t readUInt16(const uint8_t* buffer);
+static uint32_t readUInt32(const uint8_t* buffer);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t SlotRecord::encode(const SlotRecord* records, uint8_t num, uint8_t* buffer, size_t size)
+{
+    size_t  written = 0U;
+    uint8_t index   = 0U;
+
+    if ((nullptr != buffer) &&
+        (getSize(num) <= size) &&
+        ((nullptr != records) || (0U == num)))
+    {
+        uint8_t* record = &buffer[HEADER_SIZE];
+
+        buffer[0] = MAGIC;
+        buffer[1] = VERSION;
+        buffer[2] = static_cast<uint8_t>(RECORD_SIZE);
+        buffer[3] = num;
+
+        for(index = 0U; index < num; ++index)
+        {
+            record[0] = records[index].slotId;
+            writeUInt16(&record[1], records[index].typeId);
+            writeUInt16(&record[3], records[index].uid);
+            writeUInt32(&record[5], records[index].duration);
+            record[9] = 0U;
+
+            if (true == records[index].isLocked)
+            {
+                record[9] |= FLAG_LOCKED;
+            }
+
+            record[10] = records[index].weight;
+            writeUInt16(&record[11], records[index].timeBegin);
+            writeUInt16(&record[13], records[index].timeEnd);
+
+            record += RECORD_SIZE;
+        }
+
+        written = getSize(num);
+    }
+
+    return written;
+}
+
+bool SlotRecord::decode(const uint8_t* buffer, size_t size, SlotRecord* records, uint8_t max, uint8_t& num)
+{
+    bool    isValid = false;
+    uint8_t index   = 0U;
+
+    num = 0U;
+
+    if ((nullptr != buffer) &&
+        (nullptr != records) &&
+        (HEADER_SIZE <= size) &&
+        (MAGIC == buffer[0]) &&
+        (0U < buffer[1]) &&
+        (RECORD_SIZE_V1 <= buffer[2]))
+    {
+        const size_t    STORED_RECORD_SIZE  = buffer[2];
+        const uint8_t   STORED_NUM          = buffer[3];
+
+        if ((HEADER_SIZE + (STORED_NUM * STORED_RECORD_SIZE)) <= size)
+        {
+            const uint8_t* record = &buffer[HEADER_SIZE];
+
+            for(index = 0U; (index < STORED_NUM) && (index < max); ++index)
+            {
+                records[index].slotId   = record[0];
+                records[index].typeId   = readUInt16(&record[1]);
+                records[index].uid      = readUInt16(&record[3]);
+                records[index].duration = readUInt32(&record[5]);
+                records[index].isLocked = (0U != (record[9] & FLAG_LOCKED));
+
+                if (RECORD_SIZE <= STORED_RECORD_SIZE)
+                {
+                    records[index].weight       = record[10];
+                    records[index].timeBegin    = readUInt16(&record[11]);
+                    records[index].timeEnd      = readUInt16(&record[13]);
+                }
+                else
+                {
+                    records[index].weight       = 1U;
+                    records[index].timeBegin    = 0U;
+                    records[index].timeEnd      = 0U;
+                }
+
+                record += STORED_RECORD_SIZE;
+            }
+
+            num     = index;
+            isValid = true;
+        }
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a 16-bit value in little endian order.
+ *
+ * @param[out]  buffer  Buffer
+ * @param[in]   value   Value
+ */
+static void writeUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 0U);
+    buffer[1] = static_cast<uint8_t>(value >> 8U);
+
+    return;
+}
+
+/**
+ * Write a 32-bit value in little endian order.
+ *
+ * @param[out]  buffer  Buffer
+ * @param[in]   value   Value
+ */
+static void writeUInt32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 0U);
+    buffer[1] = static_cast<uint8_t>(value >> 8U);
+    buffer[2] = static_cast<uint8_t>(value >> 16U);
+    buffer[3] = static_cast<uint8_t>(value >> 24U);
+
+    return;
+}
+
+/**
+ * Read a 16-bit value in little endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint16_t readUInt16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0]) |
+           (static_cast<uint16_t>(buffer[1]) << 8U);
+}
+
+/**
+ * Read a 32-bit value in little endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint32_t readUInt32(const uint8_t* buffer)
+{
+    return (static_cast<uint32_t>(buffer[0]) << 0U) |
+           (static_cast<uint32_t>(buffer[1]) << 8U) |
+           (static_cast<uint32_t>(buffer[2]) << 16U) |
+           (static_cast<uint32_t>(buffer[3]) << 24U);
+}
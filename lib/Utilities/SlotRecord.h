@@ -0,0 +1,216 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Slot record
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SLOTRECORD_H__
+#define __SLOTRECORD_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Persistent record of a single display slot, which contains the installed
+ * plugin and the slot configuration.
+ *
+ * A set of records is stored in a compact and versioned binary format
+ * (little endian):
+ * - Header: magic (1 byte), version (1 byte), record size (1 byte), number of records (1 byte)
+ * - Record: slot id (1 byte), plugin type id (2 byte), plugin UID (2 byte), duration in ms (4 byte), flags (1 byte),
+ *   weight (1 byte), time window begin and end in minutes of the day (2 byte each)
+ *
+ * Version 1 records end after the flags. The missing fields get their defaults.
+ *
+ * Because the record size is part of the header, a later version may append
+ * fields to a record, which are skipped by this decoder.
+ */
+class SlotRecord
+{
+public:
+
+    /** Format identification */
+    static const uint8_t    MAGIC           = 0xA5U;
+
+    /** Current format version */
+    static const uint8_t    VERSION         = 2U;
+
+    /** Header size in byte */
+    static const size_t     HEADER_SIZE     = 4U;
+
+    /** Record size in byte of the current format version */
+    static const size_t     RECORD_SIZE     = 15U;
+
+    /** Record size in byte of format version 1 */
+    static const size_t     RECORD_SIZE_V1  = 10U;
+
+    /** Plugin type id of a empty slot */
+    static const uint16_t   TYPE_ID_NONE    = 0U;
+
+    /** Flag: Slot is locked */
+    static const uint8_t    FLAG_LOCKED     = 0x01U;
+
+    uint8_t     slotId;     /**< Slot id */
+    uint16_t    typeId;     /**< Plugin type id, see getTypeId() */
+    uint16_t    uid;        /**< Plugin UID */
+    uint32_t    duration;   /**< Slot duration in ms */
+    bool        isLocked;   /**< Is slot locked or not */
+    uint8_t     weight;     /**< Slot weight in the rotation, see SlotPlan */
+    uint16_t    timeBegin;  /**< Time window begin in minutes of the day */
+    uint16_t    timeEnd;    /**< Time window end in minutes of the day */
+
+    /**
+     * Constructs a record of a empty slot.
+     */
+    SlotRecord() :
+        slotId(0U),
+        typeId(TYPE_ID_NONE),
+        uid(0U),
+        duration(0U),
+        isLocked(false),
+        weight(1U),
+        timeBegin(0U),
+        timeEnd(0U)
+    {
+    }
+
+    /**
+     * Get the number of bytes, which are necessary to store the records.
+     *
+     * @param[in] num   Number of records
+     *
+     * @return Size in byte
+     */
+    static size_t getSize(uint8_t num)
+    {
+        return HEADER_SIZE + (num * RECORD_SIZE);
+    }
+
+    /**
+     * Encode the records to the binary format.
+     *
+     * @param[in]   records Records
+     * @param[in]   num     Number of records
+     * @param[out]  buffer  Buffer, which to fill
+     * @param[in]   size    Buffer size in byte
+     *
+     * @return Number of written bytes. If the buffer is too small, it will return 0.
+     */
+    static size_t encode(const SlotRecord* records, uint8_t num, uint8_t* buffer, size_t size);
+
+    /**
+     * Decode the records from the binary format.
+     *
+     * @param[in]   buffer  Buffer with binary data
+     * @param[in]   size    Number of bytes in the buffer
+     * @param[out]  records Records, which to fill
+     * @param[in]   max     Max. number of records, which can be filled
+     * @param[out]  num     Number of decoded records
+     *
+     * @return If the data is valid, it will return true otherwise false.
+     */
+    static bool decode(const uint8_t* buffer, size_t size, SlotRecord* records, uint8_t max, uint8_t& num);
+
+    /**
+     * Get the plugin type id, derived from the plugin name (16-bit FNV-1a hash).
+     * It is stable across firmware versions, as long as the plugin name is
+     * unchanged. It can be evaluated at compile time.
+     *
+     * @param[in] name  Plugin name
+     *
+     * @return Plugin type id, which is never TYPE_ID_NONE.
+     */
+    static constexpr uint16_t getTypeId(const char* name)
+    {
+        return toTypeId((nullptr == name) ? FNV_OFFSET_BASIS : hash(name, FNV_OFFSET_BASIS));
+    }
+
+private:
+
+    /** FNV-1a 32-bit offset basis */
+    static constexpr uint32_t FNV_OFFSET_BASIS  = 2166136261UL;
+
+    /** FNV-1a 32-bit prime */
+    static constexpr uint32_t FNV_PRIME         = 16777619UL;
+
+    /**
+     * Calculate the FNV-1a hash of a string.
+     *
+     * @param[in] str   String
+     * @param[in] value Hash value of the already processed characters
+     *
+     * @return Hash value
+     */
+    static constexpr uint32_t hash(const char* str, uint32_t value)
+    {
+        return ('\0' == *str) ? value : hash(str + 1, (value ^ static_cast<uint8_t>(*str)) * FNV_PRIME);
+    }
+
+    /**
+     * Fold the hash value to 16 bit. The empty slot id is reserved.
+     *
+     * @param[in] value Hash value
+     *
+     * @return Plugin type id
+     */
+    static constexpr uint16_t toTypeId(uint32_t value)
+    {
+        return (TYPE_ID_NONE == static_cast<uint16_t>((value >> 16U) ^ (value & 0xFFFFU))) ?
+            static_cast<uint16_t>(1U) :
+            static_cast<uint16_t>((value >> 16U) ^ (value & 0xFFFFU));
+    }
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SLOTRECORD_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,310 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Audio spectrum analyzer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Spectrum.h"
+
+#include <math.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int16_t toQ15(float value);
+static uint32_t log2Fixed(uint32_t value, uint8_t fracBits);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Spectrum::Spectrum() :
+    m_window(),
+    m_cos(),
+    m_sin(),
+    m_bandEnd(),
+    m_real(),
+    m_imag()
+{
+    const float LAST_BIN    = static_cast<float>(FFT_SIZE / 2U);
+    uint16_t    index       = 0U;
+    uint16_t    bandEnd     = FIRST_BIN;
+    uint8_t     band        = 0U;
+
+    for(index = 0U; index < FFT_SIZE; ++index)
+    {
+        m_window[index] = toQ15(0.5f - 0.5f * cosf(2.0f * static_cast<float>(M_PI) * index / FFT_SIZE));
+    }
+
+    for(index = 0U; index < (FFT_SIZE / 2U); ++index)
+    {
+        m_cos[index] = toQ15(cosf(2.0f * static_cast<float>(M_PI) * index / FFT_SIZE));
+        m_sin[index] = toQ15(sinf(2.0f * static_cast<float>(M_PI) * index / FFT_SIZE));
+    }
+
+    /* Logarithmic spaced bands, but every band has at least one bin. */
+    for(band = 0U; band < BAND_COUNT; ++band)
+    {
+        uint16_t end = static_cast<uint16_t>(powf(LAST_BIN, static_cast<float>(band + 1U) / BAND_COUNT) + 0.5f);
+
+        if (end <= bandEnd)
+        {
+            end = bandEnd + 1U;
+        }
+
+        m_bandEnd[band] = end;
+        bandEnd         = end;
+    }
+}
+
+void Spectrum::process(const int16_t* samples, Levels& levels)
+{
+    uint32_t    sum     = 0U;
+    uint16_t    index   = 0U;
+    uint8_t     band    = 0U;
+
+    if (nullptr == samples)
+    {
+        return;
+    }
+
+    /* The input is scaled by 1/2, which leaves headroom for the butterflies. */
+    for(index = 0U; index < FFT_SIZE; ++index)
+    {
+        int32_t sample = samples[index];
+
+        sum            += (0 > sample) ? -sample : sample;
+        m_real[index]   = static_cast<int16_t>((sample * m_window[index]) >> 16);
+        m_imag[index]   = 0;
+    }
+
+    levels.volume = toLevel(sum / FFT_SIZE, VOLUME_FULL_SCALE);
+
+    transform();
+
+    index = FIRST_BIN;
+    for(band = 0U; band < BAND_COUNT; ++band)
+    {
+        uint32_t peak = 0U;
+
+        while(m_bandEnd[band] > index)
+        {
+            uint32_t re     = static_cast<uint32_t>((0 > m_real[index]) ? -m_real[index] : m_real[index]);
+            uint32_t im     = static_cast<uint32_t>((0 > m_imag[index]) ? -m_imag[index] : m_imag[index]);
+            uint32_t mag    = 0U;
+
+            /* Magnitude approximation: max + 3/8 min */
+            if (re > im)
+            {
+                mag = re + ((3U * im) >> 3U);
+            }
+            else
+            {
+                mag = im + ((3U * re) >> 3U);
+            }
+
+            if (peak < mag)
+            {
+                peak = mag;
+            }
+
+            ++index;
+        }
+
+        levels.bands[band] = toLevel(peak, BAND_FULL_SCALE);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void Spectrum::transform()
+{
+    uint16_t    index   = 0U;
+    uint16_t    reverse = 0U;
+    uint16_t    size    = 0U;
+    uint16_t    bit     = 0U;
+
+    /* Bit reversed order */
+    for(index = 0U; index < FFT_SIZE; ++index)
+    {
+        if (index < reverse)
+        {
+            int16_t tmp = m_real[index];
+
+            m_real[index]   = m_real[reverse];
+            m_real[reverse] = tmp;
+        }
+
+        /* The imaginary part is 0, no need to swap it. */
+
+        bit = FFT_SIZE >> 1U;
+        while(0U != (reverse & bit))
+        {
+            reverse &= ~bit;
+            bit    >>= 1U;
+        }
+
+        reverse |= bit;
+    }
+
+    /* Butterflies, every stage scales by 1/2. */
+    for(size = 2U; size <= FFT_SIZE; size <<= 1U)
+    {
+        const uint16_t  HALF    = size >> 1U;
+        const uint16_t  STEP    = FFT_SIZE / size;
+        uint16_t        start   = 0U;
+
+        for(start = 0U; start < FFT_SIZE; start += size)
+        {
+            uint16_t offset = 0U;
+
+            for(offset = 0U; offset < HALF; ++offset)
+            {
+                const uint16_t  TOP = start + offset;
+                const uint16_t  BOT = TOP + HALF;
+                const int32_t   WR  = m_cos[offset * STEP];
+                const int32_t   WI  = -m_sin[offset * STEP];
+                const int32_t   TR  = (WR * m_real[BOT] - WI * m_imag[BOT]) >> 15;
+                const int32_t   TI  = (WR * m_imag[BOT] + WI * m_real[BOT]) >> 15;
+                const int32_t   UR  = m_real[TOP];
+                const int32_t   UI  = m_imag[TOP];
+
+                m_real[TOP] = static_cast<int16_t>((UR + TR) >> 1);
+                m_imag[TOP] = static_cast<int16_t>((UI + TI) >> 1);
+                m_real[BOT] = static_cast<int16_t>((UR - TR) >> 1);
+                m_imag[BOT] = static_cast<int16_t>((UI - TI) >> 1);
+            }
+        }
+    }
+
+    return;
+}
+
+uint8_t Spectrum::toLevel(uint32_t value, uint8_t fullScale)
+{
+    const uint32_t  LOG2_MIN    = static_cast<uint32_t>(fullScale - LEVEL_RANGE_LOG2) << LOG2_FRAC_BITS;
+    const uint32_t  LOG2_RANGE  = static_cast<uint32_t>(LEVEL_RANGE_LOG2) << LOG2_FRAC_BITS;
+    uint32_t        log2Value   = log2Fixed(value, LOG2_FRAC_BITS);
+    uint8_t         level       = 0U;
+
+    if (LOG2_MIN < log2Value)
+    {
+        uint32_t scaled = ((log2Value - LOG2_MIN) * LEVEL_MAX) / LOG2_RANGE;
+
+        level = (LEVEL_MAX < scaled) ? LEVEL_MAX : static_cast<uint8_t>(scaled);
+    }
+
+    return level;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a value in [-1; 1] to Q15 fixed-point.
+ *
+ * @param[in] value Value
+ *
+ * @return Value in Q15
+ */
+static int16_t toQ15(float value)
+{
+    int32_t q15 = static_cast<int32_t>(lroundf(value * 32768.0f));
+
+    if (INT16_MAX < q15)
+    {
+        q15 = INT16_MAX;
+    }
+    else if (INT16_MIN > q15)
+    {
+        q15 = INT16_MIN;
+    }
+    else
+    {
+        ;
+    }
+
+    return static_cast<int16_t>(q15);
+}
+
+/**
+ * Calculate the logarithm to base 2 in fixed-point. The fraction is
+ * linear approximated by the mantissa.
+ *
+ * @param[in] value     Value
+ * @param[in] fracBits  Number of fractional bits of the result
+ *
+ * @return Logarithm to base 2, 0 for a value of 0.
+ */
+static uint32_t log2Fixed(uint32_t value, uint8_t fracBits)
+{
+    uint32_t result = 0U;
+
+    if (0U != value)
+    {
+        const uint32_t  INT_PART    = 31U - static_cast<uint32_t>(__builtin_clz(value));
+        const uint32_t  MANTISSA    = (value << (31U - INT_PART)) & INT32_MAX;
+
+        result = (INT_PART << fracBits) | (MANTISSA >> (31U - fracBits));
+    }
+
+    return result;
+}
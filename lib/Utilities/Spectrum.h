@@ -0,0 +1,173 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Audio spectrum analyzer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SPECTRUM_H__
+#define __SPECTRUM_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Audio spectrum analyzer, which calculates the levels of logarithmic
+ * spaced frequency bands and the volume of a block of audio samples.
+ *
+ * It uses a fixed-point radix-2 FFT with a Hann window. Every FFT stage
+ * scales by 1/2, which avoids overflows. The levels are in dB, mapped
+ * to [0; 255] over a range of about 60 dB below full scale.
+ */
+class Spectrum
+{
+public:
+
+    /** FFT order, the FFT size is 2^FFT_ORDER. */
+    static const uint8_t    FFT_ORDER   = 8U;
+
+    /** Number of samples per block */
+    static const uint16_t   FFT_SIZE    = 1U << FFT_ORDER;
+
+    /** Number of frequency bands */
+    static const uint8_t    BAND_COUNT  = 16U;
+
+    /** Max. level */
+    static const uint8_t    LEVEL_MAX   = UINT8_MAX;
+
+    /**
+     * Levels of a sample block.
+     */
+    struct Levels
+    {
+        uint8_t bands[BAND_COUNT];  /**< Level of every frequency band, lowest frequency first. */
+        uint8_t volume;             /**< Volume level */
+    };
+
+    /**
+     * Constructs the spectrum analyzer and calculates its tables.
+     */
+    Spectrum();
+
+    /**
+     * Destroys the spectrum analyzer.
+     */
+    ~Spectrum()
+    {
+    }
+
+    /**
+     * Analyze a block of samples.
+     *
+     * @param[in]   samples Block with FFT_SIZE samples
+     * @param[out]  levels  Levels of the frequency bands and the volume
+     */
+    void process(const int16_t* samples, Levels& levels);
+
+    /**
+     * Get the first FFT bin of a frequency band. The frequency of a bin is
+     * bin * sample rate / FFT_SIZE.
+     *
+     * @param[in] band  Frequency band
+     *
+     * @return FFT bin
+     */
+    uint16_t getFirstBin(uint8_t band) const
+    {
+        return (0U == band) ? FIRST_BIN : m_bandEnd[band - 1U];
+    }
+
+private:
+
+    /** First FFT bin, which is used. Bin 0 is the DC component. */
+    static const uint16_t   FIRST_BIN           = 1U;
+
+    /** Number of fractional bits of the logarithm */
+    static const uint8_t    LOG2_FRAC_BITS      = 8U;
+
+    /** Range of the levels as logarithm to base 2, which is about 60 dB. */
+    static const uint8_t    LEVEL_RANGE_LOG2    = 10U;
+
+    /**
+     * Logarithm to base 2 of the FFT magnitude of a full scale sine.
+     * The input is pre-scaled by 1/2, the Hann window halves the amplitude
+     * and the scaled FFT delivers half of the amplitude in the bin.
+     */
+    static const uint8_t    BAND_FULL_SCALE     = 12U;
+
+    /** Logarithm to base 2 of the mean absolute sample value of a full scale sine. */
+    static const uint8_t    VOLUME_FULL_SCALE   = 14U;
+
+    int16_t     m_window[FFT_SIZE];         /**< Hann window in Q15 */
+    int16_t     m_cos[FFT_SIZE / 2U];       /**< Cosine twiddle factors in Q15 */
+    int16_t     m_sin[FFT_SIZE / 2U];       /**< Sine twiddle factors in Q15 */
+    uint16_t    m_bandEnd[BAND_COUNT];      /**< FFT bin after the last bin of every band */
+    int16_t     m_real[FFT_SIZE];           /**< Real part of the FFT data */
+    int16_t     m_imag[FFT_SIZE];           /**< Imaginary part of the FFT data */
+
+    /**
+     * Calculate the FFT in place with m_real and m_imag.
+     */
+    void transform();
+
+    /**
+     * Map a value logarithmically to a level.
+     *
+     * @param[in] value     Value
+     * @param[in] fullScale Logarithm to base 2 of the full scale value
+     *
+     * @return Level in [0; LEVEL_MAX]
+     */
+    static uint8_t toLevel(uint32_t value, uint8_t fullScale);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SPECTRUM_H__ */
+
+/** @} */
@@ -0,0 +1,183 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Single producer single consumer queue
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SPSCQUEUE_HPP__
+#define __SPSCQUEUE_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Lock-free queue with fixed capacity for exactly one producer and exactly
+ * one consumer, which may run in different tasks.
+ * The producer only writes the write index and the consumer only writes the
+ * read index, therefore no lock is necessary.
+ *
+ * @tparam T        Element type
+ * @tparam CAPACITY Max. number of elements, which must be a power of 2.
+ */
+template < typename T, uint32_t CAPACITY >
+class SpscQueue
+{
+public:
+
+    static_assert((0U < CAPACITY) && (0U == (CAPACITY & (CAPACITY - 1U))), "The capacity must be a power of 2.");
+
+    /**
+     * Constructs an empty queue.
+     */
+    SpscQueue() :
+        m_elements(),
+        m_writeIdx(0U),
+        m_readIdx(0U)
+    {
+    }
+
+    /**
+     * Destroys the queue.
+     */
+    ~SpscQueue()
+    {
+    }
+
+    /**
+     * Append an element. Shall only be called by the producer.
+     *
+     * @param[in] element   Element
+     *
+     * @return If successful, it will return true otherwise false (queue is full).
+     */
+    bool push(const T& element)
+    {
+        const uint32_t  WRITE_IDX   = m_writeIdx.load(std::memory_order_relaxed);
+        const uint32_t  READ_IDX    = m_readIdx.load(std::memory_order_acquire);
+        bool            isSuccess   = false;
+
+        if (CAPACITY > (WRITE_IDX - READ_IDX))
+        {
+            m_elements[WRITE_IDX & (CAPACITY - 1U)] = element;
+            m_writeIdx.store(WRITE_IDX + 1U, std::memory_order_release);
+            isSuccess = true;
+        }
+
+        return isSuccess;
+    }
+
+    /**
+     * Remove the oldest element. Shall only be called by the consumer.
+     *
+     * @param[out] element  Element
+     *
+     * @return If successful, it will return true otherwise false (queue is empty).
+     */
+    bool pop(T& element)
+    {
+        const uint32_t  READ_IDX    = m_readIdx.load(std::memory_order_relaxed);
+        const uint32_t  WRITE_IDX   = m_writeIdx.load(std::memory_order_acquire);
+        bool            isSuccess   = false;
+
+        if (READ_IDX != WRITE_IDX)
+        {
+            element = m_elements[READ_IDX & (CAPACITY - 1U)];
+            m_readIdx.store(READ_IDX + 1U, std::memory_order_release);
+            isSuccess = true;
+        }
+
+        return isSuccess;
+    }
+
+    /**
+     * Remove all elements. Shall only be called by the consumer.
+     */
+    void clear()
+    {
+        m_readIdx.store(m_writeIdx.load(std::memory_order_acquire), std::memory_order_release);
+
+        return;
+    }
+
+    /**
+     * Is the queue empty?
+     *
+     * @return If empty, it will return true otherwise false.
+     */
+    bool isEmpty() const
+    {
+        return m_readIdx.load(std::memory_order_acquire) == m_writeIdx.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get number of elements in the queue.
+     *
+     * @return Number of elements
+     */
+    uint32_t getCount() const
+    {
+        return m_writeIdx.load(std::memory_order_acquire) - m_readIdx.load(std::memory_order_acquire);
+    }
+
+private:
+
+    T                       m_elements[CAPACITY];   /**< Elements */
+    std::atomic<uint32_t>   m_writeIdx;             /**< Write index, only written by the producer */
+    std::atomic<uint32_t>   m_readIdx;              /**< Read index, only written by the consumer */
+
+    SpscQueue(const SpscQueue& queue);
+    SpscQueue& operator=(const SpscQueue& queue);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SPSCQUEUE_HPP__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,166 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free state exchange between a writer and a reader
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __STATEBUFFER_HPP__
+#define __STATEBUFFER_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Lock-free exchange of the latest state from exactly one writer to exactly
+ * one reader, which may run in different tasks. Only the latest published
+ * state is relevant, older ones are skipped by the reader.
+ *
+ * There are three slots: the writer fills the spare slot and publishes it
+ * by an atomic swap with the exchange slot. The reader swaps the exchange
+ * slot with its own slot, if there is a new state. This way the writer never
+ * touches the slot the reader currently uses and vice versa.
+ *
+ * Several writers must be serialized by the user, e.g. with a mutex, which
+ * is never taken by the reader.
+ *
+ * @tparam T    State type, which must be copy assignable.
+ */
+template < typename T >
+class StateBuffer
+{
+public:
+
+    /**
+     * Constructs the state buffer. The reader starts with a default
+     * constructed state.
+     */
+    StateBuffer() :
+        m_slots(),
+        m_writeSlot(0U),
+        m_exchangeSlot(1U),
+        m_readSlot(2U)
+    {
+    }
+
+    /**
+     * Destroys the state buffer.
+     */
+    ~StateBuffer()
+    {
+    }
+
+    /**
+     * Publish a new state. Shall only be called by the writer.
+     *
+     * @param[in] state State
+     */
+    void publish(const T& state)
+    {
+        m_slots[m_writeSlot] = state;
+        m_writeSlot = m_exchangeSlot.exchange(static_cast<uint8_t>(m_writeSlot | FLAG_NEW), std::memory_order_acq_rel) & SLOT_MASK;
+
+        return;
+    }
+
+    /**
+     * Fetch the latest state, if a new one was published since the last
+     * fetch. Shall only be called by the reader.
+     *
+     * @return If there is a new state, it will return it otherwise nullptr.
+     */
+    const T* fetch()
+    {
+        const T* state = nullptr;
+
+        if (0U != (m_exchangeSlot.load(std::memory_order_relaxed) & FLAG_NEW))
+        {
+            m_readSlot  = m_exchangeSlot.exchange(m_readSlot, std::memory_order_acq_rel) & SLOT_MASK;
+            state       = &m_slots[m_readSlot];
+        }
+
+        return state;
+    }
+
+    /**
+     * Get the state, which was fetched last. Shall only be called by the reader.
+     *
+     * @return State
+     */
+    const T& get() const
+    {
+        return m_slots[m_readSlot];
+    }
+
+private:
+
+    /** Number of slots */
+    static const uint8_t    SLOT_COUNT  = 3U;
+
+    /** Mask of the slot index in the exchange slot */
+    static const uint8_t    SLOT_MASK   = 0x03U;
+
+    /** Flag in the exchange slot, which marks a new state. */
+    static const uint8_t    FLAG_NEW    = 0x04U;
+
+    T                       m_slots[SLOT_COUNT];    /**< State slots */
+    uint8_t                 m_writeSlot;            /**< Slot index, only used by the writer */
+    std::atomic<uint8_t>    m_exchangeSlot;         /**< Slot index and new flag, swapped by writer and reader */
+    uint8_t                 m_readSlot;             /**< Slot index, only used by the reader */
+
+    /* Prevent copying */
+    StateBuffer(const StateBuffer& buffer);
+    StateBuffer& operator=(const StateBuffer& buffer);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __STATEBUFFER_HPP__ */
+
+/** @} */
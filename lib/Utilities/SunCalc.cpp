@@ -0,0 +1,133 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sunrise and sunset calculation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SunCalc.h"
+
+#include <math.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Pi */
+static const float  PI_F                = 3.14159265F;
+
+/** Factor to convert degree to radian. */
+static const float  DEG_TO_RAD_F        = PI_F / 180.0F;
+
+/**
+ * Zenith of the sun in degree at sunrise and sunset. It considers the
+ * atmospheric refraction and the size of the solar disk.
+ */
+static const float  SUN_ZENITH          = 90.833F;
+
+/** Minutes, the earth needs to rotate one degree. */
+static const float  MINUTES_PER_DEGREE  = 4.0F;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool SunCalc::calculate(float latitude, float longitude, uint16_t dayOfYear, int16_t& sunrise, int16_t& sunset)
+{
+    bool    status  = false;
+
+    /* Fractional year in radian at noon. */
+    float   gamma   = 2.0F * PI_F * static_cast<float>(dayOfYear) / 365.0F;
+
+    /* Equation of time in minutes */
+    float   eqTime  = 229.18F * (0.000075F +
+                                 0.001868F * cosf(gamma) -
+                                 0.032077F * sinf(gamma) -
+                                 0.014615F * cosf(2.0F * gamma) -
+                                 0.040849F * sinf(2.0F * gamma));
+
+    /* Solar declination in radian */
+    float   decl    = 0.006918F -
+                      0.399912F * cosf(gamma) +
+                      0.070257F * sinf(gamma) -
+                      0.006758F * cosf(2.0F * gamma) +
+                      0.000907F * sinf(2.0F * gamma) -
+                      0.002697F * cosf(3.0F * gamma) +
+                      0.00148F * sinf(3.0F * gamma);
+
+    float   latRad  = latitude * DEG_TO_RAD_F;
+    float   cosHa   = cosf(SUN_ZENITH * DEG_TO_RAD_F) / (cosf(latRad) * cosf(decl)) - tanf(latRad) * tanf(decl);
+
+    /* The sun doesn't cross the horizon at polar day or night. */
+    if ((-1.0F <= cosHa) &&
+        (1.0F >= cosHa))
+    {
+        float   haDeg   = acosf(cosHa) / DEG_TO_RAD_F;
+        float   noon    = static_cast<float>(MINUTES_PER_DAY / 2) - MINUTES_PER_DEGREE * longitude - eqTime;
+
+        sunrise = static_cast<int16_t>(lroundf(noon - MINUTES_PER_DEGREE * haDeg));
+        sunset  = static_cast<int16_t>(lroundf(noon + MINUTES_PER_DEGREE * haDeg));
+        status  = true;
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,98 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sunrise and sunset calculation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SUNCALC_H__
+#define __SUNCALC_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Calculates the sunrise and sunset of a location on the device, with the
+ * general solar position approximation of the NOAA. The result is accurate
+ * to about a minute, which is enough to show it. The calculation uses
+ * single precision only, which the hardware supports.
+ */
+class SunCalc
+{
+public:
+
+    /** Minutes of a day */
+    static const int16_t    MINUTES_PER_DAY = 24 * 60;
+
+    /**
+     * Calculate sunrise and sunset of a day.
+     * The times are in minutes after midnight UTC. Depended on the longitude,
+     * they may be negative or above a day.
+     *
+     * @param[in]   latitude    Latitude in degree, north is positive.
+     * @param[in]   longitude   Longitude in degree, east is positive.
+     * @param[in]   dayOfYear   Day of the year, starting with 0 for 1st January.
+     * @param[out]  sunrise     Sunrise in minutes after midnight UTC
+     * @param[out]  sunset      Sunset in minutes after midnight UTC
+     *
+     * @return If the sun rises and sets this day, it will return true. During polar day or night it will return false.
+     */
+    static bool calculate(float latitude, float longitude, uint16_t dayOfYear, int16_t& sunrise, int16_t& sunset);
+
+private:
+
+    /* Not allowed */
+    SunCalc();
+    SunCalc(const SunCalc& calc);
+    SunCalc& operator=(const SunCalc& calc);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SUNCALC_H__ */
+
+/** @} */
@@ -0,0 +1,202 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Synchronized clock
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SyncClock.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void SyncClock::reset()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < WINDOW_SIZE; ++index)
+    {
+        m_samples[index].offset = 0;
+        m_samples[index].delay  = 0;
+    }
+
+    m_writeIndex        = 0U;
+    m_count             = 0U;
+    m_offset            = 0;
+    m_isSynchronized    = false;
+
+    return;
+}
+
+bool SyncClock::addSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4)
+{
+    bool            isPlausible = false;
+    const int64_t   MS_DELAY    = static_cast<int64_t>(t2 - t1); /* Master to slave */
+    const int64_t   SM_DELAY    = static_cast<int64_t>(t4 - t3); /* Slave to master */
+    const int64_t   DELAY       = (MS_DELAY + SM_DELAY) / 2;
+
+    /* A negative delay means the timestamps are not from the same exchange. */
+    if (0 <= DELAY)
+    {
+        int64_t estimate = 0;
+
+        m_samples[m_writeIndex].offset  = (SM_DELAY - MS_DELAY) / 2;
+        m_samples[m_writeIndex].delay   = DELAY;
+
+        m_writeIndex = (m_writeIndex + 1U) % WINDOW_SIZE;
+
+        if (WINDOW_SIZE > m_count)
+        {
+            ++m_count;
+        }
+
+        estimate = m_samples[getBestSample()].offset;
+
+        /* The first estimate or a large correction is stepped. */
+        if ((false == m_isSynchronized) ||
+            (STEP_THRESHOLD < estimate - m_offset) ||
+            (-STEP_THRESHOLD > estimate - m_offset))
+        {
+            m_offset = estimate;
+        }
+        else
+        {
+            m_offset += (estimate - m_offset) / SLEW_DIVISOR;
+        }
+
+        if (MIN_SAMPLES <= m_count)
+        {
+            m_isSynchronized = true;
+        }
+
+        isPlausible = true;
+    }
+
+    return isPlausible;
+}
+
+int64_t SyncClock::getDelay() const
+{
+    int64_t delay = 0;
+
+    if (0U < m_count)
+    {
+        delay = m_samples[getBestSample()].delay;
+    }
+
+    return delay;
+}
+
+int32_t SyncClock::getPhaseError(uint64_t time, uint32_t period)
+{
+    int32_t error = 0;
+
+    if (0U < period)
+    {
+        error = static_cast<int32_t>(time % period);
+
+        if ((period / 2U) < static_cast<uint32_t>(error))
+        {
+            error -= static_cast<int32_t>(period);
+        }
+    }
+
+    return error;
+}
+
+uint64_t SyncClock::alignUp(uint64_t time, uint32_t period)
+{
+    uint64_t aligned = time;
+
+    if (0U < period)
+    {
+        const uint32_t REMAINDER = static_cast<uint32_t>(time % period);
+
+        if (0U < REMAINDER)
+        {
+            aligned += period - REMAINDER;
+        }
+    }
+
+    return aligned;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint8_t SyncClock::getBestSample() const
+{
+    uint8_t best    = 0U;
+    uint8_t index   = 0U;
+
+    for(index = 1U; index < m_count; ++index)
+    {
+        if (m_samples[best].delay > m_samples[index].delay)
+        {
+            best = index;
+        }
+    }
+
+    return best;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
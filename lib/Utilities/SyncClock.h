@@ -0,0 +1,217 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Synchronized clock
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SYNCCLOCK_H__
+#define __SYNCCLOCK_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The synchronized clock estimates the offset of the local clock to the
+ * clock of a master. It is fed with the timestamps of a delay request-response
+ * exchange, similar to PTP:
+ * - t1: Master sends the sync message (master clock).
+ * - t2: Slave receives the sync message (local clock).
+ * - t3: Slave sends the delay request (local clock).
+ * - t4: Master receives the delay request (master clock).
+ *
+ * All timestamps are in us. The wifi delay jitters a lot, therefore the
+ * offset of the sample with the lowest delay in a window is used. Small
+ * corrections are slewed, large corrections are stepped.
+ */
+class SyncClock
+{
+public:
+
+    /** Number of samples in the filter window */
+    static const uint8_t    WINDOW_SIZE         = 8U;
+
+    /** Number of samples, until the clock is synchronized. */
+    static const uint8_t    MIN_SAMPLES         = 4U;
+
+    /** Above this offset correction in us the clock is stepped, otherwise it is slewed. */
+    static const int64_t    STEP_THRESHOLD      = 10000;
+
+    /** A slewed correction is divided by this value. */
+    static const int64_t    SLEW_DIVISOR        = 4;
+
+    /**
+     * Constructs a not synchronized clock.
+     */
+    SyncClock()
+    {
+        reset();
+    }
+
+    /**
+     * Destroys the clock.
+     */
+    ~SyncClock()
+    {
+    }
+
+    /**
+     * Forget all samples. The clock is not synchronized afterwards.
+     */
+    void reset();
+
+    /**
+     * Add the timestamps of a delay request-response exchange.
+     *
+     * @param[in] t1    Sync message sent by the master in us (master clock)
+     * @param[in] t2    Sync message received in us (local clock)
+     * @param[in] t3    Delay request sent in us (local clock)
+     * @param[in] t4    Delay request received by the master in us (master clock)
+     *
+     * @return If the sample is plausible, it will return true otherwise false.
+     */
+    bool addSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
+
+    /**
+     * Is the clock synchronized to the master?
+     *
+     * @return If synchronized, it will return true otherwise false.
+     */
+    bool isSynchronized() const
+    {
+        return m_isSynchronized;
+    }
+
+    /**
+     * Get the offset of the master clock to the local clock.
+     *
+     * @return Offset in us
+     */
+    int64_t getOffset() const
+    {
+        return m_offset;
+    }
+
+    /**
+     * Get the one way delay of the best sample in the window.
+     *
+     * @return Delay in us
+     */
+    int64_t getDelay() const;
+
+    /**
+     * Convert a local timestamp to master clock.
+     *
+     * @param[in] local Local timestamp in us
+     *
+     * @return Master timestamp in us
+     */
+    uint64_t toMaster(uint64_t local) const
+    {
+        return local + m_offset;
+    }
+
+    /**
+     * Convert a master timestamp to local clock.
+     *
+     * @param[in] master    Master timestamp in us
+     *
+     * @return Local timestamp in us
+     */
+    uint64_t toLocal(uint64_t master) const
+    {
+        return master - m_offset;
+    }
+
+    /**
+     * Get the phase error of a timestamp to a period grid, which starts at 0.
+     *
+     * @param[in] time      Timestamp in us
+     * @param[in] period    Grid period in us
+     *
+     * @return Phase error in us, in the range of (-period / 2; period / 2].
+     */
+    static int32_t getPhaseError(uint64_t time, uint32_t period);
+
+    /**
+     * Get the first period grid point, which is not before the timestamp.
+     *
+     * @param[in] time      Timestamp in us
+     * @param[in] period    Grid period in us
+     *
+     * @return Grid point in us
+     */
+    static uint64_t alignUp(uint64_t time, uint32_t period);
+
+private:
+
+    /** A single filter sample. */
+    struct Sample
+    {
+        int64_t offset; /**< Offset in us */
+        int64_t delay;  /**< One way delay in us */
+    };
+
+    Sample  m_samples[WINDOW_SIZE]; /**< Filter window */
+    uint8_t m_writeIndex;           /**< Index of the next sample to write */
+    uint8_t m_count;                /**< Number of samples in the window */
+    int64_t m_offset;               /**< Current offset in us */
+    bool    m_isSynchronized;       /**< Is clock synchronized? */
+
+    /**
+     * Get the index of the sample with the lowest delay.
+     *
+     * @return Sample index
+     */
+    uint8_t getBestSample() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SYNCCLOCK_H__ */
+
+/** @} */
@@ -0,0 +1,245 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display synchronization packet
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SyncPacket.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeUInt16(uint8_t* buffer, uint16_t value);
+static void writeUInt64(uint8_t* buffer, uint64_t value);
+static uint16_t readUInt16(const uint8_t* buffer);
+static uint64_t readUInt64(const uint8_t* buffer);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t SyncPacket::encode(const SyncPacket& packet, uint8_t* buffer, size_t size)
+{
+    size_t          written     = 0U;
+    const size_t    PACKET_SIZE = HEADER_SIZE + getPayloadSize(packet.type);
+
+    if ((nullptr != buffer) &&
+        (PACKET_SIZE <= size))
+    {
+        uint8_t* payload = &buffer[HEADER_SIZE];
+
+        buffer[0] = MAGIC;
+        buffer[1] = VERSION;
+        buffer[2] = static_cast<uint8_t>(packet.type);
+        buffer[3] = packet.group;
+        writeUInt16(&buffer[4], packet.sequence);
+
+        if (TYPE_SYNC == packet.type)
+        {
+            writeUInt64(&payload[0], packet.timestamp);
+            writeUInt16(&payload[8], packet.framePeriod);
+            payload[10] = packet.currentSlot;
+            payload[11] = packet.nextSlot;
+            writeUInt64(&payload[12], packet.switchTime);
+        }
+        else if (TYPE_DELAY_RESP == packet.type)
+        {
+            writeUInt64(&payload[0], packet.timestamp);
+        }
+        else
+        {
+            ;
+        }
+
+        written = PACKET_SIZE;
+    }
+
+    return written;
+}
+
+bool SyncPacket::decode(const uint8_t* buffer, size_t size, SyncPacket& packet)
+{
+    bool isValid = false;
+
+    if ((nullptr != buffer) &&
+        (HEADER_SIZE <= size) &&
+        (MAGIC == buffer[0]) &&
+        (VERSION == buffer[1]) &&
+        (TYPE_SYNC <= buffer[2]) &&
+        (TYPE_DELAY_RESP >= buffer[2]) &&
+        ((HEADER_SIZE + getPayloadSize(buffer[2])) <= size))
+    {
+        const uint8_t* payload = &buffer[HEADER_SIZE];
+
+        packet.type     = static_cast<Type>(buffer[2]);
+        packet.group    = buffer[3];
+        packet.sequence = readUInt16(&buffer[4]);
+
+        if (TYPE_SYNC == packet.type)
+        {
+            packet.timestamp    = readUInt64(&payload[0]);
+            packet.framePeriod  = readUInt16(&payload[8]);
+            packet.currentSlot  = payload[10];
+            packet.nextSlot     = payload[11];
+            packet.switchTime   = readUInt64(&payload[12]);
+        }
+        else if (TYPE_DELAY_RESP == packet.type)
+        {
+            packet.timestamp    = readUInt64(&payload[0]);
+        }
+        else
+        {
+            ;
+        }
+
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+size_t SyncPacket::getPayloadSize(uint8_t type)
+{
+    size_t size = 0U;
+
+    if (TYPE_SYNC == type)
+    {
+        size = SYNC_SIZE;
+    }
+    else if (TYPE_DELAY_RESP == type)
+    {
+        size = DELAY_RESP_SIZE;
+    }
+    else
+    {
+        ;
+    }
+
+    return size;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a 16-bit value in little endian order.
+ *
+ * @param[out]  buffer  Buffer
+ * @param[in]   value   Value
+ */
+static void writeUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 0U);
+    buffer[1] = static_cast<uint8_t>(value >> 8U);
+
+    return;
+}
+
+/**
+ * Write a 64-bit value in little endian order.
+ *
+ * @param[out]  buffer  Buffer
+ * @param[in]   value   Value
+ */
+static void writeUInt64(uint8_t* buffer, uint64_t value)
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < 8U; ++index)
+    {
+        buffer[index] = static_cast<uint8_t>(value >> (8U * index));
+    }
+
+    return;
+}
+
+/**
+ * Read a 16-bit value in little endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint16_t readUInt16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0]) |
+           (static_cast<uint16_t>(buffer[1]) << 8U);
+}
+
+/**
+ * Read a 64-bit value in little endian order.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint64_t readUInt64(const uint8_t* buffer)
+{
+    uint64_t    value   = 0U;
+    uint8_t     index   = 0U;
+
+    for(index = 0U; index < 8U; ++index)
+    {
+        value |= static_cast<uint64_t>(buffer[index]) << (8U * index);
+    }
+
+    return value;
+}
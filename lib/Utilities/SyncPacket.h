@@ -0,0 +1,164 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display synchronization packet
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __SYNCPACKET_H__
+#define __SYNCPACKET_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Packet, which is exchanged between the devices of a display group.
+ *
+ * Binary format (little endian):
+ * - Header: magic (1 byte), version (1 byte), type (1 byte), group (1 byte), sequence number (2 byte)
+ * - Sync: master timestamp in us (8 byte), frame period in ms (2 byte), current slot id (1 byte),
+ *   next slot id (1 byte), slot switch timestamp in us (8 byte)
+ * - Delay request: no payload
+ * - Delay response: receive timestamp of the delay request in us (8 byte)
+ */
+class SyncPacket
+{
+public:
+
+    /** Packet types */
+    enum Type
+    {
+        TYPE_SYNC       = 1U,   /**< Master timing, sent periodically by the master */
+        TYPE_DELAY_REQ  = 2U,   /**< Delay request, sent by the slave */
+        TYPE_DELAY_RESP = 3U    /**< Delay response, sent by the master */
+    };
+
+    /** Format identification */
+    static const uint8_t    MAGIC           = 0xD5U;
+
+    /** Current format version */
+    static const uint8_t    VERSION         = 1U;
+
+    /** Header size in byte */
+    static const size_t     HEADER_SIZE     = 6U;
+
+    /** Sync payload size in byte */
+    static const size_t     SYNC_SIZE       = 20U;
+
+    /** Delay response payload size in byte */
+    static const size_t     DELAY_RESP_SIZE = 8U;
+
+    /** Max. packet size in byte */
+    static const size_t     MAX_SIZE        = HEADER_SIZE + SYNC_SIZE;
+
+    /** Slot id, which means no slot. */
+    static const uint8_t    SLOT_ID_NONE    = UINT8_MAX;
+
+    Type        type;           /**< Packet type */
+    uint8_t     group;          /**< Display group */
+    uint16_t    sequence;       /**< Sequence number, a response contains the one of the request. */
+    uint64_t    timestamp;      /**< Sync: master timestamp, delay response: receive timestamp of the request */
+    uint16_t    framePeriod;    /**< Sync: frame period in ms */
+    uint8_t     currentSlot;    /**< Sync: currently active slot id */
+    uint8_t     nextSlot;       /**< Sync: next slot id or SLOT_ID_NONE if no slot switch is announced */
+    uint64_t    switchTime;     /**< Sync: master timestamp of the announced slot switch */
+
+    /**
+     * Constructs a empty sync packet.
+     */
+    SyncPacket() :
+        type(TYPE_SYNC),
+        group(0U),
+        sequence(0U),
+        timestamp(0U),
+        framePeriod(0U),
+        currentSlot(SLOT_ID_NONE),
+        nextSlot(SLOT_ID_NONE),
+        switchTime(0U)
+    {
+    }
+
+    /**
+     * Encode the packet to the binary format.
+     *
+     * @param[in]   packet  Packet
+     * @param[out]  buffer  Buffer, which to fill
+     * @param[in]   size    Buffer size in byte
+     *
+     * @return Number of written bytes. If the buffer is too small, it will return 0.
+     */
+    static size_t encode(const SyncPacket& packet, uint8_t* buffer, size_t size);
+
+    /**
+     * Decode the packet from the binary format.
+     *
+     * @param[in]   buffer  Buffer with binary data
+     * @param[in]   size    Number of bytes in the buffer
+     * @param[out]  packet  Packet, which to fill
+     *
+     * @return If the data is valid, it will return true otherwise false.
+     */
+    static bool decode(const uint8_t* buffer, size_t size, SyncPacket& packet);
+
+private:
+
+    /**
+     * Get the payload size of a packet type.
+     *
+     * @param[in] type  Packet type
+     *
+     * @return Payload size in byte
+     */
+    static size_t getPayloadSize(uint8_t type);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SYNCPACKET_H__ */
+
+/** @} */
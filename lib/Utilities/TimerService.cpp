@@ -0,0 +1,395 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Timer service
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TimerService.h"
+#include "EventTimer.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/**
+ * Is the first timestamp before the second timestamp?
+ * The timestamps may wrap around, as long as they differ by less than 2^31 ms.
+ *
+ * @param[in] first     First timestamp in ms
+ * @param[in] second    Second timestamp in ms
+ *
+ * @return If the first timestamp is before the second, it will return true otherwise false.
+ */
+static inline bool isBefore(uint32_t first, uint32_t second);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void TimerService::start(EventTimer& timer, uint32_t duration)
+{
+    uint32_t timestamp = MonoTime::getMillis();
+
+    lock();
+
+    remove(timer);
+
+    /* An empty wheel doesn't need to catch up, it continues at the current time. */
+    if (0U == m_count)
+    {
+        m_tick = timestamp;
+    }
+
+    timer.m_duration    = duration;
+    timer.m_deadline    = timestamp + duration;
+    timer.m_isRunning   = true;
+
+    insert(timer);
+    ++m_count;
+
+    unlock();
+
+    return;
+}
+
+void TimerService::stop(EventTimer& timer)
+{
+    lock();
+
+    remove(timer);
+    timer.m_isRunning = false;
+
+    unlock();
+
+    return;
+}
+
+void TimerService::process(uint32_t timestamp)
+{
+    EventTimer* timer = nullptr;
+
+    lock();
+
+    /* The timed out timers are moved to the pending list first, which
+     * ensures that a timer restarted by its listener is notified not
+     * again in the same call.
+     */
+    while((0U < m_count) &&
+          (false == isBefore(timestamp, m_tick)))
+    {
+        uint32_t    index       = m_tick & (SLOTS - 1U);
+        List&       slot        = m_wheel[0U][index];
+        uint32_t    occupied    = 0U;
+        uint32_t    step        = 0U;
+        uint32_t    distance    = 0U;
+
+        if (0U == index)
+        {
+            cascade();
+        }
+
+        while(nullptr != slot.head)
+        {
+            timer = slot.head;
+
+            unlink(*timer);
+            append(m_pending, *timer);
+            --m_count;
+        }
+
+        m_occupied[0U] &= ~(1U << index);
+
+        /* Skip the empty slots up to the end of the turn at once. */
+        occupied = m_occupied[0U] >> index;
+
+        if (0U == occupied)
+        {
+            step = SLOTS - index;
+        }
+        else
+        {
+            step = static_cast<uint32_t>(__builtin_ctz(occupied));
+        }
+
+        distance = timestamp - m_tick + 1U;
+
+        if (distance < step)
+        {
+            step = distance;
+        }
+
+        m_tick += step;
+    }
+
+    unlock();
+
+    do
+    {
+        lock();
+
+        timer = m_pending.head;
+
+        if (nullptr != timer)
+        {
+            unlink(*timer);
+            timer->m_isRunning = false;
+        }
+
+        unlock();
+
+        /* The listener is notified without lock, which allows it to start
+         * or stop any timer.
+         */
+        if (nullptr != timer)
+        {
+            timer->m_listener.onTimeout(*timer);
+        }
+    }
+    while(nullptr != timer);
+
+    return;
+}
+
+uint32_t TimerService::getNumOfRunningTimers()
+{
+    uint32_t count = 0U;
+
+    lock();
+    count = m_count;
+    unlock();
+
+    return count;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+TimerService::~TimerService()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+#endif  /* NATIVE */
+}
+
+void TimerService::insert(EventTimer& timer)
+{
+    uint32_t    delta   = timer.m_deadline - m_tick;
+    uint32_t    expires = timer.m_deadline;
+    uint32_t    level   = 0U;
+    uint32_t    index   = 0U;
+
+    /* A deadline in the past times out with the next processed tick. */
+    if (0 > static_cast<int32_t>(delta))
+    {
+        delta   = 0U;
+        expires = m_tick;
+    }
+    /* A deadline out of range is parked at the end of the wheel. */
+    else if (RANGE <= delta)
+    {
+        delta   = RANGE - 1U;
+        expires = m_tick + delta;
+    }
+    else
+    {
+        ;
+    }
+
+    while(((level + 1U) < LEVELS) &&
+          ((1U << (LEVEL_BITS * (level + 1U))) <= delta))
+    {
+        ++level;
+    }
+
+    index = (expires >> (LEVEL_BITS * level)) & (SLOTS - 1U);
+
+    append(m_wheel[level][index], timer);
+    m_occupied[level] |= 1U << index;
+
+    return;
+}
+
+void TimerService::remove(EventTimer& timer)
+{
+    if (nullptr != timer.m_list)
+    {
+        if (&m_pending != timer.m_list)
+        {
+            --m_count;
+        }
+
+        unlink(timer);
+    }
+
+    return;
+}
+
+void TimerService::cascade()
+{
+    uint32_t level = 1U;
+    uint32_t index = 0U;
+
+    /* A level continues its turn, only if the level below completed its turn. */
+    do
+    {
+        index = (m_tick >> (LEVEL_BITS * level)) & (SLOTS - 1U);
+
+        List& slot = m_wheel[level][index];
+
+        while(nullptr != slot.head)
+        {
+            EventTimer* timer = slot.head;
+
+            unlink(*timer);
+            insert(*timer);
+        }
+
+        m_occupied[level] &= ~(1U << index);
+        ++level;
+    }
+    while((0U == index) && (LEVELS > level));
+
+    return;
+}
+
+void TimerService::append(List& list, EventTimer& timer)
+{
+    timer.m_list = &list;
+    timer.m_prev = list.tail;
+    timer.m_next = nullptr;
+
+    if (nullptr == list.tail)
+    {
+        list.head = &timer;
+    }
+    else
+    {
+        list.tail->m_next = &timer;
+    }
+
+    list.tail = &timer;
+
+    return;
+}
+
+void TimerService::unlink(EventTimer& timer)
+{
+    List* list = timer.m_list;
+
+    if (nullptr != list)
+    {
+        if (nullptr == timer.m_prev)
+        {
+            list->head = timer.m_next;
+        }
+        else
+        {
+            timer.m_prev->m_next = timer.m_next;
+        }
+
+        if (nullptr == timer.m_next)
+        {
+            list->tail = timer.m_prev;
+        }
+        else
+        {
+            timer.m_next->m_prev = timer.m_prev;
+        }
+
+        timer.m_prev = nullptr;
+        timer.m_next = nullptr;
+        timer.m_list = nullptr;
+    }
+
+    return;
+}
+
+void TimerService::lock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
+void TimerService::unlock()
+{
+#ifndef NATIVE
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGive(m_xMutex);
+    }
+#endif  /* NATIVE */
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+static inline bool isBefore(uint32_t first, uint32_t second)
+{
+    return (0 > static_cast<int32_t>(first - second)) ? true : false;
+}
@@ -0,0 +1,241 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Timer service
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __TIMERSERVICE_H__
+#define __TIMERSERVICE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <MonoTime.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class EventTimer;
+
+/**
+ * The timer service manages all running event timers in a hierarchical
+ * timing wheel. Starting and stopping a timer costs constant time,
+ * independent of the number of running timers.
+ *
+ * The wheel has several levels with a fixed number of slots each. A slot of
+ * the first level covers one millisecond, a slot of every further level
+ * covers a whole turn of the level below. A timer is put into the level,
+ * whose range covers its deadline. Whenever a level completed a turn, the
+ * timers of the next slot above are distributed into the lower levels again.
+ * Deadlines beyond the range of the wheel are parked in the last level and
+ * redistributed until they come into range.
+ *
+ * The timers may be started and stopped by any task, but the listeners are
+ * notified in the context of the task, which calls process().
+ *
+ * The wheel runs on the 32-bit ms view of the monotonic time base. It
+ * compares only differences of timestamps, therefore it continues after
+ * the wrap around.
+ */
+class TimerService
+{
+public:
+
+    /**
+     * Get the timer service instance.
+     *
+     * @return Timer service
+     */
+    static TimerService& getInstance()
+    {
+        static TimerService instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the timer. If the timer is running, it will be restarted with
+     * the new duration.
+     *
+     * @param[in] timer     Event timer
+     * @param[in] duration  Duration in ms
+     */
+    void start(EventTimer& timer, uint32_t duration);
+
+    /**
+     * Stop the timer.
+     *
+     * @param[in] timer Event timer
+     */
+    void stop(EventTimer& timer);
+
+    /**
+     * Notify the listeners of all timers, which timed out. Every timer is
+     * stopped, before its listener is notified. A timer, which is stopped
+     * or restarted before its listener is notified, is not notified.
+     *
+     * @param[in] timestamp Current timestamp in ms, see MonoTime::getMillis()
+     */
+    void process(uint32_t timestamp);
+
+    /**
+     * Get number of running timers.
+     *
+     * @return Number of running timers
+     */
+    uint32_t getNumOfRunningTimers();
+
+    /** Number of bits of the timestamp, which select the slot of one level. */
+    static const uint32_t   LEVEL_BITS  = 5U;
+
+    /** Number of slots per level. */
+    static const uint32_t   SLOTS       = 1U << LEVEL_BITS;
+
+    /** Number of levels. */
+    static const uint32_t   LEVELS      = 5U;
+
+    /** Range of the wheel in ms. Later deadlines are redistributed, until they are in range. */
+    static const uint32_t   RANGE       = 1U << (LEVEL_BITS * LEVELS);
+
+private:
+
+    /**
+     * Double linked list of timers.
+     */
+    struct List
+    {
+        EventTimer* head;   /**< First timer */
+        EventTimer* tail;   /**< Last timer */
+    };
+
+    List                m_wheel[LEVELS][SLOTS]; /**< Timing wheel, every slot contains the timers with the same deadline range. */
+    uint32_t            m_occupied[LEVELS];     /**< Per level one bit per slot, which may contain timers. */
+    uint32_t            m_tick;                 /**< Next timestamp in ms, which will be processed. */
+    uint32_t            m_count;                /**< Number of timers in the wheel. */
+    List                m_pending;              /**< Timed out timers, whose listener is not notified yet. */
+
+#ifndef NATIVE
+    SemaphoreHandle_t   m_xMutex;               /**< Mutex to protect against concurrent access. */
+#endif  /* NATIVE */
+
+    /**
+     * Constructs the timer service.
+     */
+    TimerService() :
+        m_wheel(),
+        m_occupied(),
+        m_tick(MonoTime::getMillis()),
+        m_count(0U),
+        m_pending()
+#ifndef NATIVE
+        ,
+        m_xMutex(xSemaphoreCreateMutex())
+#endif  /* NATIVE */
+    {
+    }
+
+    /**
+     * Destroys the timer service.
+     */
+    ~TimerService();
+
+    /* Prevent copying */
+    TimerService(const TimerService&);
+    TimerService& operator=(const TimerService&);
+
+    /**
+     * Insert a timer into the slot of the wheel, which covers its deadline.
+     * It must not be in any list.
+     *
+     * @param[in] timer Event timer
+     */
+    void insert(EventTimer& timer);
+
+    /**
+     * Remove a timer from the wheel or from the list of timed out timers,
+     * if its in one of them.
+     *
+     * @param[in] timer Event timer
+     */
+    void remove(EventTimer& timer);
+
+    /**
+     * Redistribute the timers of the current slots of the upper levels,
+     * after the first level completed a turn.
+     */
+    void cascade();
+
+    /**
+     * Append a timer to the end of a list.
+     *
+     * @param[in,out] list  List
+     * @param[in]     timer Event timer
+     */
+    static void append(List& list, EventTimer& timer);
+
+    /**
+     * Unlink a timer from the list, it is in.
+     *
+     * @param[in] timer Event timer
+     */
+    static void unlink(EventTimer& timer);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock();
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock();
+
+    friend class EventTimer;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TIMERSERVICE_H__ */
+
+/** @} */
\ No newline at end of file
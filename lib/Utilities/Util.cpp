@@ -47,6 +47,15 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Mapping of a unicode code point to a Windows-1252 character.
+ */
+struct Cp1252Mapping
+{
+    uint16_t    codePoint;  /**< Unicode code point */
+    uint8_t     code;       /**< Windows-1252 character code */
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -55,6 +64,67 @@
  * Local Variables
  *****************************************************************************/
 
+/**
+ * Windows-1252 characters in the range 0x80 - 0x9F, which differ from Latin-1.
+ */
+static const Cp1252Mapping  gCp1252Mappings[] =
+{
+    { 0x20ACU, 0x80U }, /* Euro sign */
+    { 0x201AU, 0x82U }, /* Single low-9 quotation mark */
+    { 0x0192U, 0x83U }, /* Latin small letter f with hook */
+    { 0x201EU, 0x84U }, /* Double low-9 quotation mark */
+    { 0x2026U, 0x85U }, /* Horizontal ellipsis */
+    { 0x2020U, 0x86U }, /* Dagger */
+    { 0x2021U, 0x87U }, /* Double dagger */
+    { 0x02C6U, 0x88U }, /* Modifier letter circumflex accent */
+    { 0x2030U, 0x89U }, /* Per mille sign */
+    { 0x0160U, 0x8AU }, /* Latin capital letter S with caron */
+    { 0x2039U, 0x8BU }, /* Single left-pointing angle quotation mark */
+    { 0x0152U, 0x8CU }, /* Latin capital ligature OE */
+    { 0x017DU, 0x8EU }, /* Latin capital letter Z with caron */
+    { 0x2018U, 0x91U }, /* Left single quotation mark */
+    { 0x2019U, 0x92U }, /* Right single quotation mark */
+    { 0x201CU, 0x93U }, /* Left double quotation mark */
+    { 0x201DU, 0x94U }, /* Right double quotation mark */
+    { 0x2022U, 0x95U }, /* Bullet */
+    { 0x2013U, 0x96U }, /* En dash */
+    { 0x2014U, 0x97U }, /* Em dash */
+    { 0x02DCU, 0x98U }, /* Small tilde */
+    { 0x2122U, 0x99U }, /* Trade mark sign */
+    { 0x0161U, 0x9AU }, /* Latin small letter s with caron */
+    { 0x203AU, 0x9BU }, /* Single right-pointing angle quotation mark */
+    { 0x0153U, 0x9CU }, /* Latin small ligature oe */
+    { 0x017EU, 0x9EU }, /* Latin small letter z with caron */
+    { 0x0178U, 0x9FU }  /* Latin capital letter Y with diaeresis */
+};
+
+/** Hex digits, indexed by nibble value. */
+static const char   gHexDigits[]    = "0123456789abcdef";
+
+/**
+ * Nibble value, indexed by character. Characters, which are no hex digit,
+ * are marked with -1.
+ */
+static const int8_t gHexNibbles[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x00 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x10 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x20 */
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1, /* 0x30 */
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x40 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x50 */
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x60 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x70 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x80 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0x90 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0xA0 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0xB0 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0xC0 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0xD0 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 0xE0 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1  /* 0xF0 */
+};
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -71,89 +141,101 @@
  * External Functions
  *****************************************************************************/
 
-extern bool Util::strToUInt8(const String& str, uint8_t& value)
+extern bool Util::strToUInt8(const char* str, uint8_t& value)
 {
     bool            success = false;
     char*           endPtr  = nullptr;
     unsigned long   tmp     = 0UL;
 
-    errno = 0;
-    tmp = strtoul(str.c_str(), &endPtr, 0);
-
-    if ((0 == errno) &&
-        (nullptr != endPtr) &&
-        ('\0' == *endPtr) &&
-        (str.c_str() != endPtr) &&
-        (UINT8_MAX >= tmp))
+    if (nullptr != str)
     {
-        value = static_cast<uint8_t>(tmp);
-        success = true;
+        errno = 0;
+        tmp = strtoul(str, &endPtr, 0);
+
+        if ((0 == errno) &&
+            (nullptr != endPtr) &&
+            ('\0' == *endPtr) &&
+            (str != endPtr) &&
+            (UINT8_MAX >= tmp))
+        {
+            value = static_cast<uint8_t>(tmp);
+            success = true;
+        }
     }
 
     return success;
 }
 
-extern bool Util::strToUInt16(const String& str, uint16_t& value)
+extern bool Util::strToUInt16(const char* str, uint16_t& value)
 {
     bool            success = false;
     char*           endPtr  = nullptr;
     unsigned long   tmp     = 0UL;
 
-    errno = 0;
-    tmp = strtoul(str.c_str(), &endPtr, 0);
-
-    if ((0 == errno) &&
-        (nullptr != endPtr) &&
-        ('\0' == *endPtr) &&
-        (str.c_str() != endPtr) &&
-        (UINT16_MAX >= tmp))
+    if (nullptr != str)
     {
-        value = static_cast<uint16_t>(tmp);
-        success = true;
+        errno = 0;
+        tmp = strtoul(str, &endPtr, 0);
+
+        if ((0 == errno) &&
+            (nullptr != endPtr) &&
+            ('\0' == *endPtr) &&
+            (str != endPtr) &&
+            (UINT16_MAX >= tmp))
+        {
+            value = static_cast<uint16_t>(tmp);
+            success = true;
+        }
     }
 
     return success;
 }
 
-extern bool Util::strToInt32(const String& str, int32_t& value)
+extern bool Util::strToInt32(const char* str, int32_t& value)
 {
-    bool    success = false;
-    char*   endPtr  = nullptr;
-    long    tmp     = 0L;
-
-    errno = 0;
-    tmp = strtol(str.c_str(), &endPtr, 0);
-
-    if ((0 == errno) &&
-        (nullptr != endPtr) &&
-        ('\0' == *endPtr) &&
-        (str.c_str() != endPtr) &&
-        (INT32_MAX >= tmp))
+    bool            success = false;
+    char*           endPtr  = nullptr;
+    long            tmp     = 0L;
+
+    if (nullptr != str)
     {
-        value = static_cast<int32_t>(tmp);
-        success = true;
+        errno = 0;
+        tmp = strtol(str, &endPtr, 0);
+
+        if ((0 == errno) &&
+            (nullptr != endPtr) &&
+            ('\0' == *endPtr) &&
+            (str != endPtr) &&
+            (INT32_MAX >= tmp))
+        {
+            value = static_cast<int32_t>(tmp);
+            success = true;
+        }
     }
 
     return success;
 }
 
-extern bool Util::strToUInt32(const String& str, uint32_t& value)
+extern bool Util::strToUInt32(const char* str, uint32_t& value)
 {
     bool            success = false;
     char*           endPtr  = nullptr;
     unsigned long   tmp     = 0UL;
 
-    errno = 0;
-    tmp = strtoul(str.c_str(), &endPtr, 0);
-
-    if ((0 == errno) &&
-        (nullptr != endPtr) &&
-        ('\0' == *endPtr) &&
-        (str.c_str() != endPtr) &&
-        (UINT32_MAX >= tmp))
+    if (nullptr != str)
     {
-        value = static_cast<uint32_t>(tmp);
-        success = true;
+        errno = 0;
+        tmp = strtoul(str, &endPtr, 0);
+
+        if ((0 == errno) &&
+            (nullptr != endPtr) &&
+            ('\0' == *endPtr) &&
+            (str != endPtr) &&
+            (UINT32_MAX >= tmp))
+        {
+            value = static_cast<uint32_t>(tmp);
+            success = true;
+        }
     }
 
     return success;
@@ -163,52 +245,191 @@ extern String Util::uint32ToHex(uint32_t value)
 {
     char buffer[9];  /* Contains a 32-bit value in hex */
 
-    (void)snprintf(buffer, UTIL_ARRAY_NUM(buffer), "%x", value);
+    (void)uint32ToHex(value, buffer, UTIL_ARRAY_NUM(buffer));
 
     return String(buffer);
 }
 
-extern uint32_t Util::hexToUInt32(const String& str)
+extern size_t Util::uint32ToHex(uint32_t value, char* buffer, size_t size)
+{
+    char    digits[8];  /* Hex digits in reverse order */
+    size_t  count   = 0U;
+    size_t  index   = 0U;
+
+    /* Convert at least one digit, leading zeros are suppressed. */
+    do
+    {
+        digits[count] = gHexDigits[value & 0x0fU];
+        value >>= 4U;
+        ++count;
+    }
+    while(0U != value);
+
+    if ((nullptr == buffer) ||
+        (count >= size))
+    {
+        count = 0U;
+    }
+    else
+    {
+        for(index = 0U; index < count; ++index)
+        {
+            buffer[index] = digits[count - index - 1U];
+        }
+
+        buffer[count] = '\0';
+    }
+
+    return count;
+}
+
+extern uint32_t Util::hexToUInt32(const char* str, size_t length)
 {
     uint32_t    value   = 0U;
-    uint32_t    idx     = 0U;
+    size_t      idx     = 0U;
     bool        isError = false;
 
-    if ((0U != str.startsWith("0x")) ||
-        (0U != str.startsWith("0X")))
+    if (nullptr == str)
+    {
+        length = 0U;
+    }
+    else if ((2U <= length) &&
+             ('0' == str[0]) &&
+             (('x' == str[1]) || ('X' == str[1])))
     {
         idx = 2U;
     }
+    else
+    {
+        ;
+    }
+
+    while((length > idx) && (false == isError))
+    {
+        const int8_t NIBBLE = gHexNibbles[static_cast<uint8_t>(str[idx])];
+
+        if (0 > NIBBLE)
+        {
+            value = 0U;
+            isError = true;
+        }
+        else
+        {
+            value = (value << 4U) | static_cast<uint32_t>(NIBBLE);
+        }
+
+        ++idx;
+    }
 
-    while((str.length() > idx) && (false == isError))
+    return value;
+}
+
+extern String Util::utf8ToCp1252(const String& str)
+{
+    /* Smallest code point per sequence length, to detect overlong encodings. */
+    const uint32_t  MIN_CODE_POINT[]    = { 0U, 0U, 0x80U, 0x800U, 0x10000U };
+    String          result;
+    uint32_t        index               = 0U;
+    uint32_t        length              = str.length();
+
+    while(length > index)
     {
-        value *= 16U;
+        const uint8_t   LEAD        = static_cast<uint8_t>(str[index]);
+        uint32_t        codePoint   = 0U;
+        uint8_t         seqLength   = 0U;
+        uint8_t         seqIndex    = 0U;
+        bool            isValid     = true;
 
-        if (('0' <= str[idx]) &&
-            ('9' >= str[idx]))
+        if (0x80U > LEAD)
         {
-            value += static_cast<uint32_t>(str[idx] - '0');
+            codePoint   = LEAD;
+            seqLength   = 1U;
         }
-        else if (('a' <= str[idx]) &&
-                 ('f' >= str[idx]))
+        else if (0xC0U == (LEAD & 0xE0U))
         {
-            value += static_cast<uint32_t>(str[idx] - 'a') + 10U;
+            codePoint   = LEAD & 0x1FU;
+            seqLength   = 2U;
         }
-        else if (('A' <= str[idx]) &&
-                 ('F' >= str[idx]))
+        else if (0xE0U == (LEAD & 0xF0U))
         {
-            value += static_cast<uint32_t>(str[idx] - 'A') + 10U;
+            codePoint   = LEAD & 0x0FU;
+            seqLength   = 3U;
+        }
+        else if (0xF0U == (LEAD & 0xF8U))
+        {
+            codePoint   = LEAD & 0x07U;
+            seqLength   = 4U;
         }
         else
         {
-            value = 0U;
-            isError = true;
+            isValid = false;
         }
 
-        ++idx;
+        /* All following bytes must be continuation bytes. */
+        for(seqIndex = 1U; (true == isValid) && (seqIndex < seqLength); ++seqIndex)
+        {
+            if ((index + seqIndex) >= length)
+            {
+                isValid = false;
+            }
+            else
+            {
+                const uint8_t CONTINUATION = static_cast<uint8_t>(str[index + seqIndex]);
+
+                if (0x80U != (CONTINUATION & 0xC0U))
+                {
+                    isValid = false;
+                }
+                else
+                {
+                    codePoint <<= 6U;
+                    codePoint |= CONTINUATION & 0x3FU;
+                }
+            }
+        }
+
+        if (false == isValid)
+        {
+            result += static_cast<char>(LEAD);
+            ++index;
+        }
+        else
+        {
+            char code = '?';
+
+            /* An overlong encoding must not be decoded, e.g. C0 80 would be a
+             * NUL or C0 AF a '/'. It is replaced like an unknown character.
+             */
+            if (MIN_CODE_POINT[seqLength] > codePoint)
+            {
+                code = '?';
+            }
+            /* ASCII and Latin-1 are equal in Windows-1252, except the C1 control characters. */
+            else if ((0x80U > codePoint) ||
+                ((0xA0U <= codePoint) && (0xFFU >= codePoint)))
+            {
+                code = static_cast<char>(codePoint);
+            }
+            else
+            {
+                uint8_t mappingIndex = 0U;
+
+                for(mappingIndex = 0U; mappingIndex < UTIL_ARRAY_NUM(gCp1252Mappings); ++mappingIndex)
+                {
+                    if (gCp1252Mappings[mappingIndex].codePoint == codePoint)
+                    {
+                        code = static_cast<char>(gCp1252Mappings[mappingIndex].code);
+                        break;
+                    }
+                }
+            }
+
+            result += code;
+            index += seqLength;
+        }
     }
 
-    return value;
+    return result;
 }
 
 /******************************************************************************
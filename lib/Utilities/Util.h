@@ -44,6 +44,8 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
 #include <WString.h>
 #include <cerrno>
 
@@ -78,7 +80,21 @@ namespace Util
  *
  * @return If conversion fails, it will return false otherwise true.
  */
-extern bool strToUInt8(const String& str, uint8_t& value);
+extern bool strToUInt8(const char* str, uint8_t& value);
+
+/**
+ * Convert a string to uint8_t. String can contain integer number in decimal
+ * or hexadecimal format.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
+inline bool strToUInt8(const String& str, uint8_t& value)
+{
+    return strToUInt8(str.c_str(), value);
+}
 
 /**
  * Convert a string to uint16_t. String can contain integer number in decimal
@@ -89,7 +105,21 @@ extern bool strToUInt8(const String& str, uint8_t& value);
  *
  * @return If conversion fails, it will return false otherwise true.
  */
-extern bool strToUInt16(const String& str, uint16_t& value);
+extern bool strToUInt16(const char* str, uint16_t& value);
+
+/**
+ * Convert a string to uint16_t. String can contain integer number in decimal
+ * or hexadecimal format.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
+inline bool strToUInt16(const String& str, uint16_t& value)
+{
+    return strToUInt16(str.c_str(), value);
+}
 
 /**
  * Convert a string to uint32_t. String can contain integer number in decimal
@@ -104,7 +134,32 @@ extern bool strToUInt16(const String& str, uint16_t& value);
  *
  * @return If conversion fails, it will return false otherwise true.
  */
-extern bool strToUInt32(const String& str, uint32_t& value);
+extern bool strToUInt32(const char* str, uint32_t& value);
+
+/**
+ * Convert a string to uint32_t. String can contain integer number in decimal
+ * or hexadecimal format.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
+inline bool strToUInt32(const String& str, uint32_t& value)
+{
+    return strToUInt32(str.c_str(), value);
+}
+
+/**
+ * Convert a string to int32_t. String can contain integer number in decimal
+ * or hexadecimal format.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
+extern bool strToInt32(const char* str, int32_t& value);
 
 /**
  * Convert a string to int32_t. String can contain integer number in decimal
@@ -115,7 +170,10 @@ extern bool strToUInt32(const String& str, uint32_t& value);
  *
  * @return If conversion fails, it will return false otherwise true.
  */
-extern bool strToInt32(const String& str, int32_t& value);
+inline bool strToInt32(const String& str, int32_t& value)
+{
+    return strToInt32(str.c_str(), value);
+}
 
 /**
  * Convert uint32_t to hex string, but without "0x" as prefix.
@@ -126,6 +184,44 @@ extern bool strToInt32(const String& str, int32_t& value);
  */
 extern String uint32ToHex(uint32_t value);
 
+/**
+ * Convert uint32_t to hex string, but without "0x" as prefix. The result is
+ * written to the buffer of the caller, which avoids any heap allocation.
+ * A buffer of 9 characters is always sufficient.
+ *
+ * @param[in]   value   Value to convert
+ * @param[out]  buffer  Buffer for the null-terminated hex string
+ * @param[in]   size    Buffer size in bytes
+ *
+ * @return Number of written characters, without the string termination.
+ *         If the buffer is too small, it will return 0.
+ */
+extern size_t uint32ToHex(uint32_t value, char* buffer, size_t size);
+
+/**
+ * Convert hex string to uint32_t. String may has the prefix "0x" or not.
+ * If conversion fails, it will return 0.
+ *
+ * @param[in] str       Characters which contain a hex number, no termination required
+ * @param[in] length    Number of characters
+ *
+ * @return 32 bit unsigned integer value
+ */
+extern uint32_t hexToUInt32(const char* str, size_t length);
+
+/**
+ * Convert hex string to uint32_t. String may has the prefix "0x" or not.
+ * If conversion fails, it will return 0.
+ *
+ * @param[in] str   Null-terminated string which contains a hex number
+ *
+ * @return 32 bit unsigned integer value
+ */
+inline uint32_t hexToUInt32(const char* str)
+{
+    return hexToUInt32(str, (nullptr == str) ? 0U : strlen(str));
+}
+
 /**
  * Convert hex string to uint32_t. String may has the prefix "0x" or not.
  * If conversion fails, it will return 0.
@@ -134,7 +230,23 @@ extern String uint32ToHex(uint32_t value);
  *
  * @return 32 bit unsigned integer value
  */
-extern uint32_t hexToUInt32(const String& str);
+inline uint32_t hexToUInt32(const String& str)
+{
+    return hexToUInt32(str.c_str(), str.length());
+}
+
+/**
+ * Convert a UTF-8 string to Windows-1252, which is the character set of the
+ * fonts. Characters, which are not available in Windows-1252 are replaced
+ * by a '?'. An overlong encoded sequence (e.g. C0 80) is replaced by a '?'
+ * too, instead of decoding it. A byte, which is not part of a valid UTF-8
+ * sequence, is taken as it is.
+ *
+ * @param[in] str   UTF-8 string
+ *
+ * @return Windows-1252 string
+ */
+extern String utf8ToCp1252(const String& str);
 
 }
 
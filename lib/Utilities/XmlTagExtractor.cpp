@@ -0,0 +1,245 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming XML tag value extractor
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "XmlTagExtractor.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isWhitespace(char c);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool XmlTagExtractor::setTag(const char* tag)
+{
+    bool isSuccessful = false;
+
+    if (nullptr != tag)
+    {
+        size_t length = strlen(tag);
+
+        if ((0U < length) &&
+            (MAX_TAG_LENGTH >= length))
+        {
+            memcpy(m_tag, tag, length + 1U);
+            m_tagLength = length;
+
+            isSuccessful = true;
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        m_tag[0U]   = '\0';
+        m_tagLength = 0U;
+    }
+
+    reset();
+
+    return isSuccessful;
+}
+
+void XmlTagExtractor::parse(const uint8_t* data, size_t size)
+{
+    size_t idx = 0U;
+
+    if ((nullptr != data) &&
+        (0U < m_tagLength))
+    {
+        while((size > idx) &&
+              (STATE_FOUND != m_state) &&
+              (STATE_OVERFLOW != m_state))
+        {
+            handle(static_cast<char>(data[idx]));
+            ++idx;
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void XmlTagExtractor::handle(char c)
+{
+    switch(m_state)
+    {
+    case STATE_SEARCH:
+        search(c);
+        break;
+
+    case STATE_ATTRIBUTES:
+        if ('>' == c)
+        {
+            /* A empty element has no value. */
+            if ('/' == m_lastChar)
+            {
+                m_state = STATE_FOUND;
+            }
+            else
+            {
+                m_state = STATE_VALUE;
+            }
+        }
+
+        m_lastChar = c;
+        break;
+
+    case STATE_VALUE:
+        /* The value ends with the end tag or any other markup. */
+        if ('<' == c)
+        {
+            m_state = STATE_FOUND;
+        }
+        else if (MAX_VALUE_LENGTH <= m_valueLength)
+        {
+            m_valueLength   = 0U;
+            m_state         = STATE_OVERFLOW;
+        }
+        else
+        {
+            m_value[m_valueLength] = c;
+            ++m_valueLength;
+        }
+
+        m_value[m_valueLength] = '\0';
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+void XmlTagExtractor::search(char c)
+{
+    /* The start tag is matched completely, now it must end, otherwise
+     * it is just a tag, which starts with the same name.
+     */
+    if ((m_tagLength + 1U) == m_matchIdx)
+    {
+        m_matchIdx = 0U;
+
+        if ('>' == c)
+        {
+            m_state = STATE_VALUE;
+        }
+        else if (('/' == c) ||
+                 (true == isWhitespace(c)))
+        {
+            m_lastChar  = c;
+            m_state     = STATE_ATTRIBUTES;
+        }
+        else if ('<' == c)
+        {
+            m_matchIdx = 1U;
+        }
+        else
+        {
+            ;
+        }
+    }
+    else if (0U == m_matchIdx)
+    {
+        if ('<' == c)
+        {
+            m_matchIdx = 1U;
+        }
+    }
+    else if (m_tag[m_matchIdx - 1U] == c)
+    {
+        ++m_matchIdx;
+    }
+    /* The '<' appears only at the begin of the start tag, therefore
+     * a mismatch restarts the search there.
+     */
+    else if ('<' == c)
+    {
+        m_matchIdx = 1U;
+    }
+    else
+    {
+        m_matchIdx = 0U;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Is the character a whitespace?
+ *
+ * @param[in] c Character
+ *
+ * @return If whitespace, it will return true otherwise false.
+ */
+static bool isWhitespace(char c)
+{
+    return ((' ' == c) || ('\t' == c) || ('\r' == c) || ('\n' == c));
+}
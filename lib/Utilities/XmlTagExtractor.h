@@ -0,0 +1,183 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming XML tag value extractor
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __XMLTAGEXTRACTOR_H__
+#define __XMLTAGEXTRACTOR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The XML tag extractor gets the text content of the first element with
+ * a given tag name out of a XML or XML like text, which is fed in parts,
+ * e.g. directly from the TCP buffer. Only the tag name and the value are
+ * kept, the text itself is never buffered.
+ *
+ * Attributes of the element are skipped. The value ends with the next
+ * markup, i.e. nested elements are not supported. Entities are not decoded.
+ */
+class XmlTagExtractor
+{
+public:
+
+    /** Max. tag name length in characters */
+    static const size_t     MAX_TAG_LENGTH      = 31U;
+
+    /** Max. value length in characters */
+    static const size_t     MAX_VALUE_LENGTH    = 63U;
+
+    /**
+     * Constructs a extractor without tag name.
+     */
+    XmlTagExtractor() :
+        m_tag(),
+        m_tagLength(0U),
+        m_value(),
+        m_valueLength(0U),
+        m_state(STATE_SEARCH),
+        m_matchIdx(0U),
+        m_lastChar('\0')
+    {
+    }
+
+    /**
+     * Set the name of the tag, whose value shall be extracted.
+     * The extractor is reset.
+     *
+     * @param[in] tag   Tag name, e.g. "D_Y_10_1"
+     *
+     * @return If the tag name is valid, it will return true otherwise false.
+     */
+    bool setTag(const char* tag);
+
+    /**
+     * Reset the extractor for the next text. The tag name is kept.
+     */
+    void reset()
+    {
+        m_valueLength       = 0U;
+        m_value[0U]         = '\0';
+        m_state             = STATE_SEARCH;
+        m_matchIdx          = 0U;
+        m_lastChar          = '\0';
+    }
+
+    /**
+     * Feed the next part of the text.
+     *
+     * @param[in] data  Text part, doesn't need to be terminated.
+     * @param[in] size  Text part size in byte
+     */
+    void parse(const uint8_t* data, size_t size);
+
+    /**
+     * Is the complete value of the tag found?
+     *
+     * @return If found, it will return true otherwise false.
+     */
+    bool isFound() const
+    {
+        return (STATE_FOUND == m_state);
+    }
+
+    /**
+     * Get the value of the tag. It is only complete, if it is found.
+     *
+     * @return Terminated value
+     */
+    const char* getValue() const
+    {
+        return m_value;
+    }
+
+private:
+
+    /**
+     * Extractor states.
+     */
+    enum State
+    {
+        STATE_SEARCH = 0,   /**< Search the start tag */
+        STATE_ATTRIBUTES,   /**< Skip the attributes of the start tag */
+        STATE_VALUE,        /**< Collect the value */
+        STATE_FOUND,        /**< Value found, the rest is skipped */
+        STATE_OVERFLOW      /**< Value too long, the rest is skipped */
+    };
+
+    char        m_tag[MAX_TAG_LENGTH + 1U];     /**< Terminated tag name */
+    size_t      m_tagLength;                    /**< Tag name length in characters */
+    char        m_value[MAX_VALUE_LENGTH + 1U]; /**< Terminated value */
+    size_t      m_valueLength;                  /**< Value length in characters */
+    State       m_state;                        /**< Current state */
+    size_t      m_matchIdx;                     /**< Number of matched characters of the start tag, including the '<' */
+    char        m_lastChar;                     /**< Last character of the start tag, used to detect a empty element */
+
+    /**
+     * Handle a single character.
+     *
+     * @param[in] c Character
+     */
+    void handle(char c);
+
+    /**
+     * Search the start tag.
+     *
+     * @param[in] c Character
+     */
+    void search(char c);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __XMLTAGEXTRACTOR_H__ */
+
+/** @} */
@@ -0,0 +1,211 @@
+# MIT License
+# 
+# Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import os
+import re
+
+Import("env")
+
+# Font, which is used to render the messages. It must be the default font of the text widget.
+FONT_FILE = "lib/Gfx/TomThumb.h"
+
+# Generated source files
+DST_HEADER = "src/Common/SysMsgBitmaps.h"
+DST_SOURCE = "src/Common/SysMsgBitmaps.cpp"
+
+# Run layout, see lib/Gfx/RleBitmap.h
+LENGTH_BITS = 5
+MAX_RUN_LENGTH = (1 << LENGTH_BITS)
+MAX_PALETTE_SIZE = (255 >> LENGTH_BITS)
+
+# Default message color
+WHITE = 0xFFFFFF
+
+# Fixed system messages, which are pre-rendered into run-length encoded bitmaps.
+# Messages with dynamic parts, like an IP address, are not listed and shown by the text widget.
+# Bitmap name, list of (color, text) segments
+SYS_MSG_BITMAPS = [
+    ( "SYS_MSG_PIXELIX", [ (0xFF0000, "P"), (0x0FF000, "I"), (0x00FF00, "X"), (0x000FF0, "E"), (0x0000FF, "L"), (0xF0000F, "I"), (0xFF0000, "X") ] ),
+    ( "SYS_MSG_UPDATE", [ (WHITE, "Update") ] ),
+    ( "SYS_MSG_ELLIPSIS", [ (WHITE, "...") ] ),
+    ( "SYS_MSG_WIFI_MODE_FAILED", [ (WHITE, "Set wifi mode failed.") ] ),
+    ( "SYS_MSG_MDNS_FAILED", [ (WHITE, "Failed to setup mDNS.") ] ),
+    ( "SYS_MSG_AUTO_RECONNECT_FAILED", [ (WHITE, "Set autom. reconnect failed.") ] ),
+    ( "SYS_MSG_KEEP_BUTTON_PRESSED", [ (WHITE, "Keep button pressed and reboot. Set SSID/password via webserer.") ] ),
+    ( "SYS_MSG_AP_CONFIG_FAILED", [ (WHITE, "Configure wifi access point failed.") ] ),
+    ( "SYS_MSG_AP_HOSTNAME_FAILED", [ (WHITE, "Can't set AP hostname.") ] ),
+    ( "SYS_MSG_AP_SETUP_FAILED", [ (WHITE, "Setup wifi access point failed.") ] ),
+    ( "SYS_MSG_HEAP_FRAGMENTED", [ (WHITE, "Warning: Heap fragmented, plugins may fail.") ] ),
+    ( "SYS_MSG_OTA_AUTH_ERROR", [ (WHITE, "OTA - Authentication error.") ] ),
+    ( "SYS_MSG_OTA_BEGIN_ERROR", [ (WHITE, "OTA - Begin error.") ] ),
+    ( "SYS_MSG_OTA_CONNECT_ERROR", [ (WHITE, "OTA - Connect error.") ] ),
+    ( "SYS_MSG_OTA_RECEIVE_ERROR", [ (WHITE, "OTA - Receive error.") ] ),
+    ( "SYS_MSG_OTA_END_ERROR", [ (WHITE, "OTA - End error.") ] ),
+    ( "SYS_MSG_OTA_UNKNOWN_ERROR", [ (WHITE, "OTA - Unknown error.") ] )
+]
+
+def loadFont(fontFile):
+    with open(os.path.join(projectDir, fontFile), "r") as file:
+        content = file.read()
+
+    # Strip the comments, which contain the character names.
+    content = re.sub(r"/\*.*?\*/", "", content, flags=re.DOTALL)
+
+    bitmapArray = re.search(r"Bitmaps\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", content, re.DOTALL).group(1)
+    glyphArray = re.search(r"Glyphs\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", content, re.DOTALL).group(1)
+    fontInfo = re.search(r"GFXglyph\s*\*\s*\)\s*\w+,.*?(0x[0-9A-Fa-f]+)\s*,\s*(0x[0-9A-Fa-f]+)\s*,\s*(\d+)\s*\}", content, re.DOTALL)
+
+    bitmaps = [int(value, 16) for value in re.findall(r"0x[0-9A-Fa-f]+", bitmapArray)]
+    glyphs = [tuple(int(value) for value in entry.split(",")) for entry in re.findall(r"\{([^{}]*)\}", glyphArray)]
+
+    return {
+        "bitmaps": bitmaps,
+        "glyphs": glyphs,
+        "first": int(fontInfo.group(1), 16),
+        "yAdvance": int(fontInfo.group(3))
+    }
+
+# Render the text like the text widget does it, top aligned with the baseline
+# in the last line of the font height. Every pixel is the color index or 0.
+def render(font, segments):
+    pixels = {}
+    cursorX = 0
+    baseline = font["yAdvance"] - 1
+    palette = []
+
+    for color, text in segments:
+        if color not in palette:
+            palette.append(color)
+
+        colorIndex = palette.index(color) + 1
+
+        for character in text:
+            glyph = font["glyphs"][ord(character) - font["first"]]
+            offset, width, height, xAdvance, xOffset, yOffset = glyph
+            bit = 0
+
+            for yy in range(height):
+                for xx in range(width):
+                    value = font["bitmaps"][offset + (bit >> 3)]
+
+                    if (0 != (value & (0x80 >> (bit & 7)))):
+                        pixels[(cursorX + xOffset + xx, baseline + yOffset + yy)] = colorIndex
+
+                    bit += 1
+
+            cursorX += xAdvance
+
+    if (MAX_PALETTE_SIZE < len(palette)):
+        raise Exception("Too many colors.")
+
+    width = cursorX
+    height = max([font["yAdvance"]] + [y + 1 for (x, y) in pixels.keys()])
+
+    return width, height, palette, pixels
+
+def encode(width, height, pixels):
+    runs = []
+
+    for y in range(height):
+        x = 0
+
+        while (width > x):
+            colorIndex = pixels.get((x, y), 0)
+            length = 1
+
+            while ((width > (x + length)) and (MAX_RUN_LENGTH > length) and (colorIndex == pixels.get((x + length, y), 0))):
+                length += 1
+
+            runs.append((colorIndex << LENGTH_BITS) | (length - 1))
+            x += length
+
+    return runs
+
+def writeOnChange(dstFile, content):
+    dstFile = os.path.join(projectDir, dstFile)
+
+    # Write only on change, otherwise every build would recompile the users.
+    if (True == os.path.isfile(dstFile)):
+        with open(dstFile, "r") as file:
+            if (content == file.read()):
+                return
+
+    with open(dstFile, "w") as file:
+        file.write(content)
+
+    print("Generated: " + os.path.relpath(dstFile, projectDir))
+
+def generate():
+    font = loadFont(FONT_FILE)
+    guard = "__SYSMSGBITMAPS_H__"
+    header = []
+    source = []
+
+    header.append("/* Generated by renderSysMsg.py from " + FONT_FILE + ", don't edit. */")
+    header.append("")
+    header.append("#ifndef " + guard)
+    header.append("#define " + guard)
+    header.append("")
+    header.append("#include <RleBitmap.h>")
+    header.append("")
+
+    source.append("/* Generated by renderSysMsg.py from " + FONT_FILE + ", don't edit. */")
+    source.append("")
+    source.append("#include \"SysMsgBitmaps.h\"")
+    source.append("#include <pgmspace.h>")
+
+    for name, segments in SYS_MSG_BITMAPS:
+        width, height, palette, pixels = render(font, segments)
+        runs = encode(width, height, pixels)
+        text = "".join(text for color, text in segments)
+
+        header.append("/** \"" + text + "\" */")
+        header.append("extern const RleBitmap " + name + ";")
+        header.append("")
+
+        source.append("")
+        source.append("/* \"" + text + "\", " + str(width) + " x " + str(height) + " pixels */")
+        source.append("static const uint32_t " + name + "_PALETTE[] PROGMEM = {")
+        source.append("    " + ", ".join("0x%06x" % color for color in palette))
+        source.append("};")
+        source.append("")
+        source.append("static const uint8_t " + name + "_RUNS[] PROGMEM = {")
+
+        for index in range(0, len(runs), 16):
+            source.append("    " + ", ".join("0x%02x" % value for value in runs[index:index + 16]) + ",")
+
+        source.append("};")
+        source.append("")
+        source.append("const RleBitmap " + name + " = {")
+        source.append("    " + str(width) + "U, " + str(height) + "U, " + name + "_PALETTE, " + str(len(palette)) + "U, " + name + "_RUNS, sizeof(" + name + "_RUNS)")
+        source.append("};")
+
+    header.append("#endif  /* " + guard + " */")
+    header.append("")
+    source.append("")
+
+    writeOnChange(DST_HEADER, "\n".join(header))
+    writeOnChange(DST_SOURCE, "\n".join(source))
+
+projectDir = env.subst("$PROJECT_DIR")
+
+generate()
@@ -0,0 +1,138 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Asset store
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "AssetStore.h"
+
+#include <AssetPack.h>
+#include <Logging.h>
+#include <esp_partition.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Is the asset pack partition mapped? */
+static bool                     gIsMapped   = false;
+
+/** Handle of the mapped asset pack partition. */
+static spi_flash_mmap_handle_t  gMmapHandle = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern bool AssetStore::begin()
+{
+    if (false == gIsMapped)
+    {
+        const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, PARTITION_LABEL);
+
+        if (nullptr == partition)
+        {
+            LOG_INFO("No asset pack partition available.");
+        }
+        else
+        {
+            const void* data = nullptr;
+
+            /* The whole partition is mapped to the data address space, the
+             * flash cache loads only the pages, which are really accessed.
+             */
+            if (ESP_OK != esp_partition_mmap(partition, 0U, partition->size, SPI_FLASH_MMAP_DATA, &data, &gMmapHandle))
+            {
+                LOG_ERROR("Couldn't map the asset pack partition.");
+            }
+            else if (false == AssetPack::getInstance().attach(static_cast<const uint8_t*>(data), partition->size))
+            {
+                LOG_WARNING("Asset pack partition contains no valid asset pack.");
+
+                spi_flash_munmap(gMmapHandle);
+            }
+            else
+            {
+                LOG_INFO("Asset pack with %u images available.", AssetPack::getInstance().getCount());
+
+                gIsMapped = true;
+            }
+        }
+    }
+
+    return gIsMapped;
+}
+
+extern void AssetStore::end()
+{
+    if (true == gIsMapped)
+    {
+        AssetPack::getInstance().detach();
+        spi_flash_munmap(gMmapHandle);
+
+        gIsMapped = false;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
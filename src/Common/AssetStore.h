@@ -0,0 +1,89 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Asset store
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __ASSET_STORE_H__
+#define __ASSET_STORE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+/**
+ * The asset store maps the asset pack from its flash partition into the
+ * address space, so its images are used directly from flash. The partition
+ * is optional. It is a data partition with the label "assets", which is
+ * written with createAssetPack.py and esptool.
+ */
+namespace AssetStore
+{
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Label of the asset pack partition. */
+static const char   PARTITION_LABEL[]   = "assets";
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Map the asset pack partition and attach the asset pack.
+ *
+ * @return If the asset pack is available, it will return true otherwise false.
+ */
+extern bool begin();
+
+/**
+ * Detach the asset pack and unmap its partition.
+ * All images of the asset pack must be released before.
+ */
+extern void end();
+
+}
+
+#endif  /* __ASSET_STORE_H__ */
+
+/** @} */
\ No newline at end of file
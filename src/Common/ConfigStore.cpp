@@ -0,0 +1,797 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin configuration store
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ConfigStore.h"
+#include "FileIo.h"
+#include "FileSystem.h"
+
+#include <ConfigJournal.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool readFile(const String& fileName, String& content);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize configuration store constants */
+const char* ConfigStore::FILE_NAME      = "/configuration.jnl";
+const char* ConfigStore::TMP_FILE_NAME  = "/configuration.tmp";
+const char* ConfigStore::IMPORT_PATH    = "/configuration";
+
+/** Max. size in byte of a configuration file, which is imported. */
+static const size_t     MAX_IMPORT_FILE_SIZE    = 2048U;
+
+/** JSON document size in byte, used to compact a imported configuration. */
+static const size_t     IMPORT_JSON_DOC_SIZE    = 2048U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool ConfigStore::begin()
+{
+    bool status = true;
+
+    lock();
+
+    readJournal();
+    importFiles();
+
+    /* Changes by the import or a corrupt journal end are written at once. */
+    if (true == isDirty())
+    {
+        flush();
+    }
+
+    unlock();
+
+    if (nullptr == m_flushTaskHandle)
+    {
+        BaseType_t osRet = xTaskCreateUniversal(flushTask,
+                                                "cfgStoreTask",
+                                                FLUSH_TASK_STACK_SIZE,
+                                                this,
+                                                FLUSH_TASK_PRIORITY,
+                                                &m_flushTaskHandle,
+                                                tskNO_AFFINITY);
+
+        if (pdPASS != osRet)
+        {
+            m_flushTaskHandle   = nullptr;
+            status              = false;
+        }
+    }
+
+    return status;
+}
+
+void ConfigStore::flush()
+{
+    lock();
+
+    if (true == isDirty())
+    {
+        bool isWritten = false;
+
+        /* A new journal is written completely. */
+        if (0U == m_journalSize)
+        {
+            isWritten = rewriteJournal();
+        }
+        else
+        {
+            size_t      size    = 0U;
+            uint8_t*    buffer  = encode(false, true, size);
+
+            /* A too large journal is rewritten with the current
+             * configurations only, otherwise the changes are appended.
+             */
+            if (MAX_JOURNAL_SIZE < (m_journalSize + size))
+            {
+                isWritten = rewriteJournal();
+            }
+            else if (nullptr != buffer)
+            {
+                isWritten = appendJournal(buffer, size);
+            }
+            else
+            {
+                ;
+            }
+
+            delete[] buffer;
+        }
+
+        if (false == isWritten)
+        {
+            LOG_ERROR("Couldn't write plugin configurations.");
+        }
+        else
+        {
+            markWritten();
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+bool ConfigStore::load(uint16_t uid, JsonDocument& doc)
+{
+    bool    status  = false;
+    Entry*  entry   = nullptr;
+
+    lock();
+
+    entry = findEntry(uid);
+
+    if ((nullptr != entry) &&
+        (false == entry->data.isEmpty()))
+    {
+        DeserializationError error = deserializeJson(doc, entry->data);
+
+        if (DeserializationError::Ok == error.code())
+        {
+            status = true;
+        }
+    }
+
+    unlock();
+
+    return status;
+}
+
+bool ConfigStore::save(uint16_t uid, const JsonDocument& doc)
+{
+    bool    status  = false;
+    String  data;
+
+    if (0U < serializeJson(doc, data))
+    {
+        lock();
+        status = setEntry(uid, data, true);
+        unlock();
+
+        if (true == status)
+        {
+            requestFlush();
+        }
+    }
+
+    return status;
+}
+
+void ConfigStore::remove(uint16_t uid)
+{
+    lock();
+
+    if (nullptr != findEntry(uid))
+    {
+        (void)setEntry(uid, "", true);
+        requestFlush();
+    }
+
+    unlock();
+
+    return;
+}
+
+bool ConfigStore::importFile(uint16_t uid, const String& fileName)
+{
+    bool    status  = false;
+    String  content;
+
+    if (true == readFile(fileName, content))
+    {
+        DynamicJsonDocument     jsonDoc(IMPORT_JSON_DOC_SIZE);
+        DeserializationError    error   = deserializeJson(jsonDoc, content);
+
+        if (DeserializationError::Ok != error.code())
+        {
+            LOG_WARNING("File %s is no valid configuration.", fileName.c_str());
+        }
+        else if (true == save(uid, jsonDoc))
+        {
+            LOG_INFO("File %s imported.", fileName.c_str());
+
+            (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+                [&fileName]() -> bool
+                {
+                    return FILESYSTEM.remove(fileName);
+                });
+
+            status = true;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ConfigStore::ConfigStore() :
+    m_entries(),
+    m_journalSize(0U),
+    m_xMutex(xSemaphoreCreateRecursiveMutex()),
+    m_flushTaskHandle(nullptr)
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        m_entries[index].uid        = 0U;
+        m_entries[index].isUsed     = false;
+        m_entries[index].isDirty    = false;
+    }
+}
+
+ConfigStore::~ConfigStore()
+{
+    if (nullptr != m_flushTaskHandle)
+    {
+        vTaskDelete(m_flushTaskHandle);
+        m_flushTaskHandle = nullptr;
+    }
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+void ConfigStore::readJournal()
+{
+    uint8_t*    buffer  = nullptr;
+    size_t      size    = 0U;
+
+    /* The whole journal is read at once. A interrupted rewrite may left
+     * only the temporary journal.
+     */
+    (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [&buffer, &size]() -> bool
+        {
+            bool isSuccessful = false;
+
+            if ((false == FILESYSTEM.exists(FILE_NAME)) &&
+                (true == FILESYSTEM.exists(TMP_FILE_NAME)))
+            {
+                (void)FILESYSTEM.rename(TMP_FILE_NAME, FILE_NAME);
+            }
+
+            File fd = FILESYSTEM.open(FILE_NAME, "r");
+
+            if (true == fd)
+            {
+                size    = fd.size();
+                buffer  = new uint8_t[size];
+
+                if ((nullptr != buffer) &&
+                    (size == fd.read(buffer, size)))
+                {
+                    isSuccessful = true;
+                }
+
+                fd.close();
+            }
+
+            return isSuccessful;
+        });
+
+    m_journalSize = 0U;
+
+    if ((nullptr != buffer) &&
+        (true == ConfigJournal::isHeaderValid(buffer, size)))
+    {
+        ConfigJournal::Entry    journalEntry;
+        size_t                  offset          = ConfigJournal::HEADER_SIZE;
+        size_t                  read            = 0U;
+
+        do
+        {
+            read = ConfigJournal::readEntry(&buffer[offset], size - offset, journalEntry);
+
+            if (0U < read)
+            {
+                String  data;
+                size_t  index   = 0U;
+
+                (void)data.reserve(journalEntry.size);
+
+                for(index = 0U; index < journalEntry.size; ++index)
+                {
+                    data += static_cast<char>(journalEntry.data[index]);
+                }
+
+                (void)setEntry(journalEntry.uid, data, false);
+
+                offset += read;
+            }
+        }
+        while((0U < read) && (size > offset));
+
+        m_journalSize = offset;
+
+        /* Ignore the corrupt journal end, which is removed by a rewrite. */
+        if (size > offset)
+        {
+            uint8_t index = 0U;
+
+            LOG_WARNING("Plugin configuration journal is corrupt at %u.", offset);
+
+            for(index = 0U; index < MAX_ENTRIES; ++index)
+            {
+                m_entries[index].isDirty = m_entries[index].isUsed;
+            }
+
+            m_journalSize = 0U;
+        }
+    }
+
+    delete[] buffer;
+
+    return;
+}
+
+void ConfigStore::importFiles()
+{
+    File dir;
+
+    /* The import directory is created, so a configuration file can be
+     * uploaded by the user.
+     */
+    (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [&dir]() -> bool
+        {
+            if (false == FILESYSTEM.exists(IMPORT_PATH))
+            {
+                (void)FILESYSTEM.mkdir(IMPORT_PATH);
+            }
+
+            dir = FILESYSTEM.open(IMPORT_PATH, "r");
+
+            return (true == dir);
+        });
+
+    if (true == dir)
+    {
+        String fileName;
+
+        do
+        {
+            fileName.clear();
+
+            (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+                [&dir, &fileName]() -> bool
+                {
+                    File fd = dir.openNextFile();
+
+                    if (true == fd)
+                    {
+                        fileName = fd.name();
+                        fd.close();
+                    }
+
+                    return (false == fileName.isEmpty());
+                });
+
+            if (false == fileName.isEmpty())
+            {
+                /* Depended on the filesystem, the name may contain the path. */
+                int         sep     = fileName.lastIndexOf('/');
+                String      name    = fileName.substring(sep + 1);
+                char*       end     = nullptr;
+                uint32_t    uid     = strtoul(name.c_str(), &end, 10);
+
+                if ((nullptr != end) &&
+                    (0 == strcmp(end, ".json")) &&
+                    (UINT16_MAX >= uid))
+                {
+                    (void)importFile(static_cast<uint16_t>(uid), String(IMPORT_PATH) + "/" + name);
+                }
+            }
+        }
+        while(false == fileName.isEmpty());
+
+        dir.close();
+    }
+
+    return;
+}
+
+bool ConfigStore::rewriteJournal()
+{
+    size_t      size    = 0U;
+    uint8_t*    buffer  = encode(true, false, size);
+    bool        status  = false;
+
+    if (nullptr != buffer)
+    {
+        /* The journal is replaced only after the temporary journal is
+         * written completely.
+         */
+        status = FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+            [buffer, size]() -> bool
+            {
+                bool    isSuccessful    = false;
+                File    fd              = FILESYSTEM.open(TMP_FILE_NAME, "w");
+
+                if (true == fd)
+                {
+                    isSuccessful = (size == fd.write(buffer, size));
+                    fd.close();
+
+                    if (true == isSuccessful)
+                    {
+                        (void)FILESYSTEM.remove(FILE_NAME);
+                        isSuccessful = FILESYSTEM.rename(TMP_FILE_NAME, FILE_NAME);
+                    }
+                }
+
+                return isSuccessful;
+            });
+
+        if (true == status)
+        {
+            m_journalSize = size;
+        }
+
+        delete[] buffer;
+    }
+
+    return status;
+}
+
+bool ConfigStore::appendJournal(const uint8_t* buffer, size_t size)
+{
+    bool status = FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [buffer, size]() -> bool
+        {
+            bool    isSuccessful    = false;
+            File    fd              = FILESYSTEM.open(FILE_NAME, "a");
+
+            if (true == fd)
+            {
+                isSuccessful = (size == fd.write(buffer, size));
+                fd.close();
+            }
+
+            return isSuccessful;
+        });
+
+    /* A partially appended entry fails its checksum and is dropped by the
+     * next start. The journal is rewritten next time to be safe.
+     */
+    if (true == status)
+    {
+        m_journalSize += size;
+    }
+    else
+    {
+        m_journalSize = 0U;
+    }
+
+    return status;
+}
+
+uint8_t* ConfigStore::encode(bool header, bool dirtyOnly, size_t& size) const
+{
+    uint8_t*    buffer  = nullptr;
+    size_t      offset  = 0U;
+    uint8_t     index   = 0U;
+
+    size = (true == header) ? ConfigJournal::HEADER_SIZE : 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        const Entry& entry = m_entries[index];
+
+        if ((true == entry.isUsed) &&
+            ((false == dirtyOnly) || (true == entry.isDirty)))
+        {
+            size += ConfigJournal::getEntrySize(entry.data.length());
+        }
+    }
+
+    if (0U < size)
+    {
+        buffer = new uint8_t[size];
+    }
+
+    if (nullptr != buffer)
+    {
+        if (true == header)
+        {
+            offset += ConfigJournal::writeHeader(buffer, size);
+        }
+
+        for(index = 0U; index < MAX_ENTRIES; ++index)
+        {
+            const Entry& entry = m_entries[index];
+
+            /* A removed configuration is written as entry without data. */
+            if ((true == entry.isUsed) &&
+                ((false == dirtyOnly) || (true == entry.isDirty)))
+            {
+                offset += ConfigJournal::writeEntry(entry.uid,
+                                                    reinterpret_cast<const uint8_t*>(entry.data.c_str()),
+                                                    entry.data.length(),
+                                                    &buffer[offset],
+                                                    size - offset);
+            }
+        }
+
+        /* A configuration, which is too large, is missing. */
+        size = offset;
+    }
+
+    return buffer;
+}
+
+void ConfigStore::markWritten()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        Entry& entry = m_entries[index];
+
+        entry.isDirty = false;
+
+        if (true == entry.data.isEmpty())
+        {
+            entry.isUsed = false;
+        }
+    }
+
+    return;
+}
+
+ConfigStore::Entry* ConfigStore::findEntry(uint16_t uid)
+{
+    Entry*  entry   = nullptr;
+    uint8_t index   = 0U;
+
+    while((nullptr == entry) && (MAX_ENTRIES > index))
+    {
+        if ((true == m_entries[index].isUsed) &&
+            (uid == m_entries[index].uid))
+        {
+            entry = &m_entries[index];
+        }
+
+        ++index;
+    }
+
+    return entry;
+}
+
+bool ConfigStore::setEntry(uint16_t uid, const String& data, bool isDirty)
+{
+    bool    status  = true;
+    Entry*  entry   = findEntry(uid);
+    uint8_t index   = 0U;
+
+    /* Use a free entry for a new configuration. */
+    while((nullptr == entry) && (MAX_ENTRIES > index))
+    {
+        if (false == m_entries[index].isUsed)
+        {
+            entry           = &m_entries[index];
+            entry->uid      = uid;
+            entry->isUsed   = true;
+            entry->isDirty  = false;
+        }
+
+        ++index;
+    }
+
+    if (nullptr == entry)
+    {
+        LOG_ERROR("No space for configuration of plugin %u.", uid);
+        status = false;
+    }
+    /* A configuration, which was removed in the journal, is released. */
+    else if ((false == isDirty) && (true == data.isEmpty()))
+    {
+        entry->data.clear();
+        entry->isUsed   = false;
+        entry->isDirty  = false;
+    }
+    /* A unchanged configuration is not written again. */
+    else if (data != entry->data)
+    {
+        entry->data     = data;
+        entry->isDirty  = entry->isDirty || isDirty;
+    }
+    else
+    {
+        ;
+    }
+
+    return status;
+}
+
+bool ConfigStore::isDirty() const
+{
+    bool    isDirty = false;
+    uint8_t index   = 0U;
+
+    while((false == isDirty) && (MAX_ENTRIES > index))
+    {
+        isDirty = m_entries[index].isDirty;
+        ++index;
+    }
+
+    return isDirty;
+}
+
+void ConfigStore::requestFlush()
+{
+    /* Without the flush task, the changes are written immediately. */
+    if (nullptr == m_flushTaskHandle)
+    {
+        flush();
+    }
+    else
+    {
+        xTaskNotifyGive(m_flushTaskHandle);
+    }
+
+    return;
+}
+
+void ConfigStore::flushTask(void* parameters)
+{
+    ConfigStore* store = static_cast<ConfigStore*>(parameters);
+
+    if (nullptr != store)
+    {
+        for(;;)
+        {
+            uint32_t firstChange = 0U;
+
+            /* Wait for the first change. */
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            firstChange = millis();
+
+            /* Further changes within the flush delay are coalesced, but the
+             * write is not postponed endless.
+             */
+            while((0U < ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FLUSH_DELAY))) &&
+                  (MAX_FLUSH_DELAY > (millis() - firstChange)))
+            {
+                /* Just wait ... */
+                ;
+            }
+
+            store->flush();
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void ConfigStore::lock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void ConfigStore::unlock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read a small file completely.
+ *
+ * @param[in]   fileName    Name of the file
+ * @param[out]  content     File content
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool readFile(const String& fileName, String& content)
+{
+    return FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [&fileName, &content]() -> bool
+        {
+            bool    isSuccessful    = false;
+            File    fd              = FILESYSTEM.open(fileName, "r");
+
+            if (true == fd)
+            {
+                if (MAX_IMPORT_FILE_SIZE >= fd.size())
+                {
+                    (void)content.reserve(fd.size());
+
+                    while(0 < fd.available())
+                    {
+                        content += static_cast<char>(fd.read());
+                    }
+
+                    isSuccessful = true;
+                }
+
+                fd.close();
+            }
+
+            return isSuccessful;
+        });
+}
@@ -0,0 +1,299 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin configuration store
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __CONFIG_STORE_H__
+#define __CONFIG_STORE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The configuration store keeps the configurations of all plugins in memory,
+ * as compact JSON text per plugin UID. All configurations are read at once
+ * from a single journal file (see ConfigJournal) during startup.
+ *
+ * Changed configurations are not written immediately. A flush task
+ * coalesces several changes in a short time and appends them to the journal
+ * in a single write. If the journal grows too large, it is rewritten with
+ * the current configurations only.
+ *
+ * A plugin configuration file in the legacy directory, e.g. uploaded by the
+ * user, is imported into the store and removed afterwards.
+ */
+class ConfigStore
+{
+public:
+
+    /** Journal file name */
+    static const char*          FILE_NAME;
+
+    /** Temporary journal file name, used for rewriting the journal. */
+    static const char*          TMP_FILE_NAME;
+
+    /** Directory of plugin configuration files, which are imported. */
+    static const char*          IMPORT_PATH;
+
+    /** Max. number of stored configurations. */
+    static const uint8_t        MAX_ENTRIES             = 32U;
+
+    /** Journal size in byte, above which it is rewritten. */
+    static const size_t         MAX_JOURNAL_SIZE        = 16384U;
+
+    /** Delay in ms after the last change, till the changes are written. */
+    static const uint32_t       FLUSH_DELAY             = 2000U;
+
+    /** Max. delay in ms after the first change, till the changes are written. */
+    static const uint32_t       MAX_FLUSH_DELAY         = 10000U;
+
+    /**
+     * Get the configuration store instance.
+     *
+     * @return Configuration store
+     */
+    static ConfigStore& getInstance()
+    {
+        static ConfigStore instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Read all configurations from the journal, import the configuration
+     * files and start the flush task. Without the flush task, the changes
+     * are written immediately.
+     * The filesystem must be mounted.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Write all changed configurations, which are not written yet.
+     */
+    void flush();
+
+    /**
+     * Load the configuration of a plugin.
+     *
+     * @param[in]   uid Plugin UID
+     * @param[out]  doc JSON document, which shall contain the configuration.
+     *
+     * @return If a configuration is available, it will return true otherwise false.
+     */
+    bool load(uint16_t uid, JsonDocument& doc);
+
+    /**
+     * Save the configuration of a plugin. It is written delayed.
+     * Saving a unchanged configuration writes nothing.
+     *
+     * @param[in] uid   Plugin UID
+     * @param[in] doc   JSON document, which contains the configuration.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool save(uint16_t uid, const JsonDocument& doc);
+
+    /**
+     * Remove the configuration of a plugin, e.g. if it is uninstalled.
+     *
+     * @param[in] uid   Plugin UID
+     */
+    void remove(uint16_t uid);
+
+    /**
+     * Import a plugin configuration file, which replaces the stored
+     * configuration. The file is removed afterwards.
+     *
+     * @param[in] uid       Plugin UID
+     * @param[in] fileName  Name of the JSON file
+     *
+     * @return If the file was imported, it will return true otherwise false.
+     */
+    bool importFile(uint16_t uid, const String& fileName);
+
+private:
+
+    /**
+     * A stored configuration.
+     */
+    struct Entry
+    {
+        uint16_t    uid;        /**< Plugin UID */
+        String      data;       /**< Configuration as compact JSON text, empty if removed */
+        bool        isUsed;     /**< Is the entry used? */
+        bool        isDirty;    /**< Is the entry changed, but not written yet? */
+    };
+
+    /** Flush task stack size in bytes */
+    static const uint32_t       FLUSH_TASK_STACK_SIZE   = 4096U;
+
+    /** Flush task priority */
+    static const UBaseType_t    FLUSH_TASK_PRIORITY     = 1U;
+
+    Entry               m_entries[MAX_ENTRIES]; /**< Stored configurations */
+    size_t              m_journalSize;          /**< Size of the journal file in byte */
+    SemaphoreHandle_t   m_xMutex;               /**< Mutex to protect against concurrent access. */
+    TaskHandle_t        m_flushTaskHandle;      /**< Flush task handle */
+
+    /**
+     * Constructs the configuration store.
+     */
+    ConfigStore();
+
+    /**
+     * Destroys the configuration store.
+     */
+    ~ConfigStore();
+
+    /* Prevent copying */
+    ConfigStore(const ConfigStore& store);
+    ConfigStore& operator=(const ConfigStore& store);
+
+    /**
+     * Read all configurations from the journal.
+     * A corrupt journal end, e.g. because of a power loss, is ignored.
+     */
+    void readJournal();
+
+    /**
+     * Import all configuration files of the import directory.
+     */
+    void importFiles();
+
+    /**
+     * Rewrite the journal with the current configurations only.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool rewriteJournal();
+
+    /**
+     * Append encoded configurations to the journal.
+     *
+     * @param[in] buffer    Encoded configurations
+     * @param[in] size      Buffer size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool appendJournal(const uint8_t* buffer, size_t size);
+
+    /**
+     * Encode the configurations into a buffer.
+     *
+     * @param[in] header        Write the journal header too?
+     * @param[in] dirtyOnly     Encode only the changed configurations?
+     * @param[out] size         Number of encoded bytes
+     *
+     * @return Buffer, which must be released with delete[]. If there is nothing to encode or no memory, it will return nullptr.
+     */
+    uint8_t* encode(bool header, bool dirtyOnly, size_t& size) const;
+
+    /**
+     * Mark all entries as written. Removed configurations are released.
+     */
+    void markWritten();
+
+    /**
+     * Get the entry of a plugin.
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return Entry or nullptr if not found.
+     */
+    Entry* findEntry(uint16_t uid);
+
+    /**
+     * Set the configuration of a plugin and mark it changed, if necessary.
+     *
+     * @param[in] uid       Plugin UID
+     * @param[in] data      Configuration as compact JSON text, empty to remove it.
+     * @param[in] isDirty   Shall the entry be marked changed?
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setEntry(uint16_t uid, const String& data, bool isDirty);
+
+    /**
+     * Is any configuration changed, but not written yet?
+     *
+     * @return If changed, it will return true otherwise false.
+     */
+    bool isDirty() const;
+
+    /**
+     * Trigger the delayed write of the changed configurations.
+     */
+    void requestFlush();
+
+    /**
+     * Flush task, which writes the changed configurations after a quiet period.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void flushTask(void* parameters);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock() const;
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __CONFIG_STORE_H__ */
+
+/** @} */
@@ -0,0 +1,274 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Crash surviving trace buffer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "CrashTrace.h"
+
+#include <esp_attr.h>
+#include <esp_system.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Trace ring buffer, located in the RTC slow memory.
+ */
+struct TraceRing
+{
+    uint32_t            magic;                              /**< Magic to detect valid content */
+    uint16_t            writeIdx;                           /**< Index of the next entry to write */
+    uint16_t            count;                              /**< Number of valid entries */
+    uint16_t            bootCount;                          /**< Boot counter */
+    uint16_t            check;                              /**< Inverted boot counter, to detect corruption */
+    CrashTrace::Entry   entries[CrashTrace::MAX_ENTRIES];   /**< Entries */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Magic, which marks a valid trace ring buffer. */
+static const uint32_t   TRACE_RING_MAGIC    = 0x54524345U; /* "TRCE" */
+
+/** Trace ring buffer, which is not initialized after a reset. */
+static RTC_NOINIT_ATTR TraceRing    gTraceRing;
+
+/** Spinlock to protect the trace ring buffer. */
+static portMUX_TYPE                 gTraceMux   = portMUX_INITIALIZER_UNLOCKED;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void CrashTrace::init()
+{
+    if (true == m_isInit)
+    {
+        return;
+    }
+
+    m_resetReason = static_cast<uint8_t>(esp_reset_reason());
+
+    /* After power-on the RTC slow memory contains garbage. */
+    if ((ESP_RST_POWERON == esp_reset_reason()) ||
+        (TRACE_RING_MAGIC != gTraceRing.magic) ||
+        (MAX_ENTRIES <= gTraceRing.writeIdx) ||
+        (MAX_ENTRIES < gTraceRing.count) ||
+        (static_cast<uint16_t>(~gTraceRing.bootCount) != gTraceRing.check))
+    {
+        gTraceRing.magic        = TRACE_RING_MAGIC;
+        gTraceRing.writeIdx     = 0U;
+        gTraceRing.count        = 0U;
+        gTraceRing.bootCount    = 0U;
+    }
+
+    ++gTraceRing.bootCount;
+    gTraceRing.check    = ~gTraceRing.bootCount;
+    m_bootCount         = gTraceRing.bootCount;
+    m_isInit            = true;
+
+    add(TYPE_BOOT, m_resetReason, m_bootCount);
+
+    return;
+}
+
+void CrashTrace::add(Type type, uint8_t arg8, uint16_t arg16)
+{
+    if (false == m_isInit)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&gTraceMux);
+
+    gTraceRing.entries[gTraceRing.writeIdx].timestamp   = millis();
+    gTraceRing.entries[gTraceRing.writeIdx].type        = static_cast<uint8_t>(type);
+    gTraceRing.entries[gTraceRing.writeIdx].arg8        = arg8;
+    gTraceRing.entries[gTraceRing.writeIdx].arg16       = arg16;
+
+    gTraceRing.writeIdx = (gTraceRing.writeIdx + 1U) % MAX_ENTRIES;
+
+    if (MAX_ENTRIES > gTraceRing.count)
+    {
+        ++gTraceRing.count;
+    }
+
+    portEXIT_CRITICAL(&gTraceMux);
+
+    return;
+}
+
+void CrashTrace::addRepeated(Type type, uint16_t arg16)
+{
+    uint32_t    timestamp   = millis();
+    Entry*      latest      = nullptr;
+
+    if (false == m_isInit)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&gTraceMux);
+
+    if (0U < gTraceRing.count)
+    {
+        latest = &gTraceRing.entries[(gTraceRing.writeIdx + MAX_ENTRIES - 1U) % MAX_ENTRIES];
+    }
+
+    if ((nullptr != latest) &&
+        (static_cast<uint8_t>(type) == latest->type) &&
+        (COALESCING_PERIOD > (timestamp - latest->timestamp)) &&
+        (UINT8_MAX > latest->arg8))
+    {
+        ++latest->arg8;
+
+        if (arg16 > latest->arg16)
+        {
+            latest->arg16 = arg16;
+        }
+    }
+    else
+    {
+        gTraceRing.entries[gTraceRing.writeIdx].timestamp   = timestamp;
+        gTraceRing.entries[gTraceRing.writeIdx].type        = static_cast<uint8_t>(type);
+        gTraceRing.entries[gTraceRing.writeIdx].arg8        = 1U;
+        gTraceRing.entries[gTraceRing.writeIdx].arg16       = arg16;
+
+        gTraceRing.writeIdx = (gTraceRing.writeIdx + 1U) % MAX_ENTRIES;
+
+        if (MAX_ENTRIES > gTraceRing.count)
+        {
+            ++gTraceRing.count;
+        }
+    }
+
+    portEXIT_CRITICAL(&gTraceMux);
+
+    return;
+}
+
+uint16_t CrashTrace::getEntries(Entry* entries, uint16_t maxEntries)
+{
+    uint16_t count  = 0U;
+    uint16_t index  = 0U;
+
+    if ((false == m_isInit) ||
+        (nullptr == entries))
+    {
+        return 0U;
+    }
+
+    portENTER_CRITICAL(&gTraceMux);
+
+    count = gTraceRing.count;
+
+    if (maxEntries < count)
+    {
+        count = maxEntries;
+    }
+
+    /* The oldest entry comes first. */
+    for(index = 0U; index < count; ++index)
+    {
+        uint16_t ringIdx = (gTraceRing.writeIdx + MAX_ENTRIES - gTraceRing.count + index) % MAX_ENTRIES;
+
+        entries[index] = gTraceRing.entries[ringIdx];
+    }
+
+    portEXIT_CRITICAL(&gTraceMux);
+
+    return count;
+}
+
+const char* CrashTrace::typeToStr(uint8_t type)
+{
+    const char* str = "unknown";
+
+    switch(type)
+    {
+    case TYPE_BOOT:
+        str = "boot";
+        break;
+
+    case TYPE_STATE:
+        str = "state";
+        break;
+
+    case TYPE_SLOT:
+        str = "slot";
+        break;
+
+    case TYPE_HTTP:
+        str = "http";
+        break;
+
+    case TYPE_FRAME:
+        str = "frame";
+        break;
+
+    default:
+        break;
+    }
+
+    return str;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,241 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Crash surviving trace buffer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __CRASH_TRACE_H__
+#define __CRASH_TRACE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Crash surviving trace buffer.
+ *
+ * It records recent events with minimal overhead in a binary ring buffer,
+ * which is located in the RTC slow memory. The RTC slow memory is not
+ * initialized by a software reset, a watchdog reset or a brownout reset.
+ * Therefore the events before a reset can be analyzed after reboot.
+ * After power-on, the trace buffer is invalid and will be cleared.
+ */
+class CrashTrace
+{
+public:
+
+    /**
+     * Event type.
+     */
+    enum Type
+    {
+        TYPE_BOOT = 0,  /**< System boot, arg8: reset reason, arg16: boot counter */
+        TYPE_STATE,     /**< System state entered, arg8: system state */
+        TYPE_SLOT,      /**< Slot activated, arg8: slot id, arg16: plugin UID */
+        TYPE_HTTP,      /**< HTTP client event, arg8: HTTP event, arg16: Event specific */
+        TYPE_FRAME,     /**< Frame deadlines missed, arg8: number of misses, arg16: max. frame time in ms */
+        TYPE_MAX        /**< Number of event types */
+    };
+
+    /**
+     * System states.
+     */
+    enum SysState
+    {
+        SYS_STATE_INIT = 0,     /**< Init state */
+        SYS_STATE_AP,           /**< Access point state */
+        SYS_STATE_CONNECTING,   /**< Connecting state */
+        SYS_STATE_CONNECTED,    /**< Connected state */
+        SYS_STATE_IDLE,         /**< Idle state */
+        SYS_STATE_ERROR,        /**< Error state */
+        SYS_STATE_RESTART       /**< Restart state */
+    };
+
+    /**
+     * HTTP client events.
+     */
+    enum HttpEvt
+    {
+        HTTP_EVT_CONNECT = 0,   /**< Connected */
+        HTTP_EVT_DISCONNECT,    /**< Disconnected */
+        HTTP_EVT_ERROR,         /**< Error, arg16: error code */
+        HTTP_EVT_TIMEOUT,       /**< Timeout */
+        HTTP_EVT_RSP            /**< Response received, arg16: HTTP status code */
+    };
+
+    /**
+     * A single trace entry.
+     */
+    struct Entry
+    {
+        uint32_t    timestamp;  /**< Timestamp in ms since boot */
+        uint8_t     type;       /**< Event type */
+        uint8_t     arg8;       /**< Event specific argument */
+        uint16_t    arg16;      /**< Event specific argument */
+    };
+
+    /**
+     * Get crash trace instance.
+     *
+     * @return Crash trace instance
+     */
+    static CrashTrace& getInstance()
+    {
+        static CrashTrace instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Initialize the trace buffer. If its content is invalid, it will be
+     * cleared. Afterwards the boot event is recorded.
+     * Call it as early as possible after reset.
+     */
+    void init();
+
+    /**
+     * Record a event. Can be called from any task.
+     *
+     * @param[in] type  Event type
+     * @param[in] arg8  Event specific argument
+     * @param[in] arg16 Event specific argument
+     */
+    void add(Type type, uint8_t arg8, uint16_t arg16 = 0U);
+
+    /**
+     * Record a repeated event. Can be called from any task.
+     *
+     * If the latest entry has the same type and was recorded within the
+     * coalescing period, no new entry is added. Instead its counter in arg8
+     * is incremented (saturated) and arg16 keeps the maximum value. This
+     * prevents that a frequent event overwrites the whole history.
+     *
+     * @param[in] type  Event type
+     * @param[in] arg16 Event specific argument, the maximum is kept.
+     */
+    void addRepeated(Type type, uint16_t arg16);
+
+    /**
+     * Get a copy of the recorded events, starting with the oldest one.
+     *
+     * @param[out]  entries     Entries buffer
+     * @param[in]   maxEntries  Max. number of entries in the buffer
+     *
+     * @return Number of copied entries
+     */
+    uint16_t getEntries(Entry* entries, uint16_t maxEntries);
+
+    /**
+     * Get the boot counter. It counts the boots since the last power-on.
+     *
+     * @return Boot counter
+     */
+    uint16_t getBootCount() const
+    {
+        return m_bootCount;
+    }
+
+    /**
+     * Get the reason of the last reset.
+     *
+     * @return Reset reason, see esp_reset_reason_t.
+     */
+    uint8_t getResetReason() const
+    {
+        return m_resetReason;
+    }
+
+    /**
+     * Get the name of a event type.
+     *
+     * @param[in] type  Event type
+     *
+     * @return Event type name
+     */
+    static const char* typeToStr(uint8_t type);
+
+    /** Max. number of entries in the trace buffer. */
+    static const uint16_t   MAX_ENTRIES = 128U;
+
+    /** Period in ms, in which repeated events are coalesced into one entry. */
+    static const uint32_t   COALESCING_PERIOD = 10000U;
+
+private:
+
+    bool            m_isInit;       /**< Is trace buffer initialized? */
+    uint16_t        m_bootCount;    /**< Boot counter */
+    uint8_t         m_resetReason;  /**< Reason of last reset */
+
+    /**
+     * Constructs the crash trace.
+     */
+    CrashTrace() :
+        m_isInit(false),
+        m_bootCount(0U),
+        m_resetReason(0U)
+    {
+    }
+
+    /**
+     * Destroys the crash trace.
+     */
+    ~CrashTrace()
+    {
+        /* Will never be called. */
+    }
+
+    CrashTrace(const CrashTrace& trace);
+    CrashTrace& operator=(const CrashTrace& trace);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __CRASH_TRACE_H__ */
+
+/** @} */
\ No newline at end of file
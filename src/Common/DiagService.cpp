@@ -0,0 +1,289 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Diagnostic service
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DiagService.h"
+#include "TaskMon.h"
+#include "MemMon.h"
+#include "NetMon.h"
+
+#include <Logging.h>
+#include <Metrics.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void processTaskMon(void);
+static void processMemMon(void);
+static void processNetMon(void);
+static int32_t getTaskMonPeriod();
+static int32_t getMemMonPeriod();
+static int32_t getNetMonPeriod();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Task monitor period, read during export. */
+static MetricGauge      gMetricTaskMonPeriod("pixelix_diag_task_mon_period_ms", "Processing period of the task monitor in ms.", getTaskMonPeriod);
+
+/** Memory monitor period, read during export. */
+static MetricGauge      gMetricMemMonPeriod("pixelix_diag_mem_mon_period_ms", "Processing period of the memory monitor in ms.", getMemMonPeriod);
+
+/** Network stack monitor period, read during export. */
+static MetricGauge      gMetricNetMonPeriod("pixelix_diag_net_mon_period_ms", "Processing period of the network stack monitor in ms.", getNetMonPeriod);
+
+/** Duration of the latest task monitor run. */
+static MetricGauge      gMetricTaskMonDuration("pixelix_diag_task_mon_duration_ms", "Duration of the latest task monitor run in ms.");
+
+/** Duration of the latest memory monitor run. */
+static MetricGauge      gMetricMemMonDuration("pixelix_diag_mem_mon_duration_ms", "Duration of the latest memory monitor run in ms.");
+
+/** Duration of the latest network stack monitor run. */
+static MetricGauge      gMetricNetMonDuration("pixelix_diag_net_mon_duration_ms", "Duration of the latest network stack monitor run in ms.");
+
+/** Number of skipped runs. */
+static MetricCounter    gMetricSkippedRuns("pixelix_diag_skipped_runs_total", "Number of diagnostic runs, which were skipped because the diagnostic task was delayed by a whole period.");
+
+/** Duration metric per job. */
+static MetricGauge* const   gMetricDurations[DiagService::JOB_MAX] =
+{
+    &gMetricTaskMonDuration,
+    &gMetricMemMonDuration,
+    &gMetricNetMonDuration
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool DiagService::begin()
+{
+    bool isSuccessful = true;
+
+    if (nullptr == m_taskHandle)
+    {
+        BaseType_t  osRet   = pdFAIL;
+        uint32_t    now     = millis();
+        uint8_t     index   = 0U;
+
+        for(index = 0U; index < JOB_MAX; ++index)
+        {
+            m_jobs[index].deadline = now;
+        }
+
+        osRet = xTaskCreateUniversal(   diagTask,
+                                        "diagTask",
+                                        TASK_STACK_SIZE,
+                                        this,
+                                        TASK_PRIORITY,
+                                        &m_taskHandle,
+                                        TASK_RUN_CORE);
+
+        if (pdPASS != osRet)
+        {
+            m_taskHandle    = nullptr;
+            isSuccessful    = false;
+        }
+        else
+        {
+            LOG_INFO("Diagnostic service started.");
+        }
+    }
+
+    return isSuccessful;
+}
+
+uint32_t DiagService::getPeriod(JobId id) const
+{
+    uint32_t period = 0U;
+
+    if (JOB_MAX > id)
+    {
+        period = m_jobs[id].period;
+    }
+
+    return period;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+DiagService::DiagService() :
+    m_taskHandle(nullptr),
+    m_jobs()
+{
+    m_jobs[JOB_TASK_MON].process    = processTaskMon;
+    m_jobs[JOB_TASK_MON].period     = DIAG_TASK_MON_PERIOD;
+    m_jobs[JOB_MEM_MON].process     = processMemMon;
+    m_jobs[JOB_MEM_MON].period      = DIAG_MEM_MON_PERIOD;
+    m_jobs[JOB_NET_MON].process     = processNetMon;
+    m_jobs[JOB_NET_MON].period      = DIAG_NET_MON_PERIOD;
+}
+
+uint32_t DiagService::process()
+{
+    uint32_t    waitTime    = UINT32_MAX;
+    uint8_t     index       = 0U;
+
+    for(index = 0U; index < JOB_MAX; ++index)
+    {
+        Job&        job         = m_jobs[index];
+        uint32_t    timestamp   = millis();
+        uint32_t    remaining   = 0U;
+
+        /* Job due? */
+        if (0 <= static_cast<int32_t>(timestamp - job.deadline))
+        {
+            job.process();
+
+            gMetricDurations[index]->set(static_cast<int32_t>(millis() - timestamp));
+
+            job.deadline    += job.period;
+            timestamp       = millis();
+
+            /* Delayed by a whole period or more? Don't catch up. */
+            if (0 <= static_cast<int32_t>(timestamp - job.deadline))
+            {
+                gMetricSkippedRuns.inc();
+                job.deadline = timestamp + job.period;
+            }
+        }
+
+        remaining = job.deadline - timestamp;
+
+        if (waitTime > remaining)
+        {
+            waitTime = remaining;
+        }
+    }
+
+    return waitTime;
+}
+
+void DiagService::diagTask(void* parameters)
+{
+    DiagService* service = static_cast<DiagService*>(parameters);
+
+    if (nullptr != service)
+    {
+        for(;;)
+        {
+            uint32_t waitTime = service->process();
+
+            vTaskDelay(pdMS_TO_TICKS(waitTime));
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Process the task monitor.
+ */
+static void processTaskMon(void)
+{
+    TaskMon::getInstance().process();
+}
+
+/**
+ * Process the memory monitor.
+ */
+static void processMemMon(void)
+{
+    MemMon::getInstance().process();
+}
+
+/**
+ * Process the network stack monitor.
+ */
+static void processNetMon(void)
+{
+    NetMon::getInstance().process();
+}
+
+/**
+ * Get the processing period of the task monitor.
+ *
+ * @return Period in ms
+ */
+static int32_t getTaskMonPeriod()
+{
+    return static_cast<int32_t>(DiagService::getInstance().getPeriod(DiagService::JOB_TASK_MON));
+}
+
+/**
+ * Get the processing period of the memory monitor.
+ *
+ * @return Period in ms
+ */
+static int32_t getMemMonPeriod()
+{
+    return static_cast<int32_t>(DiagService::getInstance().getPeriod(DiagService::JOB_MEM_MON));
+}
+
+/**
+ * Get the processing period of the network stack monitor.
+ *
+ * @return Period in ms
+ */
+static int32_t getNetMonPeriod()
+{
+    return static_cast<int32_t>(DiagService::getInstance().getPeriod(DiagService::JOB_NET_MON));
+}
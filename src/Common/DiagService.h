@@ -0,0 +1,183 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Diagnostic service
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __DIAG_SERVICE_H__
+#define __DIAG_SERVICE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef DIAG_TASK_MON_PERIOD
+/** Processing period of the task monitor in ms. */
+#define DIAG_TASK_MON_PERIOD    (5U * 1000U)
+#endif  /* DIAG_TASK_MON_PERIOD */
+
+#ifndef DIAG_MEM_MON_PERIOD
+/** Processing period of the memory monitor in ms. */
+#define DIAG_MEM_MON_PERIOD     (60U * 1000U)
+#endif  /* DIAG_MEM_MON_PERIOD */
+
+#ifndef DIAG_NET_MON_PERIOD
+/** Processing period of the network stack monitor in ms. */
+#define DIAG_NET_MON_PERIOD     (5U * 1000U)
+#endif  /* DIAG_NET_MON_PERIOD */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The diagnostic service processes the task monitor, the memory monitor and
+ * the network stack monitor in its own task. It runs with the lowest application priority, therefore
+ * the diagnostics never delay the network handling, the webserver or an
+ * update. Every job has its own period.
+ */
+class DiagService
+{
+public:
+
+    /**
+     * Get diagnostic service instance.
+     *
+     * @return Diagnostic service instance
+     */
+    static DiagService& getInstance()
+    {
+        static DiagService instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Diagnostic jobs.
+     */
+    enum JobId
+    {
+        JOB_TASK_MON = 0,   /**< Task monitor */
+        JOB_MEM_MON,        /**< Memory monitor */
+        JOB_NET_MON,        /**< Network stack monitor */
+        JOB_MAX             /**< Number of jobs */
+    };
+
+    /**
+     * Start the diagnostic service task. Every job is processed immediately
+     * once and afterwards with its period.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Get the processing period of a job.
+     *
+     * @param[in] id    Job id
+     *
+     * @return Period in ms
+     */
+    uint32_t getPeriod(JobId id) const;
+
+    /** Diagnostic task stack size in bytes. */
+    static const uint32_t       TASK_STACK_SIZE = 4096U;
+
+    /** Diagnostic task priority, the lowest one of the application and below the network stack. */
+    static const UBaseType_t    TASK_PRIORITY   = 1U;
+
+    /** MCU core where the diagnostic task shall run, the network stack runs on the other one. */
+    static const BaseType_t     TASK_RUN_CORE   = 1;
+
+private:
+
+    /**
+     * A diagnostic job.
+     */
+    struct Job
+    {
+        void        (*process)(void);   /**< Processing function */
+        uint32_t    period;             /**< Period in ms */
+        uint32_t    deadline;           /**< Timestamp in ms of the next processing */
+    };
+
+    TaskHandle_t    m_taskHandle;       /**< Diagnostic task handle */
+    Job             m_jobs[JOB_MAX];    /**< Diagnostic jobs */
+
+    /**
+     * Constructs the diagnostic service.
+     */
+    DiagService();
+
+    /**
+     * Destroys the diagnostic service.
+     */
+    ~DiagService()
+    {
+        /* Will never be called. */
+    }
+
+    DiagService(const DiagService& service);
+    DiagService& operator=(const DiagService& service);
+
+    /**
+     * Process all due jobs.
+     *
+     * @return Time in ms until the next job is due.
+     */
+    uint32_t process();
+
+    /**
+     * Diagnostic task.
+     *
+     * @param[in] parameters    Task parameters, the diagnostic service
+     */
+    static void diagTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DIAG_SERVICE_H__ */
+
+/** @} */
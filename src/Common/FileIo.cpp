@@ -0,0 +1,339 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Filesystem I/O service
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FileIo.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool FileIo::begin()
+{
+    bool status = false;
+
+    /* Not started yet? */
+    if (nullptr == m_taskHandle)
+    {
+        uint8_t idx     = 0U;
+        bool    isError = false;
+
+        /* Create binary semaphore to signal task exit. */
+        m_xSemaphore = xSemaphoreCreateBinary();
+
+        /* Create counting semaphore, which counts the jobs in all queues. */
+        m_xPending = xSemaphoreCreateCounting(QUEUE_LENGTH * PRIORITY_MAX, 0U);
+
+        for(idx = 0U; idx < PRIORITY_MAX; ++idx)
+        {
+            m_queues[idx] = xQueueCreate(QUEUE_LENGTH, sizeof(Request*));
+
+            if (nullptr == m_queues[idx])
+            {
+                isError = true;
+            }
+        }
+
+        if ((false == isError) &&
+            (nullptr != m_xSemaphore) &&
+            (nullptr != m_xPending))
+        {
+            BaseType_t osRet = pdFAIL;
+
+            /* Task shall run */
+            m_taskExit = false;
+
+            osRet = xTaskCreateUniversal(   ioTask,
+                                            "fileIoTask",
+                                            TASK_STACK_SIZE,
+                                            this,
+                                            TASK_PRIORITY,
+                                            &m_taskHandle,
+                                            TASK_RUN_CORE);
+
+            /* Task successful created? */
+            if (pdPASS == osRet)
+            {
+                (void)xSemaphoreGive(m_xSemaphore);
+                status = true;
+            }
+        }
+
+        if (false == status)
+        {
+            m_taskHandle = nullptr;
+            destroy();
+        }
+        else
+        {
+            LOG_INFO("File I/O service is up.");
+        }
+    }
+
+    return status;
+}
+
+void FileIo::end()
+{
+    /* Already running? */
+    if (nullptr != m_taskHandle)
+    {
+        m_taskExit = true;
+
+        /* Wake up the task, so it will recognize the exit request. */
+        (void)xSemaphoreGive(m_xPending);
+
+        /* Join */
+        (void)xSemaphoreTake(m_xSemaphore, portMAX_DELAY);
+        m_taskHandle = nullptr;
+
+        destroy();
+
+        LOG_INFO("File I/O service is down.");
+    }
+
+    return;
+}
+
+bool FileIo::execute(Priority priority, const Job& job)
+{
+    Request request;
+
+    submit(priority, job, request);
+
+    return wait(request);
+}
+
+void FileIo::submit(Priority priority, const Job& job, Request& request)
+{
+    request.job     = &job;
+    request.result  = false;
+    request.xDone   = nullptr;
+
+    if (nullptr == job)
+    {
+        ;
+    }
+    /* If the service is not running or the job is executed by the I/O task
+     * itself, it will be executed directly.
+     */
+    else if ((nullptr == m_taskHandle) ||
+             (xTaskGetCurrentTaskHandle() == m_taskHandle) ||
+             (PRIORITY_MAX <= priority))
+    {
+        request.result = job();
+    }
+    else
+    {
+        Request* requestPtr = &request;
+
+        request.xDone = xSemaphoreCreateBinaryStatic(&request.doneBuffer);
+
+        /* If the queue is full, the caller will wait until a job is finished. */
+        if (pdTRUE != xQueueSendToBack(m_queues[priority], &requestPtr, portMAX_DELAY))
+        {
+            vSemaphoreDelete(request.xDone);
+            request.xDone   = nullptr;
+            request.result  = job();
+        }
+        else
+        {
+            (void)xSemaphoreGive(m_xPending);
+        }
+    }
+
+    return;
+}
+
+bool FileIo::wait(Request& request)
+{
+    if (nullptr != request.xDone)
+    {
+        (void)xSemaphoreTake(request.xDone, portMAX_DELAY);
+
+        vSemaphoreDelete(request.xDone);
+        request.xDone = nullptr;
+    }
+
+    return request.result;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+FileIo::FileIo() :
+    m_taskHandle(nullptr),
+    m_taskExit(false),
+    m_xSemaphore(nullptr),
+    m_xPending(nullptr),
+    m_queues(),
+    m_generation(0U)
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < PRIORITY_MAX; ++idx)
+    {
+        m_queues[idx] = nullptr;
+    }
+}
+
+FileIo::~FileIo()
+{
+    end();
+}
+
+void FileIo::destroy()
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < PRIORITY_MAX; ++idx)
+    {
+        if (nullptr != m_queues[idx])
+        {
+            vQueueDelete(m_queues[idx]);
+            m_queues[idx] = nullptr;
+        }
+    }
+
+    if (nullptr != m_xPending)
+    {
+        vSemaphoreDelete(m_xPending);
+        m_xPending = nullptr;
+    }
+
+    if (nullptr != m_xSemaphore)
+    {
+        vSemaphoreDelete(m_xSemaphore);
+        m_xSemaphore = nullptr;
+    }
+
+    return;
+}
+
+FileIo::Request* FileIo::getNextRequest()
+{
+    Request*    request = nullptr;
+    uint8_t     idx     = PRIORITY_MAX;
+
+    /* Highest priority first */
+    while((0U < idx) && (nullptr == request))
+    {
+        --idx;
+
+        if (pdTRUE != xQueueReceive(m_queues[idx], &request, 0U))
+        {
+            request = nullptr;
+        }
+    }
+
+    return request;
+}
+
+void FileIo::ioTask(void* parameters)
+{
+    FileIo*     fileIo  = reinterpret_cast<FileIo*>(parameters);
+    Request*    request = nullptr;
+
+    if ((nullptr != fileIo) &&
+        (nullptr != fileIo->m_xSemaphore))
+    {
+        (void)xSemaphoreTake(fileIo->m_xSemaphore, portMAX_DELAY);
+
+        while(false == fileIo->m_taskExit)
+        {
+            if (pdTRUE == xSemaphoreTake(fileIo->m_xPending, portMAX_DELAY))
+            {
+                request = fileIo->getNextRequest();
+
+                if (nullptr != request)
+                {
+                    request->result = (*request->job)();
+                    (void)xSemaphoreGive(request->xDone);
+                }
+            }
+        }
+
+        /* Jobs, which are still queued, are executed before exit, because their callers are waiting. */
+        request = fileIo->getNextRequest();
+
+        while(nullptr != request)
+        {
+            request->result = (*request->job)();
+            (void)xSemaphoreGive(request->xDone);
+
+            request = fileIo->getNextRequest();
+        }
+
+        (void)xSemaphoreGive(fileIo->m_xSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,254 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Filesystem I/O service
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __FILE_IO_H__
+#define __FILE_IO_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <functional>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The filesystem I/O service serializes all filesystem accesses in a single
+ * task. Flash access stalls both cores, therefore concurrent accesses from
+ * different tasks only compete with each other. The jobs are executed
+ * according to their priority, so display critical reads go first.
+ *
+ * A job shall only access the filesystem. It must not lock anything else,
+ * because the caller may hold a lock while it waits for the job.
+ */
+class FileIo
+{
+public:
+
+    /**
+     * Prototype of a filesystem job.
+     * It returns whether it was successful or not.
+     */
+    typedef std::function<bool(void)> Job;
+
+    /**
+     * Job priorities.
+     */
+    enum Priority
+    {
+        PRIORITY_LOW = 0,   /**< Low priority, e.g. bulk uploads and configuration files */
+        PRIORITY_HIGH,      /**< High priority, e.g. display critical reads */
+        PRIORITY_MAX        /**< Number of priorities */
+    };
+
+    /**
+     * A queued job. It is owned by the caller, who waits for the result.
+     */
+    struct Request
+    {
+        const Job*          job;        /**< Filesystem job */
+        bool                result;     /**< Result of the job */
+        SemaphoreHandle_t   xDone;      /**< Binary semaphore, given by the I/O task if the job is finished */
+        StaticSemaphore_t   doneBuffer; /**< Memory of the binary semaphore */
+    };
+
+    /** Max. number of queued jobs per priority. */
+    static const UBaseType_t    QUEUE_LENGTH        = 8U;
+
+    /** Max. size in byte, which a bulk write job shall write at once. */
+    static const size_t         WRITE_CHUNK_SIZE    = 512U;
+
+    /** Task stack size in bytes, which must be enough to deserialize JSON and decode bitmaps. */
+    static const uint32_t       TASK_STACK_SIZE     = 4096U;
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Task priority, which is higher than the display task priority to keep the display task waiting short. */
+    static const UBaseType_t    TASK_PRIORITY       = 5U;
+
+    /**
+     * Get the filesystem I/O service instance.
+     *
+     * @return Filesystem I/O service
+     */
+    static FileIo& getInstance()
+    {
+        static FileIo instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the filesystem I/O service.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Stop the filesystem I/O service. Further jobs are executed directly
+     * in the context of the caller.
+     */
+    void end();
+
+    /**
+     * Execute a filesystem job in the I/O task and wait until it is finished.
+     * If the service is not running or it is called by the I/O task itself,
+     * the job is executed directly.
+     *
+     * @param[in] priority  Job priority
+     * @param[in] job       Filesystem job
+     *
+     * @return Result of the job
+     */
+    bool execute(Priority priority, const Job& job);
+
+    /**
+     * Submit a filesystem job to the I/O task without waiting. The caller
+     * must keep the job and the request alive and call wait() later.
+     * If the service is not running or it is called by the I/O task itself,
+     * the job is executed directly.
+     *
+     * @param[in]   priority    Job priority
+     * @param[in]   job         Filesystem job
+     * @param[out]  request     Request, which is used to wait for the result
+     */
+    void submit(Priority priority, const Job& job, Request& request);
+
+    /**
+     * Wait until a submitted job is finished.
+     *
+     * @param[in] request   Request of the submitted job
+     *
+     * @return Result of the job
+     */
+    bool wait(Request& request);
+
+    /**
+     * Get the filesystem generation. It is incremented with every file
+     * change, which is signalled by notifyChange().
+     *
+     * @return Filesystem generation
+     */
+    uint32_t getGeneration() const
+    {
+        return m_generation;
+    }
+
+    /**
+     * Signal that a file was changed, e.g. uploaded via REST API or a plugin
+     * configuration saved by a REST setter.
+     *
+     * @return New filesystem generation
+     */
+    uint32_t notifyChange()
+    {
+        return ++m_generation;
+    }
+
+private:
+
+    /** I/O task handle */
+    TaskHandle_t        m_taskHandle;
+
+    /** Flag to signal the task to exit. */
+    bool                m_taskExit;
+
+    /** Binary semaphore used to signal the task exit. */
+    SemaphoreHandle_t   m_xSemaphore;
+
+    /** Counting semaphore with the number of queued jobs. */
+    SemaphoreHandle_t   m_xPending;
+
+    /** Job queues, one per priority. */
+    QueueHandle_t       m_queues[PRIORITY_MAX];
+
+    /** Filesystem generation, incremented with every signalled file change. */
+    std::atomic<uint32_t>   m_generation;
+
+    /**
+     * Constructs the filesystem I/O service.
+     */
+    FileIo();
+
+    /**
+     * Destroys the filesystem I/O service.
+     */
+    ~FileIo();
+
+    /* Prevent copying */
+    FileIo(const FileIo& fileIo);
+    FileIo& operator=(const FileIo& fileIo);
+
+    /**
+     * Destroy all semaphores and queues.
+     */
+    void destroy();
+
+    /**
+     * Get the next queued job, highest priority first.
+     *
+     * @return Request of the next job or nullptr if no job is queued.
+     */
+    Request* getNextRequest();
+
+    /**
+     * The I/O task executes the queued filesystem jobs.
+     *
+     * @param[in]   parameters  Task pParameters
+     */
+    static void ioTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FILE_IO_H__ */
+
+/** @} */
\ No newline at end of file
@@ -41,20 +41,44 @@
  *****************************************************************************/
 
 /**
- * Defines SPIFFS as filesystem format (must be 1).
+ * Defines LittleFS as filesystem format instead of SPIFFS (0 or 1).
+ * LittleFS opens files and scans directories much faster, especially with
+ * many files or a nearly full filesystem. A SPIFFS filesystem is migrated
+ * once, see FileSystemMigration. The filesystem image must be built with
+ * LittleFS too (board_build.filesystem = littlefs).
+ */
+#ifndef FILESYSTEM_USE_LITTLEFS
+#define FILESYSTEM_USE_LITTLEFS (0)
+#endif  /* FILESYSTEM_USE_LITTLEFS */
+
+#if FILESYSTEM_USE_LITTLEFS
+
+/**
+ * Defines SPIFFS as filesystem format.
+ */
+#define FILESYSTEM_USE_SPIFFS   (0)
+
+#define FILESYSTEM              LITTLEFS
+
+#else   /* FILESYSTEM_USE_LITTLEFS */
+
+/**
+ * Defines SPIFFS as filesystem format.
  */
 #define FILESYSTEM_USE_SPIFFS   (1)
 
-#if FILESYSTEM_USE_SPIFFS
 #define FILESYSTEM              SPIFFS
-#endif  /* FILESYSTEM_USE_SPIFFS */
+
+#endif  /* FILESYSTEM_USE_LITTLEFS */
 
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#if FILESYSTEM_USE_SPIFFS
 #include <SPIFFS.h>
-#endif  /* FILESYSTEM_USE_SPIFFS */
+
+#if FILESYSTEM_USE_LITTLEFS
+#include <LITTLEFS.h>
+#endif  /* FILESYSTEM_USE_LITTLEFS */
 
 /******************************************************************************
  * Macros
@@ -0,0 +1,290 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Filesystem migration
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FileSystemMigration.h"
+#include "FileSystem.h"
+
+#include <Logging.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+#if FILESYSTEM_USE_LITTLEFS
+
+/**
+ * A file, which is kept in memory during the migration.
+ */
+struct MigrationFile
+{
+    String          path;   /**< Full path */
+    uint8_t*        data;   /**< File content */
+    size_t          size;   /**< File size in byte */
+    MigrationFile*  next;   /**< Next file */
+};
+
+#endif  /* FILESYSTEM_USE_LITTLEFS */
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+#if FILESYSTEM_USE_LITTLEFS
+
+static bool migrate();
+static void readDirectory(const char* dirName, MigrationFile*& files, size_t& totalSize);
+static void writeFile(const MigrationFile& file);
+
+#endif  /* FILESYSTEM_USE_LITTLEFS */
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+#if FILESYSTEM_USE_LITTLEFS
+
+/** Directories, whose files are migrated. The most important first. */
+static const char*  MIGRATION_DIRECTORIES[] =
+{
+    "/configuration",
+    "/images"
+};
+
+#endif  /* FILESYSTEM_USE_LITTLEFS */
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern bool FileSystemMigration::mount()
+{
+    bool isMounted = FILESYSTEM.begin();
+
+#if FILESYSTEM_USE_LITTLEFS
+
+    if (false == isMounted)
+    {
+        isMounted = migrate();
+    }
+
+#endif  /* FILESYSTEM_USE_LITTLEFS */
+
+    return isMounted;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#if FILESYSTEM_USE_LITTLEFS
+
+/**
+ * Migrate the SPIFFS filesystem to LittleFS. If there is no SPIFFS
+ * filesystem, the partition is formatted with LittleFS only.
+ *
+ * @return If LittleFS is successful mounted, it will return true otherwise false.
+ */
+static bool migrate()
+{
+    bool            isMounted   = false;
+    MigrationFile*  files       = nullptr;
+    size_t          totalSize   = 0U;
+    uint8_t         idx         = 0U;
+
+    /* Don't format, otherwise the files would be lost. */
+    if (false == SPIFFS.begin(false))
+    {
+        LOG_INFO("No SPIFFS filesystem found.");
+    }
+    else
+    {
+        LOG_INFO("Migrate SPIFFS filesystem to LittleFS.");
+
+        for(idx = 0U; idx < UTIL_ARRAY_NUM(MIGRATION_DIRECTORIES); ++idx)
+        {
+            readDirectory(MIGRATION_DIRECTORIES[idx], files, totalSize);
+        }
+
+        SPIFFS.end();
+    }
+
+    /* Format the partition with LittleFS. */
+    isMounted = FILESYSTEM.begin(true);
+
+    if (false == isMounted)
+    {
+        LOG_ERROR("Couldn't format the filesystem with LittleFS.");
+    }
+
+    while(nullptr != files)
+    {
+        MigrationFile* file = files;
+
+        if (true == isMounted)
+        {
+            writeFile(*file);
+        }
+
+        files = file->next;
+
+        delete[] file->data;
+        delete file;
+    }
+
+    if (true == isMounted)
+    {
+        LOG_INFO("Filesystem migrated (%u bytes). Upload the filesystem image to restore the web pages.", totalSize);
+    }
+
+    return isMounted;
+}
+
+/**
+ * Read all files of a directory into memory, as long as the max. total size
+ * isn't exceeded. Files, which are too large, are skipped.
+ *
+ * @param[in]       dirName     Directory name
+ * @param[in,out]   files       List of files in memory
+ * @param[in,out]   totalSize   Total size of all files in memory
+ */
+static void readDirectory(const char* dirName, MigrationFile*& files, size_t& totalSize)
+{
+    File dir = SPIFFS.open(dirName, "r");
+
+    if (true == dir)
+    {
+        File fd = dir.openNextFile();
+
+        while(true == fd)
+        {
+            size_t size = fd.size();
+
+            if ((FileSystemMigration::MAX_FILE_SIZE < size) ||
+                (FileSystemMigration::MAX_TOTAL_SIZE < (totalSize + size)))
+            {
+                LOG_WARNING("File %s skipped (%u bytes).", fd.name(), size);
+            }
+            else
+            {
+                MigrationFile*  file = new MigrationFile();
+                uint8_t*        data = new uint8_t[size];
+
+                if ((nullptr == file) ||
+                    (nullptr == data) ||
+                    (size != fd.read(data, size)))
+                {
+                    LOG_WARNING("File %s couldn't be read.", fd.name());
+
+                    delete file;
+                    delete[] data;
+                }
+                else
+                {
+                    file->path  = fd.name();
+                    file->data  = data;
+                    file->size  = size;
+                    file->next  = files;
+                    files       = file;
+
+                    totalSize += size;
+                }
+            }
+
+            fd.close();
+            fd = dir.openNextFile();
+        }
+
+        dir.close();
+    }
+
+    return;
+}
+
+/**
+ * Write a file from memory to the filesystem. Missing directories of its
+ * path are created, because LittleFS has real directories.
+ *
+ * @param[in] file  File in memory
+ */
+static void writeFile(const MigrationFile& file)
+{
+    File    fd;
+    int     index   = file.path.indexOf('/', 1);
+
+    while(0 < index)
+    {
+        (void)FILESYSTEM.mkdir(file.path.substring(0, index));
+
+        index = file.path.indexOf('/', index + 1);
+    }
+
+    fd = FILESYSTEM.open(file.path, "w");
+
+    if ((false == fd) ||
+        (file.size != fd.write(file.data, file.size)))
+    {
+        LOG_WARNING("File %s couldn't be migrated.", file.path.c_str());
+    }
+
+    if (true == fd)
+    {
+        fd.close();
+    }
+
+    return;
+}
+
+#endif  /* FILESYSTEM_USE_LITTLEFS */
@@ -0,0 +1,92 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Filesystem migration
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __FILESYSTEM_MIGRATION_H__
+#define __FILESYSTEM_MIGRATION_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stddef.h>
+
+/**
+ * Mounts the filesystem and migrates a SPIFFS filesystem to LittleFS once,
+ * if LittleFS is configured.
+ *
+ * The files are kept in memory during the migration, because SPIFFS and
+ * LittleFS share the same partition. Therefore only the configuration and
+ * the images are migrated, up to a max. total size. The web assets are
+ * part of the filesystem image, which has to be uploaded again.
+ */
+namespace FileSystemMigration
+{
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Max. total size in bytes of all migrated files. */
+static const size_t     MAX_TOTAL_SIZE  = 64U * 1024U;
+
+/** Max. size in bytes of a single migrated file. */
+static const size_t     MAX_FILE_SIZE   = 16U * 1024U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Mount the filesystem. If LittleFS is configured and can't be mounted,
+ * a SPIFFS filesystem is migrated and the partition is formatted with
+ * LittleFS.
+ *
+ * @return If successful mounted, it will return true otherwise false.
+ */
+extern bool mount();
+
+}
+
+#endif  /* __FILESYSTEM_MIGRATION_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,177 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  JSON field filter
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "JsonFieldFilter.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool JsonFieldFilter::addField(const char* path, size_t maxStrLength)
+{
+    bool        status      = true;
+    JsonObject  obj         = m_filter.as<JsonObject>();
+    size_t      capacity    = 0U;
+    const char* begin       = path;
+
+    if (true == obj.isNull())
+    {
+        obj = m_filter.to<JsonObject>();
+    }
+
+    if ((nullptr == path) ||
+        ('\0' == path[0]))
+    {
+        status = false;
+    }
+
+    while((true == status) && (nullptr != begin))
+    {
+        const char* end     = strchr(begin, '.');
+        bool        isNew   = false;
+        String      key;
+
+        if (nullptr == end)
+        {
+            key = begin;
+            begin = nullptr;
+        }
+        else
+        {
+            key.reserve(end - begin);
+
+            while(begin < end)
+            {
+                key += *begin;
+                ++begin;
+            }
+
+            ++begin; /* Overstep '.' */
+        }
+
+        /* Every new member needs a slot and a copy of its key, because
+         * the input is read-only.
+         */
+        if (false == obj.containsKey(key))
+        {
+            capacity += JSON_OBJECT_SIZE(1) + key.length() + 1U;
+            isNew = true;
+        }
+
+        /* Nested field? */
+        if (nullptr != begin)
+        {
+            JsonObject nested = obj[key].as<JsonObject>();
+
+            if (true == nested.isNull())
+            {
+                nested = obj.createNestedObject(key);
+            }
+
+            obj = nested;
+        }
+        else
+        {
+            obj[key] = true;
+
+            /* String values are copied too. */
+            if ((true == isNew) &&
+                (0U < maxStrLength))
+            {
+                capacity += maxStrLength + 1U;
+            }
+        }
+
+        if (true == m_filter.overflowed())
+        {
+            LOG_ERROR("Less memory for filter available.");
+            status = false;
+        }
+    }
+
+    if (true == status)
+    {
+        m_docCapacity += capacity;
+    }
+
+    return status;
+}
+
+DeserializationError JsonFieldFilter::parse(JsonDocument& doc, const char* input, size_t size) const
+{
+    return deserializeJson(doc, input, size, DeserializationOption::Filter(m_filter));
+}
+
+DeserializationError JsonFieldFilter::parse(JsonDocument& doc, Stream& input) const
+{
+    return deserializeJson(doc, input, DeserializationOption::Filter(m_filter));
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
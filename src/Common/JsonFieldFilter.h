@@ -0,0 +1,144 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  JSON field filter
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __JSON_FIELD_FILTER_H__
+#define __JSON_FIELD_FILTER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <ArduinoJson.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The JSON field filter contains the fields of a JSON input, which are
+ * needed by the user. All other fields are skipped during deserialization.
+ * Because the needed fields are known, the capacity of the JSON document,
+ * which holds the result, is derived from the filter and not from the size
+ * of the input.
+ */
+class JsonFieldFilter
+{
+public:
+
+    /** Capacity of the filter in byte. */
+    static const size_t FILTER_SIZE = 256U;
+
+    /**
+     * Constructs a empty filter, which skips every field.
+     */
+    JsonFieldFilter() :
+        m_filter(),
+        m_docCapacity(0U)
+    {
+    }
+
+    /**
+     * Destroys the filter.
+     */
+    ~JsonFieldFilter()
+    {
+    }
+
+    /**
+     * Add a needed field. Nested fields are separated by a '.', e.g.
+     * "results.sunrise".
+     *
+     * @param[in] path          Path of the field
+     * @param[in] maxStrLength  Max. length of the value in characters, if its a string value
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool addField(const char* path, size_t maxStrLength = 0U);
+
+    /**
+     * Get the capacity of a JSON document in byte, which is necessary to
+     * hold all filtered fields.
+     *
+     * @return Document capacity in byte
+     */
+    size_t getDocCapacity() const
+    {
+        return m_docCapacity;
+    }
+
+    /**
+     * Deserialize the input, but only the fields of the filter.
+     *
+     * @param[out] doc      JSON document with at least the capacity provided by getDocCapacity()
+     * @param[in]  input    JSON input
+     * @param[in]  size     Input size in byte
+     *
+     * @return Deserialization result
+     */
+    DeserializationError parse(JsonDocument& doc, const char* input, size_t size) const;
+
+    /**
+     * Deserialize the input stream, but only the fields of the filter.
+     *
+     * @param[out] doc      JSON document with at least the capacity provided by getDocCapacity()
+     * @param[in]  input    JSON input stream
+     *
+     * @return Deserialization result
+     */
+    DeserializationError parse(JsonDocument& doc, Stream& input) const;
+
+private:
+
+    StaticJsonDocument<FILTER_SIZE> m_filter;       /**< Filter, which contains the needed fields */
+    size_t                          m_docCapacity;  /**< Document capacity in byte, necessary for the filtered fields */
+
+    JsonFieldFilter(const JsonFieldFilter& filter);
+    JsonFieldFilter& operator=(const JsonFieldFilter& filter);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __JSON_FIELD_FILTER_H__ */
+
+/** @} */
\ No newline at end of file
@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "JsonFile.h"
+#include "FileIo.h"
 
 #define STREAMUTILS_ENABLE_EEPROM 0
 #include <StreamUtils.h>
@@ -57,51 +58,111 @@
  * Local Variables
  *****************************************************************************/
 
+/* Set file name extension of the temporary file. */
+const char* JsonFile::TMP_FILE_EXT  = ".tmp";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-bool JsonFile::load(const String& fileName, JsonDocument& doc)
+bool JsonFile::load(const String& fileName, JsonDocument& doc, const JsonFieldFilter* filter)
 {
-    bool    isSuccessful    = false;
-    File    fd              = m_fs.open(fileName, "r");
-
-    if (true == fd)
-    {
-        ReadBufferingStream     bufferedStream(fd, CHUNK_SIZE);
-        DeserializationError    error   = deserializeJson(doc, bufferedStream);
-
-        if (DeserializationError::Ok == error.code())
+    return FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [this, &fileName, &doc, filter]() -> bool
         {
-            isSuccessful = true;
-        }
-
-        fd.close();
-    }
-
-    return isSuccessful;
+            bool    isSuccessful    = false;
+            String  tmpFileName     = fileName + TMP_FILE_EXT;
+            File    fd;
+
+            /* A interrupted save may left only the temporary file, which
+             * is complete in this case.
+             */
+            if ((false == m_fs.exists(fileName)) &&
+                (true == m_fs.exists(tmpFileName)))
+            {
+                (void)m_fs.rename(tmpFileName, fileName);
+            }
+
+            fd = m_fs.open(fileName, "r");
+
+            if (true == fd)
+            {
+                ReadBufferingStream     bufferedStream(fd, CHUNK_SIZE);
+                DeserializationError    error;
+
+                if (nullptr == filter)
+                {
+                    error = deserializeJson(doc, bufferedStream);
+                }
+                else
+                {
+                    error = filter->parse(doc, bufferedStream);
+                }
+
+                if (DeserializationError::Ok == error.code())
+                {
+                    isSuccessful = true;
+                }
+
+                fd.close();
+            }
+
+            return isSuccessful;
+        });
 }
 
 bool JsonFile::save(const String& fileName, JsonDocument& doc)
 {
-    bool    isSuccessful    = false;
-    File    fd              = m_fs.open(fileName, "w");
-
-    if (true == fd)
-    {
-        WriteBufferingStream    bufferedStream(fd, CHUNK_SIZE);
-        size_t                  write   = measureJsonPretty(doc);
-        
-        if (write == serializeJsonPretty(doc, bufferedStream))
+    return FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [this, &fileName, &doc]() -> bool
         {
-            isSuccessful = true;
-        }
-
-        bufferedStream.flush();
-        fd.close();
-    }
-
-    return isSuccessful;
+            bool    isSuccessful    = false;
+            String  tmpFileName     = fileName + TMP_FILE_EXT;
+            File    fd              = m_fs.open(tmpFileName, "w");
+
+            if (true == fd)
+            {
+                WriteBufferingStream    bufferedStream(fd, CHUNK_SIZE);
+                size_t                  write   = measureJsonPretty(doc);
+
+                if (write == serializeJsonPretty(doc, bufferedStream))
+                {
+                    isSuccessful = true;
+                }
+
+                bufferedStream.flush();
+                fd.close();
+
+                /* Not all buffered data written, e.g. because the filesystem is full? */
+                if (true == isSuccessful)
+                {
+                    fd = m_fs.open(tmpFileName, "r");
+
+                    if ((false == fd) ||
+                        (write != fd.size()))
+                    {
+                        isSuccessful = false;
+                    }
+
+                    fd.close();
+                }
+
+                /* The file is replaced only after the temporary file is
+                 * written completely.
+                 */
+                if (true == isSuccessful)
+                {
+                    (void)m_fs.remove(fileName);
+                    isSuccessful = m_fs.rename(tmpFileName, fileName);
+                }
+                else
+                {
+                    (void)m_fs.remove(tmpFileName);
+                }
+            }
+
+            return isSuccessful;
+        });
 }
 
 /******************************************************************************
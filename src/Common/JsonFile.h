@@ -45,17 +45,30 @@
  *****************************************************************************/
 #include <ArduinoJson.h>
 #include <FS.h>
+#include <sdkconfig.h>
+#include "JsonFieldFilter.h"
 
 /******************************************************************************
  * Macros
  *****************************************************************************/
 
+/** Logical flash page size of the filesystem in byte. */
+#ifdef CONFIG_SPIFFS_PAGE_SIZE
+#define JSON_FILE_PAGE_SIZE     (CONFIG_SPIFFS_PAGE_SIZE)
+#else   /* CONFIG_SPIFFS_PAGE_SIZE */
+#define JSON_FILE_PAGE_SIZE     (256U)
+#endif  /* CONFIG_SPIFFS_PAGE_SIZE */
+
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
 
 /**
  * JSON file handler, which uses buffered i/o access to improve performance.
+ * The file is accessed by the filesystem I/O service with low priority.
+ *
+ * A file is saved atomic: the content is written to a temporary file first,
+ * which replaces the file only after it was written completely.
  */
 class JsonFile
 {
@@ -91,13 +104,16 @@ public:
 
     /**
      * Load JSON file.
+     * If a filter is given, only its fields are loaded, which reduces the
+     * necessary document capacity to the filter document capacity.
      * 
      * @param[in] fileName  Name of the JSON file.
      * @param[in] doc       JSON document, which shall contain the loaded content.
+     * @param[in] filter    Optional filter with the fields to load.
      * 
      * @return If successful, it will return true otherwise false.
      */
-    bool load(const String& fileName, JsonDocument& doc);
+    bool load(const String& fileName, JsonDocument& doc, const JsonFieldFilter* filter = nullptr);
 
     /**
      * Save JSON file.
@@ -115,9 +131,14 @@ private:
 
     /**
      * Chunk size in byte, used by buffered stream access.
-     * This influences the file read performance.
+     * This influences the file read performance, because every chunk
+     * is read ahead with a single flash access. With the size of a
+     * flash page, every chunk is written as a whole page.
      */
-    static const size_t CHUNK_SIZE  = 64U;
+    static const size_t CHUNK_SIZE  = JSON_FILE_PAGE_SIZE;
+
+    /** File name extension of the temporary file, used during save. */
+    static const char*  TMP_FILE_EXT;
 
     FS  m_fs;   /**< Filesystem */
 
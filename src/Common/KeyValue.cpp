@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "KeyValue.h"
 
+#include <Lzss.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -58,6 +60,106 @@
  * Public Methods
  *****************************************************************************/
 
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+void KeyValue::loadText(Preferences& pref, const char* key, const String& defValue, String& value, bool& isCompressed)
+{
+    size_t storedSize = pref.getBytesLength(key);
+
+    isCompressed = false;
+
+    if (COMPRESSED_HEADER_SIZE < storedSize)
+    {
+        uint8_t* buffer = new uint8_t[storedSize];
+
+        if ((nullptr != buffer) &&
+            (storedSize == pref.getBytes(key, buffer, storedSize)) &&
+            (COMPRESSED_FLAG == buffer[0U]))
+        {
+            const size_t    LENGTH  = static_cast<size_t>(buffer[1U]) | (static_cast<size_t>(buffer[2U]) << 8U);
+            char*           text    = new char[LENGTH + 1U];
+
+            if ((nullptr != text) &&
+                (LENGTH == Lzss::decompress(&buffer[COMPRESSED_HEADER_SIZE], storedSize - COMPRESSED_HEADER_SIZE, reinterpret_cast<uint8_t*>(text), LENGTH)))
+            {
+                text[LENGTH]    = '\0';
+                value           = text;
+                isCompressed    = true;
+            }
+
+            if (nullptr != text)
+            {
+                delete[] text;
+            }
+        }
+
+        if (nullptr != buffer)
+        {
+            delete[] buffer;
+        }
+    }
+
+    if (false == isCompressed)
+    {
+        value = pref.getString(key, defValue);
+    }
+
+    return;
+}
+
+void KeyValue::flushText(Preferences& pref, const char* key, const String& value, bool& isCompressed)
+{
+    const size_t    LENGTH              = value.length();
+    bool            isStoredCompressed  = false;
+
+    if ((COMPRESS_MIN_LENGTH <= LENGTH) &&
+        (UINT16_MAX >= LENGTH))
+    {
+        uint8_t* buffer = new uint8_t[LENGTH];
+
+        if (nullptr != buffer)
+        {
+            /* The compressed text incl. header shall be smaller than the string. */
+            size_t size = Lzss::compress(reinterpret_cast<const uint8_t*>(value.c_str()), LENGTH, &buffer[COMPRESSED_HEADER_SIZE], LENGTH - COMPRESSED_HEADER_SIZE);
+
+            if (0U < size)
+            {
+                buffer[0U] = COMPRESSED_FLAG;
+                buffer[1U] = static_cast<uint8_t>(LENGTH & 0xffU);
+                buffer[2U] = static_cast<uint8_t>((LENGTH >> 8U) & 0xffU);
+
+                /* The string type entry would stay beside the binary one. */
+                if (false == isCompressed)
+                {
+                    (void)pref.remove(key);
+                }
+
+                (void)pref.putBytes(key, buffer, COMPRESSED_HEADER_SIZE + size);
+                isStoredCompressed = true;
+            }
+
+            delete[] buffer;
+        }
+    }
+
+    if (false == isStoredCompressed)
+    {
+        /* The binary type entry would stay beside the string one. */
+        if (true == isCompressed)
+        {
+            (void)pref.remove(key);
+        }
+
+        (void)pref.putString(key, value);
+    }
+
+    isCompressed = isStoredCompressed;
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
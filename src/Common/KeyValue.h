@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <Preferences.h>
+#include <WString.h>
 
 /******************************************************************************
  * Macros
@@ -68,7 +69,8 @@ public:
         TYPE_STRING,        /**< String type */
         TYPE_BOOL,          /**< bool type */
         TYPE_INT32,         /**< int32_t type */
-        TYPE_JSON           /**< JSON type */
+        TYPE_JSON,          /**< JSON type */
+        TYPE_BLOB           /**< Binary type */
     };
 
     /**
@@ -99,15 +101,81 @@ public:
      */
     virtual const char* getKey() const = 0;
 
+    /**
+     * Read the value from the persistent storage into RAM. All further
+     * reads are served from RAM. The persistent storage must be opened before.
+     */
+    virtual void load() = 0;
+
+    /**
+     * Is the value changed, but not written to the persistent storage yet?
+     *
+     * @return If value is dirty, it will return true otherwise false.
+     */
+    bool isDirty() const
+    {
+        return m_isDirty;
+    }
+
+    /**
+     * Write the changed value to the persistent storage.
+     * The persistent storage must be opened read/write before.
+     */
+    virtual void flush() = 0;
+
 protected:
 
+    /**
+     * The value is kept in RAM and a changed value is marked dirty until its
+     * written to the persistent storage. This way several changes in a short
+     * time result in a single write and unchanged values are not written at all.
+     */
+    bool    m_isDirty;
+
+    /**
+     * Texts with at least this length in characters are stored compressed,
+     * if the compressed text is smaller.
+     */
+    static const size_t     COMPRESS_MIN_LENGTH     = 64U;
+
+    /** Flag in the header of a compressed text. */
+    static const uint8_t    COMPRESSED_FLAG         = 0xc5U;
+
+    /** Header size of a compressed text: flag (1 byte) and uncompressed length (2 byte, little endian). */
+    static const size_t     COMPRESSED_HEADER_SIZE  = 3U;
+
     /**
      * Constructs a key value pair.
      */
-    KeyValue()
+    KeyValue() :
+        m_isDirty(false)
     {
     }
 
+    /**
+     * Read a text from the persistent storage. A compressed text is stored
+     * as binary with header, otherwise as string. This way texts, which were
+     * stored before the compression was introduced, are still read.
+     *
+     * @param[in]  pref         Preferences
+     * @param[in]  key          Key
+     * @param[in]  defValue     Default value, used if the key is not available.
+     * @param[out] value        Read text
+     * @param[out] isCompressed Is the text stored compressed?
+     */
+    static void loadText(Preferences& pref, const char* key, const String& defValue, String& value, bool& isCompressed);
+
+    /**
+     * Write a text to the persistent storage. A long text is written
+     * compressed, if it saves space.
+     *
+     * @param[in]     pref          Preferences
+     * @param[in]     key           Key
+     * @param[in]     value         Text to write
+     * @param[in,out] isCompressed  Is the text stored compressed? It will be updated.
+     */
+    static void flushText(Preferences& pref, const char* key, const String& value, bool& isCompressed);
+
 };
 
 /**
@@ -128,7 +196,8 @@ public:
         m_name(name),
         m_defValue(defValue),
         m_min(min),
-        m_max(max)
+        m_max(max),
+        m_value(defValue)
     {
     }
 
@@ -180,18 +249,53 @@ public:
     }
 
     /**
-     * Get value.
+     * Get value from RAM. A changed value, which is not written yet, is
+     * returned instead of the stored one.
      *
      * @return Value
      */
-    virtual T getValue() const = 0;
+    T getValue() const
+    {
+        return m_value;
+    }
 
     /**
-     * Set value.
+     * Set value. It will be written to the persistent storage with the
+     * next flush, but only if its different to the current value.
      *
      * @param[in] value Value
      */
-    virtual void setValue(T value) = 0;
+    void setValue(T value)
+    {
+        if (value != m_value)
+        {
+            m_value     = value;
+            m_isDirty   = true;
+        }
+    }
+
+    /**
+     * Read the value from the persistent storage into RAM.
+     * The persistent storage must be opened before.
+     */
+    void load() final
+    {
+        m_value     = read();
+        m_isDirty   = false;
+    }
+
+    /**
+     * Write the changed value to the persistent storage.
+     * The persistent storage must be opened read/write before.
+     */
+    void flush() final
+    {
+        if (true == m_isDirty)
+        {
+            write(m_value);
+            m_isDirty = false;
+        }
+    }
 
     /**
      * Get default value.
@@ -211,6 +315,21 @@ protected:
     T               m_defValue; /**< Default value */
     T               m_min;      /**< Min. length */
     T               m_max;      /**< Max. length */
+    T               m_value;    /**< Value in RAM */
+
+    /**
+     * Read value from the persistent storage.
+     *
+     * @return Value
+     */
+    virtual T read() const = 0;
+
+    /**
+     * Write value to the persistent storage.
+     *
+     * @param[in] value Value
+     */
+    virtual void write(T value) = 0;
 
 private:
 
@@ -0,0 +1,145 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Key value pair with binary type
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "KeyValueBlob.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t KeyValueBlob::getLength() const
+{
+    return m_size;
+}
+
+size_t KeyValueBlob::getValue(uint8_t* buffer, size_t size) const
+{
+    size_t length = 0U;
+
+    if ((nullptr != buffer) &&
+        (nullptr != m_value) &&
+        (m_size <= size))
+    {
+        memcpy(buffer, m_value, m_size);
+        length = m_size;
+    }
+
+    return length;
+}
+
+bool KeyValueBlob::setValue(const uint8_t* value, size_t size)
+{
+    bool status = false;
+
+    if ((nullptr != value) &&
+        (nullptr != m_value) &&
+        (m_max >= size))
+    {
+        /* Skip unchanged value. */
+        if ((m_size != size) ||
+            (0 != memcmp(m_value, value, size)))
+        {
+            memcpy(m_value, value, size);
+            m_size      = size;
+            m_isDirty   = true;
+        }
+
+        status = true;
+    }
+
+    return status;
+}
+
+void KeyValueBlob::load()
+{
+    size_t storedSize = m_pref.getBytesLength(m_key);
+
+    m_size      = 0U;
+    m_isDirty   = false;
+
+    if ((nullptr != m_value) &&
+        (0U < storedSize) &&
+        (m_max >= storedSize))
+    {
+        m_size = m_pref.getBytes(m_key, m_value, m_max);
+    }
+}
+
+void KeyValueBlob::flush()
+{
+    if (true == m_isDirty)
+    {
+        (void)m_pref.putBytes(m_key, m_value, m_size);
+        m_isDirty = false;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,192 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Key value pair with binary type
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __KEY_VALUE_BLOB_H__
+#define __KEY_VALUE_BLOB_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "KeyValue.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Key value pair with binary value.
+ */
+class KeyValueBlob : public KeyValue
+{
+public:
+
+    /**
+     * Constructs a key value pair.
+     */
+    KeyValueBlob(Preferences& pref, const char* key, const char* name, size_t max) :
+        KeyValue(),
+        m_pref(pref),
+        m_key(key),
+        m_name(name),
+        m_max(max),
+        m_value(new uint8_t[max]),
+        m_size(0U)
+    {
+    }
+
+    /**
+     * Destroys a key value pair.
+     */
+    virtual ~KeyValueBlob()
+    {
+        if (nullptr != m_value)
+        {
+            delete[] m_value;
+            m_value = nullptr;
+        }
+    }
+
+    /**
+     * Get value type.
+     *
+     * @return Value type
+     */
+    Type getValueType() const final
+    {
+        return TYPE_BLOB;
+    }
+
+    /**
+     * Get user friendly name of key value pair.
+     *
+     * @return User friendly name
+     */
+    const char* getName() const final
+    {
+        return m_name;
+    }
+
+    /**
+     * Get key.
+     *
+     * @return Key
+     */
+    const char* getKey() const final
+    {
+        return m_key;
+    }
+
+    /**
+     * Get maximum value size in byte.
+     *
+     * @return Maximum size in byte
+     */
+    size_t getMaxLength() const
+    {
+        return m_max;
+    }
+
+    /**
+     * Get value size in byte from RAM. A changed value, which is not written
+     * yet, is considered instead of the stored one.
+     *
+     * @return Value size in byte. If no value is available, it will return 0.
+     */
+    size_t getLength() const;
+
+    /**
+     * Get value from RAM. A changed value, which is not written yet, is
+     * returned instead of the stored one.
+     *
+     * @param[out] buffer   Buffer, which to fill
+     * @param[in]  size     Buffer size in byte
+     *
+     * @return Number of bytes in the buffer. If no value is available or the buffer is too small, it will return 0.
+     */
+    size_t getValue(uint8_t* buffer, size_t size) const;
+
+    /**
+     * Set value. It will be written to the persistent storage with the
+     * next flush, but only if its different to the current value.
+     *
+     * @param[in] value Value
+     * @param[in] size  Value size in byte
+     *
+     * @return If the value is too large, it will return false otherwise true.
+     */
+    bool setValue(const uint8_t* value, size_t size);
+
+    /**
+     * Read the value from the persistent storage into RAM.
+     * The persistent storage must be opened before.
+     */
+    void load() final;
+
+    /**
+     * Write the changed value to the persistent storage.
+     * The persistent storage must be opened read/write before.
+     */
+    void flush() final;
+
+private:
+
+    Preferences&    m_pref;         /**< Preferences */
+    const char*     m_key;          /**< Key */
+    const char*     m_name;         /**< Name */
+    size_t          m_max;          /**< Max. size in byte */
+    uint8_t*        m_value;        /**< Value in RAM, with max. size */
+    size_t          m_size;         /**< Size of the value in byte. */
+
+    /* An instance shall not be copied. */
+    KeyValueBlob(const KeyValueBlob& kv);
+    KeyValueBlob& operator=(const KeyValueBlob& kv);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __KEY_VALUE_BLOB_H__ */
+
+/** @} */
\ No newline at end of file
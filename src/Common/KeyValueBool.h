@@ -68,7 +68,8 @@ public:
         m_pref(pref),
         m_key(key),
         m_name(name),
-        m_defValue(defValue)
+        m_defValue(defValue),
+        m_value(defValue)
     {
     }
 
@@ -110,23 +111,52 @@ public:
     }
 
     /**
-     * Get value.
+     * Get value from RAM. A changed value, which is not written yet, is
+     * returned instead of the stored one.
      *
      * @return Value
      */
     bool getValue() const
     {
-        return m_pref.getBool(m_key, getDefault());
+        return m_value;
     }
 
     /**
-     * Set value.
+     * Set value. It will be written to the persistent storage with the
+     * next flush, but only if its different to the current value.
      *
      * @param[in] value Value
      */
     void setValue(bool value)
     {
-        m_pref.putBool(m_key, value);
+        if (value != m_value)
+        {
+            m_value     = value;
+            m_isDirty   = true;
+        }
+    }
+
+    /**
+     * Read the value from the persistent storage into RAM.
+     * The persistent storage must be opened before.
+     */
+    void load() final
+    {
+        m_value     = m_pref.getBool(m_key, getDefault());
+        m_isDirty   = false;
+    }
+
+    /**
+     * Write the changed value to the persistent storage.
+     * The persistent storage must be opened read/write before.
+     */
+    void flush() final
+    {
+        if (true == m_isDirty)
+        {
+            (void)m_pref.putBool(m_key, m_value);
+            m_isDirty = false;
+        }
     }
 
     /**
@@ -145,6 +175,7 @@ private:
     const char*     m_key;      /**< Key */
     const char*     m_name;     /**< Name */
     bool            m_defValue; /**< Default value */
+    bool            m_value;    /**< Value in RAM */
 
     /* An instance shall not be copied. */
     KeyValueBool(const KeyValueBool& kv);
@@ -85,28 +85,28 @@ public:
         return TYPE_INT32;
     }
 
+private:
+
     /**
-     * Get value.
+     * Read value from the persistent storage.
      *
      * @return Value
      */
-    int32_t getValue() const final
+    int32_t read() const final
     {
         return m_pref.getInt(m_key, m_defValue);
     }
 
     /**
-     * Set value.
+     * Write value to the persistent storage.
      *
      * @param[in] value Value
      */
-    void setValue(int32_t value) final
+    void write(int32_t value) final
     {
-        m_pref.putInt(m_key, value);
+        (void)m_pref.putInt(m_key, value);
     }
 
-private:
-
     /* An instance shall not be copied. */
     KeyValueInt32(const KeyValueInt32& kv);
     KeyValueInt32& operator=(const KeyValueInt32& kv);
@@ -70,7 +70,9 @@ public:
         m_name(name),
         m_defValue(defValue),
         m_min(min),
-        m_max(max)
+        m_max(max),
+        m_value(defValue),
+        m_isCompressed(false)
     {
     }
 
@@ -132,23 +134,52 @@ public:
     }
 
     /**
-     * Get value.
+     * Get value from RAM. A changed value, which is not written yet, is
+     * returned instead of the stored one.
      *
      * @return Value
      */
     String getValue() const
     {
-        return m_pref.getString(m_key, getDefault());
+        return m_value;
     }
 
     /**
-     * Set value.
+     * Set value. It will be written to the persistent storage with the
+     * next flush, but only if its different to the current value.
      *
      * @param[in] value Value
      */
     void setValue(const String& value)
     {
-        m_pref.putString(m_key, value);
+        if (value != m_value)
+        {
+            m_value     = value;
+            m_isDirty   = true;
+        }
+    }
+
+    /**
+     * Read the value from the persistent storage into RAM.
+     * The persistent storage must be opened before.
+     */
+    void load() final
+    {
+        loadText(m_pref, m_key, getDefault(), m_value, m_isCompressed);
+        m_isDirty = false;
+    }
+
+    /**
+     * Write the changed value to the persistent storage.
+     * The persistent storage must be opened read/write before.
+     */
+    void flush() final
+    {
+        if (true == m_isDirty)
+        {
+            flushText(m_pref, m_key, m_value, m_isCompressed);
+            m_isDirty = false;
+        }
     }
 
     /**
@@ -169,6 +200,8 @@ private:
     const char*     m_defValue; /**< Default value */
     size_t          m_min;      /**< Min. length */
     size_t          m_max;      /**< Max. length */
+    String          m_value;    /**< Value in RAM */
+    bool            m_isCompressed; /**< Is the value stored compressed? */
 
     /* An instance shall not be copied. */
     KeyValueString(const KeyValueString& kv);
@@ -85,28 +85,28 @@ public:
         return TYPE_INT32;
     }
 
+private:
+
     /**
-     * Get value.
+     * Read value from the persistent storage.
      *
      * @return Value
      */
-    uint32_t getValue() const final
+    uint32_t read() const final
     {
         return m_pref.getUInt(m_key, m_defValue);
     }
 
     /**
-     * Set value.
+     * Write value to the persistent storage.
      *
      * @param[in] value Value
      */
-    void setValue(uint32_t value) final
+    void write(uint32_t value) final
     {
-        m_pref.putUInt(m_key, value);
+        (void)m_pref.putUInt(m_key, value);
     }
 
-private:
-
     /* An instance shall not be copied. */
     KeyValueUInt32(const KeyValueUInt32& kv);
     KeyValueUInt32& operator=(const KeyValueUInt32& kv);
@@ -85,28 +85,28 @@ public:
         return TYPE_UINT8;
     }
 
+private:
+
     /**
-     * Get value.
+     * Read value from the persistent storage.
      *
      * @return Value
      */
-    uint8_t getValue() const final
+    uint8_t read() const final
     {
         return m_pref.getUChar(m_key, m_defValue);
     }
 
     /**
-     * Set value.
+     * Write value to the persistent storage.
      *
      * @param[in] value Value
      */
-    void setValue(uint8_t value) final
+    void write(uint8_t value) final
     {
-        m_pref.putUChar(m_key, value);
+        (void)m_pref.putUChar(m_key, value);
     }
 
-private:
-
     /* An instance shall not be copied. */
     KeyValueUInt8(const KeyValueUInt8& kv);
     KeyValueUInt8& operator=(const KeyValueUInt8& kv);
@@ -0,0 +1,112 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  JSON document for large, not latency critical content
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __LARGE_JSON_DOCUMENT_H__
+#define __LARGE_JSON_DOCUMENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <ArduinoJson.h>
+#include <MemPolicy.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * JSON document allocator, which places the document in the region for
+ * large buffers. This is the PSRAM if available.
+ */
+struct LargeJsonAllocator
+{
+    /**
+     * Allocate memory for the document.
+     *
+     * @param[in] size  Size in byte
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    void* allocate(size_t size)
+    {
+        return MemPolicy::allocate(MemPolicy::REGION_LARGE, size);
+    }
+
+    /**
+     * Release the document memory.
+     *
+     * @param[in] ptr   Pointer to the memory
+     */
+    void deallocate(void* ptr)
+    {
+        MemPolicy::release(ptr);
+        return;
+    }
+
+    /**
+     * Change the size of the document memory.
+     *
+     * @param[in] ptr       Pointer to the memory
+     * @param[in] newSize   New size in byte
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    void* reallocate(void* ptr, size_t newSize)
+    {
+        return MemPolicy::reallocate(MemPolicy::REGION_LARGE, ptr, newSize);
+    }
+};
+
+/**
+ * JSON document, used for e.g. REST API requests/responses and HTTP response
+ * bodies. It is located in the PSRAM if available.
+ */
+typedef BasicJsonDocument<LargeJsonAllocator> LargeJsonDocument;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LARGE_JSON_DOCUMENT_H__ */
+
+/** @} */
\ No newline at end of file
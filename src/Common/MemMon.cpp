@@ -33,8 +33,17 @@
  * Includes
  *****************************************************************************/
 #include "MemMon.h"
+#include "PluginMemPool.h"
+#include "SysMsg.h"
+#include "SysMsgBitmaps.h"
+#include "DisplayMgr.h"
 
 #include <Logging.h>
+#include <MemPolicy.h>
+#include <Metrics.h>
+#include <ImageCache.h>
+#include <atomic>
+#include <esp_heap_caps.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -52,52 +61,122 @@
  * Prototypes
  *****************************************************************************/
 
+static int32_t getFreeHeap();
+static int32_t getMinFreeHeap();
+static int32_t getMaxAllocHeap();
+static int32_t getFragmentation();
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Free heap, read during export. */
+static MetricGauge  gMetricFreeHeap("pixelix_heap_free_bytes", "Free heap in byte.", getFreeHeap);
+
+/** Min. free heap since startup, read during export. */
+static MetricGauge  gMetricMinFreeHeap("pixelix_heap_min_free_bytes", "Min. free heap since startup in byte.", getMinFreeHeap);
+
+/** Largest allocatable heap block, read during export. */
+static MetricGauge  gMetricMaxAllocHeap("pixelix_heap_max_alloc_bytes", "Largest allocatable heap block in byte.", getMaxAllocHeap);
+
+/** Fragmentation of the internal heap, read during export. */
+static MetricGauge  gMetricFragmentation("pixelix_heap_fragmentation_percent", "Fragmentation of the internal heap in percent.", getFragmentation);
+
+/** Number of asset releases, because the heap was under pressure. */
+static MetricCounter gMetricAssetReleases("pixelix_heap_pressure_releases_total", "Number of plugin asset releases, because the heap was under pressure.");
+
+/** Memory capabilities per monitored region. */
+static const uint32_t gRegionCaps[MemMon::REGION_MAX] =
+{
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,  /* REGION_INTERNAL */
+    MALLOC_CAP_DMA,                         /* REGION_DMA */
+    MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT     /* REGION_PSRAM */
+};
+
+/** User friendly names per monitored region. */
+static const char* gRegionNames[MemMon::REGION_MAX] =
+{
+    "Internal heap",    /* REGION_INTERNAL */
+    "DMA heap",         /* REGION_DMA */
+    "PSRAM"             /* REGION_PSRAM */
+};
+
+#if (0 != MEMMON_ALLOC_HISTOGRAM)
+
+/**
+ * Number of allocations per size bucket.
+ * The counters are constant initialized, because allocations happen already
+ * during the construction of the static objects.
+ */
+static std::atomic<uint32_t> gAllocSizeBuckets[MemMon::ALLOC_SIZE_BUCKETS];
+
+#endif  /* (0 != MEMMON_ALLOC_HISTOGRAM) */
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void MemMon::process()
 {
-    bool isProcessingTime = false;
+    uint32_t minFreeHeap = ESP.getMinFreeHeap();
 
-    if (false == m_timer.isTimerRunning())
+    if (MIN_HEAP_MEMORY >= minFreeHeap)
     {
-        m_timer.start(PROCESSING_CYCLE);
-        isProcessingTime = true;
+        LOG_WARNING("Min. free heap is %u byte.", minFreeHeap);
     }
-    else if (true == m_timer.isTimeout())
+
+    updateMemRegions();
+    checkPressure();
+    checkLargestBlock();
+    logPluginMemPool();
+
+#if (0 != MEMMON_ALLOC_HISTOGRAM)
+    logAllocHistogram();
+#endif  /* (0 != MEMMON_ALLOC_HISTOGRAM) */
+
+    /* Any heap corrupt? */
+    if (false == heap_caps_check_integrity_all(true))
     {
-        isProcessingTime = true;
-        m_timer.restart();
+        LOG_FATAL("----- Heap corrupt! ------");
     }
 
-    if (true == isProcessingTime)
+    return;
+}
+
+bool MemMon::getRegionStat(Region region, RegionStat& stat) const
+{
+    bool isAvailable = false;
+
+    if ((REGION_MAX > region) &&
+        (0U < m_stats[region].total))
     {
-        uint32_t minFreeHeap        = ESP.getMinFreeHeap();
-        uint32_t minFreeHeapBlock   = ESP.getMaxAllocHeap();
+        stat        = m_stats[region];
+        isAvailable = true;
+    }
 
-        if (MIN_HEAP_MEMORY >= minFreeHeap)
-        {
-            LOG_WARNING("Min. free heap is %u byte.", minFreeHeap);
-        }
+    return isAvailable;
+}
 
-        if (MIN_HEAP_BLOCK_MEMORY > minFreeHeapBlock)
-        {
-            LOG_WARNING("Largest heap block which can be allocated is %u byte.", minFreeHeapBlock);
-        }
+#if (0 != MEMMON_ALLOC_HISTOGRAM)
 
-        /* Any heap corrupt? */
-        if (false == heap_caps_check_integrity_all(true))
-        {
-            LOG_FATAL("----- Heap corrupt! ------");
-        }
+void MemMon::countAllocation(size_t size)
+{
+    uint8_t bucket  = 0U;
+    size_t  limit   = 16U;
+
+    while(((ALLOC_SIZE_BUCKETS - 1U) > bucket) && (limit < size))
+    {
+        limit <<= 1U;
+        ++bucket;
     }
+
+    (void)gAllocSizeBuckets[bucket].fetch_add(1U, std::memory_order_relaxed);
+
+    return;
 }
 
+#endif  /* (0 != MEMMON_ALLOC_HISTOGRAM) */
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -106,10 +185,275 @@ void MemMon::process()
  * Private Methods
  *****************************************************************************/
 
+void MemMon::updateMemRegions()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < REGION_MAX; ++index)
+    {
+        RegionStat& stat = m_stats[index];
+
+        /* Large buffers, like HTTP bodies, JSON documents and images are in the PSRAM, if available. */
+        if ((REGION_PSRAM == index) &&
+            (false == MemPolicy::isPsramAvailable()))
+        {
+            stat.total = 0U;
+        }
+        else
+        {
+            multi_heap_info_t info;
+
+            heap_caps_get_info(&info, gRegionCaps[index]);
+
+            stat.total          = info.total_free_bytes + info.total_allocated_bytes;
+            stat.free           = info.total_free_bytes;
+            stat.minFree        = info.minimum_free_bytes;
+            stat.largestBlock   = info.largest_free_block;
+
+            /* The more the free memory is split into small blocks, the higher is the fragmentation. */
+            if (0U == stat.free)
+            {
+                stat.fragmentation = 0U;
+            }
+            else
+            {
+                stat.fragmentation = static_cast<uint8_t>(100U - ((static_cast<uint64_t>(stat.largestBlock) * 100U) / stat.free));
+            }
+
+            LOG_INFO("%s: %u of %u byte free, min. %u byte, largest block %u byte, fragmentation %u%%.",
+                gRegionNames[index],
+                stat.free,
+                stat.total,
+                stat.minFree,
+                stat.largestBlock,
+                stat.fragmentation);
+        }
+    }
+
+    if (false == MemPolicy::isPsramAvailable())
+    {
+        LOG_INFO("PSRAM: not available, large buffers are in the internal heap.");
+    }
+
+    return;
+}
+
+void MemMon::checkLargestBlock()
+{
+    const size_t LARGEST_BLOCK = m_stats[REGION_INTERNAL].largestBlock;
+
+    if (MIN_HEAP_BLOCK_MEMORY > LARGEST_BLOCK)
+    {
+        LOG_WARNING("Largest heap block which can be allocated is %u byte.", LARGEST_BLOCK);
+
+        /* Warn the user only once, until the heap recovered. */
+        if (false == m_isLowBlockWarned)
+        {
+            SysMsg::getInstance().show(SYS_MSG_HEAP_FRAGMENTED);
+            m_isLowBlockWarned = true;
+        }
+    }
+    else
+    {
+        m_isLowBlockWarned = false;
+    }
+
+    return;
+}
+
+void MemMon::checkPressure()
+{
+    const RegionStat& stat = m_stats[REGION_INTERNAL];
+
+    if ((PRESSURE_HEAP_MEMORY > stat.free) ||
+        (PRESSURE_HEAP_BLOCK_MEMORY > stat.largestBlock))
+    {
+        /* Plugins, which became inactive since the last cycle, are
+         * requested too. A plugin without assets just ignores it.
+         */
+        uint8_t count = DisplayMgr::getInstance().releaseInactiveAssets();
+
+        ImageCache::getInstance().clear();
+        gMetricAssetReleases.inc();
+
+        if (false == m_isUnderPressure)
+        {
+            LOG_WARNING("Heap under pressure, %u inactive plugins release their assets.", count);
+            m_isUnderPressure = true;
+        }
+    }
+    else
+    {
+        m_isUnderPressure = false;
+    }
+
+    return;
+}
+
+void MemMon::logPluginMemPool()
+{
+    PluginMemPool&  pool    = PluginMemPool::getInstance();
+    uint8_t         index   = 0U;
+    uint16_t        owner   = 0U;
+    size_t          used    = 0U;
+
+    LOG_INFO("Plugin memory pool: %u of %u byte used, peak %u byte.", pool.getUsed(), pool.getSize(), pool.getPeakUsed());
+
+    if (0U < pool.getNumOfFallbacks())
+    {
+        LOG_WARNING("Plugin memory pool exhausted, %u allocations from heap.", pool.getNumOfFallbacks());
+    }
+
+    while(true == pool.getAccount(index, owner, used))
+    {
+        if (PluginMemPool::OWNER_INSTANCES == owner)
+        {
+            LOG_INFO("Plugin instances: %u byte", used);
+        }
+        else
+        {
+            LOG_INFO("Plugin UID 0x%04X: %u byte", owner, used);
+        }
+
+        ++index;
+    }
+
+    return;
+}
+
+#if (0 != MEMMON_ALLOC_HISTOGRAM)
+
+void MemMon::logAllocHistogram()
+{
+    uint8_t bucket  = 0U;
+    size_t  limit   = 16U;
+
+    for(bucket = 0U; bucket < ALLOC_SIZE_BUCKETS; ++bucket)
+    {
+        uint32_t count = gAllocSizeBuckets[bucket].load(std::memory_order_relaxed);
+
+        if ((ALLOC_SIZE_BUCKETS - 1U) > bucket)
+        {
+            LOG_INFO("Allocations <= %u byte: %u", limit, count);
+        }
+        else
+        {
+            LOG_INFO("Allocations  > %u byte: %u", limit >> 1U, count);
+        }
+
+        limit <<= 1U;
+    }
+
+    return;
+}
+
+#endif  /* (0 != MEMMON_ALLOC_HISTOGRAM) */
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
 
+#if (0 != MEMMON_ALLOC_HISTOGRAM)
+
+/**
+ * Replaces the global operator new to count the allocation sizes.
+ * Like the default one, it returns nullptr if no memory is available.
+ *
+ * @param[in] size  Allocation size in byte
+ *
+ * @return Allocated memory
+ */
+void* operator new(size_t size)
+{
+    MemMon::countAllocation(size);
+
+    return malloc(size);
+}
+
+/**
+ * Replaces the global operator new[] to count the allocation sizes.
+ *
+ * @param[in] size  Allocation size in byte
+ *
+ * @return Allocated memory
+ */
+void* operator new[](size_t size)
+{
+    MemMon::countAllocation(size);
+
+    return malloc(size);
+}
+
+/**
+ * Replaces the global operator delete, corresponding to operator new.
+ *
+ * @param[in] ptr   Memory to release
+ */
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+/**
+ * Replaces the global operator delete[], corresponding to operator new[].
+ *
+ * @param[in] ptr   Memory to release
+ */
+void operator delete[](void* ptr) noexcept
+{
+    free(ptr);
+}
+
+#endif  /* (0 != MEMMON_ALLOC_HISTOGRAM) */
+
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Get free heap.
+ *
+ * @return Free heap in byte
+ */
+static int32_t getFreeHeap()
+{
+    return static_cast<int32_t>(ESP.getFreeHeap());
+}
+
+/**
+ * Get min. free heap since startup.
+ *
+ * @return Min. free heap in byte
+ */
+static int32_t getMinFreeHeap()
+{
+    return static_cast<int32_t>(ESP.getMinFreeHeap());
+}
+
+/**
+ * Get largest allocatable heap block.
+ *
+ * @return Largest allocatable heap block in byte
+ */
+static int32_t getMaxAllocHeap()
+{
+    return static_cast<int32_t>(ESP.getMaxAllocHeap());
+}
+
+/**
+ * Get fragmentation of the internal heap.
+ *
+ * @return Fragmentation in percent
+ */
+static int32_t getFragmentation()
+{
+    MemMon::RegionStat  stat;
+    int32_t             fragmentation = 0;
+
+    if (true == MemMon::getInstance().getRegionStat(MemMon::REGION_INTERNAL, stat))
+    {
+        fragmentation = stat.fragmentation;
+    }
+
+    return fragmentation;
+}
@@ -40,6 +40,16 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Histogram of the allocation sizes (1) or not (0).
+ * If enabled, every allocation with new is counted in a size bucket, which
+ * shows which allocation sizes shall be served by a pool allocator.
+ * Its intended for debug builds only.
+ */
+#ifndef MEMMON_ALLOC_HISTOGRAM
+#define MEMMON_ALLOC_HISTOGRAM  (0)
+#endif  /* MEMMON_ALLOC_HISTOGRAM */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
@@ -57,6 +67,7 @@
 
 /**
  * Memory monitor
+ * It is processed by the diagnostic service.
  */
 class MemMon
 {
@@ -79,23 +90,90 @@ public:
      */
     void process();
 
-    /** Processing cycle in ms. */
-    static const uint32_t PROCESSING_CYCLE          = 60U * 1000U;
-
     /** Minimum size of heap memory in bytes, the monitor starts to warn. */
     static const size_t     MIN_HEAP_MEMORY         = 1024U;
 
-    /** Minimum size of largest block of heap that can be allocated at once in bytes, the monitor starts to warn. */
+    /**
+     * Minimum size of largest block of heap that can be allocated at once in bytes, the monitor starts to warn.
+     * It corresponds to what a plugin activation needs, e.g. a display sized canvas with its widgets.
+     */
     static const size_t     MIN_HEAP_BLOCK_MEMORY   = 4096U;
 
+    /**
+     * Free internal heap in bytes, below which the inactive plugins are
+     * requested to release their reloadable assets.
+     */
+    static const size_t     PRESSURE_HEAP_MEMORY    = 16384U;
+
+    /**
+     * Size of the largest block of the internal heap in bytes, below which
+     * the inactive plugins are requested to release their reloadable assets.
+     * It is above the warning level, to relieve the heap before plugin
+     * activations fail.
+     */
+    static const size_t     PRESSURE_HEAP_BLOCK_MEMORY  = 2U * MIN_HEAP_BLOCK_MEMORY;
+
+    /**
+     * Memory regions, which are monitored.
+     */
+    enum Region
+    {
+        REGION_INTERNAL = 0,    /**< Internal SRAM */
+        REGION_DMA,             /**< DMA capable memory */
+        REGION_PSRAM,           /**< External PSRAM */
+        REGION_MAX              /**< Number of regions */
+    };
+
+    /**
+     * Statistic of a memory region.
+     */
+    struct RegionStat
+    {
+        size_t  total;          /**< Total size in byte */
+        size_t  free;           /**< Free memory in byte */
+        size_t  minFree;        /**< Min. free memory since startup in byte */
+        size_t  largestBlock;   /**< Largest free block in byte */
+        uint8_t fragmentation;  /**< Fragmentation in percent: 0 means the free memory is one block. */
+    };
+
+    /**
+     * Get the statistic of a memory region of the latest processing cycle.
+     *
+     * @param[in]  region   Memory region
+     * @param[out] stat     Statistic
+     *
+     * @return If region is available, it will return true otherwise false.
+     */
+    bool getRegionStat(Region region, RegionStat& stat) const;
+
+#if (0 != MEMMON_ALLOC_HISTOGRAM)
+
+    /** Number of allocation size buckets. Bucket n counts sizes up to 2^(n + 4) byte, the last one all above. */
+    static const uint8_t    ALLOC_SIZE_BUCKETS      = 14U;
+
+    /**
+     * Count an allocation in its size bucket.
+     * It is called by the global operator new and therefore must not allocate memory.
+     *
+     * @param[in] size  Allocation size in byte
+     */
+    static void countAllocation(size_t size);
+
+#endif  /* (0 != MEMMON_ALLOC_HISTOGRAM) */
+
 private:
 
-    SimpleTimer m_timer;    /**< Timer used for cyclic processing. */
+    RegionStat  m_stats[REGION_MAX];    /**< Statistic per memory region */
+    bool        m_isLowBlockWarned;     /**< Is the user warned about a low largest heap block? */
+    bool        m_isUnderPressure;      /**< Is the internal heap under pressure? */
 
     /**
      * Constructs the memory monitor.
      */
-    MemMon()
+    MemMon() :
+        m_stats(),
+        m_isLowBlockWarned(false),
+        m_isUnderPressure(false)
     {
     }
 
@@ -109,6 +187,39 @@ private:
 
     MemMon(const MemMon& taskMon);
     MemMon& operator=(const MemMon& taskMon);
+
+    /**
+     * Update the statistic of every memory region and log it.
+     */
+    void updateMemRegions();
+
+    /**
+     * Warn the user once, if the largest block of the internal heap is too
+     * small for a plugin activation.
+     */
+    void checkLargestBlock();
+
+    /**
+     * As long as the internal heap is under pressure, request the inactive
+     * plugins to release their reloadable assets and free the unused images
+     * of the image cache.
+     */
+    void checkPressure();
+
+#if (0 != MEMMON_ALLOC_HISTOGRAM)
+
+    /**
+     * Log the histogram of the allocation sizes.
+     */
+    void logAllocHistogram();
+
+#endif  /* (0 != MEMMON_ALLOC_HISTOGRAM) */
+
+    /**
+     * Log the usage of the plugin memory pool, incl. the memory accounted
+     * to every plugin.
+     */
+    void logPluginMemPool();
 };
 
 /******************************************************************************
@@ -0,0 +1,276 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Network stack monitor
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "NetMon.h"
+
+#include <Metrics.h>
+#include <lwip/tcpip.h>
+#include <lwip/stats.h>
+#include <lwip/memp.h>
+#include <lwip/priv/tcp_priv.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Used pbufs of the pbuf pool. */
+static MetricGauge  gMetricPbufPoolUsed("pixelix_net_pbuf_pool_used", "Number of used pbufs of the pbuf pool.");
+
+/** Max. used pbufs of the pbuf pool since startup. */
+static MetricGauge  gMetricPbufPoolMaxUsed("pixelix_net_pbuf_pool_max_used", "Max. number of used pbufs of the pbuf pool since startup.");
+
+/** Failed pbuf pool allocations since startup. */
+static MetricGauge  gMetricPbufPoolErrors("pixelix_net_pbuf_pool_errors", "Number of failed pbuf pool allocations since startup.");
+
+/** Allocated TCP PCBs. */
+static MetricGauge  gMetricTcpPcbUsed("pixelix_net_tcp_pcbs_used", "Number of allocated TCP PCBs.");
+
+/** Active TCP PCBs. */
+static MetricGauge  gMetricTcpPcbActive("pixelix_net_tcp_pcbs_active", "Number of TCP PCBs in a active state.");
+
+/** Listening TCP PCBs. */
+static MetricGauge  gMetricTcpPcbListen("pixelix_net_tcp_pcbs_listen", "Number of listening TCP PCBs.");
+
+/** TCP PCBs in TIME-WAIT state. */
+static MetricGauge  gMetricTcpPcbTimeWait("pixelix_net_tcp_pcbs_time_wait", "Number of TCP PCBs in TIME-WAIT state.");
+
+/** TCP PCBs with refused data. */
+static MetricGauge  gMetricTcpPcbStalled("pixelix_net_tcp_pcbs_stalled", "Number of TCP PCBs with received data, the application didn't accept yet.");
+
+/** Not acknowledged send data of all connections. */
+static MetricGauge  gMetricTcpSndBuf("pixelix_net_tcp_snd_buf_bytes", "Sum of the not acknowledged send data of all connections in byte.");
+
+/** Max. not acknowledged send data of a single connection. */
+static MetricGauge  gMetricTcpSndBufMax("pixelix_net_tcp_snd_buf_max_bytes", "Max. not acknowledged send data of a single connection in byte.");
+
+/** Max. send queue length of a single connection. */
+static MetricGauge  gMetricTcpSndQueueMax("pixelix_net_tcp_snd_queue_max", "Max. number of pbufs in the send queue of a single connection.");
+
+/** Retransmitted TCP segments since startup. */
+static MetricGauge  gMetricTcpRetrans("pixelix_net_tcp_retransmissions", "Number of retransmitted TCP segments since startup.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void NetMon::process()
+{
+    if ((nullptr == m_xMutex) ||
+        (nullptr == m_xSampled))
+    {
+        return;
+    }
+
+    sampleStats();
+
+    /* A late signal of a previous sample, which timed out, is discarded. */
+    (void)xSemaphoreTake(m_xSampled, 0U);
+
+    /* The TCP PCB lists are only consistent in the tcpip thread. If the
+     * tcpip thread is too busy, the TCP PCB values of the previous sample
+     * are kept.
+     */
+    if (ERR_OK == tcpip_callback(tcpipSample, this))
+    {
+        (void)xSemaphoreTake(m_xSampled, pdMS_TO_TICKS(SAMPLE_TIMEOUT));
+    }
+
+    if (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY))
+    {
+        m_stat = m_sample;
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    gMetricPbufPoolUsed.set(m_sample.pbufPoolUsed);
+    gMetricPbufPoolMaxUsed.set(m_sample.pbufPoolMaxUsed);
+    gMetricPbufPoolErrors.set(static_cast<int32_t>(m_sample.pbufPoolErrors));
+    gMetricTcpPcbUsed.set(m_sample.tcpPcbUsed);
+    gMetricTcpPcbActive.set(m_sample.activePcbs);
+    gMetricTcpPcbListen.set(m_sample.listenPcbs);
+    gMetricTcpPcbTimeWait.set(m_sample.timeWaitPcbs);
+    gMetricTcpPcbStalled.set(m_sample.stalledPcbs);
+    gMetricTcpSndBuf.set(static_cast<int32_t>(m_sample.sndBufUsed));
+    gMetricTcpSndBufMax.set(static_cast<int32_t>(m_sample.maxSndBufUsed));
+    gMetricTcpSndQueueMax.set(m_sample.maxSndQueueLen);
+    gMetricTcpRetrans.set(static_cast<int32_t>(m_sample.retransmissions));
+
+    return;
+}
+
+void NetMon::getStat(Stat& stat)
+{
+    if ((nullptr != m_xMutex) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        stat = m_stat;
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void NetMon::sampleStats()
+{
+#if (0 != LWIP_STATS) && (0 != MEMP_STATS)
+
+    const struct stats_mem* pbufPool    = lwip_stats.memp[MEMP_PBUF_POOL];
+    const struct stats_mem* tcpPcbPool  = lwip_stats.memp[MEMP_TCP_PCB];
+
+    if (nullptr != pbufPool)
+    {
+        m_sample.pbufPoolUsed       = pbufPool->used;
+        m_sample.pbufPoolMaxUsed    = pbufPool->max;
+        m_sample.pbufPoolSize       = pbufPool->avail;
+        m_sample.pbufPoolErrors     = pbufPool->err;
+    }
+
+    if (nullptr != tcpPcbPool)
+    {
+        m_sample.tcpPcbUsed = tcpPcbPool->used;
+        m_sample.tcpPcbSize = tcpPcbPool->avail;
+    }
+
+#endif  /* (0 != LWIP_STATS) && (0 != MEMP_STATS) */
+
+#if (0 != LWIP_STATS) && (0 != MIB2_STATS)
+
+    m_sample.retransmissions = lwip_stats.mib2.tcpretranssegs;
+
+#endif  /* (0 != LWIP_STATS) && (0 != MIB2_STATS) */
+
+    return;
+}
+
+void NetMon::sampleTcpPcbs()
+{
+    const struct tcp_pcb*           pcb         = nullptr;
+    const struct tcp_pcb_listen*    listenPcb   = nullptr;
+    uint16_t                        active      = 0U;
+    uint16_t                        listen      = 0U;
+    uint16_t                        timeWait    = 0U;
+    uint16_t                        stalled     = 0U;
+    uint32_t                        sndBufUsed  = 0U;
+    uint32_t                        maxSndBuf   = 0U;
+    uint16_t                        maxQueueLen = 0U;
+
+    for(pcb = tcp_active_pcbs; nullptr != pcb; pcb = pcb->next)
+    {
+        /* Written by the application, but not acknowledged by the peer yet. */
+        uint32_t used = pcb->snd_lbb - pcb->lastack;
+
+        ++active;
+
+        if (nullptr != pcb->refused_data)
+        {
+            ++stalled;
+        }
+
+        sndBufUsed += used;
+
+        if (maxSndBuf < used)
+        {
+            maxSndBuf = used;
+        }
+
+        if (maxQueueLen < pcb->snd_queuelen)
+        {
+            maxQueueLen = pcb->snd_queuelen;
+        }
+    }
+
+    for(listenPcb = tcp_listen_pcbs.listen_pcbs; nullptr != listenPcb; listenPcb = listenPcb->next)
+    {
+        ++listen;
+    }
+
+    for(pcb = tcp_tw_pcbs; nullptr != pcb; pcb = pcb->next)
+    {
+        ++timeWait;
+    }
+
+    m_sample.activePcbs     = active;
+    m_sample.listenPcbs     = listen;
+    m_sample.timeWaitPcbs   = timeWait;
+    m_sample.stalledPcbs    = stalled;
+    m_sample.sndBufUsed     = sndBufUsed;
+    m_sample.maxSndBufUsed  = maxSndBuf;
+    m_sample.maxSndQueueLen = maxQueueLen;
+
+    return;
+}
+
+void NetMon::tcpipSample(void* ctx)
+{
+    NetMon* netMon = static_cast<NetMon*>(ctx);
+
+    if (nullptr != netMon)
+    {
+        netMon->sampleTcpPcbs();
+        (void)xSemaphoreGive(netMon->m_xSampled);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,170 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Network stack monitor
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __NET_MON_H__
+#define __NET_MON_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Network stack monitor, which samples the health of the lwIP stack cyclic:
+ * pbuf pool usage, TCP protocol control blocks (PCB), send buffer occupancy
+ * and retransmissions. The TCP PCB lists are walked in the tcpip thread,
+ * because only there they are consistent.
+ * It is processed by the diagnostic service.
+ */
+class NetMon
+{
+public:
+
+    /**
+     * Network stack statistic of the latest sample.
+     * A value is 0, if the corresponding lwIP statistic is disabled.
+     */
+    struct Stat
+    {
+        uint16_t    pbufPoolUsed;       /**< Number of used pbufs of the pbuf pool */
+        uint16_t    pbufPoolMaxUsed;    /**< Max. number of used pbufs of the pbuf pool since startup */
+        uint16_t    pbufPoolSize;       /**< Size of the pbuf pool */
+        uint32_t    pbufPoolErrors;     /**< Number of failed pbuf pool allocations since startup */
+        uint16_t    tcpPcbUsed;         /**< Number of allocated TCP PCBs */
+        uint16_t    tcpPcbSize;         /**< Max. number of TCP PCBs */
+        uint16_t    activePcbs;         /**< Number of TCP PCBs in a active state */
+        uint16_t    listenPcbs;         /**< Number of listening TCP PCBs */
+        uint16_t    timeWaitPcbs;       /**< Number of TCP PCBs in TIME-WAIT state */
+        uint16_t    stalledPcbs;        /**< Number of TCP PCBs with received data, the application didn't accept yet. */
+        uint32_t    sndBufUsed;         /**< Sum of the not acknowledged send data of all connections in byte */
+        uint32_t    maxSndBufUsed;      /**< Max. not acknowledged send data of a single connection in byte */
+        uint16_t    maxSndQueueLen;     /**< Max. number of pbufs in the send queue of a single connection */
+        uint32_t    retransmissions;    /**< Number of retransmitted TCP segments since startup */
+    };
+
+    /**
+     * Get network stack monitor instance.
+     *
+     * @return Network stack monitor instance
+     */
+    static NetMon& getInstance()
+    {
+        static NetMon instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Sample the network stack.
+     */
+    void process();
+
+    /**
+     * Get the statistic of the latest sample.
+     *
+     * @param[out] stat Statistic
+     */
+    void getStat(Stat& stat);
+
+    /** Max. time in ms to wait for the tcpip thread to sample the TCP PCBs. */
+    static const uint32_t   SAMPLE_TIMEOUT  = 100U;
+
+private:
+
+    Stat                m_stat;         /**< Statistic of the latest sample */
+    Stat                m_sample;       /**< Statistic, which is currently sampled. */
+    SemaphoreHandle_t   m_xMutex;       /**< Mutex to protect the statistic of the latest sample. */
+    SemaphoreHandle_t   m_xSampled;     /**< Signals that the tcpip thread sampled the TCP PCBs. */
+
+    /**
+     * Constructs the network stack monitor.
+     */
+    NetMon() :
+        m_stat(),
+        m_sample(),
+        m_xMutex(xSemaphoreCreateMutex()),
+        m_xSampled(xSemaphoreCreateBinary())
+    {
+    }
+
+    /**
+     * Destroys the network stack monitor.
+     */
+    ~NetMon()
+    {
+        /* Will never be called. */
+    }
+
+    NetMon(const NetMon& netMon);
+    NetMon& operator=(const NetMon& netMon);
+
+    /**
+     * Sample the lwIP statistics.
+     */
+    void sampleStats();
+
+    /**
+     * Sample the TCP PCB lists. It must be called in the tcpip thread.
+     */
+    void sampleTcpPcbs();
+
+    /**
+     * Called by the tcpip thread to sample the TCP PCBs.
+     *
+     * @param[in] ctx   Context, the network stack monitor
+     */
+    static void tcpipSample(void* ctx);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __NET_MON_H__ */
+
+/** @} */
@@ -0,0 +1,236 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pooled JSON document
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PooledJsonDocument.h"
+
+#include <MemPolicy.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void* JsonDocPool::allocate(size_t size)
+{
+    void* ptr = nullptr;
+
+    if (BUFFER_SIZE >= size)
+    {
+        uint8_t index = 0U;
+
+        lock();
+
+        while((BUFFER_NUM > index) && (true == m_buffers[index].isUsed))
+        {
+            ++index;
+        }
+
+        if (BUFFER_NUM > index)
+        {
+            Buffer& buffer = m_buffers[index];
+
+            /* The buffer is allocated at first use and kept afterwards. */
+            if (nullptr == buffer.data)
+            {
+                buffer.data = MemPolicy::allocate(MemPolicy::REGION_LARGE, BUFFER_SIZE);
+            }
+
+            if (nullptr != buffer.data)
+            {
+                buffer.isUsed   = true;
+                ptr             = buffer.data;
+            }
+        }
+
+        unlock();
+    }
+
+    /* Pool exhausted or document too large? */
+    if (nullptr == ptr)
+    {
+        ptr = MemPolicy::allocate(MemPolicy::REGION_LARGE, size);
+    }
+
+    return ptr;
+}
+
+void JsonDocPool::release(void* ptr)
+{
+    if (nullptr != ptr)
+    {
+        uint8_t index = 0U;
+
+        lock();
+
+        index = findBuffer(ptr);
+
+        if (BUFFER_NUM > index)
+        {
+            m_buffers[index].isUsed = false;
+        }
+
+        unlock();
+
+        if (BUFFER_NUM <= index)
+        {
+            MemPolicy::release(ptr);
+        }
+    }
+
+    return;
+}
+
+void* JsonDocPool::reallocate(void* ptr, size_t newSize)
+{
+    void*   newPtr  = nullptr;
+    uint8_t index   = 0U;
+
+    lock();
+    index = findBuffer(ptr);
+    unlock();
+
+    /* A pool buffer keeps its size. */
+    if (BUFFER_NUM > index)
+    {
+        if (BUFFER_SIZE >= newSize)
+        {
+            newPtr = ptr;
+        }
+    }
+    else
+    {
+        newPtr = MemPolicy::reallocate(MemPolicy::REGION_LARGE, ptr, newSize);
+    }
+
+    return newPtr;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+JsonDocPool::JsonDocPool() :
+    m_buffers(),
+    m_xMutex(xSemaphoreCreateRecursiveMutex())
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < BUFFER_NUM; ++index)
+    {
+        m_buffers[index].data   = nullptr;
+        m_buffers[index].isUsed = false;
+    }
+}
+
+JsonDocPool::~JsonDocPool()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < BUFFER_NUM; ++index)
+    {
+        MemPolicy::release(m_buffers[index].data);
+        m_buffers[index].data = nullptr;
+    }
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+uint8_t JsonDocPool::findBuffer(const void* ptr) const
+{
+    uint8_t index = 0U;
+
+    while((BUFFER_NUM > index) &&
+          ((nullptr == ptr) || (ptr != m_buffers[index].data)))
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+void JsonDocPool::lock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void JsonDocPool::unlock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
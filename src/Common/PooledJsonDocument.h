@@ -0,0 +1,217 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pooled JSON document
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __POOLED_JSON_DOCUMENT_H__
+#define __POOLED_JSON_DOCUMENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Pool of JSON document buffers, which are allocated once in the region for
+ * large buffers and reused afterwards. It avoids the heap churn of
+ * frequently created documents, e.g. by the REST API handlers.
+ *
+ * If all buffers are in use or the requested size exceeds the buffer size,
+ * the memory is allocated in the region for large buffers instead.
+ */
+class JsonDocPool
+{
+public:
+
+    /** Number of buffers in the pool. */
+    static const uint8_t    BUFFER_NUM  = 2U;
+
+    /** Size of a single buffer in byte. */
+    static const size_t     BUFFER_SIZE = 4096U;
+
+    /**
+     * Get the JSON document pool instance.
+     *
+     * @return JSON document pool
+     */
+    static JsonDocPool& getInstance()
+    {
+        static JsonDocPool instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Allocate memory for a document.
+     *
+     * @param[in] size  Size in byte
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Release the document memory.
+     *
+     * @param[in] ptr   Pointer to the memory
+     */
+    void release(void* ptr);
+
+    /**
+     * Change the size of the document memory.
+     *
+     * @param[in] ptr       Pointer to the memory
+     * @param[in] newSize   New size in byte
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    void* reallocate(void* ptr, size_t newSize);
+
+private:
+
+    /**
+     * A single buffer of the pool.
+     */
+    struct Buffer
+    {
+        void*   data;   /**< Buffer memory, allocated at first use */
+        bool    isUsed; /**< Is buffer used by a document? */
+    };
+
+    Buffer              m_buffers[BUFFER_NUM];  /**< Document buffers */
+    SemaphoreHandle_t   m_xMutex;               /**< Mutex to protect the pool */
+
+    /**
+     * Constructs the JSON document pool.
+     */
+    JsonDocPool();
+
+    /**
+     * Destroys the JSON document pool.
+     */
+    ~JsonDocPool();
+
+    /* An instance shall not be copied. */
+    JsonDocPool(const JsonDocPool& pool);
+    JsonDocPool& operator=(const JsonDocPool& pool);
+
+    /**
+     * Find the pool buffer of the given memory.
+     *
+     * @param[in] ptr   Pointer to the memory
+     *
+     * @return Buffer index or BUFFER_NUM if the memory is not part of the pool.
+     */
+    uint8_t findBuffer(const void* ptr) const;
+
+    /**
+     * Lock the pool.
+     */
+    void lock();
+
+    /**
+     * Unlock the pool.
+     */
+    void unlock();
+};
+
+/**
+ * JSON document allocator, which takes the document memory from the
+ * JSON document pool.
+ */
+struct PooledJsonAllocator
+{
+    /**
+     * Allocate memory for the document.
+     *
+     * @param[in] size  Size in byte
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    void* allocate(size_t size)
+    {
+        return JsonDocPool::getInstance().allocate(size);
+    }
+
+    /**
+     * Release the document memory.
+     *
+     * @param[in] ptr   Pointer to the memory
+     */
+    void deallocate(void* ptr)
+    {
+        JsonDocPool::getInstance().release(ptr);
+        return;
+    }
+
+    /**
+     * Change the size of the document memory.
+     *
+     * @param[in] ptr       Pointer to the memory
+     * @param[in] newSize   New size in byte
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    void* reallocate(void* ptr, size_t newSize)
+    {
+        return JsonDocPool::getInstance().reallocate(ptr, newSize);
+    }
+};
+
+/**
+ * JSON document, which memory is taken from the JSON document pool.
+ * Use it for short living documents, which are created frequently.
+ */
+typedef BasicJsonDocument<PooledJsonAllocator> PooledJsonDocument;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __POOLED_JSON_DOCUMENT_H__ */
+
+/** @} */
\ No newline at end of file
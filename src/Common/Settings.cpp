@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "Settings.h"
 
+#include <Logging.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -110,6 +112,45 @@ static const char* KEY_SLOT_CONFIG                  = "slot_cfg";
 /** Scroll pause key */
 static const char* KEY_SCROLL_PAUSE                 = "scroll_pause";
 
+/** Display target frame rate key */
+static const char* KEY_DISPLAY_FPS                  = "display_fps";
+
+/** MQTT broker key */
+static const char* KEY_MQTT_BROKER                  = "mqtt_broker";
+
+/** Wifi connection cache key */
+static const char* KEY_WIFI_CACHE                   = "wifi_cache";
+
+/** Update manifest URL key */
+static const char* KEY_UPDATE_URL                   = "update_url";
+
+/** Slot installation key */
+static const char* KEY_SLOT_INSTALLATION            = "slot_inst";
+
+/** Display sync role key */
+static const char* KEY_SYNC_ROLE                    = "sync_role";
+
+/** Display sync group key */
+static const char* KEY_SYNC_GROUP                   = "sync_group";
+
+/** Display sync span width key */
+static const char* KEY_SYNC_SPAN_WIDTH              = "sync_span_w";
+
+/** Display sync span offset key */
+static const char* KEY_SYNC_SPAN_OFFSET             = "sync_span_offs";
+
+/** Display rotation key */
+static const char* KEY_DISPLAY_ROTATION             = "disp_rotation";
+
+/** Display mirror key */
+static const char* KEY_DISPLAY_MIRROR               = "disp_mirror";
+
+/** Telemetry server key */
+static const char* KEY_TELEMETRY_SERVER             = "telemetry_srv";
+
+/** Telemetry period key */
+static const char* KEY_TELEMETRY_PERIOD             = "telemetry_per";
+
 /* ---------- Key value pair names ---------- */
 
 /** Wifi network name of key value pair */
@@ -157,6 +198,45 @@ static const char*  NAME_SLOT_CONFIG                = "Display slot configuratio
 /** Scroll pause name */
 static const char*  NAME_SCROLL_PAUSE               = "Text scroll pause [ms]";
 
+/** Display target frame rate name */
+static const char*  NAME_DISPLAY_FPS                = "Display refresh rate [fps]";
+
+/** MQTT broker name of key value pair */
+static const char*  NAME_MQTT_BROKER                = "MQTT broker [user:password@]host[:port] (empty = off)";
+
+/** Wifi connection cache name of key value pair */
+static const char*  NAME_WIFI_CACHE                 = "Wifi connection cache";
+
+/** Update manifest URL name of key value pair */
+static const char*  NAME_UPDATE_URL                 = "Update manifest HTTPS URL (empty = off)";
+
+/** Slot installation name of key value pair */
+static const char*  NAME_SLOT_INSTALLATION          = "Slot installation";
+
+/** Display sync role name of key value pair */
+static const char*  NAME_SYNC_ROLE                  = "Display sync role: 0 = off, 1 = master, 2 = slave";
+
+/** Display sync group name of key value pair */
+static const char*  NAME_SYNC_GROUP                 = "Display sync group";
+
+/** Display sync span width name of key value pair */
+static const char*  NAME_SYNC_SPAN_WIDTH            = "Display sync text span width [pixel] (0 = off)";
+
+/** Display sync span offset name of key value pair */
+static const char*  NAME_SYNC_SPAN_OFFSET           = "Display sync text span offset [pixel]";
+
+/** Display rotation name of key value pair */
+static const char*  NAME_DISPLAY_ROTATION           = "Display rotation clockwise: 0 = 0, 1 = 90, 2 = 180, 3 = 270 degree";
+
+/** Display mirror name of key value pair */
+static const char*  NAME_DISPLAY_MIRROR             = "Display mirrored horizontally";
+
+/** Telemetry server name of key value pair */
+static const char*  NAME_TELEMETRY_SERVER           = "Telemetry StatsD server host[:port] (empty = off)";
+
+/** Telemetry period name of key value pair */
+static const char*  NAME_TELEMETRY_PERIOD           = "Telemetry period [s]";
+
 /* ---------- Default values ---------- */
 
 /** Wifi network default value */
@@ -204,6 +284,39 @@ static const char*      DEFAULT_SLOT_CONFIG             = "";
 /** Scroll pause default value in ms */
 static uint32_t         DEFAULT_SCROLL_PAUSE            = 80U;
 
+/** Display target frame rate default value in fps */
+static uint8_t          DEFAULT_DISPLAY_FPS             = 50U;
+
+/** MQTT broker default value */
+static const char*      DEFAULT_MQTT_BROKER             = "";
+
+/** Update manifest URL default value */
+static const char*      DEFAULT_UPDATE_URL              = "";
+
+/** Display sync role default value */
+static uint8_t          DEFAULT_SYNC_ROLE               = 0U;
+
+/** Display sync group default value */
+static uint8_t          DEFAULT_SYNC_GROUP              = 0U;
+
+/** Display sync span width default value in pixel */
+static uint32_t         DEFAULT_SYNC_SPAN_WIDTH         = 0U;
+
+/** Display sync span offset default value in pixel */
+static uint32_t         DEFAULT_SYNC_SPAN_OFFSET        = 0U;
+
+/** Display rotation default value */
+static uint8_t          DEFAULT_DISPLAY_ROTATION        = 0U;
+
+/** Display mirror default value */
+static bool             DEFAULT_DISPLAY_MIRROR          = false;
+
+/** Telemetry server default value */
+static const char*      DEFAULT_TELEMETRY_SERVER        = "";
+
+/** Telemetry period default value in s */
+static uint32_t         DEFAULT_TELEMETRY_PERIOD        = 10U;
+
 /* ---------- Minimum values ---------- */
 
 /** Wifi network SSID min. length. Section 7.3.2.1 of the 802.11-2007 specification. */
@@ -247,6 +360,38 @@ static const size_t     MIN_VALUE_SLOT_CONFIG           = 0U;
 /** Scroll pause minimum value in ms */
 static uint32_t         MIN_VALUE_SCROLL_PAUSE          = 20U;
 
+/** Display target frame rate minimum value in fps */
+static uint8_t          MIN_VALUE_DISPLAY_FPS           = 10U;
+
+/** MQTT broker address min. length */
+static const size_t     MIN_VALUE_MQTT_BROKER           = 0U;
+
+/** Update manifest URL min. length */
+static const size_t     MIN_VALUE_UPDATE_URL            = 0U;
+
+/** Display sync role minimum value */
+static uint8_t          MIN_VALUE_SYNC_ROLE             = 0U;
+
+/** Display sync group minimum value */
+static uint8_t          MIN_VALUE_SYNC_GROUP            = 0U;
+
+/** Display sync span width minimum value in pixel */
+static uint32_t         MIN_VALUE_SYNC_SPAN_WIDTH       = 0U;
+
+/** Display sync span offset minimum value in pixel */
+static uint32_t         MIN_VALUE_SYNC_SPAN_OFFSET      = 0U;
+
+/** Display rotation minimum value */
+static uint8_t          MIN_VALUE_DISPLAY_ROTATION      = 0U;
+
+/*                      MIN_VALUE_DISPLAY_MIRROR */
+
+/** Telemetry server min. length */
+static const size_t     MIN_VALUE_TELEMETRY_SERVER      = 0U;
+
+/** Telemetry period minimum value in s */
+static uint32_t         MIN_VALUE_TELEMETRY_PERIOD      = 1U;
+
 /* ---------- Maximum values ---------- */
 
 /** Wifi network SSID max. length. Section 7.3.2.1 of the 802.11-2007 specification. */
@@ -290,41 +435,186 @@ static const size_t     MAX_VALUE_SLOT_CONFIG           = 256U;
 /** Scroll pause maximum value in ms */
 static uint32_t         MAX_VALUE_SCROLL_PAUSE          = 500U;
 
+/** Display target frame rate maximum value in fps */
+static uint8_t          MAX_VALUE_DISPLAY_FPS           = 60U;
+
+/** MQTT broker address max. length */
+static const size_t     MAX_VALUE_MQTT_BROKER           = 128U;
+
+/** Update manifest URL max. length */
+static const size_t     MAX_VALUE_UPDATE_URL            = 128U;
+
+/** Display sync role maximum value */
+static uint8_t          MAX_VALUE_SYNC_ROLE             = 2U;
+
+/** Display sync group maximum value */
+static uint8_t          MAX_VALUE_SYNC_GROUP            = 255U;
+
+/** Display sync span width maximum value in pixel */
+static uint32_t         MAX_VALUE_SYNC_SPAN_WIDTH       = 4096U;
+
+/** Display sync span offset maximum value in pixel */
+static uint32_t         MAX_VALUE_SYNC_SPAN_OFFSET      = 4096U;
+
+/** Display rotation maximum value */
+static uint8_t          MAX_VALUE_DISPLAY_ROTATION      = 3U;
+
+/*                      MAX_VALUE_DISPLAY_MIRROR */
+
+/** Telemetry server max. length */
+static const size_t     MAX_VALUE_TELEMETRY_SERVER      = 128U;
+
+/** Telemetry period maximum value in s */
+static uint32_t         MAX_VALUE_TELEMETRY_PERIOD      = 3600U;
+
+/** Wifi connection cache max. size in byte, see ConnectingState. */
+static const size_t     MAX_VALUE_WIFI_CACHE            = 16U;
+
+/** Slot installation max. size in byte, enough for the max. number of slots. */
+static const size_t     MAX_VALUE_SLOT_INSTALLATION     = 192U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-bool Settings::open(bool readOnly)
+bool Settings::begin()
 {
-    /* Open Preferences with namespace. Each application module, library, etc
-     * has to use a namespace name to prevent key name collisions. We will open storage in
-     * RW-mode (second parameter has to be false).
-     * Note: Namespace name is limited to 15 chars.
-     */
-    bool status = m_preferences.begin(PREF_NAMESPACE, readOnly);
+    bool status = true;
 
-    /* If settings storage doesn't exist, it will be created. */
-    if ((false == status) &&
-        (true == readOnly))
+    /* Read all key value pairs once at boot, instead of on demand. */
+    lock();
+
+    if (false == m_isLoaded)
     {
-        status = m_preferences.begin(PREF_NAMESPACE, false);
+        if (false == load())
+        {
+            LOG_ERROR("Couldn't read settings.");
+        }
+    }
 
-        if (true == status)
+    unlock();
+
+    if (nullptr == m_flushTaskHandle)
+    {
+        BaseType_t osRet = xTaskCreateUniversal(flushTask,
+                                                "settingsTask",
+                                                FLUSH_TASK_STACK_SIZE,
+                                                this,
+                                                FLUSH_TASK_PRIORITY,
+                                                &m_flushTaskHandle,
+                                                tskNO_AFFINITY);
+
+        if (pdPASS != osRet)
         {
-            m_preferences.end();
-            status = m_preferences.begin(PREF_NAMESPACE, readOnly);
+            m_flushTaskHandle   = nullptr;
+            status              = false;
         }
     }
 
     return status;
 }
 
+bool Settings::open(bool readOnly)
+{
+    bool status = true;
+
+    /* The values are read and written in RAM, therefore read only and
+     * read/write access are the same.
+     */
+    (void)readOnly;
+
+    /* The settings are locked until they are closed again. */
+    lock();
+
+    if (false == m_isLoaded)
+    {
+        status = load();
+    }
+
+    if (false == status)
+    {
+        unlock();
+    }
+
+    return status;
+}
+
 void Settings::close()
 {
-    m_preferences.end();
+    if (true == isDirty())
+    {
+        /* Without the flush task, the changed values are written immediately. */
+        if (nullptr == m_flushTaskHandle)
+        {
+            flush();
+        }
+        else
+        {
+            xTaskNotifyGive(m_flushTaskHandle);
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void Settings::flush()
+{
+    uint8_t index = 0U;
+
+    lock();
+
+    if (true == isDirty())
+    {
+        /* All changed values are written in one session. */
+        if (false == m_preferences.begin(PREF_NAMESPACE, false))
+        {
+            LOG_ERROR("Couldn't write settings.");
+        }
+        else
+        {
+            for(index = 0U; index < KEY_VALUE_PAIR_NUM; ++index)
+            {
+                m_keyValueList[index]->flush();
+            }
+
+            m_preferences.end();
+        }
+    }
+
+    unlock();
+
     return;
 }
 
+bool Settings::clear()
+{
+    bool    status  = false;
+    uint8_t index   = 0U;
+
+    lock();
+
+    if (true == m_preferences.begin(PREF_NAMESPACE, false))
+    {
+        status = m_preferences.clear();
+
+        /* Reading the cleared storage results in the factory defaults and
+         * changed values are discarded, because they would overwrite them.
+         */
+        for(index = 0U; index < KEY_VALUE_PAIR_NUM; ++index)
+        {
+            m_keyValueList[index]->load();
+        }
+
+        m_preferences.end();
+    }
+
+    unlock();
+
+    return status;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -350,7 +640,23 @@ Settings::Settings() :
     m_dateFormatCtrl        (m_preferences, KEY_DATE_FORMAT,            NAME_DATE_FORMAT_CTRL,      DEFAULT_DATE_FORMAT_CTRL),
     m_maxSlots              (m_preferences, KEY_MAX_SLOTS,              NAME_MAX_SLOTS,             DEFAULT_MAX_SLOTS,              MIN_MAX_SLOTS,                  MAX_MAX_SLOTS),
     m_slotConfig            (m_preferences, KEY_SLOT_CONFIG,            NAME_SLOT_CONFIG,           DEFAULT_SLOT_CONFIG,            MIN_VALUE_SLOT_CONFIG,          MAX_VALUE_SLOT_CONFIG),
-    m_scrollPause           (m_preferences, KEY_SCROLL_PAUSE,           NAME_SCROLL_PAUSE,          DEFAULT_SCROLL_PAUSE,           MIN_VALUE_SCROLL_PAUSE,         MAX_VALUE_SCROLL_PAUSE)
+    m_scrollPause           (m_preferences, KEY_SCROLL_PAUSE,           NAME_SCROLL_PAUSE,          DEFAULT_SCROLL_PAUSE,           MIN_VALUE_SCROLL_PAUSE,         MAX_VALUE_SCROLL_PAUSE),
+    m_displayFps            (m_preferences, KEY_DISPLAY_FPS,            NAME_DISPLAY_FPS,           DEFAULT_DISPLAY_FPS,            MIN_VALUE_DISPLAY_FPS,          MAX_VALUE_DISPLAY_FPS),
+    m_mqttBroker            (m_preferences, KEY_MQTT_BROKER,            NAME_MQTT_BROKER,           DEFAULT_MQTT_BROKER,            MIN_VALUE_MQTT_BROKER,          MAX_VALUE_MQTT_BROKER),
+    m_updateUrl             (m_preferences, KEY_UPDATE_URL,             NAME_UPDATE_URL,            DEFAULT_UPDATE_URL,             MIN_VALUE_UPDATE_URL,           MAX_VALUE_UPDATE_URL),
+    m_slotInstallation      (m_preferences, KEY_SLOT_INSTALLATION,      NAME_SLOT_INSTALLATION,     MAX_VALUE_SLOT_INSTALLATION),
+    m_wifiCache             (m_preferences, KEY_WIFI_CACHE,             NAME_WIFI_CACHE,            MAX_VALUE_WIFI_CACHE),
+    m_syncRole              (m_preferences, KEY_SYNC_ROLE,              NAME_SYNC_ROLE,             DEFAULT_SYNC_ROLE,              MIN_VALUE_SYNC_ROLE,            MAX_VALUE_SYNC_ROLE),
+    m_syncGroup             (m_preferences, KEY_SYNC_GROUP,             NAME_SYNC_GROUP,            DEFAULT_SYNC_GROUP,             MIN_VALUE_SYNC_GROUP,           MAX_VALUE_SYNC_GROUP),
+    m_syncSpanWidth         (m_preferences, KEY_SYNC_SPAN_WIDTH,        NAME_SYNC_SPAN_WIDTH,       DEFAULT_SYNC_SPAN_WIDTH,        MIN_VALUE_SYNC_SPAN_WIDTH,      MAX_VALUE_SYNC_SPAN_WIDTH),
+    m_syncSpanOffset        (m_preferences, KEY_SYNC_SPAN_OFFSET,       NAME_SYNC_SPAN_OFFSET,      DEFAULT_SYNC_SPAN_OFFSET,       MIN_VALUE_SYNC_SPAN_OFFSET,     MAX_VALUE_SYNC_SPAN_OFFSET),
+    m_displayRotation       (m_preferences, KEY_DISPLAY_ROTATION,       NAME_DISPLAY_ROTATION,      DEFAULT_DISPLAY_ROTATION,       MIN_VALUE_DISPLAY_ROTATION,     MAX_VALUE_DISPLAY_ROTATION),
+    m_displayMirror         (m_preferences, KEY_DISPLAY_MIRROR,         NAME_DISPLAY_MIRROR,        DEFAULT_DISPLAY_MIRROR),
+    m_telemetryServer       (m_preferences, KEY_TELEMETRY_SERVER,       NAME_TELEMETRY_SERVER,      DEFAULT_TELEMETRY_SERVER,       MIN_VALUE_TELEMETRY_SERVER,     MAX_VALUE_TELEMETRY_SERVER),
+    m_telemetryPeriod       (m_preferences, KEY_TELEMETRY_PERIOD,       NAME_TELEMETRY_PERIOD,      DEFAULT_TELEMETRY_PERIOD,       MIN_VALUE_TELEMETRY_PERIOD,     MAX_VALUE_TELEMETRY_PERIOD),
+    m_isLoaded(false),
+    m_xMutex(xSemaphoreCreateRecursiveMutex()),
+    m_flushTaskHandle(nullptr)
 {
     m_keyValueList[0] = &m_wifiSSID;
     m_keyValueList[1] = &m_wifiPassphrase;
@@ -367,10 +673,136 @@ Settings::Settings() :
     m_keyValueList[12] = &m_maxSlots;
     m_keyValueList[13] = &m_slotConfig;
     m_keyValueList[14] = &m_scrollPause;
+    m_keyValueList[15] = &m_displayFps;
+    m_keyValueList[16] = &m_mqttBroker;
+    m_keyValueList[17] = &m_slotInstallation;
+    m_keyValueList[18] = &m_updateUrl;
+    m_keyValueList[19] = &m_wifiCache;
+    m_keyValueList[20] = &m_syncRole;
+    m_keyValueList[21] = &m_syncGroup;
+    m_keyValueList[22] = &m_syncSpanWidth;
+    m_keyValueList[23] = &m_syncSpanOffset;
+    m_keyValueList[24] = &m_displayRotation;
+    m_keyValueList[25] = &m_displayMirror;
+    m_keyValueList[26] = &m_telemetryServer;
+    m_keyValueList[27] = &m_telemetryPeriod;
 }
 
 Settings::~Settings()
 {
+    if (nullptr != m_flushTaskHandle)
+    {
+        vTaskDelete(m_flushTaskHandle);
+        m_flushTaskHandle = nullptr;
+    }
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+bool Settings::load()
+{
+    uint8_t index   = 0U;
+    bool    status  = false;
+
+    /* Open Preferences with namespace. Each application module, library, etc
+     * has to use a namespace name to prevent key name collisions.
+     * Note: Namespace name is limited to 15 chars.
+     */
+    status = m_preferences.begin(PREF_NAMESPACE, true);
+
+    /* If settings storage doesn't exist, it will be created. */
+    if (false == status)
+    {
+        status = m_preferences.begin(PREF_NAMESPACE, false);
+
+        if (true == status)
+        {
+            m_preferences.end();
+            status = m_preferences.begin(PREF_NAMESPACE, true);
+        }
+    }
+
+    if (true == status)
+    {
+        for(index = 0U; index < KEY_VALUE_PAIR_NUM; ++index)
+        {
+            m_keyValueList[index]->load();
+        }
+
+        m_preferences.end();
+        m_isLoaded = true;
+    }
+
+    return status;
+}
+
+bool Settings::isDirty() const
+{
+    bool    isDirty = false;
+    uint8_t index   = 0U;
+
+    while((false == isDirty) && (KEY_VALUE_PAIR_NUM > index))
+    {
+        isDirty = m_keyValueList[index]->isDirty();
+        ++index;
+    }
+
+    return isDirty;
+}
+
+void Settings::flushTask(void* parameters)
+{
+    Settings* settings = static_cast<Settings*>(parameters);
+
+    if (nullptr != settings)
+    {
+        for(;;)
+        {
+            uint32_t firstChange = 0U;
+
+            /* Wait for the first change. */
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            firstChange = millis();
+
+            /* Further changes within the flush delay are coalesced, but the
+             * write is not postponed endless.
+             */
+            while((0U < ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FLUSH_DELAY))) &&
+                  (MAX_FLUSH_DELAY > (millis() - firstChange)))
+            {
+                /* Just wait ... */
+                ;
+            }
+
+            settings->flush();
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void Settings::lock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void Settings::unlock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
 }
 
 /******************************************************************************
@@ -51,6 +51,7 @@
 #include "KeyValueInt32.h"
 #include "KeyValueUInt32.h"
 #include "KeyValueJson.h"
+#include "KeyValueBlob.h"
 
 /******************************************************************************
  * Macros
@@ -62,6 +63,12 @@
 
 /**
  * Settings class for easy access to persistent stored key:value pairs.
+ *
+ * All key:value pairs are read once from the persistent storage into RAM.
+ * Afterwards every read is served from RAM, without accessing the persistent
+ * storage. Changed values are not written immediately. They are written delayed by a
+ * flush task, which coalesces several changes in a short time into a single
+ * write session and writes only the changed key:value pairs.
  */
 class Settings
 {
@@ -80,8 +87,18 @@ public:
     }
 
     /**
-     * Open settings.
-     * If the settings storage doesn't exist, it will be created.
+     * Read all key:value pairs into RAM and start the flush task, which
+     * writes the changed values delayed. Without the flush task, the changed
+     * values are written when the settings are closed.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Open settings for exclusive access.
+     * On the first call, all key:value pairs are read into RAM. If the
+     * settings storage doesn't exist, it will be created.
      *
      * @param[in] readOnly  Open read only or read/write
      *
@@ -93,9 +110,15 @@ public:
 
     /**
      * Close settings.
+     * If values were changed, the flush task is triggered.
      */
     void close();
 
+    /**
+     * Write all changed values immediately, e.g. before a restart.
+     */
+    void flush();
+
     /**
      * Get remote wifi network SSID.
      *
@@ -157,7 +180,8 @@ public:
     }
 
     /**
-     * Get plugin installation.
+     * Get plugin installation in the legacy JSON format.
+     * It is only used to migrate to the slot installation.
      *
      * @return Key value pair
      */
@@ -227,7 +251,8 @@ public:
     }
 
     /**
-     * Get display slot configuration.
+     * Get display slot configuration in the legacy JSON format.
+     * It is only used to migrate to the slot installation.
      *
      * @return Key value pair
      */
@@ -246,6 +271,138 @@ public:
         return m_scrollPause;
     }
 
+    /**
+     * Get display target frame rate.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt8& getDisplayFps()
+    {
+        return m_displayFps;
+    }
+
+    /**
+     * Get MQTT broker address.
+     *
+     * @return Key value pair
+     */
+    KeyValueString& getMqttBroker()
+    {
+        return m_mqttBroker;
+    }
+
+    /**
+     * Get update manifest URL, which is periodically checked for new software.
+     *
+     * @return Key value pair
+     */
+    KeyValueString& getUpdateUrl()
+    {
+        return m_updateUrl;
+    }
+
+    /**
+     * Get slot installation, which contains the installed plugins and the
+     * slot configuration in binary format.
+     *
+     * @return Key value pair
+     */
+    KeyValueBlob& getSlotInstallation()
+    {
+        return m_slotInstallation;
+    }
+
+    /**
+     * Get wifi connection cache, which contains the channel and BSSID of
+     * the last successful connection in binary format.
+     *
+     * @return Key value pair
+     */
+    KeyValueBlob& getWifiCache()
+    {
+        return m_wifiCache;
+    }
+
+    /**
+     * Get display sync role, see DisplaySync::Role.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt8& getSyncRole()
+    {
+        return m_syncRole;
+    }
+
+    /**
+     * Get display sync group. Only devices of the same group are synchronized.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt8& getSyncGroup()
+    {
+        return m_syncGroup;
+    }
+
+    /**
+     * Get width of the text span over all devices of the display group.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt32& getSyncSpanWidth()
+    {
+        return m_syncSpanWidth;
+    }
+
+    /**
+     * Get offset of this device in the text span of the display group.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt32& getSyncSpanOffset()
+    {
+        return m_syncSpanOffset;
+    }
+
+    /**
+     * Get display rotation clockwise in steps of 90 degree.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt8& getDisplayRotation()
+    {
+        return m_displayRotation;
+    }
+
+    /**
+     * Get display mirror switch.
+     *
+     * @return Key value pair
+     */
+    KeyValueBool& getDisplayMirror()
+    {
+        return m_displayMirror;
+    }
+
+    /**
+     * Get telemetry StatsD server, which receives the metrics periodically.
+     *
+     * @return Key value pair
+     */
+    KeyValueString& getTelemetryServer()
+    {
+        return m_telemetryServer;
+    }
+
+    /**
+     * Get telemetry period in s.
+     *
+     * @return Key value pair
+     */
+    KeyValueUInt32& getTelemetryPeriod()
+    {
+        return m_telemetryPeriod;
+    }
+
     /**
      * Get a list of all key value pairs.
      *
@@ -262,13 +419,16 @@ public:
      *
      * @return If successful cleared, it will return true otherwise false.
      */
-    bool clear()
-    {
-        return m_preferences.clear();
-    }
+    bool clear();
 
     /** Number of key value pairs. */
-    static const uint8_t KEY_VALUE_PAIR_NUM = 15U;
+    static const uint8_t KEY_VALUE_PAIR_NUM = 28U;
+
+    /** Delay in ms after the last change, until the changed values are written. */
+    static const uint32_t FLUSH_DELAY       = 2000U;
+
+    /** Max. delay in ms after the first change, until the changed values are written. */
+    static const uint32_t MAX_FLUSH_DELAY   = 10000U;
 
 private:
 
@@ -290,6 +450,29 @@ private:
     KeyValueUInt8   m_maxSlots;             /**< Max. number of display slots. */
     KeyValueJson    m_slotConfig;           /**< Display slot configuration */
     KeyValueUInt32  m_scrollPause;          /**< Text scroll pause */
+    KeyValueUInt8   m_displayFps;           /**< Display target frame rate */
+    KeyValueString  m_mqttBroker;           /**< MQTT broker address */
+    KeyValueString  m_updateUrl;            /**< Update manifest URL */
+    KeyValueBlob    m_slotInstallation;     /**< Slot installation in binary format, see SlotRecord */
+    KeyValueBlob    m_wifiCache;            /**< Wifi connection cache in binary format, see ConnectingState */
+    KeyValueUInt8   m_syncRole;             /**< Display sync role */
+    KeyValueUInt8   m_syncGroup;            /**< Display sync group */
+    KeyValueUInt32  m_syncSpanWidth;        /**< Display sync text span width */
+    KeyValueUInt32  m_syncSpanOffset;       /**< Display sync text span offset */
+    KeyValueUInt8   m_displayRotation;      /**< Display rotation */
+    KeyValueBool    m_displayMirror;        /**< Display mirror switch */
+    KeyValueString  m_telemetryServer;      /**< Telemetry StatsD server */
+    KeyValueUInt32  m_telemetryPeriod;      /**< Telemetry period */
+
+    bool                m_isLoaded;         /**< Are the key value pairs read into RAM? */
+    SemaphoreHandle_t   m_xMutex;           /**< Mutex to protect against concurrent access. */
+    TaskHandle_t        m_flushTaskHandle;  /**< Flush task handle */
+
+    /** Flush task stack size in bytes */
+    static const uint32_t   FLUSH_TASK_STACK_SIZE   = 4096U;
+
+    /** Flush task priority */
+    static const UBaseType_t FLUSH_TASK_PRIORITY    = 1U;
 
     /**
      * Constructs the settings instance.
@@ -304,6 +487,38 @@ private:
     /* An instance shall not be copied. */
     Settings(const Settings& settings);
     Settings& operator=(const Settings& settings);
+
+    /**
+     * Read all key value pairs from the persistent storage into RAM.
+     * The settings must be locked.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool load();
+
+    /**
+     * Is any value changed, but not written yet?
+     *
+     * @return If any value is dirty, it will return true otherwise false.
+     */
+    bool isDirty() const;
+
+    /**
+     * Flush task, which writes the changed values after a quiet period.
+     *
+     * @param[in] parameters    Task parameters, the settings instance.
+     */
+    static void flushTask(void* parameters);
+
+    /**
+     * Lock settings for exclusive access.
+     */
+    void lock();
+
+    /**
+     * Unlock settings.
+     */
+    void unlock();
 };
 
 /******************************************************************************
@@ -0,0 +1,498 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin state store
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "StateStore.h"
+#include "FileIo.h"
+#include "FileSystem.h"
+
+#include <ConfigJournal.h>
+#include <Logging.h>
+#include <time.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize state store constants */
+const char* StateStore::FILE_NAME       = "/pluginstate.jnl";
+const char* StateStore::TMP_FILE_NAME   = "/pluginstate.tmp";
+const char* StateStore::STALE_COLOR     = "\\#808080";
+
+/** Size in byte of the timestamp, which leads the text in a journal entry. */
+static const size_t     TIMESTAMP_SIZE  = 4U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool StateStore::begin()
+{
+    bool status = true;
+
+    lock();
+    readFile();
+    unlock();
+
+    if (nullptr == m_flushTaskHandle)
+    {
+        BaseType_t osRet = xTaskCreateUniversal(flushTask,
+                                                "stateStoreTask",
+                                                FLUSH_TASK_STACK_SIZE,
+                                                this,
+                                                FLUSH_TASK_PRIORITY,
+                                                &m_flushTaskHandle,
+                                                tskNO_AFFINITY);
+
+        if (pdPASS != osRet)
+        {
+            m_flushTaskHandle   = nullptr;
+            status              = false;
+        }
+    }
+
+    return status;
+}
+
+void StateStore::flush()
+{
+    lock();
+
+    if (true == m_isDirty)
+    {
+        if (false == writeFile())
+        {
+            LOG_ERROR("Couldn't write plugin states.");
+        }
+        else
+        {
+            m_isDirty = false;
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+bool StateStore::load(uint16_t uid, String& text, time_t& timestamp)
+{
+    bool    status  = false;
+    Entry*  entry   = nullptr;
+
+    lock();
+
+    entry = findEntry(uid);
+
+    if (nullptr != entry)
+    {
+        time_t now = time(nullptr);
+
+        /* Without a synchronized time, the age is unknown and the state
+         * is restored anyway.
+         */
+        if ((entry->timestamp >= now) ||
+            (MAX_AGE >= (now - entry->timestamp)))
+        {
+            text        = entry->text;
+            timestamp   = entry->timestamp;
+            status      = true;
+        }
+    }
+
+    unlock();
+
+    return status;
+}
+
+void StateStore::save(uint16_t uid, const String& text)
+{
+    bool isChanged = false;
+
+    lock();
+    isChanged = setEntry(uid, text.substring(0U, MAX_TEXT_LENGTH), time(nullptr));
+    unlock();
+
+    /* The flush task coalesces all changes within the flush period. */
+    if ((true == isChanged) &&
+        (nullptr != m_flushTaskHandle))
+    {
+        xTaskNotifyGive(m_flushTaskHandle);
+    }
+
+    return;
+}
+
+void StateStore::remove(uint16_t uid)
+{
+    Entry* entry = nullptr;
+
+    lock();
+
+    entry = findEntry(uid);
+
+    if (nullptr != entry)
+    {
+        entry->text.clear();
+        entry->isUsed   = false;
+        m_isDirty       = true;
+
+        if (nullptr != m_flushTaskHandle)
+        {
+            xTaskNotifyGive(m_flushTaskHandle);
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+StateStore::StateStore() :
+    m_entries(),
+    m_isDirty(false),
+    m_xMutex(xSemaphoreCreateRecursiveMutex()),
+    m_flushTaskHandle(nullptr)
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        m_entries[index].uid        = 0U;
+        m_entries[index].timestamp  = 0;
+        m_entries[index].isUsed     = false;
+    }
+}
+
+StateStore::~StateStore()
+{
+    if (nullptr != m_flushTaskHandle)
+    {
+        vTaskDelete(m_flushTaskHandle);
+        m_flushTaskHandle = nullptr;
+    }
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+void StateStore::readFile()
+{
+    uint8_t*    buffer  = nullptr;
+    size_t      size    = 0U;
+
+    (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [&buffer, &size]() -> bool
+        {
+            bool    isSuccessful    = false;
+            File    fd              = FILESYSTEM.open(FILE_NAME, "r");
+
+            if (true == fd)
+            {
+                size    = fd.size();
+                buffer  = new uint8_t[size];
+
+                if ((nullptr != buffer) &&
+                    (size == fd.read(buffer, size)))
+                {
+                    isSuccessful = true;
+                }
+
+                fd.close();
+            }
+
+            return isSuccessful;
+        });
+
+    if ((nullptr != buffer) &&
+        (true == ConfigJournal::isHeaderValid(buffer, size)))
+    {
+        ConfigJournal::Entry    journalEntry;
+        size_t                  offset          = ConfigJournal::HEADER_SIZE;
+        size_t                  read            = 0U;
+
+        do
+        {
+            read = ConfigJournal::readEntry(&buffer[offset], size - offset, journalEntry);
+
+            if ((0U < read) &&
+                (TIMESTAMP_SIZE <= journalEntry.size))
+            {
+                String      text;
+                uint32_t    timestamp   = 0U;
+                size_t      index       = 0U;
+
+                for(index = 0U; index < TIMESTAMP_SIZE; ++index)
+                {
+                    timestamp |= static_cast<uint32_t>(journalEntry.data[index]) << (8U * index);
+                }
+
+                (void)text.reserve(journalEntry.size - TIMESTAMP_SIZE);
+
+                for(index = TIMESTAMP_SIZE; index < journalEntry.size; ++index)
+                {
+                    text += static_cast<char>(journalEntry.data[index]);
+                }
+
+                (void)setEntry(journalEntry.uid, text, static_cast<time_t>(timestamp));
+            }
+
+            offset += read;
+        }
+        while((0U < read) && (size > offset));
+
+        if (size > offset)
+        {
+            LOG_WARNING("Plugin state file is corrupt at %u.", offset);
+        }
+    }
+
+    delete[] buffer;
+
+    /* The states are just read, nothing to write. */
+    m_isDirty = false;
+
+    return;
+}
+
+bool StateStore::writeFile()
+{
+    size_t      size    = ConfigJournal::HEADER_SIZE;
+    size_t      offset  = 0U;
+    uint8_t*    buffer  = nullptr;
+    uint8_t     index   = 0U;
+    bool        status  = false;
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        if (true == m_entries[index].isUsed)
+        {
+            size += ConfigJournal::getEntrySize(TIMESTAMP_SIZE + m_entries[index].text.length());
+        }
+    }
+
+    buffer = new uint8_t[size];
+
+    if (nullptr != buffer)
+    {
+        offset += ConfigJournal::writeHeader(buffer, size);
+
+        for(index = 0U; index < MAX_ENTRIES; ++index)
+        {
+            const Entry& entry = m_entries[index];
+
+            if (true == entry.isUsed)
+            {
+                uint8_t     data[TIMESTAMP_SIZE + MAX_TEXT_LENGTH];
+                size_t      dataSize    = TIMESTAMP_SIZE + entry.text.length();
+                uint32_t    timestamp   = static_cast<uint32_t>(entry.timestamp);
+                size_t      byteIndex   = 0U;
+
+                for(byteIndex = 0U; byteIndex < TIMESTAMP_SIZE; ++byteIndex)
+                {
+                    data[byteIndex] = static_cast<uint8_t>(timestamp >> (8U * byteIndex));
+                }
+
+                memcpy(&data[TIMESTAMP_SIZE], entry.text.c_str(), entry.text.length());
+
+                offset += ConfigJournal::writeEntry(entry.uid, data, dataSize, &buffer[offset], size - offset);
+            }
+        }
+
+        /* The state file is replaced only after the temporary file is
+         * written completely.
+         */
+        status = FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+            [buffer, offset]() -> bool
+            {
+                bool    isSuccessful    = false;
+                File    fd              = FILESYSTEM.open(TMP_FILE_NAME, "w");
+
+                if (true == fd)
+                {
+                    isSuccessful = (offset == fd.write(buffer, offset));
+                    fd.close();
+
+                    if (true == isSuccessful)
+                    {
+                        (void)FILESYSTEM.remove(FILE_NAME);
+                        isSuccessful = FILESYSTEM.rename(TMP_FILE_NAME, FILE_NAME);
+                    }
+                }
+
+                return isSuccessful;
+            });
+
+        delete[] buffer;
+    }
+
+    return status;
+}
+
+StateStore::Entry* StateStore::findEntry(uint16_t uid)
+{
+    Entry*  entry   = nullptr;
+    uint8_t index   = 0U;
+
+    while((nullptr == entry) && (MAX_ENTRIES > index))
+    {
+        if ((true == m_entries[index].isUsed) &&
+            (uid == m_entries[index].uid))
+        {
+            entry = &m_entries[index];
+        }
+
+        ++index;
+    }
+
+    return entry;
+}
+
+bool StateStore::setEntry(uint16_t uid, const String& text, time_t timestamp)
+{
+    bool    isChanged   = false;
+    Entry*  entry       = findEntry(uid);
+    uint8_t index       = 0U;
+
+    /* Use a free entry for a new state. */
+    while((nullptr == entry) && (MAX_ENTRIES > index))
+    {
+        if (false == m_entries[index].isUsed)
+        {
+            entry           = &m_entries[index];
+            entry->uid      = uid;
+            entry->isUsed   = true;
+            entry->text.clear();
+        }
+
+        ++index;
+    }
+
+    if (nullptr == entry)
+    {
+        LOG_WARNING("No space for state of plugin %u.", uid);
+    }
+    /* Only a changed text is written again, a new timestamp alone doesn't
+     * justify a flash write.
+     */
+    else if (text != entry->text)
+    {
+        entry->text         = text;
+        entry->timestamp    = timestamp;
+        m_isDirty           = true;
+        isChanged           = true;
+    }
+    else
+    {
+        ;
+    }
+
+    return isChanged;
+}
+
+void StateStore::flushTask(void* parameters)
+{
+    StateStore* store = static_cast<StateStore*>(parameters);
+
+    if (nullptr != store)
+    {
+        for(;;)
+        {
+            /* Wait for the first change. */
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            /* All changes within the flush period are written together. */
+            vTaskDelay(pdMS_TO_TICKS(FLUSH_PERIOD));
+            (void)ulTaskNotifyTake(pdTRUE, 0U);
+
+            store->flush();
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void StateStore::lock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void StateStore::unlock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
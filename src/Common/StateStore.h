@@ -0,0 +1,242 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin state store
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __STATE_STORE_H__
+#define __STATE_STORE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The state store keeps the last known shown text of the plugins, which
+ * poll their data from remote, together with the time of its reception.
+ * After a reboot a plugin shows its last known text immediately, marked as
+ * stale, until it received new data.
+ *
+ * In contrast to the configuration, the state changes frequently. To spare
+ * the flash, the changes are collected in memory and written together in a
+ * single file (see ConfigJournal) after a long period only. A state lost by
+ * a power loss is not critical.
+ */
+class StateStore
+{
+public:
+
+    /** State file name */
+    static const char*          FILE_NAME;
+
+    /** Temporary state file name, used for writing the states. */
+    static const char*          TMP_FILE_NAME;
+
+    /** Text color keyword, which marks a stale text. */
+    static const char*          STALE_COLOR;
+
+    /** Max. number of stored states. */
+    static const uint8_t        MAX_ENTRIES     = 32U;
+
+    /** Max. text length in characters of a state. */
+    static const size_t         MAX_TEXT_LENGTH = 128U;
+
+    /** Period in ms after the first change, till the changes are written. */
+    static const uint32_t       FLUSH_PERIOD    = 10U * 60U * 1000U;
+
+    /** Max. age in s of a state, which is restored. */
+    static const time_t         MAX_AGE         = 7 * 24 * 60 * 60;
+
+    /**
+     * Get the state store instance.
+     *
+     * @return State store
+     */
+    static StateStore& getInstance()
+    {
+        static StateStore instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Read all states from the state file and start the flush task.
+     * Without the flush task, the changes are written at restart only.
+     * The filesystem must be mounted.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Write all changed states, which are not written yet.
+     */
+    void flush();
+
+    /**
+     * Load the last known text of a plugin.
+     * A state, which is older than the max. age, is not restored.
+     *
+     * @param[in]   uid         Plugin UID
+     * @param[out]  text        Last known text
+     * @param[out]  timestamp   Time of the reception as unix timestamp
+     *
+     * @return If a state is available, it will return true otherwise false.
+     */
+    bool load(uint16_t uid, String& text, time_t& timestamp);
+
+    /**
+     * Save the current text of a plugin with the current time.
+     * It is written after the flush period. Saving a unchanged text
+     * changes nothing.
+     *
+     * @param[in] uid   Plugin UID
+     * @param[in] text  Current text
+     */
+    void save(uint16_t uid, const String& text);
+
+    /**
+     * Remove the state of a plugin, e.g. if it is uninstalled.
+     *
+     * @param[in] uid   Plugin UID
+     */
+    void remove(uint16_t uid);
+
+private:
+
+    /**
+     * A stored state.
+     */
+    struct Entry
+    {
+        uint16_t    uid;        /**< Plugin UID */
+        String      text;       /**< Last known text */
+        time_t      timestamp;  /**< Time of the reception as unix timestamp */
+        bool        isUsed;     /**< Is the entry used? */
+    };
+
+    /** Flush task stack size in bytes */
+    static const uint32_t       FLUSH_TASK_STACK_SIZE   = 4096U;
+
+    /** Flush task priority */
+    static const UBaseType_t    FLUSH_TASK_PRIORITY     = 1U;
+
+    Entry               m_entries[MAX_ENTRIES]; /**< Stored states */
+    bool                m_isDirty;              /**< Is any state changed, but not written yet? */
+    SemaphoreHandle_t   m_xMutex;               /**< Mutex to protect against concurrent access. */
+    TaskHandle_t        m_flushTaskHandle;      /**< Flush task handle */
+
+    /**
+     * Constructs the state store.
+     */
+    StateStore();
+
+    /**
+     * Destroys the state store.
+     */
+    ~StateStore();
+
+    /* Prevent copying */
+    StateStore(const StateStore& store);
+    StateStore& operator=(const StateStore& store);
+
+    /**
+     * Read all states from the state file.
+     * A corrupt file end, e.g. because of a power loss, is ignored.
+     */
+    void readFile();
+
+    /**
+     * Write all states into the state file.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool writeFile();
+
+    /**
+     * Get the entry of a plugin.
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return Entry or nullptr if not found.
+     */
+    Entry* findEntry(uint16_t uid);
+
+    /**
+     * Set the state of a plugin.
+     *
+     * @param[in] uid       Plugin UID
+     * @param[in] text      Last known text
+     * @param[in] timestamp Time of the reception as unix timestamp
+     *
+     * @return If the state is changed, it will return true otherwise false.
+     */
+    bool setEntry(uint16_t uid, const String& text, time_t timestamp);
+
+    /**
+     * Flush task, which writes the changed states after the flush period.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void flushTask(void* parameters);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock() const;
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __STATE_STORE_H__ */
+
+/** @} */
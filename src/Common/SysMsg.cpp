@@ -34,7 +34,7 @@
  *****************************************************************************/
 #include "SysMsg.h"
 #include "DisplayMgr.h"
-#include "PluginMgr.h"
+#include <ColorDef.hpp>
 
 #include <Logging.h>
 
@@ -58,62 +58,238 @@
  * Local Variables
  *****************************************************************************/
 
+/* Set widget type */
+const char* SysMsg::MsgOverlay::WIDGET_TYPE = "sysMsg";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 bool SysMsg::init()
 {
-    bool status = false;
+    /* The overlay stays in the display manager and hides itself, as long
+     * as there is no message to show. The active slot keeps running below.
+     */
+    m_isInitialized = DisplayMgr::getInstance().addOverlay(m_overlay, DisplayMgr::OVERLAY_LAYER_SYS_MSG);
 
-    m_plugin = static_cast<SysMsgPlugin*>(PluginMgr::getInstance().install("SysMsgPlugin"));
+    return m_isInitialized;
+}
 
-    if (nullptr != m_plugin)
+void SysMsg::show(const String& msg, uint32_t duration, uint32_t max, Priority priority)
+{
+    if (true == m_isInitialized)
     {
-        uint8_t slotId = DisplayMgr::getInstance().getSlotIdByPluginUID(m_plugin->getUID());
+        m_overlay.show(msg, duration, max, priority);
+    }
+
+    return;
+}
 
-        /* Set infinite slot duration, because the system message plugin will enable/disable
-         * itself.
-         */
-        DisplayMgr::getInstance().setSlotDuration(slotId, 0U, false);
-        DisplayMgr::getInstance().lockSlot(slotId);
-        status = true;
+void SysMsg::show(const RleBitmap& bitmap, uint32_t duration, uint32_t max, Priority priority)
+{
+    if (true == m_isInitialized)
+    {
+        m_overlay.show(bitmap, duration, max, priority);
     }
 
-    return status;
+    return;
 }
 
-void SysMsg::show(const String& msg, uint32_t duration, uint32_t max, bool blocking)
+bool SysMsg::isReady() const
 {
-    if (nullptr != m_plugin)
+    bool isReady = true;
+
+    if (true == m_isInitialized)
     {
-        m_plugin->show(msg, duration, max);
+        isReady = m_overlay.isIdle();
+    }
+
+    return isReady;
+}
+
+SysMsg::MsgOverlay::MsgOverlay() :
+    Widget(WIDGET_TYPE),
+    m_textWidget(),
+    m_bitmap(nullptr),
+    m_bitmapPosX(0),
+    m_bitmapCnt(0U),
+    m_scrollTimer(),
+    m_timer(),
+    m_duration(0U),
+    m_max(0U),
+    m_isInit(true),
+    m_isShown(false),
+    m_isInfinite(false),
+    m_shownMsg(),
+    m_queue(),
+    m_queueCount(0U),
+    m_isVisible(false),
+    m_xMutex(nullptr)
+{
+    /* Move the text widget one line lower for better look. */
+    m_textWidget.move(0, 1);
+
+    m_xMutex = xSemaphoreCreateMutex();
+}
+
+SysMsg::MsgOverlay::~MsgOverlay()
+{
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+void SysMsg::MsgOverlay::update(IGfx& gfx)
+{
+    bool        isScrollingEnabled  = false;
+    uint32_t    scrollingCnt        = 0U;
+    bool        status              = false;
+
+    if ((nullptr != m_xMutex) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        /* A message, which is shown infinite, makes room for the next pending one. */
+        if ((0U < m_queueCount) &&
+            ((false == m_isShown) || (true == m_isInfinite)))
+        {
+            showNext();
+        }
+
+        gfx.fillScreen(ColorDef::BLACK);
+
+        if (false == m_isShown)
+        {
+            ;
+        }
+        else if (nullptr != m_bitmap)
+        {
+            drawBitmap(gfx, isScrollingEnabled, scrollingCnt);
+            status = true;
+        }
+        else
+        {
+            m_textWidget.update(gfx);
+
+            status = m_textWidget.getScrollInfo(isScrollingEnabled, scrollingCnt);
+        }
+
+        /* Nothing shown? */
+        if (false == m_isShown)
+        {
+            ;
+        }
+        /* In initialization phase? */
+        else if (true == m_isInit)
+        {
+            m_timer.stop();
 
-        /* Schedule plugin immediately */
-        DisplayMgr::getInstance().activatePlugin(m_plugin);
+            /* Is the scroll info ready? */
+            if (true == status)
+            {
+                /* Start timer if text doesn't scroll and shall not be shown infinite. */
+                if ((false == isScrollingEnabled) &&
+                    (0U < m_duration))
+                {
+                    m_timer.start(m_duration);
+                }
 
-        if (true == blocking)
+                /* A non-scrolling text without duration and a scrolling text
+                 * without maximum number are shown infinite.
+                 */
+                m_isInfinite    = (false == m_timer.isTimerRunning()) &&
+                                  ((false == isScrollingEnabled) || (0U == m_max));
+                m_isInit        = false;
+            }
+        }
+        /* Is timer running for non-scrolled text? */
+        else if (true == m_timer.isTimerRunning())
         {
-            while(true == m_plugin->isEnabled())
+            /* Hide after duration. */
+            if (true == m_timer.isTimeout())
             {
-                delay(1U);
+                m_timer.stop();
+                m_isShown = false;
             }
         }
+        /* Shall scrolling text be shown a specific number of times? */
+        else if (0U < m_max)
+        {
+            /* Hide after specific number of times, the text was shown. */
+            if (m_max <= scrollingCnt)
+            {
+                m_isShown = false;
+            }
+        }
+        else
+        {
+            /* Show infinite */
+            ;
+        }
+
+        m_isVisible = (true == m_isShown) || (0U < m_queueCount);
+
+        (void)xSemaphoreGive(m_xMutex);
     }
 
     return;
 }
 
-bool SysMsg::isReady() const
+void SysMsg::MsgOverlay::show(const String& msg, uint32_t duration, uint32_t max, Priority priority)
 {
-    bool isReady = false;
+    if ((nullptr != m_xMutex) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        Msg newMsg;
+
+        newMsg.text     = msg;
+        newMsg.duration = duration;
+        newMsg.max      = max;
+        newMsg.priority = priority;
+
+        enqueue(newMsg);
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
 
-    if (nullptr != m_plugin)
+    return;
+}
+
+void SysMsg::MsgOverlay::show(const RleBitmap& bitmap, uint32_t duration, uint32_t max, Priority priority)
+{
+    if ((nullptr != m_xMutex) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
     {
-        isReady = (false == m_plugin->isEnabled()) ? true : false;
+        Msg newMsg;
+
+        newMsg.bitmap   = &bitmap;
+        newMsg.duration = duration;
+        newMsg.max      = max;
+        newMsg.priority = priority;
+
+        enqueue(newMsg);
+
+        (void)xSemaphoreGive(m_xMutex);
     }
 
-    return isReady;
+    return;
+}
+
+bool SysMsg::MsgOverlay::isIdle() const
+{
+    bool isIdle = false;
+
+    if ((nullptr != m_xMutex) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        isIdle = (0U == m_queueCount) &&
+                 ((false == m_isShown) || (true == m_isInfinite));
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return isIdle;
 }
 
 /******************************************************************************
@@ -124,6 +300,152 @@ bool SysMsg::isReady() const
  * Private Methods
  *****************************************************************************/
 
+void SysMsg::MsgOverlay::drawBitmap(IGfx& gfx, bool& isScrollingEnabled, uint32_t& scrollingCnt)
+{
+    const int16_t   DISPLAY_WIDTH   = static_cast<int16_t>(gfx.getWidth());
+    const int16_t   BITMAP_WIDTH    = static_cast<int16_t>(m_bitmap->width);
+
+    isScrollingEnabled = (DISPLAY_WIDTH < BITMAP_WIDTH) ? true : false;
+
+    if (true == m_isInit)
+    {
+        m_bitmapCnt = 0U;
+
+        if (true == isScrollingEnabled)
+        {
+            /* The user can see the first characters better, if starting nearly outside the canvas. */
+            m_bitmapPosX = DISPLAY_WIDTH - 1;
+            m_scrollTimer.start(TextWidget::getScrollPause());
+        }
+        else
+        {
+            m_bitmapPosX = (DISPLAY_WIDTH - BITMAP_WIDTH) / 2;
+            m_scrollTimer.stop();
+        }
+    }
+    else if ((true == m_scrollTimer.isTimerRunning()) &&
+             (true == m_scrollTimer.isTimeout()))
+    {
+        --m_bitmapPosX;
+
+        /* Completely scrolled out? */
+        if ((-BITMAP_WIDTH) >= m_bitmapPosX)
+        {
+            m_bitmapPosX = DISPLAY_WIDTH - 1;
+            ++m_bitmapCnt;
+        }
+
+        m_scrollTimer.start(TextWidget::getScrollPause());
+    }
+    else
+    {
+        ;
+    }
+
+    /* Move the message one line lower for better look, like the text widget. */
+    m_bitmap->draw(gfx, m_bitmapPosX, 1);
+
+    scrollingCnt = m_bitmapCnt;
+
+    return;
+}
+
+void SysMsg::MsgOverlay::enqueue(const Msg& msg)
+{
+    uint8_t pos         = 0U;
+    bool    isDuplicate = false;
+
+    /* Behind all pending messages with the same or a higher priority. */
+    while((m_queueCount > pos) &&
+          (m_queue[pos].priority >= msg.priority))
+    {
+        ++pos;
+    }
+
+    /* A message, which is requested again and again, e.g. during reconnects,
+     * is shown only once.
+     */
+    if ((0U < pos) &&
+        (msg.priority == m_queue[pos - 1U].priority))
+    {
+        isDuplicate = m_queue[pos - 1U].isSame(msg);
+    }
+    else if (0U == m_queueCount)
+    {
+        isDuplicate = (true == m_isShown) && (true == m_shownMsg.isSame(msg));
+    }
+    else
+    {
+        ;
+    }
+
+    if (true == isDuplicate)
+    {
+        ;
+    }
+    /* Queue full? The last pending message has the lowest priority. */
+    else if ((MAX_QUEUE_SIZE <= m_queueCount) &&
+             (m_queueCount <= pos))
+    {
+        LOG_WARNING_DEFERRED("System message queue full, message skipped.");
+    }
+    else
+    {
+        uint8_t index = 0U;
+
+        if (MAX_QUEUE_SIZE <= m_queueCount)
+        {
+            LOG_WARNING_DEFERRED("System message queue full, message with lower priority skipped.");
+            --m_queueCount;
+        }
+
+        for(index = m_queueCount; index > pos; --index)
+        {
+            m_queue[index] = m_queue[index - 1U];
+        }
+
+        m_queue[pos] = msg;
+        ++m_queueCount;
+
+        m_isVisible = true;
+    }
+
+    return;
+}
+
+void SysMsg::MsgOverlay::showNext()
+{
+    uint8_t index = 0U;
+
+    m_shownMsg = m_queue[0];
+
+    for(index = 1U; index < m_queueCount; ++index)
+    {
+        m_queue[index - 1U] = m_queue[index];
+    }
+
+    --m_queueCount;
+    m_queue[m_queueCount].text.clear();
+
+    if (nullptr != m_shownMsg.bitmap)
+    {
+        m_bitmap = m_shownMsg.bitmap;
+    }
+    else
+    {
+        m_textWidget.setFormatStr(m_shownMsg.text);
+        m_bitmap = nullptr;
+    }
+
+    m_duration      = m_shownMsg.duration;
+    m_max           = m_shownMsg.max;
+    m_isInit        = true;
+    m_isShown       = true;
+    m_isInfinite    = false;
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
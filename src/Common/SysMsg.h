@@ -44,8 +44,13 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
-#include <SysMsgPlugin.h>
 #include <WString.h>
+#include <Widget.hpp>
+#include <TextWidget.h>
+#include <RleBitmap.h>
+#include <SimpleTimer.hpp>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 /******************************************************************************
  * Macros
@@ -57,11 +62,27 @@
 
 /**
  * System message handler.
+ * The messages are queued by priority and shown one after another, so a
+ * caller never waits for the display.
  */
 class SysMsg
 {
 public:
 
+    /**
+     * Message priority. A message with higher priority is shown before
+     * the pending messages with lower priority.
+     */
+    enum Priority
+    {
+        PRIORITY_LOW = 0,   /**< Low priority, e.g. for informations. */
+        PRIORITY_NORMAL,    /**< Normal priority */
+        PRIORITY_HIGH       /**< High priority, e.g. for errors. */
+    };
+
+    /** Max. number of pending messages, e.g. enough for the startup sequence. */
+    static const uint8_t    MAX_QUEUE_SIZE  = 8U;
+
     /**
      * Get system message handler instance.
      *
@@ -76,24 +97,43 @@ public:
 
     /**
      * Initialize system message handler.
-     * It will hook into the display manager.
+     * It will hook into the display manager as overlay, which is shown on
+     * top of the active slot without deactivating it.
      *
      * @return If initialization is successful, it will return true otherwise false.
      */
     bool init(void);
 
     /**
-     * Show message with the given duration. If the duration is infinite, it will be shown infinite.
+     * Show message with the given duration. If the duration is infinite, it will be shown
+     * until the next message is pending.
+     * The message is queued and the function returns immediately. If the same message
+     * is already the last pending one with this priority, it won't be queued again.
      *
      * @param[in] msg       Message to show
      * @param[in] duration  Duration in ms, how long a non-scrolling message shall be shown.
      * @param[in] max       How often shall a scrolling message be shown.
-     * @param[in] blocking  If false, function will return immediately, otherwise waits till end.
+     * @param[in] priority  Message priority
+     */
+    void show(const String& msg, uint32_t duration = 0U, uint32_t max = 0U, Priority priority = PRIORITY_NORMAL);
+
+    /**
+     * Show a pre-rendered message with the given duration. If the duration is infinite, it will be shown
+     * until the next message is pending.
+     * The bitmap is drawn directly, so no text is rendered and no heap is used.
+     * A bitmap, which is narrower than the display, is shown centered, otherwise it scrolls.
+     *
+     * @param[in] bitmap    Pre-rendered message, which must stay valid while it is shown.
+     * @param[in] duration  Duration in ms, how long a non-scrolling message shall be shown.
+     * @param[in] max       How often shall a scrolling message be shown.
+     * @param[in] priority  Message priority
      */
-    void show(const String& msg, uint32_t duration = 0U, uint32_t max = 0U, bool blocking = false);
+    void show(const RleBitmap& bitmap, uint32_t duration = 0U, uint32_t max = 0U, Priority priority = PRIORITY_NORMAL);
 
     /**
-     * Is the system message handler ready for the next message?
+     * Is the system message handler ready, which means that no message is
+     * pending and the shown one, if any, is shown infinite? If the handler
+     * is not initialized, it is always ready.
      *
      * @return If system message is ready, it will return true otherwise false.
      */
@@ -101,13 +141,168 @@ public:
 
 private:
 
-    SysMsgPlugin*   m_plugin;   /**< Plugin, used to show system messages */
+    /**
+     * Shows the system messages over the whole display, one after another.
+     * If the text is too long for the display width, it automatically scrolls.
+     * It hides itself after the last message was shown long enough.
+     */
+    class MsgOverlay : public Widget
+    {
+    public:
+
+        /**
+         * Constructs the hidden message overlay.
+         */
+        MsgOverlay();
+
+        /**
+         * Destroys the message overlay.
+         */
+        ~MsgOverlay();
+
+        /**
+         * Update/Draw the message overlay.
+         *
+         * @param[in] gfx Graphics interface
+         */
+        void update(IGfx& gfx) final;
+
+        /**
+         * Is the message overlay visible?
+         *
+         * @return If a message is shown or pending, it will return true otherwise false.
+         */
+        bool isVisible() const final
+        {
+            return m_isVisible;
+        }
+
+        /**
+         * Queue message.
+         *
+         * @param[in] msg       Message to show
+         * @param[in] duration  Duration in ms, how long a non-scrolling text shall be shown.
+         * @param[in] max       Maximum number how often a scrolling text shall be shown.
+         * @param[in] priority  Message priority
+         */
+        void show(const String& msg, uint32_t duration, uint32_t max, Priority priority);
+
+        /**
+         * Queue pre-rendered message.
+         *
+         * @param[in] bitmap    Pre-rendered message
+         * @param[in] duration  Duration in ms, how long a non-scrolling message shall be shown.
+         * @param[in] max       Maximum number how often a scrolling message shall be shown.
+         * @param[in] priority  Message priority
+         */
+        void show(const RleBitmap& bitmap, uint32_t duration, uint32_t max, Priority priority);
+
+        /**
+         * Is the message overlay idle, which means that no message is pending
+         * and the shown one, if any, is shown infinite?
+         *
+         * @return If idle, it will return true otherwise false.
+         */
+        bool isIdle() const;
+
+        /** Widget type string */
+        static const char*  WIDGET_TYPE;
+
+    private:
+
+        /**
+         * A pending message.
+         */
+        struct Msg
+        {
+            String              text;       /**< Message text, if not pre-rendered */
+            const RleBitmap*    bitmap;     /**< Pre-rendered message or nullptr */
+            uint32_t            duration;   /**< Duration in ms, how long a non-scrolling message shall be shown. */
+            uint32_t            max;        /**< Maximum number how often a scrolling message shall be shown. */
+            Priority            priority;   /**< Message priority */
+
+            /**
+             * Constructs a empty message.
+             */
+            Msg() :
+                text(),
+                bitmap(nullptr),
+                duration(0U),
+                max(0U),
+                priority(PRIORITY_NORMAL)
+            {
+            }
+
+            /**
+             * Is the message content the same as of another message?
+             *
+             * @param[in] msg   Other message
+             *
+             * @return If the same, it will return true otherwise false.
+             */
+            bool isSame(const Msg& msg) const
+            {
+                return ((bitmap == msg.bitmap) &&
+                        (duration == msg.duration) &&
+                        (max == msg.max) &&
+                        (text == msg.text));
+            }
+        };
+
+        TextWidget          m_textWidget;   /**< Text widget, used for showing the text. */
+        const RleBitmap*    m_bitmap;       /**< Pre-rendered message, which is shown instead of the text. */
+        int16_t             m_bitmapPosX;   /**< x-coordinate of the pre-rendered message, used for scrolling. */
+        uint32_t            m_bitmapCnt;    /**< Counts how often the pre-rendered message was complete scrolled. */
+        SimpleTimer         m_scrollTimer;  /**< Timer used to scroll the pre-rendered message. */
+        SimpleTimer         m_timer;        /**< Timer used to observer minimum duration */
+        uint32_t            m_duration;     /**< Duration in ms, how long a non-scrolling text shall be shown. */
+        uint32_t            m_max;          /**< Maximum number how often a scrolling text shall be shown. */
+        bool                m_isInit;       /**< Is initialization phase? Leaving this phase means to have duration and etc. handled. */
+        bool                m_isShown;      /**< Is a message shown? */
+        bool                m_isInfinite;   /**< Is the shown message shown infinite? */
+        Msg                 m_shownMsg;     /**< Shown message, used to detect duplicates. */
+        Msg                 m_queue[MAX_QUEUE_SIZE];    /**< Pending messages, ordered by priority. */
+        uint8_t             m_queueCount;   /**< Number of pending messages */
+        volatile bool       m_isVisible;    /**< Is a message shown or pending? */
+        SemaphoreHandle_t   m_xMutex;       /**< Protects the messages against concurrent access by the display task. */
+
+        MsgOverlay(const MsgOverlay& overlay);
+        MsgOverlay& operator=(const MsgOverlay& overlay);
+
+        /**
+         * Draw the pre-rendered message and scroll it, if its wider than the display.
+         *
+         * @param[in]  gfx                  Graphics interface
+         * @param[out] isScrollingEnabled   Is the message scrolling?
+         * @param[out] scrollingCnt         How often the message was complete scrolled.
+         */
+        void drawBitmap(IGfx& gfx, bool& isScrollingEnabled, uint32_t& scrollingCnt);
+
+        /**
+         * Queue a message by its priority. A message, which is the same as
+         * the last pending one with this priority, is skipped. If the queue is
+         * full, the last pending message is replaced, if it has a lower priority.
+         * The overlay must be locked before.
+         *
+         * @param[in] msg   Message
+         */
+        void enqueue(const Msg& msg);
+
+        /**
+         * Show the next pending message. The overlay must be locked before.
+         */
+        void showNext();
+    };
+
+    bool        m_isInitialized;    /**< Is the system message handler hooked into the display manager? */
+    MsgOverlay  m_overlay;          /**< Overlay, used to show system messages */
 
     /**
      * Constructs the system message handler.
      */
     SysMsg() :
-        m_plugin(nullptr)
+        m_isInitialized(false),
+        m_overlay()
     {
     }
 
@@ -0,0 +1,447 @@
+/* Generated by renderSysMsg.py from lib/Gfx/TomThumb.h, don't edit. */
+
+#include "SysMsgBitmaps.h"
+#include <pgmspace.h>
+
+/* "PIXELIX", 24 x 6 pixels */
+static const uint32_t SYS_MSG_PIXELIX_PALETTE[] PROGMEM = {
+    0xff0000, 0x0ff000, 0x00ff00, 0x000ff0, 0x0000ff, 0xf0000f
+};
+
+static const uint8_t SYS_MSG_PIXELIX_RUNS[] PROGMEM = {
+    0x22, 0x00, 0x40, 0x00, 0x60, 0x00, 0x60, 0x00, 0x82, 0x00, 0xa0, 0x02, 0xc0, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x40, 0x00, 0x60, 0x00, 0x60, 0x00, 0x80, 0x02, 0xa0, 0x02,
+    0xc0, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x40, 0x01, 0x60, 0x01, 0x82, 0x00, 0xa0, 0x02,
+    0xc0, 0x01, 0x20, 0x01, 0x20, 0x02, 0x40, 0x00, 0x60, 0x00, 0x60, 0x00, 0x80, 0x02, 0xa0, 0x02,
+    0xc0, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x40, 0x00, 0x60, 0x00, 0x60, 0x00, 0x82, 0x00,
+    0xa2, 0x00, 0xc0, 0x00, 0x20, 0x00, 0x20, 0x00, 0x17,
+};
+
+const RleBitmap SYS_MSG_PIXELIX = {
+    24U, 6U, SYS_MSG_PIXELIX_PALETTE, 6U, SYS_MSG_PIXELIX_RUNS, sizeof(SYS_MSG_PIXELIX_RUNS)
+};
+
+/* "Update", 24 x 6 pixels */
+static const uint32_t SYS_MSG_UPDATE_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_UPDATE_RUNS[] PROGMEM = {
+    0x20, 0x00, 0x20, 0x06, 0x20, 0x05, 0x20, 0x05, 0x20, 0x00, 0x20, 0x00, 0x21, 0x02, 0x21, 0x00,
+    0x21, 0x01, 0x22, 0x01, 0x21, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x21, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01, 0x22, 0x00,
+    0x21, 0x02, 0x21, 0x00, 0x22, 0x01, 0x21, 0x01, 0x21, 0x00, 0x03, 0x20, 0x12,
+};
+
+const RleBitmap SYS_MSG_UPDATE = {
+    24U, 6U, SYS_MSG_UPDATE_PALETTE, 1U, SYS_MSG_UPDATE_RUNS, sizeof(SYS_MSG_UPDATE_RUNS)
+};
+
+/* "...", 6 x 6 pixels */
+static const uint32_t SYS_MSG_ELLIPSIS_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_ELLIPSIS_RUNS[] PROGMEM = {
+    0x05, 0x05, 0x05, 0x05, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x05,
+};
+
+const RleBitmap SYS_MSG_ELLIPSIS = {
+    6U, 6U, SYS_MSG_ELLIPSIS_PALETTE, 1U, SYS_MSG_ELLIPSIS_RUNS, sizeof(SYS_MSG_ELLIPSIS_RUNS)
+};
+
+/* "Set wifi mode failed.", 70 x 6 pixels */
+static const uint32_t SYS_MSG_WIFI_MODE_FAILED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_WIFI_MODE_FAILED_RUNS[] PROGMEM = {
+    0x22, 0x05, 0x20, 0x07, 0x20, 0x02, 0x20, 0x00, 0x20, 0x0c, 0x20, 0x08, 0x20, 0x04, 0x20, 0x00,
+    0x21, 0x07, 0x20, 0x02, 0x20, 0x03, 0x21, 0x00, 0x22, 0x02, 0x20, 0x00, 0x20, 0x03, 0x20, 0x05,
+    0x22, 0x01, 0x20, 0x02, 0x21, 0x01, 0x21, 0x03, 0x20, 0x01, 0x21, 0x04, 0x20, 0x02, 0x21, 0x01,
+    0x21, 0x02, 0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x03, 0x22, 0x00, 0x20, 0x00, 0x22, 0x00,
+    0x20, 0x02, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02,
+    0x22, 0x01, 0x21, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02,
+    0x01, 0x20, 0x00, 0x21, 0x02, 0x20, 0x03, 0x22, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x02, 0x22,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x04, 0x20, 0x01, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01, 0x20, 0x00, 0x20, 0x02, 0x22, 0x01, 0x21, 0x01, 0x21,
+    0x02, 0x22, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0x21,
+    0x01, 0x21, 0x03, 0x20, 0x01, 0x22, 0x00, 0x20, 0x00, 0x22, 0x01, 0x21, 0x01, 0x21, 0x00, 0x20,
+    0x00, 0x1f, 0x1f, 0x05,
+};
+
+const RleBitmap SYS_MSG_WIFI_MODE_FAILED = {
+    70U, 6U, SYS_MSG_WIFI_MODE_FAILED_PALETTE, 1U, SYS_MSG_WIFI_MODE_FAILED_RUNS, sizeof(SYS_MSG_WIFI_MODE_FAILED_RUNS)
+};
+
+/* "Failed to setup mDNS.", 75 x 6 pixels */
+static const uint32_t SYS_MSG_MDNS_FAILED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_MDNS_FAILED_RUNS[] PROGMEM = {
+    0x22, 0x04, 0x20, 0x00, 0x21, 0x07, 0x20, 0x03, 0x20, 0x10, 0x20, 0x0f, 0x21, 0x01, 0x20, 0x01,
+    0x20, 0x00, 0x22, 0x02, 0x20, 0x02, 0x21, 0x04, 0x20, 0x02, 0x21, 0x01, 0x21, 0x02, 0x22, 0x01,
+    0x20, 0x04, 0x21, 0x01, 0x21, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x03, 0x22, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x21, 0x00, 0x20, 0x00, 0x20, 0x04, 0x22, 0x01, 0x21, 0x00, 0x20, 0x01,
+    0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x03, 0x20, 0x01, 0x20, 0x00, 0x20, 0x02,
+    0x21, 0x01, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02,
+    0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x00, 0x22, 0x02, 0x20, 0x02, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01, 0x20, 0x00, 0x20, 0x03, 0x20, 0x01, 0x20, 0x00,
+    0x20, 0x03, 0x21, 0x00, 0x21, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02,
+    0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x22, 0x00,
+    0x20, 0x00, 0x22, 0x01, 0x21, 0x01, 0x21, 0x03, 0x21, 0x01, 0x20, 0x03, 0x21, 0x02, 0x21, 0x01,
+    0x21, 0x01, 0x21, 0x00, 0x21, 0x03, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x01, 0x20, 0x00,
+    0x22, 0x00, 0x20, 0x00, 0x1f, 0x11, 0x20, 0x17,
+};
+
+const RleBitmap SYS_MSG_MDNS_FAILED = {
+    75U, 6U, SYS_MSG_MDNS_FAILED_PALETTE, 1U, SYS_MSG_MDNS_FAILED_RUNS, sizeof(SYS_MSG_MDNS_FAILED_RUNS)
+};
+
+/* "Set autom. reconnect failed.", 100 x 6 pixels */
+static const uint32_t SYS_MSG_AUTO_RECONNECT_FAILED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_AUTO_RECONNECT_FAILED_RUNS[] PROGMEM = {
+    0x22, 0x05, 0x20, 0x0c, 0x20, 0x1f, 0x0e, 0x20, 0x05, 0x20, 0x04, 0x20, 0x00, 0x21, 0x07, 0x20,
+    0x02, 0x20, 0x03, 0x21, 0x00, 0x22, 0x02, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00, 0x22, 0x01, 0x20,
+    0x01, 0x22, 0x05, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x20, 0x01, 0x21, 0x01, 0x21, 0x02, 0x21,
+    0x01, 0x21, 0x00, 0x22, 0x03, 0x20, 0x01, 0x21, 0x04, 0x20, 0x02, 0x21, 0x01, 0x21, 0x02, 0x22,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x04, 0x21, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20,
+    0x00, 0x20, 0x00, 0x22, 0x04, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x03, 0x20,
+    0x03, 0x22, 0x01, 0x21, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x02, 0x01, 0x20, 0x00, 0x21, 0x02, 0x20, 0x03, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01,
+    0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x22, 0x04, 0x20, 0x02, 0x21, 0x01, 0x20, 0x02, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x03, 0x20, 0x04,
+    0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01, 0x20, 0x00, 0x20, 0x02,
+    0x22, 0x01, 0x21, 0x01, 0x21, 0x02, 0x22, 0x01, 0x21, 0x01, 0x21, 0x01, 0x20, 0x01, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x02, 0x20, 0x03, 0x21, 0x01, 0x21, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x03, 0x20, 0x01, 0x22, 0x00, 0x20, 0x00,
+    0x22, 0x01, 0x21, 0x01, 0x21, 0x00, 0x20, 0x00, 0x1f, 0x1f, 0x1f, 0x03,
+};
+
+const RleBitmap SYS_MSG_AUTO_RECONNECT_FAILED = {
+    100U, 6U, SYS_MSG_AUTO_RECONNECT_FAILED_PALETTE, 1U, SYS_MSG_AUTO_RECONNECT_FAILED_RUNS, sizeof(SYS_MSG_AUTO_RECONNECT_FAILED_RUNS)
+};
+
+/* "Keep button pressed and reboot. Set SSID/password via webserer.", 228 x 6 pixels */
+static const uint32_t SYS_MSG_KEEP_BUTTON_PRESSED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_KEEP_BUTTON_PRESSED_RUNS[] PROGMEM = {
+    0x20, 0x00, 0x20, 0x0e, 0x20, 0x07, 0x20, 0x02, 0x20, 0x1f, 0x05, 0x20, 0x0c, 0x20, 0x0a, 0x20,
+    0x0b, 0x20, 0x05, 0x22, 0x05, 0x20, 0x03, 0x22, 0x00, 0x22, 0x00, 0x20, 0x00, 0x21, 0x03, 0x20,
+    0x1e, 0x20, 0x06, 0x20, 0x0e, 0x20, 0x18, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x00, 0x21,
+    0x03, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00, 0x22, 0x00, 0x22, 0x01, 0x20, 0x01, 0x21, 0x03, 0x21,
+    0x02, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x02, 0x21, 0x01, 0x21,
+    0x02, 0x21, 0x03, 0x21, 0x01, 0x21, 0x00, 0x21, 0x02, 0x20, 0x02, 0x20, 0x01, 0x22, 0x04, 0x20,
+    0x03, 0x21, 0x00, 0x22, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20,
+    0x00, 0x21, 0x01, 0x21, 0x02, 0x21, 0x01, 0x21, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0x21,
+    0x01, 0x21, 0x02, 0x20, 0x00, 0x20, 0x02, 0x21, 0x03, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x21,
+    0x02, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x02, 0x21, 0x01, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x03, 0x21, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x05, 0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x03, 0x22, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x21, 0x01, 0x21, 0x01, 0x22,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0x21, 0x02, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x20, 0x00, 0x20, 0x00, 0x21,
+    0x01, 0x21, 0x01, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x02, 0x21, 0x02, 0x21, 0x01, 0x21, 0x00, 0x21, 0x01, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02, 0x21, 0x01, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x07, 0x20, 0x00, 0x21, 0x02, 0x20,
+    0x05, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x02, 0x20, 0x00, 0x20, 0x02, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x22, 0x00, 0x21,
+    0x01, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x21, 0x01, 0x20, 0x02, 0x21, 0x01, 0x20, 0x04, 0x20,
+    0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x00, 0x21, 0x03, 0x21, 0x02, 0x21, 0x01, 0x21, 0x01, 0x21,
+    0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x02, 0x21, 0x01, 0x20, 0x03, 0x21, 0x00, 0x21, 0x01, 0x21,
+    0x02, 0x21, 0x01, 0x21, 0x02, 0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x02, 0x20, 0x03, 0x21,
+    0x00, 0x21, 0x02, 0x20, 0x02, 0x20, 0x02, 0x21, 0x00, 0x20, 0x02, 0x22, 0x01, 0x21, 0x01, 0x21,
+    0x02, 0x22, 0x00, 0x22, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x02, 0x21, 0x01, 0x22, 0x00, 0x21,
+    0x01, 0x21, 0x01, 0x22, 0x01, 0x20, 0x01, 0x20, 0x03, 0x21, 0x03, 0x20, 0x01, 0x20, 0x00, 0x22,
+    0x02, 0x22, 0x01, 0x21, 0x00, 0x21, 0x01, 0x21, 0x02, 0x21, 0x00, 0x20, 0x03, 0x21, 0x00, 0x20,
+    0x02, 0x20, 0x00, 0x0b, 0x20, 0x1e, 0x20, 0x1f, 0x1f, 0x1f, 0x06, 0x20, 0x1f, 0x1f, 0x0e,
+};
+
+const RleBitmap SYS_MSG_KEEP_BUTTON_PRESSED = {
+    228U, 6U, SYS_MSG_KEEP_BUTTON_PRESSED_PALETTE, 1U, SYS_MSG_KEEP_BUTTON_PRESSED_RUNS, sizeof(SYS_MSG_KEEP_BUTTON_PRESSED_RUNS)
+};
+
+/* "Configure wifi access point failed.", 120 x 6 pixels */
+static const uint32_t SYS_MSG_AP_CONFIG_FAILED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_AP_CONFIG_FAILED_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x0b, 0x20, 0x00, 0x20, 0x16, 0x20, 0x02, 0x20, 0x00, 0x20, 0x1f, 0x04, 0x20, 0x05,
+    0x20, 0x05, 0x20, 0x04, 0x20, 0x00, 0x21, 0x07, 0x20, 0x02, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01,
+    0x21, 0x02, 0x20, 0x04, 0x21, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x02, 0x20, 0x00,
+    0x20, 0x03, 0x20, 0x05, 0x21, 0x02, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x02,
+    0x21, 0x02, 0x20, 0x03, 0x21, 0x01, 0x22, 0x03, 0x20, 0x01, 0x21, 0x04, 0x20, 0x02, 0x21, 0x01,
+    0x21, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x22, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x02, 0x22, 0x00,
+    0x20, 0x00, 0x22, 0x00, 0x20, 0x03, 0x21, 0x00, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00,
+    0x21, 0x01, 0x21, 0x03, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x03, 0x22, 0x01, 0x21, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01,
+    0x20, 0x01, 0x20, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x21, 0x03, 0x22, 0x00,
+    0x20, 0x01, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02, 0x21, 0x02,
+    0x21, 0x01, 0x21, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x04, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01,
+    0x20, 0x00, 0x20, 0x02, 0x00, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20,
+    0x02, 0x20, 0x01, 0x21, 0x00, 0x20, 0x03, 0x21, 0x02, 0x22, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20,
+    0x02, 0x22, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x00, 0x21, 0x01, 0x21, 0x03, 0x21, 0x02, 0x20,
+    0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x03, 0x20, 0x01, 0x22, 0x00, 0x20, 0x00, 0x22,
+    0x01, 0x21, 0x01, 0x21, 0x00, 0x20, 0x00, 0x12, 0x20, 0x1f, 0x17, 0x20, 0x1f, 0x0a,
+};
+
+const RleBitmap SYS_MSG_AP_CONFIG_FAILED = {
+    120U, 6U, SYS_MSG_AP_CONFIG_FAILED_PALETTE, 1U, SYS_MSG_AP_CONFIG_FAILED_RUNS, sizeof(SYS_MSG_AP_CONFIG_FAILED_RUNS)
+};
+
+/* "Can't set AP hostname.", 78 x 6 pixels */
+static const uint32_t SYS_MSG_AP_HOSTNAME_FAILED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_AP_HOSTNAME_FAILED_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x09, 0x20, 0x01, 0x20, 0x0c, 0x20, 0x03, 0x21, 0x01, 0x22, 0x02, 0x20, 0x0b, 0x20,
+    0x13, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x21, 0x01, 0x20, 0x00, 0x22, 0x03, 0x21, 0x01, 0x21,
+    0x00, 0x22, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x21, 0x02, 0x20, 0x02, 0x21,
+    0x00, 0x22, 0x00, 0x21, 0x01, 0x21, 0x01, 0x22, 0x01, 0x21, 0x02, 0x20, 0x03, 0x21, 0x00, 0x20,
+    0x00, 0x20, 0x03, 0x20, 0x03, 0x21, 0x01, 0x20, 0x00, 0x20, 0x01, 0x20, 0x03, 0x22, 0x00, 0x21,
+    0x03, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20,
+    0x01, 0x21, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x03, 0x20, 0x04, 0x21, 0x00, 0x21, 0x02, 0x20, 0x03, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x04, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x20, 0x01, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x22, 0x00, 0x21, 0x03, 0x00, 0x20, 0x01, 0x22, 0x00,
+    0x20, 0x00, 0x20, 0x03, 0x21, 0x02, 0x21, 0x02, 0x21, 0x01, 0x21, 0x02, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x04, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x02, 0x21, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x20, 0x00, 0x1f, 0x1f, 0x0d,
+};
+
+const RleBitmap SYS_MSG_AP_HOSTNAME_FAILED = {
+    78U, 6U, SYS_MSG_AP_HOSTNAME_FAILED_PALETTE, 1U, SYS_MSG_AP_HOSTNAME_FAILED_RUNS, sizeof(SYS_MSG_AP_HOSTNAME_FAILED_RUNS)
+};
+
+/* "Setup wifi access point failed.", 106 x 6 pixels */
+static const uint32_t SYS_MSG_AP_SETUP_FAILED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_AP_SETUP_FAILED_RUNS[] PROGMEM = {
+    0x22, 0x05, 0x20, 0x0f, 0x20, 0x02, 0x20, 0x00, 0x20, 0x1f, 0x04, 0x20, 0x05, 0x20, 0x05, 0x20,
+    0x04, 0x20, 0x00, 0x21, 0x07, 0x20, 0x02, 0x20, 0x03, 0x21, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20,
+    0x00, 0x21, 0x03, 0x20, 0x00, 0x20, 0x03, 0x20, 0x05, 0x21, 0x02, 0x21, 0x01, 0x21, 0x01, 0x21,
+    0x01, 0x21, 0x01, 0x21, 0x02, 0x21, 0x02, 0x20, 0x03, 0x21, 0x01, 0x22, 0x03, 0x20, 0x01, 0x21,
+    0x04, 0x20, 0x02, 0x21, 0x01, 0x21, 0x02, 0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x22, 0x00, 0x20, 0x00, 0x22, 0x00, 0x20, 0x03, 0x21,
+    0x00, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x21, 0x03, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x03, 0x22, 0x01, 0x21,
+    0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x01, 0x20, 0x00,
+    0x21, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x22, 0x00, 0x20, 0x01,
+    0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02, 0x21, 0x02, 0x21, 0x01,
+    0x21, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01,
+    0x20, 0x04, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01, 0x20, 0x00,
+    0x20, 0x02, 0x22, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x00, 0x21, 0x03, 0x22, 0x00, 0x20, 0x01,
+    0x20, 0x01, 0x20, 0x02, 0x22, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x00, 0x21, 0x01, 0x21, 0x03,
+    0x21, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x03, 0x20, 0x01, 0x22, 0x00,
+    0x20, 0x00, 0x22, 0x01, 0x21, 0x01, 0x21, 0x00, 0x20, 0x00, 0x0f, 0x20, 0x1f, 0x0c, 0x20, 0x1f,
+    0x0a,
+};
+
+const RleBitmap SYS_MSG_AP_SETUP_FAILED = {
+    106U, 6U, SYS_MSG_AP_SETUP_FAILED_PALETTE, 1U, SYS_MSG_AP_SETUP_FAILED_RUNS, sizeof(SYS_MSG_AP_SETUP_FAILED_RUNS)
+};
+
+/* "Warning: Heap fragmented, plugins may fail.", 153 x 6 pixels */
+static const uint32_t SYS_MSG_HEAP_FRAGMENTED_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_HEAP_FRAGMENTED_RUNS[] PROGMEM = {
+    0x20, 0x02, 0x20, 0x0c, 0x20, 0x0c, 0x20, 0x00, 0x20, 0x10, 0x20, 0x19, 0x20, 0x07, 0x20, 0x09,
+    0x21, 0x09, 0x20, 0x1a, 0x20, 0x04, 0x20, 0x00, 0x21, 0x03, 0x20, 0x02, 0x20, 0x00, 0x21, 0x02,
+    0x21, 0x00, 0x21, 0x03, 0x21, 0x02, 0x21, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00,
+    0x21, 0x01, 0x21, 0x04, 0x20, 0x02, 0x21, 0x00, 0x21, 0x02, 0x21, 0x00, 0x22, 0x01, 0x21, 0x00,
+    0x21, 0x01, 0x22, 0x01, 0x21, 0x01, 0x21, 0x05, 0x21, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x01,
+    0x21, 0x02, 0x21, 0x02, 0x21, 0x02, 0x22, 0x00, 0x21, 0x01, 0x20, 0x00, 0x20, 0x03, 0x20, 0x01,
+    0x21, 0x04, 0x20, 0x03, 0x20, 0x02, 0x20, 0x01, 0x21, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x22, 0x00, 0x20, 0x00, 0x20, 0x01,
+    0x21, 0x00, 0x20, 0x00, 0x20, 0x02, 0x22, 0x00, 0x20, 0x03, 0x21, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x05, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x03, 0x22, 0x01, 0x21, 0x00, 0x20, 0x00,
+    0x20, 0x02, 0x22, 0x01, 0x21, 0x00, 0x20, 0x01, 0x20, 0x03, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x22, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x03, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x22, 0x00, 0x22, 0x00, 0x21, 0x01,
+    0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01,
+    0x21, 0x02, 0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x03, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x03, 0x00, 0x20, 0x00, 0x20, 0x01, 0x22, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x04, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x22,
+    0x00, 0x21, 0x04, 0x20, 0x01, 0x20, 0x02, 0x22, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x00, 0x20, 0x03, 0x21, 0x01, 0x22,
+    0x01, 0x21, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x03, 0x20, 0x00, 0x20,
+    0x00, 0x22, 0x02, 0x20, 0x03, 0x20, 0x01, 0x22, 0x00, 0x20, 0x00, 0x22, 0x00, 0x20, 0x00, 0x18,
+    0x20, 0x11, 0x20, 0x11, 0x20, 0x1e, 0x20, 0x0b, 0x20, 0x16, 0x20, 0x13,
+};
+
+const RleBitmap SYS_MSG_HEAP_FRAGMENTED = {
+    153U, 6U, SYS_MSG_HEAP_FRAGMENTED_PALETTE, 1U, SYS_MSG_HEAP_FRAGMENTED_RUNS, sizeof(SYS_MSG_HEAP_FRAGMENTED_RUNS)
+};
+
+/* "OTA - Authentication error.", 96 x 6 pixels */
+static const uint32_t SYS_MSG_OTA_AUTH_ERROR_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_OTA_AUTH_ERROR_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x01, 0x22, 0x00, 0x21, 0x09, 0x21, 0x06, 0x20, 0x01, 0x20, 0x0b, 0x20, 0x01, 0x20,
+    0x09, 0x20, 0x01, 0x20, 0x1f, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x22, 0x00, 0x21, 0x02, 0x21, 0x00, 0x21, 0x01,
+    0x22, 0x03, 0x21, 0x00, 0x21, 0x01, 0x22, 0x03, 0x20, 0x01, 0x21, 0x04, 0x21, 0x01, 0x21, 0x01,
+    0x21, 0x01, 0x20, 0x02, 0x21, 0x02, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x22, 0x02, 0x22, 0x02,
+    0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x03, 0x21, 0x01, 0x20, 0x01, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01,
+    0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x21, 0x01, 0x20, 0x02, 0x20, 0x02,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x00, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x20,
+    0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0x21, 0x00, 0x20, 0x01, 0x21, 0x00, 0x22, 0x01, 0x21, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20,
+    0x00, 0x20, 0x03, 0x21, 0x00, 0x20, 0x02, 0x20, 0x03, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x1f,
+    0x1f, 0x1f,
+};
+
+const RleBitmap SYS_MSG_OTA_AUTH_ERROR = {
+    96U, 6U, SYS_MSG_OTA_AUTH_ERROR_PALETTE, 1U, SYS_MSG_OTA_AUTH_ERROR_RUNS, sizeof(SYS_MSG_OTA_AUTH_ERROR_RUNS)
+};
+
+/* "OTA - Begin error.", 62 x 6 pixels */
+static const uint32_t SYS_MSG_OTA_BEGIN_ERROR_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_OTA_BEGIN_ERROR_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x01, 0x22, 0x00, 0x21, 0x09, 0x21, 0x09, 0x20, 0x1c, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x02, 0x21, 0x04, 0x21,
+    0x01, 0x21, 0x01, 0x21, 0x01, 0x20, 0x02, 0x21, 0x02, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x22,
+    0x02, 0x22, 0x02, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x04, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20, 0x00, 0x21,
+    0x01, 0x22, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x21, 0x01, 0x20, 0x02, 0x20, 0x02, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x04, 0x00, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x21, 0x02,
+    0x21, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x03, 0x21, 0x00, 0x20, 0x02, 0x20, 0x03,
+    0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x1c, 0x20, 0x1f,
+};
+
+const RleBitmap SYS_MSG_OTA_BEGIN_ERROR = {
+    62U, 6U, SYS_MSG_OTA_BEGIN_ERROR_PALETTE, 1U, SYS_MSG_OTA_BEGIN_ERROR_RUNS, sizeof(SYS_MSG_OTA_BEGIN_ERROR_RUNS)
+};
+
+/* "OTA - Connect error.", 72 x 6 pixels */
+static const uint32_t SYS_MSG_OTA_CONNECT_ERROR_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_OTA_CONNECT_ERROR_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x01, 0x22, 0x00, 0x21, 0x0a, 0x20, 0x16, 0x20, 0x19, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x21, 0x01, 0x21, 0x02, 0x21,
+    0x01, 0x21, 0x00, 0x22, 0x03, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x20, 0x02, 0x21, 0x02, 0x20,
+    0x00, 0x20, 0x01, 0x20, 0x01, 0x22, 0x02, 0x22, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x03, 0x20, 0x03, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x20, 0x00, 0x20,
+    0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x03, 0x20, 0x03, 0x21, 0x01, 0x20,
+    0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x00, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00,
+    0x20, 0x09, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01,
+    0x21, 0x01, 0x21, 0x03, 0x21, 0x00, 0x20, 0x02, 0x20, 0x03, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00,
+    0x1f, 0x1f, 0x07,
+};
+
+const RleBitmap SYS_MSG_OTA_CONNECT_ERROR = {
+    72U, 6U, SYS_MSG_OTA_CONNECT_ERROR_PALETTE, 1U, SYS_MSG_OTA_CONNECT_ERROR_RUNS, sizeof(SYS_MSG_OTA_CONNECT_ERROR_RUNS)
+};
+
+/* "OTA - Receive error.", 70 x 6 pixels */
+static const uint32_t SYS_MSG_OTA_RECEIVE_ERROR_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_OTA_RECEIVE_ERROR_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x01, 0x22, 0x00, 0x21, 0x09, 0x22, 0x0c, 0x20, 0x1f, 0x00, 0x20, 0x00, 0x20, 0x01,
+    0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20, 0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x02,
+    0x20, 0x00, 0x20, 0x01, 0x21, 0x03, 0x21, 0x01, 0x21, 0x01, 0x21, 0x01, 0x20, 0x02, 0x21, 0x02,
+    0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x22, 0x02, 0x22, 0x02, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x02,
+    0x21, 0x01, 0x20, 0x00, 0x22, 0x00, 0x21, 0x03, 0x21, 0x01, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x04, 0x00, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20,
+    0x01, 0x21, 0x01, 0x21, 0x01, 0x21, 0x00, 0x20, 0x01, 0x20, 0x02, 0x21, 0x03, 0x21, 0x00, 0x20,
+    0x02, 0x20, 0x03, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x1f, 0x1f, 0x05,
+};
+
+const RleBitmap SYS_MSG_OTA_RECEIVE_ERROR = {
+    70U, 6U, SYS_MSG_OTA_RECEIVE_ERROR_PALETTE, 1U, SYS_MSG_OTA_RECEIVE_ERROR_RUNS, sizeof(SYS_MSG_OTA_RECEIVE_ERROR_RUNS)
+};
+
+/* "OTA - End error.", 56 x 6 pixels */
+static const uint32_t SYS_MSG_OTA_END_ERROR_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_OTA_END_ERROR_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x01, 0x22, 0x00, 0x21, 0x09, 0x22, 0x06, 0x20, 0x18, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x02, 0x21, 0x02, 0x21, 0x03, 0x21, 0x01, 0x21, 0x01, 0x21,
+    0x01, 0x20, 0x02, 0x21, 0x02, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x22, 0x02, 0x22, 0x02, 0x22,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20,
+    0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20,
+    0x08, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x21, 0x01, 0x20, 0x02, 0x20,
+    0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x00, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08,
+    0x22, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x03, 0x21, 0x00, 0x20, 0x02, 0x20, 0x03, 0x20, 0x01,
+    0x20, 0x02, 0x20, 0x00, 0x1f, 0x17,
+};
+
+const RleBitmap SYS_MSG_OTA_END_ERROR = {
+    56U, 6U, SYS_MSG_OTA_END_ERROR_PALETTE, 1U, SYS_MSG_OTA_END_ERROR_RUNS, sizeof(SYS_MSG_OTA_END_ERROR_RUNS)
+};
+
+/* "OTA - Unknown error.", 72 x 6 pixels */
+static const uint32_t SYS_MSG_OTA_UNKNOWN_ERROR_PALETTE[] PROGMEM = {
+    0xffffff
+};
+
+static const uint8_t SYS_MSG_OTA_UNKNOWN_ERROR_RUNS[] PROGMEM = {
+    0x00, 0x20, 0x01, 0x22, 0x00, 0x21, 0x09, 0x20, 0x00, 0x20, 0x04, 0x20, 0x1f, 0x0a, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x00,
+    0x20, 0x00, 0x21, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x00, 0x21, 0x04, 0x21, 0x01, 0x21, 0x01,
+    0x21, 0x01, 0x20, 0x02, 0x21, 0x02, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x22, 0x02, 0x22, 0x02,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x04, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x21, 0x01, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x22, 0x00, 0x20, 0x00, 0x20, 0x02, 0x21, 0x01, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x04, 0x00, 0x20, 0x02, 0x20, 0x01, 0x20, 0x00, 0x20, 0x08, 0x22, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x01, 0x22, 0x00, 0x20,
+    0x00, 0x20, 0x03, 0x21, 0x00, 0x20, 0x02, 0x20, 0x03, 0x20, 0x01, 0x20, 0x02, 0x20, 0x00, 0x1f,
+    0x1f, 0x07,
+};
+
+const RleBitmap SYS_MSG_OTA_UNKNOWN_ERROR = {
+    72U, 6U, SYS_MSG_OTA_UNKNOWN_ERROR_PALETTE, 1U, SYS_MSG_OTA_UNKNOWN_ERROR_RUNS, sizeof(SYS_MSG_OTA_UNKNOWN_ERROR_RUNS)
+};
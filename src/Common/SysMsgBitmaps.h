@@ -0,0 +1,59 @@
+/* Generated by renderSysMsg.py from lib/Gfx/TomThumb.h, don't edit. */
+
+#ifndef __SYSMSGBITMAPS_H__
+#define __SYSMSGBITMAPS_H__
+
+#include <RleBitmap.h>
+
+/** "PIXELIX" */
+extern const RleBitmap SYS_MSG_PIXELIX;
+
+/** "Update" */
+extern const RleBitmap SYS_MSG_UPDATE;
+
+/** "..." */
+extern const RleBitmap SYS_MSG_ELLIPSIS;
+
+/** "Set wifi mode failed." */
+extern const RleBitmap SYS_MSG_WIFI_MODE_FAILED;
+
+/** "Failed to setup mDNS." */
+extern const RleBitmap SYS_MSG_MDNS_FAILED;
+
+/** "Set autom. reconnect failed." */
+extern const RleBitmap SYS_MSG_AUTO_RECONNECT_FAILED;
+
+/** "Keep button pressed and reboot. Set SSID/password via webserer." */
+extern const RleBitmap SYS_MSG_KEEP_BUTTON_PRESSED;
+
+/** "Configure wifi access point failed." */
+extern const RleBitmap SYS_MSG_AP_CONFIG_FAILED;
+
+/** "Can't set AP hostname." */
+extern const RleBitmap SYS_MSG_AP_HOSTNAME_FAILED;
+
+/** "Setup wifi access point failed." */
+extern const RleBitmap SYS_MSG_AP_SETUP_FAILED;
+
+/** "Warning: Heap fragmented, plugins may fail." */
+extern const RleBitmap SYS_MSG_HEAP_FRAGMENTED;
+
+/** "OTA - Authentication error." */
+extern const RleBitmap SYS_MSG_OTA_AUTH_ERROR;
+
+/** "OTA - Begin error." */
+extern const RleBitmap SYS_MSG_OTA_BEGIN_ERROR;
+
+/** "OTA - Connect error." */
+extern const RleBitmap SYS_MSG_OTA_CONNECT_ERROR;
+
+/** "OTA - Receive error." */
+extern const RleBitmap SYS_MSG_OTA_RECEIVE_ERROR;
+
+/** "OTA - End error." */
+extern const RleBitmap SYS_MSG_OTA_END_ERROR;
+
+/** "OTA - Unknown error." */
+extern const RleBitmap SYS_MSG_OTA_UNKNOWN_ERROR;
+
+#endif  /* __SYSMSGBITMAPS_H__ */
@@ -62,116 +62,57 @@
 
 void TaskMon::process()
 {
-#if configUSE_TRACE_FACILITY
-    bool isProcessingTime = false;
-
-    if (false == m_timer.isTimerRunning())
-    {
-        m_timer.start(PROCESSING_CYCLE);
-        isProcessingTime = true;
-    }
-    else if (true == m_timer.isTimeout())
-    {
-        isProcessingTime = true;
-        m_timer.restart();
-    }
-
-    if (true == isProcessingTime)
-    {
-        UBaseType_t     numOfTasks      = uxTaskGetNumberOfTasks();
-        TaskStatus_t*   taskStatus      = new TaskStatus_t[numOfTasks];
+    sample();
 
-        if (nullptr != taskStatus)
-        {
-            uint32_t    totalRunTime    = 0U;
-            UBaseType_t index           = 0U;
-            size_t      taskNameMaxLen  = 0U;
-            size_t      taskStateMaxLen = 0U;
-
-            numOfTasks = uxTaskGetSystemState(taskStatus, numOfTasks, &totalRunTime);
-
-            /* Determine the length of the longest task name and the longest task state name. */
-            for(index = 0U; index < numOfTasks; ++index)
-            {
-                size_t taskNameLen  = strlen(taskStatus[index].pcTaskName);
-                size_t taskStateLen = taskState2Str(taskStatus[index].eCurrentState).length();
-
-                if (taskNameMaxLen < taskNameLen)
-                {
-                    taskNameMaxLen = taskNameLen;
-                }
-
-                if (taskStateMaxLen < taskStateLen)
-                {
-                    taskStateMaxLen = taskStateLen;
-                }
-            }
+    return;
+}
 
-            /* Show task informations */
-            for(index = 0U; index < numOfTasks; ++index)
-            {
-                uint32_t statsAsPercentage = 0U;
+uint8_t TaskMon::getTaskInfos(TaskInfo* infos, uint8_t maxInfos)
+{
+    uint8_t count = 0U;
 
-                /* Calculate task load in percent, if total run time is available.
-                 * Note, this depends on how FreeRTOS is configured.
-                 */
-                if (0U < totalRunTime)
-                {
-                    statsAsPercentage = taskStatus[index].ulRunTimeCounter / (totalRunTime / 100U);
-                }
+    if ((nullptr != infos) &&
+        (nullptr != m_xMutex) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        count = (maxInfos < m_infoCnt) ? maxInfos : m_infoCnt;
 
-#if configTASKLIST_INCLUDE_COREID
-                LOG_INFO("Task \"%s\": c %d, p %2u, %s, %3u%%, stack high water mark: %u",
-                    taskStatus[index].xCoreID,
-                    fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
-                    taskStatus[index].uxCurrentPriority,
-                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
-                    statsAsPercentage,
-                    taskStatus[index].usStackHighWaterMark);
-    #else
-                LOG_INFO("Task \"%s\": p %2u, %s, %3u%%, stack high water mark: %u",
-                    fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
-                    taskStatus[index].uxCurrentPriority,
-                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
-                    statsAsPercentage,
-                    taskStatus[index].usStackHighWaterMark);
-#endif
-            }
+        memcpy(infos, m_infos, count * sizeof(TaskInfo));
 
-            delete[] taskStatus;
-        }
+        (void)xSemaphoreGive(m_xMutex);
     }
-#endif  /* configUSE_TRACE_FACILITY */
+
+    return count;
 }
 
-String TaskMon::taskState2Str(eTaskState state)
+const char* TaskMon::taskStateToStr(eTaskState state)
 {
-    String name;
+    const char* name = "Unknown";
 
     switch(state)
     {
     /* A task is querying the state of itself, so must be running. */
-	case eRunning:
+    case eRunning:
         name = "Running";
         break;
 
     /* The task being queried is in a read or pending ready list. */
-	case eReady:
+    case eReady:
         name = "Ready";
         break;
 
     /* The task being queried is in the Blocked state. */
-	case eBlocked:
+    case eBlocked:
         name = "Blocked";
         break;
 
     /* The task being queried is in the Suspended state, or is in the Blocked state with an infinite time out. */
-	case eSuspended:
+    case eSuspended:
         name = "Suspended";
         break;
 
     /* The task being queried has been deleted, but its TCB has not yet been freed. */
-	case eDeleted:
+    case eDeleted:
         name = "Deleted";
         break;
 
@@ -182,31 +123,105 @@ String TaskMon::taskState2Str(eTaskState state)
     return name;
 }
 
-String TaskMon::fillUpSpaces(const char* str, size_t len)
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void TaskMon::sample()
 {
-    String  result      = str;
-    size_t  resultLen   = result.length();
+#if configUSE_TRACE_FACILITY
+    uint32_t    totalRunTime    = 0U;
+    uint32_t    totalDelta      = 0U;
+    UBaseType_t numOfTasks      = uxTaskGetSystemState(m_status, MAX_TASKS, &totalRunTime);
+    UBaseType_t index           = 0U;
 
-    if (len > result.length())
+    /* If there are more tasks than the status buffer can hold, nothing is returned. */
+    if (0U == numOfTasks)
     {
-        size_t index = 0U;
+        LOG_WARNING("More than %u tasks, can not be monitored.", MAX_TASKS);
+        return;
+    }
 
-        for(index = 0U; index < (len - resultLen); ++index)
+    totalDelta = totalRunTime - m_prevTotalRunTime;
+
+    if ((nullptr != m_xMutex) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        for(index = 0U; index < numOfTasks; ++index)
         {
-            result += " ";
+            const TaskStatus_t& status  = m_status[index];
+            TaskInfo&           info    = m_infos[index];
+            uint32_t            delta   = status.ulRunTimeCounter - getPrevRunTime(status.xTaskNumber);
+
+            strncpy(info.name, status.pcTaskName, sizeof(info.name) - 1U);
+            info.name[sizeof(info.name) - 1U] = '\0';
+
+#if configTASKLIST_INCLUDE_COREID
+            info.coreId = (tskNO_AFFINITY == status.xCoreID) ? -1 : static_cast<int8_t>(status.xCoreID);
+#else
+            info.coreId = -1;
+#endif  /* configTASKLIST_INCLUDE_COREID */
+
+            info.priority           = static_cast<uint8_t>(status.uxCurrentPriority);
+            info.state              = status.eCurrentState;
+            info.stackHighWaterMark = status.usStackHighWaterMark;
+
+            /* The CPU load is calculated from the run time since the previous
+             * sample and not from the cumulative run time since startup.
+             * Note, the total run time depends on how FreeRTOS is configured.
+             */
+            if (0U == totalDelta)
+            {
+                info.cpuLoad = 0U;
+            }
+            else
+            {
+                uint64_t cpuLoad = (static_cast<uint64_t>(delta) * 100U) / totalDelta;
+
+                info.cpuLoad = (100U < cpuLoad) ? 100U : static_cast<uint8_t>(cpuLoad);
+            }
         }
+
+        m_infoCnt = numOfTasks;
+
+        (void)xSemaphoreGive(m_xMutex);
     }
 
-    return result;
+    /* Remember the run time counters for the next sample. */
+    for(index = 0U; index < numOfTasks; ++index)
+    {
+        m_prevRunTime[index].taskNumber = m_status[index].xTaskNumber;
+        m_prevRunTime[index].counter    = m_status[index].ulRunTimeCounter;
+    }
+
+    m_prevRunTimeCnt    = numOfTasks;
+    m_prevTotalRunTime  = totalRunTime;
+#endif  /* configUSE_TRACE_FACILITY */
+
+    return;
 }
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
+uint32_t TaskMon::getPrevRunTime(UBaseType_t taskNumber) const
+{
+    uint32_t    counter = 0U;
+    uint8_t     index   = 0U;
 
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
+    while((index < m_prevRunTimeCnt) && (taskNumber != m_prevRunTime[index].taskNumber))
+    {
+        ++index;
+    }
+
+    if (index < m_prevRunTimeCnt)
+    {
+        counter = m_prevRunTime[index].counter;
+    }
+
+    return counter;
+}
 
 /******************************************************************************
  * External Functions
@@ -44,8 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
-#include <SysMsgPlugin.h>
-#include <WString.h>
+#include <Arduino.h>
 
 /******************************************************************************
  * Macros
@@ -56,12 +55,34 @@
  *****************************************************************************/
 
 /**
- * Task monitor
+ * Task monitor, which samples the state of all tasks cyclic.
+ * All buffers are allocated once, therefore sampling doesn't allocate
+ * memory and doesn't distort the results by itself.
+ * It is processed by the diagnostic service.
  */
 class TaskMon
 {
 public:
 
+    /** Max. number of monitored tasks. */
+    static const uint8_t MAX_TASKS = 32U;
+
+    /** Max. task name length, incl. string termination. */
+    static const size_t MAX_TASK_NAME_LEN = configMAX_TASK_NAME_LEN;
+
+    /**
+     * Task information of the latest sample.
+     */
+    struct TaskInfo
+    {
+        char        name[MAX_TASK_NAME_LEN];    /**< Task name */
+        int8_t      coreId;                     /**< Core affinity, -1 for no affinity. */
+        uint8_t     priority;                   /**< Current priority */
+        eTaskState  state;                      /**< Task state */
+        uint8_t     cpuLoad;                    /**< CPU load in percent of one core since the previous sample */
+        uint32_t    stackHighWaterMark;         /**< Min. free stack since task start in byte */
+    };
+
     /**
      * Get task monitor instance.
      *
@@ -75,21 +96,61 @@ public:
     }
 
     /**
-     * Get current number of tasks and their properties.
+     * Sample the current tasks and their properties.
+     * The CPU load is calculated since the previous call.
      */
     void process();
 
-    /** Processing cycle in ms. */
-    static const uint32_t PROCESSING_CYCLE  = 60U * 1000U;
+    /**
+     * Get the task information of the latest sample.
+     *
+     * @param[out] infos    Task informations
+     * @param[in]  maxInfos Max. number of task informations
+     *
+     * @return Number of task informations
+     */
+    uint8_t getTaskInfos(TaskInfo* infos, uint8_t maxInfos);
+
+    /**
+     * Get task state as user friendly string.
+     *
+     * @param[in] state Task state
+     *
+     * @return Task state name
+     */
+    static const char* taskStateToStr(eTaskState state);
 
 private:
 
-    SimpleTimer m_timer;    /**< Timer used for cyclic processing. */
+    /**
+     * Run time counter of a task at the previous sample.
+     */
+    struct RunTime
+    {
+        UBaseType_t taskNumber;     /**< Unique task number */
+        uint32_t    counter;        /**< Run time counter */
+    };
+
+#if configUSE_TRACE_FACILITY
+    TaskStatus_t        m_status[MAX_TASKS];        /**< Raw task status of the current sample */
+#endif  /* configUSE_TRACE_FACILITY */
+    RunTime             m_prevRunTime[MAX_TASKS];   /**< Run time counters of the previous sample */
+    uint8_t             m_prevRunTimeCnt;           /**< Number of run time counters of the previous sample */
+    uint32_t            m_prevTotalRunTime;         /**< Total run time of the previous sample */
+    TaskInfo            m_infos[MAX_TASKS];         /**< Task informations of the latest sample */
+    uint8_t             m_infoCnt;                  /**< Number of task informations */
+    SemaphoreHandle_t   m_xMutex;                   /**< Mutex to protect the task informations. */
 
     /**
      * Constructs the task monitor.
      */
-    TaskMon()
+    TaskMon() :
+        m_prevRunTime(),
+        m_prevRunTimeCnt(0U),
+        m_prevTotalRunTime(0U),
+        m_infos(),
+        m_infoCnt(0U),
+        m_xMutex(xSemaphoreCreateMutex())
     {
     }
 
@@ -105,21 +166,18 @@ private:
     TaskMon& operator=(const TaskMon& taskMon);
 
     /**
-     * Get task state as user friendly string.
-     *
-     * @return Task state name
+     * Sample all tasks and calculate the CPU load since the previous sample.
      */
-    String taskState2Str(eTaskState state);
+    void sample();
 
     /**
-     * Fill string up with spaces until given length is reached.
+     * Get the run time counter of a task at the previous sample.
      *
-     * @param[in] str   String, which to fill up
-     * @param[in] len   Length of the result string
+     * @param[in] taskNumber    Unique task number
      *
-     * @return Filled up string
+     * @return Run time counter or 0, if the task didn't exist.
      */
-    String fillUpSpaces(const char* str, size_t len);
+    uint32_t getPrevRunTime(UBaseType_t taskNumber) const;
 };
 
 /******************************************************************************
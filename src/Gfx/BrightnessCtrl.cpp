@@ -35,8 +35,10 @@
 #include "BrightnessCtrl.h"
 #include "LedMatrix.h"
 #include "AmbientLightSensor.h"
+#include "EventStream.h"
 
 #include <Logging.h>
+#include <Metrics.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -54,21 +56,25 @@
  * Prototypes
  *****************************************************************************/
 
+static int32_t getBrightness();
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Display brightness, read during export. */
+static MetricGauge  gMetricBrightness("pixelix_display_brightness", "Display brightness [0; 255].", getBrightness);
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void BrightnessCtrl::init()
 {
-    float lightNormalized = AmbientLightSensor::getInstance().getNormalizedLight();
+    uint16_t lightNormalized = AmbientLightSensor::getInstance().getNormalizedLight();
 
-    m_recentShortTermAverage    = lightNormalized;
-    m_recentLongTermAverage     = lightNormalized;
-    setAmbientLight(m_recentShortTermAverage);
+    m_calc.reset(lightNormalized);
+    setAmbientLight(lightNormalized);
     updateBrightnessGoal();
 
     return;
@@ -95,11 +101,11 @@ bool BrightnessCtrl::enable(bool state)
         /* Ambient light sensor is available */
         else
         {
-            float lightNormalized = AmbientLightSensor::getInstance().getNormalizedLight();
+            uint16_t lightNormalized = AmbientLightSensor::getInstance().getNormalizedLight();
 
-            m_recentShortTermAverage    = lightNormalized;
-            m_recentLongTermAverage     = lightNormalized;
-            setAmbientLight(m_recentShortTermAverage);
+            m_calc.reset(lightNormalized);
+            m_lightChangeCount = AmbientLightSensor::getInstance().getChangeCount();
+            setAmbientLight(lightNormalized);
             updateBrightnessGoal();
 
             /* Display brightness will be automatically adjusted in the process() method. */
@@ -117,6 +123,8 @@ bool BrightnessCtrl::enable(bool state)
         }
     }
 
+    EventStream::getInstance().notify(EventStream::EVENT_BRIGHTNESS);
+
     return status;
 }
 
@@ -139,18 +147,36 @@ bool BrightnessCtrl::isEnabled() const
 
 void BrightnessCtrl::process()
 {
-    /* Ambient light sensor available for automatic brightness adjustment? */
+    /* A event driven sensor reports only light changes, which are already
+     * debounced by the sensor. Therefore there is nothing to do in between.
+     */
     if ((true == m_autoBrightnessTimer.isTimerRunning()) &&
-        (true == m_autoBrightnessTimer.isTimeout()))
+        (true == AmbientLightSensor::getInstance().isEventDriven()))
     {
-        float lightNormalized = AmbientLightSensor::getInstance().getNormalizedLight();
+        const uint32_t CHANGE_COUNT = AmbientLightSensor::getInstance().getChangeCount();
 
-        applyLightSensorMeasurement(AUTO_ADJUST_PERIOD, lightNormalized);
+        if (m_lightChangeCount != CHANGE_COUNT)
+        {
+            uint16_t lightNormalized = AmbientLightSensor::getInstance().getNormalizedLight();
+
+            m_lightChangeCount = CHANGE_COUNT;
+            m_calc.reset(lightNormalized);
+            setAmbientLight(lightNormalized);
+            updateBrightnessGoal();
+            updateBrightness();
+        }
+    }
+    /* Ambient light sensor available for automatic brightness adjustment? */
+    else if ((true == m_autoBrightnessTimer.isTimerRunning()) &&
+             (true == m_autoBrightnessTimer.isTimeout()))
+    {
+        uint16_t lightNormalized = AmbientLightSensor::getInstance().getNormalizedLight();
+
+        m_calc.applyMeasurement(AUTO_ADJUST_PERIOD, lightNormalized);
         updateBrightness();
 
         /* The ambient environment appears to be brightening. */
-        if ((m_brighteningThreshold < m_recentShortTermAverage) &&
-            (m_brighteningThreshold < m_recentLongTermAverage))
+        if (true == m_calc.isBrightening())
         {
             if (AMBIENT_LIGHT_DIRECTION_BRIGTHER != m_direction)
             {
@@ -162,7 +188,7 @@ void BrightnessCtrl::process()
             else if ((true == m_lightSensorDebounceTimer.isTimerRunning()) &&
                      (true == m_lightSensorDebounceTimer.isTimeout()))
             {
-                setAmbientLight(m_recentShortTermAverage);
+                setAmbientLight(m_calc.getShortTermAverage());
                 updateBrightnessGoal();
             }
             else
@@ -171,8 +197,7 @@ void BrightnessCtrl::process()
             }
         }
         /* The ambient environment appears to be darkening. */
-        else if ((m_darkeningThreshold > m_recentShortTermAverage) &&
-                 (m_darkeningThreshold > m_recentLongTermAverage))
+        else if (true == m_calc.isDarkening())
         {
             if (AMBIENT_LIGHT_DIRECTION_DARKER != m_direction)
             {
@@ -184,7 +209,7 @@ void BrightnessCtrl::process()
             else if ((true == m_lightSensorDebounceTimer.isTimerRunning()) &&
                      (true == m_lightSensorDebounceTimer.isTimeout()))
             {
-                setAmbientLight(m_recentShortTermAverage);
+                setAmbientLight(m_calc.getShortTermAverage());
                 updateBrightnessGoal();
             }
             else
@@ -203,11 +228,21 @@ void BrightnessCtrl::setBrightness(uint8_t level)
     {
         m_brightness = level;
         LedMatrix::getInstance().setBrightness(m_brightness);
+
+        EventStream::getInstance().notify(EventStream::EVENT_BRIGHTNESS);
     }
 
     return;
 }
 
+void BrightnessCtrl::setResponseCurve(const uint16_t* curve)
+{
+    m_calc.setResponseCurve(curve);
+    updateBrightnessGoal();
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -218,14 +253,11 @@ void BrightnessCtrl::setBrightness(uint8_t level)
 
 BrightnessCtrl::BrightnessCtrl() :
     m_autoBrightnessTimer(),
+    m_lightChangeCount(0U),
     m_brightness(0U),
     m_minBrightness((UINT8_MAX * 10U) / 100U),  /* 10% */
     m_maxBrightness(UINT8_MAX),                 /* 100% */
-    m_recentShortTermAverage(0.0F),
-    m_recentLongTermAverage(0.0F),
-    m_brighteningThreshold(0.0F),
-    m_darkeningThreshold(0.0F),
-    m_ambientLight(0.0F),
+    m_calc(BRIGHTENING_LIGHT_HYSTERESIS, DARKENING_LIGHT_HYSTERESIS, SHORT_TERM_AVG_LIGHT_TIME_CONST, LONG_TERM_AVG_LIGHT_TIME_CONST),
     m_lightSensorDebounceTimer(),
     m_direction(AMBIENT_LIGHT_DIRECTION_BRIGTHER),
     m_brightnessGoal(m_minBrightness)
@@ -236,36 +268,18 @@ BrightnessCtrl::~BrightnessCtrl()
 {
 }
 
-void BrightnessCtrl::setAmbientLight(float light)
+void BrightnessCtrl::setAmbientLight(uint16_t light)
 {
-    m_ambientLight          = light;
-    m_brighteningThreshold  = m_ambientLight * (1.0f + BRIGHTENING_LIGHT_HYSTERESIS);
-    m_darkeningThreshold    = m_ambientLight * (1.0f - DARKENING_LIGHT_HYSTERESIS);
-
-    LOG_INFO("Light: %0.3f (b-thr %0.3f < x < d-thr %0.3f)", m_ambientLight, m_brighteningThreshold, m_darkeningThreshold);
-
-    return;
-}
-
-void BrightnessCtrl::applyLightSensorMeasurement(uint32_t dTime, float light)
-{
-    m_recentShortTermAverage += (light - m_recentShortTermAverage) * dTime
-        / (SHORT_TERM_AVG_LIGHT_TIME_CONST + dTime);
-
-    m_recentLongTermAverage += (light - m_recentLongTermAverage)* dTime
-        / (LONG_TERM_AVG_LIGHT_TIME_CONST + dTime);
+    m_calc.setAmbientLight(light);
 
-    //LOG_INFO("Light: m %0.3f s-avg %0.3f l-avg %0.3f", light, m_recentShortTermAverage, m_recentLongTermAverage);
+    LOG_INFO("Light: %u (d-thr %u < x < b-thr %u)", m_calc.getAmbientLight(), m_calc.getDarkeningThreshold(), m_calc.getBrighteningThreshold());
 
     return;
 }
 
 void BrightnessCtrl::updateBrightnessGoal()
 {
-    uint8_t     BRIGHTNESS_DYN_RANGE    = m_maxBrightness - m_minBrightness;
-    float       fBrightness             = static_cast<float>(m_minBrightness) + ( static_cast<float>(BRIGHTNESS_DYN_RANGE) * m_ambientLight );
-
-    m_brightnessGoal = static_cast<uint8_t>(fBrightness);
+    m_brightnessGoal = m_calc.calcBrightness(m_minBrightness, m_maxBrightness);
 
     LOG_INFO("Change brightness goal to %u.", m_brightnessGoal);
 
@@ -274,38 +288,13 @@ void BrightnessCtrl::updateBrightnessGoal()
 
 void BrightnessCtrl::updateBrightness()
 {
-    LedMatrix&      matrix  = LedMatrix::getInstance();
-    const uint8_t   STEP    = 2U;
-
-    if (m_brightnessGoal > m_brightness)
+    /* The LED matrix ramps frame by frame to the new brightness. */
+    if (m_brightnessGoal != m_brightness)
     {
-        if ((m_brightnessGoal - STEP) < m_brightness)
-        {
-            m_brightness = m_brightnessGoal;
-        }
-        else
-        {
-            m_brightness += STEP;
-        }
-
-        matrix.setBrightness(m_brightness);
-    }
-    else if (m_brightnessGoal < m_brightness)
-    {
-        if ((m_brightnessGoal + STEP) > m_brightness)
-        {
-            m_brightness = m_brightnessGoal;
-        }
-        else
-        {
-            m_brightness -= STEP;
-        }
+        m_brightness = m_brightnessGoal;
+        LedMatrix::getInstance().setBrightness(m_brightness);
 
-        matrix.setBrightness(m_brightness);
-    }
-    else
-    {
-        ;
+        EventStream::getInstance().notify(EventStream::EVENT_BRIGHTNESS);
     }
 
     return;
@@ -318,3 +307,13 @@ void BrightnessCtrl::updateBrightness()
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Get current display brightness.
+ *
+ * @return Display brightness [0; 255]
+ */
+static int32_t getBrightness()
+{
+    return static_cast<int32_t>(BrightnessCtrl::getInstance().getBrightness());
+}
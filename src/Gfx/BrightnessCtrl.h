@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include <SimpleTimer.hpp>
+#include <BrightnessCalc.h>
 
 /******************************************************************************
  * Macros
@@ -56,7 +57,7 @@
 
 /**
  * The brightness controller sets the display brightness depended on the
- * ambient light.
+ * ambient light. All calculations are done in fixed-point arithmetic.
  */
 class BrightnessCtrl
 {
@@ -118,6 +119,14 @@ public:
         return m_brightness;
     }
 
+    /**
+     * Set the response curve, which maps the ambient light to the brightness.
+     * See BrightnessCalc::setResponseCurve() for details.
+     *
+     * @param[in] curve Response curve with BrightnessCalc::RESPONSE_CURVE_SIZE points
+     */
+    void setResponseCurve(const uint16_t* curve);
+
     /**
      * IIR filter time constant in ms for calculating the short-term moving average
      * of the light sapmles. Used for low latency measurement.
@@ -139,7 +148,7 @@ public:
      * to an observed change in light level that exceeds the hysteresis
      * threshold.
      */
-    static const uint32_t   BRIGHTENING_LIGHT_DEBOUNCE      = 4000U;
+    static const uint32_t   BRIGHTENING_LIGHT_DEBOUNCE      = 2000U;
 
     /**
      * Stability requirement in ms for accepting a new brightness level.
@@ -147,23 +156,23 @@ public:
      * to an observed change in light level that exceeds the hysteresis
      * threshold.
      */
-    static const uint32_t   DARKENING_LIGHT_DEBOUNCE        = 8000U;
+    static const uint32_t   DARKENING_LIGHT_DEBOUNCE        = 4000U;
 
     /**
-     * Hysteresis constraint for brightening in percent [0.0; 1.0].
+     * Hysteresis constraint for brightening in percent [0; 100].
      * The recent measured light must have changed at least this fraction
      * relative to the current ambient light before a change will be
      * considered.
      */
-    static constexpr float  BRIGHTENING_LIGHT_HYSTERESIS    = 0.1F;
+    static const uint8_t    BRIGHTENING_LIGHT_HYSTERESIS    = 10U;
 
     /**
-     * Hysteresis constraint for darkening in percent [0.0; 1.0].
+     * Hysteresis constraint for darkening in percent [0; 100].
      * The recent measured light must have changed at least this fraction
      * relative to the current ambient light before a change will be
      * considered.
      */
-    static constexpr float  DARKENING_LIGHT_HYSTERESIS      = 0.2F;
+    static const uint8_t    DARKENING_LIGHT_HYSTERESIS      = 20U;
 
 private:
 
@@ -177,6 +186,9 @@ private:
     /** Timer, used for automatic brightness adjustment. */
     SimpleTimer             m_autoBrightnessTimer;
 
+    /** Number of light changes, reported by a event driven sensor and already applied. */
+    uint32_t                m_lightChangeCount;
+
     /** Display brightness in digits [0; 255]. */
     uint8_t                 m_brightness;
 
@@ -186,28 +198,11 @@ private:
     /** Max. brightness level in digits [0; 255]. */
     uint8_t                 m_maxBrightness;
 
-    /** Short-term moving average of light (normalized) [0.0; 1.0]. */
-    float                   m_recentShortTermAverage;
-
-    /** Long-term moving average of light (normalized) [0.0; 1.0]. */
-    float                   m_recentLongTermAverage;
-
     /**
-     * Brightening threshold (normalized) [0.0; 1.0]. The ambient light value
-     * must be greater than this threshold to consider it.
+     * Moving averages, ambient light with its thresholds and the response
+     * curve.
      */
-    float                   m_brighteningThreshold;
-
-    /**
-     * Darkening threshold (normalized) [0.0; 1.0]. The ambient light value
-     * must be lower than this threshold to consider it.
-     */
-    float                   m_darkeningThreshold;
-
-    /**
-     * Ambient light (normalized) [0.0; 1.0].
-     */
-    float                   m_ambientLight;
+    BrightnessCalc          m_calc;
 
     /**
      * Light sensor debounce timestamp value.
@@ -241,18 +236,9 @@ private:
      * Set ambient light, which will be used to determine the display brightness.
      * It will update the brightening and darkening thresholds.
      *
-     * @param[in] light Ambient light (normalized) [0.0; 1.0]
-     */
-    void setAmbientLight(float light);
-
-    /**
-     * Apply the measured light sensor value and calculate the short-term and
-     * long-term moving average.
-     *
-     * @param[in] dTime Delta time in ms, between current and last measurement.
-     * @param[in] light Measured light (normalized) [0.0; 1.0]
+     * @param[in] light Ambient light (normalized) [0; UINT16_MAX]
      */
-    void applyLightSensorMeasurement(uint32_t dTime, float light);
+    void setAmbientLight(uint16_t light);
 
     /**
      * Update the display brightness goal. This doesn't changes the display
@@ -262,7 +248,8 @@ private:
     void updateBrightnessGoal();
 
     /**
-     * Update the display brightness.
+     * Update the display brightness to the brightness goal. The LED matrix
+     * ramps the brightness smoothly in its frame pipeline.
      */
     void updateBrightness();
 };
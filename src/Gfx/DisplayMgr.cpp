@@ -37,10 +37,26 @@
 #include "AmbientLightSensor.h"
 #include "Settings.h"
 #include "BrightnessCtrl.h"
+#include "CrashTrace.h"
+#include "ClockDrv.h"
+#include "FrameRecorder.h"
+#include "DisplaySync.h"
+#include "EventStream.h"
+#include "ResponseCache.h"
+#include "RestApi.h"
+#include "SysMsg.h"
 
 #include <Logging.h>
+#include <TimerService.h>
+#include <MonoTime.hpp>
+#include <Metrics.h>
+#include <FadeKernel.h>
 #include <ArduinoJson.h>
 
+#if defined(CONFIG_PM_ENABLE)
+#include <esp_pm.h>
+#endif  /* defined(CONFIG_PM_ENABLE) */
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -49,6 +65,10 @@
  * Macros
  *****************************************************************************/
 
+/** Log with the own log module, see gLogModule. */
+#undef LOG_MODULE
+#define LOG_MODULE  (gLogModule)
+
 /******************************************************************************
  * Types and classes
  *****************************************************************************/
@@ -61,6 +81,50 @@
  * Local Variables
  *****************************************************************************/
 
+/** Log module of the display manager, its log level can be changed at runtime. */
+static Logging::Module  gLogModule("DisplayMgr");
+
+/** Upper bounds of the frame time histogram buckets in ms. */
+static const uint32_t   gFrameTimeBounds[]  = { 5U, 10U, 20U, 30U, 40U, 60U, 100U };
+
+/** Frame time histogram */
+static MetricHistogram  gMetricFrameTime("pixelix_display_frame_time_ms", "Time to update a display frame in ms.", gFrameTimeBounds, UTIL_ARRAY_NUM(gFrameTimeBounds));
+
+/** Number of skipped frames */
+static MetricCounter    gMetricSkippedFrames("pixelix_display_skipped_frames_total", "Number of skipped display frames.");
+
+/** Number of slot changes */
+static MetricCounter    gMetricSlotChanges("pixelix_display_slot_changes_total", "Number of slot changes.");
+
+/** Upper bounds of the preemption latency histogram buckets in ms. */
+static const uint32_t   gPreemptionLatencyBounds[]  = { 10U, 20U, 40U, 80U, 160U };
+
+/** Preemption latency histogram */
+static MetricHistogram  gMetricPreemptionLatency("pixelix_display_preemption_latency_ms", "Time from a urgent request until its first frame is output in ms.", gPreemptionLatencyBounds, UTIL_ARRAY_NUM(gPreemptionLatencyBounds));
+
+/** Number of plugin throttle steps, caused by the CPU budget watchdog */
+static MetricCounter    gMetricPluginThrottles("pixelix_display_plugin_throttles_total", "Number of plugin throttle steps, because the CPU budget was exceeded.");
+
+/** Number of plugins disabled by the CPU budget watchdog */
+static MetricCounter    gMetricPluginBudgetDisables("pixelix_display_plugin_budget_disables_total", "Number of plugins disabled, because the CPU budget was exceeded.");
+
+/** Duration in ms, how long the message about a disabled plugin is shown. */
+static const uint32_t   BUDGET_MSG_DURATION = 4000U;
+
+/** How often the message about a disabled plugin is shown. */
+static const uint32_t   BUDGET_MSG_MAX      = 1U;
+
+#if (0 != DISPLAY_MGR_IDLE_MODE) && defined(CONFIG_PM_ENABLE)
+
+/**
+ * Power management lock, which prevents the automatic light sleep as long
+ * as the display task is not idle. The LED matrix keeps its content without
+ * any output, therefore the light sleep is only allowed while idle.
+ */
+static esp_pm_lock_handle_t gPmLock             = nullptr;
+
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) && defined(CONFIG_PM_ENABLE) */
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -75,21 +139,57 @@ bool DisplayMgr::begin()
     BrightnessCtrl::getInstance().init();
     BrightnessCtrl::getInstance().setBrightness(BRIGHTNESS_DEFAULT);
 
+    /* Fade effects work on full-screen framebuffers, therefore specialize
+     * their kernels on the LED matrix size.
+     */
+    FadeKernel::useFixedGeometry<Board::LedMatrix::width, Board::LedMatrix::height>();
+
     /* No slots available? */
     if (nullptr == m_slots)
     {
+        uint8_t targetFps   = 0U;
+        uint8_t rotation    = 0U;
+        bool    isMirrored  = false;
+
         if (false == Settings::getInstance().open(true))
         {
-            m_maxSlots = Settings::getInstance().getMaxSlots().getDefault();
+            m_maxSlots  = Settings::getInstance().getMaxSlots().getDefault();
+            targetFps   = Settings::getInstance().getDisplayFps().getDefault();
+            rotation    = Settings::getInstance().getDisplayRotation().getDefault();
+            isMirrored  = Settings::getInstance().getDisplayMirror().getDefault();
 
-            LOG_WARNING("Using default number of max. slots.");
+            LOG_WARNING("Using default number of max. slots and refresh rate.");
         }
         else
         {
-            m_maxSlots = Settings::getInstance().getMaxSlots().getValue();
+            m_maxSlots  = Settings::getInstance().getMaxSlots().getValue();
+            targetFps   = Settings::getInstance().getDisplayFps().getValue();
+            rotation    = Settings::getInstance().getDisplayRotation().getValue();
+            isMirrored  = Settings::getInstance().getDisplayMirror().getValue();
             Settings::getInstance().close();
         }
 
+        /* The display task is not running yet, so the orientation can be set safely. */
+        if ((LedMatrix::ROTATION_COUNT <= rotation) ||
+            (false == LedMatrix::getInstance().setOrientation(static_cast<LedMatrix::Rotation>(rotation), isMirrored)))
+        {
+            LOG_WARNING("Display rotation %u not supported.", rotation);
+        }
+
+#if (0 != DISPLAY_MGR_COOPERATIVE)
+        if (TARGET_FPS_MAX < targetFps)
+        {
+            LOG_INFO("Refresh rate limited to %u fps.", TARGET_FPS_MAX);
+            targetFps = TARGET_FPS_MAX;
+        }
+#endif  /* (0 != DISPLAY_MGR_COOPERATIVE) */
+
+        if (0U < targetFps)
+        {
+            m_framePeriod               = 1000U / targetFps;
+            m_statistics.targetFps      = targetFps;
+        }
+
         if (0 < m_maxSlots)
         {
             m_slots = new Slot[m_maxSlots];
@@ -153,13 +253,38 @@ bool DisplayMgr::begin()
             /* Task shall run */
             m_taskExit = false;
 
-            osRet = xTaskCreateUniversal(   updateTask,
-                                            "displayTask",
-                                            TASK_STACKE_SIZE,
-                                            this,
-                                            TASK_PRIORITY,
-                                            &m_taskHandle,
-                                            TASK_RUN_CORE);
+#if (0 != DISPLAY_MGR_IDLE_MODE) && defined(CONFIG_PM_ENABLE)
+            /* The display task starts active. */
+            if ((nullptr == gPmLock) &&
+                (ESP_OK == esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "display", &gPmLock)))
+            {
+                (void)esp_pm_lock_acquire(gPmLock);
+            }
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) && defined(CONFIG_PM_ENABLE) */
+
+            /* Without the prepare task, the plugins are just not prepared before a slot change. */
+            if (false == startPrepareTask())
+            {
+                LOG_WARNING("Couldn't start display prepare task.");
+            }
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+            /* The output task must run, before the display task hands over the first frame. */
+            if (false == startOutputTask())
+            {
+                LOG_ERROR("Couldn't start display output task.");
+            }
+            else
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+            {
+                osRet = xTaskCreateUniversal(   updateTask,
+                                                "displayTask",
+                                                TASK_STACKE_SIZE,
+                                                this,
+                                                TASK_PRIORITY,
+                                                &m_taskHandle,
+                                                TASK_RUN_CORE);
+            }
 
             /* Task successful created? */
             if (pdPASS == osRet)
@@ -173,6 +298,12 @@ bool DisplayMgr::begin()
     /* Any error happened? */
     if (false == status)
     {
+#if (0 != DISPLAY_MGR_PIPELINED)
+        stopOutputTask();
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+        stopPrepareTask();
+
         if (nullptr != m_xMutex)
         {
             vSemaphoreDelete(m_xMutex);
@@ -202,10 +333,24 @@ void DisplayMgr::end()
     {
         m_taskExit = true;
 
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+        /* Wake up the display task, in case it is idle. */
+        (void)xTaskNotifyGive(m_taskHandle);
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
         /* Join */
         (void)xSemaphoreTake(m_xSemaphore, portMAX_DELAY);
         m_taskHandle = nullptr;
 
+#if (0 != DISPLAY_MGR_PIPELINED)
+        /* The output task is stopped after the display task, because the
+         * display task may wait for the output of its last frame.
+         */
+        stopOutputTask();
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+        stopPrepareTask();
+
         LOG_INFO("DisplayMgr is down.");
 
         vSemaphoreDelete(m_xSemaphore);
@@ -242,20 +387,31 @@ bool DisplayMgr::getAutoBrightnessAdjustment(void)
 
 void DisplayMgr::setBrightness(uint8_t level)
 {
-    lock();
-    BrightnessCtrl::getInstance().setBrightness(level);
-    unlock();
+    /* The brightness is applied by the display task. A single aligned word
+     * is written, therefore no lock is necessary.
+     */
+    m_requestedBrightness = level;
+
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+    wakeUp();
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
 
     return;
 }
 
 uint8_t DisplayMgr::getBrightness(void)
 {
-    uint8_t brightness = 0U;
+    const uint32_t  REQUESTED   = m_requestedBrightness;
+    uint8_t         brightness  = 0U;
 
-    lock(),
-    brightness = BrightnessCtrl::getInstance().getBrightness();
-    unlock();
+    if (BRIGHTNESS_REQUEST_NONE != REQUESTED)
+    {
+        brightness = static_cast<uint8_t>(REQUESTED);
+    }
+    else
+    {
+        brightness = BrightnessCtrl::getInstance().getBrightness();
+    }
 
     return brightness;
 }
@@ -282,7 +438,7 @@ uint8_t DisplayMgr::installPlugin(IPluginMaintenance* plugin, uint8_t slotId)
 
             if (m_maxSlots > slotId)
             {
-                if (false == m_slots[slotId].setPlugin(plugin))
+                if (false == setSlotPlugin(slotId, plugin))
                 {
                     slotId = SLOT_ID_INVALID;
                 }
@@ -299,13 +455,14 @@ uint8_t DisplayMgr::installPlugin(IPluginMaintenance* plugin, uint8_t slotId)
             unlock();
         }
         /* Install to specific slot? */
-        else if ((m_maxSlots > slotId) &&
-                 (true == m_slots[slotId].isEmpty()) &&
-                 (false == m_slots[slotId].isLocked()))
+        else
         {
             lock();
 
-            if (false == m_slots[slotId].setPlugin(plugin))
+            if ((m_maxSlots <= slotId) ||
+                (false == m_slots[slotId].isEmpty()) ||
+                (true == m_slots[slotId].isLocked()) ||
+                (false == setSlotPlugin(slotId, plugin)))
             {
                 slotId = SLOT_ID_INVALID;
             }
@@ -316,10 +473,6 @@ uint8_t DisplayMgr::installPlugin(IPluginMaintenance* plugin, uint8_t slotId)
 
             unlock();
         }
-        else
-        {
-            slotId = SLOT_ID_INVALID;
-        }
 
         if (m_maxSlots > slotId)
         {
@@ -353,8 +506,14 @@ bool DisplayMgr::uninstallPlugin(IPluginMaintenance* plugin)
                     m_selectedPlugin = nullptr;
                 }
 
+                /* Is this plugin requested to be prepared? */
+                if (m_preparePlugin == plugin)
+                {
+                    m_preparePlugin = nullptr;
+                }
+
                 plugin->stop();
-                if (false == m_slots[slotId].setPlugin(nullptr))
+                if (false == setSlotPlugin(slotId, nullptr))
                 {
                     LOG_FATAL("Internal error.");
                 }
@@ -367,6 +526,17 @@ bool DisplayMgr::uninstallPlugin(IPluginMaintenance* plugin)
 
         unlock();
 
+        /* The plugin may be prepared right now, therefore wait until its
+         * preparation is finished. The display must not be locked meanwhile,
+         * because the prepare task locks it too.
+         */
+        if ((true == status) &&
+            (nullptr != m_xPrepareMutex))
+        {
+            (void)xSemaphoreTake(m_xPrepareMutex, portMAX_DELAY);
+            (void)xSemaphoreGive(m_xPrepareMutex);
+        }
+
         if (false == status)
         {
             LOG_INFO("Couldn't remove plugin %s (uid %u) from slot %u, because slot is locked.", plugin->getName(), plugin->getUID(), slotId);
@@ -382,22 +552,29 @@ bool DisplayMgr::uninstallPlugin(IPluginMaintenance* plugin)
 
 uint8_t DisplayMgr::getSlotIdByPluginUID(uint16_t uid)
 {
-    uint8_t index   = 0U;
     uint8_t slotId  = SLOT_ID_INVALID;
 
     lock();
 
-    while((m_maxSlots > index) && (m_maxSlots <= slotId))
+    if (false == m_slotIndex.find(uid, slotId))
     {
-        if (false == m_slots[index].isEmpty())
-        {
-            if (uid == m_slots[index].getPlugin()->getUID())
-            {
-                slotId = index;
-            }
-        }
+        slotId = SLOT_ID_INVALID;
+    }
+
+    unlock();
+
+    return slotId;
+}
+
+uint8_t DisplayMgr::getActiveSlotId()
+{
+    uint8_t slotId = SLOT_ID_INVALID;
+
+    lock();
 
-        ++index;
+    if (nullptr != m_selectedPlugin)
+    {
+        slotId = m_selectedSlot;
     }
 
     unlock();
@@ -409,19 +586,19 @@ IPluginMaintenance* DisplayMgr::getPluginInSlot(uint8_t slotId)
 {
     IPluginMaintenance* plugin = nullptr;
 
+    lock();
+
     if (m_maxSlots > slotId)
     {
-        lock();
-
         plugin = m_slots[slotId].getPlugin();
-
-        unlock();
     }
 
+    unlock();
+
     return plugin;
 }
 
-void DisplayMgr::activatePlugin(IPluginMaintenance* plugin)
+void DisplayMgr::activatePlugin(IPluginMaintenance* plugin, Priority priority)
 {
     if (nullptr != plugin)
     {
@@ -431,9 +608,19 @@ void DisplayMgr::activatePlugin(IPluginMaintenance* plugin)
 
         slotId = getSlotIdByPluginUID(plugin->getUID());
 
-        if (m_maxSlots > slotId)
+        /* A pending urgent request is not replaced by a normal one. */
+        if ((m_maxSlots > slotId) &&
+            ((nullptr == m_requestedPlugin) ||
+             (PRIORITY_URGENT != m_requestedPriority) ||
+             (PRIORITY_URGENT == priority)))
         {
-            m_requestedPlugin = plugin;
+            m_requestedPlugin   = plugin;
+            m_requestedPriority = priority;
+
+            if (PRIORITY_URGENT == priority)
+            {
+                m_preemptionTimestamp = MonoTime::getMillis();
+            }
         }
 
         unlock();
@@ -465,7 +652,7 @@ void DisplayMgr::activateNextFadeEffect(FadeEffect fadeEffect)
 {
     lock();
 
-    if (FADE_EFFECT_MOVE_Y < fadeEffect)
+    if (FADE_EFFECT_WIPE_X < fadeEffect)
     {
         m_fadeEffectIndex = FADE_EFFECT_LINEAR;
     }
@@ -498,6 +685,8 @@ bool DisplayMgr::movePluginToSlot(IPluginMaintenance* plugin, uint8_t slotId)
 {
     bool status = false;
 
+    lock();
+
     if ((nullptr != plugin) &&
         (m_maxSlots > slotId))
     {
@@ -509,12 +698,10 @@ bool DisplayMgr::movePluginToSlot(IPluginMaintenance* plugin, uint8_t slotId)
             Slot*   srcSlot = &m_slots[srcSlotId];
             Slot*   dstSlot = &m_slots[slotId];
 
-            lock();
-
             if (false == dstSlot->isLocked())
             {
-                srcSlot->setPlugin(dstSlot->getPlugin());
-                dstSlot->setPlugin(plugin);
+                (void)setSlotPlugin(srcSlotId, dstSlot->getPlugin());
+                (void)setSlotPlugin(slotId, plugin);
 
                 /* Is one of the moved plugins selected at the moment? */
                 if ((m_selectedPlugin == srcSlot->getPlugin()) ||
@@ -526,39 +713,41 @@ bool DisplayMgr::movePluginToSlot(IPluginMaintenance* plugin, uint8_t slotId)
 
                 status = true;
             }
-
-            unlock();
         }
     }
 
+    unlock();
+
     return status;
 }
 
 void DisplayMgr::lockSlot(uint8_t slotId)
 {
+    lock();
+
     if (m_maxSlots > slotId)
     {
-        lock();
-
         m_slots[slotId].lock();
-
-        unlock();
+        ResponseCache::getInstance().invalidate(RestApi::URI_DISPLAY_SLOTS);
     }
 
+    unlock();
+
     return;
 }
 
 void DisplayMgr::unlockSlot(uint8_t slotId)
 {
+    lock();
+
     if (m_maxSlots > slotId)
     {
-        lock();
-
         m_slots[slotId].unlock();
-
-        unlock();
+        ResponseCache::getInstance().invalidate(RestApi::URI_DISPLAY_SLOTS);
     }
 
+    unlock();
+
     return;
 }
 
@@ -566,15 +755,15 @@ bool DisplayMgr::isSlotLocked(uint8_t slotId)
 {
     bool isLocked = true;
 
+    lock();
+
     if (m_maxSlots > slotId)
     {
-        lock();
-
         isLocked = m_slots[slotId].isLocked();
-
-        unlock();
     }
 
+    unlock();
+
     return isLocked;
 }
 
@@ -582,15 +771,15 @@ uint32_t DisplayMgr::getSlotDuration(uint8_t slotId)
 {
     uint32_t duration = 0U;
 
+    lock();
+
     if (m_maxSlots > slotId)
     {
-        lock();
-
         duration = m_slots[slotId].getDuration();
-
-        unlock();
     }
 
+    unlock();
+
     return duration;
 }
 
@@ -598,13 +787,14 @@ bool DisplayMgr::setSlotDuration(uint8_t slotId, uint32_t duration, bool store)
 {
     bool status = false;
 
+    lock();
+
     if (m_maxSlots > slotId)
     {
-        lock();
-
         if (m_slots[slotId].getDuration() != duration)
         {
             m_slots[slotId].setDuration(duration);
+            ResponseCache::getInstance().invalidate(RestApi::URI_DISPLAY_SLOTS);
 
             /* Save slot configuration */
             if (true == store)
@@ -613,494 +803,2047 @@ bool DisplayMgr::setSlotDuration(uint8_t slotId, uint32_t duration, bool store)
             }
         }
 
-        unlock();
-
         status = true;
     }
 
+    unlock();
+
     return status;
 }
 
-void DisplayMgr::getFBCopy(uint32_t* fb, size_t length, uint8_t* slotId)
+bool DisplayMgr::getSlotSchedule(uint8_t slotId, Slot::Schedule& schedule)
 {
-    if ((nullptr != fb) &&
-        (0 < length))
+    bool status = false;
+
+    lock();
+
+    if (m_maxSlots > slotId)
     {
-        LedMatrix&  matrix  = LedMatrix::getInstance();
-        int16_t     x       = 0;
-        int16_t     y       = 0;
-        size_t      index   = 0;
+        schedule = m_slots[slotId].getSchedule();
 
-        lock();
+        status = true;
+    }
+
+    unlock();
+
+    return status;
+}
+
+bool DisplayMgr::setSlotSchedule(uint8_t slotId, const Slot::Schedule& schedule, bool store)
+{
+    bool status = false;
+
+    lock();
+
+    if ((m_maxSlots > slotId) &&
+        (SlotPlan::MAX_WEIGHT >= schedule.weight) &&
+        (SlotPlan::MINUTES_PER_DAY > schedule.timeBegin) &&
+        (SlotPlan::MINUTES_PER_DAY > schedule.timeEnd))
+    {
+        const Slot::Schedule& current = m_slots[slotId].getSchedule();
 
-        /* Copy framebuffer after it is completely updated. */
-        for(y = 0; y < matrix.getHeight(); ++y)
+        if ((current.weight != schedule.weight) ||
+            (current.timeBegin != schedule.timeBegin) ||
+            (current.timeEnd != schedule.timeEnd))
         {
-            for(x = 0; x < matrix.getWidth(); ++x)
+            /* Only a changed weight changes the rotation plan. */
+            if (current.weight != schedule.weight)
             {
-                fb[index] = matrix.getColor(x, y);
-                ++index;
+                m_isPlanUpdateReq = true;
+            }
 
-                if (length <= index)
-                {
-                    break;
-                }
+            m_slots[slotId].setSchedule(schedule);
+            ResponseCache::getInstance().invalidate(RestApi::URI_DISPLAY_SLOTS);
+
+            /* Save slot configuration */
+            if (true == store)
+            {
+                save();
             }
         }
 
-        if (nullptr != slotId)
+        status = true;
+    }
+
+    unlock();
+
+    return status;
+}
+
+bool DisplayMgr::setMaxSlots(uint8_t maxSlots)
+{
+    bool            status      = false;
+    bool            isChanged   = false;
+    Settings&       settings    = Settings::getInstance();
+    KeyValueUInt8&  kvMaxSlots  = settings.getMaxSlots();
+
+    if ((kvMaxSlots.getMin() <= maxSlots) &&
+        (kvMaxSlots.getMax() >= maxSlots))
+    {
+        lock();
+
+        if (nullptr == m_slots)
+        {
+            LOG_WARNING("No slot exists.");
+        }
+        else if (m_maxSlots == maxSlots)
+        {
+            status = true;
+        }
+        else
         {
-            *slotId = m_selectedSlot;
+            status      = resizeSlots(maxSlots);
+            isChanged   = status;
         }
 
         unlock();
     }
 
-    return;
-}
-
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
+    /* Store the number of slots and the migrated slot installation once. */
+    if (true == isChanged)
+    {
+        ResponseCache::getInstance().invalidate(RestApi::URI_DISPLAY_SLOTS);
 
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
+        if (false == settings.open(false))
+        {
+            LOG_WARNING("Couldn't open filesystem.");
+        }
+        else
+        {
+            kvMaxSlots.setValue(maxSlots);
+            settings.close();
+        }
 
-DisplayMgr::DisplayMgr() :
-    m_xMutex(nullptr),
-    m_taskHandle(nullptr),
-    m_taskExit(false),
-    m_xSemaphore(nullptr),
-    m_slots(nullptr),
-    m_maxSlots(0U),
-    m_selectedSlot(SLOT_ID_INVALID),
-    m_selectedPlugin(nullptr),
-    m_requestedPlugin(nullptr),
-    m_slotTimer(),
-    m_displayFadeState(FADE_IN),
-    m_currCanvas(nullptr),
-    m_framebuffers(),
-    m_fadeLinearEffect(),
-    m_fadeMoveXEffect(),
-    m_fadeMoveYEffect(),
-    m_fadeEffect(&m_fadeLinearEffect),
-    m_fadeEffectIndex(FADE_EFFECT_LINEAR),
-    m_fadeEffectUpdate(false)
-{
-    uint8_t idx = 0U;
+        save();
 
-    for(idx = 0; idx < UTIL_ARRAY_NUM(m_framebuffers); ++idx)
-    {
-        m_framebuffers[idx] = nullptr;
+        LOG_INFO("Number of slots changed to %u.", maxSlots);
     }
+
+    return status;
 }
 
-DisplayMgr::~DisplayMgr()
+uint8_t DisplayMgr::releaseInactiveAssets()
 {
-    uint8_t idx = 0;
+    uint8_t count   = 0U;
+    uint8_t slotId  = 0U;
 
-    end();
+    /* The display task can't activate a plugin meanwhile. */
+    lock();
 
-    for(idx = 0; idx < UTIL_ARRAY_NUM(m_framebuffers); ++idx)
+    for(slotId = 0U; slotId < m_maxSlots; ++slotId)
     {
-        if (nullptr != m_framebuffers[idx])
+        IPluginMaintenance* plugin = m_slots[slotId].getPlugin();
+
+        if ((nullptr != plugin) &&
+            (m_selectedPlugin != plugin) &&
+            (m_requestedPlugin != plugin) &&
+            (m_preparePlugin != plugin))
         {
-            delete m_framebuffers[idx];
-            m_framebuffers[idx] = nullptr;
+            plugin->releaseAssets();
+            ++count;
         }
     }
+
+    unlock();
+
+    return count;
 }
 
-uint8_t DisplayMgr::nextSlot(uint8_t slotId)
+void DisplayMgr::beginLayoutChange()
 {
-    uint8_t count = 0U;
+    lock();
+
+    return;
+}
+
+void DisplayMgr::endLayoutChange()
+{
+    unlock();
+
+    return;
+}
+
+void DisplayMgr::save()
+{
+    if (nullptr != m_slots)
+    {
+        Settings&   settings    = Settings::getInstance();
+        size_t      size        = SlotRecord::getSize(m_maxSlots);
+        SlotRecord* records     = new SlotRecord[m_maxSlots];
+        uint8_t*    buffer      = new uint8_t[size];
+        uint8_t     slotId      = 0U;
+
+        if ((nullptr == records) ||
+            (nullptr == buffer))
+        {
+            LOG_ERROR("Out of memory.");
+        }
+        else
+        {
+            lock();
+
+            for(slotId = 0U; slotId < m_maxSlots; ++slotId)
+            {
+                IPluginMaintenance* plugin = m_slots[slotId].getPlugin();
+
+                records[slotId].slotId      = slotId;
+                records[slotId].duration    = m_slots[slotId].getDuration();
+                records[slotId].isLocked    = m_slots[slotId].isLocked();
+                records[slotId].weight      = m_slots[slotId].getSchedule().weight;
+                records[slotId].timeBegin   = m_slots[slotId].getSchedule().timeBegin;
+                records[slotId].timeEnd     = m_slots[slotId].getSchedule().timeEnd;
+
+                if (nullptr != plugin)
+                {
+                    records[slotId].typeId  = SlotRecord::getTypeId(plugin->getName());
+                    records[slotId].uid     = plugin->getUID();
+                }
+            }
+
+            unlock();
+
+            size = SlotRecord::encode(records, m_maxSlots, buffer, size);
+
+            if (false == settings.open(false))
+            {
+                LOG_WARNING("Couldn't open filesystem.");
+            }
+            else
+            {
+                if (false == settings.getSlotInstallation().setValue(buffer, size))
+                {
+                    LOG_ERROR("Slot installation is too large.");
+                }
+
+                settings.close();
+            }
+        }
+
+        delete[] records;
+        delete[] buffer;
+    }
+}
+
+bool DisplayMgr::readSlotInstallation(SlotRecord* records, uint8_t max, uint8_t& num)
+{
+    bool            isAvailable = false;
+    KeyValueBlob&   kvBlob      = Settings::getInstance().getSlotInstallation();
+    size_t          size        = kvBlob.getLength();
+
+    num = 0U;
+
+    if (0U < size)
+    {
+        uint8_t* buffer = new uint8_t[size];
+
+        if (nullptr == buffer)
+        {
+            LOG_ERROR("Out of memory.");
+        }
+        else
+        {
+            size = kvBlob.getValue(buffer, size);
+
+            if (false == SlotRecord::decode(buffer, size, records, max, num))
+            {
+                LOG_WARNING("Invalid slot installation.");
+            }
+            else
+            {
+                isAvailable = true;
+            }
+
+            delete[] buffer;
+        }
+    }
+
+    return isAvailable;
+}
+
+void DisplayMgr::getFBCopy(uint32_t* fb, size_t length, uint8_t* slotId)
+{
+    if ((nullptr != fb) &&
+        (0 < length))
+    {
+        uint8_t publishedSlotId = SLOT_ID_INVALID;
+
+        if (FRAME_PIXEL_COUNT < length)
+        {
+            length = FRAME_PIXEL_COUNT;
+        }
+
+        /* Keep the frame published for polling consumers. */
+        m_frameRequestTimestamp = MonoTime::getMillis();
+        m_isFrameRequested      = true;
+
+        /* Not published, read it directly. */
+        if (false == m_isFramePublished)
+        {
+            lock();
+            LedMatrix::getInstance().getFrame(fb, length);
+            publishedSlotId = m_selectedSlot;
+            unlock();
+        }
+        else
+        {
+            uint32_t    seqBegin    = 0U;
+            uint32_t    seqEnd      = 0U;
+
+            /* Retry until a frame was copied, which was not updated by the
+             * display task in the meantime.
+             */
+            do
+            {
+                seqBegin = m_publishedFrameSeq;
+                __sync_synchronize();
+
+                memcpy(fb, m_publishedFrame, length * sizeof(m_publishedFrame[0]));
+                publishedSlotId = m_publishedSlotId;
+
+                __sync_synchronize();
+                seqEnd = m_publishedFrameSeq;
+            }
+            while((0U != (seqBegin & 1U)) || (seqBegin != seqEnd));
+        }
+
+        if (nullptr != slotId)
+        {
+            *slotId = publishedSlotId;
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::subscribeFrame()
+{
+    lock();
+
+    if (UINT8_MAX > m_frameSubscribers)
+    {
+        ++m_frameSubscribers;
+    }
+
+    unlock();
+
+    return;
+}
+
+void DisplayMgr::unsubscribeFrame()
+{
+    lock();
+
+    if (0U < m_frameSubscribers)
+    {
+        --m_frameSubscribers;
+    }
+
+    unlock();
+
+    return;
+}
+
+void DisplayMgr::getStatistics(Statistics& statistics)
+{
+    lock();
+    statistics = m_statistics;
+    unlock();
+
+    return;
+}
+
+bool DisplayMgr::addOverlay(Widget& overlay, OverlayLayer layer, uint8_t alpha)
+{
+    bool isAdded = false;
+
+    lock();
+
+    if ((nullptr == m_currCanvas) &&
+        (0U < alpha))
+    {
+        alpha = Compositor::ALPHA_OPAQUE;
+    }
+
+    isAdded = m_compositor.addLayer(overlay, static_cast<uint8_t>(layer), alpha);
+
+    unlock();
+
+    return isAdded;
+}
+
+void DisplayMgr::removeOverlay(Widget& overlay)
+{
+    lock();
+    m_compositor.removeLayer(overlay);
+    unlock();
+
+    return;
+}
+
+void DisplayMgr::setReducedPriority(bool isReduced)
+{
+    UBaseType_t priority = TASK_PRIORITY;
+
+    if (true == isReduced)
+    {
+        priority = TASK_PRIORITY_REDUCED;
+    }
+
+    if (nullptr != m_taskHandle)
+    {
+        vTaskPrioritySet(m_taskHandle, priority);
+    }
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+    /* The output task keeps its priority above the display task. */
+    if (nullptr != m_outputTaskHandle)
+    {
+        vTaskPrioritySet(m_outputTaskHandle, priority + 1U);
+    }
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+    return;
+}
+
+bool DisplayMgr::beginFlashAccess(uint32_t timeout)
+{
+    bool isGranted = false;
+
+    if (pdTRUE == xSemaphoreTake(m_xOutputGate, pdMS_TO_TICKS(timeout)))
+    {
+        /* A new output can't start anymore, but a running one must be finished first. */
+        if (false == LedMatrix::getInstance().waitUntilReady(timeout))
+        {
+            (void)xSemaphoreGive(m_xOutputGate);
+        }
+        else
+        {
+            isGranted = true;
+        }
+    }
+
+    return isGranted;
+}
+
+void DisplayMgr::endFlashAccess()
+{
+    (void)xSemaphoreGive(m_xOutputGate);
+
+    return;
+}
+
+bool DisplayMgr::getPluginProfile(uint8_t slotId, PluginProfile& profile)
+{
+    bool status = false;
+
+    lock();
+
+    if (m_maxSlots > slotId)
+    {
+        Slot::Profile& slotProfile = m_slots[slotId].getProfile();
+
+        getProfileSummary(slotProfile.process, profile.process);
+        getProfileSummary(slotProfile.update, profile.update);
+        getProfileSummary(slotProfile.active, profile.active);
+
+        status = true;
+    }
+
+    unlock();
+
+    return status;
+}
+
+BudgetWatchdog::Level DisplayMgr::getSlotBudgetLevel(uint8_t slotId)
+{
+    BudgetWatchdog::Level level = BudgetWatchdog::LEVEL_NORMAL;
+
+    lock();
+
+    if (m_maxSlots > slotId)
+    {
+        level = m_slots[slotId].getWatchdog().getLevel();
+    }
+
+    unlock();
+
+    return level;
+}
+
+void DisplayMgr::getFadeProfile(ProfileStat::Summary& profile)
+{
+    lock();
+    getProfileSummary(m_fadeProfile, profile);
+    unlock();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+DisplayMgr::DisplayMgr() :
+    m_xMutex(nullptr),
+    m_taskHandle(nullptr),
+    m_taskExit(false),
+    m_xSemaphore(nullptr),
+    m_xOutputGate(xSemaphoreCreateMutex()),
+    m_compositor(),
+#if (0 != DISPLAY_MGR_PIPELINED)
+    m_outputTaskHandle(nullptr),
+    m_outputTaskExit(false),
+    m_xOutputSemaphore(nullptr),
+    m_xFrameReady(nullptr),
+    m_xFrameFree(nullptr),
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+    m_prepareTaskHandle(nullptr),
+    m_prepareTaskExit(false),
+    m_xPrepareSemaphore(nullptr),
+    m_xPrepareRequest(nullptr),
+    m_xPrepareMutex(nullptr),
+    m_preparePlugin(nullptr),
+    m_isPrepareRequested(false),
+    m_slots(nullptr),
+    m_maxSlots(0U),
+    m_slotIndex(),
+    m_plan(),
+    m_planIndex(SlotPlan::MAX_LENGTH),
+    m_isPlanUpdateReq(true),
+    m_selectedSlot(SLOT_ID_INVALID),
+    m_selectedPlugin(nullptr),
+    m_timeToNextUpdate(IPluginMaintenance::UPDATE_ALWAYS),
+    m_requestedPlugin(nullptr),
+    m_requestedPriority(PRIORITY_NORMAL),
+    m_preemptionTimestamp(0U),
+    m_isPreemptionMeasured(false),
+    m_resumeSlot(SLOT_ID_INVALID),
+    m_resumeDuration(0U),
+    m_slotTimer(),
+    m_requestedBrightness(BRIGHTNESS_REQUEST_NONE),
+    m_framePeriod(TASK_PERIOD),
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+    m_staticFrames(0U),
+    m_isIdle(false),
+    m_idlePeriod(0U),
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+    m_statistics(),
+    m_fadeProfile(),
+    m_displayFadeState(FADE_IN),
+    m_currCanvas(nullptr),
+    m_framebuffers(),
+    m_fadeLinearEffect(),
+    m_fadeMoveXEffect(),
+    m_fadeMoveYEffect(),
+    m_fadeCrossEffect(),
+    m_fadeWipeXEffect(),
+    m_fadeEffect(&m_fadeLinearEffect),
+    m_fadeEffectIndex(FADE_EFFECT_LINEAR),
+    m_fadeEffectUpdate(false),
+    m_publishedFrame(),
+    m_publishedSlotId(SLOT_ID_INVALID),
+    m_publishedFrameSeq(0U),
+    m_frameSubscribers(0U),
+    m_isFramePublished(false),
+    m_isFrameRequested(false),
+    m_frameRequestTimestamp(0U)
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0; idx < UTIL_ARRAY_NUM(m_framebuffers); ++idx)
+    {
+        m_framebuffers[idx] = nullptr;
+    }
+
+    m_statistics.targetFps = 1000U / TASK_PERIOD;
+}
+
+DisplayMgr::~DisplayMgr()
+{
+    uint8_t idx = 0;
+
+    end();
+
+    for(idx = 0; idx < UTIL_ARRAY_NUM(m_framebuffers); ++idx)
+    {
+        if (nullptr != m_framebuffers[idx])
+        {
+            delete m_framebuffers[idx];
+            m_framebuffers[idx] = nullptr;
+        }
+    }
+}
+
+uint8_t DisplayMgr::nextSlot(uint8_t& planIndex)
+{
+    uint8_t     slotId          = SLOT_ID_INVALID;
+    uint8_t     count           = 0U;
+    uint8_t     length          = 0U;
+    bool        isTimeAvailable = false;
+    uint16_t    minuteOfDay     = 0U;
+    struct tm   timeInfo;
+
+    /* The plan is only built again, if a slot weight changed. */
+    if (true == m_isPlanUpdateReq)
+    {
+        updatePlan();
+        planIndex = SlotPlan::MAX_LENGTH;
+    }
+
+    length = m_plan.getLength();
+
+    /* Without time, the time windows are ignored. */
+    if (true == ClockDrv::getInstance().getTime(&timeInfo))
+    {
+        minuteOfDay     = static_cast<uint16_t>((timeInfo.tm_hour * 60) + timeInfo.tm_min);
+        isTimeAvailable = true;
+    }
+
+    /* Walk along the plan, starting behind the current position. */
+    while((length > count) && (SLOT_ID_INVALID == slotId))
+    {
+        uint8_t candidate = SLOT_ID_INVALID;
+
+        if (length <= planIndex)
+        {
+            planIndex = 0U;
+        }
+        else
+        {
+            ++planIndex;
+            planIndex %= length;
+        }
+
+        candidate = m_plan.getSlotId(planIndex);
+
+        if (true == isSlotScheduled(candidate, isTimeAvailable, minuteOfDay))
+        {
+            slotId = candidate;
+        }
+
+        ++count;
+    }
+
+    /* If no slot fulfills its schedule, show any enabled plugin instead of
+     * a dark display.
+     */
+    if (SLOT_ID_INVALID == slotId)
+    {
+        slotId = nextEnabledSlot(m_selectedSlot);
+    }
+
+    return slotId;
+}
+
+void DisplayMgr::updatePlan()
+{
+    uint8_t weights[SlotPlan::MAX_SLOTS];
+    uint8_t slotId  = 0U;
+
+    for(slotId = 0U; (slotId < m_maxSlots) && (slotId < SlotPlan::MAX_SLOTS); ++slotId)
+    {
+        weights[slotId] = m_slots[slotId].getSchedule().weight;
+    }
+
+    m_plan.build(weights, slotId);
+    m_isPlanUpdateReq = false;
+
+    return;
+}
+
+bool DisplayMgr::isSlotScheduled(uint8_t slotId, bool isTimeAvailable, uint16_t minuteOfDay)
+{
+    bool isScheduled = false;
+
+    if ((m_maxSlots > slotId) &&
+        (false == m_slots[slotId].isEmpty()))
+    {
+        const Slot::Schedule&   schedule    = m_slots[slotId].getSchedule();
+        IPluginMaintenance*     plugin      = m_slots[slotId].getPlugin();
+
+        if ((true == plugin->isEnabled()) &&
+            (true == plugin->hasContent()))
+        {
+            if ((false == isTimeAvailable) ||
+                (true == SlotPlan::isInTimeWindow(schedule.timeBegin, schedule.timeEnd, minuteOfDay)))
+            {
+                isScheduled = true;
+            }
+        }
+    }
+
+    return isScheduled;
+}
+
+uint8_t DisplayMgr::nextEnabledSlot(uint8_t slotId)
+{
+    uint8_t count = 0U;
+
+    if (m_maxSlots <= slotId)
+    {
+        slotId = 0U;
+    }
+    else
+    {
+        ++slotId;
+        slotId %= m_maxSlots;
+    }
+
+    /* Set next slot active, precondition is a installed plugin which is enabled.  */
+    do
+    {
+        /* Plugin installed? */
+        if (false == m_slots[slotId].isEmpty())
+        {
+            /* Plugin enabled? */
+            if (true == m_slots[slotId].getPlugin()->isEnabled())
+            {
+                break;
+            }
+        }
 
-    if (m_maxSlots <= slotId)
-    {
-        slotId = 0U;
-    }
-    else
-    {
         ++slotId;
         slotId %= m_maxSlots;
+
+        ++count;
+    }
+    while (m_maxSlots > count);
+
+    if (m_maxSlots <= count)
+    {
+        slotId = SLOT_ID_INVALID;
+    }
+
+    return slotId;
+}
+
+void DisplayMgr::startFadeOut()
+{
+    /* Select next framebuffer and keep old content, until
+     * the fade effect is finished.
+     */
+    if (m_currCanvas == m_framebuffers[FB_ID_0])
+    {
+        m_currCanvas = m_framebuffers[FB_ID_1];
+    }
+    else
+    {
+        m_currCanvas = m_framebuffers[FB_ID_0];
+    }
+
+    m_displayFadeState = FADE_OUT;
+
+    if (nullptr != m_fadeEffect)
+    {
+        m_fadeEffect->init();
+    }
+}
+
+void DisplayMgr::preempt()
+{
+    /* The requested plugin is already selected, only the fade effect is
+     * aborted.
+     */
+    if (m_requestedPlugin == m_selectedPlugin)
+    {
+        m_requestedPlugin       = nullptr;
+        m_requestedPriority     = PRIORITY_NORMAL;
+        m_isPreemptionMeasured  = true;
+    }
+    else if (nullptr != m_selectedPlugin)
+    {
+        /* Remember the interrupted slot to resume it later. If its duration
+         * is already over, the rotation continues with the next slot.
+         * A interrupted urgent slot is not resumed, only the first
+         * interrupted one.
+         */
+        if (SLOT_ID_INVALID == m_resumeSlot)
+        {
+            if (false == m_slotTimer.isTimerRunning())
+            {
+                m_resumeSlot        = m_selectedSlot;
+                m_resumeDuration    = 0U;
+            }
+            else if (false == m_slotTimer.isTimeout())
+            {
+                m_resumeSlot        = m_selectedSlot;
+                m_resumeDuration    = m_slotTimer.getRemaining();
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        m_selectedPlugin->inactive();
+        m_selectedPlugin = nullptr;
+        m_slotTimer.stop();
+    }
+    else
+    {
+        ;
+    }
+
+    /* Abort the fade effect. The current framebuffer is shown completely
+     * with the next update.
+     */
+    m_displayFadeState = FADE_IDLE;
+
+    if (nullptr != m_currCanvas)
+    {
+        m_currCanvas->markDirty();
+    }
+
+    return;
+}
+
+void DisplayMgr::measurePreemption()
+{
+    const uint32_t LATENCY = MonoTime::getMillis() - m_preemptionTimestamp;
+
+    lock();
+
+    ++m_statistics.preemptions;
+    m_statistics.preemptionLatency = LATENCY;
+
+    if (m_statistics.maxPreemptionLatency < LATENCY)
+    {
+        m_statistics.maxPreemptionLatency = LATENCY;
+    }
+
+    m_isPreemptionMeasured = false;
+
+    unlock();
+
+    gMetricPreemptionLatency.observe(LATENCY);
+
+    if (PREEMPTION_LATENCY_BUDGET < LATENCY)
+    {
+        LOG_WARNING_DEFERRED("Urgent request shown after %u ms.", LATENCY);
+    }
+
+    return;
+}
+
+void DisplayMgr::checkBudget(uint8_t slotId, uint32_t cycles)
+{
+    const uint32_t          CPU_FREQ_MHZ    = ESP.getCpuFreqMHz();
+    const uint32_t          BUDGET          = (m_framePeriod * 1000U * PLUGIN_CPU_BUDGET) / 100U;
+    Slot&                   slot            = m_slots[slotId];
+    IPluginMaintenance*     plugin          = slot.getPlugin();
+    BudgetWatchdog&         watchdog        = slot.getWatchdog();
+    uint8_t                 throttle        = watchdog.getThrottle();
+    BudgetWatchdog::Level   level           = watchdog.getLevel();
+
+    if ((nullptr != plugin) &&
+        (0U < CPU_FREQ_MHZ) &&
+        (BudgetWatchdog::LEVEL_EXCEEDED != level))
+    {
+        level = watchdog.addSample(cycles / CPU_FREQ_MHZ, BUDGET);
+
+        if (BudgetWatchdog::LEVEL_EXCEEDED == level)
+        {
+            String msg = "Plugin ";
+
+            msg += plugin->getName();
+            msg += " disabled: CPU budget exceeded.";
+
+            /* The selected plugin is faded out, after it was disabled. */
+            plugin->disable();
+            gMetricPluginBudgetDisables.inc();
+            SysMsg::getInstance().show(msg, BUDGET_MSG_DURATION, BUDGET_MSG_MAX);
+
+            LOG_WARNING_DEFERRED("Plugin %s (uid %u) disabled, because it exceeds its CPU budget.", plugin->getName(), plugin->getUID());
+        }
+        else if (throttle < watchdog.getThrottle())
+        {
+            gMetricPluginThrottles.inc();
+
+            LOG_WARNING_DEFERRED("Plugin %s (uid %u) exceeds its CPU budget, throttled to %u ms.", plugin->getName(), plugin->getUID(), watchdog.getMinPeriod());
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::fadeInOut(IGfx& dst)
+{
+    if ((nullptr != m_currCanvas) &&
+        (nullptr != m_fadeEffect))
+    {
+        Canvas* prevFb = nullptr;
+
+        /* Determine previous frame buffer */
+        if (m_currCanvas == m_framebuffers[FB_ID_0])
+        {
+            prevFb = m_framebuffers[FB_ID_1];
+        }
+        else
+        {
+            prevFb = m_framebuffers[FB_ID_0];
+        }
+
+        /* Continously update the current canvas with its framebuffer,
+         * unless the plugin declares no change. The canvas keeps its content.
+         */
+        if ((nullptr != m_selectedPlugin) &&
+            (IPluginMaintenance::UPDATE_ALWAYS == m_timeToNextUpdate))
+        {
+            uint32_t cycles = ESP.getCycleCount();
+
+            m_selectedPlugin->update(*m_currCanvas);
+
+            cycles = ESP.getCycleCount() - cycles;
+            m_slots[m_selectedSlot].getProfile().update.addSample(cycles);
+            checkBudget(m_selectedSlot, cycles);
+        }
+
+        /* Handle fading */
+        switch(m_displayFadeState)
+        {
+        /* No fading at all */
+        case FADE_IDLE:
+            m_currCanvas->updateFromBuffer(dst);
+            break;
+
+        /* Fade new display content in */
+        case FADE_IN:
+            {
+                uint32_t    cycles      = ESP.getCycleCount();
+                bool        isComplete  = m_fadeEffect->fadeIn(dst, *prevFb, *m_currCanvas);
+
+                m_fadeProfile.addSample(ESP.getCycleCount() - cycles);
+
+                if (true == isComplete)
+                {
+                    m_displayFadeState = FADE_IDLE;
+                }
+            }
+            break;
+
+        /* Fade old display content out! */
+        case FADE_OUT:
+            {
+                uint32_t    cycles      = ESP.getCycleCount();
+                bool        isComplete  = m_fadeEffect->fadeOut(dst, *prevFb, *m_currCanvas);
+
+                m_fadeProfile.addSample(ESP.getCycleCount() - cycles);
+
+                if (true == isComplete)
+                {
+                    m_displayFadeState = FADE_IN;
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::process()
+{
+    LedMatrix&  matrix              = LedMatrix::getInstance();
+    uint8_t     index               = 0U;
+    bool        isFrameChanged      = false;
+    uint32_t    timestamp           = 0U;
+    uint32_t    requestedBrightness = BRIGHTNESS_REQUEST_NONE;
+
+    lock();
+
+    /* Handle display brightness. The request is taken atomically, so a
+     * concurrent request is never lost.
+     */
+    requestedBrightness = __sync_lock_test_and_set(&m_requestedBrightness, BRIGHTNESS_REQUEST_NONE);
+
+    if (BRIGHTNESS_REQUEST_NONE != requestedBrightness)
+    {
+        BrightnessCtrl::getInstance().setBrightness(static_cast<uint8_t>(requestedBrightness));
+    }
+
+    BrightnessCtrl::getInstance().process();
+
+    /* A slave of a display group switches the slots together with the master. */
+    followSyncSlot();
+
+    /* Urgent plugin requested? It doesn't wait for the fade effect. */
+    if ((nullptr != m_requestedPlugin) &&
+        (PRIORITY_URGENT == m_requestedPriority) &&
+        (true == m_requestedPlugin->isEnabled()))
+    {
+        preempt();
+    }
+
+    /* Plugin requested to choose? */
+    if (nullptr != m_requestedPlugin)
+    {
+        /* Requested plugin must be enabled, otherwise it won't be scheduled. */
+        if (false == m_requestedPlugin->isEnabled())
+        {
+            LOG_WARNING("Requested plugin %s (uid %u) in slot %u is disabled.",
+                m_requestedPlugin->getName(),
+                m_requestedPlugin->getUID(),
+                getSlotIdByPluginUID(m_requestedPlugin->getUID()));
+            m_requestedPlugin = nullptr;
+        }
+        /* Requested plugin is enabled. Is currently a plugin selected? */
+        else if (nullptr != m_selectedPlugin)
+        {
+            /* If the selected plugin is the same as the requested plugin,
+             * keep it to avoid a fade in/out sequence. But restart the
+             * slot duration timer, because the duration may have changed.
+             */
+            if (m_requestedPlugin == m_selectedPlugin)
+            {
+                uint32_t duration = m_slots[m_selectedSlot].getDuration();
+
+                m_requestedPlugin       = nullptr;
+                m_isPrepareRequested    = false;
+
+                /* If plugin shall not be infinite active, start the slot timer. */
+                if (0U == duration)
+                {
+                    m_slotTimer.stop();
+                }
+                else
+                {
+                    m_slotTimer.start(duration);
+                }
+            }
+            else
+            {
+                /* Remove selected plugin, which forces to select the requested one in the next step. */
+                m_selectedPlugin->inactive();
+                m_selectedPlugin = nullptr;
+
+                /* Fade old display content out */
+                startFadeOut();
+            }
+        }
+        else
+        {
+            /* Nothing to do. */
+            ;
+        }
+    }
+
+    /* Any plugin selected? */
+    if ((nullptr != m_selectedPlugin) &&
+        (FADE_IDLE == m_displayFadeState))
+    {
+        m_selectedSlot = getSlotIdByPluginUID(m_selectedPlugin->getUID());
+
+        /* Plugin disabled in the meantime? */
+        if (false == m_selectedPlugin->isEnabled())
+        {
+            m_selectedPlugin->inactive();
+            m_selectedPlugin = nullptr;
+            m_slotTimer.stop();
+
+            /* Fade old display content out */
+            startFadeOut();
+        }
+        /* Plugin run duration timeout? A slave of a display group doesn't
+         * switch by itself and the master switches on the announced frame.
+         */
+        else if ((true == m_slotTimer.isTimerRunning()) &&
+                 (true == m_slotTimer.isTimeout()) &&
+                 (false == DisplaySync::getInstance().isFollowing()) &&
+                 (true == DisplaySync::getInstance().isSwitchDue()))
+        {
+            uint8_t planIndex   = m_planIndex;
+            uint8_t slotId      = nextSlot(planIndex);
+
+            /* If the next slot is the same as the current slot,
+             * just restart the plugin duration timer. A interrupted slot
+             * is resumed in any case.
+             */
+            if ((m_selectedSlot == slotId) &&
+                (SLOT_ID_INVALID == m_resumeSlot))
+            {
+                m_planIndex             = planIndex;
+                m_isPrepareRequested    = false;
+
+                if (true == m_slotTimer.isTimerRunning())
+                {
+                    m_slotTimer.restart();
+                }
+            }
+            else
+            {
+                m_selectedPlugin->inactive();
+                m_selectedPlugin = nullptr;
+                m_slotTimer.stop();
+
+                /* Fade old display content out */
+                startFadeOut();
+            }
+        }
+        /* Prepare the plugin of the next slot, before the duration is over. */
+        else
+        {
+            requestPrepare();
+        }
     }
 
-    /* Set next slot active, precondition is a installed plugin which is enabled.  */
-    do
+    /* If no plugin is selected, choose the next on. */
+    if (nullptr == m_selectedPlugin)
     {
-        /* Plugin installed? */
-        if (false == m_slots[slotId].isEmpty())
+        const uint8_t   PREV_SLOT_ID    = m_selectedSlot;
+        bool            isResumed       = false;
+
+        /* Plugin requested to choose? */
+        if (nullptr != m_requestedPlugin)
         {
-            /* Plugin enabled? */
-            if (true == m_slots[slotId].getPlugin()->isEnabled())
+            m_selectedSlot      = getSlotIdByPluginUID(m_requestedPlugin->getUID());
+            m_requestedPlugin   = nullptr;
+
+            if (PRIORITY_URGENT == m_requestedPriority)
+            {
+                m_isPreemptionMeasured = true;
+            }
+
+            m_requestedPriority = PRIORITY_NORMAL;
+        }
+        /* Resume the slot, which was interrupted by a urgent request,
+         * as long as it still contains a enabled plugin.
+         */
+        else if ((m_maxSlots > m_resumeSlot) &&
+                 (nullptr != m_slots[m_resumeSlot].getPlugin()) &&
+                 (true == m_slots[m_resumeSlot].getPlugin()->isEnabled()))
+        {
+            m_selectedSlot  = m_resumeSlot;
+            m_resumeSlot    = SLOT_ID_INVALID;
+            isResumed       = true;
+        }
+        /* Select next slot, which contains a enabled plugin. */
+        else
+        {
+            m_resumeSlot    = SLOT_ID_INVALID;
+            m_selectedSlot  = nextSlot(m_planIndex);
+        }
+
+        /* Next enabled plugin found? */
+        if (m_maxSlots > m_selectedSlot)
+        {
+            uint32_t duration   = 0U;
+            uint32_t cycles     = 0U;
+
+            m_selectedPlugin        = m_slots[m_selectedSlot].getPlugin();
+            duration                = (true == isResumed) ? m_resumeDuration : m_slots[m_selectedSlot].getDuration();
+            m_isPrepareRequested    = false;
+
+            /* If plugin shall not be infinite active, start the slot timer. */
+            if (0U != duration)
+            {
+                m_slotTimer.start(duration);
+            }
+
+            cycles = ESP.getCycleCount();
+
+            if (nullptr != m_currCanvas)
+            {
+                m_selectedPlugin->active(*m_currCanvas);
+            }
+            else
+            {
+                m_selectedPlugin->active(matrix);
+            }
+
+            m_slots[m_selectedSlot].getProfile().active.addSample(ESP.getCycleCount() - cycles);
+
+            /* The activated plugin shall draw its first frame at once. */
+            m_slots[m_selectedSlot].restartUpdate();
+
+            /* Show the plugin content immediately, e.g. a realtime stream. */
+            if (false == m_selectedPlugin->isFadeEnabled())
+            {
+                m_displayFadeState = FADE_IDLE;
+            }
+
+            LOG_INFO_DEFERRED("Slot %u (%s) now active.", m_selectedSlot, m_selectedPlugin->getName());
+            CrashTrace::getInstance().add(CrashTrace::TYPE_SLOT, m_selectedSlot, m_selectedPlugin->getUID());
+            gMetricSlotChanges.inc();
+            EventStream::getInstance().notify(EventStream::EVENT_SLOT);
+        }
+        /* No plugin is active, clear the display. */
+        else
+        {
+            if (nullptr != m_currCanvas)
+            {
+                m_currCanvas->fillScreen(ColorDef::BLACK);
+            }
+            matrix.clear();
+
+            if (PREV_SLOT_ID != m_selectedSlot)
+            {
+                EventStream::getInstance().notify(EventStream::EVENT_SLOT);
+            }
+        }
+    }
+
+    /* The master of a display group tells the slaves about its slots. */
+    publishSyncSlot();
+
+    /* Avoid changing to next effect, if the there is a pending slot change. */
+    if ((false != m_fadeEffectUpdate) && (FADE_IDLE == m_displayFadeState))
+    {
+        switch (m_fadeEffectIndex)
+        {
+        case FADE_EFFECT_LINEAR:
+            m_fadeEffect = &m_fadeLinearEffect;
+            break;
+
+        case FADE_EFFECT_MOVE_X:
+            m_fadeEffect = &m_fadeMoveXEffect;
+            break;
+
+        case FADE_EFFECT_MOVE_Y:
+            m_fadeEffect = &m_fadeMoveYEffect;
+            break;
+
+        case FADE_EFFECT_CROSS:
+            m_fadeEffect = &m_fadeCrossEffect;
+            break;
+
+        case FADE_EFFECT_WIPE_X:
+            m_fadeEffect = &m_fadeWipeXEffect;
+            break;
+
+        default:
+            m_fadeEffect = nullptr;
+            m_fadeEffectIndex = FADE_EFFECT_NO;
+            break;
+        }
+
+        m_fadeEffectUpdate = false;
+    }
+    
+    timestamp = MonoTime::getMillis();
+
+    /* Notify the plugins about their timed out event timers. Only timed
+     * out timers cost time here, independent of the number of plugins.
+     * The plugins are notified and processed under the lock, because they
+     * may be uninstalled at any time by other tasks.
+     */
+    TimerService::getInstance().process(timestamp);
+
+    /* Process all installed plugins, whose process period elapsed. */
+    for(index = 0U; index < m_maxSlots; ++index)
+    {
+        IPluginMaintenance* plugin = m_slots[index].getPlugin();
+
+        if ((nullptr != plugin) &&
+            (true == m_slots[index].scheduleProcess(timestamp)))
+        {
+            uint32_t cycles = ESP.getCycleCount();
+
+            plugin->process();
+
+            cycles = ESP.getCycleCount() - cycles;
+            m_slots[index].getProfile().process.addSample(cycles);
+            checkBudget(index, cycles);
+        }
+        /* A plugin, which was disabled by the CPU budget watchdog and is
+         * enabled again by the user, gets a new chance.
+         */
+        else if ((nullptr != plugin) &&
+                 (BudgetWatchdog::LEVEL_EXCEEDED == m_slots[index].getWatchdog().getLevel()) &&
+                 (true == plugin->isEnabled()))
+        {
+            m_slots[index].getWatchdog().reset();
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    /* A plugin, which knows when its content changes next (e.g. a clock),
+     * declares no change in between. Its update is skipped then.
+     * A plugin with seldom changing content declares its update period
+     * instead and is skipped between two periods.
+     */
+    if (nullptr != m_selectedPlugin)
+    {
+        m_timeToNextUpdate = m_selectedPlugin->getTimeToNextUpdate();
+
+        if (IPluginMaintenance::UPDATE_ALWAYS == m_timeToNextUpdate)
+        {
+            m_timeToNextUpdate = m_slots[m_selectedSlot].scheduleUpdate(timestamp);
+        }
+    }
+    else
+    {
+        m_timeToNextUpdate = IPluginMaintenance::UPDATE_ALWAYS;
+    }
+
+    /* Update display (main canvas available) */
+    if (nullptr != m_currCanvas)
+    {
+        fadeInOut(matrix);
+    }
+    /* Update display (main canvas not available) */
+    else if ((nullptr != m_selectedPlugin) &&
+             (IPluginMaintenance::UPDATE_ALWAYS == m_timeToNextUpdate))
+    {
+        uint32_t cycles = ESP.getCycleCount();
+
+        m_selectedPlugin->update(matrix);
+
+        cycles = ESP.getCycleCount() - cycles;
+        m_slots[m_selectedSlot].getProfile().update.addSample(cycles);
+        checkBudget(m_selectedSlot, cycles);
+    }
+    /* No plugin selected. */
+    else
+    {
+        /* Nothing to do. */
+        ;
+    }
+
+    /* The overlays are drawn on top of the display content. If they
+     * uncover or blend the display content, it must be drawn again
+     * completely. The current canvas copies only its changed pixels,
+     * therefore it is marked as completely changed. Without canvas the
+     * plugin draws everything again after it is told so via active().
+     */
+    if (true == m_compositor.draw(matrix))
+    {
+        if (nullptr != m_currCanvas)
+        {
+            m_currCanvas->markDirty();
+        }
+        else if (nullptr != m_selectedPlugin)
+        {
+            matrix.clear();
+            m_selectedPlugin->active(matrix);
+            m_slots[m_selectedSlot].restartUpdate();
+        }
+        else
+        {
+            matrix.clear();
+        }
+    }
+
+    /* Static content (e.g. a clock between two minutes) leaves the
+     * framebuffer untouched, which makes a physical update unnecessary.
+     */
+    isFrameChanged = matrix.isDirty();
+
+    /* Record every changed frame, while a recording is in progress. */
+    if ((true == isFrameChanged) &&
+        (true == FrameRecorder::getInstance().isRecording()))
+    {
+        FrameRecorder::getInstance().record();
+    }
+
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+    updateIdleState(isFrameChanged);
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
+    /* Poll request expired? */
+    if ((true == m_isFrameRequested) &&
+        (FRAME_REQUEST_TIMEOUT <= (MonoTime::getMillis() - m_frameRequestTimestamp)))
+    {
+        m_isFrameRequested = false;
+    }
+
+    /* Publish the frame only, if there is any consumer. */
+    if ((0U == m_frameSubscribers) &&
+        (false == m_isFrameRequested))
+    {
+        m_isFramePublished = false;
+    }
+    else if ((true == isFrameChanged) ||
+             (false == m_isFramePublished))
+    {
+        publishFrame();
+        m_isFramePublished = true;
+    }
+    else
+    {
+        ;
+    }
+
+    unlock();
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+
+    /* Hand the frame over to the output task, which outputs it while the
+     * next frame is rendered. While dithering or ramping the brightness,
+     * every frame is output, because it differs from the previous one.
+     */
+    if ((true == isFrameChanged) ||
+        (true == matrix.isDithering()) ||
+        (true == matrix.isRamping()))
+    {
+        (void)xSemaphoreGive(m_xFrameReady);
+    }
+    /* Nothing to output, the LED matrix framebuffer is free immediately. */
+    else
+    {
+        (void)xSemaphoreGive(m_xFrameFree);
+    }
+
+#else   /* (0 != DISPLAY_MGR_PIPELINED) */
+
+    /* The physical update doesn't need the lock, because the LED matrix
+     * is only written by the display task. While dithering or ramping the
+     * brightness, every frame is output, because it differs from the
+     * previous one.
+     */
+    if ((true == isFrameChanged) ||
+        (true == matrix.isDithering()) ||
+        (true == matrix.isRamping()))
+    {
+        /* No output during a flash access. */
+        (void)xSemaphoreTake(m_xOutputGate, portMAX_DELAY);
+        matrix.show();
+        (void)xSemaphoreGive(m_xOutputGate);
+    }
+
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+    if (true == m_isPreemptionMeasured)
+    {
+        measurePreemption();
+    }
+
+    return;
+}
+
+void DisplayMgr::publishFrame()
+{
+    /* Odd sequence number: Frame update in progress. */
+    ++m_publishedFrameSeq;
+    __sync_synchronize();
+
+    LedMatrix::getInstance().getFrame(m_publishedFrame, FRAME_PIXEL_COUNT);
+
+    m_publishedSlotId = m_selectedSlot;
+
+    /* Even sequence number: Frame update finished. */
+    __sync_synchronize();
+    ++m_publishedFrameSeq;
+
+    return;
+}
+
+void DisplayMgr::updateTask(void* parameters)
+{
+    DisplayMgr* displayMgr = reinterpret_cast<DisplayMgr*>(parameters);
+
+    if ((nullptr != displayMgr) &&
+        (nullptr != displayMgr->m_xSemaphore))
+    {
+        const TickType_t    FRAME_PERIOD    = pdMS_TO_TICKS(displayMgr->m_framePeriod);
+        const uint64_t      TICK_PERIOD_US  = portTICK_PERIOD_MS * 1000U;
+        const uint64_t      FRAME_PERIOD_US = FRAME_PERIOD * TICK_PERIOD_US;
+        TickType_t          lastWakeTime    = 0U;
+        uint64_t            frameStart      = 0U;
+
+        (void)xSemaphoreTake(displayMgr->m_xSemaphore, portMAX_DELAY);
+
+        /* The frame grid is kept in ticks for the task delay and in us
+         * for the frame time measurement, which needs a higher resolution.
+         */
+        lastWakeTime    = xTaskGetTickCount();
+        frameStart      = MonoTime::getMicros();
+
+        while(false == displayMgr->m_taskExit)
+        {
+            uint64_t    now             = 0U;
+            uint64_t    frameTime       = 0U;
+            uint32_t    skippedFrames   = 0U;
+            int32_t     correction      = 0;
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+
+            /* Wait until the output task took over the previous frame,
+             * before the LED matrix framebuffer is written again.
+             */
+            (void)xSemaphoreTake(displayMgr->m_xFrameFree, portMAX_DELAY);
+
+            /* Refresh display content periodically */
+            displayMgr->process();
+
+#else   /* (0 != DISPLAY_MGR_PIPELINED) */
+
+            /* Max. time needed to load the data into the pixels.
+             * Only a 1 ms tolerance is added, which should be enough.
+             */
+            const uint32_t  MAX_LOOP_TIME   = Board::LedMatrix::matrixLoadTime + 1U; /* ms */
+
+            /* Refresh display content periodically */
+            displayMgr->process();
+
+            /* Wait until the physical update is ready to avoid flickering
+             * and artifacts on the display, because of e.g. webserver flash
+             * access. The task is blocked meanwhile, so the CPU is free for
+             * other tasks. In cooperative mode this is the time, where the
+             * network stack on the shared core catches up.
+             */
+            if (false == LedMatrix::getInstance().waitUntilReady(MAX_LOOP_TIME))
+            {
+                LOG_WARNING_DEFERRED("LED matrix update timeout.");
+            }
+
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+            /* The frame time is measured from the frame start on the fixed
+             * frame grid, so the time to process the frame is included.
+             */
+            now         = MonoTime::getMicros();
+            frameTime   = (now > frameStart) ? (now - frameStart) : 0U;
+
+            /* Deadline missed? Skip the frames, which can't be processed in
+             * time anymore, instead of processing them in a burst afterwards.
+             * This keeps the next frame aligned to the frame grid.
+             */
+            if (FRAME_PERIOD_US <= frameTime)
+            {
+                const uint64_t FRAME_TIME_MS = frameTime / 1000U;
+
+                skippedFrames   = static_cast<uint32_t>(frameTime / FRAME_PERIOD_US);
+                lastWakeTime   += skippedFrames * FRAME_PERIOD;
+                frameStart     += skippedFrames * FRAME_PERIOD_US;
+
+                /* Consecutive misses are coalesced, otherwise an overloaded
+                 * system would flood the crash trace.
+                 */
+                CrashTrace::getInstance().addRepeated(  CrashTrace::TYPE_FRAME,
+                                                        static_cast<uint16_t>((UINT16_MAX < FRAME_TIME_MS) ? UINT16_MAX : FRAME_TIME_MS));
+            }
+
+            displayMgr->updateStatistics((UINT32_MAX < frameTime) ? UINT32_MAX : static_cast<uint32_t>(frameTime), skippedFrames);
+
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+
+            /* Static display content? Sleep until the next possible change,
+             * instead of processing every frame. Other tasks wake the display
+             * task up earlier, if they change anything via the display manager.
+             */
+            if (true == displayMgr->m_isIdle)
             {
-                break;
+                (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(displayMgr->m_idlePeriod));
+                lastWakeTime    = xTaskGetTickCount();
+                frameStart      = MonoTime::getMicros();
+            }
+            else
+            {
+                /* Align the frame grid to the clock of the display group. */
+                correction      = DisplaySync::getInstance().getFrameCorrection(lastWakeTime + FRAME_PERIOD, displayMgr->m_framePeriod);
+                lastWakeTime   += correction;
+                frameStart     += FRAME_PERIOD_US + static_cast<int64_t>(correction) * TICK_PERIOD_US;
+                vTaskDelayUntil(&lastWakeTime, FRAME_PERIOD);
             }
+
+#else   /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
+            /* Align the frame grid to the clock of the display group. */
+            correction      = DisplaySync::getInstance().getFrameCorrection(lastWakeTime + FRAME_PERIOD, displayMgr->m_framePeriod);
+            lastWakeTime   += correction;
+            frameStart     += FRAME_PERIOD_US + static_cast<int64_t>(correction) * TICK_PERIOD_US;
+            vTaskDelayUntil(&lastWakeTime, FRAME_PERIOD);
+
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
         }
 
-        ++slotId;
-        slotId %= m_maxSlots;
+        (void)xSemaphoreGive(displayMgr->m_xSemaphore);
+    }
 
-        ++count;
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+
+bool DisplayMgr::startOutputTask()
+{
+    bool status = false;
+
+    /* Create binary semaphore to signal task exit. */
+    m_xOutputSemaphore = xSemaphoreCreateBinary();
+
+    /* Create binary semaphores for the frame handover. */
+    m_xFrameReady   = xSemaphoreCreateBinary();
+    m_xFrameFree    = xSemaphoreCreateBinary();
+
+    if ((nullptr != m_xOutputSemaphore) &&
+        (nullptr != m_xFrameReady) &&
+        (nullptr != m_xFrameFree))
+    {
+        BaseType_t osRet = pdFAIL;
+
+        /* Task shall run */
+        m_outputTaskExit = false;
+
+        /* The LED matrix framebuffer is free for the first frame. */
+        (void)xSemaphoreGive(m_xFrameFree);
+
+        osRet = xTaskCreateUniversal(   outputTask,
+                                        "displayOutTask",
+                                        OUTPUT_TASK_STACK_SIZE,
+                                        this,
+                                        OUTPUT_TASK_PRIORITY,
+                                        &m_outputTaskHandle,
+                                        OUTPUT_TASK_RUN_CORE);
+
+        /* Task successful created? */
+        if (pdPASS == osRet)
+        {
+            (void)xSemaphoreGive(m_xOutputSemaphore);
+            status = true;
+        }
     }
-    while (m_maxSlots > count);
 
-    if (m_maxSlots <= count)
+    if (false == status)
     {
-        slotId = SLOT_ID_INVALID;
+        stopOutputTask();
     }
 
-    return slotId;
+    return status;
 }
 
-void DisplayMgr::startFadeOut()
+void DisplayMgr::stopOutputTask()
 {
-    /* Select next framebuffer and keep old content, until
-     * the fade effect is finished.
-     */
-    if (m_currCanvas == m_framebuffers[FB_ID_0])
+    /* Already running? */
+    if (nullptr != m_outputTaskHandle)
     {
-        m_currCanvas = m_framebuffers[FB_ID_1];
+        m_outputTaskExit = true;
+
+        /* Join */
+        (void)xSemaphoreTake(m_xOutputSemaphore, portMAX_DELAY);
+        m_outputTaskHandle = nullptr;
     }
-    else
+
+    if (nullptr != m_xOutputSemaphore)
     {
-        m_currCanvas = m_framebuffers[FB_ID_0];
+        vSemaphoreDelete(m_xOutputSemaphore);
+        m_xOutputSemaphore = nullptr;
     }
 
-    m_displayFadeState = FADE_OUT;
+    if (nullptr != m_xFrameReady)
+    {
+        vSemaphoreDelete(m_xFrameReady);
+        m_xFrameReady = nullptr;
+    }
 
-    if (nullptr != m_fadeEffect)
+    if (nullptr != m_xFrameFree)
     {
-        m_fadeEffect->init();
+        vSemaphoreDelete(m_xFrameFree);
+        m_xFrameFree = nullptr;
     }
+
+    return;
 }
 
-void DisplayMgr::fadeInOut(IGfx& dst)
+void DisplayMgr::outputTask(void* parameters)
 {
-    if ((nullptr != m_currCanvas) &&
-        (nullptr != m_fadeEffect))
+    DisplayMgr* displayMgr = reinterpret_cast<DisplayMgr*>(parameters);
+
+    if ((nullptr != displayMgr) &&
+        (nullptr != displayMgr->m_xOutputSemaphore))
     {
-        Canvas* prevFb = nullptr;
+        /* The frame handover is waited with timeout, to be able to exit the task. */
+        const TickType_t    WAIT_TIME       = pdMS_TO_TICKS(displayMgr->m_framePeriod);
 
-        /* Determine previous frame buffer */
-        if (m_currCanvas == m_framebuffers[FB_ID_0])
-        {
-            prevFb = m_framebuffers[FB_ID_1];
-        }
-        else
-        {
-            prevFb = m_framebuffers[FB_ID_0];
-        }
+        /* Max. time needed to load the data into the pixels.
+         * Only a 1 ms tolerance is added, which should be enough.
+         */
+        const uint32_t      MAX_LOOP_TIME   = Board::LedMatrix::matrixLoadTime + 1U; /* ms */
+        LedMatrix&          matrix          = LedMatrix::getInstance();
 
-        /* Continously update the current canvas with its framebuffer. */
-        if (nullptr != m_selectedPlugin)
-        {
-            m_selectedPlugin->update(*m_currCanvas);
-        }
+        (void)xSemaphoreTake(displayMgr->m_xOutputSemaphore, portMAX_DELAY);
 
-        /* Handle fading */
-        switch(m_displayFadeState)
+        while(false == displayMgr->m_outputTaskExit)
         {
-        /* No fading at all */
-        case FADE_IDLE:
-            m_currCanvas->updateFromBuffer(dst);
-            break;
-
-        /* Fade new display content in */
-        case FADE_IN:
-            if (true == m_fadeEffect->fadeIn(dst, *prevFb, *m_currCanvas))
-            {
-                m_displayFadeState = FADE_IDLE;
-            }
-            break;
-
-        /* Fade old display content out! */
-        case FADE_OUT:
-            if (true == m_fadeEffect->fadeOut(dst, *prevFb, *m_currCanvas))
+            if (pdTRUE == xSemaphoreTake(displayMgr->m_xFrameReady, WAIT_TIME))
             {
-                m_displayFadeState = FADE_IN;
+                /* No output during a flash access. */
+                (void)xSemaphoreTake(displayMgr->m_xOutputGate, portMAX_DELAY);
+                matrix.show();
+                (void)xSemaphoreGive(displayMgr->m_xOutputGate);
+
+                /* The frame is copied to the LED strips, therefore the display
+                 * task can render the next frame during the transmission.
+                 */
+                (void)xSemaphoreGive(displayMgr->m_xFrameFree);
+
+                /* Wait until the physical update is ready to avoid flickering
+                 * and artifacts on the display, because of e.g. webserver flash
+                 * access. The task is blocked meanwhile, so the CPU is free for
+                 * other tasks.
+                 */
+                if (false == matrix.waitUntilReady(MAX_LOOP_TIME))
+                {
+                    LOG_WARNING_DEFERRED("LED matrix update timeout.");
+                }
             }
-            break;
-
-        default:
-            break;
         }
+
+        (void)xSemaphoreGive(displayMgr->m_xOutputSemaphore);
     }
 
+    vTaskDelete(nullptr);
+
     return;
 }
 
-void DisplayMgr::process()
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+bool DisplayMgr::startPrepareTask()
 {
-    LedMatrix&  matrix  = LedMatrix::getInstance();
-    uint8_t     index   = 0U;
+    bool status = false;
 
-    lock();
+    /* Create binary semaphore to signal task exit. */
+    m_xPrepareSemaphore = xSemaphoreCreateBinary();
 
-    /* Handle display brightness */
-    BrightnessCtrl::getInstance().process();
+    /* Create binary semaphore for the prepare request and the mutex to wait for a running preparation. */
+    m_xPrepareRequest   = xSemaphoreCreateBinary();
+    m_xPrepareMutex     = xSemaphoreCreateMutex();
 
-    /* Plugin requested to choose? */
-    if (nullptr != m_requestedPlugin)
+    if ((nullptr != m_xPrepareSemaphore) &&
+        (nullptr != m_xPrepareRequest) &&
+        (nullptr != m_xPrepareMutex))
     {
-        /* Requested plugin must be enabled, otherwise it won't be scheduled. */
-        if (false == m_requestedPlugin->isEnabled())
-        {
-            LOG_WARNING("Requested plugin %s (uid %u) in slot %u is disabled.",
-                m_requestedPlugin->getName(),
-                m_requestedPlugin->getUID(),
-                getSlotIdByPluginUID(m_requestedPlugin->getUID()));
-            m_requestedPlugin = nullptr;
-        }
-        /* Requested plugin is enabled. Is currently a plugin selected? */
-        else if (nullptr != m_selectedPlugin)
-        {
-            /* If the selected plugin is the same as the requested plugin,
-             * keep it to avoid a fade in/out sequence. But restart the
-             * slot duration timer, because the duration may have changed.
-             */
-            if (m_requestedPlugin == m_selectedPlugin)
-            {
-                uint32_t duration = m_slots[m_selectedSlot].getDuration();
+        BaseType_t osRet = pdFAIL;
 
-                m_requestedPlugin = nullptr;
+        /* Task shall run */
+        m_prepareTaskExit = false;
 
-                /* If plugin shall not be infinite active, start the slot timer. */
-                if (0U == duration)
-                {
-                    m_slotTimer.stop();
-                }
-                else
-                {
-                    m_slotTimer.start(duration);
-                }
-            }
-            else
-            {
-                /* Remove selected plugin, which forces to select the requested one in the next step. */
-                m_selectedPlugin->inactive();
-                m_selectedPlugin = nullptr;
+        osRet = xTaskCreateUniversal(   prepareTask,
+                                        "displayPrepTask",
+                                        PREPARE_TASK_STACK_SIZE,
+                                        this,
+                                        PREPARE_TASK_PRIORITY,
+                                        &m_prepareTaskHandle,
+                                        PREPARE_TASK_RUN_CORE);
 
-                /* Fade old display content out */
-                startFadeOut();
-            }
-        }
-        else
+        /* Task successful created? */
+        if (pdPASS == osRet)
         {
-            /* Nothing to do. */
-            ;
+            (void)xSemaphoreGive(m_xPrepareSemaphore);
+            status = true;
         }
     }
 
-    /* Any plugin selected? */
-    if ((nullptr != m_selectedPlugin) &&
-        (FADE_IDLE == m_displayFadeState))
+    if (false == status)
     {
-        m_selectedSlot = getSlotIdByPluginUID(m_selectedPlugin->getUID());
+        stopPrepareTask();
+    }
 
-        /* Plugin disabled in the meantime? */
-        if (false == m_selectedPlugin->isEnabled())
-        {
-            m_selectedPlugin->inactive();
-            m_selectedPlugin = nullptr;
-            m_slotTimer.stop();
+    return status;
+}
 
-            /* Fade old display content out */
-            startFadeOut();
-        }
-        /* Plugin run duration timeout? */
-        else if ((true == m_slotTimer.isTimerRunning()) &&
-                 (true == m_slotTimer.isTimeout()))
-        {
-            uint8_t slotId = nextSlot(m_selectedSlot);
+void DisplayMgr::stopPrepareTask()
+{
+    /* Already running? */
+    if (nullptr != m_prepareTaskHandle)
+    {
+        m_prepareTaskExit = true;
 
-            /* If the next slot is the same as the current slot,
-             * just restart the plugin duration timer.
-             */
-            if (m_selectedSlot == slotId)
-            {
-                if (true == m_slotTimer.isTimerRunning())
-                {
-                    m_slotTimer.restart();
-                }
-            }
-            else
-            {
-                m_selectedPlugin->inactive();
-                m_selectedPlugin = nullptr;
-                m_slotTimer.stop();
+        /* Join */
+        (void)xSemaphoreTake(m_xPrepareSemaphore, portMAX_DELAY);
+        m_prepareTaskHandle = nullptr;
+    }
 
-                /* Fade old display content out */
-                startFadeOut();
-            }
-        }
-        else
-        {
-            /* Nothing to do. */
-            ;
-        }
+    if (nullptr != m_xPrepareSemaphore)
+    {
+        vSemaphoreDelete(m_xPrepareSemaphore);
+        m_xPrepareSemaphore = nullptr;
     }
 
-    /* If no plugin is selected, choose the next on. */
-    if (nullptr == m_selectedPlugin)
+    if (nullptr != m_xPrepareRequest)
     {
-        /* Plugin requested to choose? */
-        if (nullptr != m_requestedPlugin)
-        {
-            m_selectedSlot      = getSlotIdByPluginUID(m_requestedPlugin->getUID());
-            m_requestedPlugin   = nullptr;
-        }
-        /* Select next slot, which contains a enabled plugin. */
-        else
+        vSemaphoreDelete(m_xPrepareRequest);
+        m_xPrepareRequest = nullptr;
+    }
+
+    if (nullptr != m_xPrepareMutex)
+    {
+        vSemaphoreDelete(m_xPrepareMutex);
+        m_xPrepareMutex = nullptr;
+    }
+
+    m_preparePlugin = nullptr;
+
+    return;
+}
+
+void DisplayMgr::requestPrepare()
+{
+    if ((nullptr != m_prepareTaskHandle) &&
+        (false == m_isPrepareRequested) &&
+        (true == m_slotTimer.isTimerRunning()) &&
+        (PREPARE_LEAD_TIME >= m_slotTimer.getRemaining()))
+    {
+        /* Work on a copy of the plan index, because the slot change
+         * itself will determine the next slot again.
+         */
+        uint8_t planIndex   = m_planIndex;
+        uint8_t slotId      = nextSlot(planIndex);
+
+        if ((m_maxSlots > slotId) &&
+            (m_selectedSlot != slotId))
         {
-            m_selectedSlot = nextSlot(m_selectedSlot);
+            m_preparePlugin = m_slots[slotId].getPlugin();
+            (void)xSemaphoreGive(m_xPrepareRequest);
         }
 
-        /* Next enabled plugin found? */
-        if (m_maxSlots > m_selectedSlot)
-        {
-            uint32_t duration = 0U;
+        m_isPrepareRequested = true;
+    }
 
-            m_selectedPlugin    = m_slots[m_selectedSlot].getPlugin();
-            duration            = m_slots[m_selectedSlot].getDuration();
+    return;
+}
 
-            /* If plugin shall not be infinite active, start the slot timer. */
-            if (0U != duration)
-            {
-                m_slotTimer.start(duration);
-            }
+void DisplayMgr::followSyncSlot()
+{
+    DisplaySync& sync = DisplaySync::getInstance();
 
-            if (nullptr != m_currCanvas)
+    if ((nullptr == m_requestedPlugin) &&
+        (true == sync.isFollowing()))
+    {
+        uint8_t slotId = sync.getSlot();
+
+        if ((m_maxSlots > slotId) &&
+            (m_selectedSlot != slotId))
+        {
+            IPluginMaintenance* plugin = m_slots[slotId].getPlugin();
+
+            /* A slot without a enabled plugin keeps the current one. */
+            if ((nullptr != plugin) &&
+                (true == plugin->isEnabled()))
             {
-                m_selectedPlugin->active(*m_currCanvas);
+                m_requestedPlugin = plugin;
             }
-            else
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::publishSyncSlot()
+{
+    DisplaySync& sync = DisplaySync::getInstance();
+
+    if ((DisplaySync::ROLE_MASTER == sync.getRole()) &&
+        (nullptr != m_selectedPlugin) &&
+        (m_maxSlots > m_selectedSlot))
+    {
+        sync.setFramePeriod(m_framePeriod);
+        sync.setSlot(m_selectedSlot);
+
+        /* Announce the slot switch in time, so the slaves switch with the same frame. */
+        if ((true == m_slotTimer.isTimerRunning()) &&
+            (DisplaySync::ANNOUNCE_TIME >= m_slotTimer.getRemaining()) &&
+            (false == sync.isSwitchAnnounced()))
+        {
+            /* Work on a copy of the plan index, because the slot change
+             * itself will determine the next slot again.
+             */
+            uint8_t planIndex   = m_planIndex;
+            uint8_t slotId      = nextSlot(planIndex);
+
+            if ((m_maxSlots > slotId) &&
+                (m_selectedSlot != slotId))
             {
-                m_selectedPlugin->active(matrix);
+                sync.announceSwitch(slotId, m_slotTimer.getRemaining());
             }
+        }
+    }
+
+    return;
+}
+
+void DisplayMgr::prepareTask(void* parameters)
+{
+    DisplayMgr* displayMgr = reinterpret_cast<DisplayMgr*>(parameters);
 
-            LOG_INFO("Slot %u (%s) now active.", m_selectedSlot, m_selectedPlugin->getName());
-        }
-        /* No plugin is active, clear the display. */
-        else
+    if ((nullptr != displayMgr) &&
+        (nullptr != displayMgr->m_xPrepareSemaphore))
+    {
+        /* The prepare request is waited with timeout, to be able to exit the task. */
+        const TickType_t WAIT_TIME = pdMS_TO_TICKS(100U);
+
+        (void)xSemaphoreTake(displayMgr->m_xPrepareSemaphore, portMAX_DELAY);
+
+        while(false == displayMgr->m_prepareTaskExit)
         {
-            if (nullptr != m_currCanvas)
+            if (pdTRUE == xSemaphoreTake(displayMgr->m_xPrepareRequest, WAIT_TIME))
             {
-                m_currCanvas->fillScreen(ColorDef::BLACK);
+                IPluginMaintenance* plugin = nullptr;
+
+                /* As long as the mutex is hold, a uninstalled plugin won't be destroyed. */
+                (void)xSemaphoreTake(displayMgr->m_xPrepareMutex, portMAX_DELAY);
+
+                displayMgr->lock();
+                plugin                      = displayMgr->m_preparePlugin;
+                displayMgr->m_preparePlugin = nullptr;
+                displayMgr->unlock();
+
+                /* The plugin is prepared without display lock, so the display
+                 * task can continue to render the current slot.
+                 */
+                if (nullptr != plugin)
+                {
+                    plugin->prepare();
+                }
+
+                (void)xSemaphoreGive(displayMgr->m_xPrepareMutex);
             }
-            matrix.clear();
         }
+
+        (void)xSemaphoreGive(displayMgr->m_xPrepareSemaphore);
     }
 
-    /* Avoid changing to next effect, if the there is a pending slot change. */
-    if ((false != m_fadeEffectUpdate) && (FADE_IDLE == m_displayFadeState))
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+void DisplayMgr::updateStatistics(uint32_t frameTime, uint32_t skippedFrames)
+{
+    lock();
+
+    ++m_statistics.frames;
+    m_statistics.frameTimeUs    = frameTime;
+    m_statistics.frameTime      = frameTime / 1000U;
+
+    if (m_statistics.maxFrameTimeUs < frameTime)
     {
-        switch (m_fadeEffectIndex)
-        {
-        case FADE_EFFECT_LINEAR:
-            m_fadeEffect = &m_fadeLinearEffect;
-            break;
+        m_statistics.maxFrameTimeUs = frameTime;
+        m_statistics.maxFrameTime   = frameTime / 1000U;
+    }
 
-        case FADE_EFFECT_MOVE_X:
-            m_fadeEffect = &m_fadeMoveXEffect;
-            break;
+    if (0U < skippedFrames)
+    {
+        ++m_statistics.missedDeadlines;
+        m_statistics.skippedFrames += skippedFrames;
+    }
 
-        case FADE_EFFECT_MOVE_Y:
-            m_fadeEffect = &m_fadeMoveYEffect;
-            break;
+    unlock();
 
-        default:
-            m_fadeEffect = nullptr;
-            m_fadeEffectIndex = FADE_EFFECT_NO;
-            break;
-        }
+    /* Metrics are updated lock-free. */
+    gMetricFrameTime.observe(frameTime / 1000U);
 
-        m_fadeEffectUpdate = false;
+    if (0U < skippedFrames)
+    {
+        gMetricSkippedFrames.inc(skippedFrames);
     }
-    
-    /* Process all installed plugins. */
-    for(index = 0U; index < m_maxSlots; ++index)
+
+    return;
+}
+
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+
+void DisplayMgr::updateIdleState(bool isFrameChanged)
+{
+    LedMatrix& matrix = LedMatrix::getInstance();
+
+    /* Any activity on the display leaves the idle mode immediately.
+     * A member of a display group stays on the frame grid all the time.
+     */
+    if ((true == isFrameChanged) ||
+        (FADE_IDLE != m_displayFadeState) ||
+        (true == matrix.isRamping()) ||
+        (nullptr != m_requestedPlugin) ||
+        (DisplaySync::ROLE_OFF != DisplaySync::getInstance().getRole()))
     {
-        IPluginMaintenance* plugin = m_slots[index].getPlugin();
+        m_staticFrames = 0U;
 
-        if (nullptr != plugin)
+        if (true == m_isIdle)
         {
-            plugin->process();
+            m_isIdle = false;
+            matrix.setDithering(true);
+
+#if defined(CONFIG_PM_ENABLE)
+            if (nullptr != gPmLock)
+            {
+                (void)esp_pm_lock_acquire(gPmLock);
+            }
+#endif  /* defined(CONFIG_PM_ENABLE) */
         }
     }
-
-    /* Update display (main canvas available) */
-    if (nullptr != m_currCanvas)
+    /* A plugin, which declares its next change, allows to go idle at once. */
+    else if ((IDLE_FRAMES > m_staticFrames) &&
+             (IPluginMaintenance::UPDATE_ALWAYS == m_timeToNextUpdate))
     {
-        fadeInOut(matrix);
+        ++m_staticFrames;
     }
-    /* Update display (main canvas not available) */
-    else if (nullptr != m_selectedPlugin)
+    /* The content is static since several frames. Without dithering, the
+     * static frame needs no periodic output anymore.
+     */
+    else if (false == m_isIdle)
     {
-        m_selectedPlugin->update(matrix);
+        m_isIdle = true;
+        matrix.setDithering(false);
+
+#if defined(CONFIG_PM_ENABLE)
+        if (nullptr != gPmLock)
+        {
+            (void)esp_pm_lock_release(gPmLock);
+        }
+#endif  /* defined(CONFIG_PM_ENABLE) */
     }
-    /* No plugin selected. */
     else
     {
-        /* Nothing to do. */
         ;
     }
 
-    delay(1U);
-    matrix.show();
-
-    unlock();
-
-    return;
-}
+    /* Wake up latest at the next slot change or the next declared
+     * content change of the plugin.
+     */
+    m_idlePeriod = IDLE_PERIOD;
 
-void DisplayMgr::updateTask(void* parameters)
-{
-    DisplayMgr* displayMgr = reinterpret_cast<DisplayMgr*>(parameters);
+    if ((IPluginMaintenance::UPDATE_ALWAYS != m_timeToNextUpdate) &&
+        (m_timeToNextUpdate < m_idlePeriod))
+    {
+        m_idlePeriod = m_timeToNextUpdate;
+    }
 
-    if ((nullptr != displayMgr) &&
-        (nullptr != displayMgr->m_xSemaphore))
+    if (true == m_slotTimer.isTimerRunning())
     {
-        (void)xSemaphoreTake(displayMgr->m_xSemaphore, portMAX_DELAY);
+        const uint32_t REMAINING = m_slotTimer.getRemaining();
 
-        while(false == displayMgr->m_taskExit)
+        if (REMAINING < m_idlePeriod)
         {
-            uint32_t    timestamp   = 0U;
-            uint32_t    duration    = 0U;
-            bool        abort       = false;
-
-            /* Max. time needed to load the data into the pixels.
-             * Only a 1 ms tolerance is added, which should be enough.
-             */
-            const uint32_t  MAX_LOOP_TIME   = Board::LedMatrix::matrixLoadTime + 1U; /* ms */
+            m_idlePeriod = REMAINING;
+        }
+    }
 
-            /* Refresh display content periodically */
-            displayMgr->process();
+    return;
+}
 
-            /* Wait until the physical update is ready to avoid flickering
-             * and artifacts on the display, because of e.g. webserver flash
-             * access.
-             */
-            timestamp = millis();
-            while((false == LedMatrix::getInstance().isReady()) && (false == abort))
-            {
-                duration = millis() - timestamp;
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
 
-                if (MAX_LOOP_TIME <= duration)
-                {
-                    abort = true;
-                }
-            }
+void DisplayMgr::getProfileSummary(const ProfileStat& profileStat, ProfileStat::Summary& summary)
+{
+    const uint32_t CPU_FREQ_MHZ = ESP.getCpuFreqMHz();
 
-            delay(TASK_PERIOD - duration);
-        }
+    profileStat.getSummary(summary);
 
-        (void)xSemaphoreGive(displayMgr->m_xSemaphore);
+    if (0U < CPU_FREQ_MHZ)
+    {
+        summary.min /= CPU_FREQ_MHZ;
+        summary.avg /= CPU_FREQ_MHZ;
+        summary.max /= CPU_FREQ_MHZ;
+        summary.p99 /= CPU_FREQ_MHZ;
     }
 
-    vTaskDelete(nullptr);
-
     return;
 }
 
@@ -1121,97 +2864,263 @@ void DisplayMgr::unlock()
         (void)xSemaphoreGiveRecursive(m_xMutex);
     }
 
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+    /* Another task may have changed anything, which influences the display
+     * content.
+     */
+    wakeUp();
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
     return;
 }
 
-void DisplayMgr::load()
-{
-    Settings& settings = Settings::getInstance();
+#if (0 != DISPLAY_MGR_IDLE_MODE)
 
-    if (nullptr == m_slots)
-    {
-        LOG_WARNING("No slot exists.");
-    }
-    else if (false == settings.open(true))
+void DisplayMgr::wakeUp()
+{
+    if ((true == m_isIdle) &&
+        (nullptr != m_taskHandle) &&
+        (xTaskGetCurrentTaskHandle() != m_taskHandle))
     {
-        LOG_WARNING("Couldn't open filesystem.");
+        (void)xTaskNotifyGive(m_taskHandle);
     }
-    else
+
+    return;
+}
+
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
+bool DisplayMgr::setSlotPlugin(uint8_t slotId, IPluginMaintenance* plugin)
+{
+    IPluginMaintenance* oldPlugin   = m_slots[slotId].getPlugin();
+    bool                status      = m_slots[slotId].setPlugin(plugin);
+
+    if (true == status)
     {
-        String config = settings.getDisplaySlotConfig().getValue();
+        /* Install, uninstall and move change the slots response. */
+        ResponseCache::getInstance().invalidate(RestApi::URI_DISPLAY_SLOTS);
 
-        if (true == config.isEmpty())
-        {
-            LOG_WARNING("Display slot configuration is empty.");
-        }
-        else
+        /* Remove the old plugin only, if the index still refers to this slot.
+         * During a swap it may already refer to the other slot.
+         */
+        if (nullptr != oldPlugin)
         {
-            const size_t            JSON_DOC_SIZE   = 512U;
-            DynamicJsonDocument     jsonDoc(JSON_DOC_SIZE);
-            DeserializationError    error           = deserializeJson(jsonDoc, config);
+            uint8_t indexedSlotId = SLOT_ID_INVALID;
 
-            if (true == jsonDoc.overflowed())
-            {
-                LOG_ERROR("JSON document has less memory available.");
-            }
-            else
+            if ((true == m_slotIndex.find(oldPlugin->getUID(), indexedSlotId)) &&
+                (slotId == indexedSlotId))
             {
-                LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+                (void)m_slotIndex.remove(oldPlugin->getUID());
             }
+        }
 
-            if (DeserializationError::Ok != error.code())
+        if (nullptr != plugin)
+        {
+            if (false == m_slotIndex.insert(plugin->getUID(), slotId))
             {
-                LOG_WARNING("JSON deserialization failed: %s", error.c_str());
+                LOG_FATAL("Slot index is full.");
             }
-            else if (false == jsonDoc["slots"].is<JsonArray>())
+        }
+    }
+
+    return status;
+}
+
+bool DisplayMgr::resizeSlots(uint8_t maxSlots)
+{
+    bool    status      = false;
+    uint8_t slotId      = 0U;
+    uint8_t freeSlots   = 0U;
+    uint8_t orphans     = 0U;
+
+    /* Every plugin of a removed slot needs a empty unlocked slot in the
+     * remaining ones.
+     */
+    for(slotId = 0U; slotId < m_maxSlots; ++slotId)
+    {
+        if (maxSlots > slotId)
+        {
+            if ((true == m_slots[slotId].isEmpty()) &&
+                (false == m_slots[slotId].isLocked()))
             {
-                LOG_WARNING("Invalid JSON format.");
+                ++freeSlots;
             }
-            else
+        }
+        else if (false == m_slots[slotId].isEmpty())
+        {
+            ++orphans;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    if (freeSlots < orphans)
+    {
+        LOG_WARNING("Not enough empty slots for %u plugins of the removed slots.", orphans);
+    }
+    else
+    {
+        Slot* slots = new Slot[maxSlots];
+
+        if (nullptr == slots)
+        {
+            LOG_ERROR("Out of memory.");
+        }
+        else
+        {
+            uint8_t freeSlotId = 0U;
+
+            /* Slots are migrated in ascending order, therefore all remaining
+             * slots are migrated before the first plugin is relocated. The
+             * settings of a free slot are overwritten by the relocated plugin.
+             */
+            for(slotId = 0U; slotId < m_maxSlots; ++slotId)
             {
-                JsonArray   jsonSlots   = jsonDoc["slots"].as<JsonArray>();
-                uint8_t     slotId      = 0;
+                Slot&               srcSlot     = m_slots[slotId];
+                IPluginMaintenance* plugin      = srcSlot.getPlugin();
+                bool                isLocked    = srcSlot.isLocked();
+                uint8_t             dstSlotId   = slotId;
 
-                for(JsonObject jsonSlot: jsonSlots)
+                if (maxSlots <= slotId)
                 {
-                    if (true == jsonSlot["duration"].is<uint32_t>())
+                    dstSlotId = SLOT_ID_INVALID;
+
+                    if (nullptr != plugin)
                     {
-                        uint32_t duration = jsonSlot["duration"].as<uint32_t>();
+                        while((false == slots[freeSlotId].isEmpty()) ||
+                              (true == slots[freeSlotId].isLocked()))
+                        {
+                            ++freeSlotId;
+                        }
+
+                        dstSlotId = freeSlotId;
+                        ++freeSlotId;
+                    }
+                }
+
+                if (SLOT_ID_INVALID != dstSlotId)
+                {
+                    Slot& dstSlot = slots[dstSlotId];
 
-                        m_slots[slotId].setDuration(duration);
+                    dstSlot.setDuration(srcSlot.getDuration());
+                    dstSlot.setSchedule(srcSlot.getSchedule());
 
-                        ++slotId;
-                        if (DisplayMgr::getInstance().getMaxSlots() <= slotId)
+                    /* The plugin refers to its slot, therefore it is
+                     * removed from the old one first.
+                     */
+                    if (nullptr != plugin)
+                    {
+                        srcSlot.unlock();
+                        (void)srcSlot.setPlugin(nullptr);
+                        (void)dstSlot.setPlugin(plugin);
+
+                        if (false == m_slotIndex.insert(plugin->getUID(), dstSlotId))
                         {
-                            break;
+                            LOG_FATAL("Slot index is full.");
                         }
                     }
+
+                    if (true == isLocked)
+                    {
+                        dstSlot.lock();
+                    }
                 }
             }
-        }
 
-        settings.close();
+            delete[] m_slots;
+            m_slots     = slots;
+            m_maxSlots  = maxSlots;
+
+            /* The rotation starts again with the new plan. A interrupted
+             * slot is not resumed, because it may not exist anymore.
+             */
+            m_isPlanUpdateReq   = true;
+            m_planIndex         = SlotPlan::MAX_LENGTH;
+            m_resumeSlot        = SLOT_ID_INVALID;
+
+            if (nullptr != m_selectedPlugin)
+            {
+                (void)m_slotIndex.find(m_selectedPlugin->getUID(), m_selectedSlot);
+            }
+            else
+            {
+                m_selectedSlot = SLOT_ID_INVALID;
+            }
+
+            status = true;
+        }
     }
+
+    return status;
 }
 
-void DisplayMgr::save()
+void DisplayMgr::load()
 {
-    if (nullptr != m_slots)
+    Settings& settings = Settings::getInstance();
+
+    if (nullptr == m_slots)
+    {
+        LOG_WARNING("No slot exists.");
+    }
+    else if (false == settings.open(true))
+    {
+        LOG_WARNING("Couldn't open filesystem.");
+    }
+    else
     {
-        String              config;
-        uint8_t             slotId      = 0;
-        Settings&           settings    = Settings::getInstance();
-        const size_t        JSON_DOC_SIZE   = 512U;
-        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-        JsonArray           jsonSlots   = jsonDoc.createNestedArray("slots");
+        SlotRecord* records = new SlotRecord[m_maxSlots];
+        uint8_t     num     = 0U;
+        uint8_t     index   = 0U;
 
-        for(slotId = 0; slotId < m_maxSlots; ++slotId)
+        if (nullptr == records)
+        {
+            LOG_ERROR("Out of memory.");
+        }
+        else if (false == readSlotInstallation(records, m_maxSlots, num))
+        {
+            /* Not migrated yet */
+            loadLegacy();
+        }
+        else
         {
-            JsonObject jsonSlot = jsonSlots.createNestedObject();
+            for(index = 0U; index < num; ++index)
+            {
+                if (m_maxSlots > records[index].slotId)
+                {
+                    Slot::Schedule schedule;
 
-            jsonSlot["duration"] = m_slots[slotId].getDuration();
+                    schedule.weight     = records[index].weight;
+                    schedule.timeBegin  = records[index].timeBegin;
+                    schedule.timeEnd    = records[index].timeEnd;
+
+                    m_slots[records[index].slotId].setDuration(records[index].duration);
+                    m_slots[records[index].slotId].setSchedule(schedule);
+                }
+            }
         }
 
+        delete[] records;
+
+        settings.close();
+    }
+}
+
+void DisplayMgr::loadLegacy()
+{
+    String config = Settings::getInstance().getDisplaySlotConfig().getValue();
+
+    if (true == config.isEmpty())
+    {
+        LOG_WARNING("Display slot configuration is empty.");
+    }
+    else
+    {
+        const size_t            JSON_DOC_SIZE   = 512U;
+        DynamicJsonDocument     jsonDoc(JSON_DOC_SIZE);
+        DeserializationError    error           = deserializeJson(jsonDoc, config);
+
         if (true == jsonDoc.overflowed())
         {
             LOG_ERROR("JSON document has less memory available.");
@@ -1221,16 +3130,34 @@ void DisplayMgr::save()
             LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
         }
 
-        if (false == settings.open(false))
+        if (DeserializationError::Ok != error.code())
         {
-            LOG_WARNING("Couldn't open filesystem.");
+            LOG_WARNING("JSON deserialization failed: %s", error.c_str());
+        }
+        else if (false == jsonDoc["slots"].is<JsonArray>())
+        {
+            LOG_WARNING("Invalid JSON format.");
         }
         else
         {
-            (void)serializeJson(jsonDoc, config);
+            JsonArray   jsonSlots   = jsonDoc["slots"].as<JsonArray>();
+            uint8_t     slotId      = 0;
 
-            settings.getDisplaySlotConfig().setValue(config);
-            settings.close();
+            for(JsonObject jsonSlot: jsonSlots)
+            {
+                if (true == jsonSlot["duration"].is<uint32_t>())
+                {
+                    uint32_t duration = jsonSlot["duration"].as<uint32_t>();
+
+                    m_slots[slotId].setDuration(duration);
+
+                    ++slotId;
+                    if (DisplayMgr::getInstance().getMaxSlots() <= slotId)
+                    {
+                        break;
+                    }
+                }
+            }
         }
     }
 }
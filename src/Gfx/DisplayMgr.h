@@ -40,16 +40,59 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Pipelined display update (1) or not (0).
+ * If enabled, the display task renders the next frame, while a separate
+ * output task on the other core outputs the current frame to the LED matrix.
+ */
+#ifndef DISPLAY_MGR_PIPELINED
+#define DISPLAY_MGR_PIPELINED   (0)
+#endif  /* DISPLAY_MGR_PIPELINED */
+
+/**
+ * Idle mode of the display task (1) or not (0).
+ * If enabled, the display task sleeps longer than the frame period, as long
+ * as the display content is static.
+ */
+#ifndef DISPLAY_MGR_IDLE_MODE
+#define DISPLAY_MGR_IDLE_MODE   (1)
+#endif  /* DISPLAY_MGR_IDLE_MODE */
+
+/**
+ * Cooperative display scheduling (1) or not (0).
+ * If enabled, the display task shares the core with the network stack. It
+ * runs below the async TCP task priority, with a lower frame rate limit and
+ * smaller plugin CPU budget, and blocks during the asynchronous LED output.
+ * It is enabled by default on single-core MCUs.
+ */
+#ifndef DISPLAY_MGR_COOPERATIVE
+#if defined(CONFIG_FREERTOS_UNICORE)
+#define DISPLAY_MGR_COOPERATIVE (1)
+#else   /* defined(CONFIG_FREERTOS_UNICORE) */
+#define DISPLAY_MGR_COOPERATIVE (0)
+#endif  /* defined(CONFIG_FREERTOS_UNICORE) */
+#endif  /* DISPLAY_MGR_COOPERATIVE */
+
+#if (0 != DISPLAY_MGR_COOPERATIVE) && (0 != DISPLAY_MGR_PIPELINED)
+#error "The pipelined display update needs a second core, which is not available in cooperative mode."
+#endif  /* (0 != DISPLAY_MGR_COOPERATIVE) && (0 != DISPLAY_MGR_PIPELINED) */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <stdint.h>
 #include <Canvas.h>
+#include <Compositor.h>
 #include <TextWidget.h>
 #include <SimpleTimer.hpp>
+#include <ProfileStat.h>
 #include <FadeLinear.h>
 #include <FadeMoveX.h>
 #include <FadeMoveY.h>
+#include <FadeCross.h>
+#include <FadeWipeX.h>
+#include <SlotRecord.h>
+#include <UidMap.hpp>
 
 #include "Board.h"
 #include "IPluginMaintenance.hpp"
@@ -78,7 +121,52 @@ public:
         FADE_EFFECT_NO = 0, /**< No fade effect */
         FADE_EFFECT_LINEAR, /**< Linear dimming fade effect. */
         FADE_EFFECT_MOVE_X, /**< Moving fade effect into the direction of negative x-coordinates. */
-        FADE_EFFECT_MOVE_Y  /**< Moving fade effect into the direction of negative y-coordinates. */
+        FADE_EFFECT_MOVE_Y, /**< Moving fade effect into the direction of negative y-coordinates. */
+        FADE_EFFECT_CROSS,  /**< Cross fade effect, which blends the old content into the new one. */
+        FADE_EFFECT_WIPE_X  /**< Wipe fade effect into the direction of positive x-coordinates. */
+    };
+
+    /** Priority of a plugin activation request. */
+    enum Priority
+    {
+        PRIORITY_NORMAL = 0,    /**< Fades the current plugin out, before the requested one is shown. */
+        PRIORITY_URGENT         /**< Interrupts a fade and the current plugin, shows the requested one with the next frame. */
+    };
+
+    /** Overlay layers, higher layers are drawn on top of lower layers. */
+    enum OverlayLayer
+    {
+        OVERLAY_LAYER_SYS_MSG = 0,  /**< System messages */
+        OVERLAY_LAYER_UPDATE        /**< Update progress */
+    };
+
+    /**
+     * Display update statistics, which show whether the display task keeps
+     * its frame deadline.
+     */
+    struct Statistics
+    {
+        uint8_t     targetFps;          /**< Target frame rate in frames per second. */
+        uint32_t    frames;             /**< Number of processed frames. */
+        uint32_t    missedDeadlines;    /**< Number of frames, which took longer than the frame period. */
+        uint32_t    skippedFrames;      /**< Number of frames, which were skipped because of missed deadlines. */
+        uint32_t    frameTime;          /**< Time in ms, the last frame took. */
+        uint32_t    maxFrameTime;       /**< Max. time in ms, a frame took. */
+        uint32_t    frameTimeUs;        /**< Time in us, the last frame took. */
+        uint32_t    maxFrameTimeUs;     /**< Max. time in us, a frame took. */
+        uint32_t    preemptions;        /**< Number of urgent activation requests, which were shown. */
+        uint32_t    preemptionLatency;  /**< Time in ms from the last urgent request until its first frame was output. */
+        uint32_t    maxPreemptionLatency;   /**< Max. time in ms from a urgent request until its first frame was output. */
+    };
+
+    /**
+     * Runtime profile summary of a plugin. All values are in us.
+     */
+    struct PluginProfile
+    {
+        ProfileStat::Summary    process;    /**< Plugin process() call */
+        ProfileStat::Summary    update;     /**< Plugin update() call */
+        ProfileStat::Summary    active;     /**< Plugin active() call */
     };
 
     /**
@@ -126,6 +214,7 @@ public:
 
     /**
      * Set display brightness in digits [0; 255].
+     * The brightness is applied with the next display update.
      *
      * @param[in] level Brightness level in digits
      */
@@ -168,6 +257,13 @@ public:
      */
     uint8_t getSlotIdByPluginUID(uint16_t uid);
 
+    /**
+     * Get the id of the slot, which is currently shown.
+     *
+     * @return Slot id or SLOT_ID_INVALID, if no slot is shown.
+     */
+    uint8_t getActiveSlotId();
+
     /**
      * Get plugin from slot.
      *
@@ -180,9 +276,15 @@ public:
     /**
      * Activate a specific plugin immediately.
      *
+     * A urgent request doesn't wait for the fade effect. The current plugin
+     * is interrupted and the requested one is shown with the next frame.
+     * After the requested slot duration, the interrupted slot is resumed
+     * with its remaining duration.
+     *
      * @param[in] plugin    Plugin which to activate
+     * @param[in] priority  Request priority
      */
-    void activatePlugin(IPluginMaintenance* plugin);
+    void activatePlugin(IPluginMaintenance* plugin, Priority priority = PRIORITY_NORMAL);
 
     /**
      * Activate next slot.
@@ -253,8 +355,67 @@ public:
      */
     bool setSlotDuration(uint8_t slotId, uint32_t duration, bool store = true);
 
+    /**
+     * Get slot schedule, which controls how often and when the plugin is
+     * shown in the slot rotation.
+     *
+     * @param[in]   slotId      Slot id
+     * @param[out]  schedule    Slot schedule
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool getSlotSchedule(uint8_t slotId, Slot::Schedule& schedule);
+
+    /**
+     * Set slot schedule.
+     *
+     * @param[in] slotId    Slot id
+     * @param[in] schedule  Slot schedule
+     * @param[in] store     Store schedule persistent (default: true)
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setSlotSchedule(uint8_t slotId, const Slot::Schedule& schedule, bool store = true);
+
+    /**
+     * Begin a change of several slots, which shall become visible at once.
+     * The display task waits until the change ends. The other methods may be
+     * called in between by the same task. Call endLayoutChange() afterwards.
+     */
+    void beginLayoutChange();
+
+    /**
+     * End the change of several slots.
+     */
+    void endLayoutChange();
+
+    /**
+     * Save slot installation to persistent memory. It contains the installed
+     * plugins and the slot configuration.
+     */
+    void save();
+
+    /**
+     * Read the slot installation from persistent memory.
+     * The persistent memory must be opened before.
+     *
+     * @param[out] records  Slot records
+     * @param[in]  max      Max. number of slot records
+     * @param[out] num      Number of read slot records
+     *
+     * @return If no valid slot installation is available, it will return false otherwise true.
+     */
+    static bool readSlotInstallation(SlotRecord* records, uint8_t max, uint8_t& num);
+
     /**
      * Get access to copy of framebuffer.
+     * The colors are the logical ones, which means without the display
+     * brightness applied.
+     *
+     * If the frame is published, the copy is taken from the last published
+     * frame, which doesn't block the display update. Otherwise the display
+     * update is locked once and the frame will be published for
+     * FRAME_REQUEST_TIMEOUT, so polling consumers don't need to subscribe.
      *
      * @param[out] fb       Pointer to framebuffer copy
      * @param[out] length   Number of elements in the framebuffer copy
@@ -262,6 +423,114 @@ public:
      */
     void getFBCopy(uint32_t* fb, size_t length, uint8_t* slotId);
 
+    /**
+     * Subscribe to the published frame. As long as at least one consumer is
+     * subscribed, the display task publishes every changed frame.
+     * Every subscription must be released with unsubscribeFrame().
+     */
+    void subscribeFrame();
+
+    /**
+     * Release a subscription to the published frame.
+     */
+    void unsubscribeFrame();
+
+    /**
+     * Get display update statistics.
+     *
+     * @param[out] statistics   Display update statistics
+     */
+    void getStatistics(Statistics& statistics);
+
+    /**
+     * Is a fade effect running?
+     * It is just a snapshot and therefore needs no lock.
+     *
+     * @return If a fade effect is running, it will return true otherwise false.
+     */
+    bool isFading() const
+    {
+        return (FADE_IDLE != m_displayFadeState);
+    }
+
+    /**
+     * Add a widget, which is drawn on top of the display content every frame,
+     * e.g. to show a system message or the update progress. The active plugin
+     * stays active below it. The widget is used by the display task, so it
+     * must not be changed by other tasks without synchronization.
+     * If the widget is already a overlay, its layer and alpha are changed.
+     *
+     * Note, without framebuffers a translucent overlay is drawn opaque,
+     * because the display content below can't be restored every frame.
+     *
+     * @param[in] overlay   Overlay widget
+     * @param[in] layer     Overlay layer
+     * @param[in] alpha     Alpha value [0; 255] - 0: invisible / 255: opaque
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool addOverlay(Widget& overlay, OverlayLayer layer, uint8_t alpha = Compositor::ALPHA_OPAQUE);
+
+    /**
+     * Remove a overlay widget. The display content below is shown again
+     * with the next frame.
+     *
+     * @param[in] overlay   Overlay widget
+     */
+    void removeOverlay(Widget& overlay);
+
+    /**
+     * Reduce the priority of the display tasks below the webserver, e.g.
+     * during an update. The display keeps running, but yields to the
+     * data transfer.
+     *
+     * @param[in] isReduced Reduce the priority (true) or restore it (false).
+     */
+    void setReducedPriority(bool isReduced);
+
+    /**
+     * Begin a flash access, which disables the cache and therefore delays
+     * interrupts. It waits until a running LED matrix output is finished and
+     * prevents new outputs until endFlashAccess() is called. This avoids
+     * artifacts on the display, caused by long flash write cycles.
+     *
+     * @param[in] timeout   Max. time to wait in ms
+     *
+     * @return If the flash may be accessed, it will return true otherwise false.
+     */
+    bool beginFlashAccess(uint32_t timeout);
+
+    /**
+     * End a flash access, which was successful started with beginFlashAccess().
+     */
+    void endFlashAccess();
+
+    /**
+     * Get runtime profile of the plugin in the given slot.
+     *
+     * @param[in]  slotId   Slot id
+     * @param[out] profile  Runtime profile summary in us
+     *
+     * @return If the slot id is valid, it will return true otherwise false.
+     */
+    bool getPluginProfile(uint8_t slotId, PluginProfile& profile);
+
+    /**
+     * Get runtime profile of the fade effect steps.
+     *
+     * @param[out] profile  Runtime profile summary in us
+     */
+    void getFadeProfile(ProfileStat::Summary& profile);
+
+    /**
+     * Get the CPU budget watchdog level of a slot.
+     *
+     * @param[in] slotId    Slot id
+     *
+     * @return Watchdog level. If the slot doesn't exist, it will return the normal level.
+     */
+    BudgetWatchdog::Level getSlotBudgetLevel(uint8_t slotId);
+
     /**
      * Get max. number of display slots, which can be used for plugins.
      *
@@ -272,23 +541,155 @@ public:
         return m_maxSlots;
     }
 
+    /**
+     * Change the max. number of display slots at runtime, without restart.
+     * The installed plugins keep their slot with its duration, schedule and
+     * lock state. Plugins of removed slots are relocated to empty unlocked
+     * slots. If there are not enough, nothing is changed.
+     * The number of slots and the slot installation are stored afterwards.
+     *
+     * @param[in] maxSlots  Max. number of display slots
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setMaxSlots(uint8_t maxSlots);
+
+    /**
+     * Request all inactive plugins to release their reloadable assets,
+     * because the heap runs low. The selected plugin and the plugins, which
+     * are requested to be activated or prepared, keep their assets.
+     *
+     * @return Number of requested plugins
+     */
+    uint8_t releaseInactiveAssets();
+
     /** Invalid slot id. */
     static const uint8_t        SLOT_ID_INVALID     = UINT8_MAX;
 
     /** Task stack size in bytes */
     static const uint32_t       TASK_STACKE_SIZE    = 4096U;
 
-    /** Task period in ms */
+    /** Default task period in ms, which is used if no target frame rate is configured. */
     static const uint32_t       TASK_PERIOD         = 20U;
 
+    /**
+     * Latency budget in ms from a urgent request until its first frame is
+     * output. Exceeding it is reported.
+     */
+    static const uint32_t       PREEMPTION_LATENCY_BUDGET   = 40U;
+
+#if (0 != DISPLAY_MGR_COOPERATIVE)
+
+    /**
+     * CPU budget of a single plugin process() or update() call in percent
+     * of the frame period. A plugin, which exceeds it repeatedly, is
+     * throttled and finally disabled. The network stack needs the rest
+     * of the shared core.
+     */
+    static const uint32_t       PLUGIN_CPU_BUDGET           = 25U;
+
+    /** Max. target frame rate in fps, which leaves enough time for the network stack. */
+    static const uint8_t        TARGET_FPS_MAX              = 25U;
+
+    /**
+     * MCU core where the task shall run. It is the core of the network
+     * stack, which is the only one on a single-core MCU. On a dual-core MCU
+     * it allows to check the cooperative scheduling.
+     */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Task priority, which is lower than the webserver (async TCP) task priority. */
+    static const UBaseType_t    TASK_PRIORITY       = 2U;
+
+    /** Reduced task priority, which is the same as the prepare task priority. */
+    static const UBaseType_t    TASK_PRIORITY_REDUCED   = 1U;
+
+#else   /* (0 != DISPLAY_MGR_COOPERATIVE) */
+
+    /**
+     * CPU budget of a single plugin process() or update() call in percent
+     * of the frame period. A plugin, which exceeds it repeatedly, is
+     * throttled and finally disabled.
+     */
+    static const uint32_t       PLUGIN_CPU_BUDGET           = 50U;
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+#else   /* (0 != DISPLAY_MGR_PIPELINED) */
+
     /** MCU core where the task shall run */
     static const BaseType_t     TASK_RUN_CORE       = 1;
 
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
     static const UBaseType_t    TASK_PRIORITY       = 4U;
 
+    /** Reduced task priority, which is lower than the webserver (async TCP) task priority. */
+    static const UBaseType_t    TASK_PRIORITY_REDUCED   = 2U;
+
+#endif  /* (0 != DISPLAY_MGR_COOPERATIVE) */
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+
+    /** Output task stack size in bytes */
+    static const uint32_t       OUTPUT_TASK_STACK_SIZE  = 2048U;
+
+    /** MCU core where the output task shall run */
+    static const BaseType_t     OUTPUT_TASK_RUN_CORE    = 1;
+
+    /** Output task priority, which is higher than the display task priority. */
+    static const UBaseType_t    OUTPUT_TASK_PRIORITY    = TASK_PRIORITY + 1U;
+
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+
+    /** Number of frames with static content, after which the display task goes idle. */
+    static const uint32_t       IDLE_FRAMES             = 10U;
+
+    /**
+     * Max. time in ms the idle display task sleeps. It limits the latency
+     * of content changes, which are not signalled to the display task,
+     * e.g. a scrolling text after its pause. Plugins, which declare their
+     * next change, shorten it to wake up just in time.
+     */
+    static const uint32_t       IDLE_PERIOD             = 100U;
+
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
+    /** Prepare task stack size in bytes, which must be enough to decode bitmaps. */
+    static const uint32_t       PREPARE_TASK_STACK_SIZE = 4096U;
+
+    /** MCU core where the prepare task shall run */
+    static const BaseType_t     PREPARE_TASK_RUN_CORE   = 0;
+
+    /** Prepare task priority, which is lower than the display task priority. */
+    static const UBaseType_t    PREPARE_TASK_PRIORITY   = 1U;
+
+    /** Time in ms before the slot change, when the next plugin shall be prepared. */
+    static const uint32_t       PREPARE_LEAD_TIME       = 1000U;
+
     /** If no ambient light sensor is available, the default brightness shall be 40%. */
     static const uint8_t        BRIGHTNESS_DEFAULT  = (UINT8_MAX * 40U) / 100U;
 
+    /** No brightness level is requested. */
+    static const uint32_t       BRIGHTNESS_REQUEST_NONE = UINT32_MAX;
+
+    /** Time in ms, how long the frame is published after a getFBCopy() request without subscription. */
+    static const uint32_t       FRAME_REQUEST_TIMEOUT   = 2000U;
+
+    /** Number of pixels in a published frame. */
+    static const uint16_t       FRAME_PIXEL_COUNT   = Board::LedMatrix::width * Board::LedMatrix::height;
+
+    /**
+     * Number of entries in the slot index. It must be a power of two and
+     * greater than the max. number of slots.
+     */
+    static const uint16_t       SLOT_INDEX_SIZE     = 16U;
+
 private:
 
     /** Mutex to lock/unlock display update. */
@@ -303,24 +704,135 @@ private:
     /** Binary semaphore used to signal the task exit. */
     SemaphoreHandle_t   m_xSemaphore;
 
+    /** Mutex, which is hold while a LED matrix output is started or the flash is accessed. */
+    SemaphoreHandle_t   m_xOutputGate;
+
+    /** Composes the overlay widgets on top of the display content. */
+    Compositor          m_compositor;
+
+#if (0 != DISPLAY_MGR_PIPELINED)
+
+    /** Output task handle */
+    TaskHandle_t        m_outputTaskHandle;
+
+    /** Flag to signal the output task to exit. */
+    bool                m_outputTaskExit;
+
+    /** Binary semaphore used to signal the output task exit. */
+    SemaphoreHandle_t   m_xOutputSemaphore;
+
+    /** Binary semaphore, given by the display task if a frame is ready for output. */
+    SemaphoreHandle_t   m_xFrameReady;
+
+    /**
+     * Binary semaphore, given by the output task if the LED matrix framebuffer
+     * is free again. It is also given by the display task, if a frame needs no output.
+     */
+    SemaphoreHandle_t   m_xFrameFree;
+
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+    /** Prepare task handle */
+    TaskHandle_t        m_prepareTaskHandle;
+
+    /** Flag to signal the prepare task to exit. */
+    bool                m_prepareTaskExit;
+
+    /** Binary semaphore used to signal the prepare task exit. */
+    SemaphoreHandle_t   m_xPrepareSemaphore;
+
+    /** Binary semaphore, given by the display task if a plugin shall be prepared. */
+    SemaphoreHandle_t   m_xPrepareRequest;
+
+    /** Mutex, which is hold by the prepare task as long as a plugin is prepared. */
+    SemaphoreHandle_t   m_xPrepareMutex;
+
+    /** Plugin which shall be prepared by the prepare task. Protected by the display lock. */
+    IPluginMaintenance* m_preparePlugin;
+
+    /** Is the next plugin already requested to be prepared for the current slot duration? */
+    bool                m_isPrepareRequested;
+
     /** List of all slots with their connected plugins. */
     Slot*               m_slots;
 
     /** Max. number of slots. */
     uint8_t             m_maxSlots;
 
+    /** Slot id of every installed plugin, accessed by the plugin UID. */
+    UidMap<uint8_t, SLOT_INDEX_SIZE> m_slotIndex;
+
+    /** Slot rotation plan, derived from the slot weights. */
+    SlotPlan            m_plan;
+
+    /** Index of the current rotation plan entry. */
+    uint8_t             m_planIndex;
+
+    /** Is a update of the rotation plan required? */
+    bool                m_isPlanUpdateReq;
+
     /** Current selected slot. */
     uint8_t             m_selectedSlot;
 
     /** Current selected plugin, which is active shown. */
     IPluginMaintenance* m_selectedPlugin;
 
+    /**
+     * Time in ms until the content of the selected plugin changes next,
+     * declared by the plugin in the current display cycle. Its update is
+     * skipped, unless it is IPluginMaintenance::UPDATE_ALWAYS.
+     */
+    uint32_t            m_timeToNextUpdate;
+
     /** Plugin which is requested to be activated immediately. */
     IPluginMaintenance* m_requestedPlugin;
 
+    /** Priority of the requested plugin activation. */
+    Priority            m_requestedPriority;
+
+    /** Timestamp in ms of the pending urgent request, used to measure its latency. */
+    uint32_t            m_preemptionTimestamp;
+
+    /** Is a urgent request shown, but its first frame not output yet? */
+    bool                m_isPreemptionMeasured;
+
+    /** Slot, which was interrupted by a urgent request and is resumed afterwards. */
+    uint8_t             m_resumeSlot;
+
+    /** Remaining duration in ms of the interrupted slot. 0 means infinite. */
+    uint32_t            m_resumeDuration;
+
     /** Timer, used for changing the slot after a specific duration. */
     SimpleTimer         m_slotTimer;
 
+    /**
+     * Brightness level in digits, which is requested to be applied by the
+     * display task. BRIGHTNESS_REQUEST_NONE means no request.
+     */
+    volatile uint32_t   m_requestedBrightness;
+
+    /** Frame period in ms, derived from the target frame rate. */
+    uint32_t            m_framePeriod;
+
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+
+    /** Number of frames with static content, saturated at IDLE_FRAMES. */
+    uint32_t            m_staticFrames;
+
+    /** Is the display task idle? Only written by the display task. */
+    volatile bool       m_isIdle;
+
+    /** Time in ms, the idle display task shall sleep. Only written by the display task. */
+    volatile uint32_t   m_idlePeriod;
+
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
+    /** Display update statistics, written by the display task. */
+    Statistics          m_statistics;
+
+    /** Runtime profile of the fade effect steps in CPU cycles. */
+    ProfileStat         m_fadeProfile;
+
     /** Display fade state */
     enum FadeState
     {
@@ -347,10 +859,39 @@ private:
     FadeLinear          m_fadeLinearEffect;             /**< Linear fade effect. */
     FadeMoveX           m_fadeMoveXEffect;              /**< Moving along x-axis fade effect. */
     FadeMoveY           m_fadeMoveYEffect;              /**< Moving along y-axis fade effect. */
+    FadeCross           m_fadeCrossEffect;              /**< Cross fade effect. */
+    FadeWipeX           m_fadeWipeXEffect;              /**< Wipe along x-axis fade effect. */
     IFadeEffect*        m_fadeEffect;                   /**< The fade effect itself. */
     FadeEffect          m_fadeEffectIndex;              /**< Fade effect index to determine the next fade effect. */
     bool                m_fadeEffectUpdate;             /**< Flag to indicate that the fadeEffect was updated. */
 
+    /**
+     * The last frame, which was shown on the display. It is written by the
+     * display task only and can be read by any other task without locking
+     * the display update, see getFBCopy().
+     */
+    uint32_t            m_publishedFrame[FRAME_PIXEL_COUNT];
+    uint8_t             m_publishedSlotId;              /**< Id of the slot, which is shown in the published frame. */
+
+    /**
+     * Sequence number of the published frame. It is odd while the display task
+     * writes the published frame. A reader shall retry, if the sequence number
+     * is odd or changed during reading.
+     */
+    volatile uint32_t   m_publishedFrameSeq;
+
+    /** Number of consumers, which are subscribed to the published frame. */
+    uint8_t             m_frameSubscribers;
+
+    /** Is the published frame up to date? Only written by the display task. */
+    volatile bool       m_isFramePublished;
+
+    /** Is the frame requested by getFBCopy() without subscription? */
+    volatile bool       m_isFrameRequested;
+
+    /** Timestamp in ms of the last getFBCopy() request. */
+    volatile uint32_t   m_frameRequestTimestamp;
+
     /**
      * Construct LED matrix.
      */
@@ -365,6 +906,18 @@ private:
     DisplayMgr(const DisplayMgr& mgr);
     DisplayMgr& operator=(const DisplayMgr& mgr);
 
+    /**
+     * Schedule next slot according to the rotation plan. A slot is only
+     * scheduled, if its plugin is enabled, has content and the current time
+     * is inside the slot time window. If no slot fulfills this, the next
+     * slot with a enabled plugin is chosen.
+     *
+     * @param[in,out] planIndex Index of the current plan entry, which will be updated.
+     *
+     * @return Id of next slot
+     */
+    uint8_t nextSlot(uint8_t& planIndex);
+
     /**
      * Schedule next slot with a installed and enabled plugin.
      *
@@ -372,13 +925,52 @@ private:
      *
      * @return Id of next slot
      */
-    uint8_t nextSlot(uint8_t slotId);
+    uint8_t nextEnabledSlot(uint8_t slotId);
+
+    /**
+     * Build the rotation plan from the slot weights.
+     */
+    void updatePlan();
+
+    /**
+     * Is the slot allowed to be scheduled now?
+     *
+     * @param[in] slotId            Slot id
+     * @param[in] isTimeAvailable   Is the current time available?
+     * @param[in] minuteOfDay       Current minute of the day
+     *
+     * @return If the slot can be scheduled, it will return true otherwise false.
+     */
+    bool isSlotScheduled(uint8_t slotId, bool isTimeAvailable, uint16_t minuteOfDay);
 
     /**
      * Start fade effect.
      */
     void startFadeOut();
 
+    /**
+     * Interrupt the selected plugin and a running fade effect immediately,
+     * because of a urgent request. The interrupted slot is remembered to
+     * be resumed later.
+     */
+    void preempt();
+
+    /**
+     * Measure the latency of a shown urgent request, after its first frame
+     * was output.
+     */
+    void measurePreemption();
+
+    /**
+     * Check the runtime of a plugin call against the plugin CPU budget.
+     * If the watchdog escalates, the plugin is throttled or disabled.
+     * The display must be locked before.
+     *
+     * @param[in] slotId    Slot id of the plugin
+     * @param[in] cycles    Runtime of the call in CPU cycles
+     */
+    void checkBudget(uint8_t slotId, uint32_t cycles);
+
     /**
      * Fade display content in/out.
      *
@@ -394,6 +986,12 @@ private:
      */
     void process(void);
 
+    /**
+     * Publish the current LED matrix content, so it can be read without
+     * locking the display update.
+     */
+    void publishFrame(void);
+
     /**
      * Display update task is responsible to refresh the display content.
      *
@@ -401,6 +999,102 @@ private:
      */
     static void updateTask(void* parameters);
 
+#if (0 != DISPLAY_MGR_PIPELINED)
+
+    /**
+     * Create the output task and its semaphores.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool startOutputTask(void);
+
+    /**
+     * Stop the output task and destroy its semaphores.
+     */
+    void stopOutputTask(void);
+
+    /**
+     * Output task is responsible to output the frames to the LED matrix,
+     * which are rendered by the display task.
+     *
+     * @param[in]   parameters  Task pParameters
+     */
+    static void outputTask(void* parameters);
+
+#endif  /* (0 != DISPLAY_MGR_PIPELINED) */
+
+    /**
+     * Create the prepare task and its semaphores.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool startPrepareTask(void);
+
+    /**
+     * Stop the prepare task and destroy its semaphores.
+     */
+    void stopPrepareTask(void);
+
+    /**
+     * Request the preparation of the plugin in the next slot, if the current
+     * slot duration is nearly over. The display must be locked before.
+     */
+    void requestPrepare(void);
+
+    /**
+     * Request the slot, which is active at the master of the display group.
+     * Only a following slave does it. The display must be locked before.
+     */
+    void followSyncSlot(void);
+
+    /**
+     * Publish the active slot and the next slot switch to the slaves of the
+     * display group. Only the master does it. The display must be locked before.
+     */
+    void publishSyncSlot(void);
+
+    /**
+     * Prepare task is responsible to prepare the plugin of the next slot,
+     * before it is set active by the display task.
+     *
+     * @param[in]   parameters  Task pParameters
+     */
+    static void prepareTask(void* parameters);
+
+    /**
+     * Update the display statistics after a frame was processed.
+     *
+     * @param[in] frameTime     Time in us, the frame took.
+     * @param[in] skippedFrames Number of frames, which are skipped to catch up.
+     */
+    void updateStatistics(uint32_t frameTime, uint32_t skippedFrames);
+
+#if (0 != DISPLAY_MGR_IDLE_MODE)
+
+    /**
+     * Update the idle state of the display task after a frame was processed.
+     * The display task goes idle, if the frame content is static since
+     * several frames and leaves it immediately on any change.
+     *
+     * @param[in] isFrameChanged    Is the frame content changed?
+     */
+    void updateIdleState(bool isFrameChanged);
+
+    /**
+     * Wake up the idle display task, if called by another task.
+     */
+    void wakeUp(void);
+
+#endif  /* (0 != DISPLAY_MGR_IDLE_MODE) */
+
+    /**
+     * Get summary of runtime profile statistics in us.
+     *
+     * @param[in]  profileStat  Runtime profile statistics in CPU cycles
+     * @param[out] summary      Summary in us
+     */
+    static void getProfileSummary(const ProfileStat& profileStat, ProfileStat::Summary& summary);
+
     /**
      * Lock display and prevent the display update, which will be done in a
      * separate task.
@@ -412,15 +1106,38 @@ private:
      */
     void unlock(void);
 
+    /**
+     * Set the plugin of a slot and keep the slot index up to date.
+     * The display must be locked before.
+     *
+     * @param[in] slotId    Slot id
+     * @param[in] plugin    Plugin, may be nullptr to remove the plugin
+     *
+     * @return If successful set, it will return true otherwise false.
+     */
+    bool setSlotPlugin(uint8_t slotId, IPluginMaintenance* plugin);
+
+    /**
+     * Resize the slot array and migrate the slots into it.
+     * The display must be locked before.
+     *
+     * @param[in] maxSlots  Max. number of display slots
+     *
+     * @return If successful resized, it will return true otherwise false.
+     */
+    bool resizeSlots(uint8_t maxSlots);
+
     /**
      * Load display slot configuration from persistent memory.
      */
     void load();
 
     /**
-     * Save display slot configuration to persistent memory.
+     * Load display slot configuration from persistent memory in the legacy
+     * JSON format. It is only used until the slot installation is migrated.
+     * The persistent memory must be opened before.
      */
-    void save();
+    void loadLegacy();
 };
 
 /******************************************************************************
@@ -0,0 +1,521 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HUB75 RGB panel driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Hub75Panel.h"
+
+#include <Logging.h>
+#include <esp_heap_caps.h>
+#include <driver/gpio.h>
+#include <driver/periph_ctrl.h>
+#include <rom/gpio.h>
+#include <soc/gpio_sig_map.h>
+#include <soc/i2s_struct.h>
+
+/* The HUB75 pins are only available, if the LED matrix consists of HUB75 panels. */
+#if (0 != LEDMATRIX_HUB75)
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+static_assert(  (2U <= Board::LedMatrix::height) && (32U >= Board::LedMatrix::height),
+                "HUB75 panels with max. 16 row addresses are supported.");
+static_assert(  32U <= Board::LedMatrix::width,
+                "HUB75 panels need a width of at least 32 pixels.");
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Bit position of the upper half red data in a parallel data word, followed by green and blue. */
+static const uint8_t    BIT_RGB1        = 0U;
+
+/** Bit position of the lower half red data in a parallel data word, followed by green and blue. */
+static const uint8_t    BIT_RGB2        = 3U;
+
+/** Bit position of the row address A in a parallel data word, followed by B, C and D. */
+static const uint8_t    BIT_ADDR        = 6U;
+
+/** Latch bit in a parallel data word */
+static const uint16_t   BIT_LAT         = 1U << 10U;
+
+/** Output enable bit in a parallel data word. It is low active. */
+static const uint16_t   BIT_OE          = 1U << 11U;
+
+/**
+ * Pin numbers in the order of the parallel data word bits. The I2S
+ * peripheral outputs the 16-bit data words on its signals 8 to 23.
+ */
+static const uint8_t    DATA_PIN_NO[]   =
+{
+    Board::Pin::hub75R1PinNo,
+    Board::Pin::hub75G1PinNo,
+    Board::Pin::hub75B1PinNo,
+    Board::Pin::hub75R2PinNo,
+    Board::Pin::hub75G2PinNo,
+    Board::Pin::hub75B2PinNo,
+    Board::Pin::hub75APinNo,
+    Board::Pin::hub75BPinNo,
+    Board::Pin::hub75CPinNo,
+    Board::Pin::hub75DPinNo,
+    Board::Pin::hub75LatPinNo,
+    Board::Pin::hub75OePinNo
+};
+
+/** Panel width in pixels, which is the number of data words per row and bit plane. */
+static const uint16_t   WIDTH           = Board::LedMatrix::width;
+
+/**
+ * Number of clocks at the begin and the end of every row, where the output
+ * is disabled. It hides the row address change and the latch.
+ */
+static const uint16_t   BLANK_CLOCKS    = 1U;
+
+/** Number of clocks per row with enabled output, for bit planes which repeat their descriptor. */
+static const uint16_t   ON_CLOCKS       = WIDTH - (2U * BLANK_CLOCKS);
+
+/**
+ * I2S base clock in Hz. The PLL_D2_CLK (160 MHz) is divided by 4 in the
+ * LCD mode with a bit clock divider of 2.
+ */
+static const uint32_t   I2S_BASE_CLOCK  = 40000000U;
+
+/** I2S clock divider to get the HUB75 clock. */
+static const uint32_t   I2S_CLOCK_DIV   = I2S_BASE_CLOCK / Board::LedMatrix::hub75ClockFreq;
+
+static_assert(  2U <= I2S_CLOCK_DIV,
+                "HUB75 clock frequency is too high.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Hub75Panel::Hub75Panel() :
+    ILedStrip(),
+    m_buffers(),
+    m_descs(),
+    m_front(0U),
+    m_isSwapPending(false),
+    m_isBackDirty(false),
+    m_intrHandle(nullptr),
+    m_xSwapSemaphore(xSemaphoreCreateBinary())
+{
+    /* A complete refresh cycle shall fit into the time, which is waited for a frame. */
+    static_assert(  (static_cast<uint64_t>(DESC_COUNT) * WIDTH * 1000U) <= (static_cast<uint64_t>(Board::LedMatrix::matrixLoadTime) * Board::LedMatrix::hub75ClockFreq),
+                    "HUB75 refresh cycle exceeds the matrix load time.");
+}
+
+Hub75Panel::~Hub75Panel()
+{
+    uint8_t bufferId = 0U;
+
+    if (nullptr != m_intrHandle)
+    {
+        I2S1.conf.tx_start      = 0;
+        I2S1.out_link.stop      = 1;
+        I2S1.int_ena.val        = 0;
+
+        (void)esp_intr_free(m_intrHandle);
+        m_intrHandle = nullptr;
+    }
+
+    for(bufferId = 0U; bufferId < BUFFER_COUNT; ++bufferId)
+    {
+        heap_caps_free(m_buffers[bufferId]);
+        m_buffers[bufferId] = nullptr;
+
+        heap_caps_free(m_descs[bufferId]);
+        m_descs[bufferId] = nullptr;
+    }
+
+    if (nullptr != m_xSwapSemaphore)
+    {
+        vSemaphoreDelete(m_xSwapSemaphore);
+        m_xSwapSemaphore = nullptr;
+    }
+}
+
+void Hub75Panel::begin()
+{
+    bool    isSuccessful    = (nullptr != m_xSwapSemaphore);
+    uint8_t bufferId        = 0U;
+
+    /* The DMA can only access the internal memory. */
+    for(bufferId = 0U; (bufferId < BUFFER_COUNT) && (true == isSuccessful); ++bufferId)
+    {
+        m_buffers[bufferId] = static_cast<uint16_t*>(heap_caps_malloc(WORD_COUNT * sizeof(uint16_t), MALLOC_CAP_DMA));
+        m_descs[bufferId]   = static_cast<lldesc_t*>(heap_caps_malloc(DESC_COUNT * sizeof(lldesc_t), MALLOC_CAP_DMA));
+
+        if ((nullptr == m_buffers[bufferId]) ||
+            (nullptr == m_descs[bufferId]))
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            initBuffer(bufferId);
+            initDescs(bufferId);
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        LOG_ERROR("Not enough DMA memory for the HUB75 buffers.");
+
+        for(bufferId = 0U; bufferId < BUFFER_COUNT; ++bufferId)
+        {
+            heap_caps_free(m_buffers[bufferId]);
+            m_buffers[bufferId] = nullptr;
+
+            heap_caps_free(m_descs[bufferId]);
+            m_descs[bufferId] = nullptr;
+        }
+    }
+    else
+    {
+        initI2s();
+    }
+
+    return;
+}
+
+void Hub75Panel::show()
+{
+    if ((nullptr != m_intrHandle) &&
+        (true == m_isBackDirty) &&
+        (false == m_isSwapPending))
+    {
+        const uint8_t BACK = m_front ^ 1U;
+
+        (void)xSemaphoreTake(m_xSwapSemaphore, 0U);
+
+        m_isBackDirty   = false;
+        m_isSwapPending = true;
+
+        /* The DMA continues with the back buffer after the running refresh cycle. */
+        m_descs[m_front][DESC_COUNT - 1U].qe.stqe_next = &m_descs[BACK][0];
+    }
+
+    return;
+}
+
+bool Hub75Panel::waitUntilReady(uint32_t timeout) const
+{
+    if (true == m_isSwapPending)
+    {
+        (void)xSemaphoreTake(m_xSwapSemaphore, pdMS_TO_TICKS(timeout));
+    }
+
+    return (false == m_isSwapPending);
+}
+
+void Hub75Panel::setPixelColor(uint16_t index, const RgbColor& color)
+{
+    const uint16_t  X   = index % WIDTH;
+    const uint16_t  Y   = index / WIDTH;
+
+    if ((nullptr != m_buffers[0]) &&
+        (Board::LedMatrix::height > Y))
+    {
+        const uint8_t   SHIFT   = (ROWS > Y) ? BIT_RGB1 : BIT_RGB2;
+        const uint16_t  MASK    = static_cast<uint16_t>(~(0x07U << SHIFT));
+        uint16_t*       word    = &m_buffers[m_front ^ 1U][(Y % ROWS) * COLOR_DEPTH * WIDTH];
+        uint8_t         plane   = 0U;
+
+        /* The I2S FIFO outputs the two data words of every 32-bit word
+         * in swapped order.
+         */
+        word += X ^ 1U;
+
+        for(plane = 0U; plane < COLOR_DEPTH; ++plane)
+        {
+            const uint16_t BITS =   (((color.R >> plane) & 0x01U) << 0U) |
+                                    (((color.G >> plane) & 0x01U) << 1U) |
+                                    (((color.B >> plane) & 0x01U) << 2U);
+
+            *word = (*word & MASK) | (BITS << SHIFT);
+            word += WIDTH;
+        }
+
+        m_isBackDirty = true;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void Hub75Panel::initBuffer(uint8_t bufferId)
+{
+    uint16_t*   word    = m_buffers[bufferId];
+    uint8_t     row     = 0U;
+    uint8_t     plane   = 0U;
+    uint16_t    x       = 0U;
+
+    /* The data is latched at the end of a row and shown, while the next
+     * bit plane is shifted in. Therefore every bit plane contains the row
+     * address and the output enable of the previous one. The first bit
+     * plane of a row shows the last one of the previous row.
+     */
+    for(row = 0U; row < ROWS; ++row)
+    {
+        for(plane = 0U; plane < COLOR_DEPTH; ++plane)
+        {
+            const uint8_t   PREV_PLANE  = (0U == plane) ? (COLOR_DEPTH - 1U) : (plane - 1U);
+            const uint8_t   SHOWN_ROW   = (0U == plane) ? ((row + ROWS - 1U) % ROWS) : row;
+            const uint8_t   ON_SHIFT    = (BCM_SPLIT > PREV_PLANE) ? (BCM_SPLIT - PREV_PLANE) : 0U;
+            const uint16_t  ON_END      = BLANK_CLOCKS + (ON_CLOCKS >> ON_SHIFT);
+
+            for(x = 0U; x < WIDTH; ++x)
+            {
+                uint16_t value = static_cast<uint16_t>(SHOWN_ROW) << BIT_ADDR;
+
+                if ((BLANK_CLOCKS > x) ||
+                    (ON_END <= x))
+                {
+                    value |= BIT_OE;
+                }
+
+                if ((WIDTH - 1U) == x)
+                {
+                    value |= BIT_LAT;
+                }
+
+                word[x ^ 1U] = value;
+            }
+
+            word += WIDTH;
+        }
+    }
+
+    return;
+}
+
+void Hub75Panel::initDescs(uint8_t bufferId)
+{
+    lldesc_t*   descs   = m_descs[bufferId];
+    uint16_t    index   = 0U;
+    uint8_t     row     = 0U;
+    uint8_t     plane   = 0U;
+
+    for(row = 0U; row < ROWS; ++row)
+    {
+        for(plane = 0U; plane < COLOR_DEPTH; ++plane)
+        {
+            const uint16_t  REPEATS     = (BCM_SPLIT >= plane) ? 1U : (1U << (plane - BCM_SPLIT));
+            uint16_t*       words       = &m_buffers[bufferId][(row * COLOR_DEPTH + plane) * WIDTH];
+            uint16_t        repetition  = 0U;
+
+            /* Every repetition shows the bit plane for the time of a row. */
+            for(repetition = 0U; repetition < REPEATS; ++repetition)
+            {
+                lldesc_t* desc = &descs[index];
+
+                desc->size              = WIDTH * sizeof(uint16_t);
+                desc->length            = WIDTH * sizeof(uint16_t);
+                desc->offset            = 0U;
+                desc->sosf              = 0U;
+                desc->eof               = 0U;
+                desc->owner             = 1U;
+                desc->buf               = reinterpret_cast<uint8_t*>(words);
+                desc->qe.stqe_next      = &descs[index + 1U];
+
+                ++index;
+            }
+        }
+    }
+
+    /* The end of a refresh cycle is signalled and the buffer is repeated,
+     * until the other one is linked.
+     */
+    descs[DESC_COUNT - 1U].eof              = 1U;
+    descs[DESC_COUNT - 1U].qe.stqe_next     = &descs[0];
+
+    return;
+}
+
+void Hub75Panel::initI2s()
+{
+    uint8_t index = 0U;
+
+    periph_module_enable(PERIPH_I2S1_MODULE);
+
+    for(index = 0U; index < sizeof(DATA_PIN_NO); ++index)
+    {
+        const gpio_num_t PIN = static_cast<gpio_num_t>(DATA_PIN_NO[index]);
+
+        PIN_FUNC_SELECT(GPIO_PIN_MUX_REG[PIN], PIN_FUNC_GPIO);
+        (void)gpio_set_direction(PIN, GPIO_MODE_OUTPUT);
+        gpio_matrix_out(PIN, I2S1O_DATA_OUT8_IDX + index, false, false);
+    }
+
+    /* The data changes at the falling clock edge and is stable at the rising
+     * edge, where the panel shifts it in.
+     */
+    PIN_FUNC_SELECT(GPIO_PIN_MUX_REG[Board::Pin::hub75ClkPinNo], PIN_FUNC_GPIO);
+    (void)gpio_set_direction(static_cast<gpio_num_t>(Board::Pin::hub75ClkPinNo), GPIO_MODE_OUTPUT);
+    gpio_matrix_out(Board::Pin::hub75ClkPinNo, I2S1O_WS_OUT_IDX, true, false);
+
+    /* Reset the peripheral, the DMA and the FIFO. */
+    I2S1.conf.tx_reset          = 1;
+    I2S1.conf.tx_reset          = 0;
+    I2S1.lc_conf.out_rst        = 1;
+    I2S1.lc_conf.out_rst        = 0;
+    I2S1.lc_conf.ahbm_rst       = 1;
+    I2S1.lc_conf.ahbm_rst       = 0;
+    I2S1.conf.tx_fifo_reset     = 1;
+    I2S1.conf.tx_fifo_reset     = 0;
+
+    /* Parallel output of 16-bit data words in LCD mode. */
+    I2S1.conf2.val              = 0;
+    I2S1.conf2.lcd_en           = 1;
+
+    I2S1.sample_rate_conf.val               = 0;
+    I2S1.sample_rate_conf.tx_bits_mod       = 16;
+    I2S1.sample_rate_conf.tx_bck_div_num    = 2;
+
+    I2S1.clkm_conf.val          = 0;
+    I2S1.clkm_conf.clka_en      = 0;
+    I2S1.clkm_conf.clkm_div_a   = 1;
+    I2S1.clkm_conf.clkm_div_b   = 0;
+    I2S1.clkm_conf.clkm_div_num = I2S_CLOCK_DIV;
+    I2S1.clkm_conf.clk_en       = 1;
+
+    I2S1.fifo_conf.val                  = 0;
+    I2S1.fifo_conf.tx_fifo_mod_force_en = 1;
+    I2S1.fifo_conf.tx_fifo_mod          = 1;
+    I2S1.fifo_conf.tx_data_num          = 32;
+    I2S1.fifo_conf.dscr_en              = 1;
+
+    I2S1.conf1.val              = 0;
+    I2S1.conf1.tx_stop_en       = 0;
+    I2S1.conf1.tx_pcm_bypass    = 1;
+
+    I2S1.conf_chan.val          = 0;
+    I2S1.conf_chan.tx_chan_mod  = 1;
+
+    I2S1.conf.tx_right_first    = 0;
+    I2S1.timing.val             = 0;
+
+    I2S1.lc_conf.val                = 0;
+    I2S1.lc_conf.out_data_burst_en  = 1;
+    I2S1.lc_conf.outdscr_burst_en   = 1;
+
+    /* Only the end of a refresh cycle is of interest. */
+    I2S1.int_ena.val            = 0;
+    I2S1.int_clr.val            = UINT32_MAX;
+    I2S1.int_ena.out_eof        = 1;
+
+    if (ESP_OK != esp_intr_alloc(ETS_I2S1_INTR_SOURCE, ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_LEVEL1, isr, this, &m_intrHandle))
+    {
+        LOG_ERROR("Couldn't allocate the HUB75 interrupt.");
+        m_intrHandle = nullptr;
+    }
+    else
+    {
+        /* The refresh runs from now on without CPU. */
+        I2S1.out_link.addr      = reinterpret_cast<uint32_t>(&m_descs[m_front][0]);
+        I2S1.out_link.start     = 1;
+        I2S1.conf.tx_start      = 1;
+
+        LOG_INFO("HUB75 refresh rate: %u Hz", Board::LedMatrix::hub75ClockFreq / (static_cast<uint32_t>(DESC_COUNT) * WIDTH));
+    }
+
+    return;
+}
+
+void IRAM_ATTR Hub75Panel::isr(void* arg)
+{
+    Hub75Panel* panel   = static_cast<Hub75Panel*>(arg);
+    BaseType_t  woken   = pdFALSE;
+
+    I2S1.int_clr.val = I2S1.int_st.val;
+
+    if ((nullptr != panel) &&
+        (true == panel->m_isSwapPending))
+    {
+        const uint8_t   FRONT   = panel->m_front;
+        const uint8_t   BACK    = FRONT ^ 1U;
+        const uint32_t  DESC    = I2S1.out_link_dscr;
+        const uint32_t  FIRST   = reinterpret_cast<uint32_t>(&panel->m_descs[BACK][0]);
+        const uint32_t  LAST    = reinterpret_cast<uint32_t>(&panel->m_descs[BACK][DESC_COUNT - 1U]);
+
+        /* The link may be set too late for this refresh cycle, therefore
+         * the DMA position is checked.
+         */
+        if ((FIRST <= DESC) && (LAST >= DESC))
+        {
+            panel->m_descs[FRONT][DESC_COUNT - 1U].qe.stqe_next = &panel->m_descs[FRONT][0];
+            panel->m_front          = BACK;
+            panel->m_isSwapPending  = false;
+
+            (void)xSemaphoreGiveFromISR(panel->m_xSwapSemaphore, &woken);
+        }
+    }
+
+    if (pdFALSE != woken)
+    {
+        portYIELD_FROM_ISR();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#endif  /* (0 != LEDMATRIX_HUB75) */
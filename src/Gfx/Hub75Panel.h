@@ -0,0 +1,203 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HUB75 RGB panel driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __HUB75PANEL_H__
+#define __HUB75PANEL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <rom/lldesc.h>
+#include <esp_intr_alloc.h>
+
+#include "Board.h"
+#include "ILedStrip.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Chain of HUB75 RGB panels, which is driven by the I2S peripheral in
+ * parallel mode. The DMA refreshes the panels continuously from a buffer,
+ * which contains for every row and color bit plane the complete signal
+ * pattern (color data, row address, latch and output enable). Therefore no
+ * CPU time is spent for the refresh.
+ *
+ * The colors are displayed with binary code modulation (BCM): every bit
+ * plane is shown twice as long as the next lower one. The higher bit planes
+ * repeat the DMA descriptor of their buffer, the lower ones shorten the
+ * output enable instead, which saves descriptors and keeps the refresh rate
+ * high.
+ *
+ * There are two buffers. The pixels are written to the back buffer, which
+ * is shown after the running refresh cycle by show().
+ */
+class Hub75Panel : public ILedStrip
+{
+public:
+
+    /**
+     * Constructs the HUB75 panel chain.
+     */
+    Hub75Panel();
+
+    /**
+     * Destroys the HUB75 panel chain.
+     */
+    ~Hub75Panel();
+
+    /**
+     * Allocate the buffers and start the refresh by DMA.
+     */
+    void begin() final;
+
+    /**
+     * Show the back buffer after the running refresh cycle, if it changed.
+     */
+    void show() final;
+
+    /**
+     * Is the back buffer shown?
+     *
+     * @return If ready for another update via show(), it will return true otherwise false.
+     */
+    bool isReady() const final
+    {
+        return (false == m_isSwapPending);
+    }
+
+    /**
+     * Wait until the back buffer is shown. The calling task is blocked until
+     * the DMA signals the end of the refresh cycle.
+     *
+     * @param[in] timeout   Max. time to wait in ms
+     *
+     * @return If ready for another update via show(), it will return true otherwise false.
+     */
+    bool waitUntilReady(uint32_t timeout) const final;
+
+    /**
+     * Set the color of a single LED in the back buffer.
+     *
+     * @param[in] index Index of the LED, row by row
+     * @param[in] color Color
+     */
+    void setPixelColor(uint16_t index, const RgbColor& color) final;
+
+private:
+
+    /** Number of rows, which are addressed. Two rows are lit at a time. */
+    static const uint8_t    ROWS            = Board::LedMatrix::height / 2U;
+
+    /** Number of bit planes per color channel. */
+    static const uint8_t    COLOR_DEPTH     = 8U;
+
+    /**
+     * Bit planes up to this one are shown for a single DMA descriptor, but
+     * with a shortened output enable. The higher bit planes repeat their
+     * descriptor instead.
+     */
+    static const uint8_t    BCM_SPLIT       = 3U;
+
+    /** Number of DMA descriptors per row. */
+    static const uint16_t   DESC_PER_ROW    = BCM_SPLIT + (1U << (COLOR_DEPTH - BCM_SPLIT)) - 1U;
+
+    /** Number of DMA descriptors per buffer. */
+    static const uint16_t   DESC_COUNT      = ROWS * DESC_PER_ROW;
+
+    /** Number of parallel data words per buffer. */
+    static const uint32_t   WORD_COUNT      = static_cast<uint32_t>(ROWS) * COLOR_DEPTH * Board::LedMatrix::width;
+
+    /** Number of buffers */
+    static const uint8_t    BUFFER_COUNT    = 2U;
+
+    uint16_t*               m_buffers[BUFFER_COUNT];        /**< Parallel data words of every buffer */
+    lldesc_t*               m_descs[BUFFER_COUNT];          /**< DMA descriptors of every buffer */
+    volatile uint8_t        m_front;                        /**< Index of the buffer, which is shown */
+    volatile bool           m_isSwapPending;                /**< Is the back buffer requested to be shown? */
+    bool                    m_isBackDirty;                  /**< Is the back buffer changed since the last show()? */
+    intr_handle_t           m_intrHandle;                   /**< I2S interrupt handle */
+    SemaphoreHandle_t       m_xSwapSemaphore;               /**< Given, when the back buffer is shown */
+
+    Hub75Panel(const Hub75Panel& panel);
+    Hub75Panel& operator=(const Hub75Panel& panel);
+
+    /**
+     * Initialize the signal pattern of a buffer with black pixels.
+     *
+     * @param[in] bufferId  Buffer id
+     */
+    void initBuffer(uint8_t bufferId);
+
+    /**
+     * Link the DMA descriptors of a buffer to a ring.
+     *
+     * @param[in] bufferId  Buffer id
+     */
+    void initDescs(uint8_t bufferId);
+
+    /**
+     * Route the parallel output signals to the pins and configure the I2S
+     * peripheral in parallel mode.
+     */
+    void initI2s();
+
+    /**
+     * Handle the end of a refresh cycle. If the back buffer is shown now,
+     * the buffers are swapped.
+     *
+     * @param[in] arg   HUB75 panel chain
+     */
+    static void isr(void* arg);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HUB75PANEL_H__ */
+
+/** @} */
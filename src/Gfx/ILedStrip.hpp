@@ -1,178 +1,127 @@
-/* MIT License
- *
- * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all
- * copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
- * SOFTWARE.
- */
-
-/*******************************************************************************
-    DESCRIPTION
-*******************************************************************************/
-/**
- * @brief  HTTP header
- * @author Andreas Merkle <web@blue-andi.de>
- *
- * @addtogroup web
- *
- * @{
- */
-
-#ifndef __HTTP_HEADER_H__
-#define __HTTP_HEADER_H__
-
-/******************************************************************************
- * Compile Switches
- *****************************************************************************/
-
-/******************************************************************************
- * Includes
- *****************************************************************************/
-#include <WString.h>
-
-/******************************************************************************
- * Macros
- *****************************************************************************/
-
-/******************************************************************************
- * Types and Classes
- *****************************************************************************/
-
-/**
- * Request/Response http header
- */
-class HttpHeader
-{
-public:
-
-    /**
-     * Constructs a empty header.
-     */
-    HttpHeader() :
-        m_name(),
-        m_value()
-    {
-    }
-
-    /**
-     * Constructs header, based on the given values.
-     *
-     * @param[in] name  Field name
-     * @param[in] value Field value
-     */
-    HttpHeader(const String& name, const String& value) :
-        m_name(name),
-        m_value(value)
-    {
-    }
-
-    /**
-     * Constructs a header, based on a single header line.
-     *
-     * @param[in] line  Header line, which contains name and value.
-     */
-    HttpHeader(const String& line) :
-        m_name(),
-        m_value()
-    {
-        parse(line);
-    }
-
-    /**
-     * Destroys the header.
-     */
-    ~HttpHeader()
-    {
-    }
-
-    /**
-     * Get field name.
-     *
-     * @return Field name
-     */
-    const String& getName() const
-    {
-        return m_name;
-    }
-
-    /**
-     * Get field value.
-     *
-     * @return Field value
-     */
-    const String& getValue() const
-    {
-        return m_value;
-    }
-
-    /**
-     * Set field name.
-     *
-     * @param[in] name  Field name
-     */
-    void setName(const String& name)
-    {
-        m_name = name;
-    }
-
-    /**
-     * Set field value.
-     *
-     * @param[in] value Field value
-     */
-    void setValue(const String& value)
-    {
-        m_value = value;
-    }
-
-    /**
-     * Assign a header.
-     *
-     * @param[in] hdr   Header, which to assign.
-     *
-     * @return Header
-     */
-    HttpHeader& operator=(const HttpHeader& hdr);
-
-    /**
-     * Parse "<name>: <value>" string.
-     *
-     * @param[in] line  String line
-     */
-    void parse(const String& line);
-
-    /**
-     * Get header as single line.
-     *
-     * @return Header
-     */
-    String toString() const;
-
-private:
-
-    String  m_name;     /**< Header field name */
-    String  m_value;    /**< Header field value */
-};
-
-/******************************************************************************
- * Functions
- *****************************************************************************/
-
-#endif  /* __HTTP_HEADER_H__ */
-
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  LED strip interface
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __ILEDSTRIP_HPP__
+#define __ILEDSTRIP_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <NeoPixelBus.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Interface of a physical LED strip. Every LED strip transmits its pixel
+ * data independent of the others, which allows to drive several of them
+ * in parallel. A chain of HUB75 panels is driven as a single LED strip too.
+ */
+class ILedStrip
+{
+public:
+
+    /**
+     * Destroys the LED strip interface.
+     */
+    virtual ~ILedStrip()
+    {
+    }
+
+    /**
+     * Initialize the LED strip.
+     */
+    virtual void begin() = 0;
+
+    /**
+     * Start transmitting the pixel data to the LEDs in the background.
+     */
+    virtual void show() = 0;
+
+    /**
+     * Is the last transmission finished?
+     *
+     * @return If ready for another update via show(), it will return true otherwise false.
+     */
+    virtual bool isReady() const = 0;
+
+    /**
+     * Wait until the last transmission is finished, without spending CPU time.
+     *
+     * @param[in] timeout   Max. time to wait in ms
+     *
+     * @return If ready for another update via show(), it will return true otherwise false.
+     */
+    virtual bool waitUntilReady(uint32_t timeout) const = 0;
+
+    /**
+     * Set the color of a single LED.
+     *
+     * @param[in] index Index of the LED in the strip
+     * @param[in] color Color
+     */
+    virtual void setPixelColor(uint16_t index, const RgbColor& color) = 0;
+
+protected:
+
+    /**
+     * Constructs the LED strip interface.
+     */
+    ILedStrip()
+    {
+    }
+
+private:
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __ILEDSTRIP_HPP__ */
+
 /** @} */
\ No newline at end of file
@@ -34,7 +34,14 @@
  *****************************************************************************/
 #include "LedMatrix.h"
 
+#if (0 == LEDMATRIX_HUB75)
+#include "LedStrip.hpp"
+#else   /* (0 == LEDMATRIX_HUB75) */
+#include "Hub75Panel.h"
+#endif  /* (0 == LEDMATRIX_HUB75) */
+
 #include <Util.h>
+#include <math.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -48,6 +55,11 @@
  * Types and classes
  *****************************************************************************/
 
+static_assert(  Board::LedMatrix::stripCount <= LedMatrix::MAX_STRIP_COUNT,
+                "Max. 4 LED strips are supported.");
+static_assert(  0U == (Board::LedMatrix::height % (Board::LedMatrix::stripCount * Board::LedMatrix::panelHeight)),
+                "Every LED strip must drive complete rows of panels.");
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -56,6 +68,9 @@
  * Local Variables
  *****************************************************************************/
 
+/* Initialize the gamma value of the LEDs. */
+const float LedMatrix::GAMMA = 2.8F;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -70,20 +85,405 @@
 
 LedMatrix::LedMatrix() :
     IGfx(Board::LedMatrix::width, Board::LedMatrix::height),
-    m_strip(Board::LedMatrix::width * Board::LedMatrix::height, Board::Pin::ledMatrixDataOutPinNo),
-    m_topo(Board::LedMatrix::width, Board::LedMatrix::height)
+    m_strips(),
+    m_pixelIndex(),
+    m_frame(),
+    m_gamma(),
+    m_lut(),
+    m_limitedLut(),
+    m_histogram(),
+#if (0 != LEDMATRIX_TEMPORAL_DITHERING)
+    m_ditherError(),
+    m_isDitheringEnabled(true),
+#endif  /* (0 != LEDMATRIX_TEMPORAL_DITHERING) */
+    m_brightness(0U),
+    m_brightnessGoal(UINT8_MAX),
+    m_rampBrightness(static_cast<uint16_t>(UINT8_MAX) << 8U),
+    m_isDirty(true),
+    m_isDithering(false),
+    m_maxLoad(MAX_LOAD),
+    m_maxLoadGoal(MAX_LOAD)
 {
+    uint16_t        index   = 0U;
+    uint8_t         stripId = 0U;
+
+    for(stripId = 0U; stripId < STRIP_COUNT; ++stripId)
+    {
+        m_strips[stripId] = createStrip(stripId);
+    }
+
+    updatePixelIndex(ROTATION_0, false);
+
+    /* The gamma correction is calculated only once with full precision. */
+    for(index = 0U; index <= UINT8_MAX; ++index)
+    {
+#if (0 != LEDMATRIX_GAMMA_CORRECTION)
+        const float VALUE = powf(static_cast<float>(index) / UINT8_MAX, GAMMA);
+
+        m_gamma[index] = static_cast<uint16_t>(VALUE * UINT16_MAX + 0.5F);
+#else   /* (0 != LEDMATRIX_GAMMA_CORRECTION) */
+        m_gamma[index] = index * (UINT16_MAX / UINT8_MAX);
+#endif  /* (0 != LEDMATRIX_GAMMA_CORRECTION) */
+    }
+
+    /* Full brightness, until its set explicit. */
+    updateLut(UINT8_MAX);
+    clearHistogram();
 }
 
 LedMatrix::~LedMatrix()
 {
+    uint8_t stripId = 0U;
+
+    for(stripId = 0U; stripId < STRIP_COUNT; ++stripId)
+    {
+        delete m_strips[stripId];
+        m_strips[stripId] = nullptr;
+    }
+}
+
+void LedMatrix::getFrame(uint32_t* frame, size_t length) const
+{
+    if (nullptr != frame)
+    {
+        if (PIXEL_COUNT < length)
+        {
+            length = PIXEL_COUNT;
+        }
+
+        memcpy(frame, m_frame, length * sizeof(m_frame[0]));
+    }
+
+    return;
+}
+
+void LedMatrix::setDithering(bool isEnabled)
+{
+#if (0 != LEDMATRIX_TEMPORAL_DITHERING)
+    /* A dithered frame is output again by show(), because its output
+     * changes from frame to frame. Therefore no need to mark it dirty.
+     */
+    m_isDitheringEnabled = isEnabled;
+#else   /* (0 != LEDMATRIX_TEMPORAL_DITHERING) */
+    UTIL_NOT_USED(isEnabled);
+#endif  /* (0 != LEDMATRIX_TEMPORAL_DITHERING) */
+
+    return;
 }
 
-Color LedMatrix::getColor(int16_t x, int16_t y) const
+bool LedMatrix::setOrientation(Rotation rotation, bool isMirrored)
 {
-    HtmlColor htmlColor = m_strip.GetPixelColor(m_topo.Map(x, y));
+    bool isSupported = false;
+
+    /* The logical geometry can't change, therefore a quarter rotation is
+     * only possible for a square matrix.
+     */
+    if ((ROTATION_0 == rotation) ||
+        (ROTATION_180 == rotation) ||
+        (((ROTATION_90 == rotation) || (ROTATION_270 == rotation)) &&
+         (Board::LedMatrix::width == Board::LedMatrix::height)))
+    {
+        updatePixelIndex(rotation, isMirrored);
+        m_isDirty   = true;
+        isSupported = true;
+    }
+
+    return isSupported;
+}
+
+void LedMatrix::writeSpanUnchecked(int16_t x, int16_t y, const Color* colors, uint16_t length)
+{
+    const uint16_t  FRAME_INDEX = x + y * Board::LedMatrix::width;
+    uint16_t        index       = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        setPixel(FRAME_INDEX + index, colors[index]);
+    }
+
+    return;
+}
+
+void LedMatrix::fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color)
+{
+    const uint32_t  COLOR       = color;
+    const uint16_t  FRAME_INDEX = x + y * Board::LedMatrix::width;
+    uint16_t        index       = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        setPixel(FRAME_INDEX + index, COLOR);
+    }
+
+    return;
+}
+
+void LedMatrix::fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color)
+{
+    const uint32_t  COLOR       = color;
+    uint16_t        frameIndex  = x + y * Board::LedMatrix::width;
+    uint16_t        index       = 0U;
+
+    for(index = 0U; index < length; ++index)
+    {
+        setPixel(frameIndex, COLOR);
+        frameIndex += Board::LedMatrix::width;
+    }
+
+    return;
+}
+
+ILedStrip* LedMatrix::createStrip(uint8_t stripId)
+{
+    ILedStrip* strip = nullptr;
+
+#if (0 == LEDMATRIX_HUB75)
+
+    const uint8_t PIN_NO = Board::LedMatrix::stripDataOutPinNo[stripId];
+
+    /* Every LED strip needs its own RMT channel, which is a compile time
+     * parameter of the output method.
+     */
+    switch(stripId)
+    {
+    case 0U:
+        strip = new LedStrip<NeoEsp32RmtChannel6>(STRIP_PIXEL_COUNT, PIN_NO);
+        break;
+
+    case 1U:
+        strip = new LedStrip<NeoEsp32RmtChannel5>(STRIP_PIXEL_COUNT, PIN_NO);
+        break;
+
+    case 2U:
+        strip = new LedStrip<NeoEsp32RmtChannel4>(STRIP_PIXEL_COUNT, PIN_NO);
+        break;
+
+    case 3U:
+        strip = new LedStrip<NeoEsp32RmtChannel3>(STRIP_PIXEL_COUNT, PIN_NO);
+        break;
+
+    default:
+        break;
+    }
+
+#else   /* (0 == LEDMATRIX_HUB75) */
+
+    /* All HUB75 panels are driven together. */
+    if (0U == stripId)
+    {
+        strip = new Hub75Panel();
+    }
+
+#endif  /* (0 == LEDMATRIX_HUB75) */
+
+    return strip;
+}
+
+void LedMatrix::updatePixelIndex(Rotation rotation, bool isMirrored)
+{
+    const Topology  topo(   Board::LedMatrix::panelWidth,
+                            Board::LedMatrix::panelHeight,
+                            Board::LedMatrix::width / Board::LedMatrix::panelWidth,
+                            STRIP_HEIGHT / Board::LedMatrix::panelHeight);
+    const int16_t   MAX_X   = Board::LedMatrix::width - 1;
+    const int16_t   MAX_Y   = Board::LedMatrix::height - 1;
+    int16_t         x       = 0;
+    int16_t         y       = 0;
+
+    for(y = 0; y < Board::LedMatrix::height; ++y)
+    {
+        for(x = 0; x < Board::LedMatrix::width; ++x)
+        {
+            int16_t srcX        = (false == isMirrored) ? x : (MAX_X - x);
+            int16_t physicalX   = srcX;
+            int16_t physicalY   = y;
+
+            switch(rotation)
+            {
+            case ROTATION_90:
+                physicalX = MAX_Y - y;
+                physicalY = srcX;
+                break;
+
+            case ROTATION_180:
+                physicalX = MAX_X - srcX;
+                physicalY = MAX_Y - y;
+                break;
+
+            case ROTATION_270:
+                physicalX = y;
+                physicalY = MAX_X - srcX;
+                break;
+
+            case ROTATION_0:
+            default:
+                break;
+            }
+
+            /* Every stripe has the same topology. */
+            m_pixelIndex[x + y * Board::LedMatrix::width] =
+                (physicalY / STRIP_HEIGHT) * STRIP_PIXEL_COUNT +
+                topo.Map(physicalX, physicalY % STRIP_HEIGHT);
+        }
+    }
+
+    return;
+}
+
+void LedMatrix::updateLut(uint8_t brightness)
+{
+    uint16_t index = 0U;
+
+    /* The intermediate result needs max. 0xffff * 0xff * 0x100 + 0x7fff,
+     * which fits into 32 bit. Full brightness and full gamma value results
+     * in 0xff00, which is 255 in 8.8 fixed point format.
+     */
+    for(index = 0U; index <= UINT8_MAX; ++index)
+    {
+        const uint32_t VALUE = static_cast<uint32_t>(m_gamma[index]) * brightness * 256U;
+
+        m_lut[index] = (VALUE + (UINT16_MAX / 2U)) / UINT16_MAX;
+    }
+
+    m_brightness = brightness;
+
+    return;
+}
+
+void LedMatrix::rampBrightness()
+{
+    const uint16_t  GOAL    = static_cast<uint16_t>(m_brightnessGoal) << 8U;
+    uint16_t        step    = 0U;
+
+    if (GOAL > m_rampBrightness)
+    {
+        step = (GOAL - m_rampBrightness) >> RAMP_SHIFT;
+
+        if (RAMP_STEP_MIN > step)
+        {
+            step = RAMP_STEP_MIN;
+        }
+
+        if ((GOAL - m_rampBrightness) < step)
+        {
+            m_rampBrightness = GOAL;
+        }
+        else
+        {
+            m_rampBrightness += step;
+        }
+    }
+    else if (GOAL < m_rampBrightness)
+    {
+        step = (m_rampBrightness - GOAL) >> RAMP_SHIFT;
+
+        if (RAMP_STEP_MIN > step)
+        {
+            step = RAMP_STEP_MIN;
+        }
+
+        if ((m_rampBrightness - GOAL) < step)
+        {
+            m_rampBrightness = GOAL;
+        }
+        else
+        {
+            m_rampBrightness -= step;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    /* The lookup table resolution is one digit. */
+    if ((m_rampBrightness >> 8U) != m_brightness)
+    {
+        updateLut(static_cast<uint8_t>(m_rampBrightness >> 8U));
+        m_isDirty = true;
+    }
+
+    return;
+}
+
+void LedMatrix::output()
+{
+    const uint16_t* LUT         = getOutputLut();
+    uint16_t        index       = 0U;
+    uint16_t        fractions   = 0U;
+
+    for(index = 0U; index < PIXEL_COUNT; ++index)
+    {
+        const uint32_t  COLOR   = m_frame[index];
+        const uint16_t  RED     = LUT[(COLOR >> 16U) & 0xffU];
+        const uint16_t  GREEN   = LUT[(COLOR >> 8U) & 0xffU];
+        const uint16_t  BLUE    = LUT[(COLOR >> 0U) & 0xffU];
+        const uint16_t  PIXEL   = m_pixelIndex[index];
+
+#if (0 != LEDMATRIX_TEMPORAL_DITHERING)
+        uint8_t*        error   = &m_ditherError[index * 3U];
+        RgbColor        rgbColor;
+
+        if (true == m_isDitheringEnabled)
+        {
+            rgbColor = RgbColor(dither(RED, error[0]),
+                                dither(GREEN, error[1]),
+                                dither(BLUE, error[2]));
+
+            fractions |= RED | GREEN | BLUE;
+        }
+        else
+        {
+            rgbColor = RgbColor((RED + 0x80U) >> 8U,
+                                (GREEN + 0x80U) >> 8U,
+                                (BLUE + 0x80U) >> 8U);
+        }
+#else   /* (0 != LEDMATRIX_TEMPORAL_DITHERING) */
+        const RgbColor  rgbColor(   (RED + 0x80U) >> 8U,
+                                    (GREEN + 0x80U) >> 8U,
+                                    (BLUE + 0x80U) >> 8U);
+#endif  /* (0 != LEDMATRIX_TEMPORAL_DITHERING) */
+
+        /* The physical index selects the LED strip and its pixel. */
+        m_strips[PIXEL / STRIP_PIXEL_COUNT]->setPixelColor(PIXEL % STRIP_PIXEL_COUNT, rgbColor);
+    }
+
+    /* As long as any color channel has a fractional part, the output
+     * changes from frame to frame.
+     */
+    m_isDithering = (0U != (fractions & 0xffU));
+
+    return;
+}
+
+const uint16_t* LedMatrix::getOutputLut()
+{
+    const uint16_t* lut     = m_lut;
+    uint32_t        load    = 0U;
+    uint16_t        index   = 0U;
+
+    /* Estimate the load of the frame. The load of a full white frame
+     * fits into 32 bit for up to 21845 pixels.
+     */
+    for(index = 0U; index <= UINT8_MAX; ++index)
+    {
+        load += m_histogram[index] * m_lut[index];
+    }
+
+    /* Scale down the whole frame, so the supply is not overloaded. */
+    if (m_maxLoad < load)
+    {
+        const uint32_t SCALE = (static_cast<uint64_t>(m_maxLoad) << 8U) / load;
+
+        for(index = 0U; index <= UINT8_MAX; ++index)
+        {
+            m_limitedLut[index] = (static_cast<uint32_t>(m_lut[index]) * SCALE) >> 8U;
+        }
+
+        lut = m_limitedLut;
+    }
 
-    return Color(htmlColor.Color);
+    return lut;
 }
 
 /******************************************************************************
@@ -40,15 +40,33 @@
  * Compile Switches
  *****************************************************************************/
 
+/**
+ * Apply gamma correction to the colors at output time, which results in a
+ * perceptually linear brightness (1) or not (0).
+ */
+#ifndef LEDMATRIX_GAMMA_CORRECTION
+#define LEDMATRIX_GAMMA_CORRECTION  (1)
+#endif  /* LEDMATRIX_GAMMA_CORRECTION */
+
+/**
+ * Output the colors with temporal dithering (1) or not (0). The lookup
+ * table keeps 8 fractional bits per color channel and the remaining error
+ * is carried from frame to frame, which avoids banding at low brightness.
+ */
+#ifndef LEDMATRIX_TEMPORAL_DITHERING
+#define LEDMATRIX_TEMPORAL_DITHERING  (1)
+#endif  /* LEDMATRIX_TEMPORAL_DITHERING */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <stdint.h>
 #include <IGfx.hpp>
-#include <NeoPixelBrightnessBus.h>
+#include <NeoPixelBus.h>
 #include <ColorDef.hpp>
 
 #include "Board.h"
+#include "ILedStrip.hpp"
 
 /******************************************************************************
  * Macros
@@ -65,6 +83,21 @@ class LedMatrix : public IGfx
 {
 public:
 
+    /**
+     * Rotation of the displayed content on the physical matrix, clockwise.
+     */
+    enum Rotation
+    {
+        ROTATION_0 = 0, /**< Not rotated */
+        ROTATION_90,    /**< Rotated by 90 degree, only for a square matrix */
+        ROTATION_180,   /**< Rotated by 180 degree */
+        ROTATION_270,   /**< Rotated by 270 degree, only for a square matrix */
+        ROTATION_COUNT  /**< Number of rotations */
+    };
+
+    /** Max. number of LED strips, limited by the available RMT channels. */
+    static const uint8_t    MAX_STRIP_COUNT = 4U;
+
     /**
      * Get LED matrix instance.
      *
@@ -84,21 +117,113 @@ public:
      */
     bool begin()
     {
-        m_strip.Begin();
-        m_strip.Show();
+        uint8_t stripId = 0U;
+
+        for(stripId = 0U; stripId < STRIP_COUNT; ++stripId)
+        {
+            m_strips[stripId]->begin();
+            m_strips[stripId]->show();
+        }
 
         return true;
     }
 
     /**
      * Show internal framebuffer on physical LED matrix.
+     * If the framebuffer changed, it is copied to the LED strips in a single
+     * pass, which applies the gamma correction and the brightness.
+     * A pending brightness ramp is moved one step further every call, which
+     * keeps it synchronous to the frames.
+     * All LED strips transmit their data in parallel.
      */
     void show()
     {
-        m_strip.Show();
+        uint8_t stripId = 0U;
+
+        if (true == isRamping())
+        {
+            rampBrightness();
+        }
+
+        /* A changed current limit needs a new output of the framebuffer. */
+        if (m_maxLoadGoal != m_maxLoad)
+        {
+            m_maxLoad = m_maxLoadGoal;
+            m_isDirty = true;
+        }
+
+        if ((true == m_isDirty) ||
+            (true == m_isDithering))
+        {
+            output();
+            m_isDirty = false;
+        }
+
+        for(stripId = 0U; stripId < STRIP_COUNT; ++stripId)
+        {
+            m_strips[stripId]->show();
+        }
+
         return;
     }
 
+    /**
+     * Is the framebuffer changed since the last physical update via show()?
+     * Note, a brightness change will change the framebuffer too.
+     *
+     * @return If the framebuffer is changed, it will return true otherwise false.
+     */
+    bool isDirty() const
+    {
+        return m_isDirty;
+    }
+
+    /**
+     * Is temporal dithering in progress? In this case the framebuffer shall
+     * be shown every frame, even if it is not dirty.
+     *
+     * @return If dithering is in progress, it will return true otherwise false.
+     */
+    bool isDithering() const
+    {
+        return m_isDithering;
+    }
+
+    /**
+     * Enable or disable the temporal dithering. If disabled, the colors are
+     * rounded, which keeps a static frame stable without periodic output.
+     * Without temporal dithering support, it has no effect.
+     *
+     * @param[in] isEnabled Enable (true) or disable (false) it.
+     */
+    void setDithering(bool isEnabled);
+
+    /**
+     * Set the orientation of the displayed content on the physical matrix,
+     * e.g. for panels which are mounted upside down. The transformation is
+     * folded into the pixel index lookup table, so it costs nothing per
+     * pixel and the logical framebuffer stays unchanged.
+     * It shall not be called concurrently to show().
+     *
+     * @param[in] rotation      Rotation clockwise
+     * @param[in] isMirrored    Mirror the content horizontally (true) or not (false).
+     *                          It is applied before the rotation.
+     *
+     * @return If the orientation is supported, it will return true otherwise false.
+     */
+    bool setOrientation(Rotation rotation, bool isMirrored);
+
+    /**
+     * Is a brightness ramp in progress? In this case the framebuffer shall
+     * be shown every frame, until the brightness goal is reached.
+     *
+     * @return If a ramp is in progress, it will return true otherwise false.
+     */
+    bool isRamping() const
+    {
+        return (static_cast<uint16_t>(m_brightnessGoal) << 8U) != m_rampBrightness;
+    }
+
     /**
      * LED matrix is ready, when the last physical pixel update is finished.
      *
@@ -106,53 +231,232 @@ public:
      */
     bool isReady() const
     {
-        return m_strip.CanShow();
+        bool    isReady = true;
+        uint8_t stripId = 0U;
+
+        while((STRIP_COUNT > stripId) && (true == isReady))
+        {
+            isReady = m_strips[stripId]->isReady();
+            ++stripId;
+        }
+
+        return isReady;
+    }
+
+    /**
+     * Wait until the last physical pixel update is finished.
+     * The calling task is blocked until the RMT peripheral signals the
+     * transmission end, which means no CPU time is spent while waiting.
+     *
+     * @param[in] timeout   Max. time to wait in ms
+     *
+     * @return If ready for another update via show(), it will return true otherwise false.
+     */
+    bool waitUntilReady(uint32_t timeout) const
+    {
+        bool    isReady = true;
+        uint8_t stripId = 0U;
+
+        /* The LED strips transmit in parallel, therefore waiting for the
+         * next one is usually short.
+         */
+        while((STRIP_COUNT > stripId) && (true == isReady))
+        {
+            isReady = m_strips[stripId]->waitUntilReady(timeout);
+            ++stripId;
+        }
+
+        return isReady;
     }
 
     /**
      * Set brightness from 0 to 255.
+     * The brightness is not applied immediately, instead it is ramped
+     * frame by frame to the given value via show().
+     * It may be called from any task, because only the goal is written.
+     * To protect the electronic parts, the output is scaled down further, if
+     * the frame content would exceed the max. supply current.
      *
      * @param[in] brightness    Brightness value [0; 255]
      */
     void setBrightness(uint8_t brightness)
     {
-        /* To protect the the electronic parts, the brigntness will be scaled down
-         * according to the max. supply current.
-         */
-        const uint8_t SAFE_BRIGHTNESS =
-            (Board::LedMatrix::supplyCurrentMax * brightness) /
-            (Board::LedMatrix::maxCurrentPerLed * Board::LedMatrix::width *Board::LedMatrix::height);
+        m_brightnessGoal = brightness;
 
-        m_strip.SetBrightness(SAFE_BRIGHTNESS);
         return;
     }
 
+    /**
+     * Set the current limit in percent of the max. supply current.
+     * It throttles the output further, e.g. if the LEDs or the supply get
+     * too hot. Like the brightness it is applied with the next show() and
+     * may be called from any task.
+     *
+     * @param[in] limit Current limit in percent [0; 100]
+     */
+    void setCurrentLimit(uint8_t limit)
+    {
+        if (100U < limit)
+        {
+            limit = 100U;
+        }
+
+        m_maxLoadGoal = (static_cast<uint64_t>(MAX_LOAD) * limit) / 100U;
+
+        return;
+    }
+
+    /**
+     * Get the current limit in percent of the max. supply current.
+     *
+     * @return Current limit in percent [0; 100]
+     */
+    uint8_t getCurrentLimit() const
+    {
+        return (static_cast<uint64_t>(m_maxLoadGoal) * 100U + (MAX_LOAD / 2U)) / MAX_LOAD;
+    }
+
     /**
      * Clear LED matrix.
      */
     void clear()
     {
-        m_strip.ClearTo(ColorDef::BLACK);
+        uint16_t index = 0U;
+
+        for(index = 0U; index < PIXEL_COUNT; ++index)
+        {
+            m_frame[index] = ColorDef::BLACK;
+        }
+
+        clearHistogram();
+        m_isDirty = true;
+
         return;
     }
 
     /**
-     * Get pixel color at given position.
-     *
-     * @param[in] x x-coordinate
-     * @param[in] y y-coordinate
+     * Copy the logical framebuffer, row by row. The display brightness is
+     * not applied.
      *
-     * @return Color in RGB888 format.
+     * @param[out] frame    Framebuffer copy with colors in RGB888 format
+     * @param[in]  length   Number of pixels in the framebuffer copy
      */
-    Color getColor(int16_t x, int16_t y) const final;
+    void getFrame(uint32_t* frame, size_t length) const;
 
 private:
 
-    /** Pixel representation of the LED matrix */
-    NeoPixelBrightnessBus<NeoGrbFeature, Neo800KbpsMethod>  m_strip;
+#if (0 == LEDMATRIX_HUB75)
+
+    /**
+     * Pixel layout of a single LED panel.
+     * See https://github.com/Makuna/NeoPixelBus/wiki/Layout-objects
+     */
+    typedef ColumnMajorAlternatingLayout                        PanelLayout;
+
+#else   /* (0 == LEDMATRIX_HUB75) */
+
+    /** Pixel layout of the HUB75 panels, which are addressed row by row. */
+    typedef RowMajorLayout                                      PanelLayout;
+
+#endif  /* (0 == LEDMATRIX_HUB75) */
+
+    /**
+     * Layout of the LED panels (tiles) in a stripe of the LED matrix.
+     * Only relevant if a stripe consists of more than one panel.
+     */
+    typedef RowMajorLayout                                      TileLayout;
+
+    /** Topology of a stripe, used to map coordinates to the LED strip. */
+    typedef NeoTiles<PanelLayout, TileLayout>                   Topology;
+
+    /** Number of pixels in the LED matrix */
+    static const uint16_t   PIXEL_COUNT     = Board::LedMatrix::width * Board::LedMatrix::height;
+
+    /** Number of LED strips */
+    static const uint8_t    STRIP_COUNT     = Board::LedMatrix::stripCount;
+
+    /** Height of a stripe in pixels, which is driven by one LED strip. */
+    static const uint8_t    STRIP_HEIGHT    = Board::LedMatrix::height / STRIP_COUNT;
 
-    /** Panel topology, used to map coordinates to the framebuffer. */
-    NeoTopology<ColumnMajorAlternatingLayout>               m_topo;
+    /** Number of pixels of a single LED strip */
+    static const uint16_t   STRIP_PIXEL_COUNT   = PIXEL_COUNT / STRIP_COUNT;
+
+    /**
+     * The brightness ramp moves every frame 1 / 2^RAMP_SHIFT of the remaining
+     * distance to the goal, which results in a smooth exponential approach.
+     */
+    static const uint8_t    RAMP_SHIFT      = 3U;
+
+    /** Min. brightness ramp step per frame in 8.8 fixed point format. */
+    static const uint16_t   RAMP_STEP_MIN   = 0x40U;
+
+    /** LED strips, starting with the top stripe. */
+    ILedStrip*                                              m_strips[STRIP_COUNT];
+
+    /**
+     * Physical pixel index for every logical coordinate, row by row. The
+     * index counts over all LED strips, starting with the top stripe.
+     * It is calculated only on orientation change from the topology, which
+     * keeps the mapping arithmetic out of the pixel access.
+     */
+    uint16_t                                                m_pixelIndex[PIXEL_COUNT];
+
+    /**
+     * Logical framebuffer in RGB888 format, row by row. The strip buffer
+     * contains the colors with the brightness applied and in the topology
+     * order, which makes reading back expensive and lossy.
+     */
+    uint32_t                                                m_frame[PIXEL_COUNT];
+
+    /** Gamma correction of every color channel value in 0.16 fixed point format. */
+    uint16_t                                                m_gamma[UINT8_MAX + 1U];
+
+    /**
+     * Lookup table, which maps a color channel value to the LED strip value
+     * in 8.8 fixed point format. It combines the gamma correction and the
+     * brightness and is updated only if the brightness changes.
+     */
+    uint16_t                                                m_lut[UINT8_MAX + 1U];
+
+    /**
+     * Lookup table, which is used instead of the regular one, in case the
+     * frame content exceeds the max. supply current.
+     */
+    uint16_t                                                m_limitedLut[UINT8_MAX + 1U];
+
+    /**
+     * Number of color channels in the logical framebuffer per channel value.
+     * It is updated with every pixel change and allows to estimate the
+     * current of a frame without walking through the whole framebuffer.
+     */
+    uint32_t                                                m_histogram[UINT8_MAX + 1U];
+
+#if (0 != LEDMATRIX_TEMPORAL_DITHERING)
+    /** Fractional part per color channel, which was not output yet. */
+    uint8_t                                                 m_ditherError[PIXEL_COUNT * 3U];
+
+    /** Is the temporal dithering enabled? */
+    bool                                                    m_isDitheringEnabled;
+#endif  /* (0 != LEDMATRIX_TEMPORAL_DITHERING) */
+
+    uint8_t                                                 m_brightness;       /**< Brightness of the lookup table [0; 255] */
+    volatile uint8_t                                        m_brightnessGoal;   /**< Brightness, which the ramp shall reach [0; 255] */
+    uint16_t                                                m_rampBrightness;   /**< Current ramp brightness in 8.8 fixed point format */
+    bool                                                    m_isDirty;          /**< Is the framebuffer changed since the last show()? */
+    bool                                                    m_isDithering;      /**< Is the last output dithered? */
+    uint32_t                                                m_maxLoad;          /**< Max. load of a frame, applied by the current limiter */
+    volatile uint32_t                                       m_maxLoadGoal;      /**< Max. load of a frame, which shall be applied with the next show() */
+
+    /** Gamma value of the LEDs, used for the gamma correction. */
+    static const float                                      GAMMA;
+
+    /**
+     * Max. load of a frame, which is the sum of all color channel values in
+     * 8.8 fixed point format, that the supply can drive. A full white LED
+     * has a load of 3 * 0xff00 and draws the max. current per LED.
+     */
+    static const uint32_t                                   MAX_LOAD    =
+        (Board::LedMatrix::supplyCurrentMax * 3U * 0xff00U) / Board::LedMatrix::maxCurrentPerLed;
 
     /**
      * Construct LED matrix.
@@ -167,31 +471,197 @@ private:
     LedMatrix(const LedMatrix& matrix);
     LedMatrix& operator=(const LedMatrix& matrix);
 
+    /**
+     * Create the LED strip, which drives the given stripe.
+     *
+     * @param[in] stripId   Id of the LED strip [0; MAX_STRIP_COUNT - 1]
+     *
+     * @return LED strip
+     */
+    static ILedStrip* createStrip(uint8_t stripId);
+
+    /**
+     * Calculate the physical pixel index for every logical coordinate.
+     *
+     * @param[in] rotation      Rotation clockwise
+     * @param[in] isMirrored    Mirror the content horizontally (true) or not (false).
+     */
+    void updatePixelIndex(Rotation rotation, bool isMirrored);
+
+    /**
+     * Update the lookup table for the given brightness.
+     *
+     * @param[in] brightness    Brightness [0; 255]
+     */
+    void updateLut(uint8_t brightness);
+
+    /**
+     * Move the brightness one step towards the goal and update the lookup
+     * table, if the integer brightness changed.
+     */
+    void rampBrightness();
+
+    /**
+     * Copy the logical framebuffer to the LED strip, by applying the
+     * lookup table and mapping the coordinates to the topology.
+     */
+    void output();
+
+    /**
+     * Get the lookup table for the output. If the estimated current of
+     * the frame exceeds the max. supply current, a scaled down lookup table
+     * is provided.
+     *
+     * @return Lookup table
+     */
+    const uint16_t* getOutputLut();
+
+    /**
+     * Reset the histogram to a black framebuffer.
+     */
+    void clearHistogram()
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index <= UINT8_MAX; ++index)
+        {
+            m_histogram[index] = 0U;
+        }
+
+        m_histogram[0] = PIXEL_COUNT * 3U;
+
+        return;
+    }
+
+    /**
+     * Update the histogram by replacing a color.
+     *
+     * @param[in] oldColor  Old color in RGB888 format
+     * @param[in] newColor  New color in RGB888 format
+     */
+    void updateHistogram(uint32_t oldColor, uint32_t newColor)
+    {
+        --m_histogram[(oldColor >> 16U) & 0xffU];
+        --m_histogram[(oldColor >> 8U) & 0xffU];
+        --m_histogram[(oldColor >> 0U) & 0xffU];
+        ++m_histogram[(newColor >> 16U) & 0xffU];
+        ++m_histogram[(newColor >> 8U) & 0xffU];
+        ++m_histogram[(newColor >> 0U) & 0xffU];
+
+        return;
+    }
+
+#if (0 != LEDMATRIX_TEMPORAL_DITHERING)
+    /**
+     * Dither a single color channel value. The fractional part, which can't
+     * be output, is carried to the next frame.
+     *
+     * @param[in]       value   Color channel value in 8.8 fixed point format
+     * @param[in,out]   error   Fractional part of the previous frame
+     *
+     * @return Color channel value, which to output
+     */
+    static uint8_t dither(uint16_t value, uint8_t& error)
+    {
+        /* Max. 0xff00 + 0xff, so it can't overflow. */
+        const uint16_t SUM = value + error;
+
+        error = SUM & 0xffU;
+
+        return SUM >> 8U;
+    }
+#endif  /* (0 != LEDMATRIX_TEMPORAL_DITHERING) */
+
+    /**
+     * Set a pixel in the logical framebuffer and mark the framebuffer dirty
+     * on any change.
+     *
+     * @param[in] frameIndex    Index in the logical framebuffer
+     * @param[in] color         Color in RGB888 format
+     */
+    void setPixel(uint16_t frameIndex, uint32_t color)
+    {
+        if (m_frame[frameIndex] != color)
+        {
+            updateHistogram(m_frame[frameIndex], color);
+            m_frame[frameIndex] = color;
+            m_isDirty           = true;
+        }
+
+        return;
+    }
+
+    /**
+     * Get pixel color at given position.
+     * The logical color is returned, which means without the display
+     * brightness applied.
+     * The position is already clipped to the matrix by the caller.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color in RGB888 format.
+     */
+    Color getColorUnchecked(int16_t x, int16_t y) const final
+    {
+        return m_frame[x + y * Board::LedMatrix::width];
+    }
+
     /**
      * Draw a single pixel in the matrix.
+     * The position is already clipped to the matrix by the caller.
      *
      * @param[in] x     x-coordinate
      * @param[in] y     y-coordinate
      * @param[in] color Pixel color in RGB888 format
      */
-    void drawPixel(int16_t x, int16_t y, const Color& color) final
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
     {
-        if ((0 <= x) &&
-            (Board::LedMatrix::width > x) &&
-            (0 <= y) &&
-            (Board::LedMatrix::height > y))
-        {
-            HtmlColor htmlColor = static_cast<uint32_t>(color);
-
-            m_strip.SetPixelColor(m_topo.Map(x, y), htmlColor);
-        }
+        setPixel(x + y * Board::LedMatrix::width, color);
 
         return;
     }
 
+    /**
+     * Write a horizontal run of pixels, starting at the given position.
+     * The pixels are written directly into the logical framebuffer.
+     * The run is already clipped to the matrix by the caller.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Colors of the pixels in RGB888 format
+     * @param[in] length    Number of pixels
+     */
+    void writeSpanUnchecked(int16_t x, int16_t y, const Color* colors, uint16_t length) final;
+
+    /**
+     * Fill a horizontal run of pixels with a single color, starting at the given position.
+     * The pixels are written directly into the logical framebuffer.
+     * The run is already clipped to the matrix by the caller.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color in RGB888 format
+     */
+    void fillSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final;
+
+    /**
+     * Fill a vertical run of pixels with a single color, starting at the given position.
+     * The pixels are written directly into the logical framebuffer, row by row.
+     * The run is already clipped to the matrix by the caller.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] length    Number of pixels
+     * @param[in] color     Color in RGB888 format
+     */
+    void fillVSpanUnchecked(int16_t x, int16_t y, uint16_t length, const Color& color) final;
+
     /**
      * Dim color to black.
-     * A dim ratio of 0 means no change.
+     * A dim ratio of 255 means no change.
+     * The position is already clipped to the matrix by the caller.
      * 
      * Note, the base colors may be destroyed, depends on the color type.
      *
@@ -199,17 +669,12 @@ private:
      * @param[in] y     y-coordinate
      * @param[in] ratio Dim ration [0; 255]
      */
-    void dimPixel(int16_t x, int16_t y, uint8_t ratio) final
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
     {
-        if ((0 <= x) &&
-            (Board::LedMatrix::width > x) &&
-            (0 <= y) &&
-            (Board::LedMatrix::height > y))
-        {
-            RgbColor rgbColor = m_strip.GetPixelColor(m_topo.Map(x, y)).Dim(UINT8_MAX - ratio);
+        uint16_t    frameIndex  = x + y * Board::LedMatrix::width;
+        HtmlColor   htmlColor   = RgbColor(HtmlColor(m_frame[frameIndex])).Dim(ratio);
 
-            m_strip.SetPixelColor(m_topo.Map(x, y), rgbColor);
-        }
+        setPixel(frameIndex, htmlColor.Color);
 
         return;
     }
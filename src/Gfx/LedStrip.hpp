@@ -0,0 +1,162 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  LED strip driven by the RMT peripheral
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __LEDSTRIP_HPP__
+#define __LEDSTRIP_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <NeoPixelBus.h>
+
+#include "ILedStrip.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * LED strip with WS2812 LEDs, which is driven by a dedicated RMT channel.
+ * The RMT peripheral sends the data in the background, while the next frame
+ * can be prepared or another LED strip is driven.
+ *
+ * @tparam TRmtChannel  RMT channel, e.g. NeoEsp32RmtChannel6
+ */
+template < typename TRmtChannel >
+class LedStrip : public ILedStrip
+{
+public:
+
+    /**
+     * Constructs the LED strip.
+     *
+     * @param[in] pixelCount    Number of LEDs
+     * @param[in] pinNo         Data out pin number
+     */
+    LedStrip(uint16_t pixelCount, uint8_t pinNo) :
+        ILedStrip(),
+        m_strip(pixelCount, pinNo)
+    {
+    }
+
+    /**
+     * Destroys the LED strip.
+     */
+    ~LedStrip()
+    {
+    }
+
+    /**
+     * Initialize the LED strip.
+     */
+    void begin() final
+    {
+        m_strip.Begin();
+        return;
+    }
+
+    /**
+     * Start transmitting the pixel data to the LEDs in the background.
+     */
+    void show() final
+    {
+        m_strip.Show();
+        return;
+    }
+
+    /**
+     * Is the last transmission finished?
+     *
+     * @return If ready for another update via show(), it will return true otherwise false.
+     */
+    bool isReady() const final
+    {
+        return m_strip.CanShow();
+    }
+
+    /**
+     * Wait until the last transmission is finished. The calling task is
+     * blocked until the RMT peripheral signals the transmission end.
+     *
+     * @param[in] timeout   Max. time to wait in ms
+     *
+     * @return If ready for another update via show(), it will return true otherwise false.
+     */
+    bool waitUntilReady(uint32_t timeout) const final
+    {
+        return (ESP_OK == rmt_wait_tx_done(TRmtChannel::RmtChannelNumber, pdMS_TO_TICKS(timeout)));
+    }
+
+    /**
+     * Set the color of a single LED.
+     *
+     * @param[in] index Index of the LED in the strip
+     * @param[in] color Color
+     */
+    void setPixelColor(uint16_t index, const RgbColor& color) final
+    {
+        m_strip.SetPixelColor(index, color);
+        return;
+    }
+
+private:
+
+    /** Method to transmit the pixel data to the LEDs. */
+    typedef NeoEsp32RmtMethodBase<NeoEsp32RmtSpeed800Kbps, TRmtChannel> OutputMethod;
+
+    /** Pixel representation of the LED strip */
+    NeoPixelBus<NeoGrbFeature, OutputMethod>    m_strip;
+
+    LedStrip(const LedStrip& strip);
+    LedStrip& operator=(const LedStrip& strip);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LEDSTRIP_HPP__ */
+
+/** @} */
\ No newline at end of file
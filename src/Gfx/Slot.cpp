@@ -69,7 +69,14 @@
 Slot::Slot() :
     m_plugin(nullptr),
     m_duration(DURATION_DEFAULT),
-    m_isLocked(false)
+    m_schedule(),
+    m_isLocked(false),
+    m_profile(),
+    m_watchdog(),
+    m_processTimestamp(0U),
+    m_isProcessed(false),
+    m_updateTimestamp(0U),
+    m_isUpdated(false)
 {
 }
 
@@ -100,12 +107,86 @@ bool Slot::setPlugin(IPluginMaintenance* plugin)
             m_plugin->setSlot(this);
         }
 
+        m_profile.process.clear();
+        m_profile.update.clear();
+        m_profile.active.clear();
+        m_watchdog.reset();
+
+        m_isProcessed   = false;
+        m_isUpdated     = false;
+
         status = true;
     }
 
     return status;
 }
 
+bool Slot::scheduleProcess(uint32_t timestamp)
+{
+    bool isDue = false;
+
+    if (nullptr != m_plugin)
+    {
+        const uint32_t  MIN_PERIOD  = m_watchdog.getMinPeriod();
+        uint32_t        period      = m_plugin->getProcessPeriod();
+
+        if (MIN_PERIOD > period)
+        {
+            period = MIN_PERIOD;
+        }
+
+        if ((IPluginMaintenance::PROCESS_PERIOD_NEVER == period) ||
+            (BudgetWatchdog::LEVEL_EXCEEDED == m_watchdog.getLevel()))
+        {
+            isDue = false;
+        }
+        else if ((false == m_isProcessed) ||
+                 (period <= (timestamp - m_processTimestamp)))
+        {
+            m_processTimestamp  = timestamp;
+            m_isProcessed       = true;
+            isDue               = true;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return isDue;
+}
+
+uint32_t Slot::scheduleUpdate(uint32_t timestamp)
+{
+    uint32_t timeToNextUpdate = IPluginMaintenance::UPDATE_ALWAYS;
+
+    if (nullptr != m_plugin)
+    {
+        const uint32_t  MIN_PERIOD  = m_watchdog.getMinPeriod();
+        const uint32_t  ELAPSED     = timestamp - m_updateTimestamp;
+        uint32_t        period      = m_plugin->getUpdatePeriod();
+
+        if (MIN_PERIOD > period)
+        {
+            period = MIN_PERIOD;
+        }
+
+        if ((IPluginMaintenance::UPDATE_PERIOD_ALWAYS == period) ||
+            (false == m_isUpdated) ||
+            (period <= ELAPSED))
+        {
+            m_updateTimestamp   = timestamp;
+            m_isUpdated         = true;
+        }
+        else
+        {
+            timeToNextUpdate = period - ELAPSED;
+        }
+    }
+
+    return timeToNextUpdate;
+}
+
 bool Slot::isEmpty() const
 {
     return (nullptr == m_plugin) ? true : false;
@@ -121,6 +202,16 @@ void Slot::setDuration(uint32_t duration)
     m_duration = duration;
 }
 
+const Slot::Schedule& Slot::getSchedule() const
+{
+    return m_schedule;
+}
+
+void Slot::setSchedule(const Schedule& schedule)
+{
+    m_schedule = schedule;
+}
+
 void Slot::lock()
 {
     m_isLocked = true;
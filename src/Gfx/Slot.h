@@ -47,6 +47,10 @@
 #include "IPluginMaintenance.hpp"
 #include "ISlotPlugin.hpp"
 
+#include <ProfileStat.h>
+#include <BudgetWatchdog.h>
+#include <SlotPlan.h>
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -62,6 +66,36 @@ class Slot : public ISlotPlugin
 {
 public:
 
+    /**
+     * Runtime profile of the plugged in plugin, measured in CPU cycles.
+     */
+    struct Profile
+    {
+        ProfileStat process;    /**< Plugin process() call */
+        ProfileStat update;     /**< Plugin update() call */
+        ProfileStat active;     /**< Plugin active() call */
+    };
+
+    /**
+     * Schedule of the slot in the slot rotation.
+     */
+    struct Schedule
+    {
+        uint8_t     weight;     /**< How often the slot appears in the rotation [0; SlotPlan::MAX_WEIGHT]. 0 means never. */
+        uint16_t    timeBegin;  /**< Time window begin in minutes of the day */
+        uint16_t    timeEnd;    /**< Time window end in minutes of the day. If equal to the begin, the whole day is meant. */
+
+        /**
+         * Constructs the default schedule: Once per rotation, the whole day.
+         */
+        Schedule() :
+            weight(SlotPlan::DEFAULT_WEIGHT),
+            timeBegin(0U),
+            timeEnd(0U)
+        {
+        }
+    };
+
     /**
      * Constructs a slot.
      */
@@ -111,6 +145,21 @@ public:
      */
     void setDuration(uint32_t duration);
 
+    /**
+     * Get the slot schedule, which controls how often and when the plugin
+     * is shown in the slot rotation.
+     *
+     * @return Slot schedule
+     */
+    const Schedule& getSchedule() const;
+
+    /**
+     * Set the slot schedule.
+     *
+     * @param[in] schedule  Slot schedule
+     */
+    void setSchedule(const Schedule& schedule);
+
     /**
      * Lock slot to protect the plugin against removing it.
      */
@@ -128,6 +177,63 @@ public:
      */
     bool isLocked() const;
 
+    /**
+     * Get runtime profile of the plugged in plugin.
+     * It is cleared, every time a plugin is plugged in or removed.
+     *
+     * @return Runtime profile
+     */
+    Profile& getProfile()
+    {
+        return m_profile;
+    }
+
+    /**
+     * Get the CPU budget watchdog of the plugged in plugin.
+     * It is reset, every time a plugin is plugged in or removed.
+     *
+     * @return CPU budget watchdog
+     */
+    BudgetWatchdog& getWatchdog()
+    {
+        return m_watchdog;
+    }
+
+    /**
+     * Schedule the plugin processing. If the process period of the plugged
+     * in plugin elapsed, the plugin shall be processed now.
+     * The first call after a plugin is plugged in, is always due.
+     * A throttled plugin is processed at most with the min. period of its
+     * watchdog and a plugin, which exceeded its budget, not at all.
+     *
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If the plugin shall be processed, it will return true otherwise false.
+     */
+    bool scheduleProcess(uint32_t timestamp);
+
+    /**
+     * Schedule the plugin update, according to the update period of the
+     * plugged in plugin. If the update period elapsed, the plugin shall be
+     * updated now. The first call after restartUpdate() is always due.
+     * A throttled plugin is updated at most with the min. period of its
+     * watchdog.
+     *
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return Time to next update in ms or IPluginMaintenance::UPDATE_ALWAYS if due now.
+     */
+    uint32_t scheduleUpdate(uint32_t timestamp);
+
+    /**
+     * Restart the update schedule, e.g. after the plugin was activated.
+     * The next call of scheduleUpdate() is due.
+     */
+    void restartUpdate()
+    {
+        m_isUpdated = false;
+    }
+
     /** Default duration in ms */
     static const uint32_t DURATION_DEFAULT  = 30000U;
 
@@ -135,7 +241,14 @@ private:
 
     IPluginMaintenance* m_plugin;   /**< Plugged in slot */
     uint32_t            m_duration; /**< Duration in ms, how long the plugin shall be active. */
+    Schedule            m_schedule; /**< Schedule in the slot rotation. */
     bool                m_isLocked; /**< Is slot locked or not. */
+    Profile             m_profile;  /**< Runtime profile of the plugged in plugin. */
+    BudgetWatchdog      m_watchdog; /**< CPU budget watchdog of the plugged in plugin. */
+    uint32_t            m_processTimestamp; /**< Timestamp in ms of the last plugin processing. */
+    bool                m_isProcessed;      /**< Is the plugged in plugin processed at least once? */
+    uint32_t            m_updateTimestamp;  /**< Timestamp in ms of the last scheduled plugin update. */
+    bool                m_isUpdated;        /**< Is the plugged in plugin updated at least once since restart? */
 
     Slot(const Slot& matrix);
     Slot& operator=(const Slot& matrix);
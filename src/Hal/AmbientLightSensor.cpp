@@ -33,8 +33,11 @@
  * Includes
  *****************************************************************************/
 #include "AmbientLightSensor.h"
+#include "LightSensorDrv.h"
 #include "Board.h"
 
+#include <Logging.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -73,49 +76,173 @@ static const uint16_t   ambientLightLevels[AmbientLightSensor::AMBIENT_LIGHT_LEV
     4095U
 };
 
+/** Upper illuminance limit in lux of every ambient light level, used for a digital light sensor. */
+static const uint32_t   ambientLightLevelsLux[AmbientLightSensor::AMBIENT_LIGHT_LEVEL_MAX - 1] =
+{
+    1UL << AmbientLightSensor::LUX_FRAC_BITS,       /* Pitch black */
+    10UL << AmbientLightSensor::LUX_FRAC_BITS,      /* Night sky */
+    50UL << AmbientLightSensor::LUX_FRAC_BITS,      /* Dark room */
+    500UL << AmbientLightSensor::LUX_FRAC_BITS,     /* Dark overcast */
+    1000UL << AmbientLightSensor::LUX_FRAC_BITS,    /* Overcast day */
+    15000UL << AmbientLightSensor::LUX_FRAC_BITS    /* Full daylight */
+};
+
 /* Set threshold to detect that no LDR is connected.
  * Expected voltage is lower or equal than 3 mV.
  * This corresponds to the absolute dark resistance of the LDR with 1 MOhm.
  */
 const uint16_t  AmbientLightSensor::NO_LDR_THRESHOLD    = (3UL * (Board::adcResolution - 1U)) / Board::adcRefVoltage;
 
-/* Set lower limit for light luminance normalization in lux. */
-const float     AmbientLightSensor::LIMIT_LOW           = 1.0F;
-
-/* Set upper limit for light luminance normalization in lux. */
-const float     AmbientLightSensor::LIMIT_HIGH          = 100000.0F;
-
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
+bool AmbientLightSensor::begin()
+{
+    bool status = true;
+
+    /* A digital light sensor measures by itself. */
+    if (true == LightSensorDrv::getInstance().begin())
+    {
+        LOG_INFO("Digital light sensor is used instead of the LDR.");
+    }
+    else if (nullptr == m_timer)
+    {
+        esp_timer_create_args_t timerArgs;
+        uint16_t                index       = 0U;
+        esp_err_t               ret         = ESP_OK;
+
+        /* Calculate the lookup tables once, instead of using float math every measurement. */
+        for(index = 0U; index < LUT_SIZE; ++index)
+        {
+            const float     LUX_MAX     = static_cast<float>(UINT32_MAX >> LUX_FRAC_BITS);
+            uint32_t        adcValue    = static_cast<uint32_t>(index) << LUT_SHIFT;
+            float           illuminance = 0.0F;
+
+            /* The last entry is only used as upper interpolation point. */
+            if ((Board::adcResolution - 1U) < adcValue)
+            {
+                adcValue = Board::adcResolution - 1U;
+            }
+
+            illuminance = calcIlluminance(static_cast<uint16_t>(adcValue));
+
+            if (LUX_MAX < illuminance)
+            {
+                illuminance = LUX_MAX;
+            }
+
+            m_luxTable[index]   = static_cast<uint32_t>(illuminance * static_cast<float>(1U << LUX_FRAC_BITS));
+            m_normTable[index]  = BrightnessCalc::normalizeIlluminance(m_luxTable[index]);
+        }
+
+        /* Initialize the filter with the current value, to have valid values immediately. */
+        m_filterAcc = static_cast<uint32_t>(readOversampled()) << FILTER_SHIFT;
+
+        timerArgs.callback          = sampleTimerCallback;
+        timerArgs.arg               = this;
+        timerArgs.dispatch_method   = ESP_TIMER_TASK;
+        timerArgs.name              = "ldrSample";
+
+        ret = esp_timer_create(&timerArgs, &m_timer);
+
+        if (ESP_OK != ret)
+        {
+            LOG_ERROR("Failed to create ambient light sample timer: %d", ret);
+            m_timer = nullptr;
+            status  = false;
+        }
+        else
+        {
+            ret = esp_timer_start_periodic(m_timer, SAMPLE_PERIOD * 1000U);
+
+            if (ESP_OK != ret)
+            {
+                LOG_ERROR("Failed to start ambient light sample timer: %d", ret);
+                (void)esp_timer_delete(m_timer);
+                m_timer = nullptr;
+                status  = false;
+            }
+        }
+    }
+
+    return status;
+}
+
+void AmbientLightSensor::end()
+{
+    if (nullptr != m_timer)
+    {
+        (void)esp_timer_stop(m_timer);
+        (void)esp_timer_delete(m_timer);
+        m_timer = nullptr;
+    }
+
+    return;
+}
+
 bool AmbientLightSensor::isSensorAvailable()
 {
-    const uint16_t  ADC_UINT16  = Board::ldrIn.read();
-    bool            isAvailable = false;
+    bool isAvailable = false;
 
-    if (NO_LDR_THRESHOLD < ADC_UINT16)
+    if (true == LightSensorDrv::getInstance().isAvailable())
     {
         isAvailable = true;
     }
+    else if (NO_LDR_THRESHOLD < getAdcValue())
+    {
+        isAvailable = true;
+    }
+    else
+    {
+        ;
+    }
 
     return isAvailable;
 }
 
+bool AmbientLightSensor::isEventDriven() const
+{
+    return LightSensorDrv::getInstance().isAvailable();
+}
+
+uint32_t AmbientLightSensor::getChangeCount() const
+{
+    return LightSensorDrv::getInstance().getChangeCount();
+}
+
 AmbientLightSensor::AmbientLightLevel AmbientLightSensor::getAmbientLightLevel()
 {
-    uint16_t            adcValue    = Board::ldrIn.read();
     uint8_t             levelIndex  = 0U;
     AmbientLightLevel   level       = AMBIENT_LIGHT_LEVEL_MAX;
 
-    while((AMBIENT_LIGHT_LEVEL_MAX >= levelIndex) && (AMBIENT_LIGHT_LEVEL_MAX == level))
+    if (true == LightSensorDrv::getInstance().isAvailable())
     {
-        if (ambientLightLevels[levelIndex] >= adcValue)
+        const uint32_t ILLUMINANCE = LightSensorDrv::getInstance().getIlluminance();
+
+        while((AMBIENT_LIGHT_LEVEL_MAX > (levelIndex + 1U)) && (AMBIENT_LIGHT_LEVEL_MAX == level))
         {
-            level = static_cast<AmbientLightLevel>(levelIndex);
+            if (ambientLightLevelsLux[levelIndex] >= ILLUMINANCE)
+            {
+                level = static_cast<AmbientLightLevel>(levelIndex);
+            }
+
+            ++levelIndex;
         }
+    }
+    else
+    {
+        uint16_t adcValue = getAdcValue();
+
+        while((AMBIENT_LIGHT_LEVEL_MAX >= levelIndex) && (AMBIENT_LIGHT_LEVEL_MAX == level))
+        {
+            if (ambientLightLevels[levelIndex] >= adcValue)
+            {
+                level = static_cast<AmbientLightLevel>(levelIndex);
+            }
 
-        ++levelIndex;
+            ++levelIndex;
+        }
     }
 
     if (AMBIENT_LIGHT_LEVEL_MAX == level)
@@ -128,10 +255,108 @@ AmbientLightSensor::AmbientLightLevel AmbientLightSensor::getAmbientLightLevel()
 
 float AmbientLightSensor::getIlluminance()
 {
-    const uint16_t  ADC_UINT16  = Board::ldrIn.read();
-    float           illuminance = 0.0F;
+    float illuminance = 0.0F;
+
+    if (true == LightSensorDrv::getInstance().isAvailable())
+    {
+        illuminance = static_cast<float>(LightSensorDrv::getInstance().getIlluminance()) / static_cast<float>(1U << LUX_FRAC_BITS);
+    }
+    else
+    {
+        const uint16_t ADC_UINT16 = getAdcValue();
+
+        if (NO_LDR_THRESHOLD < ADC_UINT16)
+        {
+            const uint32_t LUX_FIXED = lookup(m_luxTable, ADC_UINT16);
+
+            illuminance = static_cast<float>(LUX_FIXED) / static_cast<float>(1U << LUX_FRAC_BITS);
+        }
+    }
+
+    return illuminance;
+}
+
+uint16_t AmbientLightSensor::getNormalizedLight()
+{
+    uint16_t lightNormalized = 0U;
+
+    if (true == LightSensorDrv::getInstance().isAvailable())
+    {
+        lightNormalized = BrightnessCalc::normalizeIlluminance(LightSensorDrv::getInstance().getIlluminance());
+    }
+    else
+    {
+        const uint16_t ADC_UINT16 = getAdcValue();
+
+        if (NO_LDR_THRESHOLD < ADC_UINT16)
+        {
+            lightNormalized = lookup(m_normTable, ADC_UINT16);
+        }
+    }
+
+    return lightNormalized;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void AmbientLightSensor::sampleTimerCallback(void* arg)
+{
+    AmbientLightSensor* sensor = static_cast<AmbientLightSensor*>(arg);
+
+    if (nullptr != sensor)
+    {
+        const uint32_t  SAMPLE  = readOversampled();
+        uint32_t        acc     = sensor->m_filterAcc;
+
+        /* IIR low pass: y += (x - y) / 2^FILTER_SHIFT */
+        acc = acc - (acc >> FILTER_SHIFT) + SAMPLE;
+
+        sensor->m_filterAcc = acc;
+    }
+
+    return;
+}
+
+uint16_t AmbientLightSensor::readOversampled()
+{
+    uint32_t    sum     = 0U;
+    uint8_t     index   = 0U;
+
+    for(index = 0U; index < OVERSAMPLING; ++index)
+    {
+        sum += Board::ldrIn.read();
+    }
+
+    return static_cast<uint16_t>(sum / OVERSAMPLING);
+}
+
+uint16_t AmbientLightSensor::getAdcValue() const
+{
+    uint16_t adcValue = 0U;
+
+    if (nullptr == m_timer)
+    {
+        adcValue = Board::ldrIn.read();
+    }
+    else
+    {
+        adcValue = static_cast<uint16_t>(m_filterAcc >> FILTER_SHIFT);
+    }
+
+    return adcValue;
+}
+
+float AmbientLightSensor::calcIlluminance(uint16_t adcValue)
+{
+    float illuminance = 0.0F;
 
-    if (NO_LDR_THRESHOLD < ADC_UINT16)
+    if (0U < adcValue)
     {
         /* LDR GL5528
         * from datasheet:
@@ -199,7 +424,7 @@ float AmbientLightSensor::getIlluminance()
         */
         const float ADC_MAX         = static_cast<float>(Board::adcResolution - 1U);
         const float R               = 1000.0F;  /* Resistor in the voltage divider, connected to GND. */
-        const float ADC_FLOAT       = static_cast<float>(ADC_UINT16);
+        const float ADC_FLOAT       = static_cast<float>(adcValue);
 
         illuminance = MULTIPLICATOR * powf( ( ADC_MAX * R - ADC_FLOAT * R ) / ADC_FLOAT, EXPONENT );
     }
@@ -207,46 +432,6 @@ float AmbientLightSensor::getIlluminance()
     return illuminance;
 }
 
-float AmbientLightSensor::getNormalizedLight()
-{
-    float illuminance = getIlluminance();
-
-    return calcNormalizedLight(illuminance);
-}
-
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
-
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
-
-float AmbientLightSensor::calcNormalizedLight(float illuminance)
-{
-    const float LIGHT_NORM_MIN  = 0.0F;
-    const float LIGHT_NORM_MAX  = 1.0F;
-    float       lightNormalized = 0.0F;         /* Range: 0.0f - 1.0f */
-
-    if (LIMIT_LOW > illuminance)
-    {
-        lightNormalized = LIGHT_NORM_MIN;
-    }
-    else if (LIMIT_HIGH < illuminance)
-    {
-        lightNormalized = LIGHT_NORM_MAX;
-    }
-    else
-    {
-        /* Map lux values to human perception, according to
-         * https://docs.microsoft.com/en-us/windows/win32/sensorsapi/understanding-and-interpreting-lux-values
-         */
-        lightNormalized = log10f(illuminance) / 5.0F;
-    }
-
-    return lightNormalized;
-}
-
 /******************************************************************************
  * External Functions
  *****************************************************************************/
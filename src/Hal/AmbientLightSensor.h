@@ -45,6 +45,8 @@
  *****************************************************************************/
 #include <Arduino.h>
 #include <Board.h>
+#include <esp_timer.h>
+#include <BrightnessCalc.h>
 
 /******************************************************************************
  * Macros
@@ -56,6 +58,9 @@
 
 /**
  * Ambient light sensor
+ *
+ * If a digital light sensor is available, it is used instead of the LDR.
+ * It reports light changes by itself, so there is no need to poll it.
  */
 class AmbientLightSensor
 {
@@ -73,6 +78,23 @@ public:
         return instance;
     }
 
+    /**
+     * Start the continuous sampling of the ambient light sensor.
+     * If a digital light sensor is detected, it is used and the LDR is not
+     * sampled. Otherwise the ADC is sampled periodically by a high resolution
+     * timer, the samples are oversampled and low pass filtered. Additional
+     * the lookup tables for the illuminance and the normalized light are
+     * calculated.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool begin(void);
+
+    /**
+     * Stop the continuous sampling of the ambient light sensor.
+     */
+    void end(void);
+
     /**
      * Checks whether a sensor is available or not.
      *
@@ -80,6 +102,22 @@ public:
      */
     bool isSensorAvailable(void);
 
+    /**
+     * Does the sensor report light changes by itself? In this case a new
+     * measurement is only available after the change count changed.
+     *
+     * @return If the sensor reports changes, it will return true otherwise false.
+     */
+    bool isEventDriven(void) const;
+
+    /**
+     * Get the number of light changes, which were reported by the sensor.
+     * Only valid, if the sensor is event driven.
+     *
+     * @return Number of light changes
+     */
+    uint32_t getChangeCount(void) const;
+
     /**
      * Ambient light level
      * Source: https://docs.microsoft.com/de-de/windows-hardware/design/whitepapers/integrating-ambient-light-sensors-with-computers-running-windows-10-creators-update
@@ -111,12 +149,12 @@ public:
     float getIlluminance(void);
 
     /**
-     * Get the normalized light value in the range of 0.0f - 1.0f, from
-     * 0 to 100000 Lux.
+     * Get the normalized light value in the range of [0; UINT16_MAX], from
+     * 1 to 100000 Lux on a logarithmic scale.
      *
      * @return Normalized light value
      */
-    float getNormalizedLight(void);
+    uint16_t getNormalizedLight(void);
 
     /**
      * Threshold to detect a not connected LDR.
@@ -124,17 +162,45 @@ public:
     static const uint16_t   NO_LDR_THRESHOLD;
 
     /**
-     * Lower limit for light luminance normalization in lux.
+     * Sample period in ms.
+     */
+    static const uint32_t   SAMPLE_PERIOD   = 10U;
+
+    /**
+     * Number of ADC conversions, which are averaged per sample.
+     */
+    static const uint8_t    OVERSAMPLING    = 4U;
+
+    /**
+     * Shift of the IIR low pass filter, which results in a filter
+     * coefficient of 1 / 2^FILTER_SHIFT. With the sample period this is
+     * a time constant of about 160 ms.
+     */
+    static const uint8_t    FILTER_SHIFT    = 4U;
+
+    /**
+     * Shift from the ADC value to the lookup table index. Every table
+     * entry covers 2^LUT_SHIFT ADC digits.
      */
-    static const float      LIMIT_LOW;
+    static const uint8_t    LUT_SHIFT       = 5U;
 
     /**
-     * Upper limit for light luminance normalization in lux.
+     * Number of lookup table entries, incl. the one for the upper limit.
      */
-    static const float      LIMIT_HIGH;
+    static const uint16_t   LUT_SIZE        = (Board::adcResolution >> LUT_SHIFT) + 1U;
+
+    /**
+     * Number of fractional bits of the illuminance in the lookup table.
+     */
+    static const uint8_t    LUX_FRAC_BITS   = BrightnessCalc::LUX_FRAC_BITS;
 
 private:
 
+    esp_timer_handle_t  m_timer;                /**< Sample timer */
+    volatile uint32_t   m_filterAcc;            /**< IIR filter accumulator, scaled by 2^FILTER_SHIFT */
+    uint32_t            m_luxTable[LUT_SIZE];   /**< Illuminance in lux, fixed-point with LUX_FRAC_BITS */
+    uint16_t            m_normTable[LUT_SIZE];  /**< Normalized light, scaled to [0; UINT16_MAX] */
+
     /* An instance shall not be copied. */
     AmbientLightSensor(const AmbientLightSensor& sensor);
     AmbientLightSensor& operator=(const AmbientLightSensor& sensor);
@@ -142,7 +208,11 @@ private:
     /**
      * Constructs an ambilight instance.
      */
-    AmbientLightSensor()
+    AmbientLightSensor() :
+        m_timer(nullptr),
+        m_filterAcc(0U),
+        m_luxTable(),
+        m_normTable()
     {
     }
 
@@ -151,16 +221,59 @@ private:
      */
     ~AmbientLightSensor()
     {
+        end();
     }
 
     /**
-     * Calculate the normalized light value in the range of 0.0f - 1.0f, from
-     * 0 to 100000 Lux.
+     * Sample timer callback, which runs in the timer task context.
+     * It averages several ADC conversions and feeds the IIR filter.
      *
-     * @param[in] illuminance   Illuminance in Lux
-     * @return Normalized light value
+     * @param[in] arg   Ambient light sensor instance
+     */
+    static void sampleTimerCallback(void* arg);
+
+    /**
+     * Read the averaged raw ADC value of the LDR.
+     *
+     * @return ADC value
+     */
+    static uint16_t readOversampled(void);
+
+    /**
+     * Get the filtered ADC value. If the sampling is not running, the
+     * ADC will be read directly.
+     *
+     * @return ADC value
+     */
+    uint16_t getAdcValue(void) const;
+
+    /**
+     * Calculate the illuminance in lux from the ADC value.
+     * Used to build the lookup table.
+     *
+     * @param[in] adcValue  ADC value
+     * @return Illuminance in lux
+     */
+    float calcIlluminance(uint16_t adcValue);
+
+    /**
+     * Lookup the given ADC value in a table and linear interpolate
+     * between the neighbour entries.
+     *
+     * @param[in] table     Lookup table with LUT_SIZE entries
+     * @param[in] adcValue  ADC value
+     * @return Interpolated table value
      */
-    float calcNormalizedLight(float illuminance);
+    template < typename T >
+    static T lookup(const T* table, uint16_t adcValue)
+    {
+        const uint32_t  INDEX   = adcValue >> LUT_SHIFT;
+        const uint32_t  FRAC    = adcValue & ((1U << LUT_SHIFT) - 1U);
+        const uint64_t  LOW     = table[INDEX];
+        const uint64_t  HIGH    = table[INDEX + 1U];
+
+        return static_cast<T>((LOW * ((1U << LUT_SHIFT) - FRAC) + HIGH * FRAC) >> LUT_SHIFT);
+    }
 };
 
 /******************************************************************************
@@ -65,9 +65,13 @@ static const IoPin* ioPinList[] =
 {
     &onBoardLedOut,
     &userButtonIn,
+#if (0 == LEDMATRIX_HUB75)
     &testPinOut,
     &ledMatrixDataOut,
-    &ldrIn
+#endif  /* (0 == LEDMATRIX_HUB75) */
+    &ldrIn,
+    &lightSensorIntIn,
+    &ntcIn
 };
 
 /******************************************************************************
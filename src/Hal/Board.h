@@ -45,6 +45,14 @@
  * Compiler Switches
  *****************************************************************************/
 
+/**
+ * The LED matrix consists of HUB75 RGB panels (1), which are driven via
+ * I2S parallel DMA, or of WS2812 LED strips (0), which are driven via RMT.
+ */
+#ifndef LEDMATRIX_HUB75
+#define LEDMATRIX_HUB75 (0)
+#endif  /* LEDMATRIX_HUB75 */
+
 /** Electronic board abstraction */
 namespace Board
 {
@@ -70,14 +78,80 @@ namespace Pin
     /** Pin number of user button */
     static const uint8_t    userButtonPinNo         = 4U;
 
+#if (0 == LEDMATRIX_HUB75)
+
     /** Pin number of test pin */
     static const uint8_t    testPinNo               = 23U;
 
     /** Pin number of LED matrix data out */
     static const uint8_t    ledMatrixDataOutPinNo   = 27U;
 
+#else   /* (0 == LEDMATRIX_HUB75) */
+
+    /** Pin number of HUB75 red data of the upper half */
+    static const uint8_t    hub75R1PinNo            = 27U;
+
+    /** Pin number of HUB75 green data of the upper half */
+    static const uint8_t    hub75G1PinNo            = 13U;
+
+    /** Pin number of HUB75 blue data of the upper half */
+    static const uint8_t    hub75B1PinNo            = 14U;
+
+    /** Pin number of HUB75 red data of the lower half */
+    static const uint8_t    hub75R2PinNo            = 12U;
+
+    /** Pin number of HUB75 green data of the lower half */
+    static const uint8_t    hub75G2PinNo            = 16U;
+
+    /** Pin number of HUB75 blue data of the lower half */
+    static const uint8_t    hub75B2PinNo            = 17U;
+
+    /** Pin number of HUB75 row address A */
+    static const uint8_t    hub75APinNo             = 5U;
+
+    /** Pin number of HUB75 row address B */
+    static const uint8_t    hub75BPinNo             = 19U;
+
+    /** Pin number of HUB75 row address C */
+    static const uint8_t    hub75CPinNo             = 25U;
+
+    /** Pin number of HUB75 row address D */
+    static const uint8_t    hub75DPinNo             = 26U;
+
+    /** Pin number of HUB75 latch */
+    static const uint8_t    hub75LatPinNo           = 33U;
+
+    /** Pin number of HUB75 output enable (low active) */
+    static const uint8_t    hub75OePinNo            = 15U;
+
+    /** Pin number of HUB75 clock */
+    static const uint8_t    hub75ClkPinNo           = 23U;
+
+#endif  /* (0 == LEDMATRIX_HUB75) */
+
     /** Pin number of LDR in */
     static const uint8_t    ldrInPinNo              = 34U;
+
+    /** Pin number of I2S microphone serial clock */
+    static const uint8_t    micSckPinNo             = 26U;
+
+    /** Pin number of I2S microphone word select */
+    static const uint8_t    micWsPinNo              = 25U;
+
+    /** Pin number of I2S microphone serial data in */
+    static const uint8_t    micSdInPinNo            = 33U;
+
+    /** Pin number of I2C serial data, used by the optional RTC and light sensor */
+    static const uint8_t    i2cSdaPinNo             = 21U;
+
+    /** Pin number of I2C serial clock, used by the optional RTC and light sensor */
+    static const uint8_t    i2cSclPinNo             = 22U;
+
+    /** Pin number of the optional light sensor interrupt */
+    static const uint8_t    lightSensorIntPinNo     = 18U;
+
+    /** Pin number of the optional NTC in, which measures the LED temperature */
+    static const uint8_t    ntcInPinNo              = 35U;
 };
 
 /** Digital output pin: Onboard LED */
@@ -86,31 +160,78 @@ static const DOutPin<Pin::onBoardLedPinNo>              onBoardLedOut;
 /** Digital input pin: User button (input with pull-up) */
 static const DInPin<Pin::userButtonPinNo, INPUT_PULLUP> userButtonIn;
 
+#if (0 == LEDMATRIX_HUB75)
+
 /** Digital output pin: Test pin (only for debug purposes) */
 static const DOutPin<Pin::testPinNo>                    testPinOut;
 
 /** Digital output pin: LED matrix data out */
 static const DOutPin<Pin::ledMatrixDataOutPinNo>        ledMatrixDataOut;
 
+#endif  /* (0 == LEDMATRIX_HUB75) */
+
 /** Analog input pin: LDR in */
 static const AnalogPin<Pin::ldrInPinNo>                 ldrIn;
 
+/** Digital input pin: Light sensor interrupt (low active, open drain) */
+static const DInPin<Pin::lightSensorIntPinNo, INPUT_PULLUP> lightSensorIntIn;
+
+/** Analog input pin: Optional NTC in */
+static const AnalogPin<Pin::ntcInPinNo>                 ntcIn;
+
 /** ADC resolution in digits */
 static const uint16_t   adcResolution   = 4096U;
 
 /** ADC reference voltage in mV */
 static const uint16_t   adcRefVoltage   = 3300U;
 
+/**
+ * Is the I2S microphone available? With HUB75 panels its pins are used to
+ * drive the panels.
+ */
+static const bool       isMicAvailable  = (0 == LEDMATRIX_HUB75);
+
+/** Number of buttons */
+static const uint8_t    buttonCount     = 1U;
+
+/** Pin number of every button. The buttons are low active inputs with pull-up. */
+static const uint8_t    buttonPinNo[buttonCount] =
+{
+    Pin::userButtonPinNo
+};
+
 /** LED matrix specific values */
 namespace LedMatrix
 {
 
+#if (0 == LEDMATRIX_HUB75)
+
 /** LED matrix width in pixels */
 static const uint8_t    width               = 32U;
 
 /** LED matrix height in pixels */
 static const uint8_t    height              = 8U;
 
+/** Width of a single LED panel in pixels. A LED matrix may consist of several panels (tiles). */
+static const uint8_t    panelWidth          = width;
+
+/** Height of a single LED panel in pixels. A LED matrix may consist of several panels (tiles). */
+static const uint8_t    panelHeight         = height;
+
+/**
+ * Number of LED strips, which are driven in parallel. The LED matrix is split
+ * horizontally into stripes of equal height and every stripe is driven by its
+ * own LED strip on a separate data out pin. A stripe consists of one or more
+ * panels.
+ */
+static const uint8_t    stripCount          = 1U;
+
+/** Data out pin number of every LED strip, starting with the top stripe. */
+static const uint8_t    stripDataOutPinNo[stripCount] =
+{
+    Pin::ledMatrixDataOutPinNo
+};
+
 /** LED matrix supply voltage in volt */
 static const uint8_t    supplyVoltage       = 5U;
 
@@ -123,8 +244,76 @@ static const uint32_t   maxCurrentPerLed    = 60U;
 /** Time to load the data for one single pixel in us. */
 static const uint32_t   pixelLoadTime       = 30U;
 
-/** Time to load the data of the whole matrix in ms. */
-static const uint32_t   matrixLoadTime      = ((width * height) * pixelLoadTime + 500U) / 1000U;
+/** Time to load the data of the whole matrix in ms. All LED strips are loaded in parallel. */
+static const uint32_t   matrixLoadTime      = (((width * height) / stripCount) * pixelLoadTime + 500U) / 1000U;
+
+#else   /* (0 == LEDMATRIX_HUB75) */
+
+/** LED matrix width in pixels, which is the sum of all chained HUB75 panels. */
+static const uint8_t    width               = 64U;
+
+/** LED matrix height in pixels. Max. 32 rows with 1/16 scan are supported. */
+static const uint8_t    height              = 32U;
+
+/**
+ * Width of a single LED panel in pixels. Chained HUB75 panels behave like
+ * one wide panel, because their shift registers are connected in series.
+ */
+static const uint8_t    panelWidth          = width;
+
+/** Height of a single LED panel in pixels. */
+static const uint8_t    panelHeight         = height;
+
+/** Number of LED strips. All HUB75 panels are driven by one I2S peripheral. */
+static const uint8_t    stripCount          = 1U;
+
+/** LED matrix supply voltage in volt */
+static const uint8_t    supplyVoltage       = 5U;
+
+/** LED matrix max. supply current in mA */
+static const uint32_t   supplyCurrentMax    = 4000U;
+
+/**
+ * Max. average current in mA per LED. With 1/16 scan only every 16th row
+ * is lit at a time.
+ */
+static const uint32_t   maxCurrentPerLed    = 4U;
+
+/** HUB75 clock frequency in Hz */
+static const uint32_t   hub75ClockFreq      = 10000000U;
+
+/**
+ * The panels are refreshed continuously by DMA. A new frame is shown after
+ * the running refresh cycle, which is the time in ms to wait for.
+ */
+static const uint32_t   matrixLoadTime      = 8U;
+
+#endif  /* (0 == LEDMATRIX_HUB75) */
+
+};
+
+/**
+ * Optional NTC, which is placed at the LED matrix to measure its temperature.
+ * It is connected between the NTC in pin and GND, with a series resistor
+ * to the ADC reference voltage.
+ */
+namespace Ntc
+{
+
+/** Is the NTC assembled? */
+static const bool       isAvailable         = false;
+
+/** Resistance of the series resistor in ohm */
+static const uint32_t   seriesResistance    = 10000U;
+
+/** NTC resistance in ohm at the nominal temperature */
+static const uint32_t   nominalResistance   = 10000U;
+
+/** Nominal temperature in degree Celsius */
+static const uint8_t    nominalTemperature  = 25U;
+
+/** NTC B-value in K */
+static const uint16_t   beta                = 3950U;
 
 };
 
@@ -36,6 +36,7 @@
 #include "Board.h"
 
 #include <Logging.h>
+#include <Util.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -49,6 +50,9 @@
  * Types and classes
  *****************************************************************************/
 
+static_assert(  Board::buttonCount <= 32U,
+                "Max. 32 buttons are supported, because of the task notification bits.");
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -59,16 +63,20 @@ static void IRAM_ATTR isrButton(void* arg);
  * Local Variables
  *****************************************************************************/
 
+/** Button task handle, which is notified by the button ISRs. */
+static TaskHandle_t gButtonTaskHandle   = nullptr;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 ButtonDrv::Ret ButtonDrv::init()
 {
-    Ret         ret     = RET_OK;
-    BaseType_t  osRet   = pdFAIL;
+    Ret         ret         = RET_OK;
+    BaseType_t  osRet       = pdFAIL;
+    uint8_t     buttonId    = 0U;
 
-    /* Create semaphore to protect button state member. */
+    /* Create semaphore to protect button states and subscribers. */
     m_semaphore = xSemaphoreCreateBinary();
 
     if (nullptr == m_semaphore)
@@ -82,7 +90,13 @@ ButtonDrv::Ret ButtonDrv::init()
     }
     else
     {
-        /* Create button task for debouncing */
+        for(buttonId = 0U; buttonId < Board::buttonCount; ++buttonId)
+        {
+            pinMode(Board::buttonPinNo[buttonId], INPUT_PULLUP);
+            m_state[buttonId] = STATE_UNKNOWN;
+        }
+
+        /* Create a single button task for debouncing all buttons. */
         osRet = xTaskCreateUniversal(   buttonTask,
                                         "buttonTask",
                                         BUTTON_TASK_STACKE_SIZE,
@@ -104,21 +118,52 @@ ButtonDrv::Ret ButtonDrv::init()
     return ret;
 }
 
-ButtonDrv::State ButtonDrv::getState()
+ButtonDrv::State ButtonDrv::getState(uint8_t buttonId)
 {
     State state = STATE_UNKNOWN;
 
-    if (pdTRUE != xSemaphoreTake(m_semaphore, portMAX_DELAY))
+    if ((Board::buttonCount > buttonId) &&
+        (nullptr != m_semaphore))
     {
-        LOG_WARNING("Update of button state not possible.");
+        if (pdTRUE != xSemaphoreTake(m_semaphore, portMAX_DELAY))
+        {
+            LOG_WARNING("Update of button state not possible.");
+        }
+        else
+        {
+            state = m_state[buttonId];
+
+            if (pdTRUE != xSemaphoreGive(m_semaphore))
+            {
+                LOG_FATAL("Can't give semaphore back.");
+            }
+        }
     }
-    else
+
+    return state;
+}
+
+bool ButtonDrv::subscribe(EventQueue& queue, NotifyFunc notify)
+{
+    bool    isSuccessful    = false;
+    uint8_t index           = 0U;
+
+    if ((nullptr != m_semaphore) &&
+        (pdTRUE == xSemaphoreTake(m_semaphore, portMAX_DELAY)))
     {
-        state = m_state;
+        /* Old events are not of interest. */
+        queue.clear();
 
-        if (STATE_TRIGGERED == m_state)
+        while((MAX_SUBSCRIBERS > index) && (false == isSuccessful))
         {
-            m_state = STATE_RELEASED;
+            if (nullptr == m_subscribers[index])
+            {
+                m_subscribers[index]    = &queue;
+                m_notify[index]         = notify;
+                isSuccessful            = true;
+            }
+
+            ++index;
         }
 
         if (pdTRUE != xSemaphoreGive(m_semaphore))
@@ -127,7 +172,32 @@ ButtonDrv::State ButtonDrv::getState()
         }
     }
 
-    return state;
+    return isSuccessful;
+}
+
+void ButtonDrv::unsubscribe(EventQueue& queue)
+{
+    uint8_t index = 0U;
+
+    if ((nullptr != m_semaphore) &&
+        (pdTRUE == xSemaphoreTake(m_semaphore, portMAX_DELAY)))
+    {
+        for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+        {
+            if (&queue == m_subscribers[index])
+            {
+                m_subscribers[index]    = nullptr;
+                m_notify[index]         = nullptr;
+            }
+        }
+
+        if (pdTRUE != xSemaphoreGive(m_semaphore))
+        {
+            LOG_FATAL("Can't give semaphore back.");
+        }
+    }
+
+    return;
 }
 
 /******************************************************************************
@@ -140,81 +210,161 @@ ButtonDrv::State ButtonDrv::getState()
 
 void ButtonDrv::buttonTask(void *parameters)
 {
-    ButtonDrv* buttonDrv = reinterpret_cast<ButtonDrv*>(parameters);
+    ButtonDrv*  buttonDrv   = reinterpret_cast<ButtonDrv*>(parameters);
+    TickType_t  waitTime    = pdMS_TO_TICKS(BUTTON_TASK_PERIOD);
+    uint8_t     buttonId    = 0U;
+
+    gButtonTaskHandle = xTaskGetCurrentTaskHandle();
 
     /* The ISR shall notify about on change to determine whether the
-     * pin state is stable or not.
+     * pin state is stable or not. Every button has its own notification bit.
      */
-    attachInterruptArg( Board::userButtonIn.getPinNo(),
-                        isrButton,
-                        buttonDrv->m_buttonTaskHandle,
-                        CHANGE);
+    for(buttonId = 0U; buttonId < Board::buttonCount; ++buttonId)
+    {
+        attachInterruptArg( Board::buttonPinNo[buttonId],
+                            isrButton,
+                            reinterpret_cast<void*>(static_cast<uintptr_t>(buttonId)),
+                            CHANGE);
+    }
 
     LOG_INFO("ButtonDrv task is ready.");
 
-    /* The main loop scans several times during one debounce period
-     * for any pin change. If there is no change, the state is
-     * considered as stable.
+    /* The task is only periodically running, as long as a button is not
+     * stable or a gesture is pending. Otherwise it waits for the next
+     * pin change.
      */
     for(;;)
     {
-        /* Is button pin value stable? */
-        if (0U == ulTaskNotifyTake(pdTRUE, BUTTON_DEBOUNCE_TIME))
+        uint32_t    changes     = 0U;
+        uint32_t    timestamp   = 0U;
+        bool        isActive    = false;
+
+        (void)xTaskNotifyWait(0U, UINT32_MAX, &changes, waitTime);
+
+        timestamp = millis();
+
+        for(buttonId = 0U; buttonId < Board::buttonCount; ++buttonId)
         {
-            /* Button state is stable, update it if applicable. */
-            if (pdTRUE != xSemaphoreTake(buttonDrv->m_semaphore, portMAX_DELAY))
+            if (0U != (changes & (1U << buttonId)))
             {
-                LOG_WARNING("Update of button state not possible.");
+                buttonDrv->m_changeTimestamp[buttonId] = timestamp;
             }
-            else
+
+            if (true == buttonDrv->processButton(buttonId, timestamp))
             {
-                uint8_t buttonValue = Board::userButtonIn.read();
+                isActive = true;
+            }
+        }
 
-                /* If the button state is unknown, just check and set. */
-                if (STATE_UNKNOWN == buttonDrv->m_state)
-                {
-                    if (HIGH == buttonValue)
-                    {
-                        buttonDrv->m_state = STATE_RELEASED;
-                    }
-                    else
-                    {
-                        buttonDrv->m_state = STATE_PRESSED;
-                    }
-                }
-                /* Overwrite a triggered state is bad, because the application
-                 * would miss it.
-                 */
-                else if (STATE_TRIGGERED != buttonDrv->m_state)
+        if (true == isActive)
+        {
+            waitTime = pdMS_TO_TICKS(BUTTON_TASK_PERIOD);
+        }
+        else
+        {
+            waitTime = portMAX_DELAY;
+        }
+    }
+
+    return;
+}
+
+bool ButtonDrv::processButton(uint8_t buttonId, uint32_t timestamp)
+{
+    bool isActive = true;
+
+    /* Is button pin value stable? If there is no pin change during the
+     * debounce time, the state is considered as stable.
+     */
+    if (BUTTON_DEBOUNCE_TIME <= (timestamp - m_changeTimestamp[buttonId]))
+    {
+        bool    isPressed   = false;
+        State   state       = STATE_RELEASED;
+        uint8_t events      = ButtonGesture::EVENT_NONE;
+
+        if (LOW == digitalRead(Board::buttonPinNo[buttonId]))
+        {
+            isPressed   = true;
+            state       = STATE_PRESSED;
+        }
+
+        if (pdTRUE != xSemaphoreTake(m_semaphore, portMAX_DELAY))
+        {
+            LOG_WARNING("Update of button state not possible.");
+        }
+        else
+        {
+            m_state[buttonId] = state;
+
+            if (pdTRUE != xSemaphoreGive(m_semaphore))
+            {
+                LOG_FATAL("Can't give semaphore back.");
+            }
+        }
+
+        events = m_gesture[buttonId].process(isPressed, timestamp);
+        publish(buttonId, events, timestamp);
+
+        if (true == m_gesture[buttonId].isIdle())
+        {
+            isActive = false;
+        }
+    }
+
+    return isActive;
+}
+
+void ButtonDrv::publish(uint8_t buttonId, uint8_t events, uint32_t timestamp)
+{
+    /* In the order the events may happen at the same time. */
+    const ButtonGesture::Event  EVENT_TYPES[]   =
+    {
+        ButtonGesture::EVENT_CLICK,
+        ButtonGesture::EVENT_PRESSED,
+        ButtonGesture::EVENT_RELEASED,
+        ButtonGesture::EVENT_DOUBLE_CLICK,
+        ButtonGesture::EVENT_LONG_PRESS
+    };
+    uint8_t                     typeIndex       = 0U;
+    uint8_t                     index           = 0U;
+
+    if ((ButtonGesture::EVENT_NONE != events) &&
+        (pdTRUE == xSemaphoreTake(m_semaphore, portMAX_DELAY)))
+    {
+        for(typeIndex = 0U; typeIndex < UTIL_ARRAY_NUM(EVENT_TYPES); ++typeIndex)
+        {
+            if (0U != (events & EVENT_TYPES[typeIndex]))
+            {
+                Event event;
+
+                event.buttonId  = buttonId;
+                event.type      = EVENT_TYPES[typeIndex];
+                event.timestamp = timestamp;
+
+                for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
                 {
-                    /* Button pressed now? */
-                    if ((STATE_RELEASED == buttonDrv->m_state) &&
-                        (LOW == buttonValue))
-                    {
-                        buttonDrv->m_state = STATE_PRESSED;
-                    }
-                    /* Button released now? */
-                    else if ((STATE_PRESSED == buttonDrv->m_state) &&
-                             (HIGH == buttonValue))
+                    if ((nullptr != m_subscribers[index]) &&
+                        (false == m_subscribers[index]->push(event)))
                     {
-                        buttonDrv->m_state = STATE_TRIGGERED;
+                        LOG_WARNING("Button event queue %u is full.", index);
                     }
-                    else
-                    {
-                        ;
-                    }
-                }
-                else
-                {
-                    ;
                 }
+            }
+        }
 
-                if (pdTRUE != xSemaphoreGive(buttonDrv->m_semaphore))
-                {
-                    LOG_FATAL("Can't give semaphore back.");
-                }
+        for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+        {
+            if ((nullptr != m_subscribers[index]) &&
+                (nullptr != m_notify[index]))
+            {
+                m_notify[index]();
             }
         }
+
+        if (pdTRUE != xSemaphoreGive(m_semaphore))
+        {
+            LOG_FATAL("Can't give semaphore back.");
+        }
     }
 
     return;
@@ -231,14 +381,17 @@ void ButtonDrv::buttonTask(void *parameters)
 /**
  * Button ISR which is called on change (falling- or rising-edge).
  *
- * @param[in] arg   Trigger counter for the button.
+ * @param[in] arg   Button id
  */
 static void IRAM_ATTR isrButton(void* arg)
 {
-    TaskHandle_t    taskHandle                  = reinterpret_cast<TaskHandle_t>(arg);
+    const uint32_t  BUTTON_ID                   = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg));
     BaseType_t      xHigherPriorityTaskWoken    = pdFALSE;
 
-    vTaskNotifyGiveFromISR(taskHandle, &xHigherPriorityTaskWoken);
+    if (nullptr != gButtonTaskHandle)
+    {
+        (void)xTaskNotifyFromISR(gButtonTaskHandle, 1U << BUTTON_ID, eSetBits, &xHigherPriorityTaskWoken);
+    }
 
     /* If xHigherPriorityTaskWoken is now set to pdTRUE then a context switch
      * should be performed to ensure the interrupt returns directly to the highest
@@ -40,6 +40,10 @@
  * Includes
  *****************************************************************************/
 #include "Arduino.h"
+#include "Board.h"
+
+#include <SpscQueue.hpp>
+#include <ButtonGesture.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -54,7 +58,10 @@
  *****************************************************************************/
 
 /**
- * Button driver.
+ * Button driver for all buttons of the board.
+ * Every button pin change is signalled by its interrupt to a single task,
+ * which debounces the buttons and detects the gestures. The events are
+ * provided with timestamp to every subscriber via its own lock-free queue.
  */
 class ButtonDrv
 {
@@ -93,22 +100,76 @@ public:
     {
         STATE_UNKNOWN = 0,  /**< Button state is unknown yet */
         STATE_RELEASED,     /**< Button is released. */
-        STATE_PRESSED,      /**< Button is pressed. */
-        STATE_TRIGGERED     /**< Button was triggered (released -> pressed -> released) */
+        STATE_PRESSED       /**< Button is pressed. */
+    };
+
+    /** Button id of the user button. */
+    static const uint8_t    BUTTON_ID_USER      = 0U;
+
+    /** Max. number of events in a subscriber queue. */
+    static const uint32_t   EVENT_QUEUE_SIZE    = 16U;
+
+    /** Max. number of subscribers. */
+    static const uint8_t    MAX_SUBSCRIBERS     = 4U;
+
+    /**
+     * Button event.
+     */
+    struct Event
+    {
+        uint8_t                 buttonId;   /**< Button id [0; Board::buttonCount - 1] */
+        ButtonGesture::Event    type;       /**< Event type, a single one per event. */
+        uint32_t                timestamp;  /**< Timestamp in ms */
     };
 
     /**
-     * Get button state.
+     * Event queue of a subscriber. The button task is the producer and
+     * the subscriber the consumer.
+     */
+    typedef SpscQueue<Event, EVENT_QUEUE_SIZE> EventQueue;
+
+    /**
+     * Notification of a subscriber, that new events are in its queue.
+     * It is called in the button task context and must not block.
+     */
+    typedef void (*NotifyFunc)(void);
+
+    /**
+     * Get the debounced button state.
      * 
+     * @param[in] buttonId  Button id
+     *
      * @return Button state
      */
-    State getState();
+    State getState(uint8_t buttonId = BUTTON_ID_USER);
+
+    /**
+     * Subscribe for button events. The queue must exist until it is
+     * unsubscribed.
+     *
+     * @param[in] queue     Event queue of the subscriber
+     * @param[in] notify    Optional notification about new events
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool subscribe(EventQueue& queue, NotifyFunc notify = nullptr);
+
+    /**
+     * Unsubscribe from the button events.
+     *
+     * @param[in] queue Event queue of the subscriber
+     */
+    void unsubscribe(EventQueue& queue);
 
 private:
 
-    TaskHandle_t        m_buttonTaskHandle; /**< Button task handle */
-    State               m_state;            /**< Current button state */
-    SemaphoreHandle_t   m_semaphore;        /**< Semaphore lock */
+    TaskHandle_t        m_buttonTaskHandle;                     /**< Button task handle */
+    State               m_state[Board::buttonCount];            /**< Current debounced button states */
+    uint32_t            m_changeTimestamp[Board::buttonCount];  /**< Timestamp in ms of the last pin change */
+    ButtonGesture       m_gesture[Board::buttonCount];          /**< Gesture detection per button */
+    EventQueue*         m_subscribers[MAX_SUBSCRIBERS];         /**< Event queues of the subscribers */
+    NotifyFunc          m_notify[MAX_SUBSCRIBERS];              /**< Notifications of the subscribers */
+    SemaphoreHandle_t   m_semaphore;                            /**< Semaphore lock */
 
     /** Button task stack size in bytes */
     static const uint32_t   BUTTON_TASK_STACKE_SIZE = 2048U;
@@ -116,7 +177,7 @@ private:
     /** MCU core where the button task shall run */
     static const BaseType_t BUTTON_TASK_RUN_CORE    = 1;
 
-    /** Task period in ms */
+    /** Task period in ms, as long as a button is not stable or a gesture is pending. */
     static const uint32_t   BUTTON_TASK_PERIOD      = 10U;
 
     /** Button debouncing time in ms */
@@ -127,7 +188,11 @@ private:
      */
     ButtonDrv() :
         m_buttonTaskHandle(nullptr),
-        m_state(STATE_UNKNOWN),
+        m_state(),
+        m_changeTimestamp(),
+        m_gesture(),
+        m_subscribers(),
+        m_notify(),
         m_semaphore(nullptr)
     {
     }
@@ -145,12 +210,31 @@ private:
     ButtonDrv& operator=(const ButtonDrv& drv);
 
     /**
-     * Button task is responsible for debouncing and updating the user button state
-     * accordingly.
+     * Button task is responsible for debouncing, detecting the gestures and
+     * providing the events to the subscribers.
      * 
      * @param[in]   parameters  Task pParameters
      */
     static void buttonTask(void* parameters);
+
+    /**
+     * Debounce a single button and process its gestures.
+     *
+     * @param[in] buttonId  Button id
+     * @param[in] timestamp Current timestamp in ms
+     *
+     * @return If the button needs further periodic processing, it will return true otherwise false.
+     */
+    bool processButton(uint8_t buttonId, uint32_t timestamp);
+
+    /**
+     * Provide the events to all subscribers.
+     *
+     * @param[in] buttonId  Button id
+     * @param[in] events    Events, see ButtonGesture::Event
+     * @param[in] timestamp Timestamp in ms
+     */
+    void publish(uint8_t buttonId, uint8_t events, uint32_t timestamp);
 };
 
 /******************************************************************************
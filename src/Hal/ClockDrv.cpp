@@ -34,10 +34,13 @@
  *****************************************************************************/
 #include "ClockDrv.h"
 #include "Settings.h"
+#include "DnsCache.h"
+#include "RtcDrv.h"
 #include "time.h"
 
 #include <sys/time.h>
 #include <Logging.h>
+#include <Metrics.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -55,40 +58,58 @@
  * Prototypes
  *****************************************************************************/
 
+static void setTimezone(int32_t gmtOffset, int16_t daylightSavingValue);
+static uint64_t getSystemTime();
+static int32_t getNtpOffset();
+static int32_t getNtpJitter();
+static int32_t getNtpTimeSinceSync();
+static int32_t getNtpPollInterval();
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Offset of the NTP server clock, read during export. */
+static MetricGauge  gMetricNtpOffset("pixelix_ntp_offset_ms", "Offset of the NTP server clock to the local clock in ms, measured by the last synchronization.", getNtpOffset);
+
+/** NTP jitter, read during export. */
+static MetricGauge  gMetricNtpJitter("pixelix_ntp_jitter_ms", "Jitter of the NTP offset in ms.", getNtpJitter);
+
+/** Time since the last NTP synchronization, read during export. */
+static MetricGauge  gMetricNtpLastSync("pixelix_ntp_last_sync_s", "Time since the last NTP synchronization in s.", getNtpTimeSinceSync);
+
+/** NTP poll interval, read during export. */
+static MetricGauge  gMetricNtpPollInterval("pixelix_ntp_poll_interval_s", "NTP poll interval in s.", getNtpPollInterval);
+
+/** Microseconds per second */
+static const int64_t    US_PER_S    = 1000000LL;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-void ClockDrv::init()
+void ClockDrv::begin()
 {
-    if (false == m_isClockDrvInitialized)
+    if (false == m_isClockDrvStarted)
     {
-        int32_t     gmtOffset           = 0;
-        int16_t     daylightSavingValue = 0;
-        String      ntpServerAddress;
-        bool        isDaylightSaving    = false;
-        struct tm   timeInfo            = { 0 };
+        bool isDaylightSaving = false;
 
         /* Get the GMT offset, daylight saving enabled/disabled and NTP server address from persistent memory. */
         if (false == Settings::getInstance().open(true))
         {
             LOG_WARNING("Use default values for NTP request.");
 
-            gmtOffset           = Settings::getInstance().getGmtOffset().getDefault();
+            m_gmtOffset         = Settings::getInstance().getGmtOffset().getDefault();
             isDaylightSaving    = Settings::getInstance().getDaylightSavingAdjustment().getDefault();
-            ntpServerAddress    = Settings::getInstance().getNTPServerAddress().getDefault();
+            m_ntpServerAddress  = Settings::getInstance().getNTPServerAddress().getDefault();
             m_is24HourFormat    = Settings::getInstance().getTimeFormatAdjustment().getDefault();
             m_isDayMonthYear    = Settings::getInstance().getDateFormatAdjustment().getDefault();
         }
         else
         {
-            gmtOffset           = Settings::getInstance().getGmtOffset().getValue();
+            m_gmtOffset         = Settings::getInstance().getGmtOffset().getValue();
             isDaylightSaving    = Settings::getInstance().getDaylightSavingAdjustment().getValue();
-            ntpServerAddress    = Settings::getInstance().getNTPServerAddress().getValue();
+            m_ntpServerAddress  = Settings::getInstance().getNTPServerAddress().getValue();
             m_is24HourFormat    = Settings::getInstance().getTimeFormatAdjustment().getValue();
             m_isDayMonthYear    = Settings::getInstance().getDateFormatAdjustment().getValue();
             Settings::getInstance().close();
@@ -96,30 +117,93 @@ void ClockDrv::init()
 
         if (true == isDaylightSaving)
         {
-            daylightSavingValue = NTP_DAYLIGHT_OFFSET_SEC;
+            m_daylightSavingValue = NTP_DAYLIGHT_OFFSET_SEC;
         }
 
-        /* Configure NTP:
-         * This will periodically synchronize the time. The time synchronization
-         * period is determined by CONFIG_LWIP_SNTP_UPDATE_DELAY (default value is one hour).
-         * To modify the variable, set CONFIG_LWIP_SNTP_UPDATE_DELAY in project configuration.
-         * https://docs.espressif.com/projects/esp-idf/en/latest/api-reference/system/system_time.html
-         * https://github.com/espressif/esp-idf/issues/4386
+        /* The local time is valid without network, if the RTC time is. */
+        setTimezone(m_gmtOffset, m_daylightSavingValue);
+
+        if (true == RtcDrv::getInstance().begin())
+        {
+            LOG_INFO("Time set by RTC.");
+        }
+
+        m_isClockDrvStarted = true;
+    }
+
+    return;
+}
+
+void ClockDrv::init()
+{
+    if (false == m_isClockDrvInitialized)
+    {
+        begin();
+
+        /* The SNTP of lwIP steps the time with every synchronization,
+         * therefore the NTP synchronization is done by the driver itself.
+         * The first request is sent by the next process() call.
          */
-        configTime(gmtOffset, daylightSavingValue, ntpServerAddress.c_str());
+        m_pollTimer.stop();
+        m_responseTimer.stop();
 
-        /* Wait for synchronization (default 5s) */
-        if (false == getLocalTime(&timeInfo))
+        m_isClockDrvInitialized = true;
+    }
+}
+
+void ClockDrv::process()
+{
+    if (true == m_isClockDrvInitialized)
+    {
+        if (true == m_responseTimer.isTimerRunning())
+        {
+            if (true == receiveResponse())
+            {
+                m_udp.stop();
+                m_responseTimer.stop();
+                m_pollTimer.start(m_ntpSync.getPollInterval() * 1000U);
+            }
+            else if (true == m_responseTimer.isTimeout())
+            {
+                LOG_WARNING("NTP server %s doesn't respond.", m_ntpServerAddress.c_str());
+
+                m_udp.stop();
+                m_responseTimer.stop();
+                m_pollTimer.start(NTP_RETRY_PERIOD);
+            }
+            else
+            {
+                ;
+            }
+        }
+        else if ((false == m_pollTimer.isTimerRunning()) ||
+                 (true == m_pollTimer.isTimeout()))
         {
-            LOG_ERROR("Failed to synchronize time.");
+            if (true == sendRequest())
+            {
+                m_pollTimer.stop();
+                m_responseTimer.start(NTP_RESPONSE_TIMEOUT);
+            }
         }
         else
         {
-            LOG_INFO("Time successfully synchronized: %d:%d", timeInfo.tm_hour, timeInfo.tm_min);
+            ;
         }
+    }
 
-        m_isClockDrvInitialized = true;
+    return;
+}
+
+uint32_t ClockDrv::getTimeSinceSync() const
+{
+    uint32_t timeSinceSync = 0U;
+
+    if (true == m_ntpSync.isSynchronized())
+    {
+        timeSinceSync = static_cast<uint32_t>((MonoTime::getMillis64() - m_lastSync) / 1000U);
     }
+
+    return timeSinceSync;
 }
 
 bool ClockDrv::getTime(tm *currentTime)
@@ -129,6 +213,26 @@ bool ClockDrv::getTime(tm *currentTime)
     return getLocalTime(currentTime, WAIT_TIME_MS);
 }
 
+uint32_t ClockDrv::getTimeToNextBoundary(uint32_t period)
+{
+    const uint32_t  MS_PER_S    = 1000U;
+    const uint32_t  US_PER_MS   = 1000U;
+    struct timeval  tv          = { 0 };
+    uint32_t        duration    = period * MS_PER_S;
+
+    if ((0U < period) &&
+        (0 == gettimeofday(&tv, nullptr)))
+    {
+        uint32_t elapsed = static_cast<uint32_t>(tv.tv_sec % period) * MS_PER_S;
+
+        elapsed += static_cast<uint32_t>(tv.tv_usec) / US_PER_MS;
+
+        duration -= elapsed;
+    }
+
+    return duration;
+}
+
 bool ClockDrv::getTimeFormat()
 {
     return m_is24HourFormat;
@@ -147,6 +251,100 @@ bool ClockDrv::getDateFormat()
  * Private Methods
  *****************************************************************************/
 
+bool ClockDrv::sendRequest()
+{
+    bool                isSent  = false;
+    IPAddress           ntpServerIp;
+    DnsCache::Result    result  = DnsCache::getInstance().resolve(m_ntpServerAddress, ntpServerIp, this, nullptr);
+
+    if (DnsCache::RESULT_RESOLVED == result)
+    {
+        uint8_t buffer[NtpSync::PACKET_SIZE];
+
+        /* A new socket per request drops late responses of previous requests. */
+        if (0 != m_udp.begin(0U))
+        {
+            m_requestTime = getSystemTime();
+
+            if ((NtpSync::PACKET_SIZE == NtpSync::writeRequest(buffer, sizeof(buffer), m_requestTime)) &&
+                (0 != m_udp.beginPacket(ntpServerIp, NtpSync::PORT)) &&
+                (sizeof(buffer) == m_udp.write(buffer, sizeof(buffer))) &&
+                (0 != m_udp.endPacket()))
+            {
+                isSent = true;
+            }
+            else
+            {
+                m_udp.stop();
+            }
+        }
+
+        if (false == isSent)
+        {
+            LOG_WARNING("Failed to send NTP request.");
+            m_pollTimer.start(NTP_RETRY_PERIOD);
+        }
+    }
+    else if (DnsCache::RESULT_PENDING == result)
+    {
+        m_pollTimer.start(NTP_LOOKUP_PERIOD);
+    }
+    else
+    {
+        LOG_WARNING("Failed to resolve NTP server %s.", m_ntpServerAddress.c_str());
+        m_pollTimer.start(NTP_RETRY_PERIOD);
+    }
+
+    return isSent;
+}
+
+bool ClockDrv::receiveResponse()
+{
+    bool isReceived = false;
+
+    if (0 < m_udp.parsePacket())
+    {
+        uint64_t    responseTime    = getSystemTime();
+        uint8_t     buffer[NtpSync::PACKET_SIZE];
+        uint64_t    receiveTime     = 0U;
+        uint64_t    transmitTime    = 0U;
+
+        if ((static_cast<int>(sizeof(buffer)) == m_udp.read(buffer, sizeof(buffer))) &&
+            (true == NtpSync::readResponse(buffer, sizeof(buffer), m_requestTime, receiveTime, transmitTime)))
+        {
+            NtpSync::Correction correction  = m_ntpSync.addSample(m_requestTime, receiveTime, transmitTime, responseTime);
+            int64_t             offset      = m_ntpSync.getOffset();
+            struct timeval      tv          = { 0 };
+
+            if (NtpSync::CORRECTION_STEP == correction)
+            {
+                uint64_t now = getSystemTime() + offset;
+
+                tv.tv_sec   = static_cast<time_t>(now / US_PER_S);
+                tv.tv_usec  = static_cast<suseconds_t>(now % US_PER_S);
+                (void)settimeofday(&tv, nullptr);
+
+                LOG_INFO("Time stepped by %d ms.", static_cast<int32_t>(offset / 1000));
+            }
+            else if (NtpSync::CORRECTION_SLEW == correction)
+            {
+                tv.tv_sec   = static_cast<time_t>(offset / US_PER_S);
+                tv.tv_usec  = static_cast<suseconds_t>(offset % US_PER_S);
+                (void)adjtime(&tv, nullptr);
+            }
+            else
+            {
+                ;
+            }
+
+            m_lastSync  = MonoTime::getMillis64();
+            isReceived  = true;
+        }
+    }
+
+    return isReceived;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -155,3 +353,104 @@ bool ClockDrv::getDateFormat()
  * Local Functions
  *****************************************************************************/
 
+/**
+ * Set the timezone without starting the NTP synchronization. The timezone
+ * string is the same, which configTime() sets.
+ *
+ * @param[in] gmtOffset             GMT offset in s
+ * @param[in] daylightSavingValue   Daylight saving offset in s
+ */
+static void setTimezone(int32_t gmtOffset, int16_t daylightSavingValue)
+{
+    const int32_t   SEC_PER_HOUR    = 3600;
+    const int32_t   SEC_PER_MIN     = 60;
+    int32_t         offset          = -gmtOffset;
+    char            cst[17]         = { 0 };
+    char            cdt[17]         = "DST";
+    char            tz[33]          = { 0 };
+
+    /* POSIX timezone offsets are west positive. */
+    if (0 != (offset % SEC_PER_HOUR))
+    {
+        snprintf(cst, sizeof(cst), "UTC%d:%02d:%02d", offset / SEC_PER_HOUR, abs((offset % SEC_PER_HOUR) / SEC_PER_MIN), abs(offset % SEC_PER_MIN));
+    }
+    else
+    {
+        snprintf(cst, sizeof(cst), "UTC%d", offset / SEC_PER_HOUR);
+    }
+
+    if (SEC_PER_HOUR != daylightSavingValue)
+    {
+        int32_t dstOffset = offset - daylightSavingValue;
+
+        if (0 != (dstOffset % SEC_PER_HOUR))
+        {
+            snprintf(cdt, sizeof(cdt), "DST%d:%02d:%02d", dstOffset / SEC_PER_HOUR, abs((dstOffset % SEC_PER_HOUR) / SEC_PER_MIN), abs(dstOffset % SEC_PER_MIN));
+        }
+        else
+        {
+            snprintf(cdt, sizeof(cdt), "DST%d", dstOffset / SEC_PER_HOUR);
+        }
+    }
+
+    snprintf(tz, sizeof(tz), "%s%s", cst, cdt);
+    (void)setenv("TZ", tz, 1);
+    tzset();
+
+    return;
+}
+
+
+/**
+ * Get the system time.
+ *
+ * @return Unix timestamp in us
+ */
+static uint64_t getSystemTime()
+{
+    struct timeval tv = { 0 };
+
+    (void)gettimeofday(&tv, nullptr);
+
+    return (static_cast<uint64_t>(tv.tv_sec) * US_PER_S) + static_cast<uint64_t>(tv.tv_usec);
+}
+
+/**
+ * Get the offset of the NTP server clock.
+ *
+ * @return Offset in ms
+ */
+static int32_t getNtpOffset()
+{
+    return static_cast<int32_t>(ClockDrv::getInstance().getNtpSync().getOffset() / 1000);
+}
+
+/**
+ * Get the NTP jitter.
+ *
+ * @return Jitter in ms
+ */
+static int32_t getNtpJitter()
+{
+    return static_cast<int32_t>(ClockDrv::getInstance().getNtpSync().getJitter() / 1000U);
+}
+
+/**
+ * Get the time since the last NTP synchronization.
+ *
+ * @return Time in s
+ */
+static int32_t getNtpTimeSinceSync()
+{
+    return static_cast<int32_t>(ClockDrv::getInstance().getTimeSinceSync());
+}
+
+/**
+ * Get the NTP poll interval.
+ *
+ * @return Poll interval in s
+ */
+static int32_t getNtpPollInterval()
+{
+    return static_cast<int32_t>(ClockDrv::getInstance().getNtpSync().getPollInterval());
+}
@@ -45,6 +45,10 @@
  *****************************************************************************/
 #include "Arduino.h"
 #include "time.h"
+#include <WiFiUdp.h>
+#include <NtpSync.h>
+#include <SimpleTimer.hpp>
+#include <MonoTime.hpp>
 
 /******************************************************************************
  * Macros
@@ -56,6 +60,9 @@
 
 /**
  * Clock driver.
+ *
+ * The time is synchronized by NTP. Small offsets are slewed, so the time
+ * never jumps, and the poll interval adapts to the drift of the clock.
  */
 class ClockDrv
 {
@@ -74,11 +81,52 @@ public:
     }
 
     /**
-     * Initialize the ClockDrv.
+     * Start the ClockDrv without network. It sets the configured timezone
+     * and the time of the optional RTC, so the time is valid before the
+     * NTP synchronization.
+     */
+    void begin();
+
+    /**
+     * Initialize the ClockDrv and start the NTP synchronization.
+     * If not started yet, it will be started first.
      *
      */
     void init();
 
+    /**
+     * Process the NTP synchronization. Call it periodically while the
+     * network is connected.
+     */
+    void process();
+
+    /**
+     * Is the time synchronized by NTP?
+     *
+     * @return If synchronized, it will return true otherwise false.
+     */
+    bool isSynchronized() const
+    {
+        return m_ntpSync.isSynchronized();
+    }
+
+    /**
+     * Get the NTP synchronization state, e.g. the offset and jitter.
+     *
+     * @return NTP synchronization
+     */
+    const NtpSync& getNtpSync() const
+    {
+        return m_ntpSync;
+    }
+
+    /**
+     * Get the time since the last NTP synchronization.
+     *
+     * @return Time in s. If not synchronized yet, it will return 0.
+     */
+    uint32_t getTimeSinceSync() const;
+
     /**
      * Get the current time.
      *
@@ -88,6 +136,17 @@ public:
      */
     bool getTime(tm *currentTime);
 
+    /**
+     * Get the time until the next boundary of the given period, e.g. the
+     * next full minute. All time zones are shifted by multiples of 15 min,
+     * therefore second and minute boundaries are the same in local time.
+     *
+     * @param[in] period    Period in s, e.g. 60 for the next full minute.
+     *
+     * @return Time to next boundary in ms
+     */
+    uint32_t getTimeToNextBoundary(uint32_t period);
+
     /**
      * Get the time format.
      *
@@ -105,24 +164,79 @@ public:
     /** Daylight saving time offset in s */
     static const int16_t NTP_DAYLIGHT_OFFSET_SEC    = 3600;
 
+    /** Period in s of a second boundary. */
+    static const uint32_t BOUNDARY_SECOND           = 1U;
+
+    /** Period in s of a minute boundary. */
+    static const uint32_t BOUNDARY_MINUTE           = 60U;
+
+    /** Timeout in ms of a NTP response. */
+    static const uint32_t NTP_RESPONSE_TIMEOUT      = 2000U;
+
+    /** Period in ms to retry a failed NTP request. */
+    static const uint32_t NTP_RETRY_PERIOD          = 16000U;
+
+    /** Period in ms to wait for a pending NTP server lookup. */
+    static const uint32_t NTP_LOOKUP_PERIOD         = 1000U;
+
 private:
 
+    /** Flag indicating a started clock driver. */
+    bool m_isClockDrvStarted;
+
     /** Flag indicating a initialized clock driver. */
     bool m_isClockDrvInitialized;
 
+    /** GMT offset in s */
+    int32_t m_gmtOffset;
+
+    /** Daylight saving offset in s */
+    int16_t m_daylightSavingValue;
+
     /** Flag holding the time format. */
     bool m_is24HourFormat;
 
     /** Flag holding the date format. */
     bool m_isDayMonthYear;
 
+    /** NTP server address */
+    String m_ntpServerAddress;
+
+    /** UDP socket for the NTP requests. */
+    WiFiUDP m_udp;
+
+    /** NTP synchronization */
+    NtpSync m_ntpSync;
+
+    /** Timer to poll the NTP server. */
+    SimpleTimer m_pollTimer;
+
+    /** Timer to wait for the NTP response. */
+    SimpleTimer m_responseTimer;
+
+    /** Local time in us, when the pending NTP request was sent (t1). */
+    uint64_t m_requestTime;
+
+    /** Timestamp in ms of the last NTP synchronization, which may be months ago. */
+    uint64_t m_lastSync;
+
     /**
      * Construct ClockDrv.
      */
     ClockDrv() :
+        m_isClockDrvStarted(false),
         m_isClockDrvInitialized(false),
+        m_gmtOffset(0),
+        m_daylightSavingValue(0),
         m_is24HourFormat(false),
-        m_isDayMonthYear(false)
+        m_isDayMonthYear(false),
+        m_ntpServerAddress(),
+        m_udp(),
+        m_ntpSync(),
+        m_pollTimer(),
+        m_responseTimer(),
+        m_requestTime(0U),
+        m_lastSync(0U)
     {
 
     }
@@ -135,6 +249,20 @@ private:
 
     }
 
+    /**
+     * Send a NTP request to the server.
+     *
+     * @return If the request is sent, it will return true otherwise false.
+     */
+    bool sendRequest();
+
+    /**
+     * Receive the NTP response and correct the time.
+     *
+     * @return If a valid response is received, it will return true otherwise false.
+     */
+    bool receiveResponse();
+
     /* Prevent copying */
     ClockDrv(const ClockDrv&);
     ClockDrv&operator=(const ClockDrv&);
@@ -0,0 +1,334 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Digital light sensor driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LightSensorDrv.h"
+#include "Board.h"
+
+#include <Wire.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** I2C clock in Hz, the same as used by the RTC. */
+static const uint32_t   I2C_CLOCK           = 400000U;
+
+/** Command bit and normal register access */
+static const uint8_t    CMD_REGISTER        = 0xA0U;
+
+/** Command bit and special function */
+static const uint8_t    CMD_SPECIAL         = 0xE0U;
+
+/** Special function: Clear the ALS interrupt */
+static const uint8_t    SF_CLEAR_ALS_INT    = 0x06U;
+
+/** Enable register */
+static const uint8_t    REG_ENABLE          = 0x00U;
+
+/** Control register with gain and integration time */
+static const uint8_t    REG_CONTROL         = 0x01U;
+
+/** ALS interrupt low threshold register, followed by the high threshold */
+static const uint8_t    REG_AILTL           = 0x04U;
+
+/** Interrupt persistence filter register */
+static const uint8_t    REG_PERSIST         = 0x0CU;
+
+/** Device id register */
+static const uint8_t    REG_ID              = 0x12U;
+
+/** Channel 0 data register, followed by channel 1 */
+static const uint8_t    REG_C0DATAL         = 0x14U;
+
+/** Device id of the TSL2591 */
+static const uint8_t    TSL2591_ID          = 0x50U;
+
+/** Enable: Power on, ALS and ALS interrupt */
+static const uint8_t    ENABLE_VALUE        = 0x13U;
+
+/**
+ * Persistence: 20 consecutive values outside the window raise the interrupt.
+ * With the integration time, this debounces a light change for 2 s.
+ */
+static const uint8_t    PERSIST_VALUE       = 0x07U;
+
+/** Max. channel value with 100 ms integration time */
+static const uint16_t   MAX_COUNT           = 36863U;
+
+/** Above this channel 0 value the gain is decreased. */
+static const uint16_t   SATURATION_COUNT    = (MAX_COUNT / 10U) * 9U;
+
+/** Below this channel 0 value the gain is increased. */
+static const uint16_t   DARK_COUNT          = 100U;
+
+/** Gain register values */
+static const uint8_t    GAIN_REG_VALUES[]   = { 0x00U, 0x10U, 0x20U };
+
+/** Gain factors */
+static const uint32_t   GAIN_FACTORS[]      = { 1U, 25U, 428U };
+
+/** Lux coefficient, see the TSL2591 application note. */
+static const uint64_t   LUX_DF              = 408U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool LightSensorDrv::begin()
+{
+    uint8_t id = 0U;
+
+    (void)Wire.begin(Board::Pin::i2cSdaPinNo, Board::Pin::i2cSclPinNo, I2C_CLOCK);
+
+    m_isAvailable = false;
+
+    if ((true == readRegs(REG_ID, &id, sizeof(id))) &&
+        (TSL2591_ID == id))
+    {
+        const uint8_t   ENABLE  = ENABLE_VALUE;
+        const uint8_t   PERSIST = PERSIST_VALUE;
+
+        if ((true == setGain(GAIN_MEDIUM)) &&
+            (true == writeRegs(REG_PERSIST, &PERSIST, sizeof(PERSIST))) &&
+            (true == writeRegs(REG_ENABLE, &ENABLE, sizeof(ENABLE))))
+        {
+            uint32_t    changeCount = m_changeCount;
+            uint8_t     tries       = 0U;
+
+            m_isAvailable = true;
+
+            /* Measure once, to have valid values immediately. A gain change
+             * needs another integration cycle.
+             */
+            do
+            {
+                delay(2U * INTEGRATION_TIME);
+                measure();
+                ++tries;
+            }
+            while((changeCount == m_changeCount) && (GAIN_MAX > tries));
+
+            LOG_INFO("Light sensor TSL2591 detected.");
+        }
+        else
+        {
+            LOG_WARNING("Failed to configure light sensor.");
+        }
+    }
+
+    return m_isAvailable;
+}
+
+void LightSensorDrv::process()
+{
+    if ((true == m_isAvailable) &&
+        (LOW == Board::lightSensorIntIn.read()))
+    {
+        measure();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void LightSensorDrv::measure()
+{
+    uint8_t data[4U];
+
+    if (true == readRegs(REG_C0DATAL, data, sizeof(data)))
+    {
+        const uint16_t  CH0 = static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8U);
+        const uint16_t  CH1 = static_cast<uint16_t>(data[2]) | (static_cast<uint16_t>(data[3]) << 8U);
+
+        /* After a gain change, the window is closed to get the next value
+         * as soon as possible.
+         */
+        if ((SATURATION_COUNT <= CH0) &&
+            (GAIN_LOW < m_gain))
+        {
+            (void)setGain(static_cast<Gain>(m_gain - 1));
+            (void)setThresholds(UINT16_MAX, 0U);
+        }
+        else if ((DARK_COUNT > CH0) &&
+                 ((GAIN_MAX - 1) > m_gain))
+        {
+            (void)setGain(static_cast<Gain>(m_gain + 1));
+            (void)setThresholds(UINT16_MAX, 0U);
+        }
+        else
+        {
+            uint32_t low    = (static_cast<uint32_t>(CH0) * (100U - THRESHOLD_HYSTERESIS)) / 100U;
+            uint32_t high   = (static_cast<uint32_t>(CH0) * (100U + THRESHOLD_HYSTERESIS)) / 100U;
+
+            /* Keep a window in the dark too. */
+            if (low == high)
+            {
+                ++high;
+            }
+
+            if (UINT16_MAX < high)
+            {
+                high = UINT16_MAX;
+            }
+
+            (void)setThresholds(static_cast<uint16_t>(low), static_cast<uint16_t>(high));
+
+            m_illuminance = calcIlluminance(CH0, CH1);
+            ++m_changeCount;
+        }
+    }
+
+    (void)sendSpecialFunction(SF_CLEAR_ALS_INT);
+
+    return;
+}
+
+bool LightSensorDrv::setGain(Gain gain)
+{
+    /* The integration time bits are 0, which is 100 ms. */
+    const uint8_t   CONTROL         = GAIN_REG_VALUES[gain];
+    bool            isSuccessful    = writeRegs(REG_CONTROL, &CONTROL, sizeof(CONTROL));
+
+    if (true == isSuccessful)
+    {
+        m_gain = gain;
+    }
+
+    return isSuccessful;
+}
+
+bool LightSensorDrv::setThresholds(uint16_t low, uint16_t high)
+{
+    const uint8_t THRESHOLDS[4U] =
+    {
+        static_cast<uint8_t>(low),
+        static_cast<uint8_t>(low >> 8U),
+        static_cast<uint8_t>(high),
+        static_cast<uint8_t>(high >> 8U)
+    };
+
+    return writeRegs(REG_AILTL, THRESHOLDS, sizeof(THRESHOLDS));
+}
+
+uint32_t LightSensorDrv::calcIlluminance(uint16_t ch0, uint16_t ch1) const
+{
+    uint32_t illuminance = 0U;
+
+    /* More infrared than visible light is a invalid measurement. */
+    if (ch0 > ch1)
+    {
+        /* lux = (ch0 - ch1) * (1 - ch1 / ch0) / cpl
+         *     = (ch0 - ch1)^2 * DF / (ch0 * time * gain)
+         */
+        const uint64_t  VISIBLE     = ch0 - ch1;
+        const uint64_t  DIVISOR     = static_cast<uint64_t>(ch0) * INTEGRATION_TIME * GAIN_FACTORS[m_gain];
+        const uint64_t  LUX_FIXED   = ((VISIBLE * VISIBLE * LUX_DF) << BrightnessCalc::LUX_FRAC_BITS) / DIVISOR;
+
+        illuminance = (UINT32_MAX < LUX_FIXED) ? UINT32_MAX : static_cast<uint32_t>(LUX_FIXED);
+    }
+
+    return illuminance;
+}
+
+bool LightSensorDrv::readRegs(uint8_t reg, uint8_t* buffer, uint8_t size)
+{
+    bool isSuccessful = false;
+
+    Wire.beginTransmission(TSL2591_ADDR);
+    (void)Wire.write(CMD_REGISTER | reg);
+
+    if ((0U == Wire.endTransmission(false)) &&
+        (size == Wire.requestFrom(TSL2591_ADDR, size)))
+    {
+        uint8_t index = 0U;
+
+        for(index = 0U; index < size; ++index)
+        {
+            buffer[index] = static_cast<uint8_t>(Wire.read());
+        }
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool LightSensorDrv::writeRegs(uint8_t reg, const uint8_t* buffer, uint8_t size)
+{
+    Wire.beginTransmission(TSL2591_ADDR);
+    (void)Wire.write(CMD_REGISTER | reg);
+    (void)Wire.write(buffer, size);
+
+    return (0U == Wire.endTransmission());
+}
+
+bool LightSensorDrv::sendSpecialFunction(uint8_t function)
+{
+    Wire.beginTransmission(TSL2591_ADDR);
+    (void)Wire.write(CMD_SPECIAL | function);
+
+    return (0U == Wire.endTransmission());
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,256 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Digital light sensor driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Hal
+ *
+ * @{
+ */
+
+#ifndef __LIGHT_SENSOR_DRV_H__
+#define __LIGHT_SENSOR_DRV_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <BrightnessCalc.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The digital light sensor driver supports a optional I2C TSL2591 light
+ * sensor, which measures continuously with its own integration time.
+ *
+ * Instead of reading it periodically, the sensor asserts its interrupt pin,
+ * if the light stays outside a threshold window for some integration cycles.
+ * The interrupt pin keeps asserted till it is cleared, therefore only its
+ * level is checked. Only then the light is read via I2C, the window is moved
+ * around the new value and the change is reported. The gain is adjusted
+ * automatically, to cover the range from a dark room to full sunlight.
+ */
+class LightSensorDrv
+{
+public:
+
+    /** I2C address of the TSL2591 */
+    static const uint8_t    TSL2591_ADDR            = 0x29U;
+
+    /** Integration time in ms */
+    static const uint32_t   INTEGRATION_TIME        = 100U;
+
+    /**
+     * Threshold window around the last measured channel value in percent.
+     * A smaller change is not reported.
+     */
+    static const uint8_t    THRESHOLD_HYSTERESIS    = 10U;
+
+    /**
+     * Get the light sensor driver instance.
+     *
+     * @return Light sensor driver instance
+     */
+    static LightSensorDrv& getInstance()
+    {
+        static LightSensorDrv instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Detect and configure the light sensor. The first measurement is
+     * available after it returns.
+     *
+     * @return If a sensor is available, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Is a sensor available?
+     *
+     * @return If available, it will return true otherwise false.
+     */
+    bool isAvailable() const
+    {
+        return m_isAvailable;
+    }
+
+    /**
+     * Read the sensor, if it signalled a light change by interrupt.
+     * Call it periodically, it costs only a pin read otherwise.
+     */
+    void process();
+
+    /**
+     * Get the illuminance of the last reported change.
+     *
+     * @return Illuminance in lux, fixed-point with BrightnessCalc::LUX_FRAC_BITS
+     */
+    uint32_t getIlluminance() const
+    {
+        return m_illuminance;
+    }
+
+    /**
+     * Get the number of reported light changes. A caller detects a new
+     * change by comparing it with the previous number.
+     *
+     * @return Number of light changes
+     */
+    uint32_t getChangeCount() const
+    {
+        return m_changeCount;
+    }
+
+private:
+
+    /**
+     * Supported gains, from low to high.
+     */
+    enum Gain
+    {
+        GAIN_LOW = 0,   /**< 1x */
+        GAIN_MEDIUM,    /**< 25x */
+        GAIN_HIGH,      /**< 428x */
+        GAIN_MAX        /**< Number of gains */
+    };
+
+    bool                m_isAvailable;      /**< Is sensor available? */
+    Gain                m_gain;             /**< Current gain */
+    volatile uint32_t   m_illuminance;      /**< Illuminance in lux of the last change, fixed-point */
+    volatile uint32_t   m_changeCount;      /**< Number of reported light changes */
+
+    /**
+     * Constructs the light sensor driver.
+     */
+    LightSensorDrv() :
+        m_isAvailable(false),
+        m_gain(GAIN_MEDIUM),
+        m_illuminance(0U),
+        m_changeCount(0U)
+    {
+    }
+
+    /**
+     * Destroys the light sensor driver.
+     */
+    ~LightSensorDrv()
+    {
+    }
+
+    /* Prevent copying */
+    LightSensorDrv(const LightSensorDrv& drv);
+    LightSensorDrv& operator=(const LightSensorDrv& drv);
+
+    /**
+     * Read both channels, adjust the gain if necessary and move the threshold
+     * window around the new value. The pending interrupt is cleared.
+     */
+    void measure();
+
+    /**
+     * Set the gain and the integration time.
+     *
+     * @param[in] gain  Gain
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setGain(Gain gain);
+
+    /**
+     * Set the threshold window of channel 0. A value outside raises the
+     * interrupt.
+     *
+     * @param[in] low   Lower threshold
+     * @param[in] high  Upper threshold
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setThresholds(uint16_t low, uint16_t high);
+
+    /**
+     * Calculate the illuminance from the channel values with the current gain.
+     *
+     * @param[in] ch0   Channel 0 value (visible and infrared)
+     * @param[in] ch1   Channel 1 value (infrared)
+     *
+     * @return Illuminance in lux, fixed-point with BrightnessCalc::LUX_FRAC_BITS
+     */
+    uint32_t calcIlluminance(uint16_t ch0, uint16_t ch1) const;
+
+    /**
+     * Read registers of the sensor.
+     *
+     * @param[in]   reg     First register address
+     * @param[out]  buffer  Register values
+     * @param[in]   size    Number of registers
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool readRegs(uint8_t reg, uint8_t* buffer, uint8_t size);
+
+    /**
+     * Write registers of the sensor.
+     *
+     * @param[in] reg       First register address
+     * @param[in] buffer    Register values
+     * @param[in] size      Number of registers
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool writeRegs(uint8_t reg, const uint8_t* buffer, uint8_t size);
+
+    /**
+     * Send a special function command to the sensor.
+     *
+     * @param[in] function  Special function
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool sendSpecialFunction(uint8_t function);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LIGHT_SENSOR_DRV_H__ */
+
+/** @} */
@@ -0,0 +1,309 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  I2S microphone driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MicDrv.h"
+#include "Board.h"
+
+#include <Logging.h>
+#include <Metrics.h>
+#include <Util.h>
+#include <driver/i2s.h>
+#include <esp_timer.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** I2S port of the microphone */
+static const i2s_port_t I2S_PORT = I2S_NUM_0;
+
+/** Analysis time histogram bucket bounds in us. */
+static const uint32_t   gAnalysisTimeBounds[] = { 1000U, 2000U, 4000U, 8000U, MicDrv::BLOCK_PERIOD };
+
+/** Time to analyze a sample block. */
+static MetricHistogram  gMetricAnalysisTime("pixelix_audio_analysis_time_us", "Time to analyze a audio sample block in us.", gAnalysisTimeBounds, UTIL_ARRAY_NUM(gAnalysisTimeBounds));
+
+/** Number of sample blocks, which analysis took longer than capturing the next one. */
+static MetricCounter    gMetricOverruns("pixelix_audio_overruns_total", "Number of audio sample blocks, which analysis exceeded the time budget.");
+
+/** Number of failed or incomplete captures. */
+static MetricCounter    gMetricCaptureErrors("pixelix_audio_capture_errors_total", "Number of failed audio captures.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool MicDrv::begin()
+{
+    bool isSuccessful = true;
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if (0U == m_users)
+    {
+        isSuccessful = start();
+    }
+
+    if (true == isSuccessful)
+    {
+        ++m_users;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return isSuccessful;
+}
+
+void MicDrv::end()
+{
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if (0U < m_users)
+    {
+        --m_users;
+
+        if (0U == m_users)
+        {
+            stop();
+        }
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+const Spectrum::Levels& MicDrv::getLevels()
+{
+    /* Take over the latest levels, if there are new ones. */
+    (void)m_levels.fetch();
+
+    return m_levels.get();
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool MicDrv::start()
+{
+    bool                isSuccessful    = false;
+    i2s_config_t        config;
+    i2s_pin_config_t    pins;
+
+    if ((false == Board::isMicAvailable) ||
+        (nullptr == m_xMutex) ||
+        (nullptr == m_xExitSemaphore))
+    {
+        return false;
+    }
+
+    memset(&config, 0, sizeof(config));
+    config.mode                 = static_cast<i2s_mode_t>(I2S_MODE_MASTER | I2S_MODE_RX);
+    config.sample_rate          = SAMPLE_RATE;
+    config.bits_per_sample      = I2S_BITS_PER_SAMPLE_32BIT;
+    config.channel_format       = I2S_CHANNEL_FMT_ONLY_LEFT;
+    config.communication_format = static_cast<i2s_comm_format_t>(I2S_COMM_FORMAT_I2S | I2S_COMM_FORMAT_I2S_MSB);
+    config.intr_alloc_flags     = ESP_INTR_FLAG_LEVEL1;
+    config.dma_buf_count        = DMA_BUF_COUNT;
+    config.dma_buf_len          = DMA_BUF_LEN;
+    config.use_apll             = false;
+
+    memset(&pins, 0, sizeof(pins));
+    pins.bck_io_num             = Board::Pin::micSckPinNo;
+    pins.ws_io_num              = Board::Pin::micWsPinNo;
+    pins.data_out_num           = I2S_PIN_NO_CHANGE;
+    pins.data_in_num            = Board::Pin::micSdInPinNo;
+
+    if (ESP_OK != i2s_driver_install(I2S_PORT, &config, 0, nullptr))
+    {
+        LOG_ERROR("Couldn't install I2S driver.");
+    }
+    else if (ESP_OK != i2s_set_pin(I2S_PORT, &pins))
+    {
+        LOG_ERROR("Couldn't set I2S pins.");
+        (void)i2s_driver_uninstall(I2S_PORT);
+    }
+    else
+    {
+        BaseType_t osRet = pdFAIL;
+
+        m_isExitReq = false;
+
+        osRet = xTaskCreateUniversal(   captureTask,
+                                        "micTask",
+                                        TASK_STACK_SIZE,
+                                        this,
+                                        TASK_PRIORITY,
+                                        &m_taskHandle,
+                                        TASK_RUN_CORE);
+
+        if (pdPASS != osRet)
+        {
+            LOG_ERROR("Couldn't create microphone task.");
+
+            m_taskHandle = nullptr;
+            (void)i2s_driver_uninstall(I2S_PORT);
+        }
+        else
+        {
+            LOG_INFO("Microphone capture started.");
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void MicDrv::stop()
+{
+    if (nullptr != m_taskHandle)
+    {
+        Spectrum::Levels silence;
+
+        m_isExitReq = true;
+
+        /* Join */
+        (void)xSemaphoreTake(m_xExitSemaphore, portMAX_DELAY);
+        m_taskHandle = nullptr;
+
+        (void)i2s_driver_uninstall(I2S_PORT);
+
+        memset(&silence, 0, sizeof(silence));
+        m_levels.publish(silence);
+
+        LOG_INFO("Microphone capture stopped.");
+    }
+
+    return;
+}
+
+void MicDrv::run()
+{
+    while(false == m_isExitReq)
+    {
+        size_t      bytesRead   = 0U;
+        esp_err_t   err         = i2s_read(I2S_PORT, m_rawSamples, sizeof(m_rawSamples), &bytesRead, pdMS_TO_TICKS(READ_TIMEOUT));
+
+        if ((ESP_OK != err) ||
+            (sizeof(m_rawSamples) != bytesRead))
+        {
+            gMetricCaptureErrors.inc();
+        }
+        else
+        {
+            int64_t             timestamp   = esp_timer_get_time();
+            uint32_t            duration    = 0U;
+            uint16_t            index       = 0U;
+            Spectrum::Levels    levels;
+
+            for(index = 0U; index < Spectrum::FFT_SIZE; ++index)
+            {
+                int32_t sample = m_rawSamples[index] >> SAMPLE_SHIFT;
+
+                if (INT16_MAX < sample)
+                {
+                    sample = INT16_MAX;
+                }
+                else if (INT16_MIN > sample)
+                {
+                    sample = INT16_MIN;
+                }
+                else
+                {
+                    ;
+                }
+
+                m_samples[index] = static_cast<int16_t>(sample);
+            }
+
+            m_spectrum.process(m_samples, levels);
+            m_levels.publish(levels);
+
+            duration = static_cast<uint32_t>(esp_timer_get_time() - timestamp);
+            gMetricAnalysisTime.observe(duration);
+
+            if (BLOCK_PERIOD < duration)
+            {
+                gMetricOverruns.inc();
+            }
+        }
+    }
+
+    return;
+}
+
+void MicDrv::captureTask(void* parameters)
+{
+    MicDrv* drv = static_cast<MicDrv*>(parameters);
+
+    if (nullptr != drv)
+    {
+        drv->run();
+
+        (void)xSemaphoreGive(drv->m_xExitSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,209 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  I2S microphone driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup hal
+ *
+ * @{
+ */
+
+#ifndef __MICDRV_H__
+#define __MICDRV_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <Spectrum.h>
+#include <StateBuffer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Driver for a I2S MEMS microphone, e.g. INMP441. The samples are captured
+ * via DMA and analyzed by a own task on core 0, see Spectrum. The levels
+ * are published lock-free to the display task.
+ *
+ * The analysis must not disturb the display task. Therefore the task runs
+ * with low priority and every block must be analyzed within the time, the
+ * next block needs to be captured. Otherwise the DMA drops samples, which
+ * is counted as overrun.
+ *
+ * The capture runs only, as long as at least one user needs it.
+ */
+class MicDrv
+{
+public:
+
+    /**
+     * Get the microphone driver instance.
+     *
+     * @return Microphone driver instance
+     */
+    static MicDrv& getInstance()
+    {
+        static MicDrv instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the capture, if it is the first user.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Stop the capture, if it is the last user.
+     */
+    void end();
+
+    /**
+     * Get the latest levels. If the capture is not running, all levels are 0.
+     * Shall only be called by the display task.
+     *
+     * @return Levels
+     */
+    const Spectrum::Levels& getLevels();
+
+    /** Sample rate in Hz, which results in a frequency range up to 8 kHz. */
+    static const uint32_t       SAMPLE_RATE         = 16000U;
+
+    /** Time in us to capture a block, which is the budget to analyze it. */
+    static const uint32_t       BLOCK_PERIOD        = (Spectrum::FFT_SIZE * 1000000U) / SAMPLE_RATE;
+
+private:
+
+    /** Task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 2048U;
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Task priority, as low as possible to not disturb the display task. */
+    static const UBaseType_t    TASK_PRIORITY       = 1U;
+
+    /** Number of DMA buffers */
+    static const int            DMA_BUF_COUNT       = 4;
+
+    /** Number of samples per DMA buffer */
+    static const int            DMA_BUF_LEN         = 128;
+
+    /** Max. time in ms to wait for a sample block. */
+    static const uint32_t       READ_TIMEOUT        = 100U;
+
+    /**
+     * Shift from the 32 bit I2S sample, which contains 24 bit of the
+     * microphone, to 16 bit. It keeps 2 bits of more sensitivity, because
+     * usual sound levels are far below the full scale.
+     */
+    static const uint8_t        SAMPLE_SHIFT        = 14U;
+
+    uint8_t                       m_users;                          /**< Number of users */
+    SemaphoreHandle_t             m_xMutex;                         /**< Protects the users and the start/stop. */
+    SemaphoreHandle_t             m_xExitSemaphore;                 /**< Signals the exit of the task. */
+    TaskHandle_t                  m_taskHandle;                     /**< Task handle */
+    volatile bool                 m_isExitReq;                      /**< Request the task to exit. */
+    Spectrum                      m_spectrum;                       /**< Spectrum analyzer, only used by the task. */
+    int32_t                       m_rawSamples[Spectrum::FFT_SIZE]; /**< Raw I2S samples, only used by the task. */
+    int16_t                       m_samples[Spectrum::FFT_SIZE];    /**< Samples, only used by the task. */
+    StateBuffer<Spectrum::Levels> m_levels;                         /**< Levels, published by the task to the display task. */
+
+    /**
+     * Constructs the microphone driver.
+     */
+    MicDrv() :
+        m_users(0U),
+        m_xMutex(xSemaphoreCreateMutex()),
+        m_xExitSemaphore(xSemaphoreCreateBinary()),
+        m_taskHandle(nullptr),
+        m_isExitReq(false),
+        m_spectrum(),
+        m_rawSamples(),
+        m_samples(),
+        m_levels()
+    {
+    }
+
+    /**
+     * Destroys the microphone driver.
+     */
+    ~MicDrv()
+    {
+        /* Never called. */
+    }
+
+    /* An instance shall not be copied. */
+    MicDrv(const MicDrv& drv);
+    MicDrv& operator=(const MicDrv& drv);
+
+    /**
+     * Install the I2S driver and start the task.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool start();
+
+    /**
+     * Stop the task and uninstall the I2S driver.
+     */
+    void stop();
+
+    /**
+     * Capture and analyze the sample blocks, until the exit is requested.
+     */
+    void run();
+
+    /**
+     * Capture task.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void captureTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __MICDRV_H__ */
+
+/** @} */
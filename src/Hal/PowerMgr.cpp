@@ -0,0 +1,350 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Power manager
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PowerMgr.h"
+#include "DisplayMgr.h"
+#include "UpdateMgr.h"
+
+#include <Logging.h>
+#include <Metrics.h>
+
+#if defined(CONFIG_PM_ENABLE)
+#include <esp_pm.h>
+#endif  /* defined(CONFIG_PM_ENABLE) */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int32_t getCpuFreq();
+static uint32_t estimateLoad(uint32_t load, uint32_t measuredCpuFreq, uint32_t cpuFreq);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Requested CPU frequency, read during export. */
+static MetricGauge  gMetricCpuFreq("pixelix_cpu_freq_mhz", "Requested CPU frequency in MHz.", getCpuFreq);
+
+#if defined(CONFIG_PM_ENABLE)
+
+/**
+ * Power management lock, which holds the max. CPU frequency. Without it,
+ * the power management scales down to the min. CPU frequency on its own.
+ */
+static esp_pm_lock_handle_t gPmLock             = nullptr;
+
+/** Is the power management lock acquired? */
+static bool                 gIsPmLockAcquired   = false;
+
+#endif  /* defined(CONFIG_PM_ENABLE) */
+
+/* The APB clock stays at 80 MHz for all of them, which the LED matrix output needs. */
+const uint32_t PowerMgr::CPU_FREQS[PowerMgr::CPU_FREQ_LEVELS] = { 80U, 160U, 240U };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void PowerMgr::process()
+{
+    Reason                  reason      = REASON_LOAD;
+    uint32_t                cpuFreq     = 0U;
+    DisplayMgr::Statistics  statistics;
+
+    DisplayMgr::getInstance().getStatistics(statistics);
+
+    /* In the connected state the loop runs about once per frame, which is enough to catch the peak. */
+    if (m_peakFrameTime < statistics.frameTime)
+    {
+        m_peakFrameTime = statistics.frameTime;
+    }
+
+    if (false == m_timer.isTimerRunning())
+    {
+        m_missedDeadlines   = statistics.missedDeadlines;
+        m_peakFrameTime     = 0U;
+        m_loadCpuFreq       = m_cpuFreq;
+
+        applyCpuFreq(m_cpuFreq);
+        m_timer.start(PROCESSING_CYCLE);
+    }
+    else if (true == m_timer.isTimeout())
+    {
+        uint32_t load = 0U;
+
+        if (0U < statistics.targetFps)
+        {
+            load = (m_peakFrameTime * 100U * statistics.targetFps) / 1000U;
+        }
+
+        if (UINT8_MAX < load)
+        {
+            load = UINT8_MAX;
+        }
+
+        m_load = static_cast<uint8_t>(load);
+        updateLevel(m_missedDeadlines != statistics.missedDeadlines);
+
+        m_missedDeadlines   = statistics.missedDeadlines;
+        m_peakFrameTime     = 0U;
+        m_loadCpuFreq       = m_cpuFreq;
+
+        m_timer.restart();
+    }
+    else
+    {
+        ;
+    }
+
+    if (true == isMaxFreqRequired(reason))
+    {
+        cpuFreq = CPU_FREQS[CPU_FREQ_LEVELS - 1U];
+    }
+    else
+    {
+        cpuFreq = CPU_FREQS[m_level];
+    }
+
+    m_reason = reason;
+
+    if (m_cpuFreq != cpuFreq)
+    {
+        LOG_INFO("CPU frequency %u MHz -> %u MHz (%s, load %u%%).", m_cpuFreq, cpuFreq, reasonToStr(reason), m_load);
+
+        applyCpuFreq(cpuFreq);
+    }
+
+    /* Measuring the load with the highest frequency of the cycle overestimates it, which is the safe side. */
+    if (m_loadCpuFreq < m_cpuFreq)
+    {
+        m_loadCpuFreq = m_cpuFreq;
+    }
+
+    return;
+}
+
+const char* PowerMgr::reasonToStr(Reason reason)
+{
+    const char* str = "unknown";
+
+    switch(reason)
+    {
+    case REASON_LOAD:
+        str = "load";
+        break;
+
+    case REASON_FADE:
+        str = "fade";
+        break;
+
+    case REASON_WEB:
+        str = "web";
+        break;
+
+    case REASON_UPDATE:
+        str = "update";
+        break;
+
+    default:
+        break;
+    }
+
+    return str;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool PowerMgr::isMaxFreqRequired(Reason& reason)
+{
+    bool isRequired = true;
+
+    if (true == UpdateMgr::getInstance().isUpdateRunning())
+    {
+        reason = REASON_UPDATE;
+    }
+    else if (true == DisplayMgr::getInstance().isFading())
+    {
+        reason = REASON_FADE;
+    }
+    else if (true == isWebActive())
+    {
+        reason = REASON_WEB;
+    }
+    else
+    {
+        m_isActivity    = false;
+        reason          = REASON_LOAD;
+        isRequired      = false;
+    }
+
+    return isRequired;
+}
+
+void PowerMgr::updateLevel(bool isDeadlineMissed)
+{
+    /* A missed deadline means the load measurement is not reliable anymore. */
+    if (true == isDeadlineMissed)
+    {
+        m_level = CPU_FREQ_LEVELS - 1U;
+    }
+    else
+    {
+        uint8_t level = 0U;
+
+        /* Lowest CPU frequency, which can handle the render load. */
+        while(((CPU_FREQ_LEVELS - 1U) > level) &&
+              (LOAD_LIMIT < estimateLoad(m_load, m_loadCpuFreq, CPU_FREQS[level])))
+        {
+            ++level;
+        }
+
+        if (m_level < level)
+        {
+            m_level = level;
+        }
+        /* Lower it only step by step and with hysteresis, to avoid toggling. */
+        else if ((m_level > level) &&
+                 ((LOAD_LIMIT - LOAD_HYSTERESIS) >= estimateLoad(m_load, m_loadCpuFreq, CPU_FREQS[m_level - 1U])))
+        {
+            --m_level;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return;
+}
+
+void PowerMgr::applyCpuFreq(uint32_t cpuFreq)
+{
+#if defined(CONFIG_PM_ENABLE)
+    /* The power management controls the frequency. Only the max. CPU frequency
+     * can be hold, otherwise it scales down to the min. CPU frequency on its own.
+     */
+    if (nullptr == gPmLock)
+    {
+        if (ESP_OK != esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "power", &gPmLock))
+        {
+            LOG_WARNING("Couldn't create power management lock.");
+            gPmLock = nullptr;
+        }
+    }
+
+    if (nullptr != gPmLock)
+    {
+        if (CPU_FREQS[CPU_FREQ_LEVELS - 1U] == cpuFreq)
+        {
+            if ((false == gIsPmLockAcquired) &&
+                (ESP_OK == esp_pm_lock_acquire(gPmLock)))
+            {
+                gIsPmLockAcquired = true;
+            }
+        }
+        else if (true == gIsPmLockAcquired)
+        {
+            if (ESP_OK == esp_pm_lock_release(gPmLock))
+            {
+                gIsPmLockAcquired = false;
+            }
+        }
+        else
+        {
+            ;
+        }
+    }
+#else   /* defined(CONFIG_PM_ENABLE) */
+    if (false == setCpuFrequencyMhz(cpuFreq))
+    {
+        LOG_WARNING("Couldn't set CPU frequency to %u MHz.", cpuFreq);
+    }
+#endif  /* defined(CONFIG_PM_ENABLE) */
+
+    m_cpuFreq = cpuFreq;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get requested CPU frequency.
+ *
+ * @return CPU frequency in MHz
+ */
+static int32_t getCpuFreq()
+{
+    return static_cast<int32_t>(PowerMgr::getInstance().getCpuFreq());
+}
+
+/**
+ * Estimate the render load with another CPU frequency.
+ *
+ * @param[in] load              Render load in percent
+ * @param[in] measuredCpuFreq   CPU frequency in MHz, the load was measured with
+ * @param[in] cpuFreq           CPU frequency in MHz, for which the load shall be estimated
+ *
+ * @return Estimated render load in percent
+ */
+static uint32_t estimateLoad(uint32_t load, uint32_t measuredCpuFreq, uint32_t cpuFreq)
+{
+    return (load * measuredCpuFreq) / cpuFreq;
+}
\ No newline at end of file
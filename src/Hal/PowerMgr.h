@@ -0,0 +1,248 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Power manager
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Hal
+ *
+ * @{
+ */
+
+#ifndef __POWER_MGR_H__
+#define __POWER_MGR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The power manager scales the CPU frequency according to the render load
+ * of the display manager. During fades, webserver activity and a running
+ * update, the max. CPU frequency is hold.
+ */
+class PowerMgr
+{
+public:
+
+    /**
+     * The reason of the selected CPU frequency.
+     */
+    enum Reason
+    {
+        REASON_LOAD = 0,    /**< Selected according to the render load */
+        REASON_FADE,        /**< Max. frequency, because of a fade effect */
+        REASON_WEB,         /**< Max. frequency, because of webserver activity */
+        REASON_UPDATE       /**< Max. frequency, because of a running update */
+    };
+
+    /**
+     * Get power manager instance.
+     *
+     * @return Power manager instance
+     */
+    static PowerMgr& getInstance()
+    {
+        static PowerMgr instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Select the CPU frequency. Call it periodically in the main loop.
+     */
+    void process();
+
+    /**
+     * Notify about webserver activity, which will hold the max. CPU frequency
+     * for a while. It can be called from any context.
+     */
+    void notifyActivity()
+    {
+        m_activityTimestamp = millis();
+        m_isActivity        = true;
+
+        return;
+    }
+
+    /**
+     * Was there webserver activity within the last ACTIVITY_HOLD ms?
+     *
+     * @return If active, it will return true otherwise false.
+     */
+    bool isWebActive() const
+    {
+        return ((true == m_isActivity) &&
+                (ACTIVITY_HOLD > (millis() - m_activityTimestamp)));
+    }
+
+    /**
+     * Get the requested CPU frequency.
+     *
+     * @return CPU frequency in MHz
+     */
+    uint32_t getCpuFreq() const
+    {
+        return m_cpuFreq;
+    }
+
+    /**
+     * Get the reason of the requested CPU frequency.
+     *
+     * @return Reason
+     */
+    Reason getReason() const
+    {
+        return m_reason;
+    }
+
+    /**
+     * Get the render load of the latest processing cycle.
+     *
+     * @return Peak frame time in percent of the frame period
+     */
+    uint8_t getLoad() const
+    {
+        return m_load;
+    }
+
+    /**
+     * Get the reason as user friendly string.
+     *
+     * @param[in] reason    Reason
+     *
+     * @return Reason name
+     */
+    static const char* reasonToStr(Reason reason);
+
+    /** Processing cycle of the render load in ms. */
+    static const uint32_t   PROCESSING_CYCLE    = 1000U;
+
+    /** Time in ms the max. CPU frequency is hold after the last webserver activity. */
+    static const uint32_t   ACTIVITY_HOLD       = 5000U;
+
+    /** Max. render load in percent, a CPU frequency shall run with. */
+    static const uint8_t    LOAD_LIMIT          = 60U;
+
+    /** Hysteresis in percent of the render load, before the CPU frequency is lowered. */
+    static const uint8_t    LOAD_HYSTERESIS     = 15U;
+
+    /** Number of selectable CPU frequencies. */
+    static const uint8_t    CPU_FREQ_LEVELS     = 3U;
+
+private:
+
+    /** Selectable CPU frequencies in MHz, in ascending order. */
+    static const uint32_t   CPU_FREQS[CPU_FREQ_LEVELS];
+
+    SimpleTimer         m_timer;                /**< Timer used for cyclic processing of the render load. */
+    uint8_t             m_level;                /**< Index of the CPU frequency, selected by render load. */
+    uint32_t            m_cpuFreq;              /**< Requested CPU frequency in MHz */
+    Reason              m_reason;               /**< Reason of the requested CPU frequency */
+    uint8_t             m_load;                 /**< Render load of the latest processing cycle in percent */
+    uint32_t            m_peakFrameTime;        /**< Peak frame time in ms of the current processing cycle */
+    uint32_t            m_missedDeadlines;      /**< Number of missed deadlines at the previous processing cycle */
+    uint32_t            m_loadCpuFreq;          /**< CPU frequency in MHz, the render load was measured with */
+    volatile uint32_t   m_activityTimestamp;    /**< Timestamp in ms of the last webserver activity */
+    volatile bool       m_isActivity;           /**< Is a webserver activity pending? */
+
+    /**
+     * Constructs the power manager.
+     */
+    PowerMgr() :
+        m_timer(),
+        m_level(CPU_FREQ_LEVELS - 1U),
+        m_cpuFreq(CPU_FREQS[CPU_FREQ_LEVELS - 1U]),
+        m_reason(REASON_LOAD),
+        m_load(0U),
+        m_peakFrameTime(0U),
+        m_missedDeadlines(0U),
+        m_loadCpuFreq(CPU_FREQS[CPU_FREQ_LEVELS - 1U]),
+        m_activityTimestamp(0U),
+        m_isActivity(false)
+    {
+    }
+
+    /**
+     * Destroys the power manager.
+     */
+    ~PowerMgr()
+    {
+        /* Will never be called. */
+    }
+
+    PowerMgr(const PowerMgr& powerMgr);
+    PowerMgr& operator=(const PowerMgr& powerMgr);
+
+    /**
+     * Is the max. CPU frequency required, independent of the render load?
+     *
+     * @param[out] reason   Reason of the max. CPU frequency
+     *
+     * @return If max. CPU frequency is required, it will return true otherwise false.
+     */
+    bool isMaxFreqRequired(Reason& reason);
+
+    /**
+     * Select the CPU frequency level according to the render load of the
+     * latest processing cycle.
+     *
+     * @param[in] isDeadlineMissed  Missed the display a deadline in the latest processing cycle?
+     */
+    void updateLevel(bool isDeadlineMissed);
+
+    /**
+     * Apply the CPU frequency.
+     *
+     * @param[in] cpuFreq   CPU frequency in MHz
+     */
+    void applyCpuFreq(uint32_t cpuFreq);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __POWER_MGR_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,448 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Real time clock driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "RtcDrv.h"
+#include "Board.h"
+#include "ClockDrv.h"
+
+#include <Wire.h>
+#include <sys/time.h>
+#include <Logging.h>
+#include <Metrics.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int32_t getDrift();
+static int32_t getDriftRate();
+static uint8_t fromBcd(uint8_t value);
+static uint8_t toBcd(uint8_t value);
+static time_t makeUnixTime(const tm& timeInfo);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Drift of the RTC, read during export. */
+static MetricGauge      gMetricDrift("pixelix_rtc_drift_s", "Deviation of the RTC in s, found during the last discipline.", getDrift);
+
+/** Drift rate of the RTC, read during export. */
+static MetricGauge      gMetricDriftRate("pixelix_rtc_drift_rate_ppm", "Drift rate of the RTC in ppm.", getDriftRate);
+
+/** I2C clock in Hz. Both RTC chips support the fast mode. */
+static const uint32_t   I2C_CLOCK           = 400000U;
+
+/** Number of time registers */
+static const uint8_t    TIME_REG_COUNT      = 7U;
+
+/** DS3231: Seconds register */
+static const uint8_t    DS3231_REG_SECONDS  = 0x00U;
+
+/** DS3231: Status register */
+static const uint8_t    DS3231_REG_STATUS   = 0x0FU;
+
+/** DS3231: Oscillator stop flag in the status register */
+static const uint8_t    DS3231_OSF          = 0x80U;
+
+/** PCF8563: Seconds register */
+static const uint8_t    PCF8563_REG_SECONDS = 0x02U;
+
+/** PCF8563: Voltage low flag in the seconds register */
+static const uint8_t    PCF8563_VL          = 0x80U;
+
+/** Century flag in the month register of both chips, set for 2100 and later. */
+static const uint8_t    CENTURY_FLAG        = 0x80U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool RtcDrv::begin()
+{
+    bool    isSet       = false;
+    time_t  timestamp   = 0;
+
+    (void)Wire.begin(Board::Pin::i2cSdaPinNo, Board::Pin::i2cSclPinNo, I2C_CLOCK);
+
+    if (true == isAvailable(DS3231_ADDR))
+    {
+        m_chip = CHIP_DS3231;
+        LOG_INFO("RTC DS3231 detected.");
+    }
+    else if (true == isAvailable(PCF8563_ADDR))
+    {
+        m_chip = CHIP_PCF8563;
+        LOG_INFO("RTC PCF8563 detected.");
+    }
+    else
+    {
+        m_chip = CHIP_NONE;
+    }
+
+    if (CHIP_NONE != m_chip)
+    {
+        if (false == readTime(timestamp))
+        {
+            LOG_WARNING("RTC time is invalid.");
+        }
+        else
+        {
+            struct timeval tv = { 0 };
+
+            tv.tv_sec = timestamp;
+
+            if (0 == settimeofday(&tv, nullptr))
+            {
+                isSet = true;
+            }
+        }
+    }
+
+    return isSet;
+}
+
+void RtcDrv::process()
+{
+    if (CHIP_NONE != m_chip)
+    {
+        if (false == m_timer.isTimerRunning())
+        {
+            m_timer.start(FIRST_DISCIPLINE_DELAY);
+        }
+        else if (true == m_timer.isTimeout())
+        {
+            discipline();
+            m_timer.start(DISCIPLINE_PERIOD);
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void RtcDrv::discipline()
+{
+    time_t  now         = time(nullptr);
+    time_t  rtcTime     = 0;
+
+    /* A not synchronized system time would spoil the RTC. */
+    if ((true == ClockDrv::getInstance().isSynchronized()) &&
+        (MIN_VALID_TIME <= now))
+    {
+        if (true == readTime(rtcTime))
+        {
+            m_drift = static_cast<int32_t>(rtcTime - now);
+
+            /* The rate is only known over the period since the RTC was set. */
+            if ((0 < m_lastDiscipline) &&
+                (m_lastDiscipline < now))
+            {
+                int64_t drift = static_cast<int64_t>(m_drift) * 1000000LL;
+
+                m_driftRate = static_cast<int32_t>(drift / static_cast<int64_t>(now - m_lastDiscipline));
+            }
+
+            if (0 != m_drift)
+            {
+                LOG_INFO("RTC drift: %d s", m_drift);
+            }
+        }
+
+        if (false == writeTime(now))
+        {
+            LOG_WARNING("Couldn't set RTC time.");
+        }
+        else
+        {
+            m_lastDiscipline = now;
+        }
+    }
+
+    return;
+}
+
+bool RtcDrv::readTime(time_t& timestamp) const
+{
+    bool    isValid             = false;
+    uint8_t regs[TIME_REG_COUNT];
+    tm      timeInfo            = { 0 };
+
+    if (CHIP_DS3231 == m_chip)
+    {
+        uint8_t status = 0U;
+
+        if ((true == readRegs(DS3231_ADDR, DS3231_REG_STATUS, &status, 1U)) &&
+            (0U == (status & DS3231_OSF)) &&
+            (true == readRegs(DS3231_ADDR, DS3231_REG_SECONDS, regs, TIME_REG_COUNT)))
+        {
+            /* Registers: seconds, minutes, hours (24h), weekday, day, month, year */
+            timeInfo.tm_sec     = fromBcd(regs[0] & 0x7FU);
+            timeInfo.tm_min     = fromBcd(regs[1] & 0x7FU);
+            timeInfo.tm_hour    = fromBcd(regs[2] & 0x3FU);
+            timeInfo.tm_mday    = fromBcd(regs[4] & 0x3FU);
+            timeInfo.tm_mon     = fromBcd(regs[5] & 0x1FU) - 1;
+            timeInfo.tm_year    = fromBcd(regs[6]) + 100 + ((0U != (regs[5] & CENTURY_FLAG)) ? 100 : 0);
+            isValid             = true;
+        }
+    }
+    else if (CHIP_PCF8563 == m_chip)
+    {
+        if ((true == readRegs(PCF8563_ADDR, PCF8563_REG_SECONDS, regs, TIME_REG_COUNT)) &&
+            (0U == (regs[0] & PCF8563_VL)))
+        {
+            /* Registers: seconds, minutes, hours, day, weekday, month, year */
+            timeInfo.tm_sec     = fromBcd(regs[0] & 0x7FU);
+            timeInfo.tm_min     = fromBcd(regs[1] & 0x7FU);
+            timeInfo.tm_hour    = fromBcd(regs[2] & 0x3FU);
+            timeInfo.tm_mday    = fromBcd(regs[3] & 0x3FU);
+            timeInfo.tm_mon     = fromBcd(regs[5] & 0x1FU) - 1;
+            timeInfo.tm_year    = fromBcd(regs[6]) + 100 + ((0U != (regs[5] & CENTURY_FLAG)) ? 100 : 0);
+            isValid             = true;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    if (true == isValid)
+    {
+        timestamp = makeUnixTime(timeInfo);
+
+        /* A RTC, which was never set, may run with its default time. */
+        if (MIN_VALID_TIME > timestamp)
+        {
+            isValid = false;
+        }
+    }
+
+    return isValid;
+}
+
+bool RtcDrv::writeTime(time_t timestamp) const
+{
+    bool    isSuccessful        = false;
+    uint8_t regs[TIME_REG_COUNT];
+    tm      timeInfo;
+    uint8_t century             = 0U;
+
+    (void)gmtime_r(&timestamp, &timeInfo);
+
+    if (200 <= timeInfo.tm_year)
+    {
+        century = CENTURY_FLAG;
+    }
+
+    if (CHIP_DS3231 == m_chip)
+    {
+        uint8_t status = 0U;
+
+        regs[0] = toBcd(timeInfo.tm_sec);
+        regs[1] = toBcd(timeInfo.tm_min);
+        regs[2] = toBcd(timeInfo.tm_hour);
+        regs[3] = toBcd(timeInfo.tm_wday + 1);
+        regs[4] = toBcd(timeInfo.tm_mday);
+        regs[5] = toBcd(timeInfo.tm_mon + 1) | century;
+        regs[6] = toBcd(timeInfo.tm_year % 100);
+
+        /* The oscillator stop flag is cleared, because the time is valid now. */
+        if ((true == writeRegs(DS3231_ADDR, DS3231_REG_SECONDS, regs, TIME_REG_COUNT)) &&
+            (true == readRegs(DS3231_ADDR, DS3231_REG_STATUS, &status, 1U)))
+        {
+            status &= ~DS3231_OSF;
+            isSuccessful = writeRegs(DS3231_ADDR, DS3231_REG_STATUS, &status, 1U);
+        }
+    }
+    else if (CHIP_PCF8563 == m_chip)
+    {
+        /* Writing the seconds clears the voltage low flag. */
+        regs[0] = toBcd(timeInfo.tm_sec);
+        regs[1] = toBcd(timeInfo.tm_min);
+        regs[2] = toBcd(timeInfo.tm_hour);
+        regs[3] = toBcd(timeInfo.tm_mday);
+        regs[4] = toBcd(timeInfo.tm_wday);
+        regs[5] = toBcd(timeInfo.tm_mon + 1) | century;
+        regs[6] = toBcd(timeInfo.tm_year % 100);
+
+        isSuccessful = writeRegs(PCF8563_ADDR, PCF8563_REG_SECONDS, regs, TIME_REG_COUNT);
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+bool RtcDrv::isAvailable(uint8_t addr)
+{
+    Wire.beginTransmission(addr);
+
+    return (0U == Wire.endTransmission());
+}
+
+bool RtcDrv::readRegs(uint8_t addr, uint8_t reg, uint8_t* buffer, uint8_t size)
+{
+    bool isSuccessful = false;
+
+    Wire.beginTransmission(addr);
+    (void)Wire.write(reg);
+
+    if ((0U == Wire.endTransmission(false)) &&
+        (size == Wire.requestFrom(addr, size)))
+    {
+        uint8_t index = 0U;
+
+        for(index = 0U; index < size; ++index)
+        {
+            buffer[index] = static_cast<uint8_t>(Wire.read());
+        }
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool RtcDrv::writeRegs(uint8_t addr, uint8_t reg, const uint8_t* buffer, uint8_t size)
+{
+    Wire.beginTransmission(addr);
+    (void)Wire.write(reg);
+    (void)Wire.write(buffer, size);
+
+    return (0U == Wire.endTransmission());
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the drift of the RTC.
+ *
+ * @return Drift in s
+ */
+static int32_t getDrift()
+{
+    return RtcDrv::getInstance().getDrift();
+}
+
+/**
+ * Get the drift rate of the RTC.
+ *
+ * @return Drift rate in ppm
+ */
+static int32_t getDriftRate()
+{
+    return RtcDrv::getInstance().getDriftRate();
+}
+
+/**
+ * Convert a BCD value to binary.
+ *
+ * @param[in] value BCD value
+ *
+ * @return Binary value
+ */
+static uint8_t fromBcd(uint8_t value)
+{
+    return ((value >> 4U) * 10U) + (value & 0x0FU);
+}
+
+/**
+ * Convert a binary value to BCD.
+ *
+ * @param[in] value Binary value, 0 - 99
+ *
+ * @return BCD value
+ */
+static uint8_t toBcd(uint8_t value)
+{
+    return ((value / 10U) << 4U) | (value % 10U);
+}
+
+/**
+ * Convert a UTC time to a unix timestamp. In contrast to mktime(), the
+ * timezone is not considered.
+ *
+ * @param[in] timeInfo  UTC time
+ *
+ * @return Unix timestamp
+ */
+static time_t makeUnixTime(const tm& timeInfo)
+{
+    /* Days since 1970-01-01 of the civil date, with the year starting in
+     * March to put the leap day at its end.
+     */
+    int32_t year    = timeInfo.tm_year + 1900 - ((2 > timeInfo.tm_mon) ? 1 : 0);
+    int32_t month   = timeInfo.tm_mon + ((2 > timeInfo.tm_mon) ? 10 : -2);
+    int32_t era     = year / 400;
+    int32_t yoe     = year - era * 400;
+    int32_t doy     = (153 * month + 2) / 5 + timeInfo.tm_mday - 1;
+    int32_t doe     = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int32_t days    = era * 146097 + doe - 719468;
+
+    return static_cast<time_t>(days) * 86400 +
+           timeInfo.tm_hour * 3600 +
+           timeInfo.tm_min * 60 +
+           timeInfo.tm_sec;
+}
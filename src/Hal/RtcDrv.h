@@ -0,0 +1,254 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Real time clock driver
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Hal
+ *
+ * @{
+ */
+
+#ifndef __RTC_DRV_H__
+#define __RTC_DRV_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#include <Arduino.h>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The real time clock driver supports a optional battery buffered I2C RTC,
+ * either a DS3231 or a PCF8563. The RTC keeps the time in UTC.
+ *
+ * During startup the RTC time is set as system time, so the time is valid
+ * immediately and not only after the NTP synchronization. As long as the
+ * system is connected, its NTP disciplined time is periodically written
+ * back to the RTC. The deviation of the RTC found at that moment is kept as
+ * drift.
+ */
+class RtcDrv
+{
+public:
+
+    /**
+     * Supported RTC chips.
+     */
+    enum Chip
+    {
+        CHIP_NONE = 0,  /**< No RTC available */
+        CHIP_DS3231,    /**< Maxim DS3231 */
+        CHIP_PCF8563    /**< NXP PCF8563 */
+    };
+
+    /** I2C address of the DS3231 */
+    static const uint8_t    DS3231_ADDR             = 0x68U;
+
+    /** I2C address of the PCF8563 */
+    static const uint8_t    PCF8563_ADDR            = 0x51U;
+
+    /**
+     * Delay in ms after the connection, till the RTC is disciplined the first
+     * time. Till then the NTP synchronization is done.
+     */
+    static const uint32_t   FIRST_DISCIPLINE_DELAY  = 60U * 1000U;
+
+    /** Period in ms, in which the RTC is disciplined. */
+    static const uint32_t   DISCIPLINE_PERIOD       = 60U * 60U * 1000U;
+
+    /**
+     * Min. valid unix timestamp (2021-01-01). A older system time is not
+     * synchronized yet and not written to the RTC.
+     */
+    static const time_t     MIN_VALID_TIME          = 1609459200;
+
+    /**
+     * Get the RTC driver instance.
+     *
+     * @return RTC driver instance
+     */
+    static RtcDrv& getInstance()
+    {
+        static RtcDrv instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Detect the RTC and set its time as system time, if it is valid.
+     *
+     * @return If the system time was set, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Discipline the RTC periodically with the system time.
+     * Call it only, while the system time is synchronized via NTP.
+     */
+    void process();
+
+    /**
+     * Get the detected RTC chip.
+     *
+     * @return RTC chip
+     */
+    Chip getChip() const
+    {
+        return m_chip;
+    }
+
+    /**
+     * Get the deviation of the RTC, found during the last discipline.
+     * A positive drift means, the RTC was ahead.
+     *
+     * @return Drift in s
+     */
+    int32_t getDrift() const
+    {
+        return m_drift;
+    }
+
+    /**
+     * Get the drift rate of the RTC, found during the last discipline.
+     *
+     * @return Drift rate in ppm
+     */
+    int32_t getDriftRate() const
+    {
+        return m_driftRate;
+    }
+
+private:
+
+    Chip        m_chip;             /**< Detected RTC chip */
+    time_t      m_lastDiscipline;   /**< Unix timestamp of the last discipline, 0 if not disciplined yet. */
+    int32_t     m_drift;            /**< Drift in s, found during the last discipline */
+    int32_t     m_driftRate;        /**< Drift rate in ppm, found during the last discipline */
+    SimpleTimer m_timer;            /**< Timer for the periodic discipline */
+
+    /**
+     * Constructs the RTC driver.
+     */
+    RtcDrv() :
+        m_chip(CHIP_NONE),
+        m_lastDiscipline(0),
+        m_drift(0),
+        m_driftRate(0),
+        m_timer()
+    {
+    }
+
+    /**
+     * Destroys the RTC driver.
+     */
+    ~RtcDrv()
+    {
+    }
+
+    /* Prevent copying */
+    RtcDrv(const RtcDrv& drv);
+    RtcDrv& operator=(const RtcDrv& drv);
+
+    /**
+     * Discipline the RTC with the system time and determine its drift.
+     */
+    void discipline();
+
+    /**
+     * Read the time from the RTC.
+     *
+     * @param[out] timestamp    Unix timestamp
+     *
+     * @return If the RTC time is valid, it will return true otherwise false.
+     */
+    bool readTime(time_t& timestamp) const;
+
+    /**
+     * Write the time to the RTC. A invalid RTC time becomes valid again.
+     *
+     * @param[in] timestamp Unix timestamp
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool writeTime(time_t timestamp) const;
+
+    /**
+     * Is a device at the I2C address available?
+     *
+     * @param[in] addr  I2C address
+     *
+     * @return If available, it will return true otherwise false.
+     */
+    static bool isAvailable(uint8_t addr);
+
+    /**
+     * Read registers of a I2C device.
+     *
+     * @param[in]   addr    I2C address
+     * @param[in]   reg     First register address
+     * @param[out]  buffer  Register values
+     * @param[in]   size    Number of registers
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool readRegs(uint8_t addr, uint8_t reg, uint8_t* buffer, uint8_t size);
+
+    /**
+     * Write registers of a I2C device.
+     *
+     * @param[in] addr      I2C address
+     * @param[in] reg       First register address
+     * @param[in] buffer    Register values
+     * @param[in] size      Number of registers
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool writeRegs(uint8_t addr, uint8_t reg, const uint8_t* buffer, uint8_t size);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __RTC_DRV_H__ */
+
+/** @} */
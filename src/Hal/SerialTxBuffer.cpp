@@ -0,0 +1,275 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Buffered serial output
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SerialTxBuffer.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool SerialTxBuffer::begin()
+{
+    bool status = true;
+
+    if (nullptr == m_taskHandle)
+    {
+        BaseType_t osRet = xTaskCreateUniversal(drainTask,
+                                                "serialTxTask",
+                                                TASK_STACK_SIZE,
+                                                this,
+                                                TASK_PRIORITY,
+                                                &m_taskHandle,
+                                                TASK_RUN_CORE);
+
+        /* Task not created? */
+        if (pdPASS != osRet)
+        {
+            m_taskHandle    = nullptr;
+            status          = false;
+        }
+    }
+
+    return status;
+}
+
+size_t SerialTxBuffer::write(const uint8_t* buffer, size_t size)
+{
+    size_t written = 0U;
+
+    if ((nullptr == buffer) || (0U == size))
+    {
+        return 0U;
+    }
+
+    /* The critical section is short, it only copies into RAM. */
+    portENTER_CRITICAL(&m_mux);
+
+    if ((BUFFER_SIZE - (m_head - m_tail)) < size)
+    {
+        ++m_dropped;
+    }
+    else
+    {
+        uint32_t    pos     = m_head & (BUFFER_SIZE - 1U);
+        size_t      first   = BUFFER_SIZE - pos;
+
+        if (size < first)
+        {
+            first = size;
+        }
+
+        memcpy(&m_buffer[pos], buffer, first);
+        memcpy(&m_buffer[0], &buffer[first], size - first);
+
+        m_head += size;
+        written = size;
+    }
+
+    portEXIT_CRITICAL(&m_mux);
+
+    /* Wake up the drain task. */
+    if ((0U < written) && (nullptr != m_taskHandle))
+    {
+        (void)xTaskNotifyGive(m_taskHandle);
+    }
+
+    return written;
+}
+
+int SerialTxBuffer::availableForWrite()
+{
+    uint32_t available = 0U;
+
+    portENTER_CRITICAL(&m_mux);
+    available = BUFFER_SIZE - (m_head - m_tail);
+    portEXIT_CRITICAL(&m_mux);
+
+    return static_cast<int>(available);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SerialTxBuffer::drainTask(void* parameters)
+{
+    SerialTxBuffer* txBuffer = reinterpret_cast<SerialTxBuffer*>(parameters);
+
+    if (nullptr != txBuffer)
+    {
+        /* Time to wait for new data, if the ring buffer is empty. */
+        const TickType_t    IDLE_TIMEOUT    = pdMS_TO_TICKS(1000U);
+
+        while(true)
+        {
+            if (0U < txBuffer->m_dropped)
+            {
+                txBuffer->reportDropped();
+            }
+
+            /* Ring buffer empty? Sleep until new data is written. */
+            if (true == txBuffer->drain())
+            {
+                (void)ulTaskNotifyTake(pdTRUE, IDLE_TIMEOUT);
+            }
+            /* UART TX FIFO is full. It needs ~11 ms at 115200 baud to
+             * send it completely, therefore just give it a tick.
+             */
+            else
+            {
+                vTaskDelay(1U);
+            }
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+bool SerialTxBuffer::drain()
+{
+    uint8_t     chunk[CHUNK_SIZE];
+    bool        isEmpty = false;
+
+    while(false == isEmpty)
+    {
+        int         fifoFree    = m_serial.availableForWrite();
+        size_t      size        = 0U;
+        size_t      index       = 0U;
+        uint32_t    tail        = 0U;
+
+        if (0 >= fifoFree)
+        {
+            break;
+        }
+
+        portENTER_CRITICAL(&m_mux);
+        size = m_head - m_tail;
+        tail = m_tail;
+        portEXIT_CRITICAL(&m_mux);
+
+        if (0U == size)
+        {
+            isEmpty = true;
+            break;
+        }
+
+        if (static_cast<size_t>(fifoFree) < size)
+        {
+            size = static_cast<size_t>(fifoFree);
+        }
+
+        if (CHUNK_SIZE < size)
+        {
+            size = CHUNK_SIZE;
+        }
+
+        /* Only the drain task reads and moves the tail, therefore the data
+         * can be copied outside the critical section.
+         */
+        for(index = 0U; index < size; ++index)
+        {
+            chunk[index] = m_buffer[(tail + index) & (BUFFER_SIZE - 1U)];
+        }
+
+        portENTER_CRITICAL(&m_mux);
+        m_tail += size;
+        portEXIT_CRITICAL(&m_mux);
+
+        /* It fits completely into the UART TX FIFO and won't block. */
+        (void)m_serial.write(chunk, size);
+    }
+
+    return isEmpty;
+}
+
+void SerialTxBuffer::reportDropped()
+{
+    char        str[64U];
+    uint32_t    dropped = 0U;
+    int         len     = 0;
+
+    portENTER_CRITICAL(&m_mux);
+    dropped     = m_dropped;
+    m_dropped   = 0U;
+    portEXIT_CRITICAL(&m_mux);
+
+    len = snprintf(str, sizeof(str), "|%u| WARNING: %u log messages dropped.\r\n", millis(), dropped);
+
+    if ((0 < len) && (sizeof(str) > static_cast<size_t>(len)))
+    {
+        /* Still no space? Report it later again. */
+        if (0U == write(reinterpret_cast<const uint8_t*>(str), static_cast<size_t>(len)))
+        {
+            portENTER_CRITICAL(&m_mux);
+            m_dropped += dropped - 1U;
+            portEXIT_CRITICAL(&m_mux);
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,200 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Buffered serial output
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup hal
+ *
+ * @{
+ */
+
+#ifndef __SERIAL_TX_BUFFER_H__
+#define __SERIAL_TX_BUFFER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Non-blocking output to a hardware serial interface.
+ *
+ * The written data is copied into a ring buffer and the caller returns
+ * immediately. A low priority drain task moves the data into the UART TX
+ * FIFO, but only as much as fits, so neither the caller nor the drain task
+ * ever waits for the UART. If the ring buffer can't take a complete write,
+ * the whole write is dropped and counted. The number of dropped writes is
+ * reported in the output as soon as there is space again.
+ *
+ * Use it as output of a printer log sink, which writes a complete log
+ * message with a single write. Then only complete log messages are dropped.
+ */
+class SerialTxBuffer : public Print
+{
+public:
+
+    /**
+     * Constructs the buffered serial output.
+     *
+     * @param[in] serial    Hardware serial interface, which to drain to.
+     */
+    SerialTxBuffer(HardwareSerial& serial) :
+        Print(),
+        m_serial(serial),
+        m_mux(portMUX_INITIALIZER_UNLOCKED),
+        m_buffer(),
+        m_head(0U),
+        m_tail(0U),
+        m_dropped(0U),
+        m_taskHandle(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the buffered serial output.
+     */
+    ~SerialTxBuffer()
+    {
+    }
+
+    /**
+     * Start the drain task. The serial interface must be already initialized.
+     * Data which is written before, stays in the ring buffer until then.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Write a single byte.
+     *
+     * @param[in] data  Byte to write
+     *
+     * @return Number of written bytes.
+     */
+    size_t write(uint8_t data) final
+    {
+        return write(&data, 1U);
+    }
+
+    /**
+     * Write data. Either all data is written to the ring buffer or nothing.
+     *
+     * @param[in] buffer    Data buffer
+     * @param[in] size      Data buffer size in bytes
+     *
+     * @return Number of written bytes.
+     */
+    size_t write(const uint8_t* buffer, size_t size) final;
+
+    /**
+     * Get the number of bytes, which can be written without dropping.
+     *
+     * @return Number of free bytes in the ring buffer.
+     */
+    int availableForWrite();
+
+    /**
+     * Get the number of dropped writes, which are not reported yet.
+     *
+     * @return Number of dropped writes
+     */
+    uint32_t getDroppedCount() const
+    {
+        return m_dropped;
+    }
+
+    /** Ring buffer size in bytes. Must be a power of 2. */
+    static const uint32_t   BUFFER_SIZE     = 4096U;
+
+private:
+
+    /** Drain task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 2048U;
+
+    /** Drain task priority, lower than every real-time task. */
+    static const UBaseType_t    TASK_PRIORITY       = 1U;
+
+    /** Drain task runs on the application core. */
+    static const BaseType_t     TASK_RUN_CORE       = 1;
+
+    /** Max. number of bytes, moved to the UART at once. */
+    static const size_t         CHUNK_SIZE          = 128U;
+
+    HardwareSerial&     m_serial;               /**< Serial interface, which to drain to */
+    portMUX_TYPE        m_mux;                  /**< Protects the ring buffer indices */
+    uint8_t             m_buffer[BUFFER_SIZE];  /**< Ring buffer */
+    uint32_t            m_head;                 /**< Write index, free running */
+    uint32_t            m_tail;                 /**< Read index, free running */
+    volatile uint32_t   m_dropped;              /**< Number of dropped writes */
+    TaskHandle_t        m_taskHandle;           /**< Drain task handle */
+
+    SerialTxBuffer(const SerialTxBuffer& txBuffer);
+    SerialTxBuffer& operator=(const SerialTxBuffer& txBuffer);
+
+    /**
+     * Drain task, which moves the data from the ring buffer to the UART.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void drainTask(void* parameters);
+
+    /**
+     * Move as much data from the ring buffer to the UART TX FIFO, as fits
+     * without waiting.
+     *
+     * @return If the ring buffer is empty, it will return true otherwise false.
+     */
+    bool drain();
+
+    /**
+     * Write the number of dropped writes to the ring buffer.
+     */
+    void reportDropped();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SERIAL_TX_BUFFER_H__ */
+
+/** @} */
@@ -0,0 +1,390 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Thermal monitor
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ThermalMonitor.h"
+#include "Board.h"
+#include "LedMatrix.h"
+
+#include <math.h>
+#include <Logging.h>
+#include <Metrics.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/* The ESP32 die temperature sensor is not part of the public API. It returns
+ * the temperature in degree Fahrenheit.
+ */
+extern "C" uint8_t temprature_sens_read();
+
+static int32_t getDieTemperature();
+static int32_t getLedTemperature();
+static int32_t getCurrentLimit();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** ESP32 die temperature, read during export. */
+static MetricGauge  gMetricDieTemperature("pixelix_temperature_die_c", "ESP32 die temperature in degree Celsius.", getDieTemperature);
+
+/** LED matrix temperature, read during export. */
+static MetricGauge  gMetricLedTemperature("pixelix_temperature_led_c", "LED matrix temperature in degree Celsius, measured by the optional NTC.", getLedTemperature);
+
+/** Current limit of the thermal throttling, read during export. */
+static MetricGauge  gMetricCurrentLimit("pixelix_thermal_current_limit_percent", "Current limit of the LED matrix by thermal throttling in percent of the max. supply current.", getCurrentLimit);
+
+/** Raw value of the die temperature sensor, if it is not supported by the chip. */
+static const uint8_t    DIE_SENSOR_UNSUPPORTED  = 128U;
+
+/**
+ * Min. ADC value of a plausible NTC measurement. Below the NTC is shorted.
+ */
+static const uint16_t   NTC_ADC_MIN             = Board::adcResolution / 100U;
+
+/**
+ * Max. ADC value of a plausible NTC measurement. Above the NTC is open.
+ */
+static const uint16_t   NTC_ADC_MAX             = Board::adcResolution - NTC_ADC_MIN;
+
+/** Min. temperature in degree Celsius of the NTC lookup table. */
+static const float      NTC_LUT_TEMP_MIN        = -40.0f;
+
+/** Max. temperature in degree Celsius of the NTC lookup table. */
+static const float      NTC_LUT_TEMP_MAX        = 150.0f;
+
+/** Temperature filter divider, a higher value means a stronger filtering. */
+static const int16_t    FILTER_DIV              = 4;
+
+/** 0 degree Celsius in Kelvin */
+static const float      ZERO_CELSIUS            = 273.15f;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void ThermalMonitor::begin()
+{
+    uint8_t index = 0U;
+
+    /* The lookup table avoids the logarithm during runtime. */
+    for(index = 0U; index < NTC_LUT_SIZE; ++index)
+    {
+        const uint32_t  ADC_STEP    = Board::adcResolution / (NTC_LUT_SIZE - 1U);
+        uint32_t        adcValue    = index * ADC_STEP;
+        float           temperature = NTC_LUT_TEMP_MAX;
+
+        if (0U == adcValue)
+        {
+            temperature = NTC_LUT_TEMP_MAX;
+        }
+        else if (Board::adcResolution <= adcValue)
+        {
+            temperature = NTC_LUT_TEMP_MIN;
+        }
+        else
+        {
+            const float T0          = static_cast<float>(Board::Ntc::nominalTemperature) + ZERO_CELSIUS;
+            float       resistance  = static_cast<float>(Board::Ntc::seriesResistance) * adcValue / (Board::adcResolution - adcValue);
+            float       lnRatio     = logf(resistance / static_cast<float>(Board::Ntc::nominalResistance));
+
+            temperature = 1.0f / ((1.0f / T0) + (lnRatio / static_cast<float>(Board::Ntc::beta))) - ZERO_CELSIUS;
+
+            if (NTC_LUT_TEMP_MIN > temperature)
+            {
+                temperature = NTC_LUT_TEMP_MIN;
+            }
+            else if (NTC_LUT_TEMP_MAX < temperature)
+            {
+                temperature = NTC_LUT_TEMP_MAX;
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        m_ntcLut[index] = static_cast<int16_t>(lroundf(temperature * (1U << TEMP_FRAC_BITS)));
+    }
+
+    measure();
+
+    if (TEMPERATURE_INVALID == m_dieTemperature)
+    {
+        LOG_INFO("Die temperature sensor not supported.");
+    }
+
+    if ((true == Board::Ntc::isAvailable) &&
+        (TEMPERATURE_INVALID == m_ledTemperature))
+    {
+        LOG_WARNING("NTC is not plausible.");
+    }
+
+    m_timer.start(SAMPLE_PERIOD);
+
+    return;
+}
+
+void ThermalMonitor::process()
+{
+    if (true == m_timer.isTimeout())
+    {
+        uint8_t currentLimitGoal    = 0U;
+        uint8_t currentLimit        = m_currentLimit;
+
+        measure();
+        currentLimitGoal = calcCurrentLimitGoal();
+
+        /* Decrease faster than increase, to protect the hardware. */
+        if (currentLimitGoal < currentLimit)
+        {
+            if ((currentLimit - currentLimitGoal) > CURRENT_LIMIT_DEC_STEP)
+            {
+                currentLimit -= CURRENT_LIMIT_DEC_STEP;
+            }
+            else
+            {
+                currentLimit = currentLimitGoal;
+            }
+        }
+        else if (currentLimitGoal > currentLimit)
+        {
+            if ((currentLimitGoal - currentLimit) > CURRENT_LIMIT_INC_STEP)
+            {
+                currentLimit += CURRENT_LIMIT_INC_STEP;
+            }
+            else
+            {
+                currentLimit = currentLimitGoal;
+            }
+        }
+        else
+        {
+            ;
+        }
+
+        if (currentLimit != m_currentLimit)
+        {
+            if (100U == m_currentLimit)
+            {
+                LOG_WARNING("Thermal throttling started (die: %d C, LED: %d C).", getDieTemperature(), getLedTemperature());
+            }
+            else if (100U == currentLimit)
+            {
+                LOG_INFO("Thermal throttling stopped.");
+            }
+            else
+            {
+                ;
+            }
+
+            m_currentLimit = currentLimit;
+            LedMatrix::getInstance().setCurrentLimit(m_currentLimit);
+        }
+
+        m_timer.restart();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void ThermalMonitor::measure()
+{
+    m_dieTemperature = filter(m_dieTemperature, readDieTemperature());
+
+    if (true == Board::Ntc::isAvailable)
+    {
+        m_ledTemperature = filter(m_ledTemperature, readLedTemperature());
+    }
+
+    return;
+}
+
+int16_t ThermalMonitor::readDieTemperature() const
+{
+    int16_t temperature = TEMPERATURE_INVALID;
+    uint8_t raw         = temprature_sens_read();
+
+    if (DIE_SENSOR_UNSUPPORTED != raw)
+    {
+        temperature = ((static_cast<int16_t>(raw) - 32) * 5 * (1 << TEMP_FRAC_BITS)) / 9;
+    }
+
+    return temperature;
+}
+
+int16_t ThermalMonitor::readLedTemperature() const
+{
+    int16_t     temperature = TEMPERATURE_INVALID;
+    uint16_t    adcValue    = Board::ntcIn.read();
+
+    if ((NTC_ADC_MIN <= adcValue) &&
+        (NTC_ADC_MAX >= adcValue))
+    {
+        const uint16_t  ADC_STEP    = Board::adcResolution / (NTC_LUT_SIZE - 1U);
+        uint8_t         index       = adcValue / ADC_STEP;
+        int32_t         fraction    = adcValue % ADC_STEP;
+        int32_t         delta       = m_ntcLut[index + 1U] - m_ntcLut[index];
+
+        /* Interpolate linear between the table entries. */
+        temperature = m_ntcLut[index] + (delta * fraction) / ADC_STEP;
+    }
+
+    return temperature;
+}
+
+uint8_t ThermalMonitor::calcCurrentLimitGoal() const
+{
+    uint8_t dieLimit = calcCurrentLimit(m_dieTemperature, DIE_THROTTLE_START, DIE_THROTTLE_FULL);
+    uint8_t ledLimit = calcCurrentLimit(m_ledTemperature, LED_THROTTLE_START, LED_THROTTLE_FULL);
+
+    return (dieLimit < ledLimit) ? dieLimit : ledLimit;
+}
+
+uint8_t ThermalMonitor::calcCurrentLimit(int16_t temperature, int16_t start, int16_t full)
+{
+    uint8_t         limit   = 100U;
+    const int32_t   START   = static_cast<int32_t>(start) << TEMP_FRAC_BITS;
+    const int32_t   FULL    = static_cast<int32_t>(full) << TEMP_FRAC_BITS;
+
+    if ((TEMPERATURE_INVALID == temperature) ||
+        (START >= temperature))
+    {
+        limit = 100U;
+    }
+    else if (FULL <= temperature)
+    {
+        limit = MIN_CURRENT_LIMIT;
+    }
+    else
+    {
+        limit = 100U - ((100U - MIN_CURRENT_LIMIT) * (temperature - START)) / (FULL - START);
+    }
+
+    return limit;
+}
+
+int16_t ThermalMonitor::filter(int16_t filtered, int16_t temperature)
+{
+    int16_t result = TEMPERATURE_INVALID;
+
+    /* A failed measurement stops the throttling by this sensor. */
+    if (TEMPERATURE_INVALID == temperature)
+    {
+        result = TEMPERATURE_INVALID;
+    }
+    else if (TEMPERATURE_INVALID == filtered)
+    {
+        result = temperature;
+    }
+    else
+    {
+        result = filtered + (temperature - filtered) / FILTER_DIV;
+    }
+
+    return result;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the ESP32 die temperature.
+ *
+ * @return Temperature in degree Celsius or 0 if not available
+ */
+static int32_t getDieTemperature()
+{
+    int32_t temperature = ThermalMonitor::getInstance().getDieTemperature();
+
+    if (ThermalMonitor::TEMPERATURE_INVALID == temperature)
+    {
+        temperature = 0;
+    }
+
+    return temperature;
+}
+
+/**
+ * Get the LED matrix temperature.
+ *
+ * @return Temperature in degree Celsius or 0 if not available
+ */
+static int32_t getLedTemperature()
+{
+    int32_t temperature = ThermalMonitor::getInstance().getLedTemperature();
+
+    if (ThermalMonitor::TEMPERATURE_INVALID == temperature)
+    {
+        temperature = 0;
+    }
+
+    return temperature;
+}
+
+/**
+ * Get the current limit of the thermal throttling.
+ *
+ * @return Current limit in percent
+ */
+static int32_t getCurrentLimit()
+{
+    return ThermalMonitor::getInstance().getCurrentLimit();
+}
@@ -0,0 +1,261 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Thermal monitor
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup hal
+ *
+ * @{
+ */
+
+#ifndef __THERMAL_MONITOR_H__
+#define __THERMAL_MONITOR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The thermal monitor measures the ESP32 die temperature and, if available,
+ * the LED matrix temperature with a NTC. If a temperature exceeds its
+ * threshold, the max. supply current of the LED matrix is reduced linearly,
+ * till it reaches the min. current limit at the full throttle temperature.
+ *
+ * The current limit is applied by the LED matrix current limiter, which
+ * scales down only frames with a high load. Dark content is not affected.
+ * To avoid visible steps, the current limit changes slowly.
+ */
+class ThermalMonitor
+{
+public:
+
+    /** Period in ms, after which the temperatures are measured. */
+    static const uint32_t   SAMPLE_PERIOD           = 1000U;
+
+    /** Die temperature in degree Celsius, where the throttling starts. */
+    static const int16_t    DIE_THROTTLE_START      = 70;
+
+    /** Die temperature in degree Celsius, where the min. current limit is reached. */
+    static const int16_t    DIE_THROTTLE_FULL       = 85;
+
+    /** LED temperature in degree Celsius, where the throttling starts. */
+    static const int16_t    LED_THROTTLE_START      = 50;
+
+    /** LED temperature in degree Celsius, where the min. current limit is reached. */
+    static const int16_t    LED_THROTTLE_FULL       = 65;
+
+    /** Min. current limit in percent of the max. supply current. */
+    static const uint8_t    MIN_CURRENT_LIMIT       = 25U;
+
+    /** Max. decrease of the current limit in percent per sample period. */
+    static const uint8_t    CURRENT_LIMIT_DEC_STEP  = 5U;
+
+    /** Max. increase of the current limit in percent per sample period. */
+    static const uint8_t    CURRENT_LIMIT_INC_STEP  = 1U;
+
+    /** Temperature, if it is not available. */
+    static const int16_t    TEMPERATURE_INVALID     = INT16_MIN;
+
+    /**
+     * Get the thermal monitor instance.
+     *
+     * @return Thermal monitor instance
+     */
+    static ThermalMonitor& getInstance()
+    {
+        static ThermalMonitor instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the thermal monitor and measure the first time.
+     */
+    void begin();
+
+    /**
+     * Measure the temperatures periodically and adapt the current limit
+     * of the LED matrix.
+     */
+    void process();
+
+    /**
+     * Get the ESP32 die temperature.
+     *
+     * @return Temperature in degree Celsius or TEMPERATURE_INVALID
+     */
+    int16_t getDieTemperature() const
+    {
+        return toCelsius(m_dieTemperature);
+    }
+
+    /**
+     * Get the LED matrix temperature, measured by the optional NTC.
+     *
+     * @return Temperature in degree Celsius or TEMPERATURE_INVALID
+     */
+    int16_t getLedTemperature() const
+    {
+        return toCelsius(m_ledTemperature);
+    }
+
+    /**
+     * Get the current limit, which is applied by the thermal throttling.
+     *
+     * @return Current limit in percent of the max. supply current [MIN_CURRENT_LIMIT; 100]
+     */
+    uint8_t getCurrentLimit() const
+    {
+        return m_currentLimit;
+    }
+
+private:
+
+    /** Number of fractional bits of the internal temperature values. */
+    static const uint8_t    TEMP_FRAC_BITS          = 4U;
+
+    /** Number of NTC lookup table entries, equally spaced over the ADC range. */
+    static const uint8_t    NTC_LUT_SIZE            = 33U;
+
+    SimpleTimer m_timer;                    /**< Timer for periodic measurement */
+    int16_t     m_dieTemperature;           /**< Filtered die temperature, fixed-point */
+    int16_t     m_ledTemperature;           /**< Filtered LED temperature, fixed-point */
+    uint8_t     m_currentLimit;             /**< Current limit in percent */
+    int16_t     m_ntcLut[NTC_LUT_SIZE];     /**< NTC temperature per ADC value, fixed-point */
+
+    /**
+     * Constructs the thermal monitor.
+     */
+    ThermalMonitor() :
+        m_timer(),
+        m_dieTemperature(TEMPERATURE_INVALID),
+        m_ledTemperature(TEMPERATURE_INVALID),
+        m_currentLimit(100U),
+        m_ntcLut()
+    {
+    }
+
+    /**
+     * Destroys the thermal monitor.
+     */
+    ~ThermalMonitor()
+    {
+    }
+
+    /* Prevent copying */
+    ThermalMonitor(const ThermalMonitor& monitor);
+    ThermalMonitor& operator=(const ThermalMonitor& monitor);
+
+    /**
+     * Measure all temperatures and filter them.
+     */
+    void measure();
+
+    /**
+     * Read the ESP32 die temperature.
+     *
+     * @return Temperature in degree Celsius, fixed-point or TEMPERATURE_INVALID
+     */
+    int16_t readDieTemperature() const;
+
+    /**
+     * Read the LED temperature by NTC.
+     *
+     * @return Temperature in degree Celsius, fixed-point or TEMPERATURE_INVALID
+     */
+    int16_t readLedTemperature() const;
+
+    /**
+     * Calculate the current limit, which shall be reached.
+     *
+     * @return Current limit in percent
+     */
+    uint8_t calcCurrentLimitGoal() const;
+
+    /**
+     * Calculate the current limit of a single temperature.
+     *
+     * @param[in] temperature   Temperature in degree Celsius, fixed-point or TEMPERATURE_INVALID
+     * @param[in] start         Temperature in degree Celsius, where the throttling starts
+     * @param[in] full          Temperature in degree Celsius, where the min. current limit is reached
+     *
+     * @return Current limit in percent
+     */
+    static uint8_t calcCurrentLimit(int16_t temperature, int16_t start, int16_t full);
+
+    /**
+     * Filter a temperature.
+     *
+     * @param[in] filtered      Last filtered temperature, fixed-point or TEMPERATURE_INVALID
+     * @param[in] temperature   New temperature, fixed-point or TEMPERATURE_INVALID
+     *
+     * @return Filtered temperature, fixed-point or TEMPERATURE_INVALID
+     */
+    static int16_t filter(int16_t filtered, int16_t temperature);
+
+    /**
+     * Convert a fixed-point temperature to degree Celsius.
+     *
+     * @param[in] temperature   Temperature, fixed-point or TEMPERATURE_INVALID
+     *
+     * @return Temperature in degree Celsius or TEMPERATURE_INVALID
+     */
+    static int16_t toCelsius(int16_t temperature)
+    {
+        int16_t celsius = TEMPERATURE_INVALID;
+
+        if (TEMPERATURE_INVALID != temperature)
+        {
+            celsius = (temperature + (1 << (TEMP_FRAC_BITS - 1U))) >> TEMP_FRAC_BITS;
+        }
+
+        return celsius;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __THERMAL_MONITOR_H__ */
+
+/** @} */
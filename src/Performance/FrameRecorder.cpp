@@ -0,0 +1,405 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display frame recorder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FrameRecorder.h"
+#include "LedMatrix.h"
+#include "FileSystem.h"
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize constants */
+const char* FrameRecorder::FILENAME = "/record.pxr";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool FrameRecorder::start(Sink sink, uint32_t clientId, uint32_t seed)
+{
+    bool status = false;
+
+    if ((nullptr == m_xMutex) ||
+        (false == m_encoder.isReady()))
+    {
+        return false;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if (STATE_IDLE == m_state)
+    {
+        m_sink      = sink;
+        m_clientId  = clientId;
+        m_seed      = seed;
+
+        /* The sink is prepared in the loop context. */
+        m_state     = STATE_STARTING;
+
+        status = true;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return status;
+}
+
+void FrameRecorder::stop()
+{
+    if (nullptr == m_xMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if (STATE_STARTING == m_state)
+    {
+        m_state = STATE_IDLE;
+    }
+    else if (STATE_RECORDING == m_state)
+    {
+        m_state = STATE_STOPPING;
+    }
+    else
+    {
+        ;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+void FrameRecorder::getStatus(Status& status) const
+{
+    status.isRecording      = (STATE_IDLE != m_state);
+    status.frames           = m_frames;
+    status.droppedFrames    = m_droppedFrames;
+    status.bytes            = m_bytes;
+
+    return;
+}
+
+void FrameRecorder::record()
+{
+    size_t recordSize = 0U;
+
+    if (STATE_RECORDING != m_state)
+    {
+        return;
+    }
+
+    LedMatrix::getInstance().getFrame(m_frame, DisplayMgr::FRAME_PIXEL_COUNT);
+    recordSize = m_encoder.encode(m_frame, millis() - m_startTimestamp, m_record);
+
+    if (0U < recordSize)
+    {
+        /* Only complete records are queued. */
+        if ((QUEUE_SIZE - m_queue.getCount()) < recordSize)
+        {
+            /* The next record must not depend on the dropped one. */
+            m_encoder.requestKeyFrame();
+            ++m_droppedFrames;
+        }
+        else
+        {
+            size_t index = 0U;
+
+            for(index = 0U; index < recordSize; ++index)
+            {
+                (void)m_queue.push(m_record[index]);
+            }
+
+            ++m_frames;
+        }
+    }
+
+    return;
+}
+
+void FrameRecorder::process(AsyncWebSocket& server)
+{
+    if (nullptr == m_xMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if (STATE_STARTING == m_state)
+    {
+        /* Records of a previous recording are discarded. */
+        m_queue.clear();
+
+        m_frames        = 0U;
+        m_droppedFrames = 0U;
+        m_bytes         = 0U;
+
+        if (false == beginSink(server))
+        {
+            m_state = STATE_IDLE;
+        }
+        else
+        {
+            if (0U != m_seed)
+            {
+                randomSeed(m_seed);
+            }
+
+            m_startTimestamp = millis();
+            m_encoder.requestKeyFrame();
+
+            LOG_INFO("Frame recording started.");
+            m_state = STATE_RECORDING;
+        }
+    }
+
+    if ((STATE_RECORDING == m_state) ||
+        (STATE_STOPPING == m_state))
+    {
+        bool isError = false;
+
+        while((false == isError) &&
+              (false == m_queue.isEmpty()) &&
+              (false == isSinkBusy(server)))
+        {
+            size_t size = 0U;
+
+            while((CHUNK_SIZE > size) &&
+                  (true == m_queue.pop(m_chunk[size])))
+            {
+                ++size;
+            }
+
+            isError = !writeSink(server, m_chunk, size);
+        }
+
+        if (true == isError)
+        {
+            LOG_WARNING("Frame recording aborted.");
+            endSink();
+            m_state = STATE_IDLE;
+        }
+        else if ((STATE_RECORDING == m_state) &&
+                 (SINK_FILE == m_sink) &&
+                 (MAX_FILE_SIZE <= m_bytes))
+        {
+            LOG_WARNING("Max. frame recording size reached.");
+            m_state = STATE_STOPPING;
+        }
+        else if ((STATE_STOPPING == m_state) &&
+                 (true == m_queue.isEmpty()))
+        {
+            LOG_INFO("Frame recording stopped: %u frames, %u dropped.", m_frames, m_droppedFrames);
+            endSink();
+            m_state = STATE_IDLE;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+FrameRecorder::FrameRecorder() :
+    m_xMutex(xSemaphoreCreateMutex()),
+    m_state(STATE_IDLE),
+    m_sink(SINK_FILE),
+    m_clientId(0U),
+    m_seed(0U),
+    m_fd(),
+    m_startTimestamp(0U),
+    m_frames(0U),
+    m_droppedFrames(0U),
+    m_bytes(0U),
+    m_encoder(DisplayMgr::FRAME_PIXEL_COUNT),
+    m_queue(),
+    m_frame(),
+    m_record(),
+    m_chunk()
+{
+    if (nullptr == m_xMutex)
+    {
+        LOG_ERROR("Couldn't create frame recorder mutex.");
+    }
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    endSink();
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+bool FrameRecorder::beginSink(AsyncWebSocket& server)
+{
+    bool                    status  = false;
+    uint8_t                 header[FrameCodec::FILE_HEADER_SIZE];
+    FrameCodec::FileHeader  fileHeader;
+
+    fileHeader.width    = Board::LedMatrix::width;
+    fileHeader.height   = Board::LedMatrix::height;
+    fileHeader.seed     = m_seed;
+
+    (void)FrameCodec::writeFileHeader(header, fileHeader);
+
+    if (SINK_FILE == m_sink)
+    {
+        m_fd = FILESYSTEM.open(FILENAME, "w");
+
+        if (false == m_fd)
+        {
+            LOG_ERROR("Couldn't create %s.", FILENAME);
+        }
+        else
+        {
+            status = writeSink(server, header, sizeof(header));
+        }
+    }
+    else if (nullptr == server.client(m_clientId))
+    {
+        LOG_WARNING("Websocket client %u is gone.", m_clientId);
+    }
+    else
+    {
+        status = writeSink(server, header, sizeof(header));
+    }
+
+    return status;
+}
+
+void FrameRecorder::endSink()
+{
+    if (true == m_fd)
+    {
+        m_fd.close();
+    }
+
+    return;
+}
+
+bool FrameRecorder::isSinkBusy(AsyncWebSocket& server)
+{
+    bool isBusy = false;
+
+    if (SINK_WEBSOCKET == m_sink)
+    {
+        AsyncWebSocketClient* client = server.client(m_clientId);
+
+        /* A gone client is detected by the next write. */
+        if ((nullptr != client) &&
+            (true == client->queueIsFull()))
+        {
+            isBusy = true;
+        }
+    }
+
+    return isBusy;
+}
+
+bool FrameRecorder::writeSink(AsyncWebSocket& server, const uint8_t* data, size_t size)
+{
+    bool status = false;
+
+    if (SINK_FILE == m_sink)
+    {
+        if (size == m_fd.write(data, size))
+        {
+            status = true;
+        }
+    }
+    else
+    {
+        AsyncWebSocketClient* client = server.client(m_clientId);
+
+        if (nullptr != client)
+        {
+            client->binary(data, size);
+            status = true;
+        }
+    }
+
+    if (true == status)
+    {
+        m_bytes += size;
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,256 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display frame recorder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __FRAME_RECORDER_H__
+#define __FRAME_RECORDER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <FS.h>
+#include <FrameCodec.h>
+#include <SpscQueue.hpp>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include "DisplayMgr.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+class AsyncWebSocket;
+
+/**
+ * The frame recorder records every changed display frame plus timing, either
+ * to a file or as binary websocket stream. See FrameCodec for the layout.
+ *
+ * The display task encodes the frames and puts them into a lock-free queue,
+ * which is written to the sink in the loop context. If the sink can't keep
+ * up, frames are dropped and the next frame is recorded as key frame.
+ *
+ * A recording can be replayed and compared with the native benchmark, see
+ * the software build documentation.
+ */
+class FrameRecorder
+{
+public:
+
+    /** Recording sink */
+    enum Sink
+    {
+        SINK_FILE = 0,  /**< Record to file */
+        SINK_WEBSOCKET  /**< Stream over websocket */
+    };
+
+    /** Recording status */
+    struct Status
+    {
+        bool        isRecording;    /**< Is recording in progress? */
+        uint32_t    frames;         /**< Number of recorded frames */
+        uint32_t    droppedFrames;  /**< Number of dropped frames */
+        uint32_t    bytes;          /**< Number of written bytes */
+    };
+
+    /** Name of the recording file. */
+    static const char*      FILENAME;
+
+    /** Max. size of the recording file in bytes. If reached, the recording stops. */
+    static const uint32_t   MAX_FILE_SIZE   = 256U * 1024U;
+
+    /**
+     * Get frame recorder instance.
+     *
+     * @return Frame recorder instance
+     */
+    static FrameRecorder& getInstance()
+    {
+        static FrameRecorder instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start recording. If a seed other than 0 is given, the Arduino random
+     * number generator is seeded with it. Plugins, which seed their own
+     * generator by random() during activation, render the same frames again
+     * after activating the slot.
+     *
+     * @param[in] sink      Recording sink
+     * @param[in] clientId  Websocket client id, only used for the websocket sink.
+     * @param[in] seed      Random seed
+     *
+     * @return If started, it will return true otherwise false.
+     */
+    bool start(Sink sink, uint32_t clientId, uint32_t seed);
+
+    /**
+     * Stop recording. The already recorded frames are still written to the sink.
+     */
+    void stop();
+
+    /**
+     * Is recording in progress?
+     *
+     * @return If recording, it will return true otherwise false.
+     */
+    bool isRecording() const
+    {
+        return (STATE_RECORDING == m_state);
+    }
+
+    /**
+     * Get the recording status.
+     *
+     * @param[out] status   Recording status
+     */
+    void getStatus(Status& status) const;
+
+    /**
+     * Record the current LED matrix frame.
+     * Call this only in the display task, after a changed frame is rendered.
+     */
+    void record();
+
+    /**
+     * Write the recorded frames to the sink. Call this periodically in the
+     * loop context.
+     *
+     * @param[in] server    Websocket server
+     */
+    void process(AsyncWebSocket& server);
+
+private:
+
+    /** Recorder states */
+    enum State
+    {
+        STATE_IDLE = 0,     /**< No recording */
+        STATE_STARTING,     /**< Recording requested, sink is prepared in the loop context. */
+        STATE_RECORDING,    /**< Recording in progress */
+        STATE_STOPPING      /**< Recording stopped, the remaining frames are written. */
+    };
+
+    /** Size of the record queue in bytes, which must be a power of 2. */
+    static const uint32_t   QUEUE_SIZE      = 8192U;
+
+    /** Max. size of a single record in bytes. */
+    static const size_t     MAX_RECORD_SIZE = FrameCodec::RECORD_HEADER_SIZE + FrameCodec::RUN_HEADER_SIZE + (FrameCodec::BYTES_PER_PIXEL * DisplayMgr::FRAME_PIXEL_COUNT);
+
+    /** Max. size of a chunk in bytes, which is written to the sink at once. */
+    static const size_t     CHUNK_SIZE      = 1024U;
+
+    SemaphoreHandle_t               m_xMutex;                       /**< Mutex to protect the state transitions. */
+    volatile State                  m_state;                        /**< Recorder state */
+    Sink                            m_sink;                         /**< Recording sink */
+    uint32_t                        m_clientId;                     /**< Websocket client id */
+    uint32_t                        m_seed;                         /**< Random seed */
+    File                            m_fd;                           /**< Recording file */
+    uint32_t                        m_startTimestamp;               /**< Timestamp in ms of the recording begin */
+    uint32_t                        m_frames;                       /**< Number of recorded frames */
+    uint32_t                        m_droppedFrames;                /**< Number of dropped frames */
+    uint32_t                        m_bytes;                        /**< Number of written bytes */
+    FrameEncoder                    m_encoder;                      /**< Frame encoder */
+    SpscQueue<uint8_t, QUEUE_SIZE>  m_queue;                        /**< Encoded records, from display task to loop context */
+    uint32_t                        m_frame[DisplayMgr::FRAME_PIXEL_COUNT]; /**< Current frame */
+    uint8_t                         m_record[MAX_RECORD_SIZE];      /**< Record buffer, used by the display task. */
+    uint8_t                         m_chunk[CHUNK_SIZE];            /**< Chunk buffer, used in the loop context. */
+
+    /**
+     * Constructs the frame recorder.
+     */
+    FrameRecorder();
+
+    /**
+     * Destroys the frame recorder.
+     */
+    ~FrameRecorder();
+
+    /* Prevent copying */
+    FrameRecorder(const FrameRecorder& recorder);
+    FrameRecorder& operator=(const FrameRecorder& recorder);
+
+    /**
+     * Prepare the sink and write the file header.
+     *
+     * @param[in] server    Websocket server
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool beginSink(AsyncWebSocket& server);
+
+    /**
+     * Close the sink.
+     */
+    void endSink();
+
+    /**
+     * Is the sink busy, e.g. because the websocket client can't keep up?
+     *
+     * @param[in] server    Websocket server
+     *
+     * @return If busy, it will return true otherwise false.
+     */
+    bool isSinkBusy(AsyncWebSocket& server);
+
+    /**
+     * Write data to the sink.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] data      Data
+     * @param[in] size      Data size in bytes
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool writeSink(AsyncWebSocket& server, const uint8_t* data, size_t size);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FRAME_RECORDER_H__ */
+
+/** @} */
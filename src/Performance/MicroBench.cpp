@@ -0,0 +1,368 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  On-device micro benchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MicroBench.h"
+#include "Board.h"
+#include "Settings.h"
+#include "Version.h"
+#include "AsyncHttpClient.h"
+
+#include <Logging.h>
+#include <Canvas.h>
+#include <TextWidget.h>
+#include <FadeKernel.h>
+#include <PixelKernel.h>
+#include <EffectRunner.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Rainbow kernel, which is used with the effect runner, like the rainbow
+ * plugin does.
+ */
+struct RainbowKernel
+{
+    /**
+     * Calculate the color of a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] time  Start angle of the color wheel
+     *
+     * @return Pixel color
+     */
+    inline Color operator()(int16_t x, int16_t y, uint32_t time) const
+    {
+        Color color;
+
+        color.turnColorWheel(time + (x + y) * 8U);
+
+        return color;
+    }
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of warm iterations of the rendering benchmarks. */
+static const uint32_t   GFX_ITERATIONS          = 200U;
+
+/** Number of warm iterations of the JSON benchmarks. */
+static const uint32_t   JSON_ITERATIONS         = 100U;
+
+/** Number of warm iterations of the HTTP parser benchmarks. */
+static const uint32_t   HTTP_ITERATIONS         = 100U;
+
+/** Number of warm iterations of the settings read benchmark. */
+static const uint32_t   SETTINGS_READ_ITERATIONS    = 50U;
+
+/**
+ * Number of warm iterations of the settings write benchmark.
+ * Keep it small, because every iteration writes to the flash.
+ */
+static const uint32_t   SETTINGS_WRITE_ITERATIONS   = 4U;
+
+/** Canned HTTP response with identity transfer coding. */
+static const char       HTTP_RSP_IDENTITY[]     =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/json; charset=utf-8\r\n"
+    "Content-Length: 86\r\n"
+    "Connection: keep-alive\r\n"
+    "Cache-Control: no-cache\r\n"
+    "\r\n"
+    "{\"coord\":{\"lon\":11.58,\"lat\":48.14},\"main\":{\"temp\":21.5,\"humidity\":48},\"name\":\"City\"}";
+
+/** Canned HTTP response with chunked transfer coding. */
+static const char       HTTP_RSP_CHUNKED[]      =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/json; charset=utf-8\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n"
+    "2a\r\n"
+    "{\"coord\":{\"lon\":11.58,\"lat\":48.14},\"main\":\r\n"
+    "2c\r\n"
+    "{\"temp\":21.5,\"humidity\":48},\"name\":\"City\"}\r\n"
+    "0\r\n"
+    "\r\n";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void MicroBench::run()
+{
+    const Logging::LogLevel LOG_LEVEL   = Logging::getInstance().getLogLevel();
+    DynamicJsonDocument     jsonDoc(REPORT_DOC_SIZE);
+    JsonObject              reportObj   = jsonDoc.to<JsonObject>();
+
+    /* The logging output would dominate the measured routines. */
+    Logging::getInstance().setLogLevel(Logging::LOGLEVEL_ERROR);
+
+    m_count     = 0U;
+    m_cpuFreq   = ESP.getCpuFreqMHz();
+
+    runGfx();
+    runJson();
+    runHttpParser();
+    runSettings();
+
+    Logging::getInstance().setLogLevel(LOG_LEVEL);
+
+    getReport(reportObj);
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+
+    /* One line, which starts with a unique tag, to be easily filtered out of the serial log. */
+    Serial.print("MICROBENCH:");
+    (void)serializeJson(jsonDoc, Serial);
+    Serial.println();
+
+    return;
+}
+
+void MicroBench::getReport(JsonObject& report) const
+{
+    JsonArray   resultArray = report.createNestedArray("results");
+    uint8_t     index       = 0U;
+
+    report["version"]       = Version::SOFTWARE_VER;
+    report["chipRev"]       = ESP.getChipRevision();
+    report["cpuFreqMhz"]    = m_cpuFreq;
+    report["flashFreqHz"]   = ESP.getFlashChipSpeed();
+
+    for(index = 0U; index < m_count; ++index)
+    {
+        JsonObject      resultObj   = resultArray.createNestedObject();
+        const Result&   result      = m_results[index];
+
+        resultObj["name"]       = result.name;
+        resultObj["iterations"] = result.iterations;
+        resultObj["cold"]       = result.cold;  // cycles
+        resultObj["min"]        = result.min;   // cycles
+        resultObj["avg"]        = result.avg;   // cycles
+        resultObj["max"]        = result.max;   // cycles
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void MicroBench::runGfx()
+{
+    const uint16_t  LENGTH          = Board::LedMatrix::width * Board::LedMatrix::height;
+    Canvas          display(Board::LedMatrix::width, Board::LedMatrix::height, 0, 0, true);
+    Canvas          prev(Board::LedMatrix::width, Board::LedMatrix::height, 0, 0, true);
+    Canvas          next(Board::LedMatrix::width, Board::LedMatrix::height, 0, 0, true);
+    Canvas          canvas(Board::LedMatrix::width, Board::LedMatrix::height, 0, 0, true);
+    TextWidget      textWidget("12:34");
+    RainbowKernel   kernel;
+    uint32_t        frame           = 0U;
+    uint32_t*       dst             = new uint32_t[LENGTH];
+    uint32_t*       src1            = new uint32_t[LENGTH];
+    uint32_t*       src2            = new uint32_t[LENGTH];
+
+    prev.fillScreen(ColorDef::RED);
+    next.fillScreen(ColorDef::BLUE);
+    (void)canvas.addWidget(textWidget);
+
+    measure("Gfx::fillScreen", GFX_ITERATIONS, [&]() {
+        display.fillScreen(ColorDef::GREEN);
+    });
+
+    measure("FadeKernel::dim", GFX_ITERATIONS, [&]() {
+        FadeKernel::dim(display, prev, static_cast<uint8_t>(frame++));
+    });
+
+    measure("FadeKernel::blend", GFX_ITERATIONS, [&]() {
+        FadeKernel::blend(display, prev, next, static_cast<uint8_t>(frame++));
+    });
+
+    measure("EffectRunner::forEachPixel", GFX_ITERATIONS, [&]() {
+        EffectRunner::forEachPixel(display, kernel, frame++);
+    });
+
+    measure("Canvas::update", GFX_ITERATIONS, [&]() {
+        textWidget.setFormatStr((0U == (frame++ & 1U)) ? "12:34" : "12:35");
+        canvas.update(display);
+    });
+
+    if ((nullptr != dst) &&
+        (nullptr != src1) &&
+        (nullptr != src2))
+    {
+        PixelKernel::fill(src1, LENGTH, 0x00c86400U);
+        PixelKernel::fill(src2, LENGTH, 0x000064c8U);
+
+        measure("PixelKernel::blend", GFX_ITERATIONS, [&]() {
+            PixelKernel::blend(dst, src1, src2, LENGTH, static_cast<uint8_t>(frame++));
+        });
+    }
+
+    delete[] dst;
+    delete[] src1;
+    delete[] src2;
+
+    return;
+}
+
+void MicroBench::runJson()
+{
+    const size_t    JSON_DOC_SIZE   = 768U;
+    String          serialized;
+
+    /* Like the status response of the REST API. */
+    measure("Json::serialize", JSON_ITERATIONS, [&]() {
+        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+        JsonObject          dataObj         = jsonDoc.createNestedObject("data");
+        JsonObject          hwObj           = dataObj.createNestedObject("hardware");
+        JsonObject          swObj           = dataObj.createNestedObject("software");
+        JsonObject          internalRamObj  = swObj.createNestedObject("internalRam");
+        JsonObject          wifiObj         = dataObj.createNestedObject("wifi");
+
+        jsonDoc["status"]               = 0U;
+        hwObj["chipRev"]                = 1U;
+        hwObj["cpuFreqMhz"]             = 240U;
+        swObj["version"]                = Version::SOFTWARE_VER;
+        swObj["revision"]               = Version::SOFTWARE_REV;
+        internalRamObj["heapSize"]      = 327680U;
+        internalRamObj["availableHeap"] = 123456U;
+        wifiObj["ssid"]                 = "MySSID";
+        wifiObj["rssi"]                 = -67;
+        wifiObj["quality"]              = 66U;
+
+        serialized.clear();
+        (void)serializeJson(jsonDoc, serialized);
+    });
+
+    measure("Json::deserialize", JSON_ITERATIONS, [&]() {
+        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+        (void)deserializeJson(jsonDoc, serialized);
+    });
+
+    return;
+}
+
+void MicroBench::runHttpParser()
+{
+    AsyncHttpClient client;
+
+    measure("AsyncHttpClient::onData (identity)", HTTP_ITERATIONS, [&]() {
+        client.onData(&client.m_tcpClient, reinterpret_cast<const uint8_t*>(HTTP_RSP_IDENTITY), sizeof(HTTP_RSP_IDENTITY) - 1U);
+    });
+
+    measure("AsyncHttpClient::onData (chunked)", HTTP_ITERATIONS, [&]() {
+        client.onData(&client.m_tcpClient, reinterpret_cast<const uint8_t*>(HTTP_RSP_CHUNKED), sizeof(HTTP_RSP_CHUNKED) - 1U);
+    });
+
+    return;
+}
+
+void MicroBench::runSettings()
+{
+    Settings&   settings    = Settings::getInstance();
+    uint32_t    scrollPause = 0U;
+    uint32_t    toggle      = 0U;
+
+    if (false == settings.open(true))
+    {
+        LOG_ERROR("Couldn't open settings.");
+        return;
+    }
+
+    scrollPause = settings.getScrollPause().getValue();
+    settings.close();
+
+    measure("Settings::read", SETTINGS_READ_ITERATIONS, [&]() {
+        if (true == settings.open(true))
+        {
+            (void)settings.getScrollPause().getValue();
+            settings.close();
+        }
+    });
+
+    /* The value is changed every time, otherwise nothing is written. */
+    measure("Settings::write", SETTINGS_WRITE_ITERATIONS, [&]() {
+        if (true == settings.open(false))
+        {
+            settings.getScrollPause().setValue(scrollPause + 1U + (toggle++ & 1U));
+            settings.close();
+            settings.flush();
+        }
+    });
+
+    /* Restore the original value. */
+    if (true == settings.open(false))
+    {
+        settings.getScrollPause().setValue(scrollPause);
+        settings.close();
+        settings.flush();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
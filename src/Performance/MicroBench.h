@@ -0,0 +1,232 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  On-device micro benchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __MICRO_BENCH_H__
+#define __MICRO_BENCH_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Micro benchmark mode (1) or not (0).
+ * If enabled, the micro benchmark runs once at startup, before the system
+ * state machine starts. See the esp32doit-devkit-v1-bench environment.
+ */
+#ifndef MICRO_BENCH
+#define MICRO_BENCH (0)
+#endif  /* MICRO_BENCH */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The micro benchmark measures the runtime of performance relevant routines
+ * on the target, because the native system doesn't reflect the flash cache
+ * and the Xtensa core. The runtime is measured with the CPU cycle counter
+ * (CCOUNT).
+ *
+ * Every routine is called once cold, which includes the flash cache misses,
+ * and afterwards a number of iterations warm. The report is printed as JSON
+ * over the serial interface and provided via REST API.
+ */
+class MicroBench
+{
+public:
+
+    /** Result of a single benchmark. */
+    struct Result
+    {
+        const char* name;       /**< Benchmark name */
+        uint32_t    iterations; /**< Number of warm iterations */
+        uint32_t    cold;       /**< CPU cycles of the cold call */
+        uint32_t    min;        /**< Min. CPU cycles of a warm iteration */
+        uint32_t    avg;        /**< Average CPU cycles of a warm iteration */
+        uint32_t    max;        /**< Max. CPU cycles of a warm iteration */
+    };
+
+    /** Max. number of results. */
+    static const uint8_t    MAX_RESULTS     = 24U;
+
+    /** Size in byte of the JSON document, which contains the report. */
+    static const size_t     REPORT_DOC_SIZE = 3072U;
+
+    /**
+     * Get the micro benchmark instance.
+     *
+     * @return Micro benchmark
+     */
+    static MicroBench& getInstance()
+    {
+        static MicroBench instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Run all benchmarks and print the report over the serial interface.
+     * The settings must be available.
+     */
+    void run();
+
+    /**
+     * Get the report of the last run.
+     *
+     * @param[out] report   JSON object, which will contain the report.
+     */
+    void getReport(JsonObject& report) const;
+
+private:
+
+    Result      m_results[MAX_RESULTS]; /**< Results */
+    uint8_t     m_count;                /**< Number of results */
+    uint32_t    m_cpuFreq;              /**< CPU frequency in MHz during the run */
+
+    /**
+     * Constructs the micro benchmark.
+     */
+    MicroBench() :
+        m_results(),
+        m_count(0U),
+        m_cpuFreq(0U)
+    {
+    }
+
+    /**
+     * Destroys the micro benchmark.
+     */
+    ~MicroBench()
+    {
+    }
+
+    MicroBench(const MicroBench& bench);
+    MicroBench& operator=(const MicroBench& bench);
+
+    /**
+     * Measure a routine and store the result.
+     *
+     * @tparam TFunc    Routine type, which is called without parameters.
+     *
+     * @param[in] name          Benchmark name
+     * @param[in] iterations    Number of warm iterations, must not be 0.
+     * @param[in] func          Routine
+     */
+    template < typename TFunc >
+    void measure(const char* name, uint32_t iterations, TFunc func)
+    {
+        if (MAX_RESULTS > m_count)
+        {
+            Result&     result  = m_results[m_count];
+            uint64_t    sum     = 0U;
+            uint32_t    index   = 0U;
+            uint32_t    begin   = ESP.getCycleCount();
+
+            func();
+
+            result.name         = name;
+            result.iterations   = iterations;
+            result.cold         = ESP.getCycleCount() - begin;
+            result.min          = UINT32_MAX;
+            result.max          = 0U;
+
+            for(index = 0U; index < iterations; ++index)
+            {
+                uint32_t cycles = 0U;
+
+                begin   = ESP.getCycleCount();
+                func();
+                cycles  = ESP.getCycleCount() - begin;
+
+                if (result.min > cycles)
+                {
+                    result.min = cycles;
+                }
+
+                if (result.max < cycles)
+                {
+                    result.max = cycles;
+                }
+
+                sum += cycles;
+            }
+
+            result.avg = static_cast<uint32_t>(sum / iterations);
+
+            ++m_count;
+        }
+
+        return;
+    }
+
+    /**
+     * Benchmark the rendering kernels.
+     */
+    void runGfx();
+
+    /**
+     * Benchmark the JSON serialization and deserialization, like the REST API.
+     */
+    void runJson();
+
+    /**
+     * Benchmark the HTTP response parser with canned responses.
+     */
+    void runHttpParser();
+
+    /**
+     * Benchmark the settings access in the NVS.
+     */
+    void runSettings();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __MICRO_BENCH_H__ */
+
+/** @} */
@@ -0,0 +1,896 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Network benchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "NetBenchmark.h"
+#include "FileSystem.h"
+#include "JsonFile.h"
+#include "Version.h"
+#include "WebConfig.h"
+
+#include <Logging.h>
+#include <WiFi.h>
+#include <time.h>
+#include <lwip/sockets.h>
+#include <lwip/netdb.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize constants */
+const char* NetBenchmark::DEFAULT_HTTP_PATH = "/favicon.png";
+const char* NetBenchmark::RESULTS_FILENAME  = "/benchmark.json";
+
+/** Websocket opcode of a text frame. */
+static const uint8_t    WS_OPCODE_TEXT      = 0x01U;
+
+/** Websocket opcode of a close frame. */
+static const uint8_t    WS_OPCODE_CLOSE     = 0x08U;
+
+/** Websocket FIN flag in the first frame header byte. */
+static const uint8_t    WS_FLAG_FIN         = 0x80U;
+
+/** Websocket MASK flag in the second frame header byte. */
+static const uint8_t    WS_FLAG_MASK        = 0x80U;
+
+/** Max. websocket payload size, which is handled by the benchmark. */
+static const size_t     WS_MAX_PAYLOAD      = 125U;
+
+/** Max. size of the websocket opening handshake response in byte. */
+static const size_t     WS_MAX_HANDSHAKE    = 512U;
+
+/**
+ * Fixed websocket key. The server just hashes it for the handshake response,
+ * therefore it doesn't need to be random for the benchmark.
+ */
+static const char       WS_KEY[]            = "dGhlIHNhbXBsZSBub25jZQ==";
+
+/** Fixed mask key of the client frames. */
+static const uint8_t    WS_MASK_KEY[4U]     = { 0x12U, 0x34U, 0x56U, 0x78U };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void NetBenchmark::begin()
+{
+    if (false == m_isLoaded)
+    {
+        JsonFile jsonFile(FILESYSTEM);
+
+        /* No results stored yet is not an error. */
+        if ((false == jsonFile.load(RESULTS_FILENAME, m_results)) ||
+            (false == m_results.is<JsonArray>()))
+        {
+            m_results.clear();
+            (void)m_results.to<JsonArray>();
+        }
+
+        m_isLoaded = true;
+    }
+
+    return;
+}
+
+void NetBenchmark::end()
+{
+    if (nullptr != m_taskHandle)
+    {
+        m_isExitReq = true;
+
+        /* Join */
+        (void)xSemaphoreTake(m_xExitSemaphore, portMAX_DELAY);
+        m_taskHandle = nullptr;
+
+        storeResult();
+    }
+
+    m_isStartReq = false;
+
+    saveResults();
+
+    return;
+}
+
+void NetBenchmark::process()
+{
+    /* Benchmark finished? */
+    if ((nullptr != m_taskHandle) &&
+        (pdTRUE == xSemaphoreTake(m_xExitSemaphore, 0U)))
+    {
+        m_taskHandle = nullptr;
+        storeResult();
+    }
+
+    if ((nullptr == m_taskHandle) &&
+        (true == m_isStartReq))
+    {
+        BaseType_t osRet = pdFAIL;
+
+        m_isExitReq = false;
+
+        osRet = xTaskCreateUniversal(   benchmarkTask,
+                                        "benchTask",
+                                        TASK_STACK_SIZE,
+                                        this,
+                                        TASK_PRIORITY,
+                                        &m_taskHandle,
+                                        TASK_RUN_CORE);
+
+        if (pdPASS != osRet)
+        {
+            LOG_ERROR("Couldn't create benchmark task.");
+            m_taskHandle = nullptr;
+        }
+
+        m_isStartReq = false;
+    }
+
+    saveResults();
+
+    return;
+}
+
+bool NetBenchmark::start(const Config& cfg)
+{
+    bool isAccepted = false;
+
+    if ((0U == cfg.requests) ||
+        (MAX_REQUESTS < cfg.requests) ||
+        (0U == cfg.clients) ||
+        (MAX_CLIENTS < cfg.clients) ||
+        (0U == cfg.port) ||
+        (false == cfg.path.startsWith("/")))
+    {
+        LOG_WARNING("Benchmark configuration invalid.");
+    }
+    else if (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY))
+    {
+        if ((false == m_isStartReq) &&
+            (nullptr == m_taskHandle))
+        {
+            m_cfg           = cfg;
+            m_isStartReq    = true;
+            isAccepted      = true;
+        }
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+    else
+    {
+        ;
+    }
+
+    return isAccepted;
+}
+
+void NetBenchmark::stop()
+{
+    m_isStartReq    = false;
+    m_isExitReq     = true;
+
+    return;
+}
+
+bool NetBenchmark::isRunning() const
+{
+    return (true == m_isStartReq) || (nullptr != m_taskHandle);
+}
+
+void NetBenchmark::getResults(JsonArray& results) const
+{
+    if (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY))
+    {
+        (void)results.set(m_results.as<JsonArrayConst>());
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+void NetBenchmark::clearResults()
+{
+    if (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY))
+    {
+        m_results.clear();
+        (void)m_results.to<JsonArray>();
+        m_isSaveReq = true;
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+NetBenchmark::NetBenchmark() :
+    m_xMutex(xSemaphoreCreateMutex()),
+    m_xExitSemaphore(xSemaphoreCreateBinary()),
+    m_xClientSemaphore(xSemaphoreCreateCounting(MAX_CLIENTS, 0U)),
+    m_taskHandle(nullptr),
+    m_isStartReq(false),
+    m_isExitReq(false),
+    m_cfg(),
+    m_addr(0U),
+    m_issued(0U),
+    m_errors(0U),
+    m_bytes(0U),
+    m_duration(0U),
+    m_latency(),
+    m_results(RESULTS_DOC_SIZE),
+    m_isLoaded(false),
+    m_isSaveReq(false)
+{
+    (void)m_results.to<JsonArray>();
+}
+
+NetBenchmark::~NetBenchmark()
+{
+    end();
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+
+    if (nullptr != m_xExitSemaphore)
+    {
+        vSemaphoreDelete(m_xExitSemaphore);
+        m_xExitSemaphore = nullptr;
+    }
+
+    if (nullptr != m_xClientSemaphore)
+    {
+        vSemaphoreDelete(m_xClientSemaphore);
+        m_xClientSemaphore = nullptr;
+    }
+}
+
+bool NetBenchmark::takeRequest(uint16_t& seq)
+{
+    bool isAvailable = false;
+
+    if ((false == m_isExitReq) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        if (m_cfg.requests > m_issued)
+        {
+            seq = m_issued;
+            ++m_issued;
+            isAvailable = true;
+        }
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return isAvailable;
+}
+
+void NetBenchmark::record(bool isSuccessful, uint32_t latency, size_t bytes)
+{
+    if (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY))
+    {
+        if (false == isSuccessful)
+        {
+            ++m_errors;
+        }
+        else
+        {
+            m_latency.addSample(latency);
+        }
+
+        m_bytes += bytes;
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+int NetBenchmark::connectToTarget() const
+{
+    int fd = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (0 <= fd)
+    {
+        struct sockaddr_in  addr;
+        struct timeval      timeout;
+        int                 noDelay = 1;
+
+        timeout.tv_sec  = RESPONSE_TIMEOUT / 1000U;
+        timeout.tv_usec = (RESPONSE_TIMEOUT % 1000U) * 1000U;
+
+        (void)lwip_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        (void)lwip_setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        /* The requests are small and shall be sent immediately. */
+        (void)lwip_setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family         = AF_INET;
+        addr.sin_port           = htons(m_cfg.port);
+        addr.sin_addr.s_addr    = m_addr;
+
+        if (0 != lwip_connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)))
+        {
+            (void)lwip_close(fd);
+            fd = -1;
+        }
+    }
+
+    return fd;
+}
+
+bool NetBenchmark::requestHttp(size_t& bytes) const
+{
+    bool    isSuccessful    = false;
+    int     fd              = connectToTarget();
+
+    bytes = 0U;
+
+    if (0 <= fd)
+    {
+        String request;
+
+        request  = "GET ";
+        request += m_cfg.path;
+        request += " HTTP/1.1\r\nHost: ";
+        request += m_cfg.host;
+        request += "\r\nConnection: close\r\n\r\n";
+
+        if (true == sendAll(fd, request.c_str(), request.length()))
+        {
+            const size_t    STATUS_LINE_START   = 9U; /* "HTTP/1.1 " */
+            char            buffer[256U];
+            char            statusClass         = '\0';
+            int             ret                 = 0;
+
+            /* Receive until the server closes the connection. */
+            do
+            {
+                ret = lwip_recv(fd, buffer, sizeof(buffer), 0);
+
+                if (0 < ret)
+                {
+                    /* The 1st digit of the status code is in the first segment. */
+                    if ((0U == bytes) &&
+                        (STATUS_LINE_START < static_cast<size_t>(ret)))
+                    {
+                        statusClass = buffer[STATUS_LINE_START];
+                    }
+
+                    bytes += ret;
+                }
+            }
+            while(0 < ret);
+
+            /* Connection closed by the server and status code 2xx? */
+            if ((0 == ret) &&
+                ('2' == statusClass))
+            {
+                isSuccessful = true;
+            }
+        }
+
+        (void)lwip_close(fd);
+    }
+
+    return isSuccessful;
+}
+
+int NetBenchmark::connectWebSocket() const
+{
+    int fd = connectToTarget();
+
+    if (0 <= fd)
+    {
+        String  request;
+        bool    isSuccessful    = false;
+
+        request  = "GET ";
+        request += m_cfg.path;
+        request += " HTTP/1.1\r\nHost: ";
+        request += m_cfg.host;
+        request += "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: ";
+        request += WS_KEY;
+        request += "\r\nSec-WebSocket-Protocol: ";
+        request += WebConfig::WEBSOCKET_PROTOCOL;
+        request += "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+
+        if (true == sendAll(fd, request.c_str(), request.length()))
+        {
+            char    response[WS_MAX_HANDSHAKE + 1U];
+            size_t  len = 0U;
+
+            /* Receive byte by byte, because the first frame may follow the header. */
+            while((WS_MAX_HANDSHAKE > len) &&
+                  (true == recvAll(fd, &response[len], 1U)))
+            {
+                ++len;
+                response[len] = '\0';
+
+                if ((4U <= len) &&
+                    (0 == strcmp(&response[len - 4U], "\r\n\r\n")))
+                {
+                    /* Switching protocols? */
+                    if (0 == strncmp(response, "HTTP/1.1 101", 12U))
+                    {
+                        isSuccessful = true;
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        if (false == isSuccessful)
+        {
+            (void)lwip_close(fd);
+            fd = -1;
+        }
+    }
+
+    return fd;
+}
+
+bool NetBenchmark::echoWebSocket(int fd, uint16_t seq, size_t& bytes) const
+{
+    bool    isSuccessful    = false;
+    char    payload[32U];
+    char    expected[32U];
+    uint8_t frame[2U + sizeof(WS_MASK_KEY) + sizeof(payload)];
+    int     payloadLen      = snprintf(payload, sizeof(payload), "BENCH;ECHO;%u", seq);
+    size_t  index           = 0U;
+    bool    isAbort         = false;
+
+    (void)snprintf(expected, sizeof(expected), "ACK;%u", seq);
+
+    bytes = 0U;
+
+    /* Client frames must be masked. */
+    frame[0U] = WS_FLAG_FIN | WS_OPCODE_TEXT;
+    frame[1U] = WS_FLAG_MASK | static_cast<uint8_t>(payloadLen);
+    memcpy(&frame[2U], WS_MASK_KEY, sizeof(WS_MASK_KEY));
+
+    for(index = 0U; index < static_cast<size_t>(payloadLen); ++index)
+    {
+        frame[2U + sizeof(WS_MASK_KEY) + index] = payload[index] ^ WS_MASK_KEY[index % sizeof(WS_MASK_KEY)];
+    }
+
+    if (false == sendAll(fd, frame, 2U + sizeof(WS_MASK_KEY) + payloadLen))
+    {
+        isAbort = true;
+    }
+
+    /* Skip all frames, e.g. broadcasts, until the echo is received. */
+    while((false == isSuccessful) && (false == isAbort))
+    {
+        uint8_t header[2U];
+        char    rsp[WS_MAX_PAYLOAD + 1U];
+        size_t  rspLen  = 0U;
+
+        /* Server frames are not masked and the benchmark handles only
+         * small ones, without extended payload length.
+         */
+        if ((false == recvAll(fd, header, sizeof(header))) ||
+            (0U != (header[1U] & WS_FLAG_MASK)) ||
+            (WS_MAX_PAYLOAD < header[1U]))
+        {
+            isAbort = true;
+        }
+        else
+        {
+            rspLen = header[1U];
+
+            if ((0U < rspLen) &&
+                (false == recvAll(fd, rsp, rspLen)))
+            {
+                isAbort = true;
+            }
+            else if (WS_OPCODE_CLOSE == (header[0U] & 0x0fU))
+            {
+                isAbort = true;
+            }
+            else
+            {
+                rsp[rspLen] = '\0';
+                bytes += sizeof(header) + rspLen;
+
+                if ((WS_OPCODE_TEXT == (header[0U] & 0x0fU)) &&
+                    (0 == strcmp(rsp, expected)))
+                {
+                    isSuccessful = true;
+                }
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+void NetBenchmark::runClient()
+{
+    uint16_t    seq = 0U;
+    int         fd  = -1;
+
+    while(true == takeRequest(seq))
+    {
+        bool        isSuccessful    = false;
+        size_t      bytes           = 0U;
+        uint32_t    begin           = micros();
+
+        if (TEST_WEBSOCKET == m_cfg.test)
+        {
+            /* The connection is established once and reestablished after an error. */
+            if (0 > fd)
+            {
+                fd = connectWebSocket();
+                begin = micros();
+            }
+
+            if (0 <= fd)
+            {
+                isSuccessful = echoWebSocket(fd, seq, bytes);
+
+                if (false == isSuccessful)
+                {
+                    (void)lwip_close(fd);
+                    fd = -1;
+                }
+            }
+        }
+        else
+        {
+            isSuccessful = requestHttp(bytes);
+        }
+
+        record(isSuccessful, micros() - begin, bytes);
+    }
+
+    if (0 <= fd)
+    {
+        const uint8_t closeFrame[2U + sizeof(WS_MASK_KEY)] =
+        {
+            WS_FLAG_FIN | WS_OPCODE_CLOSE,
+            WS_FLAG_MASK,
+            WS_MASK_KEY[0U], WS_MASK_KEY[1U], WS_MASK_KEY[2U], WS_MASK_KEY[3U]
+        };
+
+        (void)sendAll(fd, closeFrame, sizeof(closeFrame));
+        (void)lwip_close(fd);
+    }
+
+    return;
+}
+
+void NetBenchmark::runBenchmark()
+{
+    struct addrinfo     hints;
+    struct addrinfo*    res     = nullptr;
+    uint8_t             started = 0U;
+    uint8_t             index   = 0U;
+    uint32_t            begin   = 0U;
+
+    m_addr      = 0U;
+    m_issued    = 0U;
+    m_errors    = 0U;
+    m_bytes     = 0U;
+    m_duration  = 0U;
+    m_latency.clear();
+
+    /* The own webserver is measured via the loopback. */
+    if (true == m_cfg.host.isEmpty())
+    {
+        m_cfg.host = WiFi.localIP().toString();
+    }
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family     = AF_INET;
+    hints.ai_socktype   = SOCK_STREAM;
+
+    if ((0 != lwip_getaddrinfo(m_cfg.host.c_str(), nullptr, &hints, &res)) ||
+        (nullptr == res))
+    {
+        LOG_WARNING("Benchmark: Couldn't resolve %s.", m_cfg.host.c_str());
+        m_issued = m_cfg.requests;
+        m_errors = m_cfg.requests;
+    }
+    else
+    {
+        m_addr = reinterpret_cast<struct sockaddr_in*>(res->ai_addr)->sin_addr.s_addr;
+        lwip_freeaddrinfo(res);
+
+        LOG_INFO("Benchmark started: %s %s:%u%s, %u requests, %u clients",
+            testToStr(m_cfg.test), m_cfg.host.c_str(), m_cfg.port, m_cfg.path.c_str(),
+            m_cfg.requests, m_cfg.clients);
+
+        begin = millis();
+
+        for(index = 0U; index < m_cfg.clients; ++index)
+        {
+            BaseType_t osRet = xTaskCreateUniversal(clientTask,
+                                                    "benchClient",
+                                                    TASK_STACK_SIZE,
+                                                    this,
+                                                    TASK_PRIORITY,
+                                                    nullptr,
+                                                    TASK_RUN_CORE);
+
+            if (pdPASS != osRet)
+            {
+                LOG_WARNING("Benchmark: Couldn't create client task.");
+            }
+            else
+            {
+                ++started;
+            }
+        }
+
+        /* Join */
+        for(index = 0U; index < started; ++index)
+        {
+            (void)xSemaphoreTake(m_xClientSemaphore, portMAX_DELAY);
+        }
+
+        m_duration = millis() - begin;
+    }
+
+    return;
+}
+
+void NetBenchmark::storeResult()
+{
+    const size_t        JSON_DOC_SIZE   = 768U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    JsonObject          resultObj       = jsonDoc.to<JsonObject>();
+    JsonObject          latencyObj;
+    LatencyStat::Summary summary;
+    uint32_t            completed       = 0U;
+    time_t              now             = time(nullptr);
+
+    if (pdTRUE != xSemaphoreTake(m_xMutex, portMAX_DELAY))
+    {
+        return;
+    }
+
+    m_latency.getSummary(summary);
+    completed = summary.count;
+
+    resultObj["timestamp"]  = static_cast<uint32_t>(now);
+    resultObj["version"]    = Version::SOFTWARE_VER;
+    resultObj["rssi"]       = WiFi.RSSI(); /* dBm */
+    resultObj["test"]       = testToStr(m_cfg.test);
+    resultObj["host"]       = m_cfg.host;
+    resultObj["port"]       = m_cfg.port;
+    resultObj["path"]       = m_cfg.path;
+    resultObj["clients"]    = m_cfg.clients;
+    resultObj["requests"]   = m_issued;
+    resultObj["errors"]     = m_errors;
+    resultObj["bytes"]      = m_bytes;
+    resultObj["duration"]   = m_duration; /* ms */
+
+    if (0U == m_duration)
+    {
+        resultObj["reqPerSec"] = 0;
+    }
+    else
+    {
+        resultObj["reqPerSec"] = (static_cast<float>(completed) * 1000.0F) / static_cast<float>(m_duration);
+    }
+
+    latencyObj = resultObj.createNestedObject("latency"); /* us */
+    latencyObj["min"]   = summary.min;
+    latencyObj["avg"]   = summary.avg;
+    latencyObj["p50"]   = summary.p50;
+    latencyObj["p90"]   = summary.p90;
+    latencyObj["p99"]   = summary.p99;
+    latencyObj["max"]   = summary.max;
+
+    LOG_INFO("Benchmark finished: %u/%u ok, %u ms, latency p50 %u us, p99 %u us",
+        completed, m_issued, m_duration, summary.p50, summary.p99);
+
+    /* Keep only the latest results. */
+    while(MAX_RESULTS <= m_results.size())
+    {
+        m_results.remove(0U);
+    }
+
+    (void)m_results.add(resultObj);
+
+    /* Removed results are not released by the JSON document itself. */
+    (void)m_results.garbageCollect();
+
+    if (true == m_results.overflowed())
+    {
+        LOG_WARNING("Benchmark results JSON document has less memory available.");
+    }
+
+    m_isSaveReq = true;
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+void NetBenchmark::saveResults()
+{
+    if ((true == m_isSaveReq) &&
+        (pdTRUE == xSemaphoreTake(m_xMutex, portMAX_DELAY)))
+    {
+        JsonFile jsonFile(FILESYSTEM);
+
+        if (false == jsonFile.save(RESULTS_FILENAME, m_results))
+        {
+            LOG_WARNING("Couldn't save benchmark results.");
+        }
+
+        m_isSaveReq = false;
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+void NetBenchmark::benchmarkTask(void* parameters)
+{
+    NetBenchmark* bench = reinterpret_cast<NetBenchmark*>(parameters);
+
+    if (nullptr != bench)
+    {
+        bench->runBenchmark();
+
+        (void)xSemaphoreGive(bench->m_xExitSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+void NetBenchmark::clientTask(void* parameters)
+{
+    NetBenchmark* bench = reinterpret_cast<NetBenchmark*>(parameters);
+
+    if (nullptr != bench)
+    {
+        bench->runClient();
+
+        (void)xSemaphoreGive(bench->m_xClientSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+bool NetBenchmark::sendAll(int fd, const void* data, size_t size)
+{
+    const uint8_t*  buffer  = static_cast<const uint8_t*>(data);
+    size_t          sent    = 0U;
+    bool            isError = false;
+
+    while((size > sent) && (false == isError))
+    {
+        int ret = lwip_send(fd, &buffer[sent], size - sent, 0);
+
+        if (0 >= ret)
+        {
+            isError = true;
+        }
+        else
+        {
+            sent += ret;
+        }
+    }
+
+    return (false == isError);
+}
+
+bool NetBenchmark::recvAll(int fd, void* data, size_t size)
+{
+    uint8_t*    buffer      = static_cast<uint8_t*>(data);
+    size_t      received    = 0U;
+    bool        isError     = false;
+
+    while((size > received) && (false == isError))
+    {
+        int ret = lwip_recv(fd, &buffer[received], size - received, 0);
+
+        if (0 >= ret)
+        {
+            isError = true;
+        }
+        else
+        {
+            received += ret;
+        }
+    }
+
+    return (false == isError);
+}
+
+const char* NetBenchmark::testToStr(Test test)
+{
+    const char* str = "unknown";
+
+    switch(test)
+    {
+    case TEST_HTTP:
+        str = "http";
+        break;
+
+    case TEST_WEBSOCKET:
+        str = "websocket";
+        break;
+
+    default:
+        break;
+    }
+
+    return str;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
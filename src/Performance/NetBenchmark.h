@@ -0,0 +1,389 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Network benchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __NET_BENCHMARK_H__
+#define __NET_BENCHMARK_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <WString.h>
+#include <ArduinoJson.h>
+#include <LatencyStat.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The network benchmark measures the request latency and the request rate
+ * to a HTTP or websocket server. It completes the raw TCP/UDP throughput
+ * test of iperf.
+ *
+ * Every client runs in its own task with blocking sockets and sends its
+ * requests one after another. With several clients the concurrent request
+ * handling of the server is measured.
+ *
+ * - HTTP: Every request uses its own connection. The latency is the time
+ *   from connecting until the complete response is received.
+ * - Websocket: Every client keeps its connection and sends the echo
+ *   command (BENCH;ECHO;<seq>). The latency is the round trip time until
+ *   the echo is received.
+ *
+ * If the target is the own IP address, the own webserver is measured via
+ * the loopback interface, e.g. with a static file or a REST endpoint.
+ *
+ * The latest results are kept in the filesystem, so they can be compared
+ * after a firmware update.
+ */
+class NetBenchmark
+{
+public:
+
+    /** Benchmark test */
+    enum Test
+    {
+        TEST_HTTP = 0,  /**< HTTP GET requests */
+        TEST_WEBSOCKET  /**< Websocket echo */
+    };
+
+    /** Benchmark configuration */
+    struct Config
+    {
+        Test        test;       /**< Test */
+        String      host;       /**< Target host, empty for the own IP address */
+        uint16_t    port;       /**< Target port */
+        String      path;       /**< Request path */
+        uint16_t    requests;   /**< Number of requests over all clients */
+        uint8_t     clients;    /**< Number of concurrent clients */
+    };
+
+    /** Max. number of concurrent clients. */
+    static const uint8_t        MAX_CLIENTS         = 4U;
+
+    /** Max. number of requests of a benchmark. */
+    static const uint16_t       MAX_REQUESTS        = 1000U;
+
+    /** Max. number of stored results. */
+    static const uint8_t        MAX_RESULTS         = 8U;
+
+    /** Max. time in ms to wait for a response, before the request fails. */
+    static const uint32_t       RESPONSE_TIMEOUT    = 5000U;
+
+    /** Default number of requests. */
+    static const uint16_t       DEFAULT_REQUESTS    = 100U;
+
+    /** Default HTTP request path, which is a static file. */
+    static const char*          DEFAULT_HTTP_PATH;
+
+    /** Filename of the stored results. */
+    static const char*          RESULTS_FILENAME;
+
+    /** Size in byte of the JSON document, which holds the results. */
+    static const size_t         RESULTS_DOC_SIZE    = 6144U;
+
+    /** Coordinator and client task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 4096U;
+
+    /** MCU core where the tasks shall run, which is not the one of the async TCP task. */
+    static const BaseType_t     TASK_RUN_CORE       = 1;
+
+    /** Task priority, which is the same as the loop task. */
+    static const UBaseType_t    TASK_PRIORITY       = 1U;
+
+    /**
+     * Get the network benchmark instance.
+     *
+     * @return Network benchmark
+     */
+    static NetBenchmark& getInstance()
+    {
+        static NetBenchmark instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Load the stored results.
+     */
+    void begin();
+
+    /**
+     * Abort a running benchmark.
+     */
+    void end();
+
+    /**
+     * Process the benchmark. It starts a requested benchmark and stores the
+     * result of a finished one. Call it periodically.
+     */
+    void process();
+
+    /**
+     * Request to start a benchmark. It is started by the next process() call.
+     * Only one benchmark can run at once.
+     *
+     * @param[in] cfg   Configuration
+     *
+     * @return If accepted, it will return true otherwise false.
+     */
+    bool start(const Config& cfg);
+
+    /**
+     * Request to abort a running benchmark. The partial result is stored.
+     */
+    void stop();
+
+    /**
+     * Is a benchmark requested or running?
+     *
+     * @return If running, it will return true otherwise false.
+     */
+    bool isRunning() const;
+
+    /**
+     * Copy the stored results, the latest one last.
+     *
+     * @param[out] results  JSON array, which will contain the results.
+     */
+    void getResults(JsonArray& results) const;
+
+    /**
+     * Remove all stored results. The filesystem is updated by the next
+     * process() call.
+     */
+    void clearResults();
+
+private:
+
+    /** Mutex to protect the configuration, the statistics and the results. */
+    SemaphoreHandle_t       m_xMutex;
+
+    /** Binary semaphore used to signal the coordinator task exit. */
+    SemaphoreHandle_t       m_xExitSemaphore;
+
+    /** Counting semaphore used to signal the client task exits. */
+    SemaphoreHandle_t       m_xClientSemaphore;
+
+    /** Coordinator task handle */
+    TaskHandle_t            m_taskHandle;
+
+    /** Is a benchmark start requested? */
+    bool                    m_isStartReq;
+
+    /** Is the benchmark requested to abort? */
+    volatile bool           m_isExitReq;
+
+    /** Configuration of the requested or running benchmark. */
+    Config                  m_cfg;
+
+    /** Resolved target address (network byte order). */
+    uint32_t                m_addr;
+
+    /** Number of requests, which are taken by the clients. */
+    uint16_t                m_issued;
+
+    /** Number of failed requests. */
+    uint16_t                m_errors;
+
+    /** Number of received bytes. */
+    uint32_t                m_bytes;
+
+    /** Benchmark duration in ms. */
+    uint32_t                m_duration;
+
+    /** Latency statistics in us of the successful requests. */
+    LatencyStat             m_latency;
+
+    /** Stored results */
+    DynamicJsonDocument     m_results;
+
+    /** Are the stored results loaded? */
+    bool                    m_isLoaded;
+
+    /** Are the results changed and shall be saved? */
+    volatile bool           m_isSaveReq;
+
+    /**
+     * Constructs the network benchmark.
+     */
+    NetBenchmark();
+
+    /**
+     * Destroys the network benchmark.
+     */
+    ~NetBenchmark();
+
+    NetBenchmark(const NetBenchmark& bench);
+    NetBenchmark& operator=(const NetBenchmark& bench);
+
+    /**
+     * Take the next request.
+     *
+     * @param[out] seq  Sequence number of the request
+     *
+     * @return If a request is left, it will return true otherwise false.
+     */
+    bool takeRequest(uint16_t& seq);
+
+    /**
+     * Record the outcome of a request.
+     *
+     * @param[in] isSuccessful  Was the request successful?
+     * @param[in] latency       Latency in us
+     * @param[in] bytes         Received bytes
+     */
+    void record(bool isSuccessful, uint32_t latency, size_t bytes);
+
+    /**
+     * Connect to the target.
+     *
+     * @return Socket file descriptor or -1 on error.
+     */
+    int connectToTarget() const;
+
+    /**
+     * Send a HTTP GET request and receive the whole response.
+     *
+     * @param[out] bytes    Received bytes
+     *
+     * @return If a successful response is received, it will return true otherwise false.
+     */
+    bool requestHttp(size_t& bytes) const;
+
+    /**
+     * Connect to the websocket server and perform the opening handshake.
+     *
+     * @return Socket file descriptor or -1 on error.
+     */
+    int connectWebSocket() const;
+
+    /**
+     * Send the echo command and wait for the echo.
+     *
+     * @param[in]   fd      Socket file descriptor
+     * @param[in]   seq     Sequence number, which is echoed.
+     * @param[out]  bytes   Received bytes
+     *
+     * @return If the echo is received, it will return true otherwise false.
+     */
+    bool echoWebSocket(int fd, uint16_t seq, size_t& bytes) const;
+
+    /**
+     * Run the requests of one client.
+     */
+    void runClient();
+
+    /**
+     * Run the benchmark, which starts the clients and waits until they are
+     * finished.
+     */
+    void runBenchmark();
+
+    /**
+     * Append the result of the finished benchmark to the stored results
+     * and save them.
+     */
+    void storeResult();
+
+    /**
+     * Save the results, if they changed. The filesystem is accessed only
+     * in the context of process() and end().
+     */
+    void saveResults();
+
+    /**
+     * Coordinator task, which runs the benchmark.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void benchmarkTask(void* parameters);
+
+    /**
+     * Client task, which runs the requests.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void clientTask(void* parameters);
+
+    /**
+     * Send the whole data.
+     *
+     * @param[in] fd    Socket file descriptor
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool sendAll(int fd, const void* data, size_t size);
+
+    /**
+     * Receive exactly the requested number of bytes.
+     *
+     * @param[in]   fd      Socket file descriptor
+     * @param[out]  data    Data buffer
+     * @param[in]   size    Number of bytes to receive
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool recvAll(int fd, void* data, size_t size);
+
+    /**
+     * Get the test name.
+     *
+     * @param[in] test  Test
+     *
+     * @return Test name
+     */
+    static const char* testToStr(Test test);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __NET_BENCHMARK_H__ */
+
+/** @} */
@@ -47,6 +47,8 @@
 #include <IGfx.hpp>
 #include <HttpStatus.h>
 #include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
+#include "PluginWebRouter.h"
 #include <Util.h>
 #include "ISlotPlugin.hpp"
 
@@ -70,6 +72,18 @@ public:
      */
     typedef IPluginMaintenance* (*CreateFunc)(const String& name, uint16_t uid);
 
+    /** Process period, which means the plugin is processed in every display cycle. */
+    static const uint32_t PROCESS_PERIOD_ALWAYS = 0U;
+
+    /** Process period, which means the plugin is never processed. */
+    static const uint32_t PROCESS_PERIOD_NEVER  = UINT32_MAX;
+
+    /** Time to next update, which means the plugin is updated in every display cycle. */
+    static const uint32_t UPDATE_ALWAYS         = 0U;
+
+    /** Update period, which means the plugin is updated in every display cycle. */
+    static const uint32_t UPDATE_PERIOD_ALWAYS  = 0U;
+
     /**
      * Destroys the interface.
      */
@@ -96,18 +110,18 @@ public:
      * Register web interface, e.g. REST API functionality.
      * Overwrite it, if your plugin provides a web interface.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    virtual void registerWebInterface(AsyncWebServer& srv, const String& baseUri) = 0;
+    virtual void registerWebInterface(PluginWebRouter& srv, const String& baseUri) = 0;
 
     /**
      * Unregister web interface.
      * Overwrite it, if your plugin provides a web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    virtual void unregisterWebInterface(AsyncWebServer& srv) = 0;
+    virtual void unregisterWebInterface(PluginWebRouter& srv) = 0;
 
     /**
      * Get the plugin name.
@@ -155,6 +169,44 @@ public:
      */
     virtual void process() = 0;
 
+    /**
+     * Get the period in ms, in which the plugin shall be processed.
+     * The plugin is processed not more often, but it may be later,
+     * depended on the display cycle.
+     *
+     * @return Process period in ms
+     */
+    virtual uint32_t getProcessPeriod() const = 0;
+
+    /**
+     * Has the plugin content to show? A plugin, which shows e.g. data from
+     * a remote source, may return false as long as no valid data is
+     * available. Its slot is skipped in the slot rotation then.
+     *
+     * @return If content is available, it will return true otherwise false.
+     */
+    virtual bool hasContent() const = 0;
+
+    /**
+     * This method will be called shortly before the plugin is set active,
+     * to give it the chance to load its assets, e.g. icons from filesystem.
+     * It is called in the context of a low priority task, not the display
+     * task. Therefore the plugin must protect it against concurrent access.
+     * Overwrite it if your plugin needs time consuming preparations.
+     */
+    virtual void prepare() = 0;
+
+    /**
+     * This method will be called in case the heap runs low, while the plugin
+     * is inactive. The plugin shall release its assets, which can be loaded
+     * again, e.g. icons from filesystem. They are loaded again by prepare()
+     * before the plugin is set active, or at the latest by active().
+     * It is not called in the context of the display task. Therefore the
+     * plugin must protect it against concurrent access.
+     * Overwrite it if your plugin keeps large reloadable assets.
+     */
+    virtual void releaseAssets() = 0;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -180,6 +232,43 @@ public:
      */
     virtual void update(IGfx& gfx) = 0;
 
+    /**
+     * Get the time in ms, until the plugin content changes next. Until then
+     * the display manager skips update(), because the plugin declares that
+     * nothing changes. It is called in the display task after process().
+     *
+     * @return Time to next update in ms or UPDATE_ALWAYS
+     */
+    virtual uint32_t getTimeToNextUpdate() const = 0;
+
+    /**
+     * Get the period in ms, in which the plugin shall be updated, while it
+     * is active. The display manager skips update() in between and shows
+     * the previous frame, fading continues in every display cycle.
+     * The first update after activation is never skipped.
+     *
+     * @return Update period in ms or UPDATE_PERIOD_ALWAYS
+     */
+    virtual uint32_t getUpdatePeriod() const = 0;
+
+    /**
+     * Apply plugin specific settings, e.g. the text of a text plugin.
+     * It is used to configure several plugins at once via the display layout.
+     *
+     * @param[in] settings  Plugin specific settings
+     *
+     * @return If all settings are applied, it will return true otherwise false.
+     */
+    virtual bool applySettings(JsonObjectConst settings) = 0;
+
+    /**
+     * Shall the display manager fade between the previous content and the
+     * plugin? Without fading the plugin content is shown immediately.
+     *
+     * @return If fading is enabled, it will return true otherwise false.
+     */
+    virtual bool isFadeEnabled() const = 0;
+
 protected:
 
     /**
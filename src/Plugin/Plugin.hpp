@@ -44,11 +44,14 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <new>
 #include <IGfx.hpp>
 #include <HttpStatus.h>
 #include <ESPAsyncWebServer.h>
 #include <Util.h>
 #include "IPluginMaintenance.hpp"
+#include "PluginMemPool.h"
+#include "Board.h"
 
 /******************************************************************************
  * Macros
@@ -98,10 +101,10 @@ public:
      * Register web interface, e.g. REST API functionality.
      * Overwrite it, if your plugin provides a web interface.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    virtual void registerWebInterface(AsyncWebServer& srv, const String& baseUri) override
+    virtual void registerWebInterface(PluginWebRouter& srv, const String& baseUri) override
     {
         UTIL_NOT_USED(srv);
         UTIL_NOT_USED(baseUri);
@@ -112,9 +115,9 @@ public:
      * Unregister web interface.
      * Overwrite it, if your plugin provides a web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    virtual void unregisterWebInterface(AsyncWebServer& srv) override
+    virtual void unregisterWebInterface(PluginWebRouter& srv) override
     {
         UTIL_NOT_USED(srv);
         return;
@@ -189,6 +192,101 @@ public:
         return;
     }
 
+    /**
+     * Get the period in ms, in which the plugin shall be processed.
+     * Overwrite it together with process(), by default the plugin is
+     * never processed.
+     *
+     * @return Process period in ms
+     */
+    virtual uint32_t getProcessPeriod() const override
+    {
+        return PROCESS_PERIOD_NEVER;
+    }
+
+    /**
+     * Has the plugin content to show?
+     * Overwrite it, if your plugin can't show anything useful without data.
+     * By default the plugin has always content.
+     *
+     * @return If content is available, it will return true otherwise false.
+     */
+    virtual bool hasContent() const override
+    {
+        return true;
+    }
+
+    /**
+     * Get the time in ms, until the plugin content changes next.
+     * Overwrite it, if your plugin knows when its content changes, e.g. a
+     * clock. By default the plugin is updated in every display cycle.
+     *
+     * @return Time to next update in ms or UPDATE_ALWAYS
+     */
+    virtual uint32_t getTimeToNextUpdate() const override
+    {
+        return UPDATE_ALWAYS;
+    }
+
+    /**
+     * Get the period in ms, in which the plugin shall be updated.
+     * Overwrite it, if your plugin content changes seldom and it shows no
+     * animation. By default the plugin is updated in every display cycle.
+     *
+     * @return Update period in ms or UPDATE_PERIOD_ALWAYS
+     */
+    virtual uint32_t getUpdatePeriod() const override
+    {
+        return UPDATE_PERIOD_ALWAYS;
+    }
+
+    /**
+     * Apply plugin specific settings.
+     * Overwrite it, if your plugin has settings, which shall be part of the
+     * display layout. By default the plugin has no settings.
+     *
+     * @param[in] settings  Plugin specific settings
+     *
+     * @return If all settings are applied, it will return true otherwise false.
+     */
+    virtual bool applySettings(JsonObjectConst settings) override
+    {
+        (void)settings;
+
+        return false;
+    }
+
+    /**
+     * Shall the display manager fade between the previous content and the
+     * plugin? Overwrite it, if your plugin content shall be shown immediately,
+     * e.g. a realtime stream. By default fading is enabled.
+     *
+     * @return If fading is enabled, it will return true otherwise false.
+     */
+    virtual bool isFadeEnabled() const override
+    {
+        return true;
+    }
+
+    /**
+     * This method will be called shortly before the plugin is set active.
+     * Overwrite it if your plugin needs time consuming preparations.
+     */
+    virtual void prepare() override
+    {
+        return;
+    }
+
+    /**
+     * This method will be called in case the heap runs low, while the plugin
+     * is inactive. The plugin shall release its reloadable assets.
+     * Overwrite it if your plugin keeps large reloadable assets.
+     */
+    virtual void releaseAssets() override
+    {
+        return;
+    }
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -221,6 +319,29 @@ public:
      */
     virtual void update(IGfx& gfx) = 0;
 
+    /**
+     * Allocate the plugin instance from the plugin memory pool.
+     *
+     * @param[in] size  Size of the plugin instance in byte
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    static void* operator new(size_t size) noexcept
+    {
+        return PluginMemPool::getInstance().alloc(size, PluginMemPool::OWNER_INSTANCES);
+    }
+
+    /**
+     * Release the plugin instance memory.
+     *
+     * @param[in] ptr   Pointer to the plugin instance memory
+     */
+    static void operator delete(void* ptr)
+    {
+        PluginMemPool::getInstance().release(ptr);
+        return;
+    }
+
 protected:
 
     /**
@@ -237,6 +358,83 @@ protected:
     {
     }
 
+    /**
+     * Allocate a work buffer from the plugin memory pool.
+     * It is accounted to this plugin.
+     *
+     * @param[in] size  Buffer size in byte
+     *
+     * @return If successful, it will return a pointer to the buffer otherwise nullptr.
+     */
+    void* allocBuffer(size_t size) const
+    {
+        return PluginMemPool::getInstance().alloc(size, m_uid);
+    }
+
+    /**
+     * Release a work buffer, which was allocated with allocBuffer() before.
+     *
+     * @param[in] buffer    Buffer, may be nullptr.
+     */
+    void releaseBuffer(void* buffer) const
+    {
+        PluginMemPool::getInstance().release(buffer);
+        return;
+    }
+
+    /**
+     * Create a activation resource, e.g. a canvas, in the plugin memory pool.
+     * A resource with fixed size shall be created once in start() and just
+     * be reset in active(), so a slot change allocates nothing. The display
+     * size is given by DISPLAY_WIDTH and DISPLAY_HEIGHT.
+     *
+     * @tparam T        Resource type
+     * @tparam Args     Constructor argument types
+     *
+     * @param[in] args  Constructor arguments
+     *
+     * @return If successful, it will return the resource otherwise nullptr.
+     */
+    template <typename T, typename... Args>
+    T* createResource(Args... args) const
+    {
+        void*   buffer      = allocBuffer(sizeof(T));
+        T*      resource    = nullptr;
+
+        if (nullptr != buffer)
+        {
+            resource = new(buffer) T(args...);
+        }
+
+        return resource;
+    }
+
+    /**
+     * Destroy a activation resource, which was created with createResource() before.
+     *
+     * @tparam T            Resource type
+     *
+     * @param[in,out] resource  Resource, may be nullptr. It is nullptr afterwards.
+     */
+    template <typename T>
+    void destroyResource(T*& resource) const
+    {
+        if (nullptr != resource)
+        {
+            resource->~T();
+            releaseBuffer(resource);
+            resource = nullptr;
+        }
+
+        return;
+    }
+
+    /** Display width in pixel, e.g. to create the activation resources in start(). */
+    static const uint16_t   DISPLAY_WIDTH   = Board::LedMatrix::width;
+
+    /** Display height in pixel, e.g. to create the activation resources in start(). */
+    static const uint16_t   DISPLAY_HEIGHT  = Board::LedMatrix::height;
+
 private:
 
     uint16_t    m_uid;          /**< Unique id */
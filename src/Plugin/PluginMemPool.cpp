@@ -0,0 +1,391 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin memory pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PluginMemPool.h"
+
+#include <Logging.h>
+#include <stdlib.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool PluginMemPool::begin(size_t size)
+{
+    bool        status      = false;
+    uint32_t    numOfBlocks = size / BLOCK_SIZE;
+
+    /* The number of blocks is limited by the header. */
+    if (UINT16_MAX < numOfBlocks)
+    {
+        numOfBlocks = UINT16_MAX;
+    }
+
+    if (nullptr != m_pool)
+    {
+        LOG_WARNING("Plugin memory pool already exists.");
+    }
+    else if (0U == numOfBlocks)
+    {
+        LOG_INFO("Plugin memory pool disabled.");
+    }
+    else
+    {
+        bool isPsram = psramFound();
+
+        if (true == isPsram)
+        {
+            m_pool = static_cast<uint8_t*>(ps_malloc(numOfBlocks * BLOCK_SIZE));
+        }
+        else
+        {
+            m_pool = static_cast<uint8_t*>(malloc(numOfBlocks * BLOCK_SIZE));
+        }
+
+        m_isBlockUsed = new bool[numOfBlocks];
+
+        if ((nullptr == m_pool) ||
+            (nullptr == m_isBlockUsed))
+        {
+            LOG_ERROR("Couldn't allocate plugin memory pool with %u byte.", numOfBlocks * BLOCK_SIZE);
+
+            if (nullptr != m_pool)
+            {
+                free(m_pool);
+                m_pool = nullptr;
+            }
+
+            if (nullptr != m_isBlockUsed)
+            {
+                delete[] m_isBlockUsed;
+                m_isBlockUsed = nullptr;
+            }
+        }
+        else
+        {
+            uint16_t blockIdx = 0U;
+
+            for(blockIdx = 0U; blockIdx < numOfBlocks; ++blockIdx)
+            {
+                m_isBlockUsed[blockIdx] = false;
+            }
+
+            m_numOfBlocks = numOfBlocks;
+
+            LOG_INFO("Plugin memory pool with %u byte in %s.", getSize(), (true == isPsram) ? "PSRAM" : "heap");
+
+            status = true;
+        }
+    }
+
+    return status;
+}
+
+void* PluginMemPool::alloc(size_t size, uint16_t owner)
+{
+    void*           ptr         = nullptr;
+    const size_t    NUM_BLOCKS  = (sizeof(Header) + size + BLOCK_SIZE - 1U) / BLOCK_SIZE;
+    uint16_t        blockIdx    = 0U;
+
+    lock();
+
+    if ((m_numOfBlocks >= NUM_BLOCKS) &&
+        (true == findFreeBlocks(NUM_BLOCKS, blockIdx)))
+    {
+        Header*     header  = reinterpret_cast<Header*>(&m_pool[blockIdx * BLOCK_SIZE]);
+        uint16_t    index   = 0U;
+
+        for(index = 0U; index < NUM_BLOCKS; ++index)
+        {
+            m_isBlockUsed[blockIdx + index] = true;
+        }
+
+        header->numOfBlocks = NUM_BLOCKS;
+        header->owner       = owner;
+        header->reserved    = 0U;
+
+        m_usedBlocks += NUM_BLOCKS;
+
+        if (m_peakUsedBlocks < m_usedBlocks)
+        {
+            m_peakUsedBlocks = m_usedBlocks;
+        }
+
+        accountAlloc(owner, NUM_BLOCKS);
+
+        ptr = &header[1];
+    }
+
+    unlock();
+
+    /* Pool exhausted or not available? */
+    if (nullptr == ptr)
+    {
+        ptr = malloc(size);
+
+        if ((nullptr != ptr) &&
+            (0U < m_numOfBlocks))
+        {
+            lock();
+            ++m_numOfFallbacks;
+            unlock();
+        }
+    }
+
+    return ptr;
+}
+
+void PluginMemPool::release(void* ptr)
+{
+    if (nullptr != ptr)
+    {
+        if (false == isInPool(ptr))
+        {
+            free(ptr);
+        }
+        else
+        {
+            Header*     header      = &static_cast<Header*>(ptr)[-1];
+            uint16_t    blockIdx    = (reinterpret_cast<uint8_t*>(header) - m_pool) / BLOCK_SIZE;
+            uint16_t    index       = 0U;
+
+            lock();
+
+            for(index = 0U; index < header->numOfBlocks; ++index)
+            {
+                m_isBlockUsed[blockIdx + index] = false;
+            }
+
+            m_usedBlocks -= header->numOfBlocks;
+            accountRelease(header->owner, header->numOfBlocks);
+
+            unlock();
+        }
+    }
+
+    return;
+}
+
+bool PluginMemPool::getAccount(uint8_t index, uint16_t& owner, size_t& used)
+{
+    bool    status      = false;
+    uint8_t accountIdx  = 0U;
+    uint8_t found       = 0U;
+
+    lock();
+
+    /* The index counts only the used accounts. */
+    while((MAX_ACCOUNTS > accountIdx) && (false == status))
+    {
+        if (0U < m_accounts[accountIdx].numOfBlocks)
+        {
+            if (index == found)
+            {
+                owner   = m_accounts[accountIdx].owner;
+                used    = m_accounts[accountIdx].numOfBlocks * BLOCK_SIZE;
+                status  = true;
+            }
+
+            ++found;
+        }
+
+        ++accountIdx;
+    }
+
+    unlock();
+
+    return status;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool PluginMemPool::isInPool(const void* ptr) const
+{
+    const uint8_t* bytePtr = static_cast<const uint8_t*>(ptr);
+
+    return (nullptr != m_pool) &&
+           (m_pool <= bytePtr) &&
+           (&m_pool[m_numOfBlocks * BLOCK_SIZE] > bytePtr);
+}
+
+bool PluginMemPool::findFreeBlocks(uint16_t numOfBlocks, uint16_t& blockIdx) const
+{
+    bool        isFound     = false;
+    uint16_t    index       = 0U;
+    uint16_t    rangeLength = 0U;
+
+    /* First fit */
+    while((m_numOfBlocks > index) && (false == isFound))
+    {
+        if (true == m_isBlockUsed[index])
+        {
+            rangeLength = 0U;
+        }
+        else
+        {
+            ++rangeLength;
+
+            if (numOfBlocks == rangeLength)
+            {
+                blockIdx    = index + 1U - numOfBlocks;
+                isFound     = true;
+            }
+        }
+
+        ++index;
+    }
+
+    return isFound;
+}
+
+void PluginMemPool::accountAlloc(uint16_t owner, uint16_t numOfBlocks)
+{
+    uint8_t index       = 0U;
+    uint8_t freeIndex   = MAX_ACCOUNTS;
+    bool    isFound     = false;
+
+    while((MAX_ACCOUNTS > index) && (false == isFound))
+    {
+        if (0U == m_accounts[index].numOfBlocks)
+        {
+            if (MAX_ACCOUNTS == freeIndex)
+            {
+                freeIndex = index;
+            }
+        }
+        else if (owner == m_accounts[index].owner)
+        {
+            m_accounts[index].numOfBlocks += numOfBlocks;
+            isFound = true;
+        }
+        else
+        {
+            ;
+        }
+
+        ++index;
+    }
+
+    /* If all accounts are in use, the allocation is not accounted. */
+    if ((false == isFound) &&
+        (MAX_ACCOUNTS > freeIndex))
+    {
+        m_accounts[freeIndex].owner         = owner;
+        m_accounts[freeIndex].numOfBlocks   = numOfBlocks;
+    }
+
+    return;
+}
+
+void PluginMemPool::accountRelease(uint16_t owner, uint16_t numOfBlocks)
+{
+    uint8_t index   = 0U;
+    bool    isFound = false;
+
+    while((MAX_ACCOUNTS > index) && (false == isFound))
+    {
+        if ((0U < m_accounts[index].numOfBlocks) &&
+            (owner == m_accounts[index].owner))
+        {
+            if (numOfBlocks < m_accounts[index].numOfBlocks)
+            {
+                m_accounts[index].numOfBlocks -= numOfBlocks;
+            }
+            else
+            {
+                m_accounts[index].numOfBlocks = 0U;
+            }
+
+            isFound = true;
+        }
+
+        ++index;
+    }
+
+    return;
+}
+
+void PluginMemPool::lock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void PluginMemPool::unlock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
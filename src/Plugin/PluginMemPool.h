@@ -0,0 +1,291 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin memory pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __PLUGIN_MEM_POOL_H__
+#define __PLUGIN_MEM_POOL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/**
+ * Size of the plugin memory pool in byte, which is carved out at boot.
+ * If the pool is exhausted, the allocations will fall back to the heap.
+ * Set it to 0 to allocate everything from the heap.
+ */
+#ifndef PLUGIN_MEM_POOL_SIZE
+#define PLUGIN_MEM_POOL_SIZE    (16U * 1024U)
+#endif  /* PLUGIN_MEM_POOL_SIZE */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The plugin memory pool provides the memory for the plugin instances and
+ * their work buffers. It consists of fixed size blocks, which are carved out
+ * of the heap (or the PSRAM if available) once at boot. Because plugins are
+ * installed and uninstalled during runtime, this keeps the fragmentation
+ * inside the pool, instead of the whole heap.
+ *
+ * Every allocation is accounted to its owner, which is the plugin UID.
+ */
+class PluginMemPool
+{
+public:
+
+    /**
+     * Get plugin memory pool instance.
+     *
+     * @return Plugin memory pool instance
+     */
+    static PluginMemPool& getInstance()
+    {
+        static PluginMemPool instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Carve out the pool. If PSRAM is available, the pool will be located there.
+     * Call it once at boot, before any plugin is created.
+     *
+     * @param[in] size  Pool size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin(size_t size);
+
+    /**
+     * Allocate memory from the pool. If the pool is exhausted, it will
+     * be allocated from the heap.
+     *
+     * @param[in] size  Size in byte
+     * @param[in] owner Owner, which is accounted for it (plugin UID)
+     *
+     * @return If successful, it will return a pointer to the memory otherwise nullptr.
+     */
+    void* alloc(size_t size, uint16_t owner);
+
+    /**
+     * Release memory, which was allocated with alloc() before.
+     *
+     * @param[in] ptr   Pointer to the memory, may be nullptr.
+     */
+    void release(void* ptr);
+
+    /**
+     * Get pool size.
+     *
+     * @return Pool size in byte
+     */
+    size_t getSize() const
+    {
+        return m_numOfBlocks * BLOCK_SIZE;
+    }
+
+    /**
+     * Get currently used pool memory.
+     *
+     * @return Used pool memory in byte
+     */
+    size_t getUsed() const
+    {
+        return m_usedBlocks * BLOCK_SIZE;
+    }
+
+    /**
+     * Get the max. used pool memory since boot.
+     *
+     * @return Max. used pool memory in byte
+     */
+    size_t getPeakUsed() const
+    {
+        return m_peakUsedBlocks * BLOCK_SIZE;
+    }
+
+    /**
+     * Get the number of allocations, which were served by the heap, because
+     * the pool was exhausted.
+     *
+     * @return Number of heap allocations
+     */
+    uint32_t getNumOfFallbacks() const
+    {
+        return m_numOfFallbacks;
+    }
+
+    /**
+     * Get the pool memory, which is accounted to an owner.
+     * Use it to iterate over all owners, starting with index 0.
+     *
+     * @param[in]   index   Account index
+     * @param[out]  owner   Owner (plugin UID)
+     * @param[out]  used    Used pool memory in byte
+     *
+     * @return If a owner exists at the given index, it will return true otherwise false.
+     */
+    bool getAccount(uint8_t index, uint16_t& owner, size_t& used);
+
+    /** Size of a single block in byte. */
+    static const size_t     BLOCK_SIZE          = 32U;
+
+    /** Max. number of accounted owners. */
+    static const uint8_t    MAX_ACCOUNTS        = 24U;
+
+    /** Owner of the plugin instances. It is never used as plugin UID. */
+    static const uint16_t   OWNER_INSTANCES     = UINT16_MAX;
+
+private:
+
+    /**
+     * Header in front of every allocation in the pool.
+     * It is a multiple of 8 byte, to keep the allocations aligned.
+     */
+    struct Header
+    {
+        uint16_t    numOfBlocks;    /**< Number of blocks, incl. the header */
+        uint16_t    owner;          /**< Owner of the allocation */
+        uint32_t    reserved;       /**< Keeps the alignment */
+    };
+
+    /**
+     * Used pool memory of a single owner.
+     */
+    struct Account
+    {
+        uint16_t    owner;          /**< Owner */
+        uint16_t    numOfBlocks;    /**< Number of used blocks, 0 if the account is free */
+    };
+
+    uint8_t*            m_pool;                     /**< Pool memory */
+    bool*               m_isBlockUsed;              /**< Usage of every block */
+    uint16_t            m_numOfBlocks;              /**< Number of blocks in the pool */
+    uint16_t            m_usedBlocks;               /**< Number of used blocks */
+    uint16_t            m_peakUsedBlocks;           /**< Max. number of used blocks */
+    uint32_t            m_numOfFallbacks;           /**< Number of allocations, served by the heap */
+    Account             m_accounts[MAX_ACCOUNTS];   /**< Used pool memory per owner */
+    SemaphoreHandle_t   m_xMutex;                   /**< Mutex to protect against concurrent access. */
+
+    /**
+     * Constructs the plugin memory pool.
+     */
+    PluginMemPool() :
+        m_pool(nullptr),
+        m_isBlockUsed(nullptr),
+        m_numOfBlocks(0U),
+        m_usedBlocks(0U),
+        m_peakUsedBlocks(0U),
+        m_numOfFallbacks(0U),
+        m_accounts(),
+        m_xMutex(xSemaphoreCreateMutex())
+    {
+    }
+
+    /**
+     * Destroys the plugin memory pool.
+     */
+    ~PluginMemPool()
+    {
+        /* Will never be called. */
+    }
+
+    PluginMemPool(const PluginMemPool& pool);
+    PluginMemPool& operator=(const PluginMemPool& pool);
+
+    /**
+     * Is the memory located in the pool?
+     *
+     * @param[in] ptr   Pointer to the memory
+     *
+     * @return If the memory is located in the pool, it will return true otherwise false.
+     */
+    bool isInPool(const void* ptr) const;
+
+    /**
+     * Find a range of free blocks.
+     *
+     * @param[in]   numOfBlocks Number of blocks
+     * @param[out]  blockIdx    Index of the first block in the range
+     *
+     * @return If found, it will return true otherwise false.
+     */
+    bool findFreeBlocks(uint16_t numOfBlocks, uint16_t& blockIdx) const;
+
+    /**
+     * Account blocks to a owner.
+     *
+     * @param[in] owner         Owner
+     * @param[in] numOfBlocks   Number of allocated blocks
+     */
+    void accountAlloc(uint16_t owner, uint16_t numOfBlocks);
+
+    /**
+     * Remove the blocks from the account of a owner.
+     *
+     * @param[in] owner         Owner
+     * @param[in] numOfBlocks   Number of released blocks
+     */
+    void accountRelease(uint16_t owner, uint16_t numOfBlocks);
+
+    /**
+     * Lock the pool.
+     */
+    void lock();
+
+    /**
+     * Unlock the pool.
+     */
+    void unlock();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PLUGIN_MEM_POOL_H__ */
+
+/** @} */
\ No newline at end of file
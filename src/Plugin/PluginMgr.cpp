@@ -34,9 +34,10 @@
  *****************************************************************************/
 #include "PluginMgr.h"
 #include "DisplayMgr.h"
-#include "MyWebServer.h"
+#include "PluginWebRouter.h"
 #include "RestApi.h"
 #include "Settings.h"
+#include "EventStream.h"
 
 #include <Logging.h>
 #include <ArduinoJson.h>
@@ -65,38 +66,9 @@
  * Public Methods
  *****************************************************************************/
 
-void PluginMgr::registerPlugin(const String& name, IPluginMaintenance::CreateFunc createFunc)
-{
-    PluginRegEntry* entry = new PluginRegEntry();
-
-    if (nullptr != entry)
-    {
-        entry->name         = name;
-        entry->createFunc   = createFunc;
-
-        if (false == m_registry.append(entry))
-        {
-            LOG_ERROR("Couldn't add %s to registry.", name.c_str());
-
-            delete entry;
-            entry = nullptr;
-        }
-        else
-        {
-            LOG_INFO("Plugin %s registered.", name.c_str());
-        }
-    }
-    else
-    {
-        LOG_ERROR("Couldn't add %s to registry.", name.c_str());
-    }
-
-    return;
-}
-
 IPluginMaintenance* PluginMgr::install(const String& name, uint8_t slotId)
 {
-    return install(name, generateUID(), slotId);
+    return install(PluginRegistry::findByName(name.c_str()), generateUID(), slotId);
 }
 
 bool PluginMgr::uninstall(IPluginMaintenance* plugin)
@@ -105,7 +77,7 @@ bool PluginMgr::uninstall(IPluginMaintenance* plugin)
 
     if (nullptr != plugin)
     {
-        DLinkedListIterator<IPluginMaintenance*> it(m_plugins);
+        PluginListIterator it(m_plugins);
 
         if (false == it.find(plugin))
         {
@@ -117,8 +89,21 @@ bool PluginMgr::uninstall(IPluginMaintenance* plugin)
 
             if (true == status)
             {
-                plugin->unregisterWebInterface(MyWebServer::getInstance());
+                PluginListIterator pendingIt(m_pendingWeb);
+
+                /* Installed in the current batch, but not registered yet? */
+                if (true == pendingIt.find(plugin))
+                {
+                    pendingIt.remove();
+                }
+                else
+                {
+                    plugin->unregisterWebInterface(PluginWebRouter::getInstance());
+                }
+
                 it.remove();
+
+                notifyChange();
             }
         }
     }
@@ -128,11 +113,15 @@ bool PluginMgr::uninstall(IPluginMaintenance* plugin)
 
 const char* PluginMgr::findFirst()
 {
-    const char* name = nullptr;
+    const char*                     name    = nullptr;
+    const PluginRegistry::Entry*    entry   = nullptr;
+
+    m_registryIndex = 0U;
+    entry           = PluginRegistry::getEntry(m_registryIndex);
 
-    if (true == m_registryIter.first())
+    if (nullptr != entry)
     {
-        name = (*m_registryIter.current())->name.c_str();
+        name = entry->name;
     }
 
     return name;
@@ -140,11 +129,18 @@ const char* PluginMgr::findFirst()
 
 const char* PluginMgr::findNext()
 {
-    const char* name = nullptr;
+    const char*                     name    = nullptr;
+    const PluginRegistry::Entry*    entry   = nullptr;
 
-    if (true == m_registryIter.next())
+    if (PluginRegistry::getNum() > m_registryIndex)
+    {
+        ++m_registryIndex;
+        entry = PluginRegistry::getEntry(m_registryIndex);
+    }
+
+    if (nullptr != entry)
     {
-        name = (*m_registryIter.current())->name.c_str();
+        name = entry->name;
     }
 
     return name;
@@ -162,7 +158,11 @@ String PluginMgr::getRestApiBaseUri(uint16_t uid)
 
 void PluginMgr::load()
 {
-    Settings& settings = Settings::getInstance();
+    Settings&   settings        = Settings::getInstance();
+    bool        isMigrationReq  = false;
+
+    /* All stored plugins are installed at once. */
+    beginBatch();
 
     if (false == settings.open(true))
     {
@@ -170,121 +170,136 @@ void PluginMgr::load()
     }
     else
     {
-        String installation = settings.getPluginInstallation().getValue();
+        uint8_t     maxSlots    = DisplayMgr::getInstance().getMaxSlots();
+        SlotRecord* records     = new SlotRecord[maxSlots];
+        uint8_t     num         = 0U;
+        uint8_t     index       = 0U;
 
-        if (true == installation.isEmpty())
+        if (nullptr == records)
+        {
+            LOG_ERROR("Out of memory.");
+        }
+        else if (false == DisplayMgr::readSlotInstallation(records, maxSlots, num))
         {
-            LOG_WARNING("Plugin installation is empty.");
+            /* Not migrated yet */
+            isMigrationReq = loadLegacy();
         }
         else
         {
-            const size_t            JSON_DOC_SIZE   = 1024U;
-            DynamicJsonDocument     jsonDoc(JSON_DOC_SIZE);
-            DeserializationError    error           = deserializeJson(jsonDoc, installation);
-
-            if (true == jsonDoc.overflowed())
+            for(index = 0U; index < num; ++index)
             {
-                LOG_ERROR("JSON document has less memory available.");
-            }
-            else
-            {
-                LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
-            }
-
-            if (DeserializationError::Ok != error.code())
-            {
-                LOG_WARNING("JSON deserialization failed: %s", error.c_str());
-            }
-            else if (false == jsonDoc["slots"].is<JsonArray>())
-            {
-                LOG_WARNING("Invalid JSON format.");
-            }
-            else
-            {
-                JsonArray   jsonSlots   = jsonDoc["slots"].as<JsonArray>();
-                uint8_t     slotId      = 0;
+                const SlotRecord& record = records[index];
 
-                for(JsonObject jsonSlot: jsonSlots)
+                if (SlotRecord::TYPE_ID_NONE != record.typeId)
                 {
-                    if ((true == jsonSlot["name"].is<String>()) &&
-                        (true == jsonSlot["uid"].is<uint16_t>()))
+                    const PluginRegistry::Entry*    entry   = PluginRegistry::findByTypeId(record.typeId);
+                    IPluginMaintenance*             plugin  = nullptr;
+
+                    if (nullptr == entry)
                     {
-                        String      name    = jsonSlot["name"].as<String>();
-                        uint16_t    uid     = jsonSlot["uid"].as<uint16_t>();
+                        LOG_WARNING("Unknown plugin type 0x%04X (uid %u) in slot %u.", record.typeId, record.uid, record.slotId);
+                    }
+                    else
+                    {
+                        plugin = install(entry, record.uid, record.slotId);
+                    }
 
-                        if (false == name.isEmpty())
+                    if (nullptr == plugin)
+                    {
+                        LOG_WARNING("Couldn't install plugin (uid %u) in slot %u.", record.uid, record.slotId);
+                    }
+                    else
+                    {
+                        if (true == record.isLocked)
                         {
-                            IPluginMaintenance* plugin = install(name, uid, slotId);
-
-                            if (nullptr == plugin)
-                            {
-                                LOG_WARNING("Couldn't install %s (uid %u) in slot %u.", name.c_str(), uid, slotId);
-                            }
-                            else
-                            {
-                                plugin->enable();
-                            }
+                            DisplayMgr::getInstance().lockSlot(record.slotId);
                         }
 
-                        ++slotId;
-                        if (DisplayMgr::getInstance().getMaxSlots() <= slotId)
-                        {
-                            break;
-                        }
+                        plugin->enable();
                     }
                 }
             }
         }
 
+        delete[] records;
+
         settings.close();
     }
-}
 
-void PluginMgr::save()
-{
-    String              installation;
-    uint8_t             slotId      = 0;
-    Settings&           settings    = Settings::getInstance();
-    const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    JsonArray           jsonSlots   = jsonDoc.createNestedArray("slots");
-
-    for(slotId = 0; slotId < DisplayMgr::getInstance().getMaxSlots(); ++slotId)
+    /* A legacy installation is stored in the binary format, which is used from now on. */
+    endBatch(isMigrationReq);
+
+    if (true == isMigrationReq)
     {
-        IPluginMaintenance* plugin      = DisplayMgr::getInstance().getPluginInSlot(slotId);
-        JsonObject          jsonSlot    = jsonSlots.createNestedObject();
+        LOG_INFO("Plugin installation migrated.");
 
-        if (nullptr == plugin)
-        {
-            jsonSlot["name"]    = "";
-            jsonSlot["uid"]     = 0;
-        }
-        else
-        {
-            jsonSlot["name"]    = plugin->getName();
-            jsonSlot["uid"]     = plugin->getUID();
-        }
+        removeLegacy();
     }
+}
 
-    if (true == jsonDoc.overflowed())
-    {
-        LOG_ERROR("JSON document has less memory available.");
-    }
-    else
+void PluginMgr::save()
+{
+    /* The display manager stores the installed plugins together with the slot configuration. */
+    DisplayMgr::getInstance().save();
+}
+
+void PluginMgr::beginBatch()
+{
+    if (0U == m_batchLevel)
     {
-        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+        m_isBatchChanged = false;
+        m_isBatchPersist = false;
+        m_pendingWeb.clear();
     }
 
-    if (false == settings.open(false))
+    ++m_batchLevel;
+
+    DisplayMgr::getInstance().beginLayoutChange();
+}
+
+void PluginMgr::endBatch(bool persist)
+{
+    if (0U == m_batchLevel)
     {
-        LOG_WARNING("Couldn't open filesystem.");
+        LOG_WARNING("No batch running.");
     }
     else
     {
-        (void)serializeJson(jsonDoc, installation);
+        if (true == persist)
+        {
+            m_isBatchPersist = true;
+        }
 
-        settings.getPluginInstallation().setValue(installation);
-        settings.close();
+        --m_batchLevel;
+
+        DisplayMgr::getInstance().endLayoutChange();
+
+        if (0U == m_batchLevel)
+        {
+            PluginListIterator it(m_pendingWeb);
+
+            /* Register the web interfaces of all installed plugins in one pass. */
+            if (true == it.first())
+            {
+                do
+                {
+                    registerWebInterface(*it.current());
+                }
+                while(true == it.next());
+            }
+
+            m_pendingWeb.clear();
+
+            if (true == m_isBatchChanged)
+            {
+                EventStream::getInstance().notify(EventStream::EVENT_PLUGINS);
+            }
+
+            if (true == m_isBatchPersist)
+            {
+                save();
+            }
+        }
     }
 }
 
@@ -296,61 +311,128 @@ void PluginMgr::save()
  * Private Methods
  *****************************************************************************/
 
-IPluginMaintenance* PluginMgr::install(const String& name, uint16_t uid, uint8_t slotId)
+IPluginMaintenance* PluginMgr::install(const PluginRegistry::Entry* entry, uint16_t uid, uint8_t slotId)
 {
-    IPluginMaintenance*                     plugin  = nullptr;
-    PluginRegEntry*                         entry   = nullptr;
-    DLinkedListIterator<PluginRegEntry*>    it(m_registry);
+    IPluginMaintenance* plugin = nullptr;
 
-    if (true == it.first())
+    if (nullptr != entry)
     {
-        bool isFound = false;
-
-        /* Find plugin in the registry */
-        entry = *it.current();
+        plugin = entry->createFunc(entry->name, uid);
 
-        while((false == isFound) && (nullptr != entry))
+        if (DisplayMgr::SLOT_ID_INVALID == slotId)
         {
-            if (name == entry->name)
+            if (false == installToAutoSlot(plugin))
             {
-                isFound = true;
+                delete plugin;
+                plugin = nullptr;
             }
-            else if (false == it.next())
-            {
-                entry = nullptr;
-            }
-            else
+        }
+        else
+        {
+            if (false == installToSlot(plugin, slotId))
             {
-                entry = *it.current();
+                delete plugin;
+                plugin = nullptr;
             }
         }
 
-        /* Plugin found? */
-        if ((true == isFound) &&
-            (nullptr != entry))
+        if (nullptr != plugin)
         {
-            plugin = entry->createFunc(entry->name, uid);
+            notifyChange();
+        }
+    }
 
-            if (DisplayMgr::SLOT_ID_INVALID == slotId)
-            {
-                if (false == installToAutoSlot(plugin))
-                {
-                    delete plugin;
-                    plugin = nullptr;
-                }
-            }
-            else
+    return plugin;
+}
+
+bool PluginMgr::loadLegacy()
+{
+    bool    isAvailable     = false;
+    String  installation    = Settings::getInstance().getPluginInstallation().getValue();
+
+    if (true == installation.isEmpty())
+    {
+        LOG_WARNING("Plugin installation is empty.");
+    }
+    else
+    {
+        const size_t            JSON_DOC_SIZE   = 1024U;
+        DynamicJsonDocument     jsonDoc(JSON_DOC_SIZE);
+        DeserializationError    error           = deserializeJson(jsonDoc, installation);
+
+        isAvailable = true;
+
+        if (true == jsonDoc.overflowed())
+        {
+            LOG_ERROR("JSON document has less memory available.");
+        }
+        else
+        {
+            LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+        }
+
+        if (DeserializationError::Ok != error.code())
+        {
+            LOG_WARNING("JSON deserialization failed: %s", error.c_str());
+        }
+        else if (false == jsonDoc["slots"].is<JsonArray>())
+        {
+            LOG_WARNING("Invalid JSON format.");
+        }
+        else
+        {
+            JsonArray   jsonSlots   = jsonDoc["slots"].as<JsonArray>();
+            uint8_t     slotId      = 0;
+
+            for(JsonObject jsonSlot: jsonSlots)
             {
-                if (false == installToSlot(plugin, slotId))
+                if ((true == jsonSlot["name"].is<String>()) &&
+                    (true == jsonSlot["uid"].is<uint16_t>()))
                 {
-                    delete plugin;
-                    plugin = nullptr;
+                    String      name    = jsonSlot["name"].as<String>();
+                    uint16_t    uid     = jsonSlot["uid"].as<uint16_t>();
+
+                    if (false == name.isEmpty())
+                    {
+                        IPluginMaintenance* plugin = install(PluginRegistry::findByName(name.c_str()), uid, slotId);
+
+                        if (nullptr == plugin)
+                        {
+                            LOG_WARNING("Couldn't install %s (uid %u) in slot %u.", name.c_str(), uid, slotId);
+                        }
+                        else
+                        {
+                            plugin->enable();
+                        }
+                    }
+
+                    ++slotId;
+                    if (DisplayMgr::getInstance().getMaxSlots() <= slotId)
+                    {
+                        break;
+                    }
                 }
             }
         }
     }
 
-    return plugin;
+    return isAvailable;
+}
+
+void PluginMgr::removeLegacy()
+{
+    Settings& settings = Settings::getInstance();
+
+    if (false == settings.open(false))
+    {
+        LOG_WARNING("Couldn't open filesystem.");
+    }
+    else
+    {
+        settings.getPluginInstallation().setValue("");
+        settings.getDisplaySlotConfig().setValue("");
+        settings.close();
+    }
 }
 
 bool PluginMgr::installToAutoSlot(IPluginMaintenance* plugin)
@@ -373,9 +455,7 @@ bool PluginMgr::installToAutoSlot(IPluginMaintenance* plugin)
             }
             else
             {
-                String baseUri = getRestApiBaseUri(plugin->getUID());
-
-                plugin->registerWebInterface(MyWebServer::getInstance(), baseUri);
+                registerWebInterface(plugin);
 
                 status = true;
             }
@@ -405,9 +485,7 @@ bool PluginMgr::installToSlot(IPluginMaintenance* plugin, uint8_t slotId)
             }
             else
             {
-                String baseUri = getRestApiBaseUri(plugin->getUID());
-
-                plugin->registerWebInterface(MyWebServer::getInstance(), baseUri);
+                registerWebInterface(plugin);
 
                 status = true;
             }
@@ -417,40 +495,50 @@ bool PluginMgr::installToSlot(IPluginMaintenance* plugin, uint8_t slotId)
     return status;
 }
 
-uint16_t PluginMgr::generateUID()
+void PluginMgr::registerWebInterface(IPluginMaintenance* plugin)
 {
-    uint16_t                                        uid;
-    bool                                            isFound;
-    DLinkedListConstIterator<IPluginMaintenance*>   it(m_plugins);
+    bool isDeferred = false;
 
-    do
+    /* During a batch, the web interface is registered at its end. */
+    if (0U < m_batchLevel)
     {
-        isFound = false;
-        uid     = random(UINT16_MAX);
+        isDeferred = m_pendingWeb.append(plugin);
+    }
 
-        /* Ensure that UID is really unique. */
-        if (true == it.first())
-        {
-            const IPluginMaintenance* plugin = *it.current();
+    if (false == isDeferred)
+    {
+        String baseUri = getRestApiBaseUri(plugin->getUID());
 
-            while((false == isFound) && (nullptr != plugin))
-            {
-                if (uid == plugin->getUID())
-                {
-                    isFound = true;
-                }
-                else if (false == it.next())
-                {
-                    plugin = nullptr;
-                }
-                else
-                {
-                    plugin = *it.current();
-                }
-            }
-        }
+        plugin->registerWebInterface(PluginWebRouter::getInstance(), baseUri);
+    }
+}
+
+void PluginMgr::notifyChange()
+{
+    /* During a batch, the change is notified at its end. */
+    if (0U < m_batchLevel)
+    {
+        m_isBatchChanged = true;
+    }
+    else
+    {
+        EventStream::getInstance().notify(EventStream::EVENT_PLUGINS);
+    }
+}
+
+uint16_t PluginMgr::generateUID()
+{
+    uint16_t    uid         = 0U;
+    DisplayMgr& displayMgr  = DisplayMgr::getInstance();
+
+    /* Ensure that UID is really unique. Every managed plugin is installed in
+     * a slot, therefore the slot index of the display manager is used.
+     */
+    do
+    {
+        uid = random(UINT16_MAX);
     }
-    while(true == isFound);
+    while(DisplayMgr::SLOT_ID_INVALID != displayMgr.getSlotIdByPluginUID(uid));
 
     return uid;
 }
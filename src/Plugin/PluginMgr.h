@@ -46,8 +46,10 @@
 #include <stdint.h>
 #include "IPluginMaintenance.hpp"
 #include "DisplayMgr.h"
+#include "PluginRegistry.h"
 
-#include <LinkedList.hpp>
+#include <FixedList.hpp>
+#include <SlotRecord.h>
 
 /******************************************************************************
  * Macros
@@ -77,14 +79,6 @@ public:
         return instance;
     }
 
-    /**
-     * Register a plugin.
-     *
-     * @param[in] name          Plugin name
-     * @param[in] createFunc    The plugin creation function.
-     */
-    void registerPlugin(const String& name, IPluginMaintenance::CreateFunc createFunc);
-
     /**
      * Install plugin.
      * If no slot id is given, the plugin will be installed in the next available slot.
@@ -106,14 +100,14 @@ public:
     bool uninstall(IPluginMaintenance* plugin);
 
     /**
-     * Find first plugin.
+     * Find first plugin type in the plugin registry.
      *
      * @return If plugin found, it will return its name otherwise nullptr.
      */
     const char* findFirst();
 
     /**
-     * Find next plugin.
+     * Find next plugin type in the plugin registry.
      *
      * @return If plugin found, it will return its name otherwise nullptr.
      */
@@ -131,7 +125,10 @@ public:
     /**
      * Load plugin installation from persistent memory.
      * It will automatically enable the installed plugins.
+     * All plugins are installed in one batch.
      * If a slot already contains a plugin, this slot won't change.
+     * A plugin installation in the legacy JSON format is migrated to the
+     * binary slot installation.
      */
     void load();
 
@@ -140,30 +137,56 @@ public:
      */
     void save();
 
-private:
+    /**
+     * Begin a batch of several plugin installations and uninstallations.
+     * The display is locked for the whole batch. The web interfaces of the
+     * installed plugins are registered and the change is notified only once
+     * at the end. Batches may be nested, but must be called by the same task.
+     * Call endBatch() afterwards.
+     */
+    void beginBatch();
 
     /**
-     * Plugin registry entry.
+     * End a batch of plugin installations and uninstallations.
+     * Ending the outermost batch registers the web interfaces of the
+     * installed plugins, notifies the change and optional saves the plugin
+     * installation once to persistent memory.
+     *
+     * @param[in] persist   Save plugin installation to persistent memory (default: true)
      */
-    struct PluginRegEntry
-    {
-        String                          name;       /**< Plugin name */
-        IPluginMaintenance::CreateFunc  createFunc; /**< Plugin creation function */
-    };
+    void endBatch(bool persist = true);
+
+private:
+
+    /** Max. number of installed plugins. It is limited by the max. number of slots. */
+    static const uint32_t   MAX_PLUGINS             = 16U;
+
+    /** List of installed plugins */
+    typedef FixedList<IPluginMaintenance*, MAX_PLUGINS> PluginList;
+
+    /** Iterator over the installed plugins */
+    typedef FixedListIterator<IPluginMaintenance*, MAX_PLUGINS> PluginListIterator;
+
+    /** Const iterator over the installed plugins */
+    typedef FixedListConstIterator<IPluginMaintenance*, MAX_PLUGINS> PluginListConstIterator;
 
-    DLinkedList<PluginRegEntry*>            m_registry;     /**< Plugin registry */
-    DLinkedListIterator<PluginRegEntry*>    m_registryIter; /**< Plugin registry iterator. Exclusive use in findFirst() and findNext()! */
-    DLinkedList<IPluginMaintenance*>        m_plugins;      /**< List with all installed plugins */
-    PluginRegEntry*                         m_current;      /**< Current registry entry */
+    uint8_t                                 m_registryIndex;    /**< Plugin registry index. Exclusive use in findFirst() and findNext()! */
+    PluginList                              m_plugins;          /**< List with all installed plugins */
+    uint8_t                                 m_batchLevel;       /**< Nesting level of the current batch, 0 if no batch is running. */
+    bool                                    m_isBatchChanged;   /**< Any plugin installed or uninstalled during the current batch? */
+    bool                                    m_isBatchPersist;   /**< Save plugin installation at the end of the current batch? */
+    PluginList                              m_pendingWeb;       /**< Plugins, installed during the current batch, whose web interface is not registered yet. */
 
     /**
      * Constructs the plugin manager.
      */
     PluginMgr() :
-        m_registry(),
-        m_registryIter(m_registry),
+        m_registryIndex(0U),
         m_plugins(),
-        m_current(nullptr)
+        m_batchLevel(0U),
+        m_isBatchChanged(false),
+        m_isBatchPersist(false),
+        m_pendingWeb()
     {
     }
 
@@ -181,13 +204,27 @@ private:
     /**
      * Create plugin with given UID and install it to the given slot.
      *
-     * @param[in] name      Plugin name
+     * @param[in] entry     Plugin registry entry
      * @param[in] uid       Plugin UID
      * @param[in] slotId    Slot id
      *
      * @return If successful, it will return a pointer to the plugin instance, otherwise nullptr.
      */
-    IPluginMaintenance* install(const String& name, uint16_t uid, uint8_t slotId);
+    IPluginMaintenance* install(const PluginRegistry::Entry* entry, uint16_t uid, uint8_t slotId);
+
+    /**
+     * Load plugin installation from persistent memory in the legacy JSON format.
+     * The persistent memory must be opened before.
+     *
+     * @return If a legacy plugin installation is available, it will return true otherwise false.
+     */
+    bool loadLegacy();
+
+    /**
+     * Remove the legacy JSON plugin installation and slot configuration,
+     * after they were migrated to the slot installation.
+     */
+    void removeLegacy();
 
     /**
      * Install plugin to any available display slot.
@@ -208,6 +245,20 @@ private:
      */
     bool installToSlot(IPluginMaintenance* plugin, uint8_t slotId);
 
+    /**
+     * Register the web interface of the plugin.
+     * During a batch the registration is deferred to its end.
+     *
+     * @param[in] plugin    Plugin
+     */
+    void registerWebInterface(IPluginMaintenance* plugin);
+
+    /**
+     * Notify that the installed plugins changed.
+     * During a batch the notification is deferred to its end.
+     */
+    void notifyChange();
+
     /**
      * Generate a 16-bit unique id, for a plugin instance.
      *
@@ -0,0 +1,226 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin registry
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PluginRegistry.h"
+
+#include <SlotRecord.h>
+#include <Util.h>
+#include <string.h>
+
+#include "CountdownPlugin.h"
+#include "DatePlugin.h"
+#include "DateTimePlugin.h"
+#include "FirePlugin.h"
+#include "GameOfLifePlugin.h"
+#include "GruenbeckPlugin.h"
+#include "IconTextLampPlugin.h"
+#include "IconTextPlugin.h"
+#include "JustTextPlugin.h"
+#include "RainbowPlugin.h"
+#include "RemoteFramePlugin.h"
+#include "ShellyPlugSPlugin.h"
+#include "SpectrumPlugin.h"
+#include "StreamPlugin.h"
+#include "SunrisePlugin.h"
+#include "SysMsgPlugin.h"
+#include "TestPlugin.h"
+#include "TimePlugin.h"
+#include "VolumioPlugin.h"
+#include "VuMeterPlugin.h"
+#include "WifiStatusPlugin.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/**
+ * Create a registry entry for the given plugin type. The plugin name is
+ * the name of its class.
+ *
+ * @param[in] _type Plugin class
+ */
+#define PLUGIN_REGISTRY_ENTRY(_type)    { #_type, SlotRecord::getTypeId(#_type), _type::create }
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static constexpr bool isTypeIdUnique(uint8_t index, uint8_t other);
+static constexpr bool areTypeIdsUnique(uint8_t index);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** All available plugin types in alphabetic order. */
+static constexpr PluginRegistry::Entry  gRegistry[] =
+{
+    PLUGIN_REGISTRY_ENTRY(CountdownPlugin),
+    PLUGIN_REGISTRY_ENTRY(DatePlugin),
+    PLUGIN_REGISTRY_ENTRY(DateTimePlugin),
+    PLUGIN_REGISTRY_ENTRY(FirePlugin),
+    PLUGIN_REGISTRY_ENTRY(GameOfLifePlugin),
+    PLUGIN_REGISTRY_ENTRY(GruenbeckPlugin),
+    PLUGIN_REGISTRY_ENTRY(IconTextLampPlugin),
+    PLUGIN_REGISTRY_ENTRY(IconTextPlugin),
+    PLUGIN_REGISTRY_ENTRY(JustTextPlugin),
+    PLUGIN_REGISTRY_ENTRY(RainbowPlugin),
+    PLUGIN_REGISTRY_ENTRY(RemoteFramePlugin),
+    PLUGIN_REGISTRY_ENTRY(ShellyPlugSPlugin),
+    PLUGIN_REGISTRY_ENTRY(SpectrumPlugin),
+    PLUGIN_REGISTRY_ENTRY(StreamPlugin),
+    PLUGIN_REGISTRY_ENTRY(SunrisePlugin),
+    PLUGIN_REGISTRY_ENTRY(SysMsgPlugin),
+    PLUGIN_REGISTRY_ENTRY(TestPlugin),
+    PLUGIN_REGISTRY_ENTRY(TimePlugin),
+    PLUGIN_REGISTRY_ENTRY(VolumioPlugin),
+    PLUGIN_REGISTRY_ENTRY(VuMeterPlugin),
+    PLUGIN_REGISTRY_ENTRY(WifiStatusPlugin)
+};
+
+/** Number of plugin types in the registry. */
+static constexpr uint8_t                gRegistryNum = UTIL_ARRAY_NUM(gRegistry);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+uint8_t PluginRegistry::getNum()
+{
+    return gRegistryNum;
+}
+
+const PluginRegistry::Entry* PluginRegistry::getEntry(uint8_t index)
+{
+    const Entry* entry = nullptr;
+
+    if (gRegistryNum > index)
+    {
+        entry = &gRegistry[index];
+    }
+
+    return entry;
+}
+
+const PluginRegistry::Entry* PluginRegistry::findByName(const char* name)
+{
+    const Entry* entry = nullptr;
+
+    if (nullptr != name)
+    {
+        entry = findByTypeId(SlotRecord::getTypeId(name));
+
+        /* Different names may have the same type id. */
+        if ((nullptr != entry) &&
+            (0 != strcmp(entry->name, name)))
+        {
+            entry = nullptr;
+        }
+    }
+
+    return entry;
+}
+
+const PluginRegistry::Entry* PluginRegistry::findByTypeId(uint16_t typeId)
+{
+    const Entry*    entry   = nullptr;
+    uint8_t         index   = 0U;
+
+    while((gRegistryNum > index) && (nullptr == entry))
+    {
+        if (typeId == gRegistry[index].typeId)
+        {
+            entry = &gRegistry[index];
+        }
+
+        ++index;
+    }
+
+    return entry;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Is the type id of a registry entry unique in the rest of the registry?
+ *
+ * @param[in] index Index of the registry entry
+ * @param[in] other Index of the first registry entry to compare with
+ *
+ * @return If unique, it will return true otherwise false.
+ */
+static constexpr bool isTypeIdUnique(uint8_t index, uint8_t other)
+{
+    return (gRegistryNum <= other) ? true :
+        ((gRegistry[index].typeId == gRegistry[other].typeId) ? false : isTypeIdUnique(index, other + 1U));
+}
+
+/**
+ * Are the type ids of all registry entries, starting at the given index, unique?
+ *
+ * @param[in] index Index of the first registry entry
+ *
+ * @return If unique, it will return true otherwise false.
+ */
+static constexpr bool areTypeIdsUnique(uint8_t index)
+{
+    return (gRegistryNum <= index) ? true :
+        ((true == isTypeIdUnique(index, index + 1U)) && (true == areTypeIdsUnique(index + 1U)));
+}
+
+/* The type id identifies the plugin in the persistent slot installation. */
+static_assert(true == areTypeIdsUnique(0U), "Plugin type ids are not unique.");
@@ -0,0 +1,117 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin registry
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __PLUGINREGISTRY_H__
+#define __PLUGINREGISTRY_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "IPluginMaintenance.hpp"
+
+/**
+ * The plugin registry contains all available plugin types. It is a constant
+ * table, which is created at compile time and located in flash.
+ */
+namespace PluginRegistry
+{
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Plugin registry entry.
+ */
+struct Entry
+{
+    const char*                     name;       /**< Plugin name */
+    uint16_t                        typeId;     /**< Plugin type id, derived from the name. See SlotRecord::getTypeId(). */
+    IPluginMaintenance::CreateFunc  createFunc; /**< Plugin creation function */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get number of registered plugin types.
+ *
+ * @return Number of plugin types
+ */
+uint8_t getNum();
+
+/**
+ * Get registry entry by its index.
+ *
+ * @param[in] index Index [0; getNum() - 1]
+ *
+ * @return If available, it will return the registry entry otherwise nullptr.
+ */
+const Entry* getEntry(uint8_t index);
+
+/**
+ * Find registry entry by plugin name.
+ *
+ * @param[in] name  Plugin name
+ *
+ * @return If found, it will return the registry entry otherwise nullptr.
+ */
+const Entry* findByName(const char* name);
+
+/**
+ * Find registry entry by plugin type id.
+ *
+ * @param[in] typeId    Plugin type id
+ *
+ * @return If found, it will return the registry entry otherwise nullptr.
+ */
+const Entry* findByTypeId(uint16_t typeId);
+
+}
+
+#endif  /* __PLUGINREGISTRY_H__ */
+
+/** @} */
\ No newline at end of file
@@ -37,10 +37,11 @@
 #include "RestApi.h"
 #include "Util.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "ConfigStore.h"
 
 #include <ArduinoJson.h>
 #include <Logging.h>
-#include <JsonFile.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -65,14 +66,11 @@
 /* Initialize image path. */
 const char* CountdownPlugin::IMAGE_PATH     = "/images/countdown.bmp";
 
-/* Initialize configuration path. */
-const char* CountdownPlugin::CONFIG_PATH    = "/configuration";
-
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-void CountdownPlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void CountdownPlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_url = baseUri + "/countdown";
 
@@ -87,7 +85,7 @@ void CountdownPlugin::registerWebInterface(AsyncWebServer& srv, const String& ba
     return;
 }
 
-void CountdownPlugin::unregisterWebInterface(AsyncWebServer& srv)
+void CountdownPlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_url.c_str());
 
@@ -101,32 +99,55 @@ void CountdownPlugin::unregisterWebInterface(AsyncWebServer& srv)
     return;
 }
 
-void CountdownPlugin::active(IGfx& gfx)
+void CountdownPlugin::prepare()
 {
     lock();
 
-    if (nullptr == m_iconCanvas)
+    /* Check for a uploaded configuration file only, if any file changed
+     * since the last check. The remaining days are always calculated again.
+     */
+    if (FileIo::getInstance().getGeneration() != m_cfgGeneration)
     {
-        m_iconCanvas = new Canvas(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+        m_cfgGeneration = FileIo::getInstance().getGeneration();
 
-        if (nullptr != m_iconCanvas)
+        if (true == ConfigStore::getInstance().importFile(getUID(), m_configurationFilename))
         {
-            (void)m_iconCanvas->addWidget(m_bitmapWidget);
-
-            /* Load  icon from filesystem. */
-            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
+            (void)loadConfiguration();
         }
     }
 
-    if (nullptr == m_textCanvas)
-    {
-        m_textCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, gfx.getHeight(), ICON_WIDTH, 0);
+    calculateDifferenceInDays();
 
-        if (nullptr != m_textCanvas)
-        {
-            (void)m_textCanvas->addWidget(m_textWidget);
-        }
-    }
+    loadIcon();
+
+    unlock();
+
+    return;
+}
+
+void CountdownPlugin::releaseAssets()
+{
+    lock();
+
+    m_bitmapWidget.clear();
+    m_isIconLoaded = false;
+
+    unlock();
+
+    return;
+}
+
+void CountdownPlugin::active(IGfx& gfx)
+{
+    lock();
+
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* The display was cleared, therefore everything must be drawn again. */
+    m_bitmapWidget.invalidate();
+    m_textWidget.invalidate();
+
+    loadIcon();
 
     unlock();
 
@@ -141,28 +162,24 @@ void CountdownPlugin::inactive()
 
 void CountdownPlugin::update(IGfx& gfx)
 {
+    CanvasView  iconView(gfx, 0, 0, ICON_WIDTH, ICON_HEIGHT);
+    CanvasView  textView(gfx, ICON_WIDTH, 0, gfx.getWidth() - ICON_WIDTH, gfx.getHeight());
+
     lock();
 
-    if ((true == m_cfgReloadTimer.isTimerRunning()) &&
-        (true == m_cfgReloadTimer.isTimeout()))
+    /* The configuration is reloaded by prepare() if changed, only the day
+     * change needs to be considered here. No filesystem access is necessary.
+     */
+    if ((true == m_dayCheckTimer.isTimerRunning()) &&
+        (true == m_dayCheckTimer.isTimeout()))
     {
-        (void)loadConfiguration();
         calculateDifferenceInDays();
 
-        m_cfgReloadTimer.restart();
+        m_dayCheckTimer.restart();
     }
 
-    gfx.fillScreen(ColorDef::BLACK);
-
-    if (nullptr != m_iconCanvas)
-    {
-        m_iconCanvas->update(gfx);
-    }
-
-    if (nullptr != m_textCanvas)
-    {
-        m_textCanvas->update(gfx);
-    }
+    (void)iconView.drawWidget(m_bitmapWidget);
+    (void)textView.drawWidget(m_textWidget);
 
     unlock();
 
@@ -173,23 +190,23 @@ void CountdownPlugin::start()
 {
     lock();
 
-    m_configurationFilename = String(CONFIG_PATH) + "/" + getUID() + ".json";
+    m_configurationFilename = String(ConfigStore::IMPORT_PATH) + "/" + getUID() + ".json";
 
     /* Try to load configuration. If there is no configuration available, a default configuration
      * will be created.
      */
-    createConfigDirectory();
+    m_cfgGeneration = FileIo::getInstance().getGeneration();
     if (false == loadConfiguration())
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", m_configurationFilename.c_str());
+            LOG_WARNING("Failed to create initial configuration.");
         }
     }
 
     calculateDifferenceInDays();
 
-    m_cfgReloadTimer.start(CFG_RELOAD_PERIOD);
+    m_dayCheckTimer.start(DAY_CHECK_PERIOD);
 
     unlock();
 
@@ -200,12 +217,9 @@ void CountdownPlugin::stop()
 {
     lock();
 
-    m_cfgReloadTimer.stop();
+    m_dayCheckTimer.stop();
 
-    if (false != FILESYSTEM.remove(m_configurationFilename))
-    {
-        LOG_INFO("File %s removed", m_configurationFilename.c_str());
-    }
+    ConfigStore::getInstance().remove(getUID());
 
     unlock();
 
@@ -241,6 +255,8 @@ void CountdownPlugin::setTargetDate(const DateDMY& targetDate)
          * plugin activation.
          */
         (void)saveConfiguration();
+
+        calculateDifferenceInDays();
     }
 
     unlock();
@@ -276,6 +292,8 @@ void CountdownPlugin::setTargetDayDescription(const TargetDayDescription& target
          * plugin activation.
          */
         (void)saveConfiguration();
+
+        calculateDifferenceInDays();
     }
 
     unlock();
@@ -291,9 +309,18 @@ void CountdownPlugin::setTargetDayDescription(const TargetDayDescription& target
  * Private Methods
  *****************************************************************************/
 
+void CountdownPlugin::loadIcon()
+{
+    if (false == m_isIconLoaded)
+    {
+        m_isIconLoaded = m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
+    }
+
+    return;
+}
+
 void CountdownPlugin::webReqHandler(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -411,8 +438,7 @@ void CountdownPlugin::webReqHandler(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -420,7 +446,6 @@ void CountdownPlugin::webReqHandler(AsyncWebServerRequest *request)
 bool CountdownPlugin::saveConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
@@ -430,14 +455,14 @@ bool CountdownPlugin::saveConfiguration()
     jsonDoc["descriptionPlural"]    = m_targetDateInformation.plural;
     jsonDoc["descriptionSingular"]  = m_targetDateInformation.singular;
     
-    if (false == jsonFile.save(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration.");
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", m_configurationFilename.c_str());
+        LOG_INFO("Configuration saved.");
     }
 
     return status;
@@ -446,13 +471,12 @@ bool CountdownPlugin::saveConfiguration()
 bool CountdownPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    if (false == jsonFile.load(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration.");
         status = false;
     }
     else
@@ -467,17 +491,6 @@ bool CountdownPlugin::loadConfiguration()
     return status;
 }
 
-void CountdownPlugin::createConfigDirectory()
-{
-    if (false == FILESYSTEM.exists(CONFIG_PATH))
-    {
-        if (false == FILESYSTEM.mkdir(CONFIG_PATH))
-        {
-            LOG_WARNING("Couldn't create directory: %s", CONFIG_PATH);
-        }
-    }
-}
-
 void CountdownPlugin::calculateDifferenceInDays()
 {
     tm currentTime;
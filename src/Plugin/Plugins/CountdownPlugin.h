@@ -47,7 +47,7 @@
 #include "Plugin.hpp"
 #include "time.h"
 
-#include <Canvas.h>
+#include <CanvasView.hpp>
 #include <BitmapWidget.h>
 #include <stdint.h>
 #include <TextWidget.h>
@@ -176,11 +176,11 @@ public:
      */
     CountdownPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_textCanvas(nullptr),
-        m_iconCanvas(nullptr),
+        m_isIconLoaded(false),
         m_bitmapWidget(),
         m_textWidget("\\calign?"),
         m_configurationFilename(""),
+        m_cfgGeneration(0U),
         m_currentDate(),
         m_targetDate(),
         m_targetDateInformation(),
@@ -188,7 +188,7 @@ public:
         m_url(),
         m_callbackWebHandler(nullptr),
         m_xMutex(nullptr),
-        m_cfgReloadTimer()
+        m_dayCheckTimer()
     {
         /* Example data, used to generate the very first configuration file. */
         m_targetDate.day                    = 29;
@@ -208,18 +208,6 @@ public:
      */
     ~CountdownPlugin()
     {
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
-
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
-
         if (nullptr != m_xMutex)
         {
             vSemaphoreDelete(m_xMutex);
@@ -243,17 +231,29 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void unregisterWebInterface(PluginWebRouter& srv) final;
+
+    /**
+     * Prepare the plugin to be set active soon. It loads the icon from
+     * filesystem, so it is not necessary during the slot change anymore.
+     */
+    void prepare() final;
+
+    /**
+     * Release the icon, because the heap runs low. It is loaded again by
+     * prepare() or active().
+     */
+    void releaseAssets() final;
 
     /**
      * This method will be called in case the plugin is set active, which means
@@ -334,11 +334,6 @@ private:
      */
     static const char*      IMAGE_PATH;
 
-    /**
-     * Configuration path within the filesystem.
-     */
-    static const char*      CONFIG_PATH;
-
    /**
     * Offset to translate the month of the tm struct (time.h)
     * to a human readable value, since months since January are used (0-11).
@@ -352,17 +347,17 @@ private:
     static const int16_t    TM_OFFSET_YEAR  = 1900;
 
     /**
-     * The configuration in the persistent memory shall be cyclic loaded.
-     * This mechanism ensure that manual changes in the file are considered.
-     * This is the reload period in ms.
+     * The remaining days are cyclic calculated again, to consider the day
+     * change. This is the check period in ms. Manual changes in the
+     * configuration file are considered by prepare() instead.
      */
-    static const uint32_t   CFG_RELOAD_PERIOD   = 30000U;
+    static const uint32_t   DAY_CHECK_PERIOD    = 30000U;
 
-    Canvas*                     m_textCanvas;               /**< Canvas used for the text widget. */
-    Canvas*                     m_iconCanvas;               /**< Canvas used for the bitmap widget. */
+    bool                        m_isIconLoaded;             /**< Is the icon loaded from filesystem? */
     BitmapWidget                m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
     TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. */
-    String                      m_configurationFilename;    /**< String used for specifying the configuration filename. */
+    String                      m_configurationFilename;    /**< Name of the configuration file, which is imported if uploaded. */
+    uint32_t                    m_cfgGeneration;            /**< Filesystem generation of the last import check. */
     DateDMY                     m_currentDate;              /**< Date structure to hold the current date. */
     DateDMY                     m_targetDate;               /**< Date structure to hold the target date from the configuration data. */
     TargetDayDescription        m_targetDateInformation;    /**< String used for configured additional target date information. */
@@ -370,7 +365,7 @@ private:
     String                      m_url;                      /**< REST API URL */
     AsyncCallbackWebHandler*    m_callbackWebHandler;       /**< Callback web handler */
     SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
-    SimpleTimer                 m_cfgReloadTimer;           /**< Timer is used to cyclic reload the configuration from persistent memory. */
+    SimpleTimer                 m_dayCheckTimer;            /**< Timer is used to cyclic check for a day change. */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -381,21 +376,15 @@ private:
     void webReqHandler(AsyncWebServerRequest *request);
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the configuration store.
      */
     bool saveConfiguration();
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the configuration store.
      */
     bool loadConfiguration();
 
-    /**
-     * If configuration directory doesn't exists, it will be created.
-     * Otherwise nothing happens.
-     */
-    void createConfigDirectory();
-
     /**
      * Calculates the difference between m_targetTime and m_currentTime in days.
      */
@@ -419,6 +408,12 @@ private:
      */
     uint32_t dateToDays(const DateDMY& date) const;
 
+    /**
+     * Load the icon from filesystem, if not already done.
+     * The plugin must be locked before.
+     */
+    void loadIcon();
+
     /**
      * Protect against concurrent access.
      */
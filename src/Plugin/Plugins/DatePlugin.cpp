@@ -73,11 +73,11 @@
  * Public Methods
  *****************************************************************************/
 
-void DatePlugin::active(IGfx& gfx)
+void DatePlugin::start()
 {
     if (nullptr == m_textCanvas)
     {
-        m_textCanvas = new Canvas(gfx.getWidth(), gfx.getHeight() - 2U, 0, 0);
+        m_textCanvas = createResource<Canvas>(DISPLAY_WIDTH, DISPLAY_HEIGHT - 2U, 0, 0);
 
         if (nullptr != m_textCanvas)
         {
@@ -87,7 +87,7 @@ void DatePlugin::active(IGfx& gfx)
 
     if (nullptr == m_lampCanvas)
     {
-        m_lampCanvas = new Canvas(gfx.getWidth(), 1U, 1, gfx.getHeight() - 1);
+        m_lampCanvas = createResource<Canvas>(DISPLAY_WIDTH, 1U, 1, DISPLAY_HEIGHT - 1);
 
         if (nullptr != m_lampCanvas)
         {
@@ -108,9 +108,25 @@ void DatePlugin::active(IGfx& gfx)
         }
     }
 
-    m_isUpdateAvailable = true;
+    return;
+}
+
+void DatePlugin::active(IGfx& gfx)
+{
+    gfx.fillScreen(ColorDef::BLACK);
 
-    m_checkDateUpdateTimer.start(CHECK_DATE_UPDATE_PERIOD);
+    /* The display was cleared, therefore everything must be drawn again. */
+    if (nullptr != m_textCanvas)
+    {
+        m_textCanvas->invalidate();
+    }
+
+    if (nullptr != m_lampCanvas)
+    {
+        m_lampCanvas->invalidate();
+    }
+
+    m_isUpdateAvailable = true;
 
     /* Force immediate date update on activation */
     updateDate(true);
@@ -118,7 +134,7 @@ void DatePlugin::active(IGfx& gfx)
 
 void DatePlugin::inactive()
 {
-    m_checkDateUpdateTimer.stop();
+    m_updateTimer.stop();
 
     return;
 }
@@ -127,8 +143,6 @@ void DatePlugin::update(IGfx& gfx)
 {
     if (false != m_isUpdateAvailable)
     {
-        gfx.fillScreen(ColorDef::BLACK);
-
         if (nullptr != m_textCanvas)
         {
             m_textCanvas->update(gfx);
@@ -145,14 +159,32 @@ void DatePlugin::update(IGfx& gfx)
     return;
 }
 
-void DatePlugin::process()
+uint32_t DatePlugin::getTimeToNextUpdate() const
 {
-    if ((true == m_checkDateUpdateTimer.isTimerRunning()) &&
-        (true == m_checkDateUpdateTimer.isTimeout()))
+    uint32_t timeToNextUpdate = UPDATE_ALWAYS;
+
+    /* The shown date is valid till the next minute boundary. Until the
+     * timer is notified, at least 1 ms is left.
+     */
+    if ((false == m_isUpdateAvailable) &&
+        (true == m_updateTimer.isTimerRunning()))
     {
-        updateDate(false);
+        timeToNextUpdate = m_updateTimer.getRemaining();
+
+        if (UPDATE_ALWAYS == timeToNextUpdate)
+        {
+            timeToNextUpdate = 1U;
+        }
+    }
 
-        m_checkDateUpdateTimer.restart();
+    return timeToNextUpdate;
+}
+
+void DatePlugin::onTimeout(EventTimer& timer)
+{
+    if (&m_updateTimer == &timer)
+    {
+        updateDate(false);
     }
 
     return;
@@ -186,9 +218,13 @@ void DatePlugin::setLamp(uint8_t lampId, bool state)
 void DatePlugin::updateDate(bool force)
 {
     struct tm   timeinfo = {0};
+    uint32_t    boundary = ClockDrv::BOUNDARY_SECOND;
 
     if (true == ClockDrv::getInstance().getTime(&timeinfo))
     {
+        /* The day changes at a minute boundary, even with daylight saving. */
+        boundary = ClockDrv::BOUNDARY_MINUTE;
+
         if ((m_currentDay != timeinfo.tm_mday) ||
             (true == force))
         {
@@ -213,6 +249,9 @@ void DatePlugin::updateDate(bool force)
             m_isUpdateAvailable = true;
         }
     }
+
+    /* Without synchronized time, its checked every second. */
+    m_updateTimer.start(ClockDrv::getInstance().getTimeToNextBoundary(boundary));
 }
 
 /******************************************************************************
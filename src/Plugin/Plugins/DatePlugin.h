@@ -50,6 +50,7 @@
 #include <LampWidget.h>
 #include <TextWidget.h>
 #include <Canvas.h>
+#include <EventTimer.hpp>
 
 /******************************************************************************
  * Macros
@@ -61,9 +62,10 @@
 
 /**
  * Shows the current data over the whole display.
- *
+ * The date is checked at the minute boundaries only. In between the
+ * plugin declares no change, which skips its update.
  */
-class DatePlugin : public Plugin
+class DatePlugin : public Plugin, public ITimerListener
 {
 public:
 
@@ -79,7 +81,7 @@ public:
         m_textCanvas(nullptr),
         m_lampCanvas(nullptr),
         m_lampWidgets(),
-        m_checkDateUpdateTimer(),
+        m_updateTimer(*this),
         m_currentDay(0),
         m_isUpdateAvailable(false)
 
@@ -93,17 +95,8 @@ public:
      */
     ~DatePlugin()
     {
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
-
-        if (nullptr != m_lampCanvas)
-        {
-            delete m_lampCanvas;
-            m_lampCanvas = nullptr;
-        }
+        destroyResource(m_textCanvas);
+        destroyResource(m_lampCanvas);
     }
 
     /**
@@ -119,6 +112,12 @@ public:
         return new DatePlugin(name, uid);
     }
 
+    /**
+     * Start the plugin.
+     * The canvases are created once here, so the activation allocates nothing.
+     */
+    void start() final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -142,11 +141,18 @@ public:
     void update(IGfx& gfx) final;
     
     /**
-     * Process the plugin.
-     * Overwrite it if your plugin has cyclic stuff to do without being in a
-     * active slot.
+     * Get the time in ms, until the plugin content changes next.
+     *
+     * @return Time to next update in ms or UPDATE_ALWAYS
+     */
+    uint32_t getTimeToNextUpdate() const final;
+
+    /**
+     * Will be called by the timer service, if the update timer timed out.
+     *
+     * @param[in] timer Event timer, which timed out
      */
-    void process(void) final;
+    void onTimeout(EventTimer& timer) final;
 
     /**
      * Set text, which may contain format tags.
@@ -171,14 +177,11 @@ private:
     /** Size of lamp widgets used for weekday indication. */
     static const uint16_t   CUSTOM_LAMP_WIDTH           = 3;
 
-    /** Time to check date update period in ms */
-    static const uint32_t   CHECK_DATE_UPDATE_PERIOD    = 1000U;
-
     TextWidget  m_textWidget;               /**< Text widget, used for showing the text. */
     Canvas*     m_textCanvas;               /**< Canvas used for the text widget. */
     Canvas*     m_lampCanvas;               /**< Canvas used for the lamp widget. */
     LampWidget  m_lampWidgets[MAX_LAMPS];   /**< Lamp widgets, used to signal the day of week. */
-    SimpleTimer m_checkDateUpdateTimer;     /**< Timer, used for cyclic check if date update is necessarry. */
+    EventTimer  m_updateTimer;              /**< Timer, which times out at the next minute boundary. */
     int32_t     m_currentDay;               /**< Variable to hold the current day. */
     bool        m_isUpdateAvailable;        /**< Flag to indicate an updated date value. */
 
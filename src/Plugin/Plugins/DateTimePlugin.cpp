@@ -89,11 +89,11 @@ void DateTimePlugin::setSlot(const ISlotPlugin* slotInterf)
     return;
 }
 
-void DateTimePlugin::active(IGfx& gfx)
+void DateTimePlugin::start()
 {
     if (nullptr == m_textCanvas)
     {
-        m_textCanvas = new Canvas(gfx.getWidth(), gfx.getHeight() - 2, 0, 0);
+        m_textCanvas = createResource<Canvas>(DISPLAY_WIDTH, DISPLAY_HEIGHT - 2, 0, 0);
 
         if (nullptr != m_textCanvas)
         {
@@ -103,7 +103,7 @@ void DateTimePlugin::active(IGfx& gfx)
 
     if (nullptr == m_lampCanvas)
     {
-        m_lampCanvas = new Canvas(gfx.getWidth(), 1U, 1, gfx.getHeight() - 1);
+        m_lampCanvas = createResource<Canvas>(DISPLAY_WIDTH, 1U, 1, DISPLAY_HEIGHT - 1);
 
         if (nullptr != m_lampCanvas)
         {
@@ -124,19 +124,35 @@ void DateTimePlugin::active(IGfx& gfx)
         }
     }
 
+    return;
+}
+
+void DateTimePlugin::active(IGfx& gfx)
+{
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* The display was cleared, therefore everything must be drawn again. */
+    if (nullptr != m_textCanvas)
+    {
+        m_textCanvas->invalidate();
+    }
+
+    if (nullptr != m_lampCanvas)
+    {
+        m_lampCanvas->invalidate();
+    }
+
     m_isUpdateAvailable = true;
 
     m_durationCounter = 0U;
 
-    m_checkUpdateTimer.start(CHECK_UPDATE_PERIOD);
-
     /* Force immediate date/time update on activation */
     updateDateTime(true);
 }
 
 void DateTimePlugin::inactive()
 {
-    m_checkUpdateTimer.stop();
+    m_updateTimer.stop();
 
     return;
 }
@@ -145,8 +161,6 @@ void DateTimePlugin::update(IGfx& gfx)
 {
     if (false != m_isUpdateAvailable)
     {
-        gfx.fillScreen(ColorDef::BLACK);
-
         if (nullptr != m_textCanvas)
         {
             m_textCanvas->update(gfx);
@@ -163,14 +177,32 @@ void DateTimePlugin::update(IGfx& gfx)
     return;
 }
 
-void DateTimePlugin::process()
+uint32_t DateTimePlugin::getTimeToNextUpdate() const
 {
-    if ((true == m_checkUpdateTimer.isTimerRunning()) &&
-        (true == m_checkUpdateTimer.isTimeout()))
+    uint32_t timeToNextUpdate = UPDATE_ALWAYS;
+
+    /* The shown text is valid till the next second boundary. Until the
+     * timer is notified, at least 1 ms is left.
+     */
+    if ((false == m_isUpdateAvailable) &&
+        (true == m_updateTimer.isTimerRunning()))
     {
-        updateDateTime(false);
+        timeToNextUpdate = m_updateTimer.getRemaining();
 
-        m_checkUpdateTimer.restart();
+        if (UPDATE_ALWAYS == timeToNextUpdate)
+        {
+            timeToNextUpdate = 1U;
+        }
+    }
+
+    return timeToNextUpdate;
+}
+
+void DateTimePlugin::onTimeout(EventTimer& timer)
+{
+    if (&m_updateTimer == &timer)
+    {
+        updateDateTime(false);
     }
 
     return;
@@ -263,6 +295,8 @@ void DateTimePlugin::updateDateTime(bool force)
             }
         }
     }
+
+    m_updateTimer.start(ClockDrv::getInstance().getTimeToNextBoundary(ClockDrv::BOUNDARY_SECOND));
 }
 
 /******************************************************************************
@@ -50,6 +50,7 @@
 #include <LampWidget.h>
 #include <TextWidget.h>
 #include <Canvas.h>
+#include <EventTimer.hpp>
 
 /******************************************************************************
  * Macros
@@ -61,9 +62,10 @@
 
 /**
  * Shows the current data and time (alternately) over the whole display.
- *
+ * The text is rebuilt at the second boundaries only. In between the plugin
+ * declares no change, which skips its update.
  */
-class DateTimePlugin : public Plugin
+class DateTimePlugin : public Plugin, public ITimerListener
 {
 public:
 
@@ -79,7 +81,7 @@ public:
         m_textCanvas(nullptr),
         m_lampCanvas(nullptr),
         m_lampWidgets(),
-        m_checkUpdateTimer(),
+        m_updateTimer(*this),
         m_durationCounter(0u),
         m_isUpdateAvailable(false),
         m_slotInterf(nullptr)
@@ -94,17 +96,8 @@ public:
      */
     ~DateTimePlugin()
     {
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
-
-        if (nullptr != m_lampCanvas)
-        {
-            delete m_lampCanvas;
-            m_lampCanvas = nullptr;
-        }
+        destroyResource(m_textCanvas);
+        destroyResource(m_lampCanvas);
     }
 
     /**
@@ -128,6 +121,12 @@ public:
      */
     void setSlot(const ISlotPlugin* slotInterf) final;
 
+    /**
+     * Start the plugin.
+     * The canvases are created once here, so the activation allocates nothing.
+     */
+    void start() final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -151,11 +150,18 @@ public:
     void update(IGfx& gfx) final;
 
     /**
-     * Process the plugin.
-     * Overwrite it if your plugin has cyclic stuff to do without being in a
-     * active slot.
+     * Get the time in ms, until the plugin content changes next.
+     *
+     * @return Time to next update in ms or UPDATE_ALWAYS
+     */
+    uint32_t getTimeToNextUpdate() const final;
+
+    /**
+     * Will be called by the timer service, if the update timer timed out.
+     *
+     * @param[in] timer Event timer, which timed out
      */
-    void process(void) final;
+    void onTimeout(EventTimer& timer) final;
 
     /**
      * Set text, which may contain format tags.
@@ -180,15 +186,12 @@ private:
     /** Size of lamp widgets used for weekday indication. */
     static const uint16_t   CUSTOM_LAMP_WIDTH       = 3U;
 
-    /** Time to check date update period in ms */
-    static const uint32_t   CHECK_UPDATE_PERIOD     = 1000U;
-
     TextWidget          m_textWidget;               /**< Text widget, used for showing the text. */
     Canvas*             m_textCanvas;               /**< Canvas used for the text widget. */
     Canvas*             m_lampCanvas;               /**< Canvas used for the lamp widget. */
     LampWidget          m_lampWidgets[MAX_LAMPS];   /**< Lamp widgets, used to signal the day of week. */
-    SimpleTimer         m_checkUpdateTimer;         /**< Timer, used for cyclic check if date/time update is necessarry. */
-    uint8_t             m_durationCounter;          /**< Variable to count the Plugin duration in CHECK_UPDATE_PERIOD ticks . */
+    EventTimer          m_updateTimer;              /**< Timer, which times out at the next second boundary. */
+    uint8_t             m_durationCounter;          /**< Variable to count the Plugin duration in seconds. */
     bool                m_isUpdateAvailable;        /**< Flag to indicate an updated date value. */
     const ISlotPlugin*  m_slotInterf;               /**< Slot interface */
 
@@ -54,6 +54,23 @@
  * Local Variables
  *****************************************************************************/
 
+/* Heat palette, calculated on first activation of any instance. */
+Gradient    FirePlugin::m_palette;
+bool        FirePlugin::m_isPaletteReady    = false;
+
+/**
+ * Approximates a 'black body radiation' spectrum, heat is specified from
+ * 0 (cool) to 255 (hot). This is NOT a chromatically correct 'black body
+ * radiation' spectrum, but it's surprisingly close.
+ */
+static const Gradient::Stop HEAT_STOPS[] =
+{
+    {   0U, 0x00000000U },  /* Black */
+    {  85U, 0x00ff0000U },  /* Red */
+    { 170U, 0x00ffff00U },  /* Yellow */
+    { 255U, 0x00ffffffU }   /* White */
+};
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -64,7 +81,7 @@ void FirePlugin::active(IGfx& gfx)
     if (nullptr == m_heat)
     {
         m_heatSize = gfx.getWidth() * gfx.getHeight();
-        m_heat = new uint8_t[m_heatSize];
+        m_heat = static_cast<uint8_t*>(allocBuffer(m_heatSize));
 
         if (nullptr == m_heat)
         {
@@ -72,6 +89,14 @@ void FirePlugin::active(IGfx& gfx)
         }
     }
 
+    if (false == m_isPaletteReady)
+    {
+        createPalette();
+    }
+
+    /* Seed the pseudo random number generator, the state must never be 0. */
+    m_randomState = static_cast<uint32_t>(random(1, INT32_MAX));
+
     /* Clear display */
     gfx.fillScreen(ColorDef::BLACK);
 
@@ -86,76 +111,16 @@ void FirePlugin::inactive()
 
 void FirePlugin::update(IGfx& gfx)
 {
-    int16_t x       = 0;
-    int16_t y       = 0;
-
-    if (nullptr == m_heat)
-    {
-        return;
-    }
-
-    for(x = 0; x < gfx.getWidth(); ++x)
+    if ((nullptr != m_heat) &&
+        (2U <= gfx.getHeight()))
     {
-        /* Step 1) Cool down every cell a little bit */
-        for(y = 0; y < gfx.getHeight(); ++y)
-        {
-            uint8_t     coolDownTemperature = random(0, ((COOLING * 10U) / gfx.getHeight()) + 2U);
-            uint32_t    heatPos             = x + y * gfx.getWidth();
-
-            if (coolDownTemperature >= m_heat[heatPos])
-            {
-                m_heat[heatPos] = 0U;
-            }
-            else
-            {
-                m_heat[heatPos] -= coolDownTemperature;
-            }
-        }
-
-        /* Step 2) Heat from each cell drifts 'up' and diffuses a little bit */
-        for(y = 0; y < (gfx.getHeight() - 1U); ++y)
+        if (true == MatrixGeometry::matches(gfx.getWidth(), gfx.getHeight()))
         {
-            uint16_t    diffusHeat  = 0U;
-
-            if ((gfx.getHeight() - 2U) > y)
-            {
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 2) * gfx.getWidth()];
-                diffusHeat /= 3U;
-            }
-            else
-            {
-                diffusHeat += m_heat[x + (y + 0) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 0) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat /= 3U;
-            }
-
-            m_heat[x + y * gfx.getWidth()] = diffusHeat;
+            updateHeat(gfx, MatrixGeometry());
         }
-
-        /* Step 3) Randomly ignite new 'sparks' of heat near the bottom */
-        if (random(0, 255) < SPARKING)
+        else
         {
-            uint8_t     randValue   = random(160, 255);
-            uint32_t    heatPos     = x + (gfx.getHeight() - 1U) * gfx.getWidth();
-            uint16_t    heat        = m_heat[heatPos] + randValue;
-
-            if (UINT8_MAX < heat)
-            {
-                m_heat[heatPos] = 255U;
-            }
-            else
-            {
-                m_heat[heatPos] = heat;
-            }
-        }
-
-        /* Step 4) Map from heat cells to LED colors */
-        for(y = 0; y < gfx.getHeight(); ++y)
-        {
-            gfx.drawPixel(x, y, heatColor(m_heat[x + y * gfx.getWidth()]));
+            updateHeat(gfx, DynamicGeometry(gfx.getWidth(), gfx.getHeight()));
         }
     }
 
@@ -170,45 +135,100 @@ void FirePlugin::update(IGfx& gfx)
  * Private Methods
  *****************************************************************************/
 
-Color FirePlugin::heatColor(uint8_t temperature)
+template < typename TGeometry >
+void FirePlugin::updateHeat(IGfx& gfx, const TGeometry& geometry)
 {
-    Color heatColor;
+    const uint16_t  WIDTH           = geometry.getWidth();
+    const uint16_t  HEIGHT          = geometry.getHeight();
+    const uint32_t  COOLING_RANGE   = ((COOLING * 10U) / HEIGHT) + 2U;
+    uint32_t        index           = 0U;
+    int16_t         x               = 0;
+    int16_t         y               = 0;
+
+    /* Step 1) Cool down every cell a little bit */
+    for(index = 0U; index < geometry.getPixelCount(); ++index)
+    {
+        uint8_t coolDownTemperature = getRandom(COOLING_RANGE);
 
-    /* Scale 'heat' down from 0-255 to 0-191, which can then be easily divided
-     * into three equal 'thirds' of 64 units each.
+        if (coolDownTemperature >= m_heat[index])
+        {
+            m_heat[index] = 0U;
+        }
+        else
+        {
+            m_heat[index] -= coolDownTemperature;
+        }
+    }
+
+    /* Step 2) Heat from each cell drifts 'up' and diffuses a little bit.
+     * The rows are processed from top to bottom, which means the rows below
+     * are read before they are changed.
      */
-    uint8_t t192        = static_cast<uint32_t>(temperature) * 191U / 255U;
+    for(y = 0; y < (HEIGHT - 1); ++y)
+    {
+        uint8_t*        dstRow  = &m_heat[y * WIDTH];
+        const uint8_t*  srcRow1 = nullptr;
+        const uint8_t*  srcRow2 = nullptr;
 
-    /* Calculate a value that ramps up from zero to 255 in each 'third' of the scale. */
-    uint8_t heatRamp    = t192 & 0x3fU; /* 0..63 */
+        if ((HEIGHT - 2) > y)
+        {
+            srcRow1 = &m_heat[(y + 1) * WIDTH];
+            srcRow2 = &m_heat[(y + 2) * WIDTH];
+        }
+        else
+        {
+            srcRow1 = &m_heat[(y + 0) * WIDTH];
+            srcRow2 = &m_heat[(y + 1) * WIDTH];
+        }
 
-    /* Scale up to 0..252 */
-    heatRamp <<= 2;
+        for(x = 0; x < WIDTH; ++x)
+        {
+            uint32_t diffusHeat = 2U * srcRow1[x] + srcRow2[x];
 
-    /* Now figure out which third of the spectrum we're in. */
-    if (t192 & 0x80U)
-    {
-        /* We're in the hottest third */
-        heatColor.setRed(255U);         /* Full red */
-        heatColor.setGreen(255U);       /* Full green */
-        heatColor.setBlue(heatRamp);    /* Ramp up blue */
+            /* Fixed-point division by 3, exact in the range [0; 765]. */
+            dstRow[x] = (diffusHeat * 683U) >> 11U;
+        }
     }
-    else if (t192 & 0x40U)
+
+    /* Step 3) Randomly ignite new 'sparks' of heat near the bottom */
     {
-        /* We're in the middle third */
-        heatColor.setRed(255U);         /* Full red */
-        heatColor.setGreen(heatRamp);   /* Ramp up green */
-        heatColor.setBlue(0U);          /* No blue */
+        uint8_t* bottomRow = &m_heat[(HEIGHT - 1) * WIDTH];
+
+        for(x = 0; x < WIDTH; ++x)
+        {
+            if (SPARKING > getRandom(UINT8_MAX))
+            {
+                uint16_t heat = bottomRow[x] + 160U + getRandom(UINT8_MAX - 160U);
+
+                if (UINT8_MAX < heat)
+                {
+                    bottomRow[x] = UINT8_MAX;
+                }
+                else
+                {
+                    bottomRow[x] = heat;
+                }
+            }
+        }
     }
-    else
+
+    /* Step 4) Map from heat cells to LED colors via palette, span by span. */
     {
-        /* We're in the coolest third */
-        heatColor.setRed(heatRamp); /* Ramp up red */
-        heatColor.setGreen(0U);     /* No green */
-        heatColor.setBlue(0U);      /* No blue */
+        HeatKernel<TGeometry> kernel(m_heat, geometry);
+
+        EffectRunner::forEachRow(gfx, kernel, 0U, geometry);
     }
 
-    return heatColor;
+    return;
+}
+
+void FirePlugin::createPalette()
+{
+    m_palette.set(HEAT_STOPS, UTIL_ARRAY_NUM(HEAT_STOPS));
+
+    m_isPaletteReady = true;
+
+    return;
 }
 
 /******************************************************************************
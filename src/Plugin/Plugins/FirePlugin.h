@@ -45,6 +45,10 @@
  *****************************************************************************/
 #include <stdint.h>
 #include "Plugin.hpp"
+#include "Board.h"
+
+#include <EffectRunner.hpp>
+#include <Gradient.h>
 
 /******************************************************************************
  * Macros
@@ -67,7 +71,9 @@
  * 3) Sometimes randomly new 'sparks' of heat are added at the bottom
  * 4) The heat from each cell is rendered as a color into the leds array
  *
- * The heat-to-color mapping uses a black-body radiation approximation.
+ * The heat-to-color mapping uses a black-body radiation approximation by a
+ * gradient, which is precalculated once into a palette with one color per
+ * heat level.
  *
  * It was ported from https://github.com/FastLED/FastLED/blob/master/examples/Fire2012/Fire2012.ino
  */
@@ -84,7 +90,8 @@ public:
     FirePlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
         m_heat(nullptr),
-        m_heatSize(0U)
+        m_heatSize(0U),
+        m_randomState(1U)
     {
     }
 
@@ -95,7 +102,7 @@ public:
     {
         if (nullptr != m_heat)
         {
-            delete[] m_heat;
+            releaseBuffer(m_heat);
             m_heat = nullptr;
         }
     }
@@ -137,8 +144,61 @@ public:
 
 private:
 
-    uint8_t*    m_heat;     /**< Heat temperature [0; 255] */
-    size_t      m_heatSize; /**< Number of heat temperatures */
+    uint8_t*    m_heat;         /**< Heat temperature [0; 255] */
+    size_t      m_heatSize;     /**< Number of heat temperatures */
+    uint32_t    m_randomState;  /**< State of the pseudo random number generator, never 0 */
+
+    static Gradient         m_palette;                  /**< Heat palette, shared by all instances. */
+    static bool             m_isPaletteReady;           /**< Is heat palette calculated? */
+
+    /** Geometry of the LED matrix, known at compile time. */
+    typedef FixedGeometry<Board::LedMatrix::width, Board::LedMatrix::height> MatrixGeometry;
+
+    /**
+     * Row kernel, which maps the heat cells via heat palette to colors.
+     *
+     * @tparam TGeometry    Geometry type, see DynamicGeometry and FixedGeometry
+     */
+    template < typename TGeometry >
+    struct HeatKernel
+    {
+        const uint8_t*  heat;       /**< Heat temperatures */
+        TGeometry       geometry;   /**< Geometry of the heat cells */
+
+        /**
+         * Constructs the kernel.
+         *
+         * @param[in] heatCells     Heat temperatures
+         * @param[in] heatGeometry  Geometry of the heat cells
+         */
+        HeatKernel(const uint8_t* heatCells, const TGeometry& heatGeometry) :
+            heat(heatCells),
+            geometry(heatGeometry)
+        {
+        }
+
+        /**
+         * Calculate the colors of a span.
+         *
+         * @param[in]  x        x-coordinate of the first pixel
+         * @param[in]  y        y-coordinate of the first pixel
+         * @param[in]  time     Effect time (not used)
+         * @param[out] colors   Colors of the span
+         * @param[in]  length   Number of pixels
+         */
+        inline void operator()(int16_t x, int16_t y, uint32_t time, Color* colors, uint16_t length) const
+        {
+            const uint8_t*  heatRow = &heat[x + y * geometry.getWidth()];
+            uint16_t        index   = 0U;
+
+            UTIL_NOT_USED(time);
+
+            for(index = 0U; index < length; ++index)
+            {
+                colors[index] = m_palette.get(heatRow[index]);
+            }
+        }
+    };
 
     /**
      * Cooling: How much does the air cool as it rises?
@@ -154,13 +214,50 @@ private:
     static const uint8_t    SPARKING    = 120U;
 
     /**
-     * Approximates a 'black body radiation' spectrum for a given 'heat' level.
-     * This is useful for animations of 'fire'.
-     * Heat is specified as an arbitrary scale from 0 (cool) to 255 (hot).
-     * This is NOT a chromatically correct 'black body radiation'
-     * spectrum, but it's surprisingly close, and it's fast and small.
+     * Update the heat cells and draw them. With a fixed geometry, the loop
+     * bounds and row strides are compile-time constants.
+     *
+     * @tparam TGeometry    Geometry type, see DynamicGeometry and FixedGeometry
+     *
+     * @param[in] gfx       Display graphics interface
+     * @param[in] geometry  Geometry of the display
      */
-    Color heatColor(uint8_t temperature);
+    template < typename TGeometry >
+    void updateHeat(IGfx& gfx, const TGeometry& geometry);
+
+    /**
+     * Calculate the heat palette once, which maps every heat level to its color.
+     */
+    static void createPalette();
+
+    /**
+     * Get next pseudo random number from the xorshift32 generator.
+     * It is much cheaper than the Arduino random() function, which is
+     * sufficient for the fire simulation.
+     *
+     * @return Pseudo random number
+     */
+    inline uint32_t getRandom()
+    {
+        m_randomState ^= m_randomState << 13U;
+        m_randomState ^= m_randomState >> 17U;
+        m_randomState ^= m_randomState << 5U;
+
+        return m_randomState;
+    }
+
+    /**
+     * Get pseudo random number in the range [0; range[.
+     * The range is applied by fixed-point multiplication instead of a division.
+     *
+     * @param[in] range Upper limit (exclusive), max. 65536
+     *
+     * @return Pseudo random number
+     */
+    inline uint32_t getRandom(uint32_t range)
+    {
+        return ((getRandom() >> 16U) * range) >> 16U;
+    }
 };
 
 /******************************************************************************
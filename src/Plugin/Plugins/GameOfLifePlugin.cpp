@@ -50,6 +50,8 @@
  * Prototypes
  *****************************************************************************/
 
+static inline void fullAdd(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -75,9 +77,16 @@ void GameOfLifePlugin::active(IGfx& gfx)
 
     if (false == isInit)
     {
-        m_width     = gfx.getWidth();
-        m_height    = gfx.getHeight();
-        m_gridSize  = ((m_width * m_height) + (BITS - 1U)) / BITS;
+        uint8_t usedBits = 0U;
+
+        m_width         = gfx.getWidth();
+        m_height        = gfx.getHeight();
+        m_wordsPerRow   = (m_width + (BITS - 1U)) / BITS;
+        m_gridSize      = m_wordsPerRow * m_height;
+
+        /* The unused cells in the last element of a row are always dead. */
+        usedBits        = m_width - ((m_wordsPerRow - 1U) * BITS);
+        m_lastWordMask  = (BITS <= usedBits) ? UINT32_MAX : ((1U << usedBits) - 1U);
 
         if (true == createGrids())
         {
@@ -139,6 +148,7 @@ void GameOfLifePlugin::update(IGfx& gfx)
              (true == m_forceRestartTimer.isTimeout()))
     {
         generateInitialPattern(m_activeGrid);
+        update(gfx, m_activeGrid);
         m_forceRestartTimer.restart();
         m_restartTimer.stop();
     }
@@ -147,88 +157,38 @@ void GameOfLifePlugin::update(IGfx& gfx)
              (true == m_restartTimer.isTimeout()))
     {
         generateInitialPattern(m_activeGrid);
+        update(gfx, m_activeGrid);
         m_forceRestartTimer.restart();
         m_restartTimer.stop();
     }
+    else
+    {
+        ;
+    }
 
     /* Let's play the game of life. */
     if ((true == isInit) &&
         (true == m_displayTimer.isTimeout()))
     {
-        int32_t cellX           = 0;
-        int32_t cellY           = 0;
-        uint8_t inactiveGrid    = (m_activeGrid + 1U) % GRIDS;
-        bool    isStable        = true;
+        uint8_t     inactiveGrid    = (m_activeGrid + 1U) % GRIDS;
+        bool        isStable        = true;
+        uint32_t    hash            = HASH_INIT;
 
         /* Note: The active grid is the one, where we look how the current state of
          * every cell is. This is the grid, which is shown on the display right now.
-         * The next time cycle of the game will be drawn now on the inactive grid,
-         * which will be then shown at the end of this routine.
+         * The next time cycle of the game will be calculated now on the inactive grid
+         * and only the changed cells are drawn.
          *
          * After that the active grid will be inactive and vice versa.
          */
+        isStable = calcNextGeneration(gfx, m_activeGrid, inactiveGrid, hash);
 
-        /* Handle active grid */
-        for(cellY = 0; cellY < m_height; ++cellY)
+        /* A repeated generation means a oscillator, which is stable too. */
+        if (true == addToHistory(hash))
         {
-            for(cellX = 0; cellX < m_width; ++cellX)
-            {
-                bool    cellState       = getCellState(m_activeGrid, cellX, cellY);
-                uint8_t neighboursAlive = countAliveNeighbours(m_activeGrid, cellX, cellY);
-                bool    newState        = false;
-
-                /* Rules:
-                 * 1. Any live cell with fewer than two live neighbours dies, as if by underpopulation.
-                 * 2. Any live cell with two or three live neighbours lives on to the next generation.
-                 * 3. Any live cell with more than three live neighbours dies, as if by overpopulation.
-                 * 4. Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
-                 */
-
-                /* Dead? */
-                if (false == cellState)
-                {
-                    /* Rule 4: Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction. */
-                    if (3U == neighboursAlive)
-                    {
-                        newState = true;
-                    }
-                    /* Cell stays dead. */
-                    else
-                    {
-                        newState = false;
-                    }
-                }
-                /* Alive */
-                else
-                {
-                    /* Rule 1: Any live cell with fewer than two live neighbours dies, as if by underpopulation. */
-                    if (2U > neighboursAlive)
-                    {
-                        newState = false;
-                    }
-                    /* Rule 2: Any live cell with two or three live neighbours lives on to the next generation. */
-                    else if (4U > neighboursAlive)
-                    {
-                        newState = true;
-                    }
-                    /* Rule 3: Any live cell with more than three live neighbours dies, as if by overpopulation. */
-                    else
-                    {
-                        newState = false;
-                    }
-                }
-
-                setCellState(inactiveGrid, cellX, cellY, newState);
-
-                if (cellState != newState)
-                {
-                    isStable = false;
-                }
-            }
+            isStable = true;
         }
 
-        update(gfx, inactiveGrid);
-
         /* If grid is stable, restart game after a period. */
         if ((true == isStable) &&
             (false == m_restartTimer.isTimerRunning()))
@@ -266,7 +226,7 @@ bool GameOfLifePlugin::createGrids()
 
     while((GRIDS > index) && (true == status))
     {
-        m_grids[index] = new uint32_t[m_gridSize];
+        m_grids[index] = static_cast<uint32_t*>(allocBuffer(m_gridSize * sizeof(uint32_t)));
 
         if (nullptr == m_grids[index])
         {
@@ -292,7 +252,8 @@ void GameOfLifePlugin::destroyGrids()
     {
         if (nullptr != m_grids[index])
         {
-            delete[] m_grids[index];
+            releaseBuffer(m_grids[index]);
+            m_grids[index] = nullptr;
         }
 
         ++index;
@@ -303,160 +264,211 @@ void GameOfLifePlugin::destroyGrids()
 
 void GameOfLifePlugin::generateInitialPattern(uint8_t gridId)
 {
-    uint32_t gridDataIndex = 0U;
+    uint16_t    y       = 0U;
+    uint32_t*   grid    = m_grids[gridId];
 
     randomSeed(ESP.getCycleCount());
 
-    while(m_gridSize > gridDataIndex)
+    /* The generations of the previous pattern don't matter anymore. */
+    m_historyIdx    = 0U;
+    m_historyCount  = 0U;
+
+    for(y = 0U; y < m_height; ++y)
     {
-        m_grids[gridId][gridDataIndex] = random(INT32_MAX);
-        m_grids[gridId][gridDataIndex] |= (0 == random(2)) ? 0x00000000 : 0x80000000;
+        uint32_t*   row     = &grid[y * m_wordsPerRow];
+        uint16_t    wordIdx = 0U;
 
-        ++gridDataIndex;
+        for(wordIdx = 0U; wordIdx < m_wordsPerRow; ++wordIdx)
+        {
+            row[wordIdx] = random(INT32_MAX);
+            row[wordIdx] |= (0 == random(2)) ? 0x00000000 : 0x80000000;
+        }
+
+        row[m_wordsPerRow - 1U] &= m_lastWordMask;
     }
 
     return;
 }
 
-bool GameOfLifePlugin::getCellState(uint8_t gridId, int16_t x, int16_t y)
+bool GameOfLifePlugin::getCellState(uint8_t gridId, uint16_t x, uint16_t y) const
 {
-    bool isAlive = false;
+    const uint32_t* row = &m_grids[gridId][y * m_wordsPerRow];
 
-    if (0 > x)
-    {
-        x = m_width + x;
-    }
-    else if (m_width <= x)
-    {
-        x -= m_width;
-    }
-    else
-    {
-        ;
-    }
+    return (0U != ((row[x / BITS] >> (x % BITS)) & 1U));
+}
 
-    if (0 > y)
-    {
-        y = m_height + y;
-    }
-    else if (m_height <= y)
+uint32_t GameOfLifePlugin::getWestNeighbours(const uint32_t* row, uint16_t wordIdx) const
+{
+    uint32_t neighbours = row[wordIdx] << 1U;
+
+    /* The west neighbour of the first cell in the row is the last cell. */
+    if (0U == wordIdx)
     {
-        y -= m_height;
+        const uint16_t LAST_X = m_width - 1U;
+
+        neighbours |= (row[LAST_X / BITS] >> (LAST_X % BITS)) & 1U;
     }
     else
     {
-        ;
+        neighbours |= row[wordIdx - 1U] >> (BITS - 1U);
     }
 
-    if ((0 <= x) &&
-        (0 <= y) &&
-        (m_width > x) &&
-        (m_height > y))
+    if ((m_wordsPerRow - 1U) == wordIdx)
     {
-        uint32_t    cellIndex       = x + m_width * y;
-        uint32_t    cellDataIndex   = cellIndex / BITS;
-        uint8_t     bitIndex        = cellIndex - (cellDataIndex * BITS);
-
-        isAlive = (0 != (m_grids[gridId][cellDataIndex] & (1 << bitIndex)));
+        neighbours &= m_lastWordMask;
     }
 
-    return isAlive;
+    return neighbours;
 }
 
-void GameOfLifePlugin::setCellState(uint8_t gridId, int16_t x, int16_t y, bool state)
+uint32_t GameOfLifePlugin::getEastNeighbours(const uint32_t* row, uint16_t wordIdx) const
 {
-    if (0 > x)
-    {
-        x = m_width + x;
-    }
-    else if (m_width <= x)
-    {
-        x -= m_width;
-    }
-    else
-    {
-        ;
-    }
+    uint32_t neighbours = row[wordIdx] >> 1U;
 
-    if (0 > y)
+    /* The east neighbour of the last cell in the row is the first cell. */
+    if ((m_wordsPerRow - 1U) == wordIdx)
     {
-        y = m_height + y;
-    }
-    else if (m_height <= y)
-    {
-        y -= m_height;
+        const uint8_t LAST_BIT = (m_width - 1U) % BITS;
+
+        neighbours |= (row[0U] & 1U) << LAST_BIT;
     }
     else
     {
-        ;
+        neighbours |= (row[wordIdx + 1U] & 1U) << (BITS - 1U);
     }
 
-    if ((0 <= x) &&
-        (0 <= y) &&
-        (m_width > x) &&
-        (m_height > y))
-    {
-        uint32_t    cellIndex       = x + m_width * y;
-        uint32_t    cellDataIndex   = cellIndex / BITS;
-        uint8_t     bitIndex        = cellIndex - (cellDataIndex * BITS);
+    return neighbours;
+}
 
-        if (false == state)
-        {
-            m_grids[gridId][cellDataIndex] &= ~(1 << bitIndex);
-        }
-        else
+bool GameOfLifePlugin::calcNextGeneration(IGfx& gfx, uint8_t srcGridId, uint8_t dstGridId, uint32_t& hash)
+{
+    bool        isStable    = true;
+    uint16_t    y           = 0U;
+    uint32_t*   srcGrid     = m_grids[srcGridId];
+    uint32_t*   dstGrid     = m_grids[dstGridId];
+
+    for(y = 0U; y < m_height; ++y)
+    {
+        /* The grid wraps around at the top and the bottom. */
+        const uint16_t  Y_ABOVE = (0U == y) ? (m_height - 1U) : (y - 1U);
+        const uint16_t  Y_BELOW = ((m_height - 1U) == y) ? 0U : (y + 1U);
+        const uint32_t* above   = &srcGrid[Y_ABOVE * m_wordsPerRow];
+        const uint32_t* row     = &srcGrid[y * m_wordsPerRow];
+        const uint32_t* below   = &srcGrid[Y_BELOW * m_wordsPerRow];
+        uint32_t*       dstRow  = &dstGrid[y * m_wordsPerRow];
+        uint16_t        wordIdx = 0U;
+
+        for(wordIdx = 0U; wordIdx < m_wordsPerRow; ++wordIdx)
         {
-            m_grids[gridId][cellDataIndex] |= 1 << bitIndex;
+            uint32_t    sum0    = 0U;
+            uint32_t    carry0  = 0U;
+            uint32_t    sum1    = 0U;
+            uint32_t    carry1  = 0U;
+            uint32_t    sum2    = 0U;
+            uint32_t    carry2  = 0U;
+            uint32_t    ones    = 0U;
+            uint32_t    carry3  = 0U;
+            uint32_t    sum4    = 0U;
+            uint32_t    carry4  = 0U;
+            uint32_t    twos    = 0U;
+            uint32_t    carry5  = 0U;
+            uint32_t    fours   = 0U;
+            uint32_t    alive   = row[wordIdx];
+            uint32_t    next    = 0U;
+            uint32_t    changed = 0U;
+
+            /* Count the eight neighbours of 32 cells in parallel. Every full adder
+             * adds three bits of the same weight to a sum and a carry bit.
+             */
+            fullAdd(getWestNeighbours(above, wordIdx), above[wordIdx], getEastNeighbours(above, wordIdx), sum0, carry0);
+            fullAdd(getWestNeighbours(below, wordIdx), below[wordIdx], getEastNeighbours(below, wordIdx), sum1, carry1);
+            fullAdd(getWestNeighbours(row, wordIdx), getEastNeighbours(row, wordIdx), 0U, sum2, carry2);
+
+            /* Weight 1 */
+            fullAdd(sum0, sum1, sum2, ones, carry3);
+
+            /* Weight 2, everything above is summarized as 4 or more neighbours. */
+            fullAdd(carry0, carry1, carry2, sum4, carry4);
+            fullAdd(sum4, carry3, 0U, twos, carry5);
+            fours = carry4 | carry5;
+
+            /* Rules:
+             * 1. Any live cell with fewer than two live neighbours dies, as if by underpopulation.
+             * 2. Any live cell with two or three live neighbours lives on to the next generation.
+             * 3. Any live cell with more than three live neighbours dies, as if by overpopulation.
+             * 4. Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
+             *
+             * Which means with 3 neighbours a cell is alive, with 2 neighbours it keeps its state.
+             */
+            next    = twos & (~fours) & (ones | alive);
+            changed = next ^ alive;
+
+            dstRow[wordIdx] = next;
+
+            /* FNV-1a over the words is cheap and good enough to detect repetitions. */
+            hash = (hash ^ next) * HASH_PRIME;
+
+            /* Draw only the changed cells. */
+            if (0U != changed)
+            {
+                isStable = false;
+
+                while(0U != changed)
+                {
+                    const uint8_t   BIT_IDX = __builtin_ctz(changed);
+                    const int16_t   X       = wordIdx * BITS + BIT_IDX;
+
+                    if (0U == ((next >> BIT_IDX) & 1U))
+                    {
+                        gfx.drawPixel(X, y, ColorDef::BLACK);
+                    }
+                    else
+                    {
+                        gfx.drawPixel(X, y, ColorDef::BLUE);
+                    }
+
+                    /* Clear lowest set bit */
+                    changed &= changed - 1U;
+                }
+            }
         }
     }
 
-    return;
+    return isStable;
 }
 
-uint8_t GameOfLifePlugin::countAliveNeighbours(uint8_t gridId, int16_t x, int16_t y)
+bool GameOfLifePlugin::addToHistory(uint32_t hash)
 {
-    const int16_t   MAX_X   = 3;    /* 3 cells per row */
-    const int16_t   MAX_Y   = 3;    /* 3 cells per column */
-    uint8_t         count   = 0U;
-    int16_t         dX      = 0;
-    int16_t         dY      = 0;
-
-    /* Cell neighbours, marked with a '#':
-     * ###
-     * #x#
-     * ###
-     */
-
-    for(dY = 0; dY < MAX_Y; ++dY)
-    {
-        int16_t neighbourY = (y - 1) + dY;
+    bool    isRepeated  = false;
+    uint8_t index       = 0U;
 
-        for(dX = 0; dX < MAX_X; ++dX)
+    for(index = 0U; (index < m_historyCount) && (false == isRepeated); ++index)
+    {
+        if (hash == m_history[index])
         {
-            int16_t neighbourX = (x - 1) + dX;
-
-            if ((x != neighbourX) ||
-                (y != neighbourY))
-            {
-                if (true == getCellState(gridId, neighbourX, neighbourY))
-                {
-                    ++count;
-                }
-            }
+            isRepeated = true;
         }
     }
 
-    return count;
+    m_history[m_historyIdx] = hash;
+    m_historyIdx            = (m_historyIdx + 1U) % HISTORY_SIZE;
+
+    if (HISTORY_SIZE > m_historyCount)
+    {
+        ++m_historyCount;
+    }
+
+    return isRepeated;
 }
 
 void GameOfLifePlugin::update(IGfx& gfx, uint8_t gridId)
 {
-    int16_t x   = 0;
-    int16_t y   = 0;
+    uint16_t x  = 0U;
+    uint16_t y  = 0U;
 
-    for(y = 0; y < m_height; ++y)
+    for(y = 0U; y < m_height; ++y)
     {
-        for(x = 0; x < m_width; ++x)
+        for(x = 0U; x < m_width; ++x)
         {
             if (false == getCellState(gridId, x, y))
             {
@@ -479,3 +491,22 @@ void GameOfLifePlugin::update(IGfx& gfx, uint8_t gridId)
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Bitwise full adder, which adds three bits of the same weight per bit position.
+ *
+ * @param[in]   a       Summand a
+ * @param[in]   b       Summand b
+ * @param[in]   c       Summand c
+ * @param[out]  sum     Sum with the same weight
+ * @param[out]  carry   Carry with the next higher weight
+ */
+static inline void fullAdd(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry)
+{
+    const uint32_t A_XOR_B = a ^ b;
+
+    sum     = A_XOR_B ^ c;
+    carry   = (a & b) | (c & A_XOR_B);
+
+    return;
+}
@@ -69,6 +69,16 @@
  * 3. Any live cell with more than three live neighbours dies, as if by overpopulation.
  * 4. Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
  *
+ * The cells are bit-packed, every grid row consists of one or more 32-bit
+ * words. The next generation is calculated for 32 cells in parallel, by
+ * adding the shifted neighbour rows bitwise with full adders. Only the cells,
+ * which changed, are drawn again.
+ *
+ * Still lifes and oscillators would be shown until the forced restart.
+ * Therefore a hash of every generation is calculated on the fly and kept
+ * in a short history. If a hash repeats, the pattern oscillates with a
+ * period up to the history size and the game restarts after a while.
+ *
  * See https://en.wikipedia.org/wiki/Conway%27s_Game_of_Life
  */
 class GameOfLifePlugin : public Plugin
@@ -88,6 +98,11 @@ public:
         m_grids(),
         m_width(0U),
         m_height(0U),
+        m_wordsPerRow(0U),
+        m_lastWordMask(0U),
+        m_history(),
+        m_historyIdx(0U),
+        m_historyCount(0U),
         m_displayTimer(),
         m_restartTimer(),
         m_forceRestartTimer()
@@ -161,14 +176,28 @@ private:
     /** Force restart period in ms. */
     static const uint32_t   FORCE_RESTART_PERIOD    = 10000U;
 
-    uint8_t     m_activeGrid;           /**< Current active grid */
-    uint32_t    m_gridSize;             /**< Size of one grid in number of elements */
-    uint32_t*   m_grids[GRIDS];         /**< Two grids as playfields. */
-    uint16_t    m_width;                /**< Grid width */
-    uint16_t    m_height;               /**< Grid height */
-    SimpleTimer m_displayTimer;         /**< Timer, used for cyclic display update. */
-    SimpleTimer m_restartTimer;         /**< Timer, used to restart the whole game of life if grid is stable. */
-    SimpleTimer m_forceRestartTimer;    /**< Timer, used to force a restart of the whole game of life. */
+    /** Number of generation hashes in the history, which is the max. detected oscillator period. */
+    static const uint8_t    HISTORY_SIZE            = 16U;
+
+    /** Initial generation hash value (FNV-1a offset basis) */
+    static const uint32_t   HASH_INIT               = 2166136261U;
+
+    /** Generation hash multiplier (FNV-1a prime) */
+    static const uint32_t   HASH_PRIME              = 16777619U;
+
+    uint8_t     m_activeGrid;            /**< Current active grid */
+    uint32_t    m_gridSize;              /**< Size of one grid in number of elements */
+    uint32_t*   m_grids[GRIDS];          /**< Two grids as playfields. */
+    uint16_t    m_width;                 /**< Grid width */
+    uint16_t    m_height;                /**< Grid height */
+    uint16_t    m_wordsPerRow;           /**< Number of elements per grid row */
+    uint32_t    m_lastWordMask;          /**< Mask of the used cells in the last element of a row */
+    uint32_t    m_history[HISTORY_SIZE]; /**< Hashes of the last generations, used as ring buffer. */
+    uint8_t     m_historyIdx;            /**< Index of the next hash in the history */
+    uint8_t     m_historyCount;          /**< Number of hashes in the history */
+    SimpleTimer m_displayTimer;          /**< Timer, used for cyclic display update. */
+    SimpleTimer m_restartTimer;          /**< Timer, used to restart the whole game of life if grid is stable. */
+    SimpleTimer m_forceRestartTimer;     /**< Timer, used to force a restart of the whole game of life. */
 
     /**
      * Create all grids.
@@ -198,28 +227,50 @@ private:
      *
      * @return Alive (true) or dead (false).
      */
-    bool getCellState(uint8_t gridId, int16_t x, int16_t y);
+    bool getCellState(uint8_t gridId, uint16_t x, uint16_t y) const;
 
     /**
-     * Set cell state.
+     * Get the west neighbours of 32 cells in a row. Every bit contains the
+     * state of the cell left of it, including the wrap around of the row.
      *
-     * @param[in] gridId    Id of grid, where the cell lives
-     * @param[in] x         x-coordinate of cell
-     * @param[in] y         y-coordinate of cell
-     * @param[in] state     Alive (true) or dead (false).
+     * @param[in] row       Grid row
+     * @param[in] wordIdx   Index of the element in the row
+     *
+     * @return West neighbours
      */
-    void setCellState(uint8_t gridId, int16_t x, int16_t y, bool state);
+    uint32_t getWestNeighbours(const uint32_t* row, uint16_t wordIdx) const;
 
     /**
-     * Count all alive neighbours of cell.
+     * Get the east neighbours of 32 cells in a row. Every bit contains the
+     * state of the cell right of it, including the wrap around of the row.
      *
-     * @param[in] gridId    Id of grid, where the cell lives
-     * @param[in] x         x-coordinate of cell
-     * @param[in] y         y-coordinate of cell
+     * @param[in] row       Grid row
+     * @param[in] wordIdx   Index of the element in the row
+     *
+     * @return East neighbours
+     */
+    uint32_t getEastNeighbours(const uint32_t* row, uint16_t wordIdx) const;
+
+    /**
+     * Calculate the next generation and draw the changed cells.
+     *
+     * @param[in]  gfx          Graphics interface
+     * @param[in]  srcGridId    Id of grid with the current generation
+     * @param[in]  dstGridId    Id of grid for the next generation
+     * @param[out] hash         Hash of the next generation
+     *
+     * @return If no cell changed, it will return true otherwise false.
+     */
+    bool calcNextGeneration(IGfx& gfx, uint8_t srcGridId, uint8_t dstGridId, uint32_t& hash);
+
+    /**
+     * Add the hash of a generation to the history.
+     *
+     * @param[in] hash  Generation hash
      *
-     * @return Number of alive neighbours.
+     * @return If the hash was already in the history, it will return true otherwise false.
      */
-    uint8_t countAliveNeighbours(uint8_t gridId, int16_t x, int16_t y);
+    bool addToHistory(uint32_t hash);
 
     /**
      * Update the display with the grid.
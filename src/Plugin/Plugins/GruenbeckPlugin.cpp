@@ -34,12 +34,14 @@
  *****************************************************************************/
 #include "GruenbeckPlugin.h"
 #include "RestApi.h"
-#include "AsyncHttpClient.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "ConfigStore.h"
+#include "StateStore.h"
 
 #include <ArduinoJson.h>
 #include <Logging.h>
-#include <JsonFile.h>
+#include <Util.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -64,14 +66,11 @@
 /* Initialize image path. */
 const char* GruenbeckPlugin::IMAGE_PATH     = "/images/gruenbeck.bmp";
 
-/* Initialize configuration path. */
-const char* GruenbeckPlugin::CONFIG_PATH    = "/configuration";
-
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-void GruenbeckPlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void GruenbeckPlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_url = baseUri + "/ipAddress";
 
@@ -86,7 +85,7 @@ void GruenbeckPlugin::registerWebInterface(AsyncWebServer& srv, const String& ba
     return;
 }
 
-void GruenbeckPlugin::unregisterWebInterface(AsyncWebServer& srv)
+void GruenbeckPlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_url.c_str());
 
@@ -100,46 +99,59 @@ void GruenbeckPlugin::unregisterWebInterface(AsyncWebServer& srv)
     return;
 }
 
-void GruenbeckPlugin::active(IGfx& gfx)
+void GruenbeckPlugin::prepare()
 {
     lock();
 
-    gfx.fillScreen(ColorDef::BLACK);
-
-    if (nullptr == m_iconCanvas)
+    /* Check for a uploaded configuration file only, if any file changed
+     * since the last check.
+     */
+    if (FileIo::getInstance().getGeneration() != m_cfgGeneration)
     {
-        m_iconCanvas = new Canvas(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+        m_cfgGeneration = FileIo::getInstance().getGeneration();
 
-        if (nullptr != m_iconCanvas)
+        if (true == ConfigStore::getInstance().importFile(getUID(), m_configurationFilename))
         {
-            (void)m_iconCanvas->addWidget(m_bitmapWidget);
-
-            /* Load  icon from filesystem. */
-            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
-
-            m_iconCanvas->update(gfx);
+            (void)loadConfiguration();
         }
     }
-    else
-    {
-        m_iconCanvas->update(gfx);
-    }
 
-    if (nullptr == m_textCanvas)
-    {
-        m_textCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, gfx.getHeight(), ICON_WIDTH, 0);
+    loadIcon();
 
-        if (nullptr != m_textCanvas)
-        {
-            (void)m_textCanvas->addWidget(m_textWidget);
+    unlock();
 
-            m_textCanvas->update(gfx);
-        }
-    }
-    else
-    {
-        m_textCanvas->update(gfx);
-    }
+    return;
+}
+
+void GruenbeckPlugin::releaseAssets()
+{
+    lock();
+
+    m_bitmapWidget.clear();
+    m_isIconLoaded = false;
+
+    unlock();
+
+    return;
+}
+
+void GruenbeckPlugin::active(IGfx& gfx)
+{
+    CanvasView  iconView(gfx, 0, 0, ICON_WIDTH, ICON_HEIGHT);
+    CanvasView  textView(gfx, ICON_WIDTH, 0, gfx.getWidth() - ICON_WIDTH, gfx.getHeight());
+
+    lock();
+
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* The display was cleared, therefore everything must be drawn again. */
+    m_bitmapWidget.invalidate();
+    m_textWidget.invalidate();
+
+    loadIcon();
+
+    (void)iconView.drawWidget(m_bitmapWidget);
+    (void)textView.drawWidget(m_textWidget);
 
     unlock();
 
@@ -154,22 +166,17 @@ void GruenbeckPlugin::inactive()
 
 void GruenbeckPlugin::update(IGfx& gfx)
 {
+    CanvasView  iconView(gfx, 0, 0, ICON_WIDTH, ICON_HEIGHT);
+    CanvasView  textView(gfx, ICON_WIDTH, 0, gfx.getWidth() - ICON_WIDTH, gfx.getHeight());
+
     lock();
 
     if (false != m_httpResponseReceived)
     {
         m_textWidget.setFormatStr("\\calign" + m_relevantResponsePart + "%");
-        gfx.fillScreen(ColorDef::BLACK);
-
-        if (nullptr != m_iconCanvas)
-        {
-            m_iconCanvas->update(gfx);
-        }
 
-        if (nullptr != m_textCanvas)
-        {
-            m_textCanvas->update(gfx);
-        }
+        (void)iconView.drawWidget(m_bitmapWidget);
+        (void)textView.drawWidget(m_textWidget);
 
         m_relevantResponsePart = "";
 
@@ -181,29 +188,59 @@ void GruenbeckPlugin::update(IGfx& gfx)
     return;
 }
 
+uint32_t GruenbeckPlugin::getUpdatePeriod() const
+{
+    return DISPLAY_UPDATE_PERIOD;
+}
+
+bool GruenbeckPlugin::hasContent() const
+{
+    bool hasContent = false;
+
+    lock();
+    hasContent = m_hasContent;
+    unlock();
+
+    return hasContent;
+}
+
 void GruenbeckPlugin::start()
 {
+    String  lastText;
+    time_t  timestamp   = 0;
+
     lock();
 
-    m_configurationFilename = String(CONFIG_PATH) + "/" + getUID() + ".json";
+    m_configurationFilename = String(ConfigStore::IMPORT_PATH) + "/" + getUID() + ".json";
 
     /* Try to load configuration. If there is no configuration available, a default configuration
      * will be created.
      */
-    createConfigDirectory();
+    m_cfgGeneration = FileIo::getInstance().getGeneration();
     if (false == loadConfiguration())
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", m_configurationFilename.c_str());
+            LOG_WARNING("Failed to create initial configuration.");
         }
     }
 
-    initHttpClient();
+    /* Show the last known rest capacity marked as stale, till the first
+     * response is received.
+     */
+    if (true == StateStore::getInstance().load(getUID(), lastText, timestamp))
+    {
+        m_relevantResponsePart  = String(StateStore::STALE_COLOR) + lastText;
+        m_httpResponseReceived  = true;
+        m_hasContent            = true;
+    }
+
+    initHttpRequest();
     if (false == startHttpRequest())
     {
         /* If a request fails, show a '?' */
         m_textWidget.setFormatStr("\\calign?");
+        m_hasContent = false;
 
         m_requestTimer.start(UPDATE_PERIOD_SHORT);
     }
@@ -222,28 +259,27 @@ void GruenbeckPlugin::stop()
     lock();
 
     m_requestTimer.stop();
+    HttpClientPool::getInstance().abort(this);
 
-    if (false != FILESYSTEM.remove(m_configurationFilename))
-    {
-        LOG_INFO("File %s removed", m_configurationFilename.c_str());
-    }
+    ConfigStore::getInstance().remove(getUID());
+    StateStore::getInstance().remove(getUID());
 
     unlock();
 
     return;
 }
 
-void GruenbeckPlugin::process()
+void GruenbeckPlugin::onTimeout(EventTimer& timer)
 {
     lock();
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
+    if (&m_requestTimer == &timer)
     {
         if (false == startHttpRequest())
         {
             /* If a request fails, show a '?' */
             m_textWidget.setFormatStr("\\calign?");
+            m_hasContent = false;
 
             m_requestTimer.start(UPDATE_PERIOD_SHORT);
         }
@@ -287,9 +323,18 @@ void GruenbeckPlugin::setIPAddress(const String& ipAddress)
  * Private Methods
  *****************************************************************************/
 
+void GruenbeckPlugin::loadIcon()
+{
+    if (false == m_isIconLoaded)
+    {
+        m_isIconLoaded = m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
+    }
+
+    return;
+}
+
 void GruenbeckPlugin::webReqHandler(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -353,8 +398,7 @@ void GruenbeckPlugin::webReqHandler(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -367,105 +411,104 @@ bool GruenbeckPlugin::startHttpRequest()
     {
         String url = String("http://") + m_ipAddress + "/mux_http";
 
-        if (true == m_client.begin(url))
+        m_httpRequest.url = url;
+
+        /* The response body is streamed into the extractor. */
+        m_xmlExtractor.reset();
+
+        if (false == HttpClientPool::getInstance().request(m_httpRequest))
         {
-            m_client.addPar("id","42");
-            m_client.addPar("show","D_Y_10_1~");
-
-            if (false == m_client.POST())
-            {
-                LOG_WARNING("POST %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
+            LOG_WARNING("POST %s failed.", url.c_str());
+        }
+        else
+        {
+            status = true;
         }
     }
 
     return status;
 }
 
-void GruenbeckPlugin::initHttpClient()
+void GruenbeckPlugin::initHttpRequest()
 {
-    m_client.regOnResponse([this](const HttpResponse& rsp){
-        /* Structure of response-payload for requesting D_Y_10_1
-         *
-         * <data><code>ok</code><D_Y_10_1>XYZ</D_Y_10_1></data>
-         *
-         * <data><code>ok</code><D_Y_10_1>  = 31 bytes
-         * XYZ                              = 3 byte (relevant data)
-         * </D_Y_10_1></data>               = 18 bytes
-         */
-
-        /* Start index of relevant data */
-        const uint32_t  START_INDEX_OF_RELEVANT_DATA    = 31U;
-
-        /* Length of relevant data */
-        const uint32_t  RELEVANT_DATA_LENGTH            = 3U;
-
-        size_t          payloadSize                     = 0U;
-        const char*     payload                         = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-        char            restCapacity[RELEVANT_DATA_LENGTH + 1];
-
-        if (payloadSize >= (START_INDEX_OF_RELEVANT_DATA + RELEVANT_DATA_LENGTH))
-        {
-            memcpy(restCapacity, &payload[START_INDEX_OF_RELEVANT_DATA], RELEVANT_DATA_LENGTH);
-            restCapacity[RELEVANT_DATA_LENGTH] = '\0';
-        }
-        else
+    m_httpRequest.owner         = this;
+    m_httpRequest.priority      = HttpClientPool::PRIORITY_LOW;
+    m_httpRequest.isPost        = true;
+    m_httpRequest.isKeepAlive   = true;
+
+    m_httpRequest.clearPar();
+    (void)m_httpRequest.addPar("id","42");
+    (void)m_httpRequest.addPar("show","D_Y_10_1~");
+
+    /* Structure of response-payload for requesting D_Y_10_1
+     *
+     * <data><code>ok</code><D_Y_10_1>XYZ</D_Y_10_1></data>
+     *
+     * Only the value of D_Y_10_1 is relevant. It is extracted while the
+     * body is received, so the body is never buffered.
+     */
+    (void)m_xmlExtractor.setTag("D_Y_10_1");
+
+    m_httpRequest.onBody = [this](const uint8_t* data, size_t size){
+        m_xmlExtractor.parse(data, size);
+    };
+
+    m_httpRequest.onResponse = [this](const HttpResponse& rsp){
+        bool    isValid         = false;
+        String  restCapacity    = "?";
+
+        UTIL_NOT_USED(rsp);
+
+        if ((true == m_xmlExtractor.isFound()) &&
+            ('\0' != m_xmlExtractor.getValue()[0]))
         {
-            restCapacity[0] = '?';
-            restCapacity[1] = '\0';
+            restCapacity    = m_xmlExtractor.getValue();
+            isValid         = true;
         }
 
         lock();
         m_relevantResponsePart = restCapacity;
         m_httpResponseReceived = true;
+        m_hasContent = isValid;
         unlock();
-    });
-
-    m_client.regOnClosed([this]() {
-        LOG_INFO("Connection closed.");
 
-        lock();
-        if (true == m_isConnectionError)
+        if (true == isValid)
         {
-            /* If a request fails, show a '?' */
-            m_textWidget.setFormatStr("\\calign?");
-
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
+            StateStore::getInstance().save(getUID(), restCapacity);
         }
-        m_isConnectionError = false;
-        unlock();
-    });
+    };
 
-    m_client.regOnError([this]() {
+    m_httpRequest.onError = [this]() {
         LOG_WARNING("Connection error happened.");
 
         lock();
-        m_isConnectionError = true;
+
+        /* If a request fails, show a '?' */
+        m_textWidget.setFormatStr("\\calign?");
+        m_hasContent = false;
+
+        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+
         unlock();
-    });
+    };
 }
 
 bool GruenbeckPlugin::saveConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     jsonDoc["gruenbeckIP"] = m_ipAddress;
     
-    if (false == jsonFile.save(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration.");
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", m_configurationFilename.c_str());
+        LOG_INFO("Configuration saved.");
     }
 
     return status;
@@ -474,13 +517,12 @@ bool GruenbeckPlugin::saveConfiguration()
 bool GruenbeckPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    if (false == jsonFile.load(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration.");
         status = false;
     }
     else
@@ -491,17 +533,6 @@ bool GruenbeckPlugin::loadConfiguration()
     return status;
 }
 
-void GruenbeckPlugin::createConfigDirectory()
-{
-    if (false == FILESYSTEM.exists(CONFIG_PATH))
-    {
-        if (false == FILESYSTEM.mkdir(CONFIG_PATH))
-        {
-            LOG_WARNING("Couldn't create directory: %s", CONFIG_PATH);
-        }
-    }
-}
-
 void GruenbeckPlugin::lock() const
 {
     if (nullptr != m_xMutex)
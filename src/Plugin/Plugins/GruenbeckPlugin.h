@@ -44,12 +44,14 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include "AsyncHttpClient.h"
+#include "HttpClientPool.h"
 #include <stdint.h>
 #include "Plugin.hpp"
-#include <Canvas.h>
+#include <CanvasView.hpp>
 #include <BitmapWidget.h>
 #include <TextWidget.h>
+#include <EventTimer.hpp>
+#include <XmlTagExtractor.h>
 
 /******************************************************************************
  * Macros
@@ -63,7 +65,7 @@
  * Shows the remaining system capacity (parameter = D_Y_10_1 ) 
  * of the Gruenbeck softliQ SC18 via the system's RESTful webservice.
  */
-class GruenbeckPlugin : public Plugin
+class GruenbeckPlugin : public Plugin, public ITimerListener
 {
 public:
 
@@ -75,19 +77,19 @@ public:
      */
     GruenbeckPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_textCanvas(nullptr),
-        m_iconCanvas(nullptr),
+        m_isIconLoaded(false),
         m_bitmapWidget(),
         m_textWidget("\\calign?"),
         m_ipAddress("192.168.0.16"),
         m_configurationFilename(),
+        m_cfgGeneration(0U),
         m_httpResponseReceived(false),
+        m_hasContent(false),
         m_relevantResponsePart(),
-        m_requestTimer(),
+        m_requestTimer(*this),
         m_url(),
         m_callbackWebHandler(nullptr),
-        m_xMutex(nullptr),
-        m_isConnectionError(false)
+        m_xMutex(nullptr)
     {
         /* Move the text widget one line lower for better look. */
         m_textWidget.move(0, 1);
@@ -100,18 +102,6 @@ public:
      */
     ~GruenbeckPlugin()
     {
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
-
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
-
         if (nullptr != m_xMutex)
         {
             vSemaphoreDelete(m_xMutex);
@@ -135,17 +125,29 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
+     */
+    void unregisterWebInterface(PluginWebRouter& srv) final;
+
+    /**
+     * Prepare the plugin to be set active soon. It loads the icon from
+     * filesystem, so it is not necessary during the slot change anymore.
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void prepare() final;
+
+    /**
+     * Release the icon, because the heap runs low. It is loaded again by
+     * prepare() or active().
+     */
+    void releaseAssets() final;
 
     /**
      * This method will be called in case the plugin is set active, which means
@@ -169,6 +171,22 @@ public:
      */
     void update(IGfx& gfx) final;
 
+    /**
+     * Get the period in ms, in which the plugin shall be updated.
+     * The shown value changes only with a received response.
+     *
+     * @return Update period in ms
+     */
+    uint32_t getUpdatePeriod() const final;
+
+    /**
+     * Has the plugin content to show? It has as soon as the first valid
+     * data is received and as long as the requests are successful.
+     *
+     * @return If content is available, it will return true otherwise false.
+     */
+    bool hasContent() const final;
+
    /**
      * Stop the plugin.
      * Overwrite it if your plugin needs to know that it will be uninstalled.
@@ -182,11 +200,11 @@ public:
     void start() final;
     
     /**
-     * Process the plugin.
-     * Overwrite it if your plugin has cyclic stuff to do without being in a
-     * active slot.
+     * Will be called by the timer service, if one of the plugin timers timed out.
+     *
+     * @param[in] timer Event timer, which timed out
      */
-    void process(void) final;
+    void onTimeout(EventTimer& timer) final;
 
     /**
      * Get ip-address.
@@ -219,11 +237,6 @@ private:
      */
     static const char*      IMAGE_PATH;
 
-    /**
-     * Configuration path within the filesystem.
-     */
-    static const char*      CONFIG_PATH;
-
     /**
      * Period in ms for requesting data from server.
      * This is used in case the last request to the server was successful.
@@ -236,20 +249,27 @@ private:
      */
     static const uint32_t   UPDATE_PERIOD_SHORT = (10U * 1000U);
 
-    Canvas*                     m_textCanvas;               /**< Canvas used for the text widget. */
-    Canvas*                     m_iconCanvas;               /**< Canvas used for the bitmap widget. */
+    /**
+     * Period in ms for updating the display. A received response is shown
+     * not later than this.
+     */
+    static const uint32_t   DISPLAY_UPDATE_PERIOD   = 500U;
+
+    bool                        m_isIconLoaded;             /**< Is the icon loaded from filesystem? */
     BitmapWidget                m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
     TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. */
     String                      m_ipAddress;                /**< IP-address of the Gruenbeck server. */
-    String                      m_configurationFilename;    /**< String used for specifying the configuration filename. */
+    String                      m_configurationFilename;    /**< Name of the configuration file, which is imported if uploaded. */
+    uint32_t                    m_cfgGeneration;            /**< Filesystem generation of the last import check. */
     bool                        m_httpResponseReceived;     /**< Flag to indicate a received HTTP response. */
+    bool                        m_hasContent;               /**< Is valid data available, which can be shown? */
     String                      m_relevantResponsePart;     /**< String used for the relevant part of the HTTP response. */
-    AsyncHttpClient             m_client;                   /**< Asynchronous HTTP client. */
-    SimpleTimer                 m_requestTimer;             /**< Timer, used for cyclic request of new data. */
+    HttpClientPool::Request     m_httpRequest;              /**< HTTP request, which is sent via the HTTP client pool. */
+    XmlTagExtractor             m_xmlExtractor;             /**< Extracts the relevant value from the streamed response body. */
+    EventTimer                  m_requestTimer;             /**< Timer, used for cyclic request of new data. */
     String                      m_url;                      /**< REST API URL */
     AsyncCallbackWebHandler*    m_callbackWebHandler;       /**< Callback web handler */
     SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
-    bool                        m_isConnectionError;        /**< Is connection error happened? */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -267,25 +287,25 @@ private:
     bool startHttpRequest(void);
 
     /**
-     * Register callback function on response reception.
+     * Prepare the HTTP request and register its callback functions.
      */
-    void initHttpClient(void);
+    void initHttpRequest(void);
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the configuration store.
      */
     bool saveConfiguration();
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the configuration store.
      */
     bool loadConfiguration();
 
     /**
-     * If configuration directory doesn't exists, it will be created.
-     * Otherwise nothing happens.
+     * Load the icon from filesystem, if not already done.
+     * The plugin must be locked before.
      */
-    void createConfigDirectory();
+    void loadIcon();
 
     /**
      * Protect against concurrent access.
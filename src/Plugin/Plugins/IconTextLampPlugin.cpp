@@ -36,6 +36,7 @@
 #include "RestApi.h"
 #include "FileSystem.h"
 
+#include <ImageCache.h>
 #include <Logging.h>
 #include <ArduinoJson.h>
 
@@ -66,54 +67,35 @@ const char* IconTextLampPlugin::UPLOAD_PATH = "/tmp";
  * Public Methods
  *****************************************************************************/
 
-void IconTextLampPlugin::active(IGfx& gfx)
+void IconTextLampPlugin::prepare()
 {
     lock();
+    loadIconFile();
+    unlock();
 
-    if (nullptr == m_iconCanvas)
-    {
-        m_iconCanvas = new Canvas(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+    return;
+}
 
-        if (nullptr != m_iconCanvas)
-        {
-            (void)m_iconCanvas->addWidget(m_bitmapWidget);
+void IconTextLampPlugin::active(IGfx& gfx)
+{
+    uint8_t index = 0U;
 
-            /* If there is already a icon in the filesystem, load it. */
-            (void)m_bitmapWidget.load(FILESYSTEM, getFileName());
-        }
-    }
+    /* Usually already done by prepare(). */
+    lock();
+    loadIconFile();
+    unlock();
 
-    if (nullptr == m_textCanvas)
-    {
-        m_textCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, gfx.getHeight() - 2U, ICON_WIDTH, 0);
+    gfx.fillScreen(ColorDef::BLACK);
 
-        if (nullptr != m_textCanvas)
-        {
-            (void)m_textCanvas->addWidget(m_textWidget);
-        }
-    }
+    /* The display was cleared, therefore everything must be drawn again. */
+    m_bitmapWidget.invalidate();
+    m_textWidget.invalidate();
 
-    if (nullptr == m_lampCanvas)
+    for(index = 0U; index < MAX_LAMPS; ++index)
     {
-        m_lampCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, 1U, ICON_WIDTH, gfx.getHeight() - 1);
-
-        if (nullptr != m_lampCanvas)
-        {
-            uint8_t index = 0U;
-
-            for(index = 0U; index < MAX_LAMPS; ++index)
-            {
-                /* One space at the begin, two spaces between the lamps. */
-                int16_t x = (LampWidget::DEFAULT_WIDTH + 2) * index + 1;
-
-                (void)m_lampCanvas->addWidget(m_lampWidgets[index]);
-                m_lampWidgets[index].move(x, 0);
-            }
-        }
+        m_lampWidgets[index].invalidate();
     }
 
-    unlock();
-
     return;
 }
 
@@ -123,7 +105,7 @@ void IconTextLampPlugin::inactive()
     return;
 }
 
-void IconTextLampPlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void IconTextLampPlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_urlIcon = baseUri + "/bitmap";
     m_callbackWebHandlerIcon = &srv.on( m_urlIcon.c_str(),
@@ -169,7 +151,7 @@ void IconTextLampPlugin::registerWebInterface(AsyncWebServer& srv, const String&
     return;
 }
 
-void IconTextLampPlugin::unregisterWebInterface(AsyncWebServer& srv)
+void IconTextLampPlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_urlIcon.c_str());
 
@@ -212,26 +194,46 @@ void IconTextLampPlugin::unregisterWebInterface(AsyncWebServer& srv)
 
 void IconTextLampPlugin::update(IGfx& gfx)
 {
-    lock();
-
-    gfx.fillScreen(ColorDef::BLACK);
+    const String*       text    = m_textState.fetch();
+    const BitmapWidget* icon    = m_iconState.fetch();
+    const uint8_t*      lamps   = m_lampState.fetch();
+    CanvasView          iconView(gfx, 0, 0, ICON_WIDTH, ICON_HEIGHT);
+    CanvasView          textView(gfx, ICON_WIDTH, 0, gfx.getWidth() - ICON_WIDTH, gfx.getHeight() - 2U);
+    uint8_t             index   = 0U;
 
-    if (nullptr != m_iconCanvas)
+    /* Only new states need to be taken over. */
+    if (nullptr != text)
     {
-        m_iconCanvas->update(gfx);
+        m_textWidget.setFormatStr(*text);
     }
 
-    if (nullptr != m_textCanvas)
+    if (nullptr != icon)
     {
-        m_textCanvas->update(gfx);
+        m_bitmapWidget = *icon;
     }
 
-    if (nullptr != m_lampCanvas)
+    if (nullptr != lamps)
     {
-        m_lampCanvas->update(gfx);
+        for(index = 0U; index < MAX_LAMPS; ++index)
+        {
+            m_lampWidgets[index].setOnState(0U != (*lamps & (1U << index)));
+        }
     }
 
-    unlock();
+    /* Every widget owns its own window onto the display, which is only
+     * drawn again if the widget is invalid.
+     */
+    (void)iconView.drawWidget(m_bitmapWidget);
+    (void)textView.drawWidget(m_textWidget);
+
+    for(index = 0U; index < MAX_LAMPS; ++index)
+    {
+        /* One space at the begin, two spaces between the lamps. */
+        int16_t     x = ICON_WIDTH + (LampWidget::DEFAULT_WIDTH + 2) * index + 1;
+        CanvasView  lampView(gfx, x, gfx.getHeight() - 1, LampWidget::DEFAULT_WIDTH, 1U);
+
+        (void)lampView.drawWidget(m_lampWidgets[index]);
+    }
 
     return;
 }
@@ -241,7 +243,7 @@ String IconTextLampPlugin::getText() const
     String formattedText;
 
     lock();
-    formattedText = m_textWidget.getFormatStr();
+    formattedText = m_text;
     unlock();
 
     return formattedText;
@@ -249,13 +251,53 @@ String IconTextLampPlugin::getText() const
 
 void IconTextLampPlugin::setText(const String& formatText)
 {
-    unlock();
-    m_textWidget.setFormatStr(formatText);
+    lock();
+    m_text = formatText;
+    m_textState.publish(m_text);
     unlock();
 
     return;
 }
 
+bool IconTextLampPlugin::applySettings(JsonObjectConst settings)
+{
+    bool                status  = true;
+    JsonVariantConst    text    = settings["text"];
+    JsonVariantConst    lamps   = settings["lamps"];
+
+    if (false == text.isNull())
+    {
+        if (false == text.is<const char*>())
+        {
+            status = false;
+        }
+        else
+        {
+            setText(text.as<const char*>());
+        }
+    }
+
+    if (false == lamps.isNull())
+    {
+        if ((false == lamps.is<JsonArrayConst>()) ||
+            (MAX_LAMPS < lamps.size()))
+        {
+            status = false;
+        }
+        else
+        {
+            uint8_t lampId = 0U;
+
+            for(lampId = 0U; lampId < lamps.size(); ++lampId)
+            {
+                setLamp(lampId, lamps[lampId].as<bool>());
+            }
+        }
+    }
+
+    return status;
+}
+
 void IconTextLampPlugin::setBitmap(const Color* bitmap, uint16_t width, uint16_t height)
 {
     if ((nullptr != bitmap) &&
@@ -263,7 +305,13 @@ void IconTextLampPlugin::setBitmap(const Color* bitmap, uint16_t width, uint16_t
         (ICON_HEIGHT >= height))
     {
         lock();
-        m_bitmapWidget.set(bitmap, width, height);
+
+        if (true == m_icon.set(bitmap, width, height))
+        {
+            m_iconState.publish(m_icon);
+            m_isIconSet = true;
+        }
+
         unlock();
     }
 
@@ -275,7 +323,15 @@ bool IconTextLampPlugin::loadBitmap(const String& filename)
     bool status = false;
 
     lock();
-    status = m_bitmapWidget.load(FILESYSTEM, filename);
+
+    status = m_icon.load(FILESYSTEM, filename);
+
+    if (true == status)
+    {
+        m_iconState.publish(m_icon);
+        m_isIconSet = true;
+    }
+
     unlock();
 
     return status;
@@ -288,7 +344,7 @@ bool IconTextLampPlugin::getLamp(uint8_t lampId) const
     if (MAX_LAMPS > lampId)
     {
         lock();
-        lampState = m_lampWidgets[lampId].getOnState();
+        lampState = (0U != (m_lamps & (1U << lampId)));
         unlock();
     }
 
@@ -300,7 +356,17 @@ void IconTextLampPlugin::setLamp(uint8_t lampId, bool state)
     if (MAX_LAMPS > lampId)
     {
         lock();
-        m_lampWidgets[lampId].setOnState(state);
+
+        if (true == state)
+        {
+            m_lamps |= (1U << lampId);
+        }
+        else
+        {
+            m_lamps &= ~(1U << lampId);
+        }
+
+        m_lampState.publish(m_lamps);
         unlock();
     }
 
@@ -315,9 +381,24 @@ void IconTextLampPlugin::setLamp(uint8_t lampId, bool state)
  * Private Methods
  *****************************************************************************/
 
+void IconTextLampPlugin::loadIconFile()
+{
+    /* If there is already a icon in the filesystem, load it once. */
+    if (false == m_isIconSet)
+    {
+        if (true == m_icon.load(FILESYSTEM, getFileName()))
+        {
+            m_iconState.publish(m_icon);
+        }
+
+        m_isIconSet = true;
+    }
+
+    return;
+}
+
 void IconTextLampPlugin::webReqHandlerText(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -381,15 +462,13 @@ void IconTextLampPlugin::webReqHandlerText(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
 void IconTextLampPlugin::webReqHandlerIcon(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -445,8 +524,7 @@ void IconTextLampPlugin::webReqHandlerIcon(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -511,6 +589,9 @@ void IconTextLampPlugin::iconUploadHandler(AsyncWebServerRequest *request, const
             LOG_INFO("Upload of %s finished.", filename.c_str());
 
             m_fd.close();
+
+            /* The file was changed, therefore a cached image is outdated. */
+            ImageCache::getInstance().invalidate(getFileName());
         }
     }
 
@@ -519,7 +600,6 @@ void IconTextLampPlugin::iconUploadHandler(AsyncWebServerRequest *request, const
 
 void IconTextLampPlugin::webReqHandlerLamps(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -567,15 +647,13 @@ void IconTextLampPlugin::webReqHandlerLamps(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
 void IconTextLampPlugin::webReqHandlerLamp(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -670,8 +748,7 @@ void IconTextLampPlugin::webReqHandlerLamp(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -47,10 +47,11 @@
 #include "Plugin.hpp"
 
 #include <FS.h>
-#include <Canvas.h>
+#include <CanvasView.hpp>
 #include <BitmapWidget.h>
 #include <TextWidget.h>
 #include <LampWidget.h>
+#include <StateBuffer.hpp>
 
 /******************************************************************************
  * Macros
@@ -82,12 +83,16 @@ public:
      */
     IconTextLampPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_iconCanvas(nullptr),
-        m_textCanvas(nullptr),
-        m_lampCanvas(nullptr),
         m_bitmapWidget(),
         m_textWidget(),
         m_lampWidgets(),
+        m_text(),
+        m_icon(),
+        m_lamps(0U),
+        m_isIconSet(false),
+        m_textState(),
+        m_iconState(),
+        m_lampState(),
         m_urlIcon(),
         m_urlText(),
         m_urlLamps(),
@@ -100,7 +105,7 @@ public:
         m_isUploadError(false),
         m_xMutex(nullptr)
     {
-        m_xMutex = xSemaphoreCreateMutex();
+        m_xMutex = xSemaphoreCreateRecursiveMutex();
     }
 
     /**
@@ -108,24 +113,6 @@ public:
      */
     ~IconTextLampPlugin()
     {
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
-
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
-
-        if (nullptr != m_lampCanvas)
-        {
-            delete m_lampCanvas;
-            m_lampCanvas = nullptr;
-        }
-
         if (nullptr != m_xMutex)
         {
             vSemaphoreDelete(m_xMutex);
@@ -146,6 +133,13 @@ public:
         return new IconTextLampPlugin(name, uid);
     }
 
+    /**
+     * Prepare the plugin to be set active soon. It creates the icon canvas
+     * and loads the icon from filesystem, so it is not necessary during the
+     * slot change anymore.
+     */
+    void prepare() final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -163,17 +157,17 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void unregisterWebInterface(PluginWebRouter& srv) final;
 
     /**
      * Update the display.
@@ -197,6 +191,16 @@ public:
      */
     void setText(const String& formatText);
 
+    /**
+     * Apply plugin specific settings.
+     * Supported: "text" with the formatted text and "lamps" with the lamp states.
+     *
+     * @param[in] settings  Plugin specific settings
+     *
+     * @return If all settings are applied, it will return true otherwise false.
+     */
+    bool applySettings(JsonObjectConst settings) final;
+
     /**
      * Set bitmap in raw RGB888 format.
      *
@@ -254,12 +258,16 @@ private:
      */
     static const char*      UPLOAD_PATH;
 
-    Canvas*                     m_iconCanvas;               /**< Canvas used for the bitmap widget. */
-    Canvas*                     m_textCanvas;               /**< Canvas used for the text widget. */
-    Canvas*                     m_lampCanvas;               /**< Canvas used for the lamp widget. */
-    BitmapWidget                m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
-    TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. */
-    LampWidget                  m_lampWidgets[MAX_LAMPS];   /**< Lamp widgets, used to signal different things. */
+    BitmapWidget                m_bitmapWidget;             /**< Bitmap widget, used to show the icon. Only used by the display task. */
+    TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. Only used by the display task. */
+    LampWidget                  m_lampWidgets[MAX_LAMPS];   /**< Lamp widgets, used to signal different things. Only used by the display task. */
+    String                      m_text;                     /**< Text, which was set last */
+    BitmapWidget                m_icon;                     /**< Icon, which was set last */
+    uint8_t                     m_lamps;                    /**< Lamp states, which were set last. One bit per lamp. */
+    bool                        m_isIconSet;                /**< Is a icon set or was the icon file loaded? */
+    StateBuffer<String>         m_textState;                /**< Publishes the text to the display task without locking. */
+    StateBuffer<BitmapWidget>   m_iconState;                /**< Publishes the icon to the display task without locking. */
+    StateBuffer<uint8_t>        m_lampState;                /**< Publishes the lamp states to the display task without locking. */
     String                      m_urlIcon;                  /**< REST API URL for updating the icon. */
     String                      m_urlText;                  /**< REST API URL to get/set the text. */
     String                      m_urlLamps;                 /**< REST API URL to get all lamp states. */
@@ -270,7 +278,7 @@ private:
     AsyncCallbackWebHandler*    m_callbackWebHandlerLamp;   /**< Callback web handler for updating single lamps. */
     File                        m_fd;                       /**< File descriptor, used for bitmap file upload. */
     bool                        m_isUploadError;            /**< Flag to signal a upload error. */
-    SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
+    SemaphoreHandle_t           m_xMutex;                   /**< Mutex to serialize the writers, never taken by update(). */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -324,12 +332,18 @@ private:
     String getFileName(void);
 
     /**
-     * Protect against concurrent access.
+     * Load the icon from filesystem and publish it, if no icon is set yet.
+     * The plugin must be locked before.
+     */
+    void loadIconFile();
+
+    /**
+     * Protect against concurrent access of the writers.
      */
     void lock(void) const;
 
     /**
-     * Unprotect against concurrent access.
+     * Unprotect against concurrent access of the writers.
      */
     void unlock(void) const;
 };
@@ -36,6 +36,7 @@
 #include "RestApi.h"
 #include "FileSystem.h"
 
+#include <ImageCache.h>
 #include <Logging.h>
 #include <ArduinoJson.h>
 
@@ -66,26 +67,21 @@ const char* IconTextPlugin::UPLOAD_PATH = "/tmp";
  * Public Methods
  *****************************************************************************/
 
-void IconTextPlugin::active(IGfx& gfx)
+void IconTextPlugin::start()
 {
-    lock();
-
     if (nullptr == m_iconCanvas)
     {
-        m_iconCanvas = new Canvas(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+        m_iconCanvas = createResource<Canvas>(ICON_WIDTH, ICON_HEIGHT, 0, 0);
 
         if (nullptr != m_iconCanvas)
         {
-            (void)m_iconCanvas->addWidget(m_bitmapWidget);
-
-            /* If there is already a icon in the filesystem, load it. */
-            (void)m_bitmapWidget.load(FILESYSTEM, getFileName());
+            (void)m_iconCanvas->addWidget(m_spriteWidget);
         }
     }
 
     if (nullptr == m_textCanvas)
     {
-        m_textCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, gfx.getHeight(), ICON_WIDTH, 0);
+        m_textCanvas = createResource<Canvas>(DISPLAY_WIDTH - ICON_WIDTH, DISPLAY_HEIGHT, ICON_WIDTH, 0);
 
         if (nullptr != m_textCanvas)
         {
@@ -96,18 +92,48 @@ void IconTextPlugin::active(IGfx& gfx)
         }
     }
 
+    return;
+}
+
+void IconTextPlugin::prepare()
+{
+    lock();
+    loadIconFile();
     unlock();
 
     return;
 }
 
+void IconTextPlugin::active(IGfx& gfx)
+{
+    /* Usually already done by prepare(). */
+    lock();
+    loadIconFile();
+    unlock();
+
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* The display was cleared, therefore everything must be drawn again. */
+    if (nullptr != m_iconCanvas)
+    {
+        m_iconCanvas->invalidate();
+    }
+
+    if (nullptr != m_textCanvas)
+    {
+        m_textCanvas->invalidate();
+    }
+
+    return;
+}
+
 void IconTextPlugin::inactive()
 {
     /* Nothing to do. */
     return;
 }
 
-void IconTextPlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void IconTextPlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_urlIcon = baseUri + "/bitmap";
     m_callbackWebHandlerIcon = &srv.on( m_urlIcon.c_str(),
@@ -135,7 +161,7 @@ void IconTextPlugin::registerWebInterface(AsyncWebServer& srv, const String& bas
     return;
 }
 
-void IconTextPlugin::unregisterWebInterface(AsyncWebServer& srv)
+void IconTextPlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_urlIcon.c_str());
 
@@ -160,9 +186,19 @@ void IconTextPlugin::unregisterWebInterface(AsyncWebServer& srv)
 
 void IconTextPlugin::update(IGfx& gfx)
 {
-    lock();
+    const String*       text    = m_textState.fetch();
+    const SpriteWidget* icon    = m_iconState.fetch();
 
-    gfx.fillScreen(ColorDef::BLACK);
+    /* Only new states need to be taken over. */
+    if (nullptr != text)
+    {
+        m_textWidget.setFormatStr(*text);
+    }
+
+    if (nullptr != icon)
+    {
+        m_spriteWidget = *icon;
+    }
 
     if (nullptr != m_iconCanvas)
     {
@@ -174,8 +210,6 @@ void IconTextPlugin::update(IGfx& gfx)
         m_textCanvas->update(gfx);
     }
 
-    unlock();
-
     return;
 }
 
@@ -184,7 +218,7 @@ String IconTextPlugin::getText() const
     String formattedText;
 
     lock();
-    formattedText = m_textWidget.getFormatStr();
+    formattedText = m_text;
     unlock();
 
     return formattedText;
@@ -193,12 +227,33 @@ String IconTextPlugin::getText() const
 void IconTextPlugin::setText(const String& formatText)
 {
     lock();
-    m_textWidget.setFormatStr(formatText);
+    m_text = formatText;
+    m_textState.publish(m_text);
     unlock();
 
     return;
 }
 
+bool IconTextPlugin::applySettings(JsonObjectConst settings)
+{
+    bool                status  = true;
+    JsonVariantConst    text    = settings["text"];
+
+    if (false == text.isNull())
+    {
+        if (false == text.is<const char*>())
+        {
+            status = false;
+        }
+        else
+        {
+            setText(text.as<const char*>());
+        }
+    }
+
+    return status;
+}
+
 void IconTextPlugin::setBitmap(const Color* bitmap, uint16_t width, uint16_t height)
 {
     if ((nullptr != bitmap) &&
@@ -206,7 +261,13 @@ void IconTextPlugin::setBitmap(const Color* bitmap, uint16_t width, uint16_t hei
         (ICON_HEIGHT >= height))
     {
         lock();
-        m_bitmapWidget.set(bitmap, width, height);
+
+        if (true == m_icon.set(bitmap, width, height, width))
+        {
+            m_iconState.publish(m_icon);
+            m_isIconSet = true;
+        }
+
         unlock();
     }
 
@@ -218,7 +279,15 @@ bool IconTextPlugin::loadBitmap(const String& filename)
     bool status = false;
 
     lock();
-    status = m_bitmapWidget.load(FILESYSTEM, filename);
+
+    status = m_icon.load(FILESYSTEM, filename);
+
+    if (true == status)
+    {
+        m_iconState.publish(m_icon);
+        m_isIconSet = true;
+    }
+
     unlock();
 
     return status;
@@ -232,9 +301,24 @@ bool IconTextPlugin::loadBitmap(const String& filename)
  * Private Methods
  *****************************************************************************/
 
+void IconTextPlugin::loadIconFile()
+{
+    /* If there is already a icon in the filesystem, load it once. */
+    if (false == m_isIconSet)
+    {
+        if (true == m_icon.load(FILESYSTEM, getFileName()))
+        {
+            m_iconState.publish(m_icon);
+        }
+
+        m_isIconSet = true;
+    }
+
+    return;
+}
+
 void IconTextPlugin::webReqHandlerText(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -298,15 +382,13 @@ void IconTextPlugin::webReqHandlerText(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
 void IconTextPlugin::webReqHandlerIcon(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -362,8 +444,7 @@ void IconTextPlugin::webReqHandlerIcon(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -428,6 +509,9 @@ void IconTextPlugin::iconUploadHandler(AsyncWebServerRequest *request, const Str
             LOG_INFO("Upload of %s finished.", filename.c_str());
 
             m_fd.close();
+
+            /* The file was changed, therefore a cached image is outdated. */
+            ImageCache::getInstance().invalidate(getFileName());
         }
     }
 
@@ -48,8 +48,9 @@
 
 #include <FS.h>
 #include <Canvas.h>
-#include <BitmapWidget.h>
+#include <SpriteWidget.h>
 #include <TextWidget.h>
+#include <StateBuffer.hpp>
 
 /******************************************************************************
  * Macros
@@ -81,8 +82,13 @@ public:
         Plugin(name, uid),
         m_textCanvas(nullptr),
         m_iconCanvas(nullptr),
-        m_bitmapWidget(),
+        m_spriteWidget(),
         m_textWidget(),
+        m_text(),
+        m_icon(),
+        m_isIconSet(false),
+        m_textState(),
+        m_iconState(),
         m_urlIcon(),
         m_urlText(),
         m_callbackWebHandlerIcon(nullptr),
@@ -91,7 +97,7 @@ public:
         m_isUploadError(false),
         m_xMutex(nullptr)
     {
-        m_xMutex = xSemaphoreCreateMutex();
+        m_xMutex = xSemaphoreCreateRecursiveMutex();
     }
 
     /**
@@ -99,17 +105,8 @@ public:
      */
     ~IconTextPlugin()
     {
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
-
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
+        destroyResource(m_iconCanvas);
+        destroyResource(m_textCanvas);
 
         if (nullptr != m_xMutex)
         {
@@ -131,6 +128,18 @@ public:
         return new IconTextPlugin(name, uid);
     }
 
+    /**
+     * Start the plugin.
+     * The canvases are created once here, so the activation allocates nothing.
+     */
+    void start() final;
+
+    /**
+     * Prepare the plugin to be set active soon. It loads the icon from
+     * filesystem, so it is not necessary during the slot change anymore.
+     */
+    void prepare() final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -148,17 +157,17 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void unregisterWebInterface(PluginWebRouter& srv) final;
 
     /**
      * Update the display.
@@ -182,6 +191,16 @@ public:
      */
     void setText(const String& formatText);
 
+    /**
+     * Apply plugin specific settings.
+     * Supported: "text" with the formatted text.
+     *
+     * @param[in] settings  Plugin specific settings
+     *
+     * @return If all settings are applied, it will return true otherwise false.
+     */
+    bool applySettings(JsonObjectConst settings) final;
+
     /**
      * Set bitmap in raw RGB888 format.
      *
@@ -192,7 +211,8 @@ public:
     void setBitmap(const Color* bitmap, uint16_t width, uint16_t height);
 
     /**
-     * Load bitmap from filesystem.
+     * Load bitmap from filesystem. A bitmap, which width is a multiple of
+     * its height, is a sprite sheet with square frames and shown as animation.
      *
      * @param[in] filename  Bitmap filename
      *
@@ -218,16 +238,21 @@ private:
     static const char*  UPLOAD_PATH;
 
     Canvas*                     m_textCanvas;               /**< Canvas used for the text widget. */
-    Canvas*                     m_iconCanvas;               /**< Canvas used for the bitmap widget. */
-    BitmapWidget                m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
-    TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. */
+    Canvas*                     m_iconCanvas;               /**< Canvas used for the sprite widget. */
+    SpriteWidget                m_spriteWidget;             /**< Sprite widget, used to show the (animated) icon. Only used by the display task. */
+    TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. Only used by the display task. */
+    String                      m_text;                     /**< Text, which was set last */
+    SpriteWidget                m_icon;                     /**< Icon, which was set last */
+    bool                        m_isIconSet;                /**< Is a icon set or was the icon file loaded? */
+    StateBuffer<String>         m_textState;                /**< Publishes the text to the display task without locking. */
+    StateBuffer<SpriteWidget>   m_iconState;                /**< Publishes the icon to the display task without locking. */
     String                      m_urlIcon;                  /**< REST API URL for updating the icon */
     String                      m_urlText;                  /**< REST API URL for updating the text */
     AsyncCallbackWebHandler*    m_callbackWebHandlerIcon;   /**< Callback web handler for updating the icon */
     AsyncCallbackWebHandler*    m_callbackWebHandlerText;   /**< Callback web handler for updating the text */
     File                        m_fd;                       /**< File descriptor, used for bitmap file upload. */
     bool                        m_isUploadError;            /**< Flag to signal a upload error. */
-    SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
+    SemaphoreHandle_t           m_xMutex;                   /**< Mutex to serialize the writers, never taken by update(). */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -265,12 +290,18 @@ private:
     String getFileName(void);
 
     /**
-     * Protect against concurrent access.
+     * Load the icon from filesystem and publish it, if no icon is set yet.
+     * The plugin must be locked before.
+     */
+    void loadIconFile();
+
+    /**
+     * Protect against concurrent access of the writers.
      */
     void lock(void) const;
 
     /**
-     * Unprotect against concurrent access.
+     * Unprotect against concurrent access of the writers.
      */
     void unlock(void) const;
 };
@@ -63,7 +63,7 @@
  * Public Methods
  *****************************************************************************/
 
-void JustTextPlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void JustTextPlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_url = baseUri + "/text";
 
@@ -78,7 +78,7 @@ void JustTextPlugin::registerWebInterface(AsyncWebServer& srv, const String& bas
     return;
 }
 
-void JustTextPlugin::unregisterWebInterface(AsyncWebServer& srv)
+void JustTextPlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_url.c_str());
 
@@ -94,10 +94,16 @@ void JustTextPlugin::unregisterWebInterface(AsyncWebServer& srv)
 
 void JustTextPlugin::update(IGfx& gfx)
 {
-    lock();
+    const String* text = m_textState.fetch();
+
+    /* Only a new text needs to be taken over. */
+    if (nullptr != text)
+    {
+        m_textWidget.setFormatStr(*text);
+    }
+
     gfx.fillScreen(ColorDef::BLACK);
     m_textWidget.update(gfx);
-    unlock();
 
     return;
 }
@@ -107,7 +113,7 @@ String JustTextPlugin::getText() const
     String formattedText;
 
     lock();
-    formattedText = m_textWidget.getFormatStr();
+    formattedText = m_text;
     unlock();
 
     return formattedText;
@@ -116,12 +122,33 @@ String JustTextPlugin::getText() const
 void JustTextPlugin::setText(const String& formatText)
 {
     lock();
-    m_textWidget.setFormatStr(formatText);
+    m_text = formatText;
+    m_textState.publish(m_text);
     unlock();
 
     return;
 }
 
+bool JustTextPlugin::applySettings(JsonObjectConst settings)
+{
+    bool                status  = true;
+    JsonVariantConst    text    = settings["text"];
+
+    if (false == text.isNull())
+    {
+        if (false == text.is<const char*>())
+        {
+            status = false;
+        }
+        else
+        {
+            setText(text.as<const char*>());
+        }
+    }
+
+    return status;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -132,7 +159,6 @@ void JustTextPlugin::setText(const String& formatText)
 
 void JustTextPlugin::webReqHandler(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -196,8 +222,7 @@ void JustTextPlugin::webReqHandler(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -47,6 +47,7 @@
 #include "Plugin.hpp"
 
 #include <TextWidget.h>
+#include <StateBuffer.hpp>
 
 /******************************************************************************
  * Macros
@@ -76,6 +77,8 @@ public:
     JustTextPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
         m_textWidget(),
+        m_text(),
+        m_textState(),
         m_url(),
         m_callbackWebHandler(nullptr),
         m_xMutex(nullptr)
@@ -83,7 +86,7 @@ public:
         /* Move the text widget one line lower for better look. */
         m_textWidget.move(0, 1);
 
-        m_xMutex = xSemaphoreCreateMutex();
+        m_xMutex = xSemaphoreCreateRecursiveMutex();
     }
 
     /**
@@ -114,17 +117,17 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void unregisterWebInterface(PluginWebRouter& srv) final;
 
     /**
      * Update the display.
@@ -148,12 +151,24 @@ public:
      */
     void setText(const String& formatText);
 
+    /**
+     * Apply plugin specific settings.
+     * Supported: "text" with the formatted text.
+     *
+     * @param[in] settings  Plugin specific settings
+     *
+     * @return If all settings are applied, it will return true otherwise false.
+     */
+    bool applySettings(JsonObjectConst settings) final;
+
 private:
 
-    TextWidget                  m_textWidget;           /**< Text widget, used for showing the text. */
+    TextWidget                  m_textWidget;           /**< Text widget, used for showing the text. Only used by update(). */
+    String                      m_text;                 /**< Text, which was set last */
+    StateBuffer<String>         m_textState;            /**< Publishes the text to update() without locking. */
     String                      m_url;                  /**< REST API URL */
     AsyncCallbackWebHandler*    m_callbackWebHandler;   /**< Callback web handler */
-    SemaphoreHandle_t           m_xMutex;               /**< Mutex to protect against concurrent access. */
+    SemaphoreHandle_t           m_xMutex;               /**< Mutex to serialize the writers, never taken by update(). */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -164,12 +179,12 @@ private:
     void webReqHandler(AsyncWebServerRequest *request);
 
     /**
-     * Protect against concurrent access.
+     * Protect against concurrent access of the writers.
      */
     void lock(void) const;
 
     /**
-     * Unprotect against concurrent access.
+     * Unprotect against concurrent access of the writers.
      */
     void unlock(void) const;
 };
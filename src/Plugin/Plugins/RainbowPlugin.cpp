@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "RainbowPlugin.h"
+#include "Board.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -60,21 +61,9 @@
 
 void RainbowPlugin::update(IGfx& gfx)
 {
-    int16_t x       = 0;
-    int16_t y       = 0;
-    uint8_t angle   = m_angle;
-    Color   color;
-
-    for(x = 0; x < gfx.getWidth(); ++x)
-    {
-        for(y = 0; y < gfx.getHeight(); ++y)
-        {
-            color.turnColorWheel(angle + y * ANGLE_DELTA);
-            gfx.drawPixel(x, y, color);
-        }
-
-        angle += ANGLE_DELTA;
-    }
+    RainbowKernel kernel;
+
+    EffectRunner::forEachRow<Board::LedMatrix::width, Board::LedMatrix::height>(gfx, kernel, m_angle);
 
     m_angle += ANGLE_DELTA;
 
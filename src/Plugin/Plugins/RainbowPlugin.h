@@ -46,6 +46,8 @@
 #include <stdint.h>
 #include "Plugin.hpp"
 
+#include <EffectRunner.hpp>
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -107,6 +109,35 @@ private:
     static const uint8_t    ANGLE_DELTA = 1U;
 
     uint8_t m_angle;    /**< Current color wheel angle */
+
+    /**
+     * Rainbow row kernel, which uses the effect time as start angle.
+     * The color wheel is precalculated, so a span is a sequence of table
+     * lookups.
+     */
+    struct RainbowKernel
+    {
+        /**
+         * Calculate the colors of a span.
+         *
+         * @param[in]  x        x-coordinate of the first pixel
+         * @param[in]  y        y-coordinate of the first pixel
+         * @param[in]  time     Start angle of the color wheel
+         * @param[out] colors   Colors of the span
+         * @param[in]  length   Number of pixels
+         */
+        inline void operator()(int16_t x, int16_t y, uint32_t time, Color* colors, uint16_t length) const
+        {
+            uint8_t     angle   = time + (x + y) * ANGLE_DELTA;
+            uint16_t    index   = 0U;
+
+            for(index = 0U; index < length; ++index)
+            {
+                colors[index].turnColorWheel(angle);
+                angle += ANGLE_DELTA;
+            }
+        }
+    };
 };
 
 /******************************************************************************
@@ -0,0 +1,313 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Remote frame plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "RemoteFramePlugin.h"
+#include "RestApi.h"
+
+#include <Logging.h>
+#include <ArduinoJson.h>
+#include <FramePatch.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static Color from565(uint16_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize constants */
+const size_t RemoteFramePlugin::MAX_FRAME_SIZE = FramePatch::HEADER_SIZE + (FramePatch::RUN_SIZE * FRAME_WIDTH * FRAME_HEIGHT);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void RemoteFramePlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
+{
+    m_url = baseUri + "/frame";
+    m_callbackWebHandler = &srv.on( m_url.c_str(),
+                                    HTTP_ANY,
+                                    [this](AsyncWebServerRequest *request)
+                                    {
+                                        this->webReqHandler(request);
+                                    },
+                                    nullptr,
+                                    [this](AsyncWebServerRequest *request, uint8_t* data, size_t len, size_t index, size_t total)
+                                    {
+                                        this->bodyHandler(request, data, len, index, total);
+                                    });
+
+    LOG_INFO("[%s] Register: %s", getName(), m_url.c_str());
+
+    return;
+}
+
+void RemoteFramePlugin::unregisterWebInterface(PluginWebRouter& srv)
+{
+    LOG_INFO("[%s] Unregister: %s", getName(), m_url.c_str());
+
+    if (false == srv.removeHandler(m_callbackWebHandler))
+    {
+        LOG_WARNING("Couldn't remove %s handler.", this->getName());
+    }
+
+    m_callbackWebHandler = nullptr;
+
+    return;
+}
+
+void RemoteFramePlugin::active(IGfx& gfx)
+{
+    /* Show the last pushed frame immediately. */
+    drawFrame(gfx, m_frames.get());
+
+    return;
+}
+
+void RemoteFramePlugin::inactive()
+{
+    /* Nothing to do. */
+    return;
+}
+
+void RemoteFramePlugin::update(IGfx& gfx)
+{
+    const Frame* frame = m_frames.fetch();
+
+    /* Only a new frame needs to be drawn, the canvas keeps its content. */
+    if (nullptr != frame)
+    {
+        drawFrame(gfx, *frame);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void RemoteFramePlugin::webReqHandler(AsyncWebServerRequest *request)
+{
+    const size_t        JSON_DOC_SIZE   = 256U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const char*         msg             = nullptr;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_POST != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else if (MAX_FRAME_SIZE < request->contentLength())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "Frame too large.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_PAYLOAD_TOO_LARGE;
+    }
+    else if (nullptr == request->_tempObject)
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "Frame missing.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
+    else if (false == applyFrame(static_cast<const uint8_t*>(request->_tempObject), request->contentLength(), msg))
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = msg;
+        httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
+    else
+    {
+        JsonObject dataObj = jsonDoc.createNestedObject("data");
+
+        /* Prepare response */
+        dataObj["sequence"] = m_lastSequence;
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    }
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
+
+    return;
+}
+
+void RemoteFramePlugin::bodyHandler(AsyncWebServerRequest *request, uint8_t* data, size_t len, size_t index, size_t total)
+{
+    if ((nullptr != request) &&
+        (nullptr != data) &&
+        (MAX_FRAME_SIZE >= total) &&
+        (total >= (index + len)))
+    {
+        if (0U == index)
+        {
+            request->_tempObject = malloc(total);
+        }
+
+        if (nullptr != request->_tempObject)
+        {
+            memcpy(&static_cast<uint8_t*>(request->_tempObject)[index], data, len);
+        }
+    }
+
+    return;
+}
+
+bool RemoteFramePlugin::applyFrame(const uint8_t* buffer, size_t size, const char*& msg)
+{
+    FramePatch  patch;
+    bool        isApplied   = false;
+
+    if (false == FramePatch::decode(buffer, size, patch))
+    {
+        msg = "Invalid frame.";
+    }
+    /* Drop stale frames, which are received out of order. */
+    else if ((true == m_isSequenceValid) &&
+             (0U != patch.sequence) &&
+             (false == FramePatch::isNewer(patch.sequence, m_lastSequence)))
+    {
+        msg = "Stale frame.";
+    }
+    else if (false == patch.apply(m_webFrame.pixels, FRAME_WIDTH, FRAME_HEIGHT))
+    {
+        msg = "Invalid frame.";
+    }
+    else
+    {
+        m_lastSequence      = patch.sequence;
+        m_isSequenceValid   = true;
+
+        m_frames.publish(m_webFrame);
+
+        isApplied = true;
+    }
+
+    return isApplied;
+}
+
+void RemoteFramePlugin::drawFrame(IGfx& gfx, const Frame& frame)
+{
+    Color   row[FRAME_WIDTH];
+    int16_t width   = gfx.getWidth();
+    int16_t height  = gfx.getHeight();
+    int16_t x       = 0;
+    int16_t y       = 0;
+
+    if (FRAME_WIDTH < width)
+    {
+        width = FRAME_WIDTH;
+    }
+
+    if (FRAME_HEIGHT < height)
+    {
+        height = FRAME_HEIGHT;
+    }
+
+    for(y = 0; y < height; ++y)
+    {
+        const uint16_t* pixels = &frame.pixels[y * FRAME_WIDTH];
+
+        for(x = 0; x < width; ++x)
+        {
+            row[x] = from565(pixels[x]);
+        }
+
+        gfx.writeSpan(0, y, row, width);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a color in 5-6-5 RGB format. The lower bits are filled up with
+ * the upper bits, so that white stays white.
+ *
+ * @param[in] value Color in 5-6-5 RGB format
+ *
+ * @return Color
+ */
+static Color from565(uint16_t value)
+{
+    const uint8_t RED5      = (value >> 11U) & 0x1fU;
+    const uint8_t GREEN6    = (value >> 5U) & 0x3fU;
+    const uint8_t BLUE5     = (value >> 0U) & 0x1fU;
+
+    return Color((RED5 << 3U) | (RED5 >> 2U), (GREEN6 << 2U) | (GREEN6 >> 4U), (BLUE5 << 3U) | (BLUE5 >> 2U));
+}
@@ -0,0 +1,217 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Remote frame plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __REMOTEFRAMEPLUGIN_H__
+#define __REMOTEFRAMEPLUGIN_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "Plugin.hpp"
+#include "Board.h"
+
+#include <StateBuffer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Shows content, which is rendered somewhere else, e.g. charts of a
+ * dashboard server. The server pushes a full or partial frame in RGB565,
+ * optionally run-length encoded, via REST API (see FramePatch). The frame
+ * is kept in memory only, the filesystem is not used.
+ *
+ * Every frame has a sequence number, older frames are dropped. A sequence
+ * number of 0 restarts the sequence, e.g. after the server restarted.
+ */
+class RemoteFramePlugin : public Plugin
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    RemoteFramePlugin(const String& name, uint16_t uid) :
+        Plugin(name, uid),
+        m_url(),
+        m_callbackWebHandler(nullptr),
+        m_frames(),
+        m_webFrame(),
+        m_lastSequence(0U),
+        m_isSequenceValid(false)
+    {
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~RemoteFramePlugin()
+    {
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new RemoteFramePlugin(name, uid);
+    }
+
+    /**
+     * Register web interface, e.g. REST API functionality.
+     *
+     * @param[in] srv       Webserver
+     * @param[in] baseUri   Base URI, use this and append plugin specific part.
+     */
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
+
+    /**
+     * Unregister web interface.
+     *
+     * @param[in] srv   Webserver
+     */
+    void unregisterWebInterface(PluginWebRouter& srv) final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(IGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
+    /**
+     * Update the display.
+     * The scheduler will call this method periodically.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void update(IGfx& gfx) final;
+
+private:
+
+    /** Frame width in pixel */
+    static const uint16_t   FRAME_WIDTH     = Board::LedMatrix::width;
+
+    /** Frame height in pixel */
+    static const uint16_t   FRAME_HEIGHT    = Board::LedMatrix::height;
+
+    /** Max. size of a pushed frame in byte, which is a run-length encoded frame without any repetition. */
+    static const size_t     MAX_FRAME_SIZE;
+
+    /** A frame with RGB565 pixels, row by row. */
+    struct Frame
+    {
+        uint16_t    pixels[FRAME_WIDTH * FRAME_HEIGHT]; /**< Pixels */
+    };
+
+    String                      m_url;                  /**< REST API URL to push a frame. */
+    AsyncCallbackWebHandler*    m_callbackWebHandler;   /**< Callback web handler to push a frame. */
+    StateBuffer<Frame>          m_frames;               /**< Pushed frames, published by the web task to the display task. */
+    Frame                       m_webFrame;             /**< Frame, which the patches are applied to. Only used by the web task. */
+    uint32_t                    m_lastSequence;         /**< Sequence number of the last applied patch */
+    bool                        m_isSequenceValid;      /**< Is the last sequence number valid? */
+
+    /**
+     * Instance specific web request handler, called by the static web request
+     * handler. It will really handle the request.
+     *
+     * @param[in] request   HTTP request
+     */
+    void webReqHandler(AsyncWebServerRequest *request);
+
+    /**
+     * Collect the pushed frame, which may be received in several parts.
+     * It is stored in the request and released together with it.
+     *
+     * @param[in] request   HTTP request
+     * @param[in] data      Received body data
+     * @param[in] len       Length of the received body data in byte
+     * @param[in] index     Position of the received data in the body
+     * @param[in] total     Total body length in byte
+     */
+    void bodyHandler(AsyncWebServerRequest *request, uint8_t* data, size_t len, size_t index, size_t total);
+
+    /**
+     * Apply a pushed frame.
+     *
+     * @param[in]  buffer   Pushed frame
+     * @param[in]  size     Pushed frame size in byte
+     * @param[out] msg      Error message, if not applied.
+     *
+     * @return If applied, it will return true otherwise false.
+     */
+    bool applyFrame(const uint8_t* buffer, size_t size, const char*& msg);
+
+    /**
+     * Draw a frame into the framebuffer.
+     *
+     * @param[in] gfx   Display graphics interface
+     * @param[in] frame Frame
+     */
+    static void drawFrame(IGfx& gfx, const Frame& frame);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __REMOTEFRAMEPLUGIN_H__ */
+
+/** @} */
@@ -32,17 +32,19 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include "AsyncHttpClient.h"
 #include "ClockDrv.h"
 #include "Settings.h"
 #include "ShellyPlugSPlugin.h"
 #include "RestApi.h"
 #include "time.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "ConfigStore.h"
+#include "StateStore.h"
 
 #include <ArduinoJson.h>
 #include <Logging.h>
-#include <JsonFile.h>
+#include <Util.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -67,14 +69,14 @@
 /* Initialize image path. */
 const char* ShellyPlugSPlugin::IMAGE_PATH     = "/images/plug.bmp";
 
-/* Initialize configuration path. */
-const char* ShellyPlugSPlugin::CONFIG_PATH    = "/configuration";
+/* Initialize summary IP-address. */
+const char* ShellyPlugSPlugin::SUMMARY_ADDRESS  = "*";
 
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-void ShellyPlugSPlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void ShellyPlugSPlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_url = baseUri + "/ipAddress";
 
@@ -89,7 +91,7 @@ void ShellyPlugSPlugin::registerWebInterface(AsyncWebServer& srv, const String&
     return;
 }
 
-void ShellyPlugSPlugin::unregisterWebInterface(AsyncWebServer& srv)
+void ShellyPlugSPlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_url.c_str());
 
@@ -103,37 +105,67 @@ void ShellyPlugSPlugin::unregisterWebInterface(AsyncWebServer& srv)
     return;
 }
 
-void ShellyPlugSPlugin::active(IGfx& gfx)
+void ShellyPlugSPlugin::prepare()
 {
     lock();
 
-    gfx.fillScreen(ColorDef::BLACK);
-
-    if (nullptr == m_iconCanvas)
+    /* Check for a uploaded configuration file only, if any file changed
+     * since the last check.
+     */
+    if (FileIo::getInstance().getGeneration() != m_cfgGeneration)
     {
-        m_iconCanvas = new Canvas(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+        m_cfgGeneration = FileIo::getInstance().getGeneration();
 
-        if (nullptr != m_iconCanvas)
+        if (true == ConfigStore::getInstance().importFile(getUID(), m_configurationFilename))
         {
-            (void)m_iconCanvas->addWidget(m_bitmapWidget);
+            const String IP_ADDRESS = m_ipAddress;
+            const String MQTT_TOPIC = m_mqttTopic;
 
-            /* Load  icon from filesystem. */
-            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
+            (void)loadConfiguration();
 
-            m_iconCanvas->update(gfx);
+            if (IP_ADDRESS != m_ipAddress)
+            {
+                registerDevice();
+            }
+
+            if (MQTT_TOPIC != m_mqttTopic)
+            {
+                MqttClient::getInstance().unsubscribe(this);
+                subscribeMqttTopic();
+            }
         }
     }
 
-    if (nullptr == m_textCanvas)
+    unlock();
+
+    return;
+}
+
+void ShellyPlugSPlugin::active(IGfx& gfx)
+{
+    lock();
+
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* The display was cleared, therefore everything must be drawn again. */
+    if (nullptr != m_iconCanvas)
     {
-        m_textCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, gfx.getHeight(), ICON_WIDTH, 0);
+        m_iconCanvas->invalidate();
+    }
 
-        if (nullptr != m_textCanvas)
-        {
-            (void)m_textCanvas->addWidget(m_textWidget);
+    if (nullptr != m_textCanvas)
+    {
+        m_textCanvas->invalidate();
+    }
 
-            m_textCanvas->update(gfx);
-        }
+    if (nullptr != m_iconCanvas)
+    {
+        m_iconCanvas->update(gfx);
+    }
+
+    if (nullptr != m_textCanvas)
+    {
+        m_textCanvas->update(gfx);
     }
 
     unlock();
@@ -150,8 +182,6 @@ void ShellyPlugSPlugin::update(IGfx& gfx)
 {
     lock();
 
-    gfx.fillScreen(ColorDef::BLACK);
-
     if (nullptr != m_iconCanvas)
     {
         m_iconCanvas->update(gfx);
@@ -169,32 +199,39 @@ void ShellyPlugSPlugin::update(IGfx& gfx)
 
 void ShellyPlugSPlugin::start()
 {
+    String  lastText;
+    time_t  timestamp   = 0;
+
     lock();
 
-    m_configurationFilename = String(CONFIG_PATH) + "/" + getUID() + ".json";
+    /* The canvases are created once, so the activation allocates nothing. */
+    createCanvases();
+
+    m_configurationFilename = String(ConfigStore::IMPORT_PATH) + "/" + getUID() + ".json";
 
     /* Try to load configuration. If there is no configuration available, a default configuration
      * will be created.
      */
-    createConfigDirectory();
+    m_cfgGeneration = FileIo::getInstance().getGeneration();
     if (false == loadConfiguration())
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", m_configurationFilename.c_str());
+            LOG_WARNING("Failed to create initial configuration.");
         }
     }
 
-    initHttpClient();
-    if (false == startHttpRequest())
+    /* Show the last known power marked as stale, till new data is received. */
+    if (true == StateStore::getInstance().load(getUID(), lastText, timestamp))
     {
-        m_requestTimer.start(UPDATE_PERIOD_SHORT);
-    }
-    else
-    {
-        m_requestTimer.start(UPDATE_PERIOD);
+        m_textWidget.setFormatStr(String(StateStore::STALE_COLOR) + lastText);
     }
 
+    registerDevice();
+    subscribeMqttTopic();
+
+    m_refreshTimer.start(REFRESH_PERIOD);
+
     unlock();
 
     return;
@@ -204,33 +241,29 @@ void ShellyPlugSPlugin::stop()
 {
     lock();
 
-    m_requestTimer.stop();
+    m_refreshTimer.stop();
+    MqttClient::getInstance().unsubscribe(this);
+    ShellyService::getInstance().unregisterDevice(m_deviceHandle);
+    m_deviceHandle = ShellyService::INVALID_HANDLE;
 
-    if (false != FILESYSTEM.remove(m_configurationFilename))
-    {
-        LOG_INFO("File %s removed", m_configurationFilename.c_str());
-    }
+    ConfigStore::getInstance().remove(getUID());
+    StateStore::getInstance().remove(getUID());
 
     unlock();
 
     return;
 }
 
-void ShellyPlugSPlugin::process()
+void ShellyPlugSPlugin::onTimeout(EventTimer& timer)
 {
     lock();
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
+    if (&m_refreshTimer == &timer)
     {
-        if (false == startHttpRequest())
-        {
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
-        }
-        else
-        {
-            m_requestTimer.start(UPDATE_PERIOD);
-        }
+        /* The power is polled by the Shelly service, just read it. */
+        refreshPower();
+
+        m_refreshTimer.start(REFRESH_PERIOD);
     }
 
     unlock();
@@ -245,6 +278,7 @@ void ShellyPlugSPlugin::setIPAddress(const String& ipAddress)
     if (ipAddress != m_ipAddress)
     {
         m_ipAddress = ipAddress;
+        registerDevice();
 
         (void)saveConfiguration();
     }
@@ -263,6 +297,34 @@ void ShellyPlugSPlugin::getIPAddress(String& ipAddress) const
     return;
 }
 
+void ShellyPlugSPlugin::setMqttTopic(const String& mqttTopic)
+{
+    lock();
+
+    if (mqttTopic != m_mqttTopic)
+    {
+        MqttClient::getInstance().unsubscribe(this);
+
+        m_mqttTopic = mqttTopic;
+        subscribeMqttTopic();
+
+        (void)saveConfiguration();
+    }
+    unlock();
+
+    return;
+}
+
+void ShellyPlugSPlugin::getMqttTopic(String& mqttTopic) const
+{
+    lock();
+
+    mqttTopic = m_mqttTopic;
+    unlock();
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -271,9 +333,36 @@ void ShellyPlugSPlugin::getIPAddress(String& ipAddress) const
  * Private Methods
  *****************************************************************************/
 
+void ShellyPlugSPlugin::createCanvases()
+{
+    if (nullptr == m_iconCanvas)
+    {
+        m_iconCanvas = createResource<Canvas>(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+
+        if (nullptr != m_iconCanvas)
+        {
+            (void)m_iconCanvas->addWidget(m_bitmapWidget);
+
+            /* Load icon from filesystem. */
+            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
+        }
+    }
+
+    if (nullptr == m_textCanvas)
+    {
+        m_textCanvas = createResource<Canvas>(DISPLAY_WIDTH - ICON_WIDTH, DISPLAY_HEIGHT, ICON_WIDTH, 0);
+
+        if (nullptr != m_textCanvas)
+        {
+            (void)m_textCanvas->addWidget(m_textWidget);
+        }
+    }
+
+    return;
+}
+
 void ShellyPlugSPlugin::webReqHandler(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -287,10 +376,13 @@ void ShellyPlugSPlugin::webReqHandler(AsyncWebServerRequest *request)
     {
         JsonObject  dataObj     = jsonDoc.createNestedObject("data");
         String      ipAddress;
+        String      mqttTopic;
 
         getIPAddress(ipAddress);
+        getMqttTopic(mqttTopic);
 
         dataObj["ipAddress"] = ipAddress;
+        dataObj["mqttTopic"] = mqttTopic;
 
         /* Prepare response */
         jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
@@ -299,7 +391,8 @@ void ShellyPlugSPlugin::webReqHandler(AsyncWebServerRequest *request)
     else if (HTTP_POST == request->method())
     {
         /* Argument missing? */
-        if (false == request->hasArg("set"))
+        if ((false == request->hasArg("set")) &&
+            (false == request->hasArg("mqttTopic")))
         {
             JsonObject errorObj = jsonDoc.createNestedObject("error");
 
@@ -310,7 +403,15 @@ void ShellyPlugSPlugin::webReqHandler(AsyncWebServerRequest *request)
         }
         else
         {
-            setIPAddress(request->arg("set"));
+            if (true == request->hasArg("set"))
+            {
+                setIPAddress(request->arg("set"));
+            }
+
+            if (true == request->hasArg("mqttTopic"))
+            {
+                setMqttTopic(request->arg("mqttTopic"));
+            }
 
             /* Prepare response */
             (void)jsonDoc.createNestedObject("data");
@@ -337,109 +438,115 @@ void ShellyPlugSPlugin::webReqHandler(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
-bool ShellyPlugSPlugin::startHttpRequest()
+void ShellyPlugSPlugin::registerDevice()
 {
-    bool    status  = false;
-    String  url     = String("http://") + m_ipAddress + "/meter/0/";
-    wl_status_t connectionStatus    = WiFi.status();
+    ShellyService::getInstance().unregisterDevice(m_deviceHandle);
+    m_deviceHandle = ShellyService::INVALID_HANDLE;
 
-    if (WL_CONNECTED == connectionStatus)
+    if ((false == m_ipAddress.isEmpty()) &&
+        (m_ipAddress != SUMMARY_ADDRESS))
     {
-        if (true == m_client.begin(url))
-        {
-            if (false == m_client.GET())
-            {
-                LOG_WARNING("GET %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
-        }
+        m_deviceHandle = ShellyService::getInstance().registerDevice(m_ipAddress);
     }
 
-    return status;
+    /* Show the power of the new device as soon as possible. */
+    m_generation = 0U;
+
+    return;
 }
-void ShellyPlugSPlugin::initHttpClient()
+
+void ShellyPlugSPlugin::refreshPower()
 {
-    m_client.regOnResponse([this](const HttpResponse& rsp){
-        size_t                          payloadSize             = 0U;
-        const char*                     payload                 = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-        const size_t                    JSON_DOC_SIZE           = 512U;
-        DynamicJsonDocument             jsonDoc(JSON_DOC_SIZE);
-        const size_t                    FILTER_SIZE             = 128U;
-        StaticJsonDocument<FILTER_SIZE> filter;
-        DeserializationError            error;
+    float       power       = 0.0F;
+    uint32_t    generation  = 0U;
+    bool        isAvailable = false;
 
-        m_httpResponseReceived = true;
+    if (m_ipAddress == SUMMARY_ADDRESS)
+    {
+        isAvailable = ShellyService::getInstance().getTotalPower(power, generation);
+    }
+    else
+    {
+        isAvailable = ShellyService::getInstance().getPower(m_deviceHandle, power, generation);
+    }
 
-        filter["power"] = true;
+    if ((true == isAvailable) &&
+        (generation != m_generation))
+    {
+        String text = String(power, 1) + " W";
 
-        if (true == filter.overflowed())
-        {
-            LOG_ERROR("Less memory for filter available.");
-        }
-        
-        error = deserializeJson(jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+        m_generation = generation;
+        m_textWidget.setFormatStr(text);
 
-        if (DeserializationError::Ok != error.code())
-        {
-            LOG_WARNING("JSON parse error: %s", error.c_str());
-        }
-        else if (false == jsonDoc["power"].is<float>())
-        {
-            LOG_WARNING("JSON power type missmatch or missing.");
-        }
-        else
+        StateStore::getInstance().save(getUID(), text);
+    }
+
+    return;
+}
+
+void ShellyPlugSPlugin::subscribeMqttTopic()
+{
+    if (false == m_mqttTopic.isEmpty())
+    {
+        MqttClient::OnMessage onMessage = [this](const String& topic, const uint8_t* payload, size_t size)
         {
-            String power;
+            String  power;
+            size_t  index   = 0U;
 
-            power = jsonDoc["power"].as<String>();
-            power += " W";
-            
-            lock();
-            m_textWidget.setFormatStr(power);
-            unlock();
+            UTIL_NOT_USED(topic);
 
-            if (true == jsonDoc.overflowed())
+            /* The Shelly PlugS publishes the power as plain number. */
+            if ((0U == size) ||
+                (MAX_POWER_LENGTH < size))
             {
-                LOG_ERROR("JSON document has less memory available.");
+                LOG_WARNING("Invalid power received via MQTT.");
             }
             else
             {
-                LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+                power.reserve(size);
+                for(index = 0U; index < size; ++index)
+                {
+                    power += static_cast<char>(payload[index]);
+                }
+
+                /* The pushed power is shown by the next refresh. */
+                lock();
+                ShellyService::getInstance().setPower(m_deviceHandle, power.toFloat());
+                unlock();
             }
+        };
+
+        if (false == MqttClient::getInstance().subscribe(this, m_mqttTopic, onMessage))
+        {
+            LOG_WARNING("Subscribe %s failed.", m_mqttTopic.c_str());
         }
-    });
+    }
 
-    m_client.regOnError([this]() {
-        LOG_WARNING("Connection error happened.");
-    });
+    return;
 }
 
 bool ShellyPlugSPlugin::saveConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     jsonDoc["shellyPlugSIP"] = m_ipAddress;
+    jsonDoc["mqttTopic"]     = m_mqttTopic;
     
-    if (false == jsonFile.save(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration.");
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", m_configurationFilename.c_str());
+        LOG_INFO("Configuration saved.");
     }
 
     return status;
@@ -448,13 +555,12 @@ bool ShellyPlugSPlugin::saveConfiguration()
 bool ShellyPlugSPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    if (false == jsonFile.load(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration.");
         status = false;
     }
     else if (false == jsonDoc["shellyPlugSIP"].is<String>())
@@ -465,20 +571,15 @@ bool ShellyPlugSPlugin::loadConfiguration()
     else
     {
         m_ipAddress = jsonDoc["shellyPlugSIP"].as<String>();
-    }
-
-    return status;
-}
 
-void ShellyPlugSPlugin::createConfigDirectory()
-{
-    if (false == FILESYSTEM.exists(CONFIG_PATH))
-    {
-        if (false == FILESYSTEM.mkdir(CONFIG_PATH))
+        /* The MQTT topic is optional, because older configurations don't have it. */
+        if (true == jsonDoc["mqttTopic"].is<String>())
         {
-            LOG_WARNING("Couldn't create directory: %s", CONFIG_PATH);
+            m_mqttTopic = jsonDoc["mqttTopic"].as<String>();
         }
     }
+
+    return status;
 }
 
 void ShellyPlugSPlugin::lock() const
@@ -44,14 +44,15 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include "AsyncHttpClient.h"
+#include "MqttClient.h"
+#include "ShellyService.h"
 #include "Plugin.hpp"
 
 #include <Canvas.h>
 #include <BitmapWidget.h>
 #include <stdint.h>
 #include <TextWidget.h>
-#include <SimpleTimer.hpp>
+#include <EventTimer.hpp>
 
 /******************************************************************************
  * Macros
@@ -63,8 +64,12 @@
 
 /**
  * Shows the current AC power being drawn via a Shelly PlugS, in watts.
+ *
+ * The power is polled by the Shelly service, which is shared by all plugin
+ * instances. With the IP-address "*", the total power of all Shelly PlugS
+ * devices, which are shown by other plugin instances, is shown.
  */
-class ShellyPlugSPlugin : public Plugin
+class ShellyPlugSPlugin : public Plugin, public ITimerListener
 {
 public:
 
@@ -81,12 +86,15 @@ public:
         m_bitmapWidget(),
         m_textWidget("?"),
         m_ipAddress("192.168.1.123"), /* Example data */
+        m_mqttTopic(),
         m_configurationFilename(""),
-        m_httpResponseReceived(false),
+        m_cfgGeneration(0U),
+        m_deviceHandle(ShellyService::INVALID_HANDLE),
+        m_generation(0U),
         m_url(),
         m_callbackWebHandler(nullptr),
         m_xMutex(nullptr),
-        m_requestTimer()
+        m_refreshTimer(*this)
     {
         /* Move the text widget one line lower for better look. */
         m_textWidget.move(0, 1);
@@ -99,17 +107,8 @@ public:
      */
     ~ShellyPlugSPlugin()
     {
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
-
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
+        destroyResource(m_iconCanvas);
+        destroyResource(m_textCanvas);
 
         if (nullptr != m_xMutex)
         {
@@ -134,17 +133,24 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void unregisterWebInterface(PluginWebRouter& srv) final;
+
+    /**
+     * Prepare the plugin to be set active soon. It imports a uploaded
+     * configuration file, so it is not necessary during the slot change
+     * anymore.
+     */
+    void prepare() final;
 
     /**
      * This method will be called in case the plugin is set active, which means
@@ -181,11 +187,11 @@ public:
     void start() final;
 
     /**
-     * Process the plugin.
-     * Overwrite it if your plugin has cyclic stuff to do without being in a
-     * active slot.
+     * Will be called by the timer service, if one of the plugin timers timed out.
+     *
+     * @param[in] timer Event timer, which timed out
      */
-    void process(void) final;
+    void onTimeout(EventTimer& timer) final;
 
     /**
      * Get ip-address.
@@ -195,12 +201,27 @@ public:
     void getIPAddress(String& ipAddress) const;
 
     /**
-     * Set ip-address.
+     * Set ip-address. Use "*" to show the total power of all devices.
      * 
      * @param[in] ipAddress IP-address
      */
     void setIPAddress(const String& ipAddress);
 
+    /**
+     * Get MQTT topic, which provides the power.
+     *
+     * @param[out] mqttTopic MQTT topic
+     */
+    void getMqttTopic(String& mqttTopic) const;
+
+    /**
+     * Set MQTT topic, which provides the power, e.g. shellies/<device-id>/relay/0/power.
+     * If empty, the power is only requested via HTTP.
+     *
+     * @param[in] mqttTopic MQTT topic
+     */
+    void setMqttTopic(const String& mqttTopic);
+
 private:
 
     /**
@@ -219,34 +240,34 @@ private:
     static const char*      IMAGE_PATH;
 
     /**
-     * Configuration path within the filesystem.
+     * IP-address, which selects the total power of all devices.
      */
-    static const char*      CONFIG_PATH;
+    static const char*      SUMMARY_ADDRESS;
 
     /**
-     * Period in ms for requesting power consumption from the Shelly PlugS.
-     * This is used in case the last request to the server was successful.
+     * Period in ms for reading the power from the Shelly service.
      */
-    static const uint32_t   UPDATE_PERIOD       = (15U * 1000U);
+    static const uint32_t   REFRESH_PERIOD      = 1000U;
 
     /**
-     * Short period in ms for requesting power consumption from the Shelly PlugS.
-     * This is used in case the request to the server failed.
+     * Max. length of a power value, received via MQTT.
      */
-    static const uint32_t   UPDATE_PERIOD_SHORT = (10U * 1000U);
+    static const size_t     MAX_POWER_LENGTH    = 16U;
 
     Canvas*                     m_textCanvas;               /**< Canvas used for the text widget. */
     Canvas*                     m_iconCanvas;               /**< Canvas used for the bitmap widget. */
     BitmapWidget                m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
     TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. */
     String                      m_ipAddress;                /**< IP-address of the ShellyPlugS server. */
-    String                      m_configurationFilename;    /**< String used for specifying the configuration filename. */
-    bool                        m_httpResponseReceived;     /**< Flag to indicate a received HTTP response. */
-    AsyncHttpClient             m_client;                   /**< Asynchronous HTTP client. */
+    String                      m_mqttTopic;                /**< MQTT topic, which provides the power. Empty if not used. */
+    String                      m_configurationFilename;    /**< Name of the configuration file, which is imported if uploaded. */
+    uint32_t                    m_cfgGeneration;            /**< Filesystem generation of the last import check. */
+    uint8_t                     m_deviceHandle;             /**< Handle of the device in the Shelly service. */
+    uint32_t                    m_generation;               /**< Shelly service generation of the shown power. */
     String                      m_url;                      /**< REST API URL */
     AsyncCallbackWebHandler*    m_callbackWebHandler;       /**< Callback web handler */
     SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
-    SimpleTimer                 m_requestTimer;             /**< Timer is used for cyclic ShellyPlugS  http request. */
+    EventTimer                  m_refreshTimer;             /**< Timer is used for cyclic reading of the power from the Shelly service. */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -257,32 +278,38 @@ private:
     void webReqHandler(AsyncWebServerRequest *request);
 
     /**
-     * Request new data.
-     *
-     * @return If successful it will return true otherwise false.
+     * Register the configured device at the Shelly service. A previous
+     * registered device is unregistered.
+     */
+    void registerDevice(void);
+
+    /**
+     * Show the power, if it changed.
      */
-    bool startHttpRequest(void);
+    void refreshPower(void);
 
     /**
-     * Register callback function on response reception.
+     * Subscribe the MQTT topic, if configured.
+     * The received power is passed to the Shelly service, which doesn't
+     * poll the device as long as the power is pushed.
      */
-    void initHttpClient(void);
+    void subscribeMqttTopic(void);
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the configuration store.
      */
     bool saveConfiguration();
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the configuration store.
      */
     bool loadConfiguration();
 
     /**
-     * If configuration directory doesn't exists, it will be created.
-     * Otherwise nothing happens.
+     * Create the canvases and load the icon from filesystem, if not
+     * already done. The plugin must be locked before.
      */
-    void createConfigDirectory();
+    void createCanvases();
 
     /**
      * Protect against concurrent access.
@@ -0,0 +1,215 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Audio spectrum plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SpectrumPlugin.h"
+#include "MicDrv.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint8_t decay(uint8_t value, uint8_t level, uint8_t step);
+static uint16_t toPixels(uint8_t level, uint16_t height);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void SpectrumPlugin::start()
+{
+    (void)MicDrv::getInstance().begin();
+    return;
+}
+
+void SpectrumPlugin::stop()
+{
+    MicDrv::getInstance().end();
+    return;
+}
+
+void SpectrumPlugin::active(IGfx& gfx)
+{
+    memset(m_bars, 0, sizeof(m_bars));
+    memset(m_peaks, 0, sizeof(m_peaks));
+
+    /* Clear display */
+    gfx.fillScreen(ColorDef::BLACK);
+
+    return;
+}
+
+void SpectrumPlugin::inactive()
+{
+    /* Nothing to do. */
+    return;
+}
+
+void SpectrumPlugin::update(IGfx& gfx)
+{
+    const Spectrum::Levels& levels      = MicDrv::getInstance().getLevels();
+    const uint16_t          WIDTH       = gfx.getWidth();
+    const uint16_t          HEIGHT      = gfx.getHeight();
+    uint16_t                barWidth    = WIDTH / Spectrum::BAND_COUNT;
+    uint8_t                 band        = 0U;
+    int16_t                 y           = 0;
+
+    if (0U == barWidth)
+    {
+        barWidth = 1U;
+    }
+
+    for(band = 0U; band < Spectrum::BAND_COUNT; ++band)
+    {
+        m_bars[band]    = decay(m_bars[band], levels.bands[band], BAR_DECAY);
+        m_peaks[band]   = decay(m_peaks[band], m_bars[band], PEAK_DECAY);
+    }
+
+    /* Every row is drawn with spans of equal color, which are the bars
+     * and the gaps between them.
+     */
+    for(y = 0; y < HEIGHT; ++y)
+    {
+        const uint16_t  ROW         = HEIGHT - y;
+        const uint8_t   RED         = (255U * (ROW - 1U)) / HEIGHT;
+        const Color     BAR_COLOR(RED, 255U - RED, 0U);
+        int16_t         spanX       = 0;
+        Color           spanColor   = ColorDef::BLACK;
+
+        for(band = 0U; band < Spectrum::BAND_COUNT; ++band)
+        {
+            const int16_t   X       = band * barWidth;
+            Color           color   = ColorDef::BLACK;
+
+            if (toPixels(m_bars[band], HEIGHT) >= ROW)
+            {
+                color = BAR_COLOR;
+            }
+            else if (toPixels(m_peaks[band], HEIGHT) == ROW)
+            {
+                color = ColorDef::WHITE;
+            }
+            else
+            {
+                ;
+            }
+
+            if (static_cast<uint32_t>(spanColor) != static_cast<uint32_t>(color))
+            {
+                if (X > spanX)
+                {
+                    gfx.fillSpan(spanX, y, X - spanX, spanColor);
+                }
+
+                spanX       = X;
+                spanColor   = color;
+            }
+        }
+
+        gfx.fillSpan(spanX, y, (Spectrum::BAND_COUNT * barWidth) - spanX, spanColor);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Follow a level immediately, if it rises, otherwise decay slowly.
+ *
+ * @param[in] value Current value
+ * @param[in] level Level to follow
+ * @param[in] step  Decay per call
+ *
+ * @return New value
+ */
+static uint8_t decay(uint8_t value, uint8_t level, uint8_t step)
+{
+    if (level >= value)
+    {
+        value = level;
+    }
+    else if ((value - level) > step)
+    {
+        value -= step;
+    }
+    else
+    {
+        value = level;
+    }
+
+    return value;
+}
+
+/**
+ * Get the height in pixels of a level.
+ *
+ * @param[in] level     Level
+ * @param[in] height    Max. height in pixels
+ *
+ * @return Height in pixels
+ */
+static uint16_t toPixels(uint8_t level, uint16_t height)
+{
+    return (static_cast<uint32_t>(level) * height + (Spectrum::LEVEL_MAX / 2U)) / Spectrum::LEVEL_MAX;
+}
@@ -0,0 +1,334 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pixel stream plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "StreamPlugin.h"
+
+#include <Logging.h>
+#include <Metrics.h>
+#include <DdpPacket.h>
+#include <lwip/sockets.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Latency histogram bucket bounds in ms. */
+static const uint32_t   gLatencyBounds[] = { 1U, 2U, 5U, 10U, 20U, 50U, 100U };
+
+/** Number of received stream packets. */
+static MetricCounter    gMetricPackets("pixelix_stream_packets_total", "Number of received stream packets.");
+
+/** Number of lost stream packets, detected by the sequence number. */
+static MetricCounter    gMetricLostPackets("pixelix_stream_lost_packets_total", "Number of lost stream packets.");
+
+/** Latency from receiving a frame until it is in the framebuffer. */
+static MetricHistogram  gMetricLatency("pixelix_stream_latency_ms", "Latency from receiving a stream frame until it is drawn in ms.", gLatencyBounds, UTIL_ARRAY_NUM(gLatencyBounds));
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void StreamPlugin::start()
+{
+    startTask();
+    return;
+}
+
+void StreamPlugin::stop()
+{
+    stopTask();
+    return;
+}
+
+void StreamPlugin::active(IGfx& gfx)
+{
+    /* Clear display */
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* Show the last received frame immediately. */
+    drawFrame(gfx, m_frames.get());
+
+    return;
+}
+
+void StreamPlugin::inactive()
+{
+    /* Nothing to do. */
+    return;
+}
+
+void StreamPlugin::update(IGfx& gfx)
+{
+    const Frame* frame = m_frames.fetch();
+
+    if (nullptr != frame)
+    {
+        drawFrame(gfx, *frame);
+
+        gMetricLatency.observe((micros() - frame->timestamp) / 1000U);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void StreamPlugin::startTask()
+{
+    int fd = -1;
+
+    if ((nullptr != m_taskHandle) ||
+        (nullptr == m_xExitSemaphore))
+    {
+        return;
+    }
+
+    fd = lwip_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (0 > fd)
+    {
+        LOG_ERROR("Couldn't create stream socket.");
+    }
+    else
+    {
+        struct sockaddr_in  addr;
+        struct timeval      timeout;
+
+        timeout.tv_sec  = RECEIVE_TIMEOUT / 1000U;
+        timeout.tv_usec = (RECEIVE_TIMEOUT % 1000U) * 1000U;
+
+        (void)lwip_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family         = AF_INET;
+        addr.sin_port           = htons(DdpPacket::PORT);
+        addr.sin_addr.s_addr    = htonl(INADDR_ANY);
+
+        if (0 != lwip_bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)))
+        {
+            LOG_ERROR("Couldn't bind stream socket to port %u.", DdpPacket::PORT);
+            (void)lwip_close(fd);
+        }
+        else
+        {
+            BaseType_t osRet = pdFAIL;
+
+            m_socket    = fd;
+            m_sequence  = 0U;
+            m_isExitReq = false;
+            memset(&m_rxFrame, 0, sizeof(m_rxFrame));
+
+            osRet = xTaskCreateUniversal(   receiveTask,
+                                            "streamTask",
+                                            TASK_STACK_SIZE,
+                                            this,
+                                            TASK_PRIORITY,
+                                            &m_taskHandle,
+                                            TASK_RUN_CORE);
+
+            if (pdPASS != osRet)
+            {
+                LOG_ERROR("Couldn't create stream task.");
+
+                m_taskHandle = nullptr;
+
+                (void)lwip_close(m_socket);
+                m_socket = -1;
+            }
+        }
+    }
+
+    return;
+}
+
+void StreamPlugin::stopTask()
+{
+    if (nullptr != m_taskHandle)
+    {
+        m_isExitReq = true;
+
+        /* Join */
+        (void)xSemaphoreTake(m_xExitSemaphore, portMAX_DELAY);
+        m_taskHandle = nullptr;
+    }
+
+    if (0 <= m_socket)
+    {
+        (void)lwip_close(m_socket);
+        m_socket = -1;
+    }
+
+    return;
+}
+
+void StreamPlugin::run()
+{
+    uint8_t buffer[MAX_PACKET_SIZE];
+
+    while(false == m_isExitReq)
+    {
+        int ret = lwip_recv(m_socket, buffer, sizeof(buffer), 0);
+
+        if (0 < ret)
+        {
+            /* Take the receive timestamp as early as possible. */
+            handlePacket(buffer, static_cast<size_t>(ret), micros());
+        }
+    }
+
+    return;
+}
+
+void StreamPlugin::handlePacket(const uint8_t* buffer, size_t size, uint32_t timestamp)
+{
+    DdpPacket packet;
+
+    if ((true == DdpPacket::decode(buffer, size, packet)) &&
+        (true == packet.isPixelData()))
+    {
+        const uint32_t  FRAME_SIZE  = sizeof(m_rxFrame.data);
+        uint32_t        lost        = DdpPacket::getLostPackets(m_sequence, packet.sequence);
+
+        gMetricPackets.inc();
+
+        if (0U < lost)
+        {
+            gMetricLostPackets.inc(lost);
+        }
+
+        m_sequence = packet.sequence;
+
+        /* Data beyond the frame is ignored. */
+        if (FRAME_SIZE > packet.offset)
+        {
+            uint32_t length = packet.length;
+
+            if ((FRAME_SIZE - packet.offset) < length)
+            {
+                length = FRAME_SIZE - packet.offset;
+            }
+
+            memcpy(&m_rxFrame.data[packet.offset], packet.data, length);
+        }
+
+        /* The frame is complete with the push flag. */
+        if (true == packet.isPush())
+        {
+            m_rxFrame.timestamp = timestamp;
+            m_frames.publish(m_rxFrame);
+        }
+    }
+
+    return;
+}
+
+void StreamPlugin::drawFrame(IGfx& gfx, const Frame& frame)
+{
+    Color   row[Board::LedMatrix::width];
+    int16_t width   = gfx.getWidth();
+    int16_t height  = gfx.getHeight();
+    int16_t x       = 0;
+    int16_t y       = 0;
+
+    if (Board::LedMatrix::width < width)
+    {
+        width = Board::LedMatrix::width;
+    }
+
+    if (Board::LedMatrix::height < height)
+    {
+        height = Board::LedMatrix::height;
+    }
+
+    for(y = 0; y < height; ++y)
+    {
+        const uint8_t* data = &frame.data[y * Board::LedMatrix::width * BYTES_PER_PIXEL];
+
+        for(x = 0; x < width; ++x)
+        {
+            row[x] = Color(data[0], data[1], data[2]);
+            data += BYTES_PER_PIXEL;
+        }
+
+        gfx.writeSpan(0, y, row, width);
+    }
+
+    return;
+}
+
+void StreamPlugin::receiveTask(void* parameters)
+{
+    StreamPlugin* plugin = static_cast<StreamPlugin*>(parameters);
+
+    if (nullptr != plugin)
+    {
+        plugin->run();
+
+        (void)xSemaphoreGive(plugin->m_xExitSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,247 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pixel stream plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __STREAMPLUGIN_H__
+#define __STREAMPLUGIN_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "Plugin.hpp"
+#include "Board.h"
+
+#include <StateBuffer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Shows the raw pixel data, which is streamed via the Distributed Display
+ * Protocol (DDP) over UDP, e.g. by a PC at 40-50 fps.
+ *
+ * A dedicated task receives the packets with low latency and publishes a
+ * complete frame with the push flag lock-free to the display task. The
+ * frame is written directly into the framebuffer without any widget and
+ * the plugin is shown without fading.
+ *
+ * The pixels are expected as RGB with 8 bit per color, row by row.
+ * Only one instance can receive the stream.
+ */
+class StreamPlugin : public Plugin
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    StreamPlugin(const String& name, uint16_t uid) :
+        Plugin(name, uid),
+        m_frames(),
+        m_rxFrame(),
+        m_xExitSemaphore(xSemaphoreCreateBinary()),
+        m_taskHandle(nullptr),
+        m_isExitReq(false),
+        m_socket(-1),
+        m_sequence(0U)
+    {
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~StreamPlugin()
+    {
+        stopTask();
+
+        if (nullptr != m_xExitSemaphore)
+        {
+            vSemaphoreDelete(m_xExitSemaphore);
+            m_xExitSemaphore = nullptr;
+        }
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new StreamPlugin(name, uid);
+    }
+
+    /**
+     * Start the plugin, which starts receiving the stream.
+     */
+    void start() final;
+
+    /**
+     * Stop the plugin, which stops receiving the stream.
+     */
+    void stop() final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(IGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
+    /**
+     * Update the display.
+     * The scheduler will call this method periodically.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void update(IGfx& gfx) final;
+
+    /**
+     * The streamed content is shown at once, without fading.
+     *
+     * @return Always false
+     */
+    bool isFadeEnabled() const final
+    {
+        return false;
+    }
+
+private:
+
+    /** Number of pixels in a frame */
+    static const uint16_t       PIXEL_COUNT         = Board::LedMatrix::width * Board::LedMatrix::height;
+
+    /** Number of bytes per pixel in the stream */
+    static const uint8_t        BYTES_PER_PIXEL     = 3U;
+
+    /** Max. UDP payload size in byte, the DDP packets fit into a ethernet frame. */
+    static const size_t         MAX_PACKET_SIZE     = 1472U;
+
+    /** Task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 3072U;
+
+    /** Task priority, above the display task to receive the packets in time. */
+    static const UBaseType_t    TASK_PRIORITY       = 5U;
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Receive timeout in ms, which limits the latency of exiting. */
+    static const uint32_t       RECEIVE_TIMEOUT     = 100U;
+
+    /** A complete received frame. */
+    struct Frame
+    {
+        uint32_t    timestamp;                              /**< Receive timestamp in us */
+        uint8_t     data[PIXEL_COUNT * BYTES_PER_PIXEL];    /**< Pixel data in RGB */
+    };
+
+    StateBuffer<Frame>  m_frames;           /**< Received frames, published by the receive task to the display task. */
+    Frame               m_rxFrame;          /**< Frame, which is currently received. Only used by the receive task. */
+    SemaphoreHandle_t   m_xExitSemaphore;   /**< Signals the exit of the receive task. */
+    TaskHandle_t        m_taskHandle;       /**< Receive task handle */
+    volatile bool       m_isExitReq;        /**< Request the receive task to exit. */
+    int                 m_socket;           /**< UDP socket */
+    uint8_t             m_sequence;         /**< Sequence number of the last received packet */
+
+    /**
+     * Open the UDP socket and start the receive task.
+     */
+    void startTask();
+
+    /**
+     * Stop the receive task and close the UDP socket.
+     */
+    void stopTask();
+
+    /**
+     * Receive the packets, until the exit is requested.
+     */
+    void run();
+
+    /**
+     * Handle a received packet.
+     *
+     * @param[in] buffer    Packet
+     * @param[in] size      Packet size in byte
+     * @param[in] timestamp Receive timestamp in us
+     */
+    void handlePacket(const uint8_t* buffer, size_t size, uint32_t timestamp);
+
+    /**
+     * Draw a frame into the framebuffer.
+     *
+     * @param[in] gfx   Display graphics interface
+     * @param[in] frame Frame
+     */
+    static void drawFrame(IGfx& gfx, const Frame& frame);
+
+    /**
+     * Receive task.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void receiveTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __STREAMPLUGIN_H__ */
+
+/** @} */
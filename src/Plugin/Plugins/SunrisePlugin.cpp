@@ -32,17 +32,20 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include "AsyncHttpClient.h"
 #include "ClockDrv.h"
 #include "Settings.h"
 #include "SunrisePlugin.h"
 #include "RestApi.h"
 #include "time.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "ConfigStore.h"
+#include "StateStore.h"
+#include "LargeJsonDocument.h"
 
 #include <ArduinoJson.h>
 #include <Logging.h>
-#include <JsonFile.h>
+#include <SunCalc.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -76,14 +79,11 @@ char *_EXFUN(strptime,  (const char *__restrict,
 /* Initialize image path. */
 const char* SunrisePlugin::IMAGE_PATH     = "/images/sunrise.bmp";
 
-/* Initialize configuration path. */
-const char* SunrisePlugin::CONFIG_PATH    = "/configuration";
-
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-void SunrisePlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void SunrisePlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_url = baseUri + "/location";
 
@@ -98,7 +98,7 @@ void SunrisePlugin::registerWebInterface(AsyncWebServer& srv, const String& base
     return;
 }
 
-void SunrisePlugin::unregisterWebInterface(AsyncWebServer& srv)
+void SunrisePlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_url.c_str());
 
@@ -112,37 +112,53 @@ void SunrisePlugin::unregisterWebInterface(AsyncWebServer& srv)
     return;
 }
 
-void SunrisePlugin::active(IGfx& gfx)
+void SunrisePlugin::prepare()
 {
     lock();
 
-    gfx.fillScreen(ColorDef::BLACK);
-
-    if (nullptr == m_iconCanvas)
+    /* Check for a uploaded configuration file only, if any file changed
+     * since the last check.
+     */
+    if (FileIo::getInstance().getGeneration() != m_cfgGeneration)
     {
-        m_iconCanvas = new Canvas(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+        m_cfgGeneration = FileIo::getInstance().getGeneration();
 
-        if (nullptr != m_iconCanvas)
+        if (true == ConfigStore::getInstance().importFile(getUID(), m_configurationFilename))
         {
-            (void)m_iconCanvas->addWidget(m_bitmapWidget);
+            (void)loadConfiguration();
+        }
+    }
 
-            /* Load  icon from filesystem. */
-            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
+    unlock();
 
-            m_iconCanvas->update(gfx);
-        }
+    return;
+}
+
+void SunrisePlugin::active(IGfx& gfx)
+{
+    lock();
+
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* The display was cleared, therefore everything must be drawn again. */
+    if (nullptr != m_iconCanvas)
+    {
+        m_iconCanvas->invalidate();
     }
 
-    if (nullptr == m_textCanvas)
+    if (nullptr != m_textCanvas)
     {
-        m_textCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, gfx.getHeight(), ICON_WIDTH, 0);
+        m_textCanvas->invalidate();
+    }
 
-        if (nullptr != m_textCanvas)
-        {
-            (void)m_textCanvas->addWidget(m_textWidget);
+    if (nullptr != m_iconCanvas)
+    {
+        m_iconCanvas->update(gfx);
+    }
 
-            m_textCanvas->update(gfx);
-        }
+    if (nullptr != m_textCanvas)
+    {
+        m_textCanvas->update(gfx);
     }
 
     unlock();
@@ -159,8 +175,6 @@ void SunrisePlugin::update(IGfx& gfx)
 {
     lock();
 
-    gfx.fillScreen(ColorDef::BLACK);
-
     if (nullptr != m_iconCanvas)
     {
         m_iconCanvas->update(gfx);
@@ -178,24 +192,36 @@ void SunrisePlugin::update(IGfx& gfx)
 
 void SunrisePlugin::start()
 {
+    String  lastText;
+    time_t  timestamp   = 0;
+
     lock();
 
-    m_configurationFilename = String(CONFIG_PATH) + "/" + getUID() + ".json";
+    /* The canvases are created once, so the activation allocates nothing. */
+    createCanvases();
+
+    m_configurationFilename = String(ConfigStore::IMPORT_PATH) + "/" + getUID() + ".json";
 
     /* Try to load configuration. If there is no configuration available, a default configuration
      * will be created.
      */
-    createConfigDirectory();
+    m_cfgGeneration = FileIo::getInstance().getGeneration();
     if (false == loadConfiguration())
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", m_configurationFilename.c_str());
+            LOG_WARNING("Failed to create initial configuration.");
         }
     }
 
-    initHttpClient();
-    if (false == startHttpRequest())
+    /* Show the last known sunrise and sunset marked as stale, till new data is received. */
+    if (true == StateStore::getInstance().load(getUID(), lastText, timestamp))
+    {
+        m_textWidget.setFormatStr(String(StateStore::STALE_COLOR) + lastText);
+    }
+
+    initHttpRequest();
+    if (false == updateTimes())
     {
         m_requestTimer.start(UPDATE_PERIOD_SHORT);
     }
@@ -214,25 +240,23 @@ void SunrisePlugin::stop()
     lock();
 
     m_requestTimer.stop();
+    HttpClientPool::getInstance().abort(this);
 
-    if (false != FILESYSTEM.remove(m_configurationFilename))
-    {
-        LOG_INFO("File %s removed", m_configurationFilename.c_str());
-    }
+    ConfigStore::getInstance().remove(getUID());
+    StateStore::getInstance().remove(getUID());
 
     unlock();
 
     return;
 }
 
-void SunrisePlugin::process()
+void SunrisePlugin::onTimeout(EventTimer& timer)
 {
     lock();
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
+    if (&m_requestTimer == &timer)
     {
-        if (false == startHttpRequest())
+        if (false == updateTimes())
         {
             m_requestTimer.start(UPDATE_PERIOD_SHORT);
         }
@@ -288,9 +312,36 @@ void SunrisePlugin::setLocation(const String& longitude, const String& latitude)
  * Private Methods
  *****************************************************************************/
 
+void SunrisePlugin::createCanvases()
+{
+    if (nullptr == m_iconCanvas)
+    {
+        m_iconCanvas = createResource<Canvas>(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+
+        if (nullptr != m_iconCanvas)
+        {
+            (void)m_iconCanvas->addWidget(m_bitmapWidget);
+
+            /* Load icon from filesystem. */
+            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH);
+        }
+    }
+
+    if (nullptr == m_textCanvas)
+    {
+        m_textCanvas = createResource<Canvas>(DISPLAY_WIDTH - ICON_WIDTH, DISPLAY_HEIGHT, ICON_WIDTH, 0);
+
+        if (nullptr != m_textCanvas)
+        {
+            (void)m_textCanvas->addWidget(m_textWidget);
+        }
+    }
+
+    return;
+}
+
 void SunrisePlugin::webReqHandler(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -357,8 +408,7 @@ void SunrisePlugin::webReqHandler(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -368,43 +418,45 @@ bool SunrisePlugin::startHttpRequest()
     bool    status  = false;
     String  url     = String("http://api.sunrise-sunset.org/json?lat=") + m_latitude + "&lng=" + m_longitude + "&formatted=0";
 
-    if (true == m_client.begin(url))
+    m_httpRequest.url = url;
+
+    if (false == HttpClientPool::getInstance().request(m_httpRequest))
     {
-        if (false == m_client.GET())
-        {
-            LOG_WARNING("GET %s failed.", url.c_str());
-        }
-        else
-        {
-            status = true;
-        }
+        LOG_WARNING("GET %s failed.", url.c_str());
+    }
+    else
+    {
+        status = true;
     }
 
     return status;
 }
 
-void SunrisePlugin::initHttpClient()
+void SunrisePlugin::initHttpRequest()
 {
-    m_client.regOnResponse([this](const HttpResponse& rsp){
+    /* The sunrise and sunset times are requested seldom, therefore its not
+     * worth to keep the connection alive.
+     */
+    m_httpRequest.owner         = this;
+    m_httpRequest.priority      = HttpClientPool::PRIORITY_LOW;
+    m_httpRequest.isKeepAlive   = false;
+
+    /* The times change only once a day, so most responses are the same. */
+    m_httpRequest.isCached      = true;
+
+    /* Only the sunrise and sunset times are shown, skip everything else of the response. */
+    (void)m_jsonFilter.addField("results.sunrise", MAX_TIME_LENGTH);
+    (void)m_jsonFilter.addField("results.sunset", MAX_TIME_LENGTH);
+
+    m_httpRequest.onResponse = [this](const HttpResponse& rsp){
         size_t                          payloadSize             = 0U;
         const char*                     payload                 = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-        const size_t                    JSON_DOC_SIZE           = 512U;
-        DynamicJsonDocument             jsonDoc(JSON_DOC_SIZE);
-        const size_t                    FILTER_SIZE             = 128U;
-        StaticJsonDocument<FILTER_SIZE> filter;
+        LargeJsonDocument               jsonDoc(m_jsonFilter.getDocCapacity());
         DeserializationError            error;
 
         m_httpResponseReceived = true;
 
-        filter["results"]["sunrise"]    = true;
-        filter["results"]["sunset"]     = true;
-
-        if (true == filter.overflowed())
-        {
-            LOG_ERROR("Less memory for filter available.");
-        }
-
-        error = deserializeJson(jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+        error = m_jsonFilter.parse(jsonDoc, payload, payloadSize);
 
         if (DeserializationError::Ok != error.code())
         {
@@ -430,6 +482,8 @@ void SunrisePlugin::initHttpClient()
 
             unlock();
 
+            StateStore::getInstance().save(getUID(), m_relevantResponsePart);
+
             if (true == jsonDoc.overflowed())
             {
                 LOG_ERROR("JSON document has less memory available.");
@@ -439,18 +493,66 @@ void SunrisePlugin::initHttpClient()
                 LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
             }
         }
-    });
+    };
+
+    /* The shown times are still up to date. */
+    m_httpRequest.onUnchanged = [this]() {
+        m_httpResponseReceived = true;
+    };
 }
 
-String SunrisePlugin::addCurrentTimezoneValues(const String& dateTimeString) const
+bool SunrisePlugin::updateTimes()
 {
-    tm          timeInfo;
-    char        timeBuffer[17]      = { 0 };
-    int16_t     gmtOffset           = 0;
-    int16_t     isDaylightSaving    = 0;
-    const char* formattedTimeString = ClockDrv::getInstance().getTimeFormat() ? "%H:%M":"%I:%M %p";
-    bool        isPM                = dateTimeString.endsWith("PM");
+    bool status = false;
 
+    if (true == m_useServer)
+    {
+        status = startHttpRequest();
+    }
+    else
+    {
+        status = calculateTimes();
+    }
+
+    return status;
+}
+
+bool SunrisePlugin::calculateTimes()
+{
+    bool    status  = false;
+    tm      timeInfo;
+
+    /* The day is needed, therefore the time must be synchronized. */
+    if (true == ClockDrv::getInstance().getTime(&timeInfo))
+    {
+        int16_t sunrise = 0;
+        int16_t sunset  = 0;
+
+        if (false == SunCalc::calculate(m_latitude.toFloat(),
+                                        m_longitude.toFloat(),
+                                        static_cast<uint16_t>(timeInfo.tm_yday),
+                                        sunrise,
+                                        sunset))
+        {
+            /* Polar day or night */
+            m_relevantResponsePart = "-- / --";
+        }
+        else
+        {
+            m_relevantResponsePart = formatTime(sunrise) + " / " + formatTime(sunset);
+        }
+
+        m_textWidget.setFormatStr(m_relevantResponsePart);
+        StateStore::getInstance().save(getUID(), m_relevantResponsePart);
+
+        status = true;
+    }
+
+    return status;
+}
+
+void SunrisePlugin::getTimezone(int16_t& gmtOffset, int16_t& isDaylightSaving) const
+{
     /* Get the GMT offset and daylight saving enabled/disabled from persistent memory. */
     if (false == Settings::getInstance().open(true))
     {
@@ -465,6 +567,48 @@ String SunrisePlugin::addCurrentTimezoneValues(const String& dateTimeString) con
         Settings::getInstance().close();
     }
 
+    return;
+}
+
+String SunrisePlugin::formatTime(int32_t minutesUtc) const
+{
+    tm          timeInfo            = { 0 };
+    char        timeBuffer[17]      = { 0 };
+    int16_t     gmtOffset           = 0;
+    int16_t     isDaylightSaving    = 0;
+    const char* formattedTimeString = ClockDrv::getInstance().getTimeFormat() ? "%H:%M":"%I:%M %p";
+    int32_t     minutes             = 0;
+
+    getTimezone(gmtOffset, isDaylightSaving);
+
+    /* Depended on the location, the local time may be on the day before or after. */
+    minutes = minutesUtc + (gmtOffset / 60) + (isDaylightSaving * 60);
+    minutes %= SunCalc::MINUTES_PER_DAY;
+
+    if (0 > minutes)
+    {
+        minutes += SunCalc::MINUTES_PER_DAY;
+    }
+
+    timeInfo.tm_hour    = minutes / 60;
+    timeInfo.tm_min     = minutes % 60;
+
+    strftime(timeBuffer, sizeof(timeBuffer), formattedTimeString, &timeInfo);
+
+    return timeBuffer;
+}
+
+String SunrisePlugin::addCurrentTimezoneValues(const String& dateTimeString) const
+{
+    tm          timeInfo;
+    char        timeBuffer[17]      = { 0 };
+    int16_t     gmtOffset           = 0;
+    int16_t     isDaylightSaving    = 0;
+    const char* formattedTimeString = ClockDrv::getInstance().getTimeFormat() ? "%H:%M":"%I:%M %p";
+    bool        isPM                = dateTimeString.endsWith("PM");
+
+    getTimezone(gmtOffset, isDaylightSaving);
+
     strptime(dateTimeString.c_str(), "%Y-%m-%dT%H:%M:%S" ,&timeInfo);
     timeInfo.tm_hour += gmtOffset /3600;
     timeInfo.tm_hour += isDaylightSaving;
@@ -478,21 +622,21 @@ String SunrisePlugin::addCurrentTimezoneValues(const String& dateTimeString) con
 bool SunrisePlugin::saveConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     jsonDoc["longitude"]    = m_longitude;
     jsonDoc["latitude"]     = m_latitude;
-    
-    if (false == jsonFile.save(m_configurationFilename, jsonDoc))
+    jsonDoc["useServer"]    = m_useServer;
+
+    if (false == ConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration.");
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", m_configurationFilename.c_str());
+        LOG_INFO("Configuration saved.");
     }
 
     return status;
@@ -501,35 +645,24 @@ bool SunrisePlugin::saveConfiguration()
 bool SunrisePlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    if (false == jsonFile.load(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration.");
         status = false;
     }
     else
     {
         m_longitude = jsonDoc["longitude"].as<String>();
         m_latitude  = jsonDoc["latitude"].as<String>();
+        m_useServer = jsonDoc["useServer"] | false;
     }
 
     return status;
 }
 
-void SunrisePlugin::createConfigDirectory()
-{
-    if (false == FILESYSTEM.exists(CONFIG_PATH))
-    {
-        if (false == FILESYSTEM.mkdir(CONFIG_PATH))
-        {
-            LOG_WARNING("Couldn't create directory: %s", CONFIG_PATH);
-        }
-    }
-}
-
 void SunrisePlugin::lock() const
 {
     if (nullptr != m_xMutex)
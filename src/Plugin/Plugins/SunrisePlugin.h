@@ -44,7 +44,8 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
-#include "AsyncHttpClient.h"
+#include "HttpClientPool.h"
+#include "JsonFieldFilter.h"
 #include "Plugin.hpp"
 
 #include <Canvas.h>
@@ -52,6 +53,7 @@
 #include <stdint.h>
 #include <TextWidget.h>
 #include <SimpleTimer.hpp>
+#include <EventTimer.hpp>
 
 /******************************************************************************
  * Macros
@@ -67,9 +69,10 @@
  * At the first installation a json document is generated to the /configuration/UUID.json
  * in the filesystem, where the longitude and latidude have to be configured.
  *
- * Powered by sunrise-sunset.org!
+ * The times are calculated on the device by default. Optional they are
+ * requested from sunrise-sunset.org, which is configured with "useServer".
  */
-class SunrisePlugin : public Plugin
+class SunrisePlugin : public Plugin, public ITimerListener
 {
 public:
 
@@ -87,13 +90,15 @@ public:
         m_textWidget("\\calign?"),
         m_longitude("2.295"), /* Example data */
         m_latitude("48.858"), /* Example data */
+        m_useServer(false),
         m_configurationFilename(""),
+        m_cfgGeneration(0U),
         m_httpResponseReceived(false),
         m_relevantResponsePart(""),
         m_url(),
         m_callbackWebHandler(nullptr),
         m_xMutex(nullptr),
-        m_requestTimer()
+        m_requestTimer(*this)
     {
         /* Move the text widget one line lower for better look. */
         m_textWidget.move(0, 1);
@@ -106,17 +111,8 @@ public:
      */
     ~SunrisePlugin()
     {
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
-
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
+        destroyResource(m_iconCanvas);
+        destroyResource(m_textCanvas);
 
         if (nullptr != m_xMutex)
         {
@@ -141,17 +137,24 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
+     */
+    void unregisterWebInterface(PluginWebRouter& srv) final;
+
+    /**
+     * Prepare the plugin to be set active soon. It imports a uploaded
+     * configuration file, so it is not necessary during the slot change
+     * anymore.
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void prepare() final;
 
     /**
      * This method will be called in case the plugin is set active, which means
@@ -188,11 +191,11 @@ public:
     void start() final;
 
     /**
-     * Process the plugin.
-     * Overwrite it if your plugin has cyclic stuff to do without being in a
-     * active slot.
+     * Will be called by the timer service, if one of the plugin timers timed out.
+     *
+     * @param[in] timer Event timer, which timed out
      */
-    void process(void) final;
+    void onTimeout(EventTimer& timer) final;
 
     /**
      * Get geo location.
@@ -228,21 +231,24 @@ private:
     static const char*      IMAGE_PATH;
 
     /**
-     * Configuration path within the filesystem.
+     * Period in ms for requesting sunset/sunrise from server or calculating
+     * them on the device.
+     * This is used in case the last request or calculation was successful.
      */
-    static const char*      CONFIG_PATH;
+    static const uint32_t   UPDATE_PERIOD       = (30U * 60U * 1000U);
 
     /**
-     * Period in ms for requesting sunset/sunrise from server.
-     * This is used in case the last request to the server was successful.
+     * Short period in ms for requesting sunset/sunrise from server or
+     * calculating them on the device.
+     * This is used in case the request to the server failed or the time is
+     * not synchronized yet.
      */
-    static const uint32_t   UPDATE_PERIOD       = (30U * 60U * 1000U);
+    static const uint32_t   UPDATE_PERIOD_SHORT = (10U * 1000U);
 
     /**
-     * Short period in ms for requesting sunset/sunrise from server.
-     * This is used in case the request to the server failed.
+     * Max. length of a time value in the response, e.g. "2021-01-01T07:00:00+00:00".
      */
-    static const uint32_t   UPDATE_PERIOD_SHORT = (10U * 1000U);
+    static const size_t     MAX_TIME_LENGTH     = 32U;
 
     Canvas*                     m_textCanvas;               /**< Canvas used for the text widget. */
     Canvas*                     m_iconCanvas;               /**< Canvas used for the bitmap widget. */
@@ -250,15 +256,18 @@ private:
     TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. */
     String                      m_longitude;                /**< Longitude of sunrise location */
     String                      m_latitude;                 /**< Latitude of sunrise location */
-    String                      m_configurationFilename;    /**< String used for specifying the configuration filename. */
+    bool                        m_useServer;                /**< Request the times from server instead of calculating them? */
+    String                      m_configurationFilename;    /**< Name of the configuration file, which is imported if uploaded. */
+    uint32_t                    m_cfgGeneration;            /**< Filesystem generation of the last import check. */
     bool                        m_httpResponseReceived;     /**< Flag to indicate a received HTTP response. */
     String                      m_relevantResponsePart;     /**< String used for the relevant part of the HTTP response. */
-    AsyncHttpClient             m_client;                   /**< Asynchronous HTTP client. */
+    HttpClientPool::Request     m_httpRequest;              /**< HTTP request, which is sent via the HTTP client pool. */
+    JsonFieldFilter             m_jsonFilter;               /**< Filter with the needed fields of the JSON response. */
     SimpleTimer                 m_requestDataTimer;         /**< Timer, used for cyclic request of new data. */
     String                      m_url;                      /**< REST API URL */
     AsyncCallbackWebHandler*    m_callbackWebHandler;       /**< Callback web handler */
     SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
-    SimpleTimer                 m_requestTimer;             /**< Timer is used for cyclic sunrise/sunset http request. */
+    EventTimer                  m_requestTimer;             /**< Timer is used for cyclic sunrise/sunset http request. */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -276,9 +285,43 @@ private:
     bool startHttpRequest(void);
 
     /**
-     * Register callback function on response reception.
+     * Prepare the HTTP request and register its callback functions.
+     */
+    void initHttpRequest(void);
+
+    /**
+     * Update the sunrise and sunset times, either by requesting them from
+     * the server or by calculating them on the device.
+     *
+     * @return If successful it will return true otherwise false.
+     */
+    bool updateTimes(void);
+
+    /**
+     * Calculate the sunrise and sunset times of the current day on the
+     * device and show them.
+     *
+     * @return If the time is synchronized, it will return true otherwise false.
+     */
+    bool calculateTimes(void);
+
+    /**
+     * Get the timezone configuration.
+     *
+     * @param[out] gmtOffset        GMT offset in s
+     * @param[out] isDaylightSaving Daylight saving adjustment in h
+     */
+    void getTimezone(int16_t& gmtOffset, int16_t& isDaylightSaving) const;
+
+    /**
+     * Format a time of the day according to the configured timezone and
+     * time format.
+     *
+     * @param[in] minutesUtc    Time in minutes after midnight UTC
+     *
+     * @return Formatted time string
      */
-    void initHttpClient(void);
+    String formatTime(int32_t minutesUtc) const;
 
     /**
      * Add the daylight saving (if available) and GMT offset values to the given
@@ -291,20 +334,20 @@ private:
     String addCurrentTimezoneValues(const String& dateTimeString) const;
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the configuration store.
      */
     bool saveConfiguration();
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the configuration store.
      */
     bool loadConfiguration();
 
     /**
-     * If configuration directory doesn't exists, it will be created.
-     * Otherwise nothing happens.
+     * Create the canvases and load the icon from filesystem, if not
+     * already done. The plugin must be locked before.
      */
-    void createConfigDirectory();
+    void createCanvases();
 
     /**
      * Protect against concurrent access.
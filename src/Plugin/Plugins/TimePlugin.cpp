@@ -78,17 +78,15 @@ void TimePlugin::active(IGfx& gfx)
 {
     m_isUpdateAvailable = true;
 
-    m_checkTimeUpdateTimer.start(CHECK_TIME_UPDATE_PERIOD);
-
     /* Force immediate time update to avoid displaying
-     * an old time for one TIME_UPDATE_PERIOD.
+     * an old time till the next minute boundary.
      */
     updateTime(true);
 }
 
 void TimePlugin::inactive()
 {
-    m_checkTimeUpdateTimer.stop();
+    m_updateTimer.stop();
 
     return;
 }
@@ -106,14 +104,32 @@ void TimePlugin::update(IGfx& gfx)
     return;
 }
 
-void TimePlugin::process()
+uint32_t TimePlugin::getTimeToNextUpdate() const
 {
-    if ((true == m_checkTimeUpdateTimer.isTimerRunning()) &&
-        (true == m_checkTimeUpdateTimer.isTimeout()))
+    uint32_t timeToNextUpdate = UPDATE_ALWAYS;
+
+    /* The shown time is valid till the next minute boundary. Until the
+     * timer is notified, at least 1 ms is left.
+     */
+    if ((false == m_isUpdateAvailable) &&
+        (true == m_updateTimer.isTimerRunning()))
     {
-        updateTime(false);
+        timeToNextUpdate = m_updateTimer.getRemaining();
 
-        m_checkTimeUpdateTimer.restart();
+        if (UPDATE_ALWAYS == timeToNextUpdate)
+        {
+            timeToNextUpdate = 1U;
+        }
+    }
+
+    return timeToNextUpdate;
+}
+
+void TimePlugin::onTimeout(EventTimer& timer)
+{
+    if (&m_updateTimer == &timer)
+    {
+        updateTime(false);
     }
 
     return;
@@ -136,10 +152,14 @@ void TimePlugin::setText(const String& formatText)
 
 void TimePlugin::updateTime(bool force)
 {
-    struct tm timeinfo = { 0 };
+    struct tm   timeinfo = { 0 };
+    uint32_t    boundary = ClockDrv::BOUNDARY_SECOND;
 
     if (true == ClockDrv::getInstance().getTime(&timeinfo))
     {
+        /* Check the time again at the next minute boundary. */
+        boundary = ClockDrv::BOUNDARY_MINUTE;
+
         if ((m_currentMinute != timeinfo.tm_min) ||
             (true == force))
         {
@@ -153,6 +173,9 @@ void TimePlugin::updateTime(bool force)
             m_isUpdateAvailable = true;
         }
     }
+
+    /* Without synchronized time, its checked every second. */
+    m_updateTimer.start(ClockDrv::getInstance().getTimeToNextBoundary(boundary));
 }
 
 /******************************************************************************
@@ -49,6 +49,7 @@
 #include "Plugin.hpp"
 
 #include <TextWidget.h>
+#include <EventTimer.hpp>
 
 /******************************************************************************
  * Macros
@@ -60,9 +61,10 @@
 
 /**
  * Shows time over the whole display.
- *
+ * The time text is rebuilt at the minute boundaries only. In between the
+ * plugin declares no change, which skips its update.
  */
-class TimePlugin : public Plugin
+class TimePlugin : public Plugin, public ITimerListener
 {
 public:
 
@@ -75,7 +77,7 @@ public:
     TimePlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
         m_textWidget("\\calignNo NTP"),
-        m_checkTimeUpdateTimer(),
+        m_updateTimer(*this),
         m_currentMinute(0),
         m_isUpdateAvailable(false)
     {
@@ -126,11 +128,18 @@ public:
     void inactive() final;
 
     /**
-     * Process the plugin.
-     * Overwrite it if your plugin has cyclic stuff to do without being in a
-     * active slot.
+     * Get the time in ms, until the plugin content changes next.
+     *
+     * @return Time to next update in ms or UPDATE_ALWAYS
      */
-    void process(void) final;
+    uint32_t getTimeToNextUpdate() const final;
+
+    /**
+     * Will be called by the timer service, if the update timer timed out.
+     *
+     * @param[in] timer Event timer, which timed out
+     */
+    void onTimeout(EventTimer& timer) final;
 
     /**
      * Set text, which may contain format tags.
@@ -141,17 +150,15 @@ public:
     
 private:
 
-    /** Time to check time update period in ms */
-    static const uint32_t   CHECK_TIME_UPDATE_PERIOD  = 5000U;
-
     TextWidget  m_textWidget;           /**< Text widget, used for showing the text. */
-    SimpleTimer m_checkTimeUpdateTimer; /**< Timer, used for cyclic check if time update is necessarry. */
+    EventTimer  m_updateTimer;          /**< Timer, which times out at the next minute boundary. */
     int32_t     m_currentMinute;        /**< Variable to hold the current minute value. */
     bool        m_isUpdateAvailable;    /**< Flag to indicate an updated date value. */
 
     /**
      * Get current time and update the text, which to be displayed.
-     * The update takes only place, if the time changed.
+     * The update takes only place, if the time changed. Afterwards the
+     * update timer is started till the next minute boundary.
      *
      * @param[in] force Force update independent of time.
      */
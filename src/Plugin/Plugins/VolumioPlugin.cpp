@@ -35,10 +35,16 @@
 #include "VolumioPlugin.h"
 #include "RestApi.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "ConfigStore.h"
+#include "StateStore.h"
+#include "LargeJsonDocument.h"
+#include "HttpStatus.h"
 
 #include <Logging.h>
 #include <ArduinoJson.h>
-#include <JsonFile.h>
+#include <ImageCache.h>
+#include <IndexedImage.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -72,36 +78,46 @@ const char* VolumioPlugin::IMAGE_PATH_PLAY_ICON     = "/images/volumioPlay.bmp";
 /* Initialize image path for "pause" icon. */
 const char* VolumioPlugin::IMAGE_PATH_PAUSE_ICON    = "/images/volumioPause.bmp";
 
-/* Initialize configuration path. */
-const char* VolumioPlugin::CONFIG_PATH              = "/configuration";
-
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void VolumioPlugin::start()
 {
+    String  lastText;
+    time_t  timestamp   = 0;
+
     lock();
 
-    m_configurationFilename = String(CONFIG_PATH) + "/" + getUID() + ".json";
+    /* The canvases are created once, so the activation allocates nothing. */
+    createCanvases();
+
+    m_configurationFilename = String(ConfigStore::IMPORT_PATH) + "/" + getUID() + ".json";
 
     /* Try to load configuration. If there is no configuration available, a default configuration
      * will be created.
      */
-    createConfigDirectory();
+    m_cfgGeneration = FileIo::getInstance().getGeneration();
     if (false == loadConfiguration())
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", m_configurationFilename.c_str());
+            LOG_WARNING("Failed to create initial configuration.");
         }
     }
 
-    initHttpClient();
+    /* Show the last known track marked as stale, till new data is received. */
+    if (true == StateStore::getInstance().load(getUID(), lastText, timestamp))
+    {
+        m_textWidget.setFormatStr(String(StateStore::STALE_COLOR) + lastText);
+    }
+
+    initHttpRequest();
+    initAlbumArtRequest();
     if (false == startHttpRequest())
     {
         /* If a request fails, show standard icon and a '?' */
-        m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
+        m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
         m_textWidget.setFormatStr("\\calign?");
 
         m_requestTimer.start(UPDATE_PERIOD_SHORT);
@@ -124,28 +140,33 @@ void VolumioPlugin::stop()
 
     m_offlineTimer.stop();
     m_requestTimer.stop();
+    HttpClientPool::getInstance().abort(this);
 
-    if (false != FILESYSTEM.remove(m_configurationFilename))
+    if (nullptr != m_jpegDecoder)
     {
-        LOG_INFO("File %s removed", m_configurationFilename.c_str());
+        delete m_jpegDecoder;
+        m_jpegDecoder = nullptr;
     }
+    m_albumArtUrl.clear();
+
+    ConfigStore::getInstance().remove(getUID());
+    StateStore::getInstance().remove(getUID());
 
     unlock();
 
     return;
 }
 
-void VolumioPlugin::process()
+void VolumioPlugin::onTimeout(EventTimer& timer)
 {
     lock();
 
-    if ((true == m_requestTimer.isTimerRunning()) &&
-        (true == m_requestTimer.isTimeout()))
+    if (&m_requestTimer == &timer)
     {
         if (false == startHttpRequest())
         {
             /* If a request fails, show standard icon and a '?' */
-            m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
+            m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
             m_textWidget.setFormatStr("\\calign?");
 
             m_requestTimer.start(UPDATE_PERIOD_SHORT);
@@ -157,8 +178,7 @@ void VolumioPlugin::process()
     }
 
     /* If VOLUMIO is offline, disable the plugin. */
-    if ((true == m_offlineTimer.isTimerRunning()) &&
-        (true == m_offlineTimer.isTimeout()) &&
+    if ((&m_offlineTimer == &timer) &&
         (true == isEnabled()))
     {
         LOG_INFO("VOLUMIO not present, going offline.");
@@ -170,43 +190,51 @@ void VolumioPlugin::process()
     return;
 }
 
-void VolumioPlugin::active(IGfx& gfx)
+void VolumioPlugin::prepare()
 {
     lock();
 
-    gfx.fillScreen(ColorDef::BLACK);
-
-    if (nullptr == m_iconCanvas)
+    /* Check for a uploaded configuration file only, if any file changed
+     * since the last check.
+     */
+    if (FileIo::getInstance().getGeneration() != m_cfgGeneration)
     {
-        m_iconCanvas = new Canvas(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+        m_cfgGeneration = FileIo::getInstance().getGeneration();
 
-        if (nullptr != m_iconCanvas)
+        if (true == ConfigStore::getInstance().importFile(getUID(), m_configurationFilename))
         {
-            (void)m_iconCanvas->addWidget(m_bitmapWidget);
-
-            /* Load icon from filesystem. */
-            (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
-
-            m_iconCanvas->update(gfx);
+            (void)loadConfiguration();
         }
     }
-    else
+
+    unlock();
+
+    return;
+}
+
+void VolumioPlugin::active(IGfx& gfx)
+{
+    lock();
+
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* The display was cleared, therefore everything must be drawn again. */
+    if (nullptr != m_iconCanvas)
     {
-        m_iconCanvas->update(gfx);
+        m_iconCanvas->invalidate();
     }
 
-    if (nullptr == m_textCanvas)
+    if (nullptr != m_textCanvas)
     {
-        m_textCanvas = new Canvas(gfx.getWidth() - ICON_WIDTH, gfx.getHeight(), ICON_WIDTH, 0);
-
-        if (nullptr != m_textCanvas)
-        {
-            (void)m_textCanvas->addWidget(m_textWidget);
+        m_textCanvas->invalidate();
+    }
 
-            m_textCanvas->update(gfx);
-        }
+    if (nullptr != m_iconCanvas)
+    {
+        m_iconCanvas->update(gfx);
     }
-    else
+
+    if (nullptr != m_textCanvas)
     {
         m_textCanvas->update(gfx);
     }
@@ -222,7 +250,7 @@ void VolumioPlugin::inactive()
     return;
 }
 
-void VolumioPlugin::registerWebInterface(AsyncWebServer& srv, const String& baseUri)
+void VolumioPlugin::registerWebInterface(PluginWebRouter& srv, const String& baseUri)
 {
     m_url = baseUri + "/host";
 
@@ -237,7 +265,7 @@ void VolumioPlugin::registerWebInterface(AsyncWebServer& srv, const String& base
     return;
 }
 
-void VolumioPlugin::unregisterWebInterface(AsyncWebServer& srv)
+void VolumioPlugin::unregisterWebInterface(PluginWebRouter& srv)
 {
     LOG_INFO("[%s] Unregister: %s", getName(), m_url.c_str());
 
@@ -255,8 +283,6 @@ void VolumioPlugin::update(IGfx& gfx)
 {
     lock();
 
-    gfx.fillScreen(ColorDef::BLACK);
-
     if (nullptr != m_iconCanvas)
     {
         m_iconCanvas->update(gfx);
@@ -272,8 +298,15 @@ void VolumioPlugin::update(IGfx& gfx)
         m_textCanvas->getPos(tcX, tcY);
         m_textCanvas->update(gfx);
 
-        /* Draw a nice line to represent the current music position. */
+        /* Draw a nice line to represent the current music position.
+         * The display is not cleared anymore, therefore the rest of the line is cleared.
+         */
         gfx.drawHLine(tcX, m_textCanvas->getHeight() - 1, posWidth, posColor);
+
+        if (m_textCanvas->getWidth() > posWidth)
+        {
+            gfx.drawHLine(tcX + posWidth, m_textCanvas->getHeight() - 1, m_textCanvas->getWidth() - posWidth, ColorDef::BLACK);
+        }
     }
 
     unlock();
@@ -310,9 +343,36 @@ void VolumioPlugin::setHost(const String& host)
  * Private Methods
  *****************************************************************************/
 
+void VolumioPlugin::createCanvases()
+{
+    if (nullptr == m_iconCanvas)
+    {
+        m_iconCanvas = createResource<Canvas>(ICON_WIDTH, ICON_HEIGHT, 0, 0);
+
+        if (nullptr != m_iconCanvas)
+        {
+            (void)m_iconCanvas->addWidget(m_spriteWidget);
+
+            /* Load icon from filesystem. */
+            (void)m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
+        }
+    }
+
+    if (nullptr == m_textCanvas)
+    {
+        m_textCanvas = createResource<Canvas>(DISPLAY_WIDTH - ICON_WIDTH, DISPLAY_HEIGHT, ICON_WIDTH, 0);
+
+        if (nullptr != m_textCanvas)
+        {
+            (void)m_textCanvas->addWidget(m_textWidget);
+        }
+    }
+
+    return;
+}
+
 void VolumioPlugin::webReqHandler(AsyncWebServerRequest *request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
@@ -376,8 +436,7 @@ void VolumioPlugin::webReqHandler(AsyncWebServerRequest *request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -388,233 +447,476 @@ bool VolumioPlugin::startHttpRequest()
 
     if (0 < m_volumioHost.length())
     {
-        String url = String("http://") + m_volumioHost + "/api/v1/getState";
+        String url = String("http://") + m_volumioHost + "/api/v1/getQueue";
+
+        m_httpRequest.url = url;
 
-        if (true == m_client.begin(url))
+        if (false == HttpClientPool::getInstance().request(m_httpRequest))
         {
-            if (false == m_client.GET())
-            {
-                LOG_WARNING("GET %s failed.", url.c_str());
-            }
-            else
-            {
-                status = true;
-            }
+            LOG_WARNING("GET %s failed.", url.c_str());
+        }
+        else
+        {
+            status = true;
         }
     }
 
     return status;
 }
 
-void VolumioPlugin::initHttpClient()
+void VolumioPlugin::initHttpRequest()
 {
-    m_client.regOnResponse([this](const HttpResponse& rsp){
-        size_t                          payloadSize             = 0U;
-        const char*                     payload                 = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
-        const size_t                    JSON_DOC_SIZE           = 512U;
-        DynamicJsonDocument             jsonDoc(JSON_DOC_SIZE);
-        const size_t                    FILTER_SIZE             = 128U;
-        StaticJsonDocument<FILTER_SIZE> filter;
-        DeserializationError            error;
-
-        filter["artist"]    = true;
-        filter["duration"]  = true;
-        filter["seek"]      = true;
-        filter["service"]   = true;
-        filter["status"]    = true;
-        filter["title"]     = true;
-        
-        if (true == filter.overflowed())
+    /* The playback state is requested often and shown immediately,
+     * therefore keep the connection alive and prefer the request.
+     */
+    m_httpRequest.owner         = this;
+    m_httpRequest.priority      = HttpClientPool::PRIORITY_HIGH;
+    m_httpRequest.isKeepAlive   = true;
+
+    /* The queue and the playback state are requested in one combined
+     * poll, pipelined on the same connection.
+     */
+    (void)m_httpRequest.addPipelinedPath("/api/v1/getState");
+
+    /* Only the playback information is shown, skip everything else of the response. */
+    (void)m_jsonFilter.addField("albumart", MAX_ALBUM_ART_LENGTH);
+    (void)m_jsonFilter.addField("artist", MAX_ARTIST_LENGTH);
+    (void)m_jsonFilter.addField("duration");
+    (void)m_jsonFilter.addField("position");
+    (void)m_jsonFilter.addField("seek");
+    (void)m_jsonFilter.addField("service", MAX_SERVICE_LENGTH);
+    (void)m_jsonFilter.addField("status", MAX_STATUS_LENGTH);
+    (void)m_jsonFilter.addField("title", MAX_TITLE_LENGTH);
+
+    /* The queue is requested first, so the shown state considers the
+     * current queue.
+     */
+    m_httpRequest.onPipelinedResponse = [this](uint8_t index, const HttpResponse& rsp){
+        if (RSP_INDEX_QUEUE == index)
+        {
+            handleQueueResponse(rsp);
+        }
+        else if (RSP_INDEX_STATE == index)
         {
-            LOG_ERROR("Less memory for filter available.");
+            handleStateResponse(rsp);
         }
+        else
+        {
+            ;
+        }
+    };
+
+    m_httpRequest.onError = [this]() {
+        LOG_WARNING("Connection error happened.");
+
+        lock();
+
+        /* If a request fails, show standard icon and a '?' */
+        m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
+        m_textWidget.setFormatStr("\\calign?");
+
+        m_requestTimer.start(UPDATE_PERIOD_SHORT);
+
+        unlock();
+    };
+}
+
+void VolumioPlugin::handleStateResponse(const HttpResponse& rsp)
+{
+    size_t                          payloadSize             = 0U;
+    const char*                     payload                 = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
+    LargeJsonDocument               jsonDoc(m_jsonFilter.getDocCapacity());
+    DeserializationError            error;
 
-        error = deserializeJson(jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+    error = m_jsonFilter.parse(jsonDoc, payload, payloadSize);
 
-        if (DeserializationError::Ok != error.code())
+    if (DeserializationError::Ok != error.code())
+    {
+        LOG_WARNING("JSON parse error: %s", error.c_str());
+    }
+    else
+    {
+        if (false == jsonDoc["status"].is<String>())
+        {
+            LOG_WARNING("JSON status type missmatch or missing.");
+        }
+        else if (false == jsonDoc["title"].is<String>())
+        {
+            LOG_WARNING("JSON title type missmatch or missing.");
+        }
+        else if (false == jsonDoc["seek"].is<uint32_t>())
+        {
+            LOG_WARNING("JSON seek type missmatch or missing.");
+        }
+        else if (false == jsonDoc["service"].is<String>())
         {
-            LOG_WARNING("JSON parse error: %s", error.c_str());
+            LOG_WARNING("JSON service type missmatch or missing.");
         }
         else
         {
-            if (false == jsonDoc["status"].is<String>())
-            {
-                LOG_WARNING("JSON status type missmatch or missing.");
-            }
-            else if (false == jsonDoc["title"].is<String>())
-            {
-                LOG_WARNING("JSON title type missmatch or missing.");
-            }
-            else if (false == jsonDoc["seek"].is<uint32_t>())
+            String      status          = jsonDoc["status"].as<String>();
+            String      albumArtUrl;
+            String      artist;
+            String      title           = jsonDoc["title"].as<String>();
+            uint32_t    seekValue       = jsonDoc["seek"].as<uint32_t>();
+            String      service         = jsonDoc["service"].as<String>();
+            String      infoOnDisplay;
+            uint32_t    pos             = 0U;
+            uint32_t    trackNumber     = 0U;
+
+            /* Artist may exist */
+            if (true == jsonDoc["artist"].is<String>())
             {
-                LOG_WARNING("JSON seek type missmatch or missing.");
+                artist = jsonDoc["artist"].as<String>();
             }
-            else if (false == jsonDoc["service"].is<String>())
-            {
-                LOG_WARNING("JSON service type missmatch or missing.");
-            }
-            else
+
+            /* Album art may exist, either as absolute URL or as path on the VOLUMIO host. */
+            if (true == jsonDoc["albumart"].is<String>())
             {
-                String      status          = jsonDoc["status"].as<String>();
-                String      artist;
-                String      title           = jsonDoc["title"].as<String>();
-                uint32_t    seekValue       = jsonDoc["seek"].as<uint32_t>();
-                String      service         = jsonDoc["service"].as<String>();
-                String      infoOnDisplay;
-                uint32_t    pos             = 0U;
-
-                /* Artist may exist */
-                if (true == jsonDoc["artist"].is<String>())
+                String albumArt = jsonDoc["albumart"].as<String>();
+
+                if (true == albumArt.startsWith("http"))
                 {
-                    artist = jsonDoc["artist"].as<String>();
+                    albumArtUrl = albumArt;
                 }
-
-                if (true == title.isEmpty())
+                else if (true == albumArt.startsWith("/"))
                 {
-                    title = "\\calign-";
+                    albumArtUrl = "http://";
+                    albumArtUrl += m_volumioHost;
+                    albumArtUrl += albumArt;
                 }
-
-                if (service == "mpd")
+                else
                 {
-                    if (true == artist.isEmpty())
-                    {
-                        infoOnDisplay = title;
-                    }
-                    else
-                    {
-                        infoOnDisplay = artist + " - " + title;
-                    }
+                    ;
                 }
-                else if (service == "webradio")
+            }
+
+            if (true == title.isEmpty())
+            {
+                title = "\\calign-";
+            }
+
+            if (service == "mpd")
+            {
+                if (true == artist.isEmpty())
                 {
-                    /* If stopped, the title contains the radio station name,
-                     * otherwise the title contains the music and the artist
-                     * the radio station name.
-                     * 
-                     * Therefore show only the title in any case.
-                     */
                     infoOnDisplay = title;
                 }
                 else
                 {
-                    infoOnDisplay = title;
+                    infoOnDisplay = artist + " - " + title;
                 }
 
-                /* Determine position */
-                if (true == jsonDoc["duration"].is<uint32_t>())
+                /* Position of the track in the queue, starting with 0. */
+                if (true == jsonDoc["position"].is<uint32_t>())
                 {
-                    uint32_t duration = jsonDoc["duration"].as<uint32_t>();
+                    trackNumber = jsonDoc["position"].as<uint32_t>() + 1U;
+                }
+            }
+            else if (service == "webradio")
+            {
+                /* If stopped, the title contains the radio station name,
+                 * otherwise the title contains the music and the artist
+                 * the radio station name.
+                 * 
+                 * Therefore show only the title in any case.
+                 */
+                infoOnDisplay = title;
+            }
+            else
+            {
+                infoOnDisplay = title;
+            }
 
-                    if (0U == duration)
-                    {
-                        pos = 0U;
-                    }
-                    else
-                    {
-                        pos = seekValue / duration;
-                        pos /= 10U;
+            /* Determine position */
+            if (true == jsonDoc["duration"].is<uint32_t>())
+            {
+                uint32_t duration = jsonDoc["duration"].as<uint32_t>();
 
-                        if (100U < pos)
-                        {
-                            pos = 100U;
-                        }
-                    }
-                }
-                else
+                if (0U == duration)
                 {
                     pos = 0U;
                 }
-
-                lock();
-
-                /* Workaround for a VOLUMIO bug, which provides a wrong status. */
-                if (status == "stop")
+                else
                 {
-                    if (m_lastSeekValue != seekValue)
+                    pos = seekValue / duration;
+                    pos /= 10U;
+
+                    if (100U < pos)
                     {
-                        status = "play";
+                        pos = 100U;
                     }
                 }
-                m_lastSeekValue = seekValue;
+            }
+            else
+            {
+                pos = 0U;
+            }
 
-                if (status == "stop")
-                {
-                    (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STOP_ICON);
-                }
-                else if (status == "play")
-                {
-                    (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_PLAY_ICON);
-                }
-                else if (status == "pause")
+            lock();
+
+            /* Workaround for a VOLUMIO bug, which provides a wrong status. */
+            if (status == "stop")
+            {
+                if (m_lastSeekValue != seekValue)
                 {
-                    (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_PAUSE_ICON);
+                    status = "play";
                 }
-                else
+            }
+            m_lastSeekValue = seekValue;
+
+            if (status == "stop")
+            {
+                (void)m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_STOP_ICON);
+            }
+            else if (status == "play")
+            {
+                /* Show the album art instead of the play icon, as soon as it is available. */
+                if ((true == albumArtUrl.isEmpty()) ||
+                    (false == showAlbumArt(albumArtUrl)))
                 {
-                    (void)m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
+                    (void)m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_PLAY_ICON);
                 }
+            }
+            else if (status == "pause")
+            {
+                (void)m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_PAUSE_ICON);
+            }
+            else
+            {
+                (void)m_spriteWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
+            }
 
-                m_textWidget.setFormatStr(infoOnDisplay);
+            /* Show the track number, if the queue contains several tracks. */
+            if ((1U < m_queueLength) &&
+                (0U < trackNumber) &&
+                (m_queueLength >= trackNumber))
+            {
+                infoOnDisplay += " (";
+                infoOnDisplay += trackNumber;
+                infoOnDisplay += "/";
+                infoOnDisplay += m_queueLength;
+                infoOnDisplay += ")";
+            }
 
-                m_pos = static_cast<uint8_t>(pos);
+            m_textWidget.setFormatStr(infoOnDisplay);
+            StateStore::getInstance().save(getUID(), infoOnDisplay);
 
-                /* Feed the offline timer to avoid that the plugin gets disabled. */
-                m_offlineTimer.restart();
+            m_pos = static_cast<uint8_t>(pos);
 
-                /* Enable plugin again, if necessary. */
-                if (false == isEnabled())
-                {
-                    LOG_INFO("VOLUMIO back again, going online.");
-                    enable();
-                }
+            /* Feed the offline timer to avoid that the plugin gets disabled. */
+            m_offlineTimer.restart();
 
-                unlock();
+            /* Enable plugin again, if necessary. */
+            if (false == isEnabled())
+            {
+                LOG_INFO("VOLUMIO back again, going online.");
+                enable();
             }
+
+            unlock();
         }
-    });
+    }
 
-    m_client.regOnClosed([this]() {
-        LOG_INFO("Connection closed.");
+    return;
+}
+
+void VolumioPlugin::handleQueueResponse(const HttpResponse& rsp)
+{
+    const size_t            JSON_DOC_SIZE   = JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(MAX_QUEUE_LENGTH);
+    const size_t            FILTER_SIZE     = 128U;
+    size_t                  payloadSize     = 0U;
+    const char*             payload         = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
+    LargeJsonDocument       jsonDoc(JSON_DOC_SIZE);
+    StaticJsonDocument<FILTER_SIZE> filter;
+    DeserializationError    error;
+    size_t                  queueLength     = 0U;
+
+    /* Only the number of tracks is needed, therefore every track is
+     * reduced to a empty object.
+     */
+    filter["queue"][0]["-"] = true;
 
+    error = deserializeJson(jsonDoc, payload, payloadSize, DeserializationOption::Filter(filter));
+
+    if (DeserializationError::Ok != error.code())
+    {
+        LOG_WARNING("JSON parse error: %s", error.c_str());
+    }
+    else if (false == jsonDoc["queue"].is<JsonArray>())
+    {
+        LOG_WARNING("JSON queue type missmatch or missing.");
+    }
+    else
+    {
+        queueLength = jsonDoc["queue"].as<JsonArray>().size();
+    }
+
+    lock();
+    m_queueLength = queueLength;
+    unlock();
+
+    return;
+}
+
+void VolumioPlugin::initAlbumArtRequest()
+{
+    /* The album art is just decoration, therefore it shall not delay
+     * any other request.
+     */
+    m_albumArtRequest.owner         = this;
+    m_albumArtRequest.priority      = HttpClientPool::PRIORITY_LOW;
+    m_albumArtRequest.isKeepAlive   = true;
+
+    /* The album art is decoded and downscaled while it is received,
+     * so the JPEG file is never buffered.
+     */
+    m_albumArtRequest.onBody = [this](const uint8_t* data, size_t size){
         lock();
-        if (true == m_isConnectionError)
-        {
-            /* If a request fails, show standard icon and a '?' */
-            m_bitmapWidget.load(FILESYSTEM, IMAGE_PATH_STD_ICON);
-            m_textWidget.setFormatStr("\\calign?");
 
-            m_requestTimer.start(UPDATE_PERIOD_SHORT);
+        if (nullptr != m_jpegDecoder)
+        {
+            (void)m_jpegDecoder->parse(data, size);
         }
-        m_isConnectionError = false;
+
         unlock();
-    });
+    };
 
-    m_client.regOnError([this]() {
-        LOG_WARNING("Connection error happened.");
+    m_albumArtRequest.onResponse = [this](const HttpResponse& rsp){
+        lock();
+        handleAlbumArtResponse(rsp);
+        unlock();
+    };
+
+    m_albumArtRequest.onError = [this]() {
+        LOG_WARNING("Album art request failed.");
 
         lock();
-        m_isConnectionError = true;
+
+        if (nullptr != m_jpegDecoder)
+        {
+            delete m_jpegDecoder;
+            m_jpegDecoder = nullptr;
+        }
+
+        /* Try again with the next state update. */
+        m_albumArtUrl.clear();
+
         unlock();
-    });
+    };
+}
+
+bool VolumioPlugin::showAlbumArt(const String& url)
+{
+    bool                status  = false;
+    const IndexedImage* image   = ImageCache::getInstance().acquire(url);
+
+    if (nullptr != image)
+    {
+        /* The sprite widget takes the album art from the image cache by its URL. */
+        status = m_spriteWidget.load(FILESYSTEM, url);
+
+        ImageCache::getInstance().release(image);
+    }
+    /* Request it only once, till it is cached or the request failed. */
+    else if ((url != m_albumArtUrl) &&
+             (nullptr == m_jpegDecoder))
+    {
+        m_jpegDecoder = new JpegThumbDecoder();
+
+        if (nullptr != m_jpegDecoder)
+        {
+            (void)m_jpegDecoder->begin(ICON_WIDTH, ICON_HEIGHT);
+
+            m_albumArtUrl           = url;
+            m_albumArtRequest.url   = url;
+
+            if (false == HttpClientPool::getInstance().request(m_albumArtRequest))
+            {
+                LOG_WARNING("GET %s failed.", url.c_str());
+
+                delete m_jpegDecoder;
+                m_jpegDecoder = nullptr;
+                m_albumArtUrl.clear();
+            }
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return status;
+}
+
+void VolumioPlugin::handleAlbumArtResponse(const HttpResponse& rsp)
+{
+    Color           bitmap[ICON_WIDTH * ICON_HEIGHT];
+    IndexedImage*   image   = nullptr;
+
+    if (nullptr == m_jpegDecoder)
+    {
+        ;
+    }
+    else if (HttpStatus::STATUS_CODE_OK != rsp.getStatusCode())
+    {
+        LOG_WARNING("Album art not available: %u", rsp.getStatusCode());
+    }
+    /* Only baseline JPEG files are supported. Otherwise the play icon
+     * keeps shown and the album art is not requested again.
+     */
+    else if ((false == m_jpegDecoder->isComplete()) ||
+             (false == m_jpegDecoder->getThumbnail(bitmap)))
+    {
+        LOG_WARNING("Album art not supported: %s", m_albumArtUrl.c_str());
+    }
+    else
+    {
+        image = new IndexedImage();
+
+        if (nullptr != image)
+        {
+            if ((false == image->set(bitmap, ICON_WIDTH, ICON_HEIGHT)) ||
+                (false == ImageCache::getInstance().add(m_albumArtUrl, image)))
+            {
+                delete image;
+            }
+            else
+            {
+                /* The cache owns the image now. It is shown with the next
+                 * state update. If it gets evicted, it will be requested again.
+                 */
+                ImageCache::getInstance().release(image);
+                m_albumArtUrl.clear();
+            }
+        }
+    }
+
+    if (nullptr != m_jpegDecoder)
+    {
+        delete m_jpegDecoder;
+        m_jpegDecoder = nullptr;
+    }
+
+    return;
 }
 
 bool VolumioPlugin::saveConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     jsonDoc["host"] = m_volumioHost;
     
-    if (false == jsonFile.save(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration.");
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", m_configurationFilename.c_str());
+        LOG_INFO("Configuration saved.");
     }
 
     return status;
@@ -623,13 +925,12 @@ bool VolumioPlugin::saveConfiguration()
 bool VolumioPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    if (false == jsonFile.load(m_configurationFilename, jsonDoc))
+    if (false == ConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", m_configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration.");
         status = false;
     }
     else if (false == jsonDoc["host"].is<String>())
@@ -645,17 +946,6 @@ bool VolumioPlugin::loadConfiguration()
     return status;
 }
 
-void VolumioPlugin::createConfigDirectory()
-{
-    if (false == FILESYSTEM.exists(CONFIG_PATH))
-    {
-        if (false == FILESYSTEM.mkdir(CONFIG_PATH))
-        {
-            LOG_WARNING("Couldn't create directory: %s", CONFIG_PATH);
-        }
-    }
-}
-
 void VolumioPlugin::lock() const
 {
     if (nullptr != m_xMutex)
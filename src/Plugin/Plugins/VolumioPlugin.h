@@ -45,11 +45,14 @@
  *****************************************************************************/
 #include <stdint.h>
 #include "Plugin.hpp"
-#include "AsyncHttpClient.h"
+#include "HttpClientPool.h"
+#include "JsonFieldFilter.h"
 
 #include <Canvas.h>
-#include <BitmapWidget.h>
+#include <SpriteWidget.h>
 #include <TextWidget.h>
+#include <EventTimer.hpp>
+#include <JpegThumbDecoder.h>
 
 /******************************************************************************
  * Macros
@@ -67,7 +70,7 @@
  * Change VOLUMIO host address via REST API:
  * Text: POST \c "<base-uri>/host?set=<host-address>"
  */
-class VolumioPlugin : public Plugin
+class VolumioPlugin : public Plugin, public ITimerListener
 {
 public:
 
@@ -81,20 +84,24 @@ public:
         Plugin(name, uid),
         m_textCanvas(nullptr),
         m_iconCanvas(nullptr),
-        m_bitmapWidget(),
+        m_spriteWidget(),
         m_textWidget("\\calign?"),
         m_volumioHost("volumio.fritz.box"),
         m_configurationFilename(),
+        m_cfgGeneration(0U),
         m_urlIcon(),
         m_urlText(),
-        m_requestTimer(),
-        m_offlineTimer(),
+        m_requestTimer(*this),
+        m_offlineTimer(*this),
         m_url(),
         m_callbackWebHandler(nullptr),
         m_xMutex(nullptr),
-        m_isConnectionError(false),
         m_lastSeekValue(0U),
-        m_pos(0U)
+        m_pos(0U),
+        m_queueLength(0U),
+        m_albumArtRequest(),
+        m_jpegDecoder(nullptr),
+        m_albumArtUrl()
     {
         /* Move the text widget one line lower for better look. */
         m_textWidget.move(0, 1);
@@ -107,16 +114,13 @@ public:
      */
     ~VolumioPlugin()
     {
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
+        destroyResource(m_iconCanvas);
+        destroyResource(m_textCanvas);
 
-        if (nullptr != m_textCanvas)
+        if (nullptr != m_jpegDecoder)
         {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
+            delete m_jpegDecoder;
+            m_jpegDecoder = nullptr;
         }
 
         if (nullptr != m_xMutex)
@@ -152,12 +156,19 @@ public:
     void stop() final;
 
     /**
-     * Process the plugin.
-     * Overwrite it if your plugin has cyclic stuff to do without being in a
-     * active slot.
+     * Will be called by the timer service, if one of the plugin timers timed out.
+     *
+     * @param[in] timer Event timer, which timed out
      */
-    void process(void) final;
+    void onTimeout(EventTimer& timer) final;
     
+    /**
+     * Prepare the plugin to be set active soon. It imports a uploaded
+     * configuration file, so it is not necessary during the slot change
+     * anymore.
+     */
+    void prepare() final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -175,17 +186,17 @@ public:
     /**
      * Register web interface, e.g. REST API functionality.
      *
-     * @param[in] srv       Webserver
+     * @param[in] srv       Plugin web router
      * @param[in] baseUri   Base URI, use this and append plugin specific part.
      */
-    void registerWebInterface(AsyncWebServer& srv, const String& baseUri) final;
+    void registerWebInterface(PluginWebRouter& srv, const String& baseUri) final;
 
     /**
      * Unregister web interface.
      *
-     * @param[in] srv   Webserver
+     * @param[in] srv   Plugin web router
      */
-    void unregisterWebInterface(AsyncWebServer& srv) final;
+    void unregisterWebInterface(PluginWebRouter& srv) final;
 
     /**
      * Update the display.
@@ -241,11 +252,6 @@ private:
      */
     static const char*      IMAGE_PATH_PAUSE_ICON;
 
-    /**
-     * Configuration path within the filesystem.
-     */
-    static const char*      CONFIG_PATH;
-
     /**
      * Period in ms for requesting data from server.
      * This is used in case the last request to the server was successful.
@@ -260,6 +266,46 @@ private:
      */
     static const uint32_t   UPDATE_PERIOD_SHORT = (10U * 1000U);
 
+    /**
+     * Max. length of the artist in the response.
+     */
+    static const size_t     MAX_ARTIST_LENGTH   = 64U;
+
+    /**
+     * Max. length of the service in the response.
+     */
+    static const size_t     MAX_SERVICE_LENGTH  = 32U;
+
+    /**
+     * Max. length of the status in the response.
+     */
+    static const size_t     MAX_STATUS_LENGTH   = 16U;
+
+    /**
+     * Max. length of the title in the response.
+     */
+    static const size_t     MAX_TITLE_LENGTH    = 128U;
+
+    /**
+     * Max. length of the album art URL in the response.
+     */
+    static const size_t     MAX_ALBUM_ART_LENGTH    = 256U;
+
+    /**
+     * Max. number of tracks in the queue, which are counted.
+     */
+    static const size_t     MAX_QUEUE_LENGTH    = 256U;
+
+    /**
+     * Index of the queue response in the combined poll.
+     */
+    static const uint8_t    RSP_INDEX_QUEUE     = 0U;
+
+    /**
+     * Index of the state response in the combined poll.
+     */
+    static const uint8_t    RSP_INDEX_STATE     = 1U;
+
     /**
      * Period in ms after which the plugin gets automatically disabled if no new
      * data is available.
@@ -267,22 +313,27 @@ private:
     static const uint32_t   OFFLINE_PERIOD      = (60U * 1000U);
 
     Canvas*                     m_textCanvas;               /**< Canvas used for the text widget. */
-    Canvas*                     m_iconCanvas;               /**< Canvas used for the bitmap widget. */
-    BitmapWidget                m_bitmapWidget;             /**< Bitmap widget, used to show the icon. */
+    Canvas*                     m_iconCanvas;               /**< Canvas used for the sprite widget. */
+    SpriteWidget                m_spriteWidget;             /**< Sprite widget, used to show the (animated) icon. */
     TextWidget                  m_textWidget;               /**< Text widget, used for showing the text. */
     String                      m_volumioHost;              /**< Host address of the VOLUMIO server. */
-    String                      m_configurationFilename;    /**< String used for specifying the configuration filename. */
+    String                      m_configurationFilename;    /**< Name of the configuration file, which is imported if uploaded. */
+    uint32_t                    m_cfgGeneration;            /**< Filesystem generation of the last import check. */
     String                      m_urlIcon;                  /**< REST API URL for updating the icon */
     String                      m_urlText;                  /**< REST API URL for updating the text */
-    AsyncHttpClient             m_client;                   /**< Asynchronous HTTP client. */
-    SimpleTimer                 m_requestTimer;             /**< Timer used for cyclic request of new data. */
-    SimpleTimer                 m_offlineTimer;             /**< Timer used for offline detection. */
+    HttpClientPool::Request     m_httpRequest;              /**< HTTP request, which is sent via the HTTP client pool. */
+    JsonFieldFilter             m_jsonFilter;               /**< Filter with the needed fields of the JSON response. */
+    EventTimer                  m_requestTimer;             /**< Timer used for cyclic request of new data. */
+    EventTimer                  m_offlineTimer;             /**< Timer used for offline detection. */
     String                      m_url;                      /**< REST API URL */
     AsyncCallbackWebHandler*    m_callbackWebHandler;       /**< Callback web handler */
     SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
-    bool                        m_isConnectionError;        /**< Is connection error happened? */
     uint32_t                    m_lastSeekValue;            /**< Last seek value, retrieved from VOLUMIO. Used to cross-check the provided status. */
     uint8_t                     m_pos;                      /**< Current music position in percent. */
+    size_t                      m_queueLength;              /**< Number of tracks in the queue, 0 if unknown. */
+    HttpClientPool::Request     m_albumArtRequest;          /**< HTTP request of the album art. */
+    JpegThumbDecoder*           m_jpegDecoder;              /**< Decoder of the album art, only available during its request. */
+    String                      m_albumArtUrl;              /**< URL of the requested album art, which is not cached. */
 
     /**
      * Instance specific web request handler, called by the static web request
@@ -300,25 +351,62 @@ private:
     bool startHttpRequest(void);
 
     /**
-     * Register callback function on response reception.
+     * Prepare the HTTP request and register its callback functions.
+     */
+    void initHttpRequest(void);
+
+    /**
+     * Handle the response with the playback state.
+     *
+     * @param[in] rsp   Response
+     */
+    void handleStateResponse(const HttpResponse& rsp);
+
+    /**
+     * Handle the response with the queue.
+     *
+     * @param[in] rsp   Response
+     */
+    void handleQueueResponse(const HttpResponse& rsp);
+
+    /**
+     * Prepare the HTTP request of the album art and register its callback
+     * functions.
+     */
+    void initAlbumArtRequest(void);
+
+    /**
+     * Show the album art, if it is cached. Otherwise it is requested and
+     * shown after the next state update. The plugin must be locked before.
+     *
+     * @param[in] url   Album art URL
+     *
+     * @return If the album art is shown, it will return true otherwise false.
+     */
+    bool showAlbumArt(const String& url);
+
+    /**
+     * Handle the completely received album art.
+     *
+     * @param[in] rsp   Response
      */
-    void initHttpClient(void);
+    void handleAlbumArtResponse(const HttpResponse& rsp);
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the configuration store.
      */
     bool saveConfiguration();
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the configuration store.
      */
     bool loadConfiguration();
 
     /**
-     * If configuration directory doesn't exists, it will be created.
-     * Otherwise nothing happens.
+     * Create the canvases and load the icon from filesystem, if not
+     * already done. The plugin must be locked before.
      */
-    void createConfigDirectory();
+    void createCanvases();
 
     /**
      * Protect against concurrent access.
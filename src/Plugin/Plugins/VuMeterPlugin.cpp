@@ -0,0 +1,193 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Audio volume plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "VuMeterPlugin.h"
+#include "MicDrv.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint8_t decay(uint8_t value, uint8_t level, uint8_t step);
+static uint16_t toPixels(uint8_t level, uint16_t width);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void VuMeterPlugin::start()
+{
+    (void)MicDrv::getInstance().begin();
+    return;
+}
+
+void VuMeterPlugin::stop()
+{
+    MicDrv::getInstance().end();
+    return;
+}
+
+void VuMeterPlugin::active(IGfx& gfx)
+{
+    m_bar   = 0U;
+    m_peak  = 0U;
+
+    /* Clear display */
+    gfx.fillScreen(ColorDef::BLACK);
+
+    return;
+}
+
+void VuMeterPlugin::inactive()
+{
+    /* Nothing to do. */
+    return;
+}
+
+void VuMeterPlugin::update(IGfx& gfx)
+{
+    const Spectrum::Levels& levels  = MicDrv::getInstance().getLevels();
+    const uint16_t          WIDTH   = gfx.getWidth();
+    const uint16_t          HEIGHT  = gfx.getHeight();
+    uint16_t                yellowX = toPixels(LEVEL_YELLOW, WIDTH);
+    uint16_t                redX    = toPixels(LEVEL_RED, WIDTH);
+    uint16_t                barX    = 0U;
+    uint16_t                peakX   = 0U;
+    int16_t                 y       = 0;
+
+    m_bar   = decay(m_bar, levels.volume, BAR_DECAY);
+    m_peak  = decay(m_peak, m_bar, PEAK_DECAY);
+
+    barX    = toPixels(m_bar, WIDTH);
+    peakX   = toPixels(m_peak, WIDTH);
+
+    /* The colored segments end at the bar. */
+    if (yellowX > barX)
+    {
+        yellowX = barX;
+    }
+
+    if (redX > barX)
+    {
+        redX = barX;
+    }
+
+    for(y = 0; y < HEIGHT; ++y)
+    {
+        gfx.fillSpan(0, y, yellowX, ColorDef::GREEN);
+        gfx.fillSpan(yellowX, y, redX - yellowX, ColorDef::YELLOW);
+        gfx.fillSpan(redX, y, barX - redX, ColorDef::RED);
+        gfx.fillSpan(barX, y, WIDTH - barX, ColorDef::BLACK);
+
+        if ((0U < peakX) &&
+            (peakX > barX))
+        {
+            gfx.fillSpan(peakX - 1U, y, 1U, ColorDef::WHITE);
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Follow a level immediately, if it rises, otherwise decay slowly.
+ *
+ * @param[in] value Current value
+ * @param[in] level Level to follow
+ * @param[in] step  Decay per call
+ *
+ * @return New value
+ */
+static uint8_t decay(uint8_t value, uint8_t level, uint8_t step)
+{
+    if (level >= value)
+    {
+        value = level;
+    }
+    else if ((value - level) > step)
+    {
+        value -= step;
+    }
+    else
+    {
+        value = level;
+    }
+
+    return value;
+}
+
+/**
+ * Get the width in pixels of a level.
+ *
+ * @param[in] level Level
+ * @param[in] width Max. width in pixels
+ *
+ * @return Width in pixels
+ */
+static uint16_t toPixels(uint8_t level, uint16_t width)
+{
+    return (static_cast<uint32_t>(level) * width + (Spectrum::LEVEL_MAX / 2U)) / Spectrum::LEVEL_MAX;
+}
@@ -0,0 +1,156 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Audio volume plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __VUMETERPLUGIN_H__
+#define __VUMETERPLUGIN_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "Plugin.hpp"
+
+#include <Spectrum.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Shows the audio volume of the microphone as horizontal bar, like a VU
+ * meter, with a falling peak. The bar rises immediately and falls slowly.
+ */
+class VuMeterPlugin : public Plugin
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    VuMeterPlugin(const String& name, uint16_t uid) :
+        Plugin(name, uid),
+        m_bar(0U),
+        m_peak(0U)
+    {
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~VuMeterPlugin()
+    {
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new VuMeterPlugin(name, uid);
+    }
+
+    /**
+     * Start the plugin, which starts the microphone capture.
+     */
+    void start() final;
+
+    /**
+     * Stop the plugin, which stops the microphone capture.
+     */
+    void stop() final;
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(IGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
+    /**
+     * Update the display.
+     * The scheduler will call this method periodically.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void update(IGfx& gfx) final;
+
+private:
+
+    /** Level decrease of the bar per frame */
+    static const uint8_t    BAR_DECAY       = 12U;
+
+    /** Level decrease of the peak per frame */
+    static const uint8_t    PEAK_DECAY      = 2U;
+
+    /** Level, above which the bar is yellow. */
+    static const uint8_t    LEVEL_YELLOW    = 160U;
+
+    /** Level, above which the bar is red. */
+    static const uint8_t    LEVEL_RED       = 220U;
+
+    uint8_t m_bar;  /**< Level of the bar */
+    uint8_t m_peak; /**< Peak level */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __VUMETERPLUGIN_H__ */
+
+/** @} */
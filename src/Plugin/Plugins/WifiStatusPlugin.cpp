@@ -64,50 +64,8 @@ void WifiStatusPlugin::active(IGfx& gfx)
 {
     gfx.fillScreen(ColorDef::BLACK);
 
-    if (nullptr == m_dsp)
-    {
-        m_dsp           = new Canvas(gfx.getWidth(), WIFI_ICON_HEIGHT, 0, 0);
-        m_iconCanvas    = new Canvas(WIFI_ICON_WIDTH, WIFI_ICON_HEIGHT, 0, 0, true);
-        m_textCanvas    = new Canvas(gfx.getWidth() - WIFI_ICON_WIDTH - 1U, WIFI_ICON_HEIGHT, WIFI_ICON_WIDTH + 1, 0);
-
-        if ((nullptr == m_dsp) ||
-            (nullptr == m_iconCanvas) ||
-            (nullptr == m_textCanvas))
-        {
-            if (nullptr != m_dsp)
-            {
-                delete m_dsp;
-                m_dsp = nullptr;
-            }
-
-            if (nullptr != m_iconCanvas)
-            {
-                delete m_iconCanvas;
-                m_iconCanvas = nullptr;
-            }
-
-            if (nullptr != m_textCanvas)
-            {
-                delete m_textCanvas;
-                m_textCanvas = nullptr;
-            }
-        }
-        else
-        {
-            (void)m_dsp->addWidget(*m_iconCanvas);
-            (void)m_dsp->addWidget(*m_textCanvas);
-
-            (void)m_iconCanvas->addWidget(m_alertWidget);
-            (void)m_textCanvas->addWidget(m_textWidget);
-
-            m_alertWidget.move(0, 1);
-            m_alertWidget.setFormatStr("");
-            m_alertWidget.setTextColor(ColorDef::ORANGE);
-
-            m_textWidget.move(0, 1);
-            m_textWidget.setFormatStr("\\calignWiFi");
-        }
-    }
+    /* The display was cleared, therefore everything must be drawn again. */
+    m_textWidget.invalidate();
 
     /* Force update of the status information */
     m_timer.start(0U);
@@ -124,52 +82,54 @@ void WifiStatusPlugin::inactive()
 
 void WifiStatusPlugin::update(IGfx& gfx)
 {
-    if (nullptr != m_dsp)
+    if ((true == m_timer.isTimerRunning()) &&
+        (true == m_timer.isTimeout()))
     {
-        if ((true == m_timer.isTimerRunning()) &&
-            (true == m_timer.isTimeout()))
+        /* The views are windows onto the display, nothing is allocated. */
+        CanvasView  iconView(gfx, 0, 0, WIFI_ICON_WIDTH, WIFI_ICON_HEIGHT);
+        CanvasView  textView(gfx, WIFI_ICON_WIDTH + 1, 0, gfx.getWidth() - WIFI_ICON_WIDTH - 1U, WIFI_ICON_HEIGHT);
+
+        int8_t      rssi                = -100; // dbm
+        uint8_t     quality             = 0U;   // percent
+        wl_status_t connectionStatus    = WiFi.status();
+
+        /* Only in station mode it makes sense to retrieve the RSSI.
+         * Otherwise keep it -100 dbm.
+         */
+        if (WIFI_MODE_STA == WiFi.getMode())
         {
-            int8_t      rssi                = -100; // dbm
-            uint8_t     quality             = 0U;   // percent
-            wl_status_t connectionStatus    = WiFi.status();
-
-            /* Only in station mode it makes sense to retrieve the RSSI.
-             * Otherwise keep it -100 dbm.
-             */
-            if (WIFI_MODE_STA == WiFi.getMode())
-            {
-                rssi = WiFi.RSSI();
-            }
-
-            quality = WiFiUtil::getSignalQuality(rssi);
+            rssi = WiFi.RSSI();
+        }
 
-            gfx.fillScreen(ColorDef::BLACK);
+        quality = WiFiUtil::getSignalQuality(rssi);
 
-            if (WL_CONNECTED != connectionStatus)
+        if (WL_CONNECTED != connectionStatus)
+        {
+            if (false == m_toggle)
             {
-                if (false == m_toggle)
-                {
-                    m_alertWidget.setFormatStr("");
-                    m_toggle = true;
-                }
-                else
-                {
-                    m_alertWidget.setFormatStr("\\calign!");
-                    m_toggle = false;
-                }
+                m_alertWidget.setFormatStr("");
+                m_toggle = true;
             }
             else
             {
-                m_alertWidget.setFormatStr("");
-                m_toggle = true;
+                m_alertWidget.setFormatStr("\\calign!");
+                m_toggle = false;
             }
+        }
+        else
+        {
+            m_alertWidget.setFormatStr("");
+            m_toggle = true;
+        }
 
-            updateWifiStatus(quality);
-            m_dsp->update(gfx);
+        /* The alert is shown above the signal strength bars. */
+        updateWifiStatus(iconView, quality);
+        m_alertWidget.update(iconView);
 
-            /* Restart period */
-            m_timer.start(PERIOD);
-        }
+        (void)textView.drawWidget(m_textWidget);
+
+        /* Restart period */
+        m_timer.start(PERIOD);
     }
 
     return;
@@ -183,11 +143,11 @@ void WifiStatusPlugin::update(IGfx& gfx)
  * Private Methods
  *****************************************************************************/
 
-void WifiStatusPlugin::updateWifiStatus(uint8_t quality)
+void WifiStatusPlugin::updateWifiStatus(IGfx& iconView, uint8_t quality)
 {
     uint8_t index = 0U;
 
-    m_iconCanvas->fillScreen(ColorDef::BLACK);
+    iconView.fillScreen(ColorDef::BLACK);
 
     /* Draw signal strength bar steps:
      *          ##
@@ -212,7 +172,7 @@ void WifiStatusPlugin::updateWifiStatus(uint8_t quality)
             color = ColorDef::GRAY;
         }
 
-        m_iconCanvas->fillRect(x, y, WIFI_BAR_WIDTH, height, color);
+        iconView.fillRect(x, y, WIFI_BAR_WIDTH, height, color);
     }
 }
 
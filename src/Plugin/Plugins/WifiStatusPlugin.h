@@ -46,7 +46,7 @@
 #include <stdint.h>
 #include "Plugin.hpp"
 
-#include <Canvas.h>
+#include <CanvasView.hpp>
 #include <TextWidget.h>
 #include <SimpleTimer.hpp>
 
@@ -73,14 +73,17 @@ public:
      */
     WifiStatusPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_dsp(nullptr),
-        m_iconCanvas(nullptr),
-        m_textCanvas(nullptr),
         m_textWidget(),
         m_alertWidget(),
         m_timer(),
         m_toggle(true)
     {
+        m_alertWidget.move(0, 1);
+        m_alertWidget.setFormatStr("");
+        m_alertWidget.setTextColor(ColorDef::ORANGE);
+
+        m_textWidget.move(0, 1);
+        m_textWidget.setFormatStr("\\calignWiFi");
     }
 
     /**
@@ -88,23 +91,6 @@ public:
      */
     ~WifiStatusPlugin()
     {
-        if (nullptr != m_dsp)
-        {
-            delete m_dsp;
-            m_dsp = nullptr;
-        }
-
-        if (nullptr != m_iconCanvas)
-        {
-            delete m_iconCanvas;
-            m_iconCanvas = nullptr;
-        }
-
-        if (nullptr != m_textCanvas)
-        {
-            delete m_textCanvas;
-            m_textCanvas = nullptr;
-        }
     }
 
     /**
@@ -180,9 +166,6 @@ private:
      */
     const uint16_t  WIFI_ICON_HEIGHT        = 8U;
 
-    Canvas*     m_dsp;          /**< Display drawing area */
-    Canvas*     m_iconCanvas;   /**< Drawing area of the wifi icon */
-    Canvas*     m_textCanvas;   /**< Drawing area of the text */
     TextWidget  m_textWidget;   /**< Text widget, used for showing the text. */
     TextWidget  m_alertWidget;  /**< Text widget, used for showing alert (wifi disconnected). */
     SimpleTimer m_timer;        /**< Timer for periodic stuff */
@@ -191,9 +174,10 @@ private:
     /**
      * Update wifi status.
      *
+     * @param[in] iconView  Drawing area of the wifi icon
      * @param[in] quality   Signal quality in percent [0; 100].
      */
-    void updateWifiStatus(uint8_t quality);
+    void updateWifiStatus(IGfx& iconView, uint8_t quality);
 };
 
 /******************************************************************************
@@ -33,8 +33,10 @@
  * Includes
  *****************************************************************************/
 #include "APState.h"
+#include "CrashTrace.h"
 #include <Arduino.h>
 #include "SysMsg.h"
+#include "SysMsgBitmaps.h"
 #include "MyWebServer.h"
 #include "Settings.h"
 #include "CaptivePortal.h"
@@ -90,6 +92,8 @@ void APState::entry(StateMachine& sm)
     String wifiApSSID;
     String wifiApPassphrase;
 
+    CrashTrace::getInstance().add(CrashTrace::TYPE_STATE, CrashTrace::SYS_STATE_AP);
+
     LOG_INFO("Setup access point.");
 
     /* Get necessary settings. */
@@ -118,11 +122,9 @@ void APState::entry(StateMachine& sm)
      */
     if (false == WiFi.softAPConfig(LOCAL_IP, GATEWAY, SUBNET))
     {
-        String errorStr = "Configure wifi access point failed.";
-
         /* Fatal error */
-        LOG_FATAL(errorStr);
-        SysMsg::getInstance().show(errorStr);
+        LOG_FATAL("Configure wifi access point failed.");
+        SysMsg::getInstance().show(SYS_MSG_AP_CONFIG_FAILED);
 
         sm.setState(ErrorState::getInstance());
     }
@@ -144,22 +146,18 @@ void APState::entry(StateMachine& sm)
      */
     else if (false == WiFi.softAPsetHostname(hostname.c_str()))
     {
-        String errorStr = "Can't set AP hostname.";
-
         /* Fatal error */
-        LOG_FATAL(errorStr);
-        SysMsg::getInstance().show(errorStr);
+        LOG_FATAL("Can't set AP hostname.");
+        SysMsg::getInstance().show(SYS_MSG_AP_HOSTNAME_FAILED);
 
         sm.setState(ErrorState::getInstance());
     }
     /* Setup wifi access point. */
     else if (false == WiFi.softAP(wifiApSSID.c_str(), wifiApPassphrase.c_str()))
     {
-        String errorStr = "Setup wifi access point failed.";
-
         /* Fatal error */
-        LOG_FATAL(errorStr);
-        SysMsg::getInstance().show(errorStr);
+        LOG_FATAL("Setup wifi access point failed.");
+        SysMsg::getInstance().show(SYS_MSG_AP_SETUP_FAILED);
 
         sm.setState(ErrorState::getInstance());
     }
@@ -170,7 +168,7 @@ void APState::entry(StateMachine& sm)
         infoStr += wifiApSSID;
 
         /* Start DNS and redirect to webserver. */
-        if (false == m_dnsServer.start(DNS_PORT, "*", WiFi.softAPIP()))
+        if (false == m_dnsResponder.start(DNS_PORT, WiFi.softAPIP()))
         {
             LOG_WARNING("Couldn't start DNS.");
 
@@ -178,10 +176,6 @@ void APState::entry(StateMachine& sm)
             infoStr += " IP: ";
             infoStr += WiFi.softAPIP().toString();
         }
-        else
-        {
-            m_dnsServer.setErrorReplyCode(DNSReplyCode::NoError);
-        }
 
         LOG_INFO(infoStr);
         SysMsg::getInstance().show(infoStr);
@@ -192,8 +186,6 @@ void APState::entry(StateMachine& sm)
 
 void APState::process(StateMachine& sm)
 {
-    m_dnsServer.processNextRequest();
-
     if (true == CaptivePortal::isRestartRequested())
     {
         sm.setState(RestartState::getInstance());
@@ -210,7 +202,7 @@ void APState::exit(StateMachine& sm)
     (void)WiFi.softAPdisconnect();
 
     /* Stop DNS */
-    m_dnsServer.stop();
+    m_dnsResponder.stop();
 
     return;
 }
@@ -46,7 +46,7 @@
 #include <stdint.h>
 #include <StateMachine.hpp>
 #include <IPAddress.h>
-#include <DNSServer.h>
+#include "DnsResponder.h"
 
 /******************************************************************************
  * Macros
@@ -96,6 +96,21 @@ public:
      */
     void exit(StateMachine& sm) final;
 
+    /**
+     * Get the max. time, the state may wait for an event, until it needs to
+     * be processed again.
+     *
+     * @return Wait time in ms
+     */
+    uint32_t getWaitTime() const final
+    {
+        /* The restart request of the captive portal is polled. */
+        return PROCESS_PERIOD;
+    }
+
+    /** Processing period in ms. */
+    static const uint32_t   PROCESS_PERIOD  = 40U;
+
     /**
      * Minimum length of the passphrase. Don't change it, because
      * it depends on the lower layer.
@@ -116,13 +131,13 @@ public:
 
 private:
 
-    DNSServer   m_dnsServer;    /**< DNS server, used for captive portal. */
+    DnsResponder    m_dnsResponder; /**< DNS responder, used for captive portal. */
 
     /**
      * Constructs the state.
      */
     APState() :
-        m_dnsServer()
+        m_dnsResponder()
     {
     }
 
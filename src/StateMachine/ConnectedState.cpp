@@ -33,13 +33,26 @@
  * Includes
  *****************************************************************************/
 #include "ConnectedState.h"
+#include "CrashTrace.h"
 #include "SysMsg.h"
+#include "SysMsgBitmaps.h"
 #include "UpdateMgr.h"
+#include "PullUpdater.h"
+#include "LinkMonitor.h"
+#include "NetBenchmark.h"
+#include "DisplaySync.h"
+#include "TelemetryPublisher.h"
 #include "MyWebServer.h"
+#include "WebSocket.h"
+#include "EventStream.h"
 #include "Settings.h"
 #include "ClockDrv.h"
+#include "RtcDrv.h"
 #include "ButtonDrv.h"
 #include "DisplayMgr.h"
+#include "MqttClient.h"
+#include "DnsCache.h"
+#include "SysEvent.h"
 
 #include "ConnectingState.h"
 #include "RestartState.h"
@@ -48,6 +61,7 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <Logging.h>
+#include <Metrics.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -65,10 +79,19 @@
  * Prototypes
  *****************************************************************************/
 
+static int32_t getRssi();
+static void notifyButtonEvent(void);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Number of established wifi connections */
+static MetricCounter    gMetricWiFiConnects("pixelix_wifi_connects_total", "Number of established wifi connections.");
+
+/** Wifi signal strength, read during export. */
+static MetricGauge      gMetricWiFiRssi("pixelix_wifi_rssi_dbm", "Wifi signal strength in dBm.", getRssi);
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -79,7 +102,13 @@ void ConnectedState::entry(StateMachine& sm)
     String hostname;
     String infoStringIp = "IP: ";
 
+    CrashTrace::getInstance().add(CrashTrace::TYPE_STATE, CrashTrace::SYS_STATE_CONNECTED);
+
     LOG_INFO("Connected.");
+    gMetricWiFiConnects.inc();
+
+    /* The network may be a different one, therefore forget the DNS results. */
+    DnsCache::getInstance().clear();
 
     /* Get hostname. */
     if (false == Settings::getInstance().open(true))
@@ -96,11 +125,9 @@ void ConnectedState::entry(StateMachine& sm)
     /* Set hostname. Note, wifi must be connected somehow. */
     if (false == WiFi.setHostname(hostname.c_str()))
     {
-        String errorStr = "Can't set AP hostname.";
-
         /* Fatal error */
-        LOG_FATAL(errorStr);
-        SysMsg::getInstance().show(errorStr);
+        LOG_FATAL("Can't set AP hostname.");
+        SysMsg::getInstance().show(SYS_MSG_AP_HOSTNAME_FAILED);
 
         sm.setState(ErrorState::getInstance());
     }
@@ -109,6 +136,30 @@ void ConnectedState::entry(StateMachine& sm)
         /* Start the ClockDriver */
         ClockDrv::getInstance().init();
 
+        /* Connect to the MQTT broker, if one is configured. */
+        MqttClient::getInstance().begin();
+
+        /* Check periodically for updates, if a manifest URL is configured. */
+        PullUpdater::getInstance().begin();
+
+        /* Monitor the link quality and roam, if necessary. */
+        LinkMonitor::getInstance().begin();
+
+        /* Load the stored network benchmark results. */
+        NetBenchmark::getInstance().begin();
+
+        /* Synchronize with the display group, if configured. */
+        DisplaySync::getInstance().begin();
+
+        /* Push the metrics to the telemetry server, if configured. */
+        TelemetryPublisher::getInstance().begin();
+
+        /* Handle the buttons. */
+        if (false == ButtonDrv::getInstance().subscribe(m_buttonEvents, notifyButtonEvent))
+        {
+            LOG_WARNING("Couldn't subscribe for button events.");
+        }
+
         /* Show hostname and IP. */
         infoStr += WiFi.getHostname(); /* Don't believe its the same as set before. */
         infoStr += " IP: ";
@@ -123,10 +174,24 @@ void ConnectedState::entry(StateMachine& sm)
 
 void ConnectedState::process(StateMachine& sm)
 {
-    ButtonDrv::State    buttonState = ButtonDrv::getInstance().getState();
+    ButtonDrv::Event    buttonEvent;
 
     /* Handle update, there may be one in the background. */
     UpdateMgr::getInstance().process();
+    PullUpdater::getInstance().process();
+    LinkMonitor::getInstance().process();
+    NetBenchmark::getInstance().process();
+    TelemetryPublisher::getInstance().process();
+
+    /* The RTC is disciplined by the NTP synchronized time. */
+    ClockDrv::getInstance().process();
+    RtcDrv::getInstance().process();
+
+    /* Stream display content to the websocket clients. */
+    WebSocketSrv::getInstance().process();
+
+    /* Publish the state changes to the event stream subscribers. */
+    EventStream::getInstance().process();
 
     /* Restart requested by update manager? This may happen after a successful received
      * new firmware or filesystem binary.
@@ -143,10 +208,10 @@ void ConnectedState::process(StateMachine& sm)
         sm.setState(ConnectingState::getInstance());
     }
 
-    /* Connect to a remote wifi network? */
-    if (ButtonDrv::STATE_TRIGGERED == buttonState)
+    /* Handle all pending button events. */
+    while(true == m_buttonEvents.pop(buttonEvent))
     {
-        DisplayMgr::getInstance().activateNextSlot();
+        handleButtonEvent(buttonEvent);
     }
 
     return;
@@ -156,6 +221,14 @@ void ConnectedState::exit(StateMachine& sm)
 {
     UTIL_NOT_USED(sm);
 
+    ButtonDrv::getInstance().unsubscribe(m_buttonEvents);
+    MqttClient::getInstance().end();
+    PullUpdater::getInstance().end();
+    LinkMonitor::getInstance().end();
+    NetBenchmark::getInstance().end();
+    DisplaySync::getInstance().end();
+    TelemetryPublisher::getInstance().end();
+
     /* Disconnect all connections */
     (void)WiFi.disconnect();
 
@@ -170,6 +243,40 @@ void ConnectedState::exit(StateMachine& sm)
  * Private Methods
  *****************************************************************************/
 
+void ConnectedState::handleButtonEvent(const ButtonDrv::Event& event)
+{
+    DisplayMgr& displayMgr = DisplayMgr::getInstance();
+
+    if (ButtonDrv::BUTTON_ID_USER == event.buttonId)
+    {
+        switch(event.type)
+        {
+        /* Show next slot */
+        case ButtonGesture::EVENT_CLICK:
+            displayMgr.activateNextSlot();
+            break;
+
+        /* Use next fade effect */
+        case ButtonGesture::EVENT_DOUBLE_CLICK:
+            displayMgr.activateNextFadeEffect(static_cast<DisplayMgr::FadeEffect>(displayMgr.getFadeEffect() + 1));
+            break;
+
+        /* Toggle automatic brightness adjustment */
+        case ButtonGesture::EVENT_LONG_PRESS:
+            if (false == displayMgr.setAutoBrightnessAdjustment(false == displayMgr.getAutoBrightnessAdjustment()))
+            {
+                LOG_WARNING("Automatic brightness adjustment not possible.");
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -177,3 +284,22 @@ void ConnectedState::exit(StateMachine& sm)
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Get wifi signal strength.
+ *
+ * @return RSSI in dBm
+ */
+static int32_t getRssi()
+{
+    return static_cast<int32_t>(WiFi.RSSI());
+}
+
+/**
+ * Wake up the system state machine, because of new button events.
+ * It is called in the button task context.
+ */
+static void notifyButtonEvent(void)
+{
+    SysEvent::getInstance().post(SysEvent::ID_BUTTON);
+}
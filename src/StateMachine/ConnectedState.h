@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <StateMachine.hpp>
 #include <WString.h>
+#include <ButtonDrv.h>
 
 /******************************************************************************
  * Macros
@@ -95,12 +96,31 @@ public:
      */
     void exit(StateMachine& sm) final;
 
+    /**
+     * Get the max. time, the state may wait for an event, until it needs to
+     * be processed again.
+     *
+     * @return Wait time in ms
+     */
+    uint32_t getWaitTime() const final
+    {
+        /* The update, the link monitor and the display streaming are polled. */
+        return PROCESS_PERIOD;
+    }
+
+    /** Processing period in ms of the polled services. */
+    static const uint32_t   PROCESS_PERIOD  = 40U;
+
 private:
 
+    /** Button events, which are handled in this state. */
+    ButtonDrv::EventQueue   m_buttonEvents;
+
     /**
      * Constructs the state.
      */
-    ConnectedState()
+    ConnectedState() :
+        m_buttonEvents()
     {
     }
 
@@ -114,6 +134,12 @@ private:
     ConnectedState(const ConnectedState& state);
     ConnectedState& operator=(const ConnectedState& state);
 
+    /**
+     * Handle a button event.
+     *
+     * @param[in] event Button event
+     */
+    void handleButtonEvent(const ButtonDrv::Event& event);
 };
 
 /******************************************************************************
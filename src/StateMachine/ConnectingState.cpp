@@ -33,8 +33,10 @@
  * Includes
  *****************************************************************************/
 #include "ConnectingState.h"
+#include "CrashTrace.h"
 #include "Settings.h"
 #include "SysMsg.h"
+#include "SysMsgBitmaps.h"
 
 #include "IdleState.h"
 #include "ConnectedState.h"
@@ -69,40 +71,37 @@
 
 void ConnectingState::entry(StateMachine& sm)
 {
-    /* Are remote wifi network informations available? */
-    if (true == Settings::getInstance().open(true))
-    {
-        m_wifiSSID          = Settings::getInstance().getWifiSSID().getValue();
-        m_wifiPassphrase    = Settings::getInstance().getWifiPassphrase().getValue();
+    CrashTrace::getInstance().add(CrashTrace::TYPE_STATE, CrashTrace::SYS_STATE_CONNECTING);
 
-        Settings::getInstance().close();
-    }
+    loadCredentials();
 
     /* No remote wifi network informations available? */
-    if ((0 == m_wifiSSID.length()) ||
-        (0 == m_wifiPassphrase.length()))
+    if (false == isCredentialAvailable())
     {
-        String infoStr = "Keep button pressed and reboot. Set SSID/password via webserer.";
-
-        LOG_INFO(infoStr);
-        SysMsg::getInstance().show(infoStr);
+        LOG_INFO("Keep button pressed and reboot. Set SSID/password via webserer.");
+        SysMsg::getInstance().show(SYS_MSG_KEEP_BUTTON_PRESSED);
 
         sm.setState(IdleState::getInstance());
     }
 
-    /* Disable retry mechanism. */
-    m_retryTimer.stop();
+    /* Disable retry mechanism, but keep a connection establishment, which
+     * was started in advance.
+     */
+    if (false == m_isConnectionPending)
+    {
+        m_retryTimer.stop();
+    }
+
+    m_isConnectionPending = false;
 
     /* Disable automatic reconnect, so we are able to handle the
      * reconnect behaviour by ourself.
      */
     if (false == WiFi.setAutoReconnect(false))
     {
-        String errorStr = "Set autom. reconnect failed.";
-
         /* Fatal error */
-        LOG_FATAL(errorStr);
-        SysMsg::getInstance().show(errorStr);
+        LOG_FATAL("Set autom. reconnect failed.");
+        SysMsg::getInstance().show(SYS_MSG_AUTO_RECONNECT_FAILED);
 
         sm.setState(ErrorState::getInstance());
     }
@@ -121,43 +120,51 @@ void ConnectingState::process(StateMachine& sm)
         infoStr += m_wifiSSID;
         infoStr += ".";
 
-        LOG_INFO(infoStr);
-        SysMsg::getInstance().show(infoStr, 2000U, 1U, true);
+        /* Remote wifi network informations are available, try to establish a connection.
+         * The association runs in the background, while the message is shown.
+         * The retry timer waits a little bit, until retry.
+         */
+        status = startConnection();
 
-        /* Remote wifi network informations are available, try to establish a connection. */
-        status = WiFi.begin(m_wifiSSID.c_str(), m_wifiPassphrase.c_str());
+        LOG_INFO(infoStr);
+        SysMsg::getInstance().show(infoStr, 2000U, 1U);
 
-        /* Connection establishment pending? */
-        if (WL_CONNECTED != status)
-        {
-            /* Wait a little bit, until retry. */
-            m_retryTimer.start(RETRY_DELAY);
-        }
-        /* Connected */
-        else
+        /* Connected? */
+        if (WL_CONNECTED == status)
         {
             /* Disable retry mechanism. */
             m_retryTimer.stop();
 
+            storeConnectionCache(WiFi.BSSID(), WiFi.channel());
             sm.setState(ConnectedState::getInstance());
         }
     }
     /* Retry mechanism is active. */
     else
     {
-        /* Retry delay timeout? */
-        if (true == m_retryTimer.isTimeout())
+        /* Connection successful established? */
+        if (true == WiFi.isConnected())
         {
             /* Disable retry mechanism. */
             m_retryTimer.stop();
+
+            storeConnectionCache(WiFi.BSSID(), WiFi.channel());
+            sm.setState(ConnectedState::getInstance());
         }
-        /* Connection successful established? */
-        else if (true == WiFi.isConnected())
+        /* Retry delay timeout? */
+        else if (true == m_retryTimer.isTimeout())
         {
             /* Disable retry mechanism. */
             m_retryTimer.stop();
 
-            sm.setState(ConnectedState::getInstance());
+            /* The access point may have changed its channel or was replaced,
+             * therefore the next attempt scans.
+             */
+            if (true == m_isFastConnect)
+            {
+                LOG_INFO("Fast connect failed.");
+                m_channel = 0;
+            }
         }
         else
         {
@@ -177,6 +184,34 @@ void ConnectingState::exit(StateMachine& sm)
     return;
 }
 
+bool ConnectingState::beginConnection()
+{
+    bool isStarted = false;
+
+    loadCredentials();
+
+    if (true == isCredentialAvailable())
+    {
+        String infoStr = "Connecting to ";
+
+        infoStr += m_wifiSSID;
+        infoStr += ".";
+
+        LOG_INFO(infoStr);
+
+        /* Show the message until the connection is established or failed. */
+        SysMsg::getInstance().show(infoStr);
+
+        /* The retry mechanism waits for the pending connection establishment. */
+        (void)startConnection();
+        m_isConnectionPending = true;
+
+        isStarted = true;
+    }
+
+    return isStarted;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -185,6 +220,120 @@ void ConnectingState::exit(StateMachine& sm)
  * Private Methods
  *****************************************************************************/
 
+void ConnectingState::loadCredentials()
+{
+    if (true == Settings::getInstance().open(true))
+    {
+        uint8_t cache[CACHE_SIZE];
+
+        m_wifiSSID          = Settings::getInstance().getWifiSSID().getValue();
+        m_wifiPassphrase    = Settings::getInstance().getWifiPassphrase().getValue();
+        m_channel           = 0;
+
+        /* The cache is only valid for the SSID, it was created for. */
+        if (CACHE_SIZE == Settings::getInstance().getWifiCache().getValue(cache, CACHE_SIZE))
+        {
+            uint32_t hash = static_cast<uint32_t>(cache[0U]) |
+                            (static_cast<uint32_t>(cache[1U]) << 8U) |
+                            (static_cast<uint32_t>(cache[2U]) << 16U) |
+                            (static_cast<uint32_t>(cache[3U]) << 24U);
+
+            if (getSsidHash(m_wifiSSID) == hash)
+            {
+                memcpy(m_bssid, &cache[4U], BSSID_SIZE);
+                m_channel = cache[4U + BSSID_SIZE];
+            }
+        }
+
+        Settings::getInstance().close();
+    }
+
+    return;
+}
+
+wl_status_t ConnectingState::startConnection()
+{
+    wl_status_t status = WL_IDLE_STATUS;
+
+    if (0 < m_channel)
+    {
+        /* Connect directly, without scanning all channels. */
+        status          = WiFi.begin(m_wifiSSID.c_str(), m_wifiPassphrase.c_str(), m_channel, m_bssid);
+        m_isFastConnect = true;
+        m_retryTimer.start(FAST_CONNECT_TIMEOUT);
+    }
+    else
+    {
+        status          = WiFi.begin(m_wifiSSID.c_str(), m_wifiPassphrase.c_str());
+        m_isFastConnect = false;
+        m_retryTimer.start(RETRY_DELAY);
+    }
+
+    return status;
+}
+
+void ConnectingState::storeConnectionCache(const uint8_t* bssid, int32_t channel)
+{
+    if ((nullptr != bssid) &&
+        (0 < channel) &&
+        (UINT8_MAX >= channel) &&
+        ((channel != m_channel) || (0 != memcmp(bssid, m_bssid, BSSID_SIZE))))
+    {
+        uint8_t     cache[CACHE_SIZE];
+        uint32_t    hash    = getSsidHash(m_wifiSSID);
+
+        cache[0U] = static_cast<uint8_t>(hash >> 0U);
+        cache[1U] = static_cast<uint8_t>(hash >> 8U);
+        cache[2U] = static_cast<uint8_t>(hash >> 16U);
+        cache[3U] = static_cast<uint8_t>(hash >> 24U);
+        memcpy(&cache[4U], bssid, BSSID_SIZE);
+        cache[4U + BSSID_SIZE] = static_cast<uint8_t>(channel);
+
+        memcpy(m_bssid, bssid, BSSID_SIZE);
+        m_channel = channel;
+
+        /* The settings are written deferred, which doesn't delay the connected state. */
+        if (false == Settings::getInstance().open(false))
+        {
+            LOG_WARNING("Couldn't open settings.");
+        }
+        else
+        {
+            (void)Settings::getInstance().getWifiCache().setValue(cache, CACHE_SIZE);
+            Settings::getInstance().close();
+        }
+    }
+
+    return;
+}
+
+uint32_t ConnectingState::getSsidHash(const String& ssid)
+{
+    uint32_t        hash    = 2166136261U; /* FNV-1a offset basis */
+    unsigned int    idx     = 0U;
+
+    for(idx = 0U; idx < ssid.length(); ++idx)
+    {
+        hash ^= static_cast<uint8_t>(ssid[idx]);
+        hash *= 16777619U; /* FNV-1a prime */
+    }
+
+    return hash;
+}
+
+bool ConnectingState::isCredentialAvailable() const
+{
+    bool isAvailable = true;
+
+    if ((0 == m_wifiSSID.length()) ||
+        (0 == m_wifiPassphrase.length()))
+    {
+        isAvailable = false;
+    }
+
+    return isAvailable;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
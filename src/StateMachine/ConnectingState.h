@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <StateMachine.hpp>
 #include <WString.h>
+#include <WiFiType.h>
 #include <SimpleTimer.hpp>
 
 /******************************************************************************
@@ -96,9 +97,60 @@ public:
      */
     void exit(StateMachine& sm) final;
 
+    /**
+     * Get the max. time, the state may wait for an event, until it needs to
+     * be processed again. A established connection is signalled by a wifi
+     * event earlier.
+     *
+     * @return Wait time in ms
+     */
+    uint32_t getWaitTime() const final
+    {
+        uint32_t waitTime = 0U;
+
+        if (true == m_retryTimer.isTimerRunning())
+        {
+            waitTime = m_retryTimer.getRemaining();
+        }
+
+        return waitTime;
+    }
+
+    /**
+     * Start the connection establishment to the remote wifi network in advance,
+     * before the state is entered. This way the association runs in the
+     * background, while the remaining initialization takes place.
+     * The wifi station mode must be set before.
+     *
+     * @return If no remote wifi network informations are available, it will return false otherwise true.
+     */
+    bool beginConnection();
+
+    /**
+     * Set the access point, which to use for the next connection attempt,
+     * e.g. to roam to a access point with better signal quality.
+     *
+     * @param[in] bssid     BSSID of the access point
+     * @param[in] channel   Channel of the access point
+     */
+    void setPreferredAccessPoint(const uint8_t* bssid, int32_t channel)
+    {
+        storeConnectionCache(bssid, channel);
+        return;
+    }
+
     /** Retry delay after a failed connection attempt in ms. */
     static const uint32_t   RETRY_DELAY             = 30000U;
 
+    /**
+     * Max. duration in ms of a fast connection attempt with the cached
+     * channel and BSSID, until a full scan takes place.
+     */
+    static const uint32_t   FAST_CONNECT_TIMEOUT    = 5000U;
+
+    /** BSSID size in byte */
+    static const uint8_t    BSSID_SIZE              = 6U;
+
     /** Standard wait time for showing a system message in ms */
     static const uint32_t   SYS_MSG_WAIT_TIME_STD   = 2000U;
 
@@ -107,6 +159,14 @@ public:
 
 private:
 
+    /**
+     * Wifi connection cache size in byte:
+     * - FNV-1a hash of the SSID (4 byte, little endian), which invalidates the cache if the SSID changes.
+     * - BSSID (6 byte)
+     * - Channel (1 byte)
+     */
+    static const uint8_t    CACHE_SIZE              = 11U;
+
     /** Remote wifi SSID */
     String      m_wifiSSID;
 
@@ -116,13 +176,29 @@ private:
     /** Timer, used for retry mechanism. */
     SimpleTimer m_retryTimer;
 
+    /** Is a connection establishment pending, which was started in advance? */
+    bool        m_isConnectionPending;
+
+    /** BSSID of the last successful connection */
+    uint8_t     m_bssid[BSSID_SIZE];
+
+    /** Channel of the last successful connection, 0 if unknown. */
+    int32_t     m_channel;
+
+    /** Does the pending connection attempt use the cached channel and BSSID? */
+    bool        m_isFastConnect;
+
     /**
      * Constructs the state.
      */
     ConnectingState() :
         m_wifiSSID(),
         m_wifiPassphrase(),
-        m_retryTimer()
+        m_retryTimer(),
+        m_isConnectionPending(false),
+        m_bssid(),
+        m_channel(0),
+        m_isFastConnect(false)
     {
     }
 
@@ -136,6 +212,44 @@ private:
     ConnectingState(const ConnectingState& state);
     ConnectingState& operator=(const ConnectingState& state);
 
+    /**
+     * Load the remote wifi network informations from persistent memory.
+     */
+    void loadCredentials();
+
+    /**
+     * Start a connection attempt. If the channel and BSSID of the last
+     * successful connection are known, they are used to avoid the scan.
+     * The retry timer is started with the attempt specific timeout.
+     *
+     * @return Wifi status
+     */
+    wl_status_t startConnection();
+
+    /**
+     * Store the channel and BSSID of the connection cache, if they changed.
+     *
+     * @param[in] bssid     BSSID of the access point
+     * @param[in] channel   Channel of the access point
+     */
+    void storeConnectionCache(const uint8_t* bssid, int32_t channel);
+
+    /**
+     * Get the hash of the SSID, which is stored in the connection cache.
+     *
+     * @param[in] ssid  SSID
+     *
+     * @return Hash
+     */
+    static uint32_t getSsidHash(const String& ssid);
+
+    /**
+     * Are the remote wifi network informations available?
+     *
+     * @return If available, it will return true otherwise false.
+     */
+    bool isCredentialAvailable() const;
+
 };
 
 /******************************************************************************
@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "ErrorState.h"
+#include "CrashTrace.h"
 
 #include <Logging.h>
 #include <Util.h>
@@ -65,6 +66,8 @@ void ErrorState::entry(StateMachine& sm)
 {
     UTIL_NOT_USED(sm);
 
+    CrashTrace::getInstance().add(CrashTrace::TYPE_STATE, CrashTrace::SYS_STATE_ERROR);
+
     LOG_INFO("Going in error state.");
 
     return;
@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "IdleState.h"
+#include "CrashTrace.h"
 #include "DisplayMgr.h"
 
 #include <Logging.h>
@@ -66,6 +67,8 @@ void IdleState::entry(StateMachine& sm)
 {
     UTIL_NOT_USED(sm);
 
+    CrashTrace::getInstance().add(CrashTrace::TYPE_STATE, CrashTrace::SYS_STATE_IDLE);
+
     LOG_INFO("Going in idle state.");
 
     return;
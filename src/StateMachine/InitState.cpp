@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "InitState.h"
+#include "CrashTrace.h"
 
 #include <Arduino.h>
 #include <WiFi.h>
@@ -42,14 +43,23 @@
 #include "LedMatrix.h"
 #include "DisplayMgr.h"
 #include "SysMsg.h"
+#include "SysMsgBitmaps.h"
 #include "Version.h"
 #include "AmbientLightSensor.h"
+#include "ClockDrv.h"
+#include "ThermalMonitor.h"
 #include "MyWebServer.h"
 #include "UpdateMgr.h"
 #include "Settings.h"
 #include "PluginMgr.h"
+#include "PluginMemPool.h"
 #include "WebConfig.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "FileSystemMigration.h"
+#include "AssetStore.h"
+#include "ConfigStore.h"
+#include "StateStore.h"
 
 #include "APState.h"
 #include "ConnectingState.h"
@@ -59,25 +69,14 @@
 #include <Util.h>
 #include <ESPmDNS.h>
 
-#include "CountdownPlugin.h"
-#include "DatePlugin.h"
-#include "DateTimePlugin.h"
-#include "FirePlugin.h"
-#include "GameOfLifePlugin.h"
-#include "GruenbeckPlugin.h"
 #include "IconTextLampPlugin.h"
-#include "IconTextPlugin.h"
-#include "JustTextPlugin.h"
-#include "RainbowPlugin.h"
-#include "ShellyPlugSPlugin.h"
-#include "SunrisePlugin.h"
-#include "SysMsgPlugin.h"
-#include "TestPlugin.h"
-#include "TimePlugin.h"
-#include "VolumioPlugin.h"
-#include "WifiStatusPlugin.h"
 
 #include <lwip/init.h>
+#include <BitmapWidget.h>
+
+#if defined(CONFIG_PM_ENABLE)
+#include <esp_pm.h>
+#endif  /* defined(CONFIG_PM_ENABLE) */
 
 /******************************************************************************
  * Compiler Switches
@@ -95,6 +94,9 @@
  * Prototypes
  *****************************************************************************/
 
+static bool executeBitmapFileJob(const std::function<bool(void)>& job);
+static void enablePowerManagement();
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -107,14 +109,29 @@ void InitState::entry(StateMachine& sm)
 {
     bool    isError = false;
 
+    CrashTrace::getInstance().add(CrashTrace::TYPE_STATE, CrashTrace::SYS_STATE_INIT);
+
     /* Initialize hardware */
     Board::init();
 
     /* Show as soon as possible the user on the serial console that the system is booting. */
     showStartupInfoOnSerial();
 
-    /* Register plugins. This must be done before system message handler is initialized! */
-    registerPlugins();
+    /* Save power, while the display task is idle. */
+    enablePowerManagement();
+
+    /* Carve out the plugin memory pool, before any plugin is created.
+     * If it fails, the plugins will be allocated from the heap.
+     */
+    (void)PluginMemPool::getInstance().begin(PLUGIN_MEM_POOL_SIZE);
+
+    /* Start the continuous ambient light sensor sampling.
+     * If it fails, the sensor will be read directly on every measurement.
+     */
+    if (false == AmbientLightSensor::getInstance().begin())
+    {
+        LOG_WARNING("Ambient light sensor is read without filtering.");
+    }
 
     /* Initialize button driver */
     if (ButtonDrv::RET_OK != ButtonDrv::getInstance().init())
@@ -122,12 +139,18 @@ void InitState::entry(StateMachine& sm)
         LOG_FATAL("Couldn't initialize button driver.");
         isError = true;
     }
-    /* Mounting the filesystem. */
-    else if (false == FILESYSTEM.begin())
+    /* Mounting the filesystem, which may be migrated once. */
+    else if (false == FileSystemMigration::mount())
     {
         LOG_FATAL("Couldn't mount the filesystem.");
         isError = true;
     }
+    /* Start filesystem I/O service */
+    else if (false == FileIo::getInstance().begin())
+    {
+        LOG_FATAL("Failed to start the filesystem I/O service.");
+        isError = true;
+    }
     /* Start LED matrix */
     else if (false == LedMatrix::getInstance().begin())
     {
@@ -156,6 +179,34 @@ void InitState::entry(StateMachine& sm)
     {
         Settings* settings = &Settings::getInstance();
 
+        /* Bitmaps are loaded by the filesystem I/O service with high priority,
+         * because they are needed by the display.
+         */
+        BitmapWidget::setFileJobExecutor(executeBitmapFileJob);
+
+        /* Frequently used icons are provided by the optional asset pack,
+         * which is used directly from flash.
+         */
+        (void)AssetStore::begin();
+
+        /* The plugin configurations are needed, before the plugins are loaded. */
+        if (false == ConfigStore::getInstance().begin())
+        {
+            LOG_WARNING("Plugin configurations are written immediately.");
+        }
+
+        /* The last known plugin states are shown, till new data is received. */
+        if (false == StateStore::getInstance().begin())
+        {
+            LOG_WARNING("Plugin states are written at restart only.");
+        }
+
+        /* The clock plugins show the RTC time, till the time is synchronized via NTP. */
+        ClockDrv::getInstance().begin();
+
+        /* The LED matrix current is throttled, if it gets too hot. */
+        ThermalMonitor::getInstance().begin();
+
         /* Load some general configuration parameters from persistent memory. */
         if (true == settings->open(true))
         {
@@ -250,22 +301,18 @@ void InitState::exit(StateMachine& sm)
 
     if (false == WiFi.mode(wifiMode))
     {
-        String errorStr = "Set wifi mode failed.";
-
         /* Fatal error */
-        LOG_FATAL(errorStr);
-        SysMsg::getInstance().show(errorStr);
+        LOG_FATAL("Set wifi mode failed.");
+        SysMsg::getInstance().show(SYS_MSG_WIFI_MODE_FAILED);
 
         sm.setState(ErrorState::getInstance());
     }
     /* Enable mDNS */
     else if (false == MDNS.begin(hostname.c_str()))
     {
-        String errorStr = "Failed to setup mDNS.";
-
         /* Fatal error */
-        LOG_FATAL(errorStr);
-        SysMsg::getInstance().show(errorStr);
+        LOG_FATAL("Failed to setup mDNS.");
+        SysMsg::getInstance().show(SYS_MSG_MDNS_FAILED);
 
         sm.setState(ErrorState::getInstance());
     }
@@ -278,12 +325,16 @@ void InitState::exit(StateMachine& sm)
         /* Do some stuff only in wifi station mode. */
         if (false == m_isApModeRequested)
         {
-            /* In the next step the plugins are loaded and would be automatically be shown.
-             * To avoid this until the connection establishment takes place, show the following
-             * message infinite.
+            /* Start the connection establishment first, so the wifi association
+             * overlaps with loading the plugins and their configuration.
+             * Its message is shown until the connection is established, which
+             * avoids that the plugins are shown before.
              */
-            SysMsg::getInstance().show("...");
-            delay(500U); /* Just to avoid a short splash */
+            if (false == ConnectingState::getInstance().beginConnection())
+            {
+                /* Show the following message infinite instead. */
+                SysMsg::getInstance().show(SYS_MSG_ELLIPSIS);
+            }
 
             /* Load last plugin installation. */
             PluginMgr::getInstance().load();
@@ -333,44 +384,21 @@ void InitState::showStartupInfoOnDisplay()
 {
     SysMsg& sysMsg = SysMsg::getInstance();
 
+    /* The messages are queued and shown one after another, while the
+     * initialization continues.
+     */
+
     /* Show colored PIXELIX */
-    sysMsg.show("\\calign\\#FF0000P\\#0FF000I\\#00FF00X\\#000FF0E\\#0000FFL\\#F0000FI\\#FF0000X", 3000U, 2U, true);
+    sysMsg.show(SYS_MSG_PIXELIX, 3000U, 2U);
 
     /* Clear and wait */
-    sysMsg.show("", 500U, 0U, true);
+    sysMsg.show("", 500U, 0U);
 
     /* Show sw version (short) */
-    sysMsg.show(String("\\calign") + Version::SOFTWARE_VER, 3000U, 2U, true);
+    sysMsg.show(String("\\calign") + Version::SOFTWARE_VER, 3000U, 2U);
 
     /* Clear and wait */
-    sysMsg.show("", 500U, 0U, true);
-
-    return;
-}
-
-void InitState::registerPlugins()
-{
-    PluginMgr&  pluginMgr = PluginMgr::getInstance();
-
-    /* Register in alphabetic order. */
-
-    pluginMgr.registerPlugin("CountdownPlugin", CountdownPlugin::create);
-    pluginMgr.registerPlugin("DatePlugin", DatePlugin::create);
-    pluginMgr.registerPlugin("DateTimePlugin", DateTimePlugin::create);
-    pluginMgr.registerPlugin("FirePlugin", FirePlugin::create);
-    pluginMgr.registerPlugin("GameOfLifePlugin", GameOfLifePlugin::create);
-    pluginMgr.registerPlugin("GruenbeckPlugin", GruenbeckPlugin::create);
-    pluginMgr.registerPlugin("IconTextLampPlugin", IconTextLampPlugin::create);
-    pluginMgr.registerPlugin("IconTextPlugin", IconTextPlugin::create);
-    pluginMgr.registerPlugin("JustTextPlugin", JustTextPlugin::create);
-    pluginMgr.registerPlugin("RainbowPlugin", RainbowPlugin::create);
-    pluginMgr.registerPlugin("ShellyPlugSPlugin", ShellyPlugSPlugin::create);
-    pluginMgr.registerPlugin("SunrisePlugin", SunrisePlugin::create);
-    pluginMgr.registerPlugin("SysMsgPlugin", SysMsgPlugin::create);
-    pluginMgr.registerPlugin("TestPlugin", TestPlugin::create);
-    pluginMgr.registerPlugin("TimePlugin", TimePlugin::create);
-    pluginMgr.registerPlugin("VolumioPlugin", VolumioPlugin::create);
-    pluginMgr.registerPlugin("WifiStatusPlugin", WifiStatusPlugin::create);
+    sysMsg.show("", 500U, 0U);
 
     return;
 }
@@ -384,9 +412,7 @@ void InitState::welcome()
      */
     if (true == settings.open(true))
     {
-        String pluginInstallation = settings.getPluginInstallation().getValue();
-
-        if (true == pluginInstallation.isEmpty())
+        if (0U == settings.getSlotInstallation().getLength())
         {
             IconTextLampPlugin* plugin = nullptr;
 
@@ -414,3 +440,47 @@ void InitState::welcome()
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Execute a filesystem job of a bitmap widget by the filesystem I/O service.
+ *
+ * @param[in] job   Filesystem job
+ *
+ * @return Result of the job
+ */
+static bool executeBitmapFileJob(const std::function<bool(void)>& job)
+{
+    return FileIo::getInstance().execute(FileIo::PRIORITY_HIGH, job);
+}
+
+/**
+ * Enable the dynamic frequency scaling and the automatic light sleep.
+ * It is only available, if the power management is enabled in the SDK
+ * configuration. The display manager prevents the light sleep, as long
+ * as the display task is not idle.
+ */
+static void enablePowerManagement()
+{
+#if defined(CONFIG_PM_ENABLE)
+    esp_pm_config_esp32_t   pmConfig;
+    esp_err_t               ret         = ESP_OK;
+
+    /* The min. frequency keeps the APB clock at 80 MHz, which is needed for the LED matrix output. */
+    pmConfig.max_freq_mhz       = ESP.getCpuFreqMHz();
+    pmConfig.min_freq_mhz       = 80;
+    pmConfig.light_sleep_enable = true;
+
+    ret = esp_pm_configure(&pmConfig);
+
+    if (ESP_OK != ret)
+    {
+        LOG_WARNING("Power management not possible: %d", ret);
+    }
+    else
+    {
+        LOG_INFO("Power management enabled.");
+    }
+#endif  /* defined(CONFIG_PM_ENABLE) */
+
+    return;
+}
@@ -33,12 +33,18 @@
  * Includes
  *****************************************************************************/
 #include "RestartState.h"
+#include "CrashTrace.h"
 #include "DisplayMgr.h"
 #include "LedMatrix.h"
 #include "Board.h"
 #include "MyWebServer.h"
 #include "UpdateMgr.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "Settings.h"
+#include "ConfigStore.h"
+#include "StateStore.h"
+#include "SysMsg.h"
 
 #include <Logging.h>
 #include <Util.h>
@@ -72,6 +78,8 @@ void RestartState::entry(StateMachine& sm)
 {
     UTIL_NOT_USED(sm);
 
+    CrashTrace::getInstance().add(CrashTrace::TYPE_STATE, CrashTrace::SYS_STATE_RESTART);
+
     LOG_INFO("Going in restart state.");
 
     m_timer.start(WAIT_TILL_STOP_SVC);
@@ -85,15 +93,25 @@ void RestartState::process(StateMachine& sm)
 
     UpdateMgr::getInstance().process();
 
+    /* Pending system messages, e.g. the reason of the restart, are shown before. */
     if ((true == m_timer.isTimerRunning()) &&
-        (true == m_timer.isTimeout()))
+        (true == m_timer.isTimeout()) &&
+        (true == SysMsg::getInstance().isReady()))
     {
         /* Stop all servers */
         MyWebServer::end();
         UpdateMgr::getInstance().end();
         MDNS.end();
 
-        /* Unmount filesystem */
+        /* Write the changed settings, plugin configurations and plugin
+         * states, which are not written yet.
+         */
+        Settings::getInstance().flush();
+        ConfigStore::getInstance().flush();
+        StateStore::getInstance().flush();
+
+        /* Stop filesystem I/O service and unmount filesystem */
+        FileIo::getInstance().end();
         FILESYSTEM.end();
 
         /* Stop display manager */
@@ -95,6 +95,24 @@ public:
      */
     void exit(StateMachine& sm) final;
 
+    /**
+     * Get the max. time, the state may wait for an event, until it needs to
+     * be processed again.
+     *
+     * @return Wait time in ms
+     */
+    uint32_t getWaitTime() const final
+    {
+        uint32_t waitTime = WAIT_FOREVER;
+
+        if (true == m_timer.isTimerRunning())
+        {
+            waitTime = m_timer.getRemaining();
+        }
+
+        return waitTime;
+    }
+
 private:
 
     /** Wait timer in ms, after that all services will be stopped. */
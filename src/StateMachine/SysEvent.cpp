@@ -0,0 +1,144 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System event queue
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SysEvent.h"
+
+#include <StateMachine.hpp>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool SysEvent::begin()
+{
+    bool isSuccessful = true;
+
+    if (nullptr == m_xQueue)
+    {
+        m_xQueue = xQueueCreate(QUEUE_SIZE, sizeof(uint8_t));
+
+        if (nullptr == m_xQueue)
+        {
+            LOG_ERROR("Couldn't create system event queue.");
+            isSuccessful = false;
+        }
+    }
+
+    if (true == isSuccessful)
+    {
+        m_owner = xTaskGetCurrentTaskHandle();
+    }
+
+    return isSuccessful;
+}
+
+void SysEvent::post(Id id)
+{
+    if (nullptr != m_xQueue)
+    {
+        uint8_t item = static_cast<uint8_t>(id);
+
+        /* A full queue wakes up the owner anyway. */
+        (void)xQueueSendToBack(m_xQueue, &item, 0U);
+    }
+
+    return;
+}
+
+bool SysEvent::wait(Id& id, uint32_t timeout)
+{
+    bool        isAvailable = false;
+    TickType_t  ticks       = portMAX_DELAY;
+
+    if (AbstractState::WAIT_FOREVER != timeout)
+    {
+        ticks = pdMS_TO_TICKS(timeout);
+    }
+
+    if ((nullptr != m_xQueue) &&
+        (xTaskGetCurrentTaskHandle() == m_owner))
+    {
+        uint8_t item = 0U;
+
+        if (pdTRUE == xQueueReceive(m_xQueue, &item, ticks))
+        {
+            id          = static_cast<Id>(item);
+            isAvailable = true;
+        }
+    }
+    /* Without queue, the caller is at least delayed. */
+    else
+    {
+        vTaskDelay(ticks);
+    }
+
+    return isAvailable;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
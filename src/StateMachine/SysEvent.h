@@ -0,0 +1,158 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System event queue
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup sys_states
+ * 
+ * @{
+ */
+
+#ifndef __SYSEVENT_H__
+#define __SYSEVENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The system event queue wakes up the task, which owns the system state
+ * machine. Any task may post an event, but only the owner task waits for
+ * them. The owner is the task, which started the queue.
+ *
+ * An event only signals, that something happened. The details are still
+ * retrieved from the source, therefore a event, which is lost because of a
+ * full queue, doesn't harm, as long as the owner is woken up.
+ */
+class SysEvent
+{
+public:
+
+    /**
+     * Get the system event queue instance.
+     * 
+     * @return System event queue
+     */
+    static SysEvent& getInstance()
+    {
+        static SysEvent instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * System event ids.
+     */
+    enum Id
+    {
+        ID_WIFI = 0,    /**< Wifi status changed. */
+        ID_BUTTON,      /**< Button event available. */
+        ID_UPDATE,      /**< Update or restart requested. */
+        ID_LOG          /**< Deferred log messages available. */
+    };
+
+    /**
+     * Start the system event queue. The calling task becomes the owner.
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Post a event to the owner. It never blocks and may be called by any
+     * task, but not from interrupt context.
+     * 
+     * @param[in] id    Event id
+     */
+    void post(Id id);
+
+    /**
+     * Wait for the next event. Only the owner task may wait, any other task
+     * is just delayed.
+     * 
+     * @param[out] id       Event id
+     * @param[in]  timeout  Max. wait time in ms or AbstractState::WAIT_FOREVER
+     * 
+     * @return If a event is available, it will return true otherwise false.
+     */
+    bool wait(Id& id, uint32_t timeout);
+
+    /** Max. number of events in the queue. */
+    static const uint32_t   QUEUE_SIZE  = 16U;
+
+private:
+
+    QueueHandle_t   m_xQueue;   /**< Event queue */
+    TaskHandle_t    m_owner;    /**< Task, which owns the queue and waits for the events. */
+
+    /**
+     * Constructs the system event queue.
+     */
+    SysEvent() :
+        m_xQueue(nullptr),
+        m_owner(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the system event queue.
+     */
+    ~SysEvent()
+    {
+        if (nullptr != m_xQueue)
+        {
+            vQueueDelete(m_xQueue);
+            m_xQueue = nullptr;
+        }
+    }
+
+    SysEvent(const SysEvent& sysEvent);
+    SysEvent& operator=(const SysEvent& sysEvent);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SYSEVENT_H__ */
+
+/** @} */
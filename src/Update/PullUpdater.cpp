@@ -0,0 +1,654 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pull based software update
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PullUpdater.h"
+#include "UpdateWriter.h"
+#include "UpdateMgr.h"
+#include "Settings.h"
+#include "Version.h"
+#include "FileSystem.h"
+#include "HttpClientPool.h"
+#include "HttpStatus.h"
+
+#include <Logging.h>
+#include <Update.h>
+#include <DeltaPatch.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Manifest JSON document size in byte. */
+static const size_t     JSON_DOC_SIZE       = 3072U;
+
+/** Period in ms, in which a exit request is checked during waiting. */
+static const uint32_t   WAIT_STEP           = 1000U;
+
+/** Protocol of the manifest URL, which is required. */
+static const char       MANIFEST_PROTOCOL[] = "https://";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void PullUpdater::begin()
+{
+    String url;
+
+    if (false == Settings::getInstance().open(true))
+    {
+        url = Settings::getInstance().getUpdateUrl().getDefault();
+    }
+    else
+    {
+        url = Settings::getInstance().getUpdateUrl().getValue();
+        Settings::getInstance().close();
+    }
+
+    m_url = url;
+
+    if (true == m_url.isEmpty())
+    {
+        LOG_INFO("Pull update disabled.");
+        m_checkTimer.stop();
+    }
+    /* The manifest provides the SHA-256 of the images, therefore only a
+     * authenticated manifest source is accepted.
+     */
+    else if (false == m_url.startsWith(MANIFEST_PROTOCOL))
+    {
+        LOG_WARNING("Pull update disabled, manifest URL must use HTTPS.");
+        m_url.clear();
+        m_checkTimer.stop();
+    }
+    else
+    {
+        /* The device specific delay avoids that all devices check at once,
+         * e.g. after a power outage.
+         */
+        m_checkTimer.start(CHECK_DELAY + (getDeviceHash() % CHECK_JITTER));
+    }
+
+    return;
+}
+
+void PullUpdater::end()
+{
+    m_checkTimer.stop();
+
+    if (nullptr != m_taskHandle)
+    {
+        m_isExitReq = true;
+
+        /* Wake up the task, if it waits for a response. */
+        HttpClientPool::getInstance().abort(this);
+        (void)xSemaphoreGive(m_xRspSemaphore);
+
+        /* Join */
+        (void)xSemaphoreTake(m_xExitSemaphore, portMAX_DELAY);
+        m_taskHandle = nullptr;
+    }
+
+    return;
+}
+
+void PullUpdater::process()
+{
+    /* Task finished? */
+    if ((nullptr != m_taskHandle) &&
+        (pdTRUE == xSemaphoreTake(m_xExitSemaphore, 0U)))
+    {
+        m_taskHandle = nullptr;
+    }
+
+    if ((true == m_checkTimer.isTimerRunning()) &&
+        (true == m_checkTimer.isTimeout()))
+    {
+        /* A upload via the webserver has priority, therefore check later again. */
+        if ((nullptr != m_taskHandle) ||
+            (true == UpdateWriter::getInstance().isRunning()))
+        {
+            m_checkTimer.start(CHECK_DELAY);
+        }
+        else
+        {
+            BaseType_t osRet = pdFAIL;
+
+            m_isExitReq = false;
+
+            osRet = xTaskCreateUniversal(   updateTask,
+                                            "pullUpdateTask",
+                                            TASK_STACK_SIZE,
+                                            this,
+                                            TASK_PRIORITY,
+                                            &m_taskHandle,
+                                            TASK_RUN_CORE);
+
+            if (pdPASS != osRet)
+            {
+                LOG_ERROR("Couldn't create pull update task.");
+                m_taskHandle = nullptr;
+            }
+
+            m_checkTimer.start(CHECK_PERIOD);
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+PullUpdater::PullUpdater() :
+    m_url(),
+    m_checkTimer(),
+    m_taskHandle(nullptr),
+    m_xRspSemaphore(xSemaphoreCreateBinary()),
+    m_xExitSemaphore(xSemaphoreCreateBinary()),
+    m_isExitReq(false),
+    m_segment(nullptr),
+    m_segmentLen(0U),
+    m_segmentCapacity(0U),
+    m_isRspValid(false)
+{
+}
+
+PullUpdater::~PullUpdater()
+{
+    end();
+
+    if (nullptr != m_xRspSemaphore)
+    {
+        vSemaphoreDelete(m_xRspSemaphore);
+        m_xRspSemaphore = nullptr;
+    }
+
+    if (nullptr != m_xExitSemaphore)
+    {
+        vSemaphoreDelete(m_xExitSemaphore);
+        m_xExitSemaphore = nullptr;
+    }
+}
+
+uint32_t PullUpdater::getDeviceHash()
+{
+    uint64_t    chipId  = ESP.getEfuseMac();
+    uint32_t    hash    = 2166136261U; /* FNV-1a offset basis */
+    uint8_t     idx     = 0U;
+
+    /* The MAC address is unique, but the devices of a series differ only in
+     * the lower bytes. The hash spreads them over the whole value range.
+     */
+    for(idx = 0U; idx < sizeof(chipId); ++idx)
+    {
+        hash ^= static_cast<uint8_t>(chipId >> (8U * idx));
+        hash *= 16777619U; /* FNV-1a prime */
+    }
+
+    return hash;
+}
+
+String PullUpdater::getRunningSha256()
+{
+    String                  sha256;
+    const esp_partition_t*  partition   = esp_ota_get_running_partition();
+    uint8_t                 digest[UpdateWriter::SHA256_SIZE];
+
+    if ((nullptr != partition) &&
+        (ESP_OK == esp_partition_get_sha256(partition, digest)))
+    {
+        char    digestStr[2U * UpdateWriter::SHA256_SIZE + 1U];
+        uint8_t idx = 0U;
+
+        for(idx = 0U; idx < UpdateWriter::SHA256_SIZE; ++idx)
+        {
+            (void)snprintf(&digestStr[2U * idx], 3U, "%02x", digest[idx]);
+        }
+
+        sha256 = digestStr;
+    }
+
+    return sha256;
+}
+
+bool PullUpdater::wait(uint32_t duration)
+{
+    uint32_t remaining = duration;
+
+    while((false == m_isExitReq) && (0U < remaining))
+    {
+        uint32_t step = (WAIT_STEP < remaining) ? WAIT_STEP : remaining;
+
+        vTaskDelay(pdMS_TO_TICKS(step));
+        remaining -= step;
+    }
+
+    return (false == m_isExitReq);
+}
+
+bool PullUpdater::request(const String& url, size_t offset, size_t size)
+{
+    bool                        status  = false;
+    HttpClientPool::Request     req;
+
+    m_segmentLen        = 0U;
+    m_segmentCapacity   = (0U == size) ? MAX_MANIFEST_SIZE : size;
+    m_isRspValid        = false;
+
+    /* Discard a outdated signal, e.g. of a timed out request. */
+    (void)xSemaphoreTake(m_xRspSemaphore, 0U);
+
+    req.owner       = this;
+    req.priority    = HttpClientPool::PRIORITY_LOW;
+    req.url         = url;
+
+    if (0U < size)
+    {
+        req.range = String("bytes=") + offset + "-" + (offset + size - 1U);
+    }
+
+    /* The callbacks are called in the async TCP task, therefore only copy
+     * the data there. It is processed in the update task.
+     */
+    req.onBody = [this](const uint8_t* data, size_t len)
+    {
+        if ((m_segmentCapacity >= m_segmentLen) &&
+            ((m_segmentCapacity - m_segmentLen) >= len))
+        {
+            memcpy(&m_segment[m_segmentLen], data, len);
+            m_segmentLen += len;
+        }
+        else
+        {
+            /* Mark the segment as overflowed. */
+            m_segmentLen = m_segmentCapacity + 1U;
+        }
+    };
+
+    req.onResponse = [this](const HttpResponse& rsp)
+    {
+        uint16_t statusCode = rsp.getStatusCode();
+
+        /* A host, which doesn't support range requests, responds with the
+         * whole resource. This is only a problem, if it doesn't fit into
+         * the segment, which is detected by the length check.
+         */
+        if (((HttpStatus::STATUS_CODE_OK == statusCode) ||
+             (HttpStatus::STATUS_CODE_PARTIAL_CONTENT == statusCode)) &&
+            (m_segmentCapacity >= m_segmentLen))
+        {
+            m_isRspValid = true;
+        }
+        else
+        {
+            LOG_WARNING("Pull update: Status code %u.", statusCode);
+        }
+
+        (void)xSemaphoreGive(m_xRspSemaphore);
+    };
+
+    req.onError = [this]()
+    {
+        (void)xSemaphoreGive(m_xRspSemaphore);
+    };
+
+    if ((false == m_isExitReq) &&
+        (true == HttpClientPool::getInstance().request(req)))
+    {
+        if (pdTRUE != xSemaphoreTake(m_xRspSemaphore, pdMS_TO_TICKS(SEGMENT_TIMEOUT)))
+        {
+            LOG_WARNING("Pull update: Request timeout.");
+            HttpClientPool::getInstance().abort(this);
+        }
+        else
+        {
+            status = m_isRspValid;
+        }
+    }
+
+    return status;
+}
+
+bool PullUpdater::download(const String& url, size_t size, const Sink& sink)
+{
+    bool    isError = false;
+    size_t  offset  = 0U;
+
+    while((false == isError) && (size > offset))
+    {
+        size_t  segmentSize = ((size - offset) < SEGMENT_SIZE) ? (size - offset) : SEGMENT_SIZE;
+        uint8_t retries     = 0U;
+        bool    isReceived  = request(url, offset, segmentSize);
+
+        while((false == isReceived) && (SEGMENT_RETRIES > retries) && (false == m_isExitReq))
+        {
+            ++retries;
+            isReceived = request(url, offset, segmentSize);
+        }
+
+        if ((false == isReceived) ||
+            (segmentSize != m_segmentLen))
+        {
+            LOG_ERROR("Pull update: Download failed at %u.", offset);
+            isError = true;
+        }
+        else if (false == sink(m_segment, m_segmentLen))
+        {
+            isError = true;
+        }
+        else
+        {
+            offset += segmentSize;
+        }
+    }
+
+    return (false == isError);
+}
+
+void PullUpdater::checkForUpdate()
+{
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+    if (false == request(m_url, 0U, 0U))
+    {
+        LOG_WARNING("Pull update: Couldn't get manifest.");
+    }
+    else if (DeserializationError::Ok != deserializeJson(jsonDoc, m_segment, m_segmentLen))
+    {
+        LOG_WARNING("Pull update: Invalid manifest.");
+    }
+    else
+    {
+        JsonVariantConst    jsonVersion     = jsonDoc["version"];
+        JsonObjectConst     jsonFirmware    = jsonDoc["firmware"];
+        JsonObjectConst     jsonFilesystem  = jsonDoc["filesystem"];
+        JsonArrayConst      jsonDelta       = jsonDoc["delta"];
+        uint32_t            rolloutWindow   = jsonDoc["rolloutWindow"] | 0U;
+        String              version         = jsonVersion.as<String>();
+
+        if ((false == jsonVersion.is<const char*>()) ||
+            (version == Version::SOFTWARE_VER))
+        {
+            LOG_INFO("Pull update: No update available.");
+        }
+        else
+        {
+            String  deltaUrl;
+            size_t  deltaSize   = 0U;
+            bool    isSuccess   = true;
+
+            if (MAX_ROLLOUT_WINDOW < rolloutWindow)
+            {
+                rolloutWindow = MAX_ROLLOUT_WINDOW;
+            }
+
+            LOG_INFO("Pull update: Version %s available.", version.c_str());
+
+            /* Every device has its own time slot in the rollout window. */
+            if (0U < rolloutWindow)
+            {
+                uint32_t delay = getDeviceHash() % rolloutWindow;
+
+                LOG_INFO("Pull update: Starts in %u s.", delay);
+
+                isSuccess = wait(delay * 1000U);
+            }
+
+            /* A delta patch against the running firmware is preferred. */
+            if ((true == isSuccess) &&
+                (false == jsonDelta.isNull()))
+            {
+                String runningSha256 = getRunningSha256();
+
+                for(JsonObjectConst jsonPatch: jsonDelta)
+                {
+                    if ((true == deltaUrl.isEmpty()) &&
+                        (false == runningSha256.isEmpty()) &&
+                        (true == runningSha256.equalsIgnoreCase(jsonPatch["from"].as<String>())))
+                    {
+                        deltaUrl    = jsonPatch["url"].as<String>();
+                        deltaSize   = jsonPatch["size"] | 0U;
+                    }
+                }
+            }
+
+            if ((true == isSuccess) &&
+                (false == jsonFirmware.isNull()))
+            {
+                isSuccess = update(jsonFirmware, U_FLASH, deltaUrl, deltaSize);
+
+                /* If the patch fails, the full image may succeed. */
+                if ((false == isSuccess) &&
+                    (false == deltaUrl.isEmpty()) &&
+                    (false == m_isExitReq))
+                {
+                    LOG_WARNING("Pull update: Delta patch failed, download full image.");
+                    isSuccess = update(jsonFirmware, U_FLASH, "", 0U);
+                }
+            }
+
+            if ((true == isSuccess) &&
+                (false == jsonFilesystem.isNull()))
+            {
+                isSuccess = update(jsonFilesystem, U_SPIFFS, "", 0U);
+            }
+
+            if (true == isSuccess)
+            {
+                LOG_INFO("Pull update: Version %s installed.", version.c_str());
+                UpdateMgr::getInstance().reqRestart();
+            }
+        }
+    }
+
+    return;
+}
+
+bool PullUpdater::update(JsonObjectConst image, int cmd, const String& deltaUrl, size_t deltaSize)
+{
+    bool            isSuccess   = false;
+    String          url         = image["url"].as<String>();
+    size_t          size        = image["size"] | 0U;
+    String          sha256      = image["sha256"] | "";
+    UpdateWriter&   writer      = UpdateWriter::getInstance();
+
+    /* The size is necessary for the range requests. The SHA-256 is taken
+     * from the manifest, which is received via HTTPS. It ensures that only the
+     * announced image is activated, independent of how the image is downloaded.
+     */
+    if ((true == url.isEmpty()) ||
+        (0U == size) ||
+        (true == sha256.isEmpty()))
+    {
+        LOG_WARNING("Pull update: Incomplete image description.");
+    }
+    else
+    {
+        if (U_SPIFFS == cmd)
+        {
+            /* Close filesystem before continue. */
+            FILESYSTEM.end();
+        }
+
+        if (false == writer.begin(size, cmd, sha256))
+        {
+            LOG_ERROR("Pull update failed: %s", writer.getErrorStr());
+        }
+        else
+        {
+            bool isDownloaded = false;
+
+            UpdateMgr::getInstance().beginProgress();
+
+            if (true == deltaUrl.isEmpty())
+            {
+                LOG_INFO("Pull update: Download %s (%u byte).", url.c_str(), size);
+
+                isDownloaded = download(url, size,
+                    [&writer](const uint8_t* data, size_t len) -> bool
+                    {
+                        bool status = writer.write(data, len);
+
+                        UpdateMgr::getInstance().updateProgress(writer.getProgress());
+
+                        return status;
+                    });
+            }
+            else
+            {
+                const esp_partition_t*  running     = esp_ota_get_running_partition();
+                DeltaPatch              deltaPatch(
+                    [running](uint32_t offset, uint8_t* buffer, size_t len) -> bool
+                    {
+                        return ((nullptr != running) &&
+                                (ESP_OK == esp_partition_read(running, offset, buffer, len)));
+                    },
+                    [&writer](const uint8_t* data, size_t len) -> bool
+                    {
+                        bool status = writer.write(data, len);
+
+                        UpdateMgr::getInstance().updateProgress(writer.getProgress());
+
+                        return status;
+                    });
+
+                LOG_INFO("Pull update: Download delta patch %s (%u byte).", deltaUrl.c_str(), deltaSize);
+
+                isDownloaded = download(deltaUrl, deltaSize,
+                    [&deltaPatch](const uint8_t* data, size_t len) -> bool
+                    {
+                        return deltaPatch.process(data, len);
+                    });
+
+                if ((true == isDownloaded) &&
+                    ((false == deltaPatch.isFinished()) || (size != deltaPatch.getTargetSize())))
+                {
+                    LOG_ERROR("Pull update: Invalid delta patch.");
+                    isDownloaded = false;
+                }
+            }
+
+            if (false == isDownloaded)
+            {
+                if (true == writer.isRunning())
+                {
+                    writer.abort();
+                }
+            }
+            else if (false == writer.end())
+            {
+                LOG_ERROR("Pull update failed: %s", writer.getErrorStr());
+            }
+            else
+            {
+                isSuccess = true;
+            }
+
+            UpdateMgr::getInstance().endProgress();
+        }
+
+        /* Mount filesystem again, if the update failed. Otherwise it is
+         * restarted in the next seconds.
+         */
+        if ((U_SPIFFS == cmd) &&
+            (false == isSuccess) &&
+            (false == FILESYSTEM.begin()))
+        {
+            LOG_FATAL("Couldn't mount filesystem.");
+        }
+    }
+
+    return isSuccess;
+}
+
+void PullUpdater::updateTask(void* parameters)
+{
+    PullUpdater* updater = reinterpret_cast<PullUpdater*>(parameters);
+
+    if (nullptr != updater)
+    {
+        updater->m_segment = new uint8_t[SEGMENT_SIZE];
+
+        if (nullptr == updater->m_segment)
+        {
+            LOG_ERROR("Pull update: Out of memory.");
+        }
+        else
+        {
+            updater->checkForUpdate();
+
+            delete[] updater->m_segment;
+            updater->m_segment = nullptr;
+        }
+
+        (void)xSemaphoreGive(updater->m_xExitSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
\ No newline at end of file
@@ -0,0 +1,297 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pull based software update
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup update
+ *
+ * @{
+ */
+
+#ifndef __PULL_UPDATER_H__
+#define __PULL_UPDATER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <WString.h>
+#include <ArduinoJson.h>
+#include <SimpleTimer.hpp>
+#include <functional>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The pull updater periodically downloads the update manifest from the
+ * configured URL. If it announces a different software version, the
+ * firmware and filesystem images are downloaded and written to flash.
+ *
+ * The images are downloaded in segments with HTTP range requests, which are
+ * processed in a dedicated task. This keeps the async TCP task free from
+ * flash writes and the patch processing. A firmware image may be provided as
+ * delta patch against the running firmware, see DeltaPatch.
+ *
+ * To avoid that all devices hit the server at once, every device waits a
+ * device specific time within the rollout window of the manifest.
+ *
+ * The manifest is only downloaded via HTTPS with a verified server
+ * certificate. Every image is verified with the SHA-256 of the manifest,
+ * before it is activated.
+ *
+ * Manifest example:
+ * {
+ *     "version": "v4.1.0",
+ *     "rolloutWindow": 3600,
+ *     "firmware": { "url": "https://...", "size": 1234567, "sha256": "..." },
+ *     "filesystem": { "url": "https://...", "size": 1507328, "sha256": "..." },
+ *     "delta": [{ "from": "...", "url": "https://...", "size": 43210 }]
+ * }
+ */
+class PullUpdater
+{
+public:
+
+    /** Period in ms, in which the manifest is checked. */
+    static const uint32_t       CHECK_PERIOD        = (6U * 60U * 60U * 1000U);
+
+    /** Delay in ms after the connection is established, until the manifest is checked the first time. */
+    static const uint32_t       CHECK_DELAY         = (60U * 1000U);
+
+    /**
+     * Max. additional device specific delay in ms for the first check, so
+     * the devices don't check at once after a power outage.
+     */
+    static const uint32_t       CHECK_JITTER        = (10U * 60U * 1000U);
+
+    /** Segment size in byte, which is requested at once. */
+    static const size_t         SEGMENT_SIZE        = 8192U;
+
+    /** Max. time in ms to wait for a segment. */
+    static const uint32_t       SEGMENT_TIMEOUT     = 30000U;
+
+    /** Max. number of retries per segment. */
+    static const uint8_t        SEGMENT_RETRIES     = 3U;
+
+    /** Max. manifest size in byte. */
+    static const size_t         MAX_MANIFEST_SIZE   = 2048U;
+
+    /** Max. rollout window in s, which is respected. */
+    static const uint32_t       MAX_ROLLOUT_WINDOW  = (24U * 60U * 60U);
+
+    /** Task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 8192U;
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Task priority, which is lower than the writer task priority. */
+    static const UBaseType_t    TASK_PRIORITY       = 2U;
+
+    /**
+     * Get the pull updater instance.
+     *
+     * @return Pull updater
+     */
+    static PullUpdater& getInstance()
+    {
+        static PullUpdater instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start checking the manifest, if a URL is configured.
+     */
+    void begin();
+
+    /**
+     * Stop checking the manifest and abort a running update.
+     */
+    void end();
+
+    /**
+     * Process the pull updater. Call it periodically.
+     */
+    void process();
+
+    /**
+     * Is an update check or update running?
+     *
+     * @return If running, it will return true otherwise false.
+     */
+    bool isRunning() const
+    {
+        return (nullptr != m_taskHandle);
+    }
+
+private:
+
+    /**
+     * Sink, which processes the downloaded image data.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    typedef std::function<bool(const uint8_t* data, size_t size)> Sink;
+
+    /** Manifest URL, empty if disabled. */
+    String                  m_url;
+
+    /** Timer, which triggers the manifest check. */
+    SimpleTimer             m_checkTimer;
+
+    /** Update task handle */
+    TaskHandle_t            m_taskHandle;
+
+    /** Binary semaphore, which signals the end of a request. */
+    SemaphoreHandle_t       m_xRspSemaphore;
+
+    /** Binary semaphore used to signal the task exit. */
+    SemaphoreHandle_t       m_xExitSemaphore;
+
+    /** Is the task requested to exit? */
+    volatile bool           m_isExitReq;
+
+    /** Buffer for the received segment. */
+    uint8_t*                m_segment;
+
+    /** Number of bytes in the segment buffer. */
+    volatile size_t         m_segmentLen;
+
+    /** Capacity of the segment buffer for the current request. */
+    size_t                  m_segmentCapacity;
+
+    /** Was the latest request successful? */
+    volatile bool           m_isRspValid;
+
+    /**
+     * Constructs the pull updater.
+     */
+    PullUpdater();
+
+    /**
+     * Destroys the pull updater.
+     */
+    ~PullUpdater();
+
+    PullUpdater(const PullUpdater& updater);
+    PullUpdater& operator=(const PullUpdater& updater);
+
+    /**
+     * Get a device specific value, which is used to stagger the requests.
+     *
+     * @return Device specific value
+     */
+    static uint32_t getDeviceHash();
+
+    /**
+     * Get the SHA-256 of the running firmware.
+     *
+     * @return SHA-256 as hex string, empty on error.
+     */
+    static String getRunningSha256();
+
+    /**
+     * Wait the given time, but return earlier on a exit request.
+     *
+     * @param[in] duration  Duration in ms
+     *
+     * @return If the whole time elapsed, it will return true otherwise false.
+     */
+    bool wait(uint32_t duration);
+
+    /**
+     * Send a request and wait for the response.
+     *
+     * @param[in] url       URL
+     * @param[in] offset    Offset of the requested segment
+     * @param[in] size      Size of the requested segment. If 0, the whole resource
+     *                      is requested, which must fit into MAX_MANIFEST_SIZE.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool request(const String& url, size_t offset, size_t size);
+
+    /**
+     * Download a resource segment by segment and provide the data to the sink.
+     *
+     * @param[in] url   URL
+     * @param[in] size  Resource size in byte
+     * @param[in] sink  Sink, which processes the data
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool download(const String& url, size_t size, const Sink& sink);
+
+    /**
+     * Check the manifest and update, if a different version is announced.
+     */
+    void checkForUpdate();
+
+    /**
+     * Update the firmware or the filesystem.
+     *
+     * @param[in] image     Image description from the manifest
+     * @param[in] cmd       U_FLASH for the firmware or U_SPIFFS for the filesystem
+     * @param[in] deltaUrl  URL of the delta patch against the running firmware, empty for the full image
+     * @param[in] deltaSize Delta patch size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool update(JsonObjectConst image, int cmd, const String& deltaUrl, size_t deltaSize);
+
+    /**
+     * Update task, which checks the manifest and downloads the images.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void updateTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PULL_UPDATER_H__ */
+
+/** @} */
\ No newline at end of file
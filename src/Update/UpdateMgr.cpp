@@ -38,15 +38,14 @@
 #include <Esp.h>
 
 #include "FileSystem.h"
-#include "LedMatrix.h"
 #include "MyWebServer.h"
 #include "Settings.h"
 #include "DisplayMgr.h"
 #include "SysMsg.h"
 #include "PluginMgr.h"
+#include "SysEvent.h"
+#include "EventStream.h"
 
-#include "TextWidget.h"
-#include "ProgressBar.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -71,6 +70,9 @@
 /* Set over-the-air update password */
 const char* UpdateMgr::OTA_PASSWORD = "maytheforcebewithyou";
 
+/* Set widget type */
+const char* UpdateMgr::ProgressOverlay::WIDGET_TYPE = "updateProgress";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -153,19 +155,32 @@ void UpdateMgr::process()
     return;
 }
 
+void UpdateMgr::reqRestart()
+{
+    m_isRestartReq = true;
+    SysEvent::getInstance().post(SysEvent::ID_UPDATE);
+
+    return;
+}
+
 void UpdateMgr::beginProgress()
 {
     if (true == m_isInitialized)
     {
-        /* Stop display manager */
-        DisplayMgr::getInstance().end();
-
         m_updateIsRunning   = true;
         m_progress          = UINT8_MAX; // Force update
-        m_textWidget.setFormatStr("Update");
 
         /* Show user update status */
         updateProgress(0U);
+
+        /* The display keeps running, but yields to the data transfer.
+         * The flash writes are coordinated with the LED matrix output,
+         * which avoids artifacts on the display.
+         */
+        DisplayMgr::getInstance().setReducedPriority(true);
+        (void)DisplayMgr::getInstance().addOverlay(m_progressOverlay, DisplayMgr::OVERLAY_LAYER_UPDATE);
+
+        EventStream::getInstance().notify(EventStream::EVENT_UPDATE);
     }
 
     return;
@@ -178,27 +193,13 @@ void UpdateMgr::updateProgress(uint8_t progress)
     {
         m_progress = progress;
 
-        m_progressBar.setProgress(m_progress);
-
-        /* Update display manually. Note, that this must be done to avoid
-         * artifacts on the display, caused by long flash write cycles.
-         */
-        LedMatrix::getInstance().clear();
-        m_progressBar.update(LedMatrix::getInstance()); // Draw the progress bar in the background
-        m_textWidget.update(LedMatrix::getInstance());  // Overlay with the text
-        LedMatrix::getInstance().show();
-
-        /* Wait until the LED matrix is updated to avoid artifacts on the
-         * display.
-         */
-        while(false == LedMatrix::getInstance().isReady())
-        {
-            /* Just wait and give other tasks a chance. */
-            delay(1U);
-        }
+        /* The display task shows it with the next frame. */
+        m_progressOverlay.setProgress(m_progress);
 
         /* Show update status on console. */
         LOG_INFO(String("[") + m_progress + "%]");
+
+        EventStream::getInstance().notify(EventStream::EVENT_UPDATE);
     }
 
     return;
@@ -208,11 +209,10 @@ void UpdateMgr::endProgress()
 {
     if (true == m_isInitialized)
     {
-        /* Start display manager */
-        if (false == DisplayMgr::getInstance().begin())
-        {
-            LOG_WARNING("Couldn't initialize display manager again.");
-        }
+        DisplayMgr::getInstance().removeOverlay(m_progressOverlay);
+        DisplayMgr::getInstance().setReducedPriority(false);
+
+        EventStream::getInstance().notify(EventStream::EVENT_UPDATE);
     }
 
     return;
@@ -231,11 +231,8 @@ UpdateMgr::UpdateMgr() :
     m_updateIsRunning(false),
     m_progress(0U),
     m_isRestartReq(false),
-    m_textWidget(),
-    m_progressBar()
+    m_progressOverlay()
 {
-    /* Move text for a better look. */
-    m_textWidget.move(1, 1);
 }
 
 UpdateMgr::~UpdateMgr()
@@ -301,32 +298,39 @@ void UpdateMgr::onProgress(unsigned int progress, unsigned int total)
 
 void UpdateMgr::onError(ota_error_t error)
 {
-    String infoStr;
+    String              infoStr;
+    const RleBitmap*    infoBitmap  = nullptr;
 
     switch(error)
     {
     case OTA_AUTH_ERROR:
-        infoStr = "OTA - Authentication error.";
+        infoStr     = "OTA - Authentication error.";
+        infoBitmap  = &SYS_MSG_OTA_AUTH_ERROR;
         break;
 
     case OTA_BEGIN_ERROR:
-        infoStr = "OTA - Begin error.";
+        infoStr     = "OTA - Begin error.";
+        infoBitmap  = &SYS_MSG_OTA_BEGIN_ERROR;
         break;
 
     case OTA_CONNECT_ERROR:
-        infoStr = "OTA - Connect error.";
+        infoStr     = "OTA - Connect error.";
+        infoBitmap  = &SYS_MSG_OTA_CONNECT_ERROR;
         break;
 
     case OTA_RECEIVE_ERROR:
-        infoStr = "OTA - Receive error.";
+        infoStr     = "OTA - Receive error.";
+        infoBitmap  = &SYS_MSG_OTA_RECEIVE_ERROR;
         break;
 
     case OTA_END_ERROR:
-        infoStr = "OTA - End error.";
+        infoStr     = "OTA - End error.";
+        infoBitmap  = &SYS_MSG_OTA_END_ERROR;
         break;
 
     default:
-        infoStr = "OTA - Unknown error.";
+        infoStr     = "OTA - Unknown error.";
+        infoBitmap  = &SYS_MSG_OTA_UNKNOWN_ERROR;
         break;
     }
 
@@ -347,7 +351,8 @@ void UpdateMgr::onError(ota_error_t error)
          */
         if (true == getInstance().m_updateIsRunning)
         {
-            SysMsg::getInstance().show(infoStr, 4000U, 2U, true);
+            /* The restart waits until the message was shown. */
+            SysMsg::getInstance().show(*infoBitmap, 4000U, 2U, SysMsg::PRIORITY_HIGH);
 
             /* Request a restart */
             getInstance().reqRestart();
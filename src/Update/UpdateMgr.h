@@ -45,8 +45,9 @@
  *****************************************************************************/
 #include <stdint.h>
 #include <ArduinoOTA.h>
-#include <TextWidget.h>
 #include <ProgressBar.h>
+#include <ColorDef.hpp>
+#include "SysMsgBitmaps.h"
 
 /******************************************************************************
  * Macros
@@ -102,6 +103,16 @@ public:
         return m_updateIsRunning;
     }
 
+    /**
+     * Get the progress of the running update.
+     *
+     * @return Progress in [0; 100] %
+     */
+    uint8_t getProgress() const
+    {
+        return (UINT8_MAX == m_progress) ? 0U : m_progress;
+    }
+
     /**
      * Is a restart requested?
      * This will be requested after a successful received new firmware
@@ -120,13 +131,9 @@ public:
     void process(void);
 
     /**
-     * Request a restart.
+     * Request a restart. It wakes up the system state machine.
      */
-    void reqRestart()
-    {
-        m_isRestartReq = true;
-        return;
-    }
+    void reqRestart();
 
     /**
      * Show the user that the update starts.
@@ -155,6 +162,72 @@ public:
 
 private:
 
+    /**
+     * The update progress overlay is drawn by the display task on top of
+     * the display content. The progress is only handed over and applied in
+     * the display task, therefore no lock is necessary.
+     */
+    class ProgressOverlay : public Widget
+    {
+    public:
+
+        /**
+         * Constructs the progress overlay.
+         */
+        ProgressOverlay() :
+            Widget(WIDGET_TYPE),
+            m_progress(0U),
+            m_progressBar()
+        {
+        }
+
+        /**
+         * Destroys the progress overlay.
+         */
+        ~ProgressOverlay()
+        {
+        }
+
+        /**
+         * Update/Draw the progress overlay.
+         *
+         * @param[in] gfx Graphics interface
+         */
+        void update(IGfx& gfx) final
+        {
+            m_progressBar.setProgress(m_progress);
+
+            gfx.fillScreen(ColorDef::BLACK);
+            m_progressBar.update(gfx);  // Draw the progress bar in the background
+            SYS_MSG_UPDATE.draw(gfx, 1, 1); // Overlay with the pre-rendered text, moved for a better look
+
+            return;
+        }
+
+        /**
+         * Set progress.
+         *
+         * @param[in] progress  Progress in [0; 100] %
+         */
+        void setProgress(uint8_t progress)
+        {
+            m_progress = progress;
+
+            return;
+        }
+
+        /** Widget type string */
+        static const char*  WIDGET_TYPE;
+
+    private:
+
+        volatile uint8_t    m_progress;     /**< Progress in [0; 100] %, which to show with the next frame. */
+        ProgressBar         m_progressBar;  /**< During the update the user shall be informed about the update progress. */
+
+        ProgressOverlay(const ProgressOverlay& overlay);
+        ProgressOverlay& operator=(const ProgressOverlay& overlay);
+    };
+
     /** Is the over-the-air update initialized? */
     bool                m_isInitialized;
 
@@ -170,11 +243,8 @@ private:
     /** Restart requested? */
     bool                m_isRestartReq;
 
-    /** During the update the user shall be informed about whats going on. */
-    TextWidget          m_textWidget;
-
-    /** During the update the user shall be informed about the update progress. */
-    ProgressBar         m_progressBar;
+    /** Shows the update progress on top of the display content. */
+    ProgressOverlay     m_progressOverlay;
 
     /**
      * Constructs the update manager.
@@ -0,0 +1,482 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Update writer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "UpdateWriter.h"
+#include "DisplayMgr.h"
+
+#include <Logging.h>
+#include <Update.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool UpdateWriter::begin(size_t size, int cmd, const String& sha256)
+{
+    bool status = false;
+
+    if (nullptr != m_taskHandle)
+    {
+        m_errorStr = "Update already running.";
+    }
+    else if (false == Update.begin(size, cmd))
+    {
+        m_errorStr = Update.errorString();
+    }
+    else
+    {
+        uint8_t idx     = 0U;
+        bool    isError = false;
+
+        /* Create binary semaphore to signal task exit. */
+        m_xSemaphore = xSemaphoreCreateBinary();
+
+        /* One more, because the exit request is queued too. */
+        m_xFullQueue = xQueueCreate(BUFFER_COUNT + 1U, sizeof(uint8_t));
+        m_xFreeQueue = xQueueCreate(BUFFER_COUNT, sizeof(uint8_t));
+
+        if ((nullptr == m_xSemaphore) ||
+            (nullptr == m_xFullQueue) ||
+            (nullptr == m_xFreeQueue))
+        {
+            isError = true;
+        }
+
+        for(idx = 0U; idx < BUFFER_COUNT; ++idx)
+        {
+            m_buffers[idx]      = new uint8_t[BUFFER_SIZE];
+            m_bufferLen[idx]    = 0U;
+
+            if (nullptr == m_buffers[idx])
+            {
+                isError = true;
+            }
+            else if (nullptr != m_xFreeQueue)
+            {
+                (void)xQueueSendToBack(m_xFreeQueue, &idx, 0U);
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        if (false == isError)
+        {
+            BaseType_t osRet = pdFAIL;
+
+            m_fillIndex         = BUFFER_INVALID;
+            m_size              = Update.size();
+            m_received          = 0U;
+            m_isError           = false;
+            m_errorStr          = "";
+            m_expectedSha256    = sha256;
+
+            mbedtls_sha256_init(&m_sha256Ctx);
+            (void)mbedtls_sha256_starts_ret(&m_sha256Ctx, 0);
+
+            osRet = xTaskCreateUniversal(   writerTask,
+                                            "updateWriterTask",
+                                            TASK_STACK_SIZE,
+                                            this,
+                                            TASK_PRIORITY,
+                                            &m_taskHandle,
+                                            TASK_RUN_CORE);
+
+            /* Task successful created? */
+            if (pdPASS == osRet)
+            {
+                (void)xSemaphoreGive(m_xSemaphore);
+                status = true;
+            }
+            else
+            {
+                mbedtls_sha256_free(&m_sha256Ctx);
+            }
+        }
+
+        if (false == status)
+        {
+            m_taskHandle    = nullptr;
+            m_errorStr      = "Out of resources.";
+
+            destroy();
+            Update.abort();
+        }
+    }
+
+    return status;
+}
+
+bool UpdateWriter::write(const uint8_t* data, size_t len)
+{
+    size_t offset = 0U;
+
+    while((nullptr != m_taskHandle) &&
+          (false == m_isError) &&
+          (nullptr != data) &&
+          (offset < len))
+    {
+        /* Wait for a free buffer, if necessary. */
+        if (BUFFER_INVALID == m_fillIndex)
+        {
+            if (pdTRUE != xQueueReceive(m_xFreeQueue, &m_fillIndex, pdMS_TO_TICKS(BUFFER_TIMEOUT)))
+            {
+                m_fillIndex = BUFFER_INVALID;
+                m_errorStr  = "Flash write timeout.";
+                m_isError   = true;
+            }
+            else
+            {
+                m_bufferLen[m_fillIndex] = 0U;
+            }
+        }
+        else
+        {
+            size_t  available   = BUFFER_SIZE - m_bufferLen[m_fillIndex];
+            size_t  copyLen     = len - offset;
+
+            if (available < copyLen)
+            {
+                copyLen = available;
+            }
+
+            memcpy(&m_buffers[m_fillIndex][m_bufferLen[m_fillIndex]], &data[offset], copyLen);
+
+            m_bufferLen[m_fillIndex]   += copyLen;
+            m_received                 += copyLen;
+            offset                     += copyLen;
+
+            /* A full sector is written behind, while the next one is received. */
+            if (BUFFER_SIZE == m_bufferLen[m_fillIndex])
+            {
+                flush();
+            }
+        }
+    }
+
+    return ((nullptr != m_taskHandle) && (false == m_isError));
+}
+
+bool UpdateWriter::end()
+{
+    bool status = false;
+
+    if (nullptr == m_taskHandle)
+    {
+        m_errorStr = "No update running.";
+    }
+    else
+    {
+        uint8_t digest[SHA256_SIZE];
+        char    digestStr[(2U * SHA256_SIZE) + 1U];
+        uint8_t idx     = 0U;
+
+        /* Write the remaining data. */
+        if ((false == m_isError) &&
+            (BUFFER_INVALID != m_fillIndex) &&
+            (0U < m_bufferLen[m_fillIndex]))
+        {
+            flush();
+        }
+
+        stop();
+
+        (void)mbedtls_sha256_finish_ret(&m_sha256Ctx, digest);
+        mbedtls_sha256_free(&m_sha256Ctx);
+
+        for(idx = 0U; idx < SHA256_SIZE; ++idx)
+        {
+            (void)snprintf(&digestStr[2U * idx], 3U, "%02x", digest[idx]);
+        }
+
+        LOG_INFO("Image SHA-256: %s", digestStr);
+
+        if (true == m_isError)
+        {
+            Update.abort();
+        }
+        else if ((false == m_expectedSha256.isEmpty()) &&
+                 (false == m_expectedSha256.equalsIgnoreCase(digestStr)))
+        {
+            m_errorStr = "SHA-256 mismatch.";
+            Update.abort();
+        }
+        else
+        {
+            /* The remaining data in the update buffer is written now. */
+            bool isGranted = DisplayMgr::getInstance().beginFlashAccess(FLASH_ACCESS_TIMEOUT);
+
+            status = Update.end(true);
+
+            if (true == isGranted)
+            {
+                DisplayMgr::getInstance().endFlashAccess();
+            }
+
+            if (false == status)
+            {
+                m_errorStr = Update.errorString();
+            }
+        }
+
+        destroy();
+    }
+
+    return status;
+}
+
+void UpdateWriter::abort()
+{
+    if (nullptr != m_taskHandle)
+    {
+        /* Skip all pending buffers. */
+        m_isError = true;
+
+        stop();
+        mbedtls_sha256_free(&m_sha256Ctx);
+
+        Update.abort();
+        destroy();
+    }
+
+    return;
+}
+
+uint8_t UpdateWriter::getProgress() const
+{
+    uint8_t progress = 0U;
+
+    if (0U < m_size)
+    {
+        progress = static_cast<uint8_t>((static_cast<uint64_t>(m_received) * 100U) / m_size);
+    }
+
+    return progress;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+UpdateWriter::UpdateWriter() :
+    m_taskHandle(nullptr),
+    m_xSemaphore(nullptr),
+    m_xFullQueue(nullptr),
+    m_xFreeQueue(nullptr),
+    m_buffers(),
+    m_bufferLen(),
+    m_fillIndex(BUFFER_INVALID),
+    m_size(0U),
+    m_received(0U),
+    m_isError(false),
+    m_errorStr(""),
+    m_sha256Ctx(),
+    m_expectedSha256()
+{
+}
+
+UpdateWriter::~UpdateWriter()
+{
+    abort();
+}
+
+void UpdateWriter::flush()
+{
+    /* The queue is large enough for all buffers, so it never blocks. */
+    (void)xQueueSendToBack(m_xFullQueue, &m_fillIndex, portMAX_DELAY);
+    m_fillIndex = BUFFER_INVALID;
+
+    return;
+}
+
+void UpdateWriter::stop()
+{
+    uint8_t exitIndex   = BUFFER_INVALID;
+    uint8_t idx         = 0U;
+
+    /* The exit request is queued behind the pending buffers, which are
+     * written or skipped before the task exits.
+     */
+    (void)xQueueSendToBack(m_xFullQueue, &exitIndex, portMAX_DELAY);
+
+    /* Join */
+    (void)xSemaphoreTake(m_xSemaphore, portMAX_DELAY);
+
+    m_taskHandle    = nullptr;
+    m_fillIndex     = BUFFER_INVALID;
+
+    for(idx = 0U; idx < BUFFER_COUNT; ++idx)
+    {
+        m_bufferLen[idx] = 0U;
+    }
+
+    return;
+}
+
+void UpdateWriter::destroy()
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < BUFFER_COUNT; ++idx)
+    {
+        if (nullptr != m_buffers[idx])
+        {
+            delete[] m_buffers[idx];
+            m_buffers[idx] = nullptr;
+        }
+    }
+
+    if (nullptr != m_xFreeQueue)
+    {
+        vQueueDelete(m_xFreeQueue);
+        m_xFreeQueue = nullptr;
+    }
+
+    if (nullptr != m_xFullQueue)
+    {
+        vQueueDelete(m_xFullQueue);
+        m_xFullQueue = nullptr;
+    }
+
+    if (nullptr != m_xSemaphore)
+    {
+        vSemaphoreDelete(m_xSemaphore);
+        m_xSemaphore = nullptr;
+    }
+
+    m_expectedSha256.clear();
+
+    return;
+}
+
+void UpdateWriter::writeBuffer(uint8_t index)
+{
+    const size_t    LEN         = m_bufferLen[index];
+    bool            isGranted   = false;
+    size_t          written     = 0U;
+
+    (void)mbedtls_sha256_update_ret(&m_sha256Ctx, m_buffers[index], LEN);
+
+    /* The buffer is one flash sector, therefore it is written at once. */
+    isGranted   = DisplayMgr::getInstance().beginFlashAccess(FLASH_ACCESS_TIMEOUT);
+    written     = Update.write(m_buffers[index], LEN);
+
+    if (true == isGranted)
+    {
+        DisplayMgr::getInstance().endFlashAccess();
+    }
+
+    if (LEN != written)
+    {
+        m_errorStr  = Update.errorString();
+        m_isError   = true;
+    }
+
+    return;
+}
+
+void UpdateWriter::writerTask(void* parameters)
+{
+    UpdateWriter* writer = reinterpret_cast<UpdateWriter*>(parameters);
+
+    if ((nullptr != writer) &&
+        (nullptr != writer->m_xSemaphore))
+    {
+        bool isExit = false;
+
+        (void)xSemaphoreTake(writer->m_xSemaphore, portMAX_DELAY);
+
+        while(false == isExit)
+        {
+            uint8_t index = BUFFER_INVALID;
+
+            if (pdTRUE == xQueueReceive(writer->m_xFullQueue, &index, portMAX_DELAY))
+            {
+                if (BUFFER_COUNT <= index)
+                {
+                    isExit = true;
+                }
+                else
+                {
+                    if (false == writer->m_isError)
+                    {
+                        writer->writeBuffer(index);
+                    }
+
+                    (void)xQueueSendToBack(writer->m_xFreeQueue, &index, portMAX_DELAY);
+                }
+            }
+        }
+
+        (void)xSemaphoreGive(writer->m_xSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
\ No newline at end of file
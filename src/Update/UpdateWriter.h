@@ -0,0 +1,266 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Update writer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup update
+ *
+ * @{
+ */
+
+#ifndef __UPDATE_WRITER_H__
+#define __UPDATE_WRITER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <WString.h>
+#include <esp_spi_flash.h>
+#include <mbedtls/sha256.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The update writer streams an uploaded firmware or filesystem image to the
+ * flash. The received data is collected in sector sized buffers, which a
+ * dedicated task writes behind, while the next buffer is received.
+ * Every flash write is coordinated with the display manager, so the display
+ * keeps running without artifacts. The SHA-256 of the image is calculated
+ * incrementally and verified at the end, if it is known.
+ */
+class UpdateWriter
+{
+public:
+
+    /** Buffer size in byte, which is one flash sector. */
+    static const size_t         BUFFER_SIZE         = SPI_FLASH_SEC_SIZE;
+
+    /** Number of buffers, one is received while the other is written. */
+    static const uint8_t        BUFFER_COUNT        = 2U;
+
+    /** Max. time in ms to wait for a free buffer. */
+    static const uint32_t       BUFFER_TIMEOUT      = 5000U;
+
+    /**
+     * Max. time in ms to wait for the display, before the flash is written
+     * anyway. Possible artifacts are better than a failed update.
+     */
+    static const uint32_t       FLASH_ACCESS_TIMEOUT    = 100U;
+
+    /** SHA-256 digest size in byte. */
+    static const size_t         SHA256_SIZE         = 32U;
+
+    /** Task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 4096U;
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Task priority, which is equal to the webserver (async TCP) task priority. */
+    static const UBaseType_t    TASK_PRIORITY       = 3U;
+
+    /**
+     * Get the update writer instance.
+     *
+     * @return Update writer
+     */
+    static UpdateWriter& getInstance()
+    {
+        static UpdateWriter instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Begin the update.
+     *
+     * @param[in] size      Image size in byte or UPDATE_SIZE_UNKNOWN
+     * @param[in] cmd       U_FLASH for the firmware or U_SPIFFS for the filesystem
+     * @param[in] sha256    Expected SHA-256 of the image as hex string. If empty, it won't be verified.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin(size_t size, int cmd, const String& sha256);
+
+    /**
+     * Write the next part of the image. If the buffers are full, it will
+     * wait until the flash write of one is finished.
+     *
+     * @param[in] data  Data
+     * @param[in] len   Data length in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool write(const uint8_t* data, size_t len);
+
+    /**
+     * Write the remaining data, verify the image and finish the update.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool end();
+
+    /**
+     * Abort the update.
+     */
+    void abort();
+
+    /**
+     * Is an update running?
+     *
+     * @return If an update is running, it will return true otherwise false.
+     */
+    bool isRunning() const
+    {
+        return (nullptr != m_taskHandle);
+    }
+
+    /**
+     * Get the progress of the received data.
+     *
+     * @return Progress in [0; 100] %
+     */
+    uint8_t getProgress() const;
+
+    /**
+     * Get the error reason of the latest failed operation.
+     *
+     * @return Error reason
+     */
+    const char* getErrorStr() const
+    {
+        return m_errorStr;
+    }
+
+private:
+
+    /** Invalid buffer index, which is used to signal the task exit too. */
+    static const uint8_t        BUFFER_INVALID      = UINT8_MAX;
+
+    /** Writer task handle */
+    TaskHandle_t            m_taskHandle;
+
+    /** Binary semaphore used to signal the task exit. */
+    SemaphoreHandle_t       m_xSemaphore;
+
+    /** Queue with the indices of the buffers, which to write. */
+    QueueHandle_t           m_xFullQueue;
+
+    /** Queue with the indices of the free buffers. */
+    QueueHandle_t           m_xFreeQueue;
+
+    /** Sector sized buffers */
+    uint8_t*                m_buffers[BUFFER_COUNT];
+
+    /** Number of used bytes per buffer. */
+    size_t                  m_bufferLen[BUFFER_COUNT];
+
+    /** Index of the buffer, which is currently filled. */
+    uint8_t                 m_fillIndex;
+
+    /** Image size in byte */
+    size_t                  m_size;
+
+    /** Number of received bytes */
+    size_t                  m_received;
+
+    /** Is a write error pending? It is set by the writer task. */
+    volatile bool           m_isError;
+
+    /** Error reason */
+    const char*             m_errorStr;
+
+    /** Incremental SHA-256 calculation */
+    mbedtls_sha256_context  m_sha256Ctx;
+
+    /** Expected SHA-256 as hex string, empty if unknown. */
+    String                  m_expectedSha256;
+
+    /**
+     * Constructs the update writer.
+     */
+    UpdateWriter();
+
+    /**
+     * Destroys the update writer.
+     */
+    ~UpdateWriter();
+
+    UpdateWriter(const UpdateWriter& writer);
+    UpdateWriter& operator=(const UpdateWriter& writer);
+
+    /**
+     * Hand the buffer, which is currently filled, over to the writer task.
+     */
+    void flush();
+
+    /**
+     * Wait until all pending buffers are handled and stop the writer task.
+     */
+    void stop();
+
+    /**
+     * Release all resources.
+     */
+    void destroy();
+
+    /**
+     * Write a buffer to flash, in cooperation with the display manager.
+     *
+     * @param[in] index Buffer index
+     */
+    void writeBuffer(uint8_t index);
+
+    /**
+     * Writer task, which writes the filled buffers to flash.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void writerTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __UPDATE_WRITER_H__ */
+
+/** @} */
\ No newline at end of file
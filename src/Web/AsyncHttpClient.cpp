@@ -33,9 +33,14 @@
  * Includes
  *****************************************************************************/
 #include "AsyncHttpClient.h"
+#include "HttpStatus.h"
+#include "DnsCache.h"
+#include "CrashTrace.h"
+#include "TlsStore.h"
 
 #include <Util.h>
 #include <Logging.h>
+#include <Metrics.h>
 #include <base64.h>
 
 /******************************************************************************
@@ -46,6 +51,10 @@
  * Macros
  *****************************************************************************/
 
+/** Log with the own log module, see gLogModule. */
+#undef LOG_MODULE
+#define LOG_MODULE  (gLogModule)
+
 /******************************************************************************
  * Types and classes
  *****************************************************************************/
@@ -58,6 +67,24 @@
  * Local Variables
  *****************************************************************************/
 
+/** Log module of the HTTP client, its log level can be changed at runtime. */
+static Logging::Module  gLogModule("HttpClient");
+
+/** Upper bounds of the HTTP response latency histogram buckets in ms. */
+static const uint32_t   gLatencyBounds[]    = { 50U, 100U, 250U, 500U, 1000U, 2500U, 5000U };
+
+/** HTTP response latency histogram */
+static MetricHistogram  gMetricLatency("pixelix_http_client_latency_ms", "Time from sending a HTTP request until the response status is received in ms.", gLatencyBounds, UTIL_ARRAY_NUM(gLatencyBounds));
+
+/** Number of HTTP requests */
+static MetricCounter    gMetricRequests("pixelix_http_client_requests_total", "Number of sent HTTP requests.");
+
+/** Number of HTTP client errors */
+static MetricCounter    gMetricErrors("pixelix_http_client_errors_total", "Number of HTTP client connection errors.");
+
+/** Number of HTTP client timeouts */
+static MetricCounter    gMetricTimeouts("pixelix_http_client_timeouts_total", "Number of HTTP client timeouts.");
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -67,10 +94,14 @@ AsyncHttpClient::AsyncHttpClient() :
     m_onRspCallback(nullptr),
     m_onClosedCallback(),
     m_onErrorCallback(),
+    m_onBodyCallback(nullptr),
     m_hostname(),
     m_port(0U),
     m_base64Authorization(),
     m_uri(),
+    m_pipelinedUris(),
+    m_pipelinedUriCnt(0U),
+    m_rspIndex(0U),
     m_headers(),
     m_isReqOpen(false),
     m_method(),
@@ -80,15 +111,22 @@ AsyncHttpClient::AsyncHttpClient() :
     m_urlEncodedPars(),
     m_payload(nullptr),
     m_payloadSize(0U),
-    m_rspPart(RESPONSE_PART_STATUS_LINE),
+    m_request(),
+    m_fixedHeaders(),
+    m_isFixedHeadersValid(false),
+    m_fixedHeadersHostname(),
+    m_fixedHeadersPort(0U),
+    m_fixedHeadersAuthorization(),
+    m_fixedHeadersIsHttpVer10(false),
+    m_parser(*this),
     m_rsp(),
-    m_rspLine(),
     m_transferCoding(TRANSFER_CODING_IDENTITY),
     m_contentLength(0U),
-    m_contentIndex(0U),
-    m_chunkSize(0U),
-    m_chunkIndex(0U),
-    m_chunkBodyPart(CHUNK_SIZE)
+    m_isBodyAvailable(true),
+    m_requestTimestamp(0U),
+    m_payloadSizeHint(0U),
+    m_isSecure(false),
+    m_tls(m_tcpClient)
 {
     m_tcpClient.onConnect(  [this](void* arg, AsyncClient* client)
                             {
@@ -124,10 +162,16 @@ AsyncHttpClient::AsyncHttpClient() :
 
                                 onTimeout(client, timeout);
                             });
+
+    /* Header fields, which are evaluated by the client itself. */
+    (void)m_rsp.addHeaderInterest("Connection");
+    (void)m_rsp.addHeaderInterest("Content-Length");
+    (void)m_rsp.addHeaderInterest("Transfer-Encoding");
 }
 
 AsyncHttpClient::~AsyncHttpClient()
 {
+    DnsCache::getInstance().cancel(this);
 }
 
 bool AsyncHttpClient::begin(const String& url)
@@ -159,11 +203,20 @@ bool AsyncHttpClient::begin(const String& url)
         /* Determine port from protocol */
         if (protocol == "http")
         {
-            m_port = HTTP_PORT;
+            m_port      = HTTP_PORT;
+            m_isSecure  = false;
         }
         else if (protocol == "https")
         {
-            m_port = HTTPS_PORT;
+            m_port      = HTTPS_PORT;
+            m_isSecure  = true;
+
+            /* Loads the CA certificates once. */
+            if (false == TlsStore::getInstance().begin())
+            {
+                status = false;
+                LOG_ERROR("HTTPS is not available.");
+            }
         }
         else
         {
@@ -201,6 +254,7 @@ bool AsyncHttpClient::begin(const String& url)
             {
                 auth = host.substring(0, index);
                 m_base64Authorization = base64::encode(auth);
+                m_base64Authorization.replace("\n", "");
 
                 /* Remove authorization from host string. */
                 host.remove(0, index + 1);
@@ -265,13 +319,35 @@ bool AsyncHttpClient::begin(const String& url)
 
 void AsyncHttpClient::end()
 {
+    DnsCache::getInstance().cancel(this);
     disconnect();
     clear();
 }
 
 bool AsyncHttpClient::connect()
 {
-    return m_tcpClient.connect(m_hostname.c_str(), m_port);
+    bool                status  = false;
+    IPAddress           addr;
+    DnsCache::Result    result  = DnsCache::getInstance().resolve(m_hostname, addr, this, [this](bool isResolved, const IPAddress& resolvedAddr)
+                                    {
+                                        onResolved(isResolved, resolvedAddr);
+                                    });
+
+    if (DnsCache::RESULT_RESOLVED == result)
+    {
+        status = m_tcpClient.connect(addr, m_port);
+    }
+    /* Connect after the hostname is resolved. */
+    else if (DnsCache::RESULT_PENDING == result)
+    {
+        status = true;
+    }
+    else
+    {
+        LOG_WARNING("Can't resolve %s.", m_hostname.c_str());
+    }
+
+    return status;
 }
 
 void AsyncHttpClient::disconnect()
@@ -281,7 +357,8 @@ void AsyncHttpClient::disconnect()
 
 bool AsyncHttpClient::isConnected()
 {
-    return m_tcpClient.connected();
+    return (true == m_tcpClient.connected()) &&
+           ((false == m_isSecure) || (true == m_tls.isEstablished()));
 }
 
 bool AsyncHttpClient::isDisconnected()
@@ -299,6 +376,11 @@ void AsyncHttpClient::setKeepAlive(bool keepAlive)
     m_isKeepAlive = keepAlive;
 }
 
+bool AsyncHttpClient::isKeepAlive() const
+{
+    return m_isKeepAlive;
+}
+
 void AsyncHttpClient::addHeader(const String& name, const String& value)
 {
     /* Only add header if not handled by the client itself. */
@@ -342,6 +424,27 @@ void AsyncHttpClient::clearPar()
     m_urlEncodedPars.clear();
 }
 
+bool AsyncHttpClient::addPipelinedUri(const String& uri)
+{
+    bool status = false;
+
+    if ((false == m_isReqOpen) &&
+        (MAX_PIPELINED_URIS > m_pipelinedUriCnt))
+    {
+        m_pipelinedUris[m_pipelinedUriCnt] = uri;
+        ++m_pipelinedUriCnt;
+
+        status = true;
+    }
+
+    return status;
+}
+
+uint8_t AsyncHttpClient::getResponseIndex() const
+{
+    return m_rspIndex;
+}
+
 void AsyncHttpClient::regOnResponse(const OnResponse& onResponse)
 {
     m_onRspCallback = onResponse;
@@ -357,6 +460,31 @@ void AsyncHttpClient::regOnError(const OnError& onError)
     m_onErrorCallback = onError;
 }
 
+void AsyncHttpClient::regOnBody(const OnBody& onBody)
+{
+    m_onBodyCallback = onBody;
+}
+
+bool AsyncHttpClient::addHeaderInterest(const char* name)
+{
+    return m_rsp.addHeaderInterest(name);
+}
+
+void AsyncHttpClient::setPayloadSizeHint(size_t size)
+{
+    m_payloadSizeHint = size;
+}
+
+void AsyncHttpClient::setMaxPayloadSize(size_t size)
+{
+    m_rsp.setMaxPayloadSize(size);
+}
+
+void AsyncHttpClient::setPayloadBuffer(uint8_t* buffer, size_t size)
+{
+    m_rsp.setPayloadBuffer(buffer, size);
+}
+
 bool AsyncHttpClient::GET()
 {
     bool status = false;
@@ -367,7 +495,15 @@ bool AsyncHttpClient::GET()
         m_payload       = nullptr;
         m_payloadSize   = 0U;
 
-        if (false == isConnected())
+        /* The responses of pipelined requests are only distinguishable
+         * with a persistent connection.
+         */
+        if ((0U < m_pipelinedUriCnt) &&
+            ((true == m_isHttpVer10) || (false == m_urlEncodedPars.isEmpty())))
+        {
+            LOG_WARNING("Pipelining not possible.");
+        }
+        else if (false == isConnected())
         {
             status = connect();
             m_isReqOpen = status;
@@ -452,7 +588,24 @@ bool AsyncHttpClient::POST(const String& payload)
 void AsyncHttpClient::onConnect(AsyncClient* client)
 {
     LOG_INFO("Connected.");
+    CrashTrace::getInstance().add(CrashTrace::TYPE_HTTP, CrashTrace::HTTP_EVT_CONNECT);
+
+    /* A secure connection is established after the TLS handshake. */
+    if (true == m_isSecure)
+    {
+        if (false == m_tls.start(m_hostname, m_port))
+        {
+            client->close();
+        }
+    }
+    else
+    {
+        onEstablished(client);
+    }
+}
 
+void AsyncHttpClient::onEstablished(AsyncClient* client)
+{
     /* Is there a queued request, which to send? */
     if (true == m_isReqOpen)
     {
@@ -470,6 +623,12 @@ void AsyncHttpClient::onDisconnect(AsyncClient* client)
     UTIL_NOT_USED(client);
 
     LOG_INFO("Disconnected.");
+    CrashTrace::getInstance().add(CrashTrace::TYPE_HTTP, CrashTrace::HTTP_EVT_DISCONNECT);
+    m_tls.stop();
+
+    /* A body without content length ends with the connection. */
+    (void)m_parser.finish();
+
     clear();
     notifyClosed();
 }
@@ -479,6 +638,9 @@ void AsyncHttpClient::onError(AsyncClient* client, int8_t error)
     const char* errorDescription = errorToStr(error);
     UTIL_NOT_USED(client);
 
+    CrashTrace::getInstance().add(CrashTrace::TYPE_HTTP, CrashTrace::HTTP_EVT_ERROR, static_cast<uint16_t>(error));
+    gMetricErrors.inc();
+
     if (nullptr != errorDescription)
     {
         LOG_WARNING("Error occurred: %d - %s", error, errorDescription);
@@ -492,113 +654,76 @@ void AsyncHttpClient::onError(AsyncClient* client, int8_t error)
     disconnect();
 }
 
-void AsyncHttpClient::onData(AsyncClient* client, const uint8_t* data, size_t len)
+void AsyncHttpClient::onResolved(bool isResolved, const IPAddress& addr)
 {
-    size_t      index       = 0U;
-    const char* asciiData   = reinterpret_cast<const char*>(data);
-    bool        isError     = false;
-
-    /* RFC2616 - Response = Status-Line
-     *                      *(( general-header
-     *                       | response-header
-     *                       | entity-header ) CRLF)
-     *                CRLF
-     *                [ message-body ]
-     */
-
-    LOG_INFO("onData(): len = %u", len);
-
-    while((len > index) && (false == isError))
+    /* The request may be aborted during the lookup. */
+    if (true == m_isReqOpen)
     {
-        switch(m_rspPart)
+        if (false == isResolved)
         {
-        case RESPONSE_PART_STATUS_LINE:
-            if (true == parseRspStatusLine(asciiData, len, index))
-            {
-                LOG_INFO("Rsp. HTTP-Version: %s", m_rsp.getHttpVersion().c_str());
-                LOG_INFO("Rsp. Status-Code: %u", m_rsp.getStatusCode());
-                LOG_INFO("Rsp. Reason-Phrase: %s", m_rsp.getReasonPhrase().c_str());
-
-                m_rspPart = RESPONSE_PART_HEADER;
-            }
-            break;
-
-        case RESPONSE_PART_HEADER:
-            if (true == parseRspHeader(asciiData, len, index))
-            {
-                /* Examine response header.
-                 * This is important to determine the number of following
-                 * payload data and to know when the last data is
-                 * received.
-                 */
-                if (false == handleRspHeader())
-                {
-                    /* Not nice, but anyway. */
-                    LOG_ERROR("Header error.");
-                    client->close();
-                    isError = true;
-                }
-                else if (TRANSFER_CODING_IDENTITY == m_transferCoding)
-                {
-                    /* "Content-Length" may be missing. */
-                    if (0U == m_contentLength)
-                    {
-                        m_contentLength = len - index;
-                    }
-                }
-                m_rspPart = RESPONSE_PART_BODY;
-            }
-            break;
-
-        case RESPONSE_PART_BODY:
-            if (TRANSFER_CODING_CHUNCKED == m_transferCoding)
-            {
-                if (true == parseChunkedResponse(data, len, index))
-                {
-                    notifyResponse();
-
-                    m_transferCoding = TRANSFER_CODING_IDENTITY;
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
-                }
-            }
-            else
-            {
-                size_t available    = len - index;
-                size_t needed       = m_contentLength - m_contentIndex;
-                size_t copySize     = 0U;
-
-                if (available >= needed)
-                {
-                    copySize = needed;
-                }
-                else
-                {
-                    copySize = available;
-                }
-
-                m_rsp.addPayload(&data[index], copySize);
-                m_contentIndex += copySize;
-                index += copySize;
+            LOG_WARNING("Can't resolve %s.", m_hostname.c_str());
+            m_isReqOpen = false;
+            notifyError();
+        }
+        else if (false == m_tcpClient.connect(addr, m_port))
+        {
+            LOG_WARNING("Connecting to %s failed.", m_hostname.c_str());
+            m_isReqOpen = false;
+            notifyError();
+        }
+        else
+        {
+            ;
+        }
+    }
 
-                if (m_contentLength <= m_contentIndex)
-                {
-                    notifyResponse();
+    return;
+}
 
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
-                    m_contentLength = 0U;
-                    m_contentIndex = 0U;
-                }
-            }
-            break;
+void AsyncHttpClient::onData(AsyncClient* client, const uint8_t* data, size_t len)
+{
+    if (true == m_isSecure)
+    {
+        bool wasEstablished = m_tls.isEstablished();
 
-        default:
-            LOG_FATAL("Internal error.");
+        if (false == m_tls.receive(data, len, [this, client](const uint8_t* plainData, size_t plainLen)
+                                                {
+                                                    handleRspData(client, plainData, plainLen);
+                                                }))
+        {
             client->close();
-            isError = true;
-            break;
         }
+        /* Send the queued request after the handshake. */
+        else if ((false == wasEstablished) &&
+                 (true == m_tls.isEstablished()))
+        {
+            onEstablished(client);
+        }
+        else
+        {
+            ;
+        }
+    }
+    else
+    {
+        handleRspData(client, data, len);
+    }
+}
+
+void AsyncHttpClient::handleRspData(AsyncClient* client, const uint8_t* data, size_t len)
+{
+    LOG_INFO_DEFERRED("onData(): len = %u", len);
+
+    /* RFC7230 - HTTP-message = start-line
+     *                          *( header-field CRLF )
+     *                          CRLF
+     *                          [ message-body ]
+     */
+    if (false == m_parser.parse(data, len))
+    {
+        /* Not nice, but anyway. */
+        LOG_ERROR("Invalid response.");
+        client->close();
     }
 }
 
@@ -607,16 +732,23 @@ void AsyncHttpClient::onTimeout(AsyncClient* client, uint32_t timeout)
     UTIL_NOT_USED(timeout);
 
     LOG_WARNING("Timeout.");
+    CrashTrace::getInstance().add(CrashTrace::TYPE_HTTP, CrashTrace::HTTP_EVT_TIMEOUT);
+    gMetricTimeouts.inc();
     client->close();
 }
 
 bool AsyncHttpClient::sendRequest()
 {
-    bool        status      = false;
-    String      request;
-    const char* PROTOCOL    = "HTTP";
-    const char* SP          = " ";
-    const char* CRLF        = "\r\n";
+    bool        status          = false;
+    const char* CRLF            = "\r\n";
+    uint8_t     pipelinedCnt    = 0U;
+    uint8_t     index           = 0U;
+
+    /* Only GET requests are pipelined, see GET(). */
+    if (true == m_method.equals("GET"))
+    {
+        pipelinedCnt = m_pipelinedUriCnt;
+    }
 
     /* RFC2616
      * Request = Request-Line
@@ -628,191 +760,309 @@ bool AsyncHttpClient::sendRequest()
      *
      */
 
+    /* The request buffer keeps its capacity, therefore after the first
+     * request no reallocation is necessary anymore.
+     */
+    m_request = "";
+    m_request.reserve(REQUEST_RESERVED_SIZE * (1U + pipelinedCnt));
+
+    /* All requests except the last one keep the connection alive,
+     * otherwise the host would close it after the first response.
+     */
+    appendRequest(m_uri, (0U < pipelinedCnt) || (true == m_isKeepAlive));
+
+    /* Only user defined payload can be sent or URL encoded parameters.
+     * Because user might already added a "Content-Type" header in case
+     * a user payload is available, in this case the URL encoded parameters
+     * are skipped.
+     */
+    if ((nullptr != m_payload) &&
+        (0U < m_payloadSize))
+    {
+        m_request += "Content-Length: ";
+        m_request += m_payloadSize;
+        m_request += CRLF;
+
+        if (false == m_urlEncodedPars.isEmpty())
+        {
+            LOG_WARNING("Parameters skipped.");
+        }
+    }
+    else if (false == m_urlEncodedPars.isEmpty())
+    {
+        m_request += "Content-Type: application/x-www-form-urlencoded\r\n";
+        m_request += "Content-Length: ";
+        m_request += m_urlEncodedPars.length();
+        m_request += CRLF;
+
+        m_payload       = reinterpret_cast<const uint8_t*>(m_urlEncodedPars.c_str());
+        m_payloadSize   = m_urlEncodedPars.length();
+    }
+
+    m_request += m_headers;
+    m_request += CRLF;
+
+    /* The pipelined requests follow immediately, without waiting for the
+     * responses. They have no payload, see GET().
+     */
+    for(index = 0U; index < pipelinedCnt; ++index)
+    {
+        appendRequest(m_pipelinedUris[index], ((index + 1U) < pipelinedCnt) || (true == m_isKeepAlive));
+
+        m_request += m_headers;
+        m_request += CRLF;
+    }
+
+    /* Send header */
+    m_requestTimestamp  = millis();
+    m_rspIndex          = 0U;
+    gMetricRequests.inc(1U + pipelinedCnt);
+    status = (m_request.length() == writeData(reinterpret_cast<const uint8_t*>(m_request.c_str()), m_request.length(), ASYNC_WRITE_FLAG_COPY));
+
+    /* Send payload */
+    if ((true == status) &&
+        (nullptr != m_payload) &&
+        (0U < m_payloadSize))
+    {
+        status = (m_payloadSize == writeData(m_payload, m_payloadSize, 0));
+    }
+
+    return status;
+}
+
+void AsyncHttpClient::appendRequest(const String& uri, bool isKeepAlive)
+{
+    const char* SP      = " ";
+    const char* CRLF    = "\r\n";
+
     /* Request-Line: Method SP Request-URI SP HTTP-Version CRLF */
 
     /* Method */
-    request += m_method;
-    request += SP;
+    m_request += m_method;
+    m_request += SP;
 
     /* Request-URI    = "*" | absoluteURI | abs_path | authority */
-    if (true == m_uri.isEmpty())
+    if (true == uri.isEmpty())
     {
-        request += "/";
+        m_request += "/";
     }
     else
     {
-        request += m_uri;
+        m_request += uri;
     }
 
-    request += SP;
+    m_request += SP;
 
     /* HTTP-Version */
-    request += PROTOCOL;
-    request += "/";
-
     if (false == m_isHttpVer10)
     {
-        request += "1.1";
+        m_request += "HTTP/1.1";
     }
     else
     {
-        request += "1.0";
+        m_request += "HTTP/1.0";
     }
 
-    request += CRLF;
+    m_request += CRLF;
 
     /* --- Add now the request headers. --- */
 
-    /* RFC2616 - general-header */
-    /* Empty */
-
-    /* RFC2616 - request-header */
-    request += "Host: ";
-    request += m_hostname;
-
-    if ((HTTP_PORT != m_port) &&
-        (HTTPS_PORT != m_port))
-    {
-        request += ":";
-        request += m_port;
-    }
-
-    request += CRLF;
-
-    request += "User-Agent: ";
-    request += m_userAgent;
-    request += CRLF;
+    /* Host, user agent, accepted encodings and authorization change seldom. */
+    updateFixedHeaders();
+    m_request += m_fixedHeaders;
 
     /* HTTP/1.1 defines the "close" connection option for the sender to
      * signal that the connection will be closed after completion of the
      * response.
      */
-    request += "Connection: ";
-
-    if (false == m_isKeepAlive)
+    if (false == isKeepAlive)
     {
-        request += "close";
+        m_request += "Connection: close\r\n";
     }
     else
     {
-        request += "keep-alive";
+        m_request += "Connection: keep-alive\r\n";
     }
-    request += CRLF;
 
-    if (false == m_isHttpVer10)
+    return;
+}
+
+size_t AsyncHttpClient::writeData(const uint8_t* data, size_t len, uint8_t apiFlags)
+{
+    size_t written = 0U;
+
+    if (true == m_isSecure)
     {
-        /* By the client supported transfer codings. */
-        request += "Accept-Encoding: ";
-        request += "identity;q=1,chunked;q=0.1,*;q=0";
-        request += CRLF;
+        written = m_tls.write(data, len);
     }
-
-    if (0U < m_base64Authorization.length())
+    else
     {
-        m_base64Authorization.replace("\n", "");
-        request += "Authorization: Basic ";
-        request += m_base64Authorization;
-        request += CRLF;
+        written = m_tcpClient.write(reinterpret_cast<const char*>(data), len, apiFlags);
     }
 
-    /* Only user defined payload can be sent or URL encoded parameters.
-     * Because user might already added a "Content-Type" header in case
-     * a user payload is available, in this case the URL encoded parameters
-     * are skipped.
-     */
-    if ((nullptr != m_payload) &&
-        (0U < m_payloadSize))
+    return written;
+}
+
+void AsyncHttpClient::updateFixedHeaders()
+{
+    const char* CRLF = "\r\n";
+
+    /* Render the headers only again, if one of its parts changed. */
+    if ((false == m_isFixedHeadersValid) ||
+        (m_fixedHeadersHostname != m_hostname) ||
+        (m_fixedHeadersPort != m_port) ||
+        (m_fixedHeadersAuthorization != m_base64Authorization) ||
+        (m_fixedHeadersIsHttpVer10 != m_isHttpVer10))
     {
-        request += "Content-Length: ";
-        request += m_payloadSize;
-        request += CRLF;
+        m_fixedHeaders = "";
 
-        if (false == m_urlEncodedPars.isEmpty())
+        /* RFC2616 - general-header */
+        /* Empty */
+
+        /* RFC2616 - request-header */
+        m_fixedHeaders += "Host: ";
+        m_fixedHeaders += m_hostname;
+
+        if ((HTTP_PORT != m_port) &&
+            (HTTPS_PORT != m_port))
         {
-            LOG_WARNING("Parameters skipped.");
+            m_fixedHeaders += ":";
+            m_fixedHeaders += m_port;
         }
-    }
-    else if (false == m_urlEncodedPars.isEmpty())
-    {
-        request += "Content-Type: application/x-www-form-urlencoded";
-        request += CRLF;
-        request += "Content-Length: ";
-        request += m_urlEncodedPars.length();
-        request += CRLF;
 
-        m_payload       = reinterpret_cast<const uint8_t*>(m_urlEncodedPars.c_str());
-        m_payloadSize   = m_urlEncodedPars.length();
-    }
+        m_fixedHeaders += CRLF;
 
-    request += m_headers;
-    request += CRLF;
+        m_fixedHeaders += "User-Agent: ";
+        m_fixedHeaders += m_userAgent;
+        m_fixedHeaders += CRLF;
 
-    /* Send header */
-    status = (request.length() == m_tcpClient.write(request.c_str(), request.length()));
+        if (false == m_isHttpVer10)
+        {
+            /* By the client supported transfer codings. */
+            m_fixedHeaders += "Accept-Encoding: identity;q=1,chunked;q=0.1,*;q=0\r\n";
+        }
 
-    /* Send payload */
-    if ((true == status) &&
-        (nullptr != m_payload) &&
-        (0U < m_payloadSize))
-    {
-        status = (m_payloadSize == m_tcpClient.write(reinterpret_cast<const char*>(m_payload), m_payloadSize, 0));
+        if (0U < m_base64Authorization.length())
+        {
+            m_fixedHeaders += "Authorization: Basic ";
+            m_fixedHeaders += m_base64Authorization;
+            m_fixedHeaders += CRLF;
+        }
+
+        m_fixedHeadersHostname      = m_hostname;
+        m_fixedHeadersPort          = m_port;
+        m_fixedHeadersAuthorization = m_base64Authorization;
+        m_fixedHeadersIsHttpVer10   = m_isHttpVer10;
+        m_isFixedHeadersValid       = true;
     }
 
-    return status;
+    return;
 }
 
 void AsyncHttpClient::clear()
 {
     m_hostname.clear();
     m_port = 0U;
+    m_isSecure = false;
     m_base64Authorization.clear();
     m_uri.clear();
+    m_pipelinedUriCnt = 0U;
+    m_rspIndex = 0U;
     m_headers.clear();
     m_urlEncodedPars.clear();
 
     m_isReqOpen = false;
 
-    m_rspPart = RESPONSE_PART_STATUS_LINE;
+    m_parser.reset();
     m_rsp.clear();
-    m_rspLine.clear();
     m_transferCoding = TRANSFER_CODING_IDENTITY;
     m_contentLength = 0U;
-    m_contentIndex = 0U;
-    m_chunkSize = 0U;
-    m_chunkIndex = 0U;
-    m_chunkBodyPart = CHUNK_SIZE;
+    m_isBodyAvailable = true;
 
     return;
 }
 
-bool AsyncHttpClient::isEOL(const String& str, size_t& len)
+void AsyncHttpClient::onStatusLine(const char* line, size_t length)
 {
-    bool        isEOL               = false;
-    const char  TERMINATOR_LF[]     = "\n";
-    const char  TERMINATOR_CRLF[]   = "\r\n";
+    UTIL_NOT_USED(length);
+
+    m_rsp.addStatusLine(line);
 
-    len = 0U;
+    LOG_INFO("Rsp. HTTP-Version: %s", m_rsp.getHttpVersion().c_str());
+    LOG_INFO_DEFERRED("Rsp. Status-Code: %u", m_rsp.getStatusCode());
+    CrashTrace::getInstance().add(CrashTrace::TYPE_HTTP, CrashTrace::HTTP_EVT_RSP, m_rsp.getStatusCode());
+    gMetricLatency.observe(millis() - m_requestTimestamp);
+    LOG_INFO("Rsp. Reason-Phrase: %s", m_rsp.getReasonPhrase().c_str());
+}
+
+void AsyncHttpClient::onHeader(const char* line, size_t length)
+{
+    LOG_INFO("Rsp. header: %s", line);
+
+    m_rsp.addHeader(line, length);
+}
 
-    /* RFC7230 - 3.5. Message Parsing Robustness
-     * Although the line terminator for the start-line and header fields is
-     * the sequence CRLF, a recipient MAY recognize a single LF as a line
-     * terminator and ignore any preceding CR.
+IHttpRspListener::BodyType AsyncHttpClient::onHeaderEnd(size_t& contentLength)
+{
+    BodyType bodyType = BODY_INVALID;
+
+    /* Examine response header.
+     * This is important to determine the number of following
+     * payload data and to know when the last data is
+     * received.
      */
-    if (0U != str.endsWith(TERMINATOR_LF))
+    if (false == handleRspHeader())
     {
-        isEOL = true;
-
-        if (0U != str.endsWith(TERMINATOR_CRLF))
-        {
-            len = 2U;
-        }
-        else
-        {
-            len = 1U;
-        }
+        LOG_ERROR("Header error.");
+    }
+    else if (TRANSFER_CODING_CHUNCKED == m_transferCoding)
+    {
+        bodyType = BODY_CHUNKED;
+        reservePayload(m_payloadSizeHint);
+    }
+    /* Without body the response is complete with the header. */
+    else if (false == m_isBodyAvailable)
+    {
+        bodyType = BODY_NONE;
     }
+    else if (0U < m_contentLength)
+    {
+        bodyType        = BODY_LENGTH;
+        contentLength   = m_contentLength;
+        reservePayload(m_contentLength);
+    }
+    /* "Content-Length" is missing, the body ends with the connection. */
+    else
+    {
+        bodyType = BODY_UNTIL_CLOSE;
+        reservePayload(m_payloadSizeHint);
+    }
+
+    return bodyType;
+}
+
+void AsyncHttpClient::onChunk(size_t size)
+{
+    LOG_INFO_DEFERRED("Chunk size is %u byte.", size);
+
+    /* Only reallocated, if the reserved payload is exceeded. */
+    reservePayload(size);
+}
 
-    return isEOL;
+void AsyncHttpClient::onBody(const uint8_t* data, size_t size)
+{
+    handleBody(data, size);
+}
+
+void AsyncHttpClient::onComplete()
+{
+    notifyResponse();
+    ++m_rspIndex;
+
+    m_rsp.clear();
+    m_transferCoding    = TRANSFER_CODING_IDENTITY;
+    m_contentLength     = 0U;
+    m_isBodyAvailable   = true;
 }
 
 bool AsyncHttpClient::handleRspHeader()
@@ -847,11 +1097,13 @@ bool AsyncHttpClient::handleRspHeader()
 
     if (false == value.isEmpty())
     {
-        m_contentLength = value.toInt();
+        m_contentLength     = value.toInt();
+        m_isBodyAvailable   = (0U < m_contentLength);
     }
     else
     {
-        m_contentLength = 0U;
+        m_contentLength     = 0U;
+        m_isBodyAvailable   = true;
     }
 
     value = m_rsp.getHeader("Transfer-Encoding");
@@ -870,257 +1122,55 @@ bool AsyncHttpClient::handleRspHeader()
         }
     }
 
-    return isSuccess;
-}
-
-bool AsyncHttpClient::parseChunkedResponseSize(const char* data, size_t len, size_t& index)
-{
-    bool isSizeEOF = false;
-
-    while((len > index) && (false == isSizeEOF))
-    {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            m_rspLine.remove(m_rspLine.length() - terminatorLen);
-            m_chunkSize = Util::hexToUInt32(m_rspLine);
-
-            LOG_INFO("Chunk size is %u byte.", m_chunkSize);
-
-            m_rspLine.clear();
-            isSizeEOF = true;
-        }
-    }
-
-    return isSizeEOF;
-}
-
-bool AsyncHttpClient::parseChunkedResponseChunkData(const uint8_t* data, size_t len, size_t& index)
-{
-    size_t  available   = len - index;
-    size_t  needed      = m_chunkSize - m_chunkIndex;
-    size_t  copySize    = 0U;
-    bool    isDataEOF   = false;
-
-    if (available >= needed)
-    {
-        copySize = needed;
-    }
-    else
-    {
-        copySize = available;
-    }
-
-    m_rsp.addPayload(&data[index], copySize);
-    index += copySize;
-    m_chunkIndex += copySize;
-
-    if (m_chunkSize <= m_chunkIndex)
+    /* RFC7230 - 3.3.3. Message Body Length
+     * Any 204 (No Content) and 304 (Not Modified) response ends with the
+     * header section, regardless of the header fields.
+     */
+    if ((HttpStatus::STATUS_CODE_NO_CONTENT == m_rsp.getStatusCode()) ||
+        (HttpStatus::STATUS_CODE_NOT_MODIFIED == m_rsp.getStatusCode()))
     {
-        m_chunkIndex = 0U;
-        isDataEOF = true;
+        m_transferCoding    = TRANSFER_CODING_IDENTITY;
+        m_contentLength     = 0U;
+        m_isBodyAvailable   = false;
+        isSuccess           = true;
     }
 
-    return isDataEOF;
+    return isSuccess;
 }
 
-bool AsyncHttpClient::parseChunkedResponseChunkDataEnd(const char* data, size_t len, size_t& index)
+void AsyncHttpClient::reservePayload(size_t size)
 {
-    bool isDataEOF = false;
-
-    while((len > index) && (false == isDataEOF))
+    /* Streamed body data is not collected in the response. */
+    if ((nullptr == m_onBodyCallback) &&
+        (0U < size))
     {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
+        if (false == m_rsp.reservePayload(size))
         {
-            m_rspLine.clear();
-            isDataEOF = true;
+            LOG_WARNING("Rsp. payload limited, %u byte requested.", size);
         }
     }
-
-    return isDataEOF;
 }
 
-bool AsyncHttpClient::parseChunkedResponseTrailer(const char* data, size_t len, size_t& index)
+void AsyncHttpClient::handleBody(const uint8_t* data, size_t size)
 {
-    bool isTrailerEOF = false;
-
-    while((len > index) && (false == isTrailerEOF))
+    /* Streamed body data is provided directly from the TCP buffer. */
+    if (nullptr != m_onBodyCallback)
     {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            if (terminatorLen < m_rspLine.length())
-            {
-                m_rspLine.remove(m_rspLine.length() - terminatorLen);
-
-                LOG_INFO("Rsp. trailer: %s", m_rspLine.c_str());
-            }
-            else
-            {
-                LOG_INFO("Rsp. chunked transfer finished.");
-
-                isTrailerEOF = true;
-            }
-
-            m_rspLine.clear();
-        }
+        m_onBodyCallback(data, size);
     }
-
-    return isTrailerEOF;
-}
-
-bool AsyncHttpClient::parseChunkedResponse(const uint8_t* data, size_t len, size_t& index)
-{
-    const char* asciiData   = reinterpret_cast<const char*>(data);
-    bool        isChunkEOF  = false;
-
-    /*
-     * Chunked-Body   = *chunk
-     *                 last-chunk
-     *                 trailer
-     *                 CRLF
-     *
-     * chunk          = chunk-size [ chunk-extension ] CRLF
-     *                 chunk-data CRLF
-     * chunk-size     = 1*HEX
-     * last-chunk     = 1*("0") [ chunk-extension ] CRLF
-     *
-     * chunk-extension= *( ";" chunk-ext-name [ "=" chunk-ext-val ] )
-     * chunk-ext-name = token
-     * chunk-ext-val  = token | quoted-string
-     * chunk-data     = chunk-size(OCTET)
-     * trailer        = *(entity-header CRLF)
-     */
-
-    while((len > index) && (false == isChunkEOF))
-    {
-        switch(m_chunkBodyPart)
-        {
-        /* Handle chunk or last-chunk size */
-        case CHUNK_SIZE:
-            if (true == parseChunkedResponseSize(asciiData, len, index))
-            {
-                if (0U == m_chunkSize)
-                {
-                    m_chunkBodyPart = TRAILER;
-                }
-                else
-                {
-                    m_chunkBodyPart = CHUNK_DATA;
-
-                    /* Extend response payload */
-                    m_rsp.extendPayload(m_chunkSize);
-                }
-            }
-            break;
-
-        /* Handle chunk data */
-        case CHUNK_DATA:
-            if (true == parseChunkedResponseChunkData(data, len, index))
-            {
-                m_chunkBodyPart = CHUNK_DATA_END;
-            }
-            break;
-
-        /* Handle chunk data end (CRLF) */
-        case CHUNK_DATA_END:
-            if (true == parseChunkedResponseChunkDataEnd(asciiData, len, index))
-            {
-                m_chunkBodyPart = CHUNK_SIZE;
-            }
-            break;
-
-        /* Handle trailer and CRLF */
-        case TRAILER:
-            if (true == parseChunkedResponseTrailer(asciiData, len, index))
-            {
-                m_chunkBodyPart = CHUNK_SIZE;
-                isChunkEOF = true;
-            }
-            break;
-
-        default:
-            LOG_FATAL("Should never happen.");
-            break;
-        }
-    }
-
-    return isChunkEOF;
-}
-
-bool AsyncHttpClient::parseRspStatusLine(const char* data, size_t len, size_t& index)
-{
-    bool isStatusLineEOF = false;
-
-    while((len > index) && (false == isStatusLineEOF))
+    else
     {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            m_rspLine.remove(m_rspLine.length() - terminatorLen);
-
-            m_rsp.addStatusLine(m_rspLine);
-
-            isStatusLineEOF = true;
-            m_rspLine.clear();
-        }
+        m_rsp.addPayload(data, size);
     }
-
-    return isStatusLineEOF;
 }
 
-bool AsyncHttpClient::parseRspHeader(const char* data, size_t len, size_t& index)
+void AsyncHttpClient::notifyResponse()
 {
-    bool isHeaderEOF = false;
-
-    while((len > index) && (false == isHeaderEOF))
+    if (true == m_rsp.isPayloadTruncated())
     {
-        size_t terminatorLen = 0U;
-
-        m_rspLine += data[index];
-        ++index;
-
-        if (true == isEOL(m_rspLine, terminatorLen))
-        {
-            if (terminatorLen < m_rspLine.length())
-            {
-                m_rspLine.remove(m_rspLine.length() - terminatorLen);
-
-                LOG_INFO("Rsp. header: %s", m_rspLine.c_str());
-
-                m_rsp.addHeader(m_rspLine);
-            }
-            else
-            {
-                isHeaderEOF = true;
-            }
-
-            m_rspLine.clear();
-        }
+        LOG_WARNING("Rsp. payload truncated.");
     }
 
-    return isHeaderEOF;
-}
-
-void AsyncHttpClient::notifyResponse()
-{
     if (nullptr != m_onRspCallback)
     {
         m_onRspCallback(m_rsp);
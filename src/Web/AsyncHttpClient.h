@@ -47,6 +47,9 @@
 #include <AsyncTCP.h>
 
 #include "HttpResponse.h"
+#include "TlsConnection.h"
+
+#include <HttpRspParser.h>
 
 /******************************************************************************
  * Macros
@@ -59,11 +62,18 @@
 /**
  * Asynchronous HTTP client
  *
+ * HTTPS is supported via TLS on top of the TCP connection. The TLS session
+ * of a host is cached and resumed by the next connection, see TlsStore.
+ *
+ * Several GET requests to the same host can be pipelined, which means
+ * they are sent back-to-back on one connection and the responses are
+ * provided in the request order.
+ *
  * Used RFCs:
  * - RFC2616 (obsolete, because of RFC7230)
  * - RFC7230
  */
-class AsyncHttpClient
+class AsyncHttpClient : private IHttpRspListener
 {
 public:
 
@@ -82,6 +92,14 @@ public:
      */
     typedef std::function<void()> OnError;
 
+    /**
+     * Prototype of HTTP response callback for streamed body data.
+     */
+    typedef std::function<void(const uint8_t* data, size_t size)> OnBody;
+
+    /** Max. number of request URIs, which can be pipelined after the request of the URL. */
+    static const uint8_t MAX_PIPELINED_URIS = 3U;
+
     /**
      * Constructs a http client.
      */
@@ -108,7 +126,7 @@ public:
     void end();
 
     /**
-     * Establish TCP connection.
+     * Establish TCP connection. The hostname is resolved via the DNS cache.
      *
      * @return If the connection procedure is pending, it will return true otherwise false.
      */
@@ -120,7 +138,8 @@ public:
     void disconnect();
 
     /**
-     * Is connection established?
+     * Is connection established? A secure connection is established after
+     * the TLS handshake.
      *
      * @return If connection is established, it will return true otherwise false.
      */
@@ -147,6 +166,15 @@ public:
      */
     void setKeepAlive(bool keepAlive);
 
+    /**
+     * Is the connection kept alive after a request?
+     * Note, it will be cleared if the server closes the connection after
+     * the response.
+     *
+     * @return If the connection is kept alive, it will return true otherwise false.
+     */
+    bool isKeepAlive() const;
+
     /**
      * Add header to request header.
      *
@@ -177,6 +205,33 @@ public:
      */
     void clearPar();
 
+    /**
+     * Add a request URI, which is sent pipelined after the request of the
+     * URL by the next GET (RFC7230 6.3.2). All pipelined requests go to the
+     * same host on the same connection, which is kept alive until the last
+     * response. The responses are provided in the request order, see
+     * getResponseIndex().
+     *
+     * Pipelining requires HTTP/1.1 and is not available for requests with
+     * payload or URL encoded parameters. The user defined headers are sent
+     * with every pipelined request.
+     * Note, calling begin() will clear the pipelined URIs.
+     *
+     * @param[in] uri   Request URI, e.g. "/api/v1/getQueue"
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool addPipelinedUri(const String& uri);
+
+    /**
+     * Get the index of the provided response. The response to the request
+     * of the URL has index 0, the responses to the pipelined URIs follow in
+     * the order they were added. Only valid during the response callback.
+     *
+     * @return Response index
+     */
+    uint8_t getResponseIndex() const;
+
     /**
      * Register callback function on response reception.
      *
@@ -197,6 +252,54 @@ public:
      * @param[in] onError   Callback
      */
     void regOnError(const OnError& onError);
+
+    /**
+     * Register callback function for streamed body data.
+     * If registered, the response body is provided partly, directly from
+     * the TCP buffer, instead of collecting it in the response. The
+     * response callback is called afterwards without payload.
+     * The data is only valid during the callback.
+     *
+     * @param[in] onBody    Callback, use nullptr to collect the body again
+     */
+    void regOnBody(const OnBody& onBody);
+
+    /**
+     * Register a response header field of interest. Only the header fields
+     * of interest are kept in the response, the others are dropped during
+     * parsing. The ones required by the client itself are always registered.
+     *
+     * @param[in] name  Field name, case insensitive
+     *
+     * @return If successful registered, it will return true otherwise false.
+     */
+    bool addHeaderInterest(const char* name);
+
+    /**
+     * Set the expected response payload size, which is reserved at once if
+     * the response contains no "Content-Length", e.g. for a chunked transfer.
+     * Use 0 to reserve every chunk on its arrival.
+     *
+     * @param[in] size  Expected payload size in byte
+     */
+    void setPayloadSizeHint(size_t size);
+
+    /**
+     * Set the max. response payload size. Payload beyond it is dropped.
+     *
+     * @param[in] size  Max. payload size in byte
+     */
+    void setMaxPayloadSize(size_t size);
+
+    /**
+     * Provide the buffer for the response payload, instead of allocating it.
+     * The buffer size limits the payload size too.
+     * The buffer must exist as long as the client uses it.
+     *
+     * @param[in] buffer    Payload buffer, use nullptr to allocate again.
+     * @param[in] size      Buffer size in byte
+     */
+    void setPayloadBuffer(uint8_t* buffer, size_t size);
     
     /**
      * Send GET request to host.
@@ -226,15 +329,8 @@ public:
 
 private:
 
-    /**
-     * HTTP response parts.
-     */
-    enum ResponsePart
-    {
-        RESPONSE_PART_STATUS_LINE = 0,  /**< Response status line */
-        RESPONSE_PART_HEADER,           /**< Response headers */
-        RESPONSE_PART_BODY              /**< Response body */
-    };
+    /* The micro benchmark feeds the response parser with canned responses. */
+    friend class MicroBench;
 
     /**
      * Supported HTTP transfer codings
@@ -245,31 +341,27 @@ private:
         TRANSFER_CODING_CHUNCKED        /**< Chunked */
     };
 
-    /**
-     * Chunk body parts
-     */
-    enum ChunkBodyPart
-    {
-        CHUNK_SIZE = 0, /**< Chunk or last chunk size */
-        CHUNK_DATA,     /**< Chunk data */
-        CHUNK_DATA_END, /**< Chunk data end */
-        TRAILER         /**< Trailer */
-    };
-
     /** HTTP port */
     static const uint16_t   HTTP_PORT   = 80U;
 
     /** HTTPS port */
     static const uint16_t   HTTPS_PORT  = 443U;
 
+    /** Reserved size of the request buffer in byte, which is sufficient for typical requests without payload. */
+    static const size_t     REQUEST_RESERVED_SIZE   = 256U;
+
     AsyncClient     m_tcpClient;            /**< Asynchronous TCP client */
     OnResponse      m_onRspCallback;        /**< Callback which to call for a complete response. */
     OnClosed        m_onClosedCallback;     /**< Callback which to call for a closed connection. */
     OnError         m_onErrorCallback;      /**< Callback which to call for a connection error. */
+    OnBody          m_onBodyCallback;       /**< Callback which to call for streamed body data. */
     String          m_hostname;             /**< Server hostname */
     uint16_t        m_port;                 /**< Server port */
     String          m_base64Authorization;  /**< Authorization BASE64 encoded */
     String          m_uri;                  /**< Request URI */
+    String          m_pipelinedUris[MAX_PIPELINED_URIS];    /**< Request URIs, which are pipelined after the request URI */
+    uint8_t         m_pipelinedUriCnt;      /**< Number of pipelined request URIs */
+    uint8_t         m_rspIndex;             /**< Index of the current response in the pipeline */
     String          m_headers;              /**< Additional request headers */
     bool            m_isReqOpen;            /**< Is a request open? */
     String          m_method;               /**< Request method, e.g. GET, PUT, etc. */
@@ -279,16 +371,23 @@ private:
     String          m_urlEncodedPars;       /**< URL encoded paramters (application/x-www-form-urlencoded) */
     const uint8_t*  m_payload;              /**< Request payload */
     size_t          m_payloadSize;          /**< Request payload size in byte */
-
-    ResponsePart    m_rspPart;              /**< Current parsing part of the response */
+    String          m_request;              /**< Request buffer, which keeps its capacity between requests */
+    String          m_fixedHeaders;         /**< Rendered host, user agent, accepted encodings and authorization headers */
+    bool            m_isFixedHeadersValid;  /**< Are the rendered fixed headers valid? */
+    String          m_fixedHeadersHostname; /**< Hostname, the fixed headers are rendered for */
+    uint16_t        m_fixedHeadersPort;     /**< Port, the fixed headers are rendered for */
+    String          m_fixedHeadersAuthorization;    /**< Authorization, the fixed headers are rendered for */
+    bool            m_fixedHeadersIsHttpVer10;      /**< HTTP version, the fixed headers are rendered for */
+
+    HttpRspParser   m_parser;               /**< Response parser */
     HttpResponse    m_rsp;                  /**< Response */
-    String          m_rspLine;              /**< Single line, used for response parsing */
     TransferCoding  m_transferCoding;       /**< Transfer coding */
     size_t          m_contentLength;        /**< Content length in byte */
-    size_t          m_contentIndex;         /**< Content index */
-    size_t          m_chunkSize;            /**< Chunk size in byte */
-    size_t          m_chunkIndex;           /**< Chunk body index */
-    ChunkBodyPart   m_chunkBodyPart;        /**< Current part of chunked response */
+    bool            m_isBodyAvailable;      /**< Does the response contain a body? */
+    uint32_t        m_requestTimestamp;     /**< Timestamp in ms, when the request was sent. Used for the latency metric. */
+    size_t          m_payloadSizeHint;      /**< Expected response payload size in byte, if unknown. */
+    bool            m_isSecure;             /**< Is the connection secured by TLS? */
+    TlsConnection   m_tls;                  /**< TLS connection on top of the TCP connection */
 
     AsyncHttpClient(const AsyncHttpClient& client);
     AsyncHttpClient& operator=(const AsyncHttpClient& client);
@@ -300,6 +399,14 @@ private:
      */
     void onConnect(AsyncClient* client);
 
+    /**
+     * This method is called if the connection is established, for a secure
+     * connection after the TLS handshake.
+     *
+     * @param[in] client    TCP client
+     */
+    void onEstablished(AsyncClient* client);
+
     /**
      * This method is called by the TCP client if a connection is disconnected.
      *
@@ -315,6 +422,15 @@ private:
      */
     void onError(AsyncClient* client, int8_t error);
 
+    /**
+     * This method is called by the DNS cache, if a pending lookup of the
+     * hostname is finished.
+     *
+     * @param[in] isResolved    Is the hostname resolved?
+     * @param[in] addr          IP address, only valid if resolved
+     */
+    void onResolved(bool isResolved, const IPAddress& addr);
+
     /**
      * This method is called by the TCP client if data is received.
      *
@@ -324,6 +440,27 @@ private:
      */
     void onData(AsyncClient* client, const uint8_t* data, size_t len);
 
+    /**
+     * Handle received response data, which is already decrypted for a
+     * secure connection.
+     *
+     * @param[in] client    TCP client
+     * @param[in] data      Data stream
+     * @param[in] len       Data size in byte
+     */
+    void handleRspData(AsyncClient* client, const uint8_t* data, size_t len);
+
+    /**
+     * Write request data to the connection, encrypted for a secure connection.
+     *
+     * @param[in] data      Data
+     * @param[in] len       Data size in byte
+     * @param[in] apiFlags  TCP client write flags, not considered for a secure connection.
+     *
+     * @return Number of written bytes
+     */
+    size_t writeData(const uint8_t* data, size_t len, uint8_t apiFlags);
+
     /**
      * This method is called by the TCP client if ACK timeout happens.
      *
@@ -339,104 +476,92 @@ private:
      */
     bool sendRequest();
 
+    /**
+     * Append a request without payload headers to the request buffer.
+     *
+     * @param[in] uri           Request URI
+     * @param[in] isKeepAlive   Keep the connection alive after the response?
+     */
+    void appendRequest(const String& uri, bool isKeepAlive);
+
+    /**
+     * Render the headers, which don't change between requests to the same
+     * host, only in case one of their parts changed.
+     */
+    void updateFixedHeaders();
+
     /**
      * Clear all server related parameters.
      */
     void clear();
 
     /**
-     * Is line terminator detected?
-     *
-     * @param[in]   str String
-     * @param[out]  len Length of terminator
+     * Will be called by the response parser for the status line.
      *
-     * @return If line terminator detected, it will return true otherwise false.
+     * @param[in] line      Status line
+     * @param[in] length    Line length in byte
      */
-    bool isEOL(const String& str, size_t& len);
+    void onStatusLine(const char* line, size_t length) final;
 
     /**
-     * Handle response header.
+     * Will be called by the response parser for every header field line.
      *
-     * @return If client is fine with the resposne header, it will return true otherwise false.
+     * @param[in] line      Header field line
+     * @param[in] length    Line length in byte
      */
-    bool handleRspHeader();
+    void onHeader(const char* line, size_t length) final;
 
     /**
-     * Parse response chunked transfer chunk size.
+     * Will be called by the response parser after the last header field.
      *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * @param[out] contentLength    Content length in byte
      *
-     * @return If complete parsed, it will return true otherwise false.
+     * @return Kind of body
      */
-    bool parseChunkedResponseSize(const char* data, size_t len, size_t& index);
+    BodyType onHeaderEnd(size_t& contentLength) final;
 
     /**
-     * Parse response chunked transfer chunk data.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * Will be called by the response parser for every chunk.
      *
-     * @return If complete parsed, it will return true otherwise false.
+     * @param[in] size  Chunk size in byte
      */
-    bool parseChunkedResponseChunkData(const uint8_t* data, size_t len, size_t& index);
+    void onChunk(size_t size) final;
 
     /**
-     * Parse response chunked transfer chunk data end.
+     * Will be called by the response parser for body data.
      *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
-     *
-     * @return If complete parsed, it will return true otherwise false.
+     * @param[in] data  Body data
+     * @param[in] size  Body data size in byte
      */
-    bool parseChunkedResponseChunkDataEnd(const char* data, size_t len, size_t& index);
+    void onBody(const uint8_t* data, size_t size) final;
 
     /**
-     * Parse response chunked transfer trailer.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
-     *
-     * @return If complete parsed, it will return true otherwise false.
+     * Will be called by the response parser for a complete response.
      */
-    bool parseChunkedResponseTrailer(const char* data, size_t len, size_t& index);
+    void onComplete() final;
 
     /**
-     * Parse response chunked transfer.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * Handle response header.
      *
-     * @return If chunked transfer is finished, it will return true otherwise false.
+     * @return If client is fine with the resposne header, it will return true otherwise false.
      */
-    bool parseChunkedResponse(const uint8_t* data, size_t len, size_t& index);
+    bool handleRspHeader();
 
     /**
-     * Parse response status line.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * Reserve response payload space, if the body is not streamed.
      *
-     * @return If status line is parsed, it will return true otherwise false.
+     * @param[in] size  Size in byte, additional to the already received payload
      */
-    bool parseRspStatusLine(const char* data, size_t len, size_t& index);
+    void reservePayload(size_t size);
 
     /**
-     * Parse response header.
-     *
-     * @param[in]       data    Data stream
-     * @param[in]       len     Data size in byte
-     * @param[in,out]   index   Current data index
+     * Handle received body data. Either it is provided to the application
+     * or added to the response.
      *
-     * @return If all headers are parsed, it will return true otherwise false.
+     * @param[in] data  Body data
+     * @param[in] size  Body data size in byte
      */
-    bool parseRspHeader(const char* data, size_t len, size_t& index);
+    void handleBody(const uint8_t* data, size_t size);
 
     /**
      * This method will be called for every complete response and provides
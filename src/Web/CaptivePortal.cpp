@@ -37,7 +37,7 @@
 #include "WebConfig.h"
 #include "Settings.h"
 #include "CaptivePortalHandler.h"
-#include "FileSystem.h"
+#include "SysEvent.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -89,15 +89,10 @@ static bool                     gIsRestartRequested         = false;
 
 void CaptivePortal::init(AsyncWebServer& srv)
 {
-    /* Serve files with static content with enabled cache control.
-     * The client may cache files from filesystem for 1 hour.
+    /* The captive portal page is self-contained and served from program memory.
+     * Nothing is read from the filesystem, so the portal works even if it is
+     * corrupted or not flashed at all.
      */
-    (void)srv.serveStatic("/favicon.png", FILESYSTEM, "/favicon.png", "max-age=3600");
-    (void)srv.serveStatic("/images/", FILESYSTEM, "/images/", "max-age=3600");
-    (void)srv.serveStatic("/js/", FILESYSTEM, "/js/", "max-age=3600");
-    (void)srv.serveStatic("/style/", FILESYSTEM, "/style/", "max-age=3600");
-
-    /* Add the captive portal request handler at last, because it will handle everything. */
     (void)srv.addHandler(&gCaptivePortalReqHandler).setFilter(ON_AP_FILTER);
 
     return;
@@ -118,4 +113,5 @@ bool CaptivePortal::isRestartRequested()
 static void reqRestart()
 {
     gIsRestartRequested = true;
+    SysEvent::getInstance().post(SysEvent::ID_UPDATE);
 }
@@ -36,7 +36,10 @@
 #include "Settings.h"
 #include "WebConfig.h"
 #include "HttpStatus.h"
-#include "FileSystem.h"
+#include "CaptivePortalPage.h"
+
+#include <Util.h>
+#include <ArduinoJson.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -58,6 +61,25 @@
  * Local Variables
  *****************************************************************************/
 
+/**
+ * URLs, which the operating systems request to detect a captive portal.
+ */
+static const char*  CONNECTIVITY_PROBE_URLS[] =
+{
+    "/generate_204",                /* Android */
+    "/gen_204",                     /* Android */
+    "/hotspot-detect.html",         /* Apple */
+    "/library/test/success.html",   /* Apple */
+    "/connecttest.txt",             /* Windows */
+    "/ncsi.txt",                    /* Windows */
+    "/redirect",                    /* Windows */
+    "/canonical.html",              /* Firefox */
+    "/success.txt"                  /* Firefox */
+};
+
+/** URL of the wifi settings, requested by the captive portal page. */
+static const char*  URL_SETTINGS    = "/cp/settings";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -69,6 +91,15 @@ void CaptivePortalHandler::handleRequest(AsyncWebServerRequest* request)
         return;
     }
 
+    /* Connectivity probes are answered without authentication and without
+     * body, which lets the operating system show the portal immediately.
+     */
+    if (true == isConnectivityProbe(request))
+    {
+        sendRedirectToPortal(request);
+        return;
+    }
+
     /* Force authentication! */
     if (false == request->authenticate(WebConfig::WEB_LOGIN_USER, WebConfig::WEB_LOGIN_PASSWORD))
     {
@@ -124,7 +155,14 @@ void CaptivePortalHandler::handleRequest(AsyncWebServerRequest* request)
     }
     else if (HTTP_GET == request->method())
     {
-        request->send(FILESYSTEM, "/cp/captivePortal.html", "text/html", false, captivePortalPageProcessor);
+        if (request->url() == URL_SETTINGS)
+        {
+            sendSettings(request);
+        }
+        else
+        {
+            sendPage(request);
+        }
     }
     else
     {
@@ -140,32 +178,82 @@ void CaptivePortalHandler::handleRequest(AsyncWebServerRequest* request)
  * Private Methods
  *****************************************************************************/
 
-String CaptivePortalHandler::captivePortalPageProcessor(const String& var)
+bool CaptivePortalHandler::isConnectivityProbe(AsyncWebServerRequest* request)
 {
-    String  result = var;
+    bool    isProbe = false;
+    uint8_t index   = 0U;
 
-    if (var == "SSID")
+    while((false == isProbe) && (UTIL_ARRAY_NUM(CONNECTIVITY_PROBE_URLS) > index))
     {
-        if (true == Settings::getInstance().open(true))
+        if (request->url() == CONNECTIVITY_PROBE_URLS[index])
         {
-            result = Settings::getInstance().getWifiSSID().getValue();
-            Settings::getInstance().close();
+            isProbe = true;
         }
+
+        ++index;
     }
-    else if (var == "PASSPHRASE")
+
+    return isProbe;
+}
+
+void CaptivePortalHandler::sendRedirectToPortal(AsyncWebServerRequest* request)
+{
+    AsyncWebServerResponse* response = request->beginResponse(HttpStatus::STATUS_CODE_FOUND);
+
+    if (nullptr == response)
     {
-        if (true == Settings::getInstance().open(true))
-        {
-            result = Settings::getInstance().getWifiPassphrase().getValue();
-            Settings::getInstance().close();
-        }
+        request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+    }
+    else
+    {
+        String location = "http://";
+
+        location += request->client()->localIP().toString();
+        location += "/";
+
+        response->addHeader("Location", location);
+        response->addHeader("Cache-Control", "no-store");
+        request->send(response);
+    }
+}
+
+void CaptivePortalHandler::sendPage(AsyncWebServerRequest* request)
+{
+    AsyncWebServerResponse* response = request->beginResponse_P(HttpStatus::STATUS_CODE_OK, "text/html", CAPTIVE_PORTAL_PAGE, CAPTIVE_PORTAL_PAGE_SIZE);
+
+    if (nullptr == response)
+    {
+        request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+    }
+    else
+    {
+        response->addHeader("Content-Encoding", "gzip");
+        request->send(response);
+    }
+}
+
+void CaptivePortalHandler::sendSettings(AsyncWebServerRequest* request)
+{
+    const size_t        JSON_DOC_SIZE   = 256U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    String              content;
+    Settings&           settings        = Settings::getInstance();
+
+    if (true == settings.open(true))
+    {
+        jsonDoc["ssid"]         = settings.getWifiSSID().getValue();
+        jsonDoc["passphrase"]   = settings.getWifiPassphrase().getValue();
+
+        settings.close();
     }
     else
     {
-        ;
+        jsonDoc["ssid"]         = "";
+        jsonDoc["passphrase"]   = "";
     }
 
-    return result;
+    (void)serializeJson(jsonDoc, content);
+    request->send(HttpStatus::STATUS_CODE_OK, "application/json", content);
 }
 
 /******************************************************************************
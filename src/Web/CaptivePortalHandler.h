@@ -123,12 +123,34 @@ private:
     CaptivePortalHandler& operator=(const CaptivePortalHandler& handler);
 
     /**
-     * Processor for index page template.
-     * It is responsible for the data binding.
+     * Is the request a connectivity probe of the operating system?
      *
-     * @param[in] var   Name of variable in the template
+     * @param[in] request   Web request
+     *
+     * @return If it is a connectivity probe, it will return true otherwise false.
+     */
+    static bool isConnectivityProbe(AsyncWebServerRequest* request);
+
+    /**
+     * Redirect to the captive portal page.
+     *
+     * @param[in] request   Web request
+     */
+    static void sendRedirectToPortal(AsyncWebServerRequest* request);
+
+    /**
+     * Send the captive portal page from program memory.
+     *
+     * @param[in] request   Web request
+     */
+    static void sendPage(AsyncWebServerRequest* request);
+
+    /**
+     * Send the current wifi settings, which the captive portal page shows.
+     *
+     * @param[in] request   Web request
      */
-    static String captivePortalPageProcessor(const String& var);
+    static void sendSettings(AsyncWebServerRequest* request);
 };
 
 /******************************************************************************
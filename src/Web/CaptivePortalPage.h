@@ -0,0 +1,79 @@
+/* Generated by embedData.py from embedded/captivePortal.html, don't edit. */
+
+#ifndef __CAPTIVE_PORTAL_PAGE_H__
+#define __CAPTIVE_PORTAL_PAGE_H__
+
+#include <stdint.h>
+#include <pgmspace.h>
+
+/** Size of CAPTIVE_PORTAL_PAGE in byte. */
+static const size_t CAPTIVE_PORTAL_PAGE_SIZE = 1005U;
+
+/** captivePortal.html, gzip compressed. */
+static const uint8_t CAPTIVE_PORTAL_PAGE[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x56, 0x6d, 0x6f, 0xdb, 0x36,
+    0x10, 0xfe, 0xee, 0x5f, 0x71, 0xd5, 0xb0, 0x42, 0x06, 0x22, 0x4b, 0x76, 0x9a, 0x25, 0xb1, 0x25,
+    0x63, 0x5b, 0x9b, 0x6d, 0x01, 0x5a, 0x2c, 0x68, 0x0a, 0x2c, 0xc0, 0xb0, 0x0f, 0x94, 0x44, 0xd9,
+    0x5c, 0x68, 0x52, 0x23, 0x29, 0x3b, 0x5e, 0x91, 0xff, 0xbe, 0xa3, 0x24, 0xdb, 0x92, 0x22, 0x07,
+    0x29, 0x82, 0xf1, 0x83, 0xcd, 0x97, 0xe3, 0x73, 0x77, 0x0f, 0x9f, 0x23, 0x15, 0xbe, 0x49, 0x65,
+    0x62, 0xb6, 0x39, 0x85, 0xa5, 0x59, 0xf1, 0xf9, 0x20, 0xb4, 0x7f, 0xc0, 0x89, 0x58, 0x44, 0x0e,
+    0x15, 0xce, 0x7c, 0x00, 0xd8, 0xc2, 0x25, 0x25, 0x69, 0xd5, 0x2d, 0x87, 0x2b, 0x6a, 0x08, 0x24,
+    0x4b, 0xa2, 0x34, 0x35, 0x91, 0x53, 0x98, 0xcc, 0xbb, 0x70, 0xba, 0xcb, 0x82, 0xac, 0x68, 0xe4,
+    0xac, 0x19, 0xdd, 0xe4, 0x52, 0x19, 0x07, 0x12, 0x29, 0x0c, 0x15, 0x68, 0xbe, 0x61, 0xa9, 0x59,
+    0x46, 0x29, 0x5d, 0xb3, 0x84, 0x7a, 0xe5, 0xe0, 0x04, 0x98, 0x60, 0x86, 0x11, 0xee, 0xe9, 0x84,
+    0x70, 0x1a, 0x8d, 0x9b, 0x60, 0x86, 0x19, 0x4e, 0xe7, 0x37, 0xd7, 0x77, 0x57, 0x1f, 0xaf, 0xef,
+    0x42, 0xbf, 0x1a, 0x1e, 0x96, 0xb5, 0xd9, 0x36, 0xc7, 0xb6, 0xc5, 0x32, 0xdd, 0xc2, 0x57, 0x58,
+    0x11, 0xb5, 0x60, 0x62, 0x0a, 0xc1, 0x0c, 0x32, 0xf4, 0xed, 0x65, 0x64, 0xc5, 0xf8, 0x76, 0x0a,
+    0x9a, 0x08, 0xed, 0x69, 0xaa, 0x58, 0x36, 0x83, 0x98, 0x24, 0xf7, 0x0b, 0x25, 0x0b, 0x91, 0x4e,
+    0xe1, 0xbb, 0xec, 0x22, 0xbb, 0xcc, 0xc8, 0x0c, 0x23, 0xe5, 0x52, 0xe1, 0x78, 0x32, 0x9e, 0x9c,
+    0x4d, 0x2e, 0x67, 0xf0, 0xd8, 0x42, 0xb7, 0x54, 0x50, 0x85, 0xf8, 0x39, 0x49, 0x53, 0x26, 0x16,
+    0xe8, 0x60, 0x74, 0x7e, 0xa6, 0xe8, 0x0a, 0xc6, 0xf8, 0xd3, 0x81, 0x3c, 0x7d, 0x77, 0x4a, 0xde,
+    0x05, 0x07, 0xc8, 0x2c, 0xcb, 0xea, 0x68, 0x36, 0x94, 0x2d, 0x96, 0x66, 0x8a, 0xc1, 0xf2, 0x74,
+    0x06, 0x9c, 0x1a, 0x43, 0x95, 0xa7, 0x73, 0x92, 0xd4, 0x90, 0x93, 0x12, 0xac, 0xed, 0x7a, 0x45,
+    0x98, 0x28, 0x13, 0x7b, 0xa8, 0x78, 0x9b, 0xc2, 0x69, 0x50, 0x9a, 0xed, 0x53, 0x05, 0x52, 0x18,
+    0x39, 0x3b, 0x84, 0x36, 0xee, 0x41, 0xe1, 0x24, 0xa6, 0x1c, 0x61, 0x52, 0xa6, 0x73, 0x4e, 0x90,
+    0x90, 0x98, 0xcb, 0xe4, 0x7e, 0x07, 0xe2, 0x19, 0x99, 0xef, 0x53, 0xea, 0x6e, 0x65, 0x22, 0x2f,
+    0x0c, 0x6e, 0x8d, 0xe5, 0x83, 0xa7, 0xd9, 0xbf, 0xa5, 0x8b, 0x58, 0x2a, 0xe4, 0xc3, 0xc3, 0xa9,
+    0x19, 0xd4, 0x51, 0x8d, 0x83, 0xe0, 0xfb, 0x2e, 0xde, 0xa4, 0xc2, 0x6b, 0x90, 0x56, 0x4d, 0x94,
+    0x64, 0x20, 0x16, 0xed, 0x0f, 0xb6, 0xf4, 0xf8, 0xa7, 0xd5, 0x67, 0x14, 0x17, 0xc6, 0x48, 0xf1,
+    0xd7, 0xfe, 0x64, 0x2b, 0xe4, 0x9a, 0xf4, 0x32, 0x88, 0xf2, 0xac, 0xeb, 0x78, 0x14, 0x49, 0x59,
+    0xa1, 0x1b, 0x9e, 0x5b, 0xe7, 0x12, 0x04, 0xe7, 0xb1, 0x3d, 0x8a, 0xd6, 0xb9, 0xb4, 0x3d, 0x67,
+    0x52, 0x9a, 0xf6, 0x39, 0x57, 0xae, 0x0c, 0x7d, 0x30, 0x1e, 0xe1, 0x6c, 0x81, 0x7c, 0x27, 0x28,
+    0x68, 0xaa, 0x0e, 0x30, 0x3f, 0x24, 0xe7, 0x67, 0xe7, 0x69, 0x2b, 0xa9, 0x60, 0x74, 0xd1, 0x49,
+    0x2b, 0xf4, 0x1b, 0x9a, 0x0d, 0xfd, 0x43, 0x69, 0x85, 0x56, 0xb8, 0x0d, 0x69, 0x57, 0x4a, 0x3b,
+    0x48, 0xbf, 0x1e, 0x37, 0xea, 0x0c, 0xf5, 0xd0, 0x96, 0x7e, 0xb8, 0x1c, 0xcf, 0xdf, 0x93, 0xdc,
+    0xb0, 0x35, 0x85, 0x1b, 0x2c, 0x3b, 0xc2, 0x71, 0xdb, 0xb8, 0x6b, 0x33, 0x99, 0xff, 0xc1, 0x32,
+    0x06, 0x82, 0x9a, 0x8d, 0x54, 0xf7, 0xb6, 0x32, 0x33, 0xb6, 0x28, 0x14, 0x31, 0x4c, 0x0a, 0xb4,
+    0x9f, 0x74, 0xec, 0x2b, 0xc1, 0x64, 0x52, 0x45, 0x8e, 0xd6, 0x2c, 0x75, 0xe6, 0xb7, 0xb7, 0xd7,
+    0x1f, 0xa6, 0xa1, 0x5f, 0xce, 0x77, 0x6c, 0x2b, 0x85, 0x94, 0xe7, 0xe5, 0x58, 0xa6, 0x1c, 0x60,
+    0x69, 0xbd, 0xad, 0xbe, 0x11, 0xaa, 0xbe, 0x7f, 0xdc, 0x47, 0x4e, 0xb4, 0xce, 0x97, 0x8a, 0x68,
+    0xea, 0xcc, 0x6f, 0xf6, 0xfd, 0x17, 0xf8, 0xb3, 0x1b, 0x31, 0xa1, 0xb4, 0xf2, 0xd9, 0x80, 0xa9,
+    0x3d, 0x37, 0x67, 0xfc, 0x67, 0x70, 0x2a, 0xa1, 0x39, 0xb0, 0x26, 0xbc, 0xc0, 0xe1, 0xad, 0x91,
+    0x8a, 0xb6, 0x49, 0x72, 0x40, 0x8a, 0x84, 0xb3, 0xe4, 0x1e, 0xd3, 0xb1, 0xab, 0xee, 0xf0, 0x29,
+    0x22, 0xd2, 0xf8, 0x99, 0x6a, 0x43, 0x94, 0xe9, 0xa1, 0xf4, 0x19, 0x77, 0xf5, 0x26, 0x10, 0x72,
+    0xd3, 0x70, 0xa3, 0xaa, 0xd9, 0x8e, 0xa3, 0xd0, 0x6f, 0x4b, 0x20, 0xac, 0x44, 0x3b, 0x77, 0xdf,
+    0x0f, 0x61, 0x12, 0x8c, 0x2f, 0xc1, 0xc3, 0xbf, 0xc9, 0x18, 0xe2, 0x2d, 0xfc, 0x24, 0x52, 0x45,
+    0x89, 0x86, 0x4f, 0x54, 0xdd, 0x73, 0x0a, 0xee, 0x86, 0xc6, 0x3f, 0xc6, 0xe8, 0xd0, 0x23, 0x22,
+    0x65, 0xa3, 0x94, 0x0e, 0x43, 0xbf, 0xde, 0x3c, 0x68, 0x5c, 0xae, 0x89, 0x62, 0xb9, 0x69, 0xc7,
+    0x9e, 0x15, 0x22, 0xb1, 0x1c, 0x40, 0x2e, 0xb5, 0x71, 0xf1, 0xc4, 0x56, 0x1f, 0x88, 0x21, 0x43,
+    0xf8, 0xda, 0xb2, 0xb2, 0x6d, 0x4d, 0x14, 0x3c, 0x2c, 0x15, 0x44, 0xa8, 0xb4, 0x0d, 0xdc, 0x7d,
+    0xfa, 0xf8, 0x9b, 0x31, 0xf9, 0x67, 0xfa, 0x4f, 0x81, 0xb9, 0xb8, 0xc3, 0xd9, 0xe0, 0xc9, 0x06,
+    0x34, 0x1e, 0xc9, 0x9c, 0x0a, 0xd7, 0xb9, 0xf9, 0xfd, 0xf6, 0x8b, 0x73, 0x02, 0x8e, 0xef, 0xa0,
+    0x5d, 0xaf, 0x99, 0xe0, 0x92, 0xa4, 0x08, 0xbd, 0x0b, 0xc7, 0xed, 0x8b, 0xc0, 0x36, 0x7c, 0x50,
+    0x90, 0x37, 0xbb, 0x07, 0x39, 0xcc, 0xa5, 0xd0, 0xb4, 0x07, 0xf2, 0xb1, 0xdf, 0x8b, 0xa6, 0x22,
+    0x3d, 0xa4, 0xd8, 0xb6, 0x79, 0x1c, 0xf4, 0xd3, 0x52, 0x0b, 0xe2, 0x08, 0x1f, 0x3b, 0xb0, 0x9a,
+    0x94, 0x5f, 0xea, 0x61, 0x2f, 0x1d, 0x3b, 0xdb, 0x11, 0xc9, 0x73, 0x1b, 0x48, 0x55, 0x3a, 0x27,
+    0x80, 0x0f, 0x76, 0xb1, 0xc2, 0x9b, 0x67, 0xb4, 0xa0, 0xe6, 0x8a, 0x53, 0xdb, 0xfd, 0x79, 0x7b,
+    0xbd, 0x5b, 0x1f, 0x8e, 0x4a, 0x21, 0xf5, 0x24, 0xf9, 0x04, 0xaf, 0x51, 0x10, 0xcf, 0xa0, 0x36,
+    0xac, 0x8e, 0x63, 0xb7, 0xc5, 0xf0, 0x32, 0xa6, 0xf6, 0x9a, 0xfe, 0x3f, 0xb8, 0xaa, 0xc1, 0xad,
+    0x88, 0x6c, 0x25, 0xbd, 0x2e, 0x64, 0xf7, 0x59, 0x95, 0xbd, 0x42, 0xe7, 0xbf, 0x5e, 0x55, 0x32,
+    0x4f, 0x72, 0x1f, 0x3f, 0xa5, 0x0c, 0x3e, 0x33, 0xfa, 0x98, 0xe2, 0x77, 0xea, 0xfd, 0x62, 0xbf,
+    0xd5, 0x22, 0x70, 0xfe, 0xd6, 0x78, 0x69, 0xbc, 0xb6, 0x38, 0x58, 0x06, 0xae, 0x3b, 0x09, 0x02,
+    0x88, 0xa2, 0xa8, 0x52, 0xbc, 0x21, 0xa6, 0xd0, 0x43, 0x78, 0xfb, 0x16, 0x5c, 0x51, 0x70, 0x0e,
+    0x6f, 0xea, 0x85, 0x7d, 0xf1, 0x1c, 0x83, 0xb2, 0xed, 0x45, 0xca, 0x84, 0x36, 0xe0, 0xc8, 0xae,
+    0xcd, 0xbe, 0x1d, 0xf2, 0xa9, 0x2c, 0xbb, 0xc0, 0x07, 0x8b, 0x7e, 0xf8, 0xc7, 0x6f, 0xba, 0x06,
+    0xba, 0x0a, 0x19, 0x36, 0x67, 0xf0, 0x4d, 0x6f, 0x5c, 0x95, 0xa1, 0x5f, 0xbd, 0xe4, 0x78, 0xf1,
+    0x97, 0xdf, 0xd4, 0xff, 0x01, 0x59, 0x44, 0xab, 0xc2, 0x64, 0x0b, 0x00, 0x00,
+};
+
+#endif  /* __CAPTIVE_PORTAL_PAGE_H__ */
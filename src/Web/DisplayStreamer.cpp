@@ -0,0 +1,393 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display content streamer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DisplayStreamer.h"
+
+#include <Color.h>
+#include <Logging.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool DisplayStreamer::subscribe(uint32_t clientId, PixelFormat format, uint8_t fps)
+{
+    bool    status  = false;
+    uint8_t index   = 0U;
+    uint8_t freeIdx = MAX_SUBSCRIBERS;
+    uint8_t usedIdx = MAX_SUBSCRIBERS;
+
+    if ((nullptr == m_xMutex) ||
+        (MIN_FPS > fps) ||
+        (MAX_FPS < fps))
+    {
+        return false;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        if (false == m_subscribers[index].isUsed)
+        {
+            if (MAX_SUBSCRIBERS == freeIdx)
+            {
+                freeIdx = index;
+            }
+        }
+        else if (clientId == m_subscribers[index].clientId)
+        {
+            usedIdx = index;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    /* Client not subscribed yet? */
+    if ((MAX_SUBSCRIBERS == usedIdx) &&
+        (MAX_SUBSCRIBERS > freeIdx))
+    {
+        usedIdx = freeIdx;
+
+        /* The display manager shall publish every changed frame. */
+        DisplayMgr::getInstance().subscribeFrame();
+    }
+
+    if (MAX_SUBSCRIBERS > usedIdx)
+    {
+        Subscriber& subscriber = m_subscribers[usedIdx];
+
+        subscriber.isUsed               = true;
+        subscriber.clientId             = clientId;
+        subscriber.format               = format;
+        subscriber.period               = 1000U / fps;
+        subscriber.timestamp            = millis() - subscriber.period;
+        subscriber.isKeyFrameRequired   = true;
+        subscriber.slotId               = DisplayMgr::SLOT_ID_INVALID;
+
+        status = true;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return status;
+}
+
+void DisplayStreamer::unsubscribe(uint32_t clientId)
+{
+    uint8_t index = 0U;
+
+    if (nullptr == m_xMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        if ((true == m_subscribers[index].isUsed) &&
+            (clientId == m_subscribers[index].clientId))
+        {
+            m_subscribers[index].isUsed = false;
+            DisplayMgr::getInstance().unsubscribeFrame();
+        }
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+void DisplayStreamer::process(AsyncWebSocket& server)
+{
+    uint8_t     index       = 0U;
+    bool        isFrameRead = false;
+    uint8_t     slotId      = DisplayMgr::SLOT_ID_INVALID;
+    uint32_t    timestamp   = millis();
+
+    if (nullptr == m_xMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        Subscriber& subscriber = m_subscribers[index];
+
+        if ((true == subscriber.isUsed) &&
+            (subscriber.period <= (timestamp - subscriber.timestamp)))
+        {
+            AsyncWebSocketClient* client = server.client(subscriber.clientId);
+
+            /* Client gone in the meantime? */
+            if (nullptr == client)
+            {
+                subscriber.isUsed = false;
+                DisplayMgr::getInstance().unsubscribeFrame();
+            }
+            /* If the client can't keep up, skip the frame. The next delta
+             * frame will contain the changes, because it is relative to the
+             * last sent frame.
+             */
+            else if (true == client->queueIsFull())
+            {
+                ;
+            }
+            else
+            {
+                size_t frameSize = 0U;
+
+                /* Read the display content only once for all subscribers. */
+                if (false == isFrameRead)
+                {
+                    DisplayMgr::getInstance().getFBCopy(m_frame, UTIL_ARRAY_NUM(m_frame), &slotId);
+                    isFrameRead = true;
+                }
+
+                frameSize = encode(subscriber, slotId);
+
+                if (0U < frameSize)
+                {
+                    client->binary(m_buffer, frameSize);
+
+                    memcpy(subscriber.frame, m_frame, sizeof(subscriber.frame));
+                    subscriber.slotId               = slotId;
+                    subscriber.isKeyFrameRequired   = false;
+                }
+
+                subscriber.timestamp = timestamp;
+            }
+        }
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+DisplayStreamer::DisplayStreamer() :
+    m_xMutex(xSemaphoreCreateMutex()),
+    m_subscribers(),
+    m_frame(),
+    m_buffer()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        m_subscribers[index].isUsed = false;
+    }
+
+    if (nullptr == m_xMutex)
+    {
+        LOG_ERROR("Couldn't create display streamer mutex.");
+    }
+}
+
+DisplayStreamer::~DisplayStreamer()
+{
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+size_t DisplayStreamer::encode(const Subscriber& subscriber, uint8_t slotId)
+{
+    const size_t    BYTES_PER_PIXEL = getBytesPerPixel(subscriber.format);
+    const size_t    KEY_FRAME_SIZE  = HEADER_SIZE + RUN_HEADER_SIZE + (BYTES_PER_PIXEL * DisplayMgr::FRAME_PIXEL_COUNT);
+    size_t          offset          = HEADER_SIZE;
+    bool            isKeyFrame      = subscriber.isKeyFrameRequired;
+
+    /* A slot change is shown as key frame, because nearly every pixel changes. */
+    if (subscriber.slotId != slotId)
+    {
+        isKeyFrame = true;
+    }
+
+    if (false == isKeyFrame)
+    {
+        uint16_t index = 0U;
+
+        while((DisplayMgr::FRAME_PIXEL_COUNT > index) && (false == isKeyFrame))
+        {
+            /* Skip unchanged pixels. */
+            if (subscriber.frame[index] == m_frame[index])
+            {
+                ++index;
+            }
+            else
+            {
+                const uint16_t  BEGIN   = index;
+                uint16_t        end     = index + 1U;
+
+                ++index;
+
+                /* Gaps of unchanged pixels, which are cheaper to send than
+                 * a new run header, are taken over into the run.
+                 */
+                while(DisplayMgr::FRAME_PIXEL_COUNT > index)
+                {
+                    if (subscriber.frame[index] != m_frame[index])
+                    {
+                        ++index;
+                        end = index;
+                    }
+                    else if (((index - end + 1U) * BYTES_PER_PIXEL) <= RUN_HEADER_SIZE)
+                    {
+                        ++index;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+
+                /* If the delta frame gets larger than a key frame, send a key frame. */
+                if (KEY_FRAME_SIZE < (offset + RUN_HEADER_SIZE + ((end - BEGIN) * BYTES_PER_PIXEL)))
+                {
+                    isKeyFrame = true;
+                }
+                else
+                {
+                    offset = appendRun(subscriber.format, offset, BEGIN, end);
+                }
+            }
+        }
+
+        /* Nothing changed? */
+        if ((false == isKeyFrame) &&
+            (HEADER_SIZE == offset))
+        {
+            offset = 0U;
+        }
+    }
+
+    if (true == isKeyFrame)
+    {
+        offset = appendRun(subscriber.format, HEADER_SIZE, 0U, DisplayMgr::FRAME_PIXEL_COUNT);
+    }
+
+    if (0U < offset)
+    {
+        m_buffer[0] = static_cast<uint8_t>((true == isKeyFrame) ? FRAME_TYPE_KEY : FRAME_TYPE_DELTA);
+        m_buffer[1] = static_cast<uint8_t>(subscriber.format);
+        m_buffer[2] = slotId;
+    }
+
+    return offset;
+}
+
+size_t DisplayStreamer::appendRun(PixelFormat format, size_t offset, uint16_t begin, uint16_t end)
+{
+    const uint16_t  COUNT   = end - begin;
+    uint16_t        index   = 0U;
+
+    m_buffer[offset + 0U] = static_cast<uint8_t>((begin >> 0U) & 0xffU);
+    m_buffer[offset + 1U] = static_cast<uint8_t>((begin >> 8U) & 0xffU);
+    m_buffer[offset + 2U] = static_cast<uint8_t>((COUNT >> 0U) & 0xffU);
+    m_buffer[offset + 3U] = static_cast<uint8_t>((COUNT >> 8U) & 0xffU);
+    offset += RUN_HEADER_SIZE;
+
+    for(index = begin; index < end; ++index)
+    {
+        const uint32_t COLOR = m_frame[index];
+
+        if (PIXEL_FORMAT_RGB565 == format)
+        {
+            const uint16_t COLOR565 = Color(COLOR).to565();
+
+            m_buffer[offset + 0U] = static_cast<uint8_t>((COLOR565 >> 0U) & 0xffU);
+            m_buffer[offset + 1U] = static_cast<uint8_t>((COLOR565 >> 8U) & 0xffU);
+            offset += 2U;
+        }
+        else
+        {
+            m_buffer[offset + 0U] = ColorDef::getRed(COLOR);
+            m_buffer[offset + 1U] = ColorDef::getGreen(COLOR);
+            m_buffer[offset + 2U] = ColorDef::getBlue(COLOR);
+            offset += 3U;
+        }
+    }
+
+    return offset;
+}
+
+size_t DisplayStreamer::getBytesPerPixel(PixelFormat format)
+{
+    return (PIXEL_FORMAT_RGB565 == format) ? 2U : 3U;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
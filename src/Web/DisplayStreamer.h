@@ -0,0 +1,227 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display content streamer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __DISPLAYSTREAMER_H__
+#define __DISPLAYSTREAMER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+
+#include "DisplayMgr.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The display streamer pushes the display content as binary websocket frames
+ * to every subscribed client. Only the changed pixel runs relative to the
+ * frame, which was sent to the client before, are sent.
+ *
+ * Binary frame layout:
+ * - Byte 0: Frame type (FRAME_TYPE_KEY or FRAME_TYPE_DELTA)
+ * - Byte 1: Pixel format (PIXEL_FORMAT_RGB888 or PIXEL_FORMAT_RGB565)
+ * - Byte 2: Id of the slot, whose content is shown.
+ * - Followed by the pixel runs, until the end of the frame:
+ *   - Index of the first pixel in the run (uint16_t, little endian), row by row.
+ *   - Number of pixels in the run (uint16_t, little endian).
+ *   - The pixel colors: RGB888 as red, green and blue byte, RGB565 as uint16_t in little endian.
+ */
+class DisplayStreamer
+{
+public:
+
+    /** Pixel format on the wire */
+    enum PixelFormat
+    {
+        PIXEL_FORMAT_RGB888 = 0,    /**< 3 byte per pixel: red, green, blue */
+        PIXEL_FORMAT_RGB565 = 1     /**< 2 byte per pixel */
+    };
+
+    /** Frame types */
+    enum FrameType
+    {
+        FRAME_TYPE_KEY      = 0,    /**< Frame contains all pixels. */
+        FRAME_TYPE_DELTA    = 1     /**< Frame contains only the changed pixels. */
+    };
+
+    /**
+     * Get display streamer instance.
+     *
+     * @return Display streamer instance
+     */
+    static DisplayStreamer& getInstance()
+    {
+        static DisplayStreamer instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Subscribe a websocket client to the display content stream.
+     * If the client is already subscribed, its parameters will be updated and
+     * it will get a key frame next.
+     *
+     * @param[in] clientId  Websocket client id
+     * @param[in] format    Pixel format
+     * @param[in] fps       Max. frame rate in frames per second [MIN_FPS; MAX_FPS]
+     *
+     * @return If successful subscribed, it will return true otherwise false.
+     */
+    bool subscribe(uint32_t clientId, PixelFormat format, uint8_t fps);
+
+    /**
+     * Unsubscribe a websocket client from the display content stream.
+     * If the client is not subscribed, nothing happens.
+     *
+     * @param[in] clientId  Websocket client id
+     */
+    void unsubscribe(uint32_t clientId);
+
+    /**
+     * Send the display content to all subscribed clients, whose frame period
+     * elapsed. Call this periodically.
+     *
+     * @param[in] server    Websocket server
+     */
+    void process(AsyncWebSocket& server);
+
+    /** Max. number of subscribed clients. */
+    static const uint8_t    MAX_SUBSCRIBERS = 4U;
+
+    /** Min. frame rate in frames per second. */
+    static const uint8_t    MIN_FPS         = 1U;
+
+    /** Max. frame rate in frames per second. */
+    static const uint8_t    MAX_FPS         = 25U;
+
+    /** Default frame rate in frames per second. */
+    static const uint8_t    DEFAULT_FPS     = 10U;
+
+private:
+
+    /** Subscribed client */
+    struct Subscriber
+    {
+        bool        isUsed;                                         /**< Is subscriber entry used? */
+        uint32_t    clientId;                                       /**< Websocket client id */
+        PixelFormat format;                                         /**< Pixel format */
+        uint32_t    period;                                         /**< Frame period in ms */
+        uint32_t    timestamp;                                      /**< Timestamp in ms of the last sent frame */
+        bool        isKeyFrameRequired;                             /**< Shall the next frame be a key frame? */
+        uint8_t     slotId;                                         /**< Slot id of the last sent frame */
+        uint32_t    frame[DisplayMgr::FRAME_PIXEL_COUNT];           /**< Last sent frame */
+    };
+
+    /** Size of the frame header in bytes. */
+    static const size_t     HEADER_SIZE     = 3U;
+
+    /** Size of the run header in bytes. */
+    static const size_t     RUN_HEADER_SIZE = 4U;
+
+    /** Max. size of a binary frame in bytes, which is the size of a RGB888 key frame. */
+    static const size_t     MAX_FRAME_SIZE  = HEADER_SIZE + RUN_HEADER_SIZE + (3U * DisplayMgr::FRAME_PIXEL_COUNT);
+
+    SemaphoreHandle_t   m_xMutex;                               /**< Mutex to protect the subscribers. */
+    Subscriber          m_subscribers[MAX_SUBSCRIBERS];         /**< Subscribed clients */
+    uint32_t            m_frame[DisplayMgr::FRAME_PIXEL_COUNT]; /**< Current display content */
+    uint8_t             m_buffer[MAX_FRAME_SIZE];               /**< Binary frame buffer */
+
+    /**
+     * Constructs the display streamer.
+     */
+    DisplayStreamer();
+
+    /**
+     * Destroys the display streamer.
+     */
+    ~DisplayStreamer();
+
+    /* Prevent copying */
+    DisplayStreamer(const DisplayStreamer& streamer);
+    DisplayStreamer& operator=(const DisplayStreamer& streamer);
+
+    /**
+     * Encode the current display content for the given subscriber into the
+     * binary frame buffer. If it is not worth to send only the changed pixels,
+     * a key frame is encoded.
+     *
+     * @param[in] subscriber    Subscriber
+     * @param[in] slotId        Id of the slot, whose content is shown.
+     *
+     * @return Size of the binary frame in bytes. If nothing changed, it will be 0.
+     */
+    size_t encode(const Subscriber& subscriber, uint8_t slotId);
+
+    /**
+     * Append a pixel run to the binary frame buffer.
+     *
+     * @param[in] format    Pixel format
+     * @param[in] offset    Offset in the binary frame buffer, where to append the run.
+     * @param[in] begin     Index of the first pixel in the run
+     * @param[in] end       Index after the last pixel in the run
+     *
+     * @return Offset in the binary frame buffer after the run.
+     */
+    size_t appendRun(PixelFormat format, size_t offset, uint16_t begin, uint16_t end);
+
+    /**
+     * Get number of bytes per pixel on the wire.
+     *
+     * @param[in] format    Pixel format
+     *
+     * @return Number of bytes per pixel
+     */
+    static size_t getBytesPerPixel(PixelFormat format);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DISPLAYSTREAMER_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,601 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display synchronization
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DisplaySync.h"
+#include "Settings.h"
+
+#include <Logging.h>
+#include <TextWidget.h>
+#include <esp_timer.h>
+#include <lwip/sockets.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize constants */
+const char* DisplaySync::MULTICAST_ADDR = "239.255.55.68";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void DisplaySync::begin()
+{
+    Settings&   settings    = Settings::getInstance();
+    uint8_t     role        = ROLE_OFF;
+    uint16_t    spanWidth   = 0U;
+    uint16_t    spanOffset  = 0U;
+
+    end();
+
+    if (true == settings.open(true))
+    {
+        role        = settings.getSyncRole().getValue();
+        m_group     = settings.getSyncGroup().getValue();
+        spanWidth   = static_cast<uint16_t>(settings.getSyncSpanWidth().getValue());
+        spanOffset  = static_cast<uint16_t>(settings.getSyncSpanOffset().getValue());
+
+        settings.close();
+    }
+
+    if ((ROLE_MASTER == role) ||
+        (ROLE_SLAVE == role))
+    {
+        if (false == openSocket())
+        {
+            LOG_ERROR("Couldn't open display sync socket.");
+        }
+        else
+        {
+            BaseType_t osRet = pdFAIL;
+
+            (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+            m_role              = static_cast<Role>(role);
+            m_clock.reset();
+            m_syncTimestamp     = millis();
+            m_isDelayReqPending = false;
+            m_currentSlot       = SyncPacket::SLOT_ID_NONE;
+            m_nextSlot          = SyncPacket::SLOT_ID_NONE;
+            (void)xSemaphoreGive(m_xMutex);
+
+            m_isExitReq = false;
+
+            osRet = xTaskCreateUniversal(   syncTask,
+                                            "syncTask",
+                                            TASK_STACK_SIZE,
+                                            this,
+                                            TASK_PRIORITY,
+                                            &m_taskHandle,
+                                            TASK_RUN_CORE);
+
+            if (pdPASS != osRet)
+            {
+                LOG_ERROR("Couldn't create display sync task.");
+
+                m_taskHandle    = nullptr;
+                m_role          = ROLE_OFF;
+
+                (void)lwip_close(m_socket);
+                m_socket = -1;
+            }
+            else
+            {
+                /* The text of all displays scrolls with the clock of the display group. */
+                TextWidget::setSpanClock(getTimeMs);
+                TextWidget::setSpan(spanWidth, spanOffset);
+
+                LOG_INFO("Display sync started as %s of group %u.", (ROLE_MASTER == m_role) ? "master" : "slave", m_group);
+            }
+        }
+    }
+
+    return;
+}
+
+void DisplaySync::end()
+{
+    if (nullptr != m_taskHandle)
+    {
+        m_isExitReq = true;
+
+        /* Join */
+        (void)xSemaphoreTake(m_xExitSemaphore, portMAX_DELAY);
+        m_taskHandle = nullptr;
+
+        TextWidget::setSpan(0U, 0U);
+        TextWidget::setSpanClock(nullptr);
+
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+        m_role = ROLE_OFF;
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    if (0 <= m_socket)
+    {
+        (void)lwip_close(m_socket);
+        m_socket = -1;
+    }
+
+    return;
+}
+
+bool DisplaySync::isFollowing()
+{
+    bool isFollowing = false;
+
+    if (ROLE_SLAVE == m_role)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+        if ((true == m_clock.isSynchronized()) &&
+            (SYNC_TIMEOUT > (millis() - m_syncTimestamp)))
+        {
+            isFollowing = true;
+        }
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return isFollowing;
+}
+
+uint64_t DisplaySync::getTime()
+{
+    uint64_t now = static_cast<uint64_t>(esp_timer_get_time());
+
+    if (ROLE_SLAVE == m_role)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+        if (true == m_clock.isSynchronized())
+        {
+            now = m_clock.toMaster(now);
+        }
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return now;
+}
+
+uint32_t DisplaySync::getTimeMs()
+{
+    return static_cast<uint32_t>(getInstance().getTime() / 1000U);
+}
+
+int32_t DisplaySync::getFrameCorrection(TickType_t wakeTime, uint32_t period)
+{
+    int32_t correction = 0;
+
+    /* A slave aligns its frame grid only to a master with the same frame period. */
+    if ((ROLE_MASTER == m_role) ||
+        ((true == isFollowing()) && (m_framePeriod == period)))
+    {
+        const int32_t   TICK_PERIOD = portTICK_PERIOD_MS * 1000; /* us */
+        const int32_t   WAKE_DELAY  = static_cast<int32_t>(wakeTime - xTaskGetTickCount()) * TICK_PERIOD;
+        const uint64_t  WAKE_TIME   = static_cast<uint64_t>(static_cast<int64_t>(getTime()) + WAKE_DELAY);
+        const int32_t   PHASE_ERROR = SyncClock::getPhaseError(WAKE_TIME, period * 1000U);
+
+        /* A late frame grid is brought forward, a early one is delayed. */
+        if (0 <= PHASE_ERROR)
+        {
+            correction = -((PHASE_ERROR + (TICK_PERIOD / 2)) / TICK_PERIOD);
+        }
+        else
+        {
+            correction = ((TICK_PERIOD / 2) - PHASE_ERROR) / TICK_PERIOD;
+        }
+    }
+
+    return correction;
+}
+
+void DisplaySync::setFramePeriod(uint32_t period)
+{
+    m_framePeriod = period;
+    return;
+}
+
+void DisplaySync::setSlot(uint8_t slotId)
+{
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if (m_currentSlot != slotId)
+    {
+        m_currentSlot   = slotId;
+        m_nextSlot      = SyncPacket::SLOT_ID_NONE;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+bool DisplaySync::isSwitchAnnounced()
+{
+    bool isAnnounced = false;
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    isAnnounced = (SyncPacket::SLOT_ID_NONE != m_nextSlot);
+    (void)xSemaphoreGive(m_xMutex);
+
+    return isAnnounced;
+}
+
+void DisplaySync::announceSwitch(uint8_t slotId, uint32_t remaining)
+{
+    const uint64_t SWITCH_TIME = getTime() + (static_cast<uint64_t>(remaining) * 1000U);
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    /* The switch takes place on the frame grid, so all displays of the
+     * group switch with the same frame.
+     */
+    m_nextSlot      = slotId;
+    m_switchTime    = SyncClock::alignUp(SWITCH_TIME, m_framePeriod * 1000U);
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+bool DisplaySync::isSwitchDue()
+{
+    const uint64_t  NOW     = getTime();
+    bool            isDue   = false;
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    isDue = isSwitchDue(NOW);
+    (void)xSemaphoreGive(m_xMutex);
+
+    return isDue;
+}
+
+uint8_t DisplaySync::getSlot()
+{
+    const uint64_t  NOW     = getTime();
+    uint8_t         slotId  = SyncPacket::SLOT_ID_NONE;
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if ((SyncPacket::SLOT_ID_NONE != m_nextSlot) &&
+        (true == isSwitchDue(NOW)))
+    {
+        slotId = m_nextSlot;
+    }
+    else
+    {
+        slotId = m_currentSlot;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return slotId;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+DisplaySync::DisplaySync() :
+    m_xMutex(xSemaphoreCreateMutex()),
+    m_xExitSemaphore(xSemaphoreCreateBinary()),
+    m_taskHandle(nullptr),
+    m_isExitReq(false),
+    m_socket(-1),
+    m_role(ROLE_OFF),
+    m_group(0U),
+    m_clock(),
+    m_sequence(0U),
+    m_syncTimestamp(0U),
+    m_masterAddr(0U),
+    m_syncTxTime(0U),
+    m_syncRxTime(0U),
+    m_delayReqTime(0U),
+    m_isDelayReqPending(false),
+    m_framePeriod(0U),
+    m_currentSlot(SyncPacket::SLOT_ID_NONE),
+    m_nextSlot(SyncPacket::SLOT_ID_NONE),
+    m_switchTime(0U)
+{
+}
+
+DisplaySync::~DisplaySync()
+{
+    end();
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+
+    if (nullptr != m_xExitSemaphore)
+    {
+        vSemaphoreDelete(m_xExitSemaphore);
+        m_xExitSemaphore = nullptr;
+    }
+}
+
+bool DisplaySync::openSocket()
+{
+    bool    isSuccessful    = false;
+    int     fd              = lwip_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (0 <= fd)
+    {
+        struct sockaddr_in  addr;
+        struct ip_mreq      mreq;
+        struct timeval      timeout;
+        int                 reuse   = 1;
+
+        timeout.tv_sec  = RECEIVE_TIMEOUT / 1000U;
+        timeout.tv_usec = (RECEIVE_TIMEOUT % 1000U) * 1000U;
+
+        (void)lwip_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        (void)lwip_setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family         = AF_INET;
+        addr.sin_port           = htons(PORT);
+        addr.sin_addr.s_addr    = htonl(INADDR_ANY);
+
+        mreq.imr_multiaddr.s_addr   = inet_addr(MULTICAST_ADDR);
+        mreq.imr_interface.s_addr   = htonl(INADDR_ANY);
+
+        if ((0 == lwip_bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr))) &&
+            (0 == lwip_setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq))))
+        {
+            m_socket        = fd;
+            isSuccessful    = true;
+        }
+        else
+        {
+            (void)lwip_close(fd);
+        }
+    }
+
+    return isSuccessful;
+}
+
+void DisplaySync::run()
+{
+    uint8_t buffer[SyncPacket::MAX_SIZE];
+
+    while(false == m_isExitReq)
+    {
+        struct sockaddr_in  from;
+        socklen_t           fromLen = sizeof(from);
+        int                 ret     = 0;
+
+        if ((ROLE_MASTER == m_role) &&
+            (SYNC_PERIOD <= (millis() - m_syncTimestamp)))
+        {
+            sendSync();
+        }
+
+        ret = lwip_recvfrom(m_socket, buffer, sizeof(buffer), 0, reinterpret_cast<struct sockaddr*>(&from), &fromLen);
+
+        if (0 < ret)
+        {
+            /* Take the receive timestamp as early as possible. */
+            const uint64_t  RX_TIME = static_cast<uint64_t>(esp_timer_get_time());
+            SyncPacket      packet;
+
+            if ((true == SyncPacket::decode(buffer, static_cast<size_t>(ret), packet)) &&
+                (m_group == packet.group))
+            {
+                handlePacket(packet, RX_TIME, from.sin_addr.s_addr, from.sin_port);
+            }
+        }
+    }
+
+    return;
+}
+
+void DisplaySync::sendSync()
+{
+    SyncPacket packet;
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    packet.type         = SyncPacket::TYPE_SYNC;
+    packet.group        = m_group;
+    packet.sequence     = ++m_sequence;
+    packet.framePeriod  = static_cast<uint16_t>(m_framePeriod);
+    packet.currentSlot  = m_currentSlot;
+    packet.nextSlot     = m_nextSlot;
+    packet.switchTime   = m_switchTime;
+
+    m_syncTimestamp     = millis();
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    /* Take the transmit timestamp as late as possible. */
+    packet.timestamp    = static_cast<uint64_t>(esp_timer_get_time());
+
+    send(packet, inet_addr(MULTICAST_ADDR), htons(PORT));
+
+    return;
+}
+
+void DisplaySync::handlePacket(const SyncPacket& packet, uint64_t rxTime, uint32_t addr, uint16_t port)
+{
+    /* Master answers the delay requests. */
+    if ((ROLE_MASTER == m_role) &&
+        (SyncPacket::TYPE_DELAY_REQ == packet.type))
+    {
+        SyncPacket response;
+
+        response.type       = SyncPacket::TYPE_DELAY_RESP;
+        response.group      = m_group;
+        response.sequence   = packet.sequence;
+        response.timestamp  = rxTime;
+
+        send(response, addr, port);
+    }
+    /* Slave takes over the master timing and measures the delay. */
+    else if ((ROLE_SLAVE == m_role) &&
+             (SyncPacket::TYPE_SYNC == packet.type))
+    {
+        SyncPacket request;
+
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+        m_masterAddr        = addr;
+        m_syncTimestamp     = millis();
+        m_syncTxTime        = packet.timestamp;
+        m_syncRxTime        = rxTime;
+        m_framePeriod       = packet.framePeriod;
+        m_currentSlot       = packet.currentSlot;
+        m_nextSlot          = packet.nextSlot;
+        m_switchTime        = packet.switchTime;
+        m_sequence          = packet.sequence;
+        m_isDelayReqPending = true;
+
+        (void)xSemaphoreGive(m_xMutex);
+
+        request.type        = SyncPacket::TYPE_DELAY_REQ;
+        request.group       = m_group;
+        request.sequence    = packet.sequence;
+
+        /* Take the transmit timestamp as late as possible. */
+        m_delayReqTime = static_cast<uint64_t>(esp_timer_get_time());
+        send(request, m_masterAddr, htons(PORT));
+    }
+    else if ((ROLE_SLAVE == m_role) &&
+             (SyncPacket::TYPE_DELAY_RESP == packet.type))
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+        /* Only the response to the latest request is considered. */
+        if ((true == m_isDelayReqPending) &&
+            (m_sequence == packet.sequence) &&
+            (m_masterAddr == addr))
+        {
+            (void)m_clock.addSample(m_syncTxTime, m_syncRxTime, m_delayReqTime, packet.timestamp);
+            m_isDelayReqPending = false;
+        }
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+    else
+    {
+        ;
+    }
+
+    return;
+}
+
+void DisplaySync::send(const SyncPacket& packet, uint32_t addr, uint16_t port)
+{
+    uint8_t         buffer[SyncPacket::MAX_SIZE];
+    const size_t    SIZE    = SyncPacket::encode(packet, buffer, sizeof(buffer));
+
+    if (0U < SIZE)
+    {
+        struct sockaddr_in to;
+
+        memset(&to, 0, sizeof(to));
+        to.sin_family       = AF_INET;
+        to.sin_port         = port;
+        to.sin_addr.s_addr  = addr;
+
+        (void)lwip_sendto(m_socket, buffer, SIZE, 0, reinterpret_cast<struct sockaddr*>(&to), sizeof(to));
+    }
+
+    return;
+}
+
+bool DisplaySync::isSwitchDue(uint64_t now) const
+{
+    bool isDue = true;
+
+    /* The switch is due with the frame on the grid point of the switch time.
+     * Half a frame period margin compensates the remaining clock jitter.
+     */
+    if (SyncPacket::SLOT_ID_NONE != m_nextSlot)
+    {
+        const uint64_t MARGIN = (static_cast<uint64_t>(m_framePeriod) * 1000U) / 2U;
+
+        isDue = (now + MARGIN >= m_switchTime);
+    }
+
+    return isDue;
+}
+
+void DisplaySync::syncTask(void* parameters)
+{
+    DisplaySync* sync = reinterpret_cast<DisplaySync*>(parameters);
+
+    if (nullptr != sync)
+    {
+        sync->run();
+
+        (void)xSemaphoreGive(sync->m_xExitSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,321 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display synchronization
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __DISPLAY_SYNC_H__
+#define __DISPLAY_SYNC_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <SyncClock.h>
+#include <SyncPacket.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The display sync lets a group of displays side by side act as one display.
+ * One device is the master, which broadcasts its clock and its slot timing
+ * via UDP multicast. The slaves synchronize their clock to the master clock
+ * with a delay request-response exchange, similar to PTP. The wifi provides
+ * no hardware timestamps, therefore the timestamps are taken in software and
+ * the delay jitter is filtered, see SyncClock.
+ *
+ * With the synchronized clock
+ * - all displays align their frame grid to the master clock,
+ * - the slaves switch the slots together with the master,
+ * - a text is scrolled over the span of all displays, see TextWidget::setSpan().
+ *
+ * Only one master per display group is supported.
+ */
+class DisplaySync
+{
+public:
+
+    /** Role in the display group */
+    enum Role
+    {
+        ROLE_OFF    = 0,    /**< Not synchronized */
+        ROLE_MASTER = 1,    /**< Time master of the display group */
+        ROLE_SLAVE  = 2     /**< Follows the master of the display group */
+    };
+
+    /** UDP port */
+    static const uint16_t   PORT                = 5568U;
+
+    /** Multicast group address */
+    static const char*      MULTICAST_ADDR;
+
+    /** Period in ms, the master sends the sync message. */
+    static const uint32_t   SYNC_PERIOD         = 100U;
+
+    /** If no sync message is received for this time in ms, a slave runs on its own. */
+    static const uint32_t   SYNC_TIMEOUT        = 1000U;
+
+    /** Time in ms before a slot switch, the master announces it. */
+    static const uint32_t   ANNOUNCE_TIME       = 500U;
+
+    /**
+     * Get display sync instance.
+     *
+     * @return Display sync instance
+     */
+    static DisplaySync& getInstance()
+    {
+        static DisplaySync instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the synchronization according to the settings.
+     */
+    void begin();
+
+    /**
+     * Stop the synchronization.
+     */
+    void end();
+
+    /**
+     * Get the role in the display group.
+     *
+     * @return Role
+     */
+    Role getRole() const
+    {
+        return m_role;
+    }
+
+    /**
+     * Is the device a slave, which follows the master?
+     *
+     * @return If following, it will return true otherwise false.
+     */
+    bool isFollowing();
+
+    /**
+     * Get the current time of the display group.
+     * Its the master clock, if synchronized otherwise the local clock.
+     *
+     * @return Timestamp in us
+     */
+    uint64_t getTime();
+
+    /**
+     * Get the current time of the display group in ms.
+     * It can be used as span clock of the text widgets.
+     *
+     * @return Timestamp in ms
+     */
+    static uint32_t getTimeMs();
+
+    /**
+     * Get the correction of the next frame wake time, which aligns the
+     * frame to the frame grid of the display group.
+     *
+     * @param[in] wakeTime  Next frame wake time in ticks
+     * @param[in] period    Frame period in ms
+     *
+     * @return Correction in ticks, which to add to the wake time.
+     */
+    int32_t getFrameCorrection(TickType_t wakeTime, uint32_t period);
+
+    /**
+     * Master only: Set the frame period, which is sent to the slaves.
+     *
+     * @param[in] period    Frame period in ms
+     */
+    void setFramePeriod(uint32_t period);
+
+    /**
+     * Master only: Set the currently active slot. A announced slot switch is
+     * finished with it.
+     *
+     * @param[in] slotId    Slot id
+     */
+    void setSlot(uint8_t slotId);
+
+    /**
+     * Master only: Is a slot switch already announced?
+     *
+     * @return If announced, it will return true otherwise false.
+     */
+    bool isSwitchAnnounced();
+
+    /**
+     * Master only: Announce the switch to the next slot. The switch takes
+     * place with the frame on the frame grid, which is not before the
+     * remaining time.
+     *
+     * @param[in] slotId    Next slot id
+     * @param[in] remaining Remaining time in ms until the switch
+     */
+    void announceSwitch(uint8_t slotId, uint32_t remaining);
+
+    /**
+     * Is the announced slot switch due? If no switch is announced, its
+     * always due.
+     *
+     * @return If due, it will return true otherwise false.
+     */
+    bool isSwitchDue();
+
+    /**
+     * Slave only: Get the slot, which shall be active now.
+     *
+     * @return Slot id or SyncPacket::SLOT_ID_NONE
+     */
+    uint8_t getSlot();
+
+private:
+
+    /** Task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 3072U;
+
+    /** Task priority, high to take the timestamps in time. */
+    static const UBaseType_t    TASK_PRIORITY       = 5U;
+
+    /** MCU core where the task shall run */
+    static const BaseType_t     TASK_RUN_CORE       = 0;
+
+    /** Receive timeout in ms, which limits the latency of sending and exiting. */
+    static const uint32_t       RECEIVE_TIMEOUT     = 10U;
+
+    SemaphoreHandle_t   m_xMutex;               /**< Mutex to protect the synchronization state. */
+    SemaphoreHandle_t   m_xExitSemaphore;       /**< Signals the exit of the task. */
+    TaskHandle_t        m_taskHandle;           /**< Task handle */
+    volatile bool       m_isExitReq;            /**< Request the task to exit. */
+    int                 m_socket;               /**< UDP socket */
+    Role                m_role;                 /**< Role in the display group */
+    uint8_t             m_group;                /**< Display group */
+    SyncClock           m_clock;                /**< Slave: Clock, synchronized to the master */
+    uint16_t            m_sequence;             /**< Sequence number of the last sent sync or delay request */
+    uint32_t            m_syncTimestamp;        /**< Timestamp in ms of the last sent or received sync message */
+    uint32_t            m_masterAddr;           /**< Slave: Master IPv4 address in network byte order */
+    uint64_t            m_syncTxTime;           /**< Slave: Master timestamp of the last sync message in us (t1) */
+    uint64_t            m_syncRxTime;           /**< Slave: Local timestamp of the last sync message in us (t2) */
+    uint64_t            m_delayReqTime;         /**< Slave: Local timestamp of the last delay request in us (t3) */
+    bool                m_isDelayReqPending;    /**< Slave: Is a delay response pending? */
+    uint32_t            m_framePeriod;          /**< Frame period of the master in ms */
+    uint8_t             m_currentSlot;          /**< Currently active slot of the master */
+    uint8_t             m_nextSlot;             /**< Announced next slot of the master */
+    uint64_t            m_switchTime;           /**< Master timestamp in us of the announced slot switch */
+
+    /**
+     * Constructs the display sync.
+     */
+    DisplaySync();
+
+    /**
+     * Destroys the display sync.
+     */
+    ~DisplaySync();
+
+    /* Prevent copying */
+    DisplaySync(const DisplaySync& sync);
+    DisplaySync& operator=(const DisplaySync& sync);
+
+    /**
+     * Open the UDP socket and join the multicast group.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool openSocket();
+
+    /**
+     * Receive and send the sync messages, until the exit is requested.
+     */
+    void run();
+
+    /**
+     * Master only: Send the sync message to the display group.
+     */
+    void sendSync();
+
+    /**
+     * Handle a received packet.
+     *
+     * @param[in] packet    Received packet
+     * @param[in] rxTime    Local receive timestamp in us
+     * @param[in] addr      IPv4 address of the sender in network byte order
+     * @param[in] port      UDP port of the sender in network byte order
+     */
+    void handlePacket(const SyncPacket& packet, uint64_t rxTime, uint32_t addr, uint16_t port);
+
+    /**
+     * Send a packet.
+     *
+     * @param[in] packet    Packet
+     * @param[in] addr      IPv4 address in network byte order
+     * @param[in] port      UDP port in network byte order
+     */
+    void send(const SyncPacket& packet, uint32_t addr, uint16_t port);
+
+    /**
+     * Is the announced slot switch due? The caller must hold the mutex.
+     *
+     * @param[in] now   Current master timestamp in us
+     *
+     * @return If due, it will return true otherwise false.
+     */
+    bool isSwitchDue(uint64_t now) const;
+
+    /**
+     * Display sync task.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void syncTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DISPLAY_SYNC_H__ */
+
+/** @} */
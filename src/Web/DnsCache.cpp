@@ -0,0 +1,452 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DnsCache.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+DnsCache::Result DnsCache::resolve(const String& hostname, IPAddress& addr, const void* owner, const OnResolved& onResolved)
+{
+    Result  result  = RESULT_FAILED;
+    uint8_t index   = MAX_ENTRIES;
+
+    if (true == hostname.isEmpty())
+    {
+        result = RESULT_FAILED;
+    }
+    /* A IP address needs no lookup. */
+    else if (true == addr.fromString(hostname))
+    {
+        result = RESULT_RESOLVED;
+    }
+    else
+    {
+        const uint32_t NOW = millis();
+
+        lock();
+
+        index = findEntry(hostname);
+
+        if (MAX_ENTRIES > index)
+        {
+            Entry& entry = m_entries[index];
+
+            if ((STATE_RESOLVED == entry.state) &&
+                (TTL > (NOW - entry.timestamp)))
+            {
+                addr    = entry.addr;
+                result  = RESULT_RESOLVED;
+            }
+            else if ((STATE_FAILED == entry.state) &&
+                     (NEGATIVE_TTL > (NOW - entry.timestamp)))
+            {
+                result = RESULT_FAILED;
+            }
+            else if (STATE_PENDING == entry.state)
+            {
+                result = RESULT_PENDING;
+            }
+            else
+            {
+                /* Expired, lookup again. */
+                entry.state = STATE_FREE;
+            }
+        }
+        else
+        {
+            index = allocEntry();
+
+            if (MAX_ENTRIES > index)
+            {
+                m_entries[index].state      = STATE_FREE;
+                m_entries[index].hostname   = hostname;
+            }
+            else
+            {
+                LOG_WARNING("No DNS cache entry available for %s.", hostname.c_str());
+            }
+        }
+
+        /* Start a new lookup? */
+        if ((MAX_ENTRIES > index) &&
+            (STATE_FREE == m_entries[index].state))
+        {
+            Entry&      entry   = m_entries[index];
+            ip_addr_t   ipAddr;
+            err_t       err     = dns_gethostbyname(hostname.c_str(), &ipAddr, onDnsFound, this);
+
+            if (ERR_OK == err)
+            {
+                /* Answered from the lwIP table. */
+                entry.state     = STATE_RESOLVED;
+                entry.addr      = IPAddress(ipAddr.u_addr.ip4.addr);
+                entry.timestamp = NOW;
+
+                addr    = entry.addr;
+                result  = RESULT_RESOLVED;
+            }
+            else if (ERR_INPROGRESS == err)
+            {
+                entry.state = STATE_PENDING;
+                result      = RESULT_PENDING;
+            }
+            else
+            {
+                LOG_WARNING("DNS lookup of %s failed: %d", hostname.c_str(), err);
+
+                entry.state     = STATE_FAILED;
+                entry.timestamp = NOW;
+                result          = RESULT_FAILED;
+            }
+        }
+
+        if ((RESULT_PENDING == result) &&
+            (nullptr != onResolved) &&
+            (false == addWaiter(index, owner, onResolved)))
+        {
+            LOG_WARNING("Too many DNS lookups pending.");
+            result = RESULT_FAILED;
+        }
+
+        unlock();
+    }
+
+    return result;
+}
+
+void DnsCache::cancel(const void* owner)
+{
+    uint8_t index = 0U;
+
+    lock();
+
+    for(index = 0U; index < MAX_WAITERS; ++index)
+    {
+        if ((nullptr != owner) &&
+            (owner == m_waiters[index].owner))
+        {
+            m_waiters[index] = Waiter();
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void DnsCache::clear()
+{
+    uint8_t index = 0U;
+
+    lock();
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        if (STATE_PENDING != m_entries[index].state)
+        {
+            m_entries[index] = Entry();
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void DnsCache::onTimeout(EventTimer& timer)
+{
+    bool isPending = true;
+
+    if (&m_notifyTimer == &timer)
+    {
+        /* Notify one waiter after the other, always without lock, which
+         * allows the owner to call the DNS cache again.
+         */
+        while(true == isPending)
+        {
+            OnResolved  onResolved  = nullptr;
+            bool        isResolved  = false;
+            IPAddress   addr;
+            uint8_t     index       = 0U;
+
+            lock();
+
+            while((MAX_WAITERS > index) &&
+                  ((nullptr == m_waiters[index].owner) ||
+                   (false == m_waiters[index].isDone)))
+            {
+                ++index;
+            }
+
+            if (MAX_WAITERS <= index)
+            {
+                isPending = false;
+            }
+            else
+            {
+                onResolved  = m_waiters[index].onResolved;
+                isResolved  = m_waiters[index].isResolved;
+                addr        = m_waiters[index].addr;
+
+                m_waiters[index] = Waiter();
+            }
+
+            unlock();
+
+            if (nullptr != onResolved)
+            {
+                onResolved(isResolved, addr);
+            }
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+DnsCache::DnsCache() :
+    m_entries(),
+    m_waiters(),
+    m_xMutex(xSemaphoreCreateRecursiveMutex()),
+    m_notifyTimer(*this)
+{
+}
+
+DnsCache::~DnsCache()
+{
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+uint8_t DnsCache::findEntry(const String& hostname) const
+{
+    uint8_t index = 0U;
+
+    while((MAX_ENTRIES > index) &&
+          ((STATE_FREE == m_entries[index].state) ||
+           (0U == hostname.equalsIgnoreCase(m_entries[index].hostname))))
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+uint8_t DnsCache::allocEntry() const
+{
+    const uint32_t  NOW     = millis();
+    uint8_t         index   = 0U;
+    uint8_t         oldest  = MAX_ENTRIES;
+
+    while((MAX_ENTRIES > index) &&
+          (STATE_FREE != m_entries[index].state))
+    {
+        if ((STATE_PENDING != m_entries[index].state) &&
+            ((MAX_ENTRIES == oldest) ||
+             ((NOW - m_entries[index].timestamp) > (NOW - m_entries[oldest].timestamp))))
+        {
+            oldest = index;
+        }
+
+        ++index;
+    }
+
+    if (MAX_ENTRIES <= index)
+    {
+        index = oldest;
+    }
+
+    return index;
+}
+
+bool DnsCache::addWaiter(uint8_t entry, const void* owner, const OnResolved& onResolved)
+{
+    bool    status  = false;
+    uint8_t index   = 0U;
+
+    /* A owner waits only for one lookup at a time. A waiter without owner
+     * is never replaced.
+     */
+    while((MAX_WAITERS > index) &&
+          ((nullptr == owner) || (owner != m_waiters[index].owner)))
+    {
+        ++index;
+    }
+
+    if (MAX_WAITERS <= index)
+    {
+        index = 0U;
+        while((MAX_WAITERS > index) &&
+              (nullptr != m_waiters[index].owner))
+        {
+            ++index;
+        }
+    }
+
+    if (MAX_WAITERS > index)
+    {
+        m_waiters[index].owner      = (nullptr == owner) ? this : owner;
+        m_waiters[index].entry      = entry;
+        m_waiters[index].onResolved = onResolved;
+        m_waiters[index].isDone     = false;
+
+        status = true;
+    }
+
+    return status;
+}
+
+void DnsCache::setResult(const char* hostname, const ip_addr_t* ipAddr)
+{
+    uint8_t index   = 0U;
+    uint8_t waiter  = 0U;
+
+    lock();
+
+    for(index = 0U; index < MAX_ENTRIES; ++index)
+    {
+        Entry& entry = m_entries[index];
+
+        if ((STATE_PENDING == entry.state) &&
+            (nullptr != hostname) &&
+            (0U != entry.hostname.equalsIgnoreCase(hostname)))
+        {
+            if (nullptr == ipAddr)
+            {
+                entry.state = STATE_FAILED;
+            }
+            else
+            {
+                entry.state = STATE_RESOLVED;
+                entry.addr  = IPAddress(ipAddr->u_addr.ip4.addr);
+            }
+
+            entry.timestamp = millis();
+
+            /* The entry may be replaced, before the waiters are notified. */
+            for(waiter = 0U; waiter < MAX_WAITERS; ++waiter)
+            {
+                if ((nullptr != m_waiters[waiter].owner) &&
+                    (index == m_waiters[waiter].entry) &&
+                    (false == m_waiters[waiter].isDone))
+                {
+                    m_waiters[waiter].isDone        = true;
+                    m_waiters[waiter].isResolved    = (STATE_RESOLVED == entry.state);
+                    m_waiters[waiter].addr          = entry.addr;
+                }
+            }
+        }
+    }
+
+    unlock();
+
+    m_notifyTimer.start(0U);
+
+    return;
+}
+
+void DnsCache::onDnsFound(const char* name, const ip_addr_t* ipAddr, void* arg)
+{
+    DnsCache* cache = static_cast<DnsCache*>(arg);
+
+    if (nullptr != cache)
+    {
+        cache->setResult(name, ipAddr);
+    }
+
+    return;
+}
+
+void DnsCache::lock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void DnsCache::unlock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,269 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __DNS_CACHE_H__
+#define __DNS_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <IPAddress.h>
+#include <EventTimer.hpp>
+#include <lwip/dns.h>
+#include <functional>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The DNS cache resolves hostnames asynchronously and keeps the results
+ * for all network clients. Failed lookups are cached too, which avoids that
+ * every client asks again, while the DNS server is not available.
+ *
+ * lwIP doesn't provide the time to live of a record, therefore every entry
+ * has a fixed max. age. An expired entry is resolved again by lwIP, which
+ * answers from its own table as long as the record time to live is not over.
+ *
+ * The resolved callbacks are called in the context of the display task,
+ * because other network functions must not be called in the lwIP task.
+ */
+class DnsCache : public ITimerListener
+{
+public:
+
+    /**
+     * Prototype of callback for a finished lookup.
+     */
+    typedef std::function<void(bool isResolved, const IPAddress& addr)> OnResolved;
+
+    /**
+     * Lookup results.
+     */
+    enum Result
+    {
+        RESULT_RESOLVED = 0,    /**< Resolved, the address is available */
+        RESULT_PENDING,         /**< Lookup is pending, the callback will be called */
+        RESULT_FAILED           /**< Lookup failed */
+    };
+
+    /** Max. number of cached hostnames. */
+    static const uint8_t    MAX_ENTRIES     = 8U;
+
+    /** Max. number of pending lookup callbacks. */
+    static const uint8_t    MAX_WAITERS     = 6U;
+
+    /** Max. age in ms of a resolved entry. */
+    static const uint32_t   TTL             = (5U * 60U * 1000U);
+
+    /** Max. age in ms of a failed entry. */
+    static const uint32_t   NEGATIVE_TTL    = (30U * 1000U);
+
+    /**
+     * Get the DNS cache instance.
+     *
+     * @return DNS cache
+     */
+    static DnsCache& getInstance()
+    {
+        static DnsCache instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Resolve the hostname. A IP address in dot notation is resolved
+     * immediately.
+     *
+     * @param[in]   hostname    Hostname
+     * @param[out]  addr        IP address, only valid if resolved
+     * @param[in]   owner       Owner of the callback, used to cancel it
+     * @param[in]   onResolved  Callback, which is called if the lookup is pending, may be nullptr
+     *
+     * @return Lookup result
+     */
+    Result resolve(const String& hostname, IPAddress& addr, const void* owner, const OnResolved& onResolved);
+
+    /**
+     * Cancel the pending callbacks of the given owner.
+     *
+     * @param[in] owner Owner of the callbacks
+     */
+    void cancel(const void* owner);
+
+    /**
+     * Drop all entries, e.g. after connecting to a different network.
+     * Pending lookups are not affected.
+     */
+    void clear();
+
+    /**
+     * Notifies the owners about finished lookups.
+     * Will be called by the timer service.
+     *
+     * @param[in] timer Event timer, which timed out
+     */
+    void onTimeout(EventTimer& timer) final;
+
+private:
+
+    /**
+     * Entry states.
+     */
+    enum State
+    {
+        STATE_FREE = 0,     /**< Entry is not used */
+        STATE_PENDING,      /**< Lookup is pending */
+        STATE_RESOLVED,     /**< Hostname is resolved */
+        STATE_FAILED        /**< Lookup failed */
+    };
+
+    /**
+     * A cached hostname.
+     */
+    struct Entry
+    {
+        State       state;      /**< Entry state */
+        String      hostname;   /**< Hostname */
+        IPAddress   addr;       /**< IP address, if resolved */
+        uint32_t    timestamp;  /**< Timestamp in ms of the lookup result */
+    };
+
+    /**
+     * A owner, which waits for a pending lookup.
+     */
+    struct Waiter
+    {
+        const void* owner;      /**< Owner of the callback, nullptr if unused */
+        uint8_t     entry;      /**< Index of the pending entry */
+        OnResolved  onResolved; /**< Callback */
+        bool        isDone;     /**< Is the lookup finished? */
+        bool        isResolved; /**< Is the hostname resolved? */
+        IPAddress   addr;       /**< IP address, if resolved */
+    };
+
+    Entry               m_entries[MAX_ENTRIES];     /**< Cached hostnames */
+    Waiter              m_waiters[MAX_WAITERS];     /**< Waiting owners */
+    SemaphoreHandle_t   m_xMutex;                   /**< Mutex to protect against concurrent access. */
+    EventTimer          m_notifyTimer;              /**< Timer, used to notify the owners in the display task. */
+
+    /**
+     * Constructs the DNS cache.
+     */
+    DnsCache();
+
+    /**
+     * Destroys the DNS cache.
+     */
+    ~DnsCache();
+
+    /* Prevent copying */
+    DnsCache(const DnsCache&);
+    DnsCache& operator=(const DnsCache&);
+
+    /**
+     * Find the entry of the hostname.
+     *
+     * @param[in] hostname  Hostname
+     *
+     * @return Entry index or MAX_ENTRIES if not found.
+     */
+    uint8_t findEntry(const String& hostname) const;
+
+    /**
+     * Get a entry for a new lookup. A free one is preferred, otherwise the
+     * oldest not pending entry is replaced.
+     *
+     * @return Entry index or MAX_ENTRIES if all are pending.
+     */
+    uint8_t allocEntry() const;
+
+    /**
+     * Add a waiter for the pending entry.
+     *
+     * @param[in] entry         Entry index
+     * @param[in] owner         Owner of the callback
+     * @param[in] onResolved    Callback
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool addWaiter(uint8_t entry, const void* owner, const OnResolved& onResolved);
+
+    /**
+     * Set the lookup result of the hostname.
+     *
+     * @param[in] hostname  Hostname
+     * @param[in] ipAddr    IP address or nullptr if the lookup failed
+     */
+    void setResult(const char* hostname, const ip_addr_t* ipAddr);
+
+    /**
+     * Called by lwIP in its task, if a lookup is finished.
+     *
+     * @param[in] name      Hostname
+     * @param[in] ipAddr    IP address or nullptr if the lookup failed
+     * @param[in] arg       DNS cache instance
+     */
+    static void onDnsFound(const char* name, const ip_addr_t* ipAddr, void* arg);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock() const;
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DNS_CACHE_H__ */
+
+/** @} */
\ No newline at end of file
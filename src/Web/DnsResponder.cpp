@@ -0,0 +1,213 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Captive portal DNS responder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DnsResponder.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** DNS message header size in byte. */
+static const size_t     HEADER_SIZE     = 12U;
+
+/** Size of the address record in the answer section in byte. */
+static const size_t     ANSWER_SIZE     = 16U;
+
+/** Query type: host address */
+static const uint16_t   QTYPE_A         = 1U;
+
+/** Query type: all records */
+static const uint16_t   QTYPE_ANY       = 255U;
+
+/** Query class: internet */
+static const uint16_t   QCLASS_IN       = 1U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool DnsResponder::start(uint16_t port, const IPAddress& address)
+{
+    m_address = address;
+
+    if (false == m_udp.listen(port))
+    {
+        return false;
+    }
+
+    m_udp.onPacket(
+        [this](AsyncUDPPacket& packet)
+        {
+            this->onPacket(packet);
+        }
+    );
+
+    return true;
+}
+
+void DnsResponder::stop()
+{
+    m_udp.close();
+}
+
+size_t DnsResponder::buildReply(const uint8_t* query, size_t querySize, const IPAddress& address, uint8_t* reply)
+{
+    size_t      offset  = HEADER_SIZE;
+    uint16_t    qType   = 0U;
+    uint16_t    qClass  = 0U;
+
+    if ((nullptr == query) ||
+        (nullptr == reply) ||
+        (HEADER_SIZE > querySize))
+    {
+        return 0U;
+    }
+
+    /* Only standard queries (QR = 0, OPCODE = 0) with exactly one question are answered. */
+    if ((0U != (query[2] & 0xf8U)) ||
+        (0U != query[4]) ||
+        (1U != query[5]))
+    {
+        return 0U;
+    }
+
+    /* Skip the name labels. A query shall not use compression in the question. */
+    while((querySize > offset) && (0U != query[offset]))
+    {
+        if (0U != (query[offset] & 0xc0U))
+        {
+            return 0U;
+        }
+
+        offset += 1U + query[offset];
+    }
+
+    /* Terminating zero label, type and class must follow. */
+    if (querySize < (offset + 5U))
+    {
+        return 0U;
+    }
+
+    ++offset;
+    qType   = (static_cast<uint16_t>(query[offset + 0U]) << 8U) | query[offset + 1U];
+    qClass  = (static_cast<uint16_t>(query[offset + 2U]) << 8U) | query[offset + 3U];
+    offset += 4U;
+
+    if (MAX_PACKET_SIZE < (offset + ANSWER_SIZE))
+    {
+        return 0U;
+    }
+
+    /* The reply repeats header and question. Additional records (e.g. EDNS) are dropped. */
+    memcpy(reply, query, offset);
+
+    reply[2]    = 0x84U | (query[2] & 0x01U);   /* QR, AA and the RD of the query */
+    reply[3]    = 0x80U;                        /* RA, no error */
+    reply[6]    = 0U;                           /* ANCOUNT */
+    reply[7]    = 0U;
+    reply[8]    = 0U;                           /* NSCOUNT */
+    reply[9]    = 0U;
+    reply[10]   = 0U;                           /* ARCOUNT */
+    reply[11]   = 0U;
+
+    if ((QCLASS_IN == qClass) &&
+        ((QTYPE_A == qType) || (QTYPE_ANY == qType)))
+    {
+        reply[7] = 1U;
+
+        reply[offset++] = 0xc0U;                /* Name: pointer to the question */
+        reply[offset++] = HEADER_SIZE;
+        reply[offset++] = 0U;                   /* Type A */
+        reply[offset++] = QTYPE_A;
+        reply[offset++] = 0U;                   /* Class IN */
+        reply[offset++] = QCLASS_IN;
+        reply[offset++] = (TTL >> 24U) & 0xffU;
+        reply[offset++] = (TTL >> 16U) & 0xffU;
+        reply[offset++] = (TTL >>  8U) & 0xffU;
+        reply[offset++] = (TTL >>  0U) & 0xffU;
+        reply[offset++] = 0U;                   /* Data length */
+        reply[offset++] = 4U;
+        reply[offset++] = address[0];
+        reply[offset++] = address[1];
+        reply[offset++] = address[2];
+        reply[offset++] = address[3];
+    }
+
+    return offset;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void DnsResponder::onPacket(AsyncUDPPacket& packet)
+{
+    uint8_t reply[MAX_PACKET_SIZE];
+    size_t  replySize   = buildReply(packet.data(), packet.length(), m_address, reply);
+
+    if (0U < replySize)
+    {
+        (void)packet.write(reply, replySize);
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,141 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Captive portal DNS responder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __DNS_RESPONDER_H__
+#define __DNS_RESPONDER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IPAddress.h>
+#include <AsyncUDP.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * DNS responder, used by the captive portal.
+ * Every A query is answered with a single fixed address record, all other
+ * queries get an empty answer without error. The reply is built in place
+ * from the query in the receive callback, so there is no polling and no
+ * heap allocation per query.
+ */
+class DnsResponder
+{
+public:
+
+    /**
+     * Constructs the DNS responder.
+     */
+    DnsResponder() :
+        m_udp(),
+        m_address()
+    {
+    }
+
+    /**
+     * Destroys the DNS responder.
+     */
+    ~DnsResponder()
+    {
+        stop();
+    }
+
+    /**
+     * Start the DNS responder.
+     *
+     * @param[in] port      UDP port
+     * @param[in] address   Address, which is replied to every A query.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool start(uint16_t port, const IPAddress& address);
+
+    /**
+     * Stop the DNS responder.
+     */
+    void stop();
+
+    /**
+     * Build the reply for a DNS query.
+     *
+     * @param[in]   query       Query
+     * @param[in]   querySize   Query size in byte
+     * @param[in]   address     Address, which is replied to an A query.
+     * @param[out]  reply       Reply buffer with at least MAX_PACKET_SIZE bytes.
+     *
+     * @return Reply size in byte. If the query shall not be answered, it will return 0.
+     */
+    static size_t buildReply(const uint8_t* query, size_t querySize, const IPAddress& address, uint8_t* reply);
+
+    /** Max. size of a DNS message via UDP in byte. */
+    static const size_t     MAX_PACKET_SIZE = 512U;
+
+    /** Time to live of the address record in s. */
+    static const uint32_t   TTL             = 60U;
+
+private:
+
+    AsyncUDP    m_udp;      /**< UDP socket */
+    IPAddress   m_address;  /**< Address, which is replied to every A query. */
+
+    DnsResponder(const DnsResponder& responder);
+    DnsResponder& operator=(const DnsResponder& responder);
+
+    /**
+     * Handles a received DNS query.
+     *
+     * @param[in] packet    Received UDP packet
+     */
+    void onPacket(AsyncUDPPacket& packet);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DNS_RESPONDER_H__ */
+
+/** @} */
@@ -0,0 +1,223 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Server-sent event stream of state changes
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EventStream.h"
+#include "DisplayMgr.h"
+#include "BrightnessCtrl.h"
+#include "UpdateMgr.h"
+
+#include <ArduinoJson.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize the URI of the event stream. */
+const char* EventStream::URI = "/rest/api/v1/events";
+
+/* Initialize the event names. */
+const char* EventStream::EVENT_NAMES[EVENT_COUNT] =
+{
+    "slot",
+    "brightness",
+    "plugins",
+    "update"
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void EventStream::init(AsyncWebServer& srv)
+{
+    /* A new subscriber gets the complete state with the next send. The
+     * other subscribers just receive it again, which is cheaper than
+     * serializing it per subscriber.
+     */
+    m_eventSource.onConnect([this](AsyncEventSourceClient* client) {
+        (void)client;
+        m_pending.store((1U << EVENT_COUNT) - 1U, std::memory_order_relaxed);
+    });
+
+    (void)srv.addHandler(&m_eventSource);
+
+    return;
+}
+
+void EventStream::notify(Event event)
+{
+    /* The system task polls the pending events periodically. */
+    if (EVENT_COUNT > event)
+    {
+        (void)m_pending.fetch_or(1U << event, std::memory_order_relaxed);
+    }
+
+    return;
+}
+
+void EventStream::process()
+{
+    /* Changes within the send period are coalesced. */
+    if ((false == m_sendTimer.isTimerRunning()) ||
+        (true == m_sendTimer.isTimeout()))
+    {
+        const uint32_t PENDING = m_pending.exchange(0U, std::memory_order_relaxed);
+
+        if (0U == PENDING)
+        {
+            m_sendTimer.stop();
+        }
+        else
+        {
+            /* Without subscribers, the changes are just dropped. */
+            if (0U < m_eventSource.count())
+            {
+                uint8_t event = 0U;
+
+                for(event = 0U; event < EVENT_COUNT; ++event)
+                {
+                    if (0U != (PENDING & (1U << event)))
+                    {
+                        send(static_cast<Event>(event));
+                    }
+                }
+            }
+
+            m_sendTimer.start(SEND_PERIOD);
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void EventStream::send(Event event)
+{
+    const size_t                        JSON_DOC_SIZE   = 384U;
+    StaticJsonDocument<JSON_DOC_SIZE>   jsonDoc;
+    String                              payload;
+    DisplayMgr&                         displayMgr      = DisplayMgr::getInstance();
+
+    switch(event)
+    {
+    case EVENT_SLOT:
+        {
+            uint8_t             slotId  = displayMgr.getActiveSlotId();
+            IPluginMaintenance* plugin  = displayMgr.getPluginInSlot(slotId);
+
+            jsonDoc["slotId"] = slotId;
+
+            if (nullptr != plugin)
+            {
+                jsonDoc["uid"]  = plugin->getUID();
+                jsonDoc["name"] = plugin->getName();
+            }
+        }
+        break;
+
+    case EVENT_BRIGHTNESS:
+        jsonDoc["brightness"]   = (static_cast<uint32_t>(BrightnessCtrl::getInstance().getBrightness()) * 100U + (UINT8_MAX / 2U)) / UINT8_MAX;
+        jsonDoc["automatic"]    = BrightnessCtrl::getInstance().isEnabled();
+        break;
+
+    case EVENT_PLUGINS:
+        {
+            JsonArray   uidArray    = jsonDoc.createNestedArray("uids");
+            uint8_t     slotId      = 0U;
+
+            /* The UID of the installed plugin per slot, 0 for an empty slot. */
+            for(slotId = 0U; slotId < displayMgr.getMaxSlots(); ++slotId)
+            {
+                IPluginMaintenance* plugin = displayMgr.getPluginInSlot(slotId);
+
+                (void)uidArray.add((nullptr == plugin) ? 0U : plugin->getUID());
+            }
+        }
+        break;
+
+    case EVENT_UPDATE:
+        jsonDoc["running"]  = UpdateMgr::getInstance().isUpdateRunning();
+        jsonDoc["progress"] = UpdateMgr::getInstance().getProgress();
+        break;
+
+    default:
+        break;
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+    else
+    {
+        (void)serializeJson(jsonDoc, payload);
+
+        ++m_eventId;
+        m_eventSource.send(payload.c_str(), EVENT_NAMES[event], m_eventId);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
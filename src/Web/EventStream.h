@@ -0,0 +1,170 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Server-sent event stream of state changes
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __EVENT_STREAM_H__
+#define __EVENT_STREAM_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+#include <ESPAsyncWebServer.h>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The event stream publishes compact state change events via server-sent
+ * events (SSE) to all subscribed clients, which replaces polling the REST API.
+ *
+ * Any task notifies a change just by its event type. The payload is
+ * retrieved from the source by the system task, which serializes it once
+ * and sends it to all subscribers. Changes of the same type within a send
+ * period are coalesced to a single event.
+ */
+class EventStream
+{
+public:
+
+    /**
+     * Get the event stream instance.
+     *
+     * @return Event stream
+     */
+    static EventStream& getInstance()
+    {
+        static EventStream instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Event types, which are published.
+     */
+    enum Event
+    {
+        EVENT_SLOT = 0,     /**< Active display slot changed. */
+        EVENT_BRIGHTNESS,   /**< Display brightness or its control changed. */
+        EVENT_PLUGINS,      /**< Plugin installed or uninstalled. */
+        EVENT_UPDATE,       /**< Update state or progress changed. */
+        EVENT_COUNT         /**< Number of event types */
+    };
+
+    /**
+     * Register the event stream at the webserver.
+     *
+     * @param[in] srv   Webserver
+     */
+    void init(AsyncWebServer& srv);
+
+    /**
+     * Notify about a state change. It never blocks and may be called by
+     * any task, but not from interrupt context.
+     *
+     * @param[in] event Event type
+     */
+    void notify(Event event);
+
+    /**
+     * Send the pending events to all subscribers.
+     * It shall be called periodically by the system task, see
+     * ConnectedState::PROCESS_PERIOD.
+     */
+    void process();
+
+    /** URI of the event stream */
+    static const char*      URI;
+
+    /** Min. period in ms between two sends, which coalesces the changes. */
+    static const uint32_t   SEND_PERIOD = 100U;
+
+private:
+
+    AsyncEventSource        m_eventSource;  /**< Server-sent event source with all subscribers */
+    std::atomic<uint32_t>   m_pending;      /**< Pending events, one bit per event type */
+    SimpleTimer             m_sendTimer;    /**< Timer to limit the send rate */
+    uint32_t                m_eventId;      /**< Id of the last sent event */
+
+    /** Event names, used as SSE event field. */
+    static const char*      EVENT_NAMES[EVENT_COUNT];
+
+    /**
+     * Constructs the event stream.
+     */
+    EventStream() :
+        m_eventSource(URI),
+        m_pending(0U),
+        m_sendTimer(),
+        m_eventId(0U)
+    {
+    }
+
+    /**
+     * Destroys the event stream.
+     */
+    ~EventStream()
+    {
+    }
+
+    EventStream(const EventStream& stream);
+    EventStream& operator=(const EventStream& stream);
+
+    /**
+     * Serialize the current state of the event source and send it to all
+     * subscribers.
+     *
+     * @param[in] event Event type
+     */
+    void send(Event event);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __EVENT_STREAM_H__ */
+
+/** @} */
@@ -0,0 +1,449 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  File upload with write-behind buffering
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FileUploader.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool FileUploader::begin(AsyncWebServerRequest* request, const String& filename, const uint8_t* data, size_t len)
+{
+    bool    status      = false;
+    size_t  fileSize    = 0U;
+
+    if (nullptr == request)
+    {
+        m_errorStr = "Invalid request.";
+    }
+    else if (nullptr != m_request)
+    {
+        m_errorStr = "Another upload is running.";
+    }
+    else if (false == validate(filename, data, len, request->contentLength(), fileSize))
+    {
+        ;
+    }
+    else
+    {
+        uint8_t index       = 0U;
+        bool    isAllocated = true;
+
+        for(index = 0U; index < BUFFER_COUNT; ++index)
+        {
+            m_buffers[index]    = new uint8_t[BUFFER_SIZE];
+            m_bufferLen[index]  = 0U;
+            m_isPending[index]  = false;
+
+            if (nullptr == m_buffers[index])
+            {
+                isAllocated = false;
+            }
+        }
+
+        if (false == isAllocated)
+        {
+            m_errorStr = "Out of memory.";
+        }
+        /* The free space is checked before the file is truncated. A existing
+         * file with the same name is replaced, so its space is available too.
+         */
+        else if (false == FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+                    [this, &filename, fileSize]() -> bool
+                    {
+                        size_t  available   = FILESYSTEM.totalBytes() - FILESYSTEM.usedBytes();
+                        bool    isOpen      = false;
+
+                        if (true == FILESYSTEM.exists(filename))
+                        {
+                            File fd = FILESYSTEM.open(filename, "r");
+
+                            if (true == fd)
+                            {
+                                available += fd.size();
+                                fd.close();
+                            }
+                        }
+
+                        if (available < fileSize)
+                        {
+                            m_errorStr = "Not enough free space.";
+                        }
+                        else
+                        {
+                            m_fd = FILESYSTEM.open(filename, "w");
+
+                            if (false == m_fd)
+                            {
+                                m_errorStr = "Couldn't create file.";
+                            }
+                            else
+                            {
+                                isOpen = true;
+                            }
+                        }
+
+                        return isOpen;
+                    }))
+        {
+            ;
+        }
+        else
+        {
+            m_request       = request;
+            m_filename      = filename;
+            m_fillIndex     = 0U;
+            m_isError       = false;
+            m_errorStr      = "";
+            status          = true;
+        }
+
+        if (false == status)
+        {
+            release();
+        }
+    }
+
+    if (false == status)
+    {
+        m_failedRequest = request;
+    }
+    else
+    {
+        m_failedRequest = nullptr;
+    }
+
+    return status;
+}
+
+bool FileUploader::write(const uint8_t* data, size_t len)
+{
+    size_t written = 0U;
+
+    if ((nullptr == m_request) ||
+        (nullptr == data))
+    {
+        return false;
+    }
+
+    while((len > written) && (false == m_isError))
+    {
+        size_t  free        = BUFFER_SIZE - m_bufferLen[m_fillIndex];
+        size_t  chunkSize   = len - written;
+
+        if (free < chunkSize)
+        {
+            chunkSize = free;
+        }
+
+        memcpy(&m_buffers[m_fillIndex][m_bufferLen[m_fillIndex]], &data[written], chunkSize);
+        m_bufferLen[m_fillIndex]    += chunkSize;
+        written                     += chunkSize;
+
+        if (BUFFER_SIZE <= m_bufferLen[m_fillIndex])
+        {
+            flush();
+        }
+    }
+
+    if (true == m_isError)
+    {
+        m_errorStr = "Write failed.";
+    }
+
+    return (false == m_isError);
+}
+
+bool FileUploader::end()
+{
+    bool status = false;
+
+    if (nullptr == m_request)
+    {
+        return false;
+    }
+
+    if (0U < m_bufferLen[m_fillIndex])
+    {
+        flush();
+    }
+
+    waitForAll();
+
+    (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [this]() -> bool
+        {
+            m_fd.close();
+            return true;
+        });
+
+    if (true == m_isError)
+    {
+        m_errorStr      = "Write failed.";
+        m_failedRequest = m_request;
+
+        (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+            [this]() -> bool
+            {
+                return FILESYSTEM.remove(m_filename);
+            });
+    }
+    else
+    {
+        status = true;
+    }
+
+    release();
+
+    return status;
+}
+
+void FileUploader::abort()
+{
+    if (nullptr == m_request)
+    {
+        return;
+    }
+
+    waitForAll();
+
+    /* A incomplete file is worse than no file. */
+    (void)FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [this]() -> bool
+        {
+            m_fd.close();
+            return FILESYSTEM.remove(m_filename);
+        });
+
+    m_failedRequest = m_request;
+    release();
+
+    return;
+}
+
+bool FileUploader::takeFailure(const AsyncWebServerRequest* request)
+{
+    bool isFailed = false;
+
+    if ((nullptr != request) &&
+        (request == m_failedRequest))
+    {
+        m_failedRequest = nullptr;
+        isFailed        = true;
+    }
+
+    return isFailed;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+FileUploader::FileUploader() :
+    m_request(nullptr),
+    m_failedRequest(nullptr),
+    m_filename(),
+    m_fd(),
+    m_buffers(),
+    m_bufferLen(),
+    m_isPending(),
+    m_jobs(),
+    m_requests(),
+    m_fillIndex(0U),
+    m_isError(false),
+    m_errorStr("")
+{
+    uint8_t index = 0U;
+
+    /* The jobs are created once, because they must stay alive until the
+     * I/O task executed them.
+     */
+    for(index = 0U; index < BUFFER_COUNT; ++index)
+    {
+        m_buffers[index]    = nullptr;
+        m_jobs[index]       = [this, index]() -> bool
+        {
+            return (m_bufferLen[index] == m_fd.write(m_buffers[index], m_bufferLen[index]));
+        };
+    }
+}
+
+FileUploader::~FileUploader()
+{
+    abort();
+}
+
+bool FileUploader::validate(const String& filename, const uint8_t* data, size_t len, size_t contentLength, size_t& fileSize)
+{
+    bool status = true;
+
+    /* The content length contains the multipart overhead too. It is used,
+     * until the file itself tells its size.
+     */
+    fileSize = contentLength;
+
+    if (true == filename.endsWith(".bmp"))
+    {
+        if ((nullptr == data) ||
+            (BMP_HEADER_SIZE > len) ||
+            ('B' != data[0]) ||
+            ('M' != data[1]))
+        {
+            m_errorStr  = "Invalid bitmap.";
+            status      = false;
+        }
+        else
+        {
+            /* The bitmap file size is stored little endian. */
+            size_t bmpSize = static_cast<size_t>(data[2]) |
+                             (static_cast<size_t>(data[3]) << 8U) |
+                             (static_cast<size_t>(data[4]) << 16U) |
+                             (static_cast<size_t>(data[5]) << 24U);
+
+            if ((0U < contentLength) &&
+                (contentLength < bmpSize))
+            {
+                m_errorStr  = "Bitmap is truncated.";
+                status      = false;
+            }
+            else
+            {
+                fileSize = bmpSize;
+            }
+        }
+    }
+
+    return status;
+}
+
+void FileUploader::flush()
+{
+    m_isPending[m_fillIndex] = true;
+    FileIo::getInstance().submit(FileIo::PRIORITY_LOW, m_jobs[m_fillIndex], m_requests[m_fillIndex]);
+
+    m_fillIndex = (m_fillIndex + 1U) % BUFFER_COUNT;
+
+    /* Backpressure: The next buffer must be written, before it is filled again. */
+    waitFor(m_fillIndex);
+    m_bufferLen[m_fillIndex] = 0U;
+
+    return;
+}
+
+void FileUploader::waitFor(uint8_t index)
+{
+    if (true == m_isPending[index])
+    {
+        if (false == FileIo::getInstance().wait(m_requests[index]))
+        {
+            m_isError = true;
+        }
+
+        m_isPending[index] = false;
+    }
+
+    return;
+}
+
+void FileUploader::waitForAll()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < BUFFER_COUNT; ++index)
+    {
+        waitFor(index);
+    }
+
+    return;
+}
+
+void FileUploader::release()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < BUFFER_COUNT; ++index)
+    {
+        if (nullptr != m_buffers[index])
+        {
+            delete[] m_buffers[index];
+            m_buffers[index] = nullptr;
+        }
+
+        m_bufferLen[index]  = 0U;
+        m_isPending[index]  = false;
+    }
+
+    m_request = nullptr;
+    m_filename = "";
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,255 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  File upload with write-behind buffering
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __FILE_UPLOADER_H__
+#define __FILE_UPLOADER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+
+#include "FileIo.h"
+#include "FileSystem.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The file uploader streams an uploaded file to the filesystem. The received
+ * data is collected in small buffers, which the filesystem I/O task writes
+ * behind, while the next ones are received. Only if all buffers wait for
+ * their write, the webserver (async TCP) task is blocked. It doesn't
+ * acknowledge further data then, which throttles the sender by its TCP
+ * window.
+ *
+ * A upload is validated as early as possible by the request content length
+ * and the first received bytes, e.g. the bitmap header. A upload, which
+ * doesn't fit into the filesystem, is rejected before anything is written.
+ */
+class FileUploader
+{
+public:
+
+    /** Buffer size in byte, which is written by a single filesystem job. */
+    static const size_t     BUFFER_SIZE         = FileIo::WRITE_CHUNK_SIZE;
+
+    /** Number of buffers, one is received while the others are written. */
+    static const uint8_t    BUFFER_COUNT        = 4U;
+
+    /** Min. number of bytes, which are needed to validate a bitmap header. */
+    static const size_t     BMP_HEADER_SIZE     = 6U;
+
+    /**
+     * Get the file uploader instance.
+     *
+     * @return File uploader
+     */
+    static FileUploader& getInstance()
+    {
+        static FileUploader instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Begin the upload of a file. It is validated by the request content
+     * length and the first received data part.
+     *
+     * @param[in] request   HTTP request
+     * @param[in] filename  Name of the file
+     * @param[in] data      First data part of the file
+     * @param[in] len       Data part size in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool begin(AsyncWebServerRequest* request, const String& filename, const uint8_t* data, size_t len);
+
+    /**
+     * Write the next data part of the file. If all buffers are waiting to be
+     * written, it will wait until one is written.
+     *
+     * @param[in] data  Data
+     * @param[in] len   Data length in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool write(const uint8_t* data, size_t len);
+
+    /**
+     * Write the remaining data and close the file.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool end();
+
+    /**
+     * Abort the upload and remove the incomplete file.
+     */
+    void abort();
+
+    /**
+     * Is a upload of the request running?
+     *
+     * @param[in] request   HTTP request
+     *
+     * @return If the upload is running, it will return true otherwise false.
+     */
+    bool isRunning(const AsyncWebServerRequest* request) const
+    {
+        return ((nullptr != m_request) && (request == m_request));
+    }
+
+    /**
+     * Notify about a disconnected request. If its upload is still running,
+     * it will be aborted.
+     *
+     * @param[in] request   HTTP request
+     */
+    void onDisconnect(const AsyncWebServerRequest* request)
+    {
+        if (true == isRunning(request))
+        {
+            abort();
+        }
+
+        /* The request is destroyed now. */
+        if (request == m_failedRequest)
+        {
+            m_failedRequest = nullptr;
+        }
+    }
+
+    /**
+     * Did the upload of the request fail? The failure is reported only once.
+     *
+     * @param[in] request   HTTP request
+     *
+     * @return If it failed, it will return true otherwise false.
+     */
+    bool takeFailure(const AsyncWebServerRequest* request);
+
+    /**
+     * Get the error reason of the latest failed operation.
+     *
+     * @return Error reason
+     */
+    const char* getErrorStr() const
+    {
+        return m_errorStr;
+    }
+
+private:
+
+    AsyncWebServerRequest*  m_request;                  /**< Request of the running upload, nullptr if none */
+    AsyncWebServerRequest*  m_failedRequest;            /**< Request of the latest failed upload */
+    String                  m_filename;                 /**< Name of the uploaded file */
+    File                    m_fd;                       /**< Uploaded file */
+    uint8_t*                m_buffers[BUFFER_COUNT];    /**< Write-behind buffers */
+    size_t                  m_bufferLen[BUFFER_COUNT];  /**< Number of used bytes per buffer */
+    bool                    m_isPending[BUFFER_COUNT];  /**< Is the buffer waiting to be written? */
+    FileIo::Job             m_jobs[BUFFER_COUNT];       /**< Write job per buffer */
+    FileIo::Request         m_requests[BUFFER_COUNT];   /**< Submitted write job per buffer */
+    uint8_t                 m_fillIndex;                /**< Index of the buffer, which is currently filled */
+    bool                    m_isError;                  /**< Did a write fail? */
+    const char*             m_errorStr;                 /**< Error reason */
+
+    /**
+     * Constructs the file uploader.
+     */
+    FileUploader();
+
+    /**
+     * Destroys the file uploader.
+     */
+    ~FileUploader();
+
+    FileUploader(const FileUploader& uploader);
+    FileUploader& operator=(const FileUploader& uploader);
+
+    /**
+     * Validate the first data part of the file.
+     *
+     * @param[in]   filename        Name of the file
+     * @param[in]   data            First data part of the file
+     * @param[in]   len             Data part size in byte
+     * @param[in]   contentLength   Request content length in byte, 0 if unknown
+     * @param[out]  fileSize        Expected file size in byte, 0 if unknown
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    bool validate(const String& filename, const uint8_t* data, size_t len, size_t contentLength, size_t& fileSize);
+
+    /**
+     * Hand the buffer, which is currently filled, over to the I/O task and
+     * continue with the next one.
+     */
+    void flush();
+
+    /**
+     * Wait until the write of a buffer is finished.
+     *
+     * @param[in] index Buffer index
+     */
+    void waitFor(uint8_t index);
+
+    /**
+     * Wait until all buffers are written.
+     */
+    void waitForAll();
+
+    /**
+     * Release all resources of the upload.
+     */
+    void release();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FILE_UPLOADER_H__ */
+
+/** @} */
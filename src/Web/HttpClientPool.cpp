@@ -0,0 +1,1009 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP client pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HttpClientPool.h"
+#include "HttpStatus.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool HttpClientPool::request(const Request& request)
+{
+    bool    status  = true;
+    uint8_t index   = 0U;
+
+    if (true == request.url.isEmpty())
+    {
+        status = false;
+    }
+    else
+    {
+        lock();
+
+        /* A request of the same owner with the same URL is still queued,
+         * e.g. because the host is slow. Replace it instead of queueing
+         * the same request twice.
+         */
+        while((m_queueLength > index) &&
+              ((request.owner != m_queue[index].owner) || (request.url != m_queue[index].url)))
+        {
+            ++index;
+        }
+
+        if (m_queueLength > index)
+        {
+            removeFromQueue(index);
+        }
+
+        /* A offline host would only block a connection until the
+         * connect timeout.
+         */
+        if (false == isHostAvailable(getHostKey(request.url), false))
+        {
+            dropCacheEntry(request);
+            status = false;
+        }
+        else if (MAX_QUEUED_REQUESTS <= m_queueLength)
+        {
+            LOG_WARNING("Request queue full, %s skipped.", request.url.c_str());
+
+            /* The owner shows the error, so the next response must be
+             * provided in any case.
+             */
+            dropCacheEntry(request);
+
+            status = false;
+        }
+        else
+        {
+            /* Requests with the same priority keep their order. */
+            index = m_queueLength;
+
+            while((0U < index) &&
+                  (request.priority > m_queue[index - 1U].priority))
+            {
+                m_queue[index] = m_queue[index - 1U];
+                --index;
+            }
+
+            m_queue[index] = request;
+            ++m_queueLength;
+
+            /* The request is sent by the display task, which avoids that
+             * callbacks are called in the context of the caller.
+             */
+            m_dispatchTimer.start(0U);
+        }
+
+        unlock();
+    }
+
+    return status;
+}
+
+void HttpClientPool::abort(const void* owner)
+{
+    uint8_t index = 0U;
+
+    lock();
+
+    while(m_queueLength > index)
+    {
+        if (owner == m_queue[index].owner)
+        {
+            removeFromQueue(index);
+        }
+        else
+        {
+            ++index;
+        }
+    }
+
+    /* The response of a sent request can't be stopped, but it won't be
+     * provided to the owner anymore.
+     */
+    for(index = 0U; index < MAX_CONNECTIONS; ++index)
+    {
+        Connection& connection = m_connections[index];
+
+        if ((true == connection.isBusy) &&
+            (owner == connection.request.owner))
+        {
+            connection.request.onResponse   = nullptr;
+            connection.request.onError      = nullptr;
+            connection.request.onBody       = nullptr;
+            connection.request.onUnchanged  = nullptr;
+            connection.request.onPipelinedResponse = nullptr;
+        }
+    }
+
+    for(index = 0U; index < MAX_CACHE_ENTRIES; ++index)
+    {
+        if (owner == m_cache[index].owner)
+        {
+            m_cache[index] = CacheEntry();
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+uint8_t HttpClientPool::getHostInfos(HostInfo* infos, uint8_t maxCount)
+{
+    const uint32_t  NOW     = millis();
+    uint8_t         count   = 0U;
+    uint8_t         index   = 0U;
+
+    if (nullptr != infos)
+    {
+        lock();
+
+        for(index = 0U; (index < MAX_HOSTS) && (count < maxCount); ++index)
+        {
+            const Host& host = m_hosts[index];
+
+            if (false == host.hostKey.isEmpty())
+            {
+                HostInfo& info = infos[count];
+
+                info.host       = getHostName(host.hostKey);
+                info.state      = host.state;
+                info.failures   = host.failures;
+                info.retryIn    = 0U;
+
+                if ((HOST_STATE_OFFLINE == host.state) &&
+                    (0 < static_cast<int32_t>(host.retryTimestamp - NOW)))
+                {
+                    info.retryIn = host.retryTimestamp - NOW;
+                }
+
+                ++count;
+            }
+        }
+
+        unlock();
+    }
+
+    return count;
+}
+
+void HttpClientPool::onTimeout(EventTimer& timer)
+{
+    if (&m_dispatchTimer == &timer)
+    {
+        dispatch();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+HttpClientPool::HttpClientPool() :
+    m_connections(),
+    m_hosts(),
+    m_cache(),
+    m_cacheNext(0U),
+    m_queue(),
+    m_queueLength(0U),
+    m_xMutex(xSemaphoreCreateRecursiveMutex()),
+    m_dispatchTimer(*this)
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_CONNECTIONS; ++index)
+    {
+        Connection& connection = m_connections[index];
+
+        connection.isBusy       = false;
+        connection.isReusable   = false;
+
+        /* Required for the response cache validation. */
+        (void)connection.client.addHeaderInterest("ETag");
+        (void)connection.client.addHeaderInterest("Last-Modified");
+
+        connection.client.regOnResponse([this, index](const HttpResponse& rsp)
+                                        {
+                                            onResponse(index, rsp);
+                                        });
+
+        connection.client.regOnClosed(  [this, index]()
+                                        {
+                                            onClosed(index);
+                                        });
+
+        connection.client.regOnError(   [this, index]()
+                                        {
+                                            onClosed(index);
+                                        });
+    }
+}
+
+HttpClientPool::~HttpClientPool()
+{
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+void HttpClientPool::dispatch()
+{
+    bool    isConnectionAvailable   = true;
+    OnError onError                 = nullptr;
+
+    do
+    {
+        onError = nullptr;
+
+        lock();
+
+        if (0U == m_queueLength)
+        {
+            isConnectionAvailable = false;
+        }
+        else
+        {
+            const String    HOST_KEY    = getHostKey(m_queue[0U].url);
+            uint8_t         index       = MAX_CONNECTIONS;
+
+            /* The host went offline or is probed by another request,
+             * since the request was queued.
+             */
+            if (false == isHostAvailable(HOST_KEY, false))
+            {
+                onError = m_queue[0U].onError;
+
+                dropCacheEntry(m_queue[0U]);
+                removeFromQueue(0U);
+            }
+            /* All connections busy? The request stays queued, until one
+             * of them gets available.
+             */
+            else if (MAX_CONNECTIONS <= (index = selectConnection(HOST_KEY)))
+            {
+                isConnectionAvailable = false;
+            }
+            else
+            {
+                Connection& connection = m_connections[index];
+
+                connection.request = m_queue[0U];
+                removeFromQueue(0U);
+
+                /* Starts probing a offline host. */
+                (void)isHostAvailable(HOST_KEY, true);
+
+                if (false == send(index))
+                {
+                    LOG_WARNING("Request %s failed.", connection.request.url.c_str());
+
+                    updateHost(HOST_KEY, false);
+
+                    onError = connection.request.onError;
+
+                    /* The owner shows the error, so the next response
+                     * must be provided in any case.
+                     */
+                    dropCacheEntry(connection.request);
+
+                    connection.isBusy       = false;
+                    connection.isReusable   = false;
+                    connection.request      = Request();
+                }
+                else
+                {
+                    connection.hostKey = HOST_KEY;
+                }
+            }
+        }
+
+        unlock();
+
+        /* The owner is notified without lock, which allows it to queue
+         * a new request.
+         */
+        if (nullptr != onError)
+        {
+            onError();
+        }
+    }
+    while(true == isConnectionAvailable);
+
+    return;
+}
+
+uint8_t HttpClientPool::selectConnection(const String& hostKey)
+{
+    uint8_t index       = 0U;
+    uint8_t alive       = MAX_CONNECTIONS;
+    uint8_t closed      = MAX_CONNECTIONS;
+    uint8_t other       = MAX_CONNECTIONS;
+    uint8_t selected    = MAX_CONNECTIONS;
+
+    for(index = 0U; index < MAX_CONNECTIONS; ++index)
+    {
+        Connection& connection = m_connections[index];
+
+        if (true == connection.isBusy)
+        {
+            ;
+        }
+        else if ((true == connection.isReusable) &&
+                 (hostKey == connection.hostKey) &&
+                 (true == connection.client.isConnected()))
+        {
+            alive = index;
+        }
+        else if (true == connection.client.isDisconnected())
+        {
+            closed = index;
+        }
+        else
+        {
+            other = index;
+        }
+    }
+
+    if (MAX_CONNECTIONS > alive)
+    {
+        selected = alive;
+    }
+    else if (MAX_CONNECTIONS > closed)
+    {
+        selected = closed;
+    }
+    else if (MAX_CONNECTIONS > other)
+    {
+        /* The connection is alive to a different host or can't be reused.
+         * Close it to get the socket free for the request.
+         */
+        m_connections[other].isReusable = false;
+        m_connections[other].client.end();
+
+        selected = other;
+    }
+    else
+    {
+        ;
+    }
+
+    return selected;
+}
+
+bool HttpClientPool::send(uint8_t index)
+{
+    bool            status      = false;
+    Connection&     connection  = m_connections[index];
+    const Request&  request     = connection.request;
+    uint8_t         parIndex    = 0U;
+    uint8_t         pathIndex   = 0U;
+
+    /* Mark the connection busy before the request is sent, otherwise a
+     * fast response or a connection error would be ignored.
+     */
+    connection.isBusy       = true;
+    connection.isReusable   = false;
+
+    connection.client.setKeepAlive(request.isKeepAlive);
+
+    if (nullptr == request.onBody)
+    {
+        connection.client.regOnBody(nullptr);
+    }
+    else
+    {
+        connection.client.regOnBody([this, index](const uint8_t* data, size_t size)
+                                    {
+                                        onBody(index, data, size);
+                                    });
+    }
+
+    if (true == connection.client.begin(request.url))
+    {
+        /* Ask the host to send the body only if it changed since the
+         * last response. The validators belong to the URL, therefore
+         * pipelined requests are not cached.
+         */
+        if ((true == request.isCached) &&
+            (0U == request.pipelinedCount))
+        {
+            uint8_t cacheIndex = findCacheEntry(request);
+
+            if (MAX_CACHE_ENTRIES > cacheIndex)
+            {
+                const CacheEntry& entry = m_cache[cacheIndex];
+
+                if (false == entry.eTag.isEmpty())
+                {
+                    connection.client.addHeader("If-None-Match", entry.eTag);
+                }
+
+                if (false == entry.lastModified.isEmpty())
+                {
+                    connection.client.addHeader("If-Modified-Since", entry.lastModified);
+                }
+            }
+        }
+
+        if (false == request.range.isEmpty())
+        {
+            connection.client.addHeader("Range", request.range);
+        }
+
+        if (false == request.isPost)
+        {
+            for(pathIndex = 0U; pathIndex < request.pipelinedCount; ++pathIndex)
+            {
+                (void)connection.client.addPipelinedUri(request.pipelinedPaths[pathIndex]);
+            }
+
+            status = connection.client.GET();
+        }
+        else
+        {
+            for(parIndex = 0U; parIndex < request.parCount; ++parIndex)
+            {
+                connection.client.addPar(request.parNames[parIndex], request.parValues[parIndex]);
+            }
+
+            status = connection.client.POST();
+        }
+    }
+
+    return status;
+}
+
+bool HttpClientPool::isHostAvailable(const String& hostKey, bool isSend)
+{
+    bool    isAvailable = true;
+    uint8_t index       = findHost(hostKey);
+
+    if (MAX_HOSTS > index)
+    {
+        Host& host = m_hosts[index];
+
+        if (HOST_STATE_PROBING == host.state)
+        {
+            isAvailable = false;
+        }
+        else if (HOST_STATE_OFFLINE == host.state)
+        {
+            /* Backoff not elapsed yet? */
+            if (0 < static_cast<int32_t>(host.retryTimestamp - millis()))
+            {
+                isAvailable = false;
+            }
+            else if (true == isSend)
+            {
+                host.state = HOST_STATE_PROBING;
+            }
+            else
+            {
+                ;
+            }
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return isAvailable;
+}
+
+void HttpClientPool::updateHost(const String& hostKey, bool isSuccessful)
+{
+    const uint32_t  NOW     = millis();
+    uint8_t         index   = findHost(hostKey);
+
+    /* Track a new host. A free entry is preferred, otherwise the online
+     * host, which wasn't used for the longest time, is replaced.
+     */
+    if (MAX_HOSTS <= index)
+    {
+        uint8_t oldest = MAX_HOSTS;
+
+        index = 0U;
+        while((MAX_HOSTS > index) &&
+              (false == m_hosts[index].hostKey.isEmpty()))
+        {
+            if ((HOST_STATE_ONLINE == m_hosts[index].state) &&
+                ((MAX_HOSTS == oldest) ||
+                 ((NOW - m_hosts[index].lastUsed) > (NOW - m_hosts[oldest].lastUsed))))
+            {
+                oldest = index;
+            }
+
+            ++index;
+        }
+
+        if (MAX_HOSTS <= index)
+        {
+            index = oldest;
+        }
+
+        if (MAX_HOSTS > index)
+        {
+            m_hosts[index]          = Host();
+            m_hosts[index].hostKey  = hostKey;
+            m_hosts[index].state    = HOST_STATE_ONLINE;
+        }
+    }
+
+    if (MAX_HOSTS > index)
+    {
+        Host& host = m_hosts[index];
+
+        host.lastUsed = NOW;
+
+        if (true == isSuccessful)
+        {
+            if (HOST_STATE_ONLINE != host.state)
+            {
+                LOG_INFO("Host %s is online again.", getHostName(hostKey).c_str());
+            }
+
+            host.state      = HOST_STATE_ONLINE;
+            host.failures   = 0U;
+            host.backoff    = 0U;
+        }
+        else
+        {
+            if (UINT8_MAX > host.failures)
+            {
+                ++host.failures;
+            }
+
+            /* A failure of a request, which was sent before the host went
+             * offline, doesn't change the backoff.
+             */
+            if ((FAILURE_THRESHOLD <= host.failures) &&
+                (HOST_STATE_OFFLINE != host.state))
+            {
+                uint32_t delay = 0U;
+
+                /* Failed probe? */
+                if (HOST_STATE_PROBING == host.state)
+                {
+                    host.backoff *= 2U;
+
+                    if (BACKOFF_MAX < host.backoff)
+                    {
+                        host.backoff = BACKOFF_MAX;
+                    }
+                }
+                else
+                {
+                    host.backoff = BACKOFF_MIN;
+
+                    LOG_WARNING("Host %s is offline.", getHostName(hostKey).c_str());
+                }
+
+                /* The jitter avoids that the requests of several hosts
+                 * and owners are in sync.
+                 */
+                delay                   = (host.backoff / 2U) + static_cast<uint32_t>(random((host.backoff / 2U) + 1U));
+                host.state              = HOST_STATE_OFFLINE;
+                host.retryTimestamp     = NOW + delay;
+            }
+        }
+    }
+
+    return;
+}
+
+uint8_t HttpClientPool::findHost(const String& hostKey) const
+{
+    uint8_t index = 0U;
+
+    while((MAX_HOSTS > index) &&
+          ((true == m_hosts[index].hostKey.isEmpty()) || (hostKey != m_hosts[index].hostKey)))
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+uint8_t HttpClientPool::findCacheEntry(const Request& request) const
+{
+    uint8_t index = 0U;
+
+    while((MAX_CACHE_ENTRIES > index) &&
+          ((request.owner != m_cache[index].owner) || (request.url != m_cache[index].url)))
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+bool HttpClientPool::updateCache(const Request& request, const HttpResponse& rsp)
+{
+    bool    isUnchanged = false;
+    uint8_t index       = findCacheEntry(request);
+
+    if (HttpStatus::STATUS_CODE_NOT_MODIFIED == rsp.getStatusCode())
+    {
+        /* Only a host, which got the validators of the cache entry,
+         * responds with 304.
+         */
+        isUnchanged = (MAX_CACHE_ENTRIES > index);
+    }
+    else if (HttpStatus::STATUS_CODE_OK == rsp.getStatusCode())
+    {
+        size_t          size    = 0U;
+        const uint8_t*  payload = rsp.getPayload(size);
+
+        if (MAX_CACHE_ENTRIES <= index)
+        {
+            /* Prefer a free entry, otherwise replace round robin. */
+            index = 0U;
+            while((MAX_CACHE_ENTRIES > index) && (nullptr != m_cache[index].owner))
+            {
+                ++index;
+            }
+
+            if (MAX_CACHE_ENTRIES <= index)
+            {
+                index = m_cacheNext;
+                m_cacheNext = (m_cacheNext + 1U) % MAX_CACHE_ENTRIES;
+            }
+
+            m_cache[index]          = CacheEntry();
+            m_cache[index].owner    = request.owner;
+            m_cache[index].url      = request.url;
+        }
+
+        CacheEntry& entry = m_cache[index];
+
+        entry.eTag          = rsp.getHeader("ETag");
+        entry.lastModified  = rsp.getHeader("Last-Modified");
+
+        /* A streamed body is not available in the response, therefore
+         * only the validators can be used for streamed requests.
+         */
+        if (nullptr != request.onBody)
+        {
+            entry.isHashValid = false;
+        }
+        else
+        {
+            const uint32_t HASH = calcHash(payload, size);
+
+            if ((true == entry.isHashValid) &&
+                (HASH == entry.bodyHash))
+            {
+                isUnchanged = true;
+            }
+
+            entry.bodyHash      = HASH;
+            entry.isHashValid   = true;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return isUnchanged;
+}
+
+void HttpClientPool::dropCacheEntry(const Request& request)
+{
+    uint8_t index = findCacheEntry(request);
+
+    if (MAX_CACHE_ENTRIES > index)
+    {
+        m_cache[index] = CacheEntry();
+    }
+
+    return;
+}
+
+uint32_t HttpClientPool::calcHash(const uint8_t* data, size_t size)
+{
+    const uint32_t  FNV_OFFSET_BASIS    = 2166136261UL;
+    const uint32_t  FNV_PRIME           = 16777619UL;
+    uint32_t        hash                = FNV_OFFSET_BASIS;
+    size_t          index               = 0U;
+
+    if (nullptr != data)
+    {
+        for(index = 0U; index < size; ++index)
+        {
+            hash ^= data[index];
+            hash *= FNV_PRIME;
+        }
+    }
+
+    return hash;
+}
+
+void HttpClientPool::removeFromQueue(uint8_t index)
+{
+    if (m_queueLength > index)
+    {
+        --m_queueLength;
+
+        while(m_queueLength > index)
+        {
+            m_queue[index] = m_queue[index + 1U];
+            ++index;
+        }
+
+        /* Release the request resources, e.g. the captured callbacks. */
+        m_queue[m_queueLength] = Request();
+    }
+
+    return;
+}
+
+void HttpClientPool::onResponse(uint8_t index, const HttpResponse& rsp)
+{
+    OnResponse          onResponse          = nullptr;
+    OnUnchanged         onUnchanged         = nullptr;
+    OnPipelinedResponse onPipelinedResponse = nullptr;
+    uint8_t             rspIndex            = 0U;
+
+    lock();
+
+    if (MAX_CONNECTIONS > index)
+    {
+        Connection& connection = m_connections[index];
+
+        rspIndex = connection.client.getResponseIndex();
+
+        /* The connection stays busy until the response of the last
+         * pipelined request.
+         */
+        if ((true == connection.isBusy) &&
+            (connection.request.pipelinedCount > rspIndex))
+        {
+            onPipelinedResponse = connection.request.onPipelinedResponse;
+        }
+        else if (true == connection.isBusy)
+        {
+            if (0U < connection.request.pipelinedCount)
+            {
+                onPipelinedResponse = connection.request.onPipelinedResponse;
+            }
+            /* Skip the response, if its body is the same as last time.
+             * This saves the owner parsing and updating its view.
+             */
+            else if ((true == connection.request.isCached) &&
+                (true == updateCache(connection.request, rsp)))
+            {
+                onUnchanged = connection.request.onUnchanged;
+            }
+            else
+            {
+                onResponse = connection.request.onResponse;
+            }
+
+            updateHost(connection.hostKey, true);
+
+            /* The client clears keep alive, if the host will close the
+             * connection after the response.
+             */
+            connection.isBusy       = false;
+            connection.isReusable   = connection.client.isKeepAlive();
+            connection.request      = Request();
+        }
+    }
+
+    unlock();
+
+    if (nullptr != onPipelinedResponse)
+    {
+        onPipelinedResponse(rspIndex, rsp);
+    }
+    else if (nullptr != onResponse)
+    {
+        onResponse(rsp);
+    }
+    else if (nullptr != onUnchanged)
+    {
+        onUnchanged();
+    }
+    else
+    {
+        ;
+    }
+
+    m_dispatchTimer.start(0U);
+
+    return;
+}
+
+void HttpClientPool::onBody(uint8_t index, const uint8_t* data, size_t size)
+{
+    OnBody onBody = nullptr;
+
+    lock();
+
+    if ((MAX_CONNECTIONS > index) &&
+        (true == m_connections[index].isBusy))
+    {
+        onBody = m_connections[index].request.onBody;
+    }
+
+    unlock();
+
+    if (nullptr != onBody)
+    {
+        onBody(data, size);
+    }
+
+    return;
+}
+
+void HttpClientPool::onClosed(uint8_t index)
+{
+    OnError onError = nullptr;
+
+    lock();
+
+    if (MAX_CONNECTIONS > index)
+    {
+        Connection& connection = m_connections[index];
+
+        /* Closed before the response was received? */
+        if (true == connection.isBusy)
+        {
+            onError = connection.request.onError;
+
+            /* The owner shows the error, so the next response
+             * must be provided in any case.
+             */
+            dropCacheEntry(connection.request);
+            updateHost(connection.hostKey, false);
+
+            connection.isBusy   = false;
+            connection.request  = Request();
+        }
+
+        connection.isReusable = false;
+    }
+
+    unlock();
+
+    if (nullptr != onError)
+    {
+        onError();
+    }
+
+    m_dispatchTimer.start(0U);
+
+    return;
+}
+
+String HttpClientPool::getHostKey(const String& url)
+{
+    String  hostKey = url;
+    int     begin   = url.indexOf("://");
+
+    if (0 <= begin)
+    {
+        int end = url.indexOf('/', begin + 3);
+
+        if (0 <= end)
+        {
+            hostKey = url.substring(0, end);
+        }
+    }
+
+    return hostKey;
+}
+
+String HttpClientPool::getHostName(const String& hostKey)
+{
+    String  hostName    = hostKey;
+    int     index       = hostName.indexOf("://");
+
+    if (0 <= index)
+    {
+        hostName = hostName.substring(index + 3);
+    }
+
+    /* Never show the credentials. */
+    index = hostName.lastIndexOf('@');
+    if (0 <= index)
+    {
+        hostName = hostName.substring(index + 1);
+    }
+
+    return hostName;
+}
+
+void HttpClientPool::lock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void HttpClientPool::unlock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
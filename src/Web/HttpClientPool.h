@@ -0,0 +1,546 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP client pool
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __HTTP_CLIENT_POOL_H__
+#define __HTTP_CLIENT_POOL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <EventTimer.hpp>
+
+#include "AsyncHttpClient.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The HTTP client pool is shared by all HTTP request users. It limits the
+ * number of concurrent TCP connections and keeps connections alive for
+ * further requests to the same host, if requested. Requests, which can not
+ * be sent immediately, are queued according to their priority.
+ *
+ * The health of every host is tracked. After consecutive failures a host
+ * is considered offline and its requests are rejected immediately, until
+ * a exponential backoff with jitter elapsed. Then a single probe request
+ * decides whether the host is online again.
+ *
+ * Several GET requests to the same host can be combined into one request,
+ * which pipelines them on one connection. Its responses are provided in
+ * the request order.
+ *
+ * The response and error callbacks are called in the context of the TCP
+ * client task or the display task and never with a lock of the pool held.
+ */
+class HttpClientPool : public ITimerListener
+{
+public:
+
+    /**
+     * Prototype of callback for a complete received response.
+     */
+    typedef AsyncHttpClient::OnResponse OnResponse;
+
+    /**
+     * Prototype of callback in case the request failed.
+     */
+    typedef AsyncHttpClient::OnError OnError;
+
+    /**
+     * Prototype of callback for streamed body data.
+     */
+    typedef AsyncHttpClient::OnBody OnBody;
+
+    /**
+     * Prototype of callback in case the resource is unchanged since the
+     * last response.
+     */
+    typedef std::function<void()> OnUnchanged;
+
+    /**
+     * Prototype of callback for a complete received response of a pipelined
+     * request.
+     */
+    typedef std::function<void(uint8_t index, const HttpResponse& rsp)> OnPipelinedResponse;
+
+    /**
+     * Request priorities.
+     */
+    enum Priority
+    {
+        PRIORITY_LOW = 0,   /**< Low priority */
+        PRIORITY_NORMAL,    /**< Normal priority */
+        PRIORITY_HIGH       /**< High priority */
+    };
+
+    /**
+     * Host states.
+     */
+    enum HostState
+    {
+        HOST_STATE_ONLINE = 0,  /**< Host responds */
+        HOST_STATE_OFFLINE,     /**< Host doesn't respond, requests are rejected until the backoff elapsed */
+        HOST_STATE_PROBING      /**< Probe request is pending, further requests are rejected */
+    };
+
+    /**
+     * Health information of a host.
+     */
+    struct HostInfo
+    {
+        String      host;       /**< Host and port, without credentials */
+        HostState   state;      /**< Host state */
+        uint8_t     failures;   /**< Number of consecutive failed requests */
+        uint32_t    retryIn;    /**< Remaining backoff in ms, until the next request is allowed */
+    };
+
+    /**
+     * HTTP request, which is handled by the pool.
+     */
+    struct Request
+    {
+        /** Max. number of URL encoded parameters. */
+        static const uint8_t MAX_PARS = 4U;
+
+        /** Max. number of paths, which are pipelined after the URL. */
+        static const uint8_t MAX_PIPELINED_PATHS = AsyncHttpClient::MAX_PIPELINED_URIS;
+
+        const void* owner;                  /**< Owner of the request, used to abort its requests */
+        Priority    priority;               /**< Request priority */
+        String      url;                    /**< URL */
+        bool        isPost;                 /**< POST (true) or GET (false) request */
+        bool        isKeepAlive;            /**< Keep connection alive after the response? */
+        bool        isCached;               /**< Request conditional and detect unchanged responses? */
+        String      range;                  /**< Requested byte range, e.g. "bytes=0-4095". If empty, the whole resource is requested. */
+        String      parNames[MAX_PARS];     /**< Names of the URL encoded parameters (POST only) */
+        String      parValues[MAX_PARS];    /**< Values of the URL encoded parameters (POST only) */
+        uint8_t     parCount;               /**< Number of URL encoded parameters */
+        String      pipelinedPaths[MAX_PIPELINED_PATHS];    /**< Paths on the host of the URL, which are requested pipelined after the URL (GET only) */
+        uint8_t     pipelinedCount;         /**< Number of pipelined paths */
+        OnResponse  onResponse;             /**< Called for the complete received response */
+        OnError     onError;                /**< Called if the request failed without response */
+        OnBody      onBody;                 /**< If available, the body is streamed to it instead of collected in the response */
+        OnUnchanged onUnchanged;            /**< Called instead of onResponse, if the resource is unchanged (cached requests only) */
+        OnPipelinedResponse onPipelinedResponse;    /**< Called instead of onResponse for every response, if paths are pipelined */
+
+        /**
+         * Constructs a empty GET request with normal priority.
+         */
+        Request() :
+            owner(nullptr),
+            priority(PRIORITY_NORMAL),
+            url(),
+            isPost(false),
+            isKeepAlive(false),
+            isCached(false),
+            range(),
+            parNames(),
+            parValues(),
+            parCount(0U),
+            pipelinedPaths(),
+            pipelinedCount(0U),
+            onResponse(nullptr),
+            onError(nullptr),
+            onBody(nullptr),
+            onUnchanged(nullptr),
+            onPipelinedResponse(nullptr)
+        {
+        }
+
+        /**
+         * Add parameter to request (application/x-www-form-urlencoded).
+         *
+         * @param[in] name  Parameter name
+         * @param[in] value Parameter value
+         *
+         * @return If successful added, it will return true otherwise false.
+         */
+        bool addPar(const String& name, const String& value)
+        {
+            bool status = false;
+
+            if (MAX_PARS > parCount)
+            {
+                parNames[parCount]  = name;
+                parValues[parCount] = value;
+                ++parCount;
+
+                status = true;
+            }
+
+            return status;
+        }
+
+        /**
+         * Clear URL encoded parameters.
+         */
+        void clearPar()
+        {
+            parCount = 0U;
+        }
+
+        /**
+         * Add a path on the host of the URL, which is requested pipelined
+         * after the URL on the same connection. The responses are provided
+         * via onPipelinedResponse in the request order, the one of the URL
+         * with index 0. Pipelined requests are not cached.
+         *
+         * @param[in] path  Path with query, e.g. "/api/v1/getQueue"
+         *
+         * @return If successful added, it will return true otherwise false.
+         */
+        bool addPipelinedPath(const String& path)
+        {
+            bool status = false;
+
+            if (MAX_PIPELINED_PATHS > pipelinedCount)
+            {
+                pipelinedPaths[pipelinedCount] = path;
+                ++pipelinedCount;
+
+                status = true;
+            }
+
+            return status;
+        }
+    };
+
+    /** Max. number of concurrent TCP connections, used by the pool. */
+    static const uint8_t    MAX_CONNECTIONS     = 3U;
+
+    /** Max. number of queued requests. */
+    static const uint8_t    MAX_QUEUED_REQUESTS = 8U;
+
+    /** Max. number of cached responses. */
+    static const uint8_t    MAX_CACHE_ENTRIES   = 8U;
+
+    /** Max. number of hosts, whose health is tracked. */
+    static const uint8_t    MAX_HOSTS           = 8U;
+
+    /** Number of consecutive failed requests, which take a host offline. */
+    static const uint8_t    FAILURE_THRESHOLD   = 2U;
+
+    /** Backoff in ms after a host went offline. */
+    static const uint32_t   BACKOFF_MIN         = (10U * 1000U);
+
+    /** Max. backoff in ms. */
+    static const uint32_t   BACKOFF_MAX         = (5U * 60U * 1000U);
+
+    /**
+     * Get the HTTP client pool instance.
+     *
+     * @return HTTP client pool
+     */
+    static HttpClientPool& getInstance()
+    {
+        static HttpClientPool instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Queue a request. A request with the same owner and URL, which is still
+     * queued, will be replaced. The request is sent as soon as a connection
+     * is available.
+     *
+     * A request to a offline host is rejected, until its backoff elapsed.
+     *
+     * @param[in] request   Request
+     *
+     * @return If the request is queued, it will return true otherwise false.
+     */
+    bool request(const Request& request);
+
+    /**
+     * Abort all requests of the given owner. Queued requests are removed
+     * and the callbacks of sent requests won't be called anymore.
+     * The cached responses of the owner are dropped too.
+     *
+     * @param[in] owner Owner of the requests
+     */
+    void abort(const void* owner);
+
+    /**
+     * Get the health information of all tracked hosts.
+     *
+     * @param[out] infos    Host information
+     * @param[in]  maxCount Max. number of host information
+     *
+     * @return Number of host information
+     */
+    uint8_t getHostInfos(HostInfo* infos, uint8_t maxCount);
+
+    /**
+     * Dispatches the queued requests to the connections.
+     * Will be called by the timer service.
+     *
+     * @param[in] timer Event timer, which timed out
+     */
+    void onTimeout(EventTimer& timer) final;
+
+private:
+
+    /**
+     * A pooled connection.
+     */
+    struct Connection
+    {
+        AsyncHttpClient client;         /**< HTTP client with its TCP connection */
+        bool            isBusy;         /**< Is a request sent and the response pending? */
+        bool            isReusable;     /**< Can the connection be kept for the next request to the same host? */
+        String          hostKey;        /**< Protocol, authorization, host and port of the last request */
+        Request         request;        /**< Sent request */
+    };
+
+    /**
+     * A cached response. Only the validators and a hash of the body are
+     * kept, the body itself is owned by the request owner.
+     */
+    struct CacheEntry
+    {
+        const void*     owner;          /**< Owner of the request, nullptr if the entry is free */
+        String          url;            /**< Request URL */
+        String          eTag;           /**< Entity tag of the last response */
+        String          lastModified;   /**< Last modification date of the last response */
+        uint32_t        bodyHash;       /**< FNV-1a hash of the last response body */
+        bool            isHashValid;    /**< Is the body hash valid? */
+    };
+
+    /**
+     * Health of a host.
+     */
+    struct Host
+    {
+        String          hostKey;        /**< Host key, empty if the entry is free */
+        HostState       state;          /**< Host state */
+        uint8_t         failures;       /**< Number of consecutive failed requests */
+        uint32_t        backoff;        /**< Current backoff in ms, without jitter */
+        uint32_t        retryTimestamp; /**< Timestamp in ms, when the next request is allowed */
+        uint32_t        lastUsed;       /**< Timestamp in ms of the last request result */
+    };
+
+    Connection          m_connections[MAX_CONNECTIONS];     /**< Pooled connections */
+    Host                m_hosts[MAX_HOSTS];                 /**< Health of the hosts */
+    CacheEntry          m_cache[MAX_CACHE_ENTRIES];         /**< Cached responses */
+    uint8_t             m_cacheNext;                        /**< Next cache entry to replace, if the cache is full */
+    Request             m_queue[MAX_QUEUED_REQUESTS];       /**< Queued requests, sorted by priority */
+    uint8_t             m_queueLength;                      /**< Number of queued requests */
+    SemaphoreHandle_t   m_xMutex;                           /**< Mutex to protect against concurrent access. */
+    EventTimer          m_dispatchTimer;                    /**< Timer, used to dispatch the queued requests in the display task. */
+
+    /**
+     * Constructs the HTTP client pool.
+     */
+    HttpClientPool();
+
+    /**
+     * Destroys the HTTP client pool.
+     */
+    ~HttpClientPool();
+
+    /* Prevent copying */
+    HttpClientPool(const HttpClientPool&);
+    HttpClientPool& operator=(const HttpClientPool&);
+
+    /**
+     * Send as much queued requests as connections are available.
+     */
+    void dispatch();
+
+    /**
+     * Select the connection for a request to the given host.
+     * A connection alive to this host is preferred, followed by a
+     * disconnected one.
+     *
+     * @param[in] hostKey   Host key of the request
+     *
+     * @return Connection index or MAX_CONNECTIONS if all connections are busy.
+     */
+    uint8_t selectConnection(const String& hostKey);
+
+    /**
+     * Send the request of the given connection.
+     *
+     * @param[in] index Connection index
+     *
+     * @return If successful sent, it will return true otherwise false.
+     */
+    bool send(uint8_t index);
+
+    /**
+     * Is a request to the host allowed? A offline host, whose backoff
+     * elapsed, allows a single probe request.
+     *
+     * @param[in] hostKey   Host key
+     * @param[in] isSend    Will the request be sent now (true) or only queued (false)?
+     *
+     * @return If allowed, it will return true otherwise false.
+     */
+    bool isHostAvailable(const String& hostKey, bool isSend);
+
+    /**
+     * Update the host health with a request result.
+     *
+     * @param[in] hostKey       Host key
+     * @param[in] isSuccessful  Did the host respond?
+     */
+    void updateHost(const String& hostKey, bool isSuccessful);
+
+    /**
+     * Find the host entry.
+     *
+     * @param[in] hostKey   Host key
+     *
+     * @return Host index or MAX_HOSTS if not found.
+     */
+    uint8_t findHost(const String& hostKey) const;
+
+    /**
+     * Find the cache entry of the given request.
+     *
+     * @param[in] request   Request
+     *
+     * @return Cache entry index or MAX_CACHE_ENTRIES if not found.
+     */
+    uint8_t findCacheEntry(const Request& request) const;
+
+    /**
+     * Update the cache entry of the request with a received response.
+     * A missing entry is created, which may replace the oldest one.
+     *
+     * @param[in] request   Request
+     * @param[in] rsp       Response
+     *
+     * @return If the response body is unchanged, it will return true otherwise false.
+     */
+    bool updateCache(const Request& request, const HttpResponse& rsp);
+
+    /**
+     * Drop the cache entry of the given request, e.g. because the request
+     * failed and the owner shall get the next response in any case.
+     *
+     * @param[in] request   Request
+     */
+    void dropCacheEntry(const Request& request);
+
+    /**
+     * Calculate the FNV-1a hash of the given data.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return Hash
+     */
+    static uint32_t calcHash(const uint8_t* data, size_t size);
+
+    /**
+     * Remove the request from the queue.
+     *
+     * @param[in] index Queue index
+     */
+    void removeFromQueue(uint8_t index);
+
+    /**
+     * Handle a complete received response of a connection.
+     *
+     * @param[in] index Connection index
+     * @param[in] rsp   Response
+     */
+    void onResponse(uint8_t index, const HttpResponse& rsp);
+
+    /**
+     * Handle streamed body data of a connection.
+     *
+     * @param[in] index Connection index
+     * @param[in] data  Body data
+     * @param[in] size  Body data size in byte
+     */
+    void onBody(uint8_t index, const uint8_t* data, size_t size);
+
+    /**
+     * Handle a closed connection or a connection error.
+     *
+     * @param[in] index Connection index
+     */
+    void onClosed(uint8_t index);
+
+    /**
+     * Get the key, which identifies the host of the URL. It consists of
+     * protocol, authorization, host and port.
+     *
+     * @param[in] url   URL
+     *
+     * @return Host key
+     */
+    static String getHostKey(const String& url);
+
+    /**
+     * Get the host and port of the host key, without protocol and
+     * credentials.
+     *
+     * @param[in] hostKey   Host key
+     *
+     * @return Host name
+     */
+    static String getHostName(const String& hostKey);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock();
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __HTTP_CLIENT_POOL_H__ */
+
+/** @} */
\ No newline at end of file
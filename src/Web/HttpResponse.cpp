@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "HttpResponse.h"
 
+#include <MemPolicy.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -62,48 +64,33 @@ HttpResponse& HttpResponse::operator=(const HttpResponse& rsp)
 {
     if (this != &rsp)
     {
-        DLinkedListConstIterator<HttpHeader*>   it(rsp.m_headers);
-
         m_httpVersion   = rsp.m_httpVersion;
         m_statusCode    = rsp.m_statusCode;
         m_reasonPhrase  = rsp.m_reasonPhrase;
 
-        if (nullptr != m_payload)
-        {
-            delete[] m_payload;
-        }
+        clearPayload();
+        m_maxPayloadSize        = rsp.m_maxPayloadSize;
+        m_isPayloadTruncated    = rsp.m_isPayloadTruncated;
 
-        if (nullptr != rsp.m_payload)
+        /* Only the written payload is copied. */
+        if ((nullptr != rsp.m_payload) &&
+            (0U < rsp.m_wrIndex))
         {
-            m_payload = new uint8_t[rsp.m_size];
+            m_payload = static_cast<uint8_t*>(MemPolicy::allocate(MemPolicy::REGION_LARGE, rsp.m_wrIndex));
 
             if (nullptr == m_payload)
             {
-                m_size = 0U;
-                m_wrIndex = 0U;
+                m_isPayloadTruncated = true;
             }
             else
             {
-                memcpy(m_payload, rsp.m_payload, rsp.m_size);
-                m_size = rsp.m_size;
+                memcpy(m_payload, rsp.m_payload, rsp.m_wrIndex);
+                m_size = rsp.m_wrIndex;
                 m_wrIndex = rsp.m_wrIndex;
             }
         }
 
-        if (true == it.first())
-        {
-            do
-            {
-                HttpHeader* header = new HttpHeader;
-
-                if (nullptr != header)
-                {
-                    *header = **it.current();
-                    (void)m_headers.append(header);
-                }
-            }
-            while(true == it.next());
-        }
+        m_headers = rsp.m_headers;
     }
 
     return *this;
@@ -111,9 +98,8 @@ HttpResponse& HttpResponse::operator=(const HttpResponse& rsp)
 
 void HttpResponse::clear()
 {
-    clearHeaders();
+    m_headers.clear();
     clearPayload();
-    m_wrIndex = 0U;
 }
 
 void HttpResponse::addStatusLine(const String& line)
@@ -152,52 +138,74 @@ void HttpResponse::addStatusLine(const String& line)
     m_reasonPhrase  = line.substring(begin);
 }
 
-void HttpResponse::addHeader(const String& line)
+void HttpResponse::addHeader(const char* line, size_t length)
 {
-    HttpHeader* header = new HttpHeader(line);
-
-    if (nullptr != header)
-    {
-        m_headers.append(header);
-    }
+    /* A header field, which is of no interest or doesn't fit, is dropped. */
+    (void)m_headers.add(line, length);
 }
 
-void HttpResponse::extendPayload(size_t size)
+void HttpResponse::setPayloadBuffer(uint8_t* buffer, size_t size)
 {
-    uint8_t* tmp = m_payload;
+    clearPayload();
 
-    m_payload = new uint8_t[m_size + size];
+    m_extBuffer     = buffer;
+    m_extBufferSize = (nullptr == buffer) ? 0U : size;
+}
 
-    if (nullptr != m_payload)
-    {
-        m_size += size;
-    }
+bool HttpResponse::reservePayload(size_t size)
+{
+    size_t required = m_wrIndex + size;
 
-    if ((nullptr != m_payload) &&
-        (nullptr != tmp))
+    if (m_maxPayloadSize < required)
     {
-        memcpy(m_payload, tmp, m_wrIndex);
+        required = m_maxPayloadSize;
     }
 
-    if (nullptr != tmp)
+    if (m_size < required)
     {
-        delete[] tmp;
+        /* A buffer provided by the caller is never reallocated. */
+        if ((nullptr != m_extBuffer) &&
+            ((nullptr == m_payload) || (m_extBuffer == m_payload)))
+        {
+            m_payload   = m_extBuffer;
+            m_size      = (m_maxPayloadSize < m_extBufferSize) ? m_maxPayloadSize : m_extBufferSize;
+        }
+        else
+        {
+            /* The body is not latency critical, therefore it may be located in the PSRAM. */
+            uint8_t* payload = static_cast<uint8_t*>(MemPolicy::reallocate(MemPolicy::REGION_LARGE, m_payload, required));
+
+            /* If it fails, the current payload is kept. */
+            if (nullptr != payload)
+            {
+                m_payload   = payload;
+                m_size      = required;
+            }
+        }
     }
+
+    return ((m_size - m_wrIndex) >= size);
 }
 
 void HttpResponse::addPayload(const uint8_t* payload, size_t size)
 {
-    if ((nullptr == m_payload) ||
-        ((m_size - m_wrIndex) < size))
+    size_t copySize = size;
+
+    if ((m_size - m_wrIndex) < size)
+    {
+        (void)reservePayload(size);
+    }
+
+    if ((m_size - m_wrIndex) < copySize)
     {
-        extendPayload(size);
+        copySize                = m_size - m_wrIndex;
+        m_isPayloadTruncated    = true;
     }
 
-    if ((nullptr != m_payload) &&
-        ((m_size - m_wrIndex) >= size))
+    if (0U < copySize)
     {
-        memcpy(&m_payload[m_wrIndex], payload, size);
-        m_wrIndex += size;
+        memcpy(&m_payload[m_wrIndex], payload, copySize);
+        m_wrIndex += copySize;
     }
 }
 
@@ -216,29 +224,14 @@ String HttpResponse::getReasonPhrase() const
     return m_reasonPhrase;
 }
 
-String HttpResponse::getHeader(const String& name)
+String HttpResponse::getHeader(const String& name) const
 {
-    String                              value;
-    DLinkedListIterator<HttpHeader*>    it(m_headers);
+    String      value;
+    const char* field   = m_headers.find(name.c_str());
 
-    if (true == it.first())
+    if (nullptr != field)
     {
-        HttpHeader* hdr     = nullptr;
-        bool        isFound = false;
-
-        do
-        {
-            hdr = *it.current();
-
-            if ((nullptr != hdr) &&
-                (0U != hdr->getName().equalsIgnoreCase(name)))
-            {
-                value = hdr->getValue();
-                isFound = true;
-            }
-        }
-        while((false == isFound) &&
-                (true == it.next()));
+        value = field;
     }
 
     return value;
@@ -246,7 +239,7 @@ String HttpResponse::getHeader(const String& name)
 
 const uint8_t* HttpResponse::getPayload(size_t& size) const
 {
-    size = m_size;
+    size = m_wrIndex;
     return m_payload;
 }
 
@@ -258,28 +251,22 @@ const uint8_t* HttpResponse::getPayload(size_t& size) const
  * Private Methods
  *****************************************************************************/
 
-void HttpResponse::clearHeaders()
-{
-    DLinkedListIterator<HttpHeader*> it(m_headers);
-
-    while(true == it.first())
-    {
-        HttpHeader* header = *it.current();
-
-        it.remove();
-        delete header;
-    }
-}
-
 void HttpResponse::clearPayload()
 {
     if (nullptr != m_payload)
     {
-        delete[] m_payload;
+        /* A buffer provided by the caller is kept. */
+        if (m_extBuffer != m_payload)
+        {
+            MemPolicy::release(m_payload);
+        }
+
         m_payload = nullptr;
     }
 
-    m_size = 0U;
+    m_size                  = 0U;
+    m_wrIndex               = 0U;
+    m_isPayloadTruncated    = false;
 }
 
 /******************************************************************************
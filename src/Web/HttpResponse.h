@@ -44,9 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <WString.h>
-#include <LinkedList.hpp>
-
-#include "HttpHeader.h"
+#include <HeaderStore.h>
 
 /******************************************************************************
  * Macros
@@ -58,11 +56,18 @@
 
 /**
  * Http response
+ *
+ * The header fields are kept in a arena, which is part of the response.
+ * Register the header fields of interest, to avoid that the arena is
+ * filled up with header fields, which are never evaluated.
  */
 class HttpResponse
 {
 public:
 
+    /** Default max. payload size in byte */
+    static const size_t DEFAULT_MAX_PAYLOAD_SIZE = 64U * 1024U;
+
     /**
      * Construct a empty response.
      */
@@ -73,7 +78,11 @@ public:
         m_headers(),
         m_payload(nullptr),
         m_size(0U),
-        m_wrIndex(0U)
+        m_wrIndex(0U),
+        m_maxPayloadSize(DEFAULT_MAX_PAYLOAD_SIZE),
+        m_isPayloadTruncated(false),
+        m_extBuffer(nullptr),
+        m_extBufferSize(0U)
     {
     }
 
@@ -97,13 +106,18 @@ public:
         m_headers(),
         m_payload(nullptr),
         m_size(0U),
-        m_wrIndex(0U)
+        m_wrIndex(0U),
+        m_maxPayloadSize(DEFAULT_MAX_PAYLOAD_SIZE),
+        m_isPayloadTruncated(false),
+        m_extBuffer(nullptr),
+        m_extBufferSize(0U)
     {
         *this = rsp;
     }
 
     /**
-     * Assign a different response.
+     * Assign a different response. The payload is always copied into
+     * a own buffer, a buffer provided by the caller is not taken over.
      *
      * @param[in] rsp   Response
      *
@@ -112,7 +126,8 @@ public:
     HttpResponse& operator=(const HttpResponse& rsp);
 
     /**
-     * Clear response.
+     * Clear response. The max. payload size and a buffer provided by the
+     * caller are kept.
      */
     void clear();
 
@@ -123,28 +138,81 @@ public:
      */
     void addStatusLine(const String& line);
 
+    /**
+     * Register a header field of interest. If at least one is registered,
+     * all other header fields are dropped during parsing. The interests
+     * survive clearing the response.
+     *
+     * @param[in] name  Field name, case insensitive
+     *
+     * @return If successful registered, it will return true otherwise false.
+     */
+    bool addHeaderInterest(const char* name)
+    {
+        return m_headers.addInterest(name);
+    }
+
     /**
      * Add header during parsing the response.
      *
-     * @param[in] line  Single header line
+     * @param[in] line      Single header line, doesn't need to be terminated.
+     * @param[in] length    Line length in byte
+     */
+    void addHeader(const char* line, size_t length);
+
+    /**
+     * Set the max. payload size. Payload beyond it is dropped and the
+     * payload is marked as truncated.
+     *
+     * @param[in] size  Max. payload size in byte
+     */
+    void setMaxPayloadSize(size_t size)
+    {
+        m_maxPayloadSize = size;
+    }
+
+    /**
+     * Provide a payload buffer, which is used instead of allocating one.
+     * It is never reallocated, therefore its size limits the payload too.
+     * The buffer must exist as long as the response uses it.
+     *
+     * @param[in] buffer    Payload buffer, use nullptr to allocate again.
+     * @param[in] size      Buffer size in byte
      */
-    void addHeader(const String& line);
+    void setPayloadBuffer(uint8_t* buffer, size_t size);
 
     /**
-     * Extend payload size in bytes.
+     * Reserve payload space for the given number of bytes, additional to the
+     * already written payload. The space is limited by the max. payload size.
+     * The buffer is only reallocated, if its remaining space is not enough.
      *
      * @param[in] size  Size in bytes
+     *
+     * @return If the whole space is available, it will return true otherwise false.
      */
-    void extendPayload(size_t size);
+    bool reservePayload(size_t size);
 
     /**
      * Add a complete payload or add it several times partly.
+     * Payload, which doesn't fit, is dropped and the payload is marked as
+     * truncated.
      *
      * @param[in] payload   Complete or partly payload
      * @param[in] size      Payload size in byte
      */
     void addPayload(const uint8_t* payload, size_t size);
 
+    /**
+     * Is the payload truncated, because of its max. size or a
+     * allocation failure?
+     *
+     * @return If truncated, it will return true otherwise false.
+     */
+    bool isPayloadTruncated() const
+    {
+        return m_isPayloadTruncated;
+    }
+
     /**
      * Get HTTP version.
      *
@@ -171,12 +239,12 @@ public:
      *
      * @param[in] name  Field name
      */
-    String getHeader(const String& name);
+    String getHeader(const String& name) const;
 
     /**
      * Get payload.
      *
-     * @param[out] size Payload size in byte
+     * @param[out] size Size of the written payload in byte
      *
      * @return Payload buffer
      */
@@ -187,15 +255,14 @@ private:
     String                      m_httpVersion;  /**< HTTP version */
     uint16_t                    m_statusCode;   /**< Status code */
     String                      m_reasonPhrase; /**< Reason phrase */
-    DLinkedList<HttpHeader*>    m_headers;      /**< List of headers */
-    uint8_t*                    m_payload;      /**< Payload */
-    size_t                      m_size;         /**< Payload size in byte */
-    size_t                      m_wrIndex;      /**< Payload write index */
-
-    /**
-     * Clear headers.
-     */
-    void clearHeaders();
+    HeaderStore                 m_headers;      /**< Headers */
+    uint8_t*                    m_payload;              /**< Payload */
+    size_t                      m_size;                 /**< Payload buffer size in byte */
+    size_t                      m_wrIndex;              /**< Payload write index */
+    size_t                      m_maxPayloadSize;       /**< Max. payload size in byte */
+    bool                        m_isPayloadTruncated;   /**< Is payload truncated? */
+    uint8_t*                    m_extBuffer;            /**< Payload buffer provided by the caller */
+    size_t                      m_extBufferSize;        /**< Size of the payload buffer provided by the caller in byte */
 
     /**
      * Clears the payload.
@@ -0,0 +1,362 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Wifi link quality monitor
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LinkMonitor.h"
+#include "WebSocket.h"
+#include "PowerMgr.h"
+#include "DisplaySync.h"
+#include "ConnectingState.h"
+
+#include <WiFi.h>
+#include <Logging.h>
+#include <Metrics.h>
+#include <lwip/stats.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int32_t getRssi();
+static int32_t getRetransRate();
+static int32_t getPowerSave();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Averaged RSSI, read during export. */
+static MetricGauge      gMetricRssi("pixelix_wifi_rssi_avg_dbm", "Averaged wifi signal strength in dBm.", getRssi);
+
+/** TCP retransmission rate, read during export. */
+static MetricGauge      gMetricRetransRate("pixelix_wifi_tcp_retrans_percent", "TCP retransmission rate in percent.", getRetransRate);
+
+/** Power save mode, read during export. */
+static MetricGauge      gMetricPowerSave("pixelix_wifi_power_save", "Wifi power save mode (1: enabled).", getPowerSave);
+
+/** Number of background scans */
+static MetricCounter    gMetricScans("pixelix_wifi_scans_total", "Number of background scans for a better access point.");
+
+/** Number of roams */
+static MetricCounter    gMetricRoams("pixelix_wifi_roams_total", "Number of roams to a better access point.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void LinkMonitor::begin()
+{
+    m_rssiAvg       = WiFi.RSSI() * RSSI_SCALE;
+    m_retransRate   = 0U;
+    m_badSamples    = 0U;
+    m_isScanning    = false;
+    m_isEnabled     = true;
+
+    (void)getTcpSegments(m_retransSegs, m_outSegs);
+
+    m_sampleTimer.start(SAMPLE_PERIOD);
+    m_scanTimer.stop();
+    m_idleTimer.stop();
+
+    setPowerSave(true);
+
+    return;
+}
+
+void LinkMonitor::end()
+{
+    if (true == m_isScanning)
+    {
+        WiFi.scanDelete();
+        m_isScanning = false;
+    }
+
+    m_sampleTimer.stop();
+    m_scanTimer.stop();
+    m_idleTimer.stop();
+    m_isEnabled = false;
+
+    return;
+}
+
+void LinkMonitor::process()
+{
+    if (true == m_isEnabled)
+    {
+        updatePowerSave();
+
+        if (true == m_sampleTimer.isTimeout())
+        {
+            sample();
+            m_sampleTimer.restart();
+        }
+
+        if (true == m_isScanning)
+        {
+            handleScanResult();
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void LinkMonitor::sample()
+{
+    uint32_t    retransSegs = 0U;
+    uint32_t    outSegs     = 0U;
+
+    /* Exponential moving average, which suppresses single outliers. */
+    m_rssiAvg += ((WiFi.RSSI() * RSSI_SCALE) - m_rssiAvg) / 4;
+
+    if (true == getTcpSegments(retransSegs, outSegs))
+    {
+        uint32_t diffRetransSegs    = retransSegs - m_retransSegs;
+        uint32_t diffOutSegs        = outSegs - m_outSegs;
+
+        if ((0U == diffOutSegs) ||
+            (diffRetransSegs >= diffOutSegs))
+        {
+            m_retransRate = (0U == diffRetransSegs) ? 0U : 100U;
+        }
+        else
+        {
+            m_retransRate = static_cast<uint8_t>((diffRetransSegs * 100U) / diffOutSegs);
+        }
+
+        m_retransSegs   = retransSegs;
+        m_outSegs       = outSegs;
+    }
+
+    if ((BAD_RSSI > getRssi()) ||
+        (BAD_RETRANS_RATE < m_retransRate))
+    {
+        if (BAD_SAMPLES > m_badSamples)
+        {
+            ++m_badSamples;
+        }
+    }
+    else
+    {
+        m_badSamples = 0U;
+    }
+
+    /* Link quality stays bad, look for a better access point. */
+    if ((BAD_SAMPLES <= m_badSamples) &&
+        (false == m_isScanning) &&
+        ((false == m_scanTimer.isTimerRunning()) || (true == m_scanTimer.isTimeout())))
+    {
+        /* Asynchronous scan, the connection is only interrupted for the time per channel. */
+        if (WIFI_SCAN_RUNNING == WiFi.scanNetworks(true, false, false, SCAN_TIME_PER_CHANNEL))
+        {
+            LOG_INFO("Bad link quality (%d dBm, %u %% retrans.), scan for a better access point.", getRssi(), m_retransRate);
+
+            gMetricScans.inc();
+            m_isScanning = true;
+        }
+
+        m_scanTimer.start(SCAN_HOLDOFF);
+        m_badSamples = 0U;
+    }
+
+    return;
+}
+
+bool LinkMonitor::getTcpSegments(uint32_t& retransSegs, uint32_t& outSegs)
+{
+    bool isAvailable = false;
+
+/* The network stack counts the TCP segments only, if its statistics are enabled. */
+#if (0 != LWIP_STATS) && (0 != MIB2_STATS)
+
+    retransSegs = lwip_stats.mib2.tcpretranssegs;
+    outSegs     = lwip_stats.mib2.tcpoutsegs;
+    isAvailable = true;
+
+#else  /* (0 != LWIP_STATS) && (0 != MIB2_STATS) */
+
+    retransSegs = 0U;
+    outSegs     = 0U;
+
+#endif  /* (0 != LWIP_STATS) && (0 != MIB2_STATS) */
+
+    return isAvailable;
+}
+
+void LinkMonitor::handleScanResult()
+{
+    int16_t result = WiFi.scanComplete();
+
+    if (WIFI_SCAN_RUNNING != result)
+    {
+        int16_t         bestIdx     = -1;
+        int32_t         bestRssi    = WiFi.RSSI() + ROAM_RSSI_MARGIN;
+        String          ssid        = WiFi.SSID();
+        const uint8_t*  bssid       = WiFi.BSSID();
+        int16_t         idx         = 0;
+
+        m_isScanning = false;
+
+        for(idx = 0; idx < result; ++idx)
+        {
+            if ((ssid == WiFi.SSID(idx)) &&
+                (bestRssi < WiFi.RSSI(idx)) &&
+                ((nullptr == bssid) || (0 != memcmp(bssid, WiFi.BSSID(idx), ConnectingState::BSSID_SIZE))))
+            {
+                bestIdx     = idx;
+                bestRssi    = WiFi.RSSI(idx);
+            }
+        }
+
+        if (0 > bestIdx)
+        {
+            LOG_INFO("No better access point found.");
+        }
+        else
+        {
+            LOG_INFO("Roam to access point %s (channel %d, %d dBm).", WiFi.BSSIDstr(bestIdx).c_str(), WiFi.channel(bestIdx), bestRssi);
+
+            gMetricRoams.inc();
+
+            /* The connecting state connects to the preferred access point,
+             * after the connection is lost.
+             */
+            ConnectingState::getInstance().setPreferredAccessPoint(WiFi.BSSID(bestIdx), WiFi.channel(bestIdx));
+            (void)WiFi.disconnect();
+        }
+
+        WiFi.scanDelete();
+    }
+
+    return;
+}
+
+void LinkMonitor::updatePowerSave()
+{
+    /* The display sync needs a low latency all the time. */
+    if ((true == PowerMgr::getInstance().isWebActive()) ||
+        (0U < WebSocketSrv::getInstance().getClientCount()) ||
+        (DisplaySync::ROLE_OFF != DisplaySync::getInstance().getRole()))
+    {
+        if (true == m_isPowerSave)
+        {
+            setPowerSave(false);
+        }
+
+        m_idleTimer.start(POWER_SAVE_DELAY);
+    }
+    else if ((false == m_isPowerSave) &&
+             ((false == m_idleTimer.isTimerRunning()) || (true == m_idleTimer.isTimeout())))
+    {
+        setPowerSave(true);
+        m_idleTimer.stop();
+    }
+    else
+    {
+        ;
+    }
+
+    return;
+}
+
+void LinkMonitor::setPowerSave(bool isEnabled)
+{
+    if (false == WiFi.setSleep(isEnabled))
+    {
+        LOG_WARNING("Couldn't set wifi power save mode.");
+    }
+    else
+    {
+        m_isPowerSave = isEnabled;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get averaged RSSI.
+ *
+ * @return RSSI in dBm
+ */
+static int32_t getRssi()
+{
+    return LinkMonitor::getInstance().getRssi();
+}
+
+/**
+ * Get TCP retransmission rate.
+ *
+ * @return Retransmission rate in percent
+ */
+static int32_t getRetransRate()
+{
+    return static_cast<int32_t>(LinkMonitor::getInstance().getRetransRate());
+}
+
+/**
+ * Get power save mode.
+ *
+ * @return 1 if enabled, otherwise 0.
+ */
+static int32_t getPowerSave()
+{
+    return (true == LinkMonitor::getInstance().isPowerSave()) ? 1 : 0;
+}
\ No newline at end of file
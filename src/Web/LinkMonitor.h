@@ -0,0 +1,238 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Wifi link quality monitor
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __LINK_MONITOR_H__
+#define __LINK_MONITOR_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The link monitor samples the quality of the wifi connection. If the
+ * quality stays bad, it scans in the background for a access point of the
+ * same network with a better signal and roams to it.
+ *
+ * Additional it disables the wifi power save mode during webserver and
+ * websocket sessions, which reduces the latency, and enables it when idle.
+ */
+class LinkMonitor
+{
+public:
+
+    /** Sample period in ms */
+    static const uint32_t   SAMPLE_PERIOD           = 2000U;
+
+    /** Below this averaged RSSI in dBm the link quality is bad. */
+    static const int32_t    BAD_RSSI                = -75;
+
+    /** Above this TCP retransmission rate in percent the link quality is bad. */
+    static const uint8_t    BAD_RETRANS_RATE        = 10U;
+
+    /** Number of consecutive bad samples, until a scan for a better access point starts. */
+    static const uint8_t    BAD_SAMPLES             = 5U;
+
+    /** Min. time in ms between two scans. */
+    static const uint32_t   SCAN_HOLDOFF            = (5U * 60U * 1000U);
+
+    /** Max. scan time per channel in ms, which limits the interruption of the connection. */
+    static const uint32_t   SCAN_TIME_PER_CHANNEL   = 120U;
+
+    /** A access point must be this much stronger in dB, before it roams. */
+    static const int32_t    ROAM_RSSI_MARGIN        = 8;
+
+    /** Time in ms after the last session activity, until the power save mode is enabled. */
+    static const uint32_t   POWER_SAVE_DELAY        = 30000U;
+
+    /**
+     * Get link monitor instance.
+     *
+     * @return Link monitor instance
+     */
+    static LinkMonitor& getInstance()
+    {
+        static LinkMonitor instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start monitoring the established connection.
+     */
+    void begin();
+
+    /**
+     * Stop monitoring.
+     */
+    void end();
+
+    /**
+     * Process the link monitor. Call it periodically, as long as the
+     * connection is established.
+     */
+    void process();
+
+    /**
+     * Get the averaged RSSI.
+     *
+     * @return RSSI in dBm
+     */
+    int32_t getRssi() const
+    {
+        return m_rssiAvg / RSSI_SCALE;
+    }
+
+    /**
+     * Get the TCP retransmission rate of the latest sample.
+     *
+     * @return Retransmission rate in percent
+     */
+    uint8_t getRetransRate() const
+    {
+        return m_retransRate;
+    }
+
+    /**
+     * Is the wifi power save mode enabled?
+     *
+     * @return If enabled, it will return true otherwise false.
+     */
+    bool isPowerSave() const
+    {
+        return m_isPowerSave;
+    }
+
+private:
+
+    /** Scale of the averaged RSSI, which increases the resolution of the average. */
+    static const int32_t    RSSI_SCALE              = 16;
+
+    bool            m_isEnabled;        /**< Is the monitor enabled? */
+    SimpleTimer     m_sampleTimer;      /**< Timer for sampling the link quality */
+    SimpleTimer     m_scanTimer;        /**< Timer, which holds off the next scan */
+    SimpleTimer     m_idleTimer;        /**< Timer, which delays the power save mode after a session */
+    int32_t         m_rssiAvg;          /**< Averaged RSSI in dBm, scaled by RSSI_SCALE */
+    uint8_t         m_retransRate;      /**< TCP retransmission rate of the latest sample in percent */
+    uint32_t        m_retransSegs;      /**< Number of retransmitted TCP segments at the latest sample */
+    uint32_t        m_outSegs;          /**< Number of sent TCP segments at the latest sample */
+    uint8_t         m_badSamples;       /**< Number of consecutive bad samples */
+    bool            m_isScanning;       /**< Is a background scan running? */
+    bool            m_isPowerSave;      /**< Is the power save mode enabled? */
+
+    /**
+     * Constructs the link monitor.
+     */
+    LinkMonitor() :
+        m_isEnabled(false),
+        m_sampleTimer(),
+        m_scanTimer(),
+        m_idleTimer(),
+        m_rssiAvg(0),
+        m_retransRate(0U),
+        m_retransSegs(0U),
+        m_outSegs(0U),
+        m_badSamples(0U),
+        m_isScanning(false),
+        m_isPowerSave(true)
+    {
+    }
+
+    /**
+     * Destroys the link monitor.
+     */
+    ~LinkMonitor()
+    {
+        /* Will never be called. */
+    }
+
+    LinkMonitor(const LinkMonitor& monitor);
+    LinkMonitor& operator=(const LinkMonitor& monitor);
+
+    /**
+     * Sample the link quality and start a scan, if it stays bad.
+     */
+    void sample();
+
+    /**
+     * Get the TCP segment counters of the network stack.
+     *
+     * @param[out] retransSegs  Number of retransmitted TCP segments
+     * @param[out] outSegs      Number of sent TCP segments
+     *
+     * @return If the network stack provides them, it will return true otherwise false.
+     */
+    static bool getTcpSegments(uint32_t& retransSegs, uint32_t& outSegs);
+
+    /**
+     * Roam to a better access point of the scan result, if there is one.
+     */
+    void handleScanResult();
+
+    /**
+     * Enable or disable the power save mode according to the session activity.
+     */
+    void updatePowerSave();
+
+    /**
+     * Enable or disable the power save mode.
+     *
+     * @param[in] isEnabled Enable (true) or disable (false)
+     */
+    void setPowerSave(bool isEnabled);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LINK_MONITOR_H__ */
+
+/** @} */
\ No newline at end of file
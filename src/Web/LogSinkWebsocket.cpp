@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "LogSinkWebsocket.h"
 
+#include <string.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -58,31 +60,90 @@
  * Public Methods
  *****************************************************************************/
 
+bool LogSinkWebsocket::begin()
+{
+    bool status = true;
+
+    if (nullptr == m_taskHandle)
+    {
+        BaseType_t osRet = xTaskCreateUniversal(senderTask,
+                                                "logSinkWsTask",
+                                                TASK_STACK_SIZE,
+                                                this,
+                                                TASK_PRIORITY,
+                                                &m_taskHandle,
+                                                TASK_RUN_CORE);
+
+        /* Task not created? */
+        if (pdPASS != osRet)
+        {
+            m_taskHandle    = nullptr;
+            status          = false;
+        }
+    }
+
+    return status;
+}
+
 void LogSinkWebsocket::send(const Logging::Msg& msg)
 {
-    if (nullptr != m_output)
+    uint32_t    pos     = m_writeIdx.load(std::memory_order_relaxed);
+    Entry*      entry   = nullptr;
+
+    if (nullptr == m_output)
+    {
+        return;
+    }
+
+    /* Reserve a entry in the ring buffer. Multiple producers compete for it,
+     * but a producer never waits for the sender task.
+     */
+    while(nullptr == entry)
     {
-        String      buffer;
-        const char  DELIMITER = ';';
-
-        buffer += "EVT";
-        buffer += DELIMITER;
-        buffer += msg.timestamp;
-        buffer += DELIMITER;
-        buffer += msg.level;
-        buffer += DELIMITER;
-        buffer += '"';
-        buffer += msg.filename;
-        buffer += '"';
-        buffer += DELIMITER;
-        buffer += msg.line;
-        buffer += DELIMITER;
-        buffer += '"';
-        buffer += msg.str;
-        buffer += '"';
-
-        (void)m_output->print(buffer);
+        Entry*      candidate   = &m_ring[pos & (RING_SIZE - 1U)];
+        uint32_t    seq         = candidate->seq.load(std::memory_order_acquire);
+        int32_t     diff        = static_cast<int32_t>(seq - pos);
+
+        /* Entry is free? */
+        if (0 == diff)
+        {
+            if (true == m_writeIdx.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+            {
+                entry = candidate;
+            }
+        }
+        /* Ring buffer is full? */
+        else if (0 > diff)
+        {
+            (void)m_dropped.fetch_add(1U, std::memory_order_relaxed);
+            return;
+        }
+        /* Another producer was faster. */
+        else
+        {
+            pos = m_writeIdx.load(std::memory_order_relaxed);
+        }
     }
+
+    entry->timestamp    = msg.timestamp;
+    entry->level        = msg.level;
+    entry->filename     = msg.filename;
+    entry->line         = msg.line;
+
+    if (nullptr == msg.str)
+    {
+        entry->str[0] = '\0';
+    }
+    else
+    {
+        strncpy(entry->str, msg.str, sizeof(entry->str) - 1U);
+        entry->str[sizeof(entry->str) - 1U] = '\0';
+    }
+
+    /* Publish the entry to the sender task. */
+    entry->seq.store(pos + 1U, std::memory_order_release);
+
+    return;
 }
 
 /******************************************************************************
@@ -93,6 +154,111 @@ void LogSinkWebsocket::send(const Logging::Msg& msg)
  * Private Methods
  *****************************************************************************/
 
+void LogSinkWebsocket::senderTask(void* parameters)
+{
+    LogSinkWebsocket* sink = reinterpret_cast<LogSinkWebsocket*>(parameters);
+
+    if (nullptr != sink)
+    {
+        const TickType_t    SEND_PERIOD_TICKS   = pdMS_TO_TICKS(SEND_PERIOD);
+        TickType_t          lastWakeTime        = xTaskGetTickCount();
+
+        while(true)
+        {
+            sink->sendPending();
+            vTaskDelayUntil(&lastWakeTime, SEND_PERIOD_TICKS);
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void LogSinkWebsocket::sendPending()
+{
+    String      frame;
+    uint8_t     count   = 0U;
+    uint32_t    dropped = 0U;
+
+    if (nullptr == m_output)
+    {
+        return;
+    }
+
+    /* If no client is connected, the log messages stay in the ring buffer
+     * until it overflows. A slow client doesn't stop the others, because
+     * the websocket server drops its oldest frames.
+     */
+    if (0U == m_output->getClientCount())
+    {
+        return;
+    }
+
+    dropped = m_dropped.exchange(0U, std::memory_order_relaxed);
+
+    if (0U < dropped)
+    {
+        String str = String(dropped) + " log messages dropped.";
+
+        appendMsg(frame, millis(), Logging::LOGLEVEL_WARNING, "LogSinkWebsocket.cpp", __LINE__, str.c_str());
+        ++count;
+    }
+
+    while(MAX_MSGS_PER_FRAME > count)
+    {
+        Entry*      entry   = &m_ring[m_readIdx & (RING_SIZE - 1U)];
+        uint32_t    seq     = entry->seq.load(std::memory_order_acquire);
+
+        /* No further log message available? */
+        if ((m_readIdx + 1U) != seq)
+        {
+            break;
+        }
+
+        appendMsg(frame, entry->timestamp, entry->level, entry->filename, entry->line, entry->str);
+        ++count;
+
+        /* Give the entry back to the producers. */
+        entry->seq.store(m_readIdx + RING_SIZE, std::memory_order_release);
+        ++m_readIdx;
+    }
+
+    if (0U < count)
+    {
+        (void)m_output->broadcast(reinterpret_cast<const uint8_t*>(frame.c_str()), frame.length(), false);
+    }
+
+    return;
+}
+
+void LogSinkWebsocket::appendMsg(String& frame, uint32_t timestamp, Logging::LogLevel level, const char* filename, int line, const char* str)
+{
+    const char  DELIMITER = ';';
+
+    /* Several log messages in one frame are separated by a line feed. */
+    if (0U < frame.length())
+    {
+        frame += '\n';
+    }
+
+    frame += "EVT";
+    frame += DELIMITER;
+    frame += timestamp;
+    frame += DELIMITER;
+    frame += level;
+    frame += DELIMITER;
+    frame += '"';
+    frame += filename;
+    frame += '"';
+    frame += DELIMITER;
+    frame += line;
+    frame += DELIMITER;
+    frame += '"';
+    frame += str;
+    frame += '"';
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -43,6 +43,7 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
+#include <atomic>
 #include "Logging.h"
 #include "WebSocket.h"
 
@@ -56,6 +57,13 @@
 
 /**
  * Websocket log sink.
+ *
+ * The log messages are not sent in the context of the caller. They are stored
+ * in a lock-free ring buffer, which is drained by a sender task. The sender
+ * task sends several log messages at once in a single websocket frame, with
+ * a limited frame rate. If the ring buffer is full, the log message is dropped
+ * and counted. The number of dropped log messages is reported with the next
+ * frame.
  */
 class LogSinkWebsocket : public LogSink
 {
@@ -66,9 +74,14 @@ public:
      */
     LogSinkWebsocket() :
         m_name(),
-        m_output(nullptr)
+        m_output(nullptr),
+        m_ring(),
+        m_writeIdx(0U),
+        m_readIdx(0U),
+        m_dropped(0U),
+        m_taskHandle(nullptr)
     {
-
+        initRing();
     }
 
     /**
@@ -79,8 +92,14 @@ public:
      */
     LogSinkWebsocket(const String& name, WebSocketSrv* output) :
         m_name(name),
-        m_output(output)
+        m_output(output),
+        m_ring(),
+        m_writeIdx(0U),
+        m_readIdx(0U),
+        m_dropped(0U),
+        m_taskHandle(nullptr)
     {
+        initRing();
     }
 
     /**
@@ -90,6 +109,23 @@ public:
     {
     }
 
+    /**
+     * Start the sender task.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Get the number of dropped log messages, which are not reported yet.
+     *
+     * @return Number of dropped log messages
+     */
+    uint32_t getDroppedCount() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
     /**
      * Get websocket.
      *
@@ -137,13 +173,87 @@ public:
      */
     void send(const Logging::Msg& msg) final;
 
+    /** Number of log messages in the ring buffer. Must be a power of 2. */
+    static const uint32_t   RING_SIZE           = 16U;
+
+    /** Period in ms, in which the log messages are sent. It limits the frame rate. */
+    static const uint32_t   SEND_PERIOD         = 100U;
+
+    /** Max. number of log messages per websocket frame. */
+    static const uint8_t    MAX_MSGS_PER_FRAME  = 8U;
+
 private:
 
-    String          m_name;     /**< Name of the sink */
-    WebSocketSrv*   m_output;   /**< Log sink output */
+    /** Sender task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 3072U;
+
+    /** Sender task priority */
+    static const UBaseType_t    TASK_PRIORITY       = 1U;
+
+    /** Sender task runs on the application core. */
+    static const BaseType_t     TASK_RUN_CORE       = 1;
+
+    /**
+     * A log message in the ring buffer.
+     * The sequence number synchronizes the producers with the sender task.
+     */
+    struct Entry
+    {
+        std::atomic<uint32_t>   seq;                                /**< Sequence number */
+        uint32_t                timestamp;                          /**< Timestamp in ms */
+        Logging::LogLevel       level;                              /**< Log level */
+        const char*             filename;                           /**< File name */
+        int                     line;                               /**< Line number */
+        char                    str[Logging::MESSAGE_BUFFER_SIZE];  /**< Message text */
+    };
+
+    String                  m_name;             /**< Name of the sink */
+    WebSocketSrv*           m_output;           /**< Log sink output */
+    Entry                   m_ring[RING_SIZE];  /**< Ring buffer with log messages */
+    std::atomic<uint32_t>   m_writeIdx;         /**< Write index of the producers */
+    uint32_t                m_readIdx;          /**< Read index of the sender task */
+    std::atomic<uint32_t>   m_dropped;          /**< Number of dropped log messages */
+    TaskHandle_t            m_taskHandle;       /**< Sender task handle */
 
     LogSinkWebsocket(const LogSinkWebsocket& sink);
     LogSinkWebsocket& operator=(const LogSinkWebsocket& sink);
+
+    /**
+     * Initialize the sequence numbers of the ring buffer.
+     */
+    void initRing()
+    {
+        uint32_t index = 0U;
+
+        for(index = 0U; index < RING_SIZE; ++index)
+        {
+            m_ring[index].seq.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Sender task, which sends the log messages from the ring buffer.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void senderTask(void* parameters);
+
+    /**
+     * Send the log messages from the ring buffer in one websocket frame.
+     */
+    void sendPending();
+
+    /**
+     * Append a log message to the websocket frame.
+     *
+     * @param[in,out]   frame       Websocket frame
+     * @param[in]       timestamp   Timestamp in ms
+     * @param[in]       level       Log level
+     * @param[in]       filename    File name
+     * @param[in]       line        Line number
+     * @param[in]       str         Message text
+     */
+    void appendMsg(String& frame, uint32_t timestamp, Logging::LogLevel level, const char* filename, int line, const char* str);
 };
 
 /******************************************************************************
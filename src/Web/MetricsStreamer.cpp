@@ -0,0 +1,318 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Metrics streamer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MetricsStreamer.h"
+#include "DisplayMgr.h"
+#include "MemMon.h"
+#include "NetMon.h"
+
+#include <Logging.h>
+#include <MonoTime.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool MetricsStreamer::subscribe(uint32_t clientId, uint32_t period)
+{
+    bool    status  = false;
+    uint8_t index   = 0U;
+    uint8_t freeIdx = MAX_SUBSCRIBERS;
+    uint8_t usedIdx = MAX_SUBSCRIBERS;
+
+    if ((nullptr == m_xMutex) ||
+        (MIN_PERIOD > period) ||
+        (MAX_PERIOD < period))
+    {
+        return false;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        if (false == m_subscribers[index].isUsed)
+        {
+            if (MAX_SUBSCRIBERS == freeIdx)
+            {
+                freeIdx = index;
+            }
+        }
+        else if (clientId == m_subscribers[index].clientId)
+        {
+            usedIdx = index;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    /* Client not subscribed yet? */
+    if (MAX_SUBSCRIBERS == usedIdx)
+    {
+        usedIdx = freeIdx;
+    }
+
+    if (MAX_SUBSCRIBERS > usedIdx)
+    {
+        Subscriber& subscriber = m_subscribers[usedIdx];
+
+        subscriber.isUsed       = true;
+        subscriber.clientId     = clientId;
+        subscriber.period       = period;
+        subscriber.timestamp    = MonoTime::getMillis() - period;
+
+        status = true;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return status;
+}
+
+void MetricsStreamer::unsubscribe(uint32_t clientId)
+{
+    uint8_t index = 0U;
+
+    if (nullptr == m_xMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        if ((true == m_subscribers[index].isUsed) &&
+            (clientId == m_subscribers[index].clientId))
+        {
+            m_subscribers[index].isUsed = false;
+        }
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+void MetricsStreamer::process(AsyncWebSocket& server)
+{
+    uint8_t     index       = 0U;
+    size_t      frameSize   = 0U;
+    uint32_t    timestamp   = MonoTime::getMillis();
+
+    if (nullptr == m_xMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        Subscriber& subscriber = m_subscribers[index];
+
+        if ((true == subscriber.isUsed) &&
+            (subscriber.period <= (timestamp - subscriber.timestamp)))
+        {
+            AsyncWebSocketClient* client = server.client(subscriber.clientId);
+
+            /* Client gone in the meantime? */
+            if (nullptr == client)
+            {
+                subscriber.isUsed = false;
+            }
+            /* If the client can't keep up, skip the snapshot. */
+            else if (true == client->queueIsFull())
+            {
+                ;
+            }
+            else
+            {
+                /* Sample the metrics only once for all subscribers. */
+                if (0U == frameSize)
+                {
+                    frameSize = sample(timestamp);
+                }
+
+                client->binary(m_buffer, frameSize);
+                subscriber.timestamp = timestamp;
+            }
+        }
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+MetricsStreamer::MetricsStreamer() :
+    m_xMutex(xSemaphoreCreateMutex()),
+    m_subscribers(),
+    m_buffer()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_SUBSCRIBERS; ++index)
+    {
+        m_subscribers[index].isUsed = false;
+    }
+
+    if (nullptr == m_xMutex)
+    {
+        LOG_ERROR("Couldn't create metrics streamer mutex.");
+    }
+}
+
+MetricsStreamer::~MetricsStreamer()
+{
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+size_t MetricsStreamer::sample(uint32_t timestamp)
+{
+    DisplayMgr&             displayMgr  = DisplayMgr::getInstance();
+    uint8_t                 slotCnt     = displayMgr.getMaxSlots();
+    uint8_t                 slotId      = 0U;
+    size_t                  offset      = 2U;
+    DisplayMgr::Statistics  statistics;
+    MemMon::RegionStat      heapStat;
+    NetMon::Stat            netStat;
+
+    if (MAX_SLOT_ENTRIES < slotCnt)
+    {
+        slotCnt = MAX_SLOT_ENTRIES;
+    }
+
+    displayMgr.getStatistics(statistics);
+    NetMon::getInstance().getStat(netStat);
+
+    if (false == MemMon::getInstance().getRegionStat(MemMon::REGION_INTERNAL, heapStat))
+    {
+        heapStat.free           = 0U;
+        heapStat.largestBlock   = 0U;
+    }
+
+    m_buffer[0] = FRAME_TYPE_METRICS;
+    m_buffer[1] = slotCnt;
+
+    offset = putUInt32(offset, timestamp);
+    offset = putUInt32(offset, statistics.frames);
+    offset = putUInt32(offset, statistics.frameTimeUs);
+    offset = putUInt32(offset, statistics.maxFrameTimeUs);
+    offset = putUInt32(offset, statistics.skippedFrames);
+    offset = putUInt32(offset, static_cast<uint32_t>(heapStat.free));
+    offset = putUInt32(offset, static_cast<uint32_t>(heapStat.largestBlock));
+    offset = putUInt16(offset, netStat.tcpPcbUsed);
+    offset = putUInt16(offset, netStat.tcpPcbSize);
+    offset = putUInt16(offset, netStat.pbufPoolUsed);
+    offset = putUInt16(offset, netStat.pbufPoolSize);
+
+    for(slotId = 0U; slotId < slotCnt; ++slotId)
+    {
+        IPluginMaintenance*         plugin  = displayMgr.getPluginInSlot(slotId);
+        DisplayMgr::PluginProfile   profile;
+
+        if (false == displayMgr.getPluginProfile(slotId, profile))
+        {
+            profile.process.avg = 0U;
+            profile.update.avg  = 0U;
+        }
+
+        offset = putUInt16(offset, (nullptr != plugin) ? plugin->getUID() : 0U);
+        offset = putUInt32(offset, profile.process.avg);
+        offset = putUInt32(offset, profile.update.avg);
+    }
+
+    return offset;
+}
+
+size_t MetricsStreamer::putUInt16(size_t offset, uint16_t value)
+{
+    m_buffer[offset + 0U] = static_cast<uint8_t>((value >> 0U) & 0xffU);
+    m_buffer[offset + 1U] = static_cast<uint8_t>((value >> 8U) & 0xffU);
+
+    return offset + 2U;
+}
+
+size_t MetricsStreamer::putUInt32(size_t offset, uint32_t value)
+{
+    m_buffer[offset + 0U] = static_cast<uint8_t>((value >>  0U) & 0xffU);
+    m_buffer[offset + 1U] = static_cast<uint8_t>((value >>  8U) & 0xffU);
+    m_buffer[offset + 2U] = static_cast<uint8_t>((value >> 16U) & 0xffU);
+    m_buffer[offset + 3U] = static_cast<uint8_t>((value >> 24U) & 0xffU);
+
+    return offset + 4U;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,206 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Metrics streamer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __METRICSSTREAMER_H__
+#define __METRICSSTREAMER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ESPAsyncWebServer.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The metrics streamer pushes a compact snapshot of the display pipeline,
+ * heap and network metrics periodically as binary websocket frame to every
+ * subscribed client. The snapshot is sampled only once per period for all
+ * subscribers.
+ * Binary frame layout, all values in little endian:
+ * - Byte 0: Frame type (FRAME_TYPE_METRICS)
+ * - Byte 1: Number of slot entries
+ * - Timestamp in ms (uint32_t)
+ * - Number of processed frames (uint32_t)
+ * - Time of the last frame in us (uint32_t)
+ * - Max. time of a frame in us (uint32_t)
+ * - Number of skipped frames (uint32_t)
+ * - Free internal heap in byte (uint32_t)
+ * - Largest free block of the internal heap in byte (uint32_t)
+ * - Number of used TCP PCBs (uint16_t)
+ * - Max. number of TCP PCBs (uint16_t)
+ * - Number of used pbufs of the pbuf pool (uint16_t)
+ * - Size of the pbuf pool (uint16_t)
+ * - Followed by one entry per slot:
+ *   - Plugin UID, 0 if the slot is empty (uint16_t)
+ *   - Average duration of the plugin process() call in us (uint32_t)
+ *   - Average duration of the plugin update() call in us (uint32_t)
+ */
+class MetricsStreamer
+{
+public:
+
+    /** Frame type of a metrics frame, which differs from the display stream frame types. */
+    static const uint8_t    FRAME_TYPE_METRICS  = 0x40U;
+
+    /**
+     * Get metrics streamer instance.
+     * @return Metrics streamer instance
+     */
+    static MetricsStreamer& getInstance()
+    {
+        static MetricsStreamer instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Subscribe a websocket client to the metrics stream.
+     * If the client is already subscribed, its period will be updated and
+     * it will get a snapshot next.
+     * @param[in] clientId  Websocket client id
+     * @param[in] period    Period in ms [MIN_PERIOD; MAX_PERIOD]
+     * @return If successful subscribed, it will return true otherwise false.
+     */
+    bool subscribe(uint32_t clientId, uint32_t period);
+
+    /**
+     * Unsubscribe a websocket client from the metrics stream.
+     * If the client is not subscribed, nothing happens.
+     * @param[in] clientId  Websocket client id
+     */
+    void unsubscribe(uint32_t clientId);
+
+    /**
+     * Send a snapshot to all subscribed clients, whose period elapsed.
+     * Call this periodically.
+     * @param[in] server    Websocket server
+     */
+    void process(AsyncWebSocket& server);
+
+    /** Max. number of subscribed clients. */
+    static const uint8_t    MAX_SUBSCRIBERS = 2U;
+
+    /** Min. period in ms. */
+    static const uint32_t   MIN_PERIOD      = 250U;
+
+    /** Max. period in ms. */
+    static const uint32_t   MAX_PERIOD      = 10000U;
+
+    /** Default period in ms. */
+    static const uint32_t   DEFAULT_PERIOD  = 500U;
+
+private:
+
+    /** Subscribed client */
+    struct Subscriber
+    {
+        bool        isUsed;     /**< Is subscriber entry used? */
+        uint32_t    clientId;   /**< Websocket client id */
+        uint32_t    period;     /**< Period in ms */
+        uint32_t    timestamp;  /**< Timestamp in ms of the last sent snapshot */
+    };
+
+    /** Size of the frame header in bytes. */
+    static const size_t     HEADER_SIZE         = 38U;
+
+    /** Size of a slot entry in bytes. */
+    static const size_t     SLOT_ENTRY_SIZE     = 10U;
+
+    /** Max. number of slot entries. */
+    static const uint8_t    MAX_SLOT_ENTRIES    = 16U;
+
+    /** Max. size of a binary frame in bytes. */
+    static const size_t     MAX_FRAME_SIZE      = HEADER_SIZE + (SLOT_ENTRY_SIZE * MAX_SLOT_ENTRIES);
+
+    SemaphoreHandle_t   m_xMutex;                       /**< Mutex to protect the subscribers. */
+    Subscriber          m_subscribers[MAX_SUBSCRIBERS]; /**< Subscribed clients */
+    uint8_t             m_buffer[MAX_FRAME_SIZE];       /**< Binary frame buffer */
+
+    /**
+     * Constructs the metrics streamer.
+     */
+    MetricsStreamer();
+
+    /**
+     * Destroys the metrics streamer.
+     */
+    ~MetricsStreamer();
+
+    /* Prevent copying */
+    MetricsStreamer(const MetricsStreamer& streamer);
+    MetricsStreamer& operator=(const MetricsStreamer& streamer);
+
+    /**
+     * Sample the metrics into the binary frame buffer.
+     * @param[in] timestamp Timestamp in ms
+     * @return Size of the binary frame in bytes.
+     */
+    size_t sample(uint32_t timestamp);
+
+    /**
+     * Write a 16-bit value in little endian to the binary frame buffer.
+     * @param[in] offset    Offset in the binary frame buffer
+     * @param[in] value     Value
+     * @return Offset in the binary frame buffer after the value.
+     */
+    size_t putUInt16(size_t offset, uint16_t value);
+
+    /**
+     * Write a 32-bit value in little endian to the binary frame buffer.
+     * @param[in] offset    Offset in the binary frame buffer
+     * @param[in] value     Value
+     * @return Offset in the binary frame buffer after the value.
+     */
+    size_t putUInt32(size_t offset, uint32_t value);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __METRICSSTREAMER_H__ */
+
+/** @} */
@@ -0,0 +1,1025 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT client
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MqttClient.h"
+#include "Settings.h"
+#include "DnsCache.h"
+
+#include <Util.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** MQTT protocol level of version 3.1.1 */
+static const uint8_t    PROTOCOL_LEVEL              = 4U;
+
+/** CONNECT flag: Start with a clean session */
+static const uint8_t    CONNECT_FLAG_CLEAN_SESSION  = 0x02U;
+
+/** CONNECT flag: Password is present */
+static const uint8_t    CONNECT_FLAG_PASSWORD       = 0x40U;
+
+/** CONNECT flag: User name is present */
+static const uint8_t    CONNECT_FLAG_USER_NAME      = 0x80U;
+
+/** SUBACK return code: Failure */
+static const uint8_t    SUBACK_FAILURE              = 0x80U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void MqttClient::begin()
+{
+    String broker;
+    String hostname;
+
+    lock();
+
+    if (false == m_isEnabled)
+    {
+        if (false == Settings::getInstance().open(true))
+        {
+            broker      = Settings::getInstance().getMqttBroker().getDefault();
+            hostname    = Settings::getInstance().getHostname().getDefault();
+        }
+        else
+        {
+            broker      = Settings::getInstance().getMqttBroker().getValue();
+            hostname    = Settings::getInstance().getHostname().getValue();
+            Settings::getInstance().close();
+        }
+
+        if (true == broker.isEmpty())
+        {
+            LOG_INFO("MQTT disabled.");
+        }
+        else if (false == parseBroker(broker))
+        {
+            LOG_WARNING("Invalid MQTT broker address.");
+        }
+        else
+        {
+            /* The hostname is unique in the local network, therefore use it as client id. */
+            m_clientId  = hostname;
+            m_isEnabled = true;
+
+            connect();
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void MqttClient::end()
+{
+    lock();
+
+    m_isEnabled = false;
+    m_reconnectTimer.stop();
+    DnsCache::getInstance().cancel(this);
+    m_keepAliveTimer.stop();
+
+    if (STATE_DISCONNECTED != m_state)
+    {
+        if (STATE_CONNECTED == m_state)
+        {
+            (void)sendPacket(PACKET_TYPE_DISCONNECT << 4U, 0U);
+        }
+
+        m_tcpClient.close();
+        m_state = STATE_DISCONNECTED;
+    }
+
+    unlock();
+
+    return;
+}
+
+bool MqttClient::isConnected() const
+{
+    bool isConnected = false;
+
+    lock();
+    isConnected = (STATE_CONNECTED == m_state);
+    unlock();
+
+    return isConnected;
+}
+
+bool MqttClient::subscribe(const void* owner, const String& topic, const OnMessage& onMessage)
+{
+    bool    status  = false;
+    uint8_t index   = 0U;
+    uint8_t free    = MAX_SUBSCRIPTIONS;
+
+    if ((nullptr != owner) &&
+        (false == topic.isEmpty()) &&
+        (nullptr != onMessage))
+    {
+        lock();
+
+        /* A subscription of the same owner and topic is replaced. */
+        while((MAX_SUBSCRIPTIONS > index) &&
+              ((owner != m_subscriptions[index].owner) || (topic != m_subscriptions[index].topic)))
+        {
+            if ((MAX_SUBSCRIPTIONS == free) &&
+                (nullptr == m_subscriptions[index].owner))
+            {
+                free = index;
+            }
+
+            ++index;
+        }
+
+        if (MAX_SUBSCRIPTIONS <= index)
+        {
+            index = free;
+        }
+
+        if (MAX_SUBSCRIPTIONS <= index)
+        {
+            LOG_WARNING("No MQTT subscription available for %s.", topic.c_str());
+        }
+        else
+        {
+            Subscription& subscription = m_subscriptions[index];
+
+            subscription.owner      = owner;
+            subscription.topic      = topic;
+            subscription.onMessage  = onMessage;
+
+            /* If not connected, all subscriptions are sent after connecting. */
+            if (STATE_CONNECTED == m_state)
+            {
+                if (false == sendSubscription(true, topic))
+                {
+                    LOG_WARNING("MQTT subscribe %s failed.", topic.c_str());
+                }
+            }
+
+            status = true;
+        }
+
+        unlock();
+    }
+
+    return status;
+}
+
+void MqttClient::unsubscribe(const void* owner)
+{
+    uint8_t index = 0U;
+
+    lock();
+
+    for(index = 0U; index < MAX_SUBSCRIPTIONS; ++index)
+    {
+        Subscription& subscription = m_subscriptions[index];
+
+        if ((nullptr != owner) &&
+            (owner == subscription.owner))
+        {
+            String  topic       = subscription.topic;
+            uint8_t other       = 0U;
+            bool    isShared    = false;
+
+            subscription = Subscription();
+
+            /* Keep the topic subscribed, as long as another owner needs it. */
+            for(other = 0U; other < MAX_SUBSCRIPTIONS; ++other)
+            {
+                if ((nullptr != m_subscriptions[other].owner) &&
+                    (topic == m_subscriptions[other].topic))
+                {
+                    isShared = true;
+                }
+            }
+
+            if ((false == isShared) &&
+                (STATE_CONNECTED == m_state))
+            {
+                (void)sendSubscription(false, topic);
+            }
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void MqttClient::onTimeout(EventTimer& timer)
+{
+    lock();
+
+    if (&m_reconnectTimer == &timer)
+    {
+        if ((true == m_isEnabled) &&
+            (STATE_DISCONNECTED == m_state))
+        {
+            connect();
+        }
+    }
+    else if (&m_keepAliveTimer == &timer)
+    {
+        if (STATE_CONNECTING == m_state)
+        {
+            LOG_WARNING("MQTT broker doesn't acknowledge the connection.");
+            m_tcpClient.close();
+        }
+        else if (STATE_CONNECTED == m_state)
+        {
+            if (true == m_isPingPending)
+            {
+                LOG_WARNING("MQTT broker doesn't respond.");
+                m_tcpClient.close();
+            }
+            else if (false == sendPacket(PACKET_TYPE_PINGREQ << 4U, 0U))
+            {
+                m_tcpClient.close();
+            }
+            else
+            {
+                m_isPingPending = true;
+                m_keepAliveTimer.restart();
+            }
+        }
+        else
+        {
+            ;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    unlock();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+MqttClient::MqttClient() :
+    m_tcpClient(),
+    m_state(STATE_DISCONNECTED),
+    m_isEnabled(false),
+    m_hostname(),
+    m_port(DEFAULT_PORT),
+    m_user(),
+    m_password(),
+    m_clientId(),
+    m_subscriptions(),
+    m_packetId(0U),
+    m_isPingPending(false),
+    m_rxPart(RX_PART_FIXED_HEADER),
+    m_rxHeader(0U),
+    m_rxRemainingLength(0U),
+    m_rxLengthShift(0U),
+    m_rxIndex(0U),
+    m_rxBuffer(),
+    m_txBuffer(),
+    m_xMutex(xSemaphoreCreateRecursiveMutex()),
+    m_reconnectTimer(*this),
+    m_keepAliveTimer(*this)
+{
+    m_tcpClient.onConnect(  [this](void* arg, AsyncClient* client)
+                            {
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                onConnect();
+                            });
+
+    m_tcpClient.onDisconnect(   [this](void* arg, AsyncClient* client)
+                                {
+                                    UTIL_NOT_USED(arg);
+                                    UTIL_NOT_USED(client);
+
+                                    onDisconnect();
+                                });
+
+    m_tcpClient.onError(    [this](void* arg, AsyncClient* client, int8_t error)
+                            {
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                LOG_WARNING("MQTT connection error %d.", error);
+                                onDisconnect();
+                            });
+
+    m_tcpClient.onData( [this](void* arg, AsyncClient* client, void* data, size_t len)
+                        {
+                            UTIL_NOT_USED(arg);
+                            UTIL_NOT_USED(client);
+
+                            onData(static_cast<const uint8_t*>(data), len);
+                        });
+
+    m_tcpClient.onTimeout(  [this](void* arg, AsyncClient* client, uint32_t timeout)
+                            {
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(timeout);
+
+                                client->close();
+                            });
+}
+
+MqttClient::~MqttClient()
+{
+    end();
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+bool MqttClient::parseBroker(const String& broker)
+{
+    bool    status      = true;
+    String  hostPort    = broker;
+    int     index       = hostPort.indexOf("://");
+
+    /* The protocol is optional. */
+    if (0 <= index)
+    {
+        hostPort = hostPort.substring(index + 3);
+    }
+
+    m_user.clear();
+    m_password.clear();
+
+    index = hostPort.lastIndexOf('@');
+    if (0 <= index)
+    {
+        String  credentials = hostPort.substring(0, index);
+        int     colon       = credentials.indexOf(':');
+
+        hostPort = hostPort.substring(index + 1);
+
+        if (0 > colon)
+        {
+            m_user = credentials;
+        }
+        else
+        {
+            m_user      = credentials.substring(0, colon);
+            m_password  = credentials.substring(colon + 1);
+        }
+    }
+
+    index = hostPort.indexOf(':');
+    if (0 > index)
+    {
+        m_hostname  = hostPort;
+        m_port      = DEFAULT_PORT;
+    }
+    else
+    {
+        long port = hostPort.substring(index + 1).toInt();
+
+        m_hostname = hostPort.substring(0, index);
+
+        if ((0 >= port) || (UINT16_MAX < port))
+        {
+            status = false;
+        }
+        else
+        {
+            m_port = static_cast<uint16_t>(port);
+        }
+    }
+
+    if (true == m_hostname.isEmpty())
+    {
+        status = false;
+    }
+
+    return status;
+}
+
+void MqttClient::connect()
+{
+    IPAddress           addr;
+    DnsCache::Result    result  = DnsCache::RESULT_FAILED;
+
+    m_rxPart        = RX_PART_FIXED_HEADER;
+    m_isPingPending = false;
+    m_state         = STATE_CONNECTING;
+
+    LOG_INFO("Connecting to MQTT broker %s:%u.", m_hostname.c_str(), m_port);
+
+    result = DnsCache::getInstance().resolve(m_hostname, addr, this, [this](bool isResolved, const IPAddress& resolvedAddr)
+                {
+                    onResolved(isResolved, resolvedAddr);
+                });
+
+    if (DnsCache::RESULT_RESOLVED == result)
+    {
+        onResolved(true, addr);
+    }
+    else if (DnsCache::RESULT_FAILED == result)
+    {
+        onResolved(false, addr);
+    }
+    else
+    {
+        ;
+    }
+
+    return;
+}
+
+void MqttClient::onResolved(bool isResolved, const IPAddress& addr)
+{
+    lock();
+
+    /* The client may be stopped during the lookup. */
+    if ((true == m_isEnabled) &&
+        (STATE_CONNECTING == m_state))
+    {
+        if ((false == isResolved) ||
+            (false == m_tcpClient.connect(addr, m_port)))
+        {
+            LOG_WARNING("Connecting to MQTT broker failed.");
+
+            m_state = STATE_DISCONNECTED;
+            m_reconnectTimer.start(RECONNECT_PERIOD);
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void MqttClient::onConnect()
+{
+    lock();
+
+    if (false == sendConnect())
+    {
+        m_tcpClient.close();
+    }
+    else
+    {
+        /* Wait for the CONNACK not longer than a keep alive period. */
+        m_keepAliveTimer.start((KEEP_ALIVE * 1000U) / 2U);
+    }
+
+    unlock();
+
+    return;
+}
+
+void MqttClient::onDisconnect()
+{
+    lock();
+
+    if (STATE_CONNECTED == m_state)
+    {
+        LOG_INFO("Disconnected from MQTT broker.");
+    }
+
+    m_state = STATE_DISCONNECTED;
+    m_keepAliveTimer.stop();
+
+    if (true == m_isEnabled)
+    {
+        m_reconnectTimer.start(RECONNECT_PERIOD);
+    }
+
+    unlock();
+
+    return;
+}
+
+void MqttClient::onData(const uint8_t* data, size_t len)
+{
+    size_t index = 0U;
+
+    lock();
+
+    while((nullptr != data) && (len > index))
+    {
+        switch(m_rxPart)
+        {
+        case RX_PART_FIXED_HEADER:
+            m_rxHeader          = data[index];
+            m_rxRemainingLength = 0U;
+            m_rxLengthShift     = 0U;
+            m_rxIndex           = 0U;
+            m_rxPart            = RX_PART_REMAINING_LENGTH;
+            ++index;
+            break;
+
+        case RX_PART_REMAINING_LENGTH:
+            m_rxRemainingLength |= static_cast<size_t>(data[index] & 0x7FU) << m_rxLengthShift;
+            m_rxLengthShift     += 7U;
+
+            /* Last byte of the remaining length? */
+            if (0U == (data[index] & 0x80U))
+            {
+                if (0U == m_rxRemainingLength)
+                {
+                    handlePacket();
+                    m_rxPart = RX_PART_FIXED_HEADER;
+                }
+                else
+                {
+                    m_rxPart = RX_PART_BODY;
+                }
+            }
+            /* The remaining length has max. 4 bytes. */
+            else if ((7U * 4U) <= m_rxLengthShift)
+            {
+                LOG_WARNING("Malformed MQTT packet received.");
+                m_tcpClient.close();
+                m_rxPart    = RX_PART_FIXED_HEADER;
+
+                /* Skip the rest of the received data. */
+                index       = len - 1U;
+            }
+            else
+            {
+                ;
+            }
+
+            ++index;
+            break;
+
+        case RX_PART_BODY:
+            {
+                size_t  available   = len - index;
+                size_t  missing     = m_rxRemainingLength - m_rxIndex;
+                size_t  size        = (available < missing) ? available : missing;
+
+                /* Bytes, which don't fit into the buffer, are skipped. */
+                if (RX_BUFFER_SIZE > m_rxIndex)
+                {
+                    size_t copySize = RX_BUFFER_SIZE - m_rxIndex;
+
+                    if (size < copySize)
+                    {
+                        copySize = size;
+                    }
+
+                    memcpy(&m_rxBuffer[m_rxIndex], &data[index], copySize);
+                }
+
+                m_rxIndex   += size;
+                index       += size;
+
+                if (m_rxRemainingLength <= m_rxIndex)
+                {
+                    if (RX_BUFFER_SIZE < m_rxRemainingLength)
+                    {
+                        LOG_WARNING("MQTT packet with %u bytes skipped.", m_rxRemainingLength);
+                    }
+                    else
+                    {
+                        handlePacket();
+                    }
+
+                    m_rxPart = RX_PART_FIXED_HEADER;
+                }
+            }
+            break;
+
+        default:
+            m_rxPart = RX_PART_FIXED_HEADER;
+            break;
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void MqttClient::handlePacket()
+{
+    uint8_t index = 0U;
+
+    switch(m_rxHeader >> 4U)
+    {
+    case PACKET_TYPE_CONNACK:
+        /* Connection accepted? */
+        if ((2U <= m_rxRemainingLength) &&
+            (0U == m_rxBuffer[1U]))
+        {
+            LOG_INFO("Connected to MQTT broker.");
+
+            m_state = STATE_CONNECTED;
+            m_keepAliveTimer.start((KEEP_ALIVE * 1000U) / 2U);
+
+            for(index = 0U; index < MAX_SUBSCRIPTIONS; ++index)
+            {
+                if (nullptr != m_subscriptions[index].owner)
+                {
+                    (void)sendSubscription(true, m_subscriptions[index].topic);
+                }
+            }
+        }
+        else
+        {
+            LOG_WARNING("MQTT broker refused connection: %u", m_rxBuffer[1U]);
+            m_tcpClient.close();
+        }
+        break;
+
+    case PACKET_TYPE_PUBLISH:
+        handlePublish(m_rxBuffer, m_rxRemainingLength);
+        break;
+
+    case PACKET_TYPE_SUBACK:
+        /* Packet identifier is followed by the return code. */
+        if ((3U <= m_rxRemainingLength) &&
+            (SUBACK_FAILURE == m_rxBuffer[2U]))
+        {
+            LOG_WARNING("MQTT subscription refused.");
+        }
+        break;
+
+    case PACKET_TYPE_PINGRESP:
+        m_isPingPending = false;
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+void MqttClient::handlePublish(const uint8_t* body, size_t size)
+{
+    const uint8_t   QOS                             = (m_rxHeader >> 1U) & 0x03U;
+    size_t          topicLength                     = 0U;
+    size_t          payloadIndex                    = 0U;
+    String          topic;
+    OnMessage       callbacks[MAX_SUBSCRIPTIONS];
+    uint8_t         count                           = 0U;
+    uint8_t         index                           = 0U;
+    size_t          topicIndex                      = 0U;
+
+    if (2U <= size)
+    {
+        topicLength     = (static_cast<size_t>(body[0U]) << 8U) | body[1U];
+        payloadIndex    = 2U + topicLength;
+
+        /* Only QoS 0 is subscribed, but skip the packet identifier in any case. */
+        if (0U < QOS)
+        {
+            payloadIndex += 2U;
+        }
+    }
+
+    if ((2U > size) ||
+        (size < payloadIndex))
+    {
+        LOG_WARNING("Malformed MQTT PUBLISH received.");
+    }
+    else
+    {
+        topic.reserve(topicLength);
+        /* The topic may be longer than 255 characters. */
+        for(topicIndex = 0U; topicIndex < topicLength; ++topicIndex)
+        {
+            topic += static_cast<char>(body[2U + topicIndex]);
+        }
+
+        for(index = 0U; index < MAX_SUBSCRIPTIONS; ++index)
+        {
+            const Subscription& subscription = m_subscriptions[index];
+
+            if ((nullptr != subscription.owner) &&
+                (true == isTopicMatch(subscription.topic.c_str(), topic.c_str())))
+            {
+                callbacks[count] = subscription.onMessage;
+                ++count;
+            }
+        }
+
+        /* The subscribers are notified without lock, which allows them
+         * to subscribe or unsubscribe.
+         */
+        unlock();
+
+        for(index = 0U; index < count; ++index)
+        {
+            callbacks[index](topic, &body[payloadIndex], size - payloadIndex);
+        }
+
+        lock();
+    }
+
+    return;
+}
+
+bool MqttClient::sendConnect()
+{
+    size_t  index   = 0U;
+    uint8_t flags   = CONNECT_FLAG_CLEAN_SESSION;
+    bool    status  = true;
+
+    if (false == m_user.isEmpty())
+    {
+        flags |= CONNECT_FLAG_USER_NAME;
+    }
+
+    if (false == m_password.isEmpty())
+    {
+        flags |= CONNECT_FLAG_PASSWORD;
+    }
+
+    status &= putString(index, "MQTT");
+    status &= putUInt8(index, PROTOCOL_LEVEL);
+    status &= putUInt8(index, flags);
+    status &= putUInt16(index, KEEP_ALIVE);
+    status &= putString(index, m_clientId);
+
+    if (false == m_user.isEmpty())
+    {
+        status &= putString(index, m_user);
+    }
+
+    if (false == m_password.isEmpty())
+    {
+        status &= putString(index, m_password);
+    }
+
+    if (true == status)
+    {
+        status = sendPacket(PACKET_TYPE_CONNECT << 4U, index);
+    }
+
+    return status;
+}
+
+bool MqttClient::sendSubscription(bool isSubscribe, const String& topic)
+{
+    size_t  index   = 0U;
+    uint8_t header  = 0U;
+    bool    status  = true;
+
+    status &= putUInt16(index, getNextPacketId());
+    status &= putString(index, topic);
+
+    /* The reserved flags of SUBSCRIBE and UNSUBSCRIBE are 0b0010. */
+    if (true == isSubscribe)
+    {
+        header = (PACKET_TYPE_SUBSCRIBE << 4U) | 0x02U;
+        status &= putUInt8(index, 0U); /* QoS 0 */
+    }
+    else
+    {
+        header = (PACKET_TYPE_UNSUBSCRIBE << 4U) | 0x02U;
+    }
+
+    if (true == status)
+    {
+        status = sendPacket(header, index);
+    }
+
+    return status;
+}
+
+bool MqttClient::sendPacket(uint8_t header, size_t bodySize)
+{
+    uint8_t remainingLength[FIXED_HEADER_MAX_SIZE - 1U];
+    uint8_t lengthSize  = 0U;
+    size_t  length      = bodySize;
+    size_t  begin       = 0U;
+    size_t  packetSize  = 0U;
+
+    /* Variable length encoding, 7 bits per byte, least significant first. */
+    do
+    {
+        remainingLength[lengthSize] = length & 0x7FU;
+        length >>= 7U;
+
+        if (0U < length)
+        {
+            remainingLength[lengthSize] |= 0x80U;
+        }
+
+        ++lengthSize;
+    }
+    while((0U < length) && (sizeof(remainingLength) > lengthSize));
+
+    /* The fixed header is put directly in front of the body. */
+    begin               = FIXED_HEADER_MAX_SIZE - 1U - lengthSize;
+    packetSize          = 1U + lengthSize + bodySize;
+    m_txBuffer[begin]   = header;
+    memcpy(&m_txBuffer[begin + 1U], remainingLength, lengthSize);
+
+    return (packetSize == m_tcpClient.write(reinterpret_cast<const char*>(&m_txBuffer[begin]), packetSize));
+}
+
+bool MqttClient::putString(size_t& index, const String& str)
+{
+    bool    status = false;
+    size_t  length = str.length();
+
+    if ((UINT16_MAX >= length) &&
+        (true == putUInt16(index, static_cast<uint16_t>(length))) &&
+        ((TX_BUFFER_SIZE - FIXED_HEADER_MAX_SIZE - index) >= length))
+    {
+        memcpy(&m_txBuffer[FIXED_HEADER_MAX_SIZE + index], str.c_str(), length);
+        index += length;
+
+        status = true;
+    }
+
+    return status;
+}
+
+bool MqttClient::putUInt8(size_t& index, uint8_t value)
+{
+    bool status = false;
+
+    if ((TX_BUFFER_SIZE - FIXED_HEADER_MAX_SIZE) > index)
+    {
+        m_txBuffer[FIXED_HEADER_MAX_SIZE + index] = value;
+        ++index;
+
+        status = true;
+    }
+
+    return status;
+}
+
+bool MqttClient::putUInt16(size_t& index, uint16_t value)
+{
+    bool status = false;
+
+    if ((TX_BUFFER_SIZE - FIXED_HEADER_MAX_SIZE) > (index + 1U))
+    {
+        m_txBuffer[FIXED_HEADER_MAX_SIZE + index]       = static_cast<uint8_t>(value >> 8U);
+        m_txBuffer[FIXED_HEADER_MAX_SIZE + index + 1U]  = static_cast<uint8_t>(value & 0xFFU);
+        index += 2U;
+
+        status = true;
+    }
+
+    return status;
+}
+
+uint16_t MqttClient::getNextPacketId()
+{
+    ++m_packetId;
+
+    if (0U == m_packetId)
+    {
+        m_packetId = 1U;
+    }
+
+    return m_packetId;
+}
+
+bool MqttClient::isTopicMatch(const char* filter, const char* topic)
+{
+    bool isMatch    = true;
+    bool isFinished = false;
+
+    /* Topics starting with '$' are reserved by the broker and wildcards
+     * in the first level don't match them.
+     */
+    if (('$' == topic[0]) &&
+        (('+' == filter[0]) || ('#' == filter[0])))
+    {
+        isMatch = false;
+    }
+
+    while((true == isMatch) && (false == isFinished))
+    {
+        if ('#' == *filter)
+        {
+            /* Matches the parent and all child levels. */
+            isFinished = true;
+        }
+        else if ('+' == *filter)
+        {
+            /* Matches exactly one level. */
+            while(('\0' != *topic) && ('/' != *topic))
+            {
+                ++topic;
+            }
+
+            ++filter;
+        }
+        else if ('\0' == *filter)
+        {
+            isMatch     = ('\0' == *topic);
+            isFinished  = true;
+        }
+        else if (*filter == *topic)
+        {
+            ++filter;
+            ++topic;
+        }
+        /* "a/#" matches "a" too. */
+        else if (('\0' == *topic) &&
+                 (0 == strcmp(filter, "/#")))
+        {
+            isFinished = true;
+        }
+        else
+        {
+            isMatch = false;
+        }
+    }
+
+    return isMatch;
+}
+
+void MqttClient::lock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void MqttClient::unlock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,391 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT client
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __MQTT_CLIENT_H__
+#define __MQTT_CLIENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <AsyncTCP.h>
+#include <EventTimer.hpp>
+#include <functional>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A lightweight MQTT 3.1.1 client, which is shared by all users. Users
+ * subscribe topics and are notified about every published message, instead
+ * of polling the data source.
+ *
+ * Only QoS 0 is supported, which is enough for state updates, because the
+ * next update replaces a lost one. The subscriptions are kept, while the
+ * broker is not available and are sent again after every (re-)connect.
+ *
+ * The message callbacks are called in the context of the TCP client task
+ * and never with a lock of the client held.
+ */
+class MqttClient : public ITimerListener
+{
+public:
+
+    /**
+     * Prototype of callback for a received message.
+     */
+    typedef std::function<void(const String& topic, const uint8_t* payload, size_t size)> OnMessage;
+
+    /** Default MQTT broker port */
+    static const uint16_t   DEFAULT_PORT        = 1883U;
+
+    /** Max. number of subscriptions */
+    static const uint8_t    MAX_SUBSCRIPTIONS   = 8U;
+
+    /** Keep alive interval in s, which is negotiated with the broker */
+    static const uint16_t   KEEP_ALIVE          = 60U;
+
+    /** Period in ms to retry connecting to the broker */
+    static const uint32_t   RECONNECT_PERIOD    = (10U * 1000U);
+
+    /** Receive buffer size in byte. Longer packets are skipped. */
+    static const size_t     RX_BUFFER_SIZE      = 512U;
+
+    /** Transmit buffer size in byte. */
+    static const size_t     TX_BUFFER_SIZE      = 256U;
+
+    /**
+     * Get the MQTT client instance.
+     *
+     * @return MQTT client
+     */
+    static MqttClient& getInstance()
+    {
+        static MqttClient instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the client. The broker is read from the settings and if there
+     * is none configured, the client keeps disabled.
+     */
+    void begin();
+
+    /**
+     * Stop the client and disconnect from the broker. The subscriptions
+     * are kept.
+     */
+    void end();
+
+    /**
+     * Is the client connected to the broker?
+     *
+     * @return If connected, it will return true otherwise false.
+     */
+    bool isConnected() const;
+
+    /**
+     * Subscribe a topic. The topic filter may contain the wildcards '+' and '#'.
+     *
+     * @param[in] owner     Owner of the subscription, used to unsubscribe
+     * @param[in] topic     Topic filter
+     * @param[in] onMessage Callback, which is called for every received message
+     *
+     * @return If successful subscribed, it will return true otherwise false.
+     */
+    bool subscribe(const void* owner, const String& topic, const OnMessage& onMessage);
+
+    /**
+     * Unsubscribe all topics of the given owner.
+     *
+     * @param[in] owner Owner of the subscriptions
+     */
+    void unsubscribe(const void* owner);
+
+    /**
+     * Handles reconnect and keep alive.
+     * Will be called by the timer service.
+     *
+     * @param[in] timer Event timer, which timed out
+     */
+    void onTimeout(EventTimer& timer) final;
+
+private:
+
+    /**
+     * Connection states.
+     */
+    enum State
+    {
+        STATE_DISCONNECTED = 0, /**< Not connected */
+        STATE_CONNECTING,       /**< TCP connection or CONNACK pending */
+        STATE_CONNECTED         /**< Connected to the broker */
+    };
+
+    /**
+     * MQTT control packet types.
+     */
+    enum PacketType
+    {
+        PACKET_TYPE_CONNECT     = 1U,   /**< Client request to connect */
+        PACKET_TYPE_CONNACK     = 2U,   /**< Connect acknowledgment */
+        PACKET_TYPE_PUBLISH     = 3U,   /**< Publish message */
+        PACKET_TYPE_SUBSCRIBE   = 8U,   /**< Subscribe request */
+        PACKET_TYPE_SUBACK      = 9U,   /**< Subscribe acknowledgment */
+        PACKET_TYPE_UNSUBSCRIBE = 10U,  /**< Unsubscribe request */
+        PACKET_TYPE_UNSUBACK    = 11U,  /**< Unsubscribe acknowledgment */
+        PACKET_TYPE_PINGREQ     = 12U,  /**< Ping request */
+        PACKET_TYPE_PINGRESP    = 13U,  /**< Ping response */
+        PACKET_TYPE_DISCONNECT  = 14U   /**< Client is disconnecting */
+    };
+
+    /**
+     * Parts of a received packet.
+     */
+    enum RxPart
+    {
+        RX_PART_FIXED_HEADER = 0,   /**< Packet type and flags */
+        RX_PART_REMAINING_LENGTH,   /**< Variable length encoded remaining length */
+        RX_PART_BODY                /**< Variable header and payload */
+    };
+
+    /**
+     * A subscription.
+     */
+    struct Subscription
+    {
+        const void* owner;      /**< Owner of the subscription, nullptr if unused */
+        String      topic;      /**< Topic filter */
+        OnMessage   onMessage;  /**< Message callback */
+    };
+
+    /** Max. size of the fixed header in byte. */
+    static const size_t     FIXED_HEADER_MAX_SIZE   = 5U;
+
+    AsyncClient         m_tcpClient;                            /**< Asynchronous TCP client */
+    State               m_state;                                /**< Connection state */
+    bool                m_isEnabled;                            /**< Shall the client be connected to the broker? */
+    String              m_hostname;                             /**< Broker hostname */
+    uint16_t            m_port;                                 /**< Broker port */
+    String              m_user;                                 /**< User name, may be empty */
+    String              m_password;                             /**< Password, may be empty */
+    String              m_clientId;                             /**< Client id */
+    Subscription        m_subscriptions[MAX_SUBSCRIPTIONS];     /**< Subscriptions */
+    uint16_t            m_packetId;                             /**< Last used packet identifier */
+    bool                m_isPingPending;                        /**< Is a ping response pending? */
+    RxPart              m_rxPart;                               /**< Currently received packet part */
+    uint8_t             m_rxHeader;                             /**< Fixed header byte of the received packet */
+    size_t              m_rxRemainingLength;                    /**< Remaining length of the received packet */
+    uint8_t             m_rxLengthShift;                        /**< Bit shift of the next remaining length byte */
+    size_t              m_rxIndex;                              /**< Number of received body bytes */
+    uint8_t             m_rxBuffer[RX_BUFFER_SIZE];             /**< Body of the received packet */
+    uint8_t             m_txBuffer[TX_BUFFER_SIZE];             /**< Packet, which is sent next */
+    SemaphoreHandle_t   m_xMutex;                               /**< Mutex to protect against concurrent access. */
+    EventTimer          m_reconnectTimer;                       /**< Timer, used to retry connecting to the broker. */
+    EventTimer          m_keepAliveTimer;                       /**< Timer, used to ping the broker. */
+
+    /**
+     * Constructs the MQTT client.
+     */
+    MqttClient();
+
+    /**
+     * Destroys the MQTT client.
+     */
+    ~MqttClient();
+
+    /* Prevent copying */
+    MqttClient(const MqttClient&);
+    MqttClient& operator=(const MqttClient&);
+
+    /**
+     * Parse the broker address in the format [user:password@]host[:port].
+     *
+     * @param[in] broker    Broker address
+     *
+     * @return If successful parsed, it will return true otherwise false.
+     */
+    bool parseBroker(const String& broker);
+
+    /**
+     * Connect to the broker.
+     */
+    void connect();
+
+    /**
+     * Handle the finished lookup of the broker hostname and connect.
+     *
+     * @param[in] isResolved    Is the hostname resolved?
+     * @param[in] addr          IP address, only valid if resolved
+     */
+    void onResolved(bool isResolved, const IPAddress& addr);
+
+    /**
+     * Handle connection established.
+     */
+    void onConnect();
+
+    /**
+     * Handle connection closed or lost.
+     */
+    void onDisconnect();
+
+    /**
+     * Handle received data.
+     *
+     * @param[in] data  Data
+     * @param[in] len   Data length in byte
+     */
+    void onData(const uint8_t* data, size_t len);
+
+    /**
+     * Handle a complete received packet.
+     * The lock is released during the message callbacks.
+     */
+    void handlePacket();
+
+    /**
+     * Notify the subscribers about a received message.
+     *
+     * @param[in] body  PUBLISH packet body
+     * @param[in] size  Body size in byte
+     */
+    void handlePublish(const uint8_t* body, size_t size);
+
+    /**
+     * Send CONNECT packet.
+     *
+     * @return If successful sent, it will return true otherwise false.
+     */
+    bool sendConnect();
+
+    /**
+     * Send SUBSCRIBE or UNSUBSCRIBE packet for a single topic filter.
+     *
+     * @param[in] isSubscribe   Subscribe (true) or unsubscribe (false)
+     * @param[in] topic         Topic filter
+     *
+     * @return If successful sent, it will return true otherwise false.
+     */
+    bool sendSubscription(bool isSubscribe, const String& topic);
+
+    /**
+     * Send a packet, whose body is already in the transmit buffer after the
+     * reserved fixed header space.
+     *
+     * @param[in] header    Fixed header byte, packet type and flags
+     * @param[in] bodySize  Body size in byte
+     *
+     * @return If successful sent, it will return true otherwise false.
+     */
+    bool sendPacket(uint8_t header, size_t bodySize);
+
+    /**
+     * Append a length prefixed UTF-8 string to the transmit buffer body.
+     *
+     * @param[in, out]  index   Body index, which is moved behind the string
+     * @param[in]       str     String
+     *
+     * @return If the string fits into the buffer, it will return true otherwise false.
+     */
+    bool putString(size_t& index, const String& str);
+
+    /**
+     * Append a byte to the transmit buffer body.
+     *
+     * @param[in, out]  index   Body index, which is moved behind the value
+     * @param[in]       value   Value
+     *
+     * @return If the value fits into the buffer, it will return true otherwise false.
+     */
+    bool putUInt8(size_t& index, uint8_t value);
+
+    /**
+     * Append a 16-bit value in big endian to the transmit buffer body.
+     *
+     * @param[in, out]  index   Body index, which is moved behind the value
+     * @param[in]       value   Value
+     *
+     * @return If the value fits into the buffer, it will return true otherwise false.
+     */
+    bool putUInt16(size_t& index, uint16_t value);
+
+    /**
+     * Get next packet identifier, which is never 0.
+     *
+     * @return Packet identifier
+     */
+    uint16_t getNextPacketId();
+
+    /**
+     * Is a topic matching the topic filter, which may contain wildcards?
+     *
+     * @param[in] filter    Topic filter
+     * @param[in] topic     Topic
+     *
+     * @return If matching, it will return true otherwise false.
+     */
+    static bool isTopicMatch(const char* filter, const char* topic);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock() const;
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __MQTT_CLIENT_H__ */
+
+/** @} */
\ No newline at end of file
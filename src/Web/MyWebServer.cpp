@@ -38,6 +38,13 @@
 #include "Pages.h"
 #include "RestApi.h"
 #include "WebSocket.h"
+#include "EventStream.h"
+#include "PluginWebRouter.h"
+#include "PowerMgr.h"
+#include "HttpStatus.h"
+#include "FileUploader.h"
+
+#include <Metrics.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -51,6 +58,125 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * The activity handler is asked first for every request. It never handles
+ * one, it just notifies the power manager about the webserver activity.
+ */
+class ActivityHandler : public AsyncWebHandler
+{
+public:
+
+    /**
+     * Constructs the activity handler.
+     */
+    ActivityHandler() :
+        AsyncWebHandler()
+    {
+    }
+
+    /**
+     * Destroys the activity handler.
+     */
+    ~ActivityHandler()
+    {
+    }
+
+    /**
+     * Notify about the request, but never handle it.
+     *
+     * @param[in] request   HTTP request
+     *
+     * @return Always false
+     */
+    bool canHandle(AsyncWebServerRequest* request) final
+    {
+        (void)request;
+
+        PowerMgr::getInstance().notifyActivity();
+
+        return false;
+    }
+
+private:
+
+    ActivityHandler(const ActivityHandler& handler);
+    ActivityHandler& operator=(const ActivityHandler& handler);
+};
+
+/**
+ * The admission handler limits the number of concurrently handled requests.
+ * REST requests may use all of them, while static assets, e.g. during a
+ * page load burst of the browser, may use only a part. So REST requests
+ * get a predictable latency under UI load. A request, which is not admitted,
+ * is answered with "503 Service Unavailable" and a "Retry-After" header.
+ *
+ * Websocket and server-sent event requests are long-lived and taken over
+ * by their handler, therefore they are not limited.
+ *
+ * The admission handler owns the disconnect handler of every admitted
+ * request to release it. Other modules, which need to know about a
+ * disconnect, are notified by it.
+ */
+class AdmissionHandler : public AsyncWebHandler
+{
+public:
+
+    /** Max. number of concurrently handled requests. */
+    static const uint8_t    MAX_REQUESTS        = 8U;
+
+    /** Number of requests, which are reserved for the REST API. */
+    static const uint8_t    RESERVED_REST       = 3U;
+
+    /** Time in s, after which a rejected client shall retry. */
+    static const uint32_t   RETRY_AFTER         = 1U;
+
+    /**
+     * Constructs the admission handler.
+     */
+    AdmissionHandler() :
+        AsyncWebHandler(),
+        m_requests(0U)
+    {
+    }
+
+    /**
+     * Destroys the admission handler.
+     */
+    ~AdmissionHandler()
+    {
+    }
+
+    /**
+     * Admit the request or handle it, if the webserver is saturated.
+     *
+     * @param[in] request   HTTP request
+     *
+     * @return If the request is rejected, it will return true otherwise false.
+     */
+    bool canHandle(AsyncWebServerRequest* request) final;
+
+    /**
+     * Reject the request.
+     *
+     * @param[in] request   HTTP request
+     */
+    void handleRequest(AsyncWebServerRequest* request) final;
+
+private:
+
+    uint8_t m_requests; /**< Number of admitted requests, which are not finished yet. */
+
+    AdmissionHandler(const AdmissionHandler& handler);
+    AdmissionHandler& operator=(const AdmissionHandler& handler);
+
+    /**
+     * Release a admitted request, after it was disconnected.
+     *
+     * @param[in] request   HTTP request
+     */
+    void release(AsyncWebServerRequest* request);
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -64,10 +190,76 @@ static void error(AsyncWebServerRequest* request);
 /** Web server */
 static AsyncWebServer   gWebServer(WebConfig::WEBSERVER_PORT);
 
+/** Notifies the power manager about webserver activity. */
+static ActivityHandler  gActivityHandler;
+
+/** Limits the number of concurrently handled requests. */
+static AdmissionHandler gAdmissionHandler;
+
+/** Number of concurrently handled HTTP requests */
+static MetricGauge      gMetricRequests("pixelix_http_requests_in_flight", "Number of concurrently handled HTTP requests.");
+
+/** Number of rejected HTTP requests */
+static MetricCounter    gMetricRejectedRequests("pixelix_http_rejected_requests_total", "Number of HTTP requests rejected because the webserver was saturated.");
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
+bool AdmissionHandler::canHandle(AsyncWebServerRequest* request)
+{
+    bool            isRejected  = false;
+    const String&   url         = request->url();
+
+    /* Long-lived requests are taken over by their handler and never
+     * disconnected as a request.
+     */
+    if ((url == WebConfig::WEBSOCKET_PATH) ||
+        (url == EventStream::URI))
+    {
+        ;
+    }
+    else
+    {
+        uint8_t limit = MAX_REQUESTS - RESERVED_REST;
+
+        if (true == url.startsWith(RestApi::BASE_URI))
+        {
+            limit = MAX_REQUESTS;
+        }
+
+        if (limit <= m_requests)
+        {
+            isRejected = true;
+            gMetricRejectedRequests.inc();
+        }
+        else
+        {
+            ++m_requests;
+            gMetricRequests.inc();
+
+            request->onDisconnect([this, request]() {
+                release(request);
+            });
+        }
+    }
+
+    return isRejected;
+}
+
+void AdmissionHandler::handleRequest(AsyncWebServerRequest* request)
+{
+    AsyncWebServerResponse* response = request->beginResponse(HttpStatus::STATUS_CODE_SERVICE_UNAVAILABLE);
+
+    if (nullptr != response)
+    {
+        response->addHeader("Retry-After", String(RETRY_AFTER));
+        request->send(response);
+    }
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -76,22 +268,48 @@ static AsyncWebServer   gWebServer(WebConfig::WEBSERVER_PORT);
  * Private Methods
  *****************************************************************************/
 
+void AdmissionHandler::release(AsyncWebServerRequest* request)
+{
+    if (0U < m_requests)
+    {
+        --m_requests;
+        gMetricRequests.dec();
+    }
+
+    /* A broken upload connection must not block further uploads. */
+    FileUploader::getInstance().onDisconnect(request);
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
 
 void MyWebServer::init(bool initCaptivePortal)
 {
+    /* The activity handler must be the first one, to see every request. */
+    (void)gWebServer.addHandler(&gActivityHandler);
+
+    /* The admission handler must be the second one, before any request is handled. */
+    (void)gWebServer.addHandler(&gAdmissionHandler);
+
     if (false == initCaptivePortal)
     {
         /* Register all web pages */
         Pages::init(gWebServer);
         RestApi::init(gWebServer);
 
+        /* All plugin REST API requests are dispatched by a single handler. */
+        PluginWebRouter::getInstance().init(gWebServer);
+
         gWebServer.onNotFound(error);
 
         /* Register websocket */
         WebSocketSrv::getInstance().init(gWebServer);
+
+        /* Register server-sent event stream */
+        EventStream::getInstance().init(gWebServer);
     }
     else
     {
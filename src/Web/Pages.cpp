@@ -38,11 +38,14 @@
 #include "Settings.h"
 #include "Version.h"
 #include "UpdateMgr.h"
+#include "UpdateWriter.h"
 #include "LedMatrix.h"
 #include "DisplayMgr.h"
 #include "RestApi.h"
 #include "PluginMgr.h"
 #include "FileSystem.h"
+#include "StaticFileHandler.h"
+#include "JsonFile.h"
 
 #include <WiFi.h>
 #include <Esp.h>
@@ -51,6 +54,8 @@
 #include <Util.h>
 #include <ArduinoJson.h>
 #include <lwip/init.h>
+#include <MemPolicy.h>
+#include <memory>
 
 /******************************************************************************
  * Compiler Switches
@@ -70,17 +75,35 @@
 struct TmplKeyWordFunc
 {
     const char* keyword;        /**< Keyword */
+    bool        isStatic;       /**< Is the value constant during runtime? */
     String      (*func)(void);  /**< Function to call */
 };
 
+/**
+ * A web page, which is pre-rendered with the static template values and
+ * cached in memory.
+ */
+struct CachedPage
+{
+    const char*                 path;       /**< Path in the filesystem */
+    std::shared_ptr<uint8_t>    content;    /**< Pre-rendered page content, shared with pending responses */
+    size_t                      size;       /**< Content size in byte */
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
 
 static String fitToSpiffs(const String& path, const String& filenNameWithoutExt, const String& fileNameExtension);
 static bool isValidHostname(const String& hostname);
+static String getFilesystemETag();
 
 static String tmplPageProcessor(const String& var);
+static void initPageCache();
+static bool cachePage(CachedPage& page, size_t& budget);
+static size_t renderStaticTmpl(const char* src, size_t srcSize, char* dst);
+static const TmplKeyWordFunc* findTmplKeyWord(const char* keyword, size_t length);
+static void sendPage(AsyncWebServerRequest* request, const char* path);
 
 static void aboutPage(AsyncWebServerRequest* request);
 static void debugPage(AsyncWebServerRequest* request);
@@ -88,6 +111,7 @@ static void displayPage(AsyncWebServerRequest* request);
 static void editPage(AsyncWebServerRequest* request);
 static void indexPage(AsyncWebServerRequest* request);
 static void infoPage(AsyncWebServerRequest* request);
+static void perfPage(AsyncWebServerRequest* request);
 static bool storeSetting(KeyValue* parameter, const String& value, DynamicJsonDocument& jsonDoc);
 static void settingsPage(AsyncWebServerRequest* request);
 static void updatePage(AsyncWebServerRequest* request);
@@ -125,6 +149,47 @@ static const String     PLUGIN_PAGE_FILE_EXTENSION      = ".html";
 /** SPIFFS limits the max. filename length, which includes the path as well. */
 static const uint32_t   SPIFFS_FILENAME_LENGTH_LIMIT    = 32U;
 
+/** Filesystem version file, created by the filesystem image build. */
+static const char*      FILESYSTEM_VERSION_FILENAME     = "/version.json";
+
+/** Cache control of the static files. The client may cache them for 1 hour. */
+static const char*      STATIC_FILE_CACHE_CONTROL       = "max-age=3600";
+
+/**
+ * Cache control for the images, which may be changed at runtime by uploads.
+ * They are not covered by the entity tag of the filesystem version and
+ * therefore always fetched again.
+ */
+static const char*      IMAGE_FILE_CACHE_CONTROL        = "no-cache";
+
+/** Page cache size in byte, if PSRAM is available. */
+static const size_t     PAGE_CACHE_SIZE_PSRAM           = 256U * 1024U;
+
+/** Page cache size in byte, if only the internal SRAM is available. */
+static const size_t     PAGE_CACHE_SIZE                 = 16U * 1024U;
+
+/** Template placeholder, which marks the begin and the end of a keyword. */
+static const char       TMPL_PLACEHOLDER                = '~';
+
+/**
+ * Web pages, which are cached. They are sorted by priority, because only
+ * the pages, which fit into the page cache, are cached. All others are
+ * rendered from the filesystem on every request.
+ */
+static CachedPage       gCachedPages[]                  =
+{
+    { "/index.html",    nullptr,    0U },
+    { "/info.html",     nullptr,    0U },
+    { "/settings.html", nullptr,    0U },
+    { "/update.html",   nullptr,    0U },
+    { "/about.html",    nullptr,    0U },
+    { "/error.html",    nullptr,    0U },
+    { "/debug.html",    nullptr,    0U },
+    { "/display.html",  nullptr,    0U },
+    { "/edit.html",     nullptr,    0U },
+    { "/perf.html",     nullptr,    0U }
+};
+
 /** Flag used to signal any kind of file upload error. */
 static bool             gIsUploadError                  = false;
 
@@ -134,34 +199,34 @@ static bool             gIsUploadError                  = false;
  */
 static TmplKeyWordFunc  gTmplKeyWordToFunc[]            =
 {
-    "ARDUINO_IDF_BRANCH",   []() -> String { return CONFIG_ARDUINO_IDF_BRANCH; },
-    "ESP_CHIP_ID",          tmpl::getEspChipId,
-    "ESP_CHIP_REV",         []() -> String { return String(ESP.getChipRevision()); },
-    "ESP_CPU_FREQ",         []() -> String { return String(ESP.getCpuFreqMHz()); },
-    "ESP_SDK_VERSION",      []() -> String { return ESP.getSdkVersion(); },
-    "ESP_TYPE",             tmpl::getEspType,
-    "FILESYSTEM_FILENAME",  []() -> String { return FILESYSTEM_FILENAME; },
-    "FIRMWARE_FILENAME",    []() -> String { return FIRMWARE_FILENAME; },
-    "FLASH_CHIP_MODE",      tmpl::getFlashChipMode,
-    "FLASH_CHIP_SIZE",      []() -> String { return String(ESP.getFlashChipSize() / (1024U * 1024U)); },
-    "FLASH_CHIP_SPEED",     []() -> String { return String(ESP.getFlashChipSpeed() / (1000U * 1000U)); },
-    "FS_SIZE",              []() -> String { return String(FILESYSTEM.totalBytes()); },
-    "FS_SIZE_USED",         []() -> String { return String(FILESYSTEM.usedBytes()); },
-    "HEAP_SIZE",            []() -> String { return String(ESP.getHeapSize()); },
-    "HEAP_SIZE_AVAILABLE",  []() -> String { return String(ESP.getFreeHeap()); },
-    "HOSTNAME",             tmpl::getHostname,
-    "IPV4",                 tmpl::getIPAddress,
-    "LWIP_VERSION",         []() -> String { return LWIP_VERSION_STRING; },
-    "MAC_ADDR",             []() -> String { return WiFi.macAddress(); },
-    "RSSI",                 tmpl::getRSSI,
-    "SETTINGS_DATA",        tmpl::getSettingsData,
-    "SSID",                 tmpl::getSSID,
-    "SW_BRANCH",            []() -> String { return Version::SOFTWARE_BRANCH; },
-    "SW_REVISION",          []() -> String { return Version::SOFTWARE_REV; },
-    "SW_VERSION",           []() -> String { return Version::SOFTWARE_VER; },
-    "WS_ENDPOINT",          []() -> String { return WebConfig::WEBSOCKET_PATH; },
-    "WS_PORT",              []() -> String { return String(WebConfig::WEBSOCKET_PORT); },
-    "WS_PROTOCOL",          []() -> String { return WebConfig::WEBSOCKET_PROTOCOL; }
+    "ARDUINO_IDF_BRANCH",   true,  []() -> String { return CONFIG_ARDUINO_IDF_BRANCH; },
+    "ESP_CHIP_ID",          true,  tmpl::getEspChipId,
+    "ESP_CHIP_REV",         true,  []() -> String { return String(ESP.getChipRevision()); },
+    "ESP_CPU_FREQ",         false, []() -> String { return String(ESP.getCpuFreqMHz()); },
+    "ESP_SDK_VERSION",      true,  []() -> String { return ESP.getSdkVersion(); },
+    "ESP_TYPE",             true,  tmpl::getEspType,
+    "FILESYSTEM_FILENAME",  true,  []() -> String { return FILESYSTEM_FILENAME; },
+    "FIRMWARE_FILENAME",    true,  []() -> String { return FIRMWARE_FILENAME; },
+    "FLASH_CHIP_MODE",      true,  tmpl::getFlashChipMode,
+    "FLASH_CHIP_SIZE",      true,  []() -> String { return String(ESP.getFlashChipSize() / (1024U * 1024U)); },
+    "FLASH_CHIP_SPEED",     true,  []() -> String { return String(ESP.getFlashChipSpeed() / (1000U * 1000U)); },
+    "FS_SIZE",              true,  []() -> String { return String(FILESYSTEM.totalBytes()); },
+    "FS_SIZE_USED",         false, []() -> String { return String(FILESYSTEM.usedBytes()); },
+    "HEAP_SIZE",            true,  []() -> String { return String(ESP.getHeapSize()); },
+    "HEAP_SIZE_AVAILABLE",  false, []() -> String { return String(ESP.getFreeHeap()); },
+    "HOSTNAME",             false, tmpl::getHostname,
+    "IPV4",                 false, tmpl::getIPAddress,
+    "LWIP_VERSION",         true,  []() -> String { return LWIP_VERSION_STRING; },
+    "MAC_ADDR",             false, []() -> String { return WiFi.macAddress(); },
+    "RSSI",                 false, tmpl::getRSSI,
+    "SETTINGS_DATA",        false, tmpl::getSettingsData,
+    "SSID",                 false, tmpl::getSSID,
+    "SW_BRANCH",            true,  []() -> String { return Version::SOFTWARE_BRANCH; },
+    "SW_REVISION",          true,  []() -> String { return Version::SOFTWARE_REV; },
+    "SW_VERSION",           true,  []() -> String { return Version::SOFTWARE_VER; },
+    "WS_ENDPOINT",          true,  []() -> String { return WebConfig::WEBSOCKET_PATH; },
+    "WS_PORT",              true,  []() -> String { return String(WebConfig::WEBSOCKET_PORT); },
+    "WS_PROTOCOL",          true,  []() -> String { return WebConfig::WEBSOCKET_PROTOCOL; }
 };
 
 /******************************************************************************
@@ -182,7 +247,10 @@ static TmplKeyWordFunc  gTmplKeyWordToFunc[]            =
 
 void Pages::init(AsyncWebServer& srv)
 {
-    const char* pluginName = nullptr;
+    const char*     pluginName  = nullptr;
+    const String    ETAG        = getFilesystemETag();
+
+    initPageCache();
 
     (void)srv.on("/about.html", HTTP_GET, aboutPage);
     (void)srv.on("/debug.html", HTTP_GET, debugPage);
@@ -190,6 +258,7 @@ void Pages::init(AsyncWebServer& srv)
     (void)srv.on("/edit.html", HTTP_GET, editPage);
     (void)srv.on("/index.html", HTTP_GET, indexPage);
     (void)srv.on("/info.html", HTTP_GET, infoPage);
+    (void)srv.on("/perf.html", HTTP_GET, perfPage);
     (void)srv.on("/settings.html", HTTP_GET | HTTP_POST, settingsPage);
     (void)srv.on("/update.html", HTTP_GET, updatePage);
     (void)srv.on("/upload.html", HTTP_POST, uploadPage, uploadHandler);
@@ -202,12 +271,17 @@ void Pages::init(AsyncWebServer& srv)
     });
 
     /* Serve files with static content with enabled cache control.
-     * The client may cache files from filesytem for 1 hour.
+     * After the cache expired, the client revalidates the files with the
+     * entity tag of the filesystem version.
+     *
+     * The images are excluded, because they can be uploaded at runtime. With
+     * the entity tag of the filesystem version, a replaced image would still
+     * be revalidated as not modified.
      */
-    (void)srv.serveStatic("/favicon.png", FILESYSTEM, "/favicon.png", "max-age=3600");
-    (void)srv.serveStatic("/images/", FILESYSTEM, "/images/", "max-age=3600");
-    (void)srv.serveStatic("/js/", FILESYSTEM, "/js/", "max-age=3600");
-    (void)srv.serveStatic("/style/", FILESYSTEM, "/style/", "max-age=3600");
+    (void)srv.addHandler(new StaticFileHandler("/favicon.png", "/favicon.png", STATIC_FILE_CACHE_CONTROL, ETAG));
+    (void)srv.addHandler(new StaticFileHandler("/images/", "/images/", IMAGE_FILE_CACHE_CONTROL, String()));
+    (void)srv.addHandler(new StaticFileHandler("/js/", "/js/", STATIC_FILE_CACHE_CONTROL, ETAG));
+    (void)srv.addHandler(new StaticFileHandler("/style/", "/style/", STATIC_FILE_CACHE_CONTROL, ETAG));
 
     /* Add one page per plugin. */
     pluginName = PluginMgr::getInstance().findFirst();
@@ -241,6 +315,31 @@ void Pages::init(AsyncWebServer& srv)
     return;
 }
 
+/**
+ * Remove a web page from the page cache, e.g. after it was changed in the
+ * filesystem. Further requests are rendered from the filesystem.
+ *
+ * @param[in] path  Path of the web page in the filesystem
+ */
+void Pages::invalidate(const String& path)
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < UTIL_ARRAY_NUM(gCachedPages); ++index)
+    {
+        CachedPage& page = gCachedPages[index];
+
+        /* Pending responses keep their content, until they are finished. */
+        if (path == page.path)
+        {
+            page.content.reset();
+            page.size = 0U;
+        }
+    }
+
+    return;
+}
+
 /**
  * Error web page used in case a requested path was not found.
  *
@@ -263,7 +362,7 @@ void Pages::error(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/error.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/error.html");
 
     return;
 }
@@ -355,6 +454,308 @@ static bool isValidHostname(const String& hostname)
     return isValid;
 }
 
+/**
+ * Get the entity tag of the filesystem version. It is derived from the
+ * version file, which is created by the filesystem image build.
+ *
+ * @return Entity tag. If the version is not available, it will be empty.
+ */
+static String getFilesystemETag()
+{
+    String              eTag;
+    const size_t        JSON_DOC_SIZE   = 256U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    JsonFile            jsonFile(FILESYSTEM);
+
+    if (false == jsonFile.load(FILESYSTEM_VERSION_FILENAME, jsonDoc))
+    {
+        LOG_WARNING("Filesystem version not available, no entity tags.");
+    }
+    else
+    {
+        JsonVariantConst    jsonVersion = jsonDoc["version"];
+        JsonVariantConst    jsonHash    = jsonDoc["hash"];
+
+        if ((false == jsonVersion.is<String>()) ||
+            (false == jsonHash.is<String>()))
+        {
+            LOG_WARNING("Filesystem version invalid.");
+        }
+        else
+        {
+            eTag  = "\"";
+            eTag += jsonVersion.as<String>();
+            eTag += "-";
+            eTag += jsonHash.as<String>();
+            eTag += "\"";
+
+            LOG_INFO("Filesystem version: %s", eTag.c_str());
+        }
+    }
+
+    return eTag;
+}
+
+/**
+ * Pre-render the web pages with the static template values and cache them
+ * in memory, as long as the page cache size is not exhausted.
+ */
+static void initPageCache()
+{
+    size_t  budget  = (true == MemPolicy::isPsramAvailable()) ? PAGE_CACHE_SIZE_PSRAM : PAGE_CACHE_SIZE;
+    uint8_t index   = 0U;
+
+    for(index = 0U; index < UTIL_ARRAY_NUM(gCachedPages); ++index)
+    {
+        CachedPage& page = gCachedPages[index];
+
+        if (false == cachePage(page, budget))
+        {
+            LOG_INFO("Page %s not cached.", page.path);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Pre-render a single web page with the static template values and cache it.
+ *
+ * @param[in]       page    Web page
+ * @param[in,out]   budget  Remaining page cache size in byte
+ *
+ * @return If the page is cached, it will return true otherwise false.
+ */
+static bool cachePage(CachedPage& page, size_t& budget)
+{
+    bool    isCached    = false;
+    File    fd          = FILESYSTEM.open(page.path, "r");
+
+    if (true == fd)
+    {
+        const size_t    FILE_SIZE   = fd.size();
+        char*           src         = nullptr;
+
+        /* The file is only read, if the page fits at least without rendering. */
+        if (budget >= FILE_SIZE)
+        {
+            src = static_cast<char*>(MemPolicy::allocate(MemPolicy::REGION_LARGE, FILE_SIZE));
+        }
+
+        if ((nullptr != src) &&
+            (FILE_SIZE == fd.read(reinterpret_cast<uint8_t*>(src), FILE_SIZE)))
+        {
+            const size_t    SIZE    = renderStaticTmpl(src, FILE_SIZE, nullptr);
+            uint8_t*        dst     = nullptr;
+
+            if (budget >= SIZE)
+            {
+                dst = static_cast<uint8_t*>(MemPolicy::allocate(MemPolicy::REGION_LARGE, SIZE));
+            }
+
+            if (nullptr != dst)
+            {
+                (void)renderStaticTmpl(src, FILE_SIZE, reinterpret_cast<char*>(dst));
+
+                page.content.reset(dst, [](uint8_t* content) { MemPolicy::release(content); });
+                page.size   = SIZE;
+                budget     -= SIZE;
+                isCached    = true;
+            }
+        }
+
+        MemPolicy::release(src);
+        fd.close();
+    }
+
+    return isCached;
+}
+
+/**
+ * Render the static template values. Placeholders of dynamic values are
+ * kept, they are rendered later per request.
+ *
+ * @param[in]   src     Template
+ * @param[in]   srcSize Template size in byte
+ * @param[out]  dst     Destination buffer. If nullptr, only the size is calculated.
+ *
+ * @return Size of the rendered template in byte
+ */
+static size_t renderStaticTmpl(const char* src, size_t srcSize, char* dst)
+{
+    size_t  srcIndex    = 0U;
+    size_t  dstIndex    = 0U;
+
+    while(srcSize > srcIndex)
+    {
+        const TmplKeyWordFunc*  tmplKeyWord = nullptr;
+        size_t                  end         = srcIndex + 1U;
+        size_t                  length      = 1U;
+
+        if (TMPL_PLACEHOLDER == src[srcIndex])
+        {
+            while((srcSize > end) && (TMPL_PLACEHOLDER != src[end]))
+            {
+                ++end;
+            }
+
+            /* Escaped placeholder or keyword? */
+            if (srcSize > end)
+            {
+                length = end + 1U - srcIndex;
+
+                if (2U < length)
+                {
+                    tmplKeyWord = findTmplKeyWord(&src[srcIndex + 1U], length - 2U);
+
+                    /* Unknown keywords are handled by the template processor. */
+                    if (nullptr == tmplKeyWord)
+                    {
+                        length = 1U;
+                    }
+                }
+            }
+        }
+
+        /* Static value? */
+        if ((nullptr != tmplKeyWord) &&
+            (true == tmplKeyWord->isStatic))
+        {
+            String  value   = tmplKeyWord->func();
+            size_t  index   = 0U;
+
+            for(index = 0U; index < value.length(); ++index)
+            {
+                /* The placeholder in a value must be escaped by doubling it. */
+                if (TMPL_PLACEHOLDER == value[index])
+                {
+                    if (nullptr != dst)
+                    {
+                        dst[dstIndex] = TMPL_PLACEHOLDER;
+                    }
+                    ++dstIndex;
+                }
+
+                if (nullptr != dst)
+                {
+                    dst[dstIndex] = value[index];
+                }
+                ++dstIndex;
+            }
+
+            srcIndex = end + 1U;
+        }
+        /* Dynamic value or anything else is copied. */
+        else
+        {
+            if (nullptr != dst)
+            {
+                memcpy(&dst[dstIndex], &src[srcIndex], length);
+            }
+
+            srcIndex += length;
+            dstIndex += length;
+        }
+    }
+
+    return dstIndex;
+}
+
+/**
+ * Find a template keyword.
+ *
+ * @param[in] keyword   Keyword, not null terminated
+ * @param[in] length    Keyword length in characters
+ *
+ * @return If found, it will return the template keyword otherwise nullptr.
+ */
+static const TmplKeyWordFunc* findTmplKeyWord(const char* keyword, size_t length)
+{
+    const TmplKeyWordFunc*  tmplKeyWord = nullptr;
+    uint8_t                 index       = 0U;
+
+    while((index < UTIL_ARRAY_NUM(gTmplKeyWordToFunc)) && (nullptr == tmplKeyWord))
+    {
+        const char* candidate = gTmplKeyWordToFunc[index].keyword;
+
+        if ((0 == strncmp(candidate, keyword, length)) &&
+            ('\0' == candidate[length]))
+        {
+            tmplKeyWord = &gTmplKeyWordToFunc[index];
+        }
+
+        ++index;
+    }
+
+    return tmplKeyWord;
+}
+
+/**
+ * Send a web page. A cached page is sent from memory, otherwise it is
+ * read from the filesystem. In both cases the remaining template values
+ * are rendered.
+ *
+ * @param[in] request   HTTP request
+ * @param[in] path      Path of the web page in the filesystem
+ */
+static void sendPage(AsyncWebServerRequest* request, const char* path)
+{
+    std::shared_ptr<uint8_t>    content;
+    size_t                      size    = 0U;
+    uint8_t                     index   = 0U;
+
+    while((index < UTIL_ARRAY_NUM(gCachedPages)) && (nullptr == content))
+    {
+        if (0 == strcmp(path, gCachedPages[index].path))
+        {
+            content = gCachedPages[index].content;
+            size    = gCachedPages[index].size;
+        }
+
+        ++index;
+    }
+
+    if (nullptr == content)
+    {
+        request->send(FILESYSTEM, path, "text/html", false, tmplPageProcessor);
+    }
+    else
+    {
+        /* The response keeps the content, even if the page is removed from
+         * the cache in the meantime.
+         */
+        AsyncWebServerResponse* response = request->beginResponse(
+            "text/html",
+            size,
+            [content, size](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+            {
+                size_t length = 0U;
+
+                if (size > index)
+                {
+                    length = size - index;
+
+                    if (maxLen < length)
+                    {
+                        length = maxLen;
+                    }
+
+                    memcpy(buffer, &content.get()[index], length);
+                }
+
+                return length;
+            },
+            tmplPageProcessor);
+
+        if (nullptr != response)
+        {
+            request->send(response);
+        }
+    }
+
+    return;
+}
+
 /**
  * Processor for page template, containing the common part, which is available
  * in every page. It is responsible for the data binding.
@@ -401,7 +802,7 @@ static void aboutPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/about.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/about.html");
 
     return;
 }
@@ -426,7 +827,7 @@ static void debugPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/debug.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/debug.html");
 
     return;
 }
@@ -451,7 +852,7 @@ static void displayPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/display.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/display.html");
 
     return;
 }
@@ -476,7 +877,7 @@ static void editPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/edit.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/edit.html");
 
     return;
 }
@@ -501,7 +902,7 @@ static void indexPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/index.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/index.html");
 
     return;
 }
@@ -526,7 +927,32 @@ static void infoPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/info.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/info.html");
+
+    return;
+}
+
+/**
+ * Performance page, showing the live metrics of the display pipeline.
+ *
+ * @param[in] request   HTTP request
+ */
+static void perfPage(AsyncWebServerRequest* request)
+{
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    /* Force authentication! */
+    if (false == request->authenticate(WebConfig::WEB_LOGIN_USER, WebConfig::WEB_LOGIN_PASSWORD))
+    {
+        /* Request DIGEST authentication */
+        request->requestAuthentication();
+        return;
+    }
+
+    sendPage(request, "/perf.html");
 
     return;
 }
@@ -843,7 +1269,7 @@ static void settingsPage(AsyncWebServerRequest* request)
     }
     else if (HTTP_GET == request->method())
     {
-        request->send(FILESYSTEM, "/settings.html", "text/html", false, tmplPageProcessor);
+        sendPage(request, "/settings.html");
     }
     else
     {
@@ -873,7 +1299,7 @@ static void updatePage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/update.html", "text/html", false, tmplPageProcessor);
+    sendPage(request, "/update.html");
 
     return;
 }
@@ -933,13 +1359,16 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
     /* Begin of upload? */
     if (0 == index)
     {
-        AsyncWebHeader* header      = request->getHeader("X-File-Size");
-        uint32_t        fileSize    = UPDATE_SIZE_UNKNOWN;
+        AsyncWebHeader* header          = request->getHeader("X-File-Size");
+        AsyncWebHeader* sha256Header    = request->getHeader("X-File-Sha256");
+        uint32_t        fileSize        = UPDATE_SIZE_UNKNOWN;
+        String          sha256;
 
         /* If there is a pending upload, abort it. */
-        if (true == Update.isRunning())
+        if (true == UpdateWriter::getInstance().isRunning())
         {
-            Update.abort();
+            UpdateWriter::getInstance().abort();
+            UpdateMgr::getInstance().endProgress();
             LOG_WARNING("Pending upload aborted.");
         }
 
@@ -953,6 +1382,12 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
             (void)Util::strToUInt32(header->value(), fileSize);
         }
 
+        /* Expected SHA-256 of the image available? */
+        if (nullptr != sha256Header)
+        {
+            sha256 = sha256Header->value();
+        }
+
         if (UPDATE_SIZE_UNKNOWN == fileSize)
         {
             LOG_INFO("Upload of %s (unknown size) starts.", filename.c_str());
@@ -972,9 +1407,9 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
         }
 
         /* Start update */
-        if (false == Update.begin(fileSize, cmd))
+        if (false == UpdateWriter::getInstance().begin(fileSize, cmd, sha256))
         {
-            LOG_ERROR("Upload failed: %s", Update.errorString());
+            LOG_ERROR("Upload failed: %s", UpdateWriter::getInstance().getErrorStr());
             gIsUploadError = true;
 
             /* Mount filesystem again, it may be unmounted in case of filesystem update.*/
@@ -990,37 +1425,45 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
         else
         {
             /* Use UpdateMgr to show the user the update status.
-             * Note, the display manager will be completey stopped during this,
-             * to avoid artifacts on the display, because of long writes to flash.
+             * Note, the display manager keeps running with a progress overlay.
              */
             UpdateMgr::getInstance().beginProgress();
         }
     }
 
-    if (true == Update.isRunning())
+    if (true == UpdateWriter::getInstance().isRunning())
     {
         if (false == gIsUploadError)
         {
-            if(len != Update.write(data, len))
+            /* The data is written behind in sector sized chunks. */
+            if (false == UpdateWriter::getInstance().write(data, len))
             {
-                LOG_ERROR("Upload failed: %s", Update.errorString());
+                LOG_ERROR("Upload failed: %s", UpdateWriter::getInstance().getErrorStr());
                 gIsUploadError = true;
             }
             else
             {
-                uint32_t progress = (Update.progress() * 100) / Update.size();
-
-                UpdateMgr::getInstance().updateProgress(progress);
+                UpdateMgr::getInstance().updateProgress(UpdateWriter::getInstance().getProgress());
             }
 
             /* Upload finished? */
-            if (true == final)
+            if ((false == gIsUploadError) &&
+                (true == final))
             {
                 /* Finish update now. */
-                if (false == Update.end(true))
+                if (false == UpdateWriter::getInstance().end())
                 {
-                    LOG_ERROR("Upload failed: %s", Update.errorString());
+                    LOG_ERROR("Upload failed: %s", UpdateWriter::getInstance().getErrorStr());
                     gIsUploadError = true;
+
+                    /* Mount filesystem again, it may be unmounted in case of filesystem update. */
+                    if (false == FILESYSTEM.begin())
+                    {
+                        LOG_FATAL("Couldn't mount filesystem.");
+                    }
+
+                    /* The client is informed in the upload page handler, see uploadPage(). */
+                    UpdateMgr::getInstance().endProgress();
                 }
                 /* Update was successful! */
                 else
@@ -1046,7 +1489,7 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
             }
 
             /* Abort update */
-            Update.abort();
+            UpdateWriter::getInstance().abort();
             UpdateMgr::getInstance().endProgress();
 
             /* Inform client about abort.*/
@@ -1238,72 +1681,69 @@ namespace tmpl
             result.clear();
             for(index = 0U; index < Settings::KEY_VALUE_PAIR_NUM; ++index)
             {
-                KeyValue*   parameter   = list[index];
-                JsonObject  jsonSetting = jsonDoc.createNestedObject();
-                JsonObject  jsonInput   = jsonSetting.createNestedObject("input");
-
-                jsonSetting["title"]    = parameter->getName();
-                jsonInput["name"]       = parameter->getKey();
+                KeyValue* parameter = list[index];
 
-                switch(parameter->getValueType())
+                /* JSON values are only kept for migration and binary values
+                 * are not user editable.
+                 */
+                if ((KeyValue::TYPE_JSON != parameter->getValueType()) &&
+                    (KeyValue::TYPE_BLOB != parameter->getValueType()))
                 {
-                case KeyValue::TYPE_STRING:
-                    {
-                        KeyValueString* kvStr = static_cast<KeyValueString*>(parameter);
-                        jsonInput["type"]       = "text";
-                        jsonInput["value"]      = kvStr->getValue();
-                        jsonInput["size"]       = kvStr->getMaxLength();
-                        jsonInput["minlength"]  = kvStr->getMinLength();
-                        jsonInput["maxlength"]  = kvStr->getMaxLength();
-                    }
-                    break;
+                    JsonObject  jsonSetting = jsonDoc.createNestedObject();
+                    JsonObject  jsonInput   = jsonSetting.createNestedObject("input");
 
-                case KeyValue::TYPE_BOOL:
+                    jsonSetting["title"]    = parameter->getName();
+                    jsonInput["name"]       = parameter->getKey();
+
+                    switch(parameter->getValueType())
                     {
-                        KeyValueBool* kvBool = static_cast<KeyValueBool*>(parameter);
-                        jsonInput["type"]       = "checkbox";
-                        jsonInput["value"]      = kvBool->getKey();
+                    case KeyValue::TYPE_STRING:
+                        {
+                            KeyValueString* kvStr = static_cast<KeyValueString*>(parameter);
+                            jsonInput["type"]       = "text";
+                            jsonInput["value"]      = kvStr->getValue();
+                            jsonInput["size"]       = kvStr->getMaxLength();
+                            jsonInput["minlength"]  = kvStr->getMinLength();
+                            jsonInput["maxlength"]  = kvStr->getMaxLength();
+                        }
+                        break;
 
-                        if (true == kvBool->getValue())
+                    case KeyValue::TYPE_BOOL:
                         {
-                            jsonInput["checked"] = "checked";
+                            KeyValueBool* kvBool = static_cast<KeyValueBool*>(parameter);
+                            jsonInput["type"]       = "checkbox";
+                            jsonInput["value"]      = kvBool->getKey();
+
+                            if (true == kvBool->getValue())
+                            {
+                                jsonInput["checked"] = "checked";
+                            }
                         }
-                    }
-                    break;
+                        break;
+
+                    case KeyValue::TYPE_UINT8:
+                        {
+                            KeyValueUInt8* kvUInt8 = static_cast<KeyValueUInt8*>(parameter);
+                            jsonInput["type"]   = "number";
+                            jsonInput["value"]  = kvUInt8->getValue();
+                            jsonInput["min"]    = kvUInt8->getMin();
+                            jsonInput["max"]    = kvUInt8->getMax();
+                        }
+                        break;
 
-                case KeyValue::TYPE_UINT8:
+                    case KeyValue::TYPE_INT32:
                     {
-                        KeyValueUInt8* kvUInt8 = static_cast<KeyValueUInt8*>(parameter);
+                        KeyValueInt32* kvInt32 = static_cast<KeyValueInt32*>(parameter);
                         jsonInput["type"]   = "number";
-                        jsonInput["value"]  = kvUInt8->getValue();
-                        jsonInput["min"]    = kvUInt8->getMin();
-                        jsonInput["max"]    = kvUInt8->getMax();
+                        jsonInput["value"]  = kvInt32->getValue();
+                        jsonInput["min"]    = kvInt32->getMin();
+                        jsonInput["max"]    = kvInt32->getMax();
                     }
                     break;
 
-                case KeyValue::TYPE_INT32:
-                {
-                    KeyValueInt32* kvInt32 = static_cast<KeyValueInt32*>(parameter);
-                    jsonInput["type"]   = "number";
-                    jsonInput["value"]  = kvInt32->getValue();
-                    jsonInput["min"]    = kvInt32->getMin();
-                    jsonInput["max"]    = kvInt32->getMax();
-                }
-                break;
-
-                case KeyValue::TYPE_JSON:
-                    {
-                        KeyValueJson* kvJson = static_cast<KeyValueJson*>(parameter);
-                        jsonInput["type"]       = "text";
-                        jsonInput["value"]      = kvJson->getValue();
-                        jsonInput["size"]       = kvJson->getMaxLength();
-                        jsonInput["minlength"]  = kvJson->getMinLength();
-                        jsonInput["maxlength"]  = kvJson->getMaxLength();
+                    default:
+                        break;
                     }
-                    break;
-
-                default:
-                    break;
                 }
             }
 
@@ -69,6 +69,14 @@ namespace Pages
  */
 void init(AsyncWebServer& srv);
 
+/**
+ * Remove a web page from the page cache, e.g. after it was changed in the
+ * filesystem.
+ * 
+ * @param[in] path  Path of the web page in the filesystem
+ */
+void invalidate(const String& path);
+
 /**
  * Error web page used in case a requested path was not found.
  * 
@@ -0,0 +1,361 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin web router
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PluginWebRouter.h"
+#include "MyWebServer.h"
+#include "RestApi.h"
+#include "HttpStatus.h"
+
+#include <Logging.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void PluginWebRouter::init(AsyncWebServer& srv)
+{
+    (void)srv.addHandler(this);
+
+    return;
+}
+
+AsyncCallbackWebHandler& PluginWebRouter::on(const char* uri, ArRequestHandlerFunction onRequest)
+{
+    return on(uri, HTTP_ANY, onRequest);
+}
+
+AsyncCallbackWebHandler& PluginWebRouter::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest, ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody)
+{
+    AsyncCallbackWebHandler* handler = new AsyncCallbackWebHandler();
+
+    handler->setUri(uri);
+    handler->setMethod(method);
+    handler->onRequest(onRequest);
+    handler->onUpload(onUpload);
+    handler->onBody(onBody);
+
+    addHandler(uri, handler);
+
+    return *handler;
+}
+
+bool PluginWebRouter::removeHandler(AsyncWebHandler* handler)
+{
+    bool    isRemoved   = false;
+    uint8_t index       = 0U;
+
+    if (nullptr != handler)
+    {
+        lock();
+
+        for(index = 0U; (index < BUCKET_NUM) && (false == isRemoved); ++index)
+        {
+            Route*  prev    = nullptr;
+            Route*  route   = m_buckets[index];
+
+            while((nullptr != route) && (false == isRemoved))
+            {
+                if (handler == route->handler)
+                {
+                    if (nullptr == prev)
+                    {
+                        m_buckets[index] = route->next;
+                    }
+                    else
+                    {
+                        prev->next = route->next;
+                    }
+
+                    delete route->handler;
+                    delete route;
+
+                    isRemoved = true;
+                }
+                else
+                {
+                    prev    = route;
+                    route   = route->next;
+                }
+            }
+        }
+
+        unlock();
+
+        /* Handler without plugin UID? */
+        if (false == isRemoved)
+        {
+            isRemoved = MyWebServer::getInstance().removeHandler(handler);
+        }
+    }
+
+    return isRemoved;
+}
+
+bool PluginWebRouter::canHandle(AsyncWebServerRequest* request)
+{
+    bool isHandled = false;
+
+    if (nullptr != findHandler(request))
+    {
+        isHandled = true;
+    }
+
+    return isHandled;
+}
+
+void PluginWebRouter::handleRequest(AsyncWebServerRequest* request)
+{
+    AsyncWebHandler* handler = findHandler(request);
+
+    if (nullptr != handler)
+    {
+        handler->handleRequest(request);
+    }
+    /* Plugin was uninstalled in the meantime. */
+    else if (nullptr != request)
+    {
+        request->send(HttpStatus::STATUS_CODE_NOT_FOUND);
+    }
+    else
+    {
+        ;
+    }
+
+    return;
+}
+
+void PluginWebRouter::handleUpload(AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final)
+{
+    AsyncWebHandler* handler = findHandler(request);
+
+    if (nullptr != handler)
+    {
+        handler->handleUpload(request, filename, index, data, len, final);
+    }
+
+    return;
+}
+
+void PluginWebRouter::handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total)
+{
+    AsyncWebHandler* handler = findHandler(request);
+
+    if (nullptr != handler)
+    {
+        handler->handleBody(request, data, len, index, total);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+PluginWebRouter::PluginWebRouter() :
+    AsyncWebHandler(),
+    m_buckets(),
+    m_uriPrefix(String(RestApi::BASE_URI) + "/display/uid/"),
+    m_xMutex(xSemaphoreCreateMutex())
+{
+}
+
+PluginWebRouter::~PluginWebRouter()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < BUCKET_NUM; ++index)
+    {
+        while(nullptr != m_buckets[index])
+        {
+            Route* route = m_buckets[index];
+
+            m_buckets[index] = route->next;
+
+            delete route->handler;
+            delete route;
+        }
+    }
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+void PluginWebRouter::addHandler(const String& uri, AsyncWebHandler* handler)
+{
+    uint16_t uid = 0U;
+
+    if (false == getUID(uri, uid))
+    {
+        LOG_WARNING("No plugin UID in %s.", uri.c_str());
+
+        (void)MyWebServer::getInstance().addHandler(handler);
+    }
+    else
+    {
+        Route* route = new Route();
+
+        if (nullptr == route)
+        {
+            LOG_ERROR("Couldn't add route %s.", uri.c_str());
+
+            (void)MyWebServer::getInstance().addHandler(handler);
+        }
+        else
+        {
+            uint8_t index = getBucketIndex(uid);
+
+            route->uid      = uid;
+            route->handler  = handler;
+
+            lock();
+
+            route->next         = m_buckets[index];
+            m_buckets[index]    = route;
+
+            unlock();
+        }
+    }
+
+    return;
+}
+
+AsyncWebHandler* PluginWebRouter::findHandler(AsyncWebServerRequest* request)
+{
+    AsyncWebHandler*    handler = nullptr;
+    uint16_t            uid     = 0U;
+
+    if ((nullptr != request) &&
+        (true == getUID(request->url(), uid)))
+    {
+        Route* route = nullptr;
+
+        lock();
+
+        /* Only the handlers of the requested plugin are checked. */
+        route = m_buckets[getBucketIndex(uid)];
+
+        while((nullptr != route) && (nullptr == handler))
+        {
+            if ((uid == route->uid) &&
+                (true == route->handler->filter(request)) &&
+                (true == route->handler->canHandle(request)))
+            {
+                handler = route->handler;
+            }
+
+            route = route->next;
+        }
+
+        unlock();
+    }
+
+    return handler;
+}
+
+bool PluginWebRouter::getUID(const String& uri, uint16_t& uid) const
+{
+    bool isAvailable = false;
+
+    if (true == uri.startsWith(m_uriPrefix))
+    {
+        int uidEnd = uri.indexOf('/', m_uriPrefix.length());
+
+        if (0 > uidEnd)
+        {
+            uidEnd = uri.length();
+        }
+
+        isAvailable = Util::strToUInt16(uri.substring(m_uriPrefix.length(), uidEnd), uid);
+    }
+
+    return isAvailable;
+}
+
+void PluginWebRouter::lock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void PluginWebRouter::unlock()
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
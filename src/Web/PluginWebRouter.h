@@ -0,0 +1,263 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin web router
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __PLUGIN_WEB_ROUTER_H__
+#define __PLUGIN_WEB_ROUTER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <ESPAsyncWebServer.h>
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Single web handler for the REST API of all installed plugins.
+ *
+ * Without it, every plugin handler is added to the webserver, which matches
+ * its handlers linearly. This router is added only once and resolves the
+ * plugin UID of the request URL (.../display/uid/<uid>/...) via a hash table
+ * to the handlers of this plugin. Only these are checked further.
+ *
+ * The plugins register their handlers here, like at the webserver.
+ */
+class PluginWebRouter : public AsyncWebHandler
+{
+public:
+
+    /**
+     * Get the plugin web router instance.
+     *
+     * @return Plugin web router
+     */
+    static PluginWebRouter& getInstance()
+    {
+        static PluginWebRouter instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Add the router to the webserver.
+     *
+     * @param[in] srv   Webserver
+     */
+    void init(AsyncWebServer& srv);
+
+    /**
+     * Register a handler for any HTTP method.
+     *
+     * @param[in] uri       URI of the plugin, based on the plugin REST API base URI.
+     * @param[in] onRequest Request handler
+     *
+     * @return Web handler
+     */
+    AsyncCallbackWebHandler& on(const char* uri, ArRequestHandlerFunction onRequest);
+
+    /**
+     * Register a handler.
+     *
+     * @param[in] uri       URI of the plugin, based on the plugin REST API base URI.
+     * @param[in] method    HTTP method(s)
+     * @param[in] onRequest Request handler
+     * @param[in] onUpload  Upload handler (optional)
+     * @param[in] onBody    Body handler (optional)
+     *
+     * @return Web handler
+     */
+    AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest, ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr);
+
+    /**
+     * Remove a handler and destroy it.
+     *
+     * @param[in] handler   Web handler
+     *
+     * @return If successful removed, it will return true otherwise false.
+     */
+    bool removeHandler(AsyncWebHandler* handler);
+
+    /**
+     * Checks whether the request is for a plugin and can be handled by one
+     * of its handlers.
+     *
+     * @param[in] request   Web request
+     *
+     * @return If request can be handled, it will return true otherwise false.
+     */
+    bool canHandle(AsyncWebServerRequest* request) final;
+
+    /**
+     * Forwards the request to the plugin handler.
+     *
+     * @param[in] request   Web request, which to handle.
+     */
+    void handleRequest(AsyncWebServerRequest* request) final;
+
+    /**
+     * Forwards the upload to the plugin handler.
+     *
+     * @param[in] request   Web request
+     * @param[in] filename  Name of the uploaded file
+     * @param[in] index     Index of the data in the file
+     * @param[in] data      Data
+     * @param[in] len       Data length in byte
+     * @param[in] final     Is it the last part of the file?
+     */
+    void handleUpload(AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final) final;
+
+    /**
+     * Forwards the body to the plugin handler.
+     *
+     * @param[in] request   Web request
+     * @param[in] data      Data
+     * @param[in] len       Data length in byte
+     * @param[in] index     Index of the data in the body
+     * @param[in] total     Total body length in byte
+     */
+    void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) final;
+
+    /**
+     * Non-trivial handler, because the plugin handlers need the request
+     * parameters.
+     */
+    bool isRequestHandlerTrivial() final
+    {
+        return false;
+    }
+
+    /** Number of hash table buckets. Must be a power of two. */
+    static const uint8_t    BUCKET_NUM  = 16U;
+
+private:
+
+    /**
+     * Plugin handler, which is chained in a hash table bucket.
+     */
+    struct Route
+    {
+        uint16_t            uid;        /**< Plugin UID */
+        AsyncWebHandler*    handler;    /**< Plugin web handler */
+        Route*              next;       /**< Next route in the same bucket */
+    };
+
+    Route*              m_buckets[BUCKET_NUM];  /**< Hash table with the routes, the plugin UID is the key. */
+    String              m_uriPrefix;            /**< URI prefix of the plugin REST API, which is followed by the plugin UID. */
+    SemaphoreHandle_t   m_xMutex;               /**< Mutex to protect the hash table. */
+
+    /**
+     * Constructs the plugin web router.
+     */
+    PluginWebRouter();
+
+    /**
+     * Destroys the plugin web router.
+     */
+    ~PluginWebRouter();
+
+    PluginWebRouter(const PluginWebRouter& router);
+    PluginWebRouter& operator=(const PluginWebRouter& router);
+
+    /**
+     * Add handler to the hash table. If the URI contains no plugin UID,
+     * the handler is added to the webserver instead.
+     *
+     * @param[in] uri       URI of the handler
+     * @param[in] handler   Web handler
+     */
+    void addHandler(const String& uri, AsyncWebHandler* handler);
+
+    /**
+     * Find the plugin handler, which can handle the request.
+     *
+     * @param[in] request   Web request
+     *
+     * @return If found, it will return the handler otherwise nullptr.
+     */
+    AsyncWebHandler* findHandler(AsyncWebServerRequest* request);
+
+    /**
+     * Get the plugin UID from the URI.
+     *
+     * @param[in]  uri  URI
+     * @param[out] uid  Plugin UID
+     *
+     * @return If the URI contains a plugin UID, it will return true otherwise false.
+     */
+    bool getUID(const String& uri, uint16_t& uid) const;
+
+    /**
+     * Lock the hash table.
+     */
+    void lock();
+
+    /**
+     * Unlock the hash table.
+     */
+    void unlock();
+
+    /**
+     * Get the hash table bucket index of the plugin UID.
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return Bucket index
+     */
+    static uint8_t getBucketIndex(uint16_t uid)
+    {
+        return static_cast<uint8_t>(uid & (BUCKET_NUM - 1U));
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PLUGIN_WEB_ROUTER_H__ */
+
+/** @} */
\ No newline at end of file
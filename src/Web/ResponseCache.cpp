@@ -0,0 +1,239 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Short-lived cache of REST responses
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ResponseCache.h"
+#include "HttpStatus.h"
+#include "RestApi.h"
+
+#include <Metrics.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of requests, which are served from the cache */
+static MetricCounter    gMetricHits("pixelix_rest_cache_hits_total", "Number of REST requests served from the response cache.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool ResponseCache::isCacheable(AsyncWebServerRequest* request) const
+{
+    bool status = false;
+
+    /* Arguments, e.g. "pretty", change the response. Only the default
+     * JSON format is cached.
+     */
+    if ((nullptr != request) &&
+        (HTTP_GET == request->method()) &&
+        (0U == request->args()) &&
+        (false == RestApi::isMsgPackAccepted(request)))
+    {
+        status = true;
+    }
+
+    return status;
+}
+
+bool ResponseCache::send(AsyncWebServerRequest* request)
+{
+    bool isSent = false;
+
+    if ((nullptr == m_xMutex) ||
+        (false == isCacheable(request)))
+    {
+        return false;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    Entry* entry = findEntry(request->url().c_str());
+
+    if (nullptr != entry)
+    {
+        /* Expired? */
+        if (entry->ttl <= (millis() - entry->timestamp))
+        {
+            entry->uri  = "";
+            entry->body = "";
+        }
+        else
+        {
+            request->send(HttpStatus::STATUS_CODE_OK, "application/json", entry->body);
+            gMetricHits.inc();
+            isSent = true;
+        }
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return isSent;
+}
+
+void ResponseCache::store(AsyncWebServerRequest* request, uint32_t revision, uint32_t ttl, const String& body)
+{
+    if ((nullptr == m_xMutex) ||
+        (0U == ttl) ||
+        (false == isCacheable(request)))
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    /* Not invalidated in the meantime? */
+    if (revision == m_revision.load(std::memory_order_acquire))
+    {
+        const String&   uri         = request->url();
+        uint32_t        timestamp   = millis();
+        Entry*          entry       = findEntry(uri.c_str());
+
+        /* Replace a unused entry or the oldest one. */
+        if (nullptr == entry)
+        {
+            uint8_t index = 0U;
+
+            entry = &m_entries[0U];
+
+            for(index = 0U; index < MAX_ENTRIES; ++index)
+            {
+                if (0U == m_entries[index].uri.length())
+                {
+                    entry = &m_entries[index];
+                    break;
+                }
+                else if ((timestamp - m_entries[index].timestamp) > (timestamp - entry->timestamp))
+                {
+                    entry = &m_entries[index];
+                }
+                else
+                {
+                    ;
+                }
+            }
+
+            entry->uri = uri;
+        }
+
+        entry->body         = body;
+        entry->timestamp    = timestamp;
+        entry->ttl          = ttl;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+void ResponseCache::invalidate(const char* uri)
+{
+    if ((nullptr == m_xMutex) ||
+        (nullptr == uri))
+    {
+        return;
+    }
+
+    /* A response, which is built at the moment, shall not be stored. */
+    (void)m_revision.fetch_add(1U, std::memory_order_acq_rel);
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    Entry* entry = findEntry(uri);
+
+    if (nullptr != entry)
+    {
+        entry->uri  = "";
+        entry->body = "";
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ResponseCache::Entry* ResponseCache::findEntry(const char* uri)
+{
+    Entry*  entry = nullptr;
+    uint8_t index = 0U;
+
+    while((nullptr == entry) && (MAX_ENTRIES > index))
+    {
+        if ((0U < m_entries[index].uri.length()) &&
+            (m_entries[index].uri == uri))
+        {
+            entry = &m_entries[index];
+        }
+
+        ++index;
+    }
+
+    return entry;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,195 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Short-lived cache of REST responses
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __RESPONSE_CACHE_H__
+#define __RESPONSE_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+#include <WString.h>
+#include <ESPAsyncWebServer.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The response cache keeps the serialized responses of read-mostly GET
+ * endpoints for a short time, keyed by their URI. Identical requests within
+ * the time to live get the cached bytes, instead of querying and serializing
+ * the state again.
+ *
+ * The owner of a state invalidates the responses, which depend on it, as
+ * soon as it changes. A response, which was built while it was invalidated,
+ * is not stored, because it may contain the old state.
+ */
+class ResponseCache
+{
+public:
+
+    /**
+     * Get the response cache instance.
+     *
+     * @return Response cache
+     */
+    static ResponseCache& getInstance()
+    {
+        static ResponseCache instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Is the request cacheable?
+     *
+     * @param[in] request   HTTP request
+     *
+     * @return If it is cacheable, it will return true otherwise false.
+     */
+    bool isCacheable(AsyncWebServerRequest* request) const;
+
+    /**
+     * Send the cached response, if the request can be served from the cache.
+     * Only GET requests without arguments are served.
+     *
+     * @param[in] request   HTTP request
+     *
+     * @return If the cached response is sent, it will return true otherwise false.
+     */
+    bool send(AsyncWebServerRequest* request);
+
+    /**
+     * Get the current revision of the cache. It shall be retrieved before
+     * the response is built and passed to store().
+     *
+     * @return Revision
+     */
+    uint32_t getRevision() const
+    {
+        return m_revision.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Store the response of a request. Only GET requests without arguments
+     * are stored. If the cache was invalidated since the revision was
+     * retrieved, the response is not stored.
+     *
+     * @param[in] request   HTTP request
+     * @param[in] revision  Revision of the cache, before the response was built
+     * @param[in] ttl       Time to live in ms
+     * @param[in] body      Serialized response body
+     */
+    void store(AsyncWebServerRequest* request, uint32_t revision, uint32_t ttl, const String& body);
+
+    /**
+     * Invalidate the cached response of a URI.
+     *
+     * @param[in] uri   URI
+     */
+    void invalidate(const char* uri);
+
+    /** Max. number of cached responses. */
+    static const uint8_t    MAX_ENTRIES = 4U;
+
+private:
+
+    /**
+     * A cached response.
+     */
+    struct Entry
+    {
+        String      uri;        /**< URI, empty if unused */
+        String      body;       /**< Serialized response body */
+        uint32_t    timestamp;  /**< Timestamp in ms, when it was stored */
+        uint32_t    ttl;        /**< Time to live in ms */
+    };
+
+    SemaphoreHandle_t       m_xMutex;               /**< Mutex to protect the entries */
+    Entry                   m_entries[MAX_ENTRIES]; /**< Cached responses */
+    std::atomic<uint32_t>   m_revision;             /**< Revision, which changes with every invalidation */
+
+    /**
+     * Constructs the response cache.
+     */
+    ResponseCache() :
+        m_xMutex(xSemaphoreCreateMutex()),
+        m_entries(),
+        m_revision(0U)
+    {
+    }
+
+    /**
+     * Destroys the response cache.
+     */
+    ~ResponseCache()
+    {
+        if (nullptr != m_xMutex)
+        {
+            vSemaphoreDelete(m_xMutex);
+            m_xMutex = nullptr;
+        }
+    }
+
+    ResponseCache(const ResponseCache& cache);
+    ResponseCache& operator=(const ResponseCache& cache);
+
+    /**
+     * Find the entry of a URI. The mutex must be taken by the caller.
+     *
+     * @param[in] uri   URI
+     *
+     * @return Entry or nullptr if not found.
+     */
+    Entry* findEntry(const char* uri);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __RESPONSE_CACHE_H__ */
+
+/** @} */
@@ -39,14 +39,33 @@
 #include "DisplayMgr.h"
 #include "Version.h"
 #include "PluginMgr.h"
+#include "PluginRegistry.h"
 #include "WiFiUtil.h"
 #include "FileSystem.h"
+#include "FileIo.h"
+#include "PooledJsonDocument.h"
+#include "HttpClientPool.h"
+#include "Pages.h"
+#include "CrashTrace.h"
+#include "TaskMon.h"
+#include "NetMon.h"
+#include "DiagService.h"
+#include "PowerMgr.h"
+#include "NetBenchmark.h"
+#include "MicroBench.h"
+#include "ResponseCache.h"
+#include "FileUploader.h"
 
 #include <Util.h>
 #include <WiFi.h>
 #include <ArduinoJson.h>
 #include <Esp.h>
 #include <Logging.h>
+#include <Metrics.h>
+#include <SlotPlan.h>
+#include <MemPolicy.h>
+#include <ImageEncoder.h>
+#include <memory>
 
 /******************************************************************************
  * Compiler Switches
@@ -60,16 +79,142 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * Context of a directory listing, which is streamed in a chunked response.
+ * Every entry is serialized, when the response requests the next chunk.
+ */
+struct DirListing
+{
+    /** Listing parts. */
+    enum Part
+    {
+        PART_HEAD = 0,  /**< Begin of the JSON object */
+        PART_ENTRIES,   /**< Directory entries */
+        PART_TAIL,      /**< End of the JSON object with the next cursor */
+        PART_END        /**< Listing complete */
+    };
+
+    /** Max. size of a serialized part in byte. */
+    static const size_t PIECE_SIZE  = 256U;
+
+    File        dir;                /**< Directory */
+    File        entry;              /**< Next directory entry, which is not serialized yet */
+    uint32_t    cursor;             /**< Cursor of the next directory entry */
+    uint32_t    remaining;          /**< Number of entries, which may be serialized */
+    Part        part;               /**< Current listing part */
+    bool        isFirstEntry;       /**< Is the next entry the first one in the listing? */
+    char        piece[PIECE_SIZE];  /**< Serialized part, which is not completely sent */
+    size_t      pieceLen;           /**< Length of the serialized part in byte */
+    size_t      pieceOffset;        /**< Number of already sent bytes of the serialized part */
+
+    /**
+     * Constructs the directory listing context.
+     */
+    DirListing() :
+        dir(),
+        entry(),
+        cursor(0U),
+        remaining(0U),
+        part(PART_HEAD),
+        isFirstEntry(true),
+        piece(),
+        pieceLen(0U),
+        pieceOffset(0U)
+    {
+    }
+
+    /**
+     * Destroys the directory listing context and closes the directory.
+     */
+    ~DirListing()
+    {
+        if (true == entry)
+        {
+            entry.close();
+        }
+
+        if (true == dir)
+        {
+            dir.close();
+        }
+    }
+};
+
+/**
+ * Context of a screenshot, which is streamed in the response.
+ * The image is encoded from the frame copy while it is sent.
+ */
+struct Screenshot
+{
+    uint32_t*       frame;      /**< Copy of the published frame */
+    ImageEncoder    encoder;    /**< Image encoder, which reads the frame copy. */
+
+    /**
+     * Constructs the screenshot context and takes the ownership of the frame copy.
+     *
+     * @param[in] frameCopy Frame copy, allocated with MemPolicy.
+     * @param[in] format    Image format
+     * @param[in] scale     Upscale factor
+     */
+    Screenshot(uint32_t* frameCopy, ImageEncoder::Format format, uint8_t scale) :
+        frame(frameCopy),
+        encoder(format, frameCopy, Board::LedMatrix::width, Board::LedMatrix::height, scale)
+    {
+    }
+
+    /**
+     * Destroys the screenshot context and releases the frame copy.
+     */
+    ~Screenshot()
+    {
+        MemPolicy::release(frame);
+    }
+};
+
+/**
+ * Result of parsing a HTTP range request header.
+ */
+enum RangeResult
+{
+    RANGE_RESULT_IGNORED = 0,       /**< No or unsupported range, the whole file is sent. */
+    RANGE_RESULT_VALID,             /**< Single satisfiable byte range */
+    RANGE_RESULT_NOT_SATISFIABLE    /**< Range is outside of the file. */
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
 
 static void handleStatus(AsyncWebServerRequest* request);
 static void handleSlots(AsyncWebServerRequest* request);
+static void handleLayout(AsyncWebServerRequest* request);
+static void layoutBodyHandler(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total);
+static bool isLayoutValid(JsonArrayConst slots, const char*& msg);
+static bool applyLayout(JsonArrayConst slots, JsonArray& slotArray);
+static void handleProfile(AsyncWebServerRequest* request);
+static void addProfileSummary(JsonObject& obj, const ProfileStat::Summary& summary);
+static void handleHosts(AsyncWebServerRequest* request);
+static void handleTrace(AsyncWebServerRequest* request);
+static void handleTasks(AsyncWebServerRequest* request);
+static void handleNetStack(AsyncWebServerRequest* request);
+static void handleBenchmark(AsyncWebServerRequest* request);
+
+#if (0 != MICRO_BENCH)
+static void handleMicroBench(AsyncWebServerRequest* request);
+#endif  /* (0 != MICRO_BENCH) */
+
+static void handleMetrics(AsyncWebServerRequest* request);
 static void handlePlugin(AsyncWebServerRequest* request);
 static void handleButton(AsyncWebServerRequest* request);
+static void handleScreenshot(AsyncWebServerRequest* request);
 static void handleFilesystem(AsyncWebServerRequest* request);
+static size_t fillDirListing(DirListing& listing, uint8_t* buffer, size_t maxLen);
+static void serializeDirListingPart(DirListing& listing);
 static void handleFileGet(AsyncWebServerRequest* request);
+static void sendFile(AsyncWebServerRequest* request, const String& path);
+static bool getFileETag(const String& path, size_t& fileSize, String& eTag);
+static bool isETagMatching(const String& ifNoneMatch, const String& eTag);
+static RangeResult parseRange(const String& range, size_t fileSize, size_t& first, size_t& last);
 static String getContentType(const String& filename);
 static void handleFilePost(AsyncWebServerRequest* request);
 static void uploadHandler(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final);
@@ -79,90 +224,1148 @@ static void handleFileDelete(AsyncWebServerRequest* request);
  * Local Variables
  *****************************************************************************/
 
+/** Max. size of a display layout in byte. */
+static const size_t MAX_LAYOUT_SIZE = 4096U;
+
+/** Size of the chunks in byte, which are read to calculate the entity tag of a file. */
+static const size_t FILE_HASH_CHUNK_SIZE = 256U;
+
+/** Time to live of the cached status response in ms. */
+static const uint32_t STATUS_CACHE_TTL = 1000U;
+
+/** Time to live of the cached slots response in ms. It is invalidated by slot changes. */
+static const uint32_t SLOTS_CACHE_TTL = 2000U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+void RestApi::init(AsyncWebServer& srv)
+{
+    (void)srv.on(URI_STATUS, handleStatus);
+    (void)srv.on(URI_DISPLAY_SLOTS, handleSlots);
+    (void)srv.on("/rest/api/v1/display/layout", HTTP_POST, handleLayout, nullptr, layoutBodyHandler);
+    (void)srv.on("/rest/api/v1/display/profile", handleProfile);
+    (void)srv.on("/rest/api/v1/display/screenshot", handleScreenshot);
+    (void)srv.on("/rest/api/v1/hosts", handleHosts);
+    (void)srv.on("/rest/api/v1/trace", handleTrace);
+    (void)srv.on("/rest/api/v1/tasks", handleTasks);
+    (void)srv.on("/rest/api/v1/netstack", handleNetStack);
+    (void)srv.on("/rest/api/v1/benchmark", handleBenchmark);
+#if (0 != MICRO_BENCH)
+    (void)srv.on("/rest/api/v1/microbench", handleMicroBench);
+#endif  /* (0 != MICRO_BENCH) */
+    (void)srv.on("/metrics", HTTP_GET, handleMetrics);
+    (void)srv.on("/rest/api/v1/plugin", handlePlugin);
+    (void)srv.on("/rest/api/v1/button", handleButton);
+    (void)srv.on("/rest/api/v1/fs/file", HTTP_GET, handleFileGet);
+    (void)srv.on("/rest/api/v1/fs/file", HTTP_POST, handleFilePost, uploadHandler);
+    (void)srv.on("/rest/api/v1/fs/file", HTTP_DELETE, handleFileDelete);
+    (void)srv.on("/rest/api/v1/fs", handleFilesystem);
+
+    return;
+}
+
+/**
+ * Handle invalid rest path request.
+ *
+ * @param[in] request   HTTP request
+ */
+void RestApi::error(AsyncWebServerRequest* request)
+{
+    const size_t        JSON_DOC_SIZE   = 512U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    JsonObject          errorObj        = jsonDoc.createNestedObject("error");
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    /* Prepare response */
+    jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+    errorObj["msg"]     = "Invalid path requested.";
+    httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+    else
+    {
+        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+    }
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
+
+    return;
+}
+
+bool RestApi::isMsgPackAccepted(AsyncWebServerRequest* request)
+{
+    bool                isAccepted  = false;
+    AsyncWebHeader*     header      = nullptr;
+
+    if (nullptr != request)
+    {
+        header = request->getHeader("Accept");
+    }
+
+    if ((nullptr != header) &&
+        (0 <= header->value().indexOf(CONTENT_TYPE_MSGPACK)))
+    {
+        isAccepted = true;
+    }
+
+    return isAccepted;
+}
+
+void RestApi::sendJson(AsyncWebServerRequest* request, uint32_t httpStatusCode, const JsonDocument& jsonDoc)
+{
+    AsyncResponseStream*    response        = nullptr;
+    bool                    isMsgPack       = false;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    isMsgPack = isMsgPackAccepted(request);
+
+    /* The document is serialized directly into the response buffer,
+     * which avoids a temporary copy in a string.
+     */
+    response = request->beginResponseStream((true == isMsgPack) ? CONTENT_TYPE_MSGPACK : "application/json");
+
+    if (nullptr != response)
+    {
+        response->setCode(httpStatusCode);
+
+        /* The response depends on the negotiated content type. */
+        response->addHeader("Vary", "Accept");
+
+        if (true == isMsgPack)
+        {
+            (void)serializeMsgPack(jsonDoc, *response);
+        }
+        else if (true == request->hasArg("pretty"))
+        {
+            (void)serializeJsonPretty(jsonDoc, *response);
+        }
+        else
+        {
+            (void)serializeJson(jsonDoc, *response);
+        }
+
+        request->send(response);
+    }
+
+    return;
+}
+
+void RestApi::sendCachedJson(AsyncWebServerRequest* request, uint32_t httpStatusCode, const JsonDocument& jsonDoc, uint32_t revision, uint32_t ttl)
+{
+    ResponseCache& cache = ResponseCache::getInstance();
+
+    if ((HttpStatus::STATUS_CODE_OK != httpStatusCode) ||
+        (false == cache.isCacheable(request)))
+    {
+        sendJson(request, httpStatusCode, jsonDoc);
+    }
+    else
+    {
+        String body;
+
+        (void)serializeJson(jsonDoc, body);
+        cache.store(request, revision, ttl, body);
+        request->send(httpStatusCode, "application/json", body);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get status information.
+ * GET \c "/api/v1/status"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleStatus(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 768U;
+    const uint32_t      REVISION        = ResponseCache::getInstance().getRevision();
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    /* Requests of several monitoring clients within a short time get the
+     * same response.
+     */
+    if (true == ResponseCache::getInstance().send(request))
+    {
+        return;
+    }
+
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
+    if (HTTP_GET != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        String      ssid;
+        int8_t      rssi            = -100; // dbm
+        JsonObject  dataObj         = jsonDoc.createNestedObject("data");
+        JsonObject  hwObj           = dataObj.createNestedObject("hardware");
+        JsonObject  swObj           = dataObj.createNestedObject("software");
+        JsonObject  internalRamObj  = swObj.createNestedObject("internalRam");
+        JsonObject  wifiObj         = dataObj.createNestedObject("wifi");
+        JsonObject  displayObj      = dataObj.createNestedObject("display");
+        JsonObject  powerObj        = dataObj.createNestedObject("power");
+        DisplayMgr::Statistics displayStatistics;
+
+        /* Only in station mode it makes sense to retrieve the RSSI.
+         * Otherwise keep it -100 dbm.
+         */
+        if (WIFI_MODE_STA == WiFi.getMode())
+        {
+            rssi = WiFi.RSSI();
+        }
+
+        if (true == Settings::getInstance().open(true))
+        {
+            ssid = Settings::getInstance().getWifiSSID().getValue();
+            Settings::getInstance().close();
+        }
+
+        /* Prepare response */
+        jsonDoc["status"]       = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+
+        hwObj["chipRev"]        = ESP.getChipRevision();
+        hwObj["cpuFreqMhz"]     = ESP.getCpuFreqMHz();
+
+        swObj["version"]        = Version::SOFTWARE_VER;
+        swObj["revision"]       = Version::SOFTWARE_REV;
+        swObj["espSdkVersion"]  = ESP.getSdkVersion();
+
+        internalRamObj["heapSize"]      = ESP.getHeapSize();
+        internalRamObj["availableHeap"] = ESP.getFreeHeap();
+
+        wifiObj["ssid"]         = ssid;
+        wifiObj["rssi"]         = rssi;                             // dBm
+        wifiObj["quality"]      = WiFiUtil::getSignalQuality(rssi); // percent
+
+        DisplayMgr::getInstance().getStatistics(displayStatistics);
+
+        displayObj["targetFps"]         = displayStatistics.targetFps;
+        displayObj["frames"]            = displayStatistics.frames;
+        displayObj["missedDeadlines"]   = displayStatistics.missedDeadlines;
+        displayObj["skippedFrames"]     = displayStatistics.skippedFrames;
+        displayObj["frameTime"]         = displayStatistics.frameTime;      // ms
+        displayObj["maxFrameTime"]      = displayStatistics.maxFrameTime;   // ms
+        displayObj["frameTimeUs"]       = displayStatistics.frameTimeUs;    // us
+        displayObj["maxFrameTimeUs"]    = displayStatistics.maxFrameTimeUs; // us
+        displayObj["preemptions"]           = displayStatistics.preemptions;
+        displayObj["preemptionLatency"]     = displayStatistics.preemptionLatency;      // ms
+        displayObj["maxPreemptionLatency"]  = displayStatistics.maxPreemptionLatency;   // ms
+
+        powerObj["cpuFreqMhz"]  = PowerMgr::getInstance().getCpuFreq();
+        powerObj["reason"]      = PowerMgr::reasonToStr(PowerMgr::getInstance().getReason());
+        powerObj["load"]        = PowerMgr::getInstance().getLoad();    // percent
+
+        httpStatusCode          = HttpStatus::STATUS_CODE_OK;
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+    else
+    {
+        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+    }
+
+    RestApi::sendCachedJson(request, httpStatusCode, jsonDoc, REVISION, STATUS_CACHE_TTL);
+
+    return;
+}
+
+/**
+ * Get number of slots and which plugin is installed.
+ * GET \c "/api/v1/display/slots"
+ *
+ * Activate the plugin in a slot immediately.
+ * POST \c "/api/v1/display/slots?activate=<slot-id>&priority=<normal|urgent>"
+ *
+ * Change the number of slots without restart.
+ * POST \c "/api/v1/display/slots?maxSlots=<number>"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleSlots(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 2048U;
+    const uint32_t      REVISION        = ResponseCache::getInstance().getRevision();
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    /* The cached response is invalidated by every slot change. */
+    if (true == ResponseCache::getInstance().send(request))
+    {
+        return;
+    }
+
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
+    if ((HTTP_POST == request->method()) &&
+        (true == request->hasArg("maxSlots")))
+    {
+        uint8_t maxSlots = 0U;
+
+        if ((false == Util::strToUInt8(request->arg("maxSlots"), maxSlots)) ||
+            (false == DisplayMgr::getInstance().setMaxSlots(maxSlots)))
+        {
+            JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+            /* Prepare response */
+            jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+            errorObj["msg"]     = "Invalid number of slots or not enough empty slots.";
+            httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else
+        {
+            JsonObject dataObj = jsonDoc.createNestedObject("data");
+
+            /* Prepare response */
+            dataObj["maxSlots"] = maxSlots;
+            jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+            httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+        }
+    }
+    else if (HTTP_POST == request->method())
+    {
+        DisplayMgr&             displayMgr  = DisplayMgr::getInstance();
+        uint8_t                 slotId      = DisplayMgr::SLOT_ID_INVALID;
+        IPluginMaintenance*     plugin      = nullptr;
+        DisplayMgr::Priority    priority    = DisplayMgr::PRIORITY_NORMAL;
+        const String            PRIORITY    = request->arg("priority");
+        bool                    isValid     = true;
+
+        if (false == Util::strToUInt8(request->arg("activate"), slotId))
+        {
+            slotId = DisplayMgr::SLOT_ID_INVALID;
+        }
+        else
+        {
+            plugin = displayMgr.getPluginInSlot(slotId);
+        }
+
+        /* Without priority, the request has normal priority. */
+        if (PRIORITY == "urgent")
+        {
+            priority = DisplayMgr::PRIORITY_URGENT;
+        }
+        else if ((0U < PRIORITY.length()) &&
+                 (PRIORITY != "normal"))
+        {
+            isValid = false;
+        }
+        else
+        {
+            ;
+        }
+
+        if ((false == isValid) ||
+            (nullptr == plugin) ||
+            (false == plugin->isEnabled()))
+        {
+            JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+            /* Prepare response */
+            jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+            errorObj["msg"]     = "Invalid slot or priority.";
+            httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else
+        {
+            JsonObject dataObj = jsonDoc.createNestedObject("data");
+
+            displayMgr.activatePlugin(plugin, priority);
+
+            /* Prepare response */
+            dataObj["slotId"]   = slotId;
+            dataObj["uid"]      = plugin->getUID();
+            jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+            httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+        }
+    }
+    else if (HTTP_GET != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        JsonObject  dataObj     = jsonDoc.createNestedObject("data");
+        JsonArray   slotArray   = dataObj.createNestedArray("slots");
+        uint8_t     slotId      = 0U;
+        DisplayMgr& displayMgr  = DisplayMgr::getInstance();
+
+        /* Add max. number of slots */
+        dataObj["maxSlots"] = displayMgr.getMaxSlots();
+
+        /* Add which plugin's are installed. */
+        for(slotId = 0U; slotId < displayMgr.getMaxSlots(); ++slotId)
+        {
+            IPluginMaintenance* plugin      = displayMgr.getPluginInSlot(slotId);
+            const char*         name        = (nullptr != plugin) ? plugin->getName() : "";
+            uint16_t            uid         = (nullptr != plugin) ? plugin->getUID() : 0U;
+            bool                isLocked    = displayMgr.isSlotLocked(slotId);
+            uint32_t            duration    = displayMgr.getSlotDuration(slotId);
+            JsonObject          slot        = slotArray.createNestedObject();
+            Slot::Schedule      schedule;
+            const char*         budget      = "normal";
+
+            (void)displayMgr.getSlotSchedule(slotId, schedule);
+
+            /* Why a plugin is throttled or was disabled by the display manager. */
+            switch(displayMgr.getSlotBudgetLevel(slotId))
+            {
+            case BudgetWatchdog::LEVEL_THROTTLED:
+                budget = "throttled";
+                break;
+
+            case BudgetWatchdog::LEVEL_EXCEEDED:
+                budget = "exceeded";
+                break;
+
+            default:
+                break;
+            }
+
+            slot["name"]        = name;
+            slot["uid"]         = uid;
+            slot["isLocked"]    = isLocked;
+            slot["duration"]    = duration;
+            slot["weight"]      = schedule.weight;
+            slot["timeBegin"]   = schedule.timeBegin;
+            slot["timeEnd"]     = schedule.timeEnd;
+            slot["budget"]      = budget;
+        }
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+    else
+    {
+        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+    }
+
+    RestApi::sendCachedJson(request, httpStatusCode, jsonDoc, REVISION, SLOTS_CACHE_TTL);
+
+    return;
+}
+
+/**
+ * Apply a display layout, which configures several slots at once. The whole
+ * layout is validated first and applied afterwards, while the display waits.
+ * The slot installation is stored only once.
+ * POST \c "/api/v1/display/layout"
+ *
+ * Body:
+ * {
+ *     "slots": [{
+ *         "slotId": 0,
+ *         "plugin": "JustTextPlugin",
+ *         "duration": 30000,
+ *         "isLocked": false,
+ *         "weight": 1,
+ *         "timeBegin": 0,
+ *         "timeEnd": 0,
+ *         "settings": { "text": "Hello" }
+ *     }]
+ * }
+ *
+ * Except the slot id, all slot properties are optional. A slot keeps its
+ * plugin, if it has already one with the same name. A empty plugin name
+ * removes the plugin from the slot.
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleLayout(AsyncWebServerRequest* request)
+{
+    const size_t        JSON_DOC_SIZE   = 1024U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_POST != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else if (MAX_LAYOUT_SIZE < request->contentLength())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "Layout too large.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_PAYLOAD_TOO_LARGE;
+    }
+    else
+    {
+        const size_t        LAYOUT_DOC_SIZE = 4096U;
+        PooledJsonDocument  layoutDoc(LAYOUT_DOC_SIZE);
+        const char*         msg             = nullptr;
+
+        /* The body is parsed in place, the strings refer to the buffer. */
+        if ((nullptr == request->_tempObject) ||
+            (DeserializationError::Ok != deserializeJson(layoutDoc, static_cast<char*>(request->_tempObject), request->contentLength())) ||
+            (false == layoutDoc["slots"].is<JsonArray>()))
+        {
+            msg = "Invalid layout.";
+        }
+        else if (true == isLayoutValid(layoutDoc["slots"].as<JsonArrayConst>(), msg))
+        {
+            JsonObject  dataObj     = jsonDoc.createNestedObject("data");
+            JsonArray   slotArray   = dataObj.createNestedArray("slots");
+
+            if (false == applyLayout(layoutDoc["slots"].as<JsonArrayConst>(), slotArray))
+            {
+                msg = "Layout partially applied.";
+            }
+        }
+        else
+        {
+            ;
+        }
+
+        if (nullptr != msg)
+        {
+            JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+            /* Prepare response */
+            jsonDoc.remove("data");
+            jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+            errorObj["msg"]     = msg;
+            httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else
+        {
+            /* Prepare response */
+            jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+            httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+        }
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+    else
+    {
+        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+    }
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
+
+    return;
+}
+
+/**
+ * Collect the display layout, which may be received in several parts.
+ * It is stored in the request and released together with it.
+ *
+ * @param[in] request   HTTP request
+ * @param[in] data      Received body data
+ * @param[in] len       Length of the received body data in byte
+ * @param[in] index     Position of the received data in the body
+ * @param[in] total     Total body length in byte
+ */
+static void layoutBodyHandler(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total)
+{
+    if ((nullptr != request) &&
+        (nullptr != data) &&
+        (MAX_LAYOUT_SIZE >= total) &&
+        (total >= (index + len)))
+    {
+        if (0U == index)
+        {
+            request->_tempObject = malloc(total);
+        }
+
+        if (nullptr != request->_tempObject)
+        {
+            memcpy(&static_cast<uint8_t*>(request->_tempObject)[index], data, len);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Validate the display layout, before anything is changed.
+ *
+ * @param[in]   slots   Slots of the layout
+ * @param[out]  msg     Error message, if the layout is invalid.
+ *
+ * @return If the layout is valid, it will return true otherwise false.
+ */
+static bool isLayoutValid(JsonArrayConst slots, const char*& msg)
+{
+    DisplayMgr& displayMgr  = DisplayMgr::getInstance();
+    size_t      index       = 0U;
+
+    msg = nullptr;
+
+    while((nullptr == msg) && (slots.size() > index))
+    {
+        JsonObjectConst     slot        = slots[index].as<JsonObjectConst>();
+        JsonVariantConst    slotId      = slot["slotId"];
+        JsonVariantConst    pluginName  = slot["plugin"];
+        JsonVariantConst    isLocked    = slot["isLocked"];
+        size_t              otherIndex  = 0U;
+
+        if ((true == slot.isNull()) ||
+            (false == slotId.is<uint8_t>()) ||
+            (displayMgr.getMaxSlots() <= slotId.as<uint8_t>()))
+        {
+            msg = "Invalid slot id.";
+        }
+        else if (((false == slot["duration"].isNull()) && (false == slot["duration"].is<uint32_t>())) ||
+                 ((false == isLocked.isNull()) && (false == isLocked.is<bool>())) ||
+                 ((false == slot["weight"].isNull()) && ((false == slot["weight"].is<uint8_t>()) || (SlotPlan::MAX_WEIGHT < slot["weight"].as<uint8_t>()))) ||
+                 ((false == slot["timeBegin"].isNull()) && ((false == slot["timeBegin"].is<uint16_t>()) || (SlotPlan::MINUTES_PER_DAY <= slot["timeBegin"].as<uint16_t>()))) ||
+                 ((false == slot["timeEnd"].isNull()) && ((false == slot["timeEnd"].is<uint16_t>()) || (SlotPlan::MINUTES_PER_DAY <= slot["timeEnd"].as<uint16_t>()))) ||
+                 ((false == slot["settings"].isNull()) && (false == slot["settings"].is<JsonObjectConst>())))
+        {
+            msg = "Invalid slot property.";
+        }
+        else if (false == pluginName.isNull())
+        {
+            IPluginMaintenance* plugin  = displayMgr.getPluginInSlot(slotId.as<uint8_t>());
+            const char*         name    = pluginName.as<const char*>();
+
+            if (nullptr == name)
+            {
+                msg = "Invalid plugin name.";
+            }
+            else if (('\0' != name[0]) &&
+                     (nullptr == PluginRegistry::findByName(name)))
+            {
+                msg = "Plugin unknown.";
+            }
+            /* A locked slot keeps its plugin, except it is unlocked by the layout. */
+            else if ((true == displayMgr.isSlotLocked(slotId.as<uint8_t>())) &&
+                     ((false == isLocked.is<bool>()) || (true == isLocked.as<bool>())) &&
+                     (0 != strcmp(name, (nullptr != plugin) ? plugin->getName() : "")))
+            {
+                msg = "Slot is locked.";
+            }
+            else
+            {
+                ;
+            }
+        }
+        else
+        {
+            ;
+        }
+
+        /* Every slot shall be configured only once. */
+        for(otherIndex = index + 1U; (nullptr == msg) && (slots.size() > otherIndex); ++otherIndex)
+        {
+            if (slotId.as<uint8_t>() == slots[otherIndex]["slotId"].as<uint8_t>())
+            {
+                msg = "Slot id is not unique.";
+            }
+        }
+
+        ++index;
+    }
+
+    return (nullptr == msg);
+}
+
+/**
+ * Apply a validated display layout. The display waits until all slots are
+ * changed and the slot installation is stored once at the end.
+ *
+ * @param[in]   slots       Slots of the layout
+ * @param[out]  slotArray   Resulting slots with their plugin UIDs
+ *
+ * @return If all slots are changed, it will return true otherwise false.
+ */
+static bool applyLayout(JsonArrayConst slots, JsonArray& slotArray)
+{
+    DisplayMgr& displayMgr  = DisplayMgr::getInstance();
+    PluginMgr&  pluginMgr   = PluginMgr::getInstance();
+    bool        status      = true;
+
+    pluginMgr.beginBatch();
+
+    for(JsonVariantConst slotVariant: slots)
+    {
+        JsonObjectConst     slot        = slotVariant.as<JsonObjectConst>();
+        uint8_t             slotId      = slot["slotId"].as<uint8_t>();
+        JsonVariantConst    pluginName  = slot["plugin"];
+        JsonVariantConst    isLocked    = slot["isLocked"];
+        IPluginMaintenance* plugin      = displayMgr.getPluginInSlot(slotId);
+        Slot::Schedule      schedule;
+        JsonObject          slotObj     = slotArray.createNestedObject();
+
+        /* Unlock first, because a locked slot keeps its plugin. */
+        if ((true == isLocked.is<bool>()) &&
+            (false == isLocked.as<bool>()))
+        {
+            displayMgr.unlockSlot(slotId);
+        }
+
+        if (false == pluginName.isNull())
+        {
+            const char* name = pluginName.as<const char*>();
+
+            if ((nullptr == plugin) ||
+                (0 != strcmp(name, plugin->getName())))
+            {
+                if ((nullptr != plugin) &&
+                    (false == pluginMgr.uninstall(plugin)))
+                {
+                    status = false;
+                }
+                else if ('\0' == name[0])
+                {
+                    plugin = nullptr;
+                }
+                else
+                {
+                    plugin = pluginMgr.install(name, slotId);
+
+                    if (nullptr == plugin)
+                    {
+                        status = false;
+                    }
+                    else
+                    {
+                        plugin->enable();
+                    }
+                }
+            }
+        }
+
+        if (false == slot["duration"].isNull())
+        {
+            (void)displayMgr.setSlotDuration(slotId, slot["duration"].as<uint32_t>(), false);
+        }
+
+        if (true == displayMgr.getSlotSchedule(slotId, schedule))
+        {
+            schedule.weight     = slot["weight"] | schedule.weight;
+            schedule.timeBegin  = slot["timeBegin"] | schedule.timeBegin;
+            schedule.timeEnd    = slot["timeEnd"] | schedule.timeEnd;
+
+            (void)displayMgr.setSlotSchedule(slotId, schedule, false);
+        }
+
+        if ((false == slot["settings"].isNull()) &&
+            ((nullptr == plugin) || (false == plugin->applySettings(slot["settings"].as<JsonObjectConst>()))))
+        {
+            status = false;
+        }
+
+        if ((true == isLocked.is<bool>()) &&
+            (true == isLocked.as<bool>()))
+        {
+            displayMgr.lockSlot(slotId);
+        }
+
+        slotObj["slotId"]   = slotId;
+        slotObj["uid"]      = (nullptr != plugin) ? plugin->getUID() : 0U;
+    }
+
+    /* Save slot installation and configuration at once. */
+    pluginMgr.endBatch();
+
+    return status;
+}
+
+/**
+ * Get runtime profile of every installed plugin and of the fade effect.
+ * GET \c "/api/v1/display/profile"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleProfile(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 4096U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        JsonObject              dataObj     = jsonDoc.createNestedObject("data");
+        JsonObject              fadeObj     = dataObj.createNestedObject("fade");
+        JsonArray               slotArray   = dataObj.createNestedArray("slots");
+        uint8_t                 slotId      = 0U;
+        DisplayMgr&             displayMgr  = DisplayMgr::getInstance();
+        ProfileStat::Summary    fadeProfile;
+
+        displayMgr.getFadeProfile(fadeProfile);
+        addProfileSummary(fadeObj, fadeProfile);
+
+        for(slotId = 0U; slotId < displayMgr.getMaxSlots(); ++slotId)
+        {
+            IPluginMaintenance*         plugin      = displayMgr.getPluginInSlot(slotId);
+            const char*                 name        = (nullptr != plugin) ? plugin->getName() : "";
+            uint16_t                    uid         = (nullptr != plugin) ? plugin->getUID() : 0U;
+            JsonObject                  slot        = slotArray.createNestedObject();
+            JsonObject                  processObj  = slot.createNestedObject("process");
+            JsonObject                  updateObj   = slot.createNestedObject("update");
+            JsonObject                  activeObj   = slot.createNestedObject("active");
+            DisplayMgr::PluginProfile   profile;
+
+            slot["name"]    = name;
+            slot["uid"]     = uid;
+
+            if (true == displayMgr.getPluginProfile(slotId, profile))
+            {
+                addProfileSummary(processObj, profile.process);
+                addProfileSummary(updateObj, profile.update);
+                addProfileSummary(activeObj, profile.active);
+            }
+        }
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+    else
+    {
+        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+    }
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
+
+    return;
+}
+
+/**
+ * Add runtime profile summary to a JSON object.
+ *
+ * @param[in] obj       JSON object
+ * @param[in] summary   Runtime profile summary in us
+ */
+static void addProfileSummary(JsonObject& obj, const ProfileStat::Summary& summary)
+{
+    obj["count"]    = summary.count;
+    obj["min"]      = summary.min;  // us
+    obj["avg"]      = summary.avg;  // us
+    obj["max"]      = summary.max;  // us
+    obj["p99"]      = summary.p99;  // us
+
+    return;
+}
+
+/**
+ * Get the health of the remote hosts, which are requested by the plugins.
+ * GET \c "/api/v1/hosts"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleHosts(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 1024U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        JsonObject                  dataObj     = jsonDoc.createNestedObject("data");
+        JsonArray                   hostArray   = dataObj.createNestedArray("hosts");
+        HttpClientPool::HostInfo    infos[HttpClientPool::MAX_HOSTS];
+        uint8_t                     count       = HttpClientPool::getInstance().getHostInfos(infos, HttpClientPool::MAX_HOSTS);
+        uint8_t                     index       = 0U;
+
+        for(index = 0U; index < count; ++index)
+        {
+            JsonObject  hostObj = hostArray.createNestedObject();
+            const char* state   = "online";
+
+            if (HttpClientPool::HOST_STATE_OFFLINE == infos[index].state)
+            {
+                state = "offline";
+            }
+            else if (HttpClientPool::HOST_STATE_PROBING == infos[index].state)
+            {
+                state = "probing";
+            }
+            else
+            {
+                ;
+            }
+
+            hostObj["host"]     = infos[index].host;
+            hostObj["state"]    = state;
+            hostObj["failures"] = infos[index].failures;
+            hostObj["retryIn"]  = infos[index].retryIn; // ms
+        }
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
+
+    return;
+}
+
+/**
+ * Get the crash surviving trace, which contains the recent events incl.
+ * the ones before the last reset.
+ * GET \c "/api/v1/trace"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleTrace(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(3) +
+                                          JSON_ARRAY_SIZE(CrashTrace::MAX_ENTRIES) +
+                                          (CrashTrace::MAX_ENTRIES * JSON_ARRAY_SIZE(4));
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        CrashTrace&         trace       = CrashTrace::getInstance();
+        JsonObject          dataObj     = jsonDoc.createNestedObject("data");
+        JsonArray           eventArray;
+        CrashTrace::Entry*  entries     = new CrashTrace::Entry[CrashTrace::MAX_ENTRIES];
+        uint16_t            count       = 0U;
+        uint16_t            index       = 0U;
+
+        dataObj["bootCount"]    = trace.getBootCount();
+        dataObj["resetReason"]  = trace.getResetReason();
+        eventArray              = dataObj.createNestedArray("events");
+
+        if (nullptr != entries)
+        {
+            count = trace.getEntries(entries, CrashTrace::MAX_ENTRIES);
+        }
+
+        /* Every event is a compact array: timestamp, type, arg8, arg16 */
+        for(index = 0U; index < count; ++index)
+        {
+            JsonArray eventObj = eventArray.createNestedArray();
+
+            (void)eventObj.add(entries[index].timestamp);
+            (void)eventObj.add(CrashTrace::typeToStr(entries[index].type));
+            (void)eventObj.add(entries[index].arg8);
+            (void)eventObj.add(entries[index].arg16);
+        }
+
+        delete[] entries;
 
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    }
 
-/******************************************************************************
- * External Functions
- *****************************************************************************/
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
 
-void RestApi::init(AsyncWebServer& srv)
-{
-    (void)srv.on("/rest/api/v1/status", handleStatus);
-    (void)srv.on("/rest/api/v1/display/slots", handleSlots);
-    (void)srv.on("/rest/api/v1/plugin", handlePlugin);
-    (void)srv.on("/rest/api/v1/button", handleButton);
-    (void)srv.on("/rest/api/v1/fs/file", HTTP_GET, handleFileGet);
-    (void)srv.on("/rest/api/v1/fs/file", HTTP_POST, handleFilePost, uploadHandler);
-    (void)srv.on("/rest/api/v1/fs/file", HTTP_DELETE, handleFileDelete);
-    (void)srv.on("/rest/api/v1/fs", handleFilesystem);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
 /**
- * Handle invalid rest path request.
+ * Get the task informations of the latest task monitor sample.
+ * GET \c "/api/v1/tasks"
  *
  * @param[in] request   HTTP request
  */
-void RestApi::error(AsyncWebServerRequest* request)
+static void handleTasks(AsyncWebServerRequest* request)
 {
-    String              content;
-    const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    JsonObject          errorObj        = jsonDoc.createNestedObject("error");
+    const size_t        JSON_DOC_SIZE   = JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(2) +
+                                          JSON_ARRAY_SIZE(TaskMon::MAX_TASKS) +
+                                          (TaskMon::MAX_TASKS * (JSON_OBJECT_SIZE(6) + TaskMon::MAX_TASK_NAME_LEN));
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
         return;
     }
 
-    /* Prepare response */
-    jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
-    errorObj["msg"]     = "Invalid path requested.";
-    httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
-
-    if (true == jsonDoc.overflowed())
+    if (HTTP_GET != request->method())
     {
-        LOG_ERROR("JSON document has less memory available.");
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
     }
     else
     {
-        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+        JsonObject          dataObj     = jsonDoc.createNestedObject("data");
+        JsonArray           taskArray;
+        TaskMon::TaskInfo*  infos       = new TaskMon::TaskInfo[TaskMon::MAX_TASKS];
+        uint8_t             count       = 0U;
+        uint8_t             index       = 0U;
+
+        dataObj["period"]   = DiagService::getInstance().getPeriod(DiagService::JOB_TASK_MON); // ms
+        taskArray           = dataObj.createNestedArray("tasks");
+
+        if (nullptr != infos)
+        {
+            count = TaskMon::getInstance().getTaskInfos(infos, TaskMon::MAX_TASKS);
+        }
+
+        for(index = 0U; index < count; ++index)
+        {
+            JsonObject taskObj = taskArray.createNestedObject();
+
+            taskObj["name"]     = infos[index].name;
+            taskObj["core"]     = infos[index].coreId;
+            taskObj["prio"]     = infos[index].priority;
+            taskObj["state"]    = TaskMon::taskStateToStr(infos[index].state);
+            taskObj["cpu"]      = infos[index].cpuLoad; // %
+            taskObj["stackHwm"] = infos[index].stackHighWaterMark; // byte
+        }
+
+        delete[] infos;
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
-/******************************************************************************
- * Local Functions
- *****************************************************************************/
-
 /**
- * Get status information.
- * GET \c "/api/v1/status"
+ * Get the network stack statistic of the latest network stack monitor sample.
+ * GET \c "/api/v1/netstack"
  *
  * @param[in] request   HTTP request
  */
-static void handleStatus(AsyncWebServerRequest* request)
+static void handleNetStack(AsyncWebServerRequest* request)
 {
-    String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    const size_t        JSON_DOC_SIZE   = JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(10);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -180,75 +1383,118 @@ static void handleStatus(AsyncWebServerRequest* request)
     }
     else
     {
-        String      ssid;
-        int8_t      rssi            = -100; // dbm
-        JsonObject  dataObj         = jsonDoc.createNestedObject("data");
-        JsonObject  hwObj           = dataObj.createNestedObject("hardware");
-        JsonObject  swObj           = dataObj.createNestedObject("software");
-        JsonObject  internalRamObj  = swObj.createNestedObject("internalRam");
-        JsonObject  wifiObj         = dataObj.createNestedObject("wifi");
-
-        /* Only in station mode it makes sense to retrieve the RSSI.
-         * Otherwise keep it -100 dbm.
-         */
-        if (WIFI_MODE_STA == WiFi.getMode())
-        {
-            rssi = WiFi.RSSI();
-        }
-
-        if (true == Settings::getInstance().open(true))
-        {
-            ssid = Settings::getInstance().getWifiSSID().getValue();
-            Settings::getInstance().close();
-        }
+        JsonObject      dataObj = jsonDoc.createNestedObject("data");
+        JsonObject      pbufObj;
+        JsonObject      tcpObj;
+        NetMon::Stat    stat;
+
+        NetMon::getInstance().getStat(stat);
+
+        dataObj["period"]           = DiagService::getInstance().getPeriod(DiagService::JOB_NET_MON); // ms
+        pbufObj                     = dataObj.createNestedObject("pbufPool");
+        pbufObj["used"]             = stat.pbufPoolUsed;
+        pbufObj["maxUsed"]          = stat.pbufPoolMaxUsed;
+        pbufObj["size"]             = stat.pbufPoolSize;
+        pbufObj["errors"]           = stat.pbufPoolErrors;
+        tcpObj                      = dataObj.createNestedObject("tcp");
+        tcpObj["pcbsUsed"]          = stat.tcpPcbUsed;
+        tcpObj["pcbsSize"]          = stat.tcpPcbSize;
+        tcpObj["active"]            = stat.activePcbs;
+        tcpObj["listen"]            = stat.listenPcbs;
+        tcpObj["timeWait"]          = stat.timeWaitPcbs;
+        tcpObj["stalled"]           = stat.stalledPcbs;
+        tcpObj["sndBuf"]            = stat.sndBufUsed; // byte
+        tcpObj["maxSndBuf"]         = stat.maxSndBufUsed; // byte
+        tcpObj["maxSndQueueLen"]    = stat.maxSndQueueLen;
+        tcpObj["retransmissions"]   = stat.retransmissions;
 
         /* Prepare response */
-        jsonDoc["status"]       = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    }
 
-        hwObj["chipRev"]        = ESP.getChipRevision();
-        hwObj["cpuFreqMhz"]     = ESP.getCpuFreqMHz();
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
+    }
 
-        swObj["version"]        = Version::SOFTWARE_VER;
-        swObj["revision"]       = Version::SOFTWARE_REV;
-        swObj["espSdkVersion"]  = ESP.getSdkVersion();
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
-        internalRamObj["heapSize"]      = ESP.getHeapSize();
-        internalRamObj["availableHeap"] = ESP.getFreeHeap();
+    return;
+}
 
-        wifiObj["ssid"]         = ssid;
-        wifiObj["rssi"]         = rssi;                             // dBm
-        wifiObj["quality"]      = WiFiUtil::getSignalQuality(rssi); // percent
+/**
+ * Get the stored network benchmark results or remove them.
+ * GET \c "/api/v1/benchmark"
+ * DELETE \c "/api/v1/benchmark"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleBenchmark(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = NetBenchmark::RESULTS_DOC_SIZE + JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(2);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
-        httpStatusCode          = HttpStatus::STATUS_CODE_OK;
+    if (nullptr == request)
+    {
+        return;
     }
 
-    if (true == jsonDoc.overflowed())
+    if (HTTP_GET == request->method())
     {
-        LOG_ERROR("JSON document has less memory available.");
+        JsonObject  dataObj     = jsonDoc.createNestedObject("data");
+        JsonArray   resultArray = dataObj.createNestedArray("results");
+
+        dataObj["isRunning"] = NetBenchmark::getInstance().isRunning();
+        NetBenchmark::getInstance().getResults(resultArray);
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+    }
+    else if (HTTP_DELETE == request->method())
+    {
+        NetBenchmark::getInstance().clearResults();
+
+        /* Prepare response */
+        (void)jsonDoc.createNestedObject("data");
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
     }
     else
     {
-        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+
+    if (true == jsonDoc.overflowed())
+    {
+        LOG_ERROR("JSON document has less memory available.");
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
+#if (0 != MICRO_BENCH)
+
 /**
- * Get number of slots and which plugin is installed.
- * GET \c "/api/v1/display/slots"
+ * Get the report of the micro benchmark, which run at startup.
+ * GET \c "/api/v1/microbench"
  *
  * @param[in] request   HTTP request
  */
-static void handleSlots(AsyncWebServerRequest* request)
+static void handleMicroBench(AsyncWebServerRequest* request)
 {
-    String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 1024U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    const size_t        JSON_DOC_SIZE   = MicroBench::REPORT_DOC_SIZE + JSON_OBJECT_SIZE(2);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -266,29 +1512,9 @@ static void handleSlots(AsyncWebServerRequest* request)
     }
     else
     {
-        JsonObject  dataObj     = jsonDoc.createNestedObject("data");
-        JsonArray   slotArray   = dataObj.createNestedArray("slots");
-        uint8_t     slotId      = 0U;
-        DisplayMgr& displayMgr  = DisplayMgr::getInstance();
-
-        /* Add max. number of slots */
-        dataObj["maxSlots"] = displayMgr.getMaxSlots();
-
-        /* Add which plugin's are installed. */
-        for(slotId = 0U; slotId < displayMgr.getMaxSlots(); ++slotId)
-        {
-            IPluginMaintenance* plugin      = displayMgr.getPluginInSlot(slotId);
-            const char*         name        = (nullptr != plugin) ? plugin->getName() : "";
-            uint16_t            uid         = (nullptr != plugin) ? plugin->getUID() : 0U;
-            bool                isLocked    = displayMgr.isSlotLocked(slotId);
-            uint32_t            duration    = displayMgr.getSlotDuration(slotId);
-            JsonObject          slot        = slotArray.createNestedObject();
+        JsonObject dataObj = jsonDoc.createNestedObject("data");
 
-            slot["name"]        = name;
-            slot["uid"]         = uid;
-            slot["isLocked"]    = isLocked;
-            slot["duration"]    = duration;
-        }
+        MicroBench::getInstance().getReport(dataObj);
 
         /* Prepare response */
         jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
@@ -299,13 +1525,37 @@ static void handleSlots(AsyncWebServerRequest* request)
     {
         LOG_ERROR("JSON document has less memory available.");
     }
-    else
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
+
+    return;
+}
+
+#endif  /* (0 != MICRO_BENCH) */
+
+/**
+ * Export all registered metrics in the Prometheus text format.
+ * GET \c "/metrics"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleMetrics(AsyncWebServerRequest* request)
+{
+    AsyncResponseStream* response = nullptr;
+
+    if (nullptr == request)
     {
-        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
+        return;
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    /* Every sample line is written directly into the response buffer. */
+    response = request->beginResponseStream("text/plain; version=0.0.4");
+
+    if (nullptr != response)
+    {
+        Metrics::getInstance().write(*response);
+        request->send(response);
+    }
 
     return;
 }
@@ -320,9 +1570,8 @@ static void handleSlots(AsyncWebServerRequest* request)
  */
 static void handlePlugin(AsyncWebServerRequest* request)
 {
-    String              content;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
 
     if (nullptr == request)
@@ -505,8 +1754,7 @@ static void handlePlugin(AsyncWebServerRequest* request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -520,10 +1768,9 @@ static void handlePlugin(AsyncWebServerRequest* request)
  */
 static void handleButton(AsyncWebServerRequest* request)
 {
-    String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -588,25 +1835,136 @@ static void handleButton(AsyncWebServerRequest* request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
+
+    return;
+}
+
+/**
+ * Get a screenshot of the current display content (logical colors, without
+ * the brightness applied) as BMP (?format=bmp, default) or uncompressed PNG
+ * (?format=png), optionally upscaled (?scale=<factor>, default 1).
+ * Only the frame is copied, the image is encoded while it is sent.
+ *
+ * GET \c "/api/v1/display/screenshot"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleScreenshot(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 256U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
+    const uint8_t       MAX_SCALE       = 16U;
+    const size_t        PIXEL_COUNT     = Board::LedMatrix::width * Board::LedMatrix::height;
+    String              formatStr;
+    String              scaleStr;
+    uint8_t             scale           = 1U;
+    uint32_t*           frame           = nullptr;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    formatStr   = request->arg("format");
+    scaleStr    = request->arg("scale");
+
+    if (HTTP_GET != request->method())
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "HTTP method not supported.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else if ((false == formatStr.isEmpty()) &&
+             (false == formatStr.equals("bmp")) &&
+             (false == formatStr.equals("png")))
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "Invalid format.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
+    else if ((false == scaleStr.isEmpty()) &&
+             ((false == Util::strToUInt8(scaleStr, scale)) ||
+              (0U == scale) ||
+              (MAX_SCALE < scale)))
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "Invalid scale.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
+    else if (nullptr == (frame = static_cast<uint32_t*>(MemPolicy::allocate(MemPolicy::REGION_LARGE, PIXEL_COUNT * sizeof(uint32_t)))))
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = "Out of memory.";
+        httpStatusCode      = HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR;
+    }
+    else
+    {
+        bool                        isPng       = formatStr.equals("png");
+        uint8_t                     slotId      = DisplayMgr::SLOT_ID_INVALID;
+        std::shared_ptr<Screenshot> screenshot;
+        AsyncWebServerResponse*     response    = nullptr;
+
+        DisplayMgr::getInstance().getFBCopy(frame, PIXEL_COUNT, &slotId);
+
+        /* The frame copy is released, when the response is destroyed. */
+        screenshot = std::make_shared<Screenshot>(frame, (true == isPng) ? ImageEncoder::FORMAT_PNG : ImageEncoder::FORMAT_BMP, scale);
+
+        response = request->beginResponse((true == isPng) ? "image/png" : "image/bmp", screenshot->encoder.getSize(),
+            [screenshot](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+            {
+                UTIL_NOT_USED(index);
+
+                return screenshot->encoder.read(buffer, maxLen);
+            });
+
+        if (nullptr == response)
+        {
+            request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        }
+        else
+        {
+            response->addHeader("Cache-Control", "no-store");
+            request->send(response);
+        }
+
+        return;
+    }
+
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
 
 /**
  * List files of given directory (?dir=<path>).
- * 
+ * The listing is paginated by a cursor (?cursor=<index>, default 0) and the
+ * max. number of entries (?limit=<count>, default 15). Alternatively the page
+ * (?page=<page>) selects the cursor. The entries are serialized while the
+ * directory is enumerated and sent in a chunked response.
+ *
  * GET \c "/api/v1/fs"
  *
  * @param[in] request   HTTP request
  */
 static void handleFilesystem(AsyncWebServerRequest* request)
 {
-    String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 2048U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    const size_t        JSON_DOC_SIZE   = 256U;
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -624,97 +1982,238 @@ static void handleFilesystem(AsyncWebServerRequest* request)
     }
     else
     {
-        const String&   path                = request->arg("dir");
-        const String&   pageStr             = request->arg("page");
-        File            fdRoot              = FILESYSTEM.open(path, "r");
-        JsonArray       jsonData            = jsonDoc.createNestedArray("data");
-        const uint32_t  DEFAULT_MAX_FILES   = 15U;
-        uint32_t        count               = DEFAULT_MAX_FILES;
-        uint32_t        page                = 0U;
-        uint32_t        preCount            = page * count;
+        const String&               path            = request->arg("dir");
+        const String&               cursorStr       = request->arg("cursor");
+        const String&               limitStr        = request->arg("limit");
+        const String&               pageStr         = request->arg("page");
+        const uint32_t              DEFAULT_LIMIT   = 15U;
+        const uint32_t              MAX_LIMIT       = 250U;
+        uint32_t                    cursor          = 0U;
+        uint32_t                    limit           = DEFAULT_LIMIT;
+        uint32_t                    page            = 0U;
+        std::shared_ptr<DirListing> listing(new DirListing());
+
+        if (false == limitStr.isEmpty())
+        {
+            if ((false == Util::strToUInt32(limitStr, limit)) ||
+                (0U == limit))
+            {
+                limit = DEFAULT_LIMIT;
+            }
+            else if (MAX_LIMIT < limit)
+            {
+                limit = MAX_LIMIT;
+            }
+            else
+            {
+                ;
+            }
+        }
 
-        if (false == pageStr.isEmpty())
+        if (false == cursorStr.isEmpty())
+        {
+            if (false == Util::strToUInt32(cursorStr, cursor))
+            {
+                cursor = 0U;
+            }
+        }
+        else if (false == pageStr.isEmpty())
         {
             if (true == Util::strToUInt32(pageStr, page))
             {
-                preCount = page * count;
+                cursor = page * limit;
             }
         }
+        else
+        {
+            ;
+        }
+
+        if (nullptr != listing)
+        {
+            listing->dir = FILESYSTEM.open(path, "r");
+        }
 
-        if (false == fdRoot)
+        if ((nullptr == listing) ||
+            (false == listing->dir) ||
+            (false == listing->dir.isDirectory()))
         {
-            LOG_WARNING("Invalid path.");
+            JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+            LOG_WARNING("Requested path is not a directory.");
+
+            /* Prepare response */
+            jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+            errorObj["msg"]     = "Invalid directory.";
+            httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
         }
         else
         {
-            if (false == fdRoot.isDirectory())
+            AsyncWebServerResponse* response    = nullptr;
+            uint32_t                index       = 0U;
+
+            /* Skip the entries in front of the cursor. */
+            listing->entry = listing->dir.openNextFile();
+            while((true == listing->entry) && (index < cursor))
             {
-                LOG_WARNING("Requested path is not a directory.");
+                listing->entry.close();
+                listing->entry = listing->dir.openNextFile();
+                ++index;
             }
-            else
+
+            listing->cursor     = index;
+            listing->remaining  = limit;
+
+            response = request->beginChunkedResponse(   "application/json",
+                                                        [listing](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+                                                        {
+                                                            (void)index;
+                                                            return fillDirListing(*listing, buffer, maxLen);
+                                                        });
+
+            if (nullptr != response)
             {
-                File fd = fdRoot.openNextFile();
+                request->send(response);
+            }
 
-                while((true == fd) && (0U < count))
-                {
-                    /* Page handling */
-                    if (0U < preCount)
-                    {
-                        --preCount;
-                    }
-                    else
-                    {
-                        JsonObject jsonFile = jsonData.createNestedObject();
+            return;
+        }
+    }
 
-                        jsonFile["name"] = String(fd.name());
-                        jsonFile["size"] = fd.size();
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
-                        if (true == fd.isDirectory())
-                        {
-                            jsonFile["type"] = "dir";
-                        }
-                        else
-                        {
-                            jsonFile["type"] = "file";
-                        }
+    return;
+}
 
-                        --count;
-                    }
+/**
+ * Fill the chunk buffer with the next parts of the directory listing.
+ * A part, which doesn't fit completely, is continued with the next chunk.
+ *
+ * @param[in] listing   Directory listing context
+ * @param[in] buffer    Chunk buffer
+ * @param[in] maxLen    Chunk buffer size in byte
+ *
+ * @return Number of written bytes. If the listing is complete, it will return 0.
+ */
+static size_t fillDirListing(DirListing& listing, uint8_t* buffer, size_t maxLen)
+{
+    size_t written = 0U;
 
-                    fd.close();
+    while((maxLen > written) &&
+          ((listing.pieceOffset < listing.pieceLen) || (DirListing::PART_END != listing.part)))
+    {
+        if (listing.pieceOffset >= listing.pieceLen)
+        {
+            serializeDirListingPart(listing);
+        }
+        else
+        {
+            size_t len = listing.pieceLen - listing.pieceOffset;
 
-                    if (0U < count)
-                    {
-                        fd = fdRoot.openNextFile();
-                    }
-                }
+            if ((maxLen - written) < len)
+            {
+                len = maxLen - written;
             }
 
-            if (true == jsonDoc.overflowed())
+            memcpy(&buffer[written], &listing.piece[listing.pieceOffset], len);
+            listing.pieceOffset += len;
+            written             += len;
+        }
+    }
+
+    return written;
+}
+
+/**
+ * Serialize the next part of the directory listing into the piece buffer
+ * and advance to the following part.
+ *
+ * @param[in] listing   Directory listing context
+ */
+static void serializeDirListingPart(DirListing& listing)
+{
+    int len = 0;
+
+    listing.pieceOffset = 0U;
+    listing.pieceLen    = 0U;
+
+    switch(listing.part)
+    {
+    case DirListing::PART_HEAD:
+        len = snprintf(listing.piece, sizeof(listing.piece), "{\"status\":%u,\"data\":[", static_cast<unsigned int>(RestApi::STATUS_CODE_OK));
+        listing.part = DirListing::PART_ENTRIES;
+        break;
+
+    case DirListing::PART_ENTRIES:
+        if ((0U == listing.remaining) ||
+            (false == listing.entry))
+        {
+            listing.part = DirListing::PART_TAIL;
+        }
+        else
+        {
+            const size_t                        JSON_DOC_SIZE   = 128U;
+            StaticJsonDocument<JSON_DOC_SIZE>   jsonDoc;
+            size_t                              offset          = 0U;
+
+            jsonDoc["name"] = listing.entry.name();
+            jsonDoc["size"] = listing.entry.size();
+            jsonDoc["type"] = (true == listing.entry.isDirectory()) ? "dir" : "file";
+
+            /* Entries are separated by a comma. */
+            if (false == listing.isFirstEntry)
+            {
+                listing.piece[0U] = ',';
+                offset = 1U;
+            }
+
+            /* A truncated entry would result in invalid JSON. */
+            if (sizeof(listing.piece) <= (offset + measureJson(jsonDoc)))
+            {
+                LOG_WARNING("Directory entry %s skipped.", listing.entry.name());
+            }
+            else
             {
-                LOG_WARNING("JSON document has less memory.");
+                len = static_cast<int>(offset + serializeJson(jsonDoc, &listing.piece[offset], sizeof(listing.piece) - offset));
+                listing.isFirstEntry = false;
             }
 
-            fdRoot.close();
+            listing.entry.close();
+            listing.entry = listing.dir.openNextFile();
+            ++listing.cursor;
+            --listing.remaining;
         }
+        break;
 
-        /* Prepare response */
-        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
+    case DirListing::PART_TAIL:
+        /* The next cursor is only provided, if further entries are available. */
+        if (true == listing.entry)
+        {
+            len = snprintf(listing.piece, sizeof(listing.piece), "],\"next\":%u}", static_cast<unsigned int>(listing.cursor));
+        }
+        else
+        {
+            len = snprintf(listing.piece, sizeof(listing.piece), "],\"next\":null}");
+        }
 
-        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
-    }
+        listing.part = DirListing::PART_END;
+        break;
 
-    if (true == jsonDoc.overflowed())
-    {
-        LOG_ERROR("JSON document has less memory available.");
+    case DirListing::PART_END:
+        /* fallthrough */
+    default:
+        break;
     }
-    else
+
+    if (0 < len)
     {
-        LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
-    }
+        listing.pieceLen = static_cast<size_t>(len);
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+        if (sizeof(listing.piece) < listing.pieceLen)
+        {
+            listing.pieceLen = sizeof(listing.piece);
+        }
+    }
 
     return;
 }
@@ -728,10 +2227,9 @@ static void handleFilesystem(AsyncWebServerRequest* request)
  */
 static void handleFileGet(AsyncWebServerRequest* request)
 {
-    String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -756,8 +2254,7 @@ static void handleFileGet(AsyncWebServerRequest* request)
             LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
         }
 
-        (void)serializeJsonPretty(jsonDoc, content);
-        request->send(httpStatusCode, "application/json", content);
+        RestApi::sendJson(request, httpStatusCode, jsonDoc);
     }
     else
     {
@@ -783,18 +2280,284 @@ static void handleFileGet(AsyncWebServerRequest* request)
                 LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
             }
 
-            (void)serializeJsonPretty(jsonDoc, content);
-            request->send(httpStatusCode, "application/json", content);
+            RestApi::sendJson(request, httpStatusCode, jsonDoc);
         }
         else
         {
-            request->send(FILESYSTEM, path, getContentType(path));
+            sendFile(request, path);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Send a file. The entity tag is derived from the file content, so a client
+ * which has the current version gets "304 Not Modified" without the content.
+ * A single byte range is served as partial content.
+ *
+ * @param[in] request   HTTP request
+ * @param[in] path      Path of the file
+ */
+static void sendFile(AsyncWebServerRequest* request, const String& path)
+{
+    size_t                  fileSize    = 0U;
+    size_t                  first       = 0U;
+    size_t                  last        = 0U;
+    String                  eTag;
+    AsyncWebServerResponse* response    = nullptr;
+    AsyncWebHeader*         ifNoneMatch = request->getHeader("If-None-Match");
+    AsyncWebHeader*         range       = request->getHeader("Range");
+    RangeResult             rangeResult = RANGE_RESULT_IGNORED;
+
+    if (false == getFileETag(path, fileSize, eTag))
+    {
+        request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        return;
+    }
+
+    if (nullptr != range)
+    {
+        rangeResult = parseRange(range->value(), fileSize, first, last);
+    }
+
+    /* The client has already the current version? */
+    if ((nullptr != ifNoneMatch) &&
+        (true == isETagMatching(ifNoneMatch->value(), eTag)))
+    {
+        response = request->beginResponse(HttpStatus::STATUS_CODE_NOT_MODIFIED);
+    }
+    else if (RANGE_RESULT_NOT_SATISFIABLE == rangeResult)
+    {
+        response = request->beginResponse(HttpStatus::STATUS_CODE_RANGE_NOT_SATISFIABLE);
+
+        if (nullptr != response)
+        {
+            response->addHeader("Content-Range", String("bytes */") + fileSize);
+        }
+    }
+    else if (RANGE_RESULT_VALID == rangeResult)
+    {
+        const size_t            LENGTH  = last - first + 1U;
+        std::shared_ptr<File>   fd      = std::make_shared<File>(FILESYSTEM.open(path, "r"));
+
+        if (true == *fd)
+        {
+            /* The file is closed, when the response is destroyed. */
+            response = request->beginResponse(getContentType(path), LENGTH,
+                [fd, first, LENGTH](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+                {
+                    size_t read = 0U;
+
+                    if ((LENGTH - index) < maxLen)
+                    {
+                        maxLen = LENGTH - index;
+                    }
+
+                    if (true == fd->seek(first + index))
+                    {
+                        read = fd->read(buffer, maxLen);
+                    }
+
+                    return read;
+                });
+        }
+
+        if (nullptr != response)
+        {
+            String contentRange = "bytes ";
+
+            contentRange += first;
+            contentRange += "-";
+            contentRange += last;
+            contentRange += "/";
+            contentRange += fileSize;
+
+            response->setCode(HttpStatus::STATUS_CODE_PARTIAL_CONTENT);
+            response->addHeader("Content-Range", contentRange);
         }
     }
+    else
+    {
+        response = request->beginResponse(FILESYSTEM, path, getContentType(path));
+    }
+
+    if (nullptr == response)
+    {
+        request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+    }
+    else
+    {
+        response->addHeader("ETag", eTag);
+        response->addHeader("Accept-Ranges", "bytes");
+
+        request->send(response);
+    }
 
     return;
 }
 
+/**
+ * Get the entity tag of a file. It is derived from the file size and the
+ * FNV-1a hash of the file content, because the filesystem doesn't provide
+ * a modification time.
+ *
+ * @param[in]   path        Path of the file
+ * @param[out]  fileSize    File size in byte
+ * @param[out]  eTag        Entity tag
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool getFileETag(const String& path, size_t& fileSize, String& eTag)
+{
+    const uint32_t  FNV_PRIME   = 16777619UL;
+    uint32_t        hash        = 2166136261UL; /* FNV-1a offset basis */
+    bool            status      = false;
+
+    status = FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+        [&path, &fileSize, &hash, FNV_PRIME]() -> bool
+        {
+            bool    isRead  = false;
+            File    fd      = FILESYSTEM.open(path, "r");
+
+            if (true == fd)
+            {
+                uint8_t buffer[FILE_HASH_CHUNK_SIZE];
+                size_t  len     = 0U;
+
+                fileSize = fd.size();
+
+                do
+                {
+                    size_t index = 0U;
+
+                    len = fd.read(buffer, sizeof(buffer));
+
+                    for(index = 0U; index < len; ++index)
+                    {
+                        hash = (hash ^ buffer[index]) * FNV_PRIME;
+                    }
+                }
+                while(0U < len);
+
+                fd.close();
+                isRead = true;
+            }
+
+            return isRead;
+        });
+
+    if (true == status)
+    {
+        eTag  = "\"";
+        eTag += String(static_cast<uint32_t>(fileSize), HEX);
+        eTag += "-";
+        eTag += String(hash, HEX);
+        eTag += "\"";
+    }
+
+    return status;
+}
+
+/**
+ * Does the If-None-Match request header match the entity tag?
+ * It may contain a list of entity tags or "*".
+ *
+ * @param[in] ifNoneMatch   Value of the If-None-Match header
+ * @param[in] eTag          Entity tag of the current version
+ *
+ * @return If it matches, it will return true otherwise false.
+ */
+static bool isETagMatching(const String& ifNoneMatch, const String& eTag)
+{
+    bool isMatching = false;
+
+    if ((ifNoneMatch == "*") ||
+        (0 <= ifNoneMatch.indexOf(eTag)))
+    {
+        isMatching = true;
+    }
+
+    return isMatching;
+}
+
+/**
+ * Parse the HTTP range request header. Only a single byte range is
+ * supported, e.g. "bytes=0-99", "bytes=100-" or "bytes=-100". Several
+ * ranges are ignored, which means the whole file is sent.
+ *
+ * @param[in]   range       Value of the Range header
+ * @param[in]   fileSize    File size in byte
+ * @param[out]  first       First byte position of the range
+ * @param[out]  last        Last byte position of the range
+ *
+ * @return Parse result
+ */
+static RangeResult parseRange(const String& range, size_t fileSize, size_t& first, size_t& last)
+{
+    RangeResult result      = RANGE_RESULT_IGNORED;
+    const char  PREFIX[]    = "bytes=";
+    int         sepIdx      = range.indexOf('-');
+
+    if ((true == range.startsWith(PREFIX)) &&
+        (0 > range.indexOf(',')) &&
+        (0 <= sepIdx))
+    {
+        const String    firstStr    = range.substring(sizeof(PREFIX) - 1U, sepIdx);
+        const String    lastStr     = range.substring(sepIdx + 1);
+        uint32_t        firstPos    = 0U;
+        uint32_t        lastPos     = 0U;
+
+        /* Suffix range with the number of bytes at the end of the file? */
+        if (0U == firstStr.length())
+        {
+            if ((true == Util::strToUInt32(lastStr, lastPos)) &&
+                (0U < lastPos))
+            {
+                result  = RANGE_RESULT_VALID;
+                first   = (fileSize > lastPos) ? (fileSize - lastPos) : 0U;
+                last    = fileSize - 1U;
+            }
+        }
+        else if (true == Util::strToUInt32(firstStr, firstPos))
+        {
+            /* Open range till the end of the file? */
+            if (0U == lastStr.length())
+            {
+                lastPos = UINT32_MAX;
+                result  = RANGE_RESULT_VALID;
+            }
+            else if ((true == Util::strToUInt32(lastStr, lastPos)) &&
+                     (firstPos <= lastPos))
+            {
+                result  = RANGE_RESULT_VALID;
+            }
+            else
+            {
+                ;
+            }
+
+            if (RANGE_RESULT_VALID == result)
+            {
+                first   = firstPos;
+                last    = (fileSize <= lastPos) ? (fileSize - 1U) : lastPos;
+            }
+        }
+        else
+        {
+            ;
+        }
+
+        if ((RANGE_RESULT_VALID == result) &&
+            ((0U == fileSize) || (fileSize <= first)))
+        {
+            result = RANGE_RESULT_NOT_SATISFIABLE;
+        }
+    }
+
+    return result;
+}
+
 /**
  * Get content type of file.
  * 
@@ -863,10 +2626,9 @@ static String getContentType(const String& filename)
  */
 static void handleFilePost(AsyncWebServerRequest* request)
 {
-    String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -882,12 +2644,26 @@ static void handleFilePost(AsyncWebServerRequest* request)
         errorObj["msg"]     = "HTTP method not supported.";
         httpStatusCode      = HttpStatus::STATUS_CODE_NOT_FOUND;
     }
+    else if (true == FileUploader::getInstance().takeFailure(request))
+    {
+        JsonObject errorObj = jsonDoc.createNestedObject("error");
+
+        /* Prepare response */
+        jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_NOT_FOUND);
+        errorObj["msg"]     = FileUploader::getInstance().getErrorStr();
+        httpStatusCode      = HttpStatus::STATUS_CODE_BAD_REQUEST;
+    }
     else
     {
         JsonObject dataObj = jsonDoc.createNestedObject("data");
 
         UTIL_NOT_USED(dataObj);
 
+        /* The upload is complete. Plugins reload their configuration, if
+         * it is affected.
+         */
+        (void)FileIo::getInstance().notifyChange();
+
         /* Prepare response */
         jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
 
@@ -903,8 +2679,7 @@ static void handleFilePost(AsyncWebServerRequest* request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
@@ -921,17 +2696,21 @@ static void handleFilePost(AsyncWebServerRequest* request)
  */
 static void uploadHandler(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final)
 {
-    static File fd;
-    bool        isError = false;
+    FileUploader& uploader = FileUploader::getInstance();
 
     /* Begin of upload? */
     if (0 == index)
     {
-        fd = FILESYSTEM.open(filename, "w");
+        /* A changed web page must not be served from the page cache anymore. */
+        Pages::invalidate(filename);
 
-        if (false == fd)
+        /* Invalid or too large uploads are rejected, before anything is written. */
+        if (false == uploader.begin(request, filename, data, len))
         {
-            isError = true;
+            LOG_WARNING("File %s upload rejected: %s", filename.c_str(), uploader.getErrorStr());
+
+            /* Inform client about abort.*/
+            request->send(HttpStatus::STATUS_CODE_BAD_REQUEST, "text/plain", uploader.getErrorStr());
         }
         else
         {
@@ -939,29 +2718,35 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
         }
     }
 
-    if (true == fd)
-    {
-        (void)fd.write(data, len);
-    }
-
-    if ((true == final) &&
-        (false == isError))
-    {        
-        LOG_INFO("File %s successful written.", filename.c_str());
-
-        fd.close();
-    }
-    else if (true == isError)
+    /* The data is written behind by the I/O task. The webserver task only
+     * waits, if all buffers are still waiting to be written.
+     */
+    if (true == uploader.isRunning(request))
     {
-        LOG_INFO("File %s upload aborted.", filename.c_str());
+        if (false == uploader.write(data, len))
+        {
+            LOG_INFO("File %s upload aborted: %s", filename.c_str(), uploader.getErrorStr());
 
-        fd.close();
-    }
+            uploader.abort();
 
-    if (true == isError)
-    {
-        /* Inform client about abort.*/
-        request->send(HttpStatus::STATUS_CODE_BAD_REQUEST, "text/plain", "Upload aborted.");
+            /* Inform client about abort.*/
+            request->send(HttpStatus::STATUS_CODE_BAD_REQUEST, "text/plain", "Upload aborted.");
+        }
+        else if (true == final)
+        {
+            if (false == uploader.end())
+            {
+                LOG_INFO("File %s upload failed: %s", filename.c_str(), uploader.getErrorStr());
+            }
+            else
+            {
+                LOG_INFO("File %s successful written.", filename.c_str());
+            }
+        }
+        else
+        {
+            ;
+        }
     }
 
     return;
@@ -976,10 +2761,9 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
  */
 static void handleFileDelete(AsyncWebServerRequest* request)
 {
-    String              content;
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
     const size_t        JSON_DOC_SIZE   = 512U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    PooledJsonDocument  jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
     {
@@ -1001,12 +2785,21 @@ static void handleFileDelete(AsyncWebServerRequest* request)
 
         LOG_INFO("File \"%s\" removal requested.", path.c_str());
 
-        if (false == FILESYSTEM.remove(path))
+        /* A removed web page must not be served from the page cache anymore. */
+        Pages::invalidate(path);
+
+        if (true == FileIo::getInstance().execute(FileIo::PRIORITY_LOW,
+                        [&path]() -> bool
+                        {
+                            return FILESYSTEM.remove(path);
+                        }))
         {
             JsonObject dataObj = jsonDoc.createNestedObject("data");
 
             UTIL_NOT_USED(dataObj);
 
+            (void)FileIo::getInstance().notifyChange();
+
             /* Prepare response */
             jsonDoc["status"]   = static_cast<uint8_t>(RestApi::STATUS_CODE_OK);
 
@@ -1032,8 +2825,7 @@ static void handleFileDelete(AsyncWebServerRequest* request)
         LOG_INFO("JSON document size: %u", jsonDoc.memoryUsage());
     }
 
-    (void)serializeJsonPretty(jsonDoc, content);
-    request->send(httpStatusCode, "application/json", content);
+    RestApi::sendJson(request, httpStatusCode, jsonDoc);
 
     return;
 }
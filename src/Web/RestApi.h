@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
 #include <stdint.h>
 
 /** REST pages installer */
@@ -63,6 +64,16 @@ namespace RestApi
  */
 static const char BASE_URI[] = "/rest/api/v1";
 
+/**
+ * URI of the status endpoint.
+ */
+static const char URI_STATUS[] = "/rest/api/v1/status";
+
+/**
+ * URI of the display slots endpoint.
+ */
+static const char URI_DISPLAY_SLOTS[] = "/rest/api/v1/display/slots";
+
 /**
  * REST request status code.
  */
@@ -91,6 +102,44 @@ void init(AsyncWebServer& srv);
  */
 void error(AsyncWebServerRequest* request);
 
+/**
+ * Content type of MessagePack encoded responses.
+ */
+static const char CONTENT_TYPE_MSGPACK[] = "application/msgpack";
+
+/**
+ * Does the client accept MessagePack encoded responses?
+ * It is negotiated by the "Accept" request header.
+ *
+ * @param[in] request   HTTP request
+ *
+ * @return If MessagePack is accepted, it will return true otherwise false.
+ */
+bool isMsgPackAccepted(AsyncWebServerRequest* request);
+
+/**
+ * Send a JSON document as response. It is serialized compact by default
+ * and human readable if the request contains the argument "pretty".
+ * If the client accepts MessagePack, it is serialized as MessagePack.
+ *
+ * @param[in] request           HTTP request
+ * @param[in] httpStatusCode    HTTP status code
+ * @param[in] jsonDoc           JSON document
+ */
+void sendJson(AsyncWebServerRequest* request, uint32_t httpStatusCode, const JsonDocument& jsonDoc);
+
+/**
+ * Send a JSON document as response and store it in the response cache,
+ * if the request is cacheable and successful.
+ *
+ * @param[in] request           HTTP request
+ * @param[in] httpStatusCode    HTTP status code
+ * @param[in] jsonDoc           JSON document
+ * @param[in] revision          Response cache revision, retrieved before the document was built
+ * @param[in] ttl               Time to live in the response cache in ms
+ */
+void sendCachedJson(AsyncWebServerRequest* request, uint32_t httpStatusCode, const JsonDocument& jsonDoc, uint32_t revision, uint32_t ttl);
+
 }
 
 #endif  /* __RESTAPI_H__ */
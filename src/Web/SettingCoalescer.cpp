@@ -0,0 +1,249 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Coalescing of display setting updates
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SettingCoalescer.h"
+#include "DisplayMgr.h"
+
+#include <Logging.h>
+#include <Metrics.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of setting updates, which were replaced by a later one before they were applied. */
+static MetricCounter    gMetricDropped("pixelix_setting_updates_dropped_total", "Number of setting updates, which were replaced by a later one before they were applied.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void SettingCoalescer::setBrightness(uint8_t level)
+{
+    if (nullptr == m_xMutex)
+    {
+        DisplayMgr::getInstance().setBrightness(level);
+    }
+    else
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+        if (true == m_isBrightnessPending)
+        {
+            gMetricDropped.inc();
+        }
+
+        m_brightness            = level;
+        m_isBrightnessPending   = true;
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+void SettingCoalescer::setAutoBrightnessAdjustment(bool enable)
+{
+    if (nullptr == m_xMutex)
+    {
+        (void)DisplayMgr::getInstance().setAutoBrightnessAdjustment(enable);
+    }
+    else
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+        if (true == m_isAutoAdjustPending)
+        {
+            gMetricDropped.inc();
+        }
+
+        m_isAutoAdjustEnabled   = enable;
+        m_isAutoAdjustPending   = true;
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+void SettingCoalescer::setSlotDuration(uint8_t slotId, uint32_t duration)
+{
+    if (nullptr == m_xMutex)
+    {
+        (void)DisplayMgr::getInstance().setSlotDuration(slotId, duration);
+    }
+    else
+    {
+        (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+        if (true == m_isSlotDurationPending)
+        {
+            /* Only the latest value of the same slot is kept. */
+            if (slotId == m_slotId)
+            {
+                gMetricDropped.inc();
+            }
+            else
+            {
+                applySlotDuration();
+            }
+        }
+
+        m_slotId                = slotId;
+        m_slotDuration          = duration;
+        m_isSlotDurationPending = true;
+
+        (void)xSemaphoreGive(m_xMutex);
+    }
+
+    return;
+}
+
+void SettingCoalescer::process()
+{
+    DisplayMgr& displayMgr  = DisplayMgr::getInstance();
+    bool        isSaveReq   = false;
+
+    if (nullptr == m_xMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_xMutex, portMAX_DELAY);
+
+    if (true == m_isBrightnessPending)
+    {
+        displayMgr.setBrightness(m_brightness);
+        m_isBrightnessPending = false;
+    }
+
+    if (true == m_isAutoAdjustPending)
+    {
+        (void)displayMgr.setAutoBrightnessAdjustment(m_isAutoAdjustEnabled);
+        m_isAutoAdjustPending = false;
+    }
+
+    if (true == m_isSlotDurationPending)
+    {
+        applySlotDuration();
+    }
+
+    if ((true == m_saveTimer.isTimerRunning()) &&
+        (true == m_saveTimer.isTimeout()))
+    {
+        m_saveTimer.stop();
+        isSaveReq = true;
+    }
+
+    (void)xSemaphoreGive(m_xMutex);
+
+    /* Persisting takes a while, don't block the command executor meanwhile. */
+    if (true == isSaveReq)
+    {
+        displayMgr.save();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+SettingCoalescer::SettingCoalescer() :
+    m_xMutex(xSemaphoreCreateMutex()),
+    m_isBrightnessPending(false),
+    m_brightness(0U),
+    m_isAutoAdjustPending(false),
+    m_isAutoAdjustEnabled(false),
+    m_isSlotDurationPending(false),
+    m_slotId(DisplayMgr::SLOT_ID_INVALID),
+    m_slotDuration(0U),
+    m_saveTimer()
+{
+    if (nullptr == m_xMutex)
+    {
+        LOG_ERROR("Couldn't create mutex, settings are applied immediately.");
+    }
+}
+
+SettingCoalescer::~SettingCoalescer()
+{
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+void SettingCoalescer::applySlotDuration()
+{
+    /* Persisting is debounced, every change restarts the debounce time. */
+    if (true == DisplayMgr::getInstance().setSlotDuration(m_slotId, m_slotDuration, false))
+    {
+        m_saveTimer.start(SAVE_DEBOUNCE);
+    }
+
+    m_isSlotDurationPending = false;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
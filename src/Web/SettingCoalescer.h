@@ -0,0 +1,151 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Coalescing of display setting updates
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __SETTINGCOALESCER_H__
+#define __SETTINGCOALESCER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The setting coalescer collects rapid setting updates, e.g. caused by
+ * dragging a slider in the web interface. Only the latest value of every
+ * setting is kept, intermediate values are dropped. The pending values
+ * are applied once per processing cycle and the slot configuration is
+ * persisted after no further change happened for a debounce time.
+ */
+class SettingCoalescer
+{
+public:
+
+    /**
+     * Get setting coalescer instance.
+     *
+     * @return Setting coalescer instance
+     */
+    static SettingCoalescer& getInstance()
+    {
+        static SettingCoalescer instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Request a display brightness.
+     *
+     * @param[in] level Brightness level
+     */
+    void setBrightness(uint8_t level);
+
+    /**
+     * Request enabling/disabling the automatic brightness adjustment.
+     *
+     * @param[in] enable    Enable or disable
+     */
+    void setAutoBrightnessAdjustment(bool enable);
+
+    /**
+     * Request a slot duration. If the duration of another slot is still
+     * pending, that one is applied first.
+     *
+     * @param[in] slotId    Slot id
+     * @param[in] duration  Duration in ms
+     */
+    void setSlotDuration(uint8_t slotId, uint32_t duration);
+
+    /**
+     * Apply the pending settings and persist them after the debounce time.
+     * Call this periodically.
+     */
+    void process();
+
+    /** Debounce time in ms, before changed settings are persisted. */
+    static const uint32_t   SAVE_DEBOUNCE   = 2000U;
+
+private:
+
+    SemaphoreHandle_t   m_xMutex;                   /**< Mutex to protect the pending settings. */
+    bool                m_isBrightnessPending;      /**< Is a brightness pending? */
+    uint8_t             m_brightness;               /**< Pending brightness level */
+    bool                m_isAutoAdjustPending;      /**< Is the automatic brightness adjustment pending? */
+    bool                m_isAutoAdjustEnabled;      /**< Pending automatic brightness adjustment */
+    bool                m_isSlotDurationPending;    /**< Is a slot duration pending? */
+    uint8_t             m_slotId;                   /**< Slot id of the pending slot duration */
+    uint32_t            m_slotDuration;             /**< Pending slot duration in ms */
+    SimpleTimer         m_saveTimer;                /**< Timer used to debounce persisting the settings. */
+
+    /**
+     * Constructs the setting coalescer.
+     */
+    SettingCoalescer();
+
+    /**
+     * Destroys the setting coalescer.
+     */
+    ~SettingCoalescer();
+
+    /* Prevent copying */
+    SettingCoalescer(const SettingCoalescer& coalescer);
+    SettingCoalescer& operator=(const SettingCoalescer& coalescer);
+
+    /**
+     * Apply the pending slot duration. The mutex must be taken by the caller.
+     */
+    void applySlotDuration();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SETTINGCOALESCER_H__ */
+
+/** @} */
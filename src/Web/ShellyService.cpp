@@ -0,0 +1,396 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Shelly device service
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ShellyService.h"
+#include "HttpClientPool.h"
+#include "LargeJsonDocument.h"
+
+#include <WiFi.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+uint8_t ShellyService::registerDevice(const String& ipAddress)
+{
+    uint8_t handle  = INVALID_HANDLE;
+    uint8_t index   = 0U;
+
+    lock();
+
+    /* A already registered device is shared. */
+    while((INVALID_HANDLE == handle) && (MAX_DEVICES > index))
+    {
+        if ((0U < m_devices[index].refCount) &&
+            (ipAddress == m_devices[index].ipAddress))
+        {
+            ++m_devices[index].refCount;
+            handle = index;
+        }
+
+        ++index;
+    }
+
+    index = 0U;
+    while((INVALID_HANDLE == handle) && (MAX_DEVICES > index))
+    {
+        if (0U == m_devices[index].refCount)
+        {
+            Device& device = m_devices[index];
+
+            device.ipAddress    = ipAddress;
+            device.refCount     = 1U;
+            device.power        = 0.0F;
+            device.isValid      = false;
+            device.timestamp    = 0U;
+
+            ++m_deviceCount;
+            handle = index;
+
+            /* The new device is polled next. */
+            m_nextDevice = index;
+            m_pollTimer.start(0U);
+        }
+
+        ++index;
+    }
+
+    if (INVALID_HANDLE == handle)
+    {
+        LOG_WARNING("No space for Shelly device %s.", ipAddress.c_str());
+    }
+
+    unlock();
+
+    return handle;
+}
+
+void ShellyService::unregisterDevice(uint8_t handle)
+{
+    lock();
+
+    if ((MAX_DEVICES > handle) &&
+        (0U < m_devices[handle].refCount))
+    {
+        --m_devices[handle].refCount;
+
+        if (0U == m_devices[handle].refCount)
+        {
+            HttpClientPool::getInstance().abort(&m_devices[handle]);
+
+            m_devices[handle].ipAddress.clear();
+            m_devices[handle].isValid = false;
+            --m_deviceCount;
+            ++m_generation;
+
+            if (0U == m_deviceCount)
+            {
+                m_pollTimer.stop();
+            }
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+bool ShellyService::getPower(uint8_t handle, float& power, uint32_t& generation) const
+{
+    bool isAvailable = false;
+
+    lock();
+
+    if ((MAX_DEVICES > handle) &&
+        (0U < m_devices[handle].refCount) &&
+        (true == m_devices[handle].isValid))
+    {
+        power       = m_devices[handle].power;
+        isAvailable = true;
+    }
+
+    generation = m_generation;
+
+    unlock();
+
+    return isAvailable;
+}
+
+bool ShellyService::getTotalPower(float& power, uint32_t& generation) const
+{
+    bool    isAvailable = false;
+    uint8_t index       = 0U;
+
+    power = 0.0F;
+
+    lock();
+
+    for(index = 0U; index < MAX_DEVICES; ++index)
+    {
+        if ((0U < m_devices[index].refCount) &&
+            (true == m_devices[index].isValid))
+        {
+            power       += m_devices[index].power;
+            isAvailable = true;
+        }
+    }
+
+    generation = m_generation;
+
+    unlock();
+
+    return isAvailable;
+}
+
+void ShellyService::setPower(uint8_t handle, float power)
+{
+    lock();
+
+    if ((MAX_DEVICES > handle) &&
+        (0U < m_devices[handle].refCount))
+    {
+        updatePower(handle, power);
+    }
+
+    unlock();
+
+    return;
+}
+
+void ShellyService::onTimeout(EventTimer& timer)
+{
+    lock();
+
+    if ((&m_pollTimer == &timer) &&
+        (0U < m_deviceCount))
+    {
+        uint8_t index   = m_nextDevice;
+        uint8_t count   = 0U;
+
+        /* Find the next registered device. */
+        while((MAX_DEVICES > count) &&
+              (0U == m_devices[index].refCount))
+        {
+            index = (index + 1U) % MAX_DEVICES;
+            ++count;
+        }
+
+        m_nextDevice = (index + 1U) % MAX_DEVICES;
+
+        /* A device, whose power is pushed, needs no poll. */
+        if ((false == m_devices[index].isValid) ||
+            (POLL_PERIOD <= (millis() - m_devices[index].timestamp)))
+        {
+            startRequest(index);
+        }
+
+        m_pollTimer.start(getPollInterval());
+    }
+
+    unlock();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ShellyService::ShellyService() :
+    m_devices(),
+    m_deviceCount(0U),
+    m_nextDevice(0U),
+    m_generation(0U),
+    m_jsonFilter(),
+    m_xMutex(xSemaphoreCreateRecursiveMutex()),
+    m_pollTimer(*this)
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_DEVICES; ++index)
+    {
+        m_devices[index].refCount   = 0U;
+        m_devices[index].power      = 0.0F;
+        m_devices[index].isValid    = false;
+        m_devices[index].timestamp  = 0U;
+    }
+
+    /* Only the power is needed, skip everything else of the response. */
+    (void)m_jsonFilter.addField("power");
+}
+
+ShellyService::~ShellyService()
+{
+    m_pollTimer.stop();
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+uint32_t ShellyService::getPollInterval() const
+{
+    uint32_t interval = POLL_PERIOD;
+
+    if (0U < m_deviceCount)
+    {
+        interval /= m_deviceCount;
+    }
+
+    if (MIN_POLL_INTERVAL > interval)
+    {
+        interval = MIN_POLL_INTERVAL;
+    }
+
+    return interval;
+}
+
+void ShellyService::startRequest(uint8_t index)
+{
+    HttpClientPool::Request request;
+
+    if (WL_CONNECTED == WiFi.status())
+    {
+        /* The devices are polled periodically, therefore the connection
+         * is kept alive.
+         */
+        request.owner       = &m_devices[index];
+        request.url         = String("http://") + m_devices[index].ipAddress + "/meter/0/";
+        request.isKeepAlive = true;
+
+        request.onResponse = [this, index](const HttpResponse& rsp) {
+            size_t                  payloadSize = 0U;
+            const char*             payload     = reinterpret_cast<const char*>(rsp.getPayload(payloadSize));
+            LargeJsonDocument       jsonDoc(m_jsonFilter.getDocCapacity());
+            DeserializationError    error       = m_jsonFilter.parse(jsonDoc, payload, payloadSize);
+
+            if (DeserializationError::Ok != error.code())
+            {
+                LOG_WARNING("JSON parse error: %s", error.c_str());
+            }
+            else if (false == jsonDoc["power"].is<float>())
+            {
+                LOG_WARNING("JSON power type missmatch or missing.");
+            }
+            else
+            {
+                /* The device may be unregistered in the meantime. */
+                setPower(index, jsonDoc["power"].as<float>());
+            }
+        };
+
+        request.onError = []() {
+            LOG_WARNING("Connection error happened.");
+        };
+
+        if (false == HttpClientPool::getInstance().request(request))
+        {
+            LOG_WARNING("GET %s failed.", request.url.c_str());
+        }
+    }
+
+    return;
+}
+
+void ShellyService::updatePower(uint8_t index, float power)
+{
+    Device& device = m_devices[index];
+
+    if ((false == device.isValid) ||
+        (power != device.power))
+    {
+        ++m_generation;
+    }
+
+    device.power        = power;
+    device.isValid      = true;
+    device.timestamp    = millis();
+
+    return;
+}
+
+void ShellyService::lock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void ShellyService::unlock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
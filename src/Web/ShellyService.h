@@ -0,0 +1,228 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Shelly device service
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __SHELLY_SERVICE_H__
+#define __SHELLY_SERVICE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <EventTimer.hpp>
+
+#include "JsonFieldFilter.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The Shelly service polls the power of all registered Shelly PlugS devices
+ * via the HTTP client pool and caches it. Any number of plugins read the
+ * cached power without network access, e.g. several plugins, which show
+ * the same device or the total power of all devices.
+ *
+ * The devices are polled staggered: a single timer polls one device after
+ * the other, so every device is polled once in the poll period without
+ * bursts of requests. A device, whose power was pushed recently, e.g. via
+ * MQTT, isn't polled.
+ */
+class ShellyService : public ITimerListener
+{
+public:
+
+    /** Max. number of devices. */
+    static const uint8_t    MAX_DEVICES         = 16U;
+
+    /** Invalid device handle */
+    static const uint8_t    INVALID_HANDLE      = UINT8_MAX;
+
+    /** Period in ms, in which every device is polled once. */
+    static const uint32_t   POLL_PERIOD         = 15U * 1000U;
+
+    /** Min. period in ms between two polls of different devices. */
+    static const uint32_t   MIN_POLL_INTERVAL   = 500U;
+
+    /**
+     * Get the Shelly service instance.
+     *
+     * @return Shelly service
+     */
+    static ShellyService& getInstance()
+    {
+        static ShellyService instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Register a device. A device, which is already registered by its
+     * IP-address, is shared.
+     *
+     * @param[in] ipAddress IP-address of the device
+     *
+     * @return Device handle. If there is no space left, it will return INVALID_HANDLE.
+     */
+    uint8_t registerDevice(const String& ipAddress);
+
+    /**
+     * Unregister a device. The device isn't polled anymore, after the last
+     * user unregistered it.
+     *
+     * @param[in] handle    Device handle
+     */
+    void unregisterDevice(uint8_t handle);
+
+    /**
+     * Get the cached power of a device.
+     *
+     * @param[in]   handle      Device handle
+     * @param[out]  power       Power in W
+     * @param[out]  generation  Generation, which changes with every new power.
+     *
+     * @return If a power is available, it will return true otherwise false.
+     */
+    bool getPower(uint8_t handle, float& power, uint32_t& generation) const;
+
+    /**
+     * Get the total power of all devices, which have a power available.
+     *
+     * @param[out]  power       Total power in W
+     * @param[out]  generation  Generation, which changes with every new power of any device.
+     *
+     * @return If a power of at least one device is available, it will return true otherwise false.
+     */
+    bool getTotalPower(float& power, uint32_t& generation) const;
+
+    /**
+     * Set the power of a device, which was pushed e.g. via MQTT.
+     * The device is not polled, as long as the power is pushed.
+     *
+     * @param[in] handle    Device handle
+     * @param[in] power     Power in W
+     */
+    void setPower(uint8_t handle, float power);
+
+    /**
+     * Will be called by the timer service, if the poll timer timed out.
+     *
+     * @param[in] timer Event timer, which timed out
+     */
+    void onTimeout(EventTimer& timer) final;
+
+private:
+
+    /**
+     * A registered device.
+     */
+    struct Device
+    {
+        String      ipAddress;  /**< IP-address of the device */
+        uint8_t     refCount;   /**< Number of users, 0 if the entry is free. */
+        float       power;      /**< Last known power in W */
+        bool        isValid;    /**< Is the power available? */
+        uint32_t    timestamp;  /**< Timestamp in ms of the last power update */
+    };
+
+    Device              m_devices[MAX_DEVICES]; /**< Registered devices */
+    uint8_t             m_deviceCount;          /**< Number of registered devices */
+    uint8_t             m_nextDevice;           /**< Index of the device, which is polled next. */
+    uint32_t            m_generation;           /**< Generation, which changes with every new power. */
+    JsonFieldFilter     m_jsonFilter;           /**< Filter with the needed fields of the JSON response. */
+    SemaphoreHandle_t   m_xMutex;               /**< Mutex to protect against concurrent access. */
+    EventTimer          m_pollTimer;            /**< Timer, used to poll the devices staggered. */
+
+    /**
+     * Constructs the Shelly service.
+     */
+    ShellyService();
+
+    /**
+     * Destroys the Shelly service.
+     */
+    ~ShellyService();
+
+    /* Prevent copying */
+    ShellyService(const ShellyService& service);
+    ShellyService& operator=(const ShellyService& service);
+
+    /**
+     * Get the period in ms between two polls of different devices.
+     *
+     * @return Poll interval in ms
+     */
+    uint32_t getPollInterval() const;
+
+    /**
+     * Request the power of a device.
+     *
+     * @param[in] index Device index
+     */
+    void startRequest(uint8_t index);
+
+    /**
+     * Update the power of a device.
+     *
+     * @param[in] index Device index
+     * @param[in] power Power in W
+     */
+    void updatePower(uint8_t index, float power);
+
+    /**
+     * Protect against concurrent access.
+     */
+    void lock() const;
+
+    /**
+     * Unprotect against concurrent access.
+     */
+    void unlock() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SHELLY_SERVICE_H__ */
+
+/** @} */
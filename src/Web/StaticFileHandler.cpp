@@ -0,0 +1,176 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Static file handler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "StaticFileHandler.h"
+#include "HttpStatus.h"
+#include "FileSystem.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool StaticFileHandler::canHandle(AsyncWebServerRequest* request)
+{
+    bool isHandled = false;
+
+    if ((nullptr != request) &&
+        (HTTP_GET == request->method()))
+    {
+        String path = getFilePath(request);
+
+        if ((false == path.isEmpty()) &&
+            ((true == FILESYSTEM.exists(path + ".gz")) || (true == FILESYSTEM.exists(path))))
+        {
+            /* Only the interesting headers are kept by the webserver. */
+            if (false == m_eTag.isEmpty())
+            {
+                request->addInterestingHeader("If-None-Match");
+            }
+
+            isHandled = true;
+        }
+    }
+
+    return isHandled;
+}
+
+void StaticFileHandler::handleRequest(AsyncWebServerRequest* request)
+{
+    AsyncWebServerResponse* response = nullptr;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    /* The client has already the current version? */
+    if ((false == m_eTag.isEmpty()) &&
+        (true == request->hasHeader("If-None-Match")) &&
+        (m_eTag == request->header("If-None-Match")))
+    {
+        response = request->beginResponse(HttpStatus::STATUS_CODE_NOT_MODIFIED);
+    }
+    else
+    {
+        /* The file response prefers the gzip compressed file and sets the
+         * content encoding. The content type is derived from the path.
+         */
+        response = request->beginResponse(FILESYSTEM, getFilePath(request), String());
+    }
+
+    if (nullptr == response)
+    {
+        request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+    }
+    else
+    {
+        if (false == m_cacheControl.isEmpty())
+        {
+            response->addHeader("Cache-Control", m_cacheControl);
+        }
+
+        if (false == m_eTag.isEmpty())
+        {
+            response->addHeader("ETag", m_eTag);
+        }
+
+        request->send(response);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+String StaticFileHandler::getFilePath(AsyncWebServerRequest* request) const
+{
+    String          path;
+    const String&   url = request->url();
+
+    /* Directory? */
+    if (true == m_uri.endsWith("/"))
+    {
+        if ((true == url.startsWith(m_uri)) &&
+            (m_uri.length() < url.length()))
+        {
+            path = m_path + url.substring(m_uri.length());
+        }
+    }
+    /* Single file */
+    else if (m_uri == url)
+    {
+        path = m_path;
+    }
+    else
+    {
+        ;
+    }
+
+    return path;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,145 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Static file handler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __STATIC_FILE_HANDLER_H__
+#define __STATIC_FILE_HANDLER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <ESPAsyncWebServer.h>
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Serves static files from the filesystem. A gzip compressed copy of a file
+ * (<file>.gz) is preferred and sent with the corresponding content encoding.
+ *
+ * Every response contains the entity tag of the filesystem version, which
+ * allows the client to revalidate its cached files. If the client has still
+ * the current version, only a "304 Not Modified" is sent.
+ */
+class StaticFileHandler : public AsyncWebHandler
+{
+public:
+
+    /**
+     * Constructs the static file handler.
+     *
+     * @param[in] uri           URI of a directory (ends with '/') or a single file
+     * @param[in] path          Path in the filesystem, which corresponds to the URI
+     * @param[in] cacheControl  Cache control header value
+     * @param[in] eTag          Entity tag of the filesystem version. If empty, no entity tag is used.
+     */
+    StaticFileHandler(const String& uri, const String& path, const String& cacheControl, const String& eTag) :
+        m_uri(uri),
+        m_path(path),
+        m_cacheControl(cacheControl),
+        m_eTag(eTag)
+    {
+    }
+
+    /**
+     * Destroys the static file handler.
+     */
+    ~StaticFileHandler()
+    {
+    }
+
+    /**
+     * Checks whether the request can be handled.
+     *
+     * @param[in] request   Web request
+     *
+     * @return If request can be handled, it will return true otherwise false.
+     */
+    bool canHandle(AsyncWebServerRequest* request) final;
+
+    /**
+     * Handles the request.
+     *
+     * @param[in] request   Web request, which to handle.
+     */
+    void handleRequest(AsyncWebServerRequest* request) final;
+
+    /**
+     * Non-trivial handler.
+     * The request headers are needed to check the entity tag.
+     */
+    bool isRequestHandlerTrivial() final
+    {
+        return false;
+    }
+
+private:
+
+    const String    m_uri;          /**< URI of a directory or a single file */
+    const String    m_path;         /**< Path in the filesystem */
+    const String    m_cacheControl; /**< Cache control header value */
+    const String    m_eTag;         /**< Entity tag of the filesystem version */
+
+    StaticFileHandler();
+    StaticFileHandler(const StaticFileHandler& handler);
+    StaticFileHandler& operator=(const StaticFileHandler& handler);
+
+    /**
+     * Get the path of the requested file in the filesystem.
+     *
+     * @param[in] request   Web request
+     *
+     * @return Path in the filesystem. If the URL doesn't match, it will be empty.
+     */
+    String getFilePath(AsyncWebServerRequest* request) const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __STATIC_FILE_HANDLER_H__ */
+
+/** @} */
\ No newline at end of file
@@ -0,0 +1,236 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Telemetry publisher
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TelemetryPublisher.h"
+#include "DnsCache.h"
+#include "Settings.h"
+
+#include <WiFi.h>
+#include <Logging.h>
+#include <Metrics.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of sent telemetry datagrams */
+static MetricCounter    gMetricDatagrams("pixelix_telemetry_datagrams_total", "Number of sent telemetry datagrams.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void TelemetryPublisher::begin()
+{
+    String      server;
+    uint32_t    period  = 0U;
+
+    if (true == Settings::getInstance().open(true))
+    {
+        server  = Settings::getInstance().getTelemetryServer().getValue();
+        period  = Settings::getInstance().getTelemetryPeriod().getValue();
+
+        Settings::getInstance().close();
+    }
+
+    m_isEnabled = false;
+
+    if (true == server.isEmpty())
+    {
+        ;
+    }
+    else if (false == parseServer(server))
+    {
+        LOG_WARNING("Invalid telemetry server: %s", server.c_str());
+    }
+    else
+    {
+        /* The hostname distinguishes the devices of a fleet. */
+        m_prefix    = WiFi.getHostname();
+        m_period    = period * 1000U;
+        m_isEnabled = true;
+
+        m_timer.start(m_period);
+
+        LOG_INFO("Publish telemetry to %s:%u every %u s.", m_hostname.c_str(), m_port, period);
+    }
+
+    return;
+}
+
+void TelemetryPublisher::end()
+{
+    if (true == m_isEnabled)
+    {
+        DnsCache::getInstance().cancel(this);
+        m_timer.stop();
+        m_udp.close();
+        m_isEnabled = false;
+    }
+
+    return;
+}
+
+void TelemetryPublisher::process()
+{
+    if ((true == m_isEnabled) &&
+        (true == m_timer.isTimeout()))
+    {
+        IPAddress           addr;
+        DnsCache::Result    result  = DnsCache::getInstance().resolve(m_hostname, addr, this, nullptr);
+
+        m_timer.restart();
+
+        /* A pending lookup is cached, therefore its published with the next period. */
+        if (DnsCache::RESULT_RESOLVED == result)
+        {
+            publish(addr);
+        }
+    }
+
+    return;
+}
+
+size_t TelemetryPublisher::Datagram::write(const uint8_t* buffer, size_t size)
+{
+    size_t written = 0U;
+
+    if ((nullptr != buffer) &&
+        (MAX_DATAGRAM_SIZE >= size))
+    {
+        /* The line doesn't fit anymore, continue with the next datagram. */
+        if (MAX_DATAGRAM_SIZE < (m_size + size))
+        {
+            flush();
+        }
+
+        memcpy(&m_buffer[m_size], buffer, size);
+        m_size  += size;
+        written = size;
+    }
+
+    return written;
+}
+
+void TelemetryPublisher::Datagram::flush()
+{
+    if (0U < m_size)
+    {
+        if (m_size == m_udp.writeTo(m_buffer, m_size, m_addr, m_port))
+        {
+            ++m_count;
+            gMetricDatagrams.inc();
+        }
+
+        m_size = 0U;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool TelemetryPublisher::parseServer(const String& server)
+{
+    bool    status  = true;
+    int     index   = server.indexOf(':');
+
+    if (0 > index)
+    {
+        m_hostname  = server;
+        m_port      = DEFAULT_PORT;
+    }
+    else
+    {
+        long port = server.substring(index + 1).toInt();
+
+        m_hostname = server.substring(0, index);
+
+        if ((0 >= port) || (UINT16_MAX < port))
+        {
+            status = false;
+        }
+        else
+        {
+            m_port = static_cast<uint16_t>(port);
+        }
+    }
+
+    if (true == m_hostname.isEmpty())
+    {
+        status = false;
+    }
+
+    return status;
+}
+
+void TelemetryPublisher::publish(const IPAddress& addr)
+{
+    m_datagram.begin(addr, m_port);
+    Metrics::getInstance().writeStatsd(m_datagram, m_prefix.c_str());
+    m_datagram.flush();
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,259 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Telemetry publisher
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __TELEMETRY_PUBLISHER_H__
+#define __TELEMETRY_PUBLISHER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <AsyncUDP.h>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The telemetry publisher pushes all metrics periodically to a StatsD
+ * server, instead of waiting to be scraped. The metrics are written from
+ * the metrics registry line by line directly into a datagram buffer. A
+ * full datagram is sent and the next one begins, so no line is split and
+ * nothing is allocated.
+ */
+class TelemetryPublisher
+{
+public:
+
+    /** Default StatsD server port */
+    static const uint16_t   DEFAULT_PORT        = 8125U;
+
+    /** Max. datagram size in byte, which fits into a single ethernet frame. */
+    static const size_t     MAX_DATAGRAM_SIZE   = 1400U;
+
+    /**
+     * Get the telemetry publisher instance.
+     *
+     * @return Telemetry publisher
+     */
+    static TelemetryPublisher& getInstance()
+    {
+        static TelemetryPublisher instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start publishing according to the settings. If no server is
+     * configured, nothing is published.
+     */
+    void begin();
+
+    /**
+     * Stop publishing.
+     */
+    void end();
+
+    /**
+     * Publish the metrics, if the period elapsed.
+     */
+    void process();
+
+private:
+
+    /**
+     * Datagram output, which collects the metric lines. A line, which doesn't
+     * fit anymore, is written to the next datagram.
+     */
+    class Datagram : public Print
+    {
+    public:
+
+        /**
+         * Constructs the datagram output.
+         *
+         * @param[in] udp   UDP, which is used to send the datagrams.
+         */
+        Datagram(AsyncUDP& udp) :
+            Print(),
+            m_udp(udp),
+            m_addr(),
+            m_port(0U),
+            m_buffer(),
+            m_size(0U),
+            m_count(0U)
+        {
+        }
+
+        /**
+         * Destroys the datagram output.
+         */
+        ~Datagram()
+        {
+        }
+
+        /**
+         * Begin with the first datagram.
+         *
+         * @param[in] addr  Destination address
+         * @param[in] port  Destination port
+         */
+        void begin(const IPAddress& addr, uint16_t port)
+        {
+            m_addr  = addr;
+            m_port  = port;
+            m_size  = 0U;
+            m_count = 0U;
+        }
+
+        /**
+         * Write a single byte.
+         *
+         * @param[in] data  Byte to write
+         *
+         * @return Number of written bytes.
+         */
+        size_t write(uint8_t data) final
+        {
+            return write(&data, 1U);
+        }
+
+        /**
+         * Write a metric line.
+         *
+         * @param[in] buffer    Line
+         * @param[in] size      Line size in byte
+         *
+         * @return Number of written bytes.
+         */
+        size_t write(const uint8_t* buffer, size_t size) final;
+
+        /**
+         * Send the pending datagram.
+         */
+        void flush();
+
+        /**
+         * Get number of sent datagrams since begin.
+         *
+         * @return Number of sent datagrams
+         */
+        uint32_t getCount() const
+        {
+            return m_count;
+        }
+
+    private:
+
+        AsyncUDP&   m_udp;                          /**< UDP */
+        IPAddress   m_addr;                         /**< Destination address */
+        uint16_t    m_port;                         /**< Destination port */
+        uint8_t     m_buffer[MAX_DATAGRAM_SIZE];    /**< Datagram buffer */
+        size_t      m_size;                         /**< Number of bytes in the datagram buffer */
+        uint32_t    m_count;                        /**< Number of sent datagrams */
+
+        Datagram(const Datagram& datagram);
+        Datagram& operator=(const Datagram& datagram);
+    };
+
+    bool            m_isEnabled;    /**< Is publishing enabled? */
+    String          m_hostname;     /**< StatsD server hostname */
+    uint16_t        m_port;         /**< StatsD server port */
+    String          m_prefix;       /**< Prefix of the metric names */
+    uint32_t        m_period;       /**< Publish period in ms */
+    SimpleTimer     m_timer;        /**< Publish timer */
+    AsyncUDP        m_udp;          /**< UDP */
+    Datagram        m_datagram;     /**< Datagram output */
+
+    /**
+     * Constructs the telemetry publisher.
+     */
+    TelemetryPublisher() :
+        m_isEnabled(false),
+        m_hostname(),
+        m_port(DEFAULT_PORT),
+        m_prefix(),
+        m_period(0U),
+        m_timer(),
+        m_udp(),
+        m_datagram(m_udp)
+    {
+    }
+
+    /**
+     * Destroys the telemetry publisher.
+     */
+    ~TelemetryPublisher()
+    {
+        end();
+    }
+
+    TelemetryPublisher(const TelemetryPublisher& publisher);
+    TelemetryPublisher& operator=(const TelemetryPublisher& publisher);
+
+    /**
+     * Parse the server address.
+     *
+     * @param[in] server    Server address in the format host[:port]
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    bool parseServer(const String& server);
+
+    /**
+     * Publish all metrics to the server.
+     *
+     * @param[in] addr  Server address
+     */
+    void publish(const IPAddress& addr);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TELEMETRY_PUBLISHER_H__ */
+
+/** @} */
@@ -0,0 +1,372 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  TLS connection
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TlsConnection.h"
+#include "TlsStore.h"
+
+#include <Util.h>
+#include <Logging.h>
+#include <Metrics.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Upper bounds of the TLS handshake time histogram buckets in ms. */
+static const uint32_t   gHandshakeBounds[]  = { 100U, 250U, 500U, 1000U, 2500U, 5000U, 10000U };
+
+/** TLS handshake time histogram */
+static MetricHistogram  gMetricHandshakeTime("pixelix_tls_handshake_time_ms", "Time of a TLS handshake in ms.", gHandshakeBounds, UTIL_ARRAY_NUM(gHandshakeBounds));
+
+/** Number of failed TLS handshakes */
+static MetricCounter    gMetricHandshakeErrors("pixelix_tls_handshake_errors_total", "Number of failed TLS handshakes.");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+TlsConnection::TlsConnection(AsyncClient& client) :
+    m_client(client),
+    m_state(STATE_IDLE),
+    m_ssl(),
+    m_hostname(),
+    m_port(0U),
+    m_rxData(nullptr),
+    m_rxSize(0U),
+    m_rxIndex(0U),
+    m_isReceiving(false),
+    m_isStopReq(false),
+    m_handshakeTimestamp(0U),
+    m_plain()
+{
+    mbedtls_ssl_init(&m_ssl);
+}
+
+TlsConnection::~TlsConnection()
+{
+    mbedtls_ssl_free(&m_ssl);
+}
+
+bool TlsConnection::start(const String& hostname, uint16_t port)
+{
+    const mbedtls_ssl_config*   config  = TlsStore::getInstance().getConfig();
+    int                         ret     = 0;
+
+    release();
+
+    if (nullptr == config)
+    {
+        LOG_ERROR("TLS is not available.");
+        m_state = STATE_FAILED;
+    }
+    else if (0 != (ret = mbedtls_ssl_setup(&m_ssl, config)))
+    {
+        LOG_ERROR("TLS setup failed: -0x%04X", -ret);
+        m_state = STATE_FAILED;
+    }
+    /* Required for SNI and to verify the server certificate. */
+    else if (0 != (ret = mbedtls_ssl_set_hostname(&m_ssl, hostname.c_str())))
+    {
+        LOG_ERROR("TLS hostname failed: -0x%04X", -ret);
+        m_state = STATE_FAILED;
+    }
+    else
+    {
+        mbedtls_ssl_set_bio(&m_ssl, this, bioSend, bioRecv, nullptr);
+
+        m_hostname  = hostname;
+        m_port      = port;
+
+        if (true == TlsStore::getInstance().loadSession(hostname, port, &m_ssl))
+        {
+            LOG_INFO("Resume TLS session with %s.", hostname.c_str());
+        }
+
+        m_state                 = STATE_HANDSHAKE;
+        m_handshakeTimestamp    = millis();
+
+        /* Sends the client hello. */
+        handshake();
+    }
+
+    return (STATE_FAILED != m_state);
+}
+
+void TlsConnection::stop()
+{
+    /* The TLS context is in use, while receiving. */
+    if (true == m_isReceiving)
+    {
+        m_isStopReq = true;
+    }
+    else
+    {
+        if ((STATE_ESTABLISHED == m_state) &&
+            (true == m_client.connected()))
+        {
+            (void)mbedtls_ssl_close_notify(&m_ssl);
+        }
+
+        release();
+    }
+
+    return;
+}
+
+bool TlsConnection::receive(const uint8_t* data, size_t len, const OnData& onData)
+{
+    m_rxData        = data;
+    m_rxSize        = len;
+    m_rxIndex       = 0U;
+    m_isReceiving   = true;
+
+    if (STATE_HANDSHAKE == m_state)
+    {
+        handshake();
+    }
+
+    /* The handshake may be finished with the received data. */
+    if (STATE_ESTABLISHED == m_state)
+    {
+        int ret = 0;
+
+        do
+        {
+            ret = mbedtls_ssl_read(&m_ssl, m_plain, sizeof(m_plain));
+
+            if ((0 < ret) &&
+                (nullptr != onData))
+            {
+                onData(m_plain, static_cast<size_t>(ret));
+            }
+        }
+        while((0 < ret) && (false == m_isStopReq));
+
+        if ((0 == ret) ||
+            (MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY == ret))
+        {
+            LOG_INFO("TLS connection closed by peer.");
+            m_state = STATE_FAILED;
+        }
+        else if ((0 > ret) &&
+                 (MBEDTLS_ERR_SSL_WANT_READ != ret) &&
+                 (MBEDTLS_ERR_SSL_WANT_WRITE != ret))
+        {
+            LOG_WARNING("TLS read failed: -0x%04X", -ret);
+            m_state = STATE_FAILED;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    m_rxData        = nullptr;
+    m_rxSize        = 0U;
+    m_rxIndex       = 0U;
+    m_isReceiving   = false;
+
+    if (true == m_isStopReq)
+    {
+        m_isStopReq = false;
+        stop();
+    }
+
+    return ((STATE_HANDSHAKE == m_state) || (STATE_ESTABLISHED == m_state));
+}
+
+size_t TlsConnection::write(const uint8_t* data, size_t len)
+{
+    size_t  written = 0U;
+    bool    isOk    = (STATE_ESTABLISHED == m_state);
+
+    while((true == isOk) && (len > written))
+    {
+        int ret = mbedtls_ssl_write(&m_ssl, &data[written], len - written);
+
+        if (0 < ret)
+        {
+            written += static_cast<size_t>(ret);
+        }
+        else
+        {
+            /* The TCP send buffer is full or the connection failed. */
+            if ((MBEDTLS_ERR_SSL_WANT_READ != ret) &&
+                (MBEDTLS_ERR_SSL_WANT_WRITE != ret))
+            {
+                LOG_WARNING("TLS write failed: -0x%04X", -ret);
+                m_state = STATE_FAILED;
+            }
+
+            isOk = false;
+        }
+    }
+
+    return written;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void TlsConnection::handshake()
+{
+    int ret = mbedtls_ssl_handshake(&m_ssl);
+
+    if (0 == ret)
+    {
+        uint32_t duration = millis() - m_handshakeTimestamp;
+
+        LOG_INFO("TLS established with %s (%s) in %u ms.", m_hostname.c_str(), mbedtls_ssl_get_ciphersuite(&m_ssl), duration);
+        gMetricHandshakeTime.observe(duration);
+
+        /* Keep the session, maybe with a new ticket, for the next connection. */
+        TlsStore::getInstance().saveSession(m_hostname, m_port, &m_ssl);
+
+        m_state = STATE_ESTABLISHED;
+    }
+    else if ((MBEDTLS_ERR_SSL_WANT_READ == ret) ||
+             (MBEDTLS_ERR_SSL_WANT_WRITE == ret))
+    {
+        /* Handshake continues with the next received data. */
+        ;
+    }
+    else
+    {
+        uint32_t flags = mbedtls_ssl_get_verify_result(&m_ssl);
+
+        if (0U != flags)
+        {
+            LOG_WARNING("TLS handshake with %s failed, certificate not verified: 0x%08X", m_hostname.c_str(), flags);
+        }
+        else
+        {
+            LOG_WARNING("TLS handshake with %s failed: -0x%04X", m_hostname.c_str(), -ret);
+        }
+
+        gMetricHandshakeErrors.inc();
+
+        /* A broken session shall not be resumed again. */
+        TlsStore::getInstance().dropSession(m_hostname, m_port);
+
+        m_state = STATE_FAILED;
+    }
+
+    return;
+}
+
+void TlsConnection::release()
+{
+    if (STATE_IDLE != m_state)
+    {
+        mbedtls_ssl_free(&m_ssl);
+        mbedtls_ssl_init(&m_ssl);
+        m_state = STATE_IDLE;
+    }
+
+    return;
+}
+
+int TlsConnection::bioSend(void* ctx, const unsigned char* buf, size_t len)
+{
+    TlsConnection*  conn    = static_cast<TlsConnection*>(ctx);
+    int             ret     = MBEDTLS_ERR_SSL_WANT_WRITE;
+
+    if (nullptr != conn)
+    {
+        size_t space = conn->m_client.space();
+
+        if (0U < space)
+        {
+            size_t added = conn->m_client.add(reinterpret_cast<const char*>(buf), (len < space) ? len : space);
+
+            if (0U < added)
+            {
+                (void)conn->m_client.send();
+                ret = static_cast<int>(added);
+            }
+        }
+    }
+
+    return ret;
+}
+
+int TlsConnection::bioRecv(void* ctx, unsigned char* buf, size_t len)
+{
+    TlsConnection*  conn    = static_cast<TlsConnection*>(ctx);
+    int             ret     = MBEDTLS_ERR_SSL_WANT_READ;
+
+    if ((nullptr != conn) &&
+        (nullptr != conn->m_rxData) &&
+        (conn->m_rxSize > conn->m_rxIndex))
+    {
+        size_t available    = conn->m_rxSize - conn->m_rxIndex;
+        size_t copySize     = (len < available) ? len : available;
+
+        memcpy(buf, &conn->m_rxData[conn->m_rxIndex], copySize);
+        conn->m_rxIndex += copySize;
+
+        ret = static_cast<int>(copySize);
+    }
+
+    return ret;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
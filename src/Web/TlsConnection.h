@@ -0,0 +1,210 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  TLS connection
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __TLS_CONNECTION_H__
+#define __TLS_CONNECTION_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <mbedtls/ssl.h>
+#include <functional>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A TLS connection on top of a asynchronous TCP client. It is driven by the
+ * TCP client callbacks: Start it after the TCP connection is established and
+ * provide all received data. The handshake runs with the received data and
+ * afterwards the decrypted data is provided to the caller.
+ *
+ * The configuration, the CA certificates and the cached sessions are shared
+ * by all connections, see TlsStore. A cached session of the host is resumed,
+ * which avoids a full handshake.
+ */
+class TlsConnection
+{
+public:
+
+    /**
+     * Prototype of callback for decrypted data.
+     */
+    typedef std::function<void(const uint8_t* data, size_t len)> OnData;
+
+    /** Size of the buffer for decrypted data in byte. */
+    static const size_t PLAIN_BUFFER_SIZE   = 512U;
+
+    /**
+     * Constructs a TLS connection.
+     *
+     * @param[in] client    TCP client, which transports the TLS records.
+     */
+    TlsConnection(AsyncClient& client);
+
+    /**
+     * Destroys the TLS connection.
+     */
+    ~TlsConnection();
+
+    /**
+     * Start the handshake. The TCP connection must be established.
+     *
+     * @param[in] hostname  Hostname, used to verify the server certificate.
+     * @param[in] port      Port
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool start(const String& hostname, uint16_t port);
+
+    /**
+     * Stop the TLS connection and release its buffers.
+     * The TCP connection is not closed.
+     */
+    void stop();
+
+    /**
+     * Is the handshake finished and the connection established?
+     *
+     * @return If established, it will return true otherwise false.
+     */
+    bool isEstablished() const
+    {
+        return (STATE_ESTABLISHED == m_state);
+    }
+
+    /**
+     * Provide received TCP data. All of it is consumed, either by the
+     * handshake or by decrypting it.
+     *
+     * @param[in] data      Received data
+     * @param[in] len       Data length in byte
+     * @param[in] onData    Callback, which is called for the decrypted data.
+     *
+     * @return If the connection shall be kept, it will return true otherwise false.
+     */
+    bool receive(const uint8_t* data, size_t len, const OnData& onData);
+
+    /**
+     * Encrypt and send data.
+     *
+     * @param[in] data  Data
+     * @param[in] len   Data length in byte
+     *
+     * @return Number of sent bytes.
+     */
+    size_t write(const uint8_t* data, size_t len);
+
+private:
+
+    /**
+     * Connection states.
+     */
+    enum State
+    {
+        STATE_IDLE = 0,     /**< Not started */
+        STATE_HANDSHAKE,    /**< Handshake in progress */
+        STATE_ESTABLISHED,  /**< Connection established */
+        STATE_FAILED        /**< Handshake or connection failed */
+    };
+
+    AsyncClient&        m_client;                       /**< TCP client */
+    State               m_state;                        /**< Connection state */
+    mbedtls_ssl_context m_ssl;                          /**< TLS context */
+    String              m_hostname;                     /**< Hostname */
+    uint16_t            m_port;                         /**< Port */
+    const uint8_t*      m_rxData;                       /**< Received data, only valid during receiving. */
+    size_t              m_rxSize;                       /**< Received data length in byte */
+    size_t              m_rxIndex;                      /**< Index of the next not consumed received byte */
+    bool                m_isReceiving;                  /**< Is receiving in progress? */
+    bool                m_isStopReq;                    /**< Is stop requested during receiving? */
+    uint32_t            m_handshakeTimestamp;           /**< Timestamp in ms, when the handshake started. */
+    uint8_t             m_plain[PLAIN_BUFFER_SIZE];     /**< Buffer for decrypted data */
+
+    /* Prevent copying */
+    TlsConnection(const TlsConnection& conn);
+    TlsConnection& operator=(const TlsConnection& conn);
+
+    /**
+     * Continue the handshake with the received data.
+     */
+    void handshake();
+
+    /**
+     * Release the TLS context.
+     */
+    void release();
+
+    /**
+     * Send TLS records via TCP.
+     *
+     * @param[in] ctx   TLS connection
+     * @param[in] buf   Data
+     * @param[in] len   Data length in byte
+     *
+     * @return Number of sent bytes or a negative error code.
+     */
+    static int bioSend(void* ctx, const unsigned char* buf, size_t len);
+
+    /**
+     * Get TLS records from the received TCP data.
+     *
+     * @param[in]   ctx TLS connection
+     * @param[out]  buf Buffer
+     * @param[in]   len Buffer size in byte
+     *
+     * @return Number of read bytes or a negative error code.
+     */
+    static int bioRecv(void* ctx, unsigned char* buf, size_t len);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TLS_CONNECTION_H__ */
+
+/** @} */
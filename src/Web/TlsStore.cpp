@@ -0,0 +1,381 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  TLS store
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TlsStore.h"
+#include "FileSystem.h"
+
+#include <Logging.h>
+#include <MemPolicy.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize filename of the CA certificates. */
+const char* TlsStore::CA_FILE_NAME  = "/tls/ca.pem";
+
+/** Personalization string of the random number generator. */
+static const char*  RNG_PERSONALIZATION = "pixelix";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool TlsStore::begin()
+{
+    lock();
+
+    if (false == m_isInitialized)
+    {
+        int ret = 0;
+
+        m_isInitialized = true;
+
+        ret = mbedtls_ctr_drbg_seed(&m_ctrDrbg,
+                                    mbedtls_entropy_func,
+                                    &m_entropy,
+                                    reinterpret_cast<const unsigned char*>(RNG_PERSONALIZATION),
+                                    strlen(RNG_PERSONALIZATION));
+
+        if (0 != ret)
+        {
+            LOG_ERROR("Failed to seed RNG: -0x%04X", -ret);
+        }
+        else if (false == loadCaChain())
+        {
+            LOG_ERROR("No CA certificates in %s, TLS is not available.", CA_FILE_NAME);
+        }
+        else
+        {
+            ret = mbedtls_ssl_config_defaults(  &m_config,
+                                                MBEDTLS_SSL_IS_CLIENT,
+                                                MBEDTLS_SSL_TRANSPORT_STREAM,
+                                                MBEDTLS_SSL_PRESET_DEFAULT);
+
+            if (0 != ret)
+            {
+                LOG_ERROR("Failed to setup TLS config: -0x%04X", -ret);
+            }
+            else
+            {
+                mbedtls_ssl_conf_authmode(&m_config, MBEDTLS_SSL_VERIFY_REQUIRED);
+                mbedtls_ssl_conf_ca_chain(&m_config, &m_caChain, nullptr);
+                mbedtls_ssl_conf_rng(&m_config, mbedtls_ctr_drbg_random, &m_ctrDrbg);
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+                mbedtls_ssl_conf_session_tickets(&m_config, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif  /* defined(MBEDTLS_SSL_SESSION_TICKETS) */
+
+                m_isReady = true;
+            }
+        }
+    }
+
+    unlock();
+
+    return m_isReady;
+}
+
+bool TlsStore::loadSession(const String& hostname, uint16_t port, mbedtls_ssl_context* ssl)
+{
+    bool    isAvailable = false;
+    uint8_t index       = MAX_SESSIONS;
+
+    lock();
+
+    index = findEntry(hostname, port);
+
+    if (MAX_SESSIONS > index)
+    {
+        Entry& entry = m_sessions[index];
+
+        if (SESSION_MAX_AGE <= (millis() - entry.timestamp))
+        {
+            mbedtls_ssl_session_free(&entry.session);
+            mbedtls_ssl_session_init(&entry.session);
+            entry.hostname.clear();
+        }
+        else if (0 == mbedtls_ssl_set_session(ssl, &entry.session))
+        {
+            isAvailable = true;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    unlock();
+
+    return isAvailable;
+}
+
+void TlsStore::saveSession(const String& hostname, uint16_t port, const mbedtls_ssl_context* ssl)
+{
+    uint8_t index = MAX_SESSIONS;
+
+    lock();
+
+    index = findEntry(hostname, port);
+
+    /* Use a free entry or replace the oldest one. */
+    if (MAX_SESSIONS <= index)
+    {
+        uint8_t     idx     = 0U;
+        uint32_t    maxAge  = 0U;
+
+        for(idx = 0U; idx < MAX_SESSIONS; ++idx)
+        {
+            /* A free entry is treated as the oldest one. */
+            uint32_t age = (true == m_sessions[idx].hostname.isEmpty()) ? UINT32_MAX : (millis() - m_sessions[idx].timestamp);
+
+            if ((MAX_SESSIONS <= index) ||
+                (maxAge < age))
+            {
+                index   = idx;
+                maxAge  = age;
+            }
+        }
+    }
+
+    if (MAX_SESSIONS > index)
+    {
+        Entry& entry = m_sessions[index];
+
+        mbedtls_ssl_session_free(&entry.session);
+        mbedtls_ssl_session_init(&entry.session);
+
+        if (0 != mbedtls_ssl_get_session(ssl, &entry.session))
+        {
+            mbedtls_ssl_session_free(&entry.session);
+            mbedtls_ssl_session_init(&entry.session);
+            entry.hostname.clear();
+        }
+        else
+        {
+            entry.hostname  = hostname;
+            entry.port      = port;
+            entry.timestamp = millis();
+        }
+    }
+
+    unlock();
+
+    return;
+}
+
+void TlsStore::dropSession(const String& hostname, uint16_t port)
+{
+    uint8_t index = MAX_SESSIONS;
+
+    lock();
+
+    index = findEntry(hostname, port);
+
+    if (MAX_SESSIONS > index)
+    {
+        Entry& entry = m_sessions[index];
+
+        mbedtls_ssl_session_free(&entry.session);
+        mbedtls_ssl_session_init(&entry.session);
+        entry.hostname.clear();
+    }
+
+    unlock();
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+TlsStore::TlsStore() :
+    m_isInitialized(false),
+    m_isReady(false),
+    m_entropy(),
+    m_ctrDrbg(),
+    m_caChain(),
+    m_config(),
+    m_sessions(),
+    m_xMutex(xSemaphoreCreateRecursiveMutex())
+{
+    uint8_t index = 0U;
+
+    mbedtls_entropy_init(&m_entropy);
+    mbedtls_ctr_drbg_init(&m_ctrDrbg);
+    mbedtls_x509_crt_init(&m_caChain);
+    mbedtls_ssl_config_init(&m_config);
+
+    for(index = 0U; index < MAX_SESSIONS; ++index)
+    {
+        m_sessions[index].port      = 0U;
+        m_sessions[index].timestamp = 0U;
+        mbedtls_ssl_session_init(&m_sessions[index].session);
+    }
+}
+
+TlsStore::~TlsStore()
+{
+    uint8_t index = 0U;
+
+    for(index = 0U; index < MAX_SESSIONS; ++index)
+    {
+        mbedtls_ssl_session_free(&m_sessions[index].session);
+    }
+
+    mbedtls_ssl_config_free(&m_config);
+    mbedtls_x509_crt_free(&m_caChain);
+    mbedtls_ctr_drbg_free(&m_ctrDrbg);
+    mbedtls_entropy_free(&m_entropy);
+
+    if (nullptr != m_xMutex)
+    {
+        vSemaphoreDelete(m_xMutex);
+        m_xMutex = nullptr;
+    }
+}
+
+bool TlsStore::loadCaChain()
+{
+    bool    isLoaded    = false;
+    File    fd          = FILESYSTEM.open(CA_FILE_NAME, "r");
+
+    if (true == fd)
+    {
+        size_t          size    = fd.size();
+        unsigned char*  buffer  = static_cast<unsigned char*>(MemPolicy::allocate(MemPolicy::REGION_LARGE, size + 1U));
+
+        if (nullptr == buffer)
+        {
+            LOG_ERROR("Out of memory.");
+        }
+        else
+        {
+            if (size == fd.read(buffer, size))
+            {
+                int ret = 0;
+
+                /* The PEM parser requires the string termination, which is part of the length. */
+                buffer[size] = '\0';
+                ret = mbedtls_x509_crt_parse(&m_caChain, buffer, size + 1U);
+
+                /* A positive value is the number of certificates, which failed to parse. */
+                if (0 > ret)
+                {
+                    LOG_ERROR("Failed to parse CA certificates: -0x%04X", -ret);
+                }
+                else
+                {
+                    if (0 < ret)
+                    {
+                        LOG_WARNING("%d CA certificates skipped.", ret);
+                    }
+
+                    /* At least one certificate is required. */
+                    isLoaded = (0 != m_caChain.version);
+                }
+            }
+
+            MemPolicy::release(buffer);
+        }
+
+        fd.close();
+    }
+
+    return isLoaded;
+}
+
+uint8_t TlsStore::findEntry(const String& hostname, uint16_t port) const
+{
+    uint8_t index = 0U;
+
+    while((MAX_SESSIONS > index) &&
+          ((port != m_sessions[index].port) ||
+           (true == m_sessions[index].hostname.isEmpty()) ||
+           (0U == hostname.equalsIgnoreCase(m_sessions[index].hostname))))
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+void TlsStore::lock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreTakeRecursive(m_xMutex, portMAX_DELAY);
+    }
+
+    return;
+}
+
+void TlsStore::unlock() const
+{
+    if (nullptr != m_xMutex)
+    {
+        (void)xSemaphoreGiveRecursive(m_xMutex);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,217 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  TLS store
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __TLS_STORE_H__
+#define __TLS_STORE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/x509_crt.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The TLS store keeps everything, which is shared by all TLS connections:
+ * the client configuration, the random number generator, the CA certificates
+ * and the sessions of the last connected hosts.
+ *
+ * The CA certificates (PEM) are loaded once from the filesystem. Without
+ * them no server can be verified, therefore no TLS connection is possible.
+ *
+ * A cached session is used to resume it on the next connection to the same
+ * host, with a session ticket or the session id. This avoids the expensive
+ * full handshake per request.
+ */
+class TlsStore
+{
+public:
+
+    /** Max. number of cached sessions. */
+    static const uint8_t    MAX_SESSIONS    = 4U;
+
+    /** Max. age in ms of a cached session. */
+    static const uint32_t   SESSION_MAX_AGE = (60U * 60U * 1000U);
+
+    /** Filename of the CA certificates (PEM) in the filesystem. */
+    static const char*      CA_FILE_NAME;
+
+    /**
+     * Get the TLS store instance.
+     *
+     * @return TLS store
+     */
+    static TlsStore& getInstance()
+    {
+        static TlsStore instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Initialize the shared configuration and load the CA certificates.
+     * It is done only once, further calls return the previous result.
+     * Parsing the certificates takes some time, therefore don't call it
+     * in the lwIP or AsyncTCP task.
+     *
+     * @return If the store is ready, it will return true otherwise false.
+     */
+    bool begin();
+
+    /**
+     * Get the shared client configuration.
+     *
+     * @return Configuration, nullptr if not ready.
+     */
+    const mbedtls_ssl_config* getConfig() const
+    {
+        return (true == m_isReady) ? &m_config : nullptr;
+    }
+
+    /**
+     * Provide the cached session of the host to the TLS context, so the
+     * next handshake resumes it.
+     *
+     * @param[in]       hostname    Hostname
+     * @param[in]       port        Port
+     * @param[in,out]   ssl         TLS context, before the handshake starts
+     *
+     * @return If a session is available, it will return true otherwise false.
+     */
+    bool loadSession(const String& hostname, uint16_t port, mbedtls_ssl_context* ssl);
+
+    /**
+     * Cache the session of a established TLS connection.
+     *
+     * @param[in] hostname  Hostname
+     * @param[in] port      Port
+     * @param[in] ssl       TLS context, after the handshake is finished
+     */
+    void saveSession(const String& hostname, uint16_t port, const mbedtls_ssl_context* ssl);
+
+    /**
+     * Drop the cached session of the host, e.g. after a failed handshake.
+     *
+     * @param[in] hostname  Hostname
+     * @param[in] port      Port
+     */
+    void dropSession(const String& hostname, uint16_t port);
+
+private:
+
+    /**
+     * A cached session.
+     */
+    struct Entry
+    {
+        String                  hostname;   /**< Hostname, empty if unused */
+        uint16_t                port;       /**< Port */
+        mbedtls_ssl_session     session;    /**< Session */
+        uint32_t                timestamp;  /**< Timestamp in ms, when the session was cached */
+    };
+
+    bool                        m_isInitialized;            /**< Is the initialization done? */
+    bool                        m_isReady;                  /**< Is the store ready to use? */
+    mbedtls_entropy_context     m_entropy;                  /**< Entropy source */
+    mbedtls_ctr_drbg_context    m_ctrDrbg;                  /**< Random number generator */
+    mbedtls_x509_crt            m_caChain;                  /**< CA certificates */
+    mbedtls_ssl_config          m_config;                   /**< Shared client configuration */
+    Entry                       m_sessions[MAX_SESSIONS];   /**< Cached sessions */
+    SemaphoreHandle_t           m_xMutex;                   /**< Mutex to protect against concurrent access. */
+
+    /**
+     * Constructs the TLS store.
+     */
+    TlsStore();
+
+    /**
+     * Destroys the TLS store.
+     */
+    ~TlsStore();
+
+    /* Prevent copying */
+    TlsStore(const TlsStore& store);
+    TlsStore& operator=(const TlsStore& store);
+
+    /**
+     * Load the CA certificates from the filesystem.
+     *
+     * @return If at least one certificate is loaded, it will return true otherwise false.
+     */
+    bool loadCaChain();
+
+    /**
+     * Find the cached session of the host.
+     *
+     * @param[in] hostname  Hostname
+     * @param[in] port      Port
+     *
+     * @return Index of the entry or MAX_SESSIONS if not found.
+     */
+    uint8_t findEntry(const String& hostname, uint16_t port) const;
+
+    /**
+     * Lock the store.
+     */
+    void lock() const;
+
+    /**
+     * Unlock the store.
+     */
+    void unlock() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TLS_STORE_H__ */
+
+/** @} */
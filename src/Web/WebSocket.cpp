@@ -42,14 +42,27 @@
 #include "WsCmdReset.h"
 #include "WsCmdBrightness.h"
 #include "WsCmdLog.h"
+#include "WsCmdLogLevel.h"
 #include "WsCmdMove.h"
 #include "WsCmdSlotDuration.h"
+#include "WsCmdSlotSchedule.h"
 #include "WsCmdIperf.h"
+#include "WsCmdBenchmark.h"
 #include "WsCmdButton.h"
 #include "WsCmdEffect.h"
+#include "WsCmdProfile.h"
+#include "WsCmdDispStream.h"
+#include "WsCmdRecord.h"
+#include "WsCmdMetricStream.h"
+#include "DisplayStreamer.h"
+#include "MetricsStreamer.h"
+#include "FrameRecorder.h"
+#include "SettingCoalescer.h"
 
 #include <Logging.h>
 #include <Util.h>
+#include <MemPolicy.h>
+#include <Metrics.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -67,10 +80,24 @@
  * Prototypes
  *****************************************************************************/
 
+static uint32_t hashCmdName(const char* name, size_t nameLen, uint32_t seed);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Number of connected websocket clients */
+static MetricGauge          gMetricClients("pixelix_websocket_clients", "Number of connected websocket clients.");
+
+/** Number of accepted websocket messages */
+static MetricCounter        gMetricMsgs("pixelix_websocket_messages_total", "Number of accepted websocket messages.");
+
+/** Number of rejected websocket messages */
+static MetricCounter        gMetricRejectedMsgs("pixelix_websocket_rejected_messages_total", "Number of websocket messages rejected because of backpressure.");
+
+/** Number of broadcast messages, which were dropped for slow clients */
+static MetricCounter        gMetricDroppedBroadcasts("pixelix_websocket_dropped_broadcasts_total", "Number of websocket broadcast messages dropped for slow clients.");
+
 /** Websocket get display command */
 static WsCmdGetDisp         gWsCmdGetDisp;
 
@@ -95,21 +122,42 @@ static WsCmdBrightness      gWsCmdBrightness;
 /** Websocket log command */
 static WsCmdLog             gWsCmdLog;
 
+/** Websocket command to get/set the log level of a log module */
+static WsCmdLogLevel        gWsCmdLogLevel;
+
 /** Websocket move command */
 static WsCmdMove            gWsCmdMove;
 
 /** Websocket slot duration command */
 static WsCmdSlotDuration    gWsCmdSlotDuration;
 
+/** Websocket slot schedule command */
+static WsCmdSlotSchedule    gWsCmdSlotSchedule;
+
 /** Websocket iperf command */
 static WsCmdIperf           gWsCmdIperf;
 
+/** Websocket benchmark command */
+static WsCmdBenchmark       gWsCmdBenchmark;
+
 /** Websocket control virtual button command */
 static WsCmdButton          gWsCmdButton;
 
 /** Websocket control fade effects */
 static WsCmdEffect          gWsCmdEffect;
 
+/** Websocket get display runtime profile command */
+static WsCmdProfile         gWsCmdProfile;
+
+/** Websocket display content stream command */
+static WsCmdDispStream      gWsCmdDispStream;
+
+/** Websocket display frame recording command */
+static WsCmdRecord          gWsCmdRecord;
+
+/** Websocket metrics stream command */
+static WsCmdMetricStream    gWsCmdMetricStream;
+
 /** Websocket command list */
 static WsCmd*       gWsCommands[] =
 {
@@ -121,11 +169,18 @@ static WsCmd*       gWsCommands[] =
     &gWsCmdReset,
     &gWsCmdBrightness,
     &gWsCmdLog,
+    &gWsCmdLogLevel,
     &gWsCmdMove,
     &gWsCmdSlotDuration,
+    &gWsCmdSlotSchedule,
     &gWsCmdIperf,
+    &gWsCmdBenchmark,
     &gWsCmdButton,
-    &gWsCmdEffect
+    &gWsCmdEffect,
+    &gWsCmdProfile,
+    &gWsCmdDispStream,
+    &gWsCmdRecord,
+    &gWsCmdMetricStream
 };
 
 /******************************************************************************
@@ -134,6 +189,16 @@ static WsCmd*       gWsCommands[] =
 
 void WebSocketSrv::init(AsyncWebServer& srv)
 {
+    if (nullptr == m_fanoutMutex)
+    {
+        m_fanoutMutex = xSemaphoreCreateMutex();
+
+        if (nullptr == m_fanoutMutex)
+        {
+            LOG_ERROR("Couldn't create websocket broadcast mutex.");
+        }
+    }
+
     /* Register websocket event handler */
     m_webSocket.onEvent(onEvent);
 
@@ -143,9 +208,139 @@ void WebSocketSrv::init(AsyncWebServer& srv)
     /* Register websocket on webserver */
     srv.addHandler(&m_webSocket);
 
+    if (false == buildCmdTable())
+    {
+        LOG_WARNING("No perfect websocket command hash found, fallback to linear search.");
+    }
+
+    if (false == startExecutor())
+    {
+        LOG_ERROR("Couldn't start websocket command executor.");
+    }
+
+    return;
+}
+
+void WebSocketSrv::process()
+{
+    DisplayStreamer::getInstance().process(m_webSocket);
+    MetricsStreamer::getInstance().process(m_webSocket);
+    FrameRecorder::getInstance().process(m_webSocket);
+    SettingCoalescer::getInstance().process();
+    processHeldBack();
+
     return;
 }
 
+uint32_t WebSocketSrv::getClientCount() const
+{
+    int32_t count = gMetricClients.get();
+
+    return (0 < count) ? static_cast<uint32_t>(count) : 0U;
+}
+
+void WebSocketSrv::sendResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const String& rsp)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    if (false == m_isBatch)
+    {
+        server->text(client->id(), rsp);
+    }
+    else
+    {
+        if (0U < m_batchRsp.length())
+        {
+            m_batchRsp += BATCH_DELIMITER;
+        }
+
+        m_batchRsp += rsp;
+    }
+
+    return;
+}
+
+bool WebSocketSrv::broadcast(const uint8_t* data, size_t size, bool isBinary)
+{
+    bool                            isQueued    = false;
+    AsyncWebSocketMessageBuffer*    buffer      = nullptr;
+    uint8_t                         index       = 0U;
+
+    if ((nullptr == data) ||
+        (0U == size) ||
+        (nullptr == m_fanoutMutex))
+    {
+        return false;
+    }
+
+    (void)xSemaphoreTake(m_fanoutMutex, portMAX_DELAY);
+
+    /* Copy the message only once for all clients. */
+    buffer = m_webSocket.makeBuffer(const_cast<uint8_t*>(data), size);
+
+    if (nullptr != buffer)
+    {
+        /* Keep the buffer alive, until it is referenced by all clients. */
+        buffer->lock();
+
+        for(index = 0U; index < MAX_CLIENTS; ++index)
+        {
+            Fanout&                 fanout  = m_fanouts[index];
+            AsyncWebSocketClient*   client  = nullptr;
+
+            if (true == fanout.isUsed)
+            {
+                client = m_webSocket.client(fanout.clientId);
+            }
+
+            if (nullptr != client)
+            {
+                /* A older held back message is sent first to keep the order. */
+                sendHeldBack(*client, fanout);
+
+                /* If the client can't keep up, hold the message back and drop
+                 * the older one, which is still waiting.
+                 */
+                if (true == client->queueIsFull())
+                {
+                    if (nullptr != fanout.heldBack)
+                    {
+                        releaseHeldBack(fanout);
+                        gMetricDroppedBroadcasts.inc();
+                    }
+
+                    (*buffer)++;
+                    fanout.heldBack = buffer;
+                    fanout.isBinary = isBinary;
+                }
+                else if (true == isBinary)
+                {
+                    client->binary(buffer);
+                }
+                else
+                {
+                    client->text(buffer);
+                }
+
+                isQueued = true;
+            }
+        }
+
+        buffer->unlock();
+    }
+
+    /* Free the buffers, which are sent to all clients. */
+    m_webSocket._cleanBuffers();
+
+    (void)xSemaphoreGive(m_fanoutMutex);
+
+    return isQueued;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -156,12 +351,22 @@ void WebSocketSrv::init(AsyncWebServer& srv)
 
 void WebSocketSrv::onEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len)
 {
+    SemaphoreHandle_t clientMutex = getInstance().m_clientMutex;
+
     if ((nullptr == server) ||
         (nullptr == client))
     {
         return;
     }
 
+    /* The client must not be destroyed or used by the AsyncTCP task,
+     * while the executor task accesses it.
+     */
+    if (nullptr != clientMutex)
+    {
+        (void)xSemaphoreTake(clientMutex, portMAX_DELAY);
+    }
+
     switch(type)
     {
     /* Client connected */
@@ -193,6 +398,11 @@ void WebSocketSrv::onEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
         break;
     }
 
+    if (nullptr != clientMutex)
+    {
+        (void)xSemaphoreGive(clientMutex);
+    }
+
     return;
 }
 
@@ -201,12 +411,68 @@ void WebSocketSrv::onConnect(AsyncWebSocket* server, AsyncWebSocketClient* clien
     UTIL_NOT_USED(request);
 
     LOG_INFO("ws[%s][%u] Client connected.", server->url(), client->id());
+    gMetricClients.inc();
+
+    if (nullptr != m_fanoutMutex)
+    {
+        uint8_t index = 0U;
+
+        (void)xSemaphoreTake(m_fanoutMutex, portMAX_DELAY);
+
+        while((MAX_CLIENTS > index) && (true == m_fanouts[index].isUsed))
+        {
+            ++index;
+        }
+
+        if (MAX_CLIENTS > index)
+        {
+            m_fanouts[index].clientId   = client->id();
+            m_fanouts[index].isUsed     = true;
+            m_fanouts[index].isBinary   = false;
+            m_fanouts[index].heldBack   = nullptr;
+        }
+        else
+        {
+            LOG_WARNING("ws[%s][%u] No broadcasts, too many clients.", server->url(), client->id());
+        }
+
+        (void)xSemaphoreGive(m_fanoutMutex);
+    }
+
     return;
 }
 
 void WebSocketSrv::onDisconnect(AsyncWebSocket* server, AsyncWebSocketClient* client)
 {
     LOG_INFO("ws[%s][%u] Client disconnected.", server->url(), client->id());
+    gMetricClients.dec();
+
+    DisplayStreamer::getInstance().unsubscribe(client->id());
+    MetricsStreamer::getInstance().unsubscribe(client->id());
+
+    if (nullptr != m_fanoutMutex)
+    {
+        uint8_t index = 0U;
+
+        (void)xSemaphoreTake(m_fanoutMutex, portMAX_DELAY);
+
+        for(index = 0U; index < MAX_CLIENTS; ++index)
+        {
+            Fanout& fanout = m_fanouts[index];
+
+            if ((true == fanout.isUsed) &&
+                (client->id() == fanout.clientId))
+            {
+                releaseHeldBack(fanout);
+                fanout.isUsed = false;
+            }
+        }
+
+        m_webSocket._cleanBuffers();
+
+        (void)xSemaphoreGive(m_fanoutMutex);
+    }
+
     return;
 }
 
@@ -248,8 +514,9 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
         LOG_ERROR("ws[%s][%u] Frame info is missing.", server->url(), client->id());
         server->close(client->id(), 0U, "Frame info is missing.");
     }
-    /* No text frame? */
-    else if (WS_TEXT != info->opcode)
+    /* No text or binary frame? */
+    else if ((WS_TEXT != info->opcode) &&
+             (WS_BINARY != info->opcode))
     {
         LOG_ERROR("ws[%s][%u] Not supported message type received: %u", server->url(), client->id(), info->opcode);
         server->close(client->id(), 0U, "Not supported message type.");
@@ -265,10 +532,10 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
         {
             LOG_WARNING("ws[%s][%u] Message: -", server->url(), client->id());
         }
-        /* Handle text message */
+        /* Handle it by the executor task */
         else
         {
-            handleMsg(server, client, reinterpret_cast<const char*>(data), len);
+            postMsg(server, client, data, len, (WS_BINARY == info->opcode));
         }
     }
     /* Message is comprised of multiple frames or the frame is split into multiple packets */
@@ -281,11 +548,463 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
     return;
 }
 
-void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const char* msg, size_t msgLen)
+bool WebSocketSrv::startExecutor()
+{
+    bool status = false;
+
+    if (nullptr == m_taskHandle)
+    {
+        m_mutex         = xSemaphoreCreateMutex();
+        m_clientMutex   = xSemaphoreCreateMutex();
+        m_msgQueue      = xQueueCreate(MSG_QUEUE_SIZE, sizeof(Msg));
+
+        if ((nullptr != m_mutex) &&
+            (nullptr != m_clientMutex) &&
+            (nullptr != m_msgQueue))
+        {
+            BaseType_t osRet = xTaskCreateUniversal(executorTask,
+                                                    "wsExecTask",
+                                                    TASK_STACK_SIZE,
+                                                    this,
+                                                    TASK_PRIORITY,
+                                                    &m_taskHandle,
+                                                    TASK_RUN_CORE);
+
+            /* Task successful created? */
+            if (pdPASS == osRet)
+            {
+                status = true;
+            }
+        }
+
+        /* Any error happened? */
+        if (false == status)
+        {
+            if (nullptr != m_mutex)
+            {
+                vSemaphoreDelete(m_mutex);
+                m_mutex = nullptr;
+            }
+
+            if (nullptr != m_clientMutex)
+            {
+                vSemaphoreDelete(m_clientMutex);
+                m_clientMutex = nullptr;
+            }
+
+            if (nullptr != m_msgQueue)
+            {
+                vQueueDelete(m_msgQueue);
+                m_msgQueue = nullptr;
+            }
+
+            m_taskHandle = nullptr;
+        }
+    }
+
+    return status;
+}
+
+void WebSocketSrv::executorTask(void* parameters)
+{
+    WebSocketSrv* wsSrv = reinterpret_cast<WebSocketSrv*>(parameters);
+
+    if (nullptr != wsSrv)
+    {
+        Msg msg;
+
+        while(true)
+        {
+            if (pdTRUE == xQueueReceive(wsSrv->m_msgQueue, &msg, portMAX_DELAY))
+            {
+                wsSrv->executeMsg(msg);
+                MemPolicy::release(msg.data);
+
+                if (pdTRUE == xSemaphoreTake(wsSrv->m_mutex, portMAX_DELAY))
+                {
+                    Backlog* backlog = wsSrv->getBacklog(msg.clientId, false);
+
+                    if ((nullptr != backlog) &&
+                        (0U < backlog->count))
+                    {
+                        --backlog->count;
+                    }
+
+                    (void)xSemaphoreGive(wsSrv->m_mutex);
+                }
+            }
+        }
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void WebSocketSrv::postMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen, bool isBinary)
+{
+    bool isPosted = false;
+
+    if ((nullptr != m_msgQueue) &&
+        (pdTRUE == xSemaphoreTake(m_mutex, portMAX_DELAY)))
+    {
+        Backlog* backlog = getBacklog(client->id(), true);
+
+        /* Backpressure: Only a limited number of messages per client is accepted. */
+        if ((nullptr != backlog) &&
+            (MAX_PENDING_MSGS > backlog->count))
+        {
+            Msg entry;
+
+            entry.clientId  = client->id();
+            entry.isBinary  = isBinary;
+            entry.data      = static_cast<uint8_t*>(MemPolicy::allocate(MemPolicy::REGION_LARGE, msgLen + 1U));
+            entry.len       = msgLen;
+
+            if (nullptr != entry.data)
+            {
+                /* The termination allows to tokenize a text message in-place. */
+                memcpy(entry.data, msg, msgLen);
+                entry.data[msgLen] = '\0';
+
+                /* Never block the AsyncTCP task. */
+                if (pdTRUE == xQueueSendToBack(m_msgQueue, &entry, 0U))
+                {
+                    ++backlog->count;
+                    isPosted = true;
+                }
+                else
+                {
+                    MemPolicy::release(entry.data);
+                }
+            }
+        }
+
+        (void)xSemaphoreGive(m_mutex);
+    }
+
+    if (true == isPosted)
+    {
+        gMetricMsgs.inc();
+    }
+    else
+    {
+        LOG_WARNING("ws[%s][%u] Busy, message rejected.", server->url(), client->id());
+        gMetricRejectedMsgs.inc();
+
+        if (false == isBinary)
+        {
+            server->text(client->id(), "NACK;\"Busy.\"");
+        }
+        else
+        {
+            uint8_t rsp[BIN_RSP_HEADER_SIZE] = { msg[0], BIN_STATUS_NACK };
+
+            server->binary(client->id(), rsp, sizeof(rsp));
+        }
+    }
+
+    return;
+}
+
+void WebSocketSrv::executeMsg(const Msg& msg)
+{
+    AsyncWebSocketClient* client = nullptr;
+
+    /* The websocket events of the AsyncTCP task are held off, until the
+     * response is queued. A disconnect destroys the client only afterwards.
+     */
+    (void)xSemaphoreTake(m_clientMutex, portMAX_DELAY);
+
+    client = m_webSocket.client(msg.clientId);
+
+    /* The client may be disconnected in the meantime. */
+    if ((nullptr != client) &&
+        (WS_CONNECTED == client->status()))
+    {
+        if (true == msg.isBinary)
+        {
+            handleBinMsg(&m_webSocket, client, msg.data, msg.len);
+        }
+        else
+        {
+            handleMsg(&m_webSocket, client, reinterpret_cast<char*>(msg.data), msg.len);
+        }
+    }
+
+    (void)xSemaphoreGive(m_clientMutex);
+
+    return;
+}
+
+WebSocketSrv::Backlog* WebSocketSrv::getBacklog(uint32_t clientId, bool create)
+{
+    Backlog*    backlog = nullptr;
+    Backlog*    unused  = nullptr;
+    uint8_t     index   = 0U;
+
+    while((nullptr == backlog) && (MAX_CLIENTS > index))
+    {
+        if (0U == m_backlogs[index].count)
+        {
+            if (nullptr == unused)
+            {
+                unused = &m_backlogs[index];
+            }
+        }
+        else if (clientId == m_backlogs[index].clientId)
+        {
+            backlog = &m_backlogs[index];
+        }
+        else
+        {
+            ;
+        }
+
+        ++index;
+    }
+
+    if ((nullptr == backlog) &&
+        (true == create) &&
+        (nullptr != unused))
+    {
+        unused->clientId    = clientId;
+        backlog             = unused;
+    }
+
+    return backlog;
+}
+
+void WebSocketSrv::sendHeldBack(AsyncWebSocketClient& client, Fanout& fanout)
+{
+    if ((nullptr != fanout.heldBack) &&
+        (false == client.queueIsFull()))
+    {
+        if (true == fanout.isBinary)
+        {
+            client.binary(fanout.heldBack);
+        }
+        else
+        {
+            client.text(fanout.heldBack);
+        }
+
+        /* The queued message holds its own reference now. */
+        releaseHeldBack(fanout);
+    }
+
+    return;
+}
+
+void WebSocketSrv::releaseHeldBack(Fanout& fanout)
+{
+    if (nullptr != fanout.heldBack)
+    {
+        (*fanout.heldBack)--;
+        fanout.heldBack = nullptr;
+    }
+
+    return;
+}
+
+void WebSocketSrv::processHeldBack()
+{
+    uint8_t index = 0U;
+
+    if (nullptr == m_fanoutMutex)
+    {
+        return;
+    }
+
+    (void)xSemaphoreTake(m_fanoutMutex, portMAX_DELAY);
+
+    for(index = 0U; index < MAX_CLIENTS; ++index)
+    {
+        Fanout& fanout = m_fanouts[index];
+
+        if ((true == fanout.isUsed) &&
+            (nullptr != fanout.heldBack))
+        {
+            AsyncWebSocketClient* client = m_webSocket.client(fanout.clientId);
+
+            if (nullptr == client)
+            {
+                releaseHeldBack(fanout);
+            }
+            else
+            {
+                sendHeldBack(*client, fanout);
+            }
+        }
+    }
+
+    m_webSocket._cleanBuffers();
+
+    (void)xSemaphoreGive(m_fanoutMutex);
+
+    return;
+}
+
+void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, char* msg, size_t msgLen)
+{
+    size_t  begin   = 0U;
+    size_t  end     = 0U;
+    uint8_t count   = 0U;
+
+    if ((nullptr == server) ||
+        (nullptr == client) ||
+        (nullptr == msg) ||
+        (0 == msgLen))
+    {
+        return;
+    }
+
+    /* Batch of commands? */
+    while((msgLen > end) && (BATCH_DELIMITER != msg[end]))
+    {
+        ++end;
+    }
+
+    if (msgLen <= end)
+    {
+        handleCmd(server, client, msg, msgLen);
+    }
+    else
+    {
+        m_isBatch = true;
+        m_batchRsp.clear();
+
+        while((msgLen > begin) && (MAX_BATCH_CMDS > count))
+        {
+            end = begin;
+            while((msgLen > end) && (BATCH_DELIMITER != msg[end]))
+            {
+                ++end;
+            }
+
+            unsigned int rspLen = m_batchRsp.length();
+
+            /* Terminate the command in-place. */
+            msg[end] = '\0';
+
+            handleCmd(server, client, &msg[begin], end - begin);
+            ++count;
+
+            /* Every command needs a response, because the client assigns
+             * the responses by their order.
+             */
+            if (rspLen == m_batchRsp.length())
+            {
+                sendResponse(server, client, "NACK");
+            }
+
+            begin = end + 1U;
+        }
+
+        if (msgLen > begin)
+        {
+            sendResponse(server, client, "NACK;\"Too many commands.\"");
+        }
+
+        m_isBatch = false;
+        server->text(client->id(), m_batchRsp);
+        m_batchRsp.clear();
+    }
+
+    return;
+}
+
+bool WebSocketSrv::buildCmdTable()
+{
+    uint32_t    seed        = 0U;
+    bool        isPerfect   = false;
+
+    while((false == isPerfect) && (MAX_CMD_HASH_SEEDS > seed))
+    {
+        uint8_t index = 0U;
+
+        memset(m_cmdTable, CMD_TABLE_EMPTY, sizeof(m_cmdTable));
+        isPerfect = true;
+
+        while((true == isPerfect) && (UTIL_ARRAY_NUM(gWsCommands) > index))
+        {
+            const String&   name    = gWsCommands[index]->getCmd();
+            uint32_t        hash    = hashCmdName(name.c_str(), name.length(), seed) & (CMD_TABLE_SIZE - 1U);
+
+            /* Collision? */
+            if (CMD_TABLE_EMPTY != m_cmdTable[hash])
+            {
+                isPerfect = false;
+            }
+            else
+            {
+                m_cmdTable[hash] = index;
+            }
+
+            ++index;
+        }
+
+        if (false == isPerfect)
+        {
+            ++seed;
+        }
+    }
+
+    m_cmdHashSeed       = seed;
+    m_isCmdTableValid   = isPerfect;
+
+    return isPerfect;
+}
+
+WsCmd* WebSocketSrv::findCmd(const char* name, size_t nameLen) const
+{
+    WsCmd* wsCmd = nullptr;
+
+    if (true == m_isCmdTableValid)
+    {
+        uint32_t    hash    = hashCmdName(name, nameLen, m_cmdHashSeed) & (CMD_TABLE_SIZE - 1U);
+        uint8_t     index   = m_cmdTable[hash];
+
+        if (CMD_TABLE_EMPTY != index)
+        {
+            wsCmd = gWsCommands[index];
+        }
+    }
+    else
+    {
+        uint8_t index = 0U;
+
+        while((nullptr == wsCmd) && (UTIL_ARRAY_NUM(gWsCommands) > index))
+        {
+            const String& cmdName = gWsCommands[index]->getCmd();
+
+            if ((nameLen == cmdName.length()) &&
+                (0 == memcmp(name, cmdName.c_str(), nameLen)))
+            {
+                wsCmd = gWsCommands[index];
+            }
+
+            ++index;
+        }
+    }
+
+    /* A unknown name may hash to a used entry, therefore verify it. */
+    if (nullptr != wsCmd)
+    {
+        const String& cmdName = wsCmd->getCmd();
+
+        if ((nameLen != cmdName.length()) ||
+            (0 != memcmp(name, cmdName.c_str(), nameLen)))
+        {
+            wsCmd = nullptr;
+        }
+    }
+
+    return wsCmd;
+}
+
+void WebSocketSrv::handleCmd(AsyncWebSocket* server, AsyncWebSocketClient* client, char* msg, size_t msgLen)
 {
     size_t      msgIndex    = 0U;
-    String      cmd;
-    String      par;
+    size_t      cmdBegin    = 0U;
     WsCmd*      wsCmd       = nullptr;
     const char  DELIMITER   = ';';
 
@@ -304,32 +1023,21 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
     }
 
     /* Get command string */
+    cmdBegin = msgIndex;
     while((msgLen > msgIndex) && (DELIMITER != msg[msgIndex]))
     {
-        cmd += msg[msgIndex];
         ++msgIndex;
     }
 
     /* Command string not empty? */
-    if (0 < cmd.length())
+    if (cmdBegin < msgIndex)
     {
-        uint8_t index = 0U;
-
-        /* Find command object */
-        while((nullptr == wsCmd) && (index < UTIL_ARRAY_NUM(gWsCommands)))
-        {
-            if (cmd == gWsCommands[index]->getCmd())
-            {
-                wsCmd = gWsCommands[index];
-            }
-
-            ++index;
-        }
+        wsCmd = findCmd(&msg[cmdBegin], msgIndex - cmdBegin);
 
         /* Command not found? */
         if (nullptr == wsCmd)
         {
-            client->text("NACK;\"Command unknown.\"");
+            sendResponse(server, client, "NACK;\"Command unknown.\"");
         }
         else
         {
@@ -337,25 +1045,29 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
             if ((msgLen > msgIndex) &&
                 (DELIMITER == msg[msgIndex]))
             {
+                size_t parBegin = 0U;
+
                 /* Overstep delimiter */
                 ++msgIndex;
+                parBegin = msgIndex;
 
+                /* The parameters are terminated in-place and passed
+                 * directly from the message buffer.
+                 */
                 while(msgLen > msgIndex)
                 {
                     if (DELIMITER == msg[msgIndex])
                     {
-                        wsCmd->setPar(par.c_str());
-                        par.clear();
-                    }
-                    else
-                    {
-                        par += msg[msgIndex];
+                        msg[msgIndex] = '\0';
+                        wsCmd->setPar(&msg[parBegin]);
+                        parBegin = msgIndex + 1U;
                     }
 
                     ++msgIndex;
                 }
 
-                wsCmd->setPar(par.c_str());
+                /* The last parameter is terminated by the caller. */
+                wsCmd->setPar(&msg[parBegin]);
             }
 
             /* Execute command */
@@ -366,6 +1078,107 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
     return;
 }
 
+void WebSocketSrv::handleBinMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen)
+{
+    size_t  rspLen  = 0U;
+
+    if ((nullptr == server) ||
+        (nullptr == client) ||
+        (nullptr == msg) ||
+        (0 == msgLen))
+    {
+        return;
+    }
+
+    switch(msg[0])
+    {
+    case BIN_CMD_GETDISP:
+        rspLen = handleBinGetDisp(&msg[1], msgLen - 1U);
+        break;
+
+    case BIN_CMD_BRIGHTNESS:
+        rspLen = handleBinBrightness(&msg[1], msgLen - 1U);
+        break;
+
+    default:
+        rspLen = BIN_RSP_HEADER_SIZE;
+        m_binRsp[1] = BIN_STATUS_NACK;
+        break;
+    }
+
+    m_binRsp[0] = msg[0];
+
+    client->binary(m_binRsp, rspLen);
+
+    return;
+}
+
+size_t WebSocketSrv::handleBinGetDisp(const uint8_t* par, size_t parLen)
+{
+    size_t  rspLen  = BIN_RSP_HEADER_SIZE;
+
+    UTIL_NOT_USED(par);
+
+    if (0U != parLen)
+    {
+        m_binRsp[1] = BIN_STATUS_NACK;
+    }
+    else
+    {
+        uint32_t    framebuffer[DisplayMgr::FRAME_PIXEL_COUNT];
+        uint8_t     slotId      = DisplayMgr::SLOT_ID_INVALID;
+        uint32_t    index       = 0U;
+
+        DisplayMgr::getInstance().getFBCopy(framebuffer, UTIL_ARRAY_NUM(framebuffer), &slotId);
+
+        m_binRsp[1]         = BIN_STATUS_ACK;
+        m_binRsp[rspLen]    = slotId;
+        ++rspLen;
+
+        for(index = 0U; index < UTIL_ARRAY_NUM(framebuffer); ++index)
+        {
+            m_binRsp[rspLen + 0U] = static_cast<uint8_t>((framebuffer[index] >> 16U) & 0xFFU);
+            m_binRsp[rspLen + 1U] = static_cast<uint8_t>((framebuffer[index] >>  8U) & 0xFFU);
+            m_binRsp[rspLen + 2U] = static_cast<uint8_t>((framebuffer[index] >>  0U) & 0xFFU);
+            rspLen += 3U;
+        }
+    }
+
+    return rspLen;
+}
+
+size_t WebSocketSrv::handleBinBrightness(const uint8_t* par, size_t parLen)
+{
+    size_t      rspLen      = BIN_RSP_HEADER_SIZE;
+    DisplayMgr& displayMgr  = DisplayMgr::getInstance();
+
+    if ((2U < parLen) ||
+        ((2U == parLen) && (1U < par[1])))
+    {
+        m_binRsp[1] = BIN_STATUS_NACK;
+    }
+    else
+    {
+        if (1U <= parLen)
+        {
+            displayMgr.setBrightness(par[0]);
+        }
+
+        if (2U == parLen)
+        {
+            displayMgr.setAutoBrightnessAdjustment(0U != par[1]);
+        }
+
+        m_binRsp[1]         = BIN_STATUS_ACK;
+        m_binRsp[rspLen]    = displayMgr.getBrightness();
+        ++rspLen;
+        m_binRsp[rspLen]    = (true == displayMgr.getAutoBrightnessAdjustment()) ? 1U : 0U;
+        ++rspLen;
+    }
+
+    return rspLen;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -373,3 +1186,31 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Calculate the hash of a command name with FNV-1a. The seed is mixed into
+ * the offset basis, which allows to search for a perfect hash.
+ *
+ * @param[in] name      Command name (not '\0' terminated)
+ * @param[in] nameLen   Command name length
+ * @param[in] seed      Hash seed
+ *
+ * @return Hash value
+ */
+static uint32_t hashCmdName(const char* name, size_t nameLen, uint32_t seed)
+{
+    const uint32_t  FNV_PRIME   = 16777619U;
+    uint32_t        hash        = 2166136261U ^ seed;
+    size_t          index       = 0U;
+
+    for(index = 0U; index < nameLen; ++index)
+    {
+        hash ^= static_cast<uint8_t>(name[index]);
+        hash *= FNV_PRIME;
+    }
+
+    /* Fold the upper bits in, because only the lower bits select the entry. */
+    hash ^= hash >> 16U;
+
+    return hash;
+}
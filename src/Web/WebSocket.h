@@ -48,6 +48,7 @@
 #include <Print.h>
 
 #include "WebConfig.h"
+#include "DisplayMgr.h"
 
 /******************************************************************************
  * Macros
@@ -57,8 +58,32 @@
  * Types and Classes
  *****************************************************************************/
 
+class WsCmd;
+
 /**
  * Websocket server
+ *
+ * A text message contains a single command or a batch of commands, which
+ * are separated by a line feed. The responses of a batch are sent in a
+ * single text message, separated by a line feed too.
+ *
+ * A binary message contains a compact encoded command for high rate usage:
+ * - Byte 0: Binary command id
+ * - Followed by the command parameters.
+ *
+ * The binary response contains:
+ * - Byte 0: Binary command id
+ * - Byte 1: Status (BIN_STATUS_ACK or BIN_STATUS_NACK)
+ * - Followed by the command specific response data.
+ *
+ * Text messages are tokenized in-place in the received message buffer and
+ * the command is looked up by a perfect hash of its name, which is
+ * determined once during initialization.
+ *
+ * The commands are not executed in the AsyncTCP context. The received
+ * messages are posted to a bounded queue and executed by a dedicated
+ * executor task, which replies asynchronously. If a client has too many
+ * pending messages or the queue is full, the message is rejected.
  */
 class WebSocketSrv : public Print
 {
@@ -83,15 +108,178 @@ public:
      */
     void init(AsyncWebServer& srv);
 
+    /**
+     * Process the websocket server, e.g. stream the display content to the
+     * subscribed clients. Call this periodically.
+     */
+    void process();
+
+    /**
+     * Can all clients receive further messages?
+     *
+     * @return If all clients can receive, it will return true otherwise false.
+     */
+    bool availableForWriteAll()
+    {
+        return m_webSocket.availableForWriteAll();
+    }
+
+    /**
+     * Get the number of connected clients.
+     *
+     * @return Number of connected clients
+     */
+    uint32_t getClientCount() const;
+
+    /**
+     * Send the response of a command to the client. During a batch, the
+     * response is collected and sent with the others of the batch.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     * @param[in] rsp       Response
+     */
+    void sendResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const String& rsp);
+
+    /**
+     * Broadcast a message to all clients. The message is copied once into a
+     * shared, reference counted buffer, which is queued to every client.
+     * If the queue of a client is full, the message is held back for it.
+     * A further message replaces the held back one, so a slow client loses
+     * the oldest messages instead of consuming more heap.
+     *
+     * @param[in] data      Message data
+     * @param[in] size      Message size in bytes
+     * @param[in] isBinary  Send it as binary message, otherwise as text message.
+     *
+     * @return If the message is queued or held back for at least one client, it will return true otherwise false.
+     */
+    bool broadcast(const uint8_t* data, size_t size, bool isBinary);
+
+    /**
+     * Binary command ids. They start at 0x80 to distinguish the responses
+     * from the binary frames of the display streamer.
+     */
+    enum BinCmdId
+    {
+        BIN_CMD_GETDISP     = 0x80, /**< Get display content as RGB888 */
+        BIN_CMD_BRIGHTNESS  = 0x81  /**< Get/Set brightness */
+    };
+
+    /**
+     * Binary response status.
+     */
+    enum BinStatus
+    {
+        BIN_STATUS_ACK  = 0,    /**< Successful */
+        BIN_STATUS_NACK = 1     /**< Failed */
+    };
+
+    /** Delimiter of the commands in a batch. */
+    static const char       BATCH_DELIMITER     = '\n';
+
+    /** Max. number of commands in a batch. */
+    static const uint8_t    MAX_BATCH_CMDS      = 16U;
+
 private:
 
-    AsyncWebSocket  m_webSocket;    /**< Websocket */
+    /** Size of the binary response header in bytes. */
+    static const size_t     BIN_RSP_HEADER_SIZE = 2U;
+
+    /** Max. size of a binary response, which is the get display response. */
+    static const size_t     MAX_BIN_RSP_SIZE    = BIN_RSP_HEADER_SIZE + 1U + (DisplayMgr::FRAME_PIXEL_COUNT * 3U);
+
+    /** Max. number of messages in the executor queue. */
+    static const UBaseType_t    MSG_QUEUE_SIZE      = 8U;
+
+    /** Max. number of pending messages per client. */
+    static const uint8_t        MAX_PENDING_MSGS    = 2U;
+
+    /** Max. number of clients, whose pending messages are tracked. */
+    static const uint8_t        MAX_CLIENTS         = 8U;
+
+    /** Executor task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 6144U;
+
+    /** Executor task priority */
+    static const UBaseType_t    TASK_PRIORITY       = 1U;
+
+    /** Executor task runs on the application core, the AsyncTCP task runs on the other. */
+    static const BaseType_t     TASK_RUN_CORE       = 1;
+
+    /** Size of the command lookup table, must be a power of 2. */
+    static const uint8_t        CMD_TABLE_SIZE      = 64U;
+
+    /** Marks a unused entry in the command lookup table. */
+    static const uint8_t        CMD_TABLE_EMPTY     = UINT8_MAX;
+
+    /** Max. number of hash seeds, which are tried to find a perfect hash. */
+    static const uint32_t       MAX_CMD_HASH_SEEDS  = 256U;
+
+    /**
+     * A received message, which is waiting for execution.
+     */
+    struct Msg
+    {
+        uint32_t    clientId;   /**< Websocket client id */
+        bool        isBinary;   /**< Is it a binary message? */
+        uint8_t*    data;       /**< Message data, additional '\0' terminated */
+        size_t      len;        /**< Message length in bytes */
+    };
+
+    /**
+     * Broadcast state of a client.
+     */
+    struct Fanout
+    {
+        uint32_t                        clientId;   /**< Websocket client id */
+        bool                            isUsed;     /**< Is the entry used? */
+        bool                            isBinary;   /**< Is the held back message binary? */
+        AsyncWebSocketMessageBuffer*    heldBack;   /**< Held back broadcast message or nullptr */
+    };
+
+    /**
+     * Number of pending messages of a client.
+     */
+    struct Backlog
+    {
+        uint32_t    clientId;   /**< Websocket client id */
+        uint8_t     count;      /**< Number of pending messages, 0 means entry is unused */
+    };
+
+    AsyncWebSocket      m_webSocket;                    /**< Websocket */
+    bool                m_isBatch;                      /**< Is a batch of commands handled? */
+    String              m_batchRsp;                     /**< Collected responses of the batch */
+    uint8_t             m_binRsp[MAX_BIN_RSP_SIZE];     /**< Binary response buffer */
+    TaskHandle_t        m_taskHandle;                   /**< Executor task handle */
+    QueueHandle_t       m_msgQueue;                     /**< Queue with messages to execute */
+    SemaphoreHandle_t   m_mutex;                        /**< Mutex to protect the backlogs */
+    SemaphoreHandle_t   m_clientMutex;                  /**< Mutex to serialize the client access of the executor with the websocket events */
+    Backlog             m_backlogs[MAX_CLIENTS];        /**< Pending messages per client */
+    SemaphoreHandle_t   m_fanoutMutex;                  /**< Mutex to protect the broadcast states and buffers */
+    Fanout              m_fanouts[MAX_CLIENTS];         /**< Broadcast state per client */
+    uint8_t             m_cmdTable[CMD_TABLE_SIZE];     /**< Command index per hash, perfect hash table */
+    uint32_t            m_cmdHashSeed;                  /**< Seed of the perfect command hash */
+    bool                m_isCmdTableValid;              /**< Is a perfect command hash available? */
 
     /**
      * Constructs the websocket server.
      */
     WebSocketSrv() :
-        m_webSocket(WebConfig::WEBSOCKET_PATH)
+        m_webSocket(WebConfig::WEBSOCKET_PATH),
+        m_isBatch(false),
+        m_batchRsp(),
+        m_binRsp(),
+        m_taskHandle(nullptr),
+        m_msgQueue(nullptr),
+        m_mutex(nullptr),
+        m_clientMutex(nullptr),
+        m_backlogs(),
+        m_fanoutMutex(nullptr),
+        m_fanouts(),
+        m_cmdTable(),
+        m_cmdHashSeed(0U),
+        m_isCmdTableValid(false)
     {
     }
 
@@ -164,14 +352,150 @@ private:
     void onData(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsFrameInfo* info, const uint8_t* data, size_t len);
 
     /**
-     * Handle a websocket message.
+     * Handle a websocket message. The message is tokenized in-place, which
+     * means the delimiters are replaced by '\0'.
      *
      * @param[in] server    Websocket server
      * @param[in] client    Weboscket client
-     * @param[in] msg       Websocket message (not '\0' terminated)
+     * @param[in] msg       Websocket message ('\0' terminated after msgLen characters)
      * @param[in] msgLen    Websocket message length
      */
-    void handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const char* msg, size_t msgLen);
+    void handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, char* msg, size_t msgLen);
+
+    /**
+     * Build the command lookup table. A hash seed is searched, which maps
+     * every command name to a different table entry.
+     *
+     * @return If a perfect hash is found, it will return true otherwise false.
+     */
+    bool buildCmdTable();
+
+    /**
+     * Find the command by its name.
+     *
+     * @param[in] name      Command name (not '\0' terminated)
+     * @param[in] nameLen   Command name length
+     *
+     * @return Command or nullptr if not found.
+     */
+    WsCmd* findCmd(const char* name, size_t nameLen) const;
+
+    /**
+     * Start the command executor task.
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool startExecutor();
+
+    /**
+     * Command executor task, which executes the received messages.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void executorTask(void* parameters);
+
+    /**
+     * Post a received message to the executor queue.
+     * If the client has too many pending messages or the queue is full,
+     * the message is rejected with a NACK.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Weboscket client
+     * @param[in] msg       Websocket message
+     * @param[in] msgLen    Websocket message length
+     * @param[in] isBinary  Is it a binary message?
+     */
+    void postMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen, bool isBinary);
+
+    /**
+     * Execute a message from the executor queue.
+     *
+     * The client is looked up and the message is executed with the client
+     * mutex taken, because the executor runs outside the AsyncTCP task.
+     * Otherwise the client may be disconnected and destroyed meanwhile.
+     *
+     * @param[in] msg   Message
+     */
+    void executeMsg(const Msg& msg);
+
+    /**
+     * Get the backlog of a client. If the client has none yet and create
+     * is requested, a unused one will be assigned.
+     * The mutex must be taken by the caller.
+     *
+     * @param[in] clientId  Websocket client id
+     * @param[in] create    Assign a unused backlog if the client has none.
+     *
+     * @return Backlog or nullptr if not found.
+     */
+    Backlog* getBacklog(uint32_t clientId, bool create);
+
+    /**
+     * Send the held back broadcast message to the client, if its queue has
+     * space again. The fanout mutex must be taken by the caller.
+     *
+     * @param[in]       client  Websocket client
+     * @param[in,out]   fanout  Broadcast state of the client
+     */
+    void sendHeldBack(AsyncWebSocketClient& client, Fanout& fanout);
+
+    /**
+     * Release the held back broadcast message of a client without sending it.
+     * The fanout mutex must be taken by the caller.
+     *
+     * @param[in,out]   fanout  Broadcast state of the client
+     */
+    void releaseHeldBack(Fanout& fanout);
+
+    /**
+     * Send the held back broadcast messages to the clients, which can
+     * receive again.
+     */
+    void processHeldBack();
+
+    /**
+     * Handle a single command of a websocket message. The parameters are
+     * tokenized in-place and passed to the command without copying them.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Weboscket client
+     * @param[in] msg       Command with its parameters ('\0' terminated after msgLen characters)
+     * @param[in] msgLen    Command length
+     */
+    void handleCmd(AsyncWebSocket* server, AsyncWebSocketClient* client, char* msg, size_t msgLen);
+
+    /**
+     * Handle a binary websocket message.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Weboscket client
+     * @param[in] msg       Websocket message
+     * @param[in] msgLen    Websocket message length
+     */
+    void handleBinMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen);
+
+    /**
+     * Handle the binary get display command.
+     * Response data: slot id, followed by the pixels as RGB888.
+     *
+     * @param[in] par       Command parameters
+     * @param[in] parLen    Command parameter length
+     *
+     * @return Size of the binary response in bytes.
+     */
+    size_t handleBinGetDisp(const uint8_t* par, size_t parLen);
+
+    /**
+     * Handle the binary brightness command.
+     * Parameters: optional brightness, optional automatic brightness adjustment (0/1).
+     * Response data: brightness, automatic brightness adjustment (0/1).
+     *
+     * @param[in] par       Command parameters
+     * @param[in] parLen    Command parameter length
+     *
+     * @return Size of the binary response in bytes.
+     */
+    size_t handleBinBrightness(const uint8_t* par, size_t parLen);
 
     /**
      * Write single data byte to all clients.
@@ -182,7 +506,7 @@ private:
      */
     size_t write(uint8_t data) final
     {
-        m_webSocket.textAll(&data, 1);
+        (void)broadcast(&data, 1U, false);
         return 1;
     }
 
@@ -196,7 +520,7 @@ private:
      */
     size_t write(const uint8_t* buffer, size_t size) final
     {
-        m_webSocket.textAll(const_cast<uint8_t*>(buffer), size);
+        (void)broadcast(buffer, size, false);
         return size;
     }
 };
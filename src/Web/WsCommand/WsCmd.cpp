@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "WsCmd.h"
+#include "WebSocket.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -62,6 +63,13 @@
  * Protected Methods
  *****************************************************************************/
 
+void WsCmd::sendResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const String& rsp)
+{
+    WebSocketSrv::getInstance().sendResponse(server, client, rsp);
+
+    return;
+}
+
 /******************************************************************************
  * Private Methods
  *****************************************************************************/
@@ -102,6 +102,19 @@ public:
      */
     virtual void setPar(const char* par) = 0;
 
+protected:
+
+    /**
+     * Send the response to the client. If the command is part of a batch,
+     * the response is collected and sent together with the responses of
+     * the other commands.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     * @param[in] rsp       Response
+     */
+    void sendResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const String& rsp);
+
 private:
 
     String  m_cmd;  /**< Command */
@@ -0,0 +1,288 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to run the network benchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmdBenchmark.h"
+#include "WebConfig.h"
+
+#include <Logging.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void WsCmdBenchmark::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    /* Any error happended? */
+    if (true == m_isError)
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+    /* Echo? */
+    else if (CMD_ECHO == m_cmd)
+    {
+        String rsp = "ACK;";
+
+        rsp += m_echo;
+
+        sendResponse(server, client, rsp);
+    }
+    /* Get benchmark status? */
+    else if (CMD_STATUS == m_cmd)
+    {
+        if (false == NetBenchmark::getInstance().isRunning())
+        {
+            sendResponse(server, client, "ACK;0");
+        }
+        else
+        {
+            sendResponse(server, client, "ACK;1");
+        }
+    }
+    /* Start benchmark? */
+    else if (CMD_START == m_cmd)
+    {
+        /* The default path depends on the test. */
+        if (true == m_cfg.path.isEmpty())
+        {
+            if (NetBenchmark::TEST_WEBSOCKET == m_cfg.test)
+            {
+                m_cfg.path = WebConfig::WEBSOCKET_PATH;
+            }
+            else
+            {
+                m_cfg.path = NetBenchmark::DEFAULT_HTTP_PATH;
+            }
+        }
+
+        if (false == NetBenchmark::getInstance().start(m_cfg))
+        {
+            sendResponse(server, client, "NACK;\"Starting failed.\"");
+        }
+        else
+        {
+            sendResponse(server, client, "ACK;1");
+        }
+    }
+    /* Stop benchmark? */
+    else if (CMD_STOP == m_cmd)
+    {
+        NetBenchmark::getInstance().stop();
+        sendResponse(server, client, "ACK;0");
+    }
+    else
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+
+    m_isError   = false;
+    m_parCnt    = 0U;
+    m_cmd       = CMD_STATUS;
+    m_echo.clear();
+
+    setCfgDefault();
+
+    return;
+}
+
+void WsCmdBenchmark::setPar(const char* par)
+{
+    uint32_t value = 0U;
+
+    if (0U == m_parCnt)
+    {
+        if (0 == strcmp(par, "START"))
+        {
+            m_cmd = CMD_START;
+        }
+        else if (0 == strcmp(par, "STOP"))
+        {
+            m_cmd = CMD_STOP;
+        }
+        else if (0 == strcmp(par, "ECHO"))
+        {
+            m_cmd = CMD_ECHO;
+        }
+        else
+        {
+            m_isError = true;
+        }
+    }
+    else if (CMD_ECHO == m_cmd)
+    {
+        if (1U == m_parCnt)
+        {
+            m_echo = par;
+        }
+        else
+        {
+            m_isError = true;
+        }
+    }
+    else if (CMD_START == m_cmd)
+    {
+        switch(m_parCnt)
+        {
+        case 1U:
+            if ((0 == strcmp(par, "DEFAULT")) ||
+                (0 == strcmp(par, "HTTP")))
+            {
+                m_cfg.test = NetBenchmark::TEST_HTTP;
+            }
+            else if (0 == strcmp(par, "WS"))
+            {
+                m_cfg.test = NetBenchmark::TEST_WEBSOCKET;
+            }
+            else
+            {
+                m_isError = true;
+            }
+            break;
+
+        case 2U:
+            if (0 != strcmp(par, "DEFAULT"))
+            {
+                m_cfg.host = par;
+            }
+            break;
+
+        case 3U:
+            setUInt(par, WebConfig::WEBSERVER_PORT, UINT16_MAX, value);
+            m_cfg.port = static_cast<uint16_t>(value);
+            break;
+
+        case 4U:
+            if (0 != strcmp(par, "DEFAULT"))
+            {
+                m_cfg.path = par;
+            }
+            break;
+
+        case 5U:
+            setUInt(par, NetBenchmark::DEFAULT_REQUESTS, NetBenchmark::MAX_REQUESTS, value);
+            m_cfg.requests = static_cast<uint16_t>(value);
+            break;
+
+        case 6U:
+            setUInt(par, 1U, NetBenchmark::MAX_CLIENTS, value);
+            m_cfg.clients = static_cast<uint8_t>(value);
+            break;
+
+        default:
+            m_isError = true;
+            break;
+        }
+    }
+    else
+    {
+        m_isError = true;
+    }
+
+    ++m_parCnt;
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void WsCmdBenchmark::setCfgDefault()
+{
+    /* Default configuration measures the own webserver with a static file. */
+    m_cfg.test      = NetBenchmark::TEST_HTTP;
+    m_cfg.host.clear();
+    m_cfg.port      = WebConfig::WEBSERVER_PORT;
+    m_cfg.path.clear();
+    m_cfg.requests  = NetBenchmark::DEFAULT_REQUESTS;
+    m_cfg.clients   = 1U;
+}
+
+void WsCmdBenchmark::setUInt(const char* par, uint32_t defaultVal, uint32_t maxVal, uint32_t& value)
+{
+    if (0 == strcmp(par, "DEFAULT"))
+    {
+        value = defaultVal;
+    }
+    else if ((false == Util::strToUInt32(par, value)) ||
+             (0U == value) ||
+             (maxVal < value))
+    {
+        m_isError = true;
+    }
+    else
+    {
+        ;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
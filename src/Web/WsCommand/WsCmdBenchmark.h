@@ -0,0 +1,143 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to run the network benchmark
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __WSCMDBENCHMARK_H__
+#define __WSCMDBENCHMARK_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmd.h"
+#include "NetBenchmark.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Websocket command to start/stop the network benchmark. It provides the
+ * echo, which is used by the websocket benchmark too.
+ */
+class WsCmdBenchmark: public WsCmd
+{
+public:
+
+    /**
+     * Constructs the websocket command.
+     */
+    WsCmdBenchmark() :
+        WsCmd("BENCH"),
+        m_isError(false),
+        m_parCnt(0U),
+        m_cmd(CMD_STATUS),
+        m_cfg(),
+        m_echo()
+    {
+        setCfgDefault();
+    }
+
+    /**
+     * Destroys websocket command.
+     */
+    ~WsCmdBenchmark()
+    {
+    }
+
+    /**
+     * Execute command.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     */
+    void execute(AsyncWebSocket* server, AsyncWebSocketClient* client) final;
+
+    /**
+     * Set command parameter. Call this for each parameter, until executing it.
+     *
+     * @param[in] par   Parameter string
+     */
+    void setPar(const char* par) final;
+
+private:
+
+    /** Benchmark commands */
+    enum Cmd
+    {
+        CMD_STATUS = 0, /**< Get benchmark status */
+        CMD_START,      /**< Start benchmark */
+        CMD_STOP,       /**< Stop benchmark */
+        CMD_ECHO        /**< Echo the parameter */
+    };
+
+    bool                    m_isError;  /**< Any error happened during parameter reception? */
+    uint8_t                 m_parCnt;   /**< Number of received parameters */
+    Cmd                     m_cmd;      /**< Benchmark command */
+    NetBenchmark::Config    m_cfg;      /**< Benchmark configuration */
+    String                  m_echo;     /**< Echo payload */
+
+    WsCmdBenchmark(const WsCmdBenchmark& cmd);
+    WsCmdBenchmark& operator=(const WsCmdBenchmark& cmd);
+
+    /**
+     * Set benchmark default configuration.
+     */
+    void setCfgDefault();
+
+    /**
+     * Set a unsigned numeric configuration value.
+     *
+     * @param[in]   par         Parameter string
+     * @param[in]   defaultVal  Value used for DEFAULT
+     * @param[in]   maxVal      Max. valid value
+     * @param[out]  value       Value
+     */
+    void setUInt(const char* par, uint32_t defaultVal, uint32_t maxVal, uint32_t& value);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __WSCMDBENCHMARK_H__ */
+
+/** @} */
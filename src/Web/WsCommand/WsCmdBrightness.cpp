@@ -34,6 +34,7 @@
  *****************************************************************************/
 #include "WsCmdBrightness.h"
 #include "DisplayMgr.h"
+#include "SettingCoalescer.h"
 
 #include <Util.h>
 #include <Logging.h>
@@ -73,33 +74,45 @@ void WsCmdBrightness::execute(AsyncWebSocket* server, AsyncWebSocketClient* clie
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
-        String      rsp         = "ACK";
-        const char  DELIMITER   = ';';
-
-        if (1U == m_parCnt)
+        String              rsp         = "ACK";
+        const char          DELIMITER   = ';';
+        SettingCoalescer&   coalescer   = SettingCoalescer::getInstance();
+        uint8_t             brightness  = 0U;
+        bool                isEnabled   = false;
+
+        /* The settings are applied coalesced, therefore the requested
+         * values are responded.
+         */
+        if (1U <= m_parCnt)
         {
-            DisplayMgr::getInstance().setBrightness(m_brightness);
+            coalescer.setBrightness(m_brightness);
+            brightness = m_brightness;
         }
-        else if (2U == m_parCnt)
+        else
+        {
+            brightness = DisplayMgr::getInstance().getBrightness();
+        }
+
+        if (2U == m_parCnt)
         {
-            DisplayMgr::getInstance().setBrightness(m_brightness);
-            DisplayMgr::getInstance().setAutoBrightnessAdjustment(m_isEnabled);
+            coalescer.setAutoBrightnessAdjustment(m_isEnabled);
+            isEnabled = m_isEnabled;
         }
         else
         {
-            ;
+            isEnabled = DisplayMgr::getInstance().getAutoBrightnessAdjustment();
         }
 
         rsp += DELIMITER;
-        rsp += DisplayMgr::getInstance().getBrightness();
+        rsp += brightness;
         rsp += DELIMITER;
-        rsp += (true == DisplayMgr::getInstance().getAutoBrightnessAdjustment()) ? 1 : 0;
+        rsp += (true == isEnabled) ? 1 : 0;
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
@@ -113,7 +126,7 @@ void WsCmdBrightness::setPar(const char* par)
     switch(m_parCnt)
     {
     case 0:
-        if (false == Util::strToUInt8(String(par), m_brightness))
+        if (false == Util::strToUInt8(par, m_brightness))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
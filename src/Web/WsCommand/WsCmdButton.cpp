@@ -72,7 +72,7 @@ void WsCmdButton::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
@@ -80,7 +80,7 @@ void WsCmdButton::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
 
         DisplayMgr::getInstance().activateNextSlot();
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
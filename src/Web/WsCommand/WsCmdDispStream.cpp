@@ -0,0 +1,193 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to subscribe to the display content stream
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmdDispStream.h"
+
+#include <Board.h>
+#include <Util.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void WsCmdDispStream::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    /* Any error happended? */
+    if ((true == m_isError) ||
+        (0U == m_parCnt))
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+    else if (false == m_isEnabled)
+    {
+        DisplayStreamer::getInstance().unsubscribe(client->id());
+        sendResponse(server, client, "ACK");
+    }
+    else if (false == DisplayStreamer::getInstance().subscribe(client->id(), m_format, m_fps))
+    {
+        sendResponse(server, client, "NACK;\"Too many subscribers.\"");
+    }
+    else
+    {
+        /* The client needs the matrix size to render the pixel index. */
+        String      rsp         = "ACK";
+        const char  DELIMITER   = ';';
+
+        rsp += DELIMITER;
+        rsp += Board::LedMatrix::width;
+        rsp += DELIMITER;
+        rsp += Board::LedMatrix::height;
+
+        sendResponse(server, client, rsp);
+    }
+
+    m_isError   = false;
+    m_parCnt    = 0U;
+    m_isEnabled = false;
+    m_format    = DisplayStreamer::PIXEL_FORMAT_RGB888;
+    m_fps       = DisplayStreamer::DEFAULT_FPS;
+
+    return;
+}
+
+void WsCmdDispStream::setPar(const char* par)
+{
+    uint8_t value = 0U;
+
+    switch(m_parCnt)
+    {
+    case 0:
+        if (0 == strcmp(par, "0"))
+        {
+            m_isEnabled = false;
+        }
+        else if (0 == strcmp(par, "1"))
+        {
+            m_isEnabled = true;
+        }
+        else
+        {
+            m_isError = true;
+        }
+        break;
+
+    case 1:
+        if (false == Util::strToUInt8(par, value))
+        {
+            LOG_ERROR("Conversion failed: %s", par);
+            m_isError = true;
+        }
+        else if (DisplayStreamer::PIXEL_FORMAT_RGB888 == value)
+        {
+            m_format = DisplayStreamer::PIXEL_FORMAT_RGB888;
+        }
+        else if (DisplayStreamer::PIXEL_FORMAT_RGB565 == value)
+        {
+            m_format = DisplayStreamer::PIXEL_FORMAT_RGB565;
+        }
+        else
+        {
+            m_isError = true;
+        }
+        break;
+
+    case 2:
+        if (false == Util::strToUInt8(par, value))
+        {
+            LOG_ERROR("Conversion failed: %s", par);
+            m_isError = true;
+        }
+        else if ((DisplayStreamer::MIN_FPS > value) ||
+                 (DisplayStreamer::MAX_FPS < value))
+        {
+            m_isError = true;
+        }
+        else
+        {
+            m_fps = value;
+        }
+        break;
+
+    default:
+        m_isError = true;
+        break;
+    }
+
+    ++m_parCnt;
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -72,7 +72,7 @@ void WsCmdEffect::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
@@ -87,7 +87,7 @@ void WsCmdEffect::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
         rsp += DELIMITER;
         rsp += DisplayMgr::getInstance().getFadeEffect();
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
@@ -99,7 +99,7 @@ void WsCmdEffect::setPar(const char* par)
 {
     if (0U == m_parCnt)
     {
-        if (false == Util::strToUInt8(String(par), m_fadeEffect))
+        if (false == Util::strToUInt8(par, m_fadeEffect))
         {
             m_isError = true;
         }
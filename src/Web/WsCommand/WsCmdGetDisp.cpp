@@ -36,6 +36,7 @@
 #include "DisplayMgr.h"
 
 #include <Util.h>
+#include <MemPolicy.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -69,31 +70,51 @@ void WsCmdGetDisp::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
         return;
     }
 
+    /* The framebuffer copy is too large for the stack of bigger LED matrices. */
+    const size_t    PIXEL_COUNT = Board::LedMatrix::width * Board::LedMatrix::height;
+    uint32_t*       framebuffer = nullptr;
+
+    if (false == m_isError)
+    {
+        framebuffer = static_cast<uint32_t*>(MemPolicy::allocate(MemPolicy::REGION_LARGE, PIXEL_COUNT * sizeof(uint32_t)));
+    }
+
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+    else if (nullptr == framebuffer)
+    {
+        sendResponse(server, client, "NACK;\"Out of memory.\"");
     }
     else
     {
         uint32_t    index       = 0U;
         String      rsp         = "ACK";
         const char  DELIMITER   = ';';
-        uint32_t    framebuffer[Board::LedMatrix::width * Board::LedMatrix::height];
         uint8_t     slotId      = DisplayMgr::SLOT_ID_INVALID;
+        char        hex[9];     /* Contains a 32-bit value in hex */
 
-        DisplayMgr::getInstance().getFBCopy(framebuffer, UTIL_ARRAY_NUM(framebuffer), &slotId);
+        DisplayMgr::getInstance().getFBCopy(framebuffer, PIXEL_COUNT, &slotId);
+
+        /* Worst case: slot id, and per pixel a delimiter with 8 hex digits. */
+        (void)rsp.reserve(rsp.length() + 4U + PIXEL_COUNT * sizeof(hex));
 
         rsp += DELIMITER;
         rsp += slotId;
 
-        for(index = 0U; index <  UTIL_ARRAY_NUM(framebuffer); ++index)
+        for(index = 0U; index < PIXEL_COUNT; ++index)
         {
             rsp += DELIMITER;
-            rsp += Util::uint32ToHex(framebuffer[index]);
+            (void)Util::uint32ToHex(framebuffer[index], hex, sizeof(hex));
+            rsp += hex;
         }
 
-        server->text(client->id(), rsp);
+        MemPolicy::release(framebuffer);
+        framebuffer = nullptr;
+
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
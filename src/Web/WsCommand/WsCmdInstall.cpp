@@ -70,38 +70,74 @@ void WsCmdInstall::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     }
 
     /* Any error happended? */
-    if (true == m_isError)
+    if ((true == m_isError) ||
+        (0U == m_pluginCnt))
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
         String              rsp         = "ACK";
         const char          DELIMITER   = ';';
-        IPluginMaintenance* plugin      = PluginMgr::getInstance().install(m_pluginName);
+        PluginMgr&          pluginMgr   = PluginMgr::getInstance();
+        IPluginMaintenance* plugins[MAX_PLUGINS];
+        uint8_t             installed   = 0U;
+        uint8_t             index       = 0U;
 
-        if (nullptr == plugin)
+        /* All plugins are installed in one batch and the installation is
+         * saved only once to persistent memory.
+         */
+        pluginMgr.beginBatch();
+
+        for(index = 0U; index < m_pluginCnt; ++index)
+        {
+            plugins[index] = pluginMgr.install(m_pluginNames[index]);
+
+            if (nullptr != plugins[index])
+            {
+                plugins[index]->enable();
+                ++installed;
+            }
+        }
+
+        pluginMgr.endBatch(0U < installed);
+
+        if (0U == installed)
         {
             rsp = "NACK;\"Plugin not found.\"";
         }
         else
         {
-            rsp += DELIMITER;
-            rsp += DisplayMgr::getInstance().getSlotIdByPluginUID(plugin->getUID());
-            rsp += DELIMITER;
-            rsp += plugin->getUID();
-
-            plugin->enable();
-
-            /* Save current installed plugins to persistent memory. */
-            PluginMgr::getInstance().save();
+            for(index = 0U; index < m_pluginCnt; ++index)
+            {
+                rsp += DELIMITER;
+
+                /* A not installed plugin is reported with a invalid slot id and UID 0. */
+                if (nullptr == plugins[index])
+                {
+                    rsp += DisplayMgr::SLOT_ID_INVALID;
+                    rsp += DELIMITER;
+                    rsp += 0U;
+                }
+                else
+                {
+                    rsp += DisplayMgr::getInstance().getSlotIdByPluginUID(plugins[index]->getUID());
+                    rsp += DELIMITER;
+                    rsp += plugins[index]->getUID();
+                }
+            }
         }
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
-    m_pluginName.clear();
+
+    while(0U < m_pluginCnt)
+    {
+        --m_pluginCnt;
+        m_pluginNames[m_pluginCnt].clear();
+    }
 
     return;
 }
@@ -109,13 +145,17 @@ void WsCmdInstall::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
 void WsCmdInstall::setPar(const char* par)
 {
     /* The name of the plugin is enclosed in "". */
-    if ((0U == m_pluginName.length()) &&
+    if ((MAX_PLUGINS > m_pluginCnt) &&
         (2U <= strlen(par)))
     {
-        m_pluginName = par;
+        String& pluginName = m_pluginNames[m_pluginCnt];
+
+        pluginName = par;
 
         /* Remove the enclosing "" */
-        m_pluginName = m_pluginName.substring(1, m_pluginName.length() - 1);
+        pluginName = pluginName.substring(1, pluginName.length() - 1);
+
+        ++m_pluginCnt;
     }
     else
     {
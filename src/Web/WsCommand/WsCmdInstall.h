@@ -54,7 +54,7 @@
  *****************************************************************************/
 
 /**
- * Websocket command to install a plugin.
+ * Websocket command to install one or several plugins.
  */
 class WsCmdInstall: public WsCmd
 {
@@ -66,7 +66,8 @@ public:
     WsCmdInstall() :
         WsCmd("INSTALL"),
         m_isError(false),
-        m_pluginName()
+        m_pluginCnt(0U),
+        m_pluginNames()
     {
     }
 
@@ -94,8 +95,12 @@ public:
 
 private:
 
-    bool    m_isError;      /**< Any error happened during parameter reception? */
-    String  m_pluginName;   /**< Plugin name, which shall be installed. */
+    /** Max. number of plugins, which can be installed by one command. */
+    static const uint8_t    MAX_PLUGINS = 8U;
+
+    bool    m_isError;                  /**< Any error happened during parameter reception? */
+    uint8_t m_pluginCnt;                /**< Number of received plugin names */
+    String  m_pluginNames[MAX_PLUGINS]; /**< Names of the plugins, which shall be installed. */
 
     WsCmdInstall(const WsCmdInstall& cmd);
     WsCmdInstall& operator=(const WsCmdInstall& cmd);
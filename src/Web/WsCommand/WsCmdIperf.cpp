@@ -72,7 +72,7 @@ void WsCmdIperf::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     /* Get iperf status? */
     else if (CMD_STATUS == m_cmd)
@@ -91,14 +91,14 @@ void WsCmdIperf::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
             rsp += "1";
         }
         
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
     /* Start iperf? */
     else if (CMD_START == m_cmd)
     {
         if (ESP_OK != iperf_start(&m_cfg))
         {
-            server->text(client->id(), "NACK;\"Starting failed.\"");
+            sendResponse(server, client, "NACK;\"Starting failed.\"");
         }
         else
         {
@@ -108,7 +108,7 @@ void WsCmdIperf::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
                 m_cfg.sip & 0xffU, (m_cfg.sip >> 8) & 0xffU, (m_cfg.sip >> 16) & 0xffU, (m_cfg.sip >>24) & 0xffU, m_cfg.sport,
                 m_cfg.interval, m_cfg.time);
 
-            server->text(client->id(), "ACK;1");
+            sendResponse(server, client, "ACK;1");
         }
     }
     /* Stop iperf? */
@@ -116,17 +116,17 @@ void WsCmdIperf::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     {
         if (ESP_OK != iperf_stop())
         {
-            server->text(client->id(), "NACK;\"Stopping failed.\"");
+            sendResponse(server, client, "NACK;\"Stopping failed.\"");
         }
         else
         {
             LOG_INFO("iperf stopped.");
-            server->text(client->id(), "ACK;0");
+            sendResponse(server, client, "ACK;0");
         }
     }
     else
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");        
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
 
     m_isError   = false;
@@ -184,7 +184,7 @@ void WsCmdIperf::setPar(const char* par)
             }
             else
             {
-                bool status = Util::strToUInt32(String(par), m_cfg.interval);
+                bool status = Util::strToUInt32(par, m_cfg.interval);
 
                 if (false == status)
                 {
@@ -200,7 +200,7 @@ void WsCmdIperf::setPar(const char* par)
             }
             else
             {
-                bool status = Util::strToUInt32(String(par), m_cfg.time);
+                bool status = Util::strToUInt32(par, m_cfg.time);
 
                 if (false == status)
                 {
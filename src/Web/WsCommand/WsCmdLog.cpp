@@ -72,7 +72,7 @@ void WsCmdLog::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
@@ -107,7 +107,7 @@ void WsCmdLog::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
             rsp += "1";
         }
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_cnt       = 0U;
@@ -0,0 +1,192 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to get/set the log level of a log module
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmdLogLevel.h"
+#include "WebSocket.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Module name, which addresses the global log level. */
+const char* WsCmdLogLevel::GLOBAL_MODULE    = "*";
+
+/* Level parameter, which lets a log module follow the global log level. */
+const char* WsCmdLogLevel::GLOBAL_LEVEL     = "g";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void WsCmdLogLevel::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    /* Any error happended? The global log level can't follow itself. */
+    if ((true == m_isError) ||
+        (0U == m_cnt) ||
+        ((m_module == GLOBAL_MODULE) && (1U < m_cnt) && (true == m_isGlobal)))
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+    else if (m_module == GLOBAL_MODULE)
+    {
+        String      rsp         = "ACK";
+        const char  DELIMITER   = ';';
+
+        if (1U < m_cnt)
+        {
+            Logging::getInstance().setLogLevel(static_cast<Logging::LogLevel>(m_level));
+        }
+
+        rsp += DELIMITER;
+        rsp += static_cast<int>(Logging::getInstance().getLogLevel());
+        rsp += DELIMITER;
+        rsp += "1";
+
+        sendResponse(server, client, rsp);
+    }
+    else
+    {
+        Logging::Module* module = Logging::getInstance().getModule(m_module.c_str());
+
+        if (nullptr == module)
+        {
+            sendResponse(server, client, "NACK;\"Unknown module.\"");
+        }
+        else
+        {
+            String      rsp         = "ACK";
+            const char  DELIMITER   = ';';
+
+            if (1U < m_cnt)
+            {
+                if (true == m_isGlobal)
+                {
+                    module->useGlobalLogLevel();
+                }
+                else
+                {
+                    module->setLogLevel(static_cast<Logging::LogLevel>(m_level));
+                }
+            }
+
+            rsp += DELIMITER;
+            rsp += static_cast<int>(module->getLogLevel());
+            rsp += DELIMITER;
+            rsp += (true == module->isGlobalLogLevel()) ? "1" : "0";
+
+            sendResponse(server, client, rsp);
+        }
+    }
+
+    m_cnt       = 0U;
+    m_isError   = false;
+
+    return;
+}
+
+void WsCmdLogLevel::setPar(const char* par)
+{
+    if (0U == m_cnt)
+    {
+        m_module = par;
+        ++m_cnt;
+    }
+    else if (1U == m_cnt)
+    {
+        m_isGlobal = false;
+
+        if (0 == strcmp(par, GLOBAL_LEVEL))
+        {
+            m_isGlobal = true;
+        }
+        else if ((1U == strlen(par)) &&
+                 ('0' <= par[0]) &&
+                 (('0' + Logging::LOGLEVEL_FATAL) >= par[0]))
+        {
+            m_level = par[0] - '0';
+        }
+        else
+        {
+            m_isError = true;
+        }
+
+        ++m_cnt;
+    }
+    else
+    {
+        m_isError = true;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
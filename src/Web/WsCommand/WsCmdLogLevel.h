@@ -0,0 +1,123 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to get/set the log level of a log module
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __WSCMDLOGLEVEL_H__
+#define __WSCMDLOGLEVEL_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmd.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Websocket command to get/set the log level of a log module or the global
+ * log level.
+ */
+class WsCmdLogLevel: public WsCmd
+{
+public:
+
+    /**
+     * Constructs the websocket command.
+     */
+    WsCmdLogLevel() :
+        WsCmd("LOGLEVEL"),
+        m_isError(false),
+        m_cnt(0U),
+        m_module(),
+        m_level(0),
+        m_isGlobal(false)
+    {
+    }
+
+    /**
+     * Destroys websocket command.
+     */
+    ~WsCmdLogLevel()
+    {
+    }
+
+    /**
+     * Execute command.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     */
+    void execute(AsyncWebSocket* server, AsyncWebSocketClient* client) final;
+
+    /**
+     * Set command parameter. Call this for each parameter, until executing it.
+     *
+     * @param[in] par   Parameter string
+     */
+    void setPar(const char* par) final;
+
+    /** Module name, which addresses the global log level. */
+    static const char*  GLOBAL_MODULE;
+
+    /** Level parameter, which lets a log module follow the global log level. */
+    static const char*  GLOBAL_LEVEL;
+
+private:
+
+    bool    m_isError;  /**< Any error happened during parameter reception? */
+    uint8_t m_cnt;      /**< Number of received parameters */
+    String  m_module;   /**< Name of the log module */
+    int     m_level;    /**< Log level, which to set. */
+    bool    m_isGlobal; /**< Shall the log module follow the global log level? */
+
+    WsCmdLogLevel(const WsCmdLogLevel& cmd);
+    WsCmdLogLevel& operator=(const WsCmdLogLevel& cmd);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __WSCMDLOGLEVEL_H__ */
+
+/** @} */
@@ -0,0 +1,162 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to subscribe to the metrics stream
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmdMetricStream.h"
+
+#include <Util.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void WsCmdMetricStream::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    /* Any error happended? */
+    if ((true == m_isError) ||
+        (0U == m_parCnt))
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+    else if (false == m_isEnabled)
+    {
+        MetricsStreamer::getInstance().unsubscribe(client->id());
+        sendResponse(server, client, "ACK");
+    }
+    else if (false == MetricsStreamer::getInstance().subscribe(client->id(), m_period))
+    {
+        sendResponse(server, client, "NACK;\"Too many subscribers.\"");
+    }
+    else
+    {
+        sendResponse(server, client, "ACK");
+    }
+
+    m_isError   = false;
+    m_parCnt    = 0U;
+    m_isEnabled = false;
+    m_period    = MetricsStreamer::DEFAULT_PERIOD;
+
+    return;
+}
+
+void WsCmdMetricStream::setPar(const char* par)
+{
+    uint32_t value = 0U;
+
+    switch(m_parCnt)
+    {
+    case 0:
+        if (0 == strcmp(par, "0"))
+        {
+            m_isEnabled = false;
+        }
+        else if (0 == strcmp(par, "1"))
+        {
+            m_isEnabled = true;
+        }
+        else
+        {
+            m_isError = true;
+        }
+        break;
+
+    case 1:
+        if (false == Util::strToUInt32(par, value))
+        {
+            LOG_ERROR("Conversion failed: %s", par);
+            m_isError = true;
+        }
+        else if ((MetricsStreamer::MIN_PERIOD > value) ||
+                 (MetricsStreamer::MAX_PERIOD < value))
+        {
+            m_isError = true;
+        }
+        else
+        {
+            m_period = value;
+        }
+        break;
+
+    default:
+        m_isError = true;
+        break;
+    }
+
+    ++m_parCnt;
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -72,7 +72,7 @@ void WsCmdMove::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
@@ -100,7 +100,7 @@ void WsCmdMove::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
             PluginMgr::getInstance().save();
         }
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
@@ -114,7 +114,7 @@ void WsCmdMove::setPar(const char* par)
     switch(m_parCnt)
     {
     case 0:
-        if (false == Util::strToUInt16(String(par), m_uid))
+        if (false == Util::strToUInt16(par, m_uid))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
@@ -122,7 +122,7 @@ void WsCmdMove::setPar(const char* par)
         break;
 
     case 1:
-        if (false == Util::strToUInt8(String(par), m_slotId))
+        if (false == Util::strToUInt8(par, m_slotId))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
@@ -0,0 +1,165 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command get display runtime profile
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmdProfile.h"
+#include "DisplayMgr.h"
+
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void WsCmdProfile::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    /* Any error happended? */
+    if (true == m_isError)
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+    else
+    {
+        String                  rsp         = "ACK";
+        const char              DELIMITER   = ';';
+        DisplayMgr&             displayMgr  = DisplayMgr::getInstance();
+        uint8_t                 slotId      = DisplayMgr::SLOT_ID_INVALID;
+        ProfileStat::Summary    fadeProfile;
+
+        displayMgr.getFadeProfile(fadeProfile);
+        addSummary(rsp, fadeProfile);
+
+        rsp += DELIMITER;
+        rsp += displayMgr.getMaxSlots();
+
+        /* Provides for every slot:
+         * - Name of plugin.
+         * - Plugin UID.
+         * - Runtime profile of the plugin process(), update() and active() calls.
+         */
+        for(slotId = 0U; slotId < displayMgr.getMaxSlots(); ++slotId)
+        {
+            IPluginMaintenance*         plugin  = displayMgr.getPluginInSlot(slotId);
+            const char*                 name    = (nullptr != plugin) ? plugin->getName() : "";
+            uint16_t                    uid     = (nullptr != plugin) ? plugin->getUID() : 0U;
+            DisplayMgr::PluginProfile   profile;
+
+            (void)displayMgr.getPluginProfile(slotId, profile);
+
+            rsp += DELIMITER;
+            rsp += "\"";
+            rsp += name;
+            rsp += "\"";
+            rsp += DELIMITER;
+            rsp += uid;
+            addSummary(rsp, profile.process);
+            addSummary(rsp, profile.update);
+            addSummary(rsp, profile.active);
+        }
+
+        sendResponse(server, client, rsp);
+    }
+
+    m_isError = false;
+
+    return;
+}
+
+void WsCmdProfile::setPar(const char* par)
+{
+    UTIL_NOT_USED(par);
+
+    m_isError = true;
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void WsCmdProfile::addSummary(String& rsp, const ProfileStat::Summary& summary)
+{
+    const char DELIMITER = ';';
+
+    rsp += DELIMITER;
+    rsp += summary.count;
+    rsp += DELIMITER;
+    rsp += summary.min;
+    rsp += DELIMITER;
+    rsp += summary.avg;
+    rsp += DELIMITER;
+    rsp += summary.max;
+    rsp += DELIMITER;
+    rsp += summary.p99;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,202 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to record the display frames
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmdRecord.h"
+
+#include <Logging.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void WsCmdRecord::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    /* Any error happended? */
+    if (true == m_isError)
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+    /* Get recording status? */
+    else if (CMD_STATUS == m_cmd)
+    {
+        FrameRecorder::Status   status;
+        String                  rsp         = "ACK";
+        const char              DELIMITER   = ';';
+
+        FrameRecorder::getInstance().getStatus(status);
+
+        rsp += DELIMITER;
+        rsp += (true == status.isRecording) ? 1 : 0;
+        rsp += DELIMITER;
+        rsp += status.frames;
+        rsp += DELIMITER;
+        rsp += status.droppedFrames;
+        rsp += DELIMITER;
+        rsp += status.bytes;
+
+        sendResponse(server, client, rsp);
+    }
+    /* Start recording? */
+    else if (CMD_START == m_cmd)
+    {
+        if (false == FrameRecorder::getInstance().start(m_sink, client->id(), m_seed))
+        {
+            sendResponse(server, client, "NACK;\"Starting failed.\"");
+        }
+        else
+        {
+            sendResponse(server, client, "ACK;1");
+        }
+    }
+    /* Stop recording? */
+    else if (CMD_STOP == m_cmd)
+    {
+        FrameRecorder::getInstance().stop();
+        sendResponse(server, client, "ACK;0");
+    }
+    else
+    {
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
+    }
+
+    m_isError   = false;
+    m_parCnt    = 0U;
+    m_cmd       = CMD_STATUS;
+    m_sink      = FrameRecorder::SINK_FILE;
+    m_seed      = 0U;
+
+    return;
+}
+
+void WsCmdRecord::setPar(const char* par)
+{
+    if (0U == m_parCnt)
+    {
+        if (0 == strcmp(par, "START"))
+        {
+            m_cmd = CMD_START;
+        }
+        else if (0 == strcmp(par, "STOP"))
+        {
+            m_cmd = CMD_STOP;
+        }
+        else
+        {
+            m_isError = true;
+        }
+    }
+    else if (CMD_START == m_cmd)
+    {
+        switch(m_parCnt)
+        {
+        case 1U:
+            if (0 == strcmp(par, "FILE"))
+            {
+                m_sink = FrameRecorder::SINK_FILE;
+            }
+            else if (0 == strcmp(par, "WS"))
+            {
+                m_sink = FrameRecorder::SINK_WEBSOCKET;
+            }
+            else
+            {
+                m_isError = true;
+            }
+            break;
+
+        case 2U:
+            if (false == Util::strToUInt32(par, m_seed))
+            {
+                LOG_ERROR("Conversion failed: %s", par);
+                m_isError = true;
+            }
+            break;
+
+        default:
+            m_isError = true;
+            break;
+        }
+    }
+    else
+    {
+        m_isError = true;
+    }
+
+    ++m_parCnt;
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,125 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2021 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Websocket command to record the display frames
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __WSCMDRECORD_H__
+#define __WSCMDRECORD_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WsCmd.h"
+#include "FrameRecorder.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Websocket command to start/stop the display frame recording.
+ */
+class WsCmdRecord: public WsCmd
+{
+public:
+
+    /**
+     * Constructs the websocket command.
+     */
+    WsCmdRecord() :
+        WsCmd("REC"),
+        m_isError(false),
+        m_parCnt(0U),
+        m_cmd(CMD_STATUS),
+        m_sink(FrameRecorder::SINK_FILE),
+        m_seed(0U)
+    {
+    }
+
+    /**
+     * Destroys websocket command.
+     */
+    ~WsCmdRecord()
+    {
+    }
+
+    /**
+     * Execute command.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     */
+    void execute(AsyncWebSocket* server, AsyncWebSocketClient* client) final;
+
+    /**
+     * Set command parameter. Call this for each parameter, until executing it.
+     *
+     * @param[in] par   Parameter string
+     */
+    void setPar(const char* par) final;
+
+private:
+
+    /** Record commands */
+    enum Cmd
+    {
+        CMD_STATUS = 0, /**< Get recording status */
+        CMD_START,      /**< Start recording */
+        CMD_STOP        /**< Stop recording */
+    };
+
+    bool                    m_isError;  /**< Any error happened during parameter reception? */
+    uint8_t                 m_parCnt;   /**< Number of received parameters */
+    Cmd                     m_cmd;      /**< Record command */
+    FrameRecorder::Sink     m_sink;     /**< Recording sink */
+    uint32_t                m_seed;     /**< Random seed */
+
+    WsCmdRecord(const WsCmdRecord& cmd);
+    WsCmdRecord& operator=(const WsCmdRecord& cmd);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __WSCMDRECORD_H__ */
+
+/** @} */
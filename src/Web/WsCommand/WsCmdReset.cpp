@@ -72,7 +72,7 @@ void WsCmdReset::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
@@ -80,7 +80,7 @@ void WsCmdReset::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
 
         UpdateMgr::getInstance().reqRestart();
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
@@ -34,6 +34,7 @@
  *****************************************************************************/
 #include "WsCmdSlotDuration.h"
 #include "DisplayMgr.h"
+#include "SettingCoalescer.h"
 
 #include <Logging.h>
 
@@ -72,22 +73,32 @@ void WsCmdSlotDuration::execute(AsyncWebSocket* server, AsyncWebSocketClient* cl
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
         String      rsp         = "ACK";
         const char  DELIMITER   = ';';
+        uint32_t    duration    = 0U;
 
-        if (2U == m_parCnt)
+        /* The slot duration is applied coalesced and persisted debounced,
+         * therefore the requested value is responded.
+         */
+        if ((2U == m_parCnt) &&
+            (DisplayMgr::getInstance().getMaxSlots() > m_slotId))
         {
-            (void)DisplayMgr::getInstance().setSlotDuration(m_slotId, m_slotDuration);
+            SettingCoalescer::getInstance().setSlotDuration(m_slotId, m_slotDuration);
+            duration = m_slotDuration;
+        }
+        else
+        {
+            duration = DisplayMgr::getInstance().getSlotDuration(m_slotId);
         }
 
         rsp += DELIMITER;
-        rsp += DisplayMgr::getInstance().getSlotDuration(m_slotId);
+        rsp += duration;
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError = false;
@@ -101,7 +112,7 @@ void WsCmdSlotDuration::setPar(const char* par)
     switch(m_parCnt)
     {
     case 0:
-        if (false == Util::strToUInt8(String(par), m_slotId))
+        if (false == Util::strToUInt8(par, m_slotId))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
@@ -109,7 +120,7 @@ void WsCmdSlotDuration::setPar(const char* par)
         break;
 
     case 1:
-        if (false == Util::strToUInt32(String(par), m_slotDuration))
+        if (false == Util::strToUInt32(par, m_slotDuration))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
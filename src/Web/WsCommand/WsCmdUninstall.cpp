@@ -73,7 +73,7 @@ void WsCmdUninstall::execute(AsyncWebSocket* server, AsyncWebSocketClient* clien
     /* Any error happended? */
     if (true == m_isError)
     {
-        server->text(client->id(), "NACK;\"Parameter invalid.\"");
+        sendResponse(server, client, "NACK;\"Parameter invalid.\"");
     }
     else
     {
@@ -100,7 +100,7 @@ void WsCmdUninstall::execute(AsyncWebSocket* server, AsyncWebSocketClient* clien
             rsp = "ACK";
         }
 
-        server->text(client->id(), rsp);
+        sendResponse(server, client, rsp);
     }
 
     m_isError   = false;
@@ -115,7 +115,7 @@ void WsCmdUninstall::setPar(const char* par)
     {
         if (DisplayMgr::SLOT_ID_INVALID == m_slotId)
         {
-            if (false == Util::strToUInt8(String(par), m_slotId))
+            if (false == Util::strToUInt8(par, m_slotId))
             {
                 LOG_ERROR("Conversion failed: %s", par);
                 m_isError = true;
@@ -33,15 +33,23 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <WiFi.h>
 #include <Logging.h>
 #include <LogSinkPrinter.h>
 #include "LogSinkWebsocket.h"
+#include "SerialTxBuffer.h"
 #include <StateMachine.hpp>
 
 #include "Board.h"
 #include "InitState.h"
-#include "TaskMon.h"
-#include "MemMon.h"
+#include "DiagService.h"
+#include "PowerMgr.h"
+#include "CrashTrace.h"
+#include "Settings.h"
+#include "MicroBench.h"
+#include "SysEvent.h"
+#include "LightSensorDrv.h"
+#include "ThermalMonitor.h"
 
 /******************************************************************************
  * Macros
@@ -56,6 +64,8 @@
  *****************************************************************************/
 
 static int main_espLogVPrintf(const char* szFormat, va_list args);
+static void main_onWiFiEvent(WiFiEvent_t event);
+static void main_onDeferredLog(void);
 
 /******************************************************************************
  * Variables
@@ -64,8 +74,11 @@ static int main_espLogVPrintf(const char* szFormat, va_list args);
 /** System state machine */
 static StateMachine     gSysStateMachine(InitState::getInstance());
 
+/** Non-blocking serial output for the log messages. */
+static SerialTxBuffer   gSerialTxBuffer(Serial);
+
 /** Serial log sink */
-static LogSinkPrinter   gLogSinkSerial("Serial", &Serial);
+static LogSinkPrinter   gLogSinkSerial("Serial", &gSerialTxBuffer);
 
 /** Websocket log sink */
 static LogSinkWebsocket gLogSinkWebsocket("Websocket", &WebSocketSrv::getInstance());
@@ -76,9 +89,6 @@ static const uint32_t   SERIAL_BAUDRATE     = 115200U;
 /** Buffer for esp_log_write() method output. */
 static char             gLogPrintBuffer[512U];
 
-/** Task period in ms of the loop() task. */
-static const uint32_t   LOOP_TASK_PERIOD    = 40U;
-
 /******************************************************************************
  * External functions
  *****************************************************************************/
@@ -88,9 +98,20 @@ static const uint32_t   LOOP_TASK_PERIOD    = 40U;
  */
 void setup()
 {
+    /* Record the boot in the trace buffer, which survives the reset. */
+    CrashTrace::getInstance().init();
+
     /* Setup serial interface */
     Serial.begin(SERIAL_BAUDRATE);
 
+    /* Log messages are written to the serial interface in the background,
+     * because a full UART TX FIFO would block the caller.
+     */
+    if (false == gSerialTxBuffer.begin())
+    {
+        Serial.println("Couldn't start serial TX buffer.");
+    }
+
     /* Pipe esp_log_write() output through own logging system. */
     (void)esp_log_set_vprintf(main_espLogVPrintf);
     esp_log_level_set("*", ESP_LOG_VERBOSE);
@@ -102,11 +123,41 @@ void setup()
     }
 
     /* Register websocket log sink. */
-    (void)Logging::getInstance().registerSink(&gLogSinkWebsocket);
+    if (true == Logging::getInstance().registerSink(&gLogSinkWebsocket))
+    {
+        if (false == gLogSinkWebsocket.begin())
+        {
+            LOG_ERROR("Couldn't start websocket log sink.");
+        }
+    }
 
     /* Set severity */
     Logging::getInstance().setLogLevel(Logging::LOGLEVEL_INFO);
 
+    /* The loop task owns the system state machine and sleeps until one of
+     * its events happen.
+     */
+    if (false == SysEvent::getInstance().begin())
+    {
+        LOG_ERROR("Couldn't start system event queue.");
+    }
+
+    Logging::getInstance().setDeferredNotify(main_onDeferredLog);
+    (void)WiFi.onEvent(main_onWiFiEvent);
+
+    /* Changed settings are written delayed and coalesced in the background. */
+    if (false == Settings::getInstance().begin())
+    {
+        LOG_ERROR("Couldn't start settings flush task.");
+    }
+
+#if (0 != MICRO_BENCH)
+
+    /* Measure before the display and network run concurrently. */
+    MicroBench::getInstance().run();
+
+#endif  /* (0 != MICRO_BENCH) */
+
     /* The setup routine shall handle only the initialization state.
      * All other states are handled in the loop routine.
      */
@@ -116,25 +167,52 @@ void setup()
     }
     while(static_cast<AbstractState*>(&InitState::getInstance()) == gSysStateMachine.getState());
 
+    /* The task and memory monitor run in the background. */
+    if (false == DiagService::getInstance().begin())
+    {
+        LOG_ERROR("Couldn't start diagnostic service.");
+    }
+
     return;
 }
 
 /**
- * Main loop, which is called periodically.
+ * Main loop, which waits for system events or until the system state machine
+ * needs to be processed again.
  */
 void loop()
 {
+    SysEvent::Id    id          = SysEvent::ID_WIFI;
+    uint32_t        waitTime    = gSysStateMachine.getWaitTime();
+
+    /* The render load needs to be sampled at least once per processing cycle. */
+    if (PowerMgr::PROCESSING_CYCLE < waitTime)
+    {
+        waitTime = PowerMgr::PROCESSING_CYCLE;
+    }
+
+    /* Schedule other tasks, until something happens. The event itself is
+     * not of interest, because the states and the deferred logging query
+     * their sources by themselves.
+     */
+    (void)SysEvent::getInstance().wait(id, waitTime);
+
     /* Process system state machine */
     gSysStateMachine.process();
 
-    /* Task monitor */
-    TaskMon::getInstance().process();
+    /* The digital light sensor is only read, if it signals a light change.
+     * It shares the I2C bus with the RTC, which is accessed by this task too.
+     */
+    LightSensorDrv::getInstance().process();
+
+    /* Throttle the LED matrix current, if it gets too hot. */
+    ThermalMonitor::getInstance().process();
 
-    /* Memory monitor */
-    MemMon::getInstance().process();
+    /* Scale the CPU frequency according to the render load. */
+    PowerMgr::getInstance().process();
 
-    /* Schedule other tasks with same or lower priority. */
-    delay(LOOP_TASK_PERIOD);
+    /* Format and output the deferred log messages. */
+    Logging::getInstance().processDeferred();
 
     return;
 }
@@ -232,4 +310,26 @@ static int main_espLogVPrintf(const char* szFormat, va_list args)
     }
 
     return ret;
-}
\ No newline at end of file
+}
+
+/**
+ * This method is called by the wifi driver on every wifi event.
+ * It runs in the context of the event task.
+ *
+ * @param[in] event Wifi event
+ */
+static void main_onWiFiEvent(WiFiEvent_t event)
+{
+    (void)event;
+
+    /* The states query the wifi status by themselves. */
+    SysEvent::getInstance().post(SysEvent::ID_WIFI);
+}
+
+/**
+ * This method is called by the logging, if a deferred log message is pending.
+ */
+static void main_onDeferredLog(void)
+{
+    SysEvent::getInstance().post(SysEvent::ID_LOG);
+}
@@ -35,21 +35,73 @@
 #include <unity.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 
 #include <LinkedList.hpp>
+#include <FixedList.hpp>
+#include <UidMap.hpp>
 #include <Widget.hpp>
 #include <Canvas.h>
+#include <CanvasView.hpp>
+#include <Compositor.h>
 #include <LampWidget.h>
+#include <IndexedImage.h>
 #include <BitmapWidget.h>
+#include <SpriteWidget.h>
+#include <TickerWidget.h>
+#include <BmpDecoder.h>
+#include <JpegThumbDecoder.h>
+#include <ImageCache.h>
+#include <AssetPack.h>
 #include <TextWidget.h>
 #include <Color.h>
+#include <Gradient.h>
+#include <RleBitmap.h>
+#include <FadeKernel.h>
+#include <FadeTimer.hpp>
+#include <FadeWipeX.h>
+#include <PixelKernel.h>
+#include <EffectRunner.hpp>
 #include <StateMachine.hpp>
 #include <SimpleTimer.hpp>
+#include <MonoTime.hpp>
+#include <EventTimer.hpp>
+#include <SimpleEventTimer.hpp>
+#include <ProfileStat.h>
+#include <LatencyStat.h>
+#include <BudgetWatchdog.h>
 #include <ProgressBar.h>
 #include <Logging.h>
 #include <LogSinkPrinter.h>
 #include <Util.h>
+#include <MemPolicy.h>
 #include <TomThumb.h>
+#include <Metrics.h>
+#include <SlotRecord.h>
+#include <ConfigJournal.h>
+#include <SyncClock.h>
+#include <SyncPacket.h>
+#include <DdpPacket.h>
+#include <FramePatch.h>
+#include <Spectrum.h>
+#include <HeaderStore.h>
+#include <HttpRspParser.h>
+#include <SlotPlan.h>
+#include <SpscQueue.hpp>
+#include <StateBuffer.hpp>
+#include <ButtonGesture.h>
+#include <DeltaPatch.h>
+#include <FrameCodec.h>
+#include <Lzss.h>
+#include <XmlTagExtractor.h>
+#include <GlyphMetrics.h>
+#include <ImageEncoder.h>
+#include <AllocTracker.h>
+#include <PixelGfx.hpp>
+#include <SunCalc.h>
+#include <NtpSync.h>
+#include <BrightnessCalc.h>
+#include <string.h>
 
 /******************************************************************************
  * Macros
@@ -148,6 +200,81 @@ private:
     char m_buffer[1024]; /**< Write buffer, containing the logMessage. */
 };
 
+/**
+ * Print output for testing purposes, which collects everything written.
+ */
+class TestPrintBuffer : public Print
+{
+public:
+
+    /**
+     * Constructs the print output with a empty buffer.
+     */
+    TestPrintBuffer() :
+        m_buffer(),
+        m_length(0U)
+    {
+        m_buffer[0] = '\0';
+    }
+
+    /**
+     * Destroys the print output.
+     */
+    ~TestPrintBuffer()
+    {
+    }
+
+    /**
+     * Write a single byte.
+     *
+     * @param[in] data The byte to be written.
+     *
+     * @return If successful written 1, otherwise 0.
+     */
+    size_t write(uint8_t data)
+    {
+        return write(&data, 1U);
+    }
+
+    /**
+     * Write several bytes. If the buffer is full, the rest is discarded.
+     *
+     * @param[in] buffer    Pointer to the data to be written.
+     * @param[in] size      The size of the data to be written.
+     *
+     * @return The size of the written data.
+     */
+    size_t write(const uint8_t* buffer, size_t size)
+    {
+        size_t index = 0U;
+
+        while((index < size) && ((m_length + 1U) < sizeof(m_buffer)))
+        {
+            m_buffer[m_length] = static_cast<char>(buffer[index]);
+            ++m_length;
+            ++index;
+        }
+
+        m_buffer[m_length] = '\0';
+
+        return index;
+    }
+
+    /**
+     * Get the collected output.
+     *
+     * @return Output
+     */
+    const char* getBuffer() const
+    {
+        return m_buffer;
+    }
+
+private:
+    char    m_buffer[1024]; /**< Collected output */
+    size_t  m_length;       /**< Length of collected output */
+};
+
 /**
  * Graphics interface for testing purposes.
  * It provides all relevant methods from the Adafruit GFX, which are used.
@@ -187,7 +314,7 @@ public:
      * @param[in] y     y-coordinate
      * @param[in] color Pixel color
      */
-    void drawPixel(int16_t x, int16_t y, const Color& color)
+    void drawPixelUnchecked(int16_t x, int16_t y, const Color& color) final
     {
         if ((0 > x) ||
             (0 > y) ||
@@ -218,7 +345,7 @@ public:
      *
      * @return Color in RGB888 format.
      */
-    Color getColor(int16_t x, int16_t y) const
+    Color getColorUnchecked(int16_t x, int16_t y) const final
     {
         /* Out of bounds check */
         TEST_ASSERT_GREATER_OR_EQUAL_INT16(0, x);
@@ -239,7 +366,7 @@ public:
      * @param[in] y     y-coordinate
      * @param[in] ratio Dim ration [0; 255]
      */
-    void dimPixel(int16_t x, int16_t y, uint8_t ratio)
+    void dimPixelUnchecked(int16_t x, int16_t y, uint8_t ratio) final
     {
         /* Out of bounds check */
         TEST_ASSERT_GREATER_OR_EQUAL_INT16(0, x);
@@ -589,6 +716,236 @@ private:
     AbstractState*  m_nextState;    /**< Next state */
 };
 
+/**
+ * Pixel kernel for testing purposes, which encodes the coordinates and the
+ * effect time into the color.
+ */
+struct TestPixelKernel
+{
+    /**
+     * Calculate the color of a single pixel.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] time  Effect time
+     *
+     * @return Pixel color
+     */
+    Color operator()(int16_t x, int16_t y, uint32_t time) const
+    {
+        return Color(x, y, time);
+    }
+};
+
+/**
+ * Row kernel for testing purposes, which counts its calls and encodes the
+ * coordinates and the effect time into the color.
+ */
+struct TestRowKernel
+{
+    uint32_t    callCounter;    /**< Number of calls */
+    uint32_t    pixelCounter;   /**< Number of calculated pixels */
+
+    /**
+     * Calculate the colors of a span.
+     *
+     * @param[in]  x        x-coordinate of the first pixel
+     * @param[in]  y        y-coordinate of the first pixel
+     * @param[in]  time     Effect time
+     * @param[out] colors   Colors of the span
+     * @param[in]  length   Number of pixels
+     */
+    void operator()(int16_t x, int16_t y, uint32_t time, Color* colors, uint16_t length)
+    {
+        uint16_t index = 0U;
+
+        for(index = 0U; index < length; ++index)
+        {
+            colors[index] = Color(x + index, y, time);
+        }
+
+        ++callCounter;
+        pixelCounter += length;
+    }
+};
+
+/**
+ * Timer listener for testing purposes, which records the timeouts.
+ * A timer, which is the restart timer, is restarted at timeout.
+ */
+class TestTimerListener : public ITimerListener
+{
+public:
+
+    /**
+     * Constructs the test timer listener.
+     */
+    TestTimerListener() :
+        m_callCounter(0U),
+        m_lastTimer(nullptr),
+        m_restartTimer(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the test timer listener.
+     */
+    ~TestTimerListener()
+    {
+    }
+
+    /**
+     * Records the timer, which timed out.
+     *
+     * @param[in] timer Event timer, which timed out
+     */
+    void onTimeout(EventTimer& timer) final
+    {
+        TEST_ASSERT_FALSE(timer.isTimerRunning());
+
+        ++m_callCounter;
+        m_lastTimer = &timer;
+
+        if (m_restartTimer == &timer)
+        {
+            timer.restart();
+        }
+    }
+
+    uint32_t    m_callCounter;  /**< Number of timeouts */
+    EventTimer* m_lastTimer;    /**< Last timer, which timed out */
+    EventTimer* m_restartTimer; /**< Timer, which is restarted at timeout */
+};
+
+/**
+ * HTTP response listener for testing purposes, which records all events
+ * in a log and the body separately. The body type is determined by the
+ * "Content-Length" and "Transfer-Encoding" header fields.
+ */
+class TestHttpRspListener : public IHttpRspListener
+{
+public:
+
+    /** Log buffer size in byte */
+    static const size_t LOG_SIZE    = 1024U;
+
+    /** Body buffer size in byte */
+    static const size_t BODY_SIZE   = 256U;
+
+    /**
+     * Constructs the test HTTP response listener.
+     */
+    TestHttpRspListener() :
+        m_log(),
+        m_logLength(0U),
+        m_body(),
+        m_bodyLength(0U),
+        m_contentLength(0U),
+        m_bodyType(BODY_UNTIL_CLOSE)
+    {
+    }
+
+    /**
+     * Destroys the test HTTP response listener.
+     */
+    ~TestHttpRspListener()
+    {
+    }
+
+    void onStatusLine(const char* line, size_t length) final
+    {
+        TEST_ASSERT_EQUAL(strlen(line), length);
+
+        m_contentLength = 0U;
+        m_bodyType      = BODY_UNTIL_CLOSE;
+        log("S:", line);
+    }
+
+    void onHeader(const char* line, size_t length) final
+    {
+        TEST_ASSERT_EQUAL(strlen(line), length);
+
+        if (0 == strncmp(line, "Content-Length:", 15))
+        {
+            m_contentLength = strtoul(&line[15], nullptr, 10);
+            m_bodyType      = BODY_LENGTH;
+        }
+        else if (0 == strcmp(line, "Transfer-Encoding: chunked"))
+        {
+            m_bodyType = BODY_CHUNKED;
+        }
+        else if (0 == strcmp(line, "Invalid: yes"))
+        {
+            m_bodyType = BODY_INVALID;
+        }
+
+        log("H:", line);
+    }
+
+    BodyType onHeaderEnd(size_t& contentLength) final
+    {
+        contentLength = m_contentLength;
+        log("E", "");
+
+        return m_bodyType;
+    }
+
+    void onChunk(size_t size) final
+    {
+        char number[16];
+
+        (void)snprintf(number, sizeof(number), "%u", static_cast<uint32_t>(size));
+        log("C:", number);
+    }
+
+    void onBody(const uint8_t* data, size_t size) final
+    {
+        TEST_ASSERT_TRUE((BODY_SIZE - m_bodyLength) >= size);
+
+        memcpy(&m_body[m_bodyLength], data, size);
+        m_bodyLength += size;
+    }
+
+    void onComplete() final
+    {
+        log("D", "");
+    }
+
+    /**
+     * Clear log and body.
+     */
+    void clear()
+    {
+        m_logLength     = 0U;
+        m_log[0]        = '\0';
+        m_bodyLength    = 0U;
+    }
+
+    char        m_log[LOG_SIZE];    /**< Event log, every event is terminated by a LF. */
+    size_t      m_logLength;        /**< Event log length in byte */
+    uint8_t     m_body[BODY_SIZE];  /**< Received body */
+    size_t      m_bodyLength;       /**< Received body length in byte */
+
+private:
+
+    size_t      m_contentLength;    /**< Content length of the current response */
+    BodyType    m_bodyType;         /**< Body type of the current response */
+
+    /**
+     * Add a event to the log.
+     *
+     * @param[in] prefix    Event prefix
+     * @param[in] text      Event text
+     */
+    void log(const char* prefix, const char* text)
+    {
+        int written = snprintf(&m_log[m_logLength], LOG_SIZE - m_logLength, "%s%s\n", prefix, text);
+
+        TEST_ASSERT_TRUE((0 < written) && ((LOG_SIZE - m_logLength) > static_cast<size_t>(written)));
+        m_logLength += static_cast<size_t>(written);
+    }
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -597,18 +954,63 @@ template < typename T >
 static T getMin(const T value1, const T value2);
 
 static void testDoublyLinkedList(void);
+static void testFixedList(void);
+static void testUidMap(void);
 static void testGfx(void);
 static void testWidget(void);
 static void testCanvas(void);
+static void testCanvasView(void);
+static void testCompositor(void);
 static void testLampWidget(void);
+static void testIndexedImage(void);
 static void testBitmapWidget(void);
+static void testSpriteWidget(void);
+static void testTickerWidget(void);
 static void testTextWidget(void);
 static void testColor(void);
+static void testGradient(void);
+static void testRleBitmap(void);
+static void testFadeKernel(void);
+static void testFadeTimer(void);
+static void testPixelKernel(void);
+static void testEffectRunner(void);
 static void testStateMachine(void);
 static void testSimpleTimer(void);
+static void testTimerService(void);
+static void testSimpleEventTimer(void);
+static void testProfileStat(void);
+static void testLatencyStat(void);
+static void testBudgetWatchdog(void);
 static void testProgressBar(void);
 static void testLogging(void);
 static void testUtil(void);
+static void testMetrics(void);
+static void testSlotRecord(void);
+static void testConfigJournal(void);
+static void testSyncClock(void);
+static void testSyncPacket(void);
+static void testDdpPacket(void);
+static void testFramePatch(void);
+static void testSpectrum(void);
+static void testHeaderStore(void);
+static void testHttpRspParser(void);
+static void testSlotPlan(void);
+static void testSpscQueue(void);
+static void testStateBuffer(void);
+static void testButtonGesture(void);
+static void testDeltaPatch(void);
+static void testFrameCodec(void);
+static void testLzss(void);
+static void testJpegThumbDecoder(void);
+static void testXmlTagExtractor(void);
+static void testGlyphMetrics(void);
+static void testImageEncoder(void);
+static void testAllocation(void);
+static void testPixelGfx(void);
+static void testPixelFormat(void);
+static void testSunCalc(void);
+static void testNtpSync(void);
+static void testBrightnessCalc(void);
 
 /******************************************************************************
  * Variables
@@ -632,18 +1034,63 @@ int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testDoublyLinkedList);
+    RUN_TEST(testFixedList);
+    RUN_TEST(testUidMap);
     RUN_TEST(testGfx);
     RUN_TEST(testWidget);
     RUN_TEST(testCanvas);
+    RUN_TEST(testCanvasView);
+    RUN_TEST(testCompositor);
     RUN_TEST(testLampWidget);
+    RUN_TEST(testIndexedImage);
     RUN_TEST(testBitmapWidget);
+    RUN_TEST(testSpriteWidget);
+    RUN_TEST(testTickerWidget);
     RUN_TEST(testTextWidget);
     RUN_TEST(testColor);
+    RUN_TEST(testGradient);
+    RUN_TEST(testRleBitmap);
+    RUN_TEST(testFadeKernel);
+    RUN_TEST(testFadeTimer);
+    RUN_TEST(testPixelKernel);
+    RUN_TEST(testEffectRunner);
     RUN_TEST(testStateMachine);
     RUN_TEST(testSimpleTimer);
+    RUN_TEST(testTimerService);
+    RUN_TEST(testSimpleEventTimer);
+    RUN_TEST(testProfileStat);
+    RUN_TEST(testLatencyStat);
+    RUN_TEST(testBudgetWatchdog);
     RUN_TEST(testProgressBar);
     RUN_TEST(testLogging);
     RUN_TEST(testUtil);
+    RUN_TEST(testMetrics);
+    RUN_TEST(testSlotRecord);
+    RUN_TEST(testConfigJournal);
+    RUN_TEST(testSyncClock);
+    RUN_TEST(testSyncPacket);
+    RUN_TEST(testDdpPacket);
+    RUN_TEST(testFramePatch);
+    RUN_TEST(testSpectrum);
+    RUN_TEST(testHeaderStore);
+    RUN_TEST(testHttpRspParser);
+    RUN_TEST(testSlotPlan);
+    RUN_TEST(testSpscQueue);
+    RUN_TEST(testStateBuffer);
+    RUN_TEST(testButtonGesture);
+    RUN_TEST(testDeltaPatch);
+    RUN_TEST(testFrameCodec);
+    RUN_TEST(testLzss);
+    RUN_TEST(testJpegThumbDecoder);
+    RUN_TEST(testXmlTagExtractor);
+    RUN_TEST(testGlyphMetrics);
+    RUN_TEST(testImageEncoder);
+    RUN_TEST(testAllocation);
+    RUN_TEST(testPixelGfx);
+    RUN_TEST(testPixelFormat);
+    RUN_TEST(testSunCalc);
+    RUN_TEST(testNtpSync);
+    RUN_TEST(testBrightnessCalc);
 
     return UNITY_END();
 }
@@ -830,6 +1277,89 @@ static void testDoublyLinkedList()
     return;
 }
 
+/**
+ * Fixed capacity list tests.
+ */
+static void testFixedList()
+{
+    const uint32_t                          CAPACITY    = 3U;
+    FixedList<uint32_t, CAPACITY>           list;
+    FixedListIterator<uint32_t, CAPACITY>   it(list);
+    uint32_t                                index       = 0U;
+
+    /* List is empty. */
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, list.getCapacity());
+    TEST_ASSERT_EQUAL_UINT32(0U, list.getNumOfElements());
+    TEST_ASSERT_FALSE(it.first());
+    TEST_ASSERT_FALSE(it.last());
+    TEST_ASSERT_NULL(it.current());
+    TEST_ASSERT_FALSE(it.next());
+    TEST_ASSERT_FALSE(it.prev());
+    TEST_ASSERT_FALSE(it.find(1U));
+
+    /* Fill the list completely, more elements are rejected. */
+    for(index = 1U; index <= CAPACITY; ++index)
+    {
+        TEST_ASSERT_TRUE(list.append(index));
+        TEST_ASSERT_EQUAL_UINT32(index, list.getNumOfElements());
+    }
+    TEST_ASSERT_FALSE(list.append(index));
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, list.getNumOfElements());
+
+    /* Select element for element, from head to tail and back. */
+    TEST_ASSERT_TRUE(it.first());
+    TEST_ASSERT_EQUAL_UINT32(1U, *it.current());
+    TEST_ASSERT_FALSE(it.prev());
+    TEST_ASSERT_TRUE(it.next());
+    TEST_ASSERT_EQUAL_UINT32(2U, *it.current());
+    TEST_ASSERT_TRUE(it.next());
+    TEST_ASSERT_EQUAL_UINT32(3U, *it.current());
+    TEST_ASSERT_FALSE(it.next());
+    TEST_ASSERT_EQUAL_UINT32(3U, *it.current());
+    TEST_ASSERT_TRUE(it.prev());
+    TEST_ASSERT_EQUAL_UINT32(2U, *it.current());
+    TEST_ASSERT_TRUE(it.last());
+    TEST_ASSERT_EQUAL_UINT32(3U, *it.current());
+
+    /* Copied lists are independent. */
+    {
+        FixedList<uint32_t, CAPACITY>               copyOfList = list;
+        FixedListConstIterator<uint32_t, CAPACITY>  itListCopy(copyOfList);
+
+        TEST_ASSERT_EQUAL_UINT32(CAPACITY, copyOfList.getNumOfElements());
+        TEST_ASSERT_TRUE(itListCopy.first());
+        TEST_ASSERT_TRUE(it.first());
+        TEST_ASSERT_NOT_EQUAL(itListCopy.current(), it.current());
+        TEST_ASSERT_EQUAL_UINT32(*it.current(), *itListCopy.current());
+    }
+
+    /* Remove the element in the middle, the order of the others is kept. */
+    TEST_ASSERT_TRUE(it.first());
+    TEST_ASSERT_TRUE(it.find(2U));
+    it.remove();
+    TEST_ASSERT_EQUAL_UINT32(2U, list.getNumOfElements());
+    TEST_ASSERT_EQUAL_UINT32(1U, *it.current());
+    TEST_ASSERT_TRUE(it.next());
+    TEST_ASSERT_EQUAL_UINT32(3U, *it.current());
+    TEST_ASSERT_FALSE(it.next());
+
+    /* Find not existing element, the last element is selected. */
+    TEST_ASSERT_TRUE(it.first());
+    TEST_ASSERT_FALSE(it.find(2U));
+    TEST_ASSERT_EQUAL_UINT32(3U, *it.current());
+
+    /* After clearing, the iterator shall not select anything. */
+    list.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, list.getNumOfElements());
+    TEST_ASSERT_NULL(it.current());
+    TEST_ASSERT_FALSE(it.first());
+    TEST_ASSERT_TRUE(list.append(index));
+    TEST_ASSERT_TRUE(it.first());
+    TEST_ASSERT_EQUAL_UINT32(index, *it.current());
+
+    return;
+}
+
 /**
  * Test the graphic functions.
  */
@@ -938,6 +1468,113 @@ static void testGfx()
     testGfx.fillScreen(0U);
     TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0U));
 
+    /* Drawing outside is clipped, before the framebuffer is accessed. */
+    testGfx.fillRect(-4, -4, TestGfx::WIDTH + 8U, TestGfx::HEIGHT + 8U, COLOR);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, COLOR));
+    testGfx.drawLine(-10, -10, 20, 20, 0U);
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(2, 2));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(-1, 0));
+    testGfx.drawRGBBitmap(-2, -1, bitmap, TestGfx::WIDTH, TestGfx::HEIGHT);
+    TEST_ASSERT_EQUAL_UINT16(bitmap[2 + 1 * TestGfx::WIDTH], testGfx.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT16(bitmap[(TestGfx::WIDTH - 1) + (TestGfx::HEIGHT - 1) * TestGfx::WIDTH], testGfx.getColor(TestGfx::WIDTH - 3, TestGfx::HEIGHT - 2));
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0U));
+
+    /* Clipping region without translation */
+    TEST_ASSERT_TRUE(testGfx.pushClip(2, 1, 4U, 3U));
+    testGfx.fillScreen(COLOR);
+    testGfx.popClip();
+    TEST_ASSERT_TRUE(testGfx.verify(2, 1, 4U, 3U, COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, 1U, 0U));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 4, TestGfx::WIDTH, TestGfx::HEIGHT - 4U, 0U));
+    TEST_ASSERT_TRUE(testGfx.verify(6, 1, TestGfx::WIDTH - 6U, 3U, 0U));
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0U));
+
+    /* Nested clipping regions with translation, the inner one is limited by the outer one. */
+    TEST_ASSERT_TRUE(testGfx.pushClip(4, 2, 8U, 4U, true));
+    testGfx.drawPixel(0, 0, COLOR);
+    TEST_ASSERT_EQUAL_UINT16(COLOR, testGfx.getColor(0, 0));
+    TEST_ASSERT_TRUE(testGfx.pushClip(6, 1, 8U, 8U, true));
+    testGfx.fillScreen(COLOR);
+    testGfx.drawPixel(-1, 0, COLOR);
+    testGfx.popClip();
+    testGfx.popClip();
+    TEST_ASSERT_EQUAL_UINT16(COLOR, testGfx.getColor(4, 2));
+    TEST_ASSERT_TRUE(testGfx.verify(10, 3, 2U, 3U, COLOR));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(9, 3));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(12, 3));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(10, 6));
+
+    /* The stack depth is limited. */
+    TEST_ASSERT_TRUE(testGfx.pushClip(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT));
+    TEST_ASSERT_TRUE(testGfx.pushClip(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT));
+    TEST_ASSERT_TRUE(testGfx.pushClip(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT));
+    TEST_ASSERT_TRUE(testGfx.pushClip(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT));
+    TEST_ASSERT_FALSE(testGfx.pushClip(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT));
+    testGfx.popClip();
+    testGfx.popClip();
+    testGfx.popClip();
+    testGfx.popClip();
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0U));
+
+    /* A rectangle with a height of 1 pixel is a line. */
+    testGfx.drawRectangle(0, 0, 4U, 1U, COLOR);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, 4U, 1U, COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 1, TestGfx::WIDTH, TestGfx::HEIGHT - 1U, 0U));
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0U));
+
+    /* Circle outline and filled circle */
+    testGfx.drawCircle(4, 4, 3U, COLOR);
+    TEST_ASSERT_EQUAL_UINT16(COLOR, testGfx.getColor(4, 1));
+    TEST_ASSERT_EQUAL_UINT16(COLOR, testGfx.getColor(4, 7));
+    TEST_ASSERT_EQUAL_UINT16(COLOR, testGfx.getColor(1, 4));
+    TEST_ASSERT_EQUAL_UINT16(COLOR, testGfx.getColor(7, 4));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(4, 4));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(1, 1));
+
+    testGfx.fillCircle(20, 4, 3U, COLOR);
+    TEST_ASSERT_TRUE(testGfx.verify(17, 4, 7U, 1U, COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(20, 1, 1U, 7U, COLOR));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(17, 1));
+    TEST_ASSERT_EQUAL_UINT16(0U, testGfx.getColor(23, 7));
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0U));
+
+    /* Antialiased primitives: the end points are exact, between them the
+     * color is split to the two nearest pixels.
+     */
+    testGfx.drawLineAntialiased(0, 0, 8, 4, ColorDef::WHITE);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(ColorDef::WHITE), static_cast<uint32_t>(testGfx.getColor(0, 0)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(ColorDef::WHITE), static_cast<uint32_t>(testGfx.getColor(8, 4)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(ColorDef::WHITE), static_cast<uint32_t>(testGfx.getColor(2, 1)));
+    TEST_ASSERT_NOT_EQUAL(0U, static_cast<uint32_t>(testGfx.getColor(1, 0)));
+    TEST_ASSERT_NOT_EQUAL(static_cast<uint32_t>(ColorDef::WHITE), static_cast<uint32_t>(testGfx.getColor(1, 0)));
+    TEST_ASSERT_NOT_EQUAL(0U, static_cast<uint32_t>(testGfx.getColor(1, 1)));
+    TEST_ASSERT_NOT_EQUAL(static_cast<uint32_t>(ColorDef::WHITE), static_cast<uint32_t>(testGfx.getColor(1, 1)));
+    TEST_ASSERT_EQUAL_UINT32(0U, static_cast<uint32_t>(testGfx.getColor(1, 2)));
+
+    testGfx.drawCircleAntialiased(20, 4, 3U, ColorDef::WHITE);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(ColorDef::WHITE), static_cast<uint32_t>(testGfx.getColor(20, 1)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(ColorDef::WHITE), static_cast<uint32_t>(testGfx.getColor(23, 4)));
+    TEST_ASSERT_EQUAL_UINT32(0U, static_cast<uint32_t>(testGfx.getColor(20, 4)));
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0U));
+
     /* Verify cursor positon */
     testGfx.getTextCursorPos(cursorPosX, cursorPosY);
     TEST_ASSERT_EQUAL_INT16(0, cursorPosX);
@@ -981,12 +1618,14 @@ static void testWidget()
     /* Verify widget type name */
     TEST_ASSERT_EQUAL_STRING(TestWidget::WIDGET_TYPE, testWidget.getType());
 
-    /* No widget name is set, it must be empty. */
-    TEST_ASSERT_EQUAL_STRING("", testWidget.getName().c_str());
+    /* No widget name is set, it must have no id. */
+    TEST_ASSERT_EQUAL_UINT32(Widget::ID_NONE, testWidget.getId());
 
-    /* Set widget name and read back. */
+    /* Set widget name and read back its id. */
     testWidget.setName(testStr);
-    TEST_ASSERT_EQUAL_STRING(testStr, testWidget.getName().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Widget::toId(testStr), testWidget.getId());
+    TEST_ASSERT_NOT_EQUAL(Widget::ID_NONE, testWidget.getId());
+    TEST_ASSERT_NOT_EQUAL(Widget::toId("myWidget2"), testWidget.getId());
 
     /* Find widget with empty name.
      * Expected: Not found
@@ -998,10 +1637,12 @@ static void testWidget()
      */
     TEST_ASSERT_NOT_NULL(testWidget.find(testStr));
     TEST_ASSERT_EQUAL_PTR(&testWidget, testWidget.find(testStr));
+    TEST_ASSERT_EQUAL_PTR(&testWidget, testWidget.find(Widget::toId(testStr)));
 
     /* Clear name */
     testWidget.setName("");
-    TEST_ASSERT_EQUAL_STRING("", testWidget.getName().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Widget::ID_NONE, testWidget.getId());
+    TEST_ASSERT_NULL(testWidget.find(Widget::ID_NONE));
 
     /* Current position must be (0, 0) */
     testWidget.getPos(posX, posY);
@@ -1062,17 +1703,22 @@ void testCanvas()
 
     TestGfx     testGfx;
     Canvas      testCanvas(CANVAS_WIDTH, CANVAS_HEIGHT, 0, 0);
+    Canvas      testBufferedCanvas(CANVAS_WIDTH, CANVAS_HEIGHT, 0, 0, true);
     TestWidget  testWidget;
     TestWidget  testWidget2;
+    const Color TEST_BITMAP_ROW[4]  = { WIDGET_COLOR, WIDGET_COLOR, WIDGET_COLOR, WIDGET_COLOR };
 
     /* Verify widget type name */
     TEST_ASSERT_EQUAL_STRING(Canvas::WIDGET_TYPE, testCanvas.getType());
 
-    /* Canvas contains no other widget, so nothing should be drawn. */
+    /* Canvas contains no other widget, so it should be only cleared. */
+    testCanvas.update(testGfx);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestWidget::WIDTH, TestWidget::HEIGHT, 0));
+
+    /* Nothing changed, so nothing should be drawn. */
     testGfx.setCallCounterDrawPixel(0);
     testCanvas.update(testGfx);
     TEST_ASSERT_EQUAL_UINT32(0, testGfx.getCallCounterDrawPixel());
-    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestWidget::WIDTH, TestWidget::HEIGHT, 0));
 
     /* Add widget to canvas, move widget and set draw pen */
     TEST_ASSERT_TRUE(testCanvas.addWidget(testWidget));
@@ -1108,12 +1754,12 @@ void testCanvas()
                                     CANVAS_HEIGHT / 2,
                                     WIDGET_COLOR));
 
-    /* No widget name is set, it must be empty. */
-    TEST_ASSERT_EQUAL_STRING("", testCanvas.getName().c_str());
+    /* No widget name is set, it must have no id. */
+    TEST_ASSERT_EQUAL_UINT32(Widget::ID_NONE, testCanvas.getId());
 
-    /* Set widget name and read back. */
+    /* Set widget name and read back its id. */
     testCanvas.setName(CANVAS_NAME);
-    TEST_ASSERT_EQUAL_STRING(CANVAS_NAME, testCanvas.getName().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Widget::toId(CANVAS_NAME), testCanvas.getId());
 
     /* Find widget with its name.
      * Expected: Widget is found
@@ -1150,12 +1796,259 @@ void testCanvas()
     TEST_ASSERT_NOT_NULL(testCanvas.find(TEST_WIDGET_NAME));
     TEST_ASSERT_EQUAL_PTR(&testWidget, testCanvas.find(TEST_WIDGET_NAME));
 
-    return;
-}
+    /* Find widget in a nested canvas, even if its id changes later.
+     * Expected: Test widget found by its current id only
+     */
+    {
+        Canvas      nestedCanvas(CANVAS_WIDTH, CANVAS_HEIGHT, 0, 0);
+        TestWidget  nestedWidget;
 
-/**
- * Test lamp widget.
- */
+        nestedWidget.setId(42U);
+        TEST_ASSERT_TRUE(nestedCanvas.addWidget(nestedWidget));
+        TEST_ASSERT_TRUE(testCanvas.addWidget(nestedCanvas));
+        TEST_ASSERT_EQUAL_PTR(&nestedWidget, testCanvas.find(42U));
+
+        nestedWidget.setId(43U);
+        TEST_ASSERT_NULL(testCanvas.find(42U));
+        TEST_ASSERT_EQUAL_PTR(&nestedWidget, testCanvas.find(43U));
+
+        TEST_ASSERT_TRUE(testCanvas.removeWidget(nestedCanvas));
+        TEST_ASSERT_NULL(testCanvas.find(43U));
+    }
+
+    /* A new buffered canvas is completely dirty.
+     * Expected: Whole buffer is flushed once.
+     */
+    TEST_ASSERT_TRUE(testBufferedCanvas.isDirty());
+    testGfx.setCallCounterDrawPixel(0);
+    testBufferedCanvas.updateFromBuffer(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(CANVAS_WIDTH * CANVAS_HEIGHT, testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_FALSE(testBufferedCanvas.isDirty());
+
+    /* Draw the same content again.
+     * Expected: Nothing is flushed.
+     */
+    testBufferedCanvas.fillScreen(0);
+    TEST_ASSERT_FALSE(testBufferedCanvas.isDirty());
+    testGfx.setCallCounterDrawPixel(0);
+    testBufferedCanvas.updateFromBuffer(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(0, testGfx.getCallCounterDrawPixel());
+
+    /* Change a part of the canvas.
+     * Expected: Only the bounding box of the changed pixels is flushed.
+     */
+    testBufferedCanvas.fillRect(1, 2, 1, 1, WIDGET_COLOR);
+    testBufferedCanvas.fillRect(3, 1, 1, 1, WIDGET_COLOR);
+    TEST_ASSERT_TRUE(testBufferedCanvas.isDirty());
+    testGfx.fill(0);
+    testGfx.setCallCounterDrawPixel(0);
+    testBufferedCanvas.updateFromBuffer(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(3 * 2, testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_TRUE(testGfx.verify(1, 2, 1, 1, WIDGET_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(3, 1, 1, 1, WIDGET_COLOR));
+
+    /* Write a bitmap row partly outside the canvas.
+     * Expected: Only the visible pixels are written.
+     */
+    testBufferedCanvas.fillScreen(0);
+    testBufferedCanvas.updateFromBuffer(testGfx);
+    testBufferedCanvas.drawRGBBitmap(CANVAS_WIDTH - 2, 0, TEST_BITMAP_ROW, UTIL_ARRAY_NUM(TEST_BITMAP_ROW), 1);
+    testGfx.fill(0);
+    testGfx.setCallCounterDrawPixel(0);
+    testBufferedCanvas.updateFromBuffer(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(2, testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_TRUE(testGfx.verify(CANVAS_WIDTH - 2, 0, 2, 1, WIDGET_COLOR));
+
+    /* Force a complete flush.
+     * Expected: Whole buffer is flushed.
+     */
+    testBufferedCanvas.markDirty();
+    testGfx.setCallCounterDrawPixel(0);
+    testBufferedCanvas.updateFromBuffer(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(CANVAS_WIDTH * CANVAS_HEIGHT, testGfx.getCallCounterDrawPixel());
+
+    /* Only invalid widgets are drawn again, incl. the overlapping parts of other widgets. */
+    {
+        const Color LOWER_COLOR = 0x0000FF;
+        const Color UPPER_COLOR = 0x00FF00;
+        Canvas      retainedCanvas(CANVAS_WIDTH, CANVAS_HEIGHT, 0, 0);
+        TestWidget  lowerWidget;
+        TestWidget  upperWidget;
+
+        lowerWidget.setPenColor(LOWER_COLOR);
+        upperWidget.setPenColor(UPPER_COLOR);
+        upperWidget.move(0, 4);
+        TEST_ASSERT_TRUE(retainedCanvas.addWidget(lowerWidget));
+        TEST_ASSERT_TRUE(retainedCanvas.addWidget(upperWidget));
+
+        /* First update draws everything. */
+        testGfx.fill(WIDGET_COLOR);
+        retainedCanvas.update(testGfx);
+        TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH, 4, LOWER_COLOR));
+        TEST_ASSERT_TRUE(testGfx.verify(0, 4, CANVAS_WIDTH, 4, UPPER_COLOR));
+
+        /* Nothing changed, nothing is drawn. */
+        testGfx.setCallCounterDrawPixel(0);
+        retainedCanvas.update(testGfx);
+        TEST_ASSERT_EQUAL_UINT32(0, testGfx.getCallCounterDrawPixel());
+
+        /* Move the upper widget down, uncovering the lower widget. */
+        upperWidget.move(0, 6);
+        retainedCanvas.update(testGfx);
+        TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH, 5, LOWER_COLOR));
+        TEST_ASSERT_TRUE(testGfx.verify(0, 5, CANVAS_WIDTH, 1, 0));
+        TEST_ASSERT_TRUE(testGfx.verify(0, 6, CANVAS_WIDTH, 2, UPPER_COLOR));
+
+        /* Remove the lower widget, its area must be cleared. */
+        TEST_ASSERT_TRUE(retainedCanvas.removeWidget(lowerWidget));
+        retainedCanvas.update(testGfx);
+        TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH, 6, 0));
+        TEST_ASSERT_TRUE(testGfx.verify(0, 6, CANVAS_WIDTH, 2, UPPER_COLOR));
+    }
+
+    return;
+}
+
+/**
+ * Canvas view tests.
+ */
+static void testCanvasView(void)
+{
+    const int16_t   VIEW_POS_X      = 4;
+    const int16_t   VIEW_POS_Y      = 2;
+    const uint16_t  VIEW_WIDTH      = 6U;
+    const uint16_t  VIEW_HEIGHT     = 4U;
+    const Color     WIDGET_COLOR    = 0x123456;
+
+    TestGfx     testGfx;
+    CanvasView  view(testGfx, VIEW_POS_X, VIEW_POS_Y, VIEW_WIDTH, VIEW_HEIGHT);
+    TestWidget  testWidget;
+
+    TEST_ASSERT_EQUAL_UINT16(VIEW_WIDTH, view.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(VIEW_HEIGHT, view.getHeight());
+    TEST_ASSERT_EQUAL_INT16(VIEW_POS_X, view.getOffsetX());
+    TEST_ASSERT_EQUAL_INT16(VIEW_POS_Y, view.getOffsetY());
+
+    /* Drawing is translated into the parent. */
+    view.drawPixel(0, 0, WIDGET_COLOR);
+    TEST_ASSERT_EQUAL_UINT32(WIDGET_COLOR, testGfx.getColor(VIEW_POS_X, VIEW_POS_Y));
+    TEST_ASSERT_EQUAL_UINT32(WIDGET_COLOR, view.getColor(0, 0));
+
+    /* Drawing is clipped to the view. */
+    testGfx.fill(0);
+    view.fillRect(-2, -2, VIEW_WIDTH + 4U, VIEW_HEIGHT + 4U, WIDGET_COLOR);
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X, VIEW_POS_Y, VIEW_WIDTH, VIEW_HEIGHT, WIDGET_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, VIEW_POS_X, TestGfx::HEIGHT, 0));
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X + VIEW_WIDTH, 0, TestGfx::WIDTH - VIEW_POS_X - VIEW_WIDTH, TestGfx::HEIGHT, 0));
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X, 0, VIEW_WIDTH, VIEW_POS_Y, 0));
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X, VIEW_POS_Y + VIEW_HEIGHT, VIEW_WIDTH, TestGfx::HEIGHT - VIEW_POS_Y - VIEW_HEIGHT, 0));
+
+    /* A new widget is invalid and drawn clipped to the view. */
+    testGfx.fill(0);
+    testWidget.setPenColor(WIDGET_COLOR);
+    TEST_ASSERT_TRUE(view.drawWidget(testWidget));
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X, VIEW_POS_Y, VIEW_WIDTH, VIEW_HEIGHT, WIDGET_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X + VIEW_WIDTH, VIEW_POS_Y, 1U, VIEW_HEIGHT, 0));
+
+    /* Nothing changed, so nothing should be drawn. */
+    testGfx.setCallCounterDrawPixel(0);
+    TEST_ASSERT_FALSE(view.drawWidget(testWidget));
+    TEST_ASSERT_EQUAL_UINT32(0, testGfx.getCallCounterDrawPixel());
+
+    /* A invalid widget is drawn again on a cleared view. */
+    testWidget.move(VIEW_WIDTH / 2, 0);
+    TEST_ASSERT_TRUE(view.drawWidget(testWidget));
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X, VIEW_POS_Y, VIEW_WIDTH / 2, VIEW_HEIGHT, 0));
+    TEST_ASSERT_TRUE(testGfx.verify(VIEW_POS_X + VIEW_WIDTH / 2, VIEW_POS_Y, VIEW_WIDTH / 2, VIEW_HEIGHT, WIDGET_COLOR));
+
+    return;
+}
+
+/**
+ * Test compositor.
+ */
+static void testCompositor(void)
+{
+    const Color     COLOR_LOW   = 0x102030;
+    const Color     COLOR_HIGH  = 0x405060;
+    const uint8_t   ALPHA       = 128U;
+    const uint16_t  HALF_WIDTH  = TestWidget::WIDTH / 2U;
+
+    TestGfx     testGfx;
+    Compositor  compositor;
+    TestWidget  lowWidget;
+    TestWidget  highWidget;
+    TestWidget  otherWidgets[Compositor::MAX_LAYERS];
+    uint8_t     index       = 0U;
+    uint32_t    background  = 0U;
+    uint32_t    foreground  = COLOR_LOW;
+    uint32_t    mixed       = 0U;
+
+    lowWidget.setPenColor(COLOR_LOW);
+    highWidget.setPenColor(COLOR_HIGH);
+    highWidget.move(HALF_WIDTH, 0);
+
+    /* Without layers nothing is drawn. */
+    testGfx.fill(0);
+    testGfx.setCallCounterDrawPixel(0);
+    TEST_ASSERT_FALSE(compositor.draw(testGfx));
+    TEST_ASSERT_EQUAL_UINT32(0, testGfx.getCallCounterDrawPixel());
+
+    /* Layers are drawn in z-order, independent of the order they were added. */
+    TEST_ASSERT_TRUE(compositor.addLayer(highWidget, 2U));
+    TEST_ASSERT_TRUE(compositor.addLayer(lowWidget, 1U));
+    TEST_ASSERT_EQUAL_UINT8(2U, compositor.getLayerCount());
+    TEST_ASSERT_FALSE(compositor.draw(testGfx));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, HALF_WIDTH, TestWidget::HEIGHT, COLOR_LOW));
+    TEST_ASSERT_TRUE(testGfx.verify(HALF_WIDTH, 0, TestWidget::WIDTH, TestWidget::HEIGHT, COLOR_HIGH));
+
+    /* Adding a layer again changes only its z-order. */
+    TEST_ASSERT_TRUE(compositor.addLayer(lowWidget, 3U));
+    TEST_ASSERT_EQUAL_UINT8(2U, compositor.getLayerCount());
+    TEST_ASSERT_FALSE(compositor.draw(testGfx));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestWidget::WIDTH, TestWidget::HEIGHT, COLOR_LOW));
+    TEST_ASSERT_TRUE(testGfx.verify(TestWidget::WIDTH, 0, HALF_WIDTH, TestWidget::HEIGHT, COLOR_HIGH));
+
+    /* The number of layers is limited. Layers, which were never drawn, uncover nothing. */
+    for(index = 0U; index < (Compositor::MAX_LAYERS - 2U); ++index)
+    {
+        TEST_ASSERT_TRUE(compositor.addLayer(otherWidgets[index], 0U));
+    }
+    TEST_ASSERT_FALSE(compositor.addLayer(otherWidgets[index], 0U));
+    for(index = 0U; index < Compositor::MAX_LAYERS; ++index)
+    {
+        compositor.removeLayer(otherWidgets[index]);
+    }
+    TEST_ASSERT_EQUAL_UINT8(2U, compositor.getLayerCount());
+    TEST_ASSERT_FALSE(compositor.draw(testGfx));
+
+    /* A removed layer uncovers the base content. */
+    compositor.removeLayer(highWidget);
+    TEST_ASSERT_EQUAL_UINT8(1U, compositor.getLayerCount());
+    TEST_ASSERT_TRUE(compositor.draw(testGfx));
+    TEST_ASSERT_FALSE(compositor.draw(testGfx));
+
+    /* A translucent layer is blended with the base content, which must be drawn again every time. */
+    testGfx.fill(0);
+    TEST_ASSERT_FALSE(compositor.setAlpha(highWidget, ALPHA));
+    TEST_ASSERT_TRUE(compositor.setAlpha(lowWidget, ALPHA));
+    TEST_ASSERT_TRUE(compositor.draw(testGfx));
+    PixelKernel::blend(&mixed, &background, &foreground, 1U, ALPHA);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestWidget::WIDTH, TestWidget::HEIGHT, mixed));
+
+    /* A invisible layer uncovers the base content too. */
+    testGfx.fill(0);
+    TEST_ASSERT_TRUE(compositor.setAlpha(lowWidget, 0U));
+    TEST_ASSERT_TRUE(compositor.draw(testGfx));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, TestGfx::HEIGHT, 0));
+    TEST_ASSERT_FALSE(compositor.draw(testGfx));
+
+    return;
+}
+
+/**
+ * Test lamp widget.
+ */
 static void testLampWidget()
 {
     const Color     COLOR_OFF   = 0x111111;
@@ -1171,12 +2064,12 @@ static void testLampWidget()
     /* Verify widget type name */
     TEST_ASSERT_EQUAL_STRING(LampWidget::WIDGET_TYPE, lampWidget.getType());
 
-    /* No widget name is set, it must be empty. */
-    TEST_ASSERT_EQUAL_STRING("", lampWidget.getName().c_str());
+    /* No widget name is set, it must have no id. */
+    TEST_ASSERT_EQUAL_UINT32(Widget::ID_NONE, lampWidget.getId());
 
-    /* Set widget name and read back. */
+    /* Set widget name and read back its id. */
     lampWidget.setName(WIDGET_NAME);
-    TEST_ASSERT_EQUAL_STRING(WIDGET_NAME, lampWidget.getName().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Widget::toId(WIDGET_NAME), lampWidget.getId());
 
     /* Find widget with empty name.
      * Expected: Not found
@@ -1232,6 +2125,86 @@ static void testLampWidget()
     return;
 }
 
+/**
+ * Test palette indexed image.
+ */
+static void testIndexedImage()
+{
+    const uint16_t  WIDTH           = 3U;
+    const uint16_t  HEIGHT          = 2U;
+    const Color     BITMAP[WIDTH * HEIGHT] =
+    {
+        ColorDef::RED,  ColorDef::LIME, ColorDef::RED,
+        ColorDef::BLUE, ColorDef::RED,  ColorDef::WHITE
+    };
+
+    TestGfx         testGfx;
+    IndexedImage    image;
+    Color           manyColors[IndexedImage::MAX_PALETTE_SIZE + 1U];
+    Color*          displayBuffer   = testGfx.getBuffer();
+    uint16_t        x               = 0U;
+    uint16_t        y               = 0U;
+
+    /* Empty image */
+    TEST_ASSERT_TRUE(image.isEmpty());
+    TEST_ASSERT_FALSE(image.set(nullptr, WIDTH, HEIGHT));
+    TEST_ASSERT_FALSE(image.set(BITMAP, 0U, HEIGHT));
+
+    /* Up to 16 colors, every pixel needs 4 bit. Every row starts at a byte boundary. */
+    TEST_ASSERT_TRUE(image.set(BITMAP, WIDTH, HEIGHT));
+    TEST_ASSERT_FALSE(image.isEmpty());
+    TEST_ASSERT_EQUAL_UINT16(WIDTH, image.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(HEIGHT, image.getHeight());
+    TEST_ASSERT_EQUAL_UINT16(4U, image.getPaletteSize());
+    TEST_ASSERT_EQUAL_UINT8(4U, image.getBitsPerPixel());
+    TEST_ASSERT_EQUAL(4U * sizeof(Color) + 2U * HEIGHT, image.getMemorySize());
+
+    for(y = 0U; y < HEIGHT; ++y)
+    {
+        for(x = 0U; x < WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(BITMAP[x + y * WIDTH], image.getColor(x, y));
+        }
+    }
+
+    /* Draw only the last two columns. */
+    image.draw(testGfx, 1, 1, 1U, WIDTH);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, displayBuffer[1 + 1 * TestGfx::WIDTH]);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, displayBuffer[2 + 1 * TestGfx::WIDTH]);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, displayBuffer[1 + 2 * TestGfx::WIDTH]);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::WHITE, displayBuffer[2 + 2 * TestGfx::WIDTH]);
+    TEST_ASSERT_EQUAL_UINT32(0U, displayBuffer[3 + 1 * TestGfx::WIDTH]);
+
+    /* A copy is independent of the source. */
+    {
+        IndexedImage copy(image);
+
+        image.release();
+        TEST_ASSERT_TRUE(image.isEmpty());
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::WHITE, copy.getColor(2U, 1U));
+
+        image = copy;
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, image.getColor(0U, 1U));
+    }
+
+    /* More than 16 colors need 8 bit per pixel. */
+    for(x = 0U; x < UTIL_ARRAY_NUM(manyColors); ++x)
+    {
+        manyColors[x] = x;
+    }
+
+    TEST_ASSERT_TRUE(image.set(manyColors, 17U, 1U));
+    TEST_ASSERT_EQUAL_UINT8(8U, image.getBitsPerPixel());
+    TEST_ASSERT_EQUAL_UINT16(17U, image.getPaletteSize());
+    TEST_ASSERT_EQUAL_UINT32(16U, image.getColor(16U, 0U));
+
+    /* Too many colors, the previous image is kept. */
+    TEST_ASSERT_FALSE(image.set(manyColors, UTIL_ARRAY_NUM(manyColors), 1U));
+    TEST_ASSERT_EQUAL_UINT16(17U, image.getWidth());
+
+    return;
+}
+
 /**
  * Test bitmap widget.
  */
@@ -1241,25 +2214,25 @@ static void testBitmapWidget()
     const uint8_t BITMAP_HEIGHT     = TestGfx::HEIGHT;
     const char*   WIDGET_NAME       = "bmpWidgetName";
 
-    TestGfx         testGfx;
-    BitmapWidget    bitmapWidget;
-    Color           bitmap[BITMAP_WIDTH * BITMAP_HEIGHT];
-    uint8_t         x               = 0U;
-    uint8_t         y               = 0U;
-    const Color*    bitmapPtr       = nullptr;
-    uint16_t        width           = 0U;
-    uint16_t        height          = 0U;
-    Color*          displayBuffer   = nullptr;
+    TestGfx             testGfx;
+    BitmapWidget        bitmapWidget;
+    Color               bitmap[BITMAP_WIDTH * BITMAP_HEIGHT];
+    uint8_t             x               = 0U;
+    uint8_t             y               = 0U;
+    const IndexedImage* image           = nullptr;
+    uint16_t            width           = 0U;
+    uint16_t            height          = 0U;
+    Color*              displayBuffer   = nullptr;
 
     /* Verify widget type name */
     TEST_ASSERT_EQUAL_STRING(BitmapWidget::WIDGET_TYPE, bitmapWidget.getType());
 
-    /* No widget name is set, it must be empty. */
-    TEST_ASSERT_EQUAL_STRING("", bitmapWidget.getName().c_str());
+    /* No widget name is set, it must have no id. */
+    TEST_ASSERT_EQUAL_UINT32(Widget::ID_NONE, bitmapWidget.getId());
 
-    /* Set widget name and read back. */
+    /* Set widget name and read back its id. */
     bitmapWidget.setName(WIDGET_NAME);
-    TEST_ASSERT_EQUAL_STRING(WIDGET_NAME, bitmapWidget.getName().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Widget::toId(WIDGET_NAME), bitmapWidget.getId());
 
     /* Find widget with empty name.
      * Expected: Not found
@@ -1282,16 +2255,18 @@ static void testBitmapWidget()
     }
 
     /* Set bitmap and read back */
-    bitmapWidget.set(bitmap, BITMAP_WIDTH, BITMAP_HEIGHT);
-    bitmapPtr = bitmapWidget.get(width, height);
+    TEST_ASSERT_TRUE(bitmapWidget.set(bitmap, BITMAP_WIDTH, BITMAP_HEIGHT));
+    bitmapWidget.getSize(width, height);
     TEST_ASSERT_EQUAL_UINT16(BITMAP_WIDTH, width);
     TEST_ASSERT_EQUAL_UINT16(BITMAP_HEIGHT, height);
+    image = bitmapWidget.getImage();
+    TEST_ASSERT_NOT_NULL(image);
 
     for(y = 0U; y < BITMAP_HEIGHT; ++y)
     {
         for(x = 0U; x < BITMAP_WIDTH; ++x)
         {
-            TEST_ASSERT_EQUAL_UINT32(bitmap[x + y * BITMAP_WIDTH], bitmapPtr[x + y * BITMAP_WIDTH]);
+            TEST_ASSERT_EQUAL_UINT32(bitmap[x + y * BITMAP_WIDTH], image->getColor(x, y));
         }
     }
 
@@ -1307,6 +2282,341 @@ static void testBitmapWidget()
         }
     }
 
+    /* Decode a 2x2 bitmap with 24 bpp, which is stored bottom-up. */
+    {
+        const uint8_t BMP_FILE[] =
+        {
+            /* File header */
+            'B', 'M', 70, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0,
+            /* DIB header */
+            40, 0, 0, 0, 2, 0, 0, 0, 2, 0, 0, 0, 1, 0, 24, 0, 0, 0, 0, 0,
+            16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            /* Bottom row: blue, green + padding */
+            0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+            /* Top row: red, white + padding */
+            0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00
+        };
+        BmpDecoder  decoder;
+        Color       pixels[4];
+        uint16_t    fileRow = 0U;
+
+        TEST_ASSERT_FALSE(decoder.parseHeader(BMP_FILE, BmpDecoder::HEADER_SIZE - 1U));
+        TEST_ASSERT_TRUE(decoder.parseHeader(BMP_FILE, sizeof(BMP_FILE)));
+        TEST_ASSERT_EQUAL_UINT16(2U, decoder.getWidth());
+        TEST_ASSERT_EQUAL_UINT16(2U, decoder.getHeight());
+        TEST_ASSERT_EQUAL_UINT32(54U, decoder.getDataOffset());
+        TEST_ASSERT_EQUAL_UINT32(8U, decoder.getRowSize());
+
+        for(fileRow = 0U; fileRow < decoder.getHeight(); ++fileRow)
+        {
+            decoder.decodeRow(&BMP_FILE[decoder.getDataOffset() + fileRow * decoder.getRowSize()],
+                &pixels[decoder.getY(fileRow) * decoder.getWidth()]);
+        }
+
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, pixels[0]);
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::WHITE, pixels[1]);
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, pixels[2]);
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, pixels[3]);
+    }
+
+    /* Images in the image cache are shared and reference counted. */
+    {
+        ImageCache&     cache       = ImageCache::getInstance();
+        IndexedImage*   cachedImage = new IndexedImage();
+        IndexedImage*   otherImage  = new IndexedImage();
+
+        TEST_ASSERT_TRUE(cachedImage->set(bitmap, 2U, 2U));
+        TEST_ASSERT_TRUE(otherImage->set(bitmap, 2U, 2U));
+
+        TEST_ASSERT_NULL(cache.acquire("/test.bmp"));
+        TEST_ASSERT_TRUE(cache.add("/test.bmp", cachedImage));
+        TEST_ASSERT_EQUAL_PTR(cachedImage, cache.acquire("/test.bmp"));
+
+        /* Unused images stay in the cache. */
+        cache.release(cachedImage);
+        cache.release(cachedImage);
+        TEST_ASSERT_EQUAL_PTR(cachedImage, cache.acquire("/test.bmp"));
+
+        /* An invalidated image is not provided anymore, but still usable by its users. */
+        cache.invalidate("/test.bmp");
+        TEST_ASSERT_NULL(cache.acquire("/test.bmp"));
+        TEST_ASSERT_TRUE(cache.add("/test.bmp", otherImage));
+        TEST_ASSERT_EQUAL_PTR(otherImage, cache.acquire("/test.bmp"));
+        cache.release(cachedImage);
+        cache.release(otherImage);
+        cache.release(otherImage);
+        cache.clear();
+        TEST_ASSERT_NULL(cache.acquire("/test.bmp"));
+    }
+
+    /* Images of the asset pack are provided without copy. */
+    {
+        AssetPack&  pack        = AssetPack::getInstance();
+        uint32_t    packBuffer[25U];
+        uint8_t*    packData    = reinterpret_cast<uint8_t*>(packBuffer);
+        const char  PACK_HEADER[AssetPack::HEADER_SIZE] = { 'P', 'X', 'A', 'P', 1, 0, 2, 0 };
+
+        memset(packBuffer, 0, sizeof(packBuffer));
+        memcpy(packData, PACK_HEADER, sizeof(PACK_HEADER));
+
+        /* 1. entry: 1x1 pixel at offset 88 */
+        strcpy(reinterpret_cast<char*>(&packData[8U]), "/a.bmp");
+        packData[8U + AssetPack::NAME_SIZE + 0U] = 1U;
+        packData[8U + AssetPack::NAME_SIZE + 2U] = 1U;
+        packData[8U + AssetPack::NAME_SIZE + 4U] = 88U;
+
+        /* 2. entry: 2x1 pixel at offset 92 */
+        strcpy(reinterpret_cast<char*>(&packData[48U]), "/b.bmp");
+        packData[48U + AssetPack::NAME_SIZE + 0U] = 2U;
+        packData[48U + AssetPack::NAME_SIZE + 2U] = 1U;
+        packData[48U + AssetPack::NAME_SIZE + 4U] = 92U;
+
+        /* Image data: red, green, blue and intensity per pixel */
+        packData[88U] = 0xFFU;
+        packData[91U] = 0xFFU;
+        packData[93U] = 0xFFU;
+        packData[95U] = 0xFFU;
+
+        /* The image data must be inside the pack. */
+        TEST_ASSERT_FALSE(pack.attach(packData, sizeof(packBuffer) - 1U));
+        TEST_ASSERT_TRUE(pack.attach(packData, sizeof(packBuffer)));
+        TEST_ASSERT_EQUAL_UINT16(2U, pack.getCount());
+
+        TEST_ASSERT_EQUAL_PTR(&packData[92U], pack.find("/b.bmp", width, height));
+        TEST_ASSERT_EQUAL_UINT16(2U, width);
+        TEST_ASSERT_EQUAL_UINT16(1U, height);
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, *pack.find("/b.bmp", width, height));
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, *pack.find("/a.bmp", width, height));
+        TEST_ASSERT_NULL(pack.find("/c.bmp", width, height));
+        TEST_ASSERT_TRUE(pack.contains(reinterpret_cast<const Color*>(&packData[88U])));
+
+        /* The entries must be sorted by name. */
+        packData[9U] = 'c';
+        TEST_ASSERT_FALSE(pack.attach(packData, sizeof(packBuffer)));
+        TEST_ASSERT_EQUAL_UINT16(0U, pack.getCount());
+        TEST_ASSERT_NULL(pack.find("/b.bmp", width, height));
+
+        pack.detach();
+    }
+
+    return;
+}
+
+/**
+ * Test sprite widget.
+ */
+static void testSpriteWidget()
+{
+    const uint16_t  FRAME_SIZE      = 4U;
+    const uint16_t  FRAME_COUNT     = 3U;
+    const uint16_t  SHEET_WIDTH     = FRAME_SIZE * FRAME_COUNT;
+    const uint32_t  FRAME_DURATION  = 50U;
+
+    TestGfx         testGfx;
+    Canvas          canvas(TestGfx::WIDTH, TestGfx::HEIGHT, 0, 0);
+    SpriteWidget    spriteWidget;
+    Color           sheet[SHEET_WIDTH * FRAME_SIZE];
+    Color           manyColors[IndexedImage::MAX_PALETTE_SIZE + 1U];
+    NativeClock&    nativeClock     = getNativeClock();
+    uint16_t        x               = 0U;
+    uint16_t        y               = 0U;
+    uint16_t        width           = 0U;
+    uint16_t        height          = 0U;
+    Color*          displayBuffer   = testGfx.getBuffer();
+
+    /* Verify widget type name */
+    TEST_ASSERT_EQUAL_STRING(SpriteWidget::WIDGET_TYPE, spriteWidget.getType());
+
+    /* Empty sprite draws nothing. */
+    TEST_ASSERT_EQUAL_UINT16(0U, spriteWidget.getFrameCount());
+    TEST_ASSERT_TRUE(canvas.addWidget(spriteWidget));
+    canvas.update(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(0U, displayBuffer[0]);
+
+    /* Every frame is filled with its own color, the first pixel of each row is white. */
+    for(y = 0U; y < FRAME_SIZE; ++y)
+    {
+        for(x = 0U; x < SHEET_WIDTH; ++x)
+        {
+            if (0U == (x % FRAME_SIZE))
+            {
+                sheet[x + y * SHEET_WIDTH] = ColorDef::WHITE;
+            }
+            else
+            {
+                sheet[x + y * SHEET_WIDTH] = 1U + (x / FRAME_SIZE);
+            }
+        }
+    }
+
+    /* Invalid frame width */
+    TEST_ASSERT_FALSE(spriteWidget.set(sheet, SHEET_WIDTH, FRAME_SIZE, FRAME_SIZE + 1U));
+    TEST_ASSERT_FALSE(spriteWidget.set(sheet, SHEET_WIDTH, FRAME_SIZE, 0U));
+    TEST_ASSERT_EQUAL_UINT16(0U, spriteWidget.getFrameCount());
+
+    nativeClock.isFixed = true;
+    nativeClock.now     = 1000UL;
+
+    TEST_ASSERT_TRUE(spriteWidget.set(sheet, SHEET_WIDTH, FRAME_SIZE, FRAME_SIZE));
+    spriteWidget.setFrameDuration(FRAME_DURATION);
+    TEST_ASSERT_EQUAL_UINT16(FRAME_COUNT, spriteWidget.getFrameCount());
+    TEST_ASSERT_EQUAL_UINT16(FRAME_COUNT + 1U, spriteWidget.getImage()->getPaletteSize());
+    spriteWidget.getFrameSize(width, height);
+    TEST_ASSERT_EQUAL_UINT16(FRAME_SIZE, width);
+    TEST_ASSERT_EQUAL_UINT16(FRAME_SIZE, height);
+    TEST_ASSERT_TRUE(spriteWidget.isInvalid());
+
+    /* First frame */
+    canvas.update(testGfx);
+    TEST_ASSERT_FALSE(spriteWidget.isInvalid());
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(ColorDef::WHITE), displayBuffer[0]);
+    TEST_ASSERT_EQUAL_UINT32(1U, displayBuffer[1]);
+    TEST_ASSERT_EQUAL_UINT32(1U, displayBuffer[(FRAME_SIZE - 1U) + (FRAME_SIZE - 1U) * TestGfx::WIDTH]);
+    TEST_ASSERT_EQUAL_UINT32(0U, displayBuffer[FRAME_SIZE]);
+
+    /* Frame is still shown until its duration elapsed. */
+    nativeClock.now += FRAME_DURATION - 1U;
+    TEST_ASSERT_FALSE(spriteWidget.isInvalid());
+
+    /* Next frame */
+    nativeClock.now += 1U;
+    TEST_ASSERT_TRUE(spriteWidget.isInvalid());
+    canvas.update(testGfx);
+    TEST_ASSERT_FALSE(spriteWidget.isInvalid());
+    TEST_ASSERT_EQUAL_UINT32(2U, displayBuffer[1]);
+
+    /* After the last frame, the animation starts again with the first one. */
+    nativeClock.now += FRAME_DURATION * (FRAME_COUNT - 1U);
+    canvas.update(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(1U, displayBuffer[1]);
+
+    /* Copy is independent of the source. */
+    {
+        SpriteWidget copy(spriteWidget);
+
+        spriteWidget.clear();
+        TEST_ASSERT_EQUAL_UINT16(0U, spriteWidget.getFrameCount());
+        TEST_ASSERT_EQUAL_UINT16(FRAME_COUNT, copy.getFrameCount());
+        TEST_ASSERT_EQUAL_UINT32(FRAME_DURATION, copy.getFrameDuration());
+
+        nativeClock.now += FRAME_DURATION;
+        copy.update(testGfx);
+        TEST_ASSERT_EQUAL_UINT32(2U, displayBuffer[1]);
+
+        spriteWidget = copy;
+        TEST_ASSERT_EQUAL_UINT16(FRAME_COUNT, spriteWidget.getFrameCount());
+    }
+
+    /* A single frame is not animated. */
+    TEST_ASSERT_TRUE(spriteWidget.set(sheet, FRAME_SIZE, 1U, FRAME_SIZE));
+    TEST_ASSERT_EQUAL_UINT16(1U, spriteWidget.getFrameCount());
+    canvas.update(testGfx);
+    nativeClock.now += FRAME_DURATION * 10U;
+    TEST_ASSERT_FALSE(spriteWidget.isInvalid());
+
+    /* Too many colors for the palette, the previous sprite is kept. */
+    for(x = 0U; x < UTIL_ARRAY_NUM(manyColors); ++x)
+    {
+        manyColors[x] = x;
+    }
+    TEST_ASSERT_FALSE(spriteWidget.set(manyColors, UTIL_ARRAY_NUM(manyColors), 1U, 1U));
+    TEST_ASSERT_EQUAL_UINT16(1U, spriteWidget.getFrameCount());
+
+    nativeClock.isFixed = false;
+
+    return;
+}
+
+/**
+ * Test ticker widget.
+ */
+static void testTickerWidget()
+{
+    const uint16_t  SEGMENT_WIDTH   = 4U;
+    const uint16_t  GAP_WIDTH       = TestGfx::WIDTH - SEGMENT_WIDTH;
+    const Color     COLOR_FIRST     = 0x000010U;
+    const Color     COLOR_LAST      = 0x001000U;
+
+    TestGfx         testGfx;
+    CanvasView      view(testGfx, 0, 0, TestGfx::WIDTH, TestGfx::HEIGHT);
+    TickerWidget    tickerWidget(TestGfx::HEIGHT);
+    Color           first[SEGMENT_WIDTH * TestGfx::HEIGHT];
+    Color           last[SEGMENT_WIDTH * TestGfx::HEIGHT];
+    NativeClock&    nativeClock     = getNativeClock();
+    const uint32_t  PAUSE           = TextWidget::getScrollPause();
+    uint16_t        index           = 0U;
+    Color*          displayBuffer   = testGfx.getBuffer();
+
+    /* Verify widget type name */
+    TEST_ASSERT_EQUAL_STRING(TickerWidget::WIDGET_TYPE, tickerWidget.getType());
+
+    for(index = 0U; index < UTIL_ARRAY_NUM(first); ++index)
+    {
+        first[index]    = COLOR_FIRST;
+        last[index]     = COLOR_LAST;
+    }
+
+    /* Invalid segments */
+    TEST_ASSERT_FALSE(tickerWidget.appendGap(0U));
+    TEST_ASSERT_FALSE(tickerWidget.appendBitmap(nullptr, SEGMENT_WIDTH, TestGfx::HEIGHT));
+    TEST_ASSERT_FALSE(tickerWidget.appendText(""));
+    TEST_ASSERT_FALSE(tickerWidget.appendGap(TickerWidget::MAX_STRIP_WIDTH + 1U));
+    TEST_ASSERT_EQUAL_UINT16(0U, tickerWidget.getStripWidth());
+
+    nativeClock.isFixed = true;
+    nativeClock.now     = 0UL;
+
+    /* Strip, which fits into the graphics, doesn't scroll. */
+    TEST_ASSERT_TRUE(tickerWidget.appendBitmap(first, SEGMENT_WIDTH, TestGfx::HEIGHT));
+    TEST_ASSERT_TRUE(tickerWidget.isInvalid());
+    TEST_ASSERT_TRUE(view.drawWidget(tickerWidget));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_FIRST), displayBuffer[0]);
+    nativeClock.now += PAUSE * 10U;
+    TEST_ASSERT_FALSE(tickerWidget.isInvalid());
+
+    /* Wider strip scrolls one pixel per scroll pause. */
+    TEST_ASSERT_TRUE(tickerWidget.appendGap(GAP_WIDTH));
+    TEST_ASSERT_TRUE(tickerWidget.appendBitmap(last, SEGMENT_WIDTH, TestGfx::HEIGHT));
+    TEST_ASSERT_EQUAL_UINT16(TestGfx::WIDTH + SEGMENT_WIDTH, tickerWidget.getStripWidth());
+
+    nativeClock.now = 0UL;
+    TEST_ASSERT_TRUE(view.drawWidget(tickerWidget));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_FIRST), displayBuffer[SEGMENT_WIDTH - 1U]);
+    TEST_ASSERT_EQUAL_UINT32(0U, displayBuffer[TestGfx::WIDTH - 1U]);
+
+    nativeClock.now = PAUSE - 1U;
+    TEST_ASSERT_FALSE(tickerWidget.isInvalid());
+
+    nativeClock.now = PAUSE * SEGMENT_WIDTH;
+    TEST_ASSERT_TRUE(tickerWidget.isInvalid());
+    TEST_ASSERT_TRUE(view.drawWidget(tickerWidget));
+    TEST_ASSERT_EQUAL_UINT32(0U, displayBuffer[0]);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_LAST), displayBuffer[GAP_WIDTH]);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_LAST), displayBuffer[TestGfx::WIDTH - 1U + (TestGfx::HEIGHT - 1U) * TestGfx::WIDTH]);
+
+    /* After the last segment, the strip continues with the first one. */
+    nativeClock.now = PAUSE * (SEGMENT_WIDTH + 2U);
+    TEST_ASSERT_TRUE(view.drawWidget(tickerWidget));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_LAST), displayBuffer[GAP_WIDTH - 2U]);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_FIRST), displayBuffer[TestGfx::WIDTH - 2U]);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_FIRST), displayBuffer[TestGfx::WIDTH - 1U]);
+    TEST_ASSERT_EQUAL_UINT32(0U, tickerWidget.getScrollingCnt());
+
+    nativeClock.now = PAUSE * tickerWidget.getStripWidth();
+    TEST_ASSERT_TRUE(view.drawWidget(tickerWidget));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR_FIRST), displayBuffer[0]);
+    TEST_ASSERT_EQUAL_UINT32(1U, tickerWidget.getScrollingCnt());
+
+    /* Text segment */
+    TEST_ASSERT_TRUE(tickerWidget.appendText("Hi", ColorDef::RED));
+    TEST_ASSERT_EQUAL_UINT16(TestGfx::WIDTH + SEGMENT_WIDTH + GlyphMetrics::getInstance().getTextWidth(tickerWidget.getFont(), "Hi"), tickerWidget.getStripWidth());
+    TEST_ASSERT_EQUAL_UINT32(0U, tickerWidget.getScrollingCnt());
+
+    tickerWidget.clear();
+    TEST_ASSERT_EQUAL_UINT16(0U, tickerWidget.getStripWidth());
+
+    nativeClock.isFixed = false;
+
     return;
 }
 
@@ -1324,12 +2634,12 @@ static void testTextWidget()
     /* Verify widget type name */
     TEST_ASSERT_EQUAL_STRING(TextWidget::WIDGET_TYPE, textWidget.getType());
 
-    /* No widget name is set, it must be empty. */
-    TEST_ASSERT_EQUAL_STRING("", textWidget.getName().c_str());
+    /* No widget name is set, it must have no id. */
+    TEST_ASSERT_EQUAL_UINT32(Widget::ID_NONE, textWidget.getId());
 
-    /* Set widget name and read back. */
+    /* Set widget name and read back its id. */
     textWidget.setName(WIDGET_NAME);
-    TEST_ASSERT_EQUAL_STRING(WIDGET_NAME, textWidget.getName().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Widget::toId(WIDGET_NAME), textWidget.getId());
 
     /* Find widget with empty name.
      * Expected: Not found
@@ -1381,6 +2691,140 @@ static void testTextWidget()
     textWidget.setFormatStr("\\#FF00FYeah!");
     TEST_ASSERT_EQUAL_STRING("#FF00FYeah!", textWidget.getStr().c_str());
 
+    /* Set text with font keywords and get text back, which must be without them. */
+    textWidget.setFormatStr("\\flargeBig\\fsmallSmall");
+    TEST_ASSERT_EQUAL_STRING("BigSmall", textWidget.getStr().c_str());
+
+    /* Set text with escaped escape and get text back, which must contain one escape. */
+    textWidget.setFormatStr("C:\\\\temp");
+    TEST_ASSERT_EQUAL_STRING("C:\\temp", textWidget.getStr().c_str());
+
+    /* Set text with more format tags than spans and get text back, which must be complete. */
+    textWidget.setFormatStr("\\#000001a\\#000002b\\#000003c\\#000004d\\#000005e\\#000006f\\#000007g\\#000008h\\#000009i\\#00000Aj");
+    TEST_ASSERT_EQUAL_STRING("abcdefghij", textWidget.getStr().c_str());
+
+    /* A copied text widget contains the same text. */
+    {
+        TextWidget copiedTextWidget(textWidget);
+
+        TEST_ASSERT_EQUAL_STRING("abcdefghij", copiedTextWidget.getStr().c_str());
+    }
+
+    /* The rendered text layout must look like the directly drawn text
+     * and the background must be kept.
+     */
+    {
+        TestGfx         refGfx;
+        TestGfx         layoutGfx;
+        const Color     BACKGROUND  = 0x000011;
+        const uint32_t  TEXT_RGB    = 0x00ff00;
+        int16_t         x           = 0;
+        int16_t         y           = 0;
+
+        refGfx.fill(BACKGROUND);
+        refGfx.setFont(TextWidget::DEFAULT_FONT);
+        refGfx.setTextColor(TEXT_RGB);
+        refGfx.setTextCursorPos(0, TextWidget::DEFAULT_FONT->yAdvance - 1);
+        refGfx.drawText("Hi!");
+
+        textWidget.setFormatStr("\\#00FF00Hi!");
+        layoutGfx.fill(BACKGROUND);
+        textWidget.update(layoutGfx);
+
+        for(y = 0; y < TestGfx::HEIGHT; ++y)
+        {
+            for(x = 0; x < TestGfx::WIDTH; ++x)
+            {
+                TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(refGfx.getColor(x, y)), static_cast<uint32_t>(layoutGfx.getColor(x, y)));
+            }
+        }
+
+        /* Update it again, with the cached layout. */
+        layoutGfx.fill(BACKGROUND);
+        textWidget.update(layoutGfx);
+
+        for(y = 0; y < TestGfx::HEIGHT; ++y)
+        {
+            for(x = 0; x < TestGfx::WIDTH; ++x)
+            {
+                TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(refGfx.getColor(x, y)), static_cast<uint32_t>(layoutGfx.getColor(x, y)));
+            }
+        }
+    }
+
+    /* A text, which is several times wider than the canvas, is rendered in
+     * windows. Every part of it must look like the directly drawn text,
+     * especially where runs cross the window borders.
+     */
+    {
+        const uint16_t  SPAN_WIDTH  = 1000U;
+        const uint16_t  OFFSETS[]   = { 0U, TestGfx::WIDTH - 1U, 2U * TestGfx::WIDTH + 3U, 5U * TestGfx::WIDTH };
+        const Color     BACKGROUND  = 0x000011;
+        uint8_t         index       = 0U;
+
+        textWidget.setScrollMode(TextWidget::SCROLL_MODE_SMOOTH);
+        textWidget.setFormatStr("\\#00FF00A long ---- text \\#FF0000in two ____ colors, wider than the canvas.");
+
+        for(index = 0U; index < UTIL_ARRAY_NUM(OFFSETS); ++index)
+        {
+            TestGfx refGfx;
+            TestGfx layoutGfx;
+            int16_t x       = 0;
+            int16_t y       = 0;
+
+            refGfx.fill(BACKGROUND);
+            refGfx.setFont(TextWidget::DEFAULT_FONT);
+            refGfx.setTextColor(0x00ff00);
+            refGfx.setTextCursorPos(-static_cast<int16_t>(OFFSETS[index]), TextWidget::DEFAULT_FONT->yAdvance - 1);
+            refGfx.drawText("A long ---- text ");
+            refGfx.setTextColor(0xff0000);
+            refGfx.drawText("in two ____ colors, wider than the canvas.");
+
+            TextWidget::setSpan(SPAN_WIDTH, OFFSETS[index]);
+            layoutGfx.fill(BACKGROUND);
+            textWidget.update(layoutGfx);
+
+            for(y = 0; y < TestGfx::HEIGHT; ++y)
+            {
+                for(x = 0; x < TestGfx::WIDTH; ++x)
+                {
+                    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(refGfx.getColor(x, y)), static_cast<uint32_t>(layoutGfx.getColor(x, y)));
+                }
+            }
+        }
+
+        TextWidget::setSpan(0U, 0U);
+        textWidget.setScrollMode(TextWidget::DEFAULT_SCROLL_MODE);
+    }
+
+    /* A text, which doesn't fit into the canvas, must be scrolled in every scroll mode. */
+    {
+        TestGfx     scrollGfx;
+        bool        isScrollingEnabled  = false;
+        uint32_t    scrollingCnt        = 0U;
+
+        textWidget.setFormatStr("This text is too long for the canvas.");
+        TEST_ASSERT_FALSE(textWidget.getScrollInfo(isScrollingEnabled, scrollingCnt));
+
+        TEST_ASSERT_EQUAL(TextWidget::DEFAULT_SCROLL_MODE, textWidget.getScrollMode());
+        textWidget.update(scrollGfx);
+        TEST_ASSERT_TRUE(textWidget.getScrollInfo(isScrollingEnabled, scrollingCnt));
+        TEST_ASSERT_TRUE(isScrollingEnabled);
+        TEST_ASSERT_EQUAL_UINT32(0U, scrollingCnt);
+
+        textWidget.setScrollMode(TextWidget::SCROLL_MODE_SMOOTH_ANTIALIASED);
+        TEST_ASSERT_EQUAL(TextWidget::SCROLL_MODE_SMOOTH_ANTIALIASED, textWidget.getScrollMode());
+        TEST_ASSERT_FALSE(textWidget.getScrollInfo(isScrollingEnabled, scrollingCnt));
+        textWidget.update(scrollGfx);
+        TEST_ASSERT_TRUE(textWidget.getScrollInfo(isScrollingEnabled, scrollingCnt));
+        TEST_ASSERT_TRUE(isScrollingEnabled);
+
+        textWidget.setScrollMode(TextWidget::SCROLL_MODE_PIXEL);
+        textWidget.update(scrollGfx);
+        TEST_ASSERT_TRUE(textWidget.getScrollInfo(isScrollingEnabled, scrollingCnt));
+        TEST_ASSERT_TRUE(isScrollingEnabled);
+    }
+
     return;
 }
 
@@ -1452,71 +2896,454 @@ static void testColor()
     TEST_ASSERT_EQUAL_UINT8(0xc8u, myColorA.getGreen());
     TEST_ASSERT_EQUAL_UINT8(0xc8u, myColorA.getBlue());
 
+    /* Color wheel runs from red over blue and green back to red. */
+    myColorA.turnColorWheel(0U);
+    TEST_ASSERT_EQUAL_UINT32(0x00ff0000u, myColorA);
+    myColorA.turnColorWheel(1U);
+    TEST_ASSERT_EQUAL_UINT32(0x00fc0300u, myColorA);
+    myColorA.turnColorWheel(85U);
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff00u, myColorA);
+    myColorA.turnColorWheel(170U);
+    TEST_ASSERT_EQUAL_UINT32(0x000000ffu, myColorA);
+    myColorA.turnColorWheel(255U);
+    TEST_ASSERT_EQUAL_UINT32(0x00ff0000u, myColorA);
+
+    /* HSV to RGB */
+    myColorA.setHsv(0U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT32(0x00ff0000u, myColorA);
+    myColorA.setHsv(86U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT8(0x00u, myColorA.getRed());
+    TEST_ASSERT_EQUAL_UINT8(0xffu, myColorA.getGreen());
+    myColorA.setHsv(170U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT8(0x00u, myColorA.getRed());
+    TEST_ASSERT_EQUAL_UINT8(0xffu, myColorA.getBlue());
+    myColorA.setHsv(123U, 0U, 200U);
+    TEST_ASSERT_EQUAL_UINT32(0x00c8c8c8u, myColorA);
+    myColorA.setHsv(42U, 255U, 0U);
+    TEST_ASSERT_EQUAL_UINT32(0u, myColorA);
+
     return;
 }
 
 /**
- * Test the abstract state machine.
+ * Test the color gradient.
  */
-static void testStateMachine()
+static void testGradient()
 {
-    TestState       stateA;
-    TestState       stateB;
-    StateMachine    sm;
-
-    /* State machine has no state yet. */
-    TEST_ASSERT_NULL(sm.getState());
-
-    /* Add state A, but don't process it. */
-    sm.setState(stateA);
-    TEST_ASSERT_NULL(sm.getState());
-    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntEntry());
-    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntExit());
-
-    /* Process it once.
-     * Expectation:
-     * The entry part is called once and the process part.
-     */
-    sm.process();
-    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntEntry());
-    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntExit());
-    TEST_ASSERT_EQUAL_PTR(static_cast<AbstractState*>(&stateA), sm.getState());
-
-    /* Process it a 2nd time.
-     * Expectation:
-     * Only the process part is called.
-     */
-    sm.process();
-    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntEntry());
-    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntExit());
-
-    /* Transistion from A to B. */
-    stateA.setState(stateB);
-    sm.process();
-    sm.process();
-    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntEntry());
-    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntExit());
-    TEST_ASSERT_EQUAL_UINT32(1u, stateB.getCallCntEntry());
-    TEST_ASSERT_EQUAL_UINT32(0u, stateB.getCallCntExit());
-
-    /* Transistion from B to A. */
-    stateB.setState(stateA);
-    sm.process();
-    sm.process();
-    TEST_ASSERT_EQUAL_UINT32(2u, stateA.getCallCntEntry());
-    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntExit());
-    TEST_ASSERT_EQUAL_UINT32(1u, stateB.getCallCntEntry());
-    TEST_ASSERT_EQUAL_UINT32(1u, stateB.getCallCntExit());
+    const Gradient::Stop    STOPS[] =
+    {
+        {  64U, 0x00000000U },
+        { 192U, 0x00ff8000U }
+    };
+    Gradient                gradient;
+    TestGfx                 gfx;
+    Color                   colors[4U];
+
+    /* Default is black. */
+    TEST_ASSERT_EQUAL_UINT32(0u, gradient.get(0U));
+    TEST_ASSERT_EQUAL_UINT32(0u, gradient.get(255U));
+
+    /* Before the first stop and after the last stop its color is used. */
+    gradient.set(STOPS, UTIL_ARRAY_NUM(STOPS));
+    TEST_ASSERT_EQUAL_UINT32(0u, gradient.get(0U));
+    TEST_ASSERT_EQUAL_UINT32(0u, gradient.get(64U));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff8000u, gradient.get(192U));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff8000u, gradient.get(255U));
+
+    /* Linear interpolation between the stops. */
+    TEST_ASSERT_EQUAL_UINT32(0x007f4000u, gradient.get(128U));
+
+    /* Fill forward and backward. */
+    gradient.fill(colors, UTIL_ARRAY_NUM(colors), 64U, 192U);
+    TEST_ASSERT_EQUAL_UINT32(0u, colors[0U]);
+    TEST_ASSERT_EQUAL_UINT32(0x00ff8000u, colors[3U]);
+
+    gradient.fill(colors, UTIL_ARRAY_NUM(colors), 192U, 64U);
+    TEST_ASSERT_EQUAL_UINT32(0x00ff8000u, colors[0U]);
+    TEST_ASSERT_EQUAL_UINT32(0u, colors[3U]);
+
+    /* Write a span, which is clipped at the right border. */
+    gradient.writeSpan(gfx, gfx.getWidth() - 2, 1, 4U, 192U, 192U);
+    TEST_ASSERT_EQUAL_UINT32(0u, gfx.getColor(gfx.getWidth() - 3, 1));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff8000u, gfx.getColor(gfx.getWidth() - 2, 1));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff8000u, gfx.getColor(gfx.getWidth() - 1, 1));
+
+    /* No stops results in black. */
+    gradient.set(nullptr, 0U);
+    TEST_ASSERT_EQUAL_UINT32(0u, gradient.get(255U));
 
     return;
 }
 
 /**
- * Test simple timer.
+ * Test the run-length encoded bitmap.
  */
-static void testSimpleTimer()
+static void testRleBitmap()
 {
-    SimpleTimer testTimer;
+    const uint32_t  PALETTE[]   = { 0x00ff0000U, 0x0000ff00U };
+    /* 4 x 2 pixels: red, transparent, 2x green / 4x transparent */
+    const uint8_t   RUNS[]      = { 0x20U, 0x00U, 0x41U, 0x03U };
+    const RleBitmap BITMAP      = { 4U, 2U, PALETTE, UTIL_ARRAY_NUM(PALETTE), RUNS, sizeof(RUNS) };
+    TestGfx         gfx;
+
+    gfx.fill(ColorDef::BLUE);
+
+    BITMAP.draw(gfx, 1, 1);
+    TEST_ASSERT_EQUAL_UINT32(0x00ff0000u, gfx.getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, gfx.getColor(2, 1));
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff00u, gfx.getColor(3, 1));
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff00u, gfx.getColor(4, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, gfx.getColor(5, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, gfx.getColor(1, 2));
+
+    /* Partly outside the canvas, the pixels are clipped. */
+    gfx.fill(ColorDef::BLUE);
+    BITMAP.draw(gfx, -2, 0);
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff00u, gfx.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff00u, gfx.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, gfx.getColor(2, 0));
+
+    return;
+}
+
+/**
+ * Test the fade effect kernels.
+ */
+static void testFadeKernel()
+{
+    TestGfx     dst;
+    TestGfx     src1;
+    TestGfx     src2;
+    const Color COLOR1(200U, 100U, 0U);
+    const Color COLOR2(0U, 100U, 200U);
+    Color       color;
+    int16_t     x       = 0;
+
+    src1.fillScreen(COLOR1);
+    src2.fillScreen(COLOR2);
+
+    /* Dim to half intensity, the source must not be modified. */
+    FadeKernel::dim(dst, src1, 128U);
+    color = dst.getColor(0, 0);
+    TEST_ASSERT_EQUAL_UINT8(100U, color.getRed());
+    TEST_ASSERT_EQUAL_UINT8(50U, color.getGreen());
+    TEST_ASSERT_EQUAL_UINT8(0U, color.getBlue());
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR1), static_cast<uint32_t>(src1.getColor(0, 0)));
+
+    /* Blend ratio 0 results in the first source only. */
+    FadeKernel::blend(dst, src1, src2, 0U);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR1), static_cast<uint32_t>(dst.getColor(TestGfx::WIDTH - 1, TestGfx::HEIGHT - 1)));
+
+    /* Blend ratio 255 results in the second source only. */
+    FadeKernel::blend(dst, src1, src2, 255U);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR2), static_cast<uint32_t>(dst.getColor(TestGfx::WIDTH - 1, TestGfx::HEIGHT - 1)));
+
+    /* Blend nearly half/half, the ratio is mapped to [0; 256] internally. */
+    FadeKernel::blend(dst, src1, src2, 128U);
+    color = dst.getColor(1, 1);
+    TEST_ASSERT_EQUAL_UINT8(99U, color.getRed());
+    TEST_ASSERT_EQUAL_UINT8(100U, color.getGreen());
+    TEST_ASSERT_EQUAL_UINT8(100U, color.getBlue());
+
+    /* Wipe: Left of the edge the second source, at and right of it the first source. */
+    FadeKernel::wipeX(dst, src1, src2, 2);
+    for(x = 0; x < TestGfx::WIDTH; ++x)
+    {
+        if (2 > x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR2), static_cast<uint32_t>(dst.getColor(x, 0)));
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR1), static_cast<uint32_t>(dst.getColor(x, 0)));
+        }
+    }
+
+    /* Wipe edge outside the framebuffer */
+    FadeKernel::wipeX(dst, src1, src2, TestGfx::WIDTH + 1);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR2), static_cast<uint32_t>(dst.getColor(TestGfx::WIDTH - 1, 0)));
+
+    /* The kernels specialized on the geometry shall give the same results. */
+    FadeKernel::useFixedGeometry<TestGfx::WIDTH, TestGfx::HEIGHT>();
+
+    FadeKernel::dim(dst, src1, 128U);
+    color = dst.getColor(TestGfx::WIDTH - 1, TestGfx::HEIGHT - 1);
+    TEST_ASSERT_EQUAL_UINT8(100U, color.getRed());
+    TEST_ASSERT_EQUAL_UINT8(50U, color.getGreen());
+    TEST_ASSERT_EQUAL_UINT8(0U, color.getBlue());
+
+    FadeKernel::blend(dst, src1, src2, 128U);
+    color = dst.getColor(1, 1);
+    TEST_ASSERT_EQUAL_UINT8(99U, color.getRed());
+    TEST_ASSERT_EQUAL_UINT8(100U, color.getGreen());
+    TEST_ASSERT_EQUAL_UINT8(100U, color.getBlue());
+
+    FadeKernel::wipeX(dst, src1, src2, 2);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR2), static_cast<uint32_t>(dst.getColor(1, 0)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR1), static_cast<uint32_t>(dst.getColor(2, 0)));
+
+    FadeKernel::setFixedKernels(nullptr);
+
+    return;
+}
+
+/**
+ * Test the time based fade progress.
+ */
+static void testFadeTimer()
+{
+    const uint32_t  DURATION    = 1000U;
+    NativeClock&    nativeClock = getNativeClock();
+    FadeTimer       fadeTimer(DURATION, FadeTimer::EASING_LINEAR);
+    FadeWipeX       fadeWipeX(DURATION, FadeTimer::EASING_LINEAR);
+    TestGfx         gfx;
+    TestGfx         prev;
+    TestGfx         next;
+
+    nativeClock.isFixed = true;
+    nativeClock.now     = 5000UL;
+
+    /* Progress follows the elapsed time. */
+    fadeTimer.start();
+    TEST_ASSERT_EQUAL_UINT8(FadeTimer::PROGRESS_MIN, fadeTimer.getProgress());
+    TEST_ASSERT_FALSE(fadeTimer.isFinished());
+    nativeClock.now += DURATION / 2U;
+    TEST_ASSERT_EQUAL_UINT8(127U, fadeTimer.getProgress());
+    nativeClock.now += DURATION;
+    TEST_ASSERT_EQUAL_UINT8(FadeTimer::PROGRESS_MAX, fadeTimer.getProgress());
+    TEST_ASSERT_TRUE(fadeTimer.isFinished());
+
+    /* Easing curves keep the start and end points. */
+    TEST_ASSERT_EQUAL_UINT8(0U, FadeTimer::ease(FadeTimer::EASING_IN, 0U));
+    TEST_ASSERT_EQUAL_UINT8(255U, FadeTimer::ease(FadeTimer::EASING_IN, 255U));
+    TEST_ASSERT_EQUAL_UINT8(64U, FadeTimer::ease(FadeTimer::EASING_IN, 128U));
+    TEST_ASSERT_EQUAL_UINT8(0U, FadeTimer::ease(FadeTimer::EASING_OUT, 0U));
+    TEST_ASSERT_EQUAL_UINT8(255U, FadeTimer::ease(FadeTimer::EASING_OUT, 255U));
+    TEST_ASSERT_EQUAL_UINT8(192U, FadeTimer::ease(FadeTimer::EASING_OUT, 128U));
+    TEST_ASSERT_EQUAL_UINT8(0U, FadeTimer::ease(FadeTimer::EASING_IN_OUT, 0U));
+    TEST_ASSERT_EQUAL_UINT8(255U, FadeTimer::ease(FadeTimer::EASING_IN_OUT, 255U));
+    TEST_ASSERT_EQUAL_UINT8(128U, FadeTimer::ease(FadeTimer::EASING_IN_OUT, 128U));
+
+    /* No duration means, the fade effect is complete immediately. */
+    fadeTimer.setDuration(0U);
+    fadeTimer.start();
+    TEST_ASSERT_TRUE(fadeTimer.isFinished());
+    TEST_ASSERT_EQUAL_UINT8(FadeTimer::PROGRESS_MAX, fadeTimer.getProgress());
+
+    /* A fade effect stays on schedule, even if frames are dropped. */
+    prev.fillScreen(ColorDef::RED);
+    next.fillScreen(ColorDef::BLUE);
+    TEST_ASSERT_FALSE(fadeWipeX.fadeOut(gfx, prev, next));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(ColorDef::RED)), static_cast<uint32_t>(gfx.getColor(0, 0)));
+    nativeClock.now += DURATION / 2U;
+    TEST_ASSERT_FALSE(fadeWipeX.fadeOut(gfx, prev, next));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(ColorDef::BLUE)), static_cast<uint32_t>(gfx.getColor(TestGfx::WIDTH / 2 - 2, 0)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(ColorDef::RED)), static_cast<uint32_t>(gfx.getColor(TestGfx::WIDTH / 2, 0)));
+    nativeClock.now += DURATION;
+    TEST_ASSERT_TRUE(fadeWipeX.fadeOut(gfx, prev, next));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(ColorDef::BLUE)), static_cast<uint32_t>(gfx.getColor(TestGfx::WIDTH - 1, 0)));
+
+    nativeClock.isFixed = false;
+
+    return;
+}
+
+/**
+ * Test the pixel span kernels.
+ */
+static void testPixelKernel()
+{
+    const uint32_t  PIXELS1[]   = { 0x00000000U, 0x00ffffffU, 0x00c86400U, 0x00804020U, 0x007f8081U, 0x0001fe10U };
+    const uint32_t  PIXELS2[]   = { 0x00ffffffU, 0x00ffffffU, 0x000064c8U, 0x00808080U, 0x00818080U, 0x00ff02f0U };
+    const uint16_t  LENGTH      = UTIL_ARRAY_NUM(PIXELS1);
+    uint32_t        reference[LENGTH];
+    uint32_t        packed[LENGTH];
+    uint16_t        factor      = 0U;
+    uint16_t        index       = 0U;
+
+    /* Scale factor 255 means no change, 0 means black. */
+    PixelKernel::scale(reference, PIXELS1, LENGTH, 255U);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(PIXELS1, reference, LENGTH);
+    PixelKernel::scale(reference, PIXELS1, LENGTH, 0U);
+    TEST_ASSERT_EQUAL_UINT32(0U, reference[1]);
+
+    /* Scale to half */
+    PixelKernel::scale(reference, PIXELS1, LENGTH, 128U);
+    TEST_ASSERT_EQUAL_UINT32(0x00643200U, reference[2]);
+
+    /* Blend ratio 0 results in the first source, 255 in the second source. */
+    PixelKernel::blend(reference, PIXELS1, PIXELS2, LENGTH, 0U);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(PIXELS1, reference, LENGTH);
+    PixelKernel::blend(reference, PIXELS1, PIXELS2, LENGTH, 255U);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(PIXELS2, reference, LENGTH);
+
+    /* Saturated add */
+    for(index = 0U; index < LENGTH; ++index)
+    {
+        reference[index] = PIXELS1[index];
+    }
+    PixelKernel::addSaturated(reference, PIXELS2, LENGTH);
+    TEST_ASSERT_EQUAL_UINT32(0x00ffffffU, reference[0]);
+    TEST_ASSERT_EQUAL_UINT32(0x00ffffffU, reference[1]);
+    TEST_ASSERT_EQUAL_UINT32(0x00c8c8c8U, reference[2]);
+    TEST_ASSERT_EQUAL_UINT32(0x00ffc0a0U, reference[3]);
+    TEST_ASSERT_EQUAL_UINT32(0x00ffffffU, reference[4]);
+    TEST_ASSERT_EQUAL_UINT32(0x00ffffffU, reference[5]);
+
+    /* Fill */
+    PixelKernel::fill(reference, LENGTH, 0x00123456U);
+    TEST_ASSERT_EQUAL_UINT32(0x00123456U, reference[0]);
+    TEST_ASSERT_EQUAL_UINT32(0x00123456U, reference[LENGTH - 1U]);
+
+    /* The packed implementation must deliver bit exact the same results. */
+    for(factor = 0U; factor <= UINT8_MAX; ++factor)
+    {
+        PixelKernel::Reference::scale(reference, PIXELS1, LENGTH, factor);
+        PixelKernel::Packed::scale(packed, PIXELS1, LENGTH, factor);
+        TEST_ASSERT_EQUAL_UINT32_ARRAY(reference, packed, LENGTH);
+
+        PixelKernel::Reference::blend(reference, PIXELS1, PIXELS2, LENGTH, factor);
+        PixelKernel::Packed::blend(packed, PIXELS1, PIXELS2, LENGTH, factor);
+        TEST_ASSERT_EQUAL_UINT32_ARRAY(reference, packed, LENGTH);
+    }
+
+    for(index = 0U; index < LENGTH; ++index)
+    {
+        reference[index] = PIXELS1[index];
+        packed[index]    = PIXELS1[index];
+    }
+    PixelKernel::Reference::addSaturated(reference, PIXELS2, LENGTH);
+    PixelKernel::Packed::addSaturated(packed, PIXELS2, LENGTH);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(reference, packed, LENGTH);
+
+    return;
+}
+
+/**
+ * Test the effect runner.
+ */
+static void testEffectRunner()
+{
+    const uint32_t  TIME        = 42U;
+    TestGfx         testGfx;
+    TestPixelKernel pixelKernel;
+    TestRowKernel   rowKernel;
+    int16_t         x           = 0;
+    int16_t         y           = 0;
+
+    /* Every pixel shall be calculated by the pixel kernel. */
+    EffectRunner::forEachPixel(testGfx, pixelKernel, TIME);
+
+    for(y = 0; y < TestGfx::HEIGHT; ++y)
+    {
+        for(x = 0; x < TestGfx::WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(x, y, TIME)), static_cast<uint32_t>(testGfx.getColor(x, y)));
+        }
+    }
+
+    /* The row kernel shall be called once per span and calculate every pixel once. */
+    rowKernel.callCounter   = 0U;
+    rowKernel.pixelCounter  = 0U;
+    testGfx.fillScreen(ColorDef::BLACK);
+    EffectRunner::forEachRow(testGfx, rowKernel, TIME + 1U);
+
+    TEST_ASSERT_EQUAL_UINT32(TestGfx::HEIGHT * ((TestGfx::WIDTH + EffectRunner::SPAN_LENGTH - 1U) / EffectRunner::SPAN_LENGTH), rowKernel.callCounter);
+    TEST_ASSERT_EQUAL_UINT32(TestGfx::WIDTH * TestGfx::HEIGHT, rowKernel.pixelCounter);
+
+    for(y = 0; y < TestGfx::HEIGHT; ++y)
+    {
+        for(x = 0; x < TestGfx::WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(x, y, TIME + 1U)), static_cast<uint32_t>(testGfx.getColor(x, y)));
+        }
+    }
+
+    /* The geometry specialized loops shall calculate every pixel once, too. */
+    rowKernel.callCounter   = 0U;
+    rowKernel.pixelCounter  = 0U;
+    EffectRunner::forEachRow<TestGfx::WIDTH, TestGfx::HEIGHT>(testGfx, rowKernel, TIME + 2U);
+
+    TEST_ASSERT_EQUAL_UINT32(TestGfx::WIDTH * TestGfx::HEIGHT, rowKernel.pixelCounter);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(TestGfx::WIDTH - 1, TestGfx::HEIGHT - 1, TIME + 2U)), static_cast<uint32_t>(testGfx.getColor(TestGfx::WIDTH - 1, TestGfx::HEIGHT - 1)));
+
+    /* A geometry mismatch falls back to the generic loops. */
+    EffectRunner::forEachPixel<TestGfx::WIDTH + 1U, TestGfx::HEIGHT>(testGfx, pixelKernel, TIME + 3U);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(TestGfx::WIDTH - 1, TestGfx::HEIGHT - 1, TIME + 3U)), static_cast<uint32_t>(testGfx.getColor(TestGfx::WIDTH - 1, TestGfx::HEIGHT - 1)));
+
+    return;
+}
+
+/**
+ * Test the abstract state machine.
+ */
+static void testStateMachine()
+{
+    TestState       stateA;
+    TestState       stateB;
+    StateMachine    sm;
+
+    /* State machine has no state yet. */
+    TEST_ASSERT_NULL(sm.getState());
+    TEST_ASSERT_EQUAL_UINT32(AbstractState::WAIT_FOREVER, sm.getWaitTime());
+
+    /* Add state A, but don't process it. */
+    sm.setState(stateA);
+    TEST_ASSERT_NULL(sm.getState());
+
+    /* A pending state change is processed immediately. */
+    TEST_ASSERT_EQUAL_UINT32(0U, sm.getWaitTime());
+    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntEntry());
+    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntExit());
+
+    /* Process it once.
+     * Expectation:
+     * The entry part is called once and the process part.
+     */
+    sm.process();
+    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntEntry());
+    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntExit());
+    TEST_ASSERT_EQUAL_PTR(static_cast<AbstractState*>(&stateA), sm.getState());
+
+    /* The state waits only for events. */
+    TEST_ASSERT_EQUAL_UINT32(AbstractState::WAIT_FOREVER, sm.getWaitTime());
+
+    /* Process it a 2nd time.
+     * Expectation:
+     * Only the process part is called.
+     */
+    sm.process();
+    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntEntry());
+    TEST_ASSERT_EQUAL_UINT32(0u, stateA.getCallCntExit());
+
+    /* Transistion from A to B. */
+    stateA.setState(stateB);
+    sm.process();
+    sm.process();
+    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntEntry());
+    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntExit());
+    TEST_ASSERT_EQUAL_UINT32(1u, stateB.getCallCntEntry());
+    TEST_ASSERT_EQUAL_UINT32(0u, stateB.getCallCntExit());
+
+    /* Transistion from B to A. */
+    stateB.setState(stateA);
+    sm.process();
+    sm.process();
+    TEST_ASSERT_EQUAL_UINT32(2u, stateA.getCallCntEntry());
+    TEST_ASSERT_EQUAL_UINT32(1u, stateA.getCallCntExit());
+    TEST_ASSERT_EQUAL_UINT32(1u, stateB.getCallCntEntry());
+    TEST_ASSERT_EQUAL_UINT32(1u, stateB.getCallCntExit());
+
+    return;
+}
+
+/**
+ * Test simple timer.
+ */
+static void testSimpleTimer()
+{
+    SimpleTimer     testTimer;
+    NativeClock&    nativeClock = getNativeClock();
 
     /* Timer must be stopped */
     TEST_ASSERT_FALSE(testTimer.isTimerRunning());
@@ -1543,7 +3370,332 @@ static void testSimpleTimer()
     TEST_ASSERT_TRUE(testTimer.isTimeout());
     testTimer.start(100U);
     TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_UINT32_WITHIN(100U, 50U, testTimer.getRemaining());
+    testTimer.stop();
+    TEST_ASSERT_EQUAL_UINT32(0U, testTimer.getRemaining());
+
+    /* Timer runs across the wrap around of the 32-bit ms timestamp. */
+    nativeClock.isFixed = true;
+    nativeClock.now     = UINT32_MAX - 50UL;
+    testTimer.start(100U);
+    TEST_ASSERT_TRUE((static_cast<uint64_t>(nativeClock.now) * 1000U) == MonoTime::getMicros());
+    nativeClock.now    += 99UL;
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_EQUAL_UINT32(1U, testTimer.getRemaining());
+    nativeClock.now    += 1UL;
+    TEST_ASSERT_TRUE(testTimer.isTimeout());
+    nativeClock.isFixed = false;
+
+    return;
+}
+
+/**
+ * Test timer service with event timers.
+ */
+static void testTimerService()
+{
+    TimerService&       timerService    = TimerService::getInstance();
+    TestTimerListener   listener;
+    EventTimer          timerShort(listener);
+    EventTimer          timerLong(listener);
+    uint32_t            now             = millis();
+
+    /* Timers must be stopped */
+    TEST_ASSERT_FALSE(timerShort.isTimerRunning());
+    TEST_ASSERT_FALSE(timerLong.isTimerRunning());
+    TEST_ASSERT_EQUAL_UINT32(0U, timerService.getNumOfRunningTimers());
+
+    /* Start in reverse deadline order, the service sorts them. */
+    timerLong.start(2000U);
+    timerShort.start(1000U);
+    TEST_ASSERT_TRUE(timerShort.isTimerRunning());
+    TEST_ASSERT_TRUE(timerLong.isTimerRunning());
+    TEST_ASSERT_EQUAL_UINT32(2U, timerService.getNumOfRunningTimers());
+
+    /* No timeout yet */
+    timerService.process(now);
+    TEST_ASSERT_EQUAL_UINT32(0U, listener.m_callCounter);
+    TEST_ASSERT_UINT32_WITHIN(100U, 1000U, timerShort.getRemaining());
+    TEST_ASSERT_UINT32_WITHIN(100U, 2000U, timerLong.getRemaining());
+
+    /* Only the short timer times out. */
+    timerService.process(now + 1500U);
+    TEST_ASSERT_EQUAL_UINT32(1U, listener.m_callCounter);
+    TEST_ASSERT_EQUAL_PTR(&timerShort, listener.m_lastTimer);
+    TEST_ASSERT_FALSE(timerShort.isTimerRunning());
+    TEST_ASSERT_TRUE(timerLong.isTimerRunning());
+    TEST_ASSERT_EQUAL_UINT32(0U, timerShort.getRemaining());
+
+    /* Long timer times out too. */
+    timerService.process(now + 2500U);
+    TEST_ASSERT_EQUAL_UINT32(2U, listener.m_callCounter);
+    TEST_ASSERT_EQUAL_PTR(&timerLong, listener.m_lastTimer);
+    TEST_ASSERT_EQUAL_UINT32(0U, timerService.getNumOfRunningTimers());
+
+    /* A stopped timer doesn't time out. */
+    timerShort.start(1000U);
+    timerShort.stop();
+    TEST_ASSERT_FALSE(timerShort.isTimerRunning());
+    timerService.process(now + 5000U);
+    TEST_ASSERT_EQUAL_UINT32(2U, listener.m_callCounter);
+
+    /* A timer, which is restarted by its listener, keeps running. */
+    listener.m_restartTimer = &timerShort;
+    timerShort.start(0U);
+    timerService.process(millis());
+    TEST_ASSERT_EQUAL_UINT32(3U, listener.m_callCounter);
+    timerShort.start(1000U);
+    timerService.process(millis() + 1000U);
+    TEST_ASSERT_EQUAL_UINT32(4U, listener.m_callCounter);
+    TEST_ASSERT_TRUE(timerShort.isTimerRunning());
+    TEST_ASSERT_EQUAL_UINT32(1U, timerService.getNumOfRunningTimers());
+
+    /* Destroying a timer stops it. */
+    timerShort.stop();
+    TEST_ASSERT_EQUAL_UINT32(0U, timerService.getNumOfRunningTimers());
+
+    /* Timers in the upper levels and beyond the range of the wheel. */
+    listener.m_restartTimer = nullptr;
+    listener.m_callCounter  = 0U;
+    now                     = millis();
+    timerShort.start(100000U);
+    timerLong.start(TimerService::RANGE + 5000U);
+    timerService.process(now + 99000U);
+    TEST_ASSERT_EQUAL_UINT32(0U, listener.m_callCounter);
+    timerService.process(now + 101000U);
+    TEST_ASSERT_EQUAL_UINT32(1U, listener.m_callCounter);
+    TEST_ASSERT_EQUAL_PTR(&timerShort, listener.m_lastTimer);
+    timerService.process(now + TimerService::RANGE);
+    TEST_ASSERT_EQUAL_UINT32(1U, listener.m_callCounter);
+    TEST_ASSERT_TRUE(timerLong.isTimerRunning());
+    timerService.process(now + TimerService::RANGE + 6000U);
+    TEST_ASSERT_EQUAL_UINT32(2U, listener.m_callCounter);
+    TEST_ASSERT_EQUAL_PTR(&timerLong, listener.m_lastTimer);
+    TEST_ASSERT_EQUAL_UINT32(0U, timerService.getNumOfRunningTimers());
+
+    return;
+}
+
+/**
+ * Test simple event timer, which is managed by the timer service.
+ */
+static void testSimpleEventTimer()
+{
+    TimerService&       timerService    = TimerService::getInstance();
+    SimpleEventTimer    testTimer;
+
+    /* Timer must be stopped */
+    TEST_ASSERT_FALSE(testTimer.isTimerRunning());
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_EQUAL_UINT32(0U, testTimer.getRemaining());
+
+    /* Timeout is detected by polling. */
+    testTimer.start(0U);
+    TEST_ASSERT_TRUE(testTimer.isTimerRunning());
+    TEST_ASSERT_TRUE(testTimer.isTimeout());
+
+    /* Timeout is detected by the timer service. */
+    testTimer.start(1000U);
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_UINT32_WITHIN(100U, 1000U, testTimer.getRemaining());
+    TEST_ASSERT_EQUAL_UINT32(1U, timerService.getNumOfRunningTimers());
+    timerService.process(millis() + 1000U);
+    TEST_ASSERT_TRUE(testTimer.isTimerRunning());
+    TEST_ASSERT_TRUE(testTimer.isTimeout());
+    TEST_ASSERT_EQUAL_UINT32(0U, testTimer.getRemaining());
+
+    /* Restart clears the timeout. */
+    testTimer.restart();
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+
+    /* Stop timer */
     testTimer.stop();
+    TEST_ASSERT_FALSE(testTimer.isTimerRunning());
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_EQUAL_UINT32(0U, timerService.getNumOfRunningTimers());
+
+    return;
+}
+
+/**
+ * Test profile statistics.
+ */
+static void testProfileStat()
+{
+    ProfileStat             profileStat;
+    ProfileStat::Summary    summary;
+    uint16_t                index   = 0U;
+
+    /* No samples available */
+    profileStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.p99);
+
+    /* Current window is used, as long as no window is complete. */
+    profileStat.addSample(10U);
+    profileStat.addSample(30U);
+    profileStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(2U, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(10U, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(20U, summary.avg);
+    TEST_ASSERT_EQUAL_UINT32(30U, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(30U, summary.p99);
+
+    /* Complete the window with one outlier, which is above the 99th percentile. */
+    profileStat.clear();
+    for(index = 0U; index < (ProfileStat::WINDOW_SIZE - 1U); ++index)
+    {
+        profileStat.addSample(100U);
+    }
+    profileStat.addSample(5000U);
+
+    profileStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(ProfileStat::WINDOW_SIZE, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(100U, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(5000U, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(127U, summary.p99);
+
+    /* Summary of the complete window is kept, until the next one is complete. */
+    profileStat.addSample(1U);
+    profileStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(ProfileStat::WINDOW_SIZE, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(100U, summary.min);
+
+    return;
+}
+
+/**
+ * Test latency statistics.
+ */
+static void testLatencyStat()
+{
+    LatencyStat             latencyStat;
+    LatencyStat::Summary    summary;
+    uint32_t                index   = 0U;
+
+    /* No samples available */
+    latencyStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.p50);
+    TEST_ASSERT_EQUAL_UINT32(0U, summary.p99);
+
+    /* Single sample is every percentile. */
+    latencyStat.addSample(42U);
+    latencyStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(1U, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(42U, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(42U, summary.avg);
+    TEST_ASSERT_EQUAL_UINT32(42U, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(42U, summary.p50);
+    TEST_ASSERT_EQUAL_UINT32(42U, summary.p99);
+
+    /* Samples 100 down to 1 in reverse order, to verify the sorting. */
+    latencyStat.clear();
+    for(index = 100U; index > 0U; --index)
+    {
+        latencyStat.addSample(index);
+    }
+
+    latencyStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(100U, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(1U, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(50U, summary.avg);
+    TEST_ASSERT_EQUAL_UINT32(100U, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(50U, summary.p50);
+    TEST_ASSERT_EQUAL_UINT32(90U, summary.p90);
+    TEST_ASSERT_EQUAL_UINT32(99U, summary.p99);
+
+    /* Adding after a summary continues with the sorted samples. */
+    latencyStat.addSample(1000U);
+    latencyStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(101U, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(1000U, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(100U, summary.p99);
+
+    /* Samples above the capacity are only considered by min., avg. and max. */
+    latencyStat.clear();
+    for(index = 0U; index < LatencyStat::MAX_SAMPLES; ++index)
+    {
+        latencyStat.addSample(10U);
+    }
+    latencyStat.addSample(10000U);
+
+    latencyStat.getSummary(summary);
+    TEST_ASSERT_EQUAL_UINT32(LatencyStat::MAX_SAMPLES + 1U, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(10000U, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(10U, summary.p99);
+
+    return;
+}
+
+/**
+ * Test the CPU budget watchdog.
+ */
+static void testBudgetWatchdog()
+{
+    const uint32_t  BUDGET      = 100U;
+    BudgetWatchdog  watchdog;
+    uint16_t        index       = 0U;
+    uint8_t         step        = 0U;
+
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_NORMAL, watchdog.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(0U, watchdog.getMinPeriod());
+
+    /* Calls within budget don't change anything. */
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_NORMAL, watchdog.addSample(BUDGET, BUDGET));
+
+    /* A single overrun is tolerated. */
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_NORMAL, watchdog.addSample(BUDGET + 1U, BUDGET));
+    TEST_ASSERT_EQUAL_UINT8(0U, watchdog.getThrottle());
+
+    /* Repeated overruns throttle, even if interrupted by calls within budget. */
+    for(index = 1U; index < BudgetWatchdog::OVERRUN_LIMIT; ++index)
+    {
+        (void)watchdog.addSample(0U, BUDGET);
+        (void)watchdog.addSample(BUDGET + 1U, BUDGET);
+    }
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_THROTTLED, watchdog.getLevel());
+    TEST_ASSERT_EQUAL_UINT8(1U, watchdog.getThrottle());
+    TEST_ASSERT_EQUAL_UINT32(BudgetWatchdog::THROTTLE_PERIOD, watchdog.getMinPeriod());
+
+    /* Enough calls within budget relax the throttling. */
+    for(index = 0U; index < BudgetWatchdog::RECOVERY_LIMIT; ++index)
+    {
+        (void)watchdog.addSample(0U, BUDGET);
+    }
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_NORMAL, watchdog.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(0U, watchdog.getMinPeriod());
+
+    /* Overruns despite max. throttling exceed the budget for good. */
+    for(step = 0U; step < BudgetWatchdog::MAX_THROTTLE; ++step)
+    {
+        for(index = 0U; index < BudgetWatchdog::OVERRUN_LIMIT; ++index)
+        {
+            (void)watchdog.addSample(BUDGET + 1U, BUDGET);
+        }
+    }
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_THROTTLED, watchdog.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(BudgetWatchdog::THROTTLE_PERIOD << (BudgetWatchdog::MAX_THROTTLE - 1U), watchdog.getMinPeriod());
+
+    for(index = 0U; index < BudgetWatchdog::OVERRUN_LIMIT; ++index)
+    {
+        (void)watchdog.addSample(BUDGET + 1U, BUDGET);
+    }
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_EXCEEDED, watchdog.getLevel());
+
+    for(index = 0U; index < BudgetWatchdog::RECOVERY_LIMIT; ++index)
+    {
+        (void)watchdog.addSample(0U, BUDGET);
+    }
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_EXCEEDED, watchdog.getLevel());
+
+    /* Reset */
+    watchdog.reset();
+    TEST_ASSERT_EQUAL(BudgetWatchdog::LEVEL_NORMAL, watchdog.getLevel());
+    TEST_ASSERT_EQUAL_UINT8(0U, watchdog.getThrottle());
 
     return;
 }
@@ -1560,12 +3712,12 @@ static void testProgressBar()
     /* Verify widget type name */
     TEST_ASSERT_EQUAL_STRING(ProgressBar::WIDGET_TYPE, progressBar.getType());
 
-    /* No widget name is set, it must be empty. */
-    TEST_ASSERT_EQUAL_STRING("", progressBar.getName().c_str());
+    /* No widget name is set, it must have no id. */
+    TEST_ASSERT_EQUAL_UINT32(Widget::ID_NONE, progressBar.getId());
 
-    /* Set widget name and read back. */
+    /* Set widget name and read back its id. */
     progressBar.setName(WIDGET_NAME);
-    TEST_ASSERT_EQUAL_STRING(WIDGET_NAME, progressBar.getName().c_str());
+    TEST_ASSERT_EQUAL_UINT32(Widget::toId(WIDGET_NAME), progressBar.getId());
 
     /* Find widget with empty name.
      * Expected: Not found
@@ -1633,7 +3785,7 @@ static void testLogging()
     const char*     printBuffer     = nullptr;
     const char*     TEST_STRING_1   = "TestMessage";
     const String    TEST_STRING_2   = "TestMessageAsString";
-    char            expectedLogMessage[52];
+    char            expectedLogMessage[80];
     int             lineNo          = 0;
 
     /* Check intial LogLevel. */
@@ -1688,6 +3840,78 @@ static void testLogging()
 
     TEST_ASSERT_EQUAL_STRING(expectedLogMessage, printBuffer);
 
+    /* Deferred log message shall not be printed before it is processed. */
+    myTestLogger.clear();
+    LOG_ERROR_DEFERRED("Deferred %d %s %u %.1f %%", -12, TEST_STRING_2.c_str(), 7U, 1.5F); lineNo = __LINE__;
+    snprintf(expectedLogMessage, sizeof(expectedLogMessage), "ERROR: TestMain.cpp:%d Deferred -12 %s 7 1.5 %%\r\n", lineNo, TEST_STRING_2.c_str());
+    TEST_ASSERT_EQUAL_size_t(0, strlen(myTestLogger.getBuffer()));
+
+    /* Check expected deferred error log output. */
+    Logging::getInstance().processDeferred();
+    printBuffer = myTestLogger.getBuffer();
+
+    /* Skip timestamp */
+    while(('\0' != *printBuffer) && (' ' != *printBuffer))
+    {
+        ++printBuffer;
+    }
+
+    if (' ' == *printBuffer)
+    {
+        ++printBuffer;
+    }
+
+    TEST_ASSERT_EQUAL_STRING(expectedLogMessage, printBuffer);
+
+    /* Deferred log messages which don't fit into the queue shall be dropped. */
+    for(lineNo = 0; lineNo <= Logging::DEFERRED_QUEUE_SIZE; ++lineNo)
+    {
+        LOG_ERROR_DEFERRED("Deferred %d", lineNo);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1U, Logging::getInstance().getDeferredDropCount());
+    Logging::getInstance().processDeferred();
+    TEST_ASSERT_EQUAL_UINT32(0U, Logging::getInstance().getDeferredDropCount());
+
+    /* Too long string arguments shall be truncated. */
+    myTestLogger.clear();
+    LOG_ERROR_DEFERRED("%s%s%s%s", TEST_STRING_1, TEST_STRING_1, TEST_STRING_1, TEST_STRING_1);
+    Logging::getInstance().processDeferred();
+    TEST_ASSERT_NOT_NULL(strstr(myTestLogger.getBuffer(), "TestMessageTestMessageTestMes\r\n"));
+
+    /* Too long deferred log message shall be cut off. */
+    myTestLogger.clear();
+    LOG_ERROR_DEFERRED("%080u", 1U);
+    Logging::getInstance().processDeferred();
+    TEST_ASSERT_NOT_NULL(strstr(myTestLogger.getBuffer(), "000...\r\n"));
+
+    /* A log module follows the global log level, until it gets its own one. */
+    {
+        Logging::Module module("TestModule");
+
+        Logging::getInstance().setLogLevel(Logging::LOGLEVEL_ERROR);
+        TEST_ASSERT_EQUAL_PTR(&module, Logging::getInstance().getModule("TestModule"));
+        TEST_ASSERT_TRUE(module.isGlobalLogLevel());
+        TEST_ASSERT_FALSE(module.isEnabled(Logging::LOGLEVEL_INFO));
+
+        module.setLogLevel(Logging::LOGLEVEL_INFO);
+        TEST_ASSERT_FALSE(module.isGlobalLogLevel());
+        TEST_ASSERT_TRUE(module.isEnabled(Logging::LOGLEVEL_INFO));
+        TEST_ASSERT_FALSE(Logging::getInstance().isEnabled(Logging::LOGLEVEL_INFO));
+
+        Logging::getInstance().setLogLevel(Logging::LOGLEVEL_WARNING);
+        TEST_ASSERT_EQUAL(Logging::LOGLEVEL_INFO, module.getLogLevel());
+
+        module.useGlobalLogLevel();
+        TEST_ASSERT_EQUAL(Logging::LOGLEVEL_WARNING, module.getLogLevel());
+    }
+    TEST_ASSERT_NULL(Logging::getInstance().getModule("TestModule"));
+
+    /* The arguments of a disabled log level shall not be evaluated. */
+    Logging::getInstance().setLogLevel(Logging::LOGLEVEL_ERROR);
+    lineNo = 0;
+    LOG_INFO("%d", ++lineNo);
+    TEST_ASSERT_EQUAL_INT(0, lineNo);
+
     /* Unregister log sink and nothing shall be printed anymore. */
     Logging::getInstance().unregisterSink(&myLogSink);
     myTestLogger.clear();
@@ -1703,6 +3927,7 @@ static void testLogging()
 static void testUtil(void)
 {
     String      hexStr;
+    char        hexBuffer[9];
     uint8_t     valueUInt8  = 0U;
     uint16_t    valueUInt16 = 0U;
     uint32_t    valueUInt32 = 0U;
@@ -1791,6 +4016,22 @@ static void testUtil(void)
     TEST_ASSERT_EQUAL_STRING("ffff0000", Util::uint32ToHex(0xffff0000).c_str());
     TEST_ASSERT_EQUAL_STRING("ffffffff", Util::uint32ToHex(0xffffffff).c_str());
 
+    /* Test uint32_t to hex conversion into a caller buffer. */
+    TEST_ASSERT_EQUAL(1U, Util::uint32ToHex(0x00, hexBuffer, sizeof(hexBuffer)));
+    TEST_ASSERT_EQUAL_STRING("0", hexBuffer);
+    TEST_ASSERT_EQUAL(6U, Util::uint32ToHex(0xabcdef, hexBuffer, sizeof(hexBuffer)));
+    TEST_ASSERT_EQUAL_STRING("abcdef", hexBuffer);
+    TEST_ASSERT_EQUAL(8U, Util::uint32ToHex(0xffffffff, hexBuffer, sizeof(hexBuffer)));
+    TEST_ASSERT_EQUAL_STRING("ffffffff", hexBuffer);
+    TEST_ASSERT_EQUAL(0U, Util::uint32ToHex(0xffffffff, hexBuffer, sizeof(hexBuffer) - 1U));
+    TEST_ASSERT_EQUAL(0U, Util::uint32ToHex(0x1, nullptr, sizeof(hexBuffer)));
+
+    /* Test conversion of not null-terminated hex strings. */
+    TEST_ASSERT_EQUAL_UINT32(0x1fU, Util::hexToUInt32("0x1f;", 4U));
+    TEST_ASSERT_EQUAL_UINT32(0U, Util::hexToUInt32("0x1f;", 5U));
+    TEST_ASSERT_EQUAL_UINT32(0U, Util::hexToUInt32(nullptr, 4U));
+    TEST_ASSERT_FALSE(Util::strToUInt8(static_cast<const char*>(nullptr), valueUInt8));
+
     /* Value of empty hex string shall be 0. */
     hexStr.clear();
     TEST_ASSERT_EQUAL_UINT32(0U, Util::hexToUInt32(hexStr));
@@ -1831,5 +4072,1981 @@ static void testUtil(void)
     hexStr = "0y5";
     TEST_ASSERT_EQUAL_UINT32(0U, Util::hexToUInt32(hexStr));
 
+    /* Test UTF-8 to Windows-1252 conversion. */
+    TEST_ASSERT_EQUAL_STRING("Hello", Util::utf8ToCp1252("Hello").c_str());
+    TEST_ASSERT_EQUAL_STRING("\xC4\xD6\xDC\xE4\xF6\xFC\xDF", Util::utf8ToCp1252("\xC3\x84\xC3\x96\xC3\x9C\xC3\xA4\xC3\xB6\xC3\xBC\xC3\x9F").c_str());
+    TEST_ASSERT_EQUAL_STRING("5\xB0" "C", Util::utf8ToCp1252("5\xC2\xB0" "C").c_str());
+    TEST_ASSERT_EQUAL_STRING("\x80\x93\x94", Util::utf8ToCp1252("\xE2\x82\xAC\xE2\x80\x9C\xE2\x80\x9D").c_str());
+    TEST_ASSERT_EQUAL_STRING("a?b", Util::utf8ToCp1252("a\xF0\x9F\x98\x80" "b").c_str());
+    TEST_ASSERT_EQUAL_STRING("\xE4", Util::utf8ToCp1252("\xE4").c_str());
+
+    /* Overlong encodings are replaced, instead of decoded. */
+    TEST_ASSERT_EQUAL_STRING("a?b", Util::utf8ToCp1252("a\xC0\x80" "b").c_str());
+    TEST_ASSERT_EQUAL_STRING("a?b", Util::utf8ToCp1252("a\xC0\xAF" "b").c_str());
+    TEST_ASSERT_EQUAL_STRING("a?b", Util::utf8ToCp1252("a\xC1\xBF" "b").c_str());
+    TEST_ASSERT_EQUAL_STRING("a?b", Util::utf8ToCp1252("a\xE0\x80\xAF" "b").c_str());
+    TEST_ASSERT_EQUAL_STRING("a?b", Util::utf8ToCp1252("a\xE0\x83\xBF" "b").c_str());
+    TEST_ASSERT_EQUAL_STRING("a?b", Util::utf8ToCp1252("a\xF0\x80\x80\xAF" "b").c_str());
+
+    return;
+}
+
+/**
+ * Test the metrics registry.
+ */
+static void testMetrics(void)
+{
+    const uint32_t  BOUNDS[]    = { 10U, 20U };
+    Metrics&        metrics     = Metrics::getInstance();
+    const uint32_t  NUM_METRICS = metrics.getNumOfMetrics();
+
+    {
+        MetricCounter   counter("test_total", "Test counter.");
+        MetricGauge     gauge("test_gauge", "Test gauge.");
+        MetricHistogram histogram("test_ms", "Test histogram.", BOUNDS, UTIL_ARRAY_NUM(BOUNDS));
+        TestPrintBuffer output;
+
+        TEST_ASSERT_EQUAL_UINT32(NUM_METRICS + 3U, metrics.getNumOfMetrics());
+
+        /* Counter */
+        TEST_ASSERT_EQUAL_UINT32(0U, counter.get());
+        counter.inc();
+        counter.inc(2U);
+        TEST_ASSERT_EQUAL_UINT32(3U, counter.get());
+
+        /* Gauge */
+        gauge.set(5);
+        gauge.dec(7);
+        gauge.inc();
+        TEST_ASSERT_EQUAL_INT32(-1, gauge.get());
+
+        /* Histogram */
+        histogram.observe(5U);
+        histogram.observe(10U);
+        histogram.observe(15U);
+        histogram.observe(100U);
+        TEST_ASSERT_EQUAL_UINT32(4U, histogram.getCount());
+        TEST_ASSERT_EQUAL_UINT32(130U, histogram.getSum());
+
+        /* Export, the latest registered metric comes first. */
+        metrics.write(output);
+        TEST_ASSERT_EQUAL_STRING(
+            "# HELP test_ms Test histogram.\n"
+            "# TYPE test_ms histogram\n"
+            "test_ms_bucket{le=\"10\"} 2\n"
+            "test_ms_bucket{le=\"20\"} 3\n"
+            "test_ms_bucket{le=\"+Inf\"} 4\n"
+            "test_ms_sum 130\n"
+            "test_ms_count 4\n"
+            "# HELP test_gauge Test gauge.\n"
+            "# TYPE test_gauge gauge\n"
+            "test_gauge -1\n"
+            "# HELP test_total Test counter.\n"
+            "# TYPE test_total counter\n"
+            "test_total 3\n",
+            output.getBuffer());
+
+        /* Percentiles are the upper bounds of the buckets. */
+        TEST_ASSERT_EQUAL_UINT32(10U, histogram.getPercentile(50U));
+        TEST_ASSERT_EQUAL_UINT32(20U, histogram.getPercentile(75U));
+        TEST_ASSERT_EQUAL_UINT32(20U, histogram.getPercentile(99U));
+    }
+
+    /* StatsD export */
+    {
+        MetricCounter   counter("test_total", "Test counter.");
+        MetricHistogram histogram("test_ms", "Test histogram.", BOUNDS, UTIL_ARRAY_NUM(BOUNDS));
+        TestPrintBuffer output;
+
+        counter.inc(3U);
+        histogram.observe(5U);
+        histogram.observe(15U);
+
+        metrics.writeStatsd(output, "host");
+        TEST_ASSERT_EQUAL_STRING(
+            "host.test_ms.count:2|g\n"
+            "host.test_ms.sum:20|g\n"
+            "host.test_ms.p50:10|g\n"
+            "host.test_ms.p90:20|g\n"
+            "host.test_ms.p99:20|g\n"
+            "host.test_total:3|g\n",
+            output.getBuffer());
+    }
+
+    /* Destroyed metrics are unregistered. */
+    TEST_ASSERT_EQUAL_UINT32(NUM_METRICS, metrics.getNumOfMetrics());
+
+    return;
+}
+
+/**
+ * Test the binary slot record format.
+ */
+static void testSlotRecord(void)
+{
+    const uint8_t   NUM             = 3U;
+    SlotRecord      records[NUM];
+    SlotRecord      decoded[NUM];
+    uint8_t         buffer[SlotRecord::HEADER_SIZE + (NUM * SlotRecord::RECORD_SIZE) + 2U];
+    uint8_t         num             = 0U;
+    uint8_t         index           = 0U;
+
+    records[0].slotId   = 0U;
+    records[0].typeId   = SlotRecord::getTypeId("SysMsgPlugin");
+    records[0].uid      = 0x1234U;
+    records[0].duration = 0U;
+    records[0].isLocked = true;
+    records[1].slotId   = 1U;
+    records[2].slotId   = 2U;
+    records[2].typeId   = SlotRecord::getTypeId("ClockPlugin");
+    records[2].uid      = 0xBEEFU;
+    records[2].duration = 70000U;
+    records[2].weight   = 3U;
+    records[2].timeBegin = 300U;
+    records[2].timeEnd  = 420U;
+
+    /* Type id is stable and never the empty one. */
+    TEST_ASSERT_EQUAL_UINT16(SlotRecord::getTypeId("SysMsgPlugin"), records[0].typeId);
+    TEST_ASSERT_NOT_EQUAL(records[0].typeId, records[2].typeId);
+    TEST_ASSERT_NOT_EQUAL(SlotRecord::TYPE_ID_NONE, SlotRecord::getTypeId(""));
+
+    /* Type id is part of the persistent format and available at compile time. */
+    static_assert(0xA8DCU == SlotRecord::getTypeId("SysMsgPlugin"), "Plugin type id changed.");
+    TEST_ASSERT_EQUAL_UINT16(0xA8DCU, SlotRecord::getTypeId(String("SysMsgPlugin").c_str()));
+    TEST_ASSERT_EQUAL_UINT16(0x1CD9U, SlotRecord::getTypeId(""));
+
+    /* Buffer too small */
+    TEST_ASSERT_EQUAL_UINT32(0U, SlotRecord::encode(records, NUM, buffer, SlotRecord::getSize(NUM) - 1U));
+
+    /* Encode and decode */
+    TEST_ASSERT_EQUAL_UINT32(SlotRecord::getSize(NUM), SlotRecord::encode(records, NUM, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(SlotRecord::decode(buffer, SlotRecord::getSize(NUM), decoded, NUM, num));
+    TEST_ASSERT_EQUAL_UINT8(NUM, num);
+
+    for(index = 0U; index < NUM; ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT8(records[index].slotId, decoded[index].slotId);
+        TEST_ASSERT_EQUAL_UINT16(records[index].typeId, decoded[index].typeId);
+        TEST_ASSERT_EQUAL_UINT16(records[index].uid, decoded[index].uid);
+        TEST_ASSERT_EQUAL_UINT32(records[index].duration, decoded[index].duration);
+        TEST_ASSERT_EQUAL(records[index].isLocked, decoded[index].isLocked);
+        TEST_ASSERT_EQUAL_UINT8(records[index].weight, decoded[index].weight);
+        TEST_ASSERT_EQUAL_UINT16(records[index].timeBegin, decoded[index].timeBegin);
+        TEST_ASSERT_EQUAL_UINT16(records[index].timeEnd, decoded[index].timeEnd);
+    }
+
+    /* Less records requested than stored */
+    TEST_ASSERT_TRUE(SlotRecord::decode(buffer, SlotRecord::getSize(NUM), decoded, 1U, num));
+    TEST_ASSERT_EQUAL_UINT8(1U, num);
+
+    /* Truncated data */
+    TEST_ASSERT_FALSE(SlotRecord::decode(buffer, SlotRecord::getSize(NUM) - 1U, decoded, NUM, num));
+    TEST_ASSERT_EQUAL_UINT8(0U, num);
+
+    /* Invalid magic */
+    buffer[0] = 0U;
+    TEST_ASSERT_FALSE(SlotRecord::decode(buffer, SlotRecord::getSize(NUM), decoded, NUM, num));
+
+    /* A later version with larger records is still readable. */
+    records[0].isLocked = false;
+    TEST_ASSERT_EQUAL_UINT32(SlotRecord::getSize(1U), SlotRecord::encode(records, 1U, buffer, sizeof(buffer)));
+    buffer[1] = SlotRecord::VERSION + 1U;
+    buffer[2] = static_cast<uint8_t>(SlotRecord::RECORD_SIZE + 2U);
+    buffer[SlotRecord::HEADER_SIZE + SlotRecord::RECORD_SIZE + 0U] = 0xFFU;
+    buffer[SlotRecord::HEADER_SIZE + SlotRecord::RECORD_SIZE + 1U] = 0xFFU;
+    TEST_ASSERT_TRUE(SlotRecord::decode(buffer, SlotRecord::getSize(1U) + 2U, decoded, NUM, num));
+    TEST_ASSERT_EQUAL_UINT8(1U, num);
+    TEST_ASSERT_EQUAL_UINT16(0x1234U, decoded[0].uid);
+
+    /* Version 1 records get the default schedule. */
+    TEST_ASSERT_EQUAL_UINT32(SlotRecord::getSize(NUM), SlotRecord::encode(records, NUM, buffer, sizeof(buffer)));
+    buffer[1] = 1U;
+    buffer[2] = static_cast<uint8_t>(SlotRecord::RECORD_SIZE_V1);
+    buffer[3] = 2U;
+    memmove(&buffer[SlotRecord::HEADER_SIZE + SlotRecord::RECORD_SIZE_V1],
+        &buffer[SlotRecord::HEADER_SIZE + (2U * SlotRecord::RECORD_SIZE)],
+        SlotRecord::RECORD_SIZE_V1);
+    TEST_ASSERT_TRUE(SlotRecord::decode(buffer, SlotRecord::HEADER_SIZE + (2U * SlotRecord::RECORD_SIZE_V1), decoded, NUM, num));
+    TEST_ASSERT_EQUAL_UINT8(2U, num);
+    TEST_ASSERT_EQUAL_UINT16(0xBEEFU, decoded[1].uid);
+    TEST_ASSERT_EQUAL_UINT32(70000U, decoded[1].duration);
+    TEST_ASSERT_EQUAL_UINT8(1U, decoded[1].weight);
+    TEST_ASSERT_EQUAL_UINT16(0U, decoded[1].timeBegin);
+    TEST_ASSERT_EQUAL_UINT16(0U, decoded[1].timeEnd);
+
+    return;
+}
+
+/**
+ * Test the binary configuration journal format.
+ */
+static void testConfigJournal(void)
+{
+    const char              DATA[]      = "{\"host\":\"volumio\"}";
+    const size_t            DATA_SIZE   = sizeof(DATA) - 1U;
+    uint8_t                 buffer[ConfigJournal::HEADER_SIZE + ConfigJournal::ENTRY_HEADER_SIZE + DATA_SIZE + ConfigJournal::ENTRY_HEADER_SIZE];
+    ConfigJournal::Entry    entry;
+    size_t                  offset      = 0U;
+
+    /* Header */
+    TEST_ASSERT_EQUAL_UINT32(0U, ConfigJournal::writeHeader(buffer, ConfigJournal::HEADER_SIZE - 1U));
+    TEST_ASSERT_EQUAL_UINT32(ConfigJournal::HEADER_SIZE, ConfigJournal::writeHeader(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(ConfigJournal::isHeaderValid(buffer, sizeof(buffer)));
+    TEST_ASSERT_FALSE(ConfigJournal::isHeaderValid(buffer, ConfigJournal::HEADER_SIZE - 1U));
+    offset += ConfigJournal::HEADER_SIZE;
+
+    /* Entry with data and a entry, which removes the configuration. */
+    TEST_ASSERT_EQUAL_UINT32(0U, ConfigJournal::writeEntry(0x1234U, reinterpret_cast<const uint8_t*>(DATA), DATA_SIZE, &buffer[offset], ConfigJournal::getEntrySize(DATA_SIZE) - 1U));
+    TEST_ASSERT_EQUAL_UINT32(ConfigJournal::getEntrySize(DATA_SIZE), ConfigJournal::writeEntry(0x1234U, reinterpret_cast<const uint8_t*>(DATA), DATA_SIZE, &buffer[offset], sizeof(buffer) - offset));
+    offset += ConfigJournal::getEntrySize(DATA_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(ConfigJournal::ENTRY_HEADER_SIZE, ConfigJournal::writeEntry(0x1234U, nullptr, 0U, &buffer[offset], sizeof(buffer) - offset));
+
+    offset = ConfigJournal::HEADER_SIZE;
+    TEST_ASSERT_EQUAL_UINT32(ConfigJournal::getEntrySize(DATA_SIZE), ConfigJournal::readEntry(&buffer[offset], sizeof(buffer) - offset, entry));
+    TEST_ASSERT_EQUAL_UINT16(0x1234U, entry.uid);
+    TEST_ASSERT_EQUAL_UINT16(DATA_SIZE, entry.size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(DATA, entry.data, DATA_SIZE));
+    offset += ConfigJournal::getEntrySize(DATA_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(ConfigJournal::ENTRY_HEADER_SIZE, ConfigJournal::readEntry(&buffer[offset], sizeof(buffer) - offset, entry));
+    TEST_ASSERT_EQUAL_UINT16(0x1234U, entry.uid);
+    TEST_ASSERT_EQUAL_UINT16(0U, entry.size);
+
+    /* Incomplete entry */
+    offset = ConfigJournal::HEADER_SIZE;
+    TEST_ASSERT_EQUAL_UINT32(0U, ConfigJournal::readEntry(&buffer[offset], ConfigJournal::getEntrySize(DATA_SIZE) - 1U, entry));
+
+    /* Corrupt entry */
+    buffer[offset + ConfigJournal::ENTRY_HEADER_SIZE] ^= 0x01U;
+    TEST_ASSERT_EQUAL_UINT32(0U, ConfigJournal::readEntry(&buffer[offset], sizeof(buffer) - offset, entry));
+
+    /* Invalid magic */
+    buffer[0] = 0U;
+    TEST_ASSERT_FALSE(ConfigJournal::isHeaderValid(buffer, sizeof(buffer)));
+
+    return;
+}
+
+/**
+ * Test the clock synchronization to a master clock.
+ */
+static void testSyncClock(void)
+{
+    const int64_t   OFFSET  = 5000;   /* Master clock is ahead of the local clock. */
+    SyncClock       clock;
+    uint64_t        t1      = 1000000U;
+    uint8_t         index   = 0U;
+
+    TEST_ASSERT_FALSE(clock.isSynchronized());
+
+    /* Symmetric delay of 300 us */
+    TEST_ASSERT_TRUE(clock.addSample(t1, t1 - OFFSET + 300U, t1 - OFFSET + 400U, t1 + 700U));
+    TEST_ASSERT_EQUAL_INT(OFFSET, clock.getOffset());
+    TEST_ASSERT_EQUAL_INT(300, clock.getDelay());
+    TEST_ASSERT_FALSE(clock.isSynchronized());
+
+    /* Timestamps of different exchanges result in a negative delay. */
+    TEST_ASSERT_FALSE(clock.addSample(t1, t1 - OFFSET - 1000U, t1 - OFFSET - 900U, t1 + 100U - 1000U));
+
+    /* Delayed sync messages have a asymmetric delay, but the sample
+     * with the lowest delay wins.
+     */
+    for(index = 0U; index < SyncClock::MIN_SAMPLES; ++index)
+    {
+        t1 += 100000U;
+        TEST_ASSERT_TRUE(clock.addSample(t1, t1 - OFFSET + 3000U, t1 - OFFSET + 3100U, t1 + 3400U));
+    }
+
+    TEST_ASSERT_TRUE(clock.isSynchronized());
+    TEST_ASSERT_EQUAL_INT(OFFSET, clock.getOffset());
+    TEST_ASSERT_EQUAL_UINT32(2000U, clock.toMaster(2000U - OFFSET));
+    TEST_ASSERT_EQUAL_UINT32(2000U - OFFSET, clock.toLocal(2000U));
+
+    /* Small drift is slewed. */
+    clock.reset();
+
+    for(index = 0U; index < SyncClock::MIN_SAMPLES; ++index)
+    {
+        t1 += 100000U;
+        TEST_ASSERT_TRUE(clock.addSample(t1, t1 - OFFSET + 300U, t1 - OFFSET + 400U, t1 + 700U));
+    }
+
+    t1 += 100000U;
+    TEST_ASSERT_TRUE(clock.addSample(t1, t1 - OFFSET - 400U + 100U, t1 - OFFSET - 400U + 200U, t1 + 300U));
+    TEST_ASSERT_EQUAL_INT(OFFSET + 100, clock.getOffset());
+
+    /* Large offset change is stepped. */
+    clock.reset();
+    TEST_ASSERT_TRUE(clock.addSample(t1, t1 + 100U, t1 + 200U, t1 + 300U));
+    TEST_ASSERT_EQUAL_INT(0, clock.getOffset());
+
+    /* Phase to the period grid */
+    TEST_ASSERT_EQUAL_INT(0, SyncClock::getPhaseError(50000U, 25000U));
+    TEST_ASSERT_EQUAL_INT(1000, SyncClock::getPhaseError(51000U, 25000U));
+    TEST_ASSERT_EQUAL_INT(12500, SyncClock::getPhaseError(62500U, 25000U));
+    TEST_ASSERT_EQUAL_INT(-1000, SyncClock::getPhaseError(74000U, 25000U));
+    TEST_ASSERT_EQUAL_UINT32(50000U, SyncClock::alignUp(50000U, 25000U));
+    TEST_ASSERT_EQUAL_UINT32(75000U, SyncClock::alignUp(50001U, 25000U));
+
+    return;
+}
+
+/**
+ * Test the display synchronization packet format.
+ */
+static void testSyncPacket(void)
+{
+    uint8_t     buffer[SyncPacket::MAX_SIZE];
+    SyncPacket  packet;
+    SyncPacket  decoded;
+
+    /* Sync */
+    packet.type         = SyncPacket::TYPE_SYNC;
+    packet.group        = 3U;
+    packet.sequence     = 0x1234U;
+    packet.timestamp    = 0x0123456789ABCDEFULL;
+    packet.framePeriod  = 40U;
+    packet.currentSlot  = 2U;
+    packet.nextSlot     = 5U;
+    packet.switchTime   = 0x1122334455667788ULL;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, SyncPacket::encode(packet, buffer, SyncPacket::MAX_SIZE - 1U));
+    TEST_ASSERT_EQUAL_UINT32(SyncPacket::MAX_SIZE, SyncPacket::encode(packet, buffer, sizeof(buffer)));
+    TEST_ASSERT_FALSE(SyncPacket::decode(buffer, SyncPacket::MAX_SIZE - 1U, decoded));
+    TEST_ASSERT_TRUE(SyncPacket::decode(buffer, sizeof(buffer), decoded));
+    TEST_ASSERT_EQUAL_UINT8(SyncPacket::TYPE_SYNC, decoded.type);
+    TEST_ASSERT_EQUAL_UINT8(3U, decoded.group);
+    TEST_ASSERT_EQUAL_UINT16(0x1234U, decoded.sequence);
+    TEST_ASSERT_TRUE(0x0123456789ABCDEFULL == decoded.timestamp);
+    TEST_ASSERT_EQUAL_UINT16(40U, decoded.framePeriod);
+    TEST_ASSERT_EQUAL_UINT8(2U, decoded.currentSlot);
+    TEST_ASSERT_EQUAL_UINT8(5U, decoded.nextSlot);
+    TEST_ASSERT_TRUE(0x1122334455667788ULL == decoded.switchTime);
+
+    /* Delay request has no payload. */
+    packet.type = SyncPacket::TYPE_DELAY_REQ;
+    TEST_ASSERT_EQUAL_UINT32(SyncPacket::HEADER_SIZE, SyncPacket::encode(packet, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(SyncPacket::decode(buffer, SyncPacket::HEADER_SIZE, decoded));
+    TEST_ASSERT_EQUAL_UINT8(SyncPacket::TYPE_DELAY_REQ, decoded.type);
+
+    /* Delay response */
+    packet.type         = SyncPacket::TYPE_DELAY_RESP;
+    packet.timestamp    = 987654321U;
+    TEST_ASSERT_EQUAL_UINT32(SyncPacket::HEADER_SIZE + SyncPacket::DELAY_RESP_SIZE, SyncPacket::encode(packet, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(SyncPacket::decode(buffer, SyncPacket::HEADER_SIZE + SyncPacket::DELAY_RESP_SIZE, decoded));
+    TEST_ASSERT_EQUAL_UINT8(SyncPacket::TYPE_DELAY_RESP, decoded.type);
+    TEST_ASSERT_TRUE(987654321U == decoded.timestamp);
+
+    /* Unknown type and invalid magic */
+    buffer[2] = 0U;
+    TEST_ASSERT_FALSE(SyncPacket::decode(buffer, sizeof(buffer), decoded));
+    buffer[2] = SyncPacket::TYPE_SYNC;
+    buffer[0] = 0U;
+    TEST_ASSERT_FALSE(SyncPacket::decode(buffer, sizeof(buffer), decoded));
+
+    return;
+}
+
+/**
+ * Test the DDP packet decoding.
+ */
+static void testDdpPacket(void)
+{
+    uint8_t     buffer[] =
+    {
+        0x51U, 0x03U, 0x0BU, 0x01U,     /* Version 1, timecode, push, sequence 3, RGB, display */
+        0x00U, 0x00U, 0x01U, 0x02U,     /* Offset 258 */
+        0x00U, 0x03U,                   /* Length 3 */
+        0x11U, 0x22U, 0x33U, 0x44U,     /* Timecode */
+        0xFFU, 0x80U, 0x00U             /* Pixel */
+    };
+    DdpPacket   packet;
+
+    TEST_ASSERT_TRUE(DdpPacket::decode(buffer, sizeof(buffer), packet));
+    TEST_ASSERT_TRUE(packet.isPush());
+    TEST_ASSERT_TRUE(packet.isPixelData());
+    TEST_ASSERT_EQUAL_UINT8(3U, packet.sequence);
+    TEST_ASSERT_EQUAL_UINT32(258U, packet.offset);
+    TEST_ASSERT_EQUAL_UINT16(3U, packet.length);
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, packet.data[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x80U, packet.data[1]);
+
+    /* Incomplete data */
+    TEST_ASSERT_FALSE(DdpPacket::decode(buffer, sizeof(buffer) - 1U, packet));
+
+    /* Without timecode the data follows the header. */
+    buffer[0] = DdpPacket::VERSION_1;
+    TEST_ASSERT_TRUE(DdpPacket::decode(buffer, DdpPacket::HEADER_SIZE + 3U, packet));
+    TEST_ASSERT_FALSE(packet.isPush());
+    TEST_ASSERT_EQUAL_UINT8(0x11U, packet.data[0]);
+
+    /* Query */
+    buffer[0] = DdpPacket::VERSION_1 | DdpPacket::FLAG_QUERY;
+    TEST_ASSERT_TRUE(DdpPacket::decode(buffer, sizeof(buffer), packet));
+    TEST_ASSERT_FALSE(packet.isPixelData());
+
+    /* Unsupported version */
+    buffer[0] = 0x80U;
+    TEST_ASSERT_FALSE(DdpPacket::decode(buffer, sizeof(buffer), packet));
+
+    /* Packet loss */
+    TEST_ASSERT_EQUAL_UINT8(0U, DdpPacket::getLostPackets(3U, 4U));
+    TEST_ASSERT_EQUAL_UINT8(0U, DdpPacket::getLostPackets(15U, 1U));
+    TEST_ASSERT_EQUAL_UINT8(2U, DdpPacket::getLostPackets(3U, 6U));
+    TEST_ASSERT_EQUAL_UINT8(1U, DdpPacket::getLostPackets(14U, 1U));
+    TEST_ASSERT_EQUAL_UINT8(0U, DdpPacket::getLostPackets(0U, 6U));
+
+    return;
+}
+
+/**
+ * Test the frame patch decoding and applying.
+ */
+static void testFramePatch(void)
+{
+    const uint16_t  FRAME_WIDTH     = 4U;
+    const uint16_t  FRAME_HEIGHT    = 3U;
+    uint8_t         raw[]           =
+    {
+        0xF5U, 0x01U, 0x00U, 0x00U,     /* Magic, version, no flags */
+        0x05U, 0x00U, 0x00U, 0x00U,     /* Sequence 5 */
+        0x01U, 0x00U, 0x01U, 0x00U,     /* x = 1, y = 1 */
+        0x02U, 0x00U, 0x02U, 0x00U,     /* 2 x 2 pixels */
+        0x01U, 0x00U, 0x02U, 0x00U,
+        0x03U, 0x00U, 0x04U, 0x00U
+    };
+    uint8_t         rle[]           =
+    {
+        0xF5U, 0x01U, 0x01U, 0x00U,     /* Magic, version, RLE */
+        0x06U, 0x00U, 0x00U, 0x00U,     /* Sequence 6 */
+        0x00U, 0x00U, 0x00U, 0x00U,     /* x = 0, y = 0 */
+        0x04U, 0x00U, 0x01U, 0x00U,     /* 4 x 1 pixels */
+        0x02U, 0x00U, 0xF8U,            /* 3 x red */
+        0x00U, 0x1FU, 0x00U             /* 1 x blue */
+    };
+    uint16_t        frame[FRAME_WIDTH * FRAME_HEIGHT];
+    FramePatch      patch;
+
+    memset(frame, 0, sizeof(frame));
+
+    /* Uncompressed partial frame */
+    TEST_ASSERT_TRUE(FramePatch::decode(raw, sizeof(raw), patch));
+    TEST_ASSERT_EQUAL_UINT32(5U, patch.sequence);
+    TEST_ASSERT_TRUE(patch.apply(frame, FRAME_WIDTH, FRAME_HEIGHT));
+    TEST_ASSERT_EQUAL_UINT16(0U, frame[0]);
+    TEST_ASSERT_EQUAL_UINT16(1U, frame[5]);
+    TEST_ASSERT_EQUAL_UINT16(2U, frame[6]);
+    TEST_ASSERT_EQUAL_UINT16(3U, frame[9]);
+    TEST_ASSERT_EQUAL_UINT16(4U, frame[10]);
+
+    /* Doesn't fit into the frame */
+    TEST_ASSERT_FALSE(patch.apply(frame, FRAME_WIDTH, 2U));
+
+    /* Incomplete pixel data */
+    TEST_ASSERT_TRUE(FramePatch::decode(raw, sizeof(raw) - 1U, patch));
+    TEST_ASSERT_FALSE(patch.apply(frame, FRAME_WIDTH, FRAME_HEIGHT));
+
+    /* Run-length encoded row */
+    TEST_ASSERT_TRUE(FramePatch::decode(rle, sizeof(rle), patch));
+    TEST_ASSERT_TRUE(patch.apply(frame, FRAME_WIDTH, FRAME_HEIGHT));
+    TEST_ASSERT_EQUAL_UINT16(0xF800U, frame[0]);
+    TEST_ASSERT_EQUAL_UINT16(0xF800U, frame[2]);
+    TEST_ASSERT_EQUAL_UINT16(0x001FU, frame[3]);
+    TEST_ASSERT_EQUAL_UINT16(1U, frame[5]);
+
+    /* Runs must cover exactly all pixels. */
+    rle[16] = 0x03U;
+    TEST_ASSERT_FALSE(patch.apply(frame, FRAME_WIDTH, FRAME_HEIGHT));
+
+    /* Invalid magic */
+    raw[0] = 0x00U;
+    TEST_ASSERT_FALSE(FramePatch::decode(raw, sizeof(raw), patch));
+
+    /* Sequence numbers with wrap around */
+    TEST_ASSERT_TRUE(FramePatch::isNewer(6U, 5U));
+    TEST_ASSERT_FALSE(FramePatch::isNewer(5U, 5U));
+    TEST_ASSERT_FALSE(FramePatch::isNewer(4U, 5U));
+    TEST_ASSERT_TRUE(FramePatch::isNewer(1U, UINT32_MAX));
+
+    return;
+}
+
+/**
+ * Test the audio spectrum analyzer.
+ */
+static void testSpectrum(void)
+{
+    const uint16_t      SINE_BIN    = 20U;
+    static Spectrum     spectrum;
+    int16_t             samples[Spectrum::FFT_SIZE];
+    Spectrum::Levels    levels;
+    uint16_t            index       = 0U;
+    uint8_t             band        = 0U;
+    uint8_t             sineBand    = 0U;
+
+    /* Silence */
+    memset(samples, 0, sizeof(samples));
+    spectrum.process(samples, levels);
+    TEST_ASSERT_EQUAL_UINT8(0U, levels.volume);
+
+    for(band = 0U; band < Spectrum::BAND_COUNT; ++band)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0U, levels.bands[band]);
+    }
+
+    /* The bands are ascending and cover all bins. */
+    TEST_ASSERT_EQUAL_UINT16(1U, spectrum.getFirstBin(0U));
+
+    for(band = 1U; band < Spectrum::BAND_COUNT; ++band)
+    {
+        TEST_ASSERT_TRUE(spectrum.getFirstBin(band - 1U) < spectrum.getFirstBin(band));
+
+        if (SINE_BIN >= spectrum.getFirstBin(band))
+        {
+            sineBand = band;
+        }
+    }
+
+    /* Half scale sine in the middle of a bin */
+    for(index = 0U; index < Spectrum::FFT_SIZE; ++index)
+    {
+        samples[index] = static_cast<int16_t>(16384.0f * sinf(2.0f * static_cast<float>(M_PI) * SINE_BIN * index / Spectrum::FFT_SIZE));
+    }
+
+    spectrum.process(samples, levels);
+    TEST_ASSERT_TRUE(200U < levels.volume);
+    TEST_ASSERT_TRUE(200U < levels.bands[sineBand]);
+
+    /* The other bands are at least 30 dB lower. */
+    for(band = 0U; band < Spectrum::BAND_COUNT; ++band)
+    {
+        if ((sineBand != band) &&
+            ((sineBand + 1U) != band) &&
+            (sineBand != (band + 1U)))
+        {
+            TEST_ASSERT_TRUE((levels.bands[sineBand] / 2U) > levels.bands[band]);
+        }
+    }
+
+    return;
+}
+
+/**
+ * Test the arena based header store.
+ */
+static void testHeaderStore(void)
+{
+    HeaderStore     store;
+    const char      LINE_LENGTH[]   = "Content-Length:  42 \r";
+    const char      LINE_TYPE[]     = "Content-Type: text/plain";
+    const char      LINE_EMPTY[]    = "ETag:";
+    const char      LINE_INVALID[]  = "No header field";
+    char            longLine[HeaderStore::ARENA_SIZE];
+    uint8_t         idx             = 0U;
+
+    /* Without interest, all header fields are kept. */
+    TEST_ASSERT_TRUE(store.add(LINE_LENGTH, strlen(LINE_LENGTH)));
+    TEST_ASSERT_TRUE(store.add(LINE_TYPE, strlen(LINE_TYPE)));
+    TEST_ASSERT_TRUE(store.add(LINE_EMPTY, strlen(LINE_EMPTY)));
+    TEST_ASSERT_FALSE(store.add(LINE_INVALID, strlen(LINE_INVALID)));
+    TEST_ASSERT_FALSE(store.add(":value", 6U));
+    TEST_ASSERT_EQUAL_UINT8(3U, store.getCount());
+
+    /* Lookup is case insensitive and the value is trimmed. */
+    TEST_ASSERT_EQUAL_STRING("42", store.find("content-length"));
+    TEST_ASSERT_EQUAL_STRING("text/plain", store.find("CONTENT-TYPE"));
+    TEST_ASSERT_EQUAL_STRING("", store.find("ETag"));
+    TEST_ASSERT_NULL(store.find("Content"));
+    TEST_ASSERT_NULL(store.find("Connection"));
+    TEST_ASSERT_EQUAL_UINT32(HeaderStore::hash("ETAG", 4U), HeaderStore::hash("etag", 4U));
+
+    /* Only header fields of interest are kept, the interests survive clearing. */
+    store.clear();
+    TEST_ASSERT_EQUAL_UINT8(0U, store.getCount());
+    TEST_ASSERT_NULL(store.find("Content-Length"));
+    TEST_ASSERT_TRUE(store.addInterest("content-length"));
+    TEST_ASSERT_TRUE(store.addInterest("Content-Length"));
+    TEST_ASSERT_TRUE(store.add(LINE_LENGTH, strlen(LINE_LENGTH)));
+    TEST_ASSERT_FALSE(store.add(LINE_TYPE, strlen(LINE_TYPE)));
+    TEST_ASSERT_EQUAL_UINT8(1U, store.getCount());
+    TEST_ASSERT_EQUAL_STRING("42", store.find("Content-Length"));
+    TEST_ASSERT_NULL(store.find("Content-Type"));
+
+    for(idx = 1U; idx < HeaderStore::MAX_INTERESTS; ++idx)
+    {
+        char name[] = "X-Header-?";
+
+        name[sizeof(name) - 2U] = static_cast<char>('A' + idx);
+        TEST_ASSERT_TRUE(store.addInterest(name));
+    }
+    TEST_ASSERT_FALSE(store.addInterest("Full"));
+
+    /* A header field, which doesn't fit into the arena, is dropped. */
+    store.clear();
+    store.clearInterests();
+    memset(longLine, 'a', sizeof(longLine));
+    longLine[1] = ':';
+    TEST_ASSERT_FALSE(store.add(longLine, sizeof(longLine)));
+    TEST_ASSERT_TRUE(store.add(longLine, sizeof(longLine) - 2U));
+    TEST_ASSERT_FALSE(store.add(LINE_EMPTY, strlen(LINE_EMPTY)));
+
+    /* Max. number of header fields */
+    store.clear();
+    for(idx = 0U; idx < HeaderStore::MAX_HEADERS; ++idx)
+    {
+        TEST_ASSERT_TRUE(store.add(LINE_EMPTY, strlen(LINE_EMPTY)));
+    }
+    TEST_ASSERT_FALSE(store.add(LINE_EMPTY, strlen(LINE_EMPTY)));
+
+    return;
+}
+
+/**
+ * Test the incremental HTTP response parser. The same responses are parsed
+ * at once and split at random positions, which must result in the same
+ * events and body.
+ */
+static void testHttpRspParser(void)
+{
+    TestHttpRspListener listener;
+    TestHttpRspListener reference;
+    HttpRspParser       parser(listener);
+    HttpRspParser       referenceParser(reference);
+    const char          RSP_PIPELINE[]  =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5\r\n"
+        "Content-Type: text/plain\r\n"
+        "\r\n"
+        "Hello"
+        "\r\n"
+        "HTTP/1.1 200 OK\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "4;name=value\r\n"
+        "Wiki\r\n"
+        "0a\r\n"
+        "pedia in\r\n\r\n"
+        "0\r\n"
+        "Expires: never\r\n"
+        "\r\n"
+        "HTTP/1.1 204 No Content\n"
+        "Content-Length: 0\n"
+        "\n"
+        "HTTP/1.0 200 OK\r\n"
+        "\r\n"
+        "until close";
+    const char          EXPECTED_LOG[]  =
+        "S:HTTP/1.1 200 OK\n"
+        "H:Content-Length: 5\n"
+        "H:Content-Type: text/plain\n"
+        "E\n"
+        "D\n"
+        "S:HTTP/1.1 200 OK\n"
+        "H:Transfer-Encoding: chunked\n"
+        "E\n"
+        "C:4\n"
+        "C:10\n"
+        "D\n"
+        "S:HTTP/1.1 204 No Content\n"
+        "H:Content-Length: 0\n"
+        "E\n"
+        "D\n"
+        "S:HTTP/1.0 200 OK\n"
+        "E\n"
+        "D\n";
+    const char          EXPECTED_BODY[] = "HelloWikipedia in\r\nuntil close";
+    const uint8_t*      data            = reinterpret_cast<const uint8_t*>(RSP_PIPELINE);
+    const size_t        SIZE            = sizeof(RSP_PIPELINE) - 1U;
+    uint32_t            seed            = 1U;
+    uint32_t            run             = 0U;
+    char                longLine[HttpRspParser::LINE_SIZE * 2U];
+
+    /* Parse at once */
+    TEST_ASSERT_TRUE(referenceParser.isIdle());
+    TEST_ASSERT_TRUE(referenceParser.parse(data, SIZE));
+    TEST_ASSERT_FALSE(referenceParser.isIdle());
+    TEST_ASSERT_TRUE(referenceParser.finish());
+    TEST_ASSERT_TRUE(referenceParser.isIdle());
+    TEST_ASSERT_EQUAL_STRING(EXPECTED_LOG, reference.m_log);
+    TEST_ASSERT_EQUAL(strlen(EXPECTED_BODY), reference.m_bodyLength);
+    TEST_ASSERT_TRUE(0 == memcmp(EXPECTED_BODY, reference.m_body, reference.m_bodyLength));
+
+    /* Parse byte by byte and with random split positions. */
+    for(run = 0U; run < 200U; ++run)
+    {
+        size_t index = 0U;
+
+        listener.clear();
+
+        while(SIZE > index)
+        {
+            size_t chunkSize = 1U;
+
+            if (0U < run)
+            {
+                /* Linear congruential generator, deterministic for reproducible results. */
+                seed        = seed * 1103515245U + 12345U;
+                chunkSize   = 1U + ((seed >> 16U) % 32U);
+            }
+
+            if ((SIZE - index) < chunkSize)
+            {
+                chunkSize = SIZE - index;
+            }
+
+            TEST_ASSERT_TRUE(parser.parse(&data[index], chunkSize));
+            index += chunkSize;
+        }
+
+        TEST_ASSERT_TRUE(parser.finish());
+        TEST_ASSERT_EQUAL_STRING(reference.m_log, listener.m_log);
+        TEST_ASSERT_EQUAL(reference.m_bodyLength, listener.m_bodyLength);
+        TEST_ASSERT_TRUE(0 == memcmp(reference.m_body, listener.m_body, listener.m_bodyLength));
+    }
+
+    /* Incomplete response is not completed by closing the connection. */
+    listener.clear();
+    TEST_ASSERT_TRUE(parser.parse(data, 30U));
+    TEST_ASSERT_FALSE(parser.finish());
+    TEST_ASSERT_TRUE(parser.isIdle());
+
+    /* Too long lines are truncated. */
+    listener.clear();
+    memset(longLine, 'a', sizeof(longLine));
+    longLine[sizeof(longLine) - 1U] = '\n';
+    TEST_ASSERT_TRUE(parser.parse(reinterpret_cast<const uint8_t*>(longLine), sizeof(longLine)));
+    TEST_ASSERT_EQUAL(2U + (HttpRspParser::LINE_SIZE - 1U) + 1U, listener.m_logLength);
+    parser.reset();
+
+    /* Invalid chunk size */
+    listener.clear();
+    TEST_ASSERT_FALSE(parser.parse(reinterpret_cast<const uint8_t*>("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nxyz\r\n"), 50U));
+    TEST_ASSERT_FALSE(parser.parse(reinterpret_cast<const uint8_t*>("HTTP/1.1 200 OK\r\n"), 17U));
+    parser.reset();
+
+    /* Chunk size overflow */
+    TEST_ASSERT_FALSE(parser.parse(reinterpret_cast<const uint8_t*>("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n123456789abcdef01\r\n"), 64U));
+    parser.reset();
+
+    /* Missing CRLF after chunk data */
+    TEST_ASSERT_FALSE(parser.parse(reinterpret_cast<const uint8_t*>("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n1\r\nab"), 52U));
+    parser.reset();
+
+    /* Invalid header, rejected by the listener */
+    TEST_ASSERT_FALSE(parser.parse(reinterpret_cast<const uint8_t*>("HTTP/1.1 200 OK\r\nInvalid: yes\r\n\r\n"), 33U));
+    parser.reset();
+
+    return;
+}
+
+/**
+ * Test the slot rotation plan.
+ */
+static void testSlotPlan(void)
+{
+    SlotPlan        plan;
+    const uint8_t   WEIGHTS_EQUAL[]     = { 1U, 1U, 1U };
+    const uint8_t   WEIGHTS[]           = { 2U, 1U, 0U, 1U };
+    const uint8_t   EXPECTED[]          = { 0U, 1U, 3U, 0U };
+    const uint8_t   WEIGHTS_LIMITED[]   = { 200U, 1U };
+    uint8_t         index               = 0U;
+
+    /* Empty plan */
+    TEST_ASSERT_EQUAL_UINT8(0U, plan.getLength());
+    TEST_ASSERT_EQUAL_UINT8(SlotPlan::MAX_SLOTS, plan.getSlotId(0U));
+    plan.build(nullptr, 3U);
+    TEST_ASSERT_EQUAL_UINT8(0U, plan.getLength());
+
+    /* Equal weights result in round robin. */
+    plan.build(WEIGHTS_EQUAL, UTIL_ARRAY_NUM(WEIGHTS_EQUAL));
+    TEST_ASSERT_EQUAL_UINT8(UTIL_ARRAY_NUM(WEIGHTS_EQUAL), plan.getLength());
+
+    for(index = 0U; index < plan.getLength(); ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT8(index, plan.getSlotId(index));
+    }
+
+    /* Weighted slots are spread, slots with weight 0 are skipped. */
+    plan.build(WEIGHTS, UTIL_ARRAY_NUM(WEIGHTS));
+    TEST_ASSERT_EQUAL_UINT8(UTIL_ARRAY_NUM(EXPECTED), plan.getLength());
+
+    for(index = 0U; index < plan.getLength(); ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT8(EXPECTED[index], plan.getSlotId(index));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(SlotPlan::MAX_SLOTS, plan.getSlotId(plan.getLength()));
+
+    /* Weights are limited. */
+    plan.build(WEIGHTS_LIMITED, UTIL_ARRAY_NUM(WEIGHTS_LIMITED));
+    TEST_ASSERT_EQUAL_UINT8(SlotPlan::MAX_WEIGHT + 1U, plan.getLength());
+
+    /* Time windows */
+    TEST_ASSERT_TRUE(SlotPlan::isInTimeWindow(0U, 0U, 0U));
+    TEST_ASSERT_TRUE(SlotPlan::isInTimeWindow(600U, 600U, 1439U));
+    TEST_ASSERT_TRUE(SlotPlan::isInTimeWindow(300U, 420U, 300U));
+    TEST_ASSERT_TRUE(SlotPlan::isInTimeWindow(300U, 420U, 419U));
+    TEST_ASSERT_FALSE(SlotPlan::isInTimeWindow(300U, 420U, 420U));
+    TEST_ASSERT_FALSE(SlotPlan::isInTimeWindow(300U, 420U, 299U));
+    TEST_ASSERT_TRUE(SlotPlan::isInTimeWindow(1380U, 60U, 1400U));
+    TEST_ASSERT_TRUE(SlotPlan::isInTimeWindow(1380U, 60U, 10U));
+    TEST_ASSERT_FALSE(SlotPlan::isInTimeWindow(1380U, 60U, 60U));
+    TEST_ASSERT_FALSE(SlotPlan::isInTimeWindow(1380U, 60U, 720U));
+
+    return;
+}
+
+/**
+ * Test the single producer single consumer queue.
+ */
+static void testSpscQueue(void)
+{
+    SpscQueue<uint32_t, 4U> queue;
+    uint32_t                value   = 0U;
+    uint32_t                index   = 0U;
+
+    /* Empty queue */
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_EQUAL_UINT32(0U, queue.getCount());
+    TEST_ASSERT_FALSE(queue.pop(value));
+
+    /* Fill the queue completely. */
+    for(index = 0U; index < 4U; ++index)
+    {
+        TEST_ASSERT_TRUE(queue.push(index));
+    }
+
+    TEST_ASSERT_FALSE(queue.push(4U));
+    TEST_ASSERT_EQUAL_UINT32(4U, queue.getCount());
+
+    /* First in, first out, also across the wrap around. */
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL_UINT32(0U, value);
+    TEST_ASSERT_TRUE(queue.push(4U));
+
+    for(index = 1U; index <= 4U; ++index)
+    {
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL_UINT32(index, value);
+    }
+
+    TEST_ASSERT_TRUE(queue.isEmpty());
+
+    /* Clear */
+    TEST_ASSERT_TRUE(queue.push(5U));
+    TEST_ASSERT_TRUE(queue.push(6U));
+    queue.clear();
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_FALSE(queue.pop(value));
+
+    return;
+}
+
+/**
+ * Test the lock-free state buffer.
+ */
+static void testStateBuffer(void)
+{
+    StateBuffer<uint32_t>   buffer;
+    const uint32_t*         state   = nullptr;
+    uint32_t                index   = 0U;
+
+    /* Nothing published yet, the reader has the default state. */
+    TEST_ASSERT_NULL(buffer.fetch());
+    TEST_ASSERT_EQUAL_UINT32(0U, buffer.get());
+
+    /* A published state is fetched exactly once. */
+    buffer.publish(1U);
+    state = buffer.fetch();
+    TEST_ASSERT_NOT_NULL(state);
+    TEST_ASSERT_EQUAL_UINT32(1U, *state);
+    TEST_ASSERT_NULL(buffer.fetch());
+    TEST_ASSERT_EQUAL_UINT32(1U, buffer.get());
+
+    /* The writer never overwrites the state, the reader currently uses. */
+    for(index = 2U; index < 10U; ++index)
+    {
+        buffer.publish(index);
+        TEST_ASSERT_EQUAL_UINT32(1U, *state);
+    }
+
+    /* Only the latest state is fetched. */
+    state = buffer.fetch();
+    TEST_ASSERT_NOT_NULL(state);
+    TEST_ASSERT_EQUAL_UINT32(9U, *state);
+    TEST_ASSERT_NULL(buffer.fetch());
+
+    return;
+}
+
+/**
+ * Test the button gesture detection.
+ */
+static void testButtonGesture(void)
+{
+    ButtonGesture gesture(1000U, 300U);
+
+    /* Idle released button */
+    TEST_ASSERT_TRUE(gesture.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_NONE, gesture.process(false, 0U));
+
+    /* Single click is reported after the double click time. */
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_PRESSED, gesture.process(true, 100U));
+    TEST_ASSERT_FALSE(gesture.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_RELEASED, gesture.process(false, 200U));
+    TEST_ASSERT_FALSE(gesture.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_NONE, gesture.process(false, 500U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_CLICK, gesture.process(false, 501U));
+    TEST_ASSERT_TRUE(gesture.isIdle());
+
+    /* Double click */
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_PRESSED, gesture.process(true, 1000U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_RELEASED, gesture.process(false, 1100U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_PRESSED, gesture.process(true, 1300U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_RELEASED | ButtonGesture::EVENT_DOUBLE_CLICK, gesture.process(false, 1400U));
+    TEST_ASSERT_TRUE(gesture.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_NONE, gesture.process(false, 2000U));
+
+    /* A late second press results in a click and a new press. */
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_PRESSED, gesture.process(true, 3000U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_RELEASED, gesture.process(false, 3100U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_CLICK | ButtonGesture::EVENT_PRESSED, gesture.process(true, 3500U));
+
+    /* Long press, its release is no click. */
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_NONE, gesture.process(true, 4499U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_LONG_PRESS, gesture.process(true, 4500U));
+    TEST_ASSERT_TRUE(gesture.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_NONE, gesture.process(true, 6000U));
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_RELEASED, gesture.process(false, 6100U));
+    TEST_ASSERT_TRUE(gesture.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(ButtonGesture::EVENT_NONE, gesture.process(false, 7000U));
+
+    return;
+}
+
+/**
+ * Test the UID map.
+ */
+static void testUidMap()
+{
+    UidMap<uint8_t, 8U> map;
+    uint8_t             value   = 0U;
+    uint16_t            uid     = 0U;
+
+    /* Empty map */
+    TEST_ASSERT_EQUAL_UINT16(0U, map.getCount());
+    TEST_ASSERT_FALSE(map.find(1U, value));
+    TEST_ASSERT_FALSE(map.remove(1U));
+
+    /* UID 1, 9 and 17 share the same home entry, UID 2 will be pushed behind them. */
+    TEST_ASSERT_TRUE(map.insert(1U, 10U));
+    TEST_ASSERT_TRUE(map.insert(9U, 11U));
+    TEST_ASSERT_TRUE(map.insert(17U, 12U));
+    TEST_ASSERT_TRUE(map.insert(2U, 13U));
+    TEST_ASSERT_EQUAL_UINT16(4U, map.getCount());
+
+    /* Replacing a value shall not change the number of elements. */
+    TEST_ASSERT_TRUE(map.insert(9U, 21U));
+    TEST_ASSERT_EQUAL_UINT16(4U, map.getCount());
+    TEST_ASSERT_TRUE(map.find(9U, value));
+    TEST_ASSERT_EQUAL_UINT8(21U, value);
+
+    /* Removing the first element of the probe sequence shall keep the others reachable. */
+    TEST_ASSERT_TRUE(map.remove(1U));
+    TEST_ASSERT_EQUAL_UINT16(3U, map.getCount());
+    TEST_ASSERT_FALSE(map.find(1U, value));
+    TEST_ASSERT_TRUE(map.find(9U, value));
+    TEST_ASSERT_EQUAL_UINT8(21U, value);
+    TEST_ASSERT_TRUE(map.find(17U, value));
+    TEST_ASSERT_EQUAL_UINT8(12U, value);
+    TEST_ASSERT_TRUE(map.find(2U, value));
+    TEST_ASSERT_EQUAL_UINT8(13U, value);
+
+    /* Fill the map, one entry always stays free. */
+    map.clear();
+    TEST_ASSERT_EQUAL_UINT16(0U, map.getCount());
+
+    for(uid = 0U; uid < 7U; ++uid)
+    {
+        TEST_ASSERT_TRUE(map.insert(uid * 8U, static_cast<uint8_t>(uid)));
+    }
+
+    TEST_ASSERT_FALSE(map.insert(100U, 0U));
+    TEST_ASSERT_FALSE(map.find(100U, value));
+
+    for(uid = 0U; uid < 7U; ++uid)
+    {
+        TEST_ASSERT_TRUE(map.find(uid * 8U, value));
+        TEST_ASSERT_EQUAL_UINT8(uid, value);
+    }
+
+    /* Remove in the middle of a wrapped probe sequence. */
+    TEST_ASSERT_TRUE(map.remove(24U));
+    TEST_ASSERT_FALSE(map.find(24U, value));
+
+    for(uid = 0U; uid < 7U; ++uid)
+    {
+        if (3U != uid)
+        {
+            TEST_ASSERT_TRUE(map.find(uid * 8U, value));
+            TEST_ASSERT_EQUAL_UINT8(uid, value);
+        }
+    }
+
+    TEST_ASSERT_TRUE(map.insert(100U, 100U));
+    TEST_ASSERT_TRUE(map.find(100U, value));
+    TEST_ASSERT_EQUAL_UINT8(100U, value);
+
+    return;
+}
+
+/**
+ * Test the binary delta patch.
+ */
+static void testDeltaPatch(void)
+{
+    const uint8_t   SOURCE[]    = { 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H' };
+    const uint8_t   EXPECTED[]  = { 'A', 'B', 'C', 'D', 'F', 'G', 'H', 'x', 'y' };
+    const uint8_t   PATCH[]     =
+    {
+        'P', 'X', 'D', 'P', 9U, 0U, 0U, 0U,                         /* Header, target size 9 byte */
+        DeltaPatch::OPCODE_COPY, 0U, 0U, 0U, 0U, 4U, 0U, 0U, 0U,   /* Copy "ABCD" */
+        DeltaPatch::OPCODE_ADD, 4U, 0U, 0U, 0U, 3U, 0U, 0U, 0U,    /* "EFG" + 1 */
+        1U, 1U, 1U,
+        DeltaPatch::OPCODE_DATA, 2U, 0U, 0U, 0U, 'x', 'y',          /* Literal "xy" */
+        DeltaPatch::OPCODE_END
+    };
+    uint8_t         target[16U];
+    size_t          targetSize  = 0U;
+    size_t          index       = 0U;
+    uint8_t         patch[sizeof(PATCH)];
+
+    DeltaPatch deltaPatch(
+        [&SOURCE](uint32_t offset, uint8_t* buffer, size_t size) -> bool
+        {
+            bool status = false;
+
+            if ((sizeof(SOURCE) >= offset) &&
+                ((sizeof(SOURCE) - offset) >= size))
+            {
+                memcpy(buffer, &SOURCE[offset], size);
+                status = true;
+            }
+
+            return status;
+        },
+        [&target, &targetSize](const uint8_t* data, size_t size) -> bool
+        {
+            bool status = false;
+
+            if ((sizeof(target) - targetSize) >= size)
+            {
+                memcpy(&target[targetSize], data, size);
+                targetSize += size;
+                status = true;
+            }
+
+            return status;
+        });
+
+    /* Whole patch at once */
+    TEST_ASSERT_TRUE(deltaPatch.process(PATCH, sizeof(PATCH)));
+    TEST_ASSERT_TRUE(deltaPatch.isFinished());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED), deltaPatch.getTargetSize());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED), deltaPatch.getWritten());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED), targetSize);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(EXPECTED, target, sizeof(EXPECTED)));
+
+    /* Data after the end is rejected. */
+    TEST_ASSERT_FALSE(deltaPatch.process(PATCH, 1U));
+    TEST_ASSERT_TRUE(deltaPatch.isError());
+
+    /* Patch streamed byte by byte */
+    deltaPatch.init();
+    targetSize = 0U;
+
+    for(index = 0U; index < sizeof(PATCH); ++index)
+    {
+        TEST_ASSERT_TRUE(deltaPatch.process(&PATCH[index], 1U));
+    }
+
+    TEST_ASSERT_TRUE(deltaPatch.isFinished());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED), targetSize);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(EXPECTED, target, sizeof(EXPECTED)));
+
+    /* Invalid magic */
+    memcpy(patch, PATCH, sizeof(PATCH));
+    patch[0U] = 'X';
+    deltaPatch.init();
+    targetSize = 0U;
+    TEST_ASSERT_FALSE(deltaPatch.process(patch, sizeof(patch)));
+    TEST_ASSERT_TRUE(deltaPatch.isError());
+    TEST_ASSERT_EQUAL_UINT32(0U, targetSize);
+
+    /* Target image is smaller than the patched data. */
+    memcpy(patch, PATCH, sizeof(PATCH));
+    patch[4U] = 8U;
+    deltaPatch.init();
+    targetSize = 0U;
+    TEST_ASSERT_FALSE(deltaPatch.process(patch, sizeof(patch)));
+    TEST_ASSERT_TRUE(deltaPatch.isError());
+
+    /* Target image is larger than the patched data. */
+    memcpy(patch, PATCH, sizeof(PATCH));
+    patch[4U] = 10U;
+    deltaPatch.init();
+    targetSize = 0U;
+    TEST_ASSERT_FALSE(deltaPatch.process(patch, sizeof(patch)));
+    TEST_ASSERT_TRUE(deltaPatch.isError());
+
+    /* Copy beyond the source image */
+    memcpy(patch, PATCH, sizeof(PATCH));
+    patch[13U] = 9U;
+    deltaPatch.init();
+    targetSize = 0U;
+    TEST_ASSERT_FALSE(deltaPatch.process(patch, sizeof(patch)));
+    TEST_ASSERT_TRUE(deltaPatch.isError());
+
+    /* Unknown opcode */
+    memcpy(patch, PATCH, sizeof(PATCH));
+    patch[8U] = 0x7fU;
+    deltaPatch.init();
+    targetSize = 0U;
+    TEST_ASSERT_FALSE(deltaPatch.process(patch, sizeof(patch)));
+    TEST_ASSERT_TRUE(deltaPatch.isError());
+
+    return;
+}
+
+/**
+ * Test the frame record codec.
+ */
+static void testFrameCodec(void)
+{
+    const size_t            PIXEL_COUNT = 16U;
+    uint32_t                frame[PIXEL_COUNT];
+    uint8_t                 record[FrameCodec::RECORD_HEADER_SIZE + FrameCodec::RUN_HEADER_SIZE + FrameCodec::BYTES_PER_PIXEL * PIXEL_COUNT];
+    uint8_t                 header[FrameCodec::FILE_HEADER_SIZE];
+    FrameCodec::FileHeader  fileHeader;
+    FrameEncoder            encoder(PIXEL_COUNT);
+    FrameDecoder            decoder(PIXEL_COUNT);
+    size_t                  recordSize  = 0U;
+    uint32_t                timestamp   = 0U;
+    size_t                  index       = 0U;
+
+    TEST_ASSERT_TRUE(encoder.isReady());
+    TEST_ASSERT_TRUE(decoder.isReady());
+
+    /* File header */
+    fileHeader.width    = 32U;
+    fileHeader.height   = 8U;
+    fileHeader.seed     = 0x12345678U;
+    TEST_ASSERT_EQUAL(FrameCodec::FILE_HEADER_SIZE, FrameCodec::writeFileHeader(header, fileHeader));
+    fileHeader.width    = 0U;
+    fileHeader.height   = 0U;
+    fileHeader.seed     = 0U;
+    TEST_ASSERT_TRUE(FrameCodec::readFileHeader(header, sizeof(header), fileHeader));
+    TEST_ASSERT_EQUAL_UINT16(32U, fileHeader.width);
+    TEST_ASSERT_EQUAL_UINT16(8U, fileHeader.height);
+    TEST_ASSERT_EQUAL_UINT32(0x12345678U, fileHeader.seed);
+    TEST_ASSERT_FALSE(FrameCodec::readFileHeader(header, sizeof(header) - 1U, fileHeader));
+    header[0] = 'X';
+    TEST_ASSERT_FALSE(FrameCodec::readFileHeader(header, sizeof(header), fileHeader));
+
+    /* The first record is always a key frame. */
+    for(index = 0U; index < PIXEL_COUNT; ++index)
+    {
+        frame[index] = index * 0x00010203U;
+    }
+
+    recordSize = encoder.encode(frame, 0U, record);
+    TEST_ASSERT_EQUAL(sizeof(record), recordSize);
+    TEST_ASSERT_EQUAL_UINT8(FrameCodec::RECORD_TYPE_KEY, record[0]);
+    TEST_ASSERT_EQUAL(recordSize, decoder.decode(record, recordSize, timestamp));
+    TEST_ASSERT_EQUAL_UINT32(0U, timestamp);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(frame, decoder.getFrame(), PIXEL_COUNT);
+
+    /* Unchanged frame is not recorded. */
+    TEST_ASSERT_EQUAL(0U, encoder.encode(frame, 40U, record));
+
+    /* Only the changed pixels are recorded. */
+    frame[3]    = 0x00ff0000U;
+    frame[12]   = 0x0000ff00U;
+    recordSize  = encoder.encode(frame, 80U, record);
+    TEST_ASSERT_EQUAL(FrameCodec::RECORD_HEADER_SIZE + 2U * (FrameCodec::RUN_HEADER_SIZE + FrameCodec::BYTES_PER_PIXEL), recordSize);
+    TEST_ASSERT_EQUAL_UINT8(FrameCodec::RECORD_TYPE_DELTA, record[0]);
+
+    /* Incomplete record */
+    TEST_ASSERT_EQUAL(0U, decoder.decode(record, recordSize - 1U, timestamp));
+
+    TEST_ASSERT_EQUAL(recordSize, decoder.decode(record, recordSize, timestamp));
+    TEST_ASSERT_EQUAL_UINT32(80U, timestamp);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(frame, decoder.getFrame(), PIXEL_COUNT);
+    TEST_ASSERT_EQUAL_UINT32(FrameCodec::hash(frame, PIXEL_COUNT), FrameCodec::hash(decoder.getFrame(), PIXEL_COUNT));
+
+    /* Requested key frame */
+    frame[0] = 0x00ffffffU;
+    encoder.requestKeyFrame();
+    recordSize = encoder.encode(frame, 120U, record);
+    TEST_ASSERT_EQUAL(sizeof(record), recordSize);
+    TEST_ASSERT_EQUAL_UINT8(FrameCodec::RECORD_TYPE_KEY, record[0]);
+
+    /* Run out of frame bounds */
+    record[FrameCodec::RECORD_HEADER_SIZE + 0U] = 1U;
+    TEST_ASSERT_EQUAL(0U, decoder.decode(record, recordSize, timestamp));
+
+    return;
+}
+
+/**
+ * Test the LZSS codec.
+ */
+static void testLzss(void)
+{
+    const char      TEXT[]          = "{\"slots\":[{\"uid\":1,\"duration\":30},{\"uid\":2,\"duration\":30},{\"uid\":3,\"duration\":30}]}";
+    const size_t    TEXT_SIZE       = sizeof(TEXT) - 1U;
+    uint8_t         compressed[Lzss::getMaxCompressedSize(sizeof(TEXT))];
+    uint8_t         decompressed[sizeof(TEXT)];
+    uint8_t         random[64U];
+    uint8_t         randomCompressed[Lzss::getMaxCompressedSize(sizeof(random))];
+    size_t          compressedSize  = 0U;
+    size_t          index           = 0U;
+
+    /* Repeated content is compressed. */
+    compressedSize = Lzss::compress(reinterpret_cast<const uint8_t*>(TEXT), TEXT_SIZE, compressed, sizeof(compressed));
+    TEST_ASSERT_NOT_EQUAL(0U, compressedSize);
+    TEST_ASSERT_TRUE(TEXT_SIZE > compressedSize);
+    TEST_ASSERT_EQUAL(TEXT_SIZE, Lzss::decompress(compressed, compressedSize, decompressed, sizeof(decompressed)));
+    TEST_ASSERT_TRUE(0 == memcmp(TEXT, decompressed, TEXT_SIZE));
+
+    /* Too small buffers */
+    TEST_ASSERT_EQUAL(0U, Lzss::compress(reinterpret_cast<const uint8_t*>(TEXT), TEXT_SIZE, compressed, compressedSize - 1U));
+    TEST_ASSERT_EQUAL(0U, Lzss::decompress(compressed, compressedSize, decompressed, TEXT_SIZE - 1U));
+
+    /* Truncated match */
+    TEST_ASSERT_NOT_EQUAL(TEXT_SIZE, Lzss::decompress(compressed, compressedSize - 1U, decompressed, sizeof(decompressed)));
+
+    /* Data without matches fits into the max. compressed size. */
+    for(index = 0U; index < sizeof(random); ++index)
+    {
+        random[index] = static_cast<uint8_t>((index * 97U) ^ (index >> 1U));
+    }
+
+    compressedSize = Lzss::compress(random, sizeof(random), randomCompressed, sizeof(randomCompressed));
+    TEST_ASSERT_NOT_EQUAL(0U, compressedSize);
+    TEST_ASSERT_EQUAL(sizeof(random), Lzss::decompress(randomCompressed, compressedSize, decompressed, sizeof(decompressed)));
+    TEST_ASSERT_TRUE(0 == memcmp(random, decompressed, sizeof(random)));
+
+    /* Long runs of the same byte use overlapping matches. */
+    memset(random, 'a', sizeof(random));
+    compressedSize = Lzss::compress(random, sizeof(random), randomCompressed, sizeof(randomCompressed));
+    TEST_ASSERT_EQUAL(4U, compressedSize);
+    TEST_ASSERT_EQUAL(sizeof(random), Lzss::decompress(randomCompressed, compressedSize, decompressed, sizeof(decompressed)));
+    TEST_ASSERT_TRUE(0 == memcmp(random, decompressed, sizeof(random)));
+
+    return;
+}
+
+/**
+ * Test the JPEG thumbnail decoder.
+ */
+static void testJpegThumbDecoder(void)
+{
+    /* 32x16 pixel, YCbCr 4:2:0, restart interval of 1 MCU */
+    const uint8_t       JPEG[]          =
+    {
+        0xffU, 0xd8U, 0xffU, 0xe0U, 0x00U, 0x10U, 0x4aU, 0x46U, 0x49U, 0x46U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U,
+        0x00U, 0x01U, 0x00U, 0x00U, 0xffU, 0xdbU, 0x00U, 0x43U, 0x00U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U,
+        0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U,
+        0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U,
+        0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U,
+        0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0x08U, 0xffU, 0xc0U, 0x00U, 0x11U, 0x08U, 0x00U, 0x10U,
+        0x00U, 0x20U, 0x03U, 0x01U, 0x22U, 0x00U, 0x02U, 0x11U, 0x00U, 0x03U, 0x11U, 0x00U, 0xffU, 0xc4U, 0x00U, 0x33U,
+        0x00U, 0x00U, 0x01U, 0x05U, 0x01U, 0x01U, 0x01U, 0x01U, 0x01U, 0x01U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+        0x00U, 0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0aU, 0x0bU, 0x10U, 0x00U, 0x03U,
+        0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x01U,
+        0xf0U, 0xffU, 0xddU, 0x00U, 0x04U, 0x00U, 0x01U, 0xffU, 0xdaU, 0x00U, 0x0cU, 0x03U, 0x01U, 0x00U, 0x02U, 0x00U,
+        0x03U, 0x00U, 0x00U, 0x3fU, 0x00U, 0xf4U, 0x87U, 0x03U, 0x81U, 0xc0U, 0xe0U, 0x71U, 0xeeU, 0x0eU, 0x3fU, 0xffU,
+        0xd0U, 0xf3U, 0xb7U, 0x1dU, 0x43U, 0x8eU, 0x5dU, 0xc7U, 0x50U, 0xe3U, 0xdcU, 0x1cU, 0x0eU, 0x3fU, 0xffU, 0xd9U
+    };
+    JpegThumbDecoder*   decoder         = new JpegThumbDecoder();
+    Color               bitmap[JpegThumbDecoder::MAX_THUMB_WIDTH * JpegThumbDecoder::MAX_THUMB_HEIGHT];
+    uint8_t             progressive[sizeof(JPEG)];
+    size_t              index           = 0U;
+
+    TEST_ASSERT_NOT_NULL(decoder);
+
+    /* Invalid thumbnail size */
+    TEST_ASSERT_FALSE(decoder->begin(0U, 1U));
+    TEST_ASSERT_FALSE(decoder->begin(JpegThumbDecoder::MAX_THUMB_WIDTH + 1U, 1U));
+
+    /* Every 8x8 block is one pixel of the thumbnail. */
+    TEST_ASSERT_TRUE(decoder->begin(4U, 2U));
+    TEST_ASSERT_TRUE(decoder->parse(JPEG, sizeof(JPEG)));
+    TEST_ASSERT_TRUE(decoder->isComplete());
+    TEST_ASSERT_EQUAL_UINT16(32U, decoder->getWidth());
+    TEST_ASSERT_EQUAL_UINT16(16U, decoder->getHeight());
+    TEST_ASSERT_TRUE(decoder->getThumbnail(bitmap));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff79c8U, static_cast<uint32_t>(bitmap[0U]));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff79c8U, static_cast<uint32_t>(bitmap[5U]));
+    TEST_ASSERT_EQUAL_UINT32(0x003c16ffU, static_cast<uint32_t>(bitmap[2U]));
+    TEST_ASSERT_EQUAL_UINT32(0x00643effU, static_cast<uint32_t>(bitmap[7U]));
+
+    /* Area-averaging, fed byte by byte */
+    TEST_ASSERT_TRUE(decoder->begin(2U, 1U));
+    for(index = 0U; index < sizeof(JPEG); ++index)
+    {
+        TEST_ASSERT_TRUE(decoder->parse(&JPEG[index], 1U));
+    }
+    TEST_ASSERT_TRUE(decoder->getThumbnail(bitmap));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff79c8U, static_cast<uint32_t>(bitmap[0U]));
+    TEST_ASSERT_EQUAL_UINT32(0x00502affU, static_cast<uint32_t>(bitmap[1U]));
+
+    /* Incomplete image */
+    TEST_ASSERT_TRUE(decoder->begin(2U, 1U));
+    TEST_ASSERT_TRUE(decoder->parse(JPEG, sizeof(JPEG) - 10U));
+    TEST_ASSERT_FALSE(decoder->isComplete());
+    TEST_ASSERT_FALSE(decoder->getThumbnail(bitmap));
+
+    /* Progressive image is not supported. */
+    memcpy(progressive, JPEG, sizeof(JPEG));
+    progressive[90U] = 0xC2U;
+    TEST_ASSERT_TRUE(decoder->begin(2U, 1U));
+    TEST_ASSERT_FALSE(decoder->parse(progressive, sizeof(progressive)));
+
+    delete decoder;
+
+    return;
+}
+
+/**
+ * Test the streaming XML tag extractor.
+ */
+static void testXmlTagExtractor(void)
+{
+    const char      XML[]       = "<data><code>ok</code><D_Y_10_10>1</D_Y_10_10><D_Y_10_1>789</D_Y_10_1></data>";
+    const char      EMPTY[]     = "<data><D_Y_10_1 unit=\"l\"/></data>";
+    XmlTagExtractor extractor;
+    size_t          index       = 0U;
+
+    /* Without tag nothing is found. */
+    extractor.parse(reinterpret_cast<const uint8_t*>(XML), sizeof(XML) - 1U);
+    TEST_ASSERT_FALSE(extractor.isFound());
+
+    /* A tag, which starts with the same name, is skipped. */
+    TEST_ASSERT_TRUE(extractor.setTag("D_Y_10_1"));
+    extractor.parse(reinterpret_cast<const uint8_t*>(XML), sizeof(XML) - 1U);
+    TEST_ASSERT_TRUE(extractor.isFound());
+    TEST_ASSERT_EQUAL_STRING("789", extractor.getValue());
+
+    /* Fed byte by byte */
+    extractor.reset();
+    for(index = 0U; index < (sizeof(XML) - 1U); ++index)
+    {
+        extractor.parse(reinterpret_cast<const uint8_t*>(&XML[index]), 1U);
+    }
+    TEST_ASSERT_TRUE(extractor.isFound());
+    TEST_ASSERT_EQUAL_STRING("789", extractor.getValue());
+
+    /* Incomplete value */
+    extractor.reset();
+    extractor.parse(reinterpret_cast<const uint8_t*>(XML), sizeof(XML) - 20U);
+    TEST_ASSERT_FALSE(extractor.isFound());
+
+    /* Empty element with attribute */
+    extractor.reset();
+    extractor.parse(reinterpret_cast<const uint8_t*>(EMPTY), sizeof(EMPTY) - 1U);
+    TEST_ASSERT_TRUE(extractor.isFound());
+    TEST_ASSERT_EQUAL_STRING("", extractor.getValue());
+
+    /* Invalid tag */
+    TEST_ASSERT_FALSE(extractor.setTag(""));
+
+    return;
+}
+
+/**
+ * Test the glyph metrics cache.
+ */
+static void testGlyphMetrics(void)
+{
+    GlyphMetrics&   metrics     = GlyphMetrics::getInstance();
+    const uint8_t*  advances    = metrics.getAdvances(&TomThumb);
+    const GFXglyph* glyph       = &TomThumb.glyph['T' - TomThumb.first];
+
+    /* The table is built only once per font. */
+    TEST_ASSERT_TRUE(advances == metrics.getAdvances(&TomThumb));
+
+    /* Available character */
+    TEST_ASSERT_EQUAL_UINT8(glyph->xAdvance, advances['T']);
+
+    /* Line feed, carriage return and not available characters have no advance. */
+    TEST_ASSERT_EQUAL_UINT8(0U, advances['\n']);
+    TEST_ASSERT_EQUAL_UINT8(0U, advances['\r']);
+    TEST_ASSERT_EQUAL_UINT8(0U, advances[0x01]);
+
+    /* Text width is the sum of the advances of the widest line. */
+    TEST_ASSERT_EQUAL_UINT16(4U * glyph->xAdvance, metrics.getTextWidth(&TomThumb, "TTTT"));
+    TEST_ASSERT_EQUAL_UINT16(3U * glyph->xAdvance, metrics.getTextWidth(&TomThumb, "TT\nTTT\nT"));
+    TEST_ASSERT_EQUAL_UINT16(2U * glyph->xAdvance, metrics.getTextWidth(&TomThumb, "TTTT", 2U));
+    TEST_ASSERT_EQUAL_UINT16(0U, metrics.getTextWidth(nullptr, "TTTT"));
+
+    /* After clearing, the table is built again. */
+    metrics.clear();
+    advances = metrics.getAdvances(&TomThumb);
+    TEST_ASSERT_EQUAL_UINT8(glyph->xAdvance, advances['T']);
+
+    return;
+}
+
+/**
+ * Test the streaming image encoder.
+ */
+static void testImageEncoder(void)
+{
+    const uint32_t  frame[]     = { 0x00112233U, 0x00445566U, 0x00778899U, 0x00aabbccU };
+    const uint8_t   IEND[]      = { 0x00U, 0x00U, 0x00U, 0x00U, 'I', 'E', 'N', 'D', 0xaeU, 0x42U, 0x60U, 0x82U };
+    uint8_t         image[128];
+    size_t          size        = 0U;
+    size_t          count       = 0U;
+
+    /* BMP: 2x2 pixel, rows padded to 8 bytes, bottom-up */
+    {
+        ImageEncoder encoder(ImageEncoder::FORMAT_BMP, frame, 2U, 2U, 1U);
+
+        TEST_ASSERT_EQUAL(ImageEncoder::BMP_HEADER_SIZE + 2U * 8U, encoder.getSize());
+
+        /* Read in small pieces. */
+        size = 0U;
+        while(0U < (count = encoder.read(&image[size], 5U)))
+        {
+            size += count;
+        }
+
+        TEST_ASSERT_EQUAL(encoder.getSize(), size);
+        TEST_ASSERT_TRUE(encoder.isFinished());
+        TEST_ASSERT_EQUAL_UINT8('B', image[0]);
+        TEST_ASSERT_EQUAL_UINT8('M', image[1]);
+        TEST_ASSERT_EQUAL_UINT8(size, image[2]);
+        TEST_ASSERT_EQUAL_UINT8(2U, image[18]);
+        TEST_ASSERT_EQUAL_UINT8(24U, image[28]);
+
+        /* First stored row is the bottom row. */
+        TEST_ASSERT_EQUAL_UINT8(0x99U, image[54]);
+        TEST_ASSERT_EQUAL_UINT8(0x88U, image[55]);
+        TEST_ASSERT_EQUAL_UINT8(0x77U, image[56]);
+        TEST_ASSERT_EQUAL_UINT8(0x00U, image[60]);
+        TEST_ASSERT_EQUAL_UINT8(0x33U, image[62]);
+    }
+
+    /* PNG: 2x2 pixel upscaled to 4x4 */
+    {
+        ImageEncoder    encoder(ImageEncoder::FORMAT_PNG, frame, 2U, 2U, 2U);
+        const size_t    RAW_SIZE    = 4U * (1U + 4U * 3U);
+        const size_t    DATA_OFFSET = ImageEncoder::PNG_HEADER_SIZE + 5U;
+
+        TEST_ASSERT_EQUAL(ImageEncoder::PNG_HEADER_SIZE + 5U + RAW_SIZE + 20U, encoder.getSize());
+
+        size = encoder.read(image, sizeof(image));
+        TEST_ASSERT_EQUAL(encoder.getSize(), size);
+        TEST_ASSERT_EQUAL(0U, encoder.read(image, sizeof(image)));
+
+        TEST_ASSERT_EQUAL_UINT8(0x89U, image[0]);
+        TEST_ASSERT_EQUAL_UINT8('P', image[1]);
+        TEST_ASSERT_EQUAL_UINT8(4U, image[19]);
+        TEST_ASSERT_EQUAL_UINT8(4U, image[23]);
+
+        /* Single stored deflate block */
+        TEST_ASSERT_EQUAL_UINT8(1U, image[ImageEncoder::PNG_HEADER_SIZE]);
+        TEST_ASSERT_EQUAL_UINT8(RAW_SIZE, image[ImageEncoder::PNG_HEADER_SIZE + 1U]);
+
+        /* Each row starts with filter type none, every pixel is doubled. */
+        TEST_ASSERT_EQUAL_UINT8(0U, image[DATA_OFFSET]);
+        TEST_ASSERT_EQUAL_UINT8(0x11U, image[DATA_OFFSET + 1U]);
+        TEST_ASSERT_EQUAL_UINT8(0x11U, image[DATA_OFFSET + 4U]);
+        TEST_ASSERT_EQUAL_UINT8(0x44U, image[DATA_OFFSET + 7U]);
+        TEST_ASSERT_EQUAL_UINT8(0x77U, image[DATA_OFFSET + 2U * 13U + 1U]);
+
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&image[size - sizeof(IEND)], IEND, sizeof(IEND)));
+    }
+
+    /* Nothing to encode */
+    {
+        ImageEncoder encoder(ImageEncoder::FORMAT_PNG, nullptr, 2U, 2U, 1U);
+
+        TEST_ASSERT_EQUAL(0U, encoder.getSize());
+        TEST_ASSERT_EQUAL(0U, encoder.read(image, sizeof(image)));
+    }
+
+    return;
+}
+
+/**
+ * Test that the rendering hot paths don't allocate heap memory per frame.
+ */
+static void testAllocation(void)
+{
+    const uint32_t          FRAMES          = 100U;
+    const uint32_t          FRAME_PERIOD    = 40U;  /* ms */
+    const TextWidget::ScrollMode SCROLL_MODES[] =
+    {
+        TextWidget::SCROLL_MODE_PIXEL,
+        TextWidget::SCROLL_MODE_SMOOTH,
+        TextWidget::SCROLL_MODE_SMOOTH_ANTIALIASED
+    };
+    TestGfx                 testGfx;
+    Canvas                  canvas(TestGfx::WIDTH, TestGfx::HEIGHT, 0, 0);
+    Canvas                  bufferedCanvas(TestGfx::WIDTH, TestGfx::HEIGHT, 0, 0, true);
+    TestWidget              testWidget;
+    TestWidget              testWidget2;
+    NativeClock&            nativeClock     = getNativeClock();
+    uint32_t                frame           = 0U;
+    uint8_t                 index           = 0U;
+
+    if (false == AllocTracker::isEnabled())
+    {
+        TEST_IGNORE_MESSAGE("Allocation tracking is disabled.");
+        return;
+    }
+
+    /* Self test: The tracker must see an allocation. The allocation
+     * functions are called explicit, because the compiler may elide a
+     * new/delete expression pair.
+     */
+    AllocTracker::reset();
+    ::operator delete(::operator new(sizeof(uint32_t)));
+    TEST_ASSERT_EQUAL_UINT32(1U, AllocTracker::getAllocCount());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(uint32_t), AllocTracker::getAllocBytes());
+    TEST_ASSERT_EQUAL_UINT32(1U, AllocTracker::getFreeCount());
+
+    /* Canvas::update performs zero allocations per frame. */
+    TEST_ASSERT_TRUE(canvas.addWidget(testWidget));
+    TEST_ASSERT_TRUE(bufferedCanvas.addWidget(testWidget2));
+    canvas.update(testGfx);
+    bufferedCanvas.update(testGfx);
+
+    AllocTracker::reset();
+    for(frame = 0U; frame < FRAMES; ++frame)
+    {
+        testWidget.move(frame % TestGfx::WIDTH, 0);
+        testWidget2.move(frame % TestGfx::WIDTH, 0);
+        canvas.update(testGfx);
+        bufferedCanvas.update(testGfx);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0U, AllocTracker::getAllocCount());
+
+    /* TextWidget::update during scrolling allocates nothing. */
+    nativeClock.isFixed = true;
+    nativeClock.now     = 0UL;
+
+    for(index = 0U; index < UTIL_ARRAY_NUM(SCROLL_MODES); ++index)
+    {
+        TextWidget textWidget;
+
+        textWidget.setScrollMode(SCROLL_MODES[index]);
+        textWidget.setFormatStr("\\#FF0000Scrolling \\#00FF00text, \\#0000FFwhich is too long for the display.");
+
+        /* The first update prepares the scrolling. */
+        textWidget.update(testGfx);
+
+        AllocTracker::reset();
+        for(frame = 0U; frame < FRAMES; ++frame)
+        {
+            nativeClock.now += FRAME_PERIOD;
+            textWidget.update(testGfx);
+        }
+        TEST_ASSERT_EQUAL_UINT32(0U, AllocTracker::getAllocCount());
+    }
+
+    nativeClock.isFixed = false;
+
+    return;
+}
+
+/**
+ * Test the graphics with the different pixel storage formats.
+ */
+static void testPixelGfx(void)
+{
+    const Color             COLOR       = 0x123456;
+    const Color             FOREGROUND  = 0x00ff00;
+    const Color             BACKGROUND  = 0x000011;
+    TestGfx                 testGfx;
+    PixelGfx<Rgb888Pixel>   rgb888Gfx(TestGfx::WIDTH / 2U, TestGfx::HEIGHT);
+    PixelGfx<Rgb565Pixel>   rgb565Gfx(TestGfx::WIDTH / 2U, TestGfx::HEIGHT);
+    PixelGfx<Mono1Pixel>    monoGfx(TestGfx::WIDTH + 8U, TestGfx::HEIGHT, FOREGROUND);
+    PixelGfx<Mono1Pixel>    maskGfx(TestGfx::WIDTH, TestGfx::HEIGHT);
+
+    TEST_ASSERT_TRUE(rgb888Gfx.isAllocated());
+    TEST_ASSERT_TRUE(rgb565Gfx.isAllocated());
+    TEST_ASSERT_TRUE(monoGfx.isAllocated());
+
+    /* The storage formats need less memory. */
+    TEST_ASSERT_EQUAL_UINT32(3U * (TestGfx::WIDTH / 2U) * TestGfx::HEIGHT, rgb888Gfx.getBufferSize());
+    TEST_ASSERT_EQUAL_UINT32(2U * (TestGfx::WIDTH / 2U) * TestGfx::HEIGHT, rgb565Gfx.getBufferSize());
+    TEST_ASSERT_EQUAL_UINT32(2U, monoGfx.getWordsPerRow());
+    TEST_ASSERT_EQUAL_UINT32(2U * sizeof(uint32_t) * TestGfx::HEIGHT, monoGfx.getBufferSize());
+
+    /* RGB888 keeps the color. */
+    rgb888Gfx.fillRect(1, 1, 4U, 2U, COLOR);
+    TEST_ASSERT_EQUAL_UINT32(COLOR, rgb888Gfx.getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(COLOR, rgb888Gfx.getColor(4, 2));
+    TEST_ASSERT_EQUAL_UINT32(0U, rgb888Gfx.getColor(5, 2));
+
+    /* Blit converts to the target and places it at the given position. */
+    testGfx.fill(BACKGROUND);
+    rgb888Gfx.blit(testGfx, 1, 0);
+    TEST_ASSERT_TRUE(testGfx.verify(2, 1, 4U, 2U, COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(1, 0, TestGfx::WIDTH / 2U, 1U, 0U));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, 1U, TestGfx::HEIGHT, BACKGROUND));
+    TEST_ASSERT_TRUE(testGfx.verify(1 + TestGfx::WIDTH / 2, 0, TestGfx::WIDTH / 2U - 1U, TestGfx::HEIGHT, BACKGROUND));
+
+    /* RGB565 looses the lower bits, but keeps the primary colors. */
+    rgb565Gfx.drawPixel(0, 0, 0xff0000U);
+    rgb565Gfx.drawPixel(1, 0, COLOR);
+    TEST_ASSERT_EQUAL_UINT32(0xff0000U, rgb565Gfx.getColor(0, 0));
+    TEST_ASSERT_UINT32_WITHIN(0x080808U, static_cast<uint32_t>(COLOR), static_cast<uint32_t>(rgb565Gfx.getColor(1, 0)));
+
+    /* Conversion between the formats. */
+    rgb888Gfx.copy(rgb565Gfx);
+    TEST_ASSERT_EQUAL_UINT32(0xff0000U, rgb888Gfx.getColor(0, 0));
+
+    /* Monochrome: every not black pixel is set and shown in the foreground color. */
+    TEST_ASSERT_EQUAL_UINT32(0U, monoGfx.getColor(0, 0));
+    monoGfx.drawPixel(0, 0, COLOR);
+    TEST_ASSERT_EQUAL_UINT32(FOREGROUND, monoGfx.getColor(0, 0));
+    monoGfx.drawPixel(0, 0, ColorDef::BLACK);
+    TEST_ASSERT_EQUAL_UINT32(0U, monoGfx.getColor(0, 0));
+
+    /* Fill across the word border. */
+    monoGfx.fillSpan(30, 1, 4U, COLOR);
+    TEST_ASSERT_EQUAL_UINT32(0x00000000U, monoGfx.getRow(0)[0]);
+    TEST_ASSERT_EQUAL_UINT32(0xc0000000U, monoGfx.getRow(1)[0]);
+    TEST_ASSERT_EQUAL_UINT32(0x00000003U, monoGfx.getRow(1)[1]);
+    monoGfx.fillSpan(31, 1, 2U, ColorDef::BLACK);
+    TEST_ASSERT_EQUAL_UINT32(0x40000000U, monoGfx.getRow(1)[0]);
+    TEST_ASSERT_EQUAL_UINT32(0x00000002U, monoGfx.getRow(1)[1]);
+
+    /* Fill a whole row and clip it. */
+    monoGfx.fillSpan(-2, 2, TestGfx::WIDTH + 20U, COLOR);
+    TEST_ASSERT_EQUAL_UINT32(0xffffffffU, monoGfx.getRow(2)[0]);
+    TEST_ASSERT_EQUAL_UINT32(0x000000ffU, monoGfx.getRow(2)[1]);
+
+    /* Dimming clears the pixel only below the half. */
+    monoGfx.dimPixel(0, 2, 200U);
+    TEST_ASSERT_EQUAL_UINT32(FOREGROUND, monoGfx.getColor(0, 2));
+    monoGfx.dimPixel(0, 2, 10U);
+    TEST_ASSERT_EQUAL_UINT32(0U, monoGfx.getColor(0, 2));
+
+    /* Transparent blit keeps the background. */
+    maskGfx.fillSpan(31, 1, 1U, COLOR);
+    maskGfx.fillSpan(1, 2, TestGfx::WIDTH - 1U, COLOR);
+    maskGfx.setForeground(COLOR);
+    testGfx.fill(BACKGROUND);
+    maskGfx.blit(testGfx, 0, 0);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, 1U, BACKGROUND));
+    TEST_ASSERT_TRUE(testGfx.verify(30, 1, 1U, 1U, BACKGROUND));
+    TEST_ASSERT_TRUE(testGfx.verify(31, 1, 1U, 1U, COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 2, 1U, 1U, BACKGROUND));
+    TEST_ASSERT_TRUE(testGfx.verify(1, 2, TestGfx::WIDTH - 1U, 1U, COLOR));
+
+    /* Opaque blit draws the cleared pixels black. */
+    testGfx.fill(BACKGROUND);
+    maskGfx.blit(testGfx, 0, 0, false);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestGfx::WIDTH, 1U, 0U));
+    TEST_ASSERT_TRUE(testGfx.verify(1, 2, TestGfx::WIDTH - 1U, 1U, COLOR));
+
+    return;
+}
+
+/**
+ * Test the pixel storage formats.
+ */
+static void testPixelFormat(void)
+{
+    const uint32_t  RGB888_COLORS[] = { 0x000000U, 0xffffffU, 0x123456U, 0xff0000U, 0x00ff00U, 0x0000ffU, 0x010101U, 0xfefefeU };
+    uint8_t         index           = 0U;
+    uint8_t         red5            = 0U;
+    uint8_t         green6          = 0U;
+    uint8_t         blue5           = 0U;
+
+    /* RGB888: A default pixel is black. */
+    TEST_ASSERT_EQUAL_UINT32(0U, Rgb888Pixel().get());
+
+    /* RGB888: Every color survives the round trip, including the edge values. */
+    for(index = 0U; index < UTIL_ARRAY_NUM(RGB888_COLORS); ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT32(RGB888_COLORS[index], Rgb888Pixel(Color(RGB888_COLORS[index])).get());
+    }
+
+    /* RGB888: The intensity is applied on write. */
+    TEST_ASSERT_EQUAL_UINT32(0x804020U, Rgb888Pixel(Color(0xffU, 0x80U, 0x40U, 128U)).get());
+    TEST_ASSERT_EQUAL_UINT32(0U, Rgb888Pixel(Color(0xffU, 0xffU, 0xffU, 0U)).get());
+
+    /* RGB888: Dimming with the max. ratio keeps the pixel, with 0 it gets black. */
+    {
+        Rgb888Pixel pixel(Color(0xff8001U));
+        Rgb888Pixel refPixel(Color(0xff8001U));
+
+        pixel.dim(UINT8_MAX);
+        TEST_ASSERT_TRUE(refPixel == pixel);
+        pixel.dim(128U);
+        TEST_ASSERT_TRUE(refPixel != pixel);
+        TEST_ASSERT_EQUAL_UINT32(0x804000U, pixel.get());
+        pixel.dim(0U);
+        TEST_ASSERT_TRUE(Rgb888Pixel() == pixel);
+    }
+
+    /* RGB565: A default pixel is black. */
+    TEST_ASSERT_EQUAL_UINT32(0U, Rgb565Pixel().get());
+
+    /* RGB565: Every representable color survives the round trip. The lower
+     * bits are replicated from the upper bits, therefore the full range is reached.
+     */
+    for(red5 = 0U; red5 < 32U; ++red5)
+    {
+        for(green6 = 0U; green6 < 64U; ++green6)
+        {
+            for(blue5 = 0U; blue5 < 32U; ++blue5)
+            {
+                const Color COLOR(  (red5 << 3U) | (red5 >> 2U),
+                                    (green6 << 2U) | (green6 >> 4U),
+                                    (blue5 << 3U) | (blue5 >> 2U));
+
+                TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR), static_cast<uint32_t>(Rgb565Pixel(COLOR).get()));
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0xffffffU, Rgb565Pixel(Color(0xffffffU)).get());
+
+    /* RGB565: The lower bits of the channels are truncated. */
+    TEST_ASSERT_EQUAL_UINT32(0x000000U, Rgb565Pixel(Color(0x070307U)).get());
+    TEST_ASSERT_EQUAL_UINT32(0x080408U, Rgb565Pixel(Color(0x080408U)).get());
+    TEST_ASSERT_EQUAL_UINT32(0x080408U, Rgb565Pixel(Color(0x0f070fU)).get());
+    TEST_ASSERT_EQUAL_UINT32(0xffffffU, Rgb565Pixel(Color(0xf8fcf8U)).get());
+
+    /* RGB565: The intensity is applied on write. */
+    TEST_ASSERT_EQUAL_UINT32(0U, Rgb565Pixel(Color(0xffU, 0xffU, 0xffU, 0U)).get());
+
+    /* RGB565: Dimming with the max. ratio keeps the pixel, with 0 it gets black. */
+    {
+        Rgb565Pixel pixel(Color(0xffffffU));
+        Rgb565Pixel refPixel(Color(0xffffffU));
+
+        pixel.dim(UINT8_MAX);
+        TEST_ASSERT_TRUE(refPixel == pixel);
+        pixel.dim(128U);
+        TEST_ASSERT_TRUE(refPixel != pixel);
+        TEST_ASSERT_EQUAL_UINT32(0x7b7d7bU, pixel.get());
+        pixel.dim(0U);
+        TEST_ASSERT_TRUE(Rgb565Pixel() == pixel);
+    }
+
+    /* Monochrome: A storage word holds one pixel per bit. */
+    TEST_ASSERT_EQUAL_UINT8(8U * sizeof(uint32_t), Mono1Pixel::PIXELS_PER_WORD);
+
+    return;
+}
+
+/**
+ * Test the sunrise and sunset calculation.
+ */
+static void testSunCalc(void)
+{
+    const float     LATITUDE    = 48.858F;  /* Paris */
+    const float     LONGITUDE   = 2.295F;
+    const int16_t   TOLERANCE   = 3;        /* min */
+    int16_t         sunrise     = 0;
+    int16_t         sunset      = 0;
+
+    /* Summer solstice: 03:47 and 19:58 UTC */
+    TEST_ASSERT_TRUE(SunCalc::calculate(LATITUDE, LONGITUDE, 171U, sunrise, sunset));
+    TEST_ASSERT_INT_WITHIN(TOLERANCE, 3 * 60 + 47, sunrise);
+    TEST_ASSERT_INT_WITHIN(TOLERANCE, 19 * 60 + 58, sunset);
+
+    /* Winter solstice: 07:42 and 15:56 UTC */
+    TEST_ASSERT_TRUE(SunCalc::calculate(LATITUDE, LONGITUDE, 354U, sunrise, sunset));
+    TEST_ASSERT_INT_WITHIN(TOLERANCE, 7 * 60 + 42, sunrise);
+    TEST_ASSERT_INT_WITHIN(TOLERANCE, 15 * 60 + 56, sunset);
+
+    /* Western longitudes shift the times. */
+    TEST_ASSERT_TRUE(SunCalc::calculate(LATITUDE, -LONGITUDE - 180.0F, 171U, sunrise, sunset));
+    TEST_ASSERT_TRUE(SunCalc::MINUTES_PER_DAY < sunset);
+
+    /* Polar day and polar night */
+    TEST_ASSERT_FALSE(SunCalc::calculate(80.0F, 0.0F, 171U, sunrise, sunset));
+    TEST_ASSERT_FALSE(SunCalc::calculate(80.0F, 0.0F, 354U, sunrise, sunset));
+
+    return;
+}
+
+/**
+ * Test the NTP synchronization.
+ */
+static void testNtpSync(void)
+{
+    const uint64_t  T1              = 1625097600000000ULL;  /* 2021-07-01 00:00:00 */
+    const uint64_t  T2              = T1 + 1500250U;
+    const uint64_t  T3              = T2 + 500U;
+    uint8_t         request[NtpSync::PACKET_SIZE];
+    uint8_t         response[NtpSync::PACKET_SIZE];
+    uint8_t         timestamp[NtpSync::PACKET_SIZE];
+    uint64_t        receiveTime     = 0U;
+    uint64_t        transmitTime    = 0U;
+    NtpSync         ntpSync;
+    uint8_t         index           = 0U;
+    uint64_t        t1              = 0U;
+
+    /* Request */
+    TEST_ASSERT_EQUAL(0U, NtpSync::writeRequest(request, NtpSync::PACKET_SIZE - 1U, T1));
+    TEST_ASSERT_EQUAL(NtpSync::PACKET_SIZE, NtpSync::writeRequest(request, sizeof(request), T1));
+    TEST_ASSERT_EQUAL_UINT8(0x23U, request[0]);
+
+    /* Server response with the request transmit timestamp as origin */
+    memcpy(response, request, sizeof(response));
+    response[0] = 0x24U;
+    response[1] = 2U;
+    memcpy(&response[24], &request[40], 8U);
+    (void)NtpSync::writeRequest(timestamp, sizeof(timestamp), T2);
+    memcpy(&response[32], &timestamp[40], 8U);
+    (void)NtpSync::writeRequest(timestamp, sizeof(timestamp), T3);
+    memcpy(&response[40], &timestamp[40], 8U);
+
+    TEST_ASSERT_TRUE(NtpSync::readResponse(response, sizeof(response), T1, receiveTime, transmitTime));
+    TEST_ASSERT_INT_WITHIN(1, 0, static_cast<int32_t>(receiveTime - T2));
+    TEST_ASSERT_INT_WITHIN(1, 0, static_cast<int32_t>(transmitTime - T3));
+
+    /* Response to another request */
+    TEST_ASSERT_FALSE(NtpSync::readResponse(response, sizeof(response), T1 + 1000U, receiveTime, transmitTime));
+
+    /* Kiss-o'-death */
+    response[1] = 0U;
+    TEST_ASSERT_FALSE(NtpSync::readResponse(response, sizeof(response), T1, receiveTime, transmitTime));
+
+    /* The first sample steps the clock: 1.5 s offset, 250 us delay */
+    TEST_ASSERT_FALSE(ntpSync.isSynchronized());
+    TEST_ASSERT_EQUAL(NtpSync::CORRECTION_STEP, ntpSync.addSample(T1, T2, T3, T1 + 1000U));
+    TEST_ASSERT_TRUE(ntpSync.isSynchronized());
+    TEST_ASSERT_TRUE(1500000 == ntpSync.getOffset());
+    TEST_ASSERT_TRUE(250 == ntpSync.getDelay());
+
+    /* Small offsets are slewed, a stable clock extends the poll interval. */
+    TEST_ASSERT_EQUAL_UINT32(NtpSync::MIN_POLL_INTERVAL, ntpSync.getPollInterval());
+    for(index = 0U; index < NtpSync::STABLE_SAMPLES; ++index)
+    {
+        t1 = T1 + (index + 1U) * 64000000ULL;
+        TEST_ASSERT_EQUAL(NtpSync::CORRECTION_SLEW, ntpSync.addSample(t1, t1 + 1250U, t1 + 1300U, t1 + 500U));
+    }
+    TEST_ASSERT_TRUE(1025 == ntpSync.getOffset());
+    TEST_ASSERT_EQUAL_UINT32(2U * NtpSync::MIN_POLL_INTERVAL, ntpSync.getPollInterval());
+
+    /* A unstable clock shortens the poll interval. */
+    t1 += 128000000ULL;
+    TEST_ASSERT_EQUAL(NtpSync::CORRECTION_SLEW, ntpSync.addSample(t1, t1 + 100000U, t1 + 100000U, t1));
+    TEST_ASSERT_EQUAL_UINT32(NtpSync::MIN_POLL_INTERVAL, ntpSync.getPollInterval());
+    TEST_ASSERT_TRUE(0U < ntpSync.getJitter());
+
+    /* Timestamps of different exchanges are rejected. */
+    TEST_ASSERT_EQUAL(NtpSync::CORRECTION_NONE, ntpSync.addSample(t1, t1 + 100U, t1 + 50U, t1 + 200U));
+
+    /* A large offset steps the clock again. */
+    TEST_ASSERT_EQUAL(NtpSync::CORRECTION_STEP, ntpSync.addSample(t1, t1 - 5000000U, t1 - 5000000U, t1));
+
+    ntpSync.reset();
+    TEST_ASSERT_FALSE(ntpSync.isSynchronized());
+
+    return;
+}
+
+/**
+ * Test the fixed-point brightness calculation against the floating-point
+ * reference, which was used by the brightness controller before.
+ */
+static void testBrightnessCalc(void)
+{
+    const uint8_t   MIN_BRIGHTNESS      = 25U;
+    const uint8_t   MAX_BRIGHTNESS      = 255U;
+    const uint32_t  PERIOD              = 250U;
+    const uint32_t  SHORT_TERM          = 1000U;
+    const uint32_t  LONG_TERM           = 5000U;
+    const float     LUX_VALUES[]        = { 0.5F, 1.5F, 10.0F, 50.0F, 333.3F, 1000.0F, 15000.0F, 99999.0F, 200000.0F };
+    const uint16_t  LIGHT_STEPS[]       = { 1000U, 30000U, 32000U, 12000U, 65535U, 0U, 50000U };
+    const uint16_t  S_CURVE[BrightnessCalc::RESPONSE_CURVE_SIZE] = { 0U, 2000U, 6000U, 16000U, 32768U, 49000U, 59000U, 63500U, 65535U };
+    uint16_t        curve[BrightnessCalc::RESPONSE_CURVE_SIZE];
+    BrightnessCalc  calc(10U, 20U, SHORT_TERM, LONG_TERM);
+    float           refShortTerm        = 0.0F;
+    float           refLongTerm         = 0.0F;
+    float           refAmbient          = 0.0F;
+    uint8_t         index               = 0U;
+    uint8_t         step                = 0U;
+
+    /* Normalization: log10(lux) / 5 */
+    for(index = 0U; index < (sizeof(LUX_VALUES) / sizeof(LUX_VALUES[0])); ++index)
+    {
+        const uint32_t  LUX_FIXED   = static_cast<uint32_t>(LUX_VALUES[index] * 256.0F);
+        float           refLight    = log10f(LUX_VALUES[index]) / 5.0F;
+
+        if (0.0F > refLight)
+        {
+            refLight = 0.0F;
+        }
+        else if (1.0F < refLight)
+        {
+            refLight = 1.0F;
+        }
+
+        TEST_ASSERT_INT_WITHIN(2, static_cast<int32_t>(refLight * 65535.0F), BrightnessCalc::normalizeIlluminance(LUX_FIXED));
+    }
+
+    /* Moving averages, thresholds and brightness with the linear response curve */
+    calc.reset(0U);
+    calc.setAmbientLight(0U);
+
+    for(step = 0U; step < (sizeof(LIGHT_STEPS) / sizeof(LIGHT_STEPS[0])); ++step)
+    {
+        const float REF_LIGHT = static_cast<float>(LIGHT_STEPS[step]) / 65535.0F;
+
+        for(index = 0U; index < 40U; ++index)
+        {
+            bool    refIsBrightening    = false;
+            bool    refIsDarkening      = false;
+
+            refShortTerm += (REF_LIGHT - refShortTerm) * PERIOD / (SHORT_TERM + PERIOD);
+            refLongTerm  += (REF_LIGHT - refLongTerm) * PERIOD / (LONG_TERM + PERIOD);
+            calc.applyMeasurement(PERIOD, LIGHT_STEPS[step]);
+
+            TEST_ASSERT_INT_WITHIN(2, static_cast<int32_t>(refShortTerm * 65535.0F), calc.getShortTermAverage());
+            TEST_ASSERT_INT_WITHIN(2, static_cast<int32_t>(refLongTerm * 65535.0F), calc.getLongTermAverage());
+
+            refIsBrightening    = ((refAmbient * 1.1F) < refShortTerm) && ((refAmbient * 1.1F) < refLongTerm);
+            refIsDarkening      = ((refAmbient * 0.8F) > refShortTerm) && ((refAmbient * 0.8F) > refLongTerm);
+
+            TEST_ASSERT_EQUAL(refIsBrightening, calc.isBrightening());
+            TEST_ASSERT_EQUAL(refIsDarkening, calc.isDarkening());
+
+            if ((true == refIsBrightening) || (true == refIsDarkening))
+            {
+                refAmbient = refShortTerm;
+                calc.setAmbientLight(calc.getShortTermAverage());
+
+                TEST_ASSERT_INT_WITHIN(1, static_cast<int32_t>(MIN_BRIGHTNESS + ((MAX_BRIGHTNESS - MIN_BRIGHTNESS) * refAmbient)), calc.calcBrightness(MIN_BRIGHTNESS, MAX_BRIGHTNESS));
+            }
+        }
+    }
+
+    /* Response curve */
+    calc.setResponseCurve(S_CURVE);
+    calc.getResponseCurve(curve);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(S_CURVE, curve, BrightnessCalc::RESPONSE_CURVE_SIZE);
+
+    calc.setAmbientLight(0U);
+    TEST_ASSERT_EQUAL_UINT8(MIN_BRIGHTNESS, calc.calcBrightness(MIN_BRIGHTNESS, MAX_BRIGHTNESS));
+    calc.setAmbientLight(UINT16_MAX);
+    TEST_ASSERT_EQUAL_UINT8(MAX_BRIGHTNESS, calc.calcBrightness(MIN_BRIGHTNESS, MAX_BRIGHTNESS));
+    calc.setAmbientLight(UINT16_MAX / 2U);
+    TEST_ASSERT_INT_WITHIN(1, MIN_BRIGHTNESS + ((MAX_BRIGHTNESS - MIN_BRIGHTNESS) / 2), calc.calcBrightness(MIN_BRIGHTNESS, MAX_BRIGHTNESS));
+    calc.setAmbientLight(UINT16_MAX / 16U);
+    TEST_ASSERT_INT_WITHIN(1, MIN_BRIGHTNESS + (((MAX_BRIGHTNESS - MIN_BRIGHTNESS) * 1000) / 65535), calc.calcBrightness(MIN_BRIGHTNESS, MAX_BRIGHTNESS));
+
     return;
 }